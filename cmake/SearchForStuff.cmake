@@ -574,6 +574,11 @@ if (PKG_CONFIG_FOUND)
     add_definitions( -DLIBBULLET_VERSION_GT_282 )
   endif()
 
+  # Multithreaded dynamics world with the current constructor signature
+  if (BULLET_VERSION VERSION_GREATER 2.87)
+    add_definitions( -DLIBBULLET_VERSION_GT_287 )
+  endif()
+
   ########################################
   # Find libusb
   pkg_check_modules(libusb-1.0 libusb-1.0)
@@ -45,6 +45,11 @@ ODE_API unsigned long dRand(void);
 ODE_API unsigned long  dRandGetSeed(void);
 ODE_API void dRandSetSeed (unsigned long s);
 
+/* use the seed pointed to by s for the random numbers of the calling
+ * thread, or the shared seed again if s is NULL.
+ */
+ODE_API void dRandSetThreadSeed (unsigned long *s);
+
 /* return a random integer between 0..n-1. the distribution will get worse
  * as n approaches 2^32.
  */
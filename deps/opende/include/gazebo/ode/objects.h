@@ -115,6 +115,24 @@ ODE_API void dWorldSetIslandThreads (dWorldID, int num_island_threads);
  */
 ODE_API void dWorldSetQuickStepThreads (dWorldID, int num_quickstep_threads);
 
+/**
+ * @brief Get whether the results of a step are independent of the number
+ * of threads.
+ *
+ * @ingroup world
+ */
+ODE_API int dWorldGetDeterministic (dWorldID);
+
+/**
+ * @brief Set whether the results of a step are independent of the number
+ * of threads. Each island then draws its random numbers from its own seed,
+ * derived from the seed of dRandSetSeed, and the rows of an island are
+ * solved on one thread.
+ *
+ * @ingroup world
+ */
+ODE_API void dWorldSetDeterministic (dWorldID, int deterministic);
+
 /**
  * @brief Get the gravity vector for a given world.
  * @ingroup world
@@ -618,6 +636,13 @@ ODE_API Friction_Model dWorldGetQuickStepFrictionModel(dWorldID);
  */
 ODE_API World_Solver_Type dWorldGetWorldStepSolverType(dWorldID);
 
+/**
+ * @brief Get option to solve the quickstep rows with vectorized kernels.
+ * see dWorldSetQuickStepSIMDRows for details.
+ * @ingroup world
+ */
+ODE_API bool dWorldGetQuickStepSIMDRows (dWorldID);
+
 /**
  * @brief Option to turn on inertia ratio reduction.
  * @ingroup world
@@ -693,6 +718,17 @@ ODE_API void dWorldSetQuickStepFrictionModel(dWorldID, Friction_Model fricmodel)
  */
 ODE_API void dWorldSetWorldStepSolverType(dWorldID, World_Solver_Type solverType);
 
+/**
+ * @brief Solve the quickstep rows with vectorized kernels, AVX2 and FMA
+ * when the cpu supports them, or NEON on aarch64. The instruction set is
+ * detected at runtime, and portable kernels are used if none is found.
+ * Fused multiply-adds round differently, so results aren't bit identical
+ * to the default solver.
+ * @ingroup world
+ * @param simd set to true to use the vectorized kernels
+ */
+ODE_API void dWorldSetQuickStepSIMDRows (dWorldID, bool simd);
+
 /* PGS experimental parameters */
 
 /**
@@ -1231,6 +1267,14 @@ ODE_API void dBodySetRotation   (dBodyID, const dMatrix3 R);
  */
 ODE_API void dBodySetQuaternion (dBodyID, const dQuaternion q);
 
+/**
+ * @brief Set the orientation of a body from a unit quaternion, without
+ * normalizing it, for example to restore a state saved with
+ * dBodyGetQuaternion exactly.
+ * @ingroup bodies
+ */
+ODE_API void dBodySetUnitQuaternion (dBodyID, const dQuaternion q);
+
 /**
  * @brief Set the linear velocity of a body.
  * @ingroup bodies
@@ -2131,6 +2175,23 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Gets the constraint forces of the last step, which the quick
+ * step solver uses to warm start the next step.
+ * @param lambda Array of 12 values that receives the 6 constraint forces
+ * followed by the 6 error correcting forces.
+ * @ingroup joints
+ */
+ODE_API void dJointGetLambda (dJointID, dReal *lambda);
+
+/**
+ * @brief Sets the constraint forces used to warm start the next step,
+ * for example to restore a saved state.
+ * @param lambda Array of 12 values, as returned by dJointGetLambda.
+ * @ingroup joints
+ */
+ODE_API void dJointSetLambda (dJointID, const dReal *lambda);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
@@ -30,22 +30,38 @@
 
 static unsigned long seed = 0;
 
+// seed of the calling thread, set while it processes an island in
+// deterministic mode
+static thread_local unsigned long *thread_seed = NULL;
+
+static inline unsigned long &currentSeed()
+{
+  return thread_seed ? *thread_seed : seed;
+}
+
 unsigned long dRand()
 {
-  seed = (1664525UL*seed + 1013904223UL) & 0xffffffff;
-  return seed;
+  unsigned long &s = currentSeed();
+  s = (1664525UL*s + 1013904223UL) & 0xffffffff;
+  return s;
 }
 
 
 unsigned long  dRandGetSeed()
 {
-  return seed;
+  return currentSeed();
 }
 
 
 void dRandSetSeed (unsigned long s)
 {
-  seed = s;
+  currentSeed() = s;
+}
+
+
+void dRandSetThreadSeed (unsigned long *s)
+{
+  thread_seed = s;
 }
 
 
@@ -35,6 +35,7 @@
 #include <boost/threadpool.hpp>
 
 class dxStepWorkingMemory;
+struct dxWorldProcessContext;
 
 // some body flags
 
@@ -125,6 +126,7 @@ struct dxQuickStepParameters {
   int friction_iterations;  // extra quickstep iterations friction.
   Friction_Model friction_model;  // friction model, enum type Friction_Model
   World_Solver_Type world_solver_type;  // world step solver, enum type World_Solver_Type.
+  bool simd_rows;  // solve quickstep rows with the vectorized kernels.
 };
 
 // robust-step parameters
@@ -185,6 +187,18 @@ struct dxBody : public dObject {
 };
 
 
+// an island scheduled by dxProcessIslands
+struct dxIslandTask {
+  dxWorldProcessContext *context; // working memory of the island
+  dxBody *const *bodystart;
+  int bcount;
+  dxJoint *const *jointstart;
+  int jcount;
+  size_t cost;    // estimated solver cost, used to order the islands
+  unsigned long seed; // random seed of the island in deterministic mode
+};
+
+
 struct dxWorld : public dBase {
   dxBody *firstbody;    // body linked list
   dxJoint *firstjoint;    // joint linked list
@@ -196,6 +210,7 @@ struct dxWorld : public dBase {
   int body_flags;               // flags for new bodies
   dxStepWorkingMemory *wmem; // Working memory object for dWorldStep/dWorldQuickStep
   std::vector<dxStepWorkingMemory *> island_wmems; // Working memory object for dWorldStep/dWorldQuickStep
+  std::vector<dxIslandTask> island_tasks; // islands of the current step, reused between steps
 
   dxQuickStepParameters qs;
   dxRobustStepParameters rs;
@@ -204,6 +219,7 @@ struct dxWorld : public dBase {
   dReal max_angular_speed;      // limit the angular velocity to this magnitude
   boost::threadpool::pool *threadpool;
   boost::threadpool::pool *row_threadpool;
+  int deterministic;  // results independent of the number of threads
 };
 
 
@@ -427,6 +427,21 @@ void dBodySetQuaternion (dBodyID b, const dQuaternion q)
 }
 
 
+void dBodySetUnitQuaternion (dBodyID b, const dQuaternion q)
+{
+  dAASSERT (b && q);
+  b->q[0] = q[0];
+  b->q[1] = q[1];
+  b->q[2] = q[2];
+  b->q[3] = q[3];
+  dQtoR (b->q,b->posr.R);
+
+  // notify all attached geoms that this body has moved
+  for (dxGeom *geom = b->geom; geom; geom = dGeomGetBodyNext (geom))
+    dGeomMoved (geom);
+}
+
+
 void dBodySetLinearVel  (dBodyID b, dReal x, dReal y, dReal z)
 {
   dAASSERT (b);
@@ -1543,6 +1558,22 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
 }
 
 
+void dJointGetLambda (dxJoint *joint, dReal *lambda)
+{
+  dAASSERT (joint && lambda);
+  memcpy (lambda, joint->lambda, 6 * sizeof(dReal));
+  memcpy (lambda + 6, joint->lambda_erp, 6 * sizeof(dReal));
+}
+
+
+void dJointSetLambda (dxJoint *joint, const dReal *lambda)
+{
+  dAASSERT (joint && lambda);
+  memcpy (joint->lambda, lambda, 6 * sizeof(dReal));
+  memcpy (joint->lambda_erp, lambda + 6, 6 * sizeof(dReal));
+}
+
+
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
 {
@@ -1671,6 +1702,7 @@ dxWorld * dWorldCreate()
   w->qs.friction_iterations = 10;
   w->qs.friction_model = pyramid_friction;
   w->qs.world_solver_type = ODE_DEFAULT;
+  w->qs.simd_rows = false;
 
   w->contactp.max_vel = dInfinity;
   w->contactp.min_depth = 0;
@@ -1683,6 +1715,7 @@ dxWorld * dWorldCreate()
 
   w->threadpool = NULL; // new boost::threadpool::pool(0);
   w->row_threadpool = NULL; // new boost::threadpool::pool(0);
+  w->deterministic = 0;
 
   return w;
 }
@@ -1747,6 +1780,12 @@ void dWorldDestroy (dxWorld *w)
     w->wmem->Release();
   }
 
+  for (size_t i = 0; i < w->island_wmems.size(); ++i) {
+    if (w->island_wmems[i]) {
+      w->island_wmems[i]->Release();
+    }
+  }
+
   if (w->threadpool) {
     w->threadpool->wait();
     delete w->threadpool;
@@ -1792,6 +1831,18 @@ void dWorldSetIslandThreads (dWorldID w, int num_island_threads)
   }
 }
 
+int dWorldGetDeterministic (dWorldID w)
+{
+  dAASSERT (w);
+  return w->deterministic;
+}
+
+void dWorldSetDeterministic (dWorldID w, int deterministic)
+{
+  dAASSERT (w);
+  w->deterministic = deterministic ? 1 : 0;
+}
+
 void dWorldSetQuickStepThreads (dWorldID w, int num_quickstep_threads)
 {
   dAASSERT (w);
@@ -2337,6 +2388,12 @@ World_Solver_Type dWorldGetWorldStepSolverType (dWorldID w)
   return w->qs.world_solver_type;
 }
 
+bool dWorldGetQuickStepSIMDRows (dWorldID w)
+{
+  dAASSERT(w);
+  return w->qs.simd_rows;
+}
+
 void dWorldSetQuickStepInertiaRatioReduction (dWorldID w, bool irr)
 {
   dAASSERT(w);
@@ -2393,6 +2450,12 @@ void dWorldSetWorldStepSolverType(dWorldID w, World_Solver_Type solvertype)
   w->qs.world_solver_type= solvertype;
 }
 
+void dWorldSetQuickStepSIMDRows (dWorldID w, bool simd)
+{
+  dAASSERT(w);
+  w->qs.simd_rows = simd;
+}
+
 
 void dWorldSetContactMaxCorrectingVel (dWorldID w, dReal vel)
 {
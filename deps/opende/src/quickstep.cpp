@@ -514,7 +514,9 @@ void dxQuickStepper (dxWorldProcessContext *context,
                lo,hi,cfm,findex,
                &world->qs
 #ifdef USE_TPROW
-               , world->row_threadpool
+               // rows solved concurrently update the same lambdas in an
+               // order that depends on the scheduling
+               , world->deterministic ? NULL : world->row_threadpool
 #endif
       );
 
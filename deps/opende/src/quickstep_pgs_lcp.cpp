@@ -40,6 +40,7 @@
 
 #include "quickstep_util.h"
 #include "quickstep_pgs_lcp.h"
+#include "quickstep_simd.h"
 #ifndef TIMING
 #ifdef HDF5_INSTRUMENT
 #define DUMP
@@ -73,6 +74,9 @@ static void* ComputeRows(void *p)
   bool position_correction_thread = params->position_correction_thread;
 
   dxQuickStepParameters *qs    = params->qs;
+  // vectorized row kernels, if the solver type asks for them
+  const quickstep::RowKernels *simd =
+    qs->simd_rows ? &quickstep::GetRowKernels() : NULL;
   int startRow                 = params->nStart;   // 0
   int nRows                    = params->nChunkSize; // m
 #ifdef USE_1NORM
@@ -402,9 +406,14 @@ static void* ComputeRows(void *p)
 
         // for preconditioned case, update delta using cforce, not caccel
 
-        delta_precon -= quickstep::dot6(cforce_ptr1, J_ptr);
-        if (cforce_ptr2)
-          delta_precon -= quickstep::dot6(cforce_ptr2, J_ptr + 6);
+        if (simd)
+          delta_precon -= simd->dot(cforce_ptr1, cforce_ptr2, J_ptr);
+        else
+        {
+          delta_precon -= quickstep::dot6(cforce_ptr1, J_ptr);
+          if (cforce_ptr2)
+            delta_precon -= quickstep::dot6(cforce_ptr2, J_ptr + 6);
+        }
 
         // set the limits for this constraint.
         // this is the place where the QuickStep method differs from the
@@ -452,9 +461,14 @@ static void* ComputeRows(void *p)
           J_ptr = J_orig + index*12;
 
           // update cforce.
-          quickstep::sum6(cforce_ptr1, delta_precon, J_ptr);
-          if (cforce_ptr2)
-            quickstep::sum6(cforce_ptr2, delta_precon, J_ptr + 6);
+          if (simd)
+            simd->sum(cforce_ptr1, cforce_ptr2, delta_precon, J_ptr);
+          else
+          {
+            quickstep::sum6(cforce_ptr1, delta_precon, J_ptr);
+            if (cforce_ptr2)
+              quickstep::sum6(cforce_ptr2, delta_precon, J_ptr + 6);
+          }
         }
 
         // record residual (error) (for the non-erp version)
@@ -529,16 +543,26 @@ static void* ComputeRows(void *p)
 #endif
                 rhs[index] - old_lambda*Adcfm[index];
           dRealPtr J_ptr = J + index*12;
-          delta -= quickstep::dot6(caccel_ptr1, J_ptr);
-          if (caccel_ptr2)
-            delta -= quickstep::dot6(caccel_ptr2, J_ptr + 6);
+          if (simd)
+            delta -= simd->dot(caccel_ptr1, caccel_ptr2, J_ptr);
+          else
+          {
+            delta -= quickstep::dot6(caccel_ptr1, J_ptr);
+            if (caccel_ptr2)
+              delta -= quickstep::dot6(caccel_ptr2, J_ptr + 6);
+          }
 
           if (inline_position_correction)
           {
             delta_erp = rhs_erp[index] - old_lambda_erp*Adcfm[index];
-            delta_erp -= quickstep::dot6(caccel_erp_ptr1, J_ptr);
-            if (caccel_ptr2)
-              delta_erp -= quickstep::dot6(caccel_erp_ptr2, J_ptr + 6);
+            if (simd)
+              delta_erp -= simd->dot(caccel_erp_ptr1, caccel_erp_ptr2, J_ptr);
+            else
+            {
+              delta_erp -= quickstep::dot6(caccel_erp_ptr1, J_ptr);
+              if (caccel_ptr2)
+                delta_erp -= quickstep::dot6(caccel_erp_ptr2, J_ptr + 6);
+            }
           }
 
         // set the limits for this constraint.
@@ -703,15 +727,24 @@ static void* ComputeRows(void *p)
             dRealPtr iMJ_ptr = iMJ + index*12;
 
             // update caccel.
-            quickstep::sum6(caccel_ptr1, delta, iMJ_ptr);
-            if (caccel_ptr2)
-              quickstep::sum6(caccel_ptr2, delta, iMJ_ptr + 6);
-
-            if (inline_position_correction)
+            if (simd)
             {
-              quickstep::sum6(caccel_erp_ptr1, delta_erp, iMJ_ptr);
-              if (caccel_erp_ptr2)
-                quickstep::sum6(caccel_erp_ptr2, delta_erp, iMJ_ptr + 6);
+              simd->sum(caccel_ptr1, caccel_ptr2, delta, iMJ_ptr);
+              if (inline_position_correction)
+                simd->sum(caccel_erp_ptr1, caccel_erp_ptr2, delta_erp, iMJ_ptr);
+            }
+            else
+            {
+              quickstep::sum6(caccel_ptr1, delta, iMJ_ptr);
+              if (caccel_ptr2)
+                quickstep::sum6(caccel_ptr2, delta, iMJ_ptr + 6);
+
+              if (inline_position_correction)
+              {
+                quickstep::sum6(caccel_erp_ptr1, delta_erp, iMJ_ptr);
+                if (caccel_erp_ptr2)
+                  quickstep::sum6(caccel_erp_ptr2, delta_erp, iMJ_ptr + 6);
+              }
             }
           }
         }  // end of skip friction check
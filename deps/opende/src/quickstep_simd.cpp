@@ -0,0 +1,149 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#include "quickstep_simd.h"
+
+#if defined(dDOUBLE) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__GNUC__)
+#define QUICKSTEP_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(dDOUBLE) && defined(__aarch64__)
+#define QUICKSTEP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ode {
+namespace quickstep
+{
+  //****************************************************************************
+  // portable kernels, used when no vector unit is available
+
+  static dReal DotScalar(const dReal *a1, const dReal *a2, const dReal *j)
+  {
+    dReal sum = a1[0]*j[0] + a1[1]*j[1] + a1[2]*j[2] +
+                a1[3]*j[3] + a1[4]*j[4] + a1[5]*j[5];
+    if (a2)
+      sum += a2[0]*j[6] + a2[1]*j[7] + a2[2]*j[8] +
+             a2[3]*j[9] + a2[4]*j[10] + a2[5]*j[11];
+    return sum;
+  }
+
+  static void SumScalar(dReal *a1, dReal *a2, dReal delta, const dReal *j)
+  {
+    for (int i = 0; i < 6; ++i)
+      a1[i] += delta * j[i];
+    if (a2)
+      for (int i = 0; i < 6; ++i)
+        a2[i] += delta * j[6+i];
+  }
+
+#ifdef QUICKSTEP_SIMD_AVX2
+  //****************************************************************************
+  // AVX2 kernels. the body vectors are 6 doubles, so they are handled as
+  // one 256 bit and one 128 bit lane. the arrays aren't 32 byte aligned,
+  // so unaligned loads are used.
+
+  __attribute__((target("avx2,fma")))
+  static dReal DotAVX2(const dReal *a1, const dReal *a2, const dReal *j)
+  {
+    __m256d acc4 = _mm256_mul_pd(_mm256_loadu_pd(a1), _mm256_loadu_pd(j));
+    __m128d acc2 = _mm_mul_pd(_mm_loadu_pd(a1+4), _mm_loadu_pd(j+4));
+    if (a2) {
+      acc4 = _mm256_fmadd_pd(_mm256_loadu_pd(a2), _mm256_loadu_pd(j+6), acc4);
+      acc2 = _mm_fmadd_pd(_mm_loadu_pd(a2+4), _mm_loadu_pd(j+10), acc2);
+    }
+    acc2 = _mm_add_pd(acc2, _mm_add_pd(_mm256_castpd256_pd128(acc4),
+                                        _mm256_extractf128_pd(acc4, 1)));
+    return _mm_cvtsd_f64(_mm_add_sd(acc2, _mm_unpackhi_pd(acc2, acc2)));
+  }
+
+  __attribute__((target("avx2,fma")))
+  static void SumAVX2(dReal *a1, dReal *a2, dReal delta, const dReal *j)
+  {
+    const __m256d d4 = _mm256_set1_pd(delta);
+    const __m128d d2 = _mm_set1_pd(delta);
+    _mm256_storeu_pd(a1, _mm256_fmadd_pd(d4, _mm256_loadu_pd(j),
+                                         _mm256_loadu_pd(a1)));
+    _mm_storeu_pd(a1+4, _mm_fmadd_pd(d2, _mm_loadu_pd(j+4),
+                                     _mm_loadu_pd(a1+4)));
+    if (a2) {
+      _mm256_storeu_pd(a2, _mm256_fmadd_pd(d4, _mm256_loadu_pd(j+6),
+                                           _mm256_loadu_pd(a2)));
+      _mm_storeu_pd(a2+4, _mm_fmadd_pd(d2, _mm_loadu_pd(j+10),
+                                       _mm_loadu_pd(a2+4)));
+    }
+  }
+#endif
+
+#ifdef QUICKSTEP_SIMD_NEON
+  //****************************************************************************
+  // NEON kernels, the body vectors are three 128 bit lanes. NEON is part
+  // of every aarch64 cpu, so it doesn't need a runtime check.
+
+  static dReal DotNEON(const dReal *a1, const dReal *a2, const dReal *j)
+  {
+    float64x2_t acc = vmulq_f64(vld1q_f64(a1), vld1q_f64(j));
+    acc = vfmaq_f64(acc, vld1q_f64(a1+2), vld1q_f64(j+2));
+    acc = vfmaq_f64(acc, vld1q_f64(a1+4), vld1q_f64(j+4));
+    if (a2) {
+      acc = vfmaq_f64(acc, vld1q_f64(a2), vld1q_f64(j+6));
+      acc = vfmaq_f64(acc, vld1q_f64(a2+2), vld1q_f64(j+8));
+      acc = vfmaq_f64(acc, vld1q_f64(a2+4), vld1q_f64(j+10));
+    }
+    return vaddvq_f64(acc);
+  }
+
+  static void SumNEON(dReal *a1, dReal *a2, dReal delta, const dReal *j)
+  {
+    const float64x2_t d = vdupq_n_f64(delta);
+    for (int i = 0; i < 6; i += 2)
+      vst1q_f64(a1+i, vfmaq_f64(vld1q_f64(a1+i), d, vld1q_f64(j+i)));
+    if (a2)
+      for (int i = 0; i < 6; i += 2)
+        vst1q_f64(a2+i, vfmaq_f64(vld1q_f64(a2+i), d, vld1q_f64(j+6+i)));
+  }
+#endif
+
+  //****************************************************************************
+  // runtime dispatch
+
+  static RowKernels SelectRowKernels()
+  {
+#ifdef QUICKSTEP_SIMD_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return RowKernels{&DotAVX2, &SumAVX2, "avx2"};
+#endif
+#ifdef QUICKSTEP_SIMD_NEON
+    return RowKernels{&DotNEON, &SumNEON, "neon"};
+#endif
+    return RowKernels{&DotScalar, &SumScalar, "scalar"};
+  }
+
+  const RowKernels &GetRowKernels()
+  {
+    // thread safe initialization of function statics
+    static const RowKernels kernels = SelectRowKernels();
+    return kernels;
+  }
+}  // namespace quickstep
+}  // namespace ode
@@ -0,0 +1,54 @@
+/*************************************************************************
+ *                                                                       *
+ * Open Dynamics Engine, Copyright (C) 2001,2002 Russell L. Smith.       *
+ * All rights reserved.  Email: russ@q12.org   Web: www.q12.org          *
+ *                                                                       *
+ * This library is free software; you can redistribute it and/or         *
+ * modify it under the terms of EITHER:                                  *
+ *   (1) The GNU Lesser General Public License as published by the Free  *
+ *       Software Foundation; either version 2.1 of the License, or (at  *
+ *       your option) any later version. The text of the GNU Lesser      *
+ *       General Public License is included with this library in the     *
+ *       file LICENSE.TXT.                                               *
+ *   (2) The BSD-style license that is included with this library in     *
+ *       the file LICENSE-BSD.TXT.                                       *
+ *                                                                       *
+ * This library is distributed in the hope that it will be useful,       *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the files    *
+ * LICENSE.TXT and LICENSE-BSD.TXT for more details.                     *
+ *                                                                       *
+ *************************************************************************/
+
+#ifndef _ODE_QUICK_STEP_SIMD_H_
+#define _ODE_QUICK_STEP_SIMD_H_
+
+#include <gazebo/ode/common.h>
+
+namespace ode {
+namespace quickstep
+{
+  // vectorized kernels for the rows of the PGS iterations. a row couples
+  // at most two bodies, and stores the 6 jacobian entries of the first
+  // body followed by the 6 entries of the second one. the rows are solved
+  // one after the other by Gauss-Seidel, so the kernels work on a single
+  // row and fuse the two bodies in one call.
+  struct RowKernels
+  {
+    // returns a1 . j[0..5] + a2 . j[6..11], a2 may be NULL
+    dReal (*dot)(const dReal *a1, const dReal *a2, const dReal *j);
+
+    // a1 += delta * j[0..5] and a2 += delta * j[6..11], a2 may be NULL
+    void (*sum)(dReal *a1, dReal *a2, dReal delta, const dReal *j);
+
+    // name of the instruction set, for diagnostics
+    const char *name;
+  };
+
+  // kernels for the instruction set of the cpu we are running on,
+  // selected once at the first call
+  const RowKernels &GetRowKernels();
+}  // namespace quickstep
+}  // namespace ode
+
+#endif
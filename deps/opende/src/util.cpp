@@ -27,6 +27,8 @@
 #include "util.h"
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
+#include <atomic>
 #include <gazebo/ode/timer.h>
 
 #undef REPORT_THREAD_TIMING
@@ -624,35 +626,80 @@ void dxProcessIslands (dxWorld *world, dReal stepsize, dstepper_fn_t stepper)
   printf(">>>>>>>>>>>> start island spawn threads at time %f\n",cur_time);
 #endif
 
+  std::vector<dxIslandTask> &tasks = world->island_tasks;
+  tasks.resize(islandcount);
+
+  // in deterministic mode each island draws from its own seed, so that the
+  // results don't depend on which thread runs the island, or when. the
+  // shared seed moves on once per step whatever the number of threads.
+  const unsigned long stepseed = world->deterministic ? dRand() : 0;
   for (int const *sizescurr = islandsizes; sizescurr != sizesend; sizescurr += sizeelements) {
     int bcount = sizescurr[0];
     int jcount = sizescurr[1];
 
     // get working memory for each island
-    dxStepWorkingMemory *island_wmem = world->island_wmems[island_index++];
+    dxStepWorkingMemory *island_wmem = world->island_wmems[island_index];
     dIASSERT(island_wmem != NULL);
-    dxWorldProcessContext *island_context = island_wmem->GetWorldProcessingContext();
-
-#define USE_TPISLAND
-#ifdef USE_TPISLAND
-    IFTIMING(dTimerNow("scheduling island"));
-    //printf("debug opende tp %d\n",world->threadpool->size());
-    if (world->threadpool && world->threadpool->size() > 0)
-      world->threadpool->schedule(boost::bind(dxProcessOneIsland,island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount));
-    else //automatically skip threadpool if only 1 thread allocated
-      dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#else
-    dxProcessOneIsland(island_context, world, stepsize, stepper,bodystart, bcount, jointstart, jcount);
-#endif
+
+    dxIslandTask &task = tasks[island_index++];
+    task.context = island_wmem->GetWorldProcessingContext();
+    task.bodystart = bodystart;
+    task.bcount = bcount;
+    task.jointstart = jointstart;
+    task.jcount = jcount;
+    // the solver iterates over the constraint rows, whose count grows with
+    // the joints, and touches the bodies they connect
+    task.cost = (size_t)bcount * (size_t)(jcount + 1);
+    task.seed = (stepseed + 0x9e3779b9UL * (unsigned long)island_index)
+      & 0xffffffff;
 
     bodystart += bcount;
     jointstart += jcount;
   }
-#ifdef USE_TPISLAND
-  IFTIMING(dTimerNow("islands wait"));
-  if (world->threadpool && world->threadpool->size() > 0)
+
+  int workers = 0;
+  if (world->threadpool && islandcount > 1)
+    workers = std::min<int>(world->threadpool->size(), islandcount - 1);
+
+  if (workers > 0) {
+    // start the most expensive islands first, so that one large island
+    // doesn't run alone at the end of the step while the other threads
+    // are idle.
+    std::stable_sort(tasks.begin(), tasks.end(),
+      [](const dxIslandTask &a, const dxIslandTask &b) { return a.cost > b.cost; });
+
+    // each thread takes the next island when it is done with its previous
+    // one, so that the load balances itself. the calling thread works too
+    // instead of waiting.
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+      for (int i = next.fetch_add(1); i < islandcount; i = next.fetch_add(1)) {
+        dxIslandTask &task = tasks[i];
+        if (world->deterministic)
+          dRandSetThreadSeed(&task.seed);
+        dxProcessOneIsland(task.context, world, stepsize, stepper,
+          task.bodystart, task.bcount, task.jointstart, task.jcount);
+      }
+      dRandSetThreadSeed(NULL);
+    };
+
+    IFTIMING(dTimerNow("scheduling islands"));
+    for (int i = 0; i < workers; ++i)
+      world->threadpool->schedule(worker);
+    worker();
+
+    IFTIMING(dTimerNow("islands wait"));
     world->threadpool->wait();
-#endif
+  }
+  else {
+    for (dxIslandTask &task : tasks) {
+      if (world->deterministic)
+        dRandSetThreadSeed(&task.seed);
+      dxProcessOneIsland(task.context, world, stepsize, stepper,
+        task.bodystart, task.bcount, task.jointstart, task.jcount);
+    }
+    dRandSetThreadSeed(NULL);
+  }
   IFTIMING(dTimerEnd());
   IFTIMING(dTimerReport (stdout,1));
 
@@ -878,6 +925,11 @@ bool dxReallocateWorldProcessContext (dxWorld *world,
       {
         island_wmem = new dxStepWorkingMemory();
         world->island_wmems[jj] = island_wmem;
+
+        // islands allocate from the memory manager of the world
+        const dxWorldProcessMemoryManager *world_memmgr = wmem->GetMemoryManager();
+        if (world_memmgr)
+          island_wmem->SetMemoryManager(world_memmgr->m_fnAlloc, world_memmgr->m_fnShrink, world_memmgr->m_fnFree);
       }
       else
         island_wmem = world->island_wmems[jj];
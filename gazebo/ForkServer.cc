@@ -0,0 +1,409 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <dlfcn.h>
+  #include <poll.h>
+  #include <signal.h>
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/un.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <sstream>
+
+#include <boost/program_options.hpp>
+#include <sdf/sdf.hh>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/ModelSdfCache.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/ForkServer.hh"
+
+namespace po = boost::program_options;
+using namespace gazebo;
+
+namespace gazebo
+{
+  /// \internal
+  /// \brief Private data for ForkServer
+  class ForkServerPrivate
+  {
+    /// \brief Path of the job socket.
+    public: std::string socketPath;
+
+    /// \brief Plugin libraries to load before forking.
+    public: std::vector<std::string> preloads;
+
+    /// \brief Worlds whose assets are loaded before forking.
+    public: std::vector<std::string> preloadWorlds;
+
+    /// \brief Handles of the preloaded libraries, never closed.
+    public: std::vector<void *> handles;
+
+    /// \brief In a forked child, connection to the client of its job.
+    public: int jobFd = -1;
+  };
+}
+
+#ifndef _WIN32
+/// \brief Set by SIGINT and SIGTERM to stop the fork server.
+static volatile sig_atomic_t g_stopForkServer = 0;
+
+/////////////////////////////////////////////////
+/// \brief Stop the fork server.
+static void stopForkServer(int)
+{
+  g_stopForkServer = 1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a whole string to a descriptor.
+/// \param[in] _fd The descriptor.
+/// \param[in] _text The string.
+static void writeAll(const int _fd, const std::string &_text)
+{
+  size_t done = 0;
+  while (done < _text.size())
+  {
+    ssize_t n = write(_fd, _text.data() + done, _text.size() - done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return;
+    done += n;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a job from a client.
+/// \param[in] _fd Connection to the client.
+/// \param[out] _args Arguments of the job.
+/// \param[out] _env Variables of the job, as name=value.
+/// \return False if the job is malformed or incomplete.
+static bool readJob(const int _fd, std::vector<std::string> &_args,
+    std::vector<std::string> &_env)
+{
+  // A bounded job, so that a client can't hold the fork server
+  const size_t maxSize = 1 << 20;
+  std::string text;
+  char buffer[4096];
+  while (text.find("\n\n") == std::string::npos && text.size() < maxSize)
+  {
+    ssize_t n = read(_fd, buffer, sizeof(buffer));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    text.append(buffer, n);
+  }
+
+  size_t end = text.find("\n\n");
+  if (end == std::string::npos)
+    return false;
+
+  std::istringstream stream(text.substr(0, end));
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    if (line.compare(0, 4, "arg ") == 0)
+      _args.push_back(line.substr(4));
+    else if (line.compare(0, 4, "env ") == 0 &&
+             line.find('=') != std::string::npos)
+    {
+      _env.push_back(line.substr(4));
+    }
+    else
+      return false;
+  }
+  return true;
+}
+#endif
+
+/////////////////////////////////////////////////
+ForkServer::ForkServer()
+  : dataPtr(new ForkServerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ForkServer::~ForkServer()
+{
+  this->Finish(-1);
+}
+
+/////////////////////////////////////////////////
+bool ForkServer::Requested(int _argc, char **_argv)
+{
+  for (int i = 1; i < _argc; ++i)
+  {
+    if (std::string(_argv[i]) == "--fork-server")
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ForkServer::Load(int _argc, char **_argv)
+{
+#ifdef _WIN32
+  gzerr << "The fork server isn't supported on Windows\n";
+  return false;
+#else
+  po::options_description desc("Fork server options");
+  desc.add_options()
+    ("fork-server", po::value<std::string>()->required(),
+     "Serve jobs on a Unix socket.")
+    ("preload", po::value<std::vector<std::string> >(),
+     "Load a plugin library before forking.")
+    ("preload-world", po::value<std::vector<std::string> >(),
+     "Load the model SDF and meshes of a world before forking.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &_e)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return false;
+  }
+
+  this->dataPtr->socketPath = vm["fork-server"].as<std::string>();
+  if (vm.count("preload"))
+    this->dataPtr->preloads = vm["preload"].as<std::vector<std::string> >();
+  if (vm.count("preload-world"))
+  {
+    this->dataPtr->preloadWorlds =
+        vm["preload-world"].as<std::vector<std::string> >();
+  }
+
+  // Open the libraries the way PluginT does, so that the children get
+  // the loaded library when they create the plugin
+  std::list<std::string> pluginPaths =
+      common::SystemPaths::Instance()->GetPluginPaths();
+  for (auto const &preload : this->dataPtr->preloads)
+  {
+    std::string fullname = preload;
+    for (auto const &path : pluginPaths)
+    {
+      struct stat st;
+      if (stat((path + "/" + preload).c_str(), &st) == 0)
+      {
+        fullname = path + "/" + preload;
+        break;
+      }
+    }
+
+    void *handle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+    if (!handle)
+    {
+      gzerr << "Failed to preload " << fullname << ": " << dlerror() << "\n";
+      continue;
+    }
+    this->dataPtr->handles.push_back(handle);
+  }
+
+  // Parse the models of the worlds into the SDF cache, and load their
+  // meshes
+  unsigned int meshCount = 0;
+  for (auto const &world : this->dataPtr->preloadWorlds)
+  {
+    sdf::SDFPtr sdf(new sdf::SDF);
+    if (!sdf::init(sdf) || !common::ModelSdfCache::Instance()->ReadWorldFile(
+          common::find_file(world), sdf))
+    {
+      gzerr << "Unable to preload world[" << world << "]\n";
+      continue;
+    }
+
+    std::function<void(const sdf::ElementPtr &)> loadMeshes =
+        [&](const sdf::ElementPtr &_elem)
+    {
+      if (_elem->GetName() == "mesh" && _elem->HasElement("uri"))
+      {
+        std::string filename =
+            common::find_file(_elem->Get<std::string>("uri"));
+        if (!filename.empty() &&
+            common::MeshManager::Instance()->Load(filename))
+        {
+          ++meshCount;
+        }
+      }
+      for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+           child = child->GetNextElement())
+      {
+        loadMeshes(child);
+      }
+    };
+    loadMeshes(sdf->Root());
+  }
+
+  // Threads don't survive a fork
+  common::ModelDatabase::Instance()->Fini();
+
+  gzmsg << "Fork server preloaded " << this->dataPtr->handles.size()
+        << " libraries and " << meshCount << " meshes\n";
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool ForkServer::Run(std::vector<std::string> &_args)
+{
+#ifdef _WIN32
+  return false;
+#else
+  const std::string &path = this->dataPtr->socketPath;
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path))
+  {
+    gzerr << "Fork server socket path[" << path << "] is too long\n";
+    return false;
+  }
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+  int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(path.c_str());
+  if (listenFd < 0 ||
+      bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+      listen(listenFd, 16) < 0)
+  {
+    gzerr << "Unable to serve on socket[" << path << "]: "
+          << std::strerror(errno) << "\n";
+    if (listenFd >= 0)
+      close(listenFd);
+    return false;
+  }
+
+  // No SA_RESTART, so that poll returns on a signal
+  struct sigaction sigact;
+  std::memset(&sigact, 0, sizeof(sigact));
+  sigact.sa_handler = stopForkServer;
+  sigemptyset(&sigact.sa_mask);
+  struct sigaction oldInt, oldTerm;
+  sigaction(SIGINT, &sigact, &oldInt);
+  sigaction(SIGTERM, &sigact, &oldTerm);
+
+  gzmsg << "Fork server waiting for jobs on [" << path << "]\n";
+
+  bool child = false;
+  while (!g_stopForkServer)
+  {
+    // Reap the finished children
+    int status;
+    pid_t pid;
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+      gzmsg << "Fork server job [" << pid << "] finished\n";
+
+    pollfd pfd;
+    pfd.fd = listenFd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, 1000) <= 0)
+      continue;
+
+    int connFd = accept(listenFd, nullptr, nullptr);
+    if (connFd < 0)
+      continue;
+
+    // Time out clients that don't finish their job
+    timeval timeout;
+    timeout.tv_sec = 5;
+    timeout.tv_usec = 0;
+    setsockopt(connFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::vector<std::string> args, env;
+    if (!readJob(connFd, args, env))
+    {
+      writeAll(connFd, "error invalid job\n");
+      close(connFd);
+      continue;
+    }
+
+    pid = fork();
+    if (pid < 0)
+    {
+      writeAll(connFd, std::string("error ") + std::strerror(errno) + "\n");
+      close(connFd);
+    }
+    else if (pid == 0)
+    {
+      child = true;
+      close(listenFd);
+      for (auto const &var : env)
+      {
+        size_t eq = var.find('=');
+        setenv(var.substr(0, eq).c_str(), var.substr(eq + 1).c_str(), 1);
+      }
+
+      // The children would otherwise share the temporary path of the
+      // fork server
+      common::SystemPaths::Instance()->ResetTmpInstancePath();
+
+      this->dataPtr->jobFd = connFd;
+      writeAll(connFd, "pid " + std::to_string(getpid()) + "\n");
+      _args = args;
+      break;
+    }
+    else
+    {
+      gzmsg << "Fork server job [" << pid << "] started\n";
+      close(connFd);
+    }
+  }
+
+  sigaction(SIGINT, &oldInt, nullptr);
+  sigaction(SIGTERM, &oldTerm, nullptr);
+
+  if (child)
+  {
+    // The update thread of the model database was stopped before forking
+    common::ModelDatabase::Instance()->Start();
+    return true;
+  }
+
+  close(listenFd);
+  unlink(path.c_str());
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+void ForkServer::Finish(int _status)
+{
+#ifndef _WIN32
+  if (this->dataPtr->jobFd < 0)
+    return;
+
+  writeAll(this->dataPtr->jobFd, "exit " + std::to_string(_status) + "\n");
+  close(this->dataPtr->jobFd);
+  this->dataPtr->jobFd = -1;
+#endif
+}
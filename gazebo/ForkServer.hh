@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_FORKSERVER_HH_
+#define GAZEBO_FORKSERVER_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private data class
+  class ForkServerPrivate;
+
+  /// \class ForkServer ForkServer.hh gazebo_core.hh
+  /// \brief Warmed up gzserver process that forks a server per job.
+  ///
+  /// Started with `gzserver --fork-server <socket>`, the process loads
+  /// the plugin libraries given with --preload, and the model SDF and
+  /// meshes of the worlds given with --preload-world. It then waits for
+  /// jobs on a Unix socket, and forks a child per job, which shares the
+  /// loaded memory copy-on-write and runs a normal server.
+  ///
+  /// A job is a list of lines ended by an empty line: `arg <value>` for
+  /// each gzserver argument, and `env <name>=<value>` for each variable
+  /// to set in the child, such as GAZEBO_MASTER_URI. The child answers
+  /// `pid <pid>`, and `exit <status>` when the server stops.
+  ///
+  /// Transport, rendering and sensors are started by each child, since
+  /// their threads and graphics contexts don't survive a fork.
+  class GAZEBO_VISIBLE ForkServer
+  {
+    /// \brief Constructor.
+    public: ForkServer();
+
+    /// \brief Destructor.
+    public: virtual ~ForkServer();
+
+    /// \brief Get whether the command line asks for a fork server.
+    /// \param[in] _argc Number of arguments.
+    /// \param[in] _argv Array of argument values.
+    /// \return True if --fork-server is given.
+    public: static bool Requested(int _argc, char **_argv);
+
+    /// \brief Parse the fork server options and load the preloaded
+    /// libraries and assets.
+    /// \param[in] _argc Number of arguments.
+    /// \param[in] _argv Array of argument values.
+    /// \return True on success.
+    public: bool Load(int _argc, char **_argv);
+
+    /// \brief Serve jobs until SIGINT or SIGTERM.
+    /// \param[out] _args In a forked child, the gzserver arguments of its
+    /// job.
+    /// \return True in a forked child, which should run the job. False
+    /// in the fork server once it stops.
+    public: bool Run(std::vector<std::string> &_args);
+
+    /// \brief Report the exit status of the job of a forked child.
+    /// \param[in] _status Exit status of the server.
+    public: void Finish(int _status);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<ForkServerPrivate> dataPtr;
+  };
+}
+#endif
@@ -16,8 +16,11 @@
 */
 
 #include <functional>
+#include <iterator>
 #include <thread>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
@@ -41,6 +44,28 @@ namespace gazebo
     /// \brief All the known subscribers.
     gazebo::Master::SubList subscribers;
 
+    /// \brief The publishers of each topic, in the order of the
+    /// publishers list.
+    std::unordered_map<std::string,
+        std::vector<gazebo::Master::PubList::iterator>> publishersByTopic;
+
+    /// \brief The subscribers of each topic, in the order of the
+    /// subscribers list.
+    std::unordered_map<std::string,
+        std::vector<gazebo::Master::SubList::iterator>> subscribersByTopic;
+
+    /// \brief New publishers that every connection must be told about.
+    msgs::Publishers pendingAdds;
+
+    /// \brief New publishers that each subscribing connection must be
+    /// told about.
+    std::map<transport::ConnectionPtr, msgs::Publishers> pendingAdvertises;
+
+    /// \brief Connections that asked for batched publisher notifications.
+    /// The others get a publisher_add or publisher_advertise message per
+    /// publisher, which is all that older clients understand.
+    std::set<transport::ConnectionPtr> batchingConnections;
+
     /// \brief All the known connections.
     gazebo::Master::Connection_M connections;
 
@@ -116,21 +141,26 @@ void Master::OnAccept(transport::ConnectionPtr _newConnection)
   _newConnection->EnqueueMsg(msgs::Package("topic_namepaces_init",
                               namespacesMsg), true);
 
-  // Send all the publishers
-  msgs::Publishers publishersMsg;
-  PubList::iterator pubiter;
-  for (pubiter = this->dataPtr->publishers.begin();
-       pubiter != this->dataPtr->publishers.end(); ++pubiter)
-  {
-    msgs::Publish *pub = publishersMsg.add_publisher();
-    pub->CopyFrom(pubiter->first);
-  }
-  _newConnection->EnqueueMsg(
-      msgs::Package("publishers_init", publishersMsg), true);
-
   // Add the connection to our list
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+    // Tell the other connections about the new publishers first, since the
+    // new connection gets all of them at once.
+    this->SendPendingNotifications();
+
+    // Send all the publishers
+    msgs::Publishers publishersMsg;
+    PubList::iterator pubiter;
+    for (pubiter = this->dataPtr->publishers.begin();
+         pubiter != this->dataPtr->publishers.end(); ++pubiter)
+    {
+      msgs::Publish *pub = publishersMsg.add_publisher();
+      pub->CopyFrom(pubiter->first);
+    }
+    _newConnection->EnqueueMsg(
+        msgs::Package("publishers_init", publishersMsg), true);
+
     int index = this->dataPtr->connections.size();
 
     this->dataPtr->connections[index] = _newConnection;
@@ -177,17 +207,68 @@ void Master::OnRead(const unsigned int _connectionIndex,
 void Master::SendSubscribers(const std::string &_topic,
                              const std::string &_buffer)
 {
+  auto subs = this->dataPtr->subscribersByTopic.find(_topic);
+  if (subs == this->dataPtr->subscribersByTopic.end())
+    return;
+
   // Find all subscribers for this topic
   std::set<transport::ConnectionPtr> uniqueConnections;
-  for (auto const &subscriber : this->dataPtr->subscribers)
-    if (subscriber.first.topic() == _topic)
-      uniqueConnections.insert(subscriber.second);
+  for (auto const &subscriber : subs->second)
+    uniqueConnections.insert(subscriber->second);
 
   // Send message to all unique connections
   for (auto &conn : uniqueConnections)
     conn->EnqueueMsg(_buffer);
 }
 
+//////////////////////////////////////////////////
+void Master::SendPendingNotifications()
+{
+  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+
+  if (this->dataPtr->pendingAdds.publisher_size() > 0)
+  {
+    const std::string batch =
+      msgs::Package("publishers_add", this->dataPtr->pendingAdds);
+
+    std::vector<std::string> singles;
+    for (auto const &pub : this->dataPtr->pendingAdds.publisher())
+      singles.push_back(msgs::Package("publisher_add", pub));
+
+    for (auto &conn : this->dataPtr->connections)
+    {
+      if (this->dataPtr->batchingConnections.count(conn.second))
+      {
+        conn.second->EnqueueMsg(batch);
+      }
+      else
+      {
+        for (auto const &single : singles)
+          conn.second->EnqueueMsg(single);
+      }
+    }
+    this->dataPtr->pendingAdds.Clear();
+  }
+
+  for (auto &advertise : this->dataPtr->pendingAdvertises)
+  {
+    if (this->dataPtr->batchingConnections.count(advertise.first))
+    {
+      advertise.first->EnqueueMsg(
+          msgs::Package("publishers_advertise", advertise.second));
+    }
+    else
+    {
+      for (auto const &pub : advertise.second.publisher())
+      {
+        advertise.first->EnqueueMsg(
+            msgs::Package("publisher_advertise", pub));
+      }
+    }
+  }
+  this->dataPtr->pendingAdvertises.clear();
+}
+
 //////////////////////////////////////////////////
 void Master::ProcessMessage(const unsigned int _connectionIndex,
                             const std::string &_data)
@@ -200,6 +281,11 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
   msgs::Packet packet;
   packet.ParseFromString(_data);
 
+  // New publishers are announced in batches. Send them before a message
+  // whose notifications must come after them, e.g. an unadvertise.
+  if (packet.type() != "advertise" && packet.type() != "subscribe")
+    this->SendPendingNotifications();
+
   if (packet.type() == "register_topic_namespace")
   {
     msgs::GzString worldNameMsg;
@@ -230,17 +316,32 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     msgs::Publish pub;
     pub.ParseFromString(packet.serialized_data());
 
-    Connection_M::iterator iter2;
-    for (iter2 = this->dataPtr->connections.begin();
-         iter2 != this->dataPtr->connections.end(); ++iter2)
-    {
-      iter2->second->EnqueueMsg(msgs::Package("publisher_add", pub));
-    }
+    // Every connection learns about the publisher, and the connections
+    // that subscribe to the topic connect to it.
+    this->dataPtr->pendingAdds.add_publisher()->CopyFrom(pub);
 
     this->dataPtr->publishers.push_back(std::make_pair(pub, conn));
+    this->dataPtr->publishersByTopic[pub.topic()].push_back(
+        std::prev(this->dataPtr->publishers.end()));
+
+    auto subs = this->dataPtr->subscribersByTopic.find(pub.topic());
+    if (subs != this->dataPtr->subscribersByTopic.end())
+    {
+      std::set<transport::ConnectionPtr> uniqueConnections;
+      for (auto const &subscriber : subs->second)
+        uniqueConnections.insert(subscriber->second);
 
-    this->SendSubscribers(pub.topic(),
-        msgs::Package("publisher_advertise", pub));
+      for (auto &subConn : uniqueConnections)
+      {
+        this->dataPtr->pendingAdvertises[subConn].add_publisher()->CopyFrom(
+            pub);
+      }
+    }
+  }
+  else if (packet.type() == "publishers_batching")
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
+    this->dataPtr->batchingConnections.insert(conn);
   }
   else if (packet.type() == "unadvertise")
   {
@@ -260,14 +361,14 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
     sub.ParseFromString(packet.serialized_data());
 
     this->dataPtr->subscribers.push_back(std::make_pair(sub, conn));
-
-    PubList::iterator iter;
+    this->dataPtr->subscribersByTopic[sub.topic()].push_back(
+        std::prev(this->dataPtr->subscribers.end()));
 
     // Find all publishers of the topic
-    for (iter = this->dataPtr->publishers.begin();
-        iter != this->dataPtr->publishers.end(); ++iter)
+    auto pubs = this->dataPtr->publishersByTopic.find(sub.topic());
+    if (pubs != this->dataPtr->publishersByTopic.end())
     {
-      if (iter->first.topic() == sub.topic())
+      for (auto const &iter : pubs->second)
       {
         conn->EnqueueMsg(msgs::Package("publisher_subscribe", iter->first));
       }
@@ -296,18 +397,12 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::GzString_V msg;
 
       // Add all topics that are published
-      for (PubList::iterator iter = this->dataPtr->publishers.begin();
-          iter != this->dataPtr->publishers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &pubs : this->dataPtr->publishersByTopic)
+        topics.insert(pubs.first);
 
       // Add all topics that are subscribed
-      for (SubList::iterator iter = this->dataPtr->subscribers.begin();
-           iter != this->dataPtr->subscribers.end(); ++iter)
-      {
-        topics.insert(iter->first.topic());
-      }
+      for (auto const &subs : this->dataPtr->subscribersByTopic)
+        topics.insert(subs.first);
 
       // Construct the message of only unique names
       for (std::set<std::string>::iterator iter =
@@ -325,14 +420,11 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       msgs::TopicInfo ti;
       ti.set_msg_type(pub.msg_type());
 
-      PubList::iterator piter;
-      SubList::iterator siter;
-
       // Find all publishers of the topic
-      for (piter = this->dataPtr->publishers.begin();
-          piter != this->dataPtr->publishers.end(); ++piter)
+      auto pubs = this->dataPtr->publishersByTopic.find(req.data());
+      if (pubs != this->dataPtr->publishersByTopic.end())
       {
-        if (piter->first.topic() == req.data())
+        for (auto const &piter : pubs->second)
         {
           msgs::Publish *pubPtr = ti.add_publisher();
           pubPtr->CopyFrom(piter->first);
@@ -340,10 +432,10 @@ void Master::ProcessMessage(const unsigned int _connectionIndex,
       }
 
       // Find all subscribers of the topic
-      for (siter = this->dataPtr->subscribers.begin();
-          siter != this->dataPtr->subscribers.end(); ++siter)
+      auto subs = this->dataPtr->subscribersByTopic.find(req.data());
+      if (subs != this->dataPtr->subscribersByTopic.end())
       {
-        if (siter->first.topic() == req.data())
+        for (auto const &siter : subs->second)
         {
           // If the topic info message type has not been set or the
           // topic info message type is an empty string, then set the topic
@@ -410,6 +502,9 @@ void Master::RunOnce()
     }
   }
 
+  // Announce the publishers advertised by the messages at once
+  this->SendPendingNotifications();
+
   // Process all the connections
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->connectionMutex);
@@ -450,45 +545,40 @@ void Master::RemoveConnection(Connection_M::iterator _connIter)
     }
   }
 
-  // Remove all publishers for this connection
-  bool done = false;
-  while (!done)
+  // Nothing waits to be sent to the connection anymore
+  this->dataPtr->pendingAdvertises.erase(_connIter->second);
+  this->dataPtr->batchingConnections.erase(_connIter->second);
+
+  // Remove all publishers for this connection. A publisher that was
+  // advertised twice is removed once.
+  std::set<std::string> removed;
+  std::vector<msgs::Publish> pubs;
+  for (auto const &pub : this->dataPtr->publishers)
   {
-    done = true;
-    PubList::iterator pubIter = this->dataPtr->publishers.begin();
-    while (pubIter != this->dataPtr->publishers.end())
+    if (pub.second->GetId() == _connIter->second->GetId() &&
+        removed.insert(pub.first.topic() + "@" + pub.first.host() + ":" +
+        std::to_string(pub.first.port())).second)
     {
-      if ((*pubIter).second->GetId() == _connIter->second->GetId())
-      {
-        this->RemovePublisher((*pubIter).first);
-        done = false;
-        break;
-      }
-      else
-        ++pubIter;
+      pubs.push_back(pub.first);
     }
   }
+  for (auto const &pub : pubs)
+    this->RemovePublisher(pub);
 
-
-  done = false;
-  while (!done)
+  // Remove all subscribers for this connection
+  removed.clear();
+  std::vector<msgs::Subscribe> subs;
+  for (auto const &sub : this->dataPtr->subscribers)
   {
-    done = true;
-
-    // Remove all subscribers for this connection
-    SubList::iterator subIter = this->dataPtr->subscribers.begin();
-    while (subIter != this->dataPtr->subscribers.end())
+    if (sub.second->GetId() == _connIter->second->GetId() &&
+        removed.insert(sub.first.topic() + "@" + sub.first.host() + ":" +
+        std::to_string(sub.first.port())).second)
     {
-      if ((*subIter).second->GetId() == _connIter->second->GetId())
-      {
-        this->RemoveSubscriber((*subIter).first);
-        done = false;
-        break;
-      }
-      else
-        ++subIter;
+      subs.push_back(sub.first);
     }
   }
+  for (auto const &sub : subs)
+    this->RemoveSubscriber(sub);
 
   this->dataPtr->connections.erase(_connIter);
 }
@@ -508,46 +598,58 @@ void Master::RemovePublisher(const msgs::Publish _pub)
 
   this->SendSubscribers(_pub.topic(), msgs::Package("unadvertise", _pub));
 
-  PubList::iterator pubIter = this->dataPtr->publishers.begin();
-  while (pubIter != this->dataPtr->publishers.end())
+  auto pubs = this->dataPtr->publishersByTopic.find(_pub.topic());
+  if (pubs == this->dataPtr->publishersByTopic.end())
+    return;
+
+  auto pubIter = pubs->second.begin();
+  while (pubIter != pubs->second.end())
   {
-    if (pubIter->first.topic() == _pub.topic() &&
-        pubIter->first.host() == _pub.host() &&
-        pubIter->first.port() == _pub.port())
+    if ((*pubIter)->first.host() == _pub.host() &&
+        (*pubIter)->first.port() == _pub.port())
     {
-      pubIter = this->dataPtr->publishers.erase(pubIter);
+      this->dataPtr->publishers.erase(*pubIter);
+      pubIter = pubs->second.erase(pubIter);
     }
     else
       ++pubIter;
   }
+
+  if (pubs->second.empty())
+    this->dataPtr->publishersByTopic.erase(pubs);
 }
 
 /////////////////////////////////////////////////
 void Master::RemoveSubscriber(const msgs::Subscribe _sub)
 {
   // Find all publishers of the topic, and remove the subscriptions
-  for (PubList::iterator iter = this->dataPtr->publishers.begin();
-      iter != this->dataPtr->publishers.end(); ++iter)
+  auto pubs = this->dataPtr->publishersByTopic.find(_sub.topic());
+  if (pubs != this->dataPtr->publishersByTopic.end())
   {
-    if (iter->first.topic() == _sub.topic())
-    {
+    for (auto const &iter : pubs->second)
       iter->second->EnqueueMsg(msgs::Package("unsubscribe", _sub));
-    }
   }
 
   // Remove the subscribers from our list
-  SubList::iterator subiter = this->dataPtr->subscribers.begin();
-  while (subiter != this->dataPtr->subscribers.end())
+  auto subs = this->dataPtr->subscribersByTopic.find(_sub.topic());
+  if (subs == this->dataPtr->subscribersByTopic.end())
+    return;
+
+  auto subiter = subs->second.begin();
+  while (subiter != subs->second.end())
   {
-    if (subiter->first.topic() == _sub.topic() &&
-        subiter->first.host() == _sub.host() &&
-        subiter->first.port() == _sub.port())
+    if ((*subiter)->first.host() == _sub.host() &&
+        (*subiter)->first.port() == _sub.port())
     {
-      subiter = this->dataPtr->subscribers.erase(subiter);
+      this->dataPtr->subscribers.erase(*subiter);
+      subiter = subs->second.erase(subiter);
     }
     else
       ++subiter;
   }
+
+  if (subs->second.empty())
+    this->dataPtr->subscribersByTopic.erase(subs);
 }
 
 //////////////////////////////////////////////////
@@ -580,6 +682,11 @@ void Master::Fini()
   this->dataPtr->connections.clear();
   this->dataPtr->subscribers.clear();
   this->dataPtr->publishers.clear();
+  this->dataPtr->subscribersByTopic.clear();
+  this->dataPtr->publishersByTopic.clear();
+  this->dataPtr->pendingAdds.Clear();
+  this->dataPtr->pendingAdvertises.clear();
+  this->dataPtr->batchingConnections.clear();
 }
 
 //////////////////////////////////////////////////
@@ -587,18 +694,10 @@ msgs::Publish Master::GetPublisher(const std::string &_topic)
 {
   msgs::Publish msg;
 
-  PubList::iterator iter;
-
-  // Find all publishers of the topic
-  for (iter = this->dataPtr->publishers.begin();
-       iter != this->dataPtr->publishers.end(); ++iter)
-  {
-    if (iter->first.topic() == _topic)
-    {
-      msg = iter->first;
-      break;
-    }
-  }
+  // Find the first publisher of the topic
+  auto pubs = this->dataPtr->publishersByTopic.find(_topic);
+  if (pubs != this->dataPtr->publishersByTopic.end() && !pubs->second.empty())
+    msg = pubs->second.front()->first;
 
   return msg;
 }
@@ -83,6 +83,14 @@ namespace gazebo
     private: void SendSubscribers(const std::string &_topic,
                                   const std::string &_buffer);
 
+    /// \brief Send the notifications of new publishers that were batched
+    /// since the last call to every connection, and of their topics to
+    /// each connection that subscribes to them. Connections that sent a
+    /// publishers_batching message get one publishers_add and one
+    /// publishers_advertise message, the others a publisher_add and a
+    /// publisher_advertise message per publisher.
+    private: void SendPendingNotifications();
+
     /// \brief Process a message
     /// \param[in] _connectionIndex Index of the connection which generated the
     /// message
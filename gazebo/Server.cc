@@ -24,7 +24,13 @@
 
 #include <stdio.h>
 #include <signal.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <mutex>
+#include <set>
+#include <string>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
@@ -46,14 +52,23 @@
 #include "gazebo/gazebo.hh"
 #include "gazebo/transport/transport.hh"
 
+#include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/util/LogRecord.hh"
 #include "gazebo/util/LogPlay.hh"
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/ModelSdfCache.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/CompiledSdf.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/MemoryAccounts.hh"
+#include "gazebo/common/PluginCosts.hh"
+#include "gazebo/common/StartupProfiler.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/common/URI.hh"
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -89,6 +104,37 @@ namespace gazebo
     /// \brief Publisher for world modifications.
     transport::PublisherPtr worldModPub;
 
+    /// \brief Publisher for the metrics of the transport connections.
+    transport::PublisherPtr connectionStatsPub;
+
+    /// \brief Wall time of the last connection metrics published.
+    common::Time connectionStatsTime;
+
+    /// \brief Publisher for the memory accounts.
+    transport::PublisherPtr memoryStatsPub;
+
+    /// \brief Wall time of the last memory accounts published.
+    common::Time memoryStatsTime;
+
+    /// \brief Wall time between two dumps of the memory accounts to the
+    /// log directory, 0 to never dump them.
+    common::Time memoryDumpPeriod;
+
+    /// \brief Wall time of the last dump of the memory accounts.
+    common::Time memoryDumpTime;
+
+    /// \brief Publisher for the costs of the plugins.
+    transport::PublisherPtr pluginCostsPub;
+
+    /// \brief Wall time of the last plugin costs published.
+    common::Time pluginCostsTime;
+
+    /// \brief True to time the plugin callbacks even if nobody listens.
+    bool pluginCosts = false;
+
+    /// \brief Introspection items of the most costly plugins.
+    std::vector<std::string> pluginCostItems;
+
     /// \brief Mutex to protect controlMsgs.
     std::mutex receiveMutex;
 
@@ -112,11 +158,63 @@ namespace gazebo
 
     /// \brief Set whether to lockstep physics and rendering
     bool lockstep = false;
+
+    /// \brief Number of copies of each world to load.
+    unsigned int instances = 1;
   };
 }
 
 bool ServerPrivate::stop = true;
 
+/////////////////////////////////////////////////
+/// \brief Get the model URIs referenced by a world file.
+/// \param[in] _filename Path to the world file.
+/// \return URIs that start with model://, without duplicates.
+static std::vector<std::string> worldModelURIs(const std::string &_filename)
+{
+  std::set<std::string> uris;
+  std::ifstream file(_filename.c_str());
+  const std::string text((std::istreambuf_iterator<char>(file)),
+      std::istreambuf_iterator<char>());
+
+  const std::string scheme = "model://";
+  for (size_t start = text.find(scheme); start != std::string::npos;
+       start = text.find(scheme, start + scheme.size()))
+  {
+    size_t end = text.find_first_of(" \t\r\n<>\"'", start);
+    uris.insert(text.substr(start, end == std::string::npos ?
+          std::string::npos : end - start));
+  }
+
+  return std::vector<std::string>(uris.begin(), uris.end());
+}
+
+/////////////////////////////////////////////////
+/// \brief Write the loaded world to a compiled file.
+/// \param[in] _filename Path of the compiled file.
+/// \return True if the file was written.
+static bool compileWorld(const std::string &_filename)
+{
+  physics::WorldPtr world = physics::get_world();
+  if (!world)
+  {
+    gzerr << "No world to compile\n";
+    return false;
+  }
+
+  // The initial state and full asset paths, so that the compiled world
+  // doesn't depend on the model path
+  sdf::ElementPtr worldSDF = world->SDF()->Clone();
+  common::convertToFullPaths(worldSDF);
+
+  if (!common::CompiledSdf::Write(worldSDF, _filename))
+    return false;
+
+  gzmsg << "Compiled world [" << world->Name() << "] to [" << _filename
+        << "]\n";
+  return true;
+}
+
 /////////////////////////////////////////////////
 Server::Server()
   : dataPtr(new ServerPrivate())
@@ -159,15 +257,22 @@ bool Server::ParseArgs(int _argc, char **_argv)
   visibleDesc.add_options()
     ("version,v", "Output version information.")
     ("verbose", "Increase the messages written to the terminal.")
+    ("async-log", "Write the messages from a background thread, and count "
+     "the repeats of a message instead of writing them.")
     ("help,h", "Produce this help message.")
     ("pause,u", "Start the server in a paused state.")
     ("lockstep", "Lockstep simulation so sensor update rates are respected.")
+    ("instances", po::value<unsigned int>(),
+     "Number of copies of each world to run in parallel.")
     ("physics,e", po::value<std::string>(),
      "Specify a physics engine (ode|bullet|dart|simbody).")
     ("play,p", po::value<std::string>(), "Play a log file.")
     ("record,r", "Record state data.")
     ("record_encoding", po::value<std::string>()->default_value("zlib"),
      "Compression encoding format for log data (zlib|bz2|txt).")
+    ("record_format", po::value<std::string>()->default_value("sdf"),
+     "Format of the state frames (sdf|frames). frames stores the poses in "
+     "a compact binary form that older versions can't play back.")
     ("record_path", po::value<std::string>()->default_value(""),
      "Absolute path in which to store state data")
     ("record_period", po::value<double>()->default_value(-1),
@@ -175,13 +280,32 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("record_filter", po::value<std::string>()->default_value(""),
      "Recording filter (supports wildcard and regular expression).")
     ("record_resources", "Recording with model meshes and materials.")
+    ("record_topic", po::value<std::vector<std::string> >()->composing(),
+     "Record the messages of a topic into topics.tlog, next to the state "
+     "log. Can be given several times.")
+    ("memory_dump_period", po::value<double>()->default_value(0),
+     "Wall time in seconds between two dumps of the memory accounts to "
+     "memory.log in the log directory, 0 to never dump them.")
+    ("plugin_costs", "Time the event callbacks of the plugins from the "
+     "start, rather than only while someone listens to them.")
+    ("thread_config", po::value<std::string>(),
+     "CPU affinity, NUMA node, scheduling policy, priority and pool size "
+     "of the thread classes, such as \"physics:cpus=0-3,policy=fifo,"
+     "priority=50;io:cpus=4-7;tasks:pool=8\". Overrides "
+     "GAZEBO_THREAD_CONFIG.")
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
     ("profile,o", po::value<std::string>(),
-     "Physics preset profile name from the options in the world file.");
+     "Physics preset profile name from the options in the world file.")
+    ("startup-profile", po::value<std::string>(),
+     "Write a Chrome trace of the startup phases to a file, and a summary "
+     "table next to it.")
+    ("compile-world", po::value<std::string>(),
+     "Write the world to a compiled file after it is initialized, and "
+     "exit. gzserver loads a compiled world without parsing SDF.");
 
   po::options_description hiddenDesc("Hidden options");
   hiddenDesc.add_options()
@@ -238,6 +362,24 @@ bool Server::ParseArgs(int _argc, char **_argv)
     gazebo::common::Console::SetQuiet(false);
   }
 
+  if (this->dataPtr->vm.count("async-log"))
+    gazebo::common::Console::SetAsync(true);
+
+  if (this->dataPtr->vm.count("startup-profile"))
+  {
+    common::StartupProfiler::Instance()->Start(
+        this->dataPtr->vm["startup-profile"].as<std::string>());
+  }
+
+  if (this->dataPtr->vm.count("thread_config") &&
+      !common::ThreadConfig::Instance()->Parse(
+        this->dataPtr->vm["thread_config"].as<std::string>()))
+  {
+    std::cerr << "Error. Invalid thread configuration\n";
+    return false;
+  }
+  common::ThreadConfig::Instance()->InitTaskPool();
+
   if (this->dataPtr->vm.count("minimal_comms"))
     gazebo::transport::setMinimalComms(true);
   else
@@ -280,6 +422,12 @@ bool Server::ParseArgs(int _argc, char **_argv)
       this->dataPtr->params["record_resources"] = "true";
   }
 
+  this->dataPtr->memoryDumpPeriod = std::max(0.0,
+      this->dataPtr->vm["memory_dump_period"].as<double>());
+
+  this->dataPtr->pluginCosts = this->dataPtr->vm.count("plugin_costs") > 0;
+  common::PluginCosts::SetEnabled(this->dataPtr->pluginCosts);
+
   if (this->dataPtr->vm.count("iters"))
   {
     try
@@ -301,6 +449,12 @@ bool Server::ParseArgs(int _argc, char **_argv)
   }
   rendering::set_lockstep_enabled(this->dataPtr->lockstep);
 
+  if (this->dataPtr->vm.count("instances"))
+  {
+    this->dataPtr->instances =
+        std::max(1u, this->dataPtr->vm["instances"].as<unsigned int>());
+  }
+
   if (!this->PreLoad())
   {
     gzerr << "Unable to load gazebo\n";
@@ -364,20 +518,33 @@ bool Server::ParseArgs(int _argc, char **_argv)
     if (this->dataPtr->vm.count("profile"))
     {
       std::string profileName = this->dataPtr->vm["profile"].as<std::string>();
-      if (physics::get_world()->PresetMgr()->HasProfile(profileName))
+      for (auto const &world : physics::get_worlds())
       {
-        physics::get_world()->PresetMgr()->CurrentProfile(profileName);
-        gzmsg << "Setting physics profile to [" << profileName << "]."
-              << std::endl;
-      }
-      else
-      {
-        gzerr << "Specified profile [" << profileName << "] was not found."
-              << std::endl;
+        if (world->PresetMgr()->HasProfile(profileName))
+        {
+          world->PresetMgr()->CurrentProfile(profileName);
+          gzmsg << "Setting physics profile of world [" << world->Name()
+                << "] to [" << profileName << "]." << std::endl;
+        }
+        else
+        {
+          gzerr << "Specified profile [" << profileName << "] was not found "
+                << "in world [" << world->Name() << "]." << std::endl;
+        }
       }
     }
   }
 
+  if (this->dataPtr->vm.count("compile-world"))
+  {
+    if (!compileWorld(this->dataPtr->vm["compile-world"].as<std::string>()))
+      return false;
+
+    // Nothing to run
+    this->dataPtr->stop = true;
+    return true;
+  }
+
   this->ProcessParams();
 
   return true;
@@ -393,6 +560,8 @@ bool Server::GetInitialized() const
 bool Server::LoadFile(const std::string &_filename,
                       const std::string &_physics)
 {
+  common::StartupScope startupScope("Server::LoadFile", _filename);
+
   // Load the world file
   sdf::SDFPtr sdf(new sdf::SDF);
   if (!sdf::init(sdf))
@@ -443,7 +612,31 @@ bool Server::LoadFile(const std::string &_filename,
     }
     fclose(test);
 
-    if (!sdf::readFile(common::find_file(filename), sdf))
+    // A compiled world is read without parsing SDF, and its asset paths
+    // are resolved already
+    if (common::CompiledSdf::IsCompiled(common::find_file(filename)))
+    {
+      common::StartupScope readScope("CompiledSdf::Read", filename);
+      if (!common::CompiledSdf::Read(common::find_file(filename), sdf))
+      {
+        gzerr << "Unable to read compiled world file[" << filename << "]\n";
+        return false;
+      }
+      return this->LoadImpl(sdf->Root(), _physics);
+    }
+
+    // Download the missing models of the world in parallel, rather than
+    // one at a time while the world is parsed
+    {
+      common::StartupScope downloadScope("ModelDatabase::DownloadModels");
+      common::ModelDatabase::Instance()->DownloadModels(
+          worldModelURIs(common::find_file(filename)));
+    }
+
+    // Repeated model:// includes are parsed once, and cloned
+    common::StartupScope readScope("sdf::readFile", filename);
+    if (!common::ModelSdfCache::Instance()->ReadWorldFile(
+          common::find_file(filename), sdf))
     {
       gzerr << "Unable to read sdf file[" << filename << "]\n";
       return false;
@@ -476,6 +669,8 @@ bool Server::LoadString(const std::string &_sdfString)
 /////////////////////////////////////////////////
 bool Server::PreLoad()
 {
+  common::StartupScope startupScope("Server::PreLoad");
+
   // setup gazebo
   return gazebo::setupServer(this->dataPtr->systemPluginsArgc,
                              this->dataPtr->systemPluginsArgv);
@@ -485,42 +680,77 @@ bool Server::PreLoad()
 bool Server::LoadImpl(sdf::ElementPtr _elem,
                       const std::string &_physics)
 {
-  // If a physics engine is specified,
+  common::StartupScope startupScope("Server::LoadImpl");
+
+  // Check if physics engine name is valid
+  // This must be done after physics::load();
+  bool setPhysics = false;
   if (_physics.length())
   {
-    // Check if physics engine name is valid
-    // This must be done after physics::load();
     if (!physics::PhysicsFactory::IsRegistered(_physics))
     {
       gzerr << "Unregistered physics engine [" << _physics
             << "], the default will be used instead.\n";
     }
-    // Try inserting physics engine name if one is given
-    else if (_elem->HasElement("world") &&
-             _elem->GetElement("world")->HasElement("physics"))
-    {
-      _elem->GetElement("world")->GetElement("physics")
-           ->GetAttribute("type")->Set(_physics);
-    }
     else
-    {
-      gzerr << "Cannot set physics engine: <world> does not have <physics>\n";
-    }
+      setPhysics = true;
   }
 
-  sdf::ElementPtr worldElem = _elem->GetElement("world");
-  if (worldElem)
+  // Load every world of the description. Each world steps in its own
+  // thread and its topics are namespaced by its name, so the names must
+  // be unique. When several instances are requested, each copy of a world
+  // gets a suffix, such as "default_0" and "default_1".
+  std::set<std::string> worldNames;
+  sdf::ElementPtr worldElem;
+  if (_elem->HasElement("world"))
+    worldElem = _elem->GetElement("world");
+  for (; worldElem; worldElem = worldElem->GetNextElement("world"))
   {
-    physics::WorldPtr world = physics::create_world();
-
-    // Create the world
-    try
+    // Try inserting physics engine name if one is given
+    if (setPhysics)
     {
-      physics::load_world(world, worldElem);
+      if (worldElem->HasElement("physics"))
+      {
+        worldElem->GetElement("physics")->GetAttribute("type")->Set(
+            _physics);
+      }
+      else
+      {
+        gzerr << "Cannot set physics engine: <world> does not have "
+              << "<physics>\n";
+      }
     }
-    catch(common::Exception &e)
+
+    const std::string worldName = worldElem->Get<std::string>("name");
+    for (unsigned int i = 0; i < this->dataPtr->instances; ++i)
     {
-      gzthrow("Failed to load the World\n"  << e);
+      sdf::ElementPtr instanceElem = worldElem;
+      std::string instanceName = worldName;
+      if (this->dataPtr->instances > 1)
+      {
+        instanceName += "_" + std::to_string(i);
+        instanceElem = worldElem->Clone();
+        instanceElem->GetAttribute("name")->Set(instanceName);
+      }
+
+      if (!worldNames.insert(instanceName).second)
+      {
+        gzerr << "Duplicate world name [" << instanceName << "], "
+              << "the world won't be loaded.\n";
+        continue;
+      }
+
+      physics::WorldPtr world = physics::create_world();
+
+      // Create the world
+      try
+      {
+        physics::load_world(world, instanceElem);
+      }
+      catch(common::Exception &e)
+      {
+        gzthrow("Failed to load the World\n"  << e);
+      }
     }
   }
 
@@ -532,16 +762,28 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
 
   this->dataPtr->worldModPub =
     this->dataPtr->node->Advertise<msgs::WorldModify>("/gazebo/world/modify");
+  this->dataPtr->connectionStatsPub =
+    this->dataPtr->node->Advertise<msgs::ConnectionStatistics>(
+        "/gazebo/transport/connections");
+  this->dataPtr->memoryStatsPub =
+    this->dataPtr->node->Advertise<msgs::MemoryStatistics>("/gazebo/memory");
+  this->dataPtr->pluginCostsPub =
+    this->dataPtr->node->Advertise<msgs::PluginCosts>("/gazebo/plugin_costs");
+  this->RegisterPluginCostItems();
 
   common::Time waitTime(1, 0);
   int waitCount = 0;
   int maxWaitCount = 10;
 
   // Wait for namespaces.
-  while (!gazebo::transport::waitForNamespaces(waitTime) &&
-      (waitCount++) < maxWaitCount)
   {
-    gzwarn << "Waited " << waitTime.Double() << "seconds for namespaces.\n";
+    common::StartupScope waitScope("transport::waitForNamespaces");
+    while (!gazebo::transport::waitForNamespaces(waitTime) &&
+        (waitCount++) < maxWaitCount)
+    {
+      gzwarn << "Waited " << waitTime.Double()
+             << "seconds for namespaces.\n";
+    }
   }
 
   if (waitCount >= maxWaitCount)
@@ -581,6 +823,9 @@ void Server::Stop()
 void Server::Fini()
 {
   this->Stop();
+  for (auto const &item : this->dataPtr->pluginCostItems)
+    util::IntrospectionManager::Instance()->Unregister(item);
+  this->dataPtr->pluginCostItems.clear();
   gazebo::shutdown();
 }
 
@@ -613,7 +858,10 @@ void Server::Run()
 
   // Make sure the sensors are updated once before running the world.
   // This makes sure plugins get loaded properly.
-  sensors::run_once(true);
+  {
+    common::StartupScope startupScope("Server::InitSensors");
+    sensors::run_once(true);
+  }
 
   // Run the sensor threads
   sensors::run_threads();
@@ -653,6 +901,9 @@ void Server::Run()
     //   gzerr << "time out reached!" << std::endl;
 
     this->ProcessControlMsgs();
+    this->PublishConnectionStats();
+    this->PublishMemoryStats();
+    this->PublishPluginCosts();
     IGN_PROFILE_END();
 
     if (physics::worlds_running())
@@ -661,6 +912,16 @@ void Server::Run()
       sensors::run_once();
       IGN_PROFILE_END();
     }
+
+    // The startup ends once every world has loaded its plugins
+    if (common::StartupProfiler::Instance()->Enabled())
+    {
+      bool loaded = true;
+      for (auto const &world : physics::get_worlds())
+        loaded = loaded && world->PluginsLoaded();
+      if (loaded)
+        common::StartupProfiler::Instance()->Finish();
+    }
     else if (sensors::running())
     {
       IGN_PROFILE_BEGIN("stop");
@@ -691,11 +952,17 @@ void Server::ProcessParams()
       util::LogRecordParams params;
 
       params.encoding = this->dataPtr->params["record_encoding"];
+      params.format = this->dataPtr->vm["record_format"].as<std::string>();
       params.path = iter->second;
       params.period = this->dataPtr->vm["record_period"].as<double>();
       params.filter = this->dataPtr->vm["record_filter"].as<std::string>();
       params.recordResources =
           this->dataPtr->params.count("record_resources") > 0;
+      if (this->dataPtr->vm.count("record_topic"))
+      {
+        params.topics =
+          this->dataPtr->vm["record_topic"].as<std::vector<std::string> >();
+      }
       util::LogRecord::Instance()->Start(params);
     }
   }
@@ -716,6 +983,130 @@ void Server::OnControl(ConstServerControlPtr &_msg)
   this->dataPtr->controlMsgs.push_back(*_msg);
 }
 
+/////////////////////////////////////////////////
+void Server::PublishConnectionStats()
+{
+  if (!this->dataPtr->connectionStatsPub ||
+      !this->dataPtr->connectionStatsPub->HasConnections())
+  {
+    return;
+  }
+
+  common::Time now = common::Time::GetWallTime();
+  if (now - this->dataPtr->connectionStatsTime < common::Time(1, 0))
+    return;
+  this->dataPtr->connectionStatsTime = now;
+
+  msgs::ConnectionStatistics msg;
+  transport::ConnectionManager::Instance()->GetConnectionStats(msg);
+  this->dataPtr->connectionStatsPub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void Server::PublishMemoryStats()
+{
+  common::Time now = common::Time::GetWallTime();
+
+  if (this->dataPtr->memoryDumpPeriod > common::Time::Zero &&
+      now - this->dataPtr->memoryDumpTime >= this->dataPtr->memoryDumpPeriod)
+  {
+    this->dataPtr->memoryDumpTime = now;
+    common::MemoryAccounts::Instance()->Dump(
+        common::SystemPaths::Instance()->GetLogPath() + "/memory.log");
+  }
+
+  if (!this->dataPtr->memoryStatsPub ||
+      !this->dataPtr->memoryStatsPub->HasConnections() ||
+      now - this->dataPtr->memoryStatsTime < common::Time(1, 0))
+  {
+    return;
+  }
+  this->dataPtr->memoryStatsTime = now;
+
+  msgs::MemoryStatistics msg;
+  msgs::Set(msg.mutable_stamp(), now);
+  for (auto const &sample : common::MemoryAccounts::Instance()->Samples())
+  {
+    msgs::MemoryStatistics::Account *account = msg.add_account();
+    account->set_name(sample.name);
+    account->set_bytes(sample.bytes);
+    account->set_objects(sample.objects);
+    account->set_peak_bytes(sample.peakBytes);
+  }
+  this->dataPtr->memoryStatsPub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void Server::PublishPluginCosts()
+{
+  const bool connected = this->dataPtr->pluginCostsPub &&
+      this->dataPtr->pluginCostsPub->HasConnections();
+  common::PluginCosts::SetEnabled(this->dataPtr->pluginCosts || connected);
+
+  common::Time now = common::Time::GetWallTime();
+  if (!connected || now - this->dataPtr->pluginCostsTime < common::Time(1, 0))
+    return;
+  this->dataPtr->pluginCostsTime = now;
+
+  msgs::PluginCosts msg;
+  msgs::Set(msg.mutable_stamp(), now);
+  for (auto const &sample : common::PluginCosts::Instance()->Top(50))
+  {
+    msgs::PluginCosts::Plugin *plugin = msg.add_plugin();
+    plugin->set_name(sample.name);
+    plugin->set_filename(sample.filename);
+    plugin->set_calls(sample.calls);
+    plugin->set_update_time(sample.updateTime);
+    plugin->set_max_time(sample.maxTime);
+    plugin->set_load_time(sample.loadTime);
+  }
+  this->dataPtr->pluginCostsPub->Publish(msg);
+}
+
+/////////////////////////////////////////////////
+void Server::RegisterPluginCostItems()
+{
+  // The plugins by rank, so that a filter can follow the most costly ones.
+  const unsigned int count = 10;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    auto rank = [i]()
+    {
+      auto top = common::PluginCosts::Instance()->Top(i + 1);
+      return top.size() > i ? top[i] : common::PluginCostSample();
+    };
+
+    common::URI uri("data://plugin_costs/top/" + std::to_string(i));
+
+    common::URI nameURI(uri);
+    nameURI.Query().Insert("p", "string/name");
+    this->dataPtr->pluginCostItems.push_back(nameURI.Str());
+    util::IntrospectionManager::Instance()->Register<std::string>(
+        nameURI.Str(), [rank]()
+        {
+          return rank().name;
+        });
+
+    common::URI timeURI(uri);
+    timeURI.Query().Insert("p", "double/update_time");
+    this->dataPtr->pluginCostItems.push_back(timeURI.Str());
+    util::IntrospectionManager::Instance()->Register<double>(
+        timeURI.Str(), [rank]()
+        {
+          return rank().updateTime;
+        });
+
+    common::URI callsURI(uri);
+    callsURI.Query().Insert("p", "double/calls");
+    this->dataPtr->pluginCostItems.push_back(callsURI.Str());
+    util::IntrospectionManager::Instance()->Register<double>(
+        callsURI.Str(), [rank]()
+        {
+          return static_cast<double>(rank().calls);
+        });
+  }
+}
+
 /////////////////////////////////////////////////
 void Server::ProcessControlMsgs()
 {
@@ -113,6 +113,22 @@ namespace gazebo
     /// \brief Handle all control messages.
     private: void ProcessControlMsgs();
 
+    /// \brief Publish the write queue metrics of the connections to
+    /// remote subscribers, once per second and only if someone listens.
+    private: void PublishConnectionStats();
+
+    /// \brief Publish the memory accounts once per second if someone
+    /// listens, and dump them to the log directory at the dump period.
+    private: void PublishMemoryStats();
+
+    /// \brief Time the plugin callbacks while someone listens to their
+    /// costs, and publish the most costly plugins once per second.
+    private: void PublishPluginCosts();
+
+    /// \brief Register the introspection items of the most costly
+    /// plugins, by rank.
+    private: void RegisterPluginCostItems();
+
     /// \internal
     /// \brief Pointer to private data.
     private: std::unique_ptr<ServerPrivate> dataPtr;
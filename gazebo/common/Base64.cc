@@ -38,114 +38,254 @@
    3. This notice may not be removed or altered from any source distribution.
 
    René Nyffenegger rene.nyffenegger@adp-gmbh.ch
+
+   Altered for Gazebo: the codec is table driven, writes into pre-sized
+   buffers and has SSSE3 loops for x86.
 */
+#include <cstdint>
+
+// The SSSE3 loops follow the lookup and multiply-add method of Wojciech
+// Muła and Alfred Klomp. They are compiled with target attributes and
+// chosen at run time.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GZ_BASE64_SSSE3 1
+#include <immintrin.h>
+#endif
+
 #include "gazebo/common/Base64.hh"
 
-static const std::string base64Chars =
+static const char base64Chars[] =
 "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
 "abcdefghijklmnopqrstuvwxyz"
 "0123456789+/";
 
+/// \brief Value of a character that isn't base64.
+static const uint8_t kInvalid = 0xff;
+
 /////////////////////////////////////////////////
-static inline bool IsBase64(unsigned char _c)
+/// \brief Build the table of the values of the base64 characters.
+struct DecodeTable
 {
-  return (isalnum(_c) || (_c == '+') || (_c == '/'));
+  /// \brief Constructor
+  DecodeTable()
+  {
+    for (int i = 0; i < 256; ++i)
+      this->values[i] = kInvalid;
+    for (uint8_t i = 0; i < 64; ++i)
+      this->values[static_cast<unsigned char>(base64Chars[i])] = i;
+  }
+
+  /// \brief Value of every character, kInvalid for '=' and the others.
+  uint8_t values[256];
+};
+
+/////////////////////////////////////////////////
+static const DecodeTable &decodeTable()
+{
+  static const DecodeTable table;
+  return table;
 }
 
+#if defined(GZ_BASE64_SSSE3)
 /////////////////////////////////////////////////
-void Base64Encode(const char *_bytesToEncode, unsigned int _inLen,
-    std::string &_result)
+static bool haveSsse3()
 {
-  int i = 0;
-  unsigned char charArray3[3];
-  unsigned char charArray4[4];
+  static const bool have = __builtin_cpu_supports("ssse3");
+  return have;
+}
 
-  while (_inLen--)
+/////////////////////////////////////////////////
+// Encodes 12 bytes per 16 byte load, so it stops while the input still
+// has the 4 bytes read past them.
+__attribute__((target("ssse3")))
+static std::size_t encodeSsse3(const unsigned char *_in, std::size_t _len,
+    char *_out)
+{
+  const __m128i shuffle = _mm_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i lut = _mm_setr_epi8(
+      65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+  std::size_t i = 0;
+  for (; i + 16 <= _len; i += 12, _out += 16)
   {
-    charArray3[i++] = *(_bytesToEncode++);
-    if (i == 3)
+    __m128i in = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_in + i)),
+        shuffle);
+
+    // Move the four 6 bit values of every 3 bytes to their own byte
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    in = _mm_or_si128(t1, t3);
+
+    // Offset every value to its character, by range of values
+    __m128i indices = _mm_subs_epu8(in, _mm_set1_epi8(51));
+    indices = _mm_sub_epi8(indices,
+        _mm_cmpgt_epi8(in, _mm_set1_epi8(25)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_out),
+        _mm_add_epi8(in, _mm_shuffle_epi8(lut, indices)));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+// Decodes 16 characters per iteration into 12 bytes, written with a 16
+// byte store, so it stops while the output still has room. A block with
+// any other character is left to the plain loop.
+__attribute__((target("ssse3")))
+static std::size_t decodeSsse3(const char *_in, std::size_t _len,
+    char *_out, std::size_t &_written)
+{
+  const __m128i lutLo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lutHi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lutRoll = _mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask2F = _mm_set1_epi8(0x2F);
+  const __m128i pack = _mm_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  std::size_t i = 0;
+  _written = 0;
+  for (; i + 16 <= _len; i += 16, _written += 12)
+  {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_in + i));
+    const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), mask2F);
+    const __m128i loNibbles = _mm_and_si128(in, mask2F);
+    const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi),
+          _mm_setzero_si128())) != 0)
     {
-      charArray4[0] = (charArray3[0] & 0xfc) >> 2;
-      charArray4[1] = ((charArray3[0] & 0x03) << 4) +
-        ((charArray3[1] & 0xf0) >> 4);
-      charArray4[2] = ((charArray3[1] & 0x0f) << 2) +
-        ((charArray3[2] & 0xc0) >> 6);
-      charArray4[3] = charArray3[2] & 0x3f;
-
-      for (i = 0; i < 4; ++i)
-        _result += base64Chars[charArray4[i]];
-      i = 0;
+      break;
     }
+
+    const __m128i roll = _mm_shuffle_epi8(lutRoll,
+        _mm_add_epi8(_mm_cmpeq_epi8(in, mask2F), hiNibbles));
+    in = _mm_add_epi8(in, roll);
+
+    // Merge the 6 bit values in 3 bytes, then drop the empty bytes
+    in = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+    in = _mm_madd_epi16(in, _mm_set1_epi32(0x00011000));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_out + _written),
+        _mm_shuffle_epi8(in, pack));
   }
+  return i;
+}
+#endif
 
-  if (i)
-  {
-    for (int j = i; j < 3; ++j)
-      charArray3[j] = '\0';
+/////////////////////////////////////////////////
+std::size_t Base64EncodedSize(std::size_t _len)
+{
+  return (_len + 2) / 3 * 4;
+}
 
-    charArray4[0] = (charArray3[0] & 0xfc) >> 2;
-    charArray4[1] = ((charArray3[0] & 0x03) << 4) +
-      ((charArray3[1] & 0xf0) >> 4);
-    charArray4[2] = ((charArray3[1] & 0x0f) << 2) +
-      ((charArray3[2] & 0xc0) >> 6);
-    charArray4[3] = charArray3[2] & 0x3f;
+/////////////////////////////////////////////////
+std::size_t Base64DecodedSize(std::size_t _len)
+{
+  // The vector loop stores 4 bytes past its output
+  return _len / 4 * 3 + 3 + 4;
+}
 
-    for (int j = 0; (j < i + 1); ++j)
-      _result += base64Chars[charArray4[j]];
+/////////////////////////////////////////////////
+void Base64Encode(const char *_bytesToEncode, unsigned int _inLen,
+    std::string &_result)
+{
+  const std::size_t start = _result.size();
+  _result.resize(start + Base64EncodedSize(_inLen));
+  char *out = &_result[0] + start;
+  const unsigned char *in =
+    reinterpret_cast<const unsigned char *>(_bytesToEncode);
 
-    while ((i++ < 3))
-      _result += '=';
+  std::size_t i = 0;
+#if defined(GZ_BASE64_SSSE3)
+  if (haveSsse3())
+  {
+    i = encodeSsse3(in, _inLen, out);
+    out += i / 3 * 4;
+  }
+#endif
+
+  for (; i + 3 <= _inLen; i += 3)
+  {
+    const uint32_t triple = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+    *out++ = base64Chars[(triple >> 18) & 0x3f];
+    *out++ = base64Chars[(triple >> 12) & 0x3f];
+    *out++ = base64Chars[(triple >> 6) & 0x3f];
+    *out++ = base64Chars[triple & 0x3f];
+  }
+
+  const std::size_t rest = _inLen - i;
+  if (rest)
+  {
+    const uint32_t triple = (in[i] << 16) |
+      (rest == 2 ? (in[i + 1] << 8) : 0);
+    *out++ = base64Chars[(triple >> 18) & 0x3f];
+    *out++ = base64Chars[(triple >> 12) & 0x3f];
+    *out++ = rest == 2 ? base64Chars[(triple >> 6) & 0x3f] : '=';
+    *out++ = '=';
   }
 }
 
 /////////////////////////////////////////////////
-std::string Base64Decode(const std::string &_encodedString)
+std::size_t Base64Decode(const char *_encoded, std::size_t _len,
+    char *_result)
 {
-  int inLen = _encodedString.size();
-  int i = 0;
-  int in = 0;
-  unsigned char charArray4[4], charArray3[3];
-  std::string ret;
+  const uint8_t *values = decodeTable().values;
+  std::size_t in = 0;
+  std::size_t out = 0;
+#if defined(GZ_BASE64_SSSE3)
+  if (haveSsse3())
+    in = decodeSsse3(_encoded, _len, _result, out);
+#endif
 
-  while (inLen-- && (_encodedString[in] != '=') &&
-      IsBase64(_encodedString[in]))
+  uint32_t quad = 0;
+  int count = 0;
+  for (; in < _len; ++in)
   {
-    charArray4[i++] = _encodedString[in];
-    in++;
+    const uint8_t value = values[static_cast<unsigned char>(_encoded[in])];
+    if (value == kInvalid)
+      break;
 
-    if (i == 4)
+    quad = (quad << 6) | value;
+    if (++count == 4)
     {
-      for (i = 0; i < 4; ++i)
-        charArray4[i] = base64Chars.find(charArray4[i]);
-
-      charArray3[0] = (charArray4[0] << 2) +
-        ((charArray4[1] & 0x30) >> 4);
-      charArray3[1] = ((charArray4[1] & 0xf) << 4) +
-        ((charArray4[2] & 0x3c) >> 2);
-      charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
-
-      for (i = 0; (i < 3); ++i)
-        ret += charArray3[i];
-      i = 0;
+      _result[out++] = static_cast<char>(quad >> 16);
+      _result[out++] = static_cast<char>(quad >> 8);
+      _result[out++] = static_cast<char>(quad);
+      quad = 0;
+      count = 0;
     }
   }
 
-  if (i)
+  // A partial group of n characters holds n - 1 bytes
+  if (count >= 2)
   {
-    for (int j = i; j <4; ++j)
-      charArray4[j] = 0;
-
-    for (int j = 0; j <4; ++j)
-      charArray4[j] = base64Chars.find(charArray4[j]);
+    quad <<= 6 * (4 - count);
+    _result[out++] = static_cast<char>(quad >> 16);
+    if (count == 3)
+      _result[out++] = static_cast<char>(quad >> 8);
+  }
 
-    charArray3[0] = (charArray4[0] << 2) + ((charArray4[1] & 0x30) >> 4);
-    charArray3[1] = ((charArray4[1] & 0xf) << 4) +
-      ((charArray4[2] & 0x3c) >> 2);
-    charArray3[2] = ((charArray4[2] & 0x3) << 6) + charArray4[3];
+  return out;
+}
 
-    for (int j = 0; (j < i - 1); ++j)
-      ret += charArray3[j];
-  }
+/////////////////////////////////////////////////
+void Base64Decode(const std::string &_encodedString, std::string &_result)
+{
+  _result.resize(Base64DecodedSize(_encodedString.size()));
+  _result.resize(Base64Decode(_encodedString.data(), _encodedString.size(),
+        &_result[0]));
+}
 
+/////////////////////////////////////////////////
+std::string Base64Decode(const std::string &_encodedString)
+{
+  std::string ret;
+  Base64Decode(_encodedString, ret);
   return ret;
 }
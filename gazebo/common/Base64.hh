@@ -17,6 +17,7 @@
 #ifndef _BASE_64_HH_
 #define _BASE_64_HH_
 
+#include <cstddef>
 #include <string>
 #include "gazebo/util/system.hh"
 
@@ -34,4 +35,34 @@ void Base64Encode(const char *_bytesToEncode, unsigned int _len,
 /// \return The decoded string.
 GZ_COMMON_VISIBLE
 std::string Base64Decode(const std::string &_encodedString);
+
+/// \brief Decode a base64 string into an existing string, which keeps its
+/// capacity so that it can be reused for every decode.
+/// \param[in] _encodedString A base 64 encoded string.
+/// \param[out] _result The decoded string, which replaces the content.
+GZ_COMMON_VISIBLE
+void Base64Decode(const std::string &_encodedString, std::string &_result);
+
+/// \brief Decode base64 characters into a buffer. Decoding stops at the
+/// first padding or invalid character.
+/// \param[in] _encoded Base 64 characters.
+/// \param[in] _len Number of characters.
+/// \param[out] _result Buffer of at least Base64DecodedSize(_len) bytes.
+/// \return Number of bytes decoded.
+GZ_COMMON_VISIBLE
+std::size_t Base64Decode(const char *_encoded, std::size_t _len,
+    char *_result);
+
+/// \brief Get the length of the base64 encoding of bytes.
+/// \param[in] _len Number of bytes.
+/// \return Number of characters, with padding.
+GZ_COMMON_VISIBLE
+std::size_t Base64EncodedSize(std::size_t _len);
+
+/// \brief Get the size of the buffer that Base64Decode needs to decode
+/// base64 characters, which has a few bytes of room for vector stores.
+/// \param[in] _len Number of characters.
+/// \return Number of bytes.
+GZ_COMMON_VISIBLE
+std::size_t Base64DecodedSize(std::size_t _len);
 #endif
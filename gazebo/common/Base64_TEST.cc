@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/common/Base64.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class Base64Test : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(Base64Test, Known)
+{
+  // Test vectors of RFC 4648
+  const char *plain[] = {"", "f", "fo", "foo", "foob", "fooba", "foobar"};
+  const char *encoded[] = {"", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==",
+      "Zm9vYmE=", "Zm9vYmFy"};
+
+  for (int i = 0; i < 7; ++i)
+  {
+    std::string result;
+    Base64Encode(plain[i], std::string(plain[i]).size(), result);
+    EXPECT_EQ(result, encoded[i]);
+    EXPECT_EQ(result.size(), Base64EncodedSize(std::string(plain[i]).size()));
+    EXPECT_EQ(Base64Decode(encoded[i]), plain[i]);
+  }
+
+  // Encoding appends
+  std::string result = "x";
+  Base64Encode("foo", 3, result);
+  EXPECT_EQ(result, "xZm9v");
+}
+
+/////////////////////////////////////////////////
+TEST_F(Base64Test, RoundTrip)
+{
+  // Every length up to a few vector blocks, with every byte value
+  std::string decoded;
+  for (unsigned int len = 0; len < 200; ++len)
+  {
+    std::string data(len, '\0');
+    for (unsigned int i = 0; i < len; ++i)
+      data[i] = static_cast<char>((i * 131 + len) & 0xff);
+
+    std::string encoded;
+    Base64Encode(data.c_str(), len, encoded);
+    ASSERT_EQ(encoded.size(), Base64EncodedSize(len));
+
+    Base64Decode(encoded, decoded);
+    ASSERT_EQ(decoded, data) << "length " << len;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(Base64Test, Invalid)
+{
+  // Decoding stops at the first character that isn't base64, also when it
+  // is within a vector block
+  std::string encoded;
+  const std::string data(60, 'a');
+  Base64Encode(data.c_str(), data.size(), encoded);
+
+  for (std::size_t pos : {0u, 4u, 5u, 30u, 79u})
+  {
+    std::string broken = encoded;
+    broken[pos] = '!';
+    EXPECT_EQ(Base64Decode(broken), data.substr(0, pos * 3 / 4));
+  }
+
+  EXPECT_EQ(Base64Decode("Zm9v\nYmFy"), "foo");
+  EXPECT_EQ(Base64Decode("Zm9vY"), "foo");
+
+  // Decode into a raw buffer
+  char buffer[16];
+  ASSERT_LE(Base64DecodedSize(8), sizeof(buffer));
+  EXPECT_EQ(Base64Decode("Zm9vYmFy", 8, buffer), 6u);
+  EXPECT_EQ(std::string(buffer, 6), "foobar");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
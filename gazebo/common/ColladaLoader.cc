@@ -17,12 +17,20 @@
 
 #include <tinyxml.h>
 #include <math.h>
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <set>
 #include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
 #include <boost/algorithm/string.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/unordered_map.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <ignition/math/Color.hh>
 #include <ignition/math/Helpers.hh>
@@ -80,6 +88,196 @@ struct Vector2dHash : unary_function<const ignition::math::Vector2d,
   }
 };
 
+/////////////////////////////////////////////////
+/// \brief Position, normal and texture coordinate indices of a vertex.
+typedef std::tuple<unsigned int, unsigned int, unsigned int> IndexTuple;
+
+/////////////////////////////////////////////////
+struct IndexTupleHash : unary_function<const IndexTuple, std::size_t>
+{
+  std::size_t operator()(const IndexTuple &_t) const
+  {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, std::get<0>(_t));
+    boost::hash_combine(seed, std::get<1>(_t));
+    boost::hash_combine(seed, std::get<2>(_t));
+    return seed;
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Parse whitespace separated floating point numbers.
+/// \param[in] _text Text to parse, may be null.
+/// \param[out] _values Parsed numbers.
+static void parseFloats(const char *_text, std::vector<double> &_values)
+{
+  if (!_text)
+    return;
+
+  const char *p = _text;
+  char *end = nullptr;
+  while (*p)
+  {
+    double value = std::strtod(p, &end);
+    if (end == p)
+      break;
+    _values.push_back(value);
+    p = end;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse whitespace separated unsigned integers.
+/// \param[in] _text Text to parse, may be null.
+/// \param[out] _values Parsed numbers.
+static void parseIndices(const char *_text, std::vector<unsigned int> &_values)
+{
+  if (!_text)
+    return;
+
+  const char *p = _text;
+  char *end = nullptr;
+  while (*p)
+  {
+    uint64_t value = std::strtoull(p, &end, 10);
+    if (end == p)
+      break;
+    _values.push_back(static_cast<unsigned int>(value));
+    p = end;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an entry of a duplicate map.
+/// \param[in] _duplicates Map of duplicate indices.
+/// \param[in] _index Index to look up.
+/// \return Index of the first instance of the value at _index.
+static unsigned int remapIndex(
+    const std::map<unsigned int, unsigned int> &_duplicates,
+    const unsigned int _index)
+{
+  auto iter = _duplicates.find(_index);
+  return iter != _duplicates.end() ? iter->second : _index;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add the id and sid attributes of an element and its children to
+/// an index, keeping the first element of each.
+/// \param[in] _elem Element to index.
+/// \param[in,out] _ids Index to fill.
+static void indexElement(TiXmlElement *_elem,
+    std::unordered_map<std::string, TiXmlElement *> &_ids)
+{
+  if (_elem->Attribute("id"))
+    _ids.emplace(_elem->Attribute("id"), _elem);
+  if (_elem->Attribute("sid"))
+    _ids.emplace(_elem->Attribute("sid"), _elem);
+
+  for (TiXmlElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    indexElement(child, _ids);
+  }
+}
+
+/////////////////////////////////////////////////
+void ColladaLoaderPrivate::Prepare()
+{
+  this->Clear();
+  indexElement(this->colladaXml, this->elementIds);
+
+  // Collect the numeric arrays of every geometry, so that the text of the
+  // large ones is parsed on several threads before the scene is walked.
+  std::vector<std::pair<TiXmlElement *, std::vector<double> *>> floats;
+  std::vector<std::pair<TiXmlElement *, std::vector<unsigned int> *>>
+    indices;
+  for (TiXmlElement *libXml =
+       this->colladaXml->FirstChildElement("library_geometries");
+       libXml; libXml = libXml->NextSiblingElement("library_geometries"))
+  {
+    for (TiXmlElement *geomXml = libXml->FirstChildElement("geometry");
+         geomXml; geomXml = geomXml->NextSiblingElement("geometry"))
+    {
+      TiXmlElement *meshXml = geomXml->FirstChildElement("mesh");
+      if (!meshXml)
+        continue;
+
+      for (TiXmlElement *childXml = meshXml->FirstChildElement(); childXml;
+           childXml = childXml->NextSiblingElement())
+      {
+        std::string name = childXml->Value();
+        if (name == "source")
+        {
+          TiXmlElement *arrayXml = childXml->FirstChildElement("float_array");
+          if (arrayXml && arrayXml->GetText())
+            floats.emplace_back(arrayXml, &this->floatArrays[arrayXml]);
+        }
+        else if (name == "triangles" || name == "polylist" ||
+                 name == "lines")
+        {
+          for (auto arrayName : {"p", "vcount"})
+          {
+            TiXmlElement *arrayXml = childXml->FirstChildElement(arrayName);
+            if (arrayXml && arrayXml->GetText())
+              indices.emplace_back(arrayXml, &this->indexArrays[arrayXml]);
+          }
+        }
+      }
+    }
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, floats.size(), 1),
+      [&floats](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+      parseFloats(floats[i].first->GetText(), *floats[i].second);
+  });
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, indices.size(), 1),
+      [&indices](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+      parseIndices(indices[i].first->GetText(), *indices[i].second);
+  });
+}
+
+/////////////////////////////////////////////////
+void ColladaLoaderPrivate::Clear()
+{
+  this->elementIds.clear();
+  this->floatArrays.clear();
+  this->indexArrays.clear();
+}
+
+/////////////////////////////////////////////////
+const std::vector<double> &ColladaLoaderPrivate::FloatArray(
+    TiXmlElement *_elem)
+{
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+  auto iter = this->floatArrays.find(_elem);
+  if (iter == this->floatArrays.end())
+  {
+    iter = this->floatArrays.emplace(_elem, std::vector<double>()).first;
+    parseFloats(_elem->GetText(), iter->second);
+  }
+  return iter->second;
+}
+
+/////////////////////////////////////////////////
+const std::vector<unsigned int> &ColladaLoaderPrivate::IndexArray(
+    TiXmlElement *_elem)
+{
+  std::lock_guard<std::mutex> lock(this->cacheMutex);
+  auto iter = this->indexArrays.find(_elem);
+  if (iter == this->indexArrays.end())
+  {
+    iter = this->indexArrays.emplace(_elem,
+        std::vector<unsigned int>()).first;
+    parseIndices(_elem->GetText(), iter->second);
+  }
+  return iter->second;
+}
+
 //////////////////////////////////////////////////
   ColladaLoader::ColladaLoader()
 : MeshLoader(), dataPtr(new ColladaLoaderPrivate)
@@ -104,6 +302,7 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   this->dataPtr->positionDuplicateMap.clear();
   this->dataPtr->normalDuplicateMap.clear();
   this->dataPtr->texcoordDuplicateMap.clear();
+  this->dataPtr->pendingSubMeshes.clear();
 
   // reset scale
   this->dataPtr->meter = 1.0;
@@ -125,6 +324,8 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
       std::string(this->dataPtr->colladaXml->Attribute("version")) != "1.4.1")
     gzerr << "Invalid collada file. Must be version 1.4.0 or 1.4.1\n";
 
+  this->dataPtr->Prepare();
+
   TiXmlElement *assetXml =
       this->dataPtr->colladaXml->FirstChildElement("asset");
   if (assetXml)
@@ -148,6 +349,9 @@ Mesh *ColladaLoader::Load(const std::string &_filename)
   if (mesh->HasSkeleton())
     mesh->GetSkeleton()->Scale(this->dataPtr->meter);
 
+  // The arrays point in the document, which is destroyed on return
+  this->dataPtr->Clear();
+
   return mesh;
 }
 
@@ -175,6 +379,8 @@ void ColladaLoader::LoadScene(Mesh *_mesh)
     this->LoadNode(nodeXml, _mesh, ignition::math::Matrix4d::Identity);
     nodeXml = nodeXml->NextSiblingElement("node");
   }
+
+  this->LoadPendingSubMeshes(_mesh);
 }
 
 /////////////////////////////////////////////////
@@ -872,37 +1078,113 @@ void ColladaLoader::LoadGeometry(TiXmlElement *_xml,
     const ignition::math::Matrix4d &_transform, Mesh *_mesh)
 {
   TiXmlElement *meshXml = _xml->FirstChildElement("mesh");
-  TiXmlElement *childXml;
 
   if (!meshXml)
     return;
 
-  childXml = meshXml->FirstChildElement("triangles");
-  while (childXml)
+  // The materials are resolved here, as the material map belongs to the
+  // node being walked, while the submeshes are built later in parallel.
+  for (auto primitive : {"triangles", "polylist", "lines"})
   {
-    this->LoadTriangles(childXml, _transform, _mesh);
-    childXml = childXml->NextSiblingElement("triangles");
+    for (TiXmlElement *childXml = meshXml->FirstChildElement(primitive);
+         childXml; childXml = childXml->NextSiblingElement(primitive))
+    {
+      PendingSubMesh pending;
+      pending.xml = childXml;
+      pending.transform = _transform;
+      pending.name = this->dataPtr->currentNodeName;
+      pending.materialIndex = this->LoadMaterialIndex(childXml, _mesh);
+      this->dataPtr->pendingSubMeshes.push_back(pending);
+    }
   }
 
-  childXml = meshXml->FirstChildElement("polylist");
-  while (childXml)
+  // Skinned geometry reads the vertex weights of the current controller,
+  // which the next controller replaces.
+  if (_mesh->HasSkeleton())
+    this->LoadPendingSubMeshes(_mesh);
+}
+
+/////////////////////////////////////////////////
+int ColladaLoader::LoadMaterialIndex(TiXmlElement *_xml, Mesh *_mesh)
+{
+  if (!_xml->Attribute("material"))
+    return -1;
+
+  std::string matStr = _xml->Attribute("material");
+  auto iter = this->dataPtr->materialMap.find(matStr);
+  if (iter != this->dataPtr->materialMap.end())
+    matStr = iter->second;
+
+  common::Material *mat = this->LoadMaterial(matStr);
+  int matIndex = _mesh->GetMaterialIndex(mat);
+  if (matIndex < 0)
+    matIndex = _mesh->AddMaterial(mat);
+
+  if (matIndex < 0)
+    gzwarn << "Unable to add material[" << matStr << "]\n";
+
+  return matIndex;
+}
+
+/////////////////////////////////////////////////
+void ColladaLoader::LoadPendingSubMeshes(Mesh *_mesh)
+{
+  std::vector<PendingSubMesh> &pending = this->dataPtr->pendingSubMeshes;
+  std::vector<std::unique_ptr<SubMesh>> subMeshes(pending.size());
+
+  // Each submesh only reads the document, the mesh and the caches, so the
+  // primitive elements are built independently of each other.
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, pending.size(), 1),
+      [&](const tbb::blocked_range<size_t> &_r)
   {
-    this->LoadPolylist(childXml, _transform, _mesh);
-    childXml = childXml->NextSiblingElement("polylist");
-  }
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+    {
+      const std::string primitive = pending[i].xml->Value();
+      if (primitive == "triangles")
+      {
+        subMeshes[i].reset(this->LoadTriangles(pending[i].xml,
+              pending[i].transform, _mesh));
+      }
+      else if (primitive == "polylist")
+      {
+        subMeshes[i].reset(this->LoadPolylist(pending[i].xml,
+              pending[i].transform, _mesh));
+      }
+      else
+      {
+        subMeshes[i].reset(this->LoadLines(pending[i].xml,
+              pending[i].transform));
+      }
+    }
+  });
 
-  childXml = meshXml->FirstChildElement("lines");
-  while (childXml)
+  for (size_t i = 0; i < pending.size(); ++i)
   {
-    this->LoadLines(childXml, _transform, _mesh);
-    childXml = childXml->NextSiblingElement("lines");
+    if (!subMeshes[i])
+      continue;
+
+    subMeshes[i]->SetName(pending[i].name);
+    if (pending[i].materialIndex >= 0)
+      subMeshes[i]->SetMaterialIndex(pending[i].materialIndex);
+    _mesh->AddSubMesh(subMeshes[i].release());
   }
+  pending.clear();
 }
 
 /////////////////////////////////////////////////
 TiXmlElement *ColladaLoader::GetElementId(const std::string &_name,
                                           const std::string &_id)
 {
+  std::string id = _id;
+  if (id.length() > 0 && id[0] == '#')
+    id.erase(0, 1);
+
+  if (!id.empty() && !this->dataPtr->elementIds.empty())
+  {
+    auto iter = this->dataPtr->elementIds.find(id);
+    return iter != this->dataPtr->elementIds.end() ? iter->second : nullptr;
+  }
+
   return this->GetElementId(this->dataPtr->colladaXml, _name, _id);
 }
 
@@ -989,11 +1271,15 @@ void ColladaLoader::LoadPositions(const std::string &_id,
     std::vector<ignition::math::Vector3d> &_values,
     std::map<unsigned int, unsigned int> &_duplicates)
 {
-  if (this->dataPtr->positionIds.find(_id) != this->dataPtr->positionIds.end())
   {
-    _values = this->dataPtr->positionIds[_id];
-    _duplicates = this->dataPtr->positionDuplicateMap[_id];
-    return;
+    std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
+    auto iter = this->dataPtr->positionIds.find(_id);
+    if (iter != this->dataPtr->positionIds.end())
+    {
+      _values = iter->second;
+      _duplicates = this->dataPtr->positionDuplicateMap[_id];
+      return;
+    }
   }
 
   TiXmlElement *sourceXml = this->GetElementId("source", _id);
@@ -1032,21 +1318,16 @@ void ColladaLoader::LoadPositions(const std::string &_id,
 
     return;
   }
-  std::string valueStr = floatArrayXml->GetText();
+  const std::vector<double> &floats =
+      this->dataPtr->FloatArray(floatArrayXml);
 
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
 
-  std::vector<std::string> strs;
-  std::vector<std::string>::iterator iter, end;
-  boost::split(strs, valueStr, boost::is_any_of(" \t"));
-
-  end = strs.end();
-  for (iter = strs.begin(); iter != end; iter += 3)
+  _values.reserve(_values.size() + floats.size() / 3);
+  for (std::size_t i = 0; i + 2 < floats.size(); i += 3)
   {
-    ignition::math::Vector3d vec(ignition::math::parseFloat(*iter),
-        ignition::math::parseFloat(*(iter+1)),
-        ignition::math::parseFloat(*(iter+2)));
+    ignition::math::Vector3d vec(floats[i], floats[i+1], floats[i+2]);
 
     vec = _transform * vec;
     _values.push_back(vec);
@@ -1058,6 +1339,7 @@ void ColladaLoader::LoadPositions(const std::string &_id,
       unique[vec] = _values.size()-1;
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
   this->dataPtr->positionDuplicateMap[_id] = _duplicates;
   this->dataPtr->positionIds[_id] = _values;
 }
@@ -1068,11 +1350,15 @@ void ColladaLoader::LoadNormals(const std::string &_id,
     std::vector<ignition::math::Vector3d> &_values,
     std::map<unsigned int, unsigned int> &_duplicates)
 {
-  if (this->dataPtr->normalIds.find(_id) != this->dataPtr->normalIds.end())
   {
-    _values = this->dataPtr->normalIds[_id];
-    _duplicates = this->dataPtr->normalDuplicateMap[_id];
-    return;
+    std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
+    auto iter = this->dataPtr->normalIds.find(_id);
+    if (iter != this->dataPtr->normalIds.end())
+    {
+      _values = iter->second;
+      _duplicates = this->dataPtr->normalDuplicateMap[_id];
+      return;
+    }
   }
 
   ignition::math::Matrix4d rotMat = _transform;
@@ -1118,26 +1404,25 @@ void ColladaLoader::LoadNormals(const std::string &_id,
   boost::unordered_map<ignition::math::Vector3d,
     unsigned int, Vector3Hash> unique;
 
-  std::string valueStr = floatArrayXml->GetText();
-  std::istringstream iss(valueStr);
-  do
+  const std::vector<double> &floats =
+      this->dataPtr->FloatArray(floatArrayXml);
+
+  _values.reserve(_values.size() + floats.size() / 3);
+  for (std::size_t i = 0; i + 2 < floats.size(); i += 3)
   {
-    ignition::math::Vector3d vec;
-    iss >> vec.X() >> vec.Y() >> vec.Z();
-    if (iss)
-    {
-      vec = rotMat * vec;
-      vec.Normalize();
-      _values.push_back(vec);
+    ignition::math::Vector3d vec(floats[i], floats[i+1], floats[i+2]);
+    vec = rotMat * vec;
+    vec.Normalize();
+    _values.push_back(vec);
 
-      // create a map of duplicate indices
-      if (unique.find(vec) != unique.end())
-        _duplicates[_values.size()-1] = unique[vec];
-      else
-        unique[vec] = _values.size()-1;
-    }
-  } while (iss);
+    // create a map of duplicate indices
+    if (unique.find(vec) != unique.end())
+      _duplicates[_values.size()-1] = unique[vec];
+    else
+      unique[vec] = _values.size()-1;
+  }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
   this->dataPtr->normalDuplicateMap[_id] = _duplicates;
   this->dataPtr->normalIds[_id] = _values;
 }
@@ -1147,11 +1432,15 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
     std::vector<ignition::math::Vector2d> &_values,
     std::map<unsigned int, unsigned int> &_duplicates)
 {
-  if (this->dataPtr->texcoordIds.find(_id) != this->dataPtr->texcoordIds.end())
   {
-    _values = this->dataPtr->texcoordIds[_id];
-    _duplicates = this->dataPtr->texcoordDuplicateMap[_id];
-    return;
+    std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
+    auto iter = this->dataPtr->texcoordIds.find(_id);
+    if (iter != this->dataPtr->texcoordIds.end())
+    {
+      _values = iter->second;
+      _duplicates = this->dataPtr->texcoordDuplicateMap[_id];
+      return;
+    }
   }
 
   int stride = 0;
@@ -1266,17 +1555,21 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
   boost::unordered_map<ignition::math::Vector2d,
     unsigned int, Vector2dHash> unique;
 
-  // Read the raw texture values, and split them on spaces.
-  std::string valueStr = floatArrayXml->GetText();
-  std::vector<std::string> values;
-  boost::split(values, valueStr, boost::is_any_of(" "));
+  // Read the raw texture values.
+  const std::vector<double> &values =
+      this->dataPtr->FloatArray(floatArrayXml);
+  if (values.size() < static_cast<std::size_t>(totCount) || stride < 2)
+  {
+    gzerr << "Error reading texture coordinates. Element with id[" << _id
+          << "] has fewer values than its count, or a stride below 2\n";
+    return;
+  }
 
   // Read in all the texture coordinates.
   for (int i = 0; i < totCount; i += stride)
   {
     // We only handle 2D texture coordinates right now.
-    ignition::math::Vector2d vec(boost::lexical_cast<double>(values[i]),
-          1.0 - boost::lexical_cast<double>(values[i+1]));
+    ignition::math::Vector2d vec(values[i], 1.0 - values[i+1]);
     _values.push_back(vec);
 
     // create a map of duplicate indices
@@ -1288,6 +1581,7 @@ void ColladaLoader::LoadTexCoords(const std::string &_id,
       unique[vec] = _values.size()-1;
   }
 
+  std::lock_guard<std::mutex> lock(this->dataPtr->cacheMutex);
   this->dataPtr->texcoordDuplicateMap[_id] = _duplicates;
   this->dataPtr->texcoordIds[_id] = _values;
 }
@@ -1500,42 +1794,19 @@ void ColladaLoader::LoadColorOrTexture(TiXmlElement *_elem,
 }
 
 /////////////////////////////////////////////////
-void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
+SubMesh *ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
     const ignition::math::Matrix4d &_transform,
-    Mesh *_mesh)
+    const Mesh *_mesh)
 {
   // This function parses polylist types in collada into
   // a set of triangle meshes.  The assumption is that
   // each polylist polygon is convex, and we do decomposion
   // by anchoring each triangle about vertex 0 or each polygon
   SubMesh *subMesh = new SubMesh;
-  subMesh->SetName(this->dataPtr->currentNodeName);
   bool combinedVertNorms = false;
 
   subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
 
-  if (_polylistXml->Attribute("material"))
-  {
-    std::map<std::string, std::string>::iterator iter;
-    std::string matStr = _polylistXml->Attribute("material");
-
-    int matIndex = -1;
-    iter = this->dataPtr->materialMap.find(matStr);
-    if (iter != this->dataPtr->materialMap.end())
-      matStr = iter->second;
-
-    common::Material *mat = this->LoadMaterial(matStr);
-
-    matIndex = _mesh->GetMaterialIndex(mat);
-    if (matIndex < 0)
-      matIndex = _mesh->AddMaterial(mat);
-
-    if (matIndex < 0)
-      gzwarn << "Unable to add material[" << matStr << "]\n";
-    else
-      subMesh->SetMaterialIndex(matIndex);
-  }
-
   TiXmlElement *polylistInputXml = _polylistXml->FirstChildElement("input");
 
   std::vector<ignition::math::Vector3d> verts;
@@ -1606,34 +1877,41 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
   // break poly into triangles
   // if vcount >= 4, anchor around 0 (note this is bad for concave elements)
   //   e.g. if vcount = 4, break into triangle 1: [0,1,2], triangle 2: [0,2,3]
-  std::vector<std::string> vcountStrs;
   TiXmlElement *vcountXml = _polylistXml->FirstChildElement("vcount");
-  std::string vcountStr = vcountXml->GetText();
-  boost::split(vcountStrs, vcountStr, boost::is_any_of(" \t"));
-  std::vector<int> vcounts;
-  for (unsigned int j = 0; j < vcountStrs.size(); ++j)
-    vcounts.push_back(ignition::math::parseInt(vcountStrs[j]));
-
-  // read p
   TiXmlElement *pXml = _polylistXml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
+  if (!vcountXml || !pXml)
+  {
+    gzerr << "Collada file[" << this->dataPtr->filename
+      << "] has a polylist without vcount or p. Loading what we can...\n";
+    delete subMesh;
+    return nullptr;
+  }
+  const std::vector<unsigned int> &vcounts =
+      this->dataPtr->IndexArray(vcountXml);
+  const std::vector<unsigned int> &indices = this->dataPtr->IndexArray(pXml);
 
-  // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
-  // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
-  unsigned int *values = new unsigned int[inputSize];
-  memset(values, 0, inputSize);
+  // vertexIndexMap maps the collada position, normal and texcoord indices
+  // of a vertex to its Gazebo submesh index, used for identifying vertices
+  // that can be shared.
+  std::unordered_map<IndexTuple, unsigned int, IndexTupleHash>
+    vertexIndexMap;
+  std::vector<unsigned int> values(inputSize);
 
-  std::vector<std::string> strs;
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
-  std::vector<std::string>::iterator strsIter = strs.begin();
+  std::size_t polygonStart = 0;
   for (unsigned int l = 0; l < vcounts.size(); ++l)
   {
     // put us at the beginning of the polygon list
     if (l > 0)
-      strsIter += inputSize*vcounts[l-1];
+      polygonStart += inputSize*vcounts[l-1];
 
-    for (unsigned int k = 2; k < (unsigned int)vcounts[l]; ++k)
+    if (polygonStart + inputSize*vcounts[l] > indices.size())
+    {
+      gzerr << "Collada file[" << this->dataPtr->filename
+        << "] has a polylist with fewer indices than its vcount\n";
+      break;
+    }
+
+    for (unsigned int k = 2; k < vcounts[l]; ++k)
     {
       // if vcounts[l] = 5, then read 0,1,2, then 0,2,3, 0,3,4,...
       // here k = the last number in the series
@@ -1641,220 +1919,106 @@ void ColladaLoader::LoadPolylist(TiXmlElement *_polylistXml,
       for (unsigned int j = 0; j < 3; ++j)
       {
         // break polygon into triangles
-        unsigned int triangle_index;
+        unsigned int triangle_index = 0;
 
-        if (j == 0)
-          triangle_index = 0;
         if (j == 1)
           triangle_index = (k-1)*inputSize;
         if (j == 2)
           triangle_index = (k)*inputSize;
 
         for (unsigned int i = 0; i < inputSize; ++i)
-        {
-          values[i] = ignition::math::parseInt(strsIter[triangle_index+i]);
-          /*gzerr << "debug parsing "
-                << " poly-i[" << l
-                << "] tri-end-index[" << k
-                << "] tri-vertex-i[" << j
-                << "] triangle[" << triangle_index
-                << "] input[" << i
-                << "] value[" << values[i]
-                << "]\n"; */
-        }
-
+          values[i] = indices[polygonStart + triangle_index + i];
 
+        // Get the position, normal and texcoord index values. Duplicates
+        // are reset to the index of their first instance.
         unsigned int daeVertIndex = 0;
-        bool addIndex = inputs[VERTEX].empty();
-
-        // find a set of vertex/normal/texcoord that can be reused
-        // only do this if the mesh has vertices
+        unsigned int normalIndex = 0;
+        unsigned int texcoordIndex = 0;
         if (!inputs[VERTEX].empty())
         {
-          // Get the vertex position index value. If it is a duplicate then use
-          // the existing index instead
-          daeVertIndex = values[*inputs[VERTEX].begin()];
-          if (positionDupMap.find(daeVertIndex) != positionDupMap.end())
-            daeVertIndex = positionDupMap[daeVertIndex];
-
-          // if the vertex index has not been previously added then just add it.
-          if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
-          {
-            addIndex = true;
-          }
-          else
-          {
-            // if the vertex index was previously added, check to see if it has
-            // the same normal and texcoord index values
-            bool toDuplicate = true;
-            unsigned int reuseIndex = 0;
-            std::vector<GeometryIndices> inputValues =
-                vertexIndexMap[daeVertIndex];
-
-            for (unsigned int i = 0; i < inputValues.size(); ++i)
-            {
-              GeometryIndices iv = inputValues[i];
-              bool normEqual = false;
-              bool texEqual = false;
-
-              if (!inputs[NORMAL].empty())
-              {
-                // Get the vertex normal index value. If the normal is a
-                // duplicate then reset the index to the first instance of the
-                // duplicated position
-                unsigned int remappedNormalIndex =
-                  values[*inputs[NORMAL].begin()];
-                if (normalDupMap.find(remappedNormalIndex)
-                    != normalDupMap.end())
-                 {
-                  remappedNormalIndex = normalDupMap[remappedNormalIndex];
-                 }
-
-                if (iv.normalIndex == remappedNormalIndex)
-                  normEqual = true;
-              }
-
-              if (!inputs[TEXCOORD].empty())
-              {
-                // \todo: Add support for multiple texture maps to SubMesh.
-                // Here we are only using the first texture coordinates, when
-                // multiple could have been specified. See Gazebo issue #532.
-
-                // Get the vertex texcoord index value. If the texcoord is a
-                // duplicate then reset the index to the first instance of the
-                // duplicated texcoord
-                unsigned int remappedTexcoordIndex =
-                  values[*inputs[TEXCOORD].begin()];
-
-                if (texDupMap.find(remappedTexcoordIndex) != texDupMap.end())
-                  remappedTexcoordIndex = texDupMap[remappedTexcoordIndex];
-
-                texEqual = iv.texcoordIndex == remappedTexcoordIndex;
-              }
-
-              // if the vertex has matching normal and texcoord index values
-              // then the vertex can be reused.
-              if ((inputs[NORMAL].empty() || normEqual) &&
-                  (inputs[TEXCOORD].empty() || texEqual))
-              {
-                // found a vertex that can be shared.
-                toDuplicate = false;
-                reuseIndex = iv.mappedIndex;
-                subMesh->AddIndex(reuseIndex);
-                break;
-              }
-            }
-            addIndex = toDuplicate;
-          }
+          daeVertIndex = remapIndex(positionDupMap,
+              values[*inputs[VERTEX].begin()]);
+        }
+        if (!inputs[NORMAL].empty())
+        {
+          normalIndex = remapIndex(normalDupMap,
+              values[*inputs[NORMAL].begin()]);
+        }
+        if (!inputs[TEXCOORD].empty())
+        {
+          // \todo: Add support for multiple texture maps to SubMesh.
+          // Here we are only using the first texture coordinates, when
+          // multiple could have been specified. See Gazebo issue #532.
+          texcoordIndex = remapIndex(texDupMap,
+              values[*inputs[TEXCOORD].begin()]);
         }
 
-        // if the vertex index is new or can not be shared then add it
-        if (addIndex)
+        // find a vertex with the same position, normal and texcoord that
+        // can be reused. only do this if the mesh has vertices
+        IndexTuple key(daeVertIndex, normalIndex, texcoordIndex);
+        if (!inputs[VERTEX].empty())
         {
-          GeometryIndices input;
-          if (!inputs[VERTEX].empty())
-          {
-            subMesh->AddVertex(verts[daeVertIndex]);
-            unsigned int newVertIndex = subMesh->GetVertexCount()-1;
-            subMesh->AddIndex(newVertIndex);
-            if (combinedVertNorms)
-              subMesh->AddNormal(norms[daeVertIndex]);
-            if (_mesh->HasSkeleton())
-            {
-              subMesh->SetVertex(newVertIndex, bindShapeMat *
-                  subMesh->Vertex(newVertIndex));
-              Skeleton *skel = _mesh->GetSkeleton();
-              for (unsigned int i = 0;
-                  i < skel->GetNumVertNodeWeights(daeVertIndex); ++i)
-              {
-                std::pair<std::string, double> node_weight =
-                  skel->GetVertNodeWeight(daeVertIndex, i);
-                SkeletonNode *node =
-                    _mesh->GetSkeleton()->GetNodeByName(node_weight.first);
-                subMesh->AddNodeAssignment(subMesh->GetVertexCount()-1,
-                                node->GetHandle(), node_weight.second);
-              }
-            }
-            input.vertexIndex = daeVertIndex;
-            input.mappedIndex = newVertIndex;
-          }
-          if (!inputs[NORMAL].empty())
+          auto iter = vertexIndexMap.find(key);
+          if (iter != vertexIndexMap.end())
           {
-            unsigned int inputRemappedNormalIndex =
-              values[*inputs[NORMAL].begin()];
-            if (normalDupMap.find(inputRemappedNormalIndex)
-                != normalDupMap.end())
-              inputRemappedNormalIndex = normalDupMap[inputRemappedNormalIndex];
-            subMesh->AddNormal(norms[inputRemappedNormalIndex]);
-            input.normalIndex = inputRemappedNormalIndex;
+            subMesh->AddIndex(iter->second);
+            continue;
           }
+        }
 
-          if (!inputs[TEXCOORD].empty())
+        // the vertex is new, add it
+        if (!inputs[VERTEX].empty())
+        {
+          subMesh->AddVertex(verts[daeVertIndex]);
+          unsigned int newVertIndex = subMesh->GetVertexCount()-1;
+          subMesh->AddIndex(newVertIndex);
+          if (combinedVertNorms)
+            subMesh->AddNormal(norms[daeVertIndex]);
+          if (_mesh->HasSkeleton())
           {
-            // \todo: Add support for multiple texture maps to SubMesh.
-            // Here we are only using the first texture coordinates, when
-            // multiple could have been specified.
-            unsigned int inputRemappedTexcoordIndex =
-              values[*inputs[TEXCOORD].begin()];
-
-            if (texDupMap.find(inputRemappedTexcoordIndex) != texDupMap.end())
+            subMesh->SetVertex(newVertIndex, bindShapeMat *
+                subMesh->Vertex(newVertIndex));
+            Skeleton *skel = _mesh->GetSkeleton();
+            for (unsigned int i = 0;
+                i < skel->GetNumVertNodeWeights(daeVertIndex); ++i)
             {
-              inputRemappedTexcoordIndex =
-                  texDupMap[inputRemappedTexcoordIndex];
+              std::pair<std::string, double> node_weight =
+                skel->GetVertNodeWeight(daeVertIndex, i);
+              SkeletonNode *node =
+                  _mesh->GetSkeleton()->GetNodeByName(node_weight.first);
+              subMesh->AddNodeAssignment(subMesh->GetVertexCount()-1,
+                              node->GetHandle(), node_weight.second);
             }
-            subMesh->AddTexCoord(texcoords[inputRemappedTexcoordIndex].X(),
-                texcoords[inputRemappedTexcoordIndex].Y());
-            input.texcoordIndex = inputRemappedTexcoordIndex;
           }
 
           // add the new gazebo submesh vertex index to the map
-          if (!inputs[VERTEX].empty())
-          {
-            std::vector<GeometryIndices> inputValues;
-            inputValues.push_back(input);
-            vertexIndexMap[daeVertIndex] = inputValues;
-          }
+          vertexIndexMap.emplace(key, newVertIndex);
+        }
+        if (!inputs[NORMAL].empty())
+          subMesh->AddNormal(norms[normalIndex]);
+
+        if (!inputs[TEXCOORD].empty())
+        {
+          subMesh->AddTexCoord(texcoords[texcoordIndex].X(),
+              texcoords[texcoordIndex].Y());
         }
       }
     }
   }
-  delete [] values;
 
-  _mesh->AddSubMesh(subMesh);
+  return subMesh;
 }
 
 /////////////////////////////////////////////////
-void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
+SubMesh *ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
                                   const ignition::math::Matrix4d &_transform,
-                                  Mesh *_mesh)
+                                  const Mesh *_mesh)
 {
   std::unique_ptr<SubMesh> subMesh(new SubMesh);
-  subMesh->SetName(this->dataPtr->currentNodeName);
   bool combinedVertNorms = false;
 
   subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
 
-  if (_trianglesXml->Attribute("material"))
-  {
-    std::map<std::string, std::string>::iterator iter;
-    std::string matStr = _trianglesXml->Attribute("material");
-
-    int matIndex = -1;
-    iter = this->dataPtr->materialMap.find(matStr);
-    if (iter != this->dataPtr->materialMap.end())
-      matStr = iter->second;
-
-    common::Material *mat = this->LoadMaterial(matStr);
-    matIndex = _mesh->GetMaterialIndex(mat);
-    if (matIndex < 0)
-      matIndex = _mesh->AddMaterial(mat);
-
-    if (matIndex < 0)
-      gzwarn << "Unable to add material[" << matStr << "]\n";
-    else
-      subMesh->SetMaterialIndex(matIndex);
-  }
-
   TiXmlElement *trianglesInputXml = _trianglesXml->FirstChildElement("input");
 
   std::vector<ignition::math::Vector3d> verts;
@@ -1950,9 +2114,9 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
         << "This is likely not desired\n";
     }
 
-    return;
+    return nullptr;
   }
-  std::string pStr = pXml->GetText();
+  const std::vector<unsigned int> &indices = this->dataPtr->IndexArray(pXml);
 
   // Collada format allows normals and texcoords to have their own set of
   // indices for more efficient storage of data but opengl only supports one
@@ -1960,162 +2124,99 @@ void ColladaLoader::LoadTriangles(TiXmlElement *_trianglesXml,
   // index and duplicate any vertices that have the same index but different
   // normal/texcoord.
 
-  // vertexIndexMap is a map of collada vertex index to Gazebo submesh vertex
-  // indices, used for identifying vertices that can be shared.
-  std::map<unsigned int, std::vector<GeometryIndices> > vertexIndexMap;
+  // vertexIndexMap maps the collada position, normal and texcoord indices
+  // of a vertex to its Gazebo submesh index, used for identifying vertices
+  // that can be shared.
+  std::unordered_map<IndexTuple, unsigned int, IndexTupleHash>
+    vertexIndexMap;
+  vertexIndexMap.reserve(indices.size() / std::max(offsetSize, 1u));
 
   std::vector<unsigned int> values(offsetSize);
-  std::vector<std::string> strs;
 
-  boost::split(strs, pStr, boost::is_any_of(" \t"));
-
-  for (unsigned int j = 0; j < strs.size(); j += offsetSize)
+  for (std::size_t j = 0; offsetSize > 0 && j + offsetSize <= indices.size();
+       j += offsetSize)
   {
     for (unsigned int i = 0; i < offsetSize; ++i)
-      values.at(i) = ignition::math::parseInt(strs[j+i]);
+      values.at(i) = indices[j+i];
 
+    // Get the position, normal and texcoord index values. Duplicates are
+    // reset to the index of their first instance.
     unsigned int daeVertIndex = 0;
-    bool addIndex = !hasVertices;
-
-    // find a set of vertex/normal/texcoord that can be reused
-    // only do this if the mesh has vertices
+    unsigned int normalIndex = 0;
+    unsigned int texcoordIndex = 0;
     if (hasVertices)
     {
-      // Get the vertex position index value. If the position is a duplicate
-      // then reset the index to the first instance of the duplicated position
-      daeVertIndex = values.at(*inputs[VERTEX].begin());
-      if (positionDupMap.find(daeVertIndex) != positionDupMap.end())
-        daeVertIndex = positionDupMap[daeVertIndex];
+      daeVertIndex = remapIndex(positionDupMap,
+          values.at(*inputs[VERTEX].begin()));
+    }
+    if (hasNormals)
+    {
+      normalIndex = remapIndex(normalDupMap,
+          values.at(*inputs[NORMAL].begin()));
+    }
+    if (hasTexcoords)
+    {
+      texcoordIndex = remapIndex(texDupMap,
+          values.at(*inputs[TEXCOORD].begin()));
+    }
 
-      // if the vertex index has not been previously added then just add it.
-      if (vertexIndexMap.find(daeVertIndex) == vertexIndexMap.end())
-      {
-        addIndex = true;
-      }
-      else
+    // find a vertex with the same position, normal and texcoord that can be
+    // reused. only do this if the mesh has vertices
+    IndexTuple key(daeVertIndex, normalIndex, texcoordIndex);
+    if (hasVertices)
+    {
+      auto iter = vertexIndexMap.find(key);
+      if (iter != vertexIndexMap.end())
       {
-        // if the vertex index was previously added, check to see if it has the
-        // same normal and texcoord index values
-        bool toDuplicate = true;
-        unsigned int reuseIndex = 0;
-        std::vector<GeometryIndices> inputValues = vertexIndexMap[daeVertIndex];
-
-        for (unsigned int i = 0; i < inputValues.size(); ++i)
-        {
-          GeometryIndices iv = inputValues[i];
-          bool normEqual = false;
-          bool texEqual = false;
-          if (hasNormals)
-          {
-            // Get the vertex normal index value. If the normal is a duplicate
-            // then reset the index to the first instance of the duplicated
-            // position
-            unsigned int remappedNormalIndex =
-              values.at(*inputs[NORMAL].begin());
-            if (normalDupMap.find(remappedNormalIndex) != normalDupMap.end())
-              remappedNormalIndex = normalDupMap[remappedNormalIndex];
-
-            if (iv.normalIndex == remappedNormalIndex)
-              normEqual = true;
-          }
-          if (hasTexcoords)
-          {
-            // Get the vertex texcoord index value. If the texcoord is a
-            // duplicate then reset the index to the first instance of the
-            // duplicated texcoord
-            unsigned int remappedTexcoordIndex =
-                values.at(*inputs[TEXCOORD].begin());
-            if (texDupMap.find(remappedTexcoordIndex) != texDupMap.end())
-              remappedTexcoordIndex = texDupMap[remappedTexcoordIndex];
-
-            if (iv.texcoordIndex == remappedTexcoordIndex)
-              texEqual = true;
-          }
-
-          // if the vertex has matching normal and texcoord index values then
-          // the vertex can be reused.
-          if ((!hasNormals || normEqual) && (!hasTexcoords || texEqual))
-          {
-            // found a vertex that can be shared.
-            toDuplicate = false;
-            reuseIndex = iv.mappedIndex;
-            subMesh->AddIndex(reuseIndex);
-            break;
-          }
-        }
-        addIndex = toDuplicate;
+        subMesh->AddIndex(iter->second);
+        continue;
       }
     }
 
-    // if the vertex index is new or can not be shared then add it
-    if (addIndex)
+    // the vertex is new, add it
+    if (hasVertices)
     {
-      GeometryIndices input;
-      if (hasVertices)
-      {
-        subMesh->AddVertex(verts[daeVertIndex]);
-        unsigned int newVertIndex = subMesh->GetVertexCount()-1;
-        subMesh->AddIndex(newVertIndex);
+      subMesh->AddVertex(verts[daeVertIndex]);
+      unsigned int newVertIndex = subMesh->GetVertexCount()-1;
+      subMesh->AddIndex(newVertIndex);
 
-        if (combinedVertNorms)
-          subMesh->AddNormal(norms[daeVertIndex]);
-        if (_mesh->HasSkeleton())
+      if (combinedVertNorms)
+        subMesh->AddNormal(norms[daeVertIndex]);
+      if (_mesh->HasSkeleton())
+      {
+        Skeleton *skel = _mesh->GetSkeleton();
+        for (unsigned int i = 0;
+            i < skel->GetNumVertNodeWeights(daeVertIndex); ++i)
         {
-          Skeleton *skel = _mesh->GetSkeleton();
-          for (unsigned int i = 0;
-              i < skel->GetNumVertNodeWeights(daeVertIndex); ++i)
-          {
-            std::pair<std::string, double> node_weight =
-              skel->GetVertNodeWeight(daeVertIndex, i);
-            SkeletonNode *node =
-                _mesh->GetSkeleton()->GetNodeByName(node_weight.first);
-            subMesh->AddNodeAssignment(subMesh->GetVertexCount()-1,
-                            node->GetHandle(), node_weight.second);
-          }
+          std::pair<std::string, double> node_weight =
+            skel->GetVertNodeWeight(daeVertIndex, i);
+          SkeletonNode *node =
+              _mesh->GetSkeleton()->GetNodeByName(node_weight.first);
+          subMesh->AddNodeAssignment(subMesh->GetVertexCount()-1,
+                          node->GetHandle(), node_weight.second);
         }
-        input.vertexIndex = daeVertIndex;
-        input.mappedIndex = newVertIndex;
-      }
-      if (hasNormals)
-      {
-        unsigned int inputRemappedNormalIndex =
-          values.at(*inputs[NORMAL].begin());
-        if (normalDupMap.find(inputRemappedNormalIndex) != normalDupMap.end())
-          inputRemappedNormalIndex = normalDupMap[inputRemappedNormalIndex];
-        subMesh->AddNormal(norms[inputRemappedNormalIndex]);
-        input.normalIndex = inputRemappedNormalIndex;
-      }
-      if (hasTexcoords)
-      {
-        unsigned int inputRemappedTexcoordIndex =
-            values.at(*inputs[TEXCOORD].begin());
-        if (texDupMap.find(inputRemappedTexcoordIndex) != texDupMap.end())
-          inputRemappedTexcoordIndex = texDupMap[inputRemappedTexcoordIndex];
-        subMesh->AddTexCoord(texcoords[inputRemappedTexcoordIndex].X(),
-            texcoords[inputRemappedTexcoordIndex].Y());
-        input.texcoordIndex = inputRemappedTexcoordIndex;
       }
 
       // add the new gazebo submesh vertex index to the map
-      if (hasVertices)
-      {
-        std::vector<GeometryIndices> inputValues;
-        inputValues.push_back(input);
-        vertexIndexMap[daeVertIndex] = inputValues;
-      }
+      vertexIndexMap.emplace(key, newVertIndex);
+    }
+    if (hasNormals)
+      subMesh->AddNormal(norms[normalIndex]);
+    if (hasTexcoords)
+    {
+      subMesh->AddTexCoord(texcoords[texcoordIndex].X(),
+          texcoords[texcoordIndex].Y());
     }
   }
 
-  _mesh->AddSubMesh(subMesh.release());
+  return subMesh.release();
 }
 
 /////////////////////////////////////////////////
-void ColladaLoader::LoadLines(TiXmlElement *_xml,
-    const ignition::math::Matrix4d &_transform,
-    Mesh *_mesh)
+SubMesh *ColladaLoader::LoadLines(TiXmlElement *_xml,
+    const ignition::math::Matrix4d &_transform)
 {
   SubMesh *subMesh = new SubMesh;
-  subMesh->SetName(this->dataPtr->currentNodeName);
   subMesh->SetPrimitiveType(SubMesh::LINES);
 
   TiXmlElement *inputXml = _xml->FirstChildElement("input");
@@ -2127,23 +2228,17 @@ void ColladaLoader::LoadLines(TiXmlElement *_xml,
   this->LoadVertices(source, _transform, verts, norms);
 
   TiXmlElement *pXml = _xml->FirstChildElement("p");
-  std::string pStr = pXml->GetText();
-  std::istringstream iss(pStr);
+  const std::vector<unsigned int> &indices = this->dataPtr->IndexArray(pXml);
 
-  do
+  for (std::size_t i = 0; i + 1 < indices.size(); i += 2)
   {
-    int a, b;
-    iss >> a >> b;
-
-    if (!iss)
-      break;
-    subMesh->AddVertex(verts[a]);
+    subMesh->AddVertex(verts[indices[i]]);
     subMesh->AddIndex(subMesh->GetVertexCount() - 1);
-    subMesh->AddVertex(verts[b]);
+    subMesh->AddVertex(verts[indices[i+1]]);
     subMesh->AddIndex(subMesh->GetVertexCount() - 1);
-  } while (iss);
+  }
 
-  _mesh->AddSubMesh(subMesh);
+  return subMesh;
 }
 
 /////////////////////////////////////////////////
@@ -36,6 +36,7 @@ namespace gazebo
   namespace common
   {
     class Material;
+    class SubMesh;
     class ColladaLoaderPrivate;
 
     /// \addtogroup gazebo_common Common
@@ -191,29 +192,42 @@ namespace gazebo
                                        const std::string &_type,
                                        Material *_mat);
 
+      /// \brief Load the material index of a primitive element, adding the
+      /// material to the mesh if needed
+      /// \param[in] _xml Pointer to the triangles or polylist XML element
+      /// \param[in,out] _mesh Mesh that is currently being loaded
+      /// \return Index of the material in the mesh, -1 if there is none
+      private: int LoadMaterialIndex(TiXmlElement *_xml, Mesh *_mesh);
+
+      /// \brief Build the submeshes of the pending primitive elements on
+      /// several threads, and add them to the mesh in document order
+      /// \param[in,out] _mesh Mesh that is currently being loaded
+      private: void LoadPendingSubMeshes(Mesh *_mesh);
+
       /// \brief Load triangles
       /// \param[in] _trianglesXml Pointer the triangles XML instance
       /// \param[in] _transform Transform to apply to all triangles
-      /// \param[out] _mesh Mesh that is currently being loaded
-      private: void LoadTriangles(TiXmlElement *_trianglesXml,
+      /// \param[in] _mesh Mesh that is currently being loaded
+      /// \return New submesh, null if the triangles are invalid
+      private: SubMesh *LoadTriangles(TiXmlElement *_trianglesXml,
                                    const ignition::math::Matrix4d &_transform,
-                                   Mesh *_mesh);
+                                   const Mesh *_mesh);
 
       /// \brief Load a polygon list
       /// \param[in] _polylistXml Pointer to the XML element
       /// \param[in] _transform Transform to apply to each polygon
-      /// \param[out] _mesh Mesh that is currently being loaded
-      private: void LoadPolylist(TiXmlElement *_polylistXml,
+      /// \param[in] _mesh Mesh that is currently being loaded
+      /// \return New submesh, null if the polygon list is invalid
+      private: SubMesh *LoadPolylist(TiXmlElement *_polylistXml,
                                    const ignition::math::Matrix4d &_transform,
-                                   Mesh *_mesh);
+                                   const Mesh *_mesh);
 
       /// \brief Load lines
       /// \param[in] _xml Pointer to the XML element
       /// \param[in] _transform Transform to apply
-      /// \param[out] _mesh Mesh that is currently being loaded
-      private: void LoadLines(TiXmlElement *_xml,
-                               const ignition::math::Matrix4d &_transform,
-                               Mesh *_mesh);
+      /// \return New submesh
+      private: SubMesh *LoadLines(TiXmlElement *_xml,
+                               const ignition::math::Matrix4d &_transform);
 
       /// \brief Load an entire scene
       /// \param[out] _mesh Mesh that is currently being loaded
@@ -18,9 +18,13 @@
 #define _GAZEBO_COLLADALOADER_PRIVATE_HH_
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include <ignition/math/Matrix4.hh>
+#include <ignition/math/Vector2.hh>
 #include <ignition/math/Vector3.hh>
 #include <tinyxml.h>
 
@@ -32,9 +36,43 @@ namespace gazebo
   {
     class Material;
 
+    /// \brief A primitive element whose submesh is yet to be built.
+    class PendingSubMesh
+    {
+      /// \brief The triangles, polylist or lines element.
+      public: TiXmlElement *xml;
+
+      /// \brief Transform of the node instancing the geometry.
+      public: ignition::math::Matrix4d transform;
+
+      /// \brief Name of the node instancing the geometry.
+      public: std::string name;
+
+      /// \brief Index of the material in the mesh, -1 if there is none.
+      public: int materialIndex;
+    };
+
     /// \brief Private data for the ColladaLoader class
     class  ColladaLoaderPrivate
     {
+      /// \brief Index the id and sid attributes of the document, and parse
+      /// the numeric arrays of the geometries in parallel.
+      public: void Prepare();
+
+      /// \brief Forget the index and the parsed arrays.
+      public: void Clear();
+
+      /// \brief Get the values of a float_array element.
+      /// \param[in] _elem The float_array element.
+      /// \return The parsed values.
+      public: const std::vector<double> &FloatArray(TiXmlElement *_elem);
+
+      /// \brief Get the values of a p or vcount element.
+      /// \param[in] _elem The index array element.
+      /// \return The parsed values.
+      public: const std::vector<unsigned int> &IndexArray(
+                  TiXmlElement *_elem);
+
       /// \brief scaling factor
       public: double meter;
 
@@ -56,6 +94,24 @@ namespace gazebo
       /// \brief current scene being parsed
       public: TiXmlElement *currentScene;
 
+      /// \brief First element of the document with each id or sid.
+      public: std::unordered_map<std::string, TiXmlElement *> elementIds;
+
+      /// \brief Values of the float_array elements, by element.
+      public: std::unordered_map<const TiXmlElement *, std::vector<double>>
+          floatArrays;
+
+      /// \brief Values of the p and vcount elements, by element.
+      public: std::unordered_map<const TiXmlElement *,
+          std::vector<unsigned int>> indexArrays;
+
+      /// \brief Protects the parsed arrays and the source caches below,
+      /// which are shared by the threads building submeshes.
+      public: std::mutex cacheMutex;
+
+      /// \brief Primitive elements met since the submeshes were last built.
+      public: std::vector<PendingSubMesh> pendingSubMeshes;
+
       /// \brief Map of collada POSITION ids to list of vectors.
       public: std::map<std::string,
               std::vector<ignition::math::Vector3d> > positionIds;
@@ -86,22 +142,6 @@ namespace gazebo
       public: std::map<std::string, std::map<unsigned int, unsigned int> >
           texcoordDuplicateMap;
     };
-
-    /// \brief Helper data structure for loading collada geometries.
-    class GeometryIndices
-    {
-      /// \brief Index of a vertex in the collada <p> element
-      public: unsigned int vertexIndex;
-
-      /// \brief Index of a normal in the collada <p> element
-      public: unsigned int normalIndex;
-
-      /// \brief Index of a texture coordinate in the collada <p> element
-      public: unsigned int texcoordIndex;
-
-      /// \brief Index of a vertex in the Gazebo mesh
-      public: unsigned int mappedIndex;
-    };
   }
 }
 #endif
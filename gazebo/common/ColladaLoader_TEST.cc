@@ -190,10 +190,10 @@ TEST_F(ColladaLoader, LoadBoxInstControllerWithoutSkeleton)
       "/test/data/box_inst_controller_without_skeleton.dae");
 
   EXPECT_EQ(36u, mesh->GetIndexCount());
-  EXPECT_EQ(35u, mesh->GetVertexCount());
+  EXPECT_EQ(24u, mesh->GetVertexCount());
   EXPECT_EQ(1u, mesh->GetSubMeshCount());
   EXPECT_EQ(1u, mesh->GetMaterialCount());
-  EXPECT_EQ(35u, mesh->GetTexCoordCount());
+  EXPECT_EQ(24u, mesh->GetTexCoordCount());
   gazebo::common::Skeleton *skeleton = mesh->GetSkeleton();
   EXPECT_LT(0u, skeleton->GetNumNodes());
   EXPECT_NE(nullptr, skeleton->GetNodeById("Armature_Bone"));
@@ -208,19 +208,19 @@ TEST_F(ColladaLoader, LoadBoxMultipleInstControllers)
       "/test/data/box_multiple_inst_controllers.dae");
 
   EXPECT_EQ(72u, mesh->GetIndexCount());
-  EXPECT_EQ(70u, mesh->GetVertexCount());
+  EXPECT_EQ(48u, mesh->GetVertexCount());
   EXPECT_EQ(2u, mesh->GetSubMeshCount());
   EXPECT_EQ(1u, mesh->GetMaterialCount());
-  EXPECT_EQ(70u, mesh->GetTexCoordCount());
+  EXPECT_EQ(48u, mesh->GetTexCoordCount());
 
   const gazebo::common::SubMesh *submesh = mesh->GetSubMesh(0);
   const gazebo::common::SubMesh *submesh2 = mesh->GetSubMesh(1);
   EXPECT_EQ(36u, submesh->GetIndexCount());
   EXPECT_EQ(36u, submesh2->GetIndexCount());
-  EXPECT_EQ(35u, submesh->GetVertexCount());
-  EXPECT_EQ(35u, submesh2->GetVertexCount());
-  EXPECT_EQ(35u, submesh->GetTexCoordCount());
-  EXPECT_EQ(35u, submesh2->GetTexCoordCount());
+  EXPECT_EQ(24u, submesh->GetVertexCount());
+  EXPECT_EQ(24u, submesh2->GetVertexCount());
+  EXPECT_EQ(24u, submesh->GetTexCoordCount());
+  EXPECT_EQ(24u, submesh2->GetTexCoordCount());
 
   gazebo::common::Skeleton *skeleton = mesh->GetSkeleton();
   EXPECT_NE(nullptr, skeleton->GetNodeById("Armature_Bone"));
@@ -236,10 +236,10 @@ TEST_F(ColladaLoader, LoadBoxNestedAnimation)
       "/test/data/box_nested_animation.dae");
 
   EXPECT_EQ(36u, mesh->GetIndexCount());
-  EXPECT_EQ(35u, mesh->GetVertexCount());
+  EXPECT_EQ(24u, mesh->GetVertexCount());
   EXPECT_EQ(1u, mesh->GetSubMeshCount());
   EXPECT_EQ(1u, mesh->GetMaterialCount());
-  EXPECT_EQ(35u, mesh->GetTexCoordCount());
+  EXPECT_EQ(24u, mesh->GetTexCoordCount());
   gazebo::common::Skeleton *skeleton = mesh->GetSkeleton();
   ASSERT_EQ(1u, mesh->GetSkeleton()->GetNumAnimations());
   gazebo::common::SkeletonAnimation *anim = skeleton->GetAnimation(0);
@@ -270,10 +270,10 @@ TEST_F(ColladaLoader, LoadBoxWithDefaultStride)
       "/test/data/box_with_default_stride.dae");
 
   EXPECT_EQ(36u, mesh->GetIndexCount());
-  EXPECT_EQ(35u, mesh->GetVertexCount());
+  EXPECT_EQ(24u, mesh->GetVertexCount());
   EXPECT_EQ(1u, mesh->GetSubMeshCount());
   EXPECT_EQ(1u, mesh->GetMaterialCount());
-  EXPECT_EQ(35u, mesh->GetTexCoordCount());
+  EXPECT_EQ(24u, mesh->GetTexCoordCount());
   ASSERT_EQ(1u, mesh->GetSkeleton()->GetNumAnimations());
 }
 
@@ -295,6 +295,42 @@ TEST_F(ColladaLoader, LoadBoxWithMultipleGeoms)
   EXPECT_EQ(0u, mesh->GetSubMesh(1)->GetNodeAssignmentsCount());
 }
 
+/////////////////////////////////////////////////
+TEST_F(ColladaLoader, LoadMultipleGeometries)
+{
+  common::ColladaLoader loader;
+  common::Mesh *mesh = loader.Load(
+      std::string(PROJECT_SOURCE_PATH) +
+      "/test/data/multiple_geometries.dae");
+
+  // The submeshes are built in parallel, but keep the order of the nodes
+  ASSERT_EQ(4u, mesh->GetSubMeshCount());
+  EXPECT_EQ(2u, mesh->GetMaterialCount());
+
+  const common::SubMesh *lines2 = mesh->GetSubMesh(0);
+  EXPECT_EQ("Lines2", lines2->GetName());
+  EXPECT_EQ(common::SubMesh::LINES, lines2->GetPrimitiveType());
+  EXPECT_EQ(4u, lines2->GetVertexCount());
+
+  const common::SubMesh *cube = mesh->GetSubMesh(1);
+  EXPECT_EQ("Cube", cube->GetName());
+  EXPECT_EQ(common::SubMesh::TRIANGLES, cube->GetPrimitiveType());
+  EXPECT_EQ(24u, cube->GetVertexCount());
+  EXPECT_EQ(0u, cube->GetMaterialIndex());
+
+  const common::SubMesh *triangle = mesh->GetSubMesh(2);
+  EXPECT_EQ("Triangle", triangle->GetName());
+  EXPECT_EQ(3u, triangle->GetVertexCount());
+  EXPECT_EQ(1u, triangle->GetMaterialIndex());
+
+  const common::SubMesh *lines = mesh->GetSubMesh(3);
+  EXPECT_EQ("Lines", lines->GetName());
+  EXPECT_EQ(4u, lines->GetVertexCount());
+  EXPECT_EQ(ignition::math::Vector3d(1, 1, 3), lines->Vertex(3));
+
+  delete mesh;
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/CompiledSdf.hh"
+#include "gazebo/common/Console.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Appends fixed size values and strings to a buffer.
+    class CompiledSdfWriter
+    {
+      /// \brief Append a value.
+      /// \param[in] _value The value.
+      public: template<typename T>
+              void Write(const T _value)
+              {
+                this->buffer.append(reinterpret_cast<const char *>(&_value),
+                    sizeof(_value));
+              }
+
+      /// \brief Append a length prefixed string.
+      /// \param[in] _value The string.
+      public: void WriteString(const std::string &_value)
+              {
+                this->Write(static_cast<uint32_t>(_value.size()));
+                this->buffer.append(_value);
+              }
+
+      /// \brief The serialized data.
+      public: std::string buffer;
+    };
+
+    /// \internal
+    /// \brief Reads values written by CompiledSdfWriter, checking bounds.
+    class CompiledSdfReader
+    {
+      /// \brief Constructor
+      /// \param[in] _data The data.
+      public: explicit CompiledSdfReader(const std::string &_data)
+              : data(_data.data()), end(_data.data() + _data.size())
+              {
+              }
+
+      /// \brief Read a value.
+      /// \param[out] _value The value.
+      /// \return False if the data is too short.
+      public: template<typename T>
+              bool Read(T &_value)
+              {
+                if (static_cast<std::size_t>(this->end - this->data) <
+                    sizeof(_value))
+                {
+                  return false;
+                }
+                std::memcpy(&_value, this->data, sizeof(_value));
+                this->data += sizeof(_value);
+                return true;
+              }
+
+      /// \brief Read a length prefixed string.
+      /// \param[out] _value The string.
+      /// \return False if the data is too short.
+      public: bool ReadString(std::string &_value)
+              {
+                uint32_t size;
+                if (!this->Read(size) ||
+                    static_cast<std::size_t>(this->end - this->data) < size)
+                {
+                  return false;
+                }
+                _value.assign(this->data, size);
+                this->data += size;
+                return true;
+              }
+
+      /// \brief Check that a number of elements of a given size fit in the
+      /// remaining data.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _size Size of an element.
+      /// \return True if they fit.
+      public: bool Fits(const uint32_t _count, const std::size_t _size) const
+              {
+                return static_cast<std::size_t>(this->end - this->data) /
+                    _size >= _count;
+              }
+
+      /// \brief Current read position.
+      private: const char *data;
+
+      /// \brief End of the data.
+      private: const char *end;
+    };
+  }
+}
+
+/// \brief Identifies a compiled file.
+static const uint32_t kCompiledSdfMagic = 0x63736467;
+
+/// \brief Version of the layout of compiled files.
+static const uint32_t kCompiledSdfVersion = 1;
+
+/// \brief Smallest size of a serialized element: an empty name, no
+/// attributes, no value and no children.
+static const std::size_t kMinElementSize =
+    sizeof(uint32_t) * 3 + sizeof(uint8_t);
+
+/////////////////////////////////////////////////
+/// \brief Serialize an element and its descendants.
+/// \param[in] _elem The element.
+/// \param[in, out] _writer Receives the element.
+static void writeElement(const sdf::ElementPtr &_elem,
+    CompiledSdfWriter &_writer)
+{
+  _writer.WriteString(_elem->GetName());
+
+  // The attributes that sdf::Element::ToString would print
+  std::vector<sdf::ParamPtr> attributes;
+  for (size_t i = 0; i < _elem->GetAttributeCount(); ++i)
+  {
+    sdf::ParamPtr attribute = _elem->GetAttribute(i);
+    if (attribute->GetSet() || attribute->GetRequired())
+      attributes.push_back(attribute);
+  }
+  _writer.Write(static_cast<uint32_t>(attributes.size()));
+  for (auto const &attribute : attributes)
+  {
+    _writer.WriteString(attribute->GetKey());
+    _writer.WriteString(attribute->GetAsString());
+  }
+
+  sdf::ParamPtr value = _elem->GetValue();
+  _writer.Write(static_cast<uint8_t>(value != nullptr));
+  if (value)
+    _writer.WriteString(value->GetAsString());
+
+  std::vector<sdf::ElementPtr> children;
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    children.push_back(child);
+  }
+  _writer.Write(static_cast<uint32_t>(children.size()));
+  for (auto const &child : children)
+    writeElement(child, _writer);
+}
+
+/////////////////////////////////////////////////
+/// \brief Deserialize the attributes, value and descendants of an element.
+/// \param[in, out] _reader The data.
+/// \param[in] _elem The element, which has its name already.
+/// \return False if the data is invalid.
+static bool readElement(CompiledSdfReader &_reader,
+    const sdf::ElementPtr &_elem)
+{
+  uint32_t attributeCount;
+  if (!_reader.Read(attributeCount) ||
+      !_reader.Fits(attributeCount, sizeof(uint32_t) * 2))
+  {
+    return false;
+  }
+  for (uint32_t i = 0; i < attributeCount; ++i)
+  {
+    std::string key, text;
+    if (!_reader.ReadString(key) || !_reader.ReadString(text))
+      return false;
+
+    // Elements without description, such as the content of a plugin,
+    // hold string attributes
+    sdf::ParamPtr attribute = _elem->GetAttribute(key);
+    if (!attribute)
+    {
+      _elem->AddAttribute(key, "string", "", false);
+      attribute = _elem->GetAttribute(key);
+    }
+    if (!attribute->SetFromString(text))
+      return false;
+  }
+
+  uint8_t hasValue;
+  if (!_reader.Read(hasValue))
+    return false;
+  if (hasValue)
+  {
+    std::string text;
+    if (!_reader.ReadString(text))
+      return false;
+
+    sdf::ParamPtr value = _elem->GetValue();
+    if (!value)
+      _elem->AddValue("string", text, false);
+    else if (!value->SetFromString(text))
+      return false;
+  }
+
+  uint32_t childCount;
+  if (!_reader.Read(childCount) || !_reader.Fits(childCount, kMinElementSize))
+    return false;
+  for (uint32_t i = 0; i < childCount; ++i)
+  {
+    std::string name;
+    if (!_reader.ReadString(name))
+      return false;
+
+    sdf::ElementPtr child;
+    if (_elem->HasElementDescription(name))
+    {
+      // Drop the required children added with defaults, the file has them
+      child = _elem->AddElement(name);
+      child->ClearElements();
+    }
+    else
+    {
+      child.reset(new sdf::Element());
+      child->SetName(name);
+      child->SetParent(_elem);
+      _elem->InsertElement(child);
+    }
+
+    if (!readElement(_reader, child))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool CompiledSdf::Write(const sdf::ElementPtr &_world,
+    const std::string &_filename)
+{
+  CompiledSdfWriter writer;
+  writer.Write(kCompiledSdfMagic);
+  writer.Write(kCompiledSdfVersion);
+  writer.WriteString(SDF_VERSION);
+
+  // The <sdf> element, with the world as its only child
+  writer.WriteString("sdf");
+  writer.Write(static_cast<uint32_t>(1));
+  writer.WriteString("version");
+  writer.WriteString(SDF_VERSION);
+  writer.Write(static_cast<uint8_t>(0));
+  writer.Write(static_cast<uint32_t>(1));
+  writeElement(_world, writer);
+
+  std::ofstream out(_filename, std::ios::out | std::ios::binary);
+  out.write(writer.buffer.data(), writer.buffer.size());
+  if (!out)
+  {
+    gzerr << "Unable to write compiled sdf file[" << _filename << "]\n";
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool CompiledSdf::IsCompiled(const std::string &_filename)
+{
+  std::ifstream in(_filename, std::ios::in | std::ios::binary);
+  uint32_t magic = 0;
+  in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  return in && magic == kCompiledSdfMagic;
+}
+
+/////////////////////////////////////////////////
+bool CompiledSdf::Read(const std::string &_filename, sdf::SDFPtr _sdf)
+{
+  std::ifstream in(_filename, std::ios::in | std::ios::binary);
+  if (!in)
+  {
+    gzerr << "Unable to open compiled sdf file[" << _filename << "]\n";
+    return false;
+  }
+  const std::string data((std::istreambuf_iterator<char>(in)),
+      std::istreambuf_iterator<char>());
+
+  CompiledSdfReader reader(data);
+  uint32_t magic, version;
+  std::string sdfVersion, name;
+  if (!reader.Read(magic) || magic != kCompiledSdfMagic ||
+      !reader.Read(version) || version != kCompiledSdfVersion ||
+      !reader.ReadString(sdfVersion))
+  {
+    gzerr << "Invalid compiled sdf file[" << _filename << "]\n";
+    return false;
+  }
+
+  if (sdfVersion != SDF_VERSION)
+  {
+    gzerr << "Compiled sdf file[" << _filename << "] has SDF version ["
+          << sdfVersion << "], expected [" << SDF_VERSION
+          << "]. Compile the world again.\n";
+    return false;
+  }
+
+  sdf::ElementPtr root = _sdf->Root();
+  root->ClearElements();
+  if (!reader.ReadString(name) || name != root->GetName() ||
+      !readElement(reader, root))
+  {
+    gzerr << "Invalid compiled sdf file[" << _filename << "]\n";
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_COMPILEDSDF_HH_
+#define GAZEBO_COMMON_COMPILEDSDF_HH_
+
+#include <string>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class CompiledSdf CompiledSdf.hh common/common.hh
+    /// \brief Binary files of resolved SDF element trees.
+    ///
+    /// A compiled file holds the elements, attributes and values of a
+    /// world after its includes, conversions and default values have been
+    /// applied. Reading it builds the element tree directly, without
+    /// parsing XML, resolving includes or converting versions. A file is
+    /// only read by the SDF version that wrote it.
+    class GZ_COMMON_VISIBLE CompiledSdf
+    {
+      /// \brief Write a world to a compiled file.
+      /// \param[in] _world The <world> element.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      public: static bool Write(const sdf::ElementPtr &_world,
+                  const std::string &_filename);
+
+      /// \brief Get whether a file is a compiled file.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file starts like a compiled file.
+      public: static bool IsCompiled(const std::string &_filename);
+
+      /// \brief Read a compiled file.
+      /// \param[in] _filename Path of the file.
+      /// \param[out] _sdf SDF object initialized by sdf::init, which gets
+      /// the elements of the file.
+      /// \return False if the file is invalid or of another SDF version.
+      public: static bool Read(const std::string &_filename,
+                  sdf::SDFPtr _sdf);
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CompiledSdf.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CompiledSdf : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(CompiledSdf, WriteRead)
+{
+  const std::string worldString =
+      "<?xml version='1.0'?><sdf version='1.6'><world name='compiled'>"
+      "<gravity>0 0 -1</gravity>"
+      "<model name='box'><pose>1 2 3 0 0 0</pose>"
+      "<link name='link'><collision name='collision'><geometry>"
+      "<box><size>1 2 3</size></box></geometry></collision></link>"
+      "<plugin name='p' filename='libp.so'><gain scale='2'>4</gain>"
+      "<nested><item>a</item></nested></plugin>"
+      "</model></world></sdf>";
+
+  sdf::SDFPtr parsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(parsed));
+  ASSERT_TRUE(sdf::readString(worldString, parsed));
+  sdf::ElementPtr world = parsed->Root()->GetElement("world");
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_compiled_sdf_%%%%-%%%%");
+  EXPECT_FALSE(common::CompiledSdf::IsCompiled(path.string()));
+  ASSERT_TRUE(common::CompiledSdf::Write(world, path.string()));
+  EXPECT_TRUE(common::CompiledSdf::IsCompiled(path.string()));
+
+  sdf::SDFPtr compiled(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(compiled));
+  ASSERT_TRUE(common::CompiledSdf::Read(path.string(), compiled));
+
+  // The same elements, attributes and values
+  sdf::ElementPtr compiledWorld = compiled->Root()->GetElement("world");
+  EXPECT_EQ(world->ToString(""), compiledWorld->ToString(""));
+
+  EXPECT_EQ(ignition::math::Vector3d(0, 0, -1),
+      compiledWorld->Get<ignition::math::Vector3d>("gravity"));
+  sdf::ElementPtr model = compiledWorld->GetElement("model");
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+      model->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3),
+      model->GetElement("link")->GetElement("collision")->
+      GetElement("geometry")->GetElement("box")->
+      Get<ignition::math::Vector3d>("size"));
+
+  sdf::ElementPtr gain = model->GetElement("plugin")->GetElement("gain");
+  EXPECT_EQ("4", gain->Get<std::string>());
+  EXPECT_EQ("2", gain->Get<std::string>("scale"));
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompiledSdf, Invalid)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_compiled_sdf_%%%%-%%%%");
+
+  // A world file isn't compiled
+  {
+    std::ofstream out(path.string());
+    out << "<?xml version='1.0'?><sdf version='1.6'/>";
+  }
+  EXPECT_FALSE(common::CompiledSdf::IsCompiled(path.string()));
+
+  sdf::SDFPtr parsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(parsed));
+  EXPECT_FALSE(common::CompiledSdf::Read(path.string(), parsed));
+
+  // A truncated file is rejected
+  sdf::SDFPtr world(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(world));
+  ASSERT_TRUE(sdf::readString(
+      "<?xml version='1.0'?><sdf version='1.6'><world name='w'/></sdf>",
+      world));
+  ASSERT_TRUE(common::CompiledSdf::Write(world->Root()->GetElement("world"),
+        path.string()));
+  boost::filesystem::resize_file(path,
+      boost::filesystem::file_size(path) - 1);
+  EXPECT_TRUE(common::CompiledSdf::IsCompiled(path.string()));
+  EXPECT_FALSE(common::CompiledSdf::Read(path.string(), parsed));
+
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
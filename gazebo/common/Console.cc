@@ -14,7 +14,16 @@
  * limitations under the License.
  *
  */
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/regex.hpp>
@@ -37,6 +46,490 @@ Logger Console::warn("[Wrn] ", 33, Logger::STDERR);
 
 bool Console::quiet = true;
 
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Destination of a queued line.
+    enum ConsoleOutput
+    {
+      /// \brief The log file, for gzlog.
+      CONSOLE_FILE,
+
+      /// \brief The log file and stdout.
+      CONSOLE_STDOUT,
+
+      /// \brief The log file and stderr.
+      CONSOLE_STDERR
+    };
+
+    /// \internal
+    /// \brief Number of lines of the ring buffer of a thread.
+    static const size_t kConsoleRingSize = 1024;
+
+    /// \internal
+    /// \brief Nanoseconds after a line is written during which its repeats
+    /// are counted instead of written.
+    static const int64_t kConsoleRepeatNs = 1000000000;
+
+    /// \internal
+    /// \brief True when the loggers queue their lines.
+    static std::atomic<bool> g_consoleAsync{false};
+
+    /// \internal
+    /// \brief A line queued by a logger.
+    class ConsoleLine
+    {
+      /// \brief Destination of the line.
+      public: ConsoleOutput output = CONSOLE_FILE;
+
+      /// \brief SGR color of the terminal output.
+      public: int color = 0;
+
+      /// \brief Wall time at which the line was started.
+      public: Time wallTime;
+
+      /// \brief Steady time at which the line was started, in nanoseconds.
+      public: int64_t steadyNs = 0;
+
+      /// \brief Text of the line, with its newline.
+      public: std::string text;
+    };
+
+    /// \internal
+    /// \brief Ring buffer of the lines of a thread. The thread is the only
+    /// producer and the flusher is the only consumer.
+    class ConsoleRing
+    {
+      /// \brief Constructor.
+      public: ConsoleRing() : lines(kConsoleRingSize) {}
+
+      /// \brief The slots of the ring.
+      public: std::vector<ConsoleLine> lines;
+
+      /// \brief Index of the next line to write out.
+      public: std::atomic<size_t> head{0};
+
+      /// \brief Index of the next line to queue.
+      public: std::atomic<size_t> tail{0};
+
+      /// \brief Number of lines dropped because the ring was full.
+      public: std::atomic<uint64_t> dropped{0};
+
+      /// \brief True once the thread exited.
+      public: std::atomic<bool> closed{false};
+    };
+
+    /// \internal
+    /// \brief A line being written by a thread into a logger.
+    class ConsolePartialLine
+    {
+      /// \brief Buffer of the logger.
+      public: const void *buffer = nullptr;
+
+      /// \brief The line so far.
+      public: ConsoleLine line;
+    };
+
+    /// \internal
+    /// \brief Lines of a thread.
+    class ConsoleThreadLines
+    {
+      /// \brief Destructor. Queues the partial lines, and closes the ring.
+      public: ~ConsoleThreadLines();
+
+      /// \brief Ring of the thread, registered with the flusher on the
+      /// first line.
+      public: std::shared_ptr<ConsoleRing> ring;
+
+      /// \brief Lines without their newline yet, one per logger.
+      public: std::vector<ConsolePartialLine> partial;
+    };
+
+    /// \internal
+    /// \brief Repeats of a line written out.
+    class ConsoleRepeat
+    {
+      /// \brief Destination of the line.
+      public: ConsoleOutput output = CONSOLE_FILE;
+
+      /// \brief SGR color of the terminal output.
+      public: int color = 0;
+
+      /// \brief Wall time of the last repeat.
+      public: Time wallTime;
+
+      /// \brief Steady time at which the line was written, in nanoseconds.
+      public: int64_t startNs = 0;
+
+      /// \brief Number of repeats not written.
+      public: uint64_t count = 0;
+    };
+
+    /// \internal
+    /// \brief Writes the lines queued by the threads from a background
+    /// thread.
+    class ConsoleFlusher
+    {
+      /// \brief Destructor. Stops the thread, and writes the queued lines.
+      public: ~ConsoleFlusher();
+
+      /// \brief Start the thread.
+      public: void Start();
+
+      /// \brief Stop the thread, and write the queued lines.
+      public: void Stop();
+
+      /// \brief Register the ring of a thread.
+      /// \return The ring.
+      public: std::shared_ptr<ConsoleRing> Register();
+
+      /// \brief Queue a line. Called by the thread of the ring only.
+      /// \param[in] _ring Ring of the thread.
+      /// \param[in] _line The line, moved from.
+      public: static void Push(ConsoleRing &_ring, ConsoleLine &_line);
+
+      /// \brief Write the queued lines.
+      /// \param[in] _all True to also write the repeats counted since the
+      /// last copy of each line, false for the lines whose copy is older
+      /// than kConsoleRepeatNs.
+      public: void Flush(const bool _all);
+
+      /// \brief Loop of the thread.
+      private: void Run();
+
+      /// \brief Write a line or its repeats, unless it was repeated.
+      /// \param[in] _line The line.
+      private: void Process(ConsoleLine &_line);
+
+      /// \brief Write the number of repeats of a line.
+      /// \param[in] _text Text of the line.
+      /// \param[in] _repeat The repeats.
+      private: void WriteRepeats(const std::string &_text,
+                   const ConsoleRepeat &_repeat);
+
+      /// \brief Write text to the log file, and the terminal.
+      /// \param[in] _output Destination of the text.
+      /// \param[in] _color SGR color of the terminal output.
+      /// \param[in] _wallTime Wall time of the text in the log file.
+      /// \param[in] _text The text.
+      private: void Write(const ConsoleOutput _output, const int _color,
+                   const Time &_wallTime, const std::string &_text);
+
+      /// \brief Protects thread.
+      private: std::mutex runMutex;
+
+      /// \brief The background thread.
+      private: std::thread thread;
+
+      /// \brief Protects stop.
+      private: std::mutex stopMutex;
+
+      /// \brief Wakes up the thread to stop.
+      private: std::condition_variable stopCondition;
+
+      /// \brief True to stop the thread.
+      private: bool stop = false;
+
+      /// \brief Protects rings.
+      private: std::mutex ringsMutex;
+
+      /// \brief Rings of the threads.
+      private: std::vector<std::shared_ptr<ConsoleRing>> rings;
+
+      /// \brief Serializes the writes, protects repeats.
+      private: std::mutex flushMutex;
+
+      /// \brief Repeats of the lines written during the last
+      /// kConsoleRepeatNs, by destination and text.
+      private: std::map<std::pair<ConsoleOutput, std::string>,
+                   ConsoleRepeat> repeats;
+    };
+
+    /// \internal
+    /// \brief The flusher, destroyed before the loggers above.
+    static ConsoleFlusher g_consoleFlusher;
+
+    /// \internal
+    /// \brief Lines of the calling thread.
+    static thread_local ConsoleThreadLines g_consoleThreadLines;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Queue text written into a logger by the calling thread. Each
+/// line is queued once its newline is written.
+/// \param[in] _buffer Buffer of the logger.
+/// \param[in] _output Destination of the text.
+/// \param[in] _color SGR color of the terminal output.
+/// \param[in] _text The text.
+static void queueConsole(const void *_buffer, const ConsoleOutput _output,
+    const int _color, const std::string &_text)
+{
+  ConsoleThreadLines &lines = g_consoleThreadLines;
+  if (!lines.ring)
+    lines.ring = g_consoleFlusher.Register();
+
+  ConsolePartialLine *partial = nullptr;
+  for (auto &p : lines.partial)
+  {
+    if (p.buffer == _buffer)
+    {
+      partial = &p;
+      break;
+    }
+  }
+  if (!partial)
+  {
+    lines.partial.emplace_back();
+    partial = &lines.partial.back();
+    partial->buffer = _buffer;
+  }
+
+  size_t start = 0;
+  while (start < _text.size())
+  {
+    ConsoleLine &line = partial->line;
+    if (line.text.empty())
+    {
+      line.output = _output;
+      line.color = _color;
+      line.wallTime = Time::GetWallTime();
+      line.steadyNs = Time::SteadyNs();
+    }
+
+    size_t end = _text.find('\n', start);
+    if (end == std::string::npos)
+    {
+      line.text.append(_text, start, std::string::npos);
+      break;
+    }
+
+    line.text.append(_text, start, end + 1 - start);
+    ConsoleFlusher::Push(*lines.ring, line);
+    line = ConsoleLine();
+    start = end + 1;
+  }
+}
+
+/////////////////////////////////////////////////
+ConsoleThreadLines::~ConsoleThreadLines()
+{
+  if (!this->ring)
+    return;
+
+  for (auto &p : this->partial)
+  {
+    if (!p.line.text.empty())
+      ConsoleFlusher::Push(*this->ring, p.line);
+  }
+  this->ring->closed = true;
+}
+
+/////////////////////////////////////////////////
+ConsoleFlusher::~ConsoleFlusher()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Start()
+{
+  std::lock_guard<std::mutex> lock(this->runMutex);
+  if (this->thread.joinable())
+    return;
+
+  this->stop = false;
+  g_consoleAsync = true;
+  this->thread = std::thread(&ConsoleFlusher::Run, this);
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Stop()
+{
+  std::lock_guard<std::mutex> lock(this->runMutex);
+  if (!this->thread.joinable())
+    return;
+
+  g_consoleAsync = false;
+  {
+    std::lock_guard<std::mutex> stopLock(this->stopMutex);
+    this->stop = true;
+  }
+  this->stopCondition.notify_all();
+  this->thread.join();
+  this->Flush(true);
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<ConsoleRing> ConsoleFlusher::Register()
+{
+  auto ring = std::make_shared<ConsoleRing>();
+  std::lock_guard<std::mutex> lock(this->ringsMutex);
+  this->rings.push_back(ring);
+  return ring;
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Push(ConsoleRing &_ring, ConsoleLine &_line)
+{
+  const size_t tail = _ring.tail.load(std::memory_order_relaxed);
+  if (tail - _ring.head.load(std::memory_order_acquire) >= kConsoleRingSize)
+  {
+    _ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  _ring.lines[tail % kConsoleRingSize] = std::move(_line);
+  _ring.tail.store(tail + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Flush(const bool _all)
+{
+  std::vector<std::shared_ptr<ConsoleRing>> toFlush;
+  {
+    std::lock_guard<std::mutex> lock(this->ringsMutex);
+    toFlush = this->rings;
+  }
+
+  std::lock_guard<std::mutex> lock(this->flushMutex);
+  std::vector<ConsoleRing *> closed;
+  for (auto const &ring : toFlush)
+  {
+    // Read before the lines, the thread queues none once closed.
+    if (ring->closed)
+      closed.push_back(ring.get());
+
+    size_t head = ring->head.load(std::memory_order_relaxed);
+    const size_t tail = ring->tail.load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+      ConsoleLine line = std::move(ring->lines[head % kConsoleRingSize]);
+      ring->head.store(head + 1, std::memory_order_release);
+      this->Process(line);
+    }
+
+    const uint64_t dropped = ring->dropped.exchange(0);
+    if (dropped > 0)
+    {
+      this->Write(CONSOLE_STDERR, 33, Time::GetWallTime(), "[Wrn] " +
+          std::to_string(dropped) + " lines dropped by the asynchronous "
+          "console\n");
+    }
+  }
+
+  const int64_t now = Time::SteadyNs();
+  for (auto iter = this->repeats.begin(); iter != this->repeats.end();)
+  {
+    if (_all || now - iter->second.startNs >= kConsoleRepeatNs)
+    {
+      this->WriteRepeats(iter->first.second, iter->second);
+      iter = this->repeats.erase(iter);
+    }
+    else
+      ++iter;
+  }
+
+  FileLogger::Buffer *buf =
+      static_cast<FileLogger::Buffer *>(Console::log.rdbuf());
+  if (buf->stream)
+    buf->stream->flush();
+  std::cout.flush();
+  std::cerr.flush();
+
+  if (!closed.empty())
+  {
+    std::lock_guard<std::mutex> ringsLock(this->ringsMutex);
+    for (auto const ring : closed)
+    {
+      for (auto iter = this->rings.begin(); iter != this->rings.end(); ++iter)
+      {
+        if (iter->get() == ring)
+        {
+          this->rings.erase(iter);
+          break;
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Run()
+{
+  std::unique_lock<std::mutex> lock(this->stopMutex);
+  while (!this->stop)
+  {
+    this->stopCondition.wait_for(lock, std::chrono::milliseconds(20));
+    lock.unlock();
+    this->Flush(false);
+    lock.lock();
+  }
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Process(ConsoleLine &_line)
+{
+  auto key = std::make_pair(_line.output, std::move(_line.text));
+  auto iter = this->repeats.find(key);
+  if (iter != this->repeats.end())
+  {
+    if (_line.steadyNs - iter->second.startNs < kConsoleRepeatNs)
+    {
+      ++iter->second.count;
+      iter->second.wallTime = _line.wallTime;
+      return;
+    }
+    this->WriteRepeats(iter->first.second, iter->second);
+    this->repeats.erase(iter);
+  }
+
+  this->Write(_line.output, _line.color, _line.wallTime, key.second);
+
+  ConsoleRepeat repeat;
+  repeat.output = _line.output;
+  repeat.color = _line.color;
+  repeat.startNs = _line.steadyNs;
+  this->repeats[std::move(key)] = repeat;
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::WriteRepeats(const std::string &_text,
+    const ConsoleRepeat &_repeat)
+{
+  if (_repeat.count == 0)
+    return;
+
+  std::string text = _text;
+  if (!text.empty() && text.back() == '\n')
+    text.pop_back();
+  text += " [repeated " + std::to_string(_repeat.count) + " times]\n";
+  this->Write(_repeat.output, _repeat.color, _repeat.wallTime, text);
+}
+
+/////////////////////////////////////////////////
+void ConsoleFlusher::Write(const ConsoleOutput _output, const int _color,
+    const Time &_wallTime, const std::string &_text)
+{
+  FileLogger::Buffer *buf =
+      static_cast<FileLogger::Buffer *>(Console::log.rdbuf());
+  if (buf->stream)
+    *buf->stream << "(" << _wallTime << ") " << _text;
+
+  if (_output == CONSOLE_FILE || Console::GetQuiet())
+    return;
+
+  std::ostream &out = _output == CONSOLE_STDOUT ? std::cout : std::cerr;
+  #ifndef _WIN32
+  out << "\033[1;" << _color << "m" << _text << "\033[0m";
+  #else
+  (void)_color;
+  out << _text;
+  #endif
+}
+
 //////////////////////////////////////////////////
 void Console::SetQuiet(bool _quiet)
 {
@@ -49,6 +542,28 @@ bool Console::GetQuiet()
   return quiet;
 }
 
+//////////////////////////////////////////////////
+void Console::SetAsync(const bool _async)
+{
+  if (_async)
+    g_consoleFlusher.Start();
+  else
+    g_consoleFlusher.Stop();
+}
+
+//////////////////////////////////////////////////
+bool Console::GetAsync()
+{
+  return g_consoleAsync;
+}
+
+//////////////////////////////////////////////////
+void Console::Flush()
+{
+  if (g_consoleAsync)
+    g_consoleFlusher.Flush(true);
+}
+
 /////////////////////////////////////////////////
 Logger::Logger(const std::string &_prefix, int _color, LogType _type)
   : std::ostream(new Buffer(_type, _color)), color(_color), prefix(_prefix)
@@ -65,7 +580,9 @@ Logger::~Logger()
 /////////////////////////////////////////////////
 Logger &Logger::operator()()
 {
-  Console::log << "(" << Time::GetWallTime() << ") ";
+  // The asynchronous console stamps the lines when it writes them
+  if (!g_consoleAsync)
+    Console::log << "(" << Time::GetWallTime() << ") ";
   (*this) << this->prefix;
 
   return (*this);
@@ -76,7 +593,8 @@ Logger &Logger::operator()(const std::string &_file, int _line)
 {
   int index = _file.find_last_of("/") + 1;
 
-  Console::log << "(" << Time::GetWallTime() << ") ";
+  if (!g_consoleAsync)
+    Console::log << "(" << Time::GetWallTime() << ") ";
   std::stringstream prefixString;
   prefixString << this->prefix
     << "[" << _file.substr(index , _file.size() - index) << ":"
@@ -109,6 +627,14 @@ Logger::Buffer::~Buffer()
 /////////////////////////////////////////////////
 int Logger::Buffer::sync()
 {
+  if (g_consoleAsync)
+  {
+    queueConsole(this, this->type == Logger::STDOUT ?
+        CONSOLE_STDOUT : CONSOLE_STDERR, this->color, this->str());
+    this->str("");
+    return 0;
+  }
+
   // Log messages to disk
   Console::log << this->str();
   Console::log.flush();
@@ -226,7 +752,8 @@ void FileLogger::Init(const std::string &_prefix, const std::string &_filename)
 /////////////////////////////////////////////////
 FileLogger &FileLogger::operator()()
 {
-  (*this) << "(" << Time::GetWallTime() << ") ";
+  if (!g_consoleAsync)
+    (*this) << "(" << Time::GetWallTime() << ") ";
   return (*this);
 }
 
@@ -234,8 +761,10 @@ FileLogger &FileLogger::operator()()
 FileLogger &FileLogger::operator()(const std::string &_file, int _line)
 {
   int index = _file.find_last_of("/") + 1;
-  (*this) << "(" << Time::GetWallTime() << ") ["
-    << _file.substr(index , _file.size() - index) << ":" << _line << "]";
+  if (!g_consoleAsync)
+    (*this) << "(" << Time::GetWallTime() << ") ";
+  (*this) << "[" << _file.substr(index , _file.size() - index) << ":"
+    << _line << "]";
 
   return (*this);
 }
@@ -291,6 +820,13 @@ FileLogger::Buffer::~Buffer()
 /////////////////////////////////////////////////
 int FileLogger::Buffer::sync()
 {
+  if (g_consoleAsync)
+  {
+    queueConsole(this, CONSOLE_FILE, 0, this->str());
+    this->str("");
+    return 0;
+  }
+
   if (!this->stream)
     return -1;
 
@@ -34,6 +34,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare the writer of the asynchronous mode
+    class ConsoleFlusher;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
@@ -129,6 +132,9 @@ namespace gazebo
       /// \brief Stores the full path of the directory where all the log files
       /// are stored.
       private: std::string logDirectory;
+
+      /// \brief The asynchronous mode writes into the file.
+      private: friend class ConsoleFlusher;
     };
 
     /// \class Logger Logger.hh common/common.hh
@@ -212,6 +218,24 @@ namespace gazebo
       /// \return True to if quiet output is set.
       public: static bool GetQuiet();
 
+      /// \brief Set asynchronous output. The loggers then queue each line
+      /// in a ring buffer of the calling thread, and a background thread
+      /// writes the lines to the terminal and the log file. The same line
+      /// is written at most once per second, followed by the number of
+      /// times it was repeated, and the lines of a full ring buffer are
+      /// dropped and counted. Turning it off writes the queued lines.
+      /// \param[in] _async True to write from a background thread.
+      public: static void SetAsync(const bool _async);
+
+      /// \brief Get whether asynchronous output is set.
+      /// \return True if asynchronous output is set.
+      public: static bool GetAsync();
+
+      /// \brief Write the lines queued by the asynchronous output, and the
+      /// number of times the last lines were repeated. Does nothing if
+      /// asynchronous output isn't set.
+      public: static void Flush();
+
       /// \brief Global instance of the message logger.
       public: static Logger msg;
 
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <stdlib.h>
+#include <thread>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Console.hh"
@@ -274,6 +275,53 @@ TEST_F(Console_TEST, ColorErr)
   EXPECT_TRUE(logContent.find(logString) != std::string::npos);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test Console::SetAsync
+TEST_F(Console_TEST, Async)
+{
+  gazebo::common::Console::SetAsync(true);
+  EXPECT_TRUE(gazebo::common::Console::GetAsync());
+
+  for (int i = 0; i < 100; ++i)
+    gzwarn << "this is a repeated async warning\n";
+  gzerr << "this is an async error " << 1 << std::endl;
+
+  std::thread thread([]()
+      {
+        for (int i = 0; i < g_messageRepeat; ++i)
+          gzlog << "this is an async log " << i << std::endl;
+      });
+  thread.join();
+
+  gazebo::common::Console::Flush();
+  std::string logContent = this->GetLogContent();
+
+  // Written once, then counted
+  std::string warning = "this is a repeated async warning";
+  int count = 0;
+  for (size_t pos = logContent.find(warning); pos != std::string::npos;
+       pos = logContent.find(warning, pos + 1))
+  {
+    ++count;
+  }
+  EXPECT_EQ(2, count);
+  EXPECT_NE(std::string::npos,
+      logContent.find(warning + " [repeated 99 times]"));
+  EXPECT_NE(std::string::npos, logContent.find("this is an async error 1"));
+  for (int i = 0; i < g_messageRepeat; ++i)
+  {
+    std::ostringstream stream;
+    stream << "this is an async log " << i;
+    EXPECT_NE(std::string::npos, logContent.find(stream.str()));
+  }
+
+  gazebo::common::Console::SetAsync(false);
+  EXPECT_FALSE(gazebo::common::Console::GetAsync());
+  gzwarn << "this is a sync warning" << std::endl;
+  EXPECT_NE(std::string::npos,
+      this->GetLogContent().find("this is a sync warning"));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
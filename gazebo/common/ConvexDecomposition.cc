@@ -0,0 +1,579 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief A triangle of a hull being built.
+    class HullFace
+    {
+      /// \brief Indices of the points, counter-clockwise from outside.
+      public: unsigned int v[3];
+
+      /// \brief Outward unit normal.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief Distance of the plane of the face from the origin.
+      public: double offset = 0;
+
+      /// \brief Points above the face, not assigned to another face.
+      public: std::vector<unsigned int> outside;
+
+      /// \brief False once the face is removed.
+      public: bool alive = true;
+
+      /// \brief Signed distance of a point from the plane of the face.
+      /// \param[in] _p The point.
+      /// \return Positive above the face.
+      public: double Distance(const ignition::math::Vector3d &_p) const
+      {
+        return this->normal.Dot(_p) - this->offset;
+      }
+    };
+
+    /// \internal
+    /// \brief Triangles of a mesh and their hull.
+    class HullPart
+    {
+      /// \brief Corners of the triangles of the part, three per triangle.
+      public: std::vector<ignition::math::Vector3d> triangles;
+
+      /// \brief Vertices of the hull.
+      public: std::vector<ignition::math::Vector3d> vertices;
+
+      /// \brief Triangles of the hull.
+      public: std::vector<unsigned int> indices;
+
+      /// \brief Depth of the deepest surface point inside the hull.
+      public: double concavity = 0;
+
+      /// \brief False if no split lowers the concavity.
+      public: bool splittable = true;
+    };
+  }
+}
+
+/// \brief Largest number of points of a part tested for its concavity.
+static const std::size_t kConcavitySamples = 4096;
+
+/// \brief Fractions of the extent of a part where it may be split.
+static const double kSplitFractions[] = {0.25, 0.5, 0.75};
+
+/////////////////////////////////////////////////
+/// \brief Key of a directed edge.
+/// \param[in] _a First point.
+/// \param[in] _b Second point.
+/// \return The key.
+static uint64_t edgeKey(const unsigned int _a, const unsigned int _b)
+{
+  return (static_cast<uint64_t>(_a) << 32) | _b;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the depth of the deepest point inside a hull.
+/// \param[in] _points The points, inside or on the hull.
+/// \param[in] _vertices Vertices of the hull.
+/// \param[in] _indices Triangles of the hull.
+/// \return The depth, 0 if all points are on the hull.
+static double concavity(const std::vector<ignition::math::Vector3d> &_points,
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  std::vector<ignition::math::Vector3d> normals;
+  std::vector<double> offsets;
+  for (std::size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    const ignition::math::Vector3d &a = _vertices[_indices[i]];
+    ignition::math::Vector3d n =
+        (_vertices[_indices[i+1]] - a).Cross(_vertices[_indices[i+2]] - a);
+    if (n.SquaredLength() <= 0)
+      continue;
+    n.Normalize();
+    normals.push_back(n);
+    offsets.push_back(n.Dot(a));
+  }
+
+  // The depth inside a convex polytope is the distance to the nearest
+  // plane of its faces.
+  const std::size_t stride =
+      std::max<std::size_t>(1, _points.size() / kConcavitySamples);
+  double result = 0;
+  for (std::size_t i = 0; i < _points.size(); i += stride)
+  {
+    double depth = std::numeric_limits<double>::max();
+    for (std::size_t j = 0; j < normals.size() && depth > result; ++j)
+      depth = std::min(depth, offsets[j] - normals[j].Dot(_points[i]));
+    if (depth != std::numeric_limits<double>::max())
+      result = std::max(result, depth);
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+bool ConvexDecomposition::ConvexHull(
+    const std::vector<ignition::math::Vector3d> &_points,
+    const unsigned int _maxVertices,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  _indices.clear();
+  if (_points.size() < 4)
+    return false;
+
+  // Extreme points along each axis
+  unsigned int extremes[6] = {0, 0, 0, 0, 0, 0};
+  for (unsigned int i = 1; i < _points.size(); ++i)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (_points[i][axis] < _points[extremes[axis*2]][axis])
+        extremes[axis*2] = i;
+      if (_points[i][axis] > _points[extremes[axis*2+1]][axis])
+        extremes[axis*2+1] = i;
+    }
+  }
+
+  // Initial tetrahedron: the farthest extremes, the farthest point from
+  // their line, and the farthest point from the plane of the three.
+  unsigned int a = extremes[0];
+  unsigned int b = extremes[1];
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = i + 1; j < 6; ++j)
+    {
+      if (_points[extremes[i]].Distance(_points[extremes[j]]) >
+          _points[a].Distance(_points[b]))
+      {
+        a = extremes[i];
+        b = extremes[j];
+      }
+    }
+  }
+
+  const double scale = _points[a].Distance(_points[b]);
+  const double epsilon = scale * 1e-9;
+  if (scale <= 0)
+    return false;
+
+  const ignition::math::Vector3d dir =
+      (_points[b] - _points[a]) / scale;
+  unsigned int c = a;
+  double best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double d = (_points[i] - _points[a]).Cross(dir).Length();
+    if (d > best)
+    {
+      best = d;
+      c = i;
+    }
+  }
+  if (best <= epsilon)
+    return false;
+
+  ignition::math::Vector3d normal =
+      (_points[b] - _points[a]).Cross(_points[c] - _points[a]);
+  normal.Normalize();
+  unsigned int d = a;
+  best = 0;
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    const double dist = std::abs(normal.Dot(_points[i] - _points[a]));
+    if (dist > best)
+    {
+      best = dist;
+      d = i;
+    }
+  }
+  if (best <= epsilon)
+    return false;
+
+  std::vector<HullFace> faces;
+  std::unordered_map<uint64_t, std::size_t> edges;
+  const ignition::math::Vector3d center =
+      (_points[a] + _points[b] + _points[c] + _points[d]) / 4.0;
+
+  auto addFace = [&](unsigned int _i, unsigned int _j, unsigned int _k)
+  {
+    HullFace face;
+    face.v[0] = _i;
+    face.v[1] = _j;
+    face.v[2] = _k;
+    face.normal = (_points[_j] - _points[_i]).Cross(_points[_k] - _points[_i]);
+    if (face.normal.SquaredLength() > 0)
+      face.normal.Normalize();
+    face.offset = face.normal.Dot(_points[_i]);
+    for (int e = 0; e < 3; ++e)
+      edges[edgeKey(face.v[e], face.v[(e+1) % 3])] = faces.size();
+    faces.push_back(face);
+  };
+
+  // Orient the faces of the tetrahedron outwards
+  const unsigned int tetra[4][3] = {{a, b, c}, {a, d, b}, {b, d, c},
+                                    {c, d, a}};
+  for (auto const &tri : tetra)
+  {
+    const ignition::math::Vector3d n = (_points[tri[1]] - _points[tri[0]]).
+        Cross(_points[tri[2]] - _points[tri[0]]);
+    if (n.Dot(center - _points[tri[0]]) > 0)
+      addFace(tri[0], tri[2], tri[1]);
+    else
+      addFace(tri[0], tri[1], tri[2]);
+  }
+
+  // Give each point to the face it's the farthest above
+  auto assign = [&](const unsigned int _point, const std::size_t _first)
+  {
+    double farthest = epsilon;
+    std::size_t owner = faces.size();
+    for (std::size_t f = _first; f < faces.size(); ++f)
+    {
+      if (!faces[f].alive)
+        continue;
+      const double dist = faces[f].Distance(_points[_point]);
+      if (dist > farthest)
+      {
+        farthest = dist;
+        owner = f;
+      }
+    }
+    if (owner < faces.size())
+      faces[owner].outside.push_back(_point);
+  };
+
+  for (unsigned int i = 0; i < _points.size(); ++i)
+  {
+    if (i != a && i != b && i != c && i != d)
+      assign(i, 0);
+  }
+
+  unsigned int vertexCount = 4;
+  std::vector<std::size_t> visible;
+  std::vector<std::pair<unsigned int, unsigned int>> horizon;
+  std::vector<unsigned int> orphans;
+  std::vector<bool> visited;
+  for (std::size_t next = 0; next < faces.size(); ++next)
+  {
+    if (!faces[next].alive || faces[next].outside.empty())
+      continue;
+    if (_maxVertices > 0 && vertexCount >= _maxVertices)
+      break;
+
+    // The farthest point above the face joins the hull
+    unsigned int eye = faces[next].outside.front();
+    best = faces[next].Distance(_points[eye]);
+    for (auto const p : faces[next].outside)
+    {
+      const double dist = faces[next].Distance(_points[p]);
+      if (dist > best)
+      {
+        best = dist;
+        eye = p;
+      }
+    }
+
+    // Find the faces it sees, from the face, and their horizon
+    visible.assign(1, next);
+    horizon.clear();
+    visited.assign(faces.size(), false);
+    visited[next] = true;
+    for (std::size_t i = 0; i < visible.size(); ++i)
+    {
+      const HullFace &face = faces[visible[i]];
+      for (int e = 0; e < 3; ++e)
+      {
+        const unsigned int u = face.v[e];
+        const unsigned int v = face.v[(e+1) % 3];
+        auto neighbor = edges.find(edgeKey(v, u));
+        if (neighbor == edges.end())
+          continue;
+        const std::size_t n = neighbor->second;
+        if (visited[n])
+        {
+          if (faces[n].Distance(_points[eye]) <= epsilon)
+            horizon.push_back(std::make_pair(u, v));
+          continue;
+        }
+        if (faces[n].Distance(_points[eye]) > epsilon)
+        {
+          visited[n] = true;
+          visible.push_back(n);
+        }
+        else
+        {
+          visited[n] = true;
+          horizon.push_back(std::make_pair(u, v));
+        }
+      }
+    }
+
+    orphans.clear();
+    for (auto const f : visible)
+    {
+      HullFace &face = faces[f];
+      face.alive = false;
+      for (int e = 0; e < 3; ++e)
+        edges.erase(edgeKey(face.v[e], face.v[(e+1) % 3]));
+      for (auto const p : face.outside)
+      {
+        if (p != eye)
+          orphans.push_back(p);
+      }
+      face.outside.clear();
+      face.outside.shrink_to_fit();
+    }
+
+    const std::size_t first = faces.size();
+    for (auto const &edge : horizon)
+      addFace(edge.first, edge.second, eye);
+    ++vertexCount;
+
+    for (auto const p : orphans)
+      assign(p, first);
+  }
+
+  // Compact the vertices of the remaining faces
+  std::unordered_map<unsigned int, unsigned int> remap;
+  for (auto const &face : faces)
+  {
+    if (!face.alive)
+      continue;
+    for (int e = 0; e < 3; ++e)
+    {
+      auto inserted = remap.insert(
+          std::make_pair(face.v[e], static_cast<unsigned int>(remap.size())));
+      if (inserted.second)
+        _vertices.push_back(_points[face.v[e]]);
+      _indices.push_back(inserted.first->second);
+    }
+  }
+  return !_indices.empty();
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the hull and the concavity of a part.
+/// \param[in] _maxVertices Largest number of vertices of the hull.
+/// \param[in,out] _part The part whose triangles are set.
+/// \return False if the part is flat.
+static bool buildPart(const unsigned int _maxVertices, HullPart &_part)
+{
+  if (!ConvexDecomposition::ConvexHull(_part.triangles, _maxVertices,
+      _part.vertices, _part.indices))
+  {
+    return false;
+  }
+
+  // The corners and the centers of the triangles sample the surface
+  std::vector<ignition::math::Vector3d> samples = _part.triangles;
+  for (std::size_t i = 0; i + 2 < _part.triangles.size(); i += 3)
+  {
+    samples.push_back((_part.triangles[i] + _part.triangles[i+1] +
+        _part.triangles[i+2]) / 3.0);
+  }
+  _part.concavity = concavity(samples, _part.vertices, _part.indices);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a convex polygon to a part as a triangle fan.
+/// \param[in] _polygon Corners of the polygon.
+/// \param[in,out] _part The part.
+static void addPolygon(const std::vector<ignition::math::Vector3d> &_polygon,
+    HullPart &_part)
+{
+  for (std::size_t i = 1; i + 1 < _polygon.size(); ++i)
+  {
+    _part.triangles.push_back(_polygon[0]);
+    _part.triangles.push_back(_polygon[i]);
+    _part.triangles.push_back(_polygon[i+1]);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Split the triangles of a part by an axis aligned plane. The
+/// triangles across the plane are clipped.
+/// \param[in] _part The part.
+/// \param[in] _axis Axis normal to the plane.
+/// \param[in] _plane Coordinate of the plane along the axis.
+/// \param[out] _below Triangles below the plane.
+/// \param[out] _above Triangles above the plane.
+static void splitPart(const HullPart &_part, const int _axis,
+    const double _plane, HullPart &_below, HullPart &_above)
+{
+  std::vector<ignition::math::Vector3d> below;
+  std::vector<ignition::math::Vector3d> above;
+  for (std::size_t t = 0; t + 2 < _part.triangles.size(); t += 3)
+  {
+    below.clear();
+    above.clear();
+    for (int k = 0; k < 3; ++k)
+    {
+      const ignition::math::Vector3d &p = _part.triangles[t + k];
+      const ignition::math::Vector3d &q = _part.triangles[t + (k+1) % 3];
+      const double dp = p[_axis] - _plane;
+      const double dq = q[_axis] - _plane;
+      if (dp <= 0)
+        below.push_back(p);
+      if (dp >= 0)
+        above.push_back(p);
+      if ((dp < 0 && dq > 0) || (dp > 0 && dq < 0))
+      {
+        const ignition::math::Vector3d cut = p + (q - p) * (dp / (dp - dq));
+        below.push_back(cut);
+        above.push_back(cut);
+      }
+    }
+    addPolygon(below, _below);
+    addPolygon(above, _above);
+  }
+}
+
+/////////////////////////////////////////////////
+Mesh *ConvexDecomposition::Decompose(const Mesh &_mesh,
+    const Options &_options)
+{
+  std::vector<HullPart> parts(1);
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+      continue;
+
+    for (unsigned int j = 0; j + 2 < subMesh->GetIndexCount(); j += 3)
+    {
+      const unsigned int i0 = subMesh->GetIndex(j);
+      const unsigned int i1 = subMesh->GetIndex(j+1);
+      const unsigned int i2 = subMesh->GetIndex(j+2);
+      if (i0 >= subMesh->GetVertexCount() ||
+          i1 >= subMesh->GetVertexCount() ||
+          i2 >= subMesh->GetVertexCount())
+      {
+        continue;
+      }
+      parts[0].triangles.push_back(subMesh->Vertex(i0));
+      parts[0].triangles.push_back(subMesh->Vertex(i1));
+      parts[0].triangles.push_back(subMesh->Vertex(i2));
+    }
+  }
+
+  if (parts[0].triangles.empty())
+    return nullptr;
+
+  ignition::math::Vector3d min = parts[0].triangles[0];
+  ignition::math::Vector3d max = min;
+  for (auto const &v : parts[0].triangles)
+  {
+    min.Min(v);
+    max.Max(v);
+  }
+  const double threshold = _options.maxConcavity * min.Distance(max);
+
+  if (!buildPart(_options.maxVertices, parts[0]))
+    return nullptr;
+
+  while (parts.size() < std::max(1u, _options.maxHulls))
+  {
+    // Split the most concave part
+    std::size_t worst = parts.size();
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+      if (parts[i].splittable && parts[i].concavity > threshold &&
+          (worst == parts.size() ||
+           parts[i].concavity > parts[worst].concavity))
+      {
+        worst = i;
+      }
+    }
+    if (worst == parts.size())
+      break;
+
+    const HullPart &part = parts[worst];
+    ignition::math::Vector3d low = part.triangles[0];
+    ignition::math::Vector3d high = low;
+    for (auto const &v : part.triangles)
+    {
+      low.Min(v);
+      high.Max(v);
+    }
+
+    HullPart bestBelow;
+    HullPart bestAbove;
+    double bestScore = part.concavity;
+    bool found = false;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      for (auto const fraction : kSplitFractions)
+      {
+        HullPart below;
+        HullPart above;
+        splitPart(part, axis, low[axis] + fraction * (high[axis] - low[axis]),
+            below, above);
+        if (!buildPart(_options.maxVertices, below) ||
+            !buildPart(_options.maxVertices, above))
+        {
+          continue;
+        }
+
+        const double score = std::max(below.concavity, above.concavity);
+        if (score < bestScore)
+        {
+          bestScore = score;
+          bestBelow = std::move(below);
+          bestAbove = std::move(above);
+          found = true;
+        }
+      }
+    }
+
+    if (!found)
+    {
+      parts[worst].splittable = false;
+      continue;
+    }
+
+    parts[worst] = std::move(bestBelow);
+    parts.push_back(std::move(bestAbove));
+  }
+
+  Mesh *result = new Mesh();
+  for (auto const &part : parts)
+  {
+    SubMesh *subMesh = new SubMesh();
+    subMesh->SetPrimitiveType(SubMesh::TRIANGLES);
+    for (auto const &v : part.vertices)
+      subMesh->AddVertex(v);
+    for (auto const i : part.indices)
+      subMesh->AddIndex(i);
+    result->AddSubMesh(subMesh);
+  }
+  return result;
+}
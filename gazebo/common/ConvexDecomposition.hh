@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+#define GAZEBO_COMMON_CONVEXDECOMPOSITION_HH_
+
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class ConvexDecomposition ConvexDecomposition.hh common/common.hh
+    /// \brief Approximates a mesh by a set of convex hulls, so that physics
+    /// engines collide it with convex shapes instead of its triangles.
+    ///
+    /// The triangles of the mesh are split recursively by axis aligned
+    /// planes. The part whose vertices lie the deepest inside its convex
+    /// hull, its concavity, is split first, at the candidate plane that
+    /// leaves the least concave halves, until every part is convex enough
+    /// or the number of hulls is reached.
+    class GZ_COMMON_VISIBLE ConvexDecomposition
+    {
+      /// \brief Parameters of a decomposition.
+      public: class Options
+      {
+        /// \brief Largest number of hulls.
+        public: unsigned int maxHulls = 16;
+
+        /// \brief Concavity under which a part isn't split, as a fraction
+        /// of the diagonal of the bounding box of the mesh.
+        public: double maxConcavity = 0.02;
+
+        /// \brief Largest number of vertices of a hull. The hull of a part
+        /// with more vertices keeps the farthest ones.
+        public: unsigned int maxVertices = 64;
+      };
+
+      /// \brief Compute the convex hull of points with the quickhull
+      /// algorithm.
+      /// \param[in] _points The points.
+      /// \param[in] _maxVertices Largest number of vertices of the hull, 0
+      /// for no limit.
+      /// \param[out] _vertices Vertices of the hull.
+      /// \param[out] _indices Three indices in _vertices per triangle,
+      /// counter-clockwise seen from outside of the hull.
+      /// \return False if the points are fewer than four, or coplanar.
+      public: static bool ConvexHull(
+                  const std::vector<ignition::math::Vector3d> &_points,
+                  const unsigned int _maxVertices,
+                  std::vector<ignition::math::Vector3d> &_vertices,
+                  std::vector<unsigned int> &_indices);
+
+      /// \brief Decompose the triangles of a mesh in convex hulls.
+      /// \param[in] _mesh The mesh. Only its triangle submeshes are read.
+      /// \param[in] _options Parameters of the decomposition.
+      /// \return A mesh with one triangle submesh per hull, that the caller
+      /// owns, or nullptr if the mesh is flat or has no triangles.
+      public: static Mesh *Decompose(const Mesh &_mesh,
+                  const Options &_options);
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/ConvexDecomposition.hh"
+#include "gazebo/common/Mesh.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ConvexDecomposition : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Make a closed box submesh.
+/// \param[in] _min Lowest corner.
+/// \param[in] _max Highest corner.
+/// \return The submesh, 8 vertices and 12 triangles.
+common::SubMesh *makeBox(const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max)
+{
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (int i = 0; i < 8; ++i)
+  {
+    subMesh->AddVertex((i & 1) ? _max.X() : _min.X(),
+        (i & 2) ? _max.Y() : _min.Y(), (i & 4) ? _max.Z() : _min.Z());
+  }
+
+  const unsigned int indices[] = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6,
+      0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+  for (auto const i : indices)
+    subMesh->AddIndex(i);
+  return subMesh;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that every vertex is on or under every face of a hull.
+/// \param[in] _vertices Vertices of the hull.
+/// \param[in] _indices Triangles of the hull.
+void expectConvex(const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  for (std::size_t i = 0; i < _indices.size(); i += 3)
+  {
+    const ignition::math::Vector3d &a = _vertices[_indices[i]];
+    const ignition::math::Vector3d n = (_vertices[_indices[i+1]] - a).Cross(
+        _vertices[_indices[i+2]] - a).Normalize();
+    for (auto const &v : _vertices)
+      EXPECT_LE(n.Dot(v - a), 1e-9);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecomposition, ConvexHull)
+{
+  // Corners of a cube and points inside it
+  std::vector<ignition::math::Vector3d> points;
+  for (int i = 0; i < 8; ++i)
+    points.push_back(ignition::math::Vector3d(i & 1, (i >> 1) & 1, i >> 2));
+  points.push_back(ignition::math::Vector3d(0.5, 0.5, 0.5));
+  points.push_back(ignition::math::Vector3d(0.2, 0.7, 0.1));
+
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  EXPECT_TRUE(common::ConvexDecomposition::ConvexHull(points, 0, vertices,
+      indices));
+  EXPECT_EQ(8u, vertices.size());
+  EXPECT_EQ(36u, indices.size());
+  expectConvex(vertices, indices);
+
+  // The vertex limit keeps the hull convex
+  EXPECT_TRUE(common::ConvexDecomposition::ConvexHull(points, 5, vertices,
+      indices));
+  EXPECT_EQ(5u, vertices.size());
+  expectConvex(vertices, indices);
+
+  // Coplanar points have no hull
+  points.clear();
+  for (int i = 0; i < 6; ++i)
+    points.push_back(ignition::math::Vector3d(i, i * i, 0));
+  EXPECT_FALSE(common::ConvexDecomposition::ConvexHull(points, 0, vertices,
+      indices));
+  EXPECT_TRUE(vertices.empty());
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ConvexDecomposition, Decompose)
+{
+  // A box is its own hull
+  common::ConvexDecomposition::Options options;
+  common::Mesh box;
+  box.AddSubMesh(makeBox(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(2, 1, 1)));
+  std::unique_ptr<common::Mesh> hulls(
+      common::ConvexDecomposition::Decompose(box, options));
+  ASSERT_TRUE(hulls != nullptr);
+  EXPECT_EQ(1u, hulls->GetSubMeshCount());
+  EXPECT_EQ(8u, hulls->GetSubMesh(0)->GetVertexCount());
+
+  // An L shape needs several hulls
+  common::Mesh shape;
+  shape.AddSubMesh(makeBox(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(4, 1, 1)));
+  shape.AddSubMesh(makeBox(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d(1, 4, 1)));
+  hulls.reset(common::ConvexDecomposition::Decompose(shape, options));
+  ASSERT_TRUE(hulls != nullptr);
+  EXPECT_GE(hulls->GetSubMeshCount(), 2u);
+  for (unsigned int i = 0; i < hulls->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *subMesh = hulls->GetSubMesh(i);
+    EXPECT_EQ(common::SubMesh::TRIANGLES, subMesh->GetPrimitiveType());
+    std::vector<ignition::math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      vertices.push_back(subMesh->Vertex(j));
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      indices.push_back(subMesh->GetIndex(j));
+    expectConvex(vertices, indices);
+  }
+
+  // The hull count is bounded
+  options.maxHulls = 1;
+  hulls.reset(common::ConvexDecomposition::Decompose(shape, options));
+  ASSERT_TRUE(hulls != nullptr);
+  EXPECT_EQ(1u, hulls->GetSubMeshCount());
+
+  // A mesh without triangles can't be decomposed
+  common::Mesh empty;
+  EXPECT_TRUE(
+      common::ConvexDecomposition::Decompose(empty, options) == nullptr);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -23,10 +23,12 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/PluginCosts.hh"
 #include "gazebo/util/system.hh"
 
 #include "ignition/common/Profiler.hh"
@@ -272,15 +274,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback0");
-            iter.second->callback();
+            Invoke(entry);
             IGN_PROFILE_END();
           }
         }
@@ -293,15 +294,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback1");
-            iter.second->callback(_p);
+            Invoke(entry, _p);
             IGN_PROFILE_END();
           }
         }
@@ -315,15 +315,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback2");
-            iter.second->callback(_p1, _p2);
+            Invoke(entry, _p1, _p2);
             IGN_PROFILE_END();
           }
         }
@@ -338,15 +337,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback3");
-            iter.second->callback(_p1, _p2, _p3);
+            Invoke(entry, _p1, _p2, _p3);
             IGN_PROFILE_END();
           }
         }
@@ -363,15 +361,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback4");
-            iter.second->callback(_p1, _p2, _p3, _p4);
+            Invoke(entry, _p1, _p2, _p3, _p4);
             IGN_PROFILE_END();
           }
         }
@@ -390,15 +387,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback5");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5);
+            Invoke(entry, _p1, _p2, _p3, _p4, _p5);
             IGN_PROFILE_END();
           }
         }
@@ -418,15 +414,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback6");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6);
+            Invoke(entry, _p1, _p2, _p3, _p4, _p5, _p6);
             IGN_PROFILE_END();
           }
         }
@@ -447,15 +442,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback7");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7);
+            Invoke(entry, _p1, _p2, _p3, _p4, _p5, _p6, _p7);
             IGN_PROFILE_END();
           }
         }
@@ -478,15 +472,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback8");
-            iter.second->callback(_p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
+            Invoke(entry, _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8);
             IGN_PROFILE_END();
           }
         }
@@ -511,15 +504,14 @@ namespace gazebo
       {
         IGN_PROFILE("Event::Signal");
 
-        this->Cleanup();
-
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback9");
-            iter.second->callback(
+            Invoke(entry,
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9);
             IGN_PROFILE_END();
           }
@@ -544,17 +536,16 @@ namespace gazebo
                   const P4 &_p4, const P5 &_p5, const P6 &_p6, const P7 &_p7,
                   const P8 &_p8, const P9 &_p9, const P10 &_p10)
       {
-        this->Cleanup();
+        IGN_PROFILE("Event::Signal");
 
         this->SetSignaled(true);
-        for (const auto &iter: this->connections)
+        SignalScope scope(*this);
+        for (const auto &entry : scope.Connections())
         {
-          IGN_PROFILE("Event::Signal");
-
-          if (iter.second->on)
+          if (entry.connection->on)
           {
             IGN_PROFILE_BEGIN("callback10");
-            iter.second->callback(
+            Invoke(entry,
                 _p1, _p2, _p3, _p4, _p5, _p6, _p7, _p8, _p9, _p10);
             IGN_PROFILE_END();
           }
@@ -562,9 +553,16 @@ namespace gazebo
       }
 
       /// \internal
-      /// \brief Removes queued connections.
-      /// We assume that this function is called from a Signal function.
-      private: void Cleanup();
+      /// \brief Publish a new list of connections to the signal functions,
+      /// built from the connection map. The mutex must be locked.
+      private: void Publish();
+
+      /// \internal
+      /// \brief Delete the connections that were removed and the
+      /// connection lists that were replaced, if no signal function is
+      /// using them.
+      /// \param[in] _wait False to give up if the mutex is locked.
+      private: void Reclaim(const bool _wait);
 
       /// \brief A private helper class used in maintaining connections.
       private: class EventConnection
@@ -589,29 +587,142 @@ namespace gazebo
       /// \brief Event Connection map typedef.
       typedef std::map<int, std::unique_ptr<EventConnection>> EvtConnectionMap;
 
+      /// \internal
+      /// \brief A connection as read by the signal functions.
+      private: class SignalEntry
+      {
+        /// \brief The connection, owned by the connection map.
+        public: EventConnection *connection;
+
+        /// \brief Plugin that made the connection, null if none.
+        public: common::PluginCost *cost;
+      };
+
+      /// \def EvtConnectionList
+      /// \brief Immutable list of connections read by the signal functions.
+      typedef std::vector<SignalEntry> EvtConnectionList;
+
+      /// \internal
+      /// \brief Private data for the EventT class.
+      private: class EventTPrivate
+      {
+        /// \brief Current list of connections. Connect and Disconnect
+        /// replace it, so that signaling doesn't lock or allocate.
+        public: std::atomic<const EvtConnectionList *> list;
+
+        /// \brief Number of signal functions in progress.
+        public: std::atomic<int> signalCount;
+
+        /// \brief Connection lists that were replaced but may still be in
+        /// use by a signal function.
+        public: std::vector<const EvtConnectionList *> retired;
+
+        /// \brief True if there are connections or lists to delete.
+        public: std::atomic<bool> retiredPending;
+
+        /// \brief Plugin that made each connection, by connection id.
+        public: std::map<int, common::PluginCost *> costs;
+
+        /// \brief Id of the next connection.
+        public: int nextId = 0;
+      };
+
+      /// \brief Run the callback of a connection, and time it if it was
+      /// made by a plugin and the plugin costs are enabled.
+      /// \param[in] _entry The connection.
+      /// \param[in] _args Parameters of the signal.
+      private: template<typename... Args>
+               static void Invoke(const SignalEntry &_entry,
+                                  const Args &... _args)
+      {
+        if (_entry.cost && common::PluginCosts::Enabled())
+        {
+          common::PluginCostTimer timer(*_entry.cost);
+          _entry.connection->callback(_args...);
+        }
+        else
+          _entry.connection->callback(_args...);
+      }
+
+      /// \internal
+      /// \brief Gives a signal function access to the current list of
+      /// connections, which stays valid until the end of the scope even
+      /// if a callback connects or disconnects.
+      private: class SignalScope
+      {
+        /// \brief Constructor
+        /// \param[in] _event The event being signaled.
+        public: explicit SignalScope(EventT<T> &_event)
+                : data(*_event.dataPtr), event(_event)
+        {
+          this->data.signalCount.fetch_add(1);
+          this->list = this->data.list.load();
+        }
+
+        /// \brief Destructor
+        public: ~SignalScope()
+        {
+          if (this->data.signalCount.fetch_sub(1) == 1 &&
+              this->data.retiredPending.load())
+          {
+            this->event.Reclaim(false);
+          }
+        }
+
+        /// \brief Get the connections to call.
+        /// \return The connection list.
+        public: const EvtConnectionList &Connections() const
+        {
+          return *this->list;
+        }
+
+        /// \brief Private data of the event being signaled.
+        private: EventTPrivate &data;
+
+        /// \brief The event being signaled.
+        private: EventT<T> &event;
+
+        /// \brief The connection list read when the scope started.
+        private: const EvtConnectionList *list;
+      };
+
       /// \brief Array of connection callbacks.
       private: EvtConnectionMap connections;
 
-      /// \brief A thread lock.
-      private: std::mutex mutex;
+      /// \brief A thread lock, which protects the connections and the
+      /// private data.
+      private: mutable std::mutex mutex;
 
-      /// \brief List of connections to remove
+      /// \brief List of connections to remove once no signal function
+      /// uses them.
       private: std::list<typename EvtConnectionMap::const_iterator>
               connectionsToRemove;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<EventTPrivate> dataPtr;
     };
 
     /// \brief Constructor.
     template<typename T>
     EventT<T>::EventT()
-    : Event()
+    : Event(), dataPtr(new EventTPrivate)
     {
+      this->dataPtr->list = new EvtConnectionList();
+      this->dataPtr->signalCount = 0;
+      this->dataPtr->retiredPending = false;
     }
 
     /// \brief Destructor. Deletes all the associated connections.
     template<typename T>
     EventT<T>::~EventT()
     {
+      this->connectionsToRemove.clear();
       this->connections.clear();
+      for (auto &oldList : this->dataPtr->retired)
+        delete oldList;
+      this->dataPtr->retired.clear();
+      delete this->dataPtr->list.load();
     }
 
     /// \brief Adds a connection.
@@ -619,13 +730,17 @@ namespace gazebo
     template<typename T>
     ConnectionPtr EventT<T>::Connect(const std::function<T> &_subscriber)
     {
-      int index = 0;
-      if (!this->connections.empty())
+      int index;
       {
-        auto const &iter = this->connections.rbegin();
-        index = iter->first + 1;
+        std::lock_guard<std::mutex> lock(this->mutex);
+        index = this->dataPtr->nextId++;
+        this->connections[index].reset(new EventConnection(true, _subscriber));
+        common::PluginCost *cost = common::PluginCostScope::Current();
+        if (cost)
+          this->dataPtr->costs[index] = cost;
+        this->Publish();
       }
-      this->connections[index].reset(new EventConnection(true, _subscriber));
+      this->Reclaim(true);
       return ConnectionPtr(new Connection(this, index));
     }
 
@@ -634,7 +749,8 @@ namespace gazebo
     template<typename T>
     unsigned int EventT<T>::ConnectionCount() const
     {
-      return this->connections.size();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      return this->connections.size() - this->connectionsToRemove.size();
     }
 
     /// \brief Removes a connection.
@@ -642,25 +758,77 @@ namespace gazebo
     template<typename T>
     void EventT<T>::Disconnect(int _id)
     {
-      // Find the connection
-      auto const &it = this->connections.find(_id);
-
-      if (it != this->connections.end())
       {
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        // Find the connection
+        auto const &it = this->connections.find(_id);
+        if (it == this->connections.end() || !it->second->on)
+          return;
+
+        // Signals in progress skip the connection from now on. It is
+        // deleted once they are done.
         it->second->on = false;
         this->connectionsToRemove.push_back(it);
+        this->dataPtr->costs.erase(_id);
+        this->Publish();
       }
+      this->Reclaim(true);
     }
 
     /////////////////////////////////////////////
     template<typename T>
-    void EventT<T>::Cleanup()
+    void EventT<T>::Publish()
     {
-      std::lock_guard<std::mutex> lock(this->mutex);
-      // Remove all queue connections.
-      for (auto &conn : this->connectionsToRemove)
-        this->connections.erase(conn);
-      this->connectionsToRemove.clear();
+      EvtConnectionList *newList = new EvtConnectionList();
+      newList->reserve(this->connections.size());
+      for (auto const &conn : this->connections)
+      {
+        if (!conn.second->on)
+          continue;
+
+        auto cost = this->dataPtr->costs.find(conn.first);
+        newList->push_back(SignalEntry{conn.second.get(),
+            cost != this->dataPtr->costs.end() ? cost->second : nullptr});
+      }
+
+      this->dataPtr->retired.push_back(this->dataPtr->list.exchange(newList));
+      this->dataPtr->retiredPending = true;
+    }
+
+    /////////////////////////////////////////////
+    template<typename T>
+    void EventT<T>::Reclaim(const bool _wait)
+    {
+      std::vector<const EvtConnectionList *> oldLists;
+      std::vector<std::unique_ptr<EventConnection>> removed;
+      {
+        std::unique_lock<std::mutex> lock(this->mutex, std::defer_lock);
+        if (_wait)
+          lock.lock();
+        else if (!lock.try_lock())
+          return;
+
+        // A signal function that starts from now on reads the current
+        // list, so the retired ones are unused if no signal is running.
+        if (this->dataPtr->signalCount != 0)
+          return;
+
+        oldLists.swap(this->dataPtr->retired);
+        for (auto &conn : this->connectionsToRemove)
+        {
+          auto iter = this->connections.find(conn->first);
+          removed.push_back(std::move(iter->second));
+          this->connections.erase(iter);
+        }
+        this->connectionsToRemove.clear();
+        this->dataPtr->retiredPending = false;
+      }
+
+      // Delete outside of the lock, since destroying a callback may
+      // disconnect from this event.
+      for (auto &oldList : oldLists)
+        delete oldList;
     }
     /// \}
   }
@@ -15,7 +15,9 @@
  *
 */
 
+#include <atomic>
 #include <functional>
+#include <thread>
 #include <gtest/gtest.h>
 #include <gazebo/common/Time.hh>
 #include <gazebo/common/Event.hh>
@@ -220,6 +222,63 @@ TEST_F(EventTest, ManyChanges)
   EXPECT_EQ(g_callback1, 2);
 }
 
+/////////////////////////////////////////////////
+TEST_F(EventTest, CallbackConnect)
+{
+  g_callback = 0;
+  g_callback1 = 0;
+
+  event::EventT<void ()> evt;
+  event::ConnectionPtr conn1;
+  event::ConnectionPtr conn = evt.Connect([&]()
+      {
+        callback();
+        if (!conn1)
+          conn1 = evt.Connect(std::bind(&callback1));
+      });
+
+  // A connection made by a callback is called from the next signal
+  evt();
+  EXPECT_EQ(g_callback, 1);
+  EXPECT_EQ(g_callback1, 0);
+  EXPECT_EQ(evt.ConnectionCount(), 2u);
+
+  evt();
+  EXPECT_EQ(g_callback, 2);
+  EXPECT_EQ(g_callback1, 1);
+
+  conn1.reset();
+  EXPECT_EQ(evt.ConnectionCount(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EventTest, ConcurrentConnect)
+{
+  g_callback = 0;
+
+  event::EventT<void ()> evt;
+  event::ConnectionPtr conn = evt.Connect(std::bind(&callback));
+
+  // Connect and disconnect while the event is signaled
+  std::atomic<bool> done(false);
+  std::thread thread([&]()
+      {
+        while (!done)
+        {
+          event::ConnectionPtr tmp = evt.Connect([]() {});
+        }
+      });
+
+  for (unsigned int i = 0; i < 10000; ++i)
+    evt();
+
+  done = true;
+  thread.join();
+
+  EXPECT_EQ(g_callback, 10000);
+  EXPECT_EQ(evt.ConnectionCount(), 1u);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -101,7 +101,11 @@ namespace gazebo
               { return addEntity.Connect(_subscriber); }
 
       //////////////////////////////////////////////////////////////////////////
-      /// \brief Connect a callback to the world update start signal
+      /// \brief Connect a callback to the world update start signal.
+      /// The callbacks run serially on the physics thread. Model plugins
+      /// that only touch their own model may use
+      /// physics::Model::ConnectLocalUpdate instead, which can run in
+      /// parallel.
       /// \param[in] _subscriber the subscriber to this event
       /// \return a connection
       public: template<typename T>
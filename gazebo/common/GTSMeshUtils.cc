@@ -14,6 +14,7 @@
  * limitations under the License.
  *
  */
+#include <mutex>
 #include <vector>
 #include <gts.h>
 
@@ -121,6 +122,23 @@ bool TriangleIsHole(GtsTriangle *_t, GtsFifo *_edgeList)
     return true;
 }
 
+//////////////////////////////////////////////////
+void GTSMeshUtils::InitClasses()
+{
+  static std::once_flag once;
+  std::call_once(once, []()
+      {
+        gts_vertex_class();
+        gts_edge_class();
+        gts_constraint_class();
+        gts_triangle_class();
+        gts_face_class();
+        gts_surface_class();
+        gts_surface_inter_class();
+        gts_bbox_class();
+      });
+}
+
 //////////////////////////////////////////////////
 GtsSurface *GTSMeshUtils::DelaunayTriangulation(
     const std::vector<ignition::math::Vector2d> &_vertices,
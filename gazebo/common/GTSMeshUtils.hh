@@ -41,6 +41,11 @@ namespace gazebo
     /// \brief Creates GTS utilities for meshes
     class GZ_COMMON_VISIBLE GTSMeshUtils
     {
+      /// \brief Initialize the GTS classes. GTS creates them on first use,
+      /// which is not thread safe, so call this once before generating
+      /// meshes on several threads.
+      public: static void InitClasses();
+
       /// \brief Perform delaunay triangulation on input vertices.
       /// \param[in] _vertices A list of all vertices
       /// \param[in] _edges A list of edges. Each edge is made of 2 vertex
@@ -21,12 +21,14 @@
 
 #include <FreeImage.h>
 #include <boost/filesystem.hpp>
+#include <cstring>
 #include <string>
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/PixelConvert.hh"
 
 using namespace gazebo;
 using namespace common;
@@ -181,6 +183,34 @@ void Image::GetRGBData(unsigned char **_data, unsigned int &_count) const
   FreeImage_Unload(tmp);
 }
 
+//////////////////////////////////////////////////
+void Image::GetRGBAData(unsigned char **_data, unsigned int &_count) const
+{
+  FIBITMAP *tmp = FreeImage_ConvertTo32Bits(this->bitmap);
+  const unsigned int width = FreeImage_GetWidth(tmp);
+  const unsigned int height = FreeImage_GetHeight(tmp);
+
+  if (*_data)
+    delete [] *_data;
+
+  _count = width * height * 4;
+  *_data = new unsigned char[_count];
+
+  // FreeImage stores the bottom row first, in the byte order of the
+  // platform
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    const BYTE *src = FreeImage_GetScanLine(tmp, height - 1 - y);
+    unsigned char *dst = *_data + y * width * 4;
+    if (FI_RGBA_RED == 2)
+      SwapRedBlueAlpha(src, dst, width);
+    else
+      memcpy(dst, src, width * 4);
+  }
+
+  FreeImage_Unload(tmp);
+}
+
 //////////////////////////////////////////////////
 void Image::GetData(unsigned char **_data, unsigned int &_count) const
 {
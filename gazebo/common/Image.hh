@@ -135,6 +135,14 @@ namespace gazebo
       public: void GetRGBData(unsigned char **_data,
                               unsigned int &_count) const;
 
+      /// \brief Get the image as 8 bit red, green, blue and alpha values,
+      /// in this order on every platform, with the top row first. Images
+      /// without an alpha channel are opaque.
+      /// \param[out] _data Pointer to a nullptr array of char.
+      /// \param[out] _count The resulting data array size
+      public: void GetRGBAData(unsigned char **_data,
+                               unsigned int &_count) const;
+
       /// \brief Get the width
       /// \return The image width
       public: unsigned int GetWidth() const;
@@ -48,6 +48,17 @@ TEST_F(ImageTest, Image)
   img.GetData(&data, size);
   EXPECT_EQ(static_cast<unsigned int>(489552), size);
 
+  // Top row first, with an opaque alpha channel
+  unsigned char *rgba = nullptr;
+  img.GetRGBAData(&rgba, size);
+  EXPECT_EQ(static_cast<unsigned int>(652736), size);
+  const unsigned char *pixel = rgba + ((328 - 10) * 496 + 10) * 4;
+  EXPECT_EQ(34, pixel[0]);
+  EXPECT_EQ(96, pixel[1]);
+  EXPECT_EQ(167, pixel[2]);
+  EXPECT_EQ(255, pixel[3]);
+  delete [] rgba;
+
   img.SetFromData(data, img.GetWidth(), img.GetHeight(),
                   common::Image::RGB_INT8);
 }
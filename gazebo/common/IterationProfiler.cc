@@ -0,0 +1,361 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/IterationProfiler.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Clock of the profiler.
+    using IterationClock = std::chrono::steady_clock;
+
+    /// \internal
+    /// \brief Largest number of records of a window, about 100MB.
+    static const size_t kMaxIterationRecords = 1000000;
+
+    /// \internal
+    /// \brief A scope open on a thread.
+    class IterationOpenScope
+    {
+      /// \brief Name of the scope.
+      public: std::string name;
+
+      /// \brief Iteration when the scope opened.
+      public: uint64_t iteration = 0;
+
+      /// \brief Sim time when the scope opened.
+      public: double simTime = 0;
+
+      /// \brief Time at which the scope opened.
+      public: IterationClock::time_point start;
+    };
+
+    /// \internal
+    /// \brief Scopes open on the calling thread.
+    class IterationThreadStack
+    {
+      /// \brief Window the scopes belong to.
+      public: uint64_t session = 0;
+
+      /// \brief The open scopes, the innermost last.
+      public: std::vector<IterationOpenScope> scopes;
+    };
+
+    /// \internal
+    /// \brief Scopes open on the calling thread.
+    static thread_local IterationThreadStack g_iterationStack;
+
+    /// \internal
+    /// \brief Private data for IterationProfiler
+    class IterationProfilerPrivate
+    {
+      /// \brief True during a window.
+      public: std::atomic<bool> enabled{false};
+
+      /// \brief True once a window is armed, until it opens.
+      public: std::atomic<bool> armed{false};
+
+      /// \brief Window, incremented when one opens.
+      public: std::atomic<uint64_t> session{0};
+
+      /// \brief Current iteration of the world.
+      public: std::atomic<uint64_t> iteration{0};
+
+      /// \brief Current sim time of the world in seconds.
+      public: std::atomic<double> simTime{0};
+
+      /// \brief Iteration that closes the window.
+      public: std::atomic<uint64_t> last{0};
+
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Number of iterations of the armed window.
+      public: unsigned int iterations = 0;
+
+      /// \brief Path of the trace, as given to Start().
+      public: std::string requestedPath;
+
+      /// \brief Path of the trace of the window.
+      public: std::string path;
+
+      /// \brief Time at which the window opened.
+      public: IterationClock::time_point start;
+
+      /// \brief Closed scopes.
+      public: std::vector<IterationProfiler::Record> records;
+
+      /// \brief Number of scopes left out because of kMaxIterationRecords.
+      public: uint64_t dropped = 0;
+
+      /// \brief Index of each thread that recorded a scope.
+      public: std::map<std::thread::id, unsigned int> threads;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Escape a string for JSON.
+/// \param[in] _str The string.
+/// \return The escaped string.
+static std::string escapeJson(const std::string &_str)
+{
+  std::string result;
+  result.reserve(_str.size());
+  for (auto const c : _str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result += '\\';
+      result += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      result += buffer;
+    }
+    else
+      result += c;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+IterationProfiler::IterationProfiler()
+  : dataPtr(new IterationProfilerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+IterationProfiler::~IterationProfiler()
+{
+}
+
+/////////////////////////////////////////////////
+bool IterationProfiler::Start(const unsigned int _iterations,
+    const std::string &_path)
+{
+  if (_iterations == 0)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->armed || this->dataPtr->enabled)
+    return false;
+
+  this->dataPtr->iterations = _iterations;
+  this->dataPtr->requestedPath = _path;
+  this->dataPtr->armed = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool IterationProfiler::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void IterationProfiler::SetIteration(const uint64_t _iteration,
+    const double _simTime)
+{
+  this->dataPtr->iteration = _iteration;
+  this->dataPtr->simTime = _simTime;
+
+  if (this->dataPtr->enabled && _iteration >= this->dataPtr->last)
+    this->Finish();
+
+  if (!this->dataPtr->armed)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->path = this->dataPtr->requestedPath;
+  if (this->dataPtr->path.empty())
+  {
+    boost::filesystem::path path(SystemPaths::Instance()->GetLogPath());
+    path /= "iterations_" + std::to_string(getpid()) + "_" +
+        std::to_string(_iteration) + ".json";
+    this->dataPtr->path = path.string();
+  }
+  this->dataPtr->start = IterationClock::now();
+  this->dataPtr->records.clear();
+  this->dataPtr->dropped = 0;
+  this->dataPtr->threads.clear();
+  this->dataPtr->last = _iteration + this->dataPtr->iterations;
+  ++this->dataPtr->session;
+  this->dataPtr->armed = false;
+  this->dataPtr->enabled = true;
+}
+
+/////////////////////////////////////////////////
+void IterationProfiler::Begin(const char *_name)
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  // Drop the scopes left open by a previous window.
+  const uint64_t session = this->dataPtr->session;
+  if (g_iterationStack.session != session)
+  {
+    g_iterationStack.session = session;
+    g_iterationStack.scopes.clear();
+  }
+
+  IterationOpenScope scope;
+  scope.name = _name;
+  scope.iteration = this->dataPtr->iteration;
+  scope.simTime = this->dataPtr->simTime;
+  scope.start = IterationClock::now();
+  g_iterationStack.scopes.push_back(std::move(scope));
+}
+
+/////////////////////////////////////////////////
+void IterationProfiler::End()
+{
+  if (!this->dataPtr->enabled)
+    return;
+
+  const auto end = IterationClock::now();
+  if (g_iterationStack.scopes.empty() ||
+      g_iterationStack.session != this->dataPtr->session)
+  {
+    return;
+  }
+
+  IterationOpenScope scope = std::move(g_iterationStack.scopes.back());
+  g_iterationStack.scopes.pop_back();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->records.size() >= kMaxIterationRecords)
+  {
+    ++this->dataPtr->dropped;
+    return;
+  }
+
+  Record record;
+  record.name = std::move(scope.name);
+  auto thread = this->dataPtr->threads.insert(std::make_pair(
+      std::this_thread::get_id(), this->dataPtr->threads.size()));
+  record.thread = thread.first->second;
+  record.iteration = scope.iteration;
+  record.simTime = scope.simTime;
+  record.start = std::chrono::duration<double>(
+      scope.start - this->dataPtr->start).count();
+  record.duration = std::chrono::duration<double>(end - scope.start).count();
+  this->dataPtr->records.push_back(std::move(record));
+}
+
+/////////////////////////////////////////////////
+bool IterationProfiler::Finish()
+{
+  if (!this->dataPtr->enabled.exchange(false))
+    return true;
+
+  std::string path;
+  std::vector<Record> records;
+  uint64_t dropped;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    path = this->dataPtr->path;
+    records = this->dataPtr->records;
+    dropped = this->dataPtr->dropped;
+  }
+
+  std::ofstream trace(path);
+  if (!trace)
+  {
+    gzerr << "Unable to write the iteration profile [" << path << "]\n";
+    return false;
+  }
+
+  // Chrome trace of complete events, in microseconds.
+  trace << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    const Record &r = records[i];
+    trace << (i == 0 ? "\n" : ",\n")
+          << "{\"name\": \"" << escapeJson(r.name) << "\", "
+          << "\"cat\": \"iteration\", \"ph\": \"X\", \"pid\": " << getpid()
+          << ", \"tid\": " << r.thread
+          << ", \"ts\": " << std::fixed << std::setprecision(1)
+          << r.start * 1e6 << ", \"dur\": " << r.duration * 1e6
+          << ", \"args\": {\"iteration\": " << r.iteration
+          << ", \"sim_time\": " << std::setprecision(6) << r.simTime << "}}";
+  }
+  trace << "\n]}\n";
+  trace.close();
+
+  gzmsg << "Iteration profile of " << records.size() << " scopes written to ["
+        << path << "]\n";
+  if (dropped > 0)
+    gzwarn << dropped << " scopes left out of the iteration profile\n";
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<IterationProfiler::Record> IterationProfiler::Records() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->records;
+}
+
+/////////////////////////////////////////////////
+std::string IterationProfiler::Path() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->path;
+}
+
+/////////////////////////////////////////////////
+IterationScope::IterationScope(const char *_name)
+  : active(IterationProfiler::Instance()->Enabled())
+{
+  if (this->active)
+    IterationProfiler::Instance()->Begin(_name);
+}
+
+/////////////////////////////////////////////////
+IterationScope::~IterationScope()
+{
+  if (this->active)
+    IterationProfiler::Instance()->End();
+}
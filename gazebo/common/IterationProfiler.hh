@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_ITERATIONPROFILER_HH_
+#define GAZEBO_COMMON_ITERATIONPROFILER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+#include "ignition/common/Profiler.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, IterationProfiler)
+
+/// \brief Concatenate for the name of a scope variable.
+#define GZ_PROFILE_CONCAT_(_a, _b) _a ## _b
+
+/// \brief Expand, then concatenate.
+#define GZ_PROFILE_CONCAT(_a, _b) GZ_PROFILE_CONCAT_(_a, _b)
+
+/// \brief Profile the rest of the block under a name, with the ignition
+/// profiler when enabled at build time, and with the IterationProfiler
+/// while it records a window.
+#define GZ_PROFILE(_name) \
+  IGN_PROFILE(_name); \
+  gazebo::common::IterationScope GZ_PROFILE_CONCAT(gzProfileScope, \
+      __LINE__)(_name)
+
+/// \brief Open a profiled section, closed by GZ_PROFILE_END on the same
+/// thread.
+#define GZ_PROFILE_BEGIN(_name) \
+  IGN_PROFILE_BEGIN(_name); \
+  gazebo::common::IterationProfiler::Instance()->Begin(_name)
+
+/// \brief Close the last section opened by GZ_PROFILE_BEGIN.
+#define GZ_PROFILE_END() \
+  gazebo::common::IterationProfiler::Instance()->End(); \
+  IGN_PROFILE_END()
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class IterationProfilerPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class IterationProfiler IterationProfiler.hh common/common.hh
+    /// \brief Records the GZ_PROFILE scopes of the simulation for a window
+    /// of iterations, without rebuilding with the ignition profiler.
+    ///
+    /// Start() arms a window, from the next iteration of the world for a
+    /// number of iterations. The world tells the profiler each iteration
+    /// and sim time, and every scope closed on any thread during the
+    /// window is recorded with the iteration and sim time at which it
+    /// opened. At the end of the window the records are written as a
+    /// Chrome trace, to open in chrome://tracing; the iteration that
+    /// closes the window pays for the write.
+    ///
+    /// The world starts a window on a message on its ~/profile topic,
+    /// which "gz world --profile" publishes. Outside of a window the
+    /// scopes cost an atomic load.
+    class GZ_COMMON_VISIBLE IterationProfiler :
+      public SingletonT<IterationProfiler>
+    {
+      /// \brief A closed scope.
+      public: class Record
+      {
+        /// \brief Name of the scope.
+        public: std::string name;
+
+        /// \brief Index of the thread.
+        public: unsigned int thread = 0;
+
+        /// \brief Iteration of the world when the scope opened.
+        public: uint64_t iteration = 0;
+
+        /// \brief Sim time of the world when the scope opened, in
+        /// seconds.
+        public: double simTime = 0;
+
+        /// \brief Start time from the start of the window in seconds.
+        public: double start = 0;
+
+        /// \brief Wall time in seconds.
+        public: double duration = 0;
+      };
+
+      /// \brief Constructor.
+      private: IterationProfiler();
+
+      /// \brief Destructor.
+      private: virtual ~IterationProfiler();
+
+      /// \brief Arm a window, which starts at the next iteration.
+      /// \param[in] _iterations Number of iterations of the window.
+      /// \param[in] _path Path of the trace, empty for a file named after
+      /// the process and the first iteration in the log directory.
+      /// \return False if a window is already armed or recording.
+      public: bool Start(const unsigned int _iterations,
+                  const std::string &_path = "");
+
+      /// \brief Get whether the profiler records the scopes.
+      /// \return True during a window.
+      public: bool Enabled() const;
+
+      /// \brief Tell the iteration that starts. Opens an armed window,
+      /// and closes the window after its last iteration.
+      /// \param[in] _iteration Iteration of the world.
+      /// \param[in] _simTime Sim time of the world in seconds.
+      public: void SetIteration(const uint64_t _iteration,
+                  const double _simTime);
+
+      /// \brief Open a scope on the calling thread. Prefer GZ_PROFILE.
+      /// \param[in] _name Name of the scope, copied during a window.
+      public: void Begin(const char *_name);
+
+      /// \brief Close the last scope opened on the calling thread.
+      public: void End();
+
+      /// \brief Close the window, and write the trace. Scopes still open
+      /// are left out.
+      /// \return False if the trace couldn't be written.
+      public: bool Finish();
+
+      /// \brief Get the records of the last window.
+      /// \return The closed scopes, in the order they closed.
+      public: std::vector<Record> Records() const;
+
+      /// \brief Get the path of the trace of the last window.
+      /// \return The path, empty if none was written.
+      public: std::string Path() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<IterationProfilerPrivate> dataPtr;
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<IterationProfiler>;
+    };
+
+    /// \class IterationScope IterationProfiler.hh common/common.hh
+    /// \brief Records a scope in the IterationProfiler, from its
+    /// construction to its destruction. Prefer GZ_PROFILE.
+    class GZ_COMMON_VISIBLE IterationScope
+    {
+      /// \brief Constructor. Opens the scope if the profiler records.
+      /// \param[in] _name Name of the scope.
+      public: explicit IterationScope(const char *_name);
+
+      /// \brief Destructor. Closes the scope.
+      public: ~IterationScope();
+
+      /// \brief True if the scope was opened.
+      private: bool active;
+    };
+    /// \}
+  }
+}
+#endif
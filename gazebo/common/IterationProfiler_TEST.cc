@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/IterationProfiler.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class IterationProfilerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(IterationProfilerTest, Window)
+{
+  common::IterationProfiler *profiler =
+      common::IterationProfiler::Instance();
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("iterations_%%%%%%.json");
+
+  EXPECT_FALSE(profiler->Start(0, path.string()));
+  EXPECT_TRUE(profiler->Start(2, path.string()));
+  EXPECT_FALSE(profiler->Start(2, path.string()));
+
+  // Not recorded until the next iteration
+  {
+    GZ_PROFILE("before");
+  }
+  EXPECT_FALSE(profiler->Enabled());
+
+  profiler->SetIteration(10, 0.01);
+  EXPECT_TRUE(profiler->Enabled());
+  {
+    GZ_PROFILE("World::Step");
+    GZ_PROFILE_BEGIN("Update");
+    GZ_PROFILE_END();
+  }
+
+  profiler->SetIteration(11, 0.02);
+  std::thread thread([]()
+      {
+        GZ_PROFILE("SensorManager::Update");
+      });
+  thread.join();
+
+  // A scope open at the end of the window is left out
+  GZ_PROFILE_BEGIN("open");
+  profiler->SetIteration(12, 0.03);
+  EXPECT_FALSE(profiler->Enabled());
+  GZ_PROFILE_END();
+
+  std::vector<common::IterationProfiler::Record> records =
+      profiler->Records();
+  ASSERT_EQ(3u, records.size());
+  EXPECT_EQ("Update", records[0].name);
+  EXPECT_EQ("World::Step", records[1].name);
+  EXPECT_EQ(10u, records[1].iteration);
+  EXPECT_DOUBLE_EQ(0.01, records[1].simTime);
+  EXPECT_GE(records[1].duration, records[0].duration);
+  EXPECT_EQ("SensorManager::Update", records[2].name);
+  EXPECT_EQ(11u, records[2].iteration);
+  EXPECT_NE(records[1].thread, records[2].thread);
+
+  EXPECT_EQ(path.string(), profiler->Path());
+  std::ifstream in(path.string());
+  std::stringstream trace;
+  trace << in.rdbuf();
+  EXPECT_NE(std::string::npos, trace.str().find("\"traceEvents\""));
+  EXPECT_NE(std::string::npos, trace.str().find("\"iteration\": 11"));
+  boost::filesystem::remove(path);
+
+  // Another window can be armed
+  EXPECT_TRUE(profiler->Start(1, path.string()));
+  profiler->SetIteration(20, 0.1);
+  profiler->SetIteration(21, 0.11);
+  EXPECT_TRUE(profiler->Records().empty());
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/LockProfiler.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the LockStats class.
+    class LockStatsPrivate
+    {
+      /// \brief Name of the lock.
+      public: std::string name;
+
+      /// \brief Number of acquisitions.
+      public: std::atomic<uint64_t> acquisitions{0};
+
+      /// \brief Number of contended acquisitions.
+      public: std::atomic<uint64_t> contentions{0};
+
+      /// \brief Wait time in nanoseconds.
+      public: std::atomic<int64_t> waitTime{0};
+
+      /// \brief Longest wait in nanoseconds.
+      public: std::atomic<int64_t> maxWait{0};
+
+      /// \brief Hold time in nanoseconds.
+      public: std::atomic<int64_t> holdTime{0};
+
+      /// \brief Longest hold in nanoseconds.
+      public: std::atomic<int64_t> maxHold{0};
+    };
+
+    /// \internal
+    /// \brief Private data for the LockProfiler class.
+    class LockProfilerPrivate
+    {
+      /// \brief Accounts, by name.
+      public: std::map<std::string, std::unique_ptr<LockStats>> accounts;
+
+      /// \brief Protects the accounts.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Raise an atomic maximum.
+/// \param[in,out] _max The maximum.
+/// \param[in] _value The new value.
+static void raiseMax(std::atomic<int64_t> &_max, const int64_t _value)
+{
+  int64_t max = _max.load(std::memory_order_relaxed);
+  while (_value > max &&
+      !_max.compare_exchange_weak(max, _value, std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+LockStats::LockStats(const std::string &_name)
+  : dataPtr(new LockStatsPrivate)
+{
+  this->dataPtr->name = _name;
+}
+
+/////////////////////////////////////////////////
+LockStats::~LockStats()
+{
+}
+
+/////////////////////////////////////////////////
+void LockStats::AddAcquisition(const int64_t _waitNanoseconds,
+    const bool _contended)
+{
+  this->dataPtr->acquisitions.fetch_add(1, std::memory_order_relaxed);
+  if (!_contended)
+    return;
+
+  this->dataPtr->contentions.fetch_add(1, std::memory_order_relaxed);
+  this->dataPtr->waitTime.fetch_add(_waitNanoseconds,
+      std::memory_order_relaxed);
+  raiseMax(this->dataPtr->maxWait, _waitNanoseconds);
+}
+
+/////////////////////////////////////////////////
+void LockStats::AddHold(const int64_t _holdNanoseconds)
+{
+  this->dataPtr->holdTime.fetch_add(_holdNanoseconds,
+      std::memory_order_relaxed);
+  raiseMax(this->dataPtr->maxHold, _holdNanoseconds);
+}
+
+/////////////////////////////////////////////////
+LockSample LockStats::Sample() const
+{
+  LockSample sample;
+  sample.name = this->dataPtr->name;
+  sample.acquisitions = this->dataPtr->acquisitions;
+  sample.contentions = this->dataPtr->contentions;
+  sample.waitTime = this->dataPtr->waitTime * 1e-9;
+  sample.maxWait = this->dataPtr->maxWait * 1e-9;
+  sample.holdTime = this->dataPtr->holdTime * 1e-9;
+  sample.maxHold = this->dataPtr->maxHold * 1e-9;
+  return sample;
+}
+
+/////////////////////////////////////////////////
+void LockStats::Reset()
+{
+  this->dataPtr->acquisitions = 0;
+  this->dataPtr->contentions = 0;
+  this->dataPtr->waitTime = 0;
+  this->dataPtr->maxWait = 0;
+  this->dataPtr->holdTime = 0;
+  this->dataPtr->maxHold = 0;
+}
+
+/////////////////////////////////////////////////
+LockProfiler::LockProfiler()
+  : dataPtr(new LockProfilerPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LockProfiler::~LockProfiler()
+{
+  // The mutexes of objects destroyed after the registry, such as the
+  // connections of the transport, still report on their last unlock.
+  for (auto &account : this->dataPtr->accounts)
+    account.second.release();
+}
+
+/////////////////////////////////////////////////
+bool LockProfiler::Enabled()
+{
+#ifdef ENABLE_DIAGNOSTICS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+LockStats *LockProfiler::Stats(const std::string &_name)
+{
+  if (!Enabled())
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &account = this->dataPtr->accounts[_name];
+  if (!account)
+    account.reset(new LockStats(_name));
+  return account.get();
+}
+
+/////////////////////////////////////////////////
+std::vector<LockSample> LockProfiler::Samples() const
+{
+  std::vector<LockSample> result;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    result.reserve(this->dataPtr->accounts.size());
+    for (auto const &account : this->dataPtr->accounts)
+      result.push_back(account.second->Sample());
+  }
+
+  std::stable_sort(result.begin(), result.end(),
+      [](const LockSample &_a, const LockSample &_b)
+      {
+        return _a.waitTime > _b.waitTime;
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+void LockProfiler::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &account : this->dataPtr->accounts)
+    account.second->Reset();
+}
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_LOCKPROFILER_HH_
+#define GAZEBO_COMMON_LOCKPROFILER_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, LockProfiler)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data classes.
+    class LockStatsPrivate;
+    class LockProfilerPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief Values of a lock account at one time.
+    class GZ_COMMON_VISIBLE LockSample
+    {
+      /// \brief Name of the lock.
+      public: std::string name;
+
+      /// \brief Number of acquisitions, not counting the recursive ones.
+      public: uint64_t acquisitions = 0;
+
+      /// \brief Number of acquisitions that had to wait for another
+      /// thread.
+      public: uint64_t contentions = 0;
+
+      /// \brief Wall time spent waiting for the lock in seconds.
+      public: double waitTime = 0;
+
+      /// \brief Longest wait in seconds.
+      public: double maxWait = 0;
+
+      /// \brief Wall time the lock was held in seconds.
+      public: double holdTime = 0;
+
+      /// \brief Longest hold in seconds.
+      public: double maxHold = 0;
+    };
+
+    /// \class LockStats LockProfiler.hh common/common.hh
+    /// \brief The contention of a named lock. All the mutexes of the same
+    /// name, such as the update mutex of every model, share the account.
+    /// The counters are atomic, so any thread can report.
+    class GZ_COMMON_VISIBLE LockStats
+    {
+      /// \brief Clock of the measurements.
+      public: typedef std::chrono::steady_clock Clock;
+
+      /// \brief Constructor.
+      /// \param[in] _name Name of the lock.
+      public: explicit LockStats(const std::string &_name);
+
+      /// \brief Destructor.
+      public: virtual ~LockStats();
+
+      /// \brief Add an acquisition.
+      /// \param[in] _waitNanoseconds Wall time spent waiting, 0 if the
+      /// lock was free.
+      /// \param[in] _contended True if the lock was held by another
+      /// thread.
+      public: void AddAcquisition(const int64_t _waitNanoseconds,
+                  const bool _contended);
+
+      /// \brief Add a release.
+      /// \param[in] _holdNanoseconds Wall time the lock was held.
+      public: void AddHold(const int64_t _holdNanoseconds);
+
+      /// \brief Get the values of the account.
+      /// \return The values.
+      public: LockSample Sample() const;
+
+      /// \brief Reset the counters.
+      public: void Reset();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LockStatsPrivate> dataPtr;
+    };
+
+    /// \class LockProfiler LockProfiler.hh common/common.hh
+    /// \brief Registry of the lock accounts of the process. The mutexes
+    /// of the step path are ProfiledMutex, which report their wait and
+    /// hold times here. The profiling is compiled in with
+    /// ENABLE_DIAGNOSTICS; otherwise there are no accounts and the
+    /// mutexes cost one branch more than the ones they wrap.
+    class GZ_COMMON_VISIBLE LockProfiler
+      : public SingletonT<LockProfiler>
+    {
+      /// \brief Constructor.
+      private: LockProfiler();
+
+      /// \brief Destructor.
+      private: virtual ~LockProfiler();
+
+      /// \brief Get whether the locks are profiled.
+      /// \return True if gazebo was built with ENABLE_DIAGNOSTICS.
+      public: static bool Enabled();
+
+      /// \brief Get an account, created on first use. Accounts live as
+      /// long as the registry, so the pointer can be kept. Singletons
+      /// that own a profiled mutex should get it in their constructor,
+      /// so that the registry outlives them.
+      /// \param[in] _name Name of the lock, by convention
+      /// "<subsystem>/<lock>".
+      /// \return The account, null if the locks aren't profiled.
+      public: LockStats *Stats(const std::string &_name);
+
+      /// \brief Get the values of all the accounts.
+      /// \return The values, from the longest wait time.
+      public: std::vector<LockSample> Samples() const;
+
+      /// \brief Reset the counters of all the accounts.
+      public: void Reset();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LockProfilerPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<LockProfiler>;
+    };
+
+    /// \class ProfiledMutex LockProfiler.hh common/common.hh
+    /// \brief A mutex that reports its contention to a named account of
+    /// the LockProfiler. It wraps a std or boost mutex, recursive or not,
+    /// and can be locked with std::lock_guard and std::unique_lock. Only
+    /// the outermost lock of a recursive mutex is measured.
+    template<typename M>
+    class ProfiledMutex
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the account.
+      public: explicit ProfiledMutex(const std::string &_name)
+              : stats(LockProfiler::Instance()->Stats(_name))
+              {
+              }
+
+      /// \brief Not copyable.
+      public: ProfiledMutex(const ProfiledMutex &) = delete;
+
+      /// \brief Not copyable.
+      public: ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+      /// \brief Lock, waiting for other threads.
+      public: void lock()
+              {
+                if (!this->stats)
+                {
+                  this->mutex.lock();
+                  return;
+                }
+
+                if (this->mutex.try_lock())
+                {
+                  this->Acquired(LockStats::Clock::time_point(), false);
+                  return;
+                }
+
+                const LockStats::Clock::time_point start =
+                    LockStats::Clock::now();
+                this->mutex.lock();
+                this->Acquired(start, true);
+              }
+
+      /// \brief Lock if no other thread holds the mutex.
+      /// \return True if locked.
+      public: bool try_lock()
+              {
+                if (!this->mutex.try_lock())
+                  return false;
+                if (this->stats)
+                  this->Acquired(LockStats::Clock::time_point(), false);
+                return true;
+              }
+
+      /// \brief Unlock.
+      public: void unlock()
+              {
+                if (this->stats && --this->depth == 0)
+                {
+                  this->stats->AddHold(
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      LockStats::Clock::now() - this->holdStart).count());
+                }
+                this->mutex.unlock();
+              }
+
+      /// \brief Record an acquisition. The mutex is held.
+      /// \param[in] _start Start of the wait, if contended.
+      /// \param[in] _contended True if the lock had to wait.
+      private: void Acquired(const LockStats::Clock::time_point &_start,
+                   const bool _contended)
+              {
+                if (this->depth++ > 0)
+                  return;
+
+                this->holdStart = LockStats::Clock::now();
+                this->stats->AddAcquisition(_contended ?
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    this->holdStart - _start).count() : 0, _contended);
+              }
+
+      /// \brief The wrapped mutex.
+      private: M mutex;
+
+      /// \brief The account, null if the locks aren't profiled.
+      private: LockStats *stats;
+
+      /// \brief Recursion depth of the owner, protected by the mutex.
+      private: unsigned int depth = 0;
+
+      /// \brief Start of the outermost hold, protected by the mutex.
+      private: LockStats::Clock::time_point holdStart;
+    };
+
+    /// \class ProfiledLock LockProfiler.hh common/common.hh
+    /// \brief Scoped lock of a mutex that can't be a ProfiledMutex, such
+    /// as one of the public API, which reports the contention it sees
+    /// to an account.
+    template<typename M>
+    class ProfiledLock
+    {
+      /// \brief Constructor. Locks the mutex.
+      /// \param[in] _mutex The mutex.
+      /// \param[in] _stats The account, from LockProfiler::Stats; null
+      /// to only lock.
+      public: ProfiledLock(M &_mutex, LockStats *_stats)
+              : mutex(_mutex), stats(_stats)
+              {
+                if (!this->stats)
+                {
+                  this->mutex.lock();
+                  return;
+                }
+
+                const bool contended = !this->mutex.try_lock();
+                const LockStats::Clock::time_point start =
+                    contended ? LockStats::Clock::now() :
+                    LockStats::Clock::time_point();
+                if (contended)
+                  this->mutex.lock();
+                this->holdStart = LockStats::Clock::now();
+                this->stats->AddAcquisition(contended ?
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    this->holdStart - start).count() : 0, contended);
+              }
+
+      /// \brief Destructor. Unlocks the mutex.
+      public: ~ProfiledLock()
+              {
+                if (this->stats)
+                {
+                  this->stats->AddHold(
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      LockStats::Clock::now() - this->holdStart).count());
+                }
+                this->mutex.unlock();
+              }
+
+      /// \brief Not copyable.
+      public: ProfiledLock(const ProfiledLock &) = delete;
+
+      /// \brief Not copyable.
+      public: ProfiledLock &operator=(const ProfiledLock &) = delete;
+
+      /// \brief The mutex.
+      private: M &mutex;
+
+      /// \brief The account.
+      private: LockStats *stats;
+
+      /// \brief Start of the hold.
+      private: LockStats::Clock::time_point holdStart;
+    };
+    /// \}
+  }
+}
+#endif
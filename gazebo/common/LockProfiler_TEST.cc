@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/thread/recursive_mutex.hpp>
+
+#include "gazebo/common/LockProfiler.hh"
+#include "gazebo/common/Time.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LockProfilerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LockProfilerTest, ProfiledLock)
+{
+  std::mutex mutex;
+  common::LockStats stats("test/lock");
+
+  // Uncontended
+  {
+    common::ProfiledLock<std::mutex> lock(mutex, &stats);
+    common::Time::MSleep(5);
+  }
+  common::LockSample sample = stats.Sample();
+  EXPECT_EQ("test/lock", sample.name);
+  EXPECT_EQ(1u, sample.acquisitions);
+  EXPECT_EQ(0u, sample.contentions);
+  EXPECT_DOUBLE_EQ(0.0, sample.waitTime);
+  EXPECT_GE(sample.holdTime, 0.004);
+
+  // Contended, another thread holds the mutex
+  std::unique_lock<std::mutex> other(mutex);
+  std::thread thread([&mutex, &stats]()
+      {
+        common::ProfiledLock<std::mutex> lock(mutex, &stats);
+      });
+  common::Time::MSleep(20);
+  other.unlock();
+  thread.join();
+
+  sample = stats.Sample();
+  EXPECT_EQ(2u, sample.acquisitions);
+  EXPECT_EQ(1u, sample.contentions);
+  EXPECT_GE(sample.waitTime, 0.01);
+  EXPECT_DOUBLE_EQ(sample.waitTime, sample.maxWait);
+
+  stats.Reset();
+  EXPECT_EQ(0u, stats.Sample().acquisitions);
+  EXPECT_DOUBLE_EQ(0.0, stats.Sample().holdTime);
+
+  // Without an account, it only locks
+  {
+    common::ProfiledLock<std::mutex> lock(mutex, nullptr);
+    EXPECT_FALSE(mutex.try_lock());
+  }
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+}
+
+/////////////////////////////////////////////////
+TEST_F(LockProfilerTest, ProfiledMutex)
+{
+  common::ProfiledMutex<boost::recursive_mutex> mutex("test/recursive");
+  {
+    std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>>
+        lock(mutex);
+    std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>>
+        nested(mutex);
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+  }
+
+  // Mutual exclusion
+  int count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([&mutex, &count]()
+        {
+          for (int j = 0; j < 1000; ++j)
+          {
+            std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>>
+                lock(mutex);
+            ++count;
+          }
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(4000, count);
+
+  std::vector<common::LockSample> samples =
+      common::LockProfiler::Instance()->Samples();
+  if (!common::LockProfiler::Enabled())
+  {
+    EXPECT_TRUE(samples.empty());
+    EXPECT_TRUE(common::LockProfiler::Instance()->Stats("test/other") ==
+        nullptr);
+    return;
+  }
+
+  // The nested locks aren't counted
+  ASSERT_EQ(1u, samples.size());
+  EXPECT_EQ("test/recursive", samples[0].name);
+  EXPECT_EQ(4001u, samples[0].acquisitions);
+  EXPECT_LE(samples[0].contentions, 4000u);
+
+  common::LockProfiler::Instance()->Reset();
+  EXPECT_EQ(0u,
+      common::LockProfiler::Instance()->Samples()[0].acquisitions);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
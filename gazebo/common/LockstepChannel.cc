@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#ifdef __linux__
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/LockstepChannel.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Header of the shared memory of a channel, followed by the
+    /// command and the state blocks.
+    struct LockstepHeader
+    {
+      /// \brief Identifies a channel.
+      uint32_t magic;
+
+      /// \brief Version of the layout.
+      uint32_t version;
+
+      /// \brief Number of doubles of the command block.
+      uint32_t commandSize;
+
+      /// \brief Number of doubles of the state block.
+      uint32_t stateSize;
+
+      /// \brief Number of steps asked by the external process.
+      std::atomic<uint32_t> requested;
+
+      /// \brief Number of steps completed by the simulation.
+      std::atomic<uint32_t> completed;
+
+      /// \brief Not 0 once the simulation closed the channel.
+      std::atomic<uint32_t> closed;
+
+      /// \brief Iteration count of the last completed step.
+      std::atomic<uint64_t> iterations;
+
+      /// \brief Bits of the sim time of the last completed step.
+      std::atomic<uint64_t> simTime;
+    };
+
+    /// \internal
+    /// \brief Private data for the LockstepChannel class.
+    class LockstepChannelPrivate
+    {
+      /// \brief Name of the shared memory object.
+      public: std::string shmName;
+
+      /// \brief Mapped memory, null if the channel isn't open.
+      public: void *memory = nullptr;
+
+      /// \brief Size of the mapped memory.
+      public: std::size_t size = 0;
+
+      /// \brief Header in the mapped memory.
+      public: LockstepHeader *header = nullptr;
+
+      /// \brief Command block in the mapped memory.
+      public: double *command = nullptr;
+
+      /// \brief State block in the mapped memory.
+      public: double *state = nullptr;
+
+      /// \brief True on the side that created the channel.
+      public: bool owner = false;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Identifies a channel, "GZLS".
+static const uint32_t kLockstepMagic = 0x534c5a47;
+
+/// \brief Version of the layout of the shared memory.
+static const uint32_t kLockstepVersion = 1;
+
+/// \brief Offset of the blocks from the start of the shared memory, a
+/// cache line apart from the header.
+static const std::size_t kLockstepDataOffset =
+    (sizeof(LockstepHeader) + 63) / 64 * 64;
+
+/////////////////////////////////////////////////
+/// \brief Wake the other side waiting on a word.
+/// \param[in] _word The word.
+static void wake(std::atomic<uint32_t> &_word)
+{
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_word), FUTEX_WAKE,
+      INT_MAX, nullptr, nullptr, 0);
+#else
+  (void)_word;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for a word to differ from a value.
+/// \param[in] _word The word.
+/// \param[in] _value The value.
+/// \param[in] _closed Set when the channel is closed.
+/// \param[in] _timeout Longest wait in seconds, negative for no limit.
+/// \return True if the word changed, false on timeout or close.
+static bool waitWhile(std::atomic<uint32_t> &_word, const uint32_t _value,
+    const std::atomic<uint32_t> &_closed, const double _timeout)
+{
+  // Steps at kHz rates come back within microseconds, spin a little
+  // before sleeping
+  for (int i = 0; i < 2000; ++i)
+  {
+    if (_word.load(std::memory_order_acquire) != _value)
+      return true;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  while (_word.load(std::memory_order_acquire) == _value)
+  {
+    if (_closed.load(std::memory_order_acquire))
+      return false;
+
+    // Wake up now and then to notice a close by a process that died
+    std::chrono::nanoseconds slice = std::chrono::milliseconds(100);
+    if (_timeout >= 0)
+    {
+      const auto left = std::chrono::duration<double>(_timeout) -
+          (std::chrono::steady_clock::now() - start);
+      if (left.count() <= 0)
+        return false;
+      slice = std::min(slice,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(left));
+    }
+
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = slice.count() / 1000000000;
+    ts.tv_nsec = slice.count() % 1000000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_word), FUTEX_WAIT,
+        _value, &ts, nullptr, 0);
+#else
+    std::this_thread::sleep_for(std::min(slice,
+        std::chrono::nanoseconds(std::chrono::microseconds(50))));
+#endif
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+LockstepChannel::LockstepChannel()
+  : dataPtr(new LockstepChannelPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LockstepChannel::~LockstepChannel()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool LockstepChannel::Create(const std::string &_name,
+    const unsigned int _commandSize, const unsigned int _stateSize)
+{
+  this->Close();
+
+#ifdef _WIN32
+  gzerr << "Lockstep channels are not available on Windows\n";
+  (void)_name;
+  (void)_commandSize;
+  (void)_stateSize;
+  return false;
+#else
+  const std::string shmName = "/gazebo_lockstep_" + _name;
+  const std::size_t size = kLockstepDataOffset +
+      (_commandSize + _stateSize) * sizeof(*this->dataPtr->command);
+
+  // Replace a channel left by a simulation that died
+  shm_unlink(shmName.c_str());
+  const int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzerr << "Unable to create lockstep channel [" << _name << "]: "
+          << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  void *memory = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+  {
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzerr << "Unable to map lockstep channel [" << _name << "]: "
+          << std::strerror(errno) << "\n";
+    shm_unlink(shmName.c_str());
+    return false;
+  }
+
+  std::memset(memory, 0, size);
+  LockstepHeader *header = new(memory) LockstepHeader;
+  header->version = kLockstepVersion;
+  header->commandSize = _commandSize;
+  header->stateSize = _stateSize;
+  header->requested.store(0);
+  header->completed.store(0);
+  header->closed.store(0);
+  header->iterations.store(0);
+  header->simTime.store(0);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // Written last, the external process checks it first
+  header->magic = kLockstepMagic;
+
+  this->dataPtr->shmName = shmName;
+  this->dataPtr->memory = memory;
+  this->dataPtr->size = size;
+  this->dataPtr->header = header;
+  this->dataPtr->command = reinterpret_cast<double *>(
+      static_cast<char *>(memory) + kLockstepDataOffset);
+  this->dataPtr->state = this->dataPtr->command + _commandSize;
+  this->dataPtr->owner = true;
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+bool LockstepChannel::Open(const std::string &_name)
+{
+  this->Close();
+
+#ifdef _WIN32
+  gzerr << "Lockstep channels are not available on Windows\n";
+  (void)_name;
+  return false;
+#else
+  const std::string shmName = "/gazebo_lockstep_" + _name;
+  const int fd = shm_open(shmName.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+  {
+    gzerr << "Unable to open lockstep channel [" << _name << "]: "
+          << std::strerror(errno) << "\n";
+    return false;
+  }
+
+  struct stat info;
+  void *memory = MAP_FAILED;
+  std::size_t size = 0;
+  if (fstat(fd, &info) == 0 &&
+      static_cast<std::size_t>(info.st_size) >= kLockstepDataOffset)
+  {
+    size = static_cast<std::size_t>(info.st_size);
+    memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED)
+  {
+    gzerr << "Unable to map lockstep channel [" << _name << "]\n";
+    return false;
+  }
+
+  LockstepHeader *header = static_cast<LockstepHeader *>(memory);
+  if (header->magic != kLockstepMagic || header->version != kLockstepVersion ||
+      kLockstepDataOffset + (header->commandSize + header->stateSize) *
+      sizeof(*this->dataPtr->command) > size)
+  {
+    gzerr << "Invalid lockstep channel [" << _name << "]\n";
+    munmap(memory, size);
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  this->dataPtr->shmName = shmName;
+  this->dataPtr->memory = memory;
+  this->dataPtr->size = size;
+  this->dataPtr->header = header;
+  this->dataPtr->command = reinterpret_cast<double *>(
+      static_cast<char *>(memory) + kLockstepDataOffset);
+  this->dataPtr->state = this->dataPtr->command + header->commandSize;
+  this->dataPtr->owner = false;
+  return true;
+#endif
+}
+
+/////////////////////////////////////////////////
+void LockstepChannel::Close()
+{
+  if (!this->dataPtr->memory)
+    return;
+
+#ifndef _WIN32
+  if (this->dataPtr->owner)
+  {
+    this->dataPtr->header->closed.store(1, std::memory_order_release);
+    wake(this->dataPtr->header->requested);
+    wake(this->dataPtr->header->completed);
+    shm_unlink(this->dataPtr->shmName.c_str());
+  }
+  munmap(this->dataPtr->memory, this->dataPtr->size);
+#endif
+
+  this->dataPtr->memory = nullptr;
+  this->dataPtr->size = 0;
+  this->dataPtr->header = nullptr;
+  this->dataPtr->command = nullptr;
+  this->dataPtr->state = nullptr;
+  this->dataPtr->owner = false;
+}
+
+/////////////////////////////////////////////////
+bool LockstepChannel::Valid() const
+{
+  return this->dataPtr->header &&
+      !this->dataPtr->header->closed.load(std::memory_order_acquire);
+}
+
+/////////////////////////////////////////////////
+double *LockstepChannel::Command() const
+{
+  return this->dataPtr->command;
+}
+
+/////////////////////////////////////////////////
+unsigned int LockstepChannel::CommandSize() const
+{
+  return this->dataPtr->header ? this->dataPtr->header->commandSize : 0;
+}
+
+/////////////////////////////////////////////////
+double *LockstepChannel::State() const
+{
+  return this->dataPtr->state;
+}
+
+/////////////////////////////////////////////////
+unsigned int LockstepChannel::StateSize() const
+{
+  return this->dataPtr->header ? this->dataPtr->header->stateSize : 0;
+}
+
+/////////////////////////////////////////////////
+bool LockstepChannel::Step(const double _timeout)
+{
+  if (!this->Valid())
+    return false;
+
+  LockstepHeader &header = *this->dataPtr->header;
+  const uint32_t previous = header.completed.load(std::memory_order_acquire);
+  const uint32_t request = header.requested.load(std::memory_order_relaxed) +
+      1;
+
+  // The release publishes the command block
+  header.requested.store(request, std::memory_order_release);
+  wake(header.requested);
+
+  if (!waitWhile(header.completed, previous, header.closed, _timeout))
+    return false;
+  return header.completed.load(std::memory_order_acquire) == request;
+}
+
+/////////////////////////////////////////////////
+bool LockstepChannel::WaitForStep(const double _timeout)
+{
+  if (!this->Valid())
+    return false;
+
+  LockstepHeader &header = *this->dataPtr->header;
+  const uint32_t completed = header.completed.load(std::memory_order_relaxed);
+  return waitWhile(header.requested, completed, header.closed, _timeout);
+}
+
+/////////////////////////////////////////////////
+void LockstepChannel::CompleteStep(const uint64_t _iterations,
+    const double _simTime)
+{
+  if (!this->Valid())
+    return;
+
+  LockstepHeader &header = *this->dataPtr->header;
+  uint64_t bits;
+  std::memcpy(&bits, &_simTime, sizeof(bits));
+  header.iterations.store(_iterations, std::memory_order_relaxed);
+  header.simTime.store(bits, std::memory_order_relaxed);
+
+  // The release publishes the state block
+  header.completed.store(header.requested.load(std::memory_order_acquire),
+      std::memory_order_release);
+  wake(header.completed);
+}
+
+/////////////////////////////////////////////////
+uint64_t LockstepChannel::Iterations() const
+{
+  if (!this->dataPtr->header)
+    return 0;
+  return this->dataPtr->header->iterations.load(std::memory_order_acquire);
+}
+
+/////////////////////////////////////////////////
+double LockstepChannel::SimTime() const
+{
+  if (!this->dataPtr->header)
+    return 0;
+
+  const uint64_t bits =
+      this->dataPtr->header->simTime.load(std::memory_order_acquire);
+  double simTime;
+  std::memcpy(&simTime, &bits, sizeof(simTime));
+  return simTime;
+}
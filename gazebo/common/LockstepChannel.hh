@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_LOCKSTEPCHANNEL_HH_
+#define GAZEBO_COMMON_LOCKSTEPCHANNEL_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class LockstepChannelPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class LockstepChannel LockstepChannel.hh common/common.hh
+    /// \brief Step barrier and state exchange between a simulation and
+    /// an external process, in shared memory.
+    ///
+    /// The simulation creates the channel with the sizes of a command
+    /// block, written by the external process, and of a state block,
+    /// written by the simulation. Both are arrays of doubles that each side
+    /// reads and writes in place. The external process opens the channel
+    /// by name, writes the command, and calls Step, which wakes the
+    /// simulation and returns once the simulation completed the step and
+    /// wrote the state. On Linux the two sides wait on futexes in the
+    /// shared memory, so a round trip costs two context switches.
+    /// Elsewhere they sleep for short periods.
+    ///
+    /// There is one simulation and one external process per channel.
+    /// Shared memory isn't available on Windows, where Create and Open
+    /// fail.
+    class GZ_COMMON_VISIBLE LockstepChannel
+    {
+      /// \brief Constructor.
+      public: LockstepChannel();
+
+      /// \brief Destructor. Closes the channel.
+      public: virtual ~LockstepChannel();
+
+      /// \brief Create a channel, on the side of the simulation. A stale
+      /// channel with the same name is replaced.
+      /// \param[in] _name Name of the channel, without slashes.
+      /// \param[in] _commandSize Number of doubles of the command block.
+      /// \param[in] _stateSize Number of doubles of the state block.
+      /// \return True on success.
+      public: bool Create(const std::string &_name,
+                  const unsigned int _commandSize,
+                  const unsigned int _stateSize);
+
+      /// \brief Open a channel created by a simulation, on the side of the
+      /// external process.
+      /// \param[in] _name Name of the channel.
+      /// \return True on success.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Close the channel. The side that created it removes it,
+      /// and wakes the other side.
+      public: void Close();
+
+      /// \brief Get whether the channel is open.
+      /// \return True if Create or Open succeeded and the channel wasn't
+      /// closed by either side.
+      public: bool Valid() const;
+
+      /// \brief Get the command block.
+      /// \return Pointer to CommandSize() doubles, null if the channel
+      /// isn't open.
+      public: double *Command() const;
+
+      /// \brief Get the number of doubles of the command block.
+      /// \return The size.
+      public: unsigned int CommandSize() const;
+
+      /// \brief Get the state block.
+      /// \return Pointer to StateSize() doubles, null if the channel isn't
+      /// open.
+      public: double *State() const;
+
+      /// \brief Get the number of doubles of the state block.
+      /// \return The size.
+      public: unsigned int StateSize() const;
+
+      /// \brief Ask the simulation for a step and wait for it, on the side
+      /// of the external process.
+      /// \param[in] _timeout Longest wait in seconds, negative to wait
+      /// until the step completes or the channel closes.
+      /// \return True if the step completed.
+      public: bool Step(const double _timeout = -1);
+
+      /// \brief Wait for the external process to ask for a step, on the
+      /// side of the simulation.
+      /// \param[in] _timeout Longest wait in seconds, negative to wait
+      /// until a step is asked or the channel closes.
+      /// \return True if a step was asked.
+      public: bool WaitForStep(const double _timeout = -1);
+
+      /// \brief Tell the external process that the step it asked for
+      /// completed, on the side of the simulation. The state block must
+      /// be written before.
+      /// \param[in] _iterations Iteration count of the simulation.
+      /// \param[in] _simTime Sim time in seconds.
+      public: void CompleteStep(const uint64_t _iterations,
+                  const double _simTime);
+
+      /// \brief Get the iteration count of the last completed step.
+      /// \return The iteration count.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the sim time of the last completed step.
+      /// \return Sim time in seconds.
+      public: double SimTime() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LockstepChannelPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <thread>
+
+#include "gazebo/common/LockstepChannel.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LockstepChannelTest : public gazebo::testing::AutoLogFixture { };
+
+#ifndef _WIN32
+/////////////////////////////////////////////////
+TEST_F(LockstepChannelTest, Open)
+{
+  common::LockstepChannel client;
+  EXPECT_FALSE(client.Valid());
+  EXPECT_FALSE(client.Open("lockstep_test_missing"));
+  EXPECT_FALSE(client.Step(0.01));
+  EXPECT_TRUE(client.Command() == nullptr);
+
+  common::LockstepChannel server;
+  ASSERT_TRUE(server.Create("lockstep_test_open", 2, 3));
+  EXPECT_TRUE(server.Valid());
+  EXPECT_EQ(server.CommandSize(), 2u);
+  EXPECT_EQ(server.StateSize(), 3u);
+
+  ASSERT_TRUE(client.Open("lockstep_test_open"));
+  EXPECT_TRUE(client.Valid());
+  EXPECT_EQ(client.CommandSize(), 2u);
+  EXPECT_EQ(client.StateSize(), 3u);
+
+  // No step was asked
+  EXPECT_FALSE(server.WaitForStep(0.01));
+
+  // Closing the server wakes the client
+  server.Close();
+  EXPECT_FALSE(server.Valid());
+  EXPECT_FALSE(client.Valid());
+  EXPECT_FALSE(client.Step());
+  client.Close();
+  EXPECT_FALSE(client.Open("lockstep_test_open"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(LockstepChannelTest, Step)
+{
+  common::LockstepChannel server;
+  ASSERT_TRUE(server.Create("lockstep_test_step", 1, 1));
+
+  // The simulation doubles the command
+  const int steps = 1000;
+  std::thread simulation([&server]()
+      {
+        for (int i = 1; i <= steps; ++i)
+        {
+          if (!server.WaitForStep(5))
+            return;
+          server.State()[0] = server.Command()[0] * 2;
+          server.CompleteStep(i, i * 0.001);
+        }
+      });
+
+  common::LockstepChannel client;
+  ASSERT_TRUE(client.Open("lockstep_test_step"));
+  for (int i = 1; i <= steps; ++i)
+  {
+    client.Command()[0] = i;
+    ASSERT_TRUE(client.Step(5));
+    EXPECT_DOUBLE_EQ(client.State()[0], i * 2.0);
+    EXPECT_EQ(client.Iterations(), static_cast<uint64_t>(i));
+    EXPECT_DOUBLE_EQ(client.SimTime(), i * 0.001);
+  }
+  simulation.join();
+
+  // The simulation stopped answering
+  EXPECT_FALSE(client.Step(0.01));
+}
+#endif
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 
 #include <boost/filesystem.hpp>
 #include <algorithm>
+#include <mutex>
 #include <boost/lexical_cast.hpp>
 
 #include "gazebo/common/SystemPaths.hh"
@@ -29,6 +30,19 @@ using namespace common;
 
 unsigned int Material::counter = 0;
 
+/// \brief Protects Material::counter, since meshes may be loaded by several
+/// threads at once.
+static std::mutex g_counterMutex;
+
+/// \brief Get a unique material name.
+/// \param[in] _counter The material counter.
+/// \return The name.
+static std::string UniqueName(unsigned int &_counter)
+{
+  std::lock_guard<std::mutex> lock(g_counterMutex);
+  return "gazebo_material_" + boost::lexical_cast<std::string>(_counter++);
+}
+
 std::string Material::ShadeModeStr[SHADE_COUNT] = {"FLAT", "GOURAUD",
   "PHONG", "BLINN"};
 std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
@@ -37,7 +51,7 @@ std::string Material::BlendModeStr[BLEND_COUNT] = {"ADD", "MODULATE",
 //////////////////////////////////////////////////
 Material::Material()
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = UniqueName(counter);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient.Set(0.4, 0.4, 0.4, 1);
@@ -49,7 +63,7 @@ Material::Material()
 //////////////////////////////////////////////////
 Material::Material(const ignition::math::Color &_clr)
 {
-  this->name = "gazebo_material_" + boost::lexical_cast<std::string>(counter++);
+  this->name = UniqueName(counter);
   this->blendMode = REPLACE;
   this->shadeMode = GOURAUD;
   this->ambient = _clr;
@@ -15,6 +15,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "gazebo/common/Material.hh"
 #include "test/util.hh"
@@ -76,6 +80,29 @@ TEST_F(MaterialTest, Material)
   EXPECT_TRUE(mat.GetLighting());
 }
 
+/////////////////////////////////////////////////
+TEST_F(MaterialTest, UniqueNames)
+{
+  // Materials created by several threads at once all get their own name
+  std::vector<std::vector<std::string>> names(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    threads.push_back(std::thread([&names, i]()
+    {
+      for (int j = 0; j < 1000; ++j)
+        names[i].push_back(common::Material().GetName());
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  std::set<std::string> unique;
+  for (auto const &threadNames : names)
+    unique.insert(threadNames.begin(), threadNames.end());
+  EXPECT_EQ(4000u, unique.size());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
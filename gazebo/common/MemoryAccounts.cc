@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccounts.hh"
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the MemoryAccount class.
+    class MemoryAccountPrivate
+    {
+      /// \brief Name of the account.
+      public: std::string name;
+
+      /// \brief Bytes held.
+      public: std::atomic<int64_t> bytes{0};
+
+      /// \brief Objects held.
+      public: std::atomic<int64_t> objects{0};
+
+      /// \brief Largest number of bytes held.
+      public: std::atomic<int64_t> peakBytes{0};
+    };
+
+    /// \internal
+    /// \brief Private data for the MemoryAccounts class.
+    class MemoryAccountsPrivate
+    {
+      /// \brief Accounts, by name.
+      public: std::map<std::string, std::unique_ptr<MemoryAccount>> accounts;
+
+      /// \brief Protects the accounts.
+      public: mutable std::mutex mutex;
+
+      /// \brief Probes, by account name.
+      public: std::map<std::string, MemoryAccounts::Probe> probes;
+
+      /// \brief Protects the probes, and is held while they run.
+      public: mutable std::mutex probeMutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Raise a peak to a value.
+/// \param[in,out] _peak The peak.
+/// \param[in] _value The value.
+static void raisePeak(std::atomic<int64_t> &_peak, const int64_t _value)
+{
+  int64_t peak = _peak.load(std::memory_order_relaxed);
+  while (_value > peak &&
+         !_peak.compare_exchange_weak(peak, _value, std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+MemoryAccount::MemoryAccount(const std::string &_name)
+  : dataPtr(new MemoryAccountPrivate)
+{
+  this->dataPtr->name = _name;
+}
+
+/////////////////////////////////////////////////
+MemoryAccount::~MemoryAccount()
+{
+}
+
+/////////////////////////////////////////////////
+std::string MemoryAccount::Name() const
+{
+  return this->dataPtr->name;
+}
+
+/////////////////////////////////////////////////
+void MemoryAccount::Add(const int64_t _bytes, const int64_t _objects)
+{
+  const int64_t bytes = this->dataPtr->bytes.fetch_add(_bytes,
+      std::memory_order_relaxed) + _bytes;
+  this->dataPtr->objects.fetch_add(_objects, std::memory_order_relaxed);
+  raisePeak(this->dataPtr->peakBytes, bytes);
+}
+
+/////////////////////////////////////////////////
+void MemoryAccount::Set(const int64_t _bytes, const int64_t _objects)
+{
+  this->dataPtr->bytes.store(_bytes, std::memory_order_relaxed);
+  this->dataPtr->objects.store(_objects, std::memory_order_relaxed);
+  raisePeak(this->dataPtr->peakBytes, _bytes);
+}
+
+/////////////////////////////////////////////////
+MemorySample MemoryAccount::Sample() const
+{
+  MemorySample sample;
+  sample.name = this->dataPtr->name;
+  sample.bytes = this->dataPtr->bytes.load(std::memory_order_relaxed);
+  sample.objects = this->dataPtr->objects.load(std::memory_order_relaxed);
+  sample.peakBytes = this->dataPtr->peakBytes.load(std::memory_order_relaxed);
+  return sample;
+}
+
+/////////////////////////////////////////////////
+MemoryUsage::MemoryUsage(const std::string &_account)
+  : account(MemoryAccounts::Instance()->Account(_account))
+{
+}
+
+/////////////////////////////////////////////////
+MemoryUsage::~MemoryUsage()
+{
+  this->Set(0, 0);
+}
+
+/////////////////////////////////////////////////
+void MemoryUsage::Set(const int64_t _bytes, const int64_t _objects)
+{
+  if (_bytes == this->bytes && _objects == this->objects)
+    return;
+
+  this->account.Add(_bytes - this->bytes, _objects - this->objects);
+  this->bytes = _bytes;
+  this->objects = _objects;
+}
+
+/////////////////////////////////////////////////
+int64_t MemoryUsage::Bytes() const
+{
+  return this->bytes;
+}
+
+/////////////////////////////////////////////////
+MemoryAccounts::MemoryAccounts()
+  : dataPtr(new MemoryAccountsPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+MemoryAccounts::~MemoryAccounts()
+{
+}
+
+/////////////////////////////////////////////////
+MemoryAccount &MemoryAccounts::Account(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::unique_ptr<MemoryAccount> &account = this->dataPtr->accounts[_name];
+  if (!account)
+    account.reset(new MemoryAccount(_name));
+  return *account;
+}
+
+/////////////////////////////////////////////////
+void MemoryAccounts::SetProbe(const std::string &_name, const Probe &_probe)
+{
+  this->Account(_name);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->probeMutex);
+  if (_probe)
+    this->dataPtr->probes[_name] = _probe;
+  else
+    this->dataPtr->probes.erase(_name);
+}
+
+/////////////////////////////////////////////////
+std::vector<MemorySample> MemoryAccounts::Samples() const
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->probeMutex);
+    for (auto const &probe : this->dataPtr->probes)
+      probe.second();
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::vector<MemorySample> samples;
+  samples.reserve(this->dataPtr->accounts.size());
+  for (auto const &account : this->dataPtr->accounts)
+    samples.push_back(account.second->Sample());
+  return samples;
+}
+
+/////////////////////////////////////////////////
+bool MemoryAccounts::Dump(const std::string &_filename) const
+{
+  std::ofstream file(_filename.c_str(), std::ios::out | std::ios::app);
+  if (!file.is_open())
+  {
+    gzerr << "Unable to open memory dump file[" << _filename << "]\n";
+    return false;
+  }
+
+  const common::Time now = common::Time::GetWallTime();
+  for (auto const &sample : this->Samples())
+  {
+    file << now.Double() << " " << sample.name << " " << sample.bytes << " "
+         << sample.objects << " " << sample.peakBytes << "\n";
+  }
+  return file.good();
+}
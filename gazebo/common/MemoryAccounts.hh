@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MEMORYACCOUNTS_HH_
+#define GAZEBO_COMMON_MEMORYACCOUNTS_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, MemoryAccounts)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data classes.
+    class MemoryAccountPrivate;
+    class MemoryAccountsPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief Values of a memory account at one time.
+    class GZ_COMMON_VISIBLE MemorySample
+    {
+      /// \brief Name of the account.
+      public: std::string name;
+
+      /// \brief Bytes held.
+      public: int64_t bytes = 0;
+
+      /// \brief Objects held.
+      public: int64_t objects = 0;
+
+      /// \brief Largest number of bytes held since the account was created.
+      public: int64_t peakBytes = 0;
+    };
+
+    /// \class MemoryAccount MemoryAccounts.hh common/common.hh
+    /// \brief The memory a subsystem holds, as reported by the subsystem.
+    /// The counters are atomic, so any thread can report.
+    class GZ_COMMON_VISIBLE MemoryAccount
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the account.
+      public: explicit MemoryAccount(const std::string &_name);
+
+      /// \brief Destructor.
+      public: virtual ~MemoryAccount();
+
+      /// \brief Get the name of the account.
+      /// \return Name of the account, such as "common/meshes".
+      public: std::string Name() const;
+
+      /// \brief Add to the memory held, or release memory with negative
+      /// values.
+      /// \param[in] _bytes Bytes allocated.
+      /// \param[in] _objects Objects allocated.
+      public: void Add(const int64_t _bytes, const int64_t _objects = 1);
+
+      /// \brief Set the memory held, for subsystems that measure it rather
+      /// than count it.
+      /// \param[in] _bytes Bytes held.
+      /// \param[in] _objects Objects held.
+      public: void Set(const int64_t _bytes, const int64_t _objects);
+
+      /// \brief Get the values of the account.
+      /// \return The values.
+      public: MemorySample Sample() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MemoryAccountPrivate> dataPtr;
+    };
+
+    /// \class MemoryUsage MemoryAccounts.hh common/common.hh
+    /// \brief The share of an account held by one object, such as a
+    /// buffer, so that several objects can report their size into the
+    /// same account. The share is released on destruction.
+    class GZ_COMMON_VISIBLE MemoryUsage
+    {
+      /// \brief Constructor.
+      /// \param[in] _account Name of the account.
+      public: explicit MemoryUsage(const std::string &_account);
+
+      /// \brief Destructor. Releases the share.
+      public: virtual ~MemoryUsage();
+
+      /// \brief Set the share of the object.
+      /// \param[in] _bytes Bytes held by the object.
+      /// \param[in] _objects Objects held by the object.
+      public: void Set(const int64_t _bytes, const int64_t _objects = 1);
+
+      /// \brief Get the bytes held by the object.
+      /// \return Bytes of the share.
+      public: int64_t Bytes() const;
+
+      /// \brief The account.
+      private: MemoryAccount &account;
+
+      /// \brief Bytes of the share.
+      private: int64_t bytes = 0;
+
+      /// \brief Objects of the share.
+      private: int64_t objects = 0;
+    };
+
+    /// \class MemoryAccounts MemoryAccounts.hh common/common.hh
+    /// \brief Registry of the memory accounts of the process. Subsystems
+    /// report the memory they hold into named accounts, which the server
+    /// publishes and can dump to the log directory. The figures are those
+    /// the subsystems know of, not the heap used by the process.
+    class GZ_COMMON_VISIBLE MemoryAccounts
+      : public SingletonT<MemoryAccounts>
+    {
+      /// \brief Constructor.
+      private: MemoryAccounts();
+
+      /// \brief Destructor.
+      private: virtual ~MemoryAccounts();
+
+      /// \brief Measures the memory of a subsystem and sets its account.
+      public: typedef std::function<void()> Probe;
+
+      /// \brief Get an account, created on first use. Accounts live as
+      /// long as the registry, so the reference can be kept. Singletons
+      /// that report should get their account in their constructor, so
+      /// that the registry outlives them.
+      /// \param[in] _name Name of the account, by convention
+      /// "<subsystem>/<pool>".
+      /// \return The account.
+      public: MemoryAccount &Account(const std::string &_name);
+
+      /// \brief Set the probe of an account, for subsystems whose memory
+      /// is easier to measure when sampled than to count as it changes.
+      /// \param[in] _name Name of the account.
+      /// \param[in] _probe Called by Samples, from the thread that samples.
+      /// An empty probe removes the probe, and waits for it if it runs.
+      public: void SetProbe(const std::string &_name, const Probe &_probe);
+
+      /// \brief Run the probes, then get the values of all the accounts.
+      /// \return The values, sorted by name.
+      public: std::vector<MemorySample> Samples() const;
+
+      /// \brief Append the values of all the accounts to a file, one line
+      /// per account with the wall time, name, bytes, objects and peak
+      /// bytes.
+      /// \param[in] _filename Path of the file.
+      /// \return True if the file was written.
+      public: bool Dump(const std::string &_filename) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MemoryAccountsPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<MemoryAccounts>;
+    };
+    /// \}
+  }
+}
+#endif
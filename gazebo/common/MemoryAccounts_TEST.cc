@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/MemoryAccounts.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MemoryAccountsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountsTest, Account)
+{
+  common::MemoryAccount &account =
+      common::MemoryAccounts::Instance()->Account("test/account");
+  EXPECT_EQ(&account,
+      &common::MemoryAccounts::Instance()->Account("test/account"));
+  EXPECT_EQ("test/account", account.Name());
+
+  account.Add(100, 2);
+  account.Add(-60, -1);
+  common::MemorySample sample = account.Sample();
+  EXPECT_EQ(40, sample.bytes);
+  EXPECT_EQ(1, sample.objects);
+  EXPECT_EQ(100, sample.peakBytes);
+
+  account.Set(500, 3);
+  account.Set(0, 0);
+  sample = account.Sample();
+  EXPECT_EQ(0, sample.bytes);
+  EXPECT_EQ(0, sample.objects);
+  EXPECT_EQ(500, sample.peakBytes);
+
+  // Concurrent reports add up
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([&account]()
+        {
+          for (int j = 0; j < 1000; ++j)
+            account.Add(1, 1);
+        }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(4000, account.Sample().bytes);
+  EXPECT_EQ(4000, account.Sample().objects);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountsTest, Usage)
+{
+  common::MemoryAccount &account =
+      common::MemoryAccounts::Instance()->Account("test/usage");
+  {
+    common::MemoryUsage first("test/usage");
+    common::MemoryUsage second("test/usage");
+    first.Set(10);
+    second.Set(30, 2);
+    EXPECT_EQ(40, account.Sample().bytes);
+    EXPECT_EQ(3, account.Sample().objects);
+
+    first.Set(5);
+    EXPECT_EQ(5, first.Bytes());
+    EXPECT_EQ(35, account.Sample().bytes);
+  }
+
+  // The shares are released with their objects
+  EXPECT_EQ(0, account.Sample().bytes);
+  EXPECT_EQ(0, account.Sample().objects);
+  EXPECT_EQ(40, account.Sample().peakBytes);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountsTest, Probe)
+{
+  common::MemoryAccounts *accounts = common::MemoryAccounts::Instance();
+  int64_t size = 64;
+  int calls = 0;
+  accounts->SetProbe("test/probe", [&]()
+      {
+        ++calls;
+        accounts->Account("test/probe").Set(size, 1);
+      });
+
+  auto find = [&]()
+  {
+    for (auto const &sample : accounts->Samples())
+    {
+      if (sample.name == "test/probe")
+        return sample.bytes;
+    }
+    return int64_t(-1);
+  };
+
+  // Probes run when sampled
+  EXPECT_EQ(64, find());
+  size = 128;
+  EXPECT_EQ(128, find());
+  EXPECT_EQ(2, calls);
+
+  // and not once removed
+  accounts->SetProbe("test/probe", common::MemoryAccounts::Probe());
+  size = 256;
+  EXPECT_EQ(128, find());
+  EXPECT_EQ(2, calls);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MemoryAccountsTest, Dump)
+{
+  common::MemoryAccounts::Instance()->Account("test/dump").Set(1234, 5);
+
+  bool found = false;
+  for (auto const &sample : common::MemoryAccounts::Instance()->Samples())
+  {
+    if (sample.name == "test/dump")
+    {
+      found = true;
+      EXPECT_EQ(1234, sample.bytes);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  const boost::filesystem::path path =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_memory_%%%%.log");
+  EXPECT_TRUE(common::MemoryAccounts::Instance()->Dump(path.string()));
+  EXPECT_TRUE(common::MemoryAccounts::Instance()->Dump(path.string()));
+
+  std::ifstream file(path.string().c_str());
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line))
+  {
+    if (line.find(" test/dump 1234 5 1234") != std::string::npos)
+      ++lines;
+  }
+  EXPECT_EQ(2, lines);
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
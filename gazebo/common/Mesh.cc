@@ -17,11 +17,17 @@
 #include <float.h>
 #include <string.h>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
 
 #include "gazebo/common/Material.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshPrivate.hh"
 #include "gazebo/common/Skeleton.hh"
 #include "gazebo/gazebo_config.h"
 
@@ -31,6 +37,7 @@ using namespace common;
 
 //////////////////////////////////////////////////
 Mesh::Mesh()
+  : dataPtr(new MeshPrivate)
 {
   this->name = "unknown";
   this->skeleton = nullptr;
@@ -401,11 +408,170 @@ void Mesh::Translate(const ignition::math::Vector3d &_vec)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Cluster the vertices of a triangle submesh on a grid.
+/// \param[in] _subMesh The submesh.
+/// \param[in] _origin Corner of the grid.
+/// \param[in] _cell Size of a grid cell.
+/// \return Indices of the triangles whose corners fall in different cells,
+/// each corner being replaced by the vertex of its cell that is closest to
+/// the mean of the cell.
+static std::vector<unsigned int> clusterIndices(const SubMesh *_subMesh,
+    const ignition::math::Vector3d &_origin, const double _cell)
+{
+  class Cluster
+  {
+    public: ignition::math::Vector3d sum;
+    public: unsigned int count = 0;
+    public: unsigned int vertex = 0;
+    public: double distance = DBL_MAX;
+  };
+
+  // 21 bits per axis, which covers the finest grid used
+  const unsigned int vertexCount = _subMesh->GetVertexCount();
+  std::vector<uint64_t> keys(vertexCount);
+  std::unordered_map<uint64_t, Cluster> clusters;
+  for (unsigned int i = 0; i < vertexCount; ++i)
+  {
+    const ignition::math::Vector3d v = _subMesh->Vertex(i);
+    const ignition::math::Vector3d p = (v - _origin) / _cell;
+    uint64_t key = 0;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+    {
+      const double c = std::floor(p[axis]);
+      const uint64_t index = c <= 0 ? 0 :
+          static_cast<uint64_t>(std::min(c, 2097151.0));
+      key |= index << (21 * axis);
+    }
+    keys[i] = key;
+
+    Cluster &cluster = clusters[key];
+    cluster.sum += v;
+    ++cluster.count;
+  }
+
+  for (unsigned int i = 0; i < vertexCount; ++i)
+  {
+    Cluster &cluster = clusters[keys[i]];
+    const double distance = _subMesh->Vertex(i).Distance(
+        cluster.sum / cluster.count);
+    if (distance < cluster.distance)
+    {
+      cluster.distance = distance;
+      cluster.vertex = i;
+    }
+  }
+
+  std::vector<unsigned int> result;
+  std::set<std::array<unsigned int, 3>> triangles;
+  const unsigned int indexCount = _subMesh->GetIndexCount() / 3 * 3;
+  for (unsigned int i = 0; i < indexCount; i += 3)
+  {
+    std::array<unsigned int, 3> tri;
+    bool valid = true;
+    for (unsigned int j = 0; j < 3 && valid; ++j)
+    {
+      const unsigned int index = _subMesh->GetIndex(i + j);
+      valid = index < vertexCount;
+      if (valid)
+        tri[j] = clusters[keys[index]].vertex;
+    }
+
+    if (!valid || tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+      continue;
+
+    // Rotate the smallest index first, which keeps the winding, so that
+    // duplicates are found
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()),
+        tri.end());
+    if (triangles.insert(tri).second)
+      result.insert(result.end(), tri.begin(), tri.end());
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+unsigned int Mesh::GenerateLod(const unsigned int _maxLevels)
+{
+  this->ClearLod();
+  if (this->HasSkeleton())
+    return 0;
+
+  unsigned int triangleCount = 0;
+  for (auto const subMesh : this->submeshes)
+  {
+    if (subMesh->GetPrimitiveType() == SubMesh::TRIANGLES)
+      triangleCount += subMesh->GetIndexCount() / 3;
+  }
+  if (triangleCount == 0)
+    return 0;
+
+  const ignition::math::Vector3d min = this->Min();
+  const ignition::math::Vector3d size = this->Max() - min;
+  const double extent = std::max(size.X(), std::max(size.Y(), size.Z()));
+  if (!std::isfinite(extent) || extent <= 0)
+    return 0;
+
+  // Start with a fine grid, and halve its resolution for each level
+  for (unsigned int resolution = 512;
+       resolution >= 4 && this->dataPtr->lodErrors.size() < _maxLevels;
+       resolution /= 2)
+  {
+    const double cell = extent / resolution;
+    std::vector<std::vector<unsigned int>> level(this->submeshes.size());
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < this->submeshes.size(); ++i)
+    {
+      if (this->submeshes[i]->GetPrimitiveType() != SubMesh::TRIANGLES)
+        continue;
+      level[i] = clusterIndices(this->submeshes[i], min, cell);
+      count += level[i].size() / 3;
+    }
+
+    if (count == 0)
+      break;
+    if (count * 2 > triangleCount)
+      continue;
+
+    for (unsigned int i = 0; i < this->submeshes.size(); ++i)
+    {
+      if (this->submeshes[i]->GetPrimitiveType() == SubMesh::TRIANGLES)
+        this->submeshes[i]->AddLodIndices(level[i]);
+    }
+    this->dataPtr->lodErrors.push_back(cell);
+    triangleCount = count;
+  }
+
+  return this->dataPtr->lodErrors.size();
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &Mesh::LodErrors() const
+{
+  return this->dataPtr->lodErrors;
+}
+
+//////////////////////////////////////////////////
+void Mesh::SetLodErrors(const std::vector<double> &_errors)
+{
+  this->dataPtr->lodErrors = _errors;
+}
+
+//////////////////////////////////////////////////
+void Mesh::ClearLod()
+{
+  this->dataPtr->lodErrors.clear();
+  for (auto &subMesh : this->submeshes)
+    subMesh->ClearLod();
+}
+
 //////////////////////////////////////////////////
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 SubMesh::SubMesh()
+  : dataPtr(new SubMeshPrivate)
 {
   this->materialIndex = -1;
   this->primitiveType = TRIANGLES;
@@ -413,6 +579,7 @@ SubMesh::SubMesh()
 
 //////////////////////////////////////////////////
 SubMesh::SubMesh(const SubMesh *_mesh)
+  : dataPtr(new SubMeshPrivate)
 {
   if (!_mesh)
   {
@@ -435,6 +602,7 @@ SubMesh::SubMesh(const SubMesh *_mesh)
       std::back_inserter(this->texCoords));
   std::copy(_mesh->vertices.begin(), _mesh->vertices.end(),
       std::back_inserter(this->vertices));
+  this->dataPtr->lodIndices = _mesh->dataPtr->lodIndices;
 }
 
 //////////////////////////////////////////////////
@@ -916,6 +1084,34 @@ std::string SubMesh::GetName() const
   return this->name;
 }
 
+//////////////////////////////////////////////////
+void SubMesh::AddLodIndices(const std::vector<unsigned int> &_indices)
+{
+  this->dataPtr->lodIndices.push_back(_indices);
+}
+
+//////////////////////////////////////////////////
+unsigned int SubMesh::LodLevelCount() const
+{
+  return this->dataPtr->lodIndices.size();
+}
+
+//////////////////////////////////////////////////
+const std::vector<unsigned int> &SubMesh::LodIndices(
+    const unsigned int _level) const
+{
+  static const std::vector<unsigned int> empty;
+  if (_level >= this->dataPtr->lodIndices.size())
+    return empty;
+  return this->dataPtr->lodIndices[_level];
+}
+
+//////////////////////////////////////////////////
+void SubMesh::ClearLod()
+{
+  this->dataPtr->lodIndices.clear();
+}
+
 //////////////////////////////////////////////////
 NodeAssignment::NodeAssignment()
   : vertexIndex(0), nodeIndex(0), weight(0.0)
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_MESH_HH_
 #define _GAZEBO_MESH_HH_
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -31,7 +32,9 @@ namespace gazebo
   namespace common
   {
     class Material;
+    class MeshPrivate;
     class SubMesh;
+    class SubMeshPrivate;
     class Skeleton;
 
     /// \addtogroup gazebo_common Common
@@ -177,6 +180,33 @@ namespace gazebo
       /// \param[in] _vec Amount to translate vertices.
       public: void Translate(const ignition::math::Vector3d &_vec);
 
+      /// \brief Generate reduced levels of detail of the triangle
+      /// submeshes. Each level clusters the vertices on a grid whose cells
+      /// are twice as large as those of the previous level, and keeps the
+      /// triangles whose corners fall in different cells. The reduced
+      /// levels share the vertices of the full mesh, they only have
+      /// indices of their own. A level is only kept if it has at most half
+      /// the triangles of the previous one. Meshes with a skeleton get no
+      /// levels. Existing levels are replaced.
+      /// \param[in] _maxLevels Maximum number of reduced levels.
+      /// \return Number of reduced levels generated.
+      /// \sa SubMesh::LodIndices()
+      public: unsigned int GenerateLod(const unsigned int _maxLevels = 3);
+
+      /// \brief Get the geometric error of each reduced level of detail,
+      /// which is the size of its clustering cells.
+      /// \return Errors of the levels, from the most detailed to the least
+      /// detailed one, empty if the mesh has no reduced levels.
+      public: const std::vector<double> &LodErrors() const;
+
+      /// \brief Set the geometric error of each reduced level of detail,
+      /// for meshes whose levels are added with SubMesh::AddLodIndices().
+      /// \param[in] _errors Errors of the levels.
+      public: void SetLodErrors(const std::vector<double> &_errors);
+
+      /// \brief Remove the reduced levels of detail of every submesh.
+      public: void ClearLod();
+
       /// \brief The name of the mesh
       private: std::string name;
 
@@ -191,6 +221,10 @@ namespace gazebo
 
       /// \brief The skeleton (for animation)
       private: Skeleton *skeleton;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MeshPrivate> dataPtr;
     };
 
     /// \brief Vertex to node weighted assignement for skeleton animation
@@ -423,6 +457,28 @@ namespace gazebo
       /// \param[in] _factor Scaling vector
       public: void SetScale(const ignition::math::Vector3d &_factor);
 
+      /// \brief Add a reduced level of detail. Levels must be added from
+      /// the most detailed to the least detailed one, and be generated
+      /// again if the vertices or indices change.
+      /// \param[in] _indices Triangle indices of the level, into the
+      /// vertices of the submesh.
+      /// \sa Mesh::GenerateLod()
+      public: void AddLodIndices(const std::vector<unsigned int> &_indices);
+
+      /// \brief Get the number of reduced levels of detail.
+      /// \return Number of levels, not counting the full submesh.
+      public: unsigned int LodLevelCount() const;
+
+      /// \brief Get the indices of a reduced level of detail.
+      /// \param[in] _level Index of the level, 0 being the most detailed
+      /// reduced level.
+      /// \return The indices, empty if the level doesn't exist.
+      public: const std::vector<unsigned int> &LodIndices(
+                  const unsigned int _level) const;
+
+      /// \brief Remove the reduced levels of detail.
+      public: void ClearLod();
+
       /// \brief the vertex array
       private: std::vector<ignition::math::Vector3d> vertices;
 
@@ -447,6 +503,10 @@ namespace gazebo
 
       /// \brief The name of the sub-mesh
       private: std::string name;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SubMeshPrivate> dataPtr;
     };
     /// \}
   }
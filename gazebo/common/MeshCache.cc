@@ -0,0 +1,684 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <ignition/math/Color.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/SignedDistanceField.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for MeshCache
+    class MeshCachePrivate
+    {
+      /// \brief Get the key that identifies the current version of a mesh
+      /// file.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \param[out] _key The key.
+      /// \return False if the file can't be inspected.
+      public: static bool Key(const std::string &_filename, std::string &_key)
+              {
+                boost::system::error_code ec;
+                std::time_t mtime =
+                    boost::filesystem::last_write_time(_filename, ec);
+                if (ec)
+                  return false;
+                uintmax_t size = boost::filesystem::file_size(_filename, ec);
+                if (ec)
+                  return false;
+
+                std::ostringstream stream;
+                stream << _filename << '\n' << mtime << '\n' << size << '\n'
+                       << MeshCache::kVersion;
+                _key = stream.str();
+                return true;
+              }
+
+      /// \brief Get the key of a generated mesh.
+      /// \param[in] _content Key of the content the mesh is generated from.
+      /// \return The key.
+      public: static std::string GeneratedKey(const std::string &_content)
+              {
+                std::ostringstream stream;
+                stream << "generated\n" << _content << '\n'
+                       << MeshCache::kVersion;
+                return stream.str();
+              }
+
+      /// \brief Get the key of a signed distance field.
+      /// \param[in] _content Key of the content the field is built from.
+      /// \return The key.
+      public: static std::string FieldKey(const std::string &_content)
+              {
+                std::ostringstream stream;
+                stream << "field\n" << _content << '\n'
+                       << MeshCache::kVersion;
+                return stream.str();
+              }
+
+      /// \brief Get the path of the cache entry for a key.
+      /// \param[in] _key Key returned by Key().
+      /// \return Path of the entry.
+      public: std::string EntryPath(const std::string &_key) const
+              {
+                // 64 bit FNV-1a
+                uint64_t hash = 14695981039346656037ULL;
+                for (auto const c : _key)
+                {
+                  hash ^= static_cast<unsigned char>(c);
+                  hash *= 1099511628211ULL;
+                }
+
+                std::ostringstream stream;
+                stream << std::hex << std::setw(16) << std::setfill('0')
+                       << hash << ".gzmesh";
+                return (boost::filesystem::path(this->path) /
+                    stream.str()).string();
+              }
+
+      /// \brief Identifies a cache entry.
+      public: static const uint32_t kMagic = 0x687a6d67;
+
+      /// \brief Cache directory.
+      public: std::string path;
+    };
+
+    /// \internal
+    /// \brief Appends fixed size values and strings to a buffer.
+    class MeshCacheWriter
+    {
+      /// \brief Append a value.
+      /// \param[in] _value The value.
+      public: template<typename T>
+              void Write(const T _value)
+              {
+                this->buffer.append(reinterpret_cast<const char *>(&_value),
+                    sizeof(_value));
+              }
+
+      /// \brief Append a length prefixed string.
+      /// \param[in] _value The string.
+      public: void WriteString(const std::string &_value)
+              {
+                this->Write(static_cast<uint32_t>(_value.size()));
+                this->buffer.append(_value);
+              }
+
+      /// \brief Append a color.
+      /// \param[in] _value The color.
+      public: void WriteColor(const ignition::math::Color &_value)
+              {
+                this->Write(_value.R());
+                this->Write(_value.G());
+                this->Write(_value.B());
+                this->Write(_value.A());
+              }
+
+      /// \brief The serialized data.
+      public: std::string buffer;
+    };
+
+    /// \internal
+    /// \brief Reads values written by MeshCacheWriter, checking bounds.
+    class MeshCacheReader
+    {
+      /// \brief Constructor
+      /// \param[in] _data Start of the data.
+      /// \param[in] _size Size of the data.
+      public: MeshCacheReader(const char *_data, const std::size_t _size)
+              : data(_data), end(_data + _size)
+              {
+              }
+
+      /// \brief Read a value.
+      /// \param[out] _value The value.
+      /// \return False if the data is too short.
+      public: template<typename T>
+              bool Read(T &_value)
+              {
+                if (static_cast<std::size_t>(this->end - this->data) <
+                    sizeof(_value))
+                {
+                  return false;
+                }
+                std::memcpy(&_value, this->data, sizeof(_value));
+                this->data += sizeof(_value);
+                return true;
+              }
+
+      /// \brief Read a length prefixed string.
+      /// \param[out] _value The string.
+      /// \return False if the data is too short.
+      public: bool ReadString(std::string &_value)
+              {
+                uint32_t size;
+                if (!this->Read(size) ||
+                    static_cast<std::size_t>(this->end - this->data) < size)
+                {
+                  return false;
+                }
+                _value.assign(this->data, size);
+                this->data += size;
+                return true;
+              }
+
+      /// \brief Read a color.
+      /// \param[out] _value The color.
+      /// \return False if the data is too short.
+      public: bool ReadColor(ignition::math::Color &_value)
+              {
+                float r, g, b, a;
+                if (!this->Read(r) || !this->Read(g) || !this->Read(b) ||
+                    !this->Read(a))
+                {
+                  return false;
+                }
+                _value.Set(r, g, b, a);
+                return true;
+              }
+
+      /// \brief Check that a number of elements of a given size fit in the
+      /// remaining data.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _size Size of an element.
+      /// \return True if they fit.
+      public: bool Fits(const uint32_t _count, const std::size_t _size) const
+              {
+                return static_cast<std::size_t>(this->end - this->data) /
+                    _size >= _count;
+              }
+
+      /// \brief Check that a number of elements made of values of type T
+      /// fit in the remaining data.
+      /// \param[in] _count Number of elements.
+      /// \param[in] _values Number of values in an element.
+      /// \return True if they fit.
+      public: template<typename T>
+              bool Fits(const uint32_t _count, const std::size_t _values) const
+              {
+                return this->Fits(_count, _values * sizeof(T));
+              }
+
+      /// \brief Current read position.
+      private: const char *data;
+
+      /// \brief End of the data.
+      private: const char *end;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+MeshCache::MeshCache(const std::string &_path)
+: dataPtr(new MeshCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+}
+
+/////////////////////////////////////////////////
+/// \brief Map a cache entry in memory.
+/// \param[in] _data Private data of the cache.
+/// \param[in] _key Key of the entry.
+/// \param[out] _region The mapped entry.
+/// \return False if there is no entry for the key.
+static bool mapEntry(const MeshCachePrivate &_data, const std::string &_key,
+    boost::interprocess::mapped_region &_region)
+{
+  std::string entryPath = _data.EntryPath(_key);
+  if (!boost::filesystem::exists(entryPath))
+    return false;
+
+  try
+  {
+    boost::interprocess::file_mapping file(entryPath.c_str(),
+        boost::interprocess::read_only);
+    _region = boost::interprocess::mapped_region(file,
+        boost::interprocess::read_only);
+  }
+  catch(boost::interprocess::interprocess_exception &)
+  {
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the header of a cache entry.
+/// \param[in,out] _reader Reader of the entry.
+/// \param[in] _key Key of the entry.
+/// \return False if the entry isn't valid for the key.
+static bool readHeader(MeshCacheReader &_reader, const std::string &_key)
+{
+  uint32_t magic = 0;
+  std::string entryKey;
+  return _reader.Read(magic) && magic == MeshCachePrivate::kMagic &&
+      _reader.ReadString(entryKey) && entryKey == _key;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a cache entry atomically.
+/// \param[in] _data Private data of the cache.
+/// \param[in] _key Key of the entry.
+/// \param[in] _buffer Content of the entry.
+/// \return True if the entry was written.
+static bool writeEntry(const MeshCachePrivate &_data, const std::string &_key,
+    const std::string &_buffer)
+{
+  // Write to a temporary file and rename it, so that other processes
+  // never see a partial entry.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_data.path, ec);
+
+  std::string entryPath = _data.EntryPath(_key);
+  boost::filesystem::path tmpPath = boost::filesystem::unique_path(
+      entryPath + ".%%%%-%%%%-%%%%", ec);
+  if (ec)
+    return false;
+
+  {
+    std::ofstream out(tmpPath.string(), std::ios::out | std::ios::binary);
+    out.write(_buffer.data(), _buffer.size());
+    if (!out)
+    {
+      out.close();
+      boost::filesystem::remove(tmpPath, ec);
+      gzwarn << "Unable to write mesh cache entry[" << entryPath << "]\n";
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, entryPath, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a cache entry.
+/// \param[in] _data Private data of the cache.
+/// \param[in] _key Key of the entry.
+/// \return The mesh, null if there is no valid entry for the key.
+static Mesh *loadEntry(const MeshCachePrivate &_data,
+    const std::string &_key)
+{
+  boost::interprocess::mapped_region region;
+  if (!mapEntry(_data, _key, region))
+    return nullptr;
+
+  MeshCacheReader reader(static_cast<const char *>(region.get_address()),
+      region.get_size());
+  if (!readHeader(reader, _key))
+    return nullptr;
+
+  std::unique_ptr<Mesh> mesh(new Mesh());
+  std::string meshPath;
+  uint32_t materialCount = 0;
+  if (!reader.ReadString(meshPath) || !reader.Read(materialCount))
+    return nullptr;
+  mesh->SetPath(meshPath);
+
+  for (uint32_t i = 0; i < materialCount; ++i)
+  {
+    std::string texImage;
+    ignition::math::Color ambient, diffuse, specular, emissive;
+    double transparency, shininess, srcBlend, dstBlend, pointSize;
+    int32_t blendMode, shadeMode;
+    uint8_t depthWrite, lighting;
+    if (!reader.ReadString(texImage) || !reader.ReadColor(ambient) ||
+        !reader.ReadColor(diffuse) || !reader.ReadColor(specular) ||
+        !reader.ReadColor(emissive) || !reader.Read(transparency) ||
+        !reader.Read(shininess) || !reader.Read(srcBlend) ||
+        !reader.Read(dstBlend) || !reader.Read(pointSize) ||
+        !reader.Read(blendMode) || !reader.Read(shadeMode) ||
+        !reader.Read(depthWrite) || !reader.Read(lighting) ||
+        blendMode < 0 || blendMode >= Material::BLEND_COUNT ||
+        shadeMode < 0 || shadeMode >= Material::SHADE_COUNT)
+    {
+      return nullptr;
+    }
+
+    Material *mat = new Material();
+    mat->SetTextureImage(texImage);
+    mat->SetAmbient(ambient);
+    mat->SetDiffuse(diffuse);
+    mat->SetSpecular(specular);
+    mat->SetEmissive(emissive);
+    mat->SetTransparency(transparency);
+    mat->SetShininess(shininess);
+    mat->SetBlendFactors(srcBlend, dstBlend);
+    mat->SetPointSize(pointSize);
+    mat->SetBlendMode(static_cast<Material::BlendMode>(blendMode));
+    mat->SetShadeMode(static_cast<Material::ShadeMode>(shadeMode));
+    mat->SetDepthWrite(depthWrite != 0);
+    mat->SetLighting(lighting != 0);
+    mesh->AddMaterial(mat);
+  }
+
+  uint32_t lodCount = 0;
+  if (!reader.Read(lodCount) || !reader.Fits<double>(lodCount, 1))
+    return nullptr;
+  std::vector<double> lodErrors(lodCount);
+  for (uint32_t i = 0; i < lodCount; ++i)
+    reader.Read(lodErrors[i]);
+  mesh->SetLodErrors(lodErrors);
+
+  uint32_t subMeshCount = 0;
+  if (!reader.Read(subMeshCount))
+    return nullptr;
+
+  for (uint32_t i = 0; i < subMeshCount; ++i)
+  {
+    std::unique_ptr<SubMesh> subMesh(new SubMesh());
+    std::string name;
+    int32_t primitiveType, materialIndex;
+    if (!reader.ReadString(name) || !reader.Read(primitiveType) ||
+        !reader.Read(materialIndex))
+    {
+      return nullptr;
+    }
+    subMesh->SetName(name);
+    subMesh->SetPrimitiveType(
+        static_cast<SubMesh::PrimitiveType>(primitiveType));
+    if (materialIndex >= 0)
+      subMesh->SetMaterialIndex(materialIndex);
+
+    uint32_t count = 0;
+    if (!reader.Read(count) || !reader.Fits<double>(count, 3))
+      return nullptr;
+    subMesh->SetVertexCount(count);
+    for (uint32_t j = 0; j < count; ++j)
+    {
+      double x, y, z;
+      reader.Read(x);
+      reader.Read(y);
+      reader.Read(z);
+      subMesh->SetVertex(j, ignition::math::Vector3d(x, y, z));
+    }
+
+    if (!reader.Read(count) || !reader.Fits<double>(count, 3))
+      return nullptr;
+    subMesh->SetNormalCount(count);
+    for (uint32_t j = 0; j < count; ++j)
+    {
+      double x, y, z;
+      reader.Read(x);
+      reader.Read(y);
+      reader.Read(z);
+      subMesh->SetNormal(j, ignition::math::Vector3d(x, y, z));
+    }
+
+    if (!reader.Read(count) || !reader.Fits<double>(count, 2))
+      return nullptr;
+    subMesh->SetTexCoordCount(count);
+    for (uint32_t j = 0; j < count; ++j)
+    {
+      double u, v;
+      reader.Read(u);
+      reader.Read(v);
+      subMesh->SetTexCoord(j, ignition::math::Vector2d(u, v));
+    }
+
+    if (!reader.Read(count) || !reader.Fits(count, sizeof(uint32_t)))
+      return nullptr;
+    for (uint32_t j = 0; j < count; ++j)
+    {
+      uint32_t index;
+      reader.Read(index);
+      subMesh->AddIndex(index);
+    }
+
+    uint32_t levelCount = 0;
+    if (!reader.Read(levelCount) || levelCount > lodCount)
+      return nullptr;
+    for (uint32_t j = 0; j < levelCount; ++j)
+    {
+      if (!reader.Read(count) || !reader.Fits(count, sizeof(uint32_t)))
+        return nullptr;
+      std::vector<unsigned int> lodIndices(count);
+      for (uint32_t k = 0; k < count; ++k)
+      {
+        uint32_t index;
+        reader.Read(index);
+        lodIndices[k] = index;
+      }
+      subMesh->AddLodIndices(lodIndices);
+    }
+
+    mesh->AddSubMesh(subMesh.release());
+  }
+
+  return mesh.release();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a cache entry.
+/// \param[in] _data Private data of the cache.
+/// \param[in] _key Key of the entry.
+/// \param[in] _mesh The mesh.
+/// \return True if the entry was written.
+static bool saveEntry(const MeshCachePrivate &_data, const std::string &_key,
+    const Mesh *_mesh)
+{
+  if (!_mesh || _mesh->HasSkeleton())
+    return false;
+
+  MeshCacheWriter writer;
+  writer.Write(MeshCachePrivate::kMagic);
+  writer.WriteString(_key);
+  writer.WriteString(_mesh->GetPath());
+
+  writer.Write(static_cast<uint32_t>(_mesh->GetMaterialCount()));
+  for (unsigned int i = 0; i < _mesh->GetMaterialCount(); ++i)
+  {
+    const Material *mat = _mesh->GetMaterial(i);
+    double srcBlend, dstBlend;
+    mat->GetBlendFactors(srcBlend, dstBlend);
+
+    writer.WriteString(mat->GetTextureImage());
+    writer.WriteColor(mat->Ambient());
+    writer.WriteColor(mat->Diffuse());
+    writer.WriteColor(mat->Specular());
+    writer.WriteColor(mat->Emissive());
+    writer.Write(mat->GetTransparency());
+    writer.Write(mat->GetShininess());
+    writer.Write(srcBlend);
+    writer.Write(dstBlend);
+    writer.Write(mat->GetPointSize());
+    writer.Write(static_cast<int32_t>(mat->GetBlendMode()));
+    writer.Write(static_cast<int32_t>(mat->GetShadeMode()));
+    writer.Write(static_cast<uint8_t>(mat->GetDepthWrite()));
+    writer.Write(static_cast<uint8_t>(mat->GetLighting()));
+  }
+
+  writer.Write(static_cast<uint32_t>(_mesh->LodErrors().size()));
+  for (auto const error : _mesh->LodErrors())
+    writer.Write(error);
+
+  writer.Write(static_cast<uint32_t>(_mesh->GetSubMeshCount()));
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh->GetSubMesh(i);
+    writer.WriteString(subMesh->GetName());
+    writer.Write(static_cast<int32_t>(subMesh->GetPrimitiveType()));
+    writer.Write(static_cast<int32_t>(subMesh->GetMaterialIndex()));
+
+    writer.Write(static_cast<uint32_t>(subMesh->GetVertexCount()));
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+    {
+      ignition::math::Vector3d v = subMesh->Vertex(j);
+      writer.Write(v.X());
+      writer.Write(v.Y());
+      writer.Write(v.Z());
+    }
+
+    writer.Write(static_cast<uint32_t>(subMesh->GetNormalCount()));
+    for (unsigned int j = 0; j < subMesh->GetNormalCount(); ++j)
+    {
+      ignition::math::Vector3d n = subMesh->Normal(j);
+      writer.Write(n.X());
+      writer.Write(n.Y());
+      writer.Write(n.Z());
+    }
+
+    writer.Write(static_cast<uint32_t>(subMesh->GetTexCoordCount()));
+    for (unsigned int j = 0; j < subMesh->GetTexCoordCount(); ++j)
+    {
+      ignition::math::Vector2d t = subMesh->TexCoord(j);
+      writer.Write(t.X());
+      writer.Write(t.Y());
+    }
+
+    writer.Write(static_cast<uint32_t>(subMesh->GetIndexCount()));
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      writer.Write(static_cast<uint32_t>(subMesh->GetIndex(j)));
+
+    writer.Write(static_cast<uint32_t>(subMesh->LodLevelCount()));
+    for (unsigned int j = 0; j < subMesh->LodLevelCount(); ++j)
+    {
+      const std::vector<unsigned int> &lodIndices = subMesh->LodIndices(j);
+      writer.Write(static_cast<uint32_t>(lodIndices.size()));
+      for (auto const index : lodIndices)
+        writer.Write(static_cast<uint32_t>(index));
+    }
+  }
+
+  return writeEntry(_data, _key, writer.buffer);
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::Load(const std::string &_filename) const
+{
+  std::string key;
+  if (!MeshCachePrivate::Key(_filename, key))
+    return nullptr;
+  return loadEntry(*this->dataPtr, key);
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::Save(const std::string &_filename, const Mesh *_mesh) const
+{
+  std::string key;
+  if (!MeshCachePrivate::Key(_filename, key))
+    return false;
+  return saveEntry(*this->dataPtr, key, _mesh);
+}
+
+/////////////////////////////////////////////////
+Mesh *MeshCache::LoadGenerated(const std::string &_key) const
+{
+  return loadEntry(*this->dataPtr, MeshCachePrivate::GeneratedKey(_key));
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::SaveGenerated(const std::string &_key,
+    const Mesh *_mesh) const
+{
+  return saveEntry(*this->dataPtr, MeshCachePrivate::GeneratedKey(_key),
+      _mesh);
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::LoadField(const std::string &_key,
+    SignedDistanceField &_field) const
+{
+  const std::string key = MeshCachePrivate::FieldKey(_key);
+  boost::interprocess::mapped_region region;
+  if (!mapEntry(*this->dataPtr, key, region))
+    return false;
+
+  MeshCacheReader reader(static_cast<const char *>(region.get_address()),
+      region.get_size());
+  double x, y, z, resolution;
+  ignition::math::Vector3<unsigned int> size;
+  if (!readHeader(reader, key) || !reader.Read(x) || !reader.Read(y) ||
+      !reader.Read(z) || !reader.Read(resolution) || !reader.Read(size[0]) ||
+      !reader.Read(size[1]) || !reader.Read(size[2]))
+  {
+    return false;
+  }
+
+  const uint64_t count = static_cast<uint64_t>(size.X()) * size.Y() *
+      size.Z();
+  if (count > std::numeric_limits<uint32_t>::max() ||
+      !reader.Fits<float>(static_cast<uint32_t>(count), 1))
+  {
+    return false;
+  }
+  std::vector<float> values(count);
+  for (auto &value : values)
+    reader.Read(value);
+
+  return _field.Set(ignition::math::Vector3d(x, y, z), resolution, size,
+      values);
+}
+
+/////////////////////////////////////////////////
+bool MeshCache::SaveField(const std::string &_key,
+    const SignedDistanceField &_field) const
+{
+  if (!_field.Valid())
+    return false;
+
+  const std::string key = MeshCachePrivate::FieldKey(_key);
+  MeshCacheWriter writer;
+  writer.Write(MeshCachePrivate::kMagic);
+  writer.WriteString(key);
+  writer.Write(_field.Origin().X());
+  writer.Write(_field.Origin().Y());
+  writer.Write(_field.Origin().Z());
+  writer.Write(_field.Resolution());
+  writer.Write(static_cast<uint32_t>(_field.Size().X()));
+  writer.Write(static_cast<uint32_t>(_field.Size().Y()));
+  writer.Write(static_cast<uint32_t>(_field.Size().Z()));
+  writer.buffer.append(
+      reinterpret_cast<const char *>(_field.Values().data()),
+      _field.Values().size() * sizeof(_field.Values()[0]));
+  return writeEntry(*this->dataPtr, key, writer.buffer);
+}
+
+/////////////////////////////////////////////////
+std::string MeshCache::Path() const
+{
+  return this->dataPtr->path;
+}
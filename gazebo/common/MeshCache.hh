@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MESHCACHE_HH_
+#define GAZEBO_COMMON_MESHCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class SignedDistanceField;
+
+    // Forward declare private data class
+    class MeshCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class MeshCache MeshCache.hh common/common.hh
+    /// \brief On-disk cache of loaded meshes.
+    ///
+    /// Each mesh file is stored in a binary file whose name is a hash of
+    /// the mesh file's path, modification time, size and the cache format
+    /// version, so the entry of a mesh file that changed is never used.
+    /// Entries are written atomically and read through a memory mapping,
+    /// which lets several processes, such as gzserver and gzclient, share
+    /// the same cache directory. The reduced levels of detail of a mesh
+    /// are stored along with it. Meshes with a skeleton aren't cached.
+    /// Generated meshes and signed distance fields are stored under a key
+    /// of the content they were made from.
+    class GZ_COMMON_VISIBLE MeshCache
+    {
+      /// \brief Version of the cache format. Increment it when the format
+      /// changes or when a mesh loader produces different meshes.
+      public: static const uint32_t kVersion = 3;
+
+      /// \brief Constructor
+      /// \param[in] _path Directory that holds the cache entries. It is
+      /// created when the first entry is saved.
+      public: explicit MeshCache(const std::string &_path);
+
+      /// \brief Destructor
+      public: virtual ~MeshCache();
+
+      /// \brief Load a mesh from the cache.
+      /// \param[in] _filename Full path of the mesh file.
+      /// \return A new mesh, which the caller owns, or nullptr if the
+      /// cache doesn't hold an up to date entry for the file.
+      public: Mesh *Load(const std::string &_filename) const;
+
+      /// \brief Save a mesh to the cache.
+      /// \param[in] _filename Full path of the mesh file the mesh was
+      /// loaded from.
+      /// \param[in] _mesh The loaded mesh.
+      /// \return True if the entry was written.
+      public: bool Save(const std::string &_filename,
+                        const Mesh *_mesh) const;
+
+      /// \brief Load a generated mesh from the cache.
+      /// \param[in] _key Key of the content the mesh was generated from,
+      /// such as a hash of the polylines of an extruded mesh.
+      /// \return The mesh, null if it isn't in the cache. The caller owns
+      /// it.
+      public: Mesh *LoadGenerated(const std::string &_key) const;
+
+      /// \brief Save a generated mesh to the cache.
+      /// \param[in] _key Key of the content the mesh was generated from.
+      /// \param[in] _mesh The mesh.
+      /// \return True if the mesh was saved.
+      public: bool SaveGenerated(const std::string &_key,
+                  const Mesh *_mesh) const;
+
+      /// \brief Load a signed distance field from the cache.
+      /// \param[in] _key Key of the content the field was built from.
+      /// \param[out] _field The field.
+      /// \return False if the field isn't in the cache.
+      public: bool LoadField(const std::string &_key,
+                  SignedDistanceField &_field) const;
+
+      /// \brief Save a signed distance field to the cache.
+      /// \param[in] _key Key of the content the field was built from.
+      /// \param[in] _field The field.
+      /// \return True if the field was saved.
+      public: bool SaveField(const std::string &_key,
+                  const SignedDistanceField &_field) const;
+
+      /// \brief Get the cache directory.
+      /// \return Directory that holds the cache entries.
+      public: std::string Path() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<MeshCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
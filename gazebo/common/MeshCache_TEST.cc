@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/ColladaLoader.hh"
+#include "gazebo/common/Material.hh"
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/SignedDistanceField.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MeshCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create a wavy square grid of triangles.
+/// \param[in] _size Number of quads along each side.
+/// \return The mesh, which the caller owns.
+common::Mesh *gridMesh(const unsigned int _size)
+{
+  common::SubMesh *subMesh = new common::SubMesh();
+  for (unsigned int y = 0; y <= _size; ++y)
+  {
+    for (unsigned int x = 0; x <= _size; ++x)
+    {
+      subMesh->AddVertex(x, y, 0.1 * std::sin(x * 0.3) * std::cos(y * 0.2));
+      subMesh->AddNormal(0, 0, 1);
+    }
+  }
+  for (unsigned int y = 0; y < _size; ++y)
+  {
+    for (unsigned int x = 0; x < _size; ++x)
+    {
+      const unsigned int i = y * (_size + 1) + x;
+      subMesh->AddIndex(i);
+      subMesh->AddIndex(i + 1);
+      subMesh->AddIndex(i + _size + 2);
+      subMesh->AddIndex(i);
+      subMesh->AddIndex(i + _size + 2);
+      subMesh->AddIndex(i + _size + 1);
+    }
+  }
+
+  common::Mesh *mesh = new common::Mesh();
+  mesh->AddSubMesh(subMesh);
+  return mesh;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, SaveLoad)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+
+  // Work on a copy, so that its modification time can be changed.
+  std::string meshFile = (dir / "box.dae").string();
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae", meshFile);
+
+  common::ColladaLoader loader;
+  std::unique_ptr<common::Mesh> mesh(loader.Load(meshFile));
+  ASSERT_NE(nullptr, mesh);
+
+  common::MeshCache cache((dir / "cache").string());
+  EXPECT_EQ((dir / "cache").string(), cache.Path());
+
+  // Nothing cached yet
+  EXPECT_EQ(nullptr, cache.Load(meshFile));
+  EXPECT_FALSE(cache.Save(meshFile, nullptr));
+
+  EXPECT_TRUE(cache.Save(meshFile, mesh.get()));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(meshFile));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(mesh->GetPath(), cached->GetPath());
+  EXPECT_EQ(mesh->Max(), cached->Max());
+  EXPECT_EQ(mesh->Min(), cached->Min());
+  EXPECT_EQ(mesh->GetVertexCount(), cached->GetVertexCount());
+  EXPECT_EQ(mesh->GetNormalCount(), cached->GetNormalCount());
+  EXPECT_EQ(mesh->GetIndexCount(), cached->GetIndexCount());
+  EXPECT_EQ(mesh->GetTexCoordCount(), cached->GetTexCoordCount());
+  ASSERT_EQ(mesh->GetSubMeshCount(), cached->GetSubMeshCount());
+  ASSERT_EQ(mesh->GetMaterialCount(), cached->GetMaterialCount());
+
+  for (unsigned int i = 0; i < mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *a = mesh->GetSubMesh(i);
+    const common::SubMesh *b = cached->GetSubMesh(i);
+    EXPECT_EQ(a->GetName(), b->GetName());
+    EXPECT_EQ(a->GetPrimitiveType(), b->GetPrimitiveType());
+    EXPECT_EQ(a->GetMaterialIndex(), b->GetMaterialIndex());
+    for (unsigned int j = 0; j < a->GetVertexCount(); ++j)
+      EXPECT_EQ(a->Vertex(j), b->Vertex(j));
+    for (unsigned int j = 0; j < a->GetNormalCount(); ++j)
+      EXPECT_EQ(a->Normal(j), b->Normal(j));
+    for (unsigned int j = 0; j < a->GetIndexCount(); ++j)
+      EXPECT_EQ(a->GetIndex(j), b->GetIndex(j));
+  }
+
+  for (unsigned int i = 0; i < mesh->GetMaterialCount(); ++i)
+  {
+    const common::Material *a = mesh->GetMaterial(i);
+    const common::Material *b = cached->GetMaterial(i);
+    EXPECT_EQ(a->GetTextureImage(), b->GetTextureImage());
+    EXPECT_EQ(a->Ambient(), b->Ambient());
+    EXPECT_EQ(a->Diffuse(), b->Diffuse());
+    EXPECT_EQ(a->Specular(), b->Specular());
+    EXPECT_EQ(a->Emissive(), b->Emissive());
+    EXPECT_DOUBLE_EQ(a->GetTransparency(), b->GetTransparency());
+    EXPECT_DOUBLE_EQ(a->GetShininess(), b->GetShininess());
+    EXPECT_EQ(a->GetBlendMode(), b->GetBlendMode());
+    EXPECT_EQ(a->GetShadeMode(), b->GetShadeMode());
+    EXPECT_EQ(a->GetLighting(), b->GetLighting());
+  }
+
+  // A modified mesh file doesn't use the stale entry
+  boost::filesystem::last_write_time(meshFile,
+      boost::filesystem::last_write_time(meshFile) + 10);
+  EXPECT_EQ(nullptr, cache.Load(meshFile));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Lod)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+
+  // Any file identifies the entry
+  std::string meshFile = (dir / "grid.dae").string();
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae", meshFile);
+
+  std::unique_ptr<common::Mesh> mesh(gridMesh(100));
+  ASSERT_GT(mesh->GenerateLod(), 0u);
+
+  common::MeshCache cache((dir / "cache").string());
+  EXPECT_TRUE(cache.Save(meshFile, mesh.get()));
+
+  std::unique_ptr<common::Mesh> cached(cache.Load(meshFile));
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ(mesh->LodErrors(), cached->LodErrors());
+
+  const common::SubMesh *a = mesh->GetSubMesh(0);
+  const common::SubMesh *b = cached->GetSubMesh(0);
+  ASSERT_EQ(a->LodLevelCount(), b->LodLevelCount());
+  for (unsigned int i = 0; i < a->LodLevelCount(); ++i)
+    EXPECT_EQ(a->LodIndices(i), b->LodIndices(i));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshCache, Field)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_mesh_cache_%%%%-%%%%");
+
+  std::unique_ptr<common::Mesh> mesh(gridMesh(8));
+  common::SignedDistanceField field;
+  ASSERT_TRUE(field.Build(*mesh, ignition::math::Vector3d::One, 0.5));
+
+  common::MeshCache cache((dir / "cache").string());
+  common::SignedDistanceField cached;
+  EXPECT_FALSE(cache.LoadField("grid_field", cached));
+  EXPECT_FALSE(cache.SaveField("grid_field", cached));
+  EXPECT_TRUE(cache.SaveField("grid_field", field));
+
+  ASSERT_TRUE(cache.LoadField("grid_field", cached));
+  EXPECT_EQ(field.Origin(), cached.Origin());
+  EXPECT_DOUBLE_EQ(field.Resolution(), cached.Resolution());
+  EXPECT_EQ(field.Size(), cached.Size());
+  EXPECT_EQ(field.Values(), cached.Values());
+
+  // Fields and generated meshes don't share entries
+  EXPECT_EQ(nullptr, cache.LoadGenerated("grid_field"));
+
+  boost::filesystem::remove_all(dir);
+}
@@ -16,17 +16,33 @@
  */
 
 #include <sys/stat.h>
+#include <tbb/task_group.h>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <map>
+#include <memory>
+#include <set>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccounts.hh"
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshCache.hh"
+#include "gazebo/common/SignedDistanceField.hh"
 #include "gazebo/common/ColladaLoader.hh"
 #include "gazebo/common/ColladaExporter.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/common/STLLoader.hh"
 #include "gazebo/common/OBJLoader.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/gazebo_config.h"
 
 #ifdef HAVE_GTS
@@ -65,12 +81,200 @@ class MeshManagerPrivate
   /// \brief Mutex to protect from loading the same mesh in different threads
   /// at the same time.
   public: boost::mutex mutex;
+
+  /// \brief On-disk cache of loaded meshes, null if disabled.
+  public: MeshCache *cache = nullptr;
+
+  /// \brief Names of the meshes being loaded by some thread.
+  public: std::set<std::string> loading;
+
+  /// \brief Signaled when a thread finishes loading a mesh.
+  public: boost::condition_variable loadingCondition;
+
+  /// \brief Number of triangles from which loaded meshes get reduced
+  /// levels of detail, 0 to disable.
+  public: std::atomic<unsigned int> lodTriangleThreshold{20000};
+
+  /// \brief Memory of the loaded and added meshes.
+  public: MemoryAccount *memory = nullptr;
+
+  /// \brief Start generating a mesh. Waits for the thread generating the
+  /// same mesh, if any.
+  /// \param[in] _name Name of the mesh.
+  /// \return False if the mesh exists and must not be generated.
+  public: bool BeginGenerate(const std::string &_name);
+
+  /// \brief Get a copy of a mesh generated from the same content, from
+  /// memory or from the mesh cache.
+  /// \param[in] _key Key of the content.
+  /// \return The copy, null if the content wasn't generated yet.
+  public: Mesh *Generated(const std::string &_key);
+
+  /// \brief Finish generating a mesh, and wake up the waiting threads.
+  /// \param[in] _name Name of the mesh.
+  /// \param[in] _key Key of the content of the mesh.
+  /// \param[in] _mesh The mesh, null if it couldn't be generated.
+  public: void EndGenerate(const std::string &_name, const std::string &_key,
+              Mesh *_mesh);
+
+  /// \brief Name of a generated mesh, by key of its content.
+  public: std::map<std::string, std::string> generatedNames;
+
+  /// \brief Meshes created on worker threads.
+  public: tbb::task_group tasks;
+
+  /// \brief Signed distance fields, by key of their content.
+  public: std::map<std::string, std::unique_ptr<SignedDistanceField>> fields;
+};
+
+//////////////////////////////////////////////////
+/// \brief FNV-1a hash of the content a mesh is generated from.
+class ContentHash
+{
+  /// \brief Add bytes to the hash.
+  /// \param[in] _data The bytes.
+  /// \param[in] _size Number of bytes.
+  public: void Add(const void *_data, const std::size_t _size)
+  {
+    const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+    for (std::size_t i = 0; i < _size; ++i)
+    {
+      this->hash ^= bytes[i];
+      this->hash *= 1099511628211ull;
+    }
+  }
+
+  /// \brief Add a value to the hash.
+  /// \param[in] _value The value.
+  public: template<typename T> void Add(const T _value)
+  {
+    this->Add(&_value, sizeof(_value));
+  }
+
+  /// \brief Add a string to the hash.
+  /// \param[in] _value The string.
+  public: void Add(const char *_value)
+  {
+    this->Add(_value, std::strlen(_value));
+  }
+
+  /// \brief Add the vertices and indices of a mesh to the hash.
+  /// \param[in] _mesh The mesh.
+  public: void Add(const Mesh &_mesh)
+  {
+    this->Add(_mesh.GetSubMeshCount());
+    for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+    {
+      const SubMesh *subMesh = _mesh.GetSubMesh(i);
+      this->Add(subMesh->GetVertexCount());
+      for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      {
+        const ignition::math::Vector3d &v = subMesh->Vertex(j);
+        this->Add(v.X());
+        this->Add(v.Y());
+        this->Add(v.Z());
+      }
+      this->Add(subMesh->GetIndexCount());
+      for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+        this->Add(subMesh->GetIndex(j));
+    }
+  }
+
+  /// \brief Get the key of the content.
+  /// \return Hexadecimal hash.
+  public: std::string Key() const
+  {
+    std::ostringstream stream;
+    stream << std::hex << std::setw(16) << std::setfill('0') << this->hash;
+    return stream.str();
+  }
+
+  /// \brief Current hash.
+  private: uint64_t hash = 14695981039346656037ull;
 };
 
 // added here for ABI compatibility
 // TODO move to header / private class when merging forward.
 static OBJLoader objLoader;
 
+//////////////////////////////////////////////////
+/// \brief Estimate the memory of the vertex data of a mesh.
+/// \param[in] _mesh The mesh.
+/// \return Bytes of the vertices, normals, texture coordinates and indices.
+static int64_t meshBytes(const Mesh &_mesh)
+{
+  int64_t bytes = 0;
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    bytes += subMesh->GetVertexCount() * sizeof(ignition::math::Vector3d) +
+        subMesh->GetNormalCount() * sizeof(ignition::math::Vector3d) +
+        subMesh->GetTexCoordCount() * sizeof(ignition::math::Vector2d) +
+        subMesh->GetIndexCount() * sizeof(unsigned int);
+  }
+  return bytes;
+}
+
+//////////////////////////////////////////////////
+bool MeshManagerPrivate::BeginGenerate(const std::string &_name)
+{
+#ifdef HAVE_GTS
+  GTSMeshUtils::InitClasses();
+#endif
+
+  boost::mutex::scoped_lock lock(this->mutex);
+  while (this->loading.count(_name) > 0)
+    this->loadingCondition.wait(lock);
+
+  if (_name.empty() || this->meshes.count(_name) > 0)
+    return false;
+
+  this->loading.insert(_name);
+  return true;
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshManagerPrivate::Generated(const std::string &_key)
+{
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    auto name = this->generatedNames.find(_key);
+    if (name != this->generatedNames.end())
+    {
+      auto iter = this->meshes.find(name->second);
+      if (iter != this->meshes.end())
+      {
+        Mesh *mesh = new Mesh();
+        for (unsigned int i = 0; i < iter->second->GetSubMeshCount(); ++i)
+          mesh->AddSubMesh(new SubMesh(iter->second->GetSubMesh(i)));
+        return mesh;
+      }
+    }
+  }
+
+  if (this->cache)
+    return this->cache->LoadGenerated(_key);
+  return nullptr;
+}
+
+//////////////////////////////////////////////////
+void MeshManagerPrivate::EndGenerate(const std::string &_name,
+    const std::string &_key, Mesh *_mesh)
+{
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    if (_mesh != nullptr)
+    {
+      _mesh->SetName(_name);
+      this->meshes.insert(std::make_pair(_name, _mesh));
+      this->memory->Add(meshBytes(*_mesh));
+      this->generatedNames[_key] = _name;
+    }
+    this->loading.erase(_name);
+  }
+  this->loadingCondition.notify_all();
+}
+
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
   : dataPtr(new MeshManagerPrivate)
@@ -78,6 +282,21 @@ MeshManager::MeshManager()
   this->dataPtr->colladaLoader = new ColladaLoader();
   this->dataPtr->colladaExporter = new ColladaExporter();
   this->dataPtr->stlLoader = new STLLoader();
+  this->dataPtr->memory =
+      &MemoryAccounts::Instance()->Account("common/meshes");
+
+  // Cache loaded meshes on disk unless GAZEBO_MESH_CACHE=0
+  const char *cacheEnv = getenv("GAZEBO_MESH_CACHE");
+  if (!cacheEnv || std::string(cacheEnv) != "0")
+  {
+    this->dataPtr->cache = new MeshCache(
+        SystemPaths::Instance()->GetLogPath() + "/mesh_cache");
+  }
+
+  // Generate levels of detail of large meshes unless GAZEBO_MESH_LOD=0
+  const char *lodEnv = getenv("GAZEBO_MESH_LOD");
+  if (lodEnv && std::string(lodEnv) == "0")
+    this->dataPtr->lodTriangleThreshold = 0;
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -116,9 +335,11 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
+  this->dataPtr->tasks.wait();
   delete this->dataPtr->colladaLoader;
   delete this->dataPtr->colladaExporter;
   delete this->dataPtr->stlLoader;
+  delete this->dataPtr->cache;
   for (auto &pairNameMesh : this->dataPtr->meshes)
   {
     delete pairNameMesh.second;
@@ -142,6 +363,7 @@ const Mesh *MeshManager::Load(const std::string &_filename)
 
   std::string extension;
 
+  boost::mutex::scoped_lock hasLock(this->dataPtr->mutex);
   if (this->HasMesh(_filename))
   {
     return this->dataPtr->meshes[_filename];
@@ -158,7 +380,9 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     this->dataPtr->meshes.erase(iter);
     */
   }
+  hasLock.unlock();
 
+  StartupScope startupScope("MeshManager::Load", _filename);
   std::string fullname = common::find_file(_filename);
 
   if (!fullname.empty())
@@ -166,12 +390,20 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
     std::transform(extension.begin(), extension.end(),
         extension.begin(), ::tolower);
+
+    // The STL and OBJ loaders are stateless, but the Collada loader isn't,
+    // so each load gets its own Collada loader. That lets different meshes
+    // load in parallel.
+    std::unique_ptr<ColladaLoader> colladaLoader;
     MeshLoader *loader = nullptr;
 
     if (extension == "stl" || extension == "stlb" || extension == "stla")
       loader = this->dataPtr->stlLoader;
     else if (extension == "dae")
-      loader = this->dataPtr->colladaLoader;
+    {
+      colladaLoader.reset(new ColladaLoader());
+      loader = colladaLoader.get();
+    }
     else if (extension == "obj")
       loader = &objLoader;
     else
@@ -180,32 +412,65 @@ const Mesh *MeshManager::Load(const std::string &_filename)
       return nullptr;
     }
 
-    try
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
+      // Only one thread loads a given mesh. Others wait for it to finish.
       boost::mutex::scoped_lock lock(this->dataPtr->mutex);
-      if (!this->HasMesh(_filename))
+      while (this->dataPtr->loading.count(_filename) > 0)
+        this->dataPtr->loadingCondition.wait(lock);
+
+      if (this->HasMesh(_filename))
+        return this->dataPtr->meshes[_filename];
+
+      this->dataPtr->loading.insert(_filename);
+    }
+
+    try
+    {
+      if (this->dataPtr->cache)
+        mesh = this->dataPtr->cache->Load(fullname);
+
+      const unsigned int lodThreshold = this->dataPtr->lodTriangleThreshold;
+      if (mesh == nullptr && (mesh = loader->Load(fullname)) != nullptr)
       {
-        if ((mesh = loader->Load(fullname)) != nullptr)
-        {
-          mesh->SetName(_filename);
-          this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
+        // The levels are saved with the mesh, so they are only generated
+        // the first time a mesh file is loaded
+        if (lodThreshold > 0 && mesh->GetIndexCount() / 3 >= lodThreshold)
+          mesh->GenerateLod();
+
+        if (this->dataPtr->cache)
+          this->dataPtr->cache->Save(fullname, mesh);
       }
-      else
+      else if (mesh != nullptr && lodThreshold == 0)
       {
-        mesh = this->dataPtr->meshes[_filename];
+        mesh->ClearLod();
       }
     }
     catch(gazebo::common::Exception &e)
     {
+      {
+        boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+        this->dataPtr->loading.erase(_filename);
+      }
+      this->dataPtr->loadingCondition.notify_all();
+
       gzerr << "Error loading mesh[" << fullname << "]\n";
       gzerr << e << "\n";
       gzthrow(e);
     }
+
+    {
+      boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+      if (mesh != nullptr)
+      {
+        mesh->SetName(_filename);
+        this->dataPtr->meshes.insert(std::make_pair(_filename, mesh));
+        this->dataPtr->memory->Add(meshBytes(*mesh));
+      }
+      else
+        gzerr << "Unable to load mesh[" << fullname << "]\n";
+      this->dataPtr->loading.erase(_filename);
+    }
+    this->dataPtr->loadingCondition.notify_all();
   }
   else
     gzerr << "Unable to find file[" << _filename << "]\n";
@@ -213,6 +478,18 @@ const Mesh *MeshManager::Load(const std::string &_filename)
   return mesh;
 }
 
+//////////////////////////////////////////////////
+void MeshManager::SetLodTriangleThreshold(const unsigned int _count)
+{
+  this->dataPtr->lodTriangleThreshold = _count;
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshManager::LodTriangleThreshold() const
+{
+  return this->dataPtr->lodTriangleThreshold;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::Export(const Mesh *_mesh, const std::string &_filename,
     const std::string &_extension, bool _exportTextures)
@@ -265,7 +542,10 @@ void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
 void MeshManager::AddMesh(Mesh *_mesh)
 {
   if (!this->HasMesh(_mesh->GetName()))
+  {
     this->dataPtr->meshes[_mesh->GetName()] = _mesh;
+    this->dataPtr->memory->Add(meshBytes(*_mesh));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -576,21 +856,68 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  if (this->HasMesh(_name))
-  {
+  if (!this->dataPtr->BeginGenerate(_name))
     return;
+
+  ContentHash hash;
+  hash.Add("polyline");
+  hash.Add(_height);
+  for (auto const &poly : polys)
+  {
+    hash.Add(poly.size());
+    for (auto const &point : poly)
+    {
+      hash.Add(point.X());
+      hash.Add(point.Y());
+    }
   }
+  const std::string key = hash.Key();
+
+  Mesh *mesh = this->dataPtr->Generated(key);
+  if (mesh == nullptr)
+  {
+    mesh = MeshManager::ExtrudePolylines(polys, _height, tol);
+    if (mesh != nullptr && this->dataPtr->cache)
+      this->dataPtr->cache->SaveGenerated(key, mesh);
+  }
+
+  this->dataPtr->EndGenerate(_name, key, mesh);
+}
+
+//////////////////////////////////////////////////
+void MeshManager::CreateExtrudedPolylineAsync(const std::string &_name,
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    double _height)
+{
+  if (this->HasMesh(_name))
+    return;
+
+  this->dataPtr->tasks.run([this, _name, _polys, _height]()
+      {
+        this->CreateExtrudedPolyline(_name, _polys, _height);
+      });
+}
 
+//////////////////////////////////////////////////
+void MeshManager::WaitForAsync()
+{
+  this->dataPtr->tasks.wait();
+}
+
+//////////////////////////////////////////////////
+Mesh *MeshManager::ExtrudePolylines(
+    const std::vector<std::vector<ignition::math::Vector2d> > &_polys,
+    double _height, double _tol)
+{
   Mesh *mesh = new Mesh();
-  mesh->SetName(_name);
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
   std::vector<ignition::math::Vector2d> vertices;
   std::vector<ignition::math::Vector2i> edges;
-  MeshManager::ConvertPolylinesToVerticesAndEdges(polys,
-                                                  tol,
+  MeshManager::ConvertPolylinesToVerticesAndEdges(_polys,
+                                                  _tol,
                                                   vertices,
                                                   edges);
   #if HAVE_GTS
@@ -598,7 +925,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   {
     gzerr << "Unable to triangulate polyline." << std::endl;
     delete mesh;
-    return;
+    return nullptr;
   }
   #endif
 
@@ -688,7 +1015,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   {
     gzerr << "Unable to extrude mesh. Triangulation failed" << std::endl;
     delete mesh;
-    return;
+    return nullptr;
   }
 
   unsigned int numVertices = subMesh->GetVertexCount();
@@ -759,8 +1086,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
     }
   }
 
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
-  return;
+  return mesh;
 }
 
 //////////////////////////////////////////////////
@@ -1325,16 +1651,102 @@ void MeshManager::Tesselate2DMesh(SubMesh *sm, int meshWidth, int meshHeight,
 void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
     const Mesh *_m2, int _operation, const ignition::math::Pose3d &_offset)
 {
-  if (this->HasMesh(_name))
+  if (!this->dataPtr->BeginGenerate(_name))
     return;
 
-  MeshCSG csg;
-  Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
-  mesh->SetName(_name);
-  this->dataPtr->meshes.insert(std::make_pair(_name, mesh));
+  ContentHash hash;
+  hash.Add("boolean");
+  hash.Add(*_m1);
+  hash.Add(*_m2);
+  hash.Add(_operation);
+  hash.Add(_offset.Pos().X());
+  hash.Add(_offset.Pos().Y());
+  hash.Add(_offset.Pos().Z());
+  hash.Add(_offset.Rot().W());
+  hash.Add(_offset.Rot().X());
+  hash.Add(_offset.Rot().Y());
+  hash.Add(_offset.Rot().Z());
+  const std::string key = hash.Key();
+
+  Mesh *mesh = this->dataPtr->Generated(key);
+  if (mesh == nullptr)
+  {
+    MeshCSG csg;
+    mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
+    if (mesh != nullptr && this->dataPtr->cache)
+      this->dataPtr->cache->SaveGenerated(key, mesh);
+  }
+
+  this->dataPtr->EndGenerate(_name, key, mesh);
 }
 #endif
 
+//////////////////////////////////////////////////
+void MeshManager::CreateConvexDecomposition(const std::string &_name,
+    const Mesh *_mesh, const ConvexDecomposition::Options &_options)
+{
+  if (!this->dataPtr->BeginGenerate(_name))
+    return;
+
+  ContentHash hash;
+  hash.Add("convex_decomposition");
+  hash.Add(*_mesh);
+  hash.Add(_options.maxHulls);
+  hash.Add(_options.maxConcavity);
+  hash.Add(_options.maxVertices);
+  const std::string key = hash.Key();
+
+  Mesh *mesh = this->dataPtr->Generated(key);
+  if (mesh == nullptr)
+  {
+    mesh = ConvexDecomposition::Decompose(*_mesh, _options);
+    if (mesh != nullptr && this->dataPtr->cache)
+      this->dataPtr->cache->SaveGenerated(key, mesh);
+  }
+
+  this->dataPtr->EndGenerate(_name, key, mesh);
+}
+
+//////////////////////////////////////////////////
+const SignedDistanceField *MeshManager::DistanceField(const Mesh *_mesh,
+    const ignition::math::Vector3d &_scale, const double _resolution)
+{
+  if (!_mesh)
+    return nullptr;
+
+  ContentHash hash;
+  hash.Add("signed_distance_field");
+  hash.Add(*_mesh);
+  hash.Add(_scale.X());
+  hash.Add(_scale.Y());
+  hash.Add(_scale.Z());
+  hash.Add(_resolution);
+  const std::string key = hash.Key();
+
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->fields.find(key);
+    if (iter != this->dataPtr->fields.end())
+      return iter->second.get();
+  }
+
+  // Build outside of the lock, as it may take a while. A field built at
+  // the same time by another thread is dropped.
+  std::unique_ptr<SignedDistanceField> field(new SignedDistanceField());
+  if (!this->dataPtr->cache || !this->dataPtr->cache->LoadField(key, *field))
+  {
+    if (!field->Build(*_mesh, _scale, _resolution))
+      return nullptr;
+    if (this->dataPtr->cache)
+      this->dataPtr->cache->SaveField(key, *field);
+  }
+
+  boost::mutex::scoped_lock lock(this->dataPtr->mutex);
+  auto inserted = this->dataPtr->fields.insert(
+      std::make_pair(key, std::move(field)));
+  return inserted.first->second.get();
+}
+
 //////////////////////////////////////////////////
 size_t MeshManager::AddUniquePointToVerticesTable(
                      std::vector<ignition::math::Vector2d> &_vertices,
@@ -28,6 +28,7 @@
 
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/ConvexDecomposition.hh"
 #include "gazebo/util/system.hh"
 
 /// \brief Explicit instantiation for typed SingletonT.
@@ -41,6 +42,7 @@ namespace gazebo
     class MeshManagerPrivate;
     class Mesh;
     class SubMesh;
+    class SignedDistanceField;
 
     /// \addtogroup gazebo_common Common
     /// \{
@@ -57,11 +59,29 @@ namespace gazebo
       /// Destroys the collada loader, the stl loader and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. Meshes are cached on disk in the
+      /// mesh_cache directory of the log path. Set the GAZEBO_MESH_CACHE
+      /// environment variable to 0 to disable the cache.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
+      /// \sa MeshCache
       public: const Mesh *Load(const std::string &_filename);
 
+      /// \brief Set the number of triangles from which meshes loaded from
+      /// files get reduced levels of detail, which the rendering engine
+      /// draws for the cameras that see them from far away. The levels are
+      /// stored in the mesh cache entry. Defaults to 20000, or 0 if the
+      /// GAZEBO_MESH_LOD environment variable is set to 0.
+      /// \param[in] _count Number of triangles, 0 to disable levels of
+      /// detail.
+      /// \sa Mesh::GenerateLod()
+      public: void SetLodTriangleThreshold(const unsigned int _count);
+
+      /// \brief Get the number of triangles from which loaded meshes get
+      /// reduced levels of detail.
+      /// \return Number of triangles, 0 if levels of detail are disabled.
+      public: unsigned int LodTriangleThreshold() const;
+
       /// \brief Export a mesh to a file
       /// \param[in] _mesh Pointer to the mesh to be exported
       /// \param[in] _filename Exported file's path and name
@@ -135,10 +155,29 @@ namespace gazebo
       /// vertices that describe one polyline.
       /// edges and remove the holes in the shape.
       /// \param[in] _height the height of extrusion
+      ///
+      /// The mesh is generated once per content: polylines and height
+      /// already extruded under another name, or found in the mesh cache,
+      /// are copied instead of triangulated again. This can be called from
+      /// several threads.
       public: void CreateExtrudedPolyline(const std::string &_name,
                   const std::vector<std::vector<ignition::math::Vector2d> >
                   &_vertices, double _height);
 
+      /// \brief Create an extruded mesh from polylines on a worker thread.
+      /// A later call to CreateExtrudedPolyline or Load with the same name
+      /// waits for it, and HasMesh is true once it is done.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _vertices The polylines.
+      /// \param[in] _height the height of extrusion
+      /// \sa CreateExtrudedPolyline
+      public: void CreateExtrudedPolylineAsync(const std::string &_name,
+                  const std::vector<std::vector<ignition::math::Vector2d> >
+                  &_vertices, double _height);
+
+      /// \brief Wait for the meshes created on worker threads.
+      public: void WaitForAsync();
+
       /// \brief Create a cylinder mesh
       /// \param[in] _name the name of the new mesh
       /// \param[in] _radius the radius of the cylinder in the x y plane
@@ -230,11 +269,37 @@ namespace gazebo
       /// \param[in] _m2 the child mesh in the boolean operation
       /// \param[in] _operation the boolean operation applied to the two meshes
       /// \param[in] _offset _m2's pose offset from _m1
+      ///
+      /// Like extruded meshes, boolean meshes are generated once per
+      /// content and can be created from several threads.
       public: void CreateBoolean(const std::string &_name, const Mesh *_m1,
           const Mesh *_m2, const int _operation,
           const ignition::math::Pose3d &_offset = ignition::math::Pose3d::Zero);
 #endif
 
+      /// \brief Create the convex decomposition of a mesh, a mesh with one
+      /// submesh per convex hull.
+      /// \param[in] _name the name of the new mesh
+      /// \param[in] _mesh the mesh to decompose
+      /// \param[in] _options parameters of the decomposition
+      ///
+      /// Decompositions are generated once per content, and saved in the
+      /// mesh cache. No mesh is added if the decomposition fails.
+      public: void CreateConvexDecomposition(const std::string &_name,
+          const Mesh *_mesh, const ConvexDecomposition::Options &_options =
+          ConvexDecomposition::Options());
+
+      /// \brief Get the signed distance field of a mesh, built on first use
+      /// or loaded from the mesh cache.
+      /// \param[in] _mesh The mesh.
+      /// \param[in] _scale Scale applied to the vertices of the mesh.
+      /// \param[in] _resolution Size of a cell, 0 for a default.
+      /// \return The field, owned by the manager and shared by the meshes
+      /// of the same content, or null if the mesh has no triangles.
+      /// \sa SignedDistanceField::Build
+      public: const SignedDistanceField *DistanceField(const Mesh *_mesh,
+          const ignition::math::Vector3d &_scale, const double _resolution);
+
       /// \brief Converts a vector of polylines into a table of vertices and
       /// a list of edges (each made of 2 points from the table of vertices.
       /// \param[in] _polys the polylines
@@ -249,6 +314,15 @@ namespace gazebo
                    std::vector<ignition::math::Vector2d> &_vertices,
                    std::vector<ignition::math::Vector2i> &_edges);
 
+      /// \brief Extrude closed polylines.
+      /// \param[in] _polys The closed polylines.
+      /// \param[in] _height the height of extrusion
+      /// \param[in] _tol tolerence for 2 vertices to be considered the same
+      /// \return The mesh, null if the triangulation failed.
+      private: static Mesh *ExtrudePolylines(
+                   const std::vector<std::vector<ignition::math::Vector2d> >
+                   &_polys, double _height, double _tol);
+
       /// \brief Check a point againts a list, and only adds it to the list
       /// if it is not there already.
       /// \param[in] _vertices the vertex table where points are stored
@@ -16,10 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/SignedDistanceField.hh"
 #include "gazebo/gazebo_config.h"
 #include "test/util.hh"
 
@@ -243,6 +247,49 @@ TEST_F(MeshManager, CreateExtrudedPolylineClosedPath)
     }
   }
 }
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateExtrudedPolylineAsync)
+{
+  std::vector<std::vector<ignition::math::Vector2d> > path;
+  std::vector<ignition::math::Vector2d> subpath;
+  subpath.push_back(ignition::math::Vector2d(0, 0));
+  subpath.push_back(ignition::math::Vector2d(2, 0));
+  subpath.push_back(ignition::math::Vector2d(2, 1));
+  subpath.push_back(ignition::math::Vector2d(0, 1));
+  path.push_back(subpath);
+
+  // The same polylines under several names, from worker threads
+  common::MeshManager *manager = common::MeshManager::Instance();
+  for (int i = 0; i < 8; ++i)
+  {
+    manager->CreateExtrudedPolylineAsync(
+        "async_path_" + std::to_string(i), path, 3.0);
+  }
+
+  // Waits for the worker that generates it
+  manager->CreateExtrudedPolyline("async_path_0", path, 3.0);
+  ASSERT_TRUE(manager->HasMesh("async_path_0"));
+
+  manager->WaitForAsync();
+  const common::Mesh *first = manager->GetMesh("async_path_0");
+  ASSERT_TRUE(first != nullptr);
+  for (int i = 1; i < 8; ++i)
+  {
+    const common::Mesh *mesh =
+        manager->GetMesh("async_path_" + std::to_string(i));
+    ASSERT_TRUE(mesh != nullptr);
+    EXPECT_NE(mesh, first);
+    EXPECT_EQ(mesh->GetName(), "async_path_" + std::to_string(i));
+    EXPECT_EQ(mesh->GetVertexCount(), first->GetVertexCount());
+    EXPECT_EQ(mesh->GetIndexCount(), first->GetIndexCount());
+  }
+
+  ignition::math::Vector3d center, min, max;
+  first->GetAABB(center, min, max);
+  EXPECT_EQ(min, ignition::math::Vector3d::Zero);
+  EXPECT_EQ(max, ignition::math::Vector3d(2, 1, 3));
+}
 #endif
 
 /////////////////////////////////////////////////
@@ -266,6 +313,102 @@ TEST_F(MeshManager, CreateExtrudedPolylineInvalid)
   EXPECT_TRUE(!common::MeshManager::Instance()->HasMesh(meshName));
 }
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, CreateConvexDecomposition)
+{
+  common::MeshManager *manager = common::MeshManager::Instance();
+  manager->CreateBox("convex_box", ignition::math::Vector3d(1, 2, 3),
+      ignition::math::Vector2d(1, 1));
+  const common::Mesh *box = manager->GetMesh("convex_box");
+  ASSERT_TRUE(box != nullptr);
+
+  manager->CreateConvexDecomposition("convex_box_hulls", box);
+  const common::Mesh *hulls = manager->GetMesh("convex_box_hulls");
+  ASSERT_TRUE(hulls != nullptr);
+  EXPECT_EQ(1u, hulls->GetSubMeshCount());
+
+  ignition::math::Vector3d center, min, max;
+  manager->GetMeshAABB(hulls, center, min, max);
+  EXPECT_EQ(box->Min(), min);
+  EXPECT_EQ(box->Max(), max);
+
+  // A second name for the same content reuses the decomposition
+  manager->CreateConvexDecomposition("convex_box_hulls_copy", box);
+  const common::Mesh *copy = manager->GetMesh("convex_box_hulls_copy");
+  ASSERT_TRUE(copy != nullptr);
+  EXPECT_NE(hulls, copy);
+  EXPECT_EQ(hulls->GetVertexCount(), copy->GetVertexCount());
+
+  // A flat mesh has no hulls
+  manager->CreatePlane("convex_plane", ignition::math::Vector3d::UnitZ,
+      0, ignition::math::Vector2d(1, 1), ignition::math::Vector2d(1, 1),
+      ignition::math::Vector2d(1, 1));
+  manager->CreateConvexDecomposition("convex_plane_hulls",
+      manager->GetMesh("convex_plane"));
+  EXPECT_FALSE(manager->HasMesh("convex_plane_hulls"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, DistanceField)
+{
+  common::MeshManager *manager = common::MeshManager::Instance();
+  manager->CreateBox("field_box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector2d(1, 1));
+  const common::Mesh *box = manager->GetMesh("field_box");
+  ASSERT_TRUE(box != nullptr);
+
+  const common::SignedDistanceField *field =
+      manager->DistanceField(box, ignition::math::Vector3d::One, 0.05);
+  ASSERT_TRUE(field != nullptr);
+  EXPECT_NEAR(-0.5, field->Distance(ignition::math::Vector3d::Zero), 1e-3);
+
+  // The same content shares the field, another scale doesn't
+  EXPECT_EQ(field,
+      manager->DistanceField(box, ignition::math::Vector3d::One, 0.05));
+  EXPECT_NE(field,
+      manager->DistanceField(box, ignition::math::Vector3d(2, 2, 2), 0.05));
+
+  EXPECT_TRUE(manager->DistanceField(nullptr,
+      ignition::math::Vector3d::One, 0.05) == nullptr);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, LoadConcurrent)
+{
+  const std::string box =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae";
+  const std::string offset =
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae";
+
+  // Several threads load the same two meshes at once
+  common::MeshManager *manager = common::MeshManager::Instance();
+  std::vector<const common::Mesh *> meshes(8, nullptr);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < meshes.size(); ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+    {
+      meshes[i] = manager->Load(i % 2 == 0 ? box : offset);
+    }));
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // Each mesh is loaded once, and is shared by all its requests
+  ASSERT_TRUE(meshes[0] != nullptr);
+  ASSERT_TRUE(meshes[1] != nullptr);
+  EXPECT_NE(meshes[0], meshes[1]);
+  for (size_t i = 2; i < meshes.size(); ++i)
+    EXPECT_EQ(meshes[i % 2], meshes[i]);
+
+  EXPECT_TRUE(manager->HasMesh(box));
+  EXPECT_TRUE(manager->HasMesh(offset));
+  EXPECT_EQ(box, meshes[0]->GetName());
+  EXPECT_EQ(offset, meshes[1]->GetName());
+  EXPECT_EQ(meshes[0], manager->Load(box));
+  EXPECT_EQ(24u, meshes[0]->GetVertexCount());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_MESH_PRIVATE_HH_
+#define GAZEBO_MESH_PRIVATE_HH_
+
+#include <vector>
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the Mesh class.
+    class MeshPrivate
+    {
+      /// \brief Geometric error of each reduced level of detail.
+      public: std::vector<double> lodErrors;
+    };
+
+    /// \internal
+    /// \brief Private data for the SubMesh class.
+    class SubMeshPrivate
+    {
+      /// \brief Indices of each reduced level of detail.
+      public: std::vector<std::vector<unsigned int>> lodIndices;
+    };
+  }
+}
+#endif
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
 #include <boost/filesystem.hpp>
 
 #include "test_config.h"
@@ -30,6 +33,40 @@ using namespace gazebo;
 
 class MeshTest : public gazebo::testing::AutoLogFixture { };
 
+/////////////////////////////////////////////////
+/// \brief Create a wavy square grid of triangles.
+/// \param[in] _size Number of quads along each side.
+/// \return The mesh, which the caller owns.
+common::Mesh *gridMesh(const unsigned int _size)
+{
+  common::SubMesh *subMesh = new common::SubMesh();
+  for (unsigned int y = 0; y <= _size; ++y)
+  {
+    for (unsigned int x = 0; x <= _size; ++x)
+    {
+      subMesh->AddVertex(x, y, 0.1 * std::sin(x * 0.3) * std::cos(y * 0.2));
+      subMesh->AddNormal(0, 0, 1);
+    }
+  }
+  for (unsigned int y = 0; y < _size; ++y)
+  {
+    for (unsigned int x = 0; x < _size; ++x)
+    {
+      const unsigned int i = y * (_size + 1) + x;
+      subMesh->AddIndex(i);
+      subMesh->AddIndex(i + 1);
+      subMesh->AddIndex(i + _size + 2);
+      subMesh->AddIndex(i);
+      subMesh->AddIndex(i + _size + 2);
+      subMesh->AddIndex(i + _size + 1);
+    }
+  }
+
+  common::Mesh *mesh = new common::Mesh();
+  mesh->AddSubMesh(subMesh);
+  return mesh;
+}
+
 std::string asciiSTLBox =
 "solid MYSOLID\n\
   facet normal  0.0   0.0  -1.0\n\
@@ -297,6 +334,55 @@ TEST_F(MeshTest, SubMeshCenter)
   EXPECT_EQ(ignition::math::Vector3d(3.46555, 0.180391, 2.8431), mesh->Min());
 }
 
+/////////////////////////////////////////////////
+// Test generating levels of detail
+TEST_F(MeshTest, GenerateLod)
+{
+  std::unique_ptr<common::Mesh> mesh(gridMesh(200));
+  const common::SubMesh *subMesh = mesh->GetSubMesh(0);
+  EXPECT_EQ(0u, subMesh->LodLevelCount());
+  EXPECT_TRUE(mesh->LodErrors().empty());
+
+  const unsigned int levels = mesh->GenerateLod(3);
+  EXPECT_GE(levels, 2u);
+  EXPECT_LE(levels, 3u);
+  ASSERT_EQ(levels, mesh->LodErrors().size());
+  ASSERT_EQ(levels, subMesh->LodLevelCount());
+  EXPECT_TRUE(subMesh->LodIndices(levels).empty());
+
+  // Each level has at most half the triangles of the previous one, and a
+  // larger error
+  unsigned int previous = subMesh->GetIndexCount();
+  for (unsigned int i = 0; i < levels; ++i)
+  {
+    const std::vector<unsigned int> &indices = subMesh->LodIndices(i);
+    EXPECT_EQ(0u, indices.size() % 3);
+    EXPECT_GT(indices.size(), 0u);
+    EXPECT_LE(indices.size() * 2, previous);
+    previous = indices.size();
+
+    if (i > 0)
+      EXPECT_GT(mesh->LodErrors()[i], mesh->LodErrors()[i - 1]);
+
+    for (auto const index : indices)
+      EXPECT_LT(index, subMesh->GetVertexCount());
+  }
+
+  // Full resolution data is untouched, and copies keep the levels
+  EXPECT_EQ(200u * 200u * 6u, subMesh->GetIndexCount());
+  common::SubMesh copy(subMesh);
+  EXPECT_EQ(levels, copy.LodLevelCount());
+  EXPECT_EQ(subMesh->LodIndices(0), copy.LodIndices(0));
+
+  mesh->ClearLod();
+  EXPECT_TRUE(mesh->LodErrors().empty());
+  EXPECT_EQ(0u, subMesh->LodLevelCount());
+
+  // Small meshes don't reduce
+  std::unique_ptr<common::Mesh> small(gridMesh(2));
+  EXPECT_EQ(0u, small->GenerateLod());
+}
+
 /////////////////////////////////////////////////
 // Test STL import
 TEST_F(MeshTest, STLRead)
@@ -22,7 +22,15 @@
 #include <curl/curl.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <list>
+#include <set>
+#include <thread>
+#include <vector>
 
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/bind.hpp>
@@ -34,6 +42,7 @@
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Console.hh"
@@ -65,10 +74,280 @@ size_t get_models_cb(void *_buffer, size_t _size, size_t _nmemb, void *_userp)
   return _size;
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the number of threads that download models.
+/// \return Value of GAZEBO_MODEL_DOWNLOAD_CONNECTIONS, 4 by default.
+static std::size_t downloadConnections()
+{
+  std::size_t connections = 4;
+  const char *env = getenv("GAZEBO_MODEL_DOWNLOAD_CONNECTIONS");
+  if (env)
+  {
+    try
+    {
+      connections = std::max(std::stoi(env), 1);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_MODEL_DOWNLOAD_CONNECTIONS[" << env
+             << "], using " << connections << "\n";
+    }
+  }
+  return connections;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a task for every index, on at most downloadConnections()
+/// threads.
+/// \param[in] _count Number of indices.
+/// \param[in] _task Task to run for an index.
+static void runPool(const std::size_t _count,
+    const std::function<void (const std::size_t)> &_task)
+{
+  const std::size_t threadCount = std::min(_count, downloadConnections());
+  if (threadCount <= 1)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+      _task(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&]()
+    {
+      for (std::size_t i = next++; i < _count; i = next++)
+        _task(i);
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the directory where downloaded models are installed.
+/// \return Path of the directory.
+static std::string installPath()
+{
+  const char *home = getenv("HOME");
+  return std::string(home ? home : "") + "/.gazebo/models";
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a model that is installed locally.
+/// \param[in] _modelName Name of the model.
+/// \return Path to the model, empty if it isn't installed.
+static std::string installedModel(const std::string &_modelName)
+{
+  std::list<std::string> paths = SystemPaths::Instance()->GetModelPaths();
+  paths.push_back(installPath());
+  for (const auto &dir : paths)
+  {
+    boost::filesystem::path path = boost::filesystem::path(dir) / _modelName;
+    boost::system::error_code ec;
+    if (boost::filesystem::exists(path / GZ_MODEL_MANIFEST_FILENAME, ec))
+      return path.string();
+  }
+  return std::string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the URIs of the dependencies listed in a model manifest.
+/// \param[in] _xmlDoc Model manifest.
+/// \param[in] _manifest Name of the manifest, for error messages.
+/// \return URIs of the dependencies.
+static std::vector<std::string> dependencyURIs(TiXmlDocument &_xmlDoc,
+    const std::string &_manifest)
+{
+  std::vector<std::string> uris;
+
+  TiXmlElement *modelXML = _xmlDoc.FirstChildElement("model");
+  if (!modelXML)
+  {
+    gzerr << "No <model> element in manifest file[" << _manifest << "]\n";
+    return uris;
+  }
+
+  TiXmlElement *dependXML = modelXML->FirstChildElement("depend");
+  if (!dependXML)
+    return uris;
+
+  for (TiXmlElement *depXML = dependXML->FirstChildElement("model");
+       depXML; depXML = depXML->NextSiblingElement())
+  {
+    TiXmlElement *uriXML = depXML->FirstChildElement("uri");
+    if (uriXML && uriXML->GetText())
+      uris.push_back(uriXML->GetText());
+    else
+    {
+      gzerr << "Model depend is missing <uri> in manifest["
+            << _manifest << "]\n";
+    }
+  }
+
+  return uris;
+}
+
+/////////////////////////////////////////////////
+/// \brief Download a file.
+/// \param[in] _url URL of the file.
+/// \param[in] _filename Local file to write.
+/// \return True on success.
+static bool downloadFile(const std::string &_url, const std::string &_filename)
+{
+  CURL *curl = curl_easy_init();
+  if (!curl)
+  {
+    gzerr << "Unable to initialize libcurl\n";
+    return false;
+  }
+
+  FILE *fp = fopen(_filename.c_str(), "wb");
+  if (!fp)
+  {
+    gzerr << "Could not download [" << _url << "] because we were"
+      << "unable to write to file[" << _filename << "]."
+      << "Please fix file permissions.";
+    curl_easy_cleanup(curl);
+    return false;
+  }
+
+  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  CURLcode success = curl_easy_perform(curl);
+
+  fclose(fp);
+  curl_easy_cleanup(curl);
+  return success == CURLE_OK;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the shared cache of model tarballs.
+/// \return Value of GAZEBO_MODEL_CACHE_PATH, empty when it isn't set.
+static std::string cachePath()
+{
+  const char *path = getenv("GAZEBO_MODEL_CACHE_PATH");
+  return path ? path : "";
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+/// \param[in] _filename File to read.
+/// \param[out] _data Content of the file.
+/// \return False if the file can't be read.
+static bool readFile(const std::string &_filename, std::string &_data)
+{
+  std::ifstream file(_filename.c_str(),
+      std::ios_base::in | std::ios_base::binary);
+  if (!file)
+    return false;
+  _data.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  return !file.bad();
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a file so that other processes see either nothing or the
+/// whole file, by renaming a temporary file of the same directory.
+/// \param[in] _filename File to write.
+/// \param[in] _data Content of the file.
+/// \return True on success.
+static bool writeFileAtomic(const boost::filesystem::path &_filename,
+    const std::string &_data)
+{
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(_filename.parent_path(), ec);
+
+  boost::filesystem::path tmp = _filename.parent_path() /
+      boost::filesystem::unique_path(".tmp-%%%%-%%%%-%%%%-%%%%");
+  std::ofstream out(tmp.string().c_str(),
+      std::ios_base::out | std::ios_base::binary);
+  out.write(_data.data(), _data.size());
+  out.close();
+
+  if (out)
+    boost::filesystem::rename(tmp, _filename, ec);
+
+  if (!out || ec)
+  {
+    boost::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a tarball in the shared cache. The cache holds the
+/// tarballs in objects/<sha1 of content>.tar.gz, and the SHA1 of the
+/// content of every URL in refs/<sha1 of URL>.
+/// \param[in] _cache Path to the cache, empty when it is disabled.
+/// \param[in] _url URL of the tarball.
+/// \return Path to the cached tarball, empty if it isn't cached.
+static std::string cacheLookup(const std::string &_cache,
+    const std::string &_url)
+{
+  if (_cache.empty())
+    return std::string();
+
+  boost::filesystem::path cache(_cache);
+  std::string hash;
+  if (!readFile((cache / "refs" / common::get_sha1(_url)).string(), hash) ||
+      hash.size() != 40 ||
+      hash.find_first_not_of("0123456789abcdef") != std::string::npos)
+  {
+    return std::string();
+  }
+
+  boost::filesystem::path object = cache / "objects" / (hash + ".tar.gz");
+  std::string data;
+  if (!readFile(object.string(), data))
+    return std::string();
+
+  if (common::get_sha1(data) != hash)
+  {
+    gzwarn << "Ignoring damaged model tarball[" << object << "] in cache\n";
+    return std::string();
+  }
+
+  return object.string();
+}
+
+/////////////////////////////////////////////////
+/// \brief Store a tarball in the shared cache, see cacheLookup().
+/// \param[in] _cache Path to the cache.
+/// \param[in] _url URL of the tarball.
+/// \param[in] _filename Downloaded tarball.
+static void cacheStore(const std::string &_cache, const std::string &_url,
+    const std::string &_filename)
+{
+  std::string data;
+  if (!readFile(_filename, data))
+    return;
+
+  const std::string hash = common::get_sha1(data);
+  boost::filesystem::path cache(_cache);
+  boost::filesystem::path object = cache / "objects" / (hash + ".tar.gz");
+
+  // The object is written even if it exists, to replace a damaged file
+  if (!writeFileAtomic(object, data) ||
+      !writeFileAtomic(cache / "refs" / common::get_sha1(_url), hash))
+  {
+    gzwarn << "Unable to store model tarball[" << _url << "] in cache["
+           << _cache << "]\n";
+  }
+}
+
 /////////////////////////////////////////////////
 ModelDatabase::ModelDatabase()
   : dataPtr(new ModelDatabasePrivate)
 {
+  // Models are downloaded from several threads
+  curl_global_init(CURL_GLOBAL_ALL);
   this->dataPtr->updateCacheThread = nullptr;
   this->Start();
 }
@@ -79,6 +358,7 @@ ModelDatabase::~ModelDatabase()
   this->Fini();
   delete this->dataPtr;
   this->dataPtr = nullptr;
+  curl_global_cleanup();
 }
 
 /////////////////////////////////////////////////
@@ -205,6 +485,7 @@ std::string ModelDatabase::GetManifestImpl(const std::string &_uri)
 
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, get_models_cb);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &xmlString);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
 
     CURLcode success = curl_easy_perform(curl);
     if (success != CURLE_OK)
@@ -414,131 +695,144 @@ std::string ModelDatabase::GetModelPath(const std::string &_uri,
       return std::string();
     }
 
-    // Get the model name from the uri
-    size_t startIndex = _uri.find_first_of("://");
-    if (startIndex == std::string::npos)
-    {
-      gzerr << "URI[" << _uri << "] is missing ://\n";
+    std::string modelName;
+    if (!this->ParseModelURI(_uri, modelName, suffix))
       return std::string();
-    }
-
-    std::string modelName = _uri;
-    boost::replace_first(modelName, "model://", "");
-    boost::replace_first(modelName, ModelDatabase::GetURI(), "");
-
-    startIndex = modelName[0] == '/' ? 1 : 0;
-    size_t endIndex = modelName.find_first_of("/", startIndex);
-    size_t modelNameLen = endIndex == std::string::npos ? std::string::npos :
-      endIndex - startIndex;
-
-    if (endIndex != std::string::npos)
-      suffix = modelName.substr(endIndex, std::string::npos);
-
-    modelName = modelName.substr(startIndex, modelNameLen);
-
-    // Store downloaded .tar.gz and intermediate .tar files in temp location
-    boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
-    tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
-    std::string tarfilename = tmppath.string() + ".tar";
-    std::string tgzfilename = tarfilename + ".gz";
 
-    CURL *curl = curl_easy_init();
-    if (!curl)
     {
-      gzerr << "Unable to initialize libcurl\n";
-      return std::string();
+      boost::recursive_mutex::scoped_lock lock(this->dataPtr->downloadMutex);
+      path = this->DownloadModel(modelName);
     }
 
-    curl_easy_setopt(curl, CURLOPT_URL,
-        (ModelDatabase::GetURI() + "/" +
-         modelName + "/model.tar.gz").c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
-
-    bool retry = true;
-    int iterations = 0;
-    while (retry && iterations < 4)
+    if (path.empty())
     {
-      retry = false;
-      iterations++;
+      gzerr << "Could not download model[" << _uri << "]."
+        << "The model may be corrupt.\n";
+      return std::string();
+    }
 
-      FILE *fp = fopen(tgzfilename.c_str(), "wb");
-      if (!fp)
-      {
-        gzerr << "Could not download model[" << _uri << "] because we were"
-          << "unable to write to file[" << tgzfilename << "]."
-          << "Please fix file permissions.";
-        return std::string();
-      }
+    // The index of the model paths doesn't list the new model yet
+    SystemPaths::Instance()->ClearFindFileCache();
 
-      /// Download the model tarball
-      curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-      CURLcode success = curl_easy_perform(curl);
+    this->DownloadDependencies(path);
+  }
 
-      if (success != CURLE_OK)
-      {
-        gzwarn << "Unable to connect to model database using ["
-               << _uri << "]\n";
-        retry = true;
-        continue;
-      }
+  return path + suffix;
+}
 
-      fclose(fp);
+/////////////////////////////////////////////////
+bool ModelDatabase::ParseModelURI(const std::string &_uri,
+    std::string &_modelName, std::string &_suffix)
+{
+  if (_uri.find("://") == std::string::npos)
+  {
+    gzerr << "URI[" << _uri << "] is missing ://\n";
+    return false;
+  }
 
-      try
-      {
-        // Unzip model tarball
-        std::ifstream file(tgzfilename.c_str(),
-            std::ios_base::in | std::ios_base::binary);
-        std::ofstream out(tarfilename.c_str(),
-            std::ios_base::out | std::ios_base::binary);
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
-        in.push(boost::iostreams::gzip_decompressor());
-        in.push(file);
-        boost::iostreams::copy(in, out);
-      }
-      catch(...)
-      {
-        gzerr << "Failed to unzip model tarball. Trying again...\n";
-        retry = true;
-        continue;
-      }
+  std::string modelName = _uri;
+  boost::replace_first(modelName, "model://", "");
+  boost::replace_first(modelName, ModelDatabase::GetURI(), "");
 
-#ifndef _WIN32
-      TAR *tar;
-      tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
-          nullptr, O_RDONLY, 0644, TAR_GNU);
+  size_t startIndex = !modelName.empty() && modelName[0] == '/' ? 1 : 0;
+  size_t endIndex = modelName.find_first_of("/", startIndex);
+  size_t modelNameLen = endIndex == std::string::npos ? std::string::npos :
+    endIndex - startIndex;
 
-      std::string outputPath = getenv("HOME");
-      outputPath += "/.gazebo/models";
+  _suffix.clear();
+  if (endIndex != std::string::npos)
+    _suffix = modelName.substr(endIndex, std::string::npos);
 
-      tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
-      path = outputPath + "/" + modelName;
+  _modelName = modelName.substr(startIndex, modelNameLen);
+  return !_modelName.empty();
+}
 
-      ModelDatabase::DownloadDependencies(path);
-#endif
-    }
+/////////////////////////////////////////////////
+std::string ModelDatabase::DownloadModel(const std::string &_modelName)
+{
+  const std::string url =
+    ModelDatabase::GetURI() + "/" + _modelName + "/model.tar.gz";
+  const std::string cache = cachePath();
+
+  // Store downloaded .tar.gz and intermediate .tar files in temp location
+  boost::filesystem::path tmppath = boost::filesystem::temp_directory_path();
+  tmppath /= boost::filesystem::unique_path("gz_model-%%%%-%%%%-%%%%-%%%%");
+  std::string tarfilename = tmppath.string() + ".tar";
+  std::string tgzfilename = tarfilename + ".gz";
+
+  std::string path;
+  bool done = false;
+  for (int iterations = 0; !done && iterations < 4; ++iterations)
+  {
+    // Only the first attempt uses the cache, in case its tarball is bad
+    std::string source;
+    if (iterations == 0)
+      source = cacheLookup(cache, url);
 
-    curl_easy_cleanup(curl);
-    if (retry)
+    const bool cached = !source.empty();
+    if (!cached)
     {
-      gzerr << "Could not download model[" << _uri << "]."
-        << "The model may be corrupt.\n";
-      path.clear();
+      if (!downloadFile(url, tgzfilename))
+      {
+        gzwarn << "Unable to connect to model database using ["
+               << url << "]\n";
+        continue;
+      }
+      source = tgzfilename;
     }
 
-    // Clean up
     try
     {
-      boost::filesystem::remove(tarfilename);
-      boost::filesystem::remove(tgzfilename);
+      // Unzip model tarball
+      std::ifstream file(source.c_str(),
+          std::ios_base::in | std::ios_base::binary);
+      std::ofstream out(tarfilename.c_str(),
+          std::ios_base::out | std::ios_base::binary);
+      boost::iostreams::filtering_streambuf<boost::iostreams::input> in;
+      in.push(boost::iostreams::gzip_decompressor());
+      in.push(file);
+      boost::iostreams::copy(in, out);
     }
     catch(...)
     {
-      gzwarn << "Failed to remove temporary model files after download.";
+      gzerr << "Failed to unzip model tarball. Trying again...\n";
+      continue;
     }
+
+    // Only tarballs that unzip are shared with other processes
+    if (!cached && !cache.empty())
+      cacheStore(cache, url, tgzfilename);
+
+    done = true;
+
+#ifndef _WIN32
+    TAR *tar;
+    if (tar_open(&tar, const_cast<char*>(tarfilename.c_str()),
+          nullptr, O_RDONLY, 0644, TAR_GNU) != 0)
+    {
+      gzerr << "Unable to open model tarball[" << tarfilename << "]\n";
+      continue;
+    }
+
+    std::string outputPath = installPath();
+    tar_extract_all(tar, const_cast<char*>(outputPath.c_str()));
+    tar_close(tar);
+    path = outputPath + "/" + _modelName;
+#endif
   }
 
-  return path + suffix;
+  // Clean up
+  try
+  {
+    boost::filesystem::remove(tarfilename);
+    boost::filesystem::remove(tgzfilename);
+  }
+  catch(...)
+  {
+    gzwarn << "Failed to remove temporary model files after download.";
+  }
+
+  return path;
 }
 
 /////////////////////////////////////////////////
@@ -558,35 +852,99 @@ void ModelDatabase::DownloadDependencies(const std::string &_path)
   TiXmlDocument xmlDoc;
   if (xmlDoc.LoadFile(manifestPath.string()))
   {
-    TiXmlElement *modelXML = xmlDoc.FirstChildElement("model");
-    if (!modelXML)
+    // Download the models if they don't exist.
+    this->DownloadModels(dependencyURIs(xmlDoc, manifestPath.string()));
+  }
+  else
+    gzerr << "Unable to load manifest file[" << manifestPath << "]\n";
+}
+
+/////////////////////////////////////////////////
+bool ModelDatabase::DownloadModels(const std::vector<std::string> &_uris)
+{
+  boost::recursive_mutex::scoped_lock lock(this->dataPtr->downloadMutex);
+  bool result = true;
+
+  // Resolve the dependency graph one level at a time. The manifests of a
+  // level are fetched in parallel.
+  std::vector<std::string> models;
+  std::set<std::string> visited;
+  std::vector<std::string> pending = _uris;
+  while (!pending.empty())
+  {
+    std::vector<std::string> level;
+    for (const auto &uri : pending)
     {
-      gzerr << "No <model> element in manifest file[" << _path << "]\n";
-      return;
-    }
+      std::string modelName, suffix;
+      if (!this->ParseModelURI(uri, modelName, suffix))
+      {
+        result = false;
+        continue;
+      }
 
-    TiXmlElement *dependXML = modelXML->FirstChildElement("depend");
-    if (!dependXML)
-      return;
+      if (!visited.insert(modelName).second ||
+          !installedModel(modelName).empty())
+      {
+        continue;
+      }
 
-    for (TiXmlElement *depXML = dependXML->FirstChildElement("model");
-         depXML; depXML = depXML->NextSiblingElement())
-    {
-      TiXmlElement *uriXML = depXML->FirstChildElement("uri");
-      if (uriXML)
+      if (!this->HasModel(uri))
       {
-        // Download the model if it doesn't exist.
-        ModelDatabase::GetModelPath(uriXML->GetText());
+        result = false;
+        continue;
       }
-      else
+
+      level.push_back(modelName);
+    }
+    models.insert(models.end(), level.begin(), level.end());
+
+    std::vector<std::vector<std::string>> depends(level.size());
+    runPool(level.size(), [&](const std::size_t _index)
+    {
+      std::string xmlStr = this->GetModelConfig("model://" + level[_index]);
+      TiXmlDocument xmlDoc;
+      if (!xmlStr.empty() && xmlDoc.Parse(xmlStr.c_str()))
       {
-        gzerr << "Model depend is missing <uri> in manifest["
-              << manifestPath << "]\n";
+        depends[_index] = dependencyURIs(xmlDoc,
+            level[_index] + "/" + GZ_MODEL_MANIFEST_FILENAME);
       }
+    });
+
+    pending.clear();
+    for (const auto &uris : depends)
+      pending.insert(pending.end(), uris.begin(), uris.end());
+  }
+
+  if (models.empty())
+    return result;
+
+  gzmsg << "Downloading " << models.size() << " models\n";
+  std::vector<std::string> paths(models.size());
+  runPool(models.size(), [&](const std::size_t _index)
+  {
+    paths[_index] = this->DownloadModel(models[_index]);
+  });
+
+  // The index of the model paths doesn't list the new models yet
+  SystemPaths::Instance()->ClearFindFileCache();
+
+  for (std::size_t i = 0; i < models.size(); ++i)
+  {
+    if (paths[i].empty())
+    {
+      gzerr << "Could not download model[model://" << models[i] << "]."
+        << "The model may be corrupt.\n";
+      result = false;
+    }
+    else
+    {
+      // Fetch the dependencies that a missing manifest of the database
+      // didn't list. The others are installed by now.
+      this->DownloadDependencies(paths[i]);
     }
   }
-  else
-    gzerr << "Unable to load manifest file[" << manifestPath << "]\n";
+
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include <string>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include <boost/function.hpp>
 #include "gazebo/common/Event.hh"
@@ -129,6 +130,21 @@ namespace gazebo
       /// \param[in] _path Path to a model.
       public: void DownloadDependencies(const std::string &_path);
 
+      /// \brief Download models and all their dependencies.
+      ///
+      /// The dependency graph of the models that aren't installed locally
+      /// is resolved first from the model.config files of the database.
+      /// The models are then downloaded in parallel, by at most
+      /// GAZEBO_MODEL_DOWNLOAD_CONNECTIONS threads (4 by default).
+      ///
+      /// When GAZEBO_MODEL_CACHE_PATH is set, downloaded tarballs are
+      /// stored there by the SHA1 of their content, and reused instead of
+      /// downloading them again. The cache is updated with atomic renames,
+      /// so it can be shared by several processes or containers.
+      /// \param[in] _uris URIs of the models (eg: model://my_model_name).
+      /// \return True if every model is installed.
+      public: bool DownloadModels(const std::vector<std::string> &_uris);
+
       /// \brief Returns true if the model exists on the database.
       ///
       /// \param[in] _modelName URI of the model (eg:
@@ -141,6 +157,22 @@ namespace gazebo
       /// \return The contents of the manifest file.
       private: std::string GetManifestImpl(const std::string &_uri);
 
+      /// \brief Get the name of a model and the path within the model from
+      /// a URI.
+      /// \param[in] _uri URI of a model or of a file of a model.
+      /// \param[out] _modelName Name of the model.
+      /// \param[out] _suffix Path of the file within the model, empty for
+      /// the model itself.
+      /// \return False if the URI is invalid.
+      private: bool ParseModelURI(const std::string &_uri,
+                   std::string &_modelName, std::string &_suffix);
+
+      /// \brief Download and install a model, without its dependencies.
+      /// This can be called from several threads.
+      /// \param[in] _modelName Name of the model.
+      /// \return Path to the installed model, empty on failure.
+      private: std::string DownloadModel(const std::string &_modelName);
+
       /// \brief Used by a thread to update the model cache.
       /// \param[in] _fetchImmediately True to fetch the models without
       /// waiting.
@@ -53,6 +53,10 @@ namespace gazebo
       /// \brief Mutex to protect cache thread status checks.
       public: boost::recursive_mutex startCacheMutex;
 
+      /// \brief Serializes the downloads of models. It is recursive
+      /// because installing a model downloads its dependencies.
+      public: boost::recursive_mutex downloadMutex;
+
       /// \brief Condition variable for the updateCacheThread.
       public: boost::condition_variable updateCacheCondition;
 
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tinyxml.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/FuelModelDatabase.hh"
+#include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/ModelSdfCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for ModelSdfCache
+    class ModelSdfCachePrivate
+    {
+      /// \brief A parsed file.
+      public: struct Entry
+              {
+                /// \brief Full path of the file.
+                std::string filename;
+
+                /// \brief Version of the file, see Key().
+                std::string key;
+
+                /// \brief The parsed <sdf> element.
+                sdf::ElementPtr root;
+              };
+
+      /// \brief Get the key that identifies the current version of a file.
+      /// \param[in] _filename Full path of the file.
+      /// \param[out] _key The key.
+      /// \return False if the file can't be inspected.
+      public: static bool Key(const std::string &_filename, std::string &_key)
+              {
+                boost::system::error_code ec;
+                std::time_t mtime =
+                    boost::filesystem::last_write_time(_filename, ec);
+                if (ec)
+                  return false;
+                uintmax_t size = boost::filesystem::file_size(_filename, ec);
+                if (ec)
+                  return false;
+
+                std::ostringstream stream;
+                stream << mtime << '\n' << size;
+                _key = stream.str();
+                return true;
+              }
+
+      /// \brief Get the file of a URI.
+      /// \param[in] _uri URI of a model, or path of a file.
+      /// \return Full path of the file, empty if it can't be found.
+      public: static std::string Resolve(const std::string &_uri)
+              {
+                if (boost::starts_with(_uri, "http://") ||
+                    boost::starts_with(_uri, "https://"))
+                {
+                  return FuelModelDatabase::Instance()->ModelFile(_uri);
+                }
+                if (boost::starts_with(_uri, "model://"))
+                  return ModelDatabase::Instance()->GetModelFile(_uri);
+                if (boost::starts_with(_uri, "file://"))
+                  return _uri.substr(7);
+                return _uri;
+              }
+
+      /// \brief Protects entries, hits and misses.
+      public: mutable std::mutex mutex;
+
+      /// \brief The parsed files, by URI.
+      public: std::map<std::string, Entry> entries;
+
+      /// \brief Number of requests served from the cache.
+      public: uint64_t hits = 0;
+
+      /// \brief Number of requests that parsed a file.
+      public: uint64_t misses = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether an include can be instantiated from the cache.
+/// \param[in] _include The <include> element.
+/// \return True if its children are a model:// <uri>, and optionally
+/// <name>, <pose> without attributes, and <static>.
+static bool simpleInclude(const TiXmlElement *_include)
+{
+  bool hasUri = false;
+  for (const TiXmlElement *child = _include->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    const std::string name = child->Value();
+    const char *text = child->GetText();
+    if (name == "uri")
+    {
+      hasUri = text && boost::starts_with(std::string(text), "model://");
+      if (!hasUri)
+        return false;
+    }
+    else if (name == "pose")
+    {
+      if (child->FirstAttribute())
+        return false;
+    }
+    else if (name != "name" && name != "static")
+      return false;
+  }
+  return hasUri;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the text of a child element.
+/// \param[in] _elem Parent element.
+/// \param[in] _name Name of the child.
+/// \return The text, empty if there's no such child.
+static std::string childText(const TiXmlElement *_elem,
+    const std::string &_name)
+{
+  const TiXmlElement *child = _elem->FirstChildElement(_name.c_str());
+  if (!child || !child->GetText())
+    return "";
+  return child->GetText();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get whether a file has an include that may be relative to the
+/// file.
+/// \param[in] _elem Element to inspect with its descendants.
+/// \return True if an include doesn't have a model:// or Fuel URI.
+static bool hasRelativeInclude(const TiXmlElement *_elem)
+{
+  for (const TiXmlElement *child = _elem->FirstChildElement(); child;
+       child = child->NextSiblingElement())
+  {
+    if (std::string(child->Value()) == "include")
+    {
+      const std::string uri = childText(child, "uri");
+      if (!boost::starts_with(uri, "model://") &&
+          !boost::starts_with(uri, "http://") &&
+          !boost::starts_with(uri, "https://"))
+      {
+        return true;
+      }
+    }
+    else if (hasRelativeInclude(child))
+      return true;
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+ModelSdfCache::ModelSdfCache()
+  : dataPtr(new ModelSdfCachePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ModelSdfCache::~ModelSdfCache()
+{
+}
+
+/////////////////////////////////////////////////
+sdf::ElementPtr ModelSdfCache::Root(const std::string &_uri)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Serve the parsed file while it's unchanged
+  auto iter = this->dataPtr->entries.find(_uri);
+  if (iter != this->dataPtr->entries.end())
+  {
+    std::string key;
+    if (ModelSdfCachePrivate::Key(iter->second.filename, key) &&
+        key == iter->second.key)
+    {
+      ++this->dataPtr->hits;
+      return iter->second.root->Clone();
+    }
+    this->dataPtr->entries.erase(iter);
+  }
+
+  ++this->dataPtr->misses;
+
+  ModelSdfCachePrivate::Entry entry;
+  entry.filename = ModelSdfCachePrivate::Resolve(_uri);
+  if (entry.filename.empty() ||
+      !ModelSdfCachePrivate::Key(entry.filename, entry.key))
+  {
+    gzerr << "Unable to find sdf file of [" << _uri << "]\n";
+    return sdf::ElementPtr();
+  }
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  if (!sdf::init(sdfParsed) || !sdf::readFile(entry.filename, sdfParsed))
+  {
+    gzerr << "Unable to read sdf file [" << entry.filename << "]\n";
+    return sdf::ElementPtr();
+  }
+
+  entry.root = sdfParsed->Root();
+  convertToFullPaths(entry.root);
+
+  sdf::ElementPtr root = entry.root->Clone();
+  this->dataPtr->entries[_uri] = std::move(entry);
+  return root;
+}
+
+/////////////////////////////////////////////////
+bool ModelSdfCache::ReadWorldFile(const std::string &_filename,
+    sdf::SDFPtr _sdf)
+{
+  TiXmlDocument doc;
+  TiXmlElement *sdfXml = nullptr;
+  if (!doc.LoadFile(_filename.c_str()) ||
+      !(sdfXml = doc.FirstChildElement("sdf")) ||
+      hasRelativeInclude(sdfXml))
+  {
+    return sdf::readFile(_filename, _sdf);
+  }
+
+  // The models of the simple includes of each world, in include order
+  struct Include
+  {
+    size_t world;
+    std::string name;
+    std::string pose;
+    std::string isStatic;
+    sdf::ElementPtr model;
+  };
+  std::vector<Include> includes;
+
+  size_t worldIndex = 0;
+  for (TiXmlElement *worldXml = sdfXml->FirstChildElement("world");
+       worldXml; worldXml = worldXml->NextSiblingElement("world"),
+       ++worldIndex)
+  {
+    TiXmlElement *includeXml = worldXml->FirstChildElement("include");
+    while (includeXml)
+    {
+      TiXmlElement *next = includeXml->NextSiblingElement("include");
+      if (simpleInclude(includeXml))
+      {
+        sdf::ElementPtr root = this->Root(childText(includeXml, "uri"));
+        if (root && root->HasElement("model"))
+        {
+          Include include;
+          include.world = worldIndex;
+          include.name = childText(includeXml, "name");
+          include.pose = childText(includeXml, "pose");
+          include.isStatic = childText(includeXml, "static");
+          include.model = root->GetElement("model");
+          includes.push_back(include);
+          worldXml->RemoveChild(includeXml);
+        }
+      }
+      includeXml = next;
+    }
+  }
+
+  if (includes.empty())
+    return sdf::readFile(_filename, _sdf);
+
+  TiXmlPrinter printer;
+  doc.Accept(&printer);
+  if (!sdf::readString(printer.CStr(), _sdf))
+    return false;
+
+  std::vector<sdf::ElementPtr> worlds;
+  if (_sdf->Root()->HasElement("world"))
+  {
+    for (sdf::ElementPtr world = _sdf->Root()->GetElement("world"); world;
+         world = world->GetNextElement("world"))
+    {
+      worlds.push_back(world);
+    }
+  }
+
+  for (auto const &include : includes)
+  {
+    if (include.world >= worlds.size())
+    {
+      gzerr << "Unable to find world of included model ["
+            << include.model->Get<std::string>("name") << "]\n";
+      return false;
+    }
+
+    if (!include.name.empty())
+      include.model->GetAttribute("name")->SetFromString(include.name);
+    if (!include.pose.empty())
+      include.model->GetElement("pose")->GetValue()->SetFromString(
+          include.pose);
+    if (!include.isStatic.empty())
+      include.model->GetElement("static")->GetValue()->SetFromString(
+          include.isStatic);
+
+    include.model->SetParent(worlds[include.world]);
+    worlds[include.world]->InsertElement(include.model);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSdfCache::Hits() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->hits;
+}
+
+/////////////////////////////////////////////////
+uint64_t ModelSdfCache::Misses() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->misses;
+}
+
+/////////////////////////////////////////////////
+void ModelSdfCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.clear();
+}
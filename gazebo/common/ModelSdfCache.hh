@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_MODELSDFCACHE_HH_
+#define GAZEBO_COMMON_MODELSDFCACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, ModelSdfCache)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class ModelSdfCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class ModelSdfCache ModelSdfCache.hh common/common.hh
+    /// \brief In-process cache of parsed model SDF files.
+    ///
+    /// The files are looked up by URI, and parsed again when their
+    /// modification time or size changes. Every request returns a clone
+    /// of the cached elements, which the caller is free to modify.
+    class GZ_COMMON_VISIBLE ModelSdfCache : public SingletonT<ModelSdfCache>
+    {
+      /// \brief Constructor
+      private: ModelSdfCache();
+
+      /// \brief Destructor
+      private: virtual ~ModelSdfCache();
+
+      /// \brief Get the parsed SDF of a model.
+      /// \param[in] _uri URI of the model, such as model://box, a Fuel
+      /// URL, or the path of an SDF file.
+      /// \return A clone of the <sdf> element, with full paths. Null if
+      /// the model can't be found or parsed.
+      public: sdf::ElementPtr Root(const std::string &_uri);
+
+      /// \brief Read a world file, instantiating its plain model://
+      /// includes from the cache.
+      ///
+      /// An include of a world is instantiated from the cache when its
+      /// only children are <uri>, <name>, <pose> and <static>. Other
+      /// includes are left to libsdformat, and the whole file is read by
+      /// sdf::readFile when one of them isn't a model:// or Fuel URI,
+      /// since those may be relative to the world file.
+      /// \param[in] _filename Path of the world file.
+      /// \param[out] _sdf SDF object to populate.
+      /// \return True on success.
+      public: bool ReadWorldFile(const std::string &_filename,
+                  sdf::SDFPtr _sdf);
+
+      /// \brief Get the number of requests served from the cache.
+      /// \return Number of hits.
+      public: uint64_t Hits() const;
+
+      /// \brief Get the number of requests that parsed a file.
+      /// \return Number of misses.
+      public: uint64_t Misses() const;
+
+      /// \brief Remove all the parsed files.
+      public: void Clear();
+
+      /// \brief Singleton implementation
+      private: friend class SingletonT<ModelSdfCache>;
+
+      /// \internal
+      /// \brief Pointer to private data.
+      private: std::unique_ptr<ModelSdfCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
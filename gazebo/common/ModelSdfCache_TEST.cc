@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <map>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/ModelSdfCache.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ModelSdfCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _text Content of the file.
+void writeFile(const boost::filesystem::path &_path, const std::string &_text)
+{
+  std::ofstream file(_path.string());
+  file << _text;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a model with a box link.
+/// \param[in] _dir Directory of the model.
+/// \param[in] _link Name of the link.
+void writeModel(const boost::filesystem::path &_dir, const std::string &_link)
+{
+  boost::filesystem::create_directories(_dir);
+  writeFile(_dir / "model.config",
+      "<?xml version='1.0'?><model><name>cached_box</name>"
+      "<sdf version='1.6'>model.sdf</sdf></model>");
+  writeFile(_dir / "model.sdf",
+      "<?xml version='1.0'?><sdf version='1.6'>"
+      "<model name='cached_box'><pose>0 0 0.5 0 0 0</pose>"
+      "<link name='" + _link + "'/></model></sdf>");
+}
+
+/////////////////////////////////////////////////
+TEST_F(ModelSdfCache, Root)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_model_sdf_cache_%%%%-%%%%");
+  writeModel(dir / "cached_box", "link");
+  common::SystemPaths::Instance()->AddModelPaths(dir.string());
+
+  common::ModelSdfCache *cache = common::ModelSdfCache::Instance();
+  cache->Clear();
+  const uint64_t hits = cache->Hits();
+  const uint64_t misses = cache->Misses();
+
+  sdf::ElementPtr root = cache->Root("model://cached_box");
+  ASSERT_TRUE(root != nullptr);
+  ASSERT_TRUE(root->HasElement("model"));
+  EXPECT_EQ(misses + 1, cache->Misses());
+
+  // Changes to a clone don't reach the cache
+  root->GetElement("model")->GetAttribute("name")->Set("changed");
+  sdf::ElementPtr other = cache->Root("model://cached_box");
+  ASSERT_TRUE(other != nullptr);
+  EXPECT_EQ("cached_box",
+      other->GetElement("model")->Get<std::string>("name"));
+  EXPECT_EQ(hits + 1, cache->Hits());
+
+  // A changed file is parsed again
+  writeModel(dir / "cached_box", "other_link");
+  root = cache->Root("model://cached_box");
+  ASSERT_TRUE(root != nullptr);
+  EXPECT_TRUE(root->GetElement("model")->HasElement("link"));
+  EXPECT_EQ("other_link", root->GetElement("model")->GetElement("link")->
+      Get<std::string>("name"));
+  EXPECT_EQ(misses + 2, cache->Misses());
+
+  EXPECT_TRUE(cache->Root("model://missing_cached_box") == nullptr);
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ModelSdfCache, ReadWorldFile)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_model_sdf_cache_%%%%-%%%%");
+  writeModel(dir / "cached_box", "link");
+  common::SystemPaths::Instance()->AddModelPaths(dir.string());
+
+  writeFile(dir / "boxes.world",
+      "<?xml version='1.0'?><sdf version='1.6'><world name='default'>"
+      "<model name='ground'><static>true</static><link name='link'/>"
+      "</model>"
+      "<include><uri>model://cached_box</uri><name>box_0</name>"
+      "<pose>1 2 3 0 0 0</pose></include>"
+      "<include><uri>model://cached_box</uri><name>box_1</name>"
+      "<static>true</static></include>"
+      "<include><uri>model://cached_box</uri><name>box_2</name>"
+      "<plugin name='p' filename='libp.so'/></include>"
+      "</world></sdf>");
+
+  common::ModelSdfCache *cache = common::ModelSdfCache::Instance();
+  cache->Clear();
+  const uint64_t hits = cache->Hits();
+  const uint64_t misses = cache->Misses();
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF());
+  ASSERT_TRUE(sdf::init(sdfParsed));
+  ASSERT_TRUE(cache->ReadWorldFile((dir / "boxes.world").string(),
+        sdfParsed));
+
+  // The simple includes are parsed once
+  EXPECT_EQ(misses + 1, cache->Misses());
+  EXPECT_EQ(hits + 1, cache->Hits());
+
+  sdf::ElementPtr world = sdfParsed->Root()->GetElement("world");
+  std::map<std::string, sdf::ElementPtr> models;
+  for (sdf::ElementPtr model = world->GetElement("model"); model;
+       model = model->GetNextElement("model"))
+  {
+    models[model->Get<std::string>("name")] = model;
+  }
+  ASSERT_EQ(4u, models.size());
+  ASSERT_EQ(1u, models.count("box_0"));
+  ASSERT_EQ(1u, models.count("box_1"));
+  ASSERT_EQ(1u, models.count("box_2"));
+
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0),
+      models["box_0"]->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_FALSE(models["box_0"]->Get<bool>("static"));
+  EXPECT_EQ(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0),
+      models["box_1"]->Get<ignition::math::Pose3d>("pose"));
+  EXPECT_TRUE(models["box_1"]->Get<bool>("static"));
+  EXPECT_EQ(world, models["box_1"]->GetParent());
+
+  // The include with a plugin is left to libsdformat
+  EXPECT_TRUE(models["box_2"]->HasElement("plugin"));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -181,6 +181,26 @@ void PID::GetErrors(double &_pe, double &_ie, double &_de)
   _de = this->dErr;
 }
 
+/////////////////////////////////////////////////
+void PID::State(double *_state) const
+{
+  _state[0] = this->pErrLast;
+  _state[1] = this->pErr;
+  _state[2] = this->iErr;
+  _state[3] = this->dErr;
+  _state[4] = this->cmd;
+}
+
+/////////////////////////////////////////////////
+void PID::SetState(const double *_state)
+{
+  this->pErrLast = _state[0];
+  this->pErr = _state[1];
+  this->iErr = _state[2];
+  this->dErr = _state[3];
+  this->cmd = _state[4];
+}
+
 /////////////////////////////////////////////////
 double PID::GetPGain() const
 {
@@ -151,6 +151,19 @@ namespace gazebo
       /// \param[in] _de  The derivative error.
       public: void GetErrors(double &_pe, double &_ie, double &_de);
 
+      /// \brief Number of values in the state of a PID controller.
+      public: static const unsigned int kStateSize = 5;
+
+      /// \brief Get the state that Update changes, which are the previous,
+      /// proportional, integral and derivative errors and the command.
+      /// \param[out] _state Array of kStateSize values.
+      public: void State(double *_state) const;
+
+      /// \brief Set the state returned by State(), for example to restore
+      /// a saved simulation state. The gains and limits don't change.
+      /// \param[in] _state Array of kStateSize values.
+      public: void SetState(const double *_state);
+
       /// \brief Assignment operator
       /// \param[in] _p a reference to a PID to assign values from
       /// \return reference to this instance
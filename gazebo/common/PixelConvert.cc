@@ -0,0 +1,616 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// The x86 paths are compiled with target attributes and chosen at run
+// time, so that the library still runs on CPUs without SSSE3 or AVX2.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define GZ_PIXEL_X86 1
+#include <immintrin.h>
+#define GZ_TARGET(_isa) __attribute__((target(_isa)))
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GZ_PIXEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "gazebo/common/PixelConvert.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Instruction sets of the conversions.
+enum class PixelPath
+{
+  /// \brief Plain loops.
+  SCALAR,
+
+  /// \brief SSE2 and SSSE3.
+  SSSE3,
+
+  /// \brief AVX2, with SSSE3 for the 3 byte swizzles.
+  AVX2,
+
+  /// \brief ARM NEON.
+  NEON
+};
+
+/////////////////////////////////////////////////
+static PixelPath detectPath()
+{
+#if defined(GZ_PIXEL_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return PixelPath::AVX2;
+  if (__builtin_cpu_supports("ssse3"))
+    return PixelPath::SSSE3;
+  return PixelPath::SCALAR;
+#elif defined(GZ_PIXEL_NEON)
+  return PixelPath::NEON;
+#else
+  return PixelPath::SCALAR;
+#endif
+}
+
+/////////////////////////////////////////////////
+static PixelPath pixelPath()
+{
+  static const PixelPath path = detectPath();
+  return path;
+}
+
+#if defined(GZ_PIXEL_X86)
+/////////////////////////////////////////////////
+// Five pixels are swapped per 16 byte load, and the last byte is copied
+// as is. It belongs to the next pixel, which the next store rewrites.
+GZ_TARGET("ssse3")
+static std::size_t swapRedBlueSsse3(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  const __m128i mask = _mm_setr_epi8(
+      2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+  std::size_t i = 0;
+  for (; i + 6 <= _count; i += 5)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 3),
+        _mm_shuffle_epi8(v, mask));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+GZ_TARGET("ssse3")
+static std::size_t swapRedBlueAlphaSsse3(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  const __m128i mask = _mm_setr_epi8(
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  std::size_t i = 0;
+  for (; i + 4 <= _count; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 4),
+        _mm_shuffle_epi8(v, mask));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+GZ_TARGET("avx2")
+static std::size_t swapRedBlueAlphaAvx2(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  // The shuffle works within each 128 bit lane, which holds whole pixels
+  const __m256i mask = _mm256_setr_epi8(
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  std::size_t i = 0;
+  for (; i + 8 <= _count; i += 8)
+  {
+    const __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(_src + i * 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(_dst + i * 4),
+        _mm256_shuffle_epi8(v, mask));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+// Four pixels are packed per iteration. The 16 byte store writes 4 bytes
+// past them, so the loop stops while the destination still has room.
+GZ_TARGET("ssse3")
+static std::size_t rgbaToRgbSsse3(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  const __m128i mask = _mm_setr_epi8(
+      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  std::size_t i = 0;
+  for (; i + 6 <= _count; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 3),
+        _mm_shuffle_epi8(v, mask));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+// The 16 byte load reads 4 bytes past the four pixels expanded, so the
+// loop stops while the source still has them.
+GZ_TARGET("ssse3")
+static std::size_t rgbToRgbaSsse3(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count, const unsigned char _alpha)
+{
+  const __m128i mask = _mm_setr_epi8(
+      0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m128i alpha = _mm_set1_epi32(
+      static_cast<int>(static_cast<uint32_t>(_alpha) << 24));
+  std::size_t i = 0;
+  for (; i + 6 <= _count; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(_src + i * 3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i * 4),
+        _mm_or_si128(_mm_shuffle_epi8(v, mask), alpha));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+// The values are biased to fit the signed saturation of packs, because
+// SSE2 has no unsigned 32 to 16 bit pack.
+GZ_TARGET("sse2")
+static std::size_t depthToUInt16Sse2(const float *_src, uint16_t *_dst,
+    const std::size_t _count, const float _scale)
+{
+  const __m128 scale = _mm_set1_ps(_scale);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 top = _mm_set1_ps(65535.0f);
+  const __m128i bias = _mm_set1_epi32(32768);
+  const __m128i bias16 = _mm_set1_epi16(-32768);
+  std::size_t i = 0;
+  for (; i + 8 <= _count; i += 8)
+  {
+    __m128 a = _mm_mul_ps(_mm_loadu_ps(_src + i), scale);
+    __m128 b = _mm_mul_ps(_mm_loadu_ps(_src + i + 4), scale);
+    // max returns its second operand when the first one is NaN
+    a = _mm_min_ps(_mm_max_ps(a, zero), top);
+    b = _mm_min_ps(_mm_max_ps(b, zero), top);
+    const __m128i ia = _mm_sub_epi32(_mm_cvtps_epi32(a), bias);
+    const __m128i ib = _mm_sub_epi32(_mm_cvtps_epi32(b), bias);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_xor_si128(_mm_packs_epi32(ia, ib), bias16));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+GZ_TARGET("avx2")
+static std::size_t depthToUInt16Avx2(const float *_src, uint16_t *_dst,
+    const std::size_t _count, const float _scale)
+{
+  const __m256 scale = _mm256_set1_ps(_scale);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 top = _mm256_set1_ps(65535.0f);
+  std::size_t i = 0;
+  for (; i + 16 <= _count; i += 16)
+  {
+    __m256 a = _mm256_mul_ps(_mm256_loadu_ps(_src + i), scale);
+    __m256 b = _mm256_mul_ps(_mm256_loadu_ps(_src + i + 8), scale);
+    a = _mm256_min_ps(_mm256_max_ps(a, zero), top);
+    b = _mm256_min_ps(_mm256_max_ps(b, zero), top);
+    // The pack interleaves the 128 bit lanes of its operands
+    const __m256i packed = _mm256_packus_epi32(
+        _mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(_dst + i),
+        _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+GZ_TARGET("sse2")
+static std::size_t clampDepthSse2(float *_data, const std::size_t _count,
+    const float _near, const float _far)
+{
+  const __m128 nearClip = _mm_set1_ps(_near);
+  const __m128 farClip = _mm_set1_ps(_far);
+  const __m128 inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  const __m128 negInf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+  std::size_t i = 0;
+  for (; i + 4 <= _count; i += 4)
+  {
+    const __m128 v = _mm_loadu_ps(_data + i);
+    const __m128 isFar = _mm_cmpge_ps(v, farClip);
+    const __m128 isNear = _mm_andnot_ps(isFar, _mm_cmple_ps(v, nearClip));
+    const __m128 masked = _mm_or_ps(_mm_and_ps(isFar, inf),
+        _mm_and_ps(isNear, negInf));
+    _mm_storeu_ps(_data + i, _mm_or_ps(
+        _mm_andnot_ps(_mm_or_ps(isFar, isNear), v), masked));
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+GZ_TARGET("avx2")
+static std::size_t clampDepthAvx2(float *_data, const std::size_t _count,
+    const float _near, const float _far)
+{
+  const __m256 nearClip = _mm256_set1_ps(_near);
+  const __m256 farClip = _mm256_set1_ps(_far);
+  const __m256 inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+  const __m256 negInf =
+    _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+  std::size_t i = 0;
+  for (; i + 8 <= _count; i += 8)
+  {
+    const __m256 v = _mm256_loadu_ps(_data + i);
+    __m256 out = _mm256_blendv_ps(v, negInf,
+        _mm256_cmp_ps(v, nearClip, _CMP_LE_OQ));
+    // The far clip is tested last, so that it wins as in the plain loop
+    out = _mm256_blendv_ps(out, inf, _mm256_cmp_ps(v, farClip, _CMP_GE_OQ));
+    _mm256_storeu_ps(_data + i, out);
+  }
+  return i;
+}
+#endif
+
+#if defined(GZ_PIXEL_NEON)
+/////////////////////////////////////////////////
+static std::size_t swapRedBlueNeon(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= _count; i += 16)
+  {
+    uint8x16x3_t v = vld3q_u8(_src + i * 3);
+    const uint8x16_t red = v.val[0];
+    v.val[0] = v.val[2];
+    v.val[2] = red;
+    vst3q_u8(_dst + i * 3, v);
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+static std::size_t swapRedBlueAlphaNeon(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= _count; i += 16)
+  {
+    uint8x16x4_t v = vld4q_u8(_src + i * 4);
+    const uint8x16_t red = v.val[0];
+    v.val[0] = v.val[2];
+    v.val[2] = red;
+    vst4q_u8(_dst + i * 4, v);
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+static std::size_t rgbaToRgbNeon(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= _count; i += 16)
+  {
+    const uint8x16x4_t v = vld4q_u8(_src + i * 4);
+    uint8x16x3_t out;
+    out.val[0] = v.val[0];
+    out.val[1] = v.val[1];
+    out.val[2] = v.val[2];
+    vst3q_u8(_dst + i * 3, out);
+  }
+  return i;
+}
+
+/////////////////////////////////////////////////
+static std::size_t rgbToRgbaNeon(const unsigned char *_src,
+    unsigned char *_dst, const std::size_t _count, const unsigned char _alpha)
+{
+  uint8x16x4_t out;
+  out.val[3] = vdupq_n_u8(_alpha);
+  std::size_t i = 0;
+  for (; i + 16 <= _count; i += 16)
+  {
+    const uint8x16x3_t v = vld3q_u8(_src + i * 3);
+    out.val[0] = v.val[0];
+    out.val[1] = v.val[1];
+    out.val[2] = v.val[2];
+    vst4q_u8(_dst + i * 4, out);
+  }
+  return i;
+}
+
+#if defined(__aarch64__)
+/////////////////////////////////////////////////
+// ARMv7 has no rounding conversion, so it uses the plain loop.
+static std::size_t depthToUInt16Neon(const float *_src, uint16_t *_dst,
+    const std::size_t _count, const float _scale)
+{
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t top = vdupq_n_f32(65535.0f);
+  std::size_t i = 0;
+  for (; i + 8 <= _count; i += 8)
+  {
+    // maxnm returns the number when the other operand is NaN
+    float32x4_t a = vmulq_n_f32(vld1q_f32(_src + i), _scale);
+    float32x4_t b = vmulq_n_f32(vld1q_f32(_src + i + 4), _scale);
+    a = vminq_f32(vmaxnmq_f32(a, zero), top);
+    b = vminq_f32(vmaxnmq_f32(b, zero), top);
+    vst1q_u16(_dst + i, vcombine_u16(vmovn_u32(vcvtnq_u32_f32(a)),
+        vmovn_u32(vcvtnq_u32_f32(b))));
+  }
+  return i;
+}
+#endif
+
+/////////////////////////////////////////////////
+static std::size_t clampDepthNeon(float *_data, const std::size_t _count,
+    const float _near, const float _far)
+{
+  const float32x4_t nearClip = vdupq_n_f32(_near);
+  const float32x4_t farClip = vdupq_n_f32(_far);
+  const float32x4_t inf = vdupq_n_f32(std::numeric_limits<float>::infinity());
+  const float32x4_t negInf =
+    vdupq_n_f32(-std::numeric_limits<float>::infinity());
+  std::size_t i = 0;
+  for (; i + 4 <= _count; i += 4)
+  {
+    const float32x4_t v = vld1q_f32(_data + i);
+    float32x4_t out = vbslq_f32(vcleq_f32(v, nearClip), negInf, v);
+    out = vbslq_f32(vcgeq_f32(v, farClip), inf, out);
+    vst1q_f32(_data + i, out);
+  }
+  return i;
+}
+#endif
+
+/////////////////////////////////////////////////
+void common::SwapRedBlue(const unsigned char *_src, unsigned char *_dst,
+    const std::size_t _count)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() != PixelPath::SCALAR)
+    i = swapRedBlueSsse3(_src, _dst, _count);
+#elif defined(GZ_PIXEL_NEON)
+  i = swapRedBlueNeon(_src, _dst, _count);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const unsigned char red = _src[i * 3];
+    _dst[i * 3] = _src[i * 3 + 2];
+    _dst[i * 3 + 1] = _src[i * 3 + 1];
+    _dst[i * 3 + 2] = red;
+  }
+}
+
+/////////////////////////////////////////////////
+void common::SwapRedBlueAlpha(const unsigned char *_src, unsigned char *_dst,
+    const std::size_t _count)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() == PixelPath::AVX2)
+    i = swapRedBlueAlphaAvx2(_src, _dst, _count);
+  if (pixelPath() != PixelPath::SCALAR)
+    i += swapRedBlueAlphaSsse3(_src + i * 4, _dst + i * 4, _count - i);
+#elif defined(GZ_PIXEL_NEON)
+  i = swapRedBlueAlphaNeon(_src, _dst, _count);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    const unsigned char red = _src[i * 4];
+    _dst[i * 4] = _src[i * 4 + 2];
+    _dst[i * 4 + 1] = _src[i * 4 + 1];
+    _dst[i * 4 + 2] = red;
+    _dst[i * 4 + 3] = _src[i * 4 + 3];
+  }
+}
+
+/////////////////////////////////////////////////
+void common::RGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+    const std::size_t _count)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() != PixelPath::SCALAR)
+    i = rgbaToRgbSsse3(_src, _dst, _count);
+#elif defined(GZ_PIXEL_NEON)
+  i = rgbaToRgbNeon(_src, _dst, _count);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    _dst[i * 3] = _src[i * 4];
+    _dst[i * 3 + 1] = _src[i * 4 + 1];
+    _dst[i * 3 + 2] = _src[i * 4 + 2];
+  }
+}
+
+/////////////////////////////////////////////////
+void common::RGBToRGBA(const unsigned char *_src, unsigned char *_dst,
+    const std::size_t _count, const unsigned char _alpha)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() != PixelPath::SCALAR)
+    i = rgbToRgbaSsse3(_src, _dst, _count, _alpha);
+#elif defined(GZ_PIXEL_NEON)
+  i = rgbToRgbaNeon(_src, _dst, _count, _alpha);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    _dst[i * 4] = _src[i * 3];
+    _dst[i * 4 + 1] = _src[i * 3 + 1];
+    _dst[i * 4 + 2] = _src[i * 3 + 2];
+    _dst[i * 4 + 3] = _alpha;
+  }
+}
+
+/////////////////////////////////////////////////
+void common::DepthToUInt16(const float *_src, uint16_t *_dst,
+    const std::size_t _count, const float _scale)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() == PixelPath::AVX2)
+    i = depthToUInt16Avx2(_src, _dst, _count, _scale);
+  if (pixelPath() != PixelPath::SCALAR)
+    i += depthToUInt16Sse2(_src + i, _dst + i, _count - i, _scale);
+#elif defined(GZ_PIXEL_NEON) && defined(__aarch64__)
+  i = depthToUInt16Neon(_src, _dst, _count, _scale);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    float value = _src[i] * _scale;
+    // Written so that NaN gives 0, as in the vector paths
+    if (!(value > 0.0f))
+      value = 0.0f;
+    else if (value > 65535.0f)
+      value = 65535.0f;
+    // lrint rounds to nearest even, as the vector conversions do
+    _dst[i] = static_cast<uint16_t>(std::lrint(value));
+  }
+}
+
+/////////////////////////////////////////////////
+void common::ClampDepth(float *_data, const std::size_t _count,
+    const float _near, const float _far)
+{
+  std::size_t i = 0;
+#if defined(GZ_PIXEL_X86)
+  if (pixelPath() == PixelPath::AVX2)
+    i = clampDepthAvx2(_data, _count, _near, _far);
+  if (pixelPath() != PixelPath::SCALAR)
+    i += clampDepthSse2(_data + i, _count - i, _near, _far);
+#elif defined(GZ_PIXEL_NEON)
+  i = clampDepthNeon(_data, _count, _near, _far);
+#endif
+
+  for (; i < _count; ++i)
+  {
+    if (_data[i] >= _far)
+      _data[i] = std::numeric_limits<float>::infinity();
+    else if (_data[i] <= _near)
+      _data[i] = -std::numeric_limits<float>::infinity();
+  }
+}
+
+/////////////////////////////////////////////////
+void common::ClampDepthHalf(uint16_t *_data, const std::size_t _count,
+    const float _near, const float _far)
+{
+  // Non negative half floats are ordered as their bits
+  const uint16_t nearBits = FloatToHalf(_near);
+  const uint16_t farBits = FloatToHalf(_far);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const uint16_t value = _data[i];
+    if ((value & 0x7fff) > 0x7c00)
+      continue;
+    if (!(value & 0x8000) && value >= farBits)
+      _data[i] = 0x7c00;
+    else if ((value & 0x8000) || value <= nearBits)
+      _data[i] = 0xfc00;
+  }
+}
+
+/////////////////////////////////////////////////
+uint16_t common::FloatToHalf(const float _value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &_value, sizeof(bits));
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  const uint32_t absBits = bits & 0x7fffffff;
+
+  // Infinities and NaN
+  if (absBits >= 0x7f800000)
+    return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x200 : 0);
+
+  // 65520 and above round beyond the largest half float
+  if (absBits >= 0x477ff000)
+    return sign | 0x7c00;
+
+  // Subnormal half floats, in steps of 2^-24
+  if (absBits < 0x38800000)
+  {
+    float absValue;
+    std::memcpy(&absValue, &absBits, sizeof(absValue));
+    return sign | static_cast<uint16_t>(std::lrint(absValue * 16777216.0f));
+  }
+
+  uint32_t half = (((absBits >> 23) - 112) << 10) | ((absBits >> 13) & 0x3ff);
+  const uint32_t rest = absBits & 0x1fff;
+  // A carry out of the mantissa increments the exponent, as it should
+  if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+    ++half;
+  return sign | static_cast<uint16_t>(half);
+}
+
+/////////////////////////////////////////////////
+float common::HalfToFloat(const uint16_t _half)
+{
+  const int exponent = (_half >> 10) & 0x1f;
+  const int mantissa = _half & 0x3ff;
+  float value;
+  if (exponent == 0)
+    value = std::ldexp(static_cast<float>(mantissa), -24);
+  else if (exponent == 31)
+  {
+    value = mantissa ? std::numeric_limits<float>::quiet_NaN() :
+        std::numeric_limits<float>::infinity();
+  }
+  else
+    value = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+  return (_half & 0x8000) ? -value : value;
+}
+
+/////////////////////////////////////////////////
+void common::HalfToFloat(const uint16_t *_src, float *_dst,
+    const std::size_t _count)
+{
+  for (std::size_t i = 0; i < _count; ++i)
+    _dst[i] = HalfToFloat(_src[i]);
+}
+
+/////////////////////////////////////////////////
+std::string common::PixelConvertPath()
+{
+  switch (pixelPath())
+  {
+    case PixelPath::AVX2:
+      return "avx2";
+    case PixelPath::SSSE3:
+      return "ssse3";
+    case PixelPath::NEON:
+      return "neon";
+    default:
+      return "scalar";
+  }
+}
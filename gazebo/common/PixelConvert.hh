@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PIXELCONVERT_HH_
+#define GAZEBO_COMMON_PIXELCONVERT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \addtogroup gazebo_common
+    /// \{
+
+    // The functions below convert buffers of pixels with the widest
+    // instruction set of the CPU: SSSE3 or AVX2 on x86, NEON on ARM, and
+    // plain loops elsewhere. Every path gives the same result. The
+    // source and destination must not overlap, unless stated otherwise.
+
+    /// \brief Swap the first and third channel of 3 byte pixels, which
+    /// converts RGB to BGR and BGR to RGB.
+    /// \param[in] _src Source pixels.
+    /// \param[out] _dst Destination pixels, which can be _src.
+    /// \param[in] _count Number of pixels.
+    GZ_COMMON_VISIBLE
+    void SwapRedBlue(const unsigned char *_src, unsigned char *_dst,
+                     const std::size_t _count);
+
+    /// \brief Swap the first and third channel of 4 byte pixels, which
+    /// converts RGBA to BGRA and BGRA to RGBA.
+    /// \param[in] _src Source pixels.
+    /// \param[out] _dst Destination pixels, which can be _src.
+    /// \param[in] _count Number of pixels.
+    GZ_COMMON_VISIBLE
+    void SwapRedBlueAlpha(const unsigned char *_src, unsigned char *_dst,
+                          const std::size_t _count);
+
+    /// \brief Drop the fourth channel of 4 byte pixels, which converts
+    /// RGBA to RGB.
+    /// \param[in] _src Source pixels.
+    /// \param[out] _dst Destination pixels, 3 bytes each.
+    /// \param[in] _count Number of pixels.
+    GZ_COMMON_VISIBLE
+    void RGBAToRGB(const unsigned char *_src, unsigned char *_dst,
+                   const std::size_t _count);
+
+    /// \brief Add a fourth channel to 3 byte pixels, which converts RGB
+    /// to RGBA.
+    /// \param[in] _src Source pixels.
+    /// \param[out] _dst Destination pixels, 4 bytes each.
+    /// \param[in] _count Number of pixels.
+    /// \param[in] _alpha Value of the new channel.
+    GZ_COMMON_VISIBLE
+    void RGBToRGBA(const unsigned char *_src, unsigned char *_dst,
+                   const std::size_t _count, const unsigned char _alpha = 255);
+
+    /// \brief Quantize depths to 16 bit integers, as in the 16UC1 depth
+    /// images of ROS. Values are rounded to the nearest integer and
+    /// clamped to [0, 65535]. NaN gives 0.
+    /// \param[in] _src Depths.
+    /// \param[out] _dst Quantized depths.
+    /// \param[in] _count Number of depths.
+    /// \param[in] _scale Factor applied before rounding, 1000 to convert
+    /// meters to millimeters.
+    GZ_COMMON_VISIBLE
+    void DepthToUInt16(const float *_src, uint16_t *_dst,
+                       const std::size_t _count, const float _scale);
+
+    /// \brief Mask depths outside of the clip distances, as per REP 117.
+    /// A depth at or beyond _far becomes +inf, otherwise a depth at or
+    /// before _near becomes -inf.
+    /// \param[in,out] _data Depths.
+    /// \param[in] _count Number of depths.
+    /// \param[in] _near Near clip distance.
+    /// \param[in] _far Far clip distance.
+    GZ_COMMON_VISIBLE
+    void ClampDepth(float *_data, const std::size_t _count,
+                    const float _near, const float _far);
+
+    /// \brief Mask half float depths outside of the clip distances, as
+    /// ClampDepth does for floats. The clip distances are rounded to half
+    /// floats before the comparisons. NaN is kept.
+    /// \param[in,out] _data Depths, as IEEE 754 half floats.
+    /// \param[in] _count Number of depths.
+    /// \param[in] _near Near clip distance.
+    /// \param[in] _far Far clip distance.
+    GZ_COMMON_VISIBLE
+    void ClampDepthHalf(uint16_t *_data, const std::size_t _count,
+                        const float _near, const float _far);
+
+    /// \brief Convert a float to an IEEE 754 half float, rounding to the
+    /// nearest even. Values beyond the half range become infinities.
+    /// \param[in] _value The float.
+    /// \return The half float.
+    GZ_COMMON_VISIBLE
+    uint16_t FloatToHalf(const float _value);
+
+    /// \brief Convert an IEEE 754 half float to a float, which is exact.
+    /// \param[in] _half The half float.
+    /// \return The float.
+    GZ_COMMON_VISIBLE
+    float HalfToFloat(const uint16_t _half);
+
+    /// \brief Convert IEEE 754 half floats to floats. This is a plain
+    /// loop on every CPU.
+    /// \param[in] _src Half floats.
+    /// \param[out] _dst Floats.
+    /// \param[in] _count Number of values.
+    GZ_COMMON_VISIBLE
+    void HalfToFloat(const uint16_t *_src, float *_dst,
+                     const std::size_t _count);
+
+    /// \brief Get the instruction set used by the conversions.
+    /// \return "avx2", "ssse3", "neon" or "scalar".
+    GZ_COMMON_VISIBLE
+    std::string PixelConvertPath();
+
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gazebo/common/PixelConvert.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PixelConvertTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Pixel counts that exercise the vector loops and their tails.
+static const std::size_t kCounts[] = {0, 1, 3, 5, 6, 7, 15, 16, 17, 33, 100};
+
+/////////////////////////////////////////////////
+static std::vector<unsigned char> pattern(const std::size_t _size)
+{
+  std::vector<unsigned char> data(_size);
+  for (std::size_t i = 0; i < _size; ++i)
+    data[i] = static_cast<unsigned char>(i * 7 + 3);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, Path)
+{
+  const std::string path = common::PixelConvertPath();
+  EXPECT_TRUE(path == "avx2" || path == "ssse3" || path == "neon" ||
+      path == "scalar");
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, SwapRedBlue)
+{
+  for (auto count : kCounts)
+  {
+    const std::vector<unsigned char> src = pattern(count * 3);
+    std::vector<unsigned char> dst(count * 3);
+    common::SwapRedBlue(src.data(), dst.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(dst[i * 3], src[i * 3 + 2]);
+      EXPECT_EQ(dst[i * 3 + 1], src[i * 3 + 1]);
+      EXPECT_EQ(dst[i * 3 + 2], src[i * 3]);
+    }
+
+    // Swapping in place twice restores the pixels
+    common::SwapRedBlue(dst.data(), dst.data(), count);
+    EXPECT_EQ(dst, src);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, SwapRedBlueAlpha)
+{
+  for (auto count : kCounts)
+  {
+    const std::vector<unsigned char> src = pattern(count * 4);
+    std::vector<unsigned char> dst(count * 4);
+    common::SwapRedBlueAlpha(src.data(), dst.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(dst[i * 4], src[i * 4 + 2]);
+      EXPECT_EQ(dst[i * 4 + 1], src[i * 4 + 1]);
+      EXPECT_EQ(dst[i * 4 + 2], src[i * 4]);
+      EXPECT_EQ(dst[i * 4 + 3], src[i * 4 + 3]);
+    }
+
+    common::SwapRedBlueAlpha(dst.data(), dst.data(), count);
+    EXPECT_EQ(dst, src);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, Packing)
+{
+  for (auto count : kCounts)
+  {
+    const std::vector<unsigned char> rgba = pattern(count * 4);
+    std::vector<unsigned char> rgb(count * 3);
+    common::RGBAToRGB(rgba.data(), rgb.data(), count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(rgb[i * 3], rgba[i * 4]);
+      EXPECT_EQ(rgb[i * 3 + 1], rgba[i * 4 + 1]);
+      EXPECT_EQ(rgb[i * 3 + 2], rgba[i * 4 + 2]);
+    }
+
+    std::vector<unsigned char> out(count * 4);
+    common::RGBToRGBA(rgb.data(), out.data(), count, 42);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      EXPECT_EQ(out[i * 4], rgb[i * 3]);
+      EXPECT_EQ(out[i * 4 + 1], rgb[i * 3 + 1]);
+      EXPECT_EQ(out[i * 4 + 2], rgb[i * 3 + 2]);
+      EXPECT_EQ(out[i * 4 + 3], 42);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, DepthToUInt16)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  const std::vector<float> special = {0.0f, -0.0f, -1.0f, 0.0004f, 0.0016f,
+      0.0026f, 1.2344f, 65.535f, 65.536f, 1e9f, inf, -inf,
+      std::numeric_limits<float>::quiet_NaN()};
+  const std::vector<uint16_t> expected = {0, 0, 0, 0, 2, 3, 1234, 65535,
+      65535, 65535, 65535, 0, 0};
+
+  // Repeat the values so that they land in every lane and in the tail
+  std::vector<float> src;
+  std::vector<uint16_t> result;
+  for (int i = 0; i < 5; ++i)
+  {
+    src.insert(src.end(), special.begin(), special.end());
+    result.insert(result.end(), expected.begin(), expected.end());
+  }
+
+  std::vector<uint16_t> dst(src.size());
+  common::DepthToUInt16(src.data(), dst.data(), src.size(), 1000.0f);
+  EXPECT_EQ(dst, result);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, ClampDepth)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  for (auto count : kCounts)
+  {
+    std::vector<float> data(count);
+    for (std::size_t i = 0; i < count; ++i)
+      data[i] = static_cast<float>(i % 12);
+
+    common::ClampDepth(data.data(), count, 2.0f, 9.0f);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const float value = static_cast<float>(i % 12);
+      if (value >= 9.0f)
+        EXPECT_EQ(data[i], inf);
+      else if (value <= 2.0f)
+        EXPECT_EQ(data[i], -inf);
+      else
+        EXPECT_EQ(data[i], value);
+    }
+  }
+
+  // The far clip wins when the clip distances cross
+  std::vector<float> data(20, 5.0f);
+  common::ClampDepth(data.data(), data.size(), 6.0f, 4.0f);
+  for (auto value : data)
+    EXPECT_EQ(value, inf);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, HalfFloat)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(common::FloatToHalf(0.0f), 0x0000u);
+  EXPECT_EQ(common::FloatToHalf(-0.0f), 0x8000u);
+  EXPECT_EQ(common::FloatToHalf(1.0f), 0x3c00u);
+  EXPECT_EQ(common::FloatToHalf(-2.0f), 0xc000u);
+  EXPECT_EQ(common::FloatToHalf(65504.0f), 0x7bffu);
+  EXPECT_EQ(common::FloatToHalf(65520.0f), 0x7c00u);
+  EXPECT_EQ(common::FloatToHalf(inf), 0x7c00u);
+  EXPECT_EQ(common::FloatToHalf(-inf), 0xfc00u);
+  EXPECT_EQ(common::FloatToHalf(std::ldexp(1.0f, -24)), 0x0001u);
+
+  // Ties round to the even mantissa
+  EXPECT_EQ(common::FloatToHalf(1.0f + std::ldexp(1.0f, -11)), 0x3c00u);
+  EXPECT_EQ(common::FloatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)), 0x3c02u);
+
+  EXPECT_TRUE(std::isnan(common::HalfToFloat(common::FloatToHalf(
+      std::numeric_limits<float>::quiet_NaN()))));
+
+  // Every finite half float survives a round trip
+  std::vector<uint16_t> halves;
+  for (uint32_t h = 0; h <= 0xffff; ++h)
+  {
+    if ((h & 0x7c00) != 0x7c00)
+      halves.push_back(static_cast<uint16_t>(h));
+  }
+  std::vector<float> floats(halves.size());
+  common::HalfToFloat(halves.data(), floats.data(), halves.size());
+  for (std::size_t i = 0; i < halves.size(); ++i)
+  {
+    EXPECT_EQ(floats[i], common::HalfToFloat(halves[i]));
+    EXPECT_EQ(common::FloatToHalf(floats[i]), halves[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(PixelConvertTest, ClampDepthHalf)
+{
+  std::vector<uint16_t> data;
+  for (int i = 0; i < 12; ++i)
+    data.push_back(common::FloatToHalf(static_cast<float>(i)));
+  data.push_back(common::FloatToHalf(-1.0f));
+
+  common::ClampDepthHalf(data.data(), data.size(), 2.0f, 9.0f);
+  for (int i = 0; i < 12; ++i)
+  {
+    if (i >= 9)
+      EXPECT_EQ(data[i], 0x7c00u);
+    else if (i <= 2)
+      EXPECT_EQ(data[i], 0xfc00u);
+    else
+      EXPECT_EQ(common::HalfToFloat(data[i]), static_cast<float>(i));
+  }
+  EXPECT_EQ(data.back(), 0xfc00u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
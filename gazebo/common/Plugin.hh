@@ -28,6 +28,8 @@
 #include <dlfcn.h>
 
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
 
 #include <sdf/sdf.hh>
@@ -37,6 +39,7 @@
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/StartupProfiler.hh"
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/sensors/SensorTypes.hh"
@@ -114,6 +117,8 @@ namespace gazebo
     public: static TPtr Create(const std::string &_filename,
                 const std::string &_name)
             {
+              common::StartupScope startupScope("Plugin::Create",
+                  _filename);
               TPtr result;
               // PluginPtr result;
               struct stat st;
@@ -122,6 +127,8 @@ namespace gazebo
               std::list<std::string>::iterator iter;
               std::list<std::string> pluginPaths =
                 common::SystemPaths::Instance()->GetPluginPaths();
+              fptr_union_t registerFunc;
+              void *dlHandle = nullptr;
 
 #ifdef __APPLE__
               // This is a hack to work around issue #800,
@@ -153,40 +160,63 @@ namespace gazebo
               }
 #endif  // ifdef __APPLE__
 
-              for (iter = pluginPaths.begin();
-                   iter!= pluginPaths.end(); ++iter)
+              // Reuse the library of an earlier instance, unless the plugin
+              // paths changed since it was resolved
               {
-                fullname = (*iter)+std::string("/")+filename;
-                fullname = boost::filesystem::path(fullname)
-                    .make_preferred().string();
-                if (stat(fullname.c_str(), &st) == 0)
+                std::lock_guard<std::mutex> lock(LibrariesMutex());
+                auto library = Libraries().find(filename);
+                if (library != Libraries().end() &&
+                    library->second.pluginPaths == pluginPaths)
                 {
-                  found = true;
-                  break;
+                  fullname = library->second.fullname;
+                  dlHandle = library->second.dlHandle;
+                  registerFunc.ptr = library->second.registerFunc;
                 }
               }
 
-              if (!found)
-                fullname = filename;
-
-              fptr_union_t registerFunc;
-              std::string registerName = "RegisterPlugin";
-
-              void *dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
               if (!dlHandle)
               {
-                gzerr << "Failed to load plugin " << fullname << ": "
-                  << dlerror() << "\n";
-                return result;
-              }
+                for (iter = pluginPaths.begin();
+                     iter!= pluginPaths.end(); ++iter)
+                {
+                  fullname = (*iter)+std::string("/")+filename;
+                  fullname = boost::filesystem::path(fullname)
+                      .make_preferred().string();
+                  if (stat(fullname.c_str(), &st) == 0)
+                  {
+                    found = true;
+                    break;
+                  }
+                }
 
-              registerFunc.ptr = dlsym(dlHandle, registerName.c_str());
+                if (!found)
+                  fullname = filename;
 
-              if (!registerFunc.ptr)
-              {
-                gzerr << "Failed to resolve " << registerName
-                      << ": " << dlerror();
-                return result;
+                std::string registerName = "RegisterPlugin";
+
+                dlHandle = dlopen(fullname.c_str(), RTLD_LAZY|RTLD_GLOBAL);
+                if (!dlHandle)
+                {
+                  gzerr << "Failed to load plugin " << fullname << ": "
+                    << dlerror() << "\n";
+                  return result;
+                }
+
+                registerFunc.ptr = dlsym(dlHandle, registerName.c_str());
+
+                if (!registerFunc.ptr)
+                {
+                  gzerr << "Failed to resolve " << registerName
+                        << ": " << dlerror();
+                  return result;
+                }
+
+                std::lock_guard<std::mutex> lock(LibrariesMutex());
+                Library &library = Libraries()[filename];
+                library.pluginPaths = pluginPaths;
+                library.fullname = fullname;
+                library.dlHandle = dlHandle;
+                library.registerFunc = registerFunc.ptr;
               }
 
               // Register the new controller.
@@ -269,6 +299,38 @@ namespace gazebo
 
     /// \brief Handle used for closing the dynamic library.
     private: void *dlHandle;
+
+    /// \brief A library resolved and opened by Create.
+    private: class Library
+             {
+               /// \brief Plugin paths the library was resolved with.
+               public: std::list<std::string> pluginPaths;
+
+               /// \brief Full path of the library.
+               public: std::string fullname;
+
+               /// \brief Handle of the library, which is never closed.
+               public: void *dlHandle = nullptr;
+
+               /// \brief Registration function of the library.
+               public: void *registerFunc = nullptr;
+             };
+
+    /// \brief Get the libraries opened by Create, by filename.
+    /// \return The libraries.
+    private: static std::map<std::string, Library> &Libraries()
+             {
+               static std::map<std::string, Library> libraries;
+               return libraries;
+             }
+
+    /// \brief Get the mutex that protects Libraries().
+    /// \return The mutex.
+    private: static std::mutex &LibrariesMutex()
+             {
+               static std::mutex mutex;
+               return mutex;
+             }
   };
 
   /// \class WorldPlugin Plugin.hh common/common.hh
@@ -323,6 +385,14 @@ namespace gazebo
 
     /// \brief Override this method for custom plugin reset behavior.
     public: virtual void Reset() {}
+
+    /// \brief Override this method to allow the Load of the plugin to run
+    /// concurrently with the Load of other such plugins, when the
+    /// "plugin_load_threads" physics parameter is larger than 1. Load must
+    /// then only touch its own model and state. Init is still called
+    /// serially, after all the plugins are loaded.
+    /// \return True if Load can run concurrently.
+    public: virtual bool ConcurrentLoad() const {return false;}
   };
 
   /// \class SensorPlugin Plugin.hh common/common.hh
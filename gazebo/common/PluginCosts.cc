@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include "gazebo/common/PluginCosts.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the PluginCost class.
+    class PluginCostPrivate
+    {
+      /// \brief Name of the plugin.
+      public: std::string name;
+
+      /// \brief Library of the plugin.
+      public: std::string filename;
+
+      /// \brief Number of callbacks.
+      public: std::atomic<uint64_t> calls{0};
+
+      /// \brief Wall time of the callbacks in nanoseconds.
+      public: std::atomic<int64_t> updateTime{0};
+
+      /// \brief Longest callback in nanoseconds.
+      public: std::atomic<int64_t> maxTime{0};
+
+      /// \brief Wall time of the load in nanoseconds.
+      public: std::atomic<int64_t> loadTime{0};
+    };
+
+    /// \internal
+    /// \brief Private data for the PluginCosts class.
+    class PluginCostsPrivate
+    {
+      /// \brief Accounts, by name.
+      public: std::map<std::string, std::unique_ptr<PluginCost>> accounts;
+
+      /// \brief Protects the accounts.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief True if the callbacks are timed.
+static std::atomic<bool> g_pluginCostsEnabled{false};
+
+/// \brief Plugin of the innermost scope of the thread.
+static thread_local PluginCost *g_pluginCostScope = nullptr;
+
+/////////////////////////////////////////////////
+/// \brief Get the nanoseconds since a time point.
+/// \param[in] _start The time point.
+/// \return Wall time in nanoseconds.
+static int64_t nanosecondsSince(
+    const std::chrono::steady_clock::time_point &_start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - _start).count();
+}
+
+/////////////////////////////////////////////////
+PluginCost::PluginCost(const std::string &_name, const std::string &_filename)
+  : dataPtr(new PluginCostPrivate)
+{
+  this->dataPtr->name = _name;
+  this->dataPtr->filename = _filename;
+}
+
+/////////////////////////////////////////////////
+PluginCost::~PluginCost()
+{
+}
+
+/////////////////////////////////////////////////
+void PluginCost::AddCall(const int64_t _nanoseconds)
+{
+  this->dataPtr->calls.fetch_add(1, std::memory_order_relaxed);
+  this->dataPtr->updateTime.fetch_add(_nanoseconds,
+      std::memory_order_relaxed);
+
+  int64_t max = this->dataPtr->maxTime.load(std::memory_order_relaxed);
+  while (_nanoseconds > max && !this->dataPtr->maxTime.compare_exchange_weak(
+      max, _nanoseconds, std::memory_order_relaxed))
+  {
+  }
+}
+
+/////////////////////////////////////////////////
+void PluginCost::AddLoad(const int64_t _nanoseconds)
+{
+  this->dataPtr->loadTime.fetch_add(_nanoseconds, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+PluginCostSample PluginCost::Sample() const
+{
+  PluginCostSample sample;
+  sample.name = this->dataPtr->name;
+  sample.filename = this->dataPtr->filename;
+  sample.calls = this->dataPtr->calls;
+  sample.updateTime = this->dataPtr->updateTime * 1e-9;
+  sample.maxTime = this->dataPtr->maxTime * 1e-9;
+  sample.loadTime = this->dataPtr->loadTime * 1e-9;
+  return sample;
+}
+
+/////////////////////////////////////////////////
+void PluginCost::Reset()
+{
+  this->dataPtr->calls = 0;
+  this->dataPtr->updateTime = 0;
+  this->dataPtr->maxTime = 0;
+}
+
+/////////////////////////////////////////////////
+PluginCostScope::PluginCostScope(const std::string &_name,
+    const std::string &_filename)
+  : account(&PluginCosts::Instance()->Account(_name, _filename)),
+    previous(g_pluginCostScope), start(std::chrono::steady_clock::now())
+{
+  g_pluginCostScope = this->account;
+}
+
+/////////////////////////////////////////////////
+PluginCostScope::~PluginCostScope()
+{
+  g_pluginCostScope = this->previous;
+  this->account->AddLoad(nanosecondsSince(this->start));
+}
+
+/////////////////////////////////////////////////
+PluginCost *PluginCostScope::Current()
+{
+  return g_pluginCostScope;
+}
+
+/////////////////////////////////////////////////
+PluginCostTimer::PluginCostTimer(PluginCost &_account)
+  : account(_account), start(std::chrono::steady_clock::now())
+{
+}
+
+/////////////////////////////////////////////////
+PluginCostTimer::~PluginCostTimer()
+{
+  this->account.AddCall(nanosecondsSince(this->start));
+}
+
+/////////////////////////////////////////////////
+PluginCosts::PluginCosts()
+  : dataPtr(new PluginCostsPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PluginCosts::~PluginCosts()
+{
+}
+
+/////////////////////////////////////////////////
+PluginCost &PluginCosts::Account(const std::string &_name,
+    const std::string &_filename)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &account = this->dataPtr->accounts[_name];
+  if (!account)
+    account.reset(new PluginCost(_name, _filename));
+  return *account;
+}
+
+/////////////////////////////////////////////////
+void PluginCosts::SetEnabled(const bool _enabled)
+{
+  g_pluginCostsEnabled = _enabled;
+}
+
+/////////////////////////////////////////////////
+bool PluginCosts::Enabled()
+{
+  return g_pluginCostsEnabled.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+std::vector<PluginCostSample> PluginCosts::Top(const unsigned int _count)
+    const
+{
+  std::vector<PluginCostSample> result;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    result.reserve(this->dataPtr->accounts.size());
+    for (auto const &account : this->dataPtr->accounts)
+      result.push_back(account.second->Sample());
+  }
+
+  std::stable_sort(result.begin(), result.end(),
+      [](const PluginCostSample &_a, const PluginCostSample &_b)
+      {
+        return _a.updateTime > _b.updateTime;
+      });
+  if (result.size() > _count)
+    result.resize(_count);
+  return result;
+}
+
+/////////////////////////////////////////////////
+void PluginCosts::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &account : this->dataPtr->accounts)
+    account.second->Reset();
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_PLUGINCOSTS_HH_
+#define GAZEBO_COMMON_PLUGINCOSTS_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, PluginCosts)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data classes.
+    class PluginCostPrivate;
+    class PluginCostsPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief Values of a plugin cost account at one time.
+    class GZ_COMMON_VISIBLE PluginCostSample
+    {
+      /// \brief Name of the plugin, scoped by its owner, such as
+      /// "default::pioneer::diff_drive".
+      public: std::string name;
+
+      /// \brief Library of the plugin.
+      public: std::string filename;
+
+      /// \brief Number of event callbacks run.
+      public: uint64_t calls = 0;
+
+      /// \brief Wall time of the callbacks in seconds.
+      public: double updateTime = 0;
+
+      /// \brief Longest callback in seconds.
+      public: double maxTime = 0;
+
+      /// \brief Wall time of the creation, load and init of the plugin in
+      /// seconds.
+      public: double loadTime = 0;
+    };
+
+    /// \class PluginCost PluginCosts.hh common/common.hh
+    /// \brief The wall time spent in the event callbacks of a plugin. The
+    /// counters are atomic, so any thread can report.
+    class GZ_COMMON_VISIBLE PluginCost
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the plugin.
+      /// \param[in] _filename Library of the plugin.
+      public: PluginCost(const std::string &_name,
+                  const std::string &_filename);
+
+      /// \brief Destructor.
+      public: virtual ~PluginCost();
+
+      /// \brief Add a callback.
+      /// \param[in] _nanoseconds Wall time of the callback.
+      public: void AddCall(const int64_t _nanoseconds);
+
+      /// \brief Add to the load time.
+      /// \param[in] _nanoseconds Wall time of the load.
+      public: void AddLoad(const int64_t _nanoseconds);
+
+      /// \brief Get the values of the account.
+      /// \return The values.
+      public: PluginCostSample Sample() const;
+
+      /// \brief Reset the callback counters.
+      public: void Reset();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PluginCostPrivate> dataPtr;
+    };
+
+    /// \class PluginCostScope PluginCosts.hh common/common.hh
+    /// \brief Attributes to a plugin the event connections made on the
+    /// calling thread while the scope lives, and adds the wall time of the
+    /// scope to its load time. The owners of plugins open one around the
+    /// creation, load and init of each plugin. Scopes nest.
+    class GZ_COMMON_VISIBLE PluginCostScope
+    {
+      /// \brief Constructor.
+      /// \param[in] _name Name of the plugin, scoped by its owner.
+      /// \param[in] _filename Library of the plugin.
+      public: PluginCostScope(const std::string &_name,
+                  const std::string &_filename);
+
+      /// \brief Destructor.
+      public: ~PluginCostScope();
+
+      /// \brief Get the plugin of the innermost scope of the calling
+      /// thread.
+      /// \return The account, null outside of a scope.
+      public: static PluginCost *Current();
+
+      /// \brief The account of the plugin.
+      private: PluginCost *account;
+
+      /// \brief The account of the enclosing scope.
+      private: PluginCost *previous;
+
+      /// \brief Start of the scope.
+      private: std::chrono::steady_clock::time_point start;
+    };
+
+    /// \class PluginCostTimer PluginCosts.hh common/common.hh
+    /// \brief Adds the wall time of its scope as a callback of a plugin.
+    class GZ_COMMON_VISIBLE PluginCostTimer
+    {
+      /// \brief Constructor.
+      /// \param[in] _account The account of the plugin.
+      public: explicit PluginCostTimer(PluginCost &_account);
+
+      /// \brief Destructor.
+      public: ~PluginCostTimer();
+
+      /// \brief The account of the plugin.
+      private: PluginCost &account;
+
+      /// \brief Start of the callback.
+      private: std::chrono::steady_clock::time_point start;
+    };
+
+    /// \class PluginCosts PluginCosts.hh common/common.hh
+    /// \brief Registry of the cost accounts of the plugins. Event
+    /// connections remember the plugin that made them, and once enabled,
+    /// event::EventT times their callbacks. The time of a callback
+    /// includes that of the callbacks of the events it signals.
+    class GZ_COMMON_VISIBLE PluginCosts
+      : public SingletonT<PluginCosts>
+    {
+      /// \brief Constructor.
+      private: PluginCosts();
+
+      /// \brief Destructor.
+      private: virtual ~PluginCosts();
+
+      /// \brief Get an account, created on first use. Accounts live as
+      /// long as the registry, so the reference can be kept.
+      /// \param[in] _name Name of the plugin, scoped by its owner.
+      /// \param[in] _filename Library of the plugin.
+      /// \return The account.
+      public: PluginCost &Account(const std::string &_name,
+                  const std::string &_filename);
+
+      /// \brief Enable or disable the timing of the callbacks. The
+      /// connections are attributed either way.
+      /// \param[in] _enabled True to time the callbacks.
+      public: static void SetEnabled(const bool _enabled);
+
+      /// \brief Get whether the callbacks are timed.
+      /// \return True if they are.
+      public: static bool Enabled();
+
+      /// \brief Get the most costly plugins.
+      /// \param[in] _count Largest number of plugins.
+      /// \return The values, from the longest update time.
+      public: std::vector<PluginCostSample> Top(const unsigned int _count)
+                  const;
+
+      /// \brief Reset the callback counters of all the accounts.
+      public: void Reset();
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PluginCostsPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<PluginCosts>;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/PluginCosts.hh"
+#include "gazebo/common/Time.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class PluginCostsTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the sample of a plugin.
+/// \param[in] _name Name of the plugin.
+/// \return The sample, empty if not found.
+static common::PluginCostSample sample(const std::string &_name)
+{
+  for (auto const &s : common::PluginCosts::Instance()->Top(100))
+  {
+    if (s.name == _name)
+      return s;
+  }
+  return common::PluginCostSample();
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginCostsTest, Scope)
+{
+  EXPECT_TRUE(common::PluginCostScope::Current() == nullptr);
+  {
+    common::PluginCostScope outer("world::outer", "libouter.so");
+    common::PluginCost *outerCost = common::PluginCostScope::Current();
+    ASSERT_TRUE(outerCost != nullptr);
+    {
+      common::PluginCostScope inner("world::inner", "libinner.so");
+      EXPECT_NE(outerCost, common::PluginCostScope::Current());
+      common::Time::MSleep(5);
+    }
+    EXPECT_EQ(outerCost, common::PluginCostScope::Current());
+  }
+  EXPECT_TRUE(common::PluginCostScope::Current() == nullptr);
+
+  // The loads nest, the inner one is part of the outer one.
+  common::PluginCostSample outer = sample("world::outer");
+  common::PluginCostSample inner = sample("world::inner");
+  EXPECT_EQ("libouter.so", outer.filename);
+  EXPECT_GE(inner.loadTime, 0.004);
+  EXPECT_GE(outer.loadTime, inner.loadTime);
+  EXPECT_EQ(0u, outer.calls);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PluginCostsTest, Callbacks)
+{
+  event::EventT<void (int)> event;
+  int sum = 0;
+
+  event::ConnectionPtr slow, fast, anonymous;
+  {
+    common::PluginCostScope scope("world::slow", "libslow.so");
+    slow = event.Connect([&sum](int _v)
+        {
+          sum += _v;
+          common::Time::MSleep(2);
+        });
+  }
+  {
+    common::PluginCostScope scope("world::fast", "libfast.so");
+    fast = event.Connect([&sum](int _v)
+        {
+          sum += _v;
+        });
+  }
+  anonymous = event.Connect([&sum](int _v)
+      {
+        sum += _v;
+      });
+
+  // Not timed until enabled
+  event(1);
+  EXPECT_EQ(3, sum);
+  EXPECT_EQ(0u, sample("world::slow").calls);
+
+  common::PluginCosts::SetEnabled(true);
+  EXPECT_TRUE(common::PluginCosts::Enabled());
+  for (int i = 0; i < 3; ++i)
+    event(1);
+  common::PluginCosts::SetEnabled(false);
+  EXPECT_EQ(12, sum);
+
+  common::PluginCostSample slowSample = sample("world::slow");
+  common::PluginCostSample fastSample = sample("world::fast");
+  EXPECT_EQ(3u, slowSample.calls);
+  EXPECT_EQ(3u, fastSample.calls);
+  EXPECT_GE(slowSample.updateTime, 0.005);
+  EXPECT_GE(slowSample.maxTime, 0.0015);
+  EXPECT_LT(fastSample.updateTime, slowSample.updateTime);
+
+  // The most costly first
+  auto top = common::PluginCosts::Instance()->Top(1);
+  ASSERT_EQ(1u, top.size());
+  EXPECT_EQ("world::slow", top[0].name);
+
+  common::PluginCosts::Instance()->Reset();
+  EXPECT_EQ(0u, sample("world::slow").calls);
+  EXPECT_DOUBLE_EQ(0.0, sample("world::slow").updateTime);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
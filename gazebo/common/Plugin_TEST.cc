@@ -58,6 +58,23 @@ TEST_F(PluginTest, LoadModelPlugin)
   EXPECT_EQ(plugin->GetHandle(), "pluginInterfaceTest");
 }
 
+TEST_F(PluginTest, LoadModelPluginTwice)
+{
+  // The second instance reuses the library resolved by the first
+  ModelPluginPtr first = ModelPlugin::Create("libBuoyancyPlugin.so",
+                                             "first");
+  ModelPluginPtr second = ModelPlugin::Create("libBuoyancyPlugin.so",
+                                              "second");
+  ASSERT_TRUE(first != nullptr);
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_NE(first, second);
+
+  EXPECT_EQ(second->GetType(), PluginType::MODEL_PLUGIN);
+  EXPECT_EQ(second->GetFilename(), first->GetFilename());
+  EXPECT_EQ(second->GetHandle(), "second");
+  EXPECT_FALSE(second->ConcurrentLoad());
+}
+
 TEST_F(PluginTest, LoadWorldPlugin)
 {
   WorldPluginPtr plugin = WorldPlugin::Create("libArrangePlugin.so",
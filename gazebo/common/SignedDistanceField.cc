@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/TriangleBVH.hh"
+#include "gazebo/common/SignedDistanceField.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Largest number of cells along an axis.
+static const unsigned int kMaxCells = 128;
+
+/// \brief Number of cells between the mesh and the border of the grid.
+static const unsigned int kPaddingCells = 2;
+
+/// \brief Number of cells along the largest extent of a mesh, when no
+/// resolution is given.
+static const unsigned int kDefaultCells = 64;
+
+/// \brief Largest number of surfaces crossed by a ray along the grid.
+static const unsigned int kMaxCrossings = 4096;
+
+/// \brief Private data for the SignedDistanceField class
+class gazebo::common::SignedDistanceFieldPrivate
+{
+  /// \brief Get the index of a sample.
+  /// \param[in] _x Index along x.
+  /// \param[in] _y Index along y.
+  /// \param[in] _z Index along z.
+  /// \return Index in the values.
+  public: std::size_t Index(const unsigned int _x, const unsigned int _y,
+              const unsigned int _z) const
+  {
+    return (static_cast<std::size_t>(_z) * this->size.Y() + _y) *
+        this->size.X() + _x;
+  }
+
+  /// \brief Position of the first sample.
+  public: ignition::math::Vector3d origin;
+
+  /// \brief Distance between neighbor samples.
+  public: double resolution = 0;
+
+  /// \brief Number of samples along each axis.
+  public: ignition::math::Vector3<unsigned int> size;
+
+  /// \brief Samples, x varying fastest.
+  public: std::vector<float> values;
+};
+
+//////////////////////////////////////////////////
+SignedDistanceField::SignedDistanceField()
+  : dataPtr(new SignedDistanceFieldPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+SignedDistanceField::~SignedDistanceField()
+{
+}
+
+//////////////////////////////////////////////////
+/// \brief Count the surfaces a ray crosses before each sample of a line of
+/// the grid, and add a vote to the samples after an odd number.
+/// \param[in] _bvh Triangles of the mesh.
+/// \param[in] _start Origin of the ray, one cell before the first sample.
+/// \param[in] _dir Unit direction of the line.
+/// \param[in] _resolution Distance between the samples.
+/// \param[in] _count Number of samples of the line.
+/// \param[in] _first Index of the vote of the first sample.
+/// \param[in] _stride Distance between the votes of neighbor samples.
+/// \param[in,out] _votes Votes of the samples.
+static void voteLine(const TriangleBVH &_bvh,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _resolution,
+    const unsigned int _count, const std::size_t _first,
+    const std::size_t _stride, std::vector<uint8_t> &_votes)
+{
+  const double end = _resolution * (_count + 1);
+  const double epsilon = _resolution * 1e-6;
+  std::vector<double> crossings;
+  double t = 0;
+  double distance;
+  unsigned int triangle;
+  while (crossings.size() < kMaxCrossings &&
+      _bvh.Intersect(_start + _dir * t, _dir, false, distance, triangle))
+  {
+    t += distance;
+    if (t > end)
+      break;
+    crossings.push_back(t);
+    t += epsilon;
+  }
+
+  std::size_t crossed = 0;
+  for (unsigned int k = 0; k < _count; ++k)
+  {
+    const double s = _resolution * (k + 1);
+    while (crossed < crossings.size() && crossings[crossed] < s)
+      ++crossed;
+    if (crossed % 2 == 1)
+      ++_votes[_first + k * _stride];
+  }
+}
+
+//////////////////////////////////////////////////
+bool SignedDistanceField::Build(const Mesh &_mesh,
+    const ignition::math::Vector3d &_scale, const double _resolution)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < _mesh.GetSubMeshCount(); ++i)
+  {
+    const SubMesh *subMesh = _mesh.GetSubMesh(i);
+    if (subMesh->GetPrimitiveType() != SubMesh::TRIANGLES)
+      continue;
+
+    const unsigned int offset = vertices.size();
+    for (unsigned int j = 0; j < subMesh->GetVertexCount(); ++j)
+      vertices.push_back(subMesh->Vertex(j) * _scale);
+    for (unsigned int j = 0; j < subMesh->GetIndexCount(); ++j)
+      indices.push_back(offset + subMesh->GetIndex(j));
+  }
+
+  TriangleBVH bvh;
+  bvh.Build(vertices, indices);
+  if (bvh.TriangleCount() == 0)
+    return false;
+
+  ignition::math::Vector3d min = bvh.Triangle(0)[0];
+  ignition::math::Vector3d max = min;
+  for (unsigned int i = 0; i < bvh.TriangleCount(); ++i)
+  {
+    const ignition::math::Triangle3d tri = bvh.Triangle(i);
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      min.Min(tri[j]);
+      max.Max(tri[j]);
+    }
+  }
+
+  const ignition::math::Vector3d extent = max - min;
+  const double largest = std::max(extent.Max(), 1e-6);
+  double resolution = _resolution > 0 ? _resolution : largest / kDefaultCells;
+  resolution = std::max(resolution,
+      largest / (kMaxCells - 2 * kPaddingCells));
+
+  ignition::math::Vector3<unsigned int> size;
+  for (int i = 0; i < 3; ++i)
+  {
+    size[i] = static_cast<unsigned int>(
+        std::ceil(extent[i] / resolution - 1e-9)) +
+        2 * kPaddingCells + 1;
+  }
+  const ignition::math::Vector3d origin =
+      min - ignition::math::Vector3d::One * (kPaddingCells * resolution);
+
+  this->dataPtr->origin = origin;
+  this->dataPtr->resolution = resolution;
+  this->dataPtr->size = size;
+  this->dataPtr->values.assign(
+      static_cast<std::size_t>(size.X()) * size.Y() * size.Z(), 0);
+
+  // Vote for the sign along each axis. The rays are moved off the grid
+  // lines, so that they don't follow the edges of axis aligned meshes.
+  std::vector<uint8_t> votes(this->dataPtr->values.size(), 0);
+  const ignition::math::Vector3d jitter(0.37, 0.61, 0.23);
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const int u = (axis + 1) % 3;
+    const int v = (axis + 2) % 3;
+    ignition::math::Vector3d dir;
+    dir[axis] = 1;
+
+    ignition::math::Vector3<std::size_t> strides(1, size.X(),
+        static_cast<std::size_t>(size.X()) * size.Y());
+    for (unsigned int j = 0; j < size[v]; ++j)
+    {
+      for (unsigned int i = 0; i < size[u]; ++i)
+      {
+        ignition::math::Vector3d start = origin;
+        start[axis] -= resolution;
+        start[u] += resolution * (i + jitter[u] * 1e-3);
+        start[v] += resolution * (j + jitter[v] * 1e-3);
+        voteLine(bvh, start, dir, resolution, size[axis],
+            i * strides[u] + j * strides[v], strides[axis], votes);
+      }
+    }
+  }
+
+  // The distances to the triangles are the costly part
+  SignedDistanceFieldPrivate *data = this->dataPtr.get();
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0, size.Z()),
+      [&](const tbb::blocked_range<unsigned int> &_range)
+  {
+    double distance;
+    unsigned int triangle;
+    ignition::math::Vector3d closest;
+    for (unsigned int z = _range.begin(); z != _range.end(); ++z)
+    {
+      for (unsigned int y = 0; y < size.Y(); ++y)
+      {
+        for (unsigned int x = 0; x < size.X(); ++x)
+        {
+          const ignition::math::Vector3d p =
+              origin + ignition::math::Vector3d(x, y, z) * resolution;
+          bvh.Closest(p, distance, triangle, closest);
+          const std::size_t index = data->Index(x, y, z);
+          data->values[index] = static_cast<float>(
+              votes[index] >= 2 ? -distance : distance);
+        }
+      }
+    }
+  });
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SignedDistanceField::Set(const ignition::math::Vector3d &_origin,
+    const double _resolution,
+    const ignition::math::Vector3<unsigned int> &_size,
+    const std::vector<float> &_values)
+{
+  if (_resolution <= 0 || _size.X() < 2 || _size.Y() < 2 || _size.Z() < 2 ||
+      static_cast<std::size_t>(_size.X()) * _size.Y() * _size.Z() !=
+      _values.size())
+  {
+    return false;
+  }
+
+  this->dataPtr->origin = _origin;
+  this->dataPtr->resolution = _resolution;
+  this->dataPtr->size = _size;
+  this->dataPtr->values = _values;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SignedDistanceField::Valid() const
+{
+  return !this->dataPtr->values.empty();
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d SignedDistanceField::Origin() const
+{
+  return this->dataPtr->origin;
+}
+
+//////////////////////////////////////////////////
+double SignedDistanceField::Resolution() const
+{
+  return this->dataPtr->resolution;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3<unsigned int> SignedDistanceField::Size() const
+{
+  return this->dataPtr->size;
+}
+
+//////////////////////////////////////////////////
+const std::vector<float> &SignedDistanceField::Values() const
+{
+  return this->dataPtr->values;
+}
+
+//////////////////////////////////////////////////
+ignition::math::AxisAlignedBox SignedDistanceField::Box() const
+{
+  const ignition::math::Vector3<unsigned int> &size = this->dataPtr->size;
+  return ignition::math::AxisAlignedBox(this->dataPtr->origin,
+      this->dataPtr->origin + ignition::math::Vector3d(
+        size.X() - 1.0, size.Y() - 1.0, size.Z() - 1.0) *
+      this->dataPtr->resolution);
+}
+
+//////////////////////////////////////////////////
+double SignedDistanceField::Distance(
+    const ignition::math::Vector3d &_point) const
+{
+  if (this->dataPtr->values.empty())
+    return 0;
+
+  // Cell of the point clamped to the grid, and the position in the cell
+  const ignition::math::Vector3<unsigned int> &size = this->dataPtr->size;
+  const ignition::math::Vector3d local =
+      (_point - this->dataPtr->origin) / this->dataPtr->resolution;
+  unsigned int cell[3];
+  double f[3];
+  double outside = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double limit = size[i] - 1.0;
+    const double clamped = ignition::math::clamp(local[i], 0.0, limit);
+    const double d = (local[i] - clamped) * this->dataPtr->resolution;
+    outside += d * d;
+    cell[i] = std::min(static_cast<unsigned int>(clamped), size[i] - 2);
+    f[i] = clamped - cell[i];
+  }
+
+  const std::vector<float> &values = this->dataPtr->values;
+  const std::size_t i000 =
+      this->dataPtr->Index(cell[0], cell[1], cell[2]);
+  const std::size_t dy = size.X();
+  const std::size_t dz = static_cast<std::size_t>(size.X()) * size.Y();
+
+  const double c00 = values[i000] * (1 - f[0]) + values[i000 + 1] * f[0];
+  const double c10 =
+      values[i000 + dy] * (1 - f[0]) + values[i000 + dy + 1] * f[0];
+  const double c01 =
+      values[i000 + dz] * (1 - f[0]) + values[i000 + dz + 1] * f[0];
+  const double c11 = values[i000 + dy + dz] * (1 - f[0]) +
+      values[i000 + dy + dz + 1] * f[0];
+  const double c0 = c00 * (1 - f[1]) + c10 * f[1];
+  const double c1 = c01 * (1 - f[1]) + c11 * f[1];
+  return c0 * (1 - f[2]) + c1 * f[2] + std::sqrt(outside);
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d SignedDistanceField::Gradient(
+    const ignition::math::Vector3d &_point) const
+{
+  // Central differences over half a cell smooth the trilinear steps
+  const double h = this->dataPtr->resolution * 0.5;
+  ignition::math::Vector3d gradient;
+  for (int i = 0; i < 3; ++i)
+  {
+    ignition::math::Vector3d offset;
+    offset[i] = h;
+    gradient[i] = this->Distance(_point + offset) -
+        this->Distance(_point - offset);
+  }
+
+  if (gradient.SquaredLength() <= 0)
+    return ignition::math::Vector3d::Zero;
+  return gradient.Normalize();
+}
+
+//////////////////////////////////////////////////
+unsigned int SignedDistanceField::MaxCells()
+{
+  return kMaxCells;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_SIGNEDDISTANCEFIELD_HH_
+#define GAZEBO_COMMON_SIGNEDDISTANCEFIELD_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+
+    // Forward declare private data class
+    class SignedDistanceFieldPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class SignedDistanceField SignedDistanceField.hh common/common.hh
+    /// \brief Distances to the surface of a closed mesh, sampled on a
+    /// regular grid, negative inside of the mesh.
+    ///
+    /// The field is built once from the triangles of a mesh, and then
+    /// answers the distance and the gradient at any point in constant
+    /// time, by trilinear interpolation of the eight samples around the
+    /// point. The grid extends a few cells beyond the mesh; farther away,
+    /// the distance to the grid is added to the distance at its border.
+    class GZ_COMMON_VISIBLE SignedDistanceField
+    {
+      /// \brief Constructor
+      public: SignedDistanceField();
+
+      /// \brief Destructor
+      public: virtual ~SignedDistanceField();
+
+      /// \brief Sample the distances to the triangles of a mesh. The sign
+      /// of a sample is the majority of the parities of rays along the
+      /// three axes, so small holes in the mesh are tolerated.
+      /// \param[in] _mesh The mesh. Only its triangle submeshes are read.
+      /// \param[in] _scale Scale applied to the vertices.
+      /// \param[in] _resolution Size of a cell, 0 for a 64th of the largest
+      /// extent of the mesh. It's increased so that no axis has more than
+      /// MaxCells() cells.
+      /// \return False if the mesh has no triangles.
+      public: bool Build(const Mesh &_mesh,
+                  const ignition::math::Vector3d &_scale,
+                  const double _resolution);
+
+      /// \brief Set the samples of the field.
+      /// \param[in] _origin Position of the first sample.
+      /// \param[in] _resolution Distance between neighbor samples.
+      /// \param[in] _size Number of samples along each axis, at least 2.
+      /// \param[in] _values Samples, x varying fastest.
+      /// \return False if the size doesn't match the values.
+      public: bool Set(const ignition::math::Vector3d &_origin,
+                  const double _resolution,
+                  const ignition::math::Vector3<unsigned int> &_size,
+                  const std::vector<float> &_values);
+
+      /// \brief Get whether the field has samples.
+      /// \return True after a successful Build() or Set().
+      public: bool Valid() const;
+
+      /// \brief Get the position of the first sample.
+      /// \return The origin of the grid.
+      public: ignition::math::Vector3d Origin() const;
+
+      /// \brief Get the distance between neighbor samples.
+      /// \return The size of a cell.
+      public: double Resolution() const;
+
+      /// \brief Get the number of samples along each axis.
+      /// \return The size of the grid.
+      public: ignition::math::Vector3<unsigned int> Size() const;
+
+      /// \brief Get the samples.
+      /// \return The samples, x varying fastest.
+      public: const std::vector<float> &Values() const;
+
+      /// \brief Get the bounds of the grid.
+      /// \return The box between the first and the last sample.
+      public: ignition::math::AxisAlignedBox Box() const;
+
+      /// \brief Get the signed distance at a point.
+      /// \param[in] _point The point, in the frame of the mesh.
+      /// \return The distance, negative inside of the mesh.
+      public: double Distance(const ignition::math::Vector3d &_point) const;
+
+      /// \brief Get the gradient of the distance at a point, which points
+      /// away from the nearest surface.
+      /// \param[in] _point The point, in the frame of the mesh.
+      /// \return The normalized gradient, zero where it is undefined.
+      public: ignition::math::Vector3d Gradient(
+                  const ignition::math::Vector3d &_point) const;
+
+      /// \brief Get the largest number of cells along an axis.
+      /// \return The limit used by Build().
+      public: static unsigned int MaxCells();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SignedDistanceFieldPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/SignedDistanceField.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SignedDistanceField : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Make a mesh of a closed unit cube centered at the origin.
+/// \param[out] _mesh The mesh.
+void makeCube(common::Mesh &_mesh)
+{
+  common::SubMesh *subMesh = new common::SubMesh();
+  subMesh->SetPrimitiveType(common::SubMesh::TRIANGLES);
+  for (int i = 0; i < 8; ++i)
+  {
+    subMesh->AddVertex((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5,
+        (i & 4) ? 0.5 : -0.5);
+  }
+
+  const unsigned int indices[] = {0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6,
+      0, 1, 5, 0, 5, 4, 2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5};
+  for (auto const i : indices)
+    subMesh->AddIndex(i);
+  _mesh.AddSubMesh(subMesh);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SignedDistanceField, Cube)
+{
+  common::Mesh cube;
+  makeCube(cube);
+
+  common::SignedDistanceField field;
+  EXPECT_FALSE(field.Valid());
+  EXPECT_TRUE(field.Build(cube, ignition::math::Vector3d(2, 2, 2), 0.1));
+  EXPECT_TRUE(field.Valid());
+  EXPECT_DOUBLE_EQ(0.1, field.Resolution());
+  EXPECT_EQ(field.Size().X(), field.Size().Y());
+  EXPECT_EQ(static_cast<std::size_t>(field.Size().X()) * field.Size().Y() *
+      field.Size().Z(), field.Values().size());
+  EXPECT_TRUE(field.Box().Contains(ignition::math::Vector3d(1, 1, 1)));
+
+  // Inside, the distance is negative
+  EXPECT_NEAR(-1.0, field.Distance(ignition::math::Vector3d::Zero), 1e-3);
+  EXPECT_NEAR(-0.5, field.Distance(ignition::math::Vector3d(0.5, 0, 0)),
+      1e-3);
+  EXPECT_NEAR(0.0, field.Distance(ignition::math::Vector3d(0, 1, 0)), 1e-3);
+  EXPECT_NEAR(0.1, field.Distance(ignition::math::Vector3d(0, 0, 1.1)),
+      1e-3);
+
+  // Beyond the grid, the distance keeps growing
+  EXPECT_NEAR(4.0, field.Distance(ignition::math::Vector3d(5, 0, 0)), 1e-3);
+
+  // The gradient points away from the nearest face
+  EXPECT_EQ(ignition::math::Vector3d::UnitX,
+      field.Gradient(ignition::math::Vector3d(0.95, 0, 0)));
+  EXPECT_EQ(-ignition::math::Vector3d::UnitZ,
+      field.Gradient(ignition::math::Vector3d(0, 0, -1.05)));
+
+  // The default resolution
+  EXPECT_TRUE(field.Build(cube, ignition::math::Vector3d::One, 0));
+  EXPECT_DOUBLE_EQ(1.0 / 64, field.Resolution());
+
+  // The number of cells is bounded
+  EXPECT_TRUE(field.Build(cube, ignition::math::Vector3d::One, 1e-4));
+  EXPECT_LE(field.Size().Z(), common::SignedDistanceField::MaxCells() + 1);
+
+  // Nothing to build from an empty mesh
+  common::Mesh empty;
+  EXPECT_FALSE(field.Build(empty, ignition::math::Vector3d::One, 0.1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(SignedDistanceField, Set)
+{
+  common::SignedDistanceField field;
+  std::vector<float> values(8);
+  for (unsigned int i = 0; i < values.size(); ++i)
+    values[i] = i & 1 ? 1 : -1;
+
+  EXPECT_FALSE(field.Set(ignition::math::Vector3d::Zero, 1,
+      ignition::math::Vector3<unsigned int>(2, 2, 3), values));
+  EXPECT_FALSE(field.Set(ignition::math::Vector3d::Zero, 0,
+      ignition::math::Vector3<unsigned int>(2, 2, 2), values));
+  EXPECT_FALSE(field.Valid());
+
+  EXPECT_TRUE(field.Set(ignition::math::Vector3d::Zero, 1,
+      ignition::math::Vector3<unsigned int>(2, 2, 2), values));
+  EXPECT_TRUE(field.Valid());
+
+  // The samples are interpolated along x
+  EXPECT_DOUBLE_EQ(-1, field.Distance(ignition::math::Vector3d(0, 0.5, 0)));
+  EXPECT_DOUBLE_EQ(0, field.Distance(ignition::math::Vector3d(0.5, 0.5, 1)));
+  EXPECT_DOUBLE_EQ(0.5,
+      field.Distance(ignition::math::Vector3d(0.75, 0.2, 0.3)));
+  EXPECT_EQ(ignition::math::Vector3d::UnitX,
+      field.Gradient(ignition::math::Vector3d(0.5, 0.5, 0.5)));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
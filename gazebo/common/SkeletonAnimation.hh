@@ -200,6 +200,17 @@ namespace gazebo
                   const double _x, const std::string &_node,
                   const bool _loop = true) const;
 
+      /// \brief Returns the time at which a named node transformation's
+      /// translational value along the X axis is equal to _x, as used by
+      /// PoseAtX.
+      /// \param[in] _x the value along x. You must ensure that _x is within a
+      /// valid range.
+      /// \param[in] _node the name of the animation node
+      /// \param[in] _loop when true, _x wraps around the last value along x
+      /// \return the time
+      public: double TimeAtX(const double _x, const std::string &_node,
+                  const bool _loop = true) const;
+
 
       /// \brief Scales every animation in the animations list
       /// \param[in] _scale the scaling factor
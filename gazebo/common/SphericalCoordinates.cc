@@ -15,6 +15,7 @@
  *
 */
 #include <string>
+#include <vector>
 #include <math.h>
 
 #include "gazebo/common/Console.hh"
@@ -160,6 +161,9 @@ void SphericalCoordinates::SetSurfaceType(const SurfaceType &_type)
       gzerr << "Unknown surface type[" << this->dataPtr->surfaceType << "]\n";
       break;
   }
+
+  // The origin depends on the ellipse parameters
+  this->UpdateTransformationMatrix();
 }
 
 //////////////////////////////////////////////////
@@ -203,6 +207,16 @@ ignition::math::Vector3d SphericalCoordinates::SphericalFromLocal(
   return result;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::SphericalFromLocal(
+    const std::vector<ignition::math::Vector3d> &_xyz,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  _result.resize(_xyz.size());
+  for (std::size_t i = 0; i < _xyz.size(); ++i)
+    _result[i] = this->SphericalFromLocal(_xyz[i]);
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d SphericalCoordinates::LocalFromSpherical(
     const ignition::math::Vector3d &_xyz) const
@@ -220,6 +234,19 @@ ignition::math::Vector3d SphericalCoordinates::GlobalFromLocal(
   return this->VelocityTransform(_xyz, LOCAL, GLOBAL);
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::GlobalFromLocal(
+    const std::vector<ignition::math::Vector3d> &_xyz,
+    std::vector<ignition::math::Vector3d> &_result) const
+{
+  // A velocity is a single product by the cached rotation
+  const ignition::math::Matrix3d rot =
+    this->dataPtr->rotECEFToGlobal * this->dataPtr->rotLocalToECEF;
+  _result.resize(_xyz.size());
+  for (std::size_t i = 0; i < _xyz.size(); ++i)
+    _result[i] = rot * _xyz[i];
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d SphericalCoordinates::LocalFromGlobal(
     const ignition::math::Vector3d &_xyz) const
@@ -279,6 +306,20 @@ void SphericalCoordinates::UpdateTransformationMatrix()
   this->dataPtr->cosHea = cos(-this->dataPtr->headingOffset.Radian());
   this->dataPtr->sinHea = sin(-this->dataPtr->headingOffset.Radian());
 
+  // Fold the heading transforms into the rotations, so that a LOCAL
+  // position or velocity is a single product
+  const double cosHea = this->dataPtr->cosHea;
+  const double sinHea = this->dataPtr->sinHea;
+  this->dataPtr->rotLocalToECEF = this->dataPtr->rotGlobalToECEF *
+    ignition::math::Matrix3d(
+        -cosHea, sinHea,  0.0,
+        -sinHea, -cosHea, 0.0,
+         0.0,    0.0,     1.0);
+  this->dataPtr->rotECEFToLocal = ignition::math::Matrix3d(
+         cosHea, -sinHea, 0.0,
+         sinHea,  cosHea, 0.0,
+         0.0,     0.0,    1.0) * this->dataPtr->rotECEFToGlobal;
+
   // Cache the ECEF coordinate of the origin
   this->dataPtr->origin = ignition::math::Vector3d(
     this->dataPtr->latitudeReference.Radian(),
@@ -295,38 +336,35 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 {
   ignition::math::Vector3d tmp = _pos;
 
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
-
   // Convert whatever arrives to a more flexible ECEF coordinate
   switch (_in)
   {
-    // East, North, Up (ENU), note no break at end of case
+    // East, North, Up (ENU), rotated by the heading
     case LOCAL:
       {
-        tmp.X(-_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea - _pos.Y() *
-            this->dataPtr->cosHea);
+        tmp = this->dataPtr->origin + this->dataPtr->rotLocalToECEF * _pos;
+        break;
       }
-      [[fallthrough]];
 
     case GLOBAL:
       {
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
+        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * _pos;
         break;
       }
 
     case SPHERICAL:
       {
+        // Cache trig results
+        double cosLat = cos(_pos.X());
+        double sinLat = sin(_pos.X());
+        double cosLon = cos(_pos.Y());
+        double sinLon = sin(_pos.Y());
+
+        // Radius of planet curvature (meters)
+        double curvature = 1.0 -
+          this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
+        curvature = this->dataPtr->ellA / sqrt(curvature);
+
         tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
         tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
         tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
@@ -382,12 +420,7 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 
     // Convert from ECEF TO LOCAL
     case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
+      tmp = this->dataPtr->rotECEFToLocal * (tmp - this->dataPtr->origin);
       break;
 
     // Return ECEF (do nothing)
@@ -420,16 +453,13 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
   // First, convert to an ECEF vector
   switch (_in)
   {
-    // ENU (note no break at end of case)
+    // ENU, rotated by the heading
     case LOCAL:
-      tmp.X(-_vel.X() * this->dataPtr->cosHea + _vel.Y() *
-            this->dataPtr->sinHea);
-      tmp.Y(-_vel.X() * this->dataPtr->sinHea - _vel.Y() *
-            this->dataPtr->cosHea);
-      [[fallthrough]];
+      tmp = this->dataPtr->rotLocalToECEF * _vel;
+      break;
     // spherical
     case GLOBAL:
-      tmp = this->dataPtr->rotGlobalToECEF * tmp;
+      tmp = this->dataPtr->rotGlobalToECEF * _vel;
       break;
     // Do nothing
     case ECEF:
@@ -454,11 +484,7 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
 
     // Convert from ECEF to local
     case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * tmp;
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
+      tmp = this->dataPtr->rotECEFToLocal * tmp;
       break;
 
     default:
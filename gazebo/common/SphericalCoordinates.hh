@@ -18,6 +18,7 @@
 #define _GAZEBO_SPHERICALCOORDINATES_HH_
 
 #include <string>
+#include <vector>
 
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Vector3.hh>
@@ -93,6 +94,14 @@ namespace gazebo
       public: ignition::math::Vector3d SphericalFromLocal(
                   const ignition::math::Vector3d &_xyz) const;
 
+      /// \brief Convert Cartesian position vectors to geodetic coordinates.
+      /// \param[in] _xyz Cartesian position vectors in gazebo's world frame.
+      /// \param[out] _result Coordinates of each vector: geodetic latitude
+      ///         (deg), longitude (deg), altitude above sea level (m).
+      public: void SphericalFromLocal(
+                  const std::vector<ignition::math::Vector3d> &_xyz,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
       /// \brief Convert a Cartesian velocity vector in the local gazebo frame
       ///        to a global Cartesian frame with components East, North, Up.
       /// \param[in] _xyz Cartesian vector in gazebo's world frame.
@@ -100,6 +109,15 @@ namespace gazebo
       public: ignition::math::Vector3d GlobalFromLocal(
                   const ignition::math::Vector3d &_xyz) const;
 
+      /// \brief Convert Cartesian velocity vectors in the local gazebo frame
+      ///        to a global Cartesian frame with components East, North, Up.
+      /// \param[in] _xyz Cartesian vectors in gazebo's world frame.
+      /// \param[out] _result Rotated vectors with components (x,y,z):
+      ///         (East, North, Up).
+      public: void GlobalFromLocal(
+                  const std::vector<ignition::math::Vector3d> &_xyz,
+                  std::vector<ignition::math::Vector3d> &_result) const;
+
       /// \brief Convert a string to a SurfaceType.
       /// \param[in] _str String to convert.
       /// \return Conversion to SurfaceType.
@@ -49,7 +49,7 @@ namespace gazebo
       public: ignition::math::Angle longitudeReference;
 
       /// \brief Elevation of reference point relative to sea level in meters.
-      public: double elevationReference;
+      public: double elevationReference = 0;
 
       /// \brief Heading offset, expressed as angle from East to
       ///        gazebo x-axis, or equivalently from North to gazebo y-axis.
@@ -76,6 +76,14 @@ namespace gazebo
       /// \brief Rotation matrix that moves GLOBAL to ECEF
       public: ignition::math::Matrix3d rotGlobalToECEF;
 
+      /// \brief Rotation matrix that moves LOCAL to ECEF, the heading
+      /// transform followed by rotGlobalToECEF
+      public: ignition::math::Matrix3d rotLocalToECEF;
+
+      /// \brief Rotation matrix that moves ECEF to LOCAL, rotECEFToGlobal
+      /// followed by the heading transform
+      public: ignition::math::Matrix3d rotECEFToLocal;
+
       /// \brief Cache the ECEF position of the the origin
       public: ignition::math::Vector3d origin;
 
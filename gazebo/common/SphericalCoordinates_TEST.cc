@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <vector>
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
@@ -266,6 +267,51 @@ TEST_F(SphericalCoordinatesTest, Distance)
   EXPECT_NEAR(14002, d, 20);
 }
 
+//////////////////////////////////////////////////
+// Test the batch conversions, and the cached transforms after the reference
+// changes
+TEST_F(SphericalCoordinatesTest, BatchTransforms)
+{
+  common::SphericalCoordinates sc(
+      common::SphericalCoordinates::EARTH_WGS84,
+      ignition::math::Angle(0.3), ignition::math::Angle(-1.2), 354.1,
+      ignition::math::Angle::HalfPi);
+
+  std::vector<ignition::math::Vector3d> xyz;
+  for (int i = 0; i < 10; ++i)
+    xyz.push_back(ignition::math::Vector3d(i * 100.0, -i * 50.0, i * 3.0));
+
+  for (int reference = 0; reference < 2; ++reference)
+  {
+    std::vector<ignition::math::Vector3d> spherical;
+    std::vector<ignition::math::Vector3d> global;
+    sc.SphericalFromLocal(xyz, spherical);
+    sc.GlobalFromLocal(xyz, global);
+    ASSERT_EQ(spherical.size(), xyz.size());
+    ASSERT_EQ(global.size(), xyz.size());
+
+    for (std::size_t i = 0; i < xyz.size(); ++i)
+    {
+      EXPECT_EQ(spherical[i], sc.SphericalFromLocal(xyz[i]));
+      EXPECT_EQ(global[i], sc.GlobalFromLocal(xyz[i]));
+
+      // Round trips, with the heading offset of 90 degrees
+      const ignition::math::Vector3d local =
+          sc.LocalFromSpherical(spherical[i]);
+      EXPECT_NEAR(local.X(), xyz[i].X(), 1e-2);
+      EXPECT_NEAR(local.Y(), xyz[i].Y(), 1e-2);
+      EXPECT_NEAR(local.Z(), xyz[i].Z(), 1e-2);
+      EXPECT_EQ(sc.LocalFromGlobal(global[i]), xyz[i]);
+
+      // Velocities keep their norm
+      EXPECT_NEAR(global[i].Length(), xyz[i].Length(), 1e-6);
+    }
+
+    sc.SetLatitudeReference(ignition::math::Angle(-0.7));
+    sc.SetLongitudeReference(ignition::math::Angle(2.5));
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
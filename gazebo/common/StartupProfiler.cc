@@ -0,0 +1,430 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef _WIN32
+  #include <process.h>
+  #define getpid _getpid
+#else
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/StartupProfiler.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Clock of the profiler.
+    using StartupClock = std::chrono::steady_clock;
+
+    /// \internal
+    /// \brief A closed scope.
+    class StartupRecord
+    {
+      /// \brief Name of the phase.
+      public: std::string name;
+
+      /// \brief Asset of the scope.
+      public: std::string detail;
+
+      /// \brief Index of the thread.
+      public: unsigned int thread = 0;
+
+      /// \brief Start time from the start of the profiler in seconds.
+      public: double start = 0;
+
+      /// \brief Wall time in seconds.
+      public: double duration = 0;
+
+      /// \brief Wall time without the nested scopes in seconds.
+      public: double self = 0;
+    };
+
+    /// \internal
+    /// \brief A scope open on a thread.
+    class StartupOpenScope
+    {
+      /// \brief Name of the phase.
+      public: std::string name;
+
+      /// \brief Asset of the scope.
+      public: std::string detail;
+
+      /// \brief Time at which the scope opened.
+      public: StartupClock::time_point start;
+
+      /// \brief Wall time of the nested scopes in seconds.
+      public: double children = 0;
+    };
+
+    /// \internal
+    /// \brief Scopes open on the calling thread.
+    class StartupThreadStack
+    {
+      /// \brief Recording session the scopes belong to.
+      public: uint64_t session = 0;
+
+      /// \brief The open scopes, the innermost last.
+      public: std::vector<StartupOpenScope> scopes;
+    };
+
+    /// \internal
+    /// \brief Scopes open on the calling thread.
+    static thread_local StartupThreadStack g_startupStack;
+
+    /// \internal
+    /// \brief Private data for StartupProfiler
+    class StartupProfilerPrivate
+    {
+      /// \brief True while recording.
+      public: std::atomic<bool> enabled{false};
+
+      /// \brief Recording session, incremented by Start().
+      public: std::atomic<uint64_t> session{0};
+
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Path of the trace.
+      public: std::string path;
+
+      /// \brief Time at which the recording started.
+      public: StartupClock::time_point start;
+
+      /// \brief Closed scopes.
+      public: std::vector<StartupRecord> records;
+
+      /// \brief Index of each thread that recorded a scope.
+      public: std::map<std::thread::id, unsigned int> threads;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Escape a string for JSON.
+/// \param[in] _str The string.
+/// \return The escaped string.
+static std::string escapeJson(const std::string &_str)
+{
+  std::string result;
+  result.reserve(_str.size());
+  for (auto const c : _str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result += '\\';
+      result += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      result += buffer;
+    }
+    else
+      result += c;
+  }
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Sort entries from the longest total time.
+/// \param[in,out] _entries The entries.
+static void sortEntries(std::vector<StartupProfiler::Entry> &_entries)
+{
+  std::stable_sort(_entries.begin(), _entries.end(),
+      [](const StartupProfiler::Entry &_a, const StartupProfiler::Entry &_b)
+      {
+        return _a.totalTime > _b.totalTime;
+      });
+}
+
+/////////////////////////////////////////////////
+StartupProfiler::StartupProfiler()
+  : dataPtr(new StartupProfilerPrivate)
+{
+  const char *dir = getenv("GAZEBO_STARTUP_PROFILE");
+  if (dir && *dir)
+  {
+    boost::filesystem::path path(dir);
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(path, ec);
+    this->Start((path / ("startup_" + std::to_string(getpid()) +
+        ".json")).string());
+  }
+}
+
+/////////////////////////////////////////////////
+StartupProfiler::~StartupProfiler()
+{
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::Start(const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->path = _path;
+  this->dataPtr->start = StartupClock::now();
+  this->dataPtr->records.clear();
+  this->dataPtr->threads.clear();
+  ++this->dataPtr->session;
+  this->dataPtr->enabled = true;
+}
+
+/////////////////////////////////////////////////
+bool StartupProfiler::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::Begin(const std::string &_name,
+    const std::string &_detail)
+{
+  // Drop the scopes left open by a previous session.
+  const uint64_t session = this->dataPtr->session;
+  if (g_startupStack.session != session)
+  {
+    g_startupStack.session = session;
+    g_startupStack.scopes.clear();
+  }
+
+  StartupOpenScope scope;
+  scope.name = _name;
+  scope.detail = _detail;
+  scope.start = StartupClock::now();
+  g_startupStack.scopes.push_back(std::move(scope));
+}
+
+/////////////////////////////////////////////////
+void StartupProfiler::End()
+{
+  const auto end = StartupClock::now();
+  if (g_startupStack.scopes.empty() ||
+      g_startupStack.session != this->dataPtr->session)
+  {
+    return;
+  }
+
+  StartupOpenScope scope = std::move(g_startupStack.scopes.back());
+  g_startupStack.scopes.pop_back();
+
+  const double duration =
+      std::chrono::duration<double>(end - scope.start).count();
+  if (!g_startupStack.scopes.empty())
+    g_startupStack.scopes.back().children += duration;
+
+  if (!this->dataPtr->enabled)
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  StartupRecord record;
+  record.name = std::move(scope.name);
+  record.detail = std::move(scope.detail);
+  auto thread = this->dataPtr->threads.insert(std::make_pair(
+      std::this_thread::get_id(), this->dataPtr->threads.size()));
+  record.thread = thread.first->second;
+  record.start = std::chrono::duration<double>(
+      scope.start - this->dataPtr->start).count();
+  record.duration = duration;
+  record.self = std::max(0.0, duration - scope.children);
+  this->dataPtr->records.push_back(std::move(record));
+}
+
+/////////////////////////////////////////////////
+bool StartupProfiler::Finish()
+{
+  if (!this->dataPtr->enabled.exchange(false))
+    return true;
+
+  std::string path;
+  std::vector<StartupRecord> records;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    path = this->dataPtr->path;
+    records = this->dataPtr->records;
+  }
+
+  if (path.empty())
+    return true;
+
+  std::ofstream trace(path);
+  if (!trace)
+  {
+    gzerr << "Unable to write the startup profile [" << path << "]\n";
+    return false;
+  }
+
+  // Chrome trace of complete events, in microseconds.
+  trace << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < records.size(); ++i)
+  {
+    const StartupRecord &r = records[i];
+    trace << (i == 0 ? "\n" : ",\n")
+          << "{\"name\": \"" << escapeJson(r.name) << "\", "
+          << "\"cat\": \"startup\", \"ph\": \"X\", \"pid\": " << getpid()
+          << ", \"tid\": " << r.thread
+          << ", \"ts\": " << std::fixed << std::setprecision(1)
+          << r.start * 1e6 << ", \"dur\": " << r.duration * 1e6;
+    if (!r.detail.empty())
+      trace << ", \"args\": {\"detail\": \"" << escapeJson(r.detail) << "\"}";
+    trace << "}";
+  }
+  trace << "\n]}\n";
+  trace.close();
+
+  boost::filesystem::path summaryPath(path);
+  summaryPath.replace_extension(".txt");
+  std::ofstream summary(summaryPath.string());
+  const std::string table = this->Summary();
+  summary << table;
+
+  gzmsg << "Startup profile written to [" << path << "]\n" << table;
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<StartupProfiler::Entry> StartupProfiler::Phases() const
+{
+  std::map<std::string, Entry> phases;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &r : this->dataPtr->records)
+    {
+      Entry &entry = phases[r.name];
+      entry.name = r.name;
+      ++entry.calls;
+      entry.totalTime += r.duration;
+      entry.selfTime += r.self;
+    }
+  }
+
+  std::vector<Entry> result;
+  for (auto &phase : phases)
+    result.push_back(std::move(phase.second));
+  sortEntries(result);
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::vector<StartupProfiler::Entry> StartupProfiler::Assets(
+    const unsigned int _count) const
+{
+  std::map<std::pair<std::string, std::string>, Entry> assets;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &r : this->dataPtr->records)
+    {
+      if (r.detail.empty())
+        continue;
+      Entry &entry = assets[std::make_pair(r.name, r.detail)];
+      entry.name = r.name;
+      entry.detail = r.detail;
+      ++entry.calls;
+      entry.totalTime += r.duration;
+      entry.selfTime += r.self;
+    }
+  }
+
+  std::vector<Entry> result;
+  for (auto &asset : assets)
+    result.push_back(std::move(asset.second));
+  sortEntries(result);
+  if (result.size() > _count)
+    result.resize(_count);
+  return result;
+}
+
+/////////////////////////////////////////////////
+double StartupProfiler::Duration() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  double result = 0;
+  for (auto const &r : this->dataPtr->records)
+    result = std::max(result, r.start + r.duration);
+  return result;
+}
+
+/////////////////////////////////////////////////
+std::string StartupProfiler::Summary(const unsigned int _rows) const
+{
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1)
+      << "Startup took " << this->Duration() * 1e3 << " ms\n\n"
+      << std::setw(10) << "total ms" << std::setw(10) << "self ms"
+      << std::setw(8) << "calls" << "  phase\n";
+
+  unsigned int rows = 0;
+  for (auto const &phase : this->Phases())
+  {
+    if (rows++ >= _rows)
+      break;
+    out << std::setw(10) << phase.totalTime * 1e3
+        << std::setw(10) << phase.selfTime * 1e3
+        << std::setw(8) << phase.calls << "  " << phase.name << "\n";
+  }
+
+  const std::vector<Entry> assets = this->Assets(_rows);
+  if (!assets.empty())
+  {
+    out << "\n" << std::setw(10) << "total ms" << std::setw(10) << "self ms"
+        << std::setw(8) << "calls" << "  asset\n";
+    for (auto const &asset : assets)
+    {
+      out << std::setw(10) << asset.totalTime * 1e3
+          << std::setw(10) << asset.selfTime * 1e3
+          << std::setw(8) << asset.calls << "  " << asset.name << " "
+          << asset.detail << "\n";
+    }
+  }
+
+  return out.str();
+}
+
+/////////////////////////////////////////////////
+StartupScope::StartupScope(const char *_name, const std::string &_detail)
+  : active(StartupProfiler::Instance()->Enabled())
+{
+  if (this->active)
+    StartupProfiler::Instance()->Begin(_name, _detail);
+}
+
+/////////////////////////////////////////////////
+StartupScope::~StartupScope()
+{
+  if (this->active)
+    StartupProfiler::Instance()->End();
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_STARTUPPROFILER_HH_
+#define GAZEBO_COMMON_STARTUPPROFILER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, StartupProfiler)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class StartupProfilerPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class StartupProfiler StartupProfiler.hh common/common.hh
+    /// \brief Records the time spent in the phases of the startup.
+    ///
+    /// The load functions of the server and the client open a
+    /// StartupScope for each phase and asset, such as the load of a world,
+    /// a model, a plugin or a mesh. Scopes nest per thread. Once started,
+    /// the profiler records the scopes until Finish(), which writes them
+    /// as a Chrome trace, to open in chrome://tracing, and writes a summary
+    /// table of the time spent by phase and of the slowest assets next to
+    /// it, in a file with the ".txt" extension.
+    ///
+    /// gzserver and gzclient start it with --startup-profile, and every
+    /// process starts it when GAZEBO_STARTUP_PROFILE is set to a directory,
+    /// in which the trace is named after the process id. The scopes cost
+    /// an atomic load when the profiler isn't started.
+    class GZ_COMMON_VISIBLE StartupProfiler :
+      public SingletonT<StartupProfiler>
+    {
+      /// \brief Time spent by a phase, or by an asset.
+      public: class Entry
+      {
+        /// \brief Name of the phase, such as "World::Load".
+        public: std::string name;
+
+        /// \brief Asset of the scope, such as a mesh file, empty for the
+        /// summary of a phase.
+        public: std::string detail;
+
+        /// \brief Number of scopes.
+        public: uint64_t calls = 0;
+
+        /// \brief Total wall time of the scopes in seconds, nested scopes
+        /// included.
+        public: double totalTime = 0;
+
+        /// \brief Wall time of the scopes in seconds, nested scopes of the
+        /// same thread excluded.
+        public: double selfTime = 0;
+      };
+
+      /// \brief Constructor.
+      private: StartupProfiler();
+
+      /// \brief Destructor.
+      private: virtual ~StartupProfiler();
+
+      /// \brief Start recording, and discard what was recorded before.
+      /// \param[in] _path Path of the Chrome trace written by Finish(),
+      /// empty to only keep the records in memory.
+      public: void Start(const std::string &_path);
+
+      /// \brief Get whether the profiler records the scopes.
+      /// \return True between Start() and Finish().
+      public: bool Enabled() const;
+
+      /// \brief Open a scope on the calling thread. Prefer StartupScope.
+      /// \param[in] _name Name of the phase.
+      /// \param[in] _detail Asset of the scope, can be empty.
+      public: void Begin(const std::string &_name,
+                  const std::string &_detail = "");
+
+      /// \brief Close the last scope opened on the calling thread.
+      public: void End();
+
+      /// \brief Stop recording, and write the trace and the summary if a
+      /// path was given to Start(). Scopes still open are left out.
+      /// \return False if the files couldn't be written.
+      public: bool Finish();
+
+      /// \brief Get the time spent by phase, from the longest total time.
+      /// \return One entry per phase name.
+      public: std::vector<Entry> Phases() const;
+
+      /// \brief Get the slowest assets, from the longest total time.
+      /// \param[in] _count Largest number of entries.
+      /// \return One entry per phase name and asset.
+      public: std::vector<Entry> Assets(const unsigned int _count) const;
+
+      /// \brief Get the wall time from Start() to the end of the last
+      /// closed scope.
+      /// \return Wall time in seconds.
+      public: double Duration() const;
+
+      /// \brief Get the summary table of Phases() and Assets().
+      /// \param[in] _rows Largest number of rows of each part.
+      /// \return The table, one row per line.
+      public: std::string Summary(const unsigned int _rows = 25) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StartupProfilerPrivate> dataPtr;
+
+      /// \brief This is a singleton.
+      private: friend class SingletonT<StartupProfiler>;
+    };
+
+    /// \class StartupScope StartupProfiler.hh common/common.hh
+    /// \brief Records a phase of the startup in the StartupProfiler, from
+    /// its construction to its destruction.
+    class GZ_COMMON_VISIBLE StartupScope
+    {
+      /// \brief Constructor. Opens the scope if the profiler is started.
+      /// \param[in] _name Name of the phase.
+      /// \param[in] _detail Asset of the scope, can be empty.
+      public: explicit StartupScope(const char *_name,
+                  const std::string &_detail = "");
+
+      /// \brief Destructor. Closes the scope.
+      public: ~StartupScope();
+
+      /// \brief True if the scope was opened.
+      private: bool active;
+    };
+    /// \}
+  }
+}
+#endif
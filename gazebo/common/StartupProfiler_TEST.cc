@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/StartupProfiler.hh"
+#include "gazebo/common/Time.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StartupProfilerTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(StartupProfilerTest, Scopes)
+{
+  common::StartupProfiler *profiler = common::StartupProfiler::Instance();
+
+  // Scopes aren't recorded before the start
+  {
+    common::StartupScope scope("Ignored");
+  }
+  profiler->Start("");
+  EXPECT_TRUE(profiler->Enabled());
+  EXPECT_TRUE(profiler->Phases().empty());
+
+  {
+    common::StartupScope world("World::Load", "default");
+    {
+      common::StartupScope model("Model::Load", "box");
+      common::Time::MSleep(5);
+    }
+    {
+      common::StartupScope model("Model::Load", "sphere");
+      common::Time::MSleep(2);
+    }
+    std::thread thread([]()
+        {
+          common::StartupScope mesh("MeshManager::Load", "mesh.dae");
+          common::Time::MSleep(2);
+        });
+    thread.join();
+  }
+
+  auto phases = profiler->Phases();
+  ASSERT_EQ(3u, phases.size());
+  EXPECT_EQ("World::Load", phases[0].name);
+  EXPECT_EQ(1u, phases[0].calls);
+  EXPECT_EQ("Model::Load", phases[1].name);
+  EXPECT_EQ(2u, phases[1].calls);
+  EXPECT_GE(phases[1].totalTime, 0.007);
+
+  // The models are nested in the world, the mesh is on another thread
+  EXPECT_NEAR(phases[0].selfTime,
+      phases[0].totalTime - phases[1].totalTime, 1e-6);
+  EXPECT_GE(phases[0].selfTime, phases[2].totalTime * 0.5);
+
+  auto assets = profiler->Assets(2);
+  ASSERT_EQ(2u, assets.size());
+  EXPECT_EQ("default", assets[0].detail);
+  EXPECT_EQ("box", assets[1].detail);
+
+  EXPECT_GE(profiler->Duration(), phases[0].totalTime);
+  EXPECT_NE(std::string::npos, profiler->Summary().find("Model::Load"));
+
+  // Without a path nothing is written
+  EXPECT_TRUE(profiler->Finish());
+  EXPECT_FALSE(profiler->Enabled());
+  {
+    common::StartupScope scope("Ignored");
+  }
+  EXPECT_EQ(3u, profiler->Phases().size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StartupProfilerTest, Trace)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_startup_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+  boost::filesystem::path path = dir / "trace.json";
+
+  common::StartupProfiler *profiler = common::StartupProfiler::Instance();
+  profiler->Start(path.string());
+  {
+    common::StartupScope scope("Plugin::Create", "lib\"quoted\".so");
+  }
+
+  // A scope left open isn't written
+  profiler->Begin("Open");
+  EXPECT_TRUE(profiler->Finish());
+  profiler->End();
+
+  std::ifstream trace(path.string());
+  ASSERT_TRUE(trace.good());
+  std::stringstream content;
+  content << trace.rdbuf();
+  EXPECT_NE(std::string::npos, content.str().find("\"traceEvents\""));
+  EXPECT_NE(std::string::npos, content.str().find(
+      "\"name\": \"Plugin::Create\""));
+  EXPECT_NE(std::string::npos, content.str().find("lib\\\"quoted\\\".so"));
+  EXPECT_EQ(std::string::npos, content.str().find("Open"));
+
+  EXPECT_TRUE(boost::filesystem::exists(dir / "trace.txt"));
+
+  // A new start discards the previous records
+  profiler->Start("");
+  EXPECT_TRUE(profiler->Phases().empty());
+  profiler->Finish();
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
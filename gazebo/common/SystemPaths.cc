@@ -17,6 +17,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
 #include <sstream>
 
 #include <boost/filesystem.hpp>
@@ -56,9 +59,125 @@ char pathDelimiter()
 /// TODO(chapulina): Move to member variable when porting forward
 std::vector<std::function<std::string (const std::string &)>> g_findFileCbs;
 
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for SystemPaths
+    class SystemPathsPrivate
+    {
+      /// \brief Get whether a search path may contain a path.
+      /// \param[in] _root Search path.
+      /// \param[in] _rel Path relative to _root.
+      /// \return False if the index is used and the first directory of
+      /// _rel isn't in _root.
+      public: bool MayContain(const std::string &_root,
+                              const std::string &_rel);
+
+      /// \brief True to cache the paths that were found.
+      public: bool cacheEnabled = true;
+
+      /// \brief True to index the search paths.
+      public: bool indexEnabled = false;
+
+      /// \brief Paths found, by lookup key.
+      public: std::map<std::string, std::string> cache;
+
+      /// \brief Names of the entries of each indexed search path.
+      public: std::map<std::string, std::set<std::string>> index;
+
+      /// \brief Counters of the cache.
+      public: FindFileStats stats;
+
+      /// \brief Last value of each environment variable read, used to
+      /// parse a variable again only when it changed.
+      public: std::map<std::string, std::string> envValues;
+
+      /// \brief Protects the cache, the index and the counters.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+bool SystemPathsPrivate::MayContain(const std::string &_root,
+    const std::string &_rel)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->indexEnabled)
+    return true;
+
+  std::size_t start = _rel.find_first_not_of("/\\");
+  if (start == std::string::npos)
+    return true;
+  std::size_t end = _rel.find_first_of("/\\", start);
+  std::string first = _rel.substr(start, end - start);
+  if (first == "." || first == "..")
+    return true;
+
+  auto iter = this->index.find(_root);
+  if (iter == this->index.end())
+  {
+    std::set<std::string> entries;
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator dirIter(_root, ec);
+    for (; !ec && dirIter != boost::filesystem::directory_iterator();
+         dirIter.increment(ec))
+    {
+      entries.insert(dirIter->path().filename().string());
+    }
+    iter = this->index.emplace(_root, std::move(entries)).first;
+    this->stats.indexedDirectories++;
+  }
+
+  if (iter->second.count(first) == 0)
+  {
+    this->stats.skippedProbes++;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a search path variable of the environment.
+/// \param[in] _name Name of the variable.
+/// \param[in] _default Value to use when the variable isn't set.
+/// \param[in,out] _last Value returned by the previous call.
+/// \return False if the value didn't change since the previous call.
+static bool readPathEnv(const char *_name, const std::string &_default,
+    std::map<std::string, std::string> &_last)
+{
+  const char *pathCStr = getenv(_name);
+  std::string path;
+  if (!pathCStr || *pathCStr == '\0')
+  {
+    // No env var; take the compile-time default.
+    path = _default;
+  }
+  else
+  {
+    path = pathCStr;
+  }
+
+  auto iter = _last.find(_name);
+  if (iter != _last.end() && iter->second == path)
+    return false;
+  _last[_name] = path;
+  return true;
+}
+
 //////////////////////////////////////////////////
 SystemPaths::SystemPaths()
+  : dataPtr(new SystemPathsPrivate)
 {
+  const char *cacheEnv = getenv("GAZEBO_FIND_FILE_CACHE");
+  if (cacheEnv && std::string(cacheEnv) == "0")
+    this->dataPtr->cacheEnabled = false;
+  const char *indexEnv = getenv("GAZEBO_INDEX_SEARCH_PATHS");
+  if (indexEnv && std::string(indexEnv) == "1")
+    this->dataPtr->indexEnabled = true;
+
   this->gazeboPaths.clear();
   this->ogrePaths.clear();
   this->pluginPaths.clear();
@@ -135,6 +254,11 @@ SystemPaths::SystemPaths()
   this->ogrePathsFromEnv = true;
 }
 
+//////////////////////////////////////////////////
+SystemPaths::~SystemPaths()
+{
+}
+
 /////////////////////////////////////////////////
 std::string SystemPaths::GetLogPath() const
 {
@@ -185,6 +309,20 @@ const std::string &SystemPaths::TmpInstancePath() const
   return this->tmpInstancePath.string();
 }
 
+/////////////////////////////////////////////////
+void SystemPaths::ResetTmpInstancePath()
+{
+  try
+  {
+    this->tmpInstancePath = boost::filesystem::unique_path("gazebo-%%%%%%");
+  }
+  catch(const boost::system::error_code &_ex)
+  {
+    gzerr << "Failed creating temp directory. Reason: "
+          << _ex.message() << "\n";
+  }
+}
+
 /////////////////////////////////////////////////
 std::string SystemPaths::DefaultTestPath() const
 {
@@ -194,20 +332,12 @@ std::string SystemPaths::DefaultTestPath() const
 /////////////////////////////////////////////////
 void SystemPaths::UpdateModelPaths()
 {
-  std::string path;
-
-  char *pathCStr = getenv("GAZEBO_MODEL_PATH");
-  if (!pathCStr || *pathCStr == '\0')
-  {
-    // No env var; take the compile-time default.
-    path = GAZEBO_MODEL_PATH;
-  }
-  else
-  {
-    path = pathCStr;
-  }
+  if (!readPathEnv("GAZEBO_MODEL_PATH", GAZEBO_MODEL_PATH,
+        this->dataPtr->envValues))
+    return;
 
-  auto delimitedPaths = ignition::common::Split(path, pathDelimiter());
+  auto delimitedPaths = ignition::common::Split(
+      this->dataPtr->envValues["GAZEBO_MODEL_PATH"], pathDelimiter());
   for (const auto &delimitedPath : delimitedPaths)
   {
     if (!delimitedPath.empty())
@@ -216,25 +346,18 @@ void SystemPaths::UpdateModelPaths()
       this->InsertUnique(delimitedPath, this->modelPaths);
     }
   }
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::UpdateGazeboPaths()
 {
-  std::string path;
-
-  char *pathCStr = getenv("GAZEBO_RESOURCE_PATH");
-  if (!pathCStr || *pathCStr == '\0')
-  {
-    // No env var; take the compile-time default.
-    path = GAZEBO_RESOURCE_PATH;
-  }
-  else
-  {
-    path = pathCStr;
-  }
+  if (!readPathEnv("GAZEBO_RESOURCE_PATH", GAZEBO_RESOURCE_PATH,
+        this->dataPtr->envValues))
+    return;
 
-  auto delimitedPaths = ignition::common::Split(path, pathDelimiter());
+  auto delimitedPaths = ignition::common::Split(
+      this->dataPtr->envValues["GAZEBO_RESOURCE_PATH"], pathDelimiter());
   for (const auto &delimitedPath : delimitedPaths)
   {
     if (!delimitedPath.empty())
@@ -242,25 +365,18 @@ void SystemPaths::UpdateGazeboPaths()
       this->InsertUnique(delimitedPath, this->gazeboPaths);
     }
   }
+  this->ClearFindFileCache();
 }
 
 //////////////////////////////////////////////////
 void SystemPaths::UpdatePluginPaths()
 {
-  std::string path;
-
-  char *pathCStr = getenv("GAZEBO_PLUGIN_PATH");
-  if (!pathCStr || *pathCStr == '\0')
-  {
-    // No env var; take the compile-time default.
-    path = GAZEBO_PLUGIN_PATH;
-  }
-  else
-  {
-    path = pathCStr;
-  }
+  if (!readPathEnv("GAZEBO_PLUGIN_PATH", GAZEBO_PLUGIN_PATH,
+        this->dataPtr->envValues))
+    return;
 
-  auto delimitedPaths = ignition::common::Split(path, pathDelimiter());
+  auto delimitedPaths = ignition::common::Split(
+      this->dataPtr->envValues["GAZEBO_PLUGIN_PATH"], pathDelimiter());
   for (const auto &delimitedPath : delimitedPaths)
   {
     if (!delimitedPath.empty())
@@ -273,20 +389,12 @@ void SystemPaths::UpdatePluginPaths()
 //////////////////////////////////////////////////
 void SystemPaths::UpdateOgrePaths()
 {
-  std::string path;
-
-  char *pathCStr = getenv("OGRE_RESOURCE_PATH");
-  if (!pathCStr || *pathCStr == '\0')
-  {
-    // No env var; take the compile-time default.
-    path = OGRE_RESOURCE_PATH;
-  }
-  else
-  {
-    path = pathCStr;
-  }
+  if (!readPathEnv("OGRE_RESOURCE_PATH", OGRE_RESOURCE_PATH,
+        this->dataPtr->envValues))
+    return;
 
-  auto delimitedPaths = ignition::common::Split(path, pathDelimiter());
+  auto delimitedPaths = ignition::common::Split(
+      this->dataPtr->envValues["OGRE_RESOURCE_PATH"], pathDelimiter());
   for (const auto &delimitedPath : delimitedPaths)
   {
     if (!delimitedPath.empty())
@@ -305,6 +413,33 @@ std::string SystemPaths::GetWorldPathExtension()
 
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFileURI(const std::string &_uri)
+{
+  if (!this->dataPtr->cacheEnabled)
+    return this->FindFileURIUncached(_uri);
+
+  std::string key = "uri\n" + _uri;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->cache.find(key);
+    if (iter != this->dataPtr->cache.end())
+    {
+      this->dataPtr->stats.hits++;
+      return iter->second;
+    }
+    this->dataPtr->stats.misses++;
+  }
+
+  std::string filename = this->FindFileURIUncached(_uri);
+  if (!filename.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->cache[key] = filename;
+  }
+  return filename;
+}
+
+//////////////////////////////////////////////////
+std::string SystemPaths::FindFileURIUncached(const std::string &_uri)
 {
   int index = _uri.find("://");
   std::string prefix = _uri.substr(0, index);
@@ -320,7 +455,8 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
          iter != this->modelPaths.end(); ++iter)
     {
       path = boost::filesystem::path(*iter) / suffix;
-      if (boost::filesystem::exists(path))
+      if (this->dataPtr->MayContain(*iter, suffix) &&
+          boost::filesystem::exists(path))
       {
         filename = path.string();
         break;
@@ -334,7 +470,7 @@ std::string SystemPaths::FindFileURI(const std::string &_uri)
   else if (prefix.empty() || prefix == "file")
   {
     // Try to find the file on the current system
-    filename = this->FindFile(suffix);
+    filename = this->FindFileUncached(suffix, true);
   }
 
   return filename;
@@ -349,6 +485,50 @@ static bool isAbsolute(const std::string &_filename)
 //////////////////////////////////////////////////
 std::string SystemPaths::FindFile(const std::string &_filename,
                                   bool _searchLocalPath)
+{
+  if (_filename.empty() || !this->dataPtr->cacheEnabled)
+    return this->FindFileUncached(_filename, _searchLocalPath);
+
+  // Relative names are resolved against the working directory first
+  std::string key;
+  if (_filename.find("://") != std::string::npos)
+  {
+    key = "uri\n" + _filename;
+  }
+  else
+  {
+    key = _searchLocalPath ? "local\n" : "paths\n";
+    if (!isAbsolute(_filename))
+    {
+      boost::system::error_code ec;
+      key += boost::filesystem::current_path(ec).string() + "\n";
+    }
+    key += _filename;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    auto iter = this->dataPtr->cache.find(key);
+    if (iter != this->dataPtr->cache.end())
+    {
+      this->dataPtr->stats.hits++;
+      return iter->second;
+    }
+    this->dataPtr->stats.misses++;
+  }
+
+  std::string filename = this->FindFileUncached(_filename, _searchLocalPath);
+  if (!filename.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->cache[key] = filename;
+  }
+  return filename;
+}
+
+//////////////////////////////////////////////////
+std::string SystemPaths::FindFileUncached(const std::string &_filename,
+                                          bool _searchLocalPath)
 {
   boost::filesystem::path path;
 
@@ -358,7 +538,7 @@ std::string SystemPaths::FindFile(const std::string &_filename,
   // Handle as URI
   if (_filename.find("://") != std::string::npos)
   {
-    path = boost::filesystem::path(this->FindFileURI(_filename));
+    path = boost::filesystem::path(this->FindFileURIUncached(_filename));
   }
   // Handle as local absolute path
   else if (isAbsolute(_filename))
@@ -376,7 +556,8 @@ std::string SystemPaths::FindFile(const std::string &_filename,
            iter != this->modelPaths.end(); ++iter)
       {
         auto modelPath = boost::filesystem::path(*iter) / path;
-        if (boost::filesystem::exists(modelPath))
+        if (this->dataPtr->MayContain(*iter, _filename) &&
+            boost::filesystem::exists(modelPath))
         {
           path = modelPath;
           break;
@@ -410,14 +591,15 @@ std::string SystemPaths::FindFile(const std::string &_filename,
     else
     {
       bool found = false;
-      std::list<std::string> paths = this->GetGazeboPaths();
+      const std::list<std::string> &paths = this->GetGazeboPaths();
 
       for (std::list<std::string>::const_iterator iter = paths.begin();
           iter != paths.end() && !found; ++iter)
       {
         path = boost::filesystem::path((*iter));
         path = boost::filesystem::operator/(path, _filename);
-        if (boost::filesystem::exists(path))
+        if (this->dataPtr->MayContain(*iter, _filename) &&
+            boost::filesystem::exists(path))
         {
           found = true;
           break;
@@ -430,7 +612,8 @@ std::string SystemPaths::FindFile(const std::string &_filename,
           path = boost::filesystem::path(*iter);
           path = boost::filesystem::operator/(path, *suffixIter);
           path = boost::filesystem::operator/(path, _filename);
-          if (boost::filesystem::exists(path))
+          if (this->dataPtr->MayContain(*iter, *suffixIter) &&
+              boost::filesystem::exists(path))
           {
             found = true;
             break;
@@ -469,30 +652,37 @@ void SystemPaths::AddFindFileCallback(
     std::function<std::string (const std::string &)> _cb)
 {
   g_findFileCbs.push_back(_cb);
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearGazeboPaths()
 {
   this->gazeboPaths.clear();
+  this->dataPtr->envValues.erase("GAZEBO_RESOURCE_PATH");
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearOgrePaths()
 {
   this->ogrePaths.clear();
+  this->dataPtr->envValues.erase("OGRE_RESOURCE_PATH");
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearPluginPaths()
 {
   this->pluginPaths.clear();
+  this->dataPtr->envValues.erase("GAZEBO_PLUGIN_PATH");
 }
 
 /////////////////////////////////////////////////
 void SystemPaths::ClearModelPaths()
 {
   this->modelPaths.clear();
+  this->dataPtr->envValues.erase("GAZEBO_MODEL_PATH");
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -506,6 +696,7 @@ void SystemPaths::AddGazeboPaths(const std::string &_path)
       this->InsertUnique(delimitedPath, this->gazeboPaths);
     }
   }
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -545,6 +736,7 @@ void SystemPaths::AddModelPaths(const std::string &_path)
       this->InsertUnique(delimitedPath, this->modelPaths);
     }
   }
+  this->ClearFindFileCache();
 }
 
 /////////////////////////////////////////////////
@@ -576,4 +768,39 @@ void SystemPaths::AddSearchPathSuffix(const std::string &_suffix)
     s += "/";
 
   this->suffixPaths.push_back(s);
+  this->ClearFindFileCache();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::SetFindFileCache(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cacheEnabled = _enable;
+  this->dataPtr->cache.clear();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::SetSearchPathIndex(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->indexEnabled = _enable;
+  this->dataPtr->index.clear();
+  this->dataPtr->cache.clear();
+}
+
+/////////////////////////////////////////////////
+void SystemPaths::ClearFindFileCache()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->cache.clear();
+  this->dataPtr->index.clear();
+}
+
+/////////////////////////////////////////////////
+FindFileStats SystemPaths::FindFileCacheStats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  FindFileStats result = this->dataPtr->stats;
+  result.entries = this->dataPtr->cache.size();
+  return result;
 }
@@ -29,7 +29,9 @@
 #endif
 
 #include <boost/filesystem.hpp>
+#include <cstdint>
 #include <list>
+#include <memory>
 #include <string>
 
 #include "gazebo/common/CommonTypes.hh"
@@ -44,9 +46,31 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class
+    class SystemPathsPrivate;
+
     /// \addtogroup gazebo_common Common
     /// \{
 
+    /// \brief Counters of the cache of SystemPaths::FindFile.
+    class GZ_COMMON_VISIBLE FindFileStats
+    {
+      /// \brief Number of lookups answered by the cache.
+      public: uint64_t hits = 0;
+
+      /// \brief Number of lookups that searched the paths.
+      public: uint64_t misses = 0;
+
+      /// \brief Number of resolved paths in the cache.
+      public: uint64_t entries = 0;
+
+      /// \brief Number of directories listed by the index.
+      public: uint64_t indexedDirectories = 0;
+
+      /// \brief Number of file system probes avoided by the index.
+      public: uint64_t skippedProbes = 0;
+    };
+
     /// \class SystemPaths SystemPaths.hh common/common.hh
     /// \brief Functions to handle getting system paths, keeps track of:
     ///        \li SystemPaths#gazeboPaths - media paths containing
@@ -56,11 +80,21 @@ namespace gazebo
     ///            Should point to Ogre RenderSystem_GL.so et. al.
     ///        \li SystemPaths#pluginPaths - plugin library paths
     ///            for common::WorldPlugin
+    ///
+    /// The paths found by FindFile and FindFileURI are cached, so that
+    /// looking up the same file again doesn't probe the file system. The
+    /// cache is cleared when the search paths change, and can be disabled
+    /// by setting GAZEBO_FIND_FILE_CACHE=0. Setting
+    /// GAZEBO_INDEX_SEARCH_PATHS=1 also lists every model and gazebo path
+    /// once, and skips the paths that can't contain a file.
     class GZ_COMMON_VISIBLE SystemPaths : public SingletonT<SystemPaths>
     {
       /// Constructor for SystemPaths
       private: SystemPaths();
 
+      /// \brief Destructor
+      private: virtual ~SystemPaths();
+
       /// \brief Get the log path
       /// \return the path
       public: std::string GetLogPath() const;
@@ -95,6 +129,12 @@ namespace gazebo
       /// E.g.: /tmp/gazebo_234123 (Linux).
       public: const std::string &TmpInstancePath() const;
 
+      /// \brief Create a new unique temporary path for this instance,
+      /// for a process that is forked from another gazebo process, and
+      /// would otherwise share its path.
+      /// \sa TmpInstancePath()
+      public: void ResetTmpInstancePath();
+
       /// Returns the default temporary test path.
       /// \return a full path name to directory.
       /// E.g.: /tmp/gazebo_test (Linux).
@@ -163,6 +203,40 @@ namespace gazebo
       /// \param[in] _suffix The suffix to add
       public: void AddSearchPathSuffix(const std::string &_suffix);
 
+      /// \brief Enable the cache of the paths found by FindFile and
+      /// FindFileURI. Files that aren't found are never cached.
+      /// \param[in] _enable False to search the paths on every lookup.
+      public: void SetFindFileCache(const bool _enable);
+
+      /// \brief Enable the index of the model and gazebo paths. Each path
+      /// is listed the first time it is searched, and a file is only probed
+      /// in the paths that contain the first directory of its name.
+      /// \param[in] _enable True to use the index.
+      public: void SetSearchPathIndex(const bool _enable);
+
+      /// \brief Forget the cached paths and the index. Must be called after
+      /// adding files to the search paths while the index is used, or after
+      /// removing a file that was found.
+      public: void ClearFindFileCache();
+
+      /// \brief Get the counters of the cache.
+      /// \return Copy of the counters.
+      public: FindFileStats FindFileCacheStats() const;
+
+      /// \brief Find a file or path using a URI, without the cache.
+      /// \param[in] _uri the uniform resource identifier
+      /// \return Returns full path name to file or an empty string if URI
+      /// couldn't be found.
+      private: std::string FindFileURIUncached(const std::string &_uri);
+
+      /// \brief Find a file in the gazebo paths, without the cache.
+      /// \param[in] _filename Name of the file to find.
+      /// \param[in] _searchLocalPath True to search in the current working
+      /// directory.
+      /// \return Returns full path name to file
+      private: std::string FindFileUncached(const std::string &_filename,
+                                            bool _searchLocalPath);
+
       /// \brief re-read SystemPaths#gazeboPaths from environment variable
       private: void UpdateModelPaths();
 
@@ -219,6 +293,10 @@ namespace gazebo
 
       /// \brief Path to the instance temporary directory
       private: boost::filesystem::path tmpInstancePath;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SystemPathsPrivate> dataPtr;
     };
     /// \}
   }
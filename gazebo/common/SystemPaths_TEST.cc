@@ -16,6 +16,8 @@
 */
 #include <gtest/gtest.h>
 
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -90,6 +92,68 @@ TEST_F(SystemPathsTest, FindFile)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, FindFileCache)
+{
+  common::SystemPaths *paths = common::SystemPaths::Instance();
+
+  boost::filesystem::path dir = boost::filesystem::path(paths->TmpPath()) /
+      boost::filesystem::unique_path("gazebo_find_file_%%%%%%");
+  boost::filesystem::create_directories(dir / "first");
+  std::ofstream((dir / "first" / "file.txt").string()) << "test";
+  paths->AddGazeboPaths(dir.string());
+  paths->SetFindFileCache(true);
+  paths->SetSearchPathIndex(false);
+
+  common::FindFileStats before = paths->FindFileCacheStats();
+  std::string found = paths->FindFile("first/file.txt", false);
+  EXPECT_EQ((dir / "first" / "file.txt").string(), found);
+  EXPECT_EQ(found, paths->FindFile("first/file.txt", false));
+  common::FindFileStats after = paths->FindFileCacheStats();
+  EXPECT_EQ(before.misses + 1, after.misses);
+  EXPECT_EQ(before.hits + 1, after.hits);
+  EXPECT_GE(after.entries, 1u);
+
+  // Missing files aren't cached
+  EXPECT_EQ("", paths->FindFile("first/missing.txt", false));
+  EXPECT_EQ("", paths->FindFile("first/missing.txt", false));
+  EXPECT_EQ(after.misses + 2, paths->FindFileCacheStats().misses);
+
+  paths->ClearFindFileCache();
+  EXPECT_EQ(0u, paths->FindFileCacheStats().entries);
+
+  // The index skips the paths that don't contain the first directory, and
+  // doesn't see new directories until it is cleared
+  paths->SetSearchPathIndex(true);
+  EXPECT_EQ(found, paths->FindFile("first/file.txt", false));
+  EXPECT_GE(paths->FindFileCacheStats().indexedDirectories, 1u);
+  boost::filesystem::create_directories(dir / "second");
+  std::ofstream((dir / "second" / "file.txt").string()) << "test";
+  EXPECT_EQ("", paths->FindFile("second/file.txt", false));
+  paths->ClearFindFileCache();
+  EXPECT_EQ((dir / "second" / "file.txt").string(),
+      paths->FindFile("second/file.txt", false));
+  EXPECT_GT(paths->FindFileCacheStats().skippedProbes, 0u);
+
+  paths->SetSearchPathIndex(false);
+  paths->ClearGazeboPaths();
+  boost::filesystem::remove_all(dir);
+}
+
+//////////////////////////////////////////////////
+TEST_F(SystemPathsTest, ResetTmpInstancePath)
+{
+  common::SystemPaths *paths = common::SystemPaths::Instance();
+  const std::string path = paths->TmpInstancePath();
+  EXPECT_FALSE(path.empty());
+
+  paths->ResetTmpInstancePath();
+  EXPECT_FALSE(paths->TmpInstancePath().empty());
+  EXPECT_NE(path, paths->TmpInstancePath());
+  EXPECT_EQ(paths->TmpInstancePath() + "/gazebo_test",
+      paths->DefaultTestPath());
+}
+
 //////////////////////////////////////////////////
 TEST_F(SystemPathsTest, SystemPaths)
 {
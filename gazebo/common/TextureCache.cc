@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Image.hh"
+#include "gazebo/common/TextureCache.hh"
+
+using namespace gazebo;
+using namespace common;
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief An uncompressed RGBA image.
+    class TextureCacheImage
+    {
+      /// \brief Get a pixel, clamping the coordinates to the image.
+      /// \param[in] _x Column.
+      /// \param[in] _y Row.
+      /// \return Pointer to the 4 bytes of the pixel.
+      public: const unsigned char *Pixel(const unsigned int _x,
+                                         const unsigned int _y) const
+              {
+                return &this->data[(std::min(_y, this->height - 1) *
+                    this->width + std::min(_x, this->width - 1)) * 4];
+              }
+
+      /// \brief Width in pixels.
+      public: unsigned int width = 0;
+
+      /// \brief Height in pixels.
+      public: unsigned int height = 0;
+
+      /// \brief Pixels, top row first.
+      public: std::vector<unsigned char> data;
+    };
+
+    /// \internal
+    /// \brief Private data for TextureCache
+    class TextureCachePrivate
+    {
+      /// \brief Get the key that identifies the current version of an
+      /// image file.
+      /// \param[in] _filename Full path of the image file.
+      /// \param[out] _key The key.
+      /// \return False if the file can't be inspected.
+      public: static bool Key(const std::string &_filename, std::string &_key)
+              {
+                boost::system::error_code ec;
+                std::time_t mtime =
+                    boost::filesystem::last_write_time(_filename, ec);
+                if (ec)
+                  return false;
+                uintmax_t size = boost::filesystem::file_size(_filename, ec);
+                if (ec)
+                  return false;
+
+                std::ostringstream stream;
+                stream << _filename << '\n' << mtime << '\n' << size << '\n'
+                       << TextureCache::kVersion;
+                _key = stream.str();
+                return true;
+              }
+
+      /// \brief Get the path of a cache entry for a key.
+      /// \param[in] _key Key returned by Key().
+      /// \param[in] _suffix Appended to the hash of the key.
+      /// \return Path of the entry.
+      public: std::string EntryPath(const std::string &_key,
+                                    const std::string &_suffix) const
+              {
+                // 64 bit FNV-1a
+                uint64_t hash = 14695981039346656037ULL;
+                for (auto const c : _key)
+                {
+                  hash ^= static_cast<unsigned char>(c);
+                  hash *= 1099511628211ULL;
+                }
+
+                std::ostringstream stream;
+                stream << std::hex << std::setw(16) << std::setfill('0')
+                       << hash << _suffix << ".dds";
+                return (boost::filesystem::path(this->path) /
+                    stream.str()).string();
+              }
+
+      /// \brief Get the next level of a mip chain with a box filter.
+      /// \param[in] _image A mip level larger than one pixel.
+      /// \return The level of half the size.
+      public: static TextureCacheImage HalfSize(
+                  const TextureCacheImage &_image)
+              {
+                TextureCacheImage result;
+                result.width = std::max(1u, _image.width / 2);
+                result.height = std::max(1u, _image.height / 2);
+                result.data.resize(result.width * result.height * 4);
+
+                unsigned char *dst = result.data.data();
+                for (unsigned int y = 0; y < result.height; ++y)
+                {
+                  for (unsigned int x = 0; x < result.width; ++x)
+                  {
+                    const unsigned char *p[4] = {
+                      _image.Pixel(x * 2, y * 2),
+                      _image.Pixel(x * 2 + 1, y * 2),
+                      _image.Pixel(x * 2, y * 2 + 1),
+                      _image.Pixel(x * 2 + 1, y * 2 + 1)};
+                    for (unsigned int c = 0; c < 4; ++c)
+                    {
+                      *dst++ = static_cast<unsigned char>(
+                          (p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+                    }
+                  }
+                }
+                return result;
+              }
+
+      /// \brief Append a little endian value to a buffer.
+      /// \param[in] _value The value.
+      /// \param[in] _bytes Number of bytes of the value to append.
+      /// \param[in,out] _buffer The buffer.
+      public: static void Write(const uint64_t _value,
+                                const unsigned int _bytes,
+                                std::string &_buffer)
+              {
+                for (unsigned int i = 0; i < _bytes; ++i)
+                  _buffer.push_back(static_cast<char>((_value >> (i * 8))));
+              }
+
+      /// \brief Convert a color to 16 bit RGB 5:6:5.
+      /// \param[in] _rgb The 8 bit color.
+      /// \return The 16 bit color.
+      public: static uint16_t To565(const int *_rgb)
+              {
+                return static_cast<uint16_t>(((_rgb[0] >> 3) << 11) |
+                    ((_rgb[1] >> 2) << 5) | (_rgb[2] >> 3));
+              }
+
+      /// \brief Convert a 16 bit RGB 5:6:5 color to 8 bit values.
+      /// \param[in] _color The 16 bit color.
+      /// \param[out] _rgb The 8 bit color.
+      public: static void From565(const uint16_t _color, int *_rgb)
+              {
+                const int r = (_color >> 11) & 31;
+                const int g = (_color >> 5) & 63;
+                const int b = _color & 31;
+                _rgb[0] = (r << 3) | (r >> 2);
+                _rgb[1] = (g << 2) | (g >> 4);
+                _rgb[2] = (b << 3) | (b >> 2);
+              }
+
+      /// \brief Append the BC1 color block of 16 pixels. The endpoints are
+      /// the corners of the bounding box of the colors, moved inwards by a
+      /// sixteenth of its size, which is always in the four color mode.
+      /// \param[in] _pixels The 16 RGBA pixels, row by row.
+      /// \param[in,out] _buffer The buffer.
+      public: static void EncodeColor(const unsigned char *_pixels,
+                                      std::string &_buffer)
+              {
+                int minColor[3] = {255, 255, 255};
+                int maxColor[3] = {0, 0, 0};
+                for (unsigned int i = 0; i < 16; ++i)
+                {
+                  for (unsigned int c = 0; c < 3; ++c)
+                  {
+                    minColor[c] = std::min(minColor[c],
+                        static_cast<int>(_pixels[i * 4 + c]));
+                    maxColor[c] = std::max(maxColor[c],
+                        static_cast<int>(_pixels[i * 4 + c]));
+                  }
+                }
+                for (unsigned int c = 0; c < 3; ++c)
+                {
+                  const int inset = (maxColor[c] - minColor[c]) / 16;
+                  minColor[c] += inset;
+                  maxColor[c] -= inset;
+                }
+
+                uint16_t c0 = To565(maxColor);
+                uint16_t c1 = To565(minColor);
+                if (c0 < c1)
+                  std::swap(c0, c1);
+
+                uint32_t indices = 0;
+                if (c0 != c1)
+                {
+                  int palette[4][3];
+                  From565(c0, palette[0]);
+                  From565(c1, palette[1]);
+                  for (unsigned int c = 0; c < 3; ++c)
+                  {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                  }
+
+                  for (unsigned int i = 0; i < 16; ++i)
+                  {
+                    int best = 0;
+                    int bestDist = -1;
+                    for (int j = 0; j < 4; ++j)
+                    {
+                      int dist = 0;
+                      for (unsigned int c = 0; c < 3; ++c)
+                      {
+                        const int d = _pixels[i * 4 + c] - palette[j][c];
+                        dist += d * d;
+                      }
+                      if (bestDist < 0 || dist < bestDist)
+                      {
+                        best = j;
+                        bestDist = dist;
+                      }
+                    }
+                    indices |= static_cast<uint32_t>(best) << (i * 2);
+                  }
+                }
+
+                Write(c0, 2, _buffer);
+                Write(c1, 2, _buffer);
+                Write(indices, 4, _buffer);
+              }
+
+      /// \brief Append the BC3 alpha block of 16 pixels, in the eight
+      /// value mode between the smallest and largest alpha.
+      /// \param[in] _pixels The 16 RGBA pixels, row by row.
+      /// \param[in,out] _buffer The buffer.
+      public: static void EncodeAlpha(const unsigned char *_pixels,
+                                      std::string &_buffer)
+              {
+                int a0 = 0;
+                int a1 = 255;
+                for (unsigned int i = 0; i < 16; ++i)
+                {
+                  a0 = std::max(a0, static_cast<int>(_pixels[i * 4 + 3]));
+                  a1 = std::min(a1, static_cast<int>(_pixels[i * 4 + 3]));
+                }
+
+                uint64_t indices = 0;
+                if (a0 != a1)
+                {
+                  // Codes 0 and 1 are the endpoints, codes 2 to 7 the
+                  // values in between, from a0 to a1.
+                  int palette[8] = {a0, a1};
+                  for (int j = 1; j < 7; ++j)
+                    palette[j + 1] = ((7 - j) * a0 + j * a1) / 7;
+
+                  for (unsigned int i = 0; i < 16; ++i)
+                  {
+                    uint64_t best = 0;
+                    int bestDist = 256;
+                    for (unsigned int j = 0; j < 8; ++j)
+                    {
+                      const int dist = std::abs(_pixels[i * 4 + 3] -
+                          palette[j]);
+                      if (dist < bestDist)
+                      {
+                        best = j;
+                        bestDist = dist;
+                      }
+                    }
+                    indices |= best << (i * 3);
+                  }
+                }
+
+                Write(static_cast<uint64_t>(a0), 1, _buffer);
+                Write(static_cast<uint64_t>(a1), 1, _buffer);
+                Write(indices, 6, _buffer);
+              }
+
+      /// \brief Append a compressed mip level.
+      /// \param[in] _image The mip level.
+      /// \param[in] _alpha True for BC3, false for BC1.
+      /// \param[in,out] _buffer The buffer.
+      public: static void Encode(const TextureCacheImage &_image,
+                                 const bool _alpha, std::string &_buffer)
+              {
+                unsigned char block[64];
+                for (unsigned int by = 0; by < _image.height; by += 4)
+                {
+                  for (unsigned int bx = 0; bx < _image.width; bx += 4)
+                  {
+                    // Blocks on the right and bottom edges repeat the last
+                    // column and row.
+                    for (unsigned int i = 0; i < 16; ++i)
+                    {
+                      const unsigned char *p =
+                          _image.Pixel(bx + i % 4, by + i / 4);
+                      std::copy(p, p + 4, block + i * 4);
+                    }
+                    if (_alpha)
+                      EncodeAlpha(block, _buffer);
+                    EncodeColor(block, _buffer);
+                  }
+                }
+              }
+
+      /// \brief Create a DDS file from mip levels.
+      /// \param[in] _levels The mip levels, largest first.
+      /// \param[in] _first Index of the first level to write.
+      /// \param[in] _alpha True for BC3, false for BC1.
+      /// \return Content of the file.
+      public: static std::string Dds(
+                  const std::vector<TextureCacheImage> &_levels,
+                  const std::size_t _first, const bool _alpha)
+              {
+                const unsigned int blockSize = _alpha ? 16 : 8;
+                const TextureCacheImage &top = _levels[_first];
+
+                std::string buffer("DDS ");
+                Write(124, 4, buffer);
+                // Caps, height, width, pixel format, mip count and linear
+                // size are set
+                Write(0xA1007, 4, buffer);
+                Write(top.height, 4, buffer);
+                Write(top.width, 4, buffer);
+                Write(((top.width + 3) / 4) * ((top.height + 3) / 4) *
+                    blockSize, 4, buffer);
+                Write(0, 4, buffer);
+                Write(_levels.size() - _first, 4, buffer);
+                buffer.append(11 * 4, '\0');
+
+                // Pixel format with a four character code
+                Write(32, 4, buffer);
+                Write(0x4, 4, buffer);
+                buffer.append(_alpha ? "DXT5" : "DXT1");
+                buffer.append(5 * 4, '\0');
+
+                // Complex mipmapped texture
+                Write(0x401008, 4, buffer);
+                buffer.append(4 * 4, '\0');
+
+                for (std::size_t i = _first; i < _levels.size(); ++i)
+                  Encode(_levels[i], _alpha, buffer);
+                return buffer;
+              }
+
+      /// \brief Write a file atomically, through a temporary file that is
+      /// renamed, so that other processes never see a partial entry.
+      /// \param[in] _path Path of the file.
+      /// \param[in] _data Content of the file.
+      /// \return True if the file was written.
+      public: static bool WriteFile(const std::string &_path,
+                                    const std::string &_data)
+              {
+                boost::system::error_code ec;
+                boost::filesystem::path tmpPath =
+                    boost::filesystem::unique_path(
+                    _path + ".%%%%-%%%%-%%%%", ec);
+                if (ec)
+                  return false;
+
+                {
+                  std::ofstream out(tmpPath.string(),
+                      std::ios::out | std::ios::binary);
+                  out.write(_data.data(), _data.size());
+                  if (!out)
+                  {
+                    out.close();
+                    boost::filesystem::remove(tmpPath, ec);
+                    gzwarn << "Unable to write texture cache entry["
+                           << _path << "]\n";
+                    return false;
+                  }
+                }
+
+                boost::filesystem::rename(tmpPath, _path, ec);
+                if (ec)
+                {
+                  boost::filesystem::remove(tmpPath, ec);
+                  return false;
+                }
+                return true;
+              }
+
+      /// \brief Cache directory.
+      public: std::string path;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+TextureCache::TextureCache(const std::string &_path)
+: dataPtr(new TextureCachePrivate)
+{
+  this->dataPtr->path = _path;
+}
+
+/////////////////////////////////////////////////
+TextureCache::~TextureCache()
+{
+}
+
+/////////////////////////////////////////////////
+bool TextureCache::Find(const std::string &_filename, std::string &_full,
+    std::string &_low) const
+{
+  std::string key;
+  if (!TextureCachePrivate::Key(_filename, key))
+    return false;
+
+  boost::system::error_code ec;
+  _full = this->dataPtr->EntryPath(key, "");
+  if (!boost::filesystem::exists(_full, ec))
+    return false;
+
+  // The low resolution entry is written first
+  _low = this->dataPtr->EntryPath(key, "_low");
+  if (!boost::filesystem::exists(_low, ec))
+    _low.clear();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TextureCache::Save(const std::string &_filename) const
+{
+  std::string key;
+  if (!TextureCachePrivate::Key(_filename, key))
+    return false;
+
+  Image image;
+  if (image.Load(_filename) != 0 || !image.Valid())
+    return false;
+
+  std::vector<TextureCacheImage> levels(1);
+  levels[0].width = image.GetWidth();
+  levels[0].height = image.GetHeight();
+  if (levels[0].width == 0 || levels[0].height == 0)
+    return false;
+
+  unsigned char *data = nullptr;
+  unsigned int count = 0;
+  image.GetRGBAData(&data, count);
+  levels[0].data.assign(data, data + count);
+  delete [] data;
+
+  bool alpha = false;
+  for (unsigned int i = 3; i < count && !alpha; i += 4)
+    alpha = levels[0].data[i] != 255;
+
+  std::size_t lowLevel = 0;
+  while (levels.back().width > 1 || levels.back().height > 1)
+  {
+    levels.push_back(TextureCachePrivate::HalfSize(levels.back()));
+    if (lowLevel == 0 && levels.back().width <= kLowSize &&
+        levels.back().height <= kLowSize)
+    {
+      lowLevel = levels.size() - 1;
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dataPtr->path, ec);
+
+  if (levels[0].width > kLowSize || levels[0].height > kLowSize)
+  {
+    if (!TextureCachePrivate::WriteFile(
+        this->dataPtr->EntryPath(key, "_low"),
+        TextureCachePrivate::Dds(levels, lowLevel, alpha)))
+    {
+      return false;
+    }
+  }
+
+  return TextureCachePrivate::WriteFile(this->dataPtr->EntryPath(key, ""),
+      TextureCachePrivate::Dds(levels, 0, alpha));
+}
+
+/////////////////////////////////////////////////
+std::string TextureCache::Path() const
+{
+  return this->dataPtr->path;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_TEXTURECACHE_HH_
+#define GAZEBO_COMMON_TEXTURECACHE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class TextureCachePrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class TextureCache TextureCache.hh common/common.hh
+    /// \brief On-disk cache of compressed textures.
+    ///
+    /// Each image file is converted to a DDS file that holds its full mip
+    /// chain, compressed with BC1 (DXT1) when the image is opaque and BC3
+    /// (DXT5) otherwise. Images larger than kLowSize get a second, small
+    /// DDS file with the mip levels that fit in kLowSize, which can be
+    /// loaded first while the full texture is read. As with MeshCache,
+    /// entry names are a hash of the image file's path, modification time,
+    /// size and the cache format version, and entries are written
+    /// atomically, so several processes can share the same directory.
+    class GZ_COMMON_VISIBLE TextureCache
+    {
+      /// \brief Version of the cache format. Increment it when the format
+      /// or the encoder changes.
+      public: static const uint32_t kVersion = 1;
+
+      /// \brief Largest width and height of the low resolution entry.
+      public: static const unsigned int kLowSize = 128;
+
+      /// \brief Constructor
+      /// \param[in] _path Directory that holds the cache entries. It is
+      /// created when the first entry is saved.
+      public: explicit TextureCache(const std::string &_path);
+
+      /// \brief Destructor
+      public: virtual ~TextureCache();
+
+      /// \brief Find the entries of an image file.
+      /// \param[in] _filename Full path of the image file.
+      /// \param[out] _full Path of the DDS file with every mip level.
+      /// \param[out] _low Path of the low resolution DDS file, or an empty
+      /// string if the image isn't larger than kLowSize.
+      /// \return True if the cache holds an up to date entry for the file.
+      public: bool Find(const std::string &_filename, std::string &_full,
+                        std::string &_low) const;
+
+      /// \brief Convert an image file and save it to the cache. This can
+      /// be called from any thread.
+      /// \param[in] _filename Full path of a PNG, JPEG or BMP file.
+      /// \return True if the entries were written.
+      public: bool Save(const std::string &_filename) const;
+
+      /// \brief Get the cache directory.
+      /// \return Directory that holds the cache entries.
+      public: std::string Path() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<TextureCachePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <boost/filesystem.hpp>
+
+#include "test_config.h"
+#include "gazebo/common/TextureCache.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TextureCache : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Read a little endian 32 bit value of a DDS header.
+/// \param[in] _data Content of the DDS file.
+/// \param[in] _offset Offset of the value.
+/// \return The value.
+uint32_t ddsValue(const std::string &_data, const std::size_t _offset)
+{
+  uint32_t value = 0;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    value |= static_cast<uint32_t>(
+        static_cast<unsigned char>(_data[_offset + i])) << (i * 8);
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+/// \param[in] _path Path of the file.
+/// \return Content of the file.
+std::string readFile(const std::string &_path)
+{
+  std::ifstream in(_path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TextureCache, Opaque)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_texture_cache_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+
+  // Work on a copy, so that its modification time can be changed.
+  std::string imageFile = (dir / "wood.jpg").string();
+  boost::filesystem::copy_file(
+      std::string(PROJECT_SOURCE_PATH) + "/media/materials/textures/wood.jpg",
+      imageFile);
+
+  common::TextureCache cache((dir / "cache").string());
+  EXPECT_EQ((dir / "cache").string(), cache.Path());
+
+  // Nothing cached yet
+  std::string full, low;
+  EXPECT_FALSE(cache.Find(imageFile, full, low));
+  EXPECT_FALSE(cache.Save((dir / "missing.png").string()));
+
+  EXPECT_TRUE(cache.Save(imageFile));
+  ASSERT_TRUE(cache.Find(imageFile, full, low));
+
+  // 496x329 with 9 mip levels, in DXT1 blocks of 8 bytes.
+  std::string data = readFile(full);
+  ASSERT_GT(data.size(), 128u);
+  EXPECT_EQ(0, data.compare(0, 4, "DDS "));
+  EXPECT_EQ(329u, ddsValue(data, 12));
+  EXPECT_EQ(496u, ddsValue(data, 16));
+  EXPECT_EQ(9u, ddsValue(data, 28));
+  EXPECT_EQ(0, data.compare(84, 4, "DXT1"));
+  EXPECT_EQ(124u * 83u * 8u, ddsValue(data, 20));
+
+  // The low resolution file starts at 124x82
+  ASSERT_FALSE(low.empty());
+  data = readFile(low);
+  ASSERT_GT(data.size(), 128u);
+  EXPECT_EQ(82u, ddsValue(data, 12));
+  EXPECT_EQ(124u, ddsValue(data, 16));
+  EXPECT_EQ(7u, ddsValue(data, 28));
+  EXPECT_EQ(0, data.compare(84, 4, "DXT1"));
+
+  // A modified image file doesn't use the stale entry
+  boost::filesystem::last_write_time(imageFile,
+      boost::filesystem::last_write_time(imageFile) + 10);
+  EXPECT_FALSE(cache.Find(imageFile, full, low));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TextureCache, Alpha)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_texture_cache_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+
+  std::string imageFile = std::string(PROJECT_SOURCE_PATH) +
+      "/media/materials/textures/building_frame.png";
+
+  common::TextureCache cache((dir / "cache").string());
+  EXPECT_TRUE(cache.Save(imageFile));
+
+  std::string full, low;
+  ASSERT_TRUE(cache.Find(imageFile, full, low));
+
+  // A 100x100 image has no low resolution file
+  EXPECT_TRUE(low.empty());
+
+  std::string data = readFile(full);
+  ASSERT_GT(data.size(), 128u);
+  EXPECT_EQ(100u, ddsValue(data, 12));
+  EXPECT_EQ(100u, ddsValue(data, 16));
+  EXPECT_EQ(7u, ddsValue(data, 28));
+  EXPECT_EQ(0, data.compare(84, 4, "DXT5"));
+
+  // Every level down to 1x1 uses at least one block of 16 bytes
+  std::size_t size = 0;
+  for (unsigned int s = 100; s > 0; s /= 2)
+    size += ((s + 3) / 4) * ((s + 3) / 4) * 16;
+  EXPECT_EQ(128u + size, data.size());
+
+  boost::filesystem::remove_all(dir);
+}
+
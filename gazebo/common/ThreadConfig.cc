@@ -0,0 +1,425 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <tbb/task_scheduler_init.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadConfig.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Applies the settings of the tasks class to the TBB worker
+    /// threads when they join the scheduler.
+    class TaskObserver : public tbb::task_scheduler_observer
+    {
+      /// \brief Constructor. Starts observing.
+      public: TaskObserver()
+      {
+        this->observe(true);
+      }
+
+      /// \brief Destructor. Stops observing.
+      public: virtual ~TaskObserver()
+      {
+        this->observe(false);
+      }
+
+      // Documentation inherited
+      public: virtual void on_scheduler_entry(bool _worker)
+      {
+        if (_worker)
+          ThreadConfig::Instance()->Apply("tasks");
+      }
+    };
+
+    /// \internal
+    /// \brief Private data for the ThreadConfig class.
+    class ThreadConfigPrivate
+    {
+      /// \brief Settings, by class.
+      public: std::map<std::string, ThreadSettings> classes;
+
+      /// \brief Classes whose failures were reported.
+      public: std::set<std::string> warned;
+
+      /// \brief Bounds the TBB worker threads.
+      public: std::unique_ptr<tbb::task_scheduler_init> taskInit;
+
+      /// \brief Applies the settings to the TBB worker threads.
+      public: std::unique_ptr<TaskObserver> taskObserver;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace common;
+
+/////////////////////////////////////////////////
+/// \brief Parse an integer.
+/// \param[in] _str The string.
+/// \param[out] _value The integer.
+/// \return False if _str isn't an integer.
+static bool parseInt(const std::string &_str, int &_value)
+{
+  try
+  {
+    std::size_t end = 0;
+    _value = std::stoi(_str, &end);
+    return end == _str.size();
+  }
+  catch(...)
+  {
+    return false;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Split a string.
+/// \param[in] _str The string.
+/// \param[in] _delim The delimiter.
+/// \return The parts, without the spaces around them and the empty ones.
+static std::vector<std::string> split(const std::string &_str,
+    const char _delim)
+{
+  std::vector<std::string> parts;
+  std::istringstream stream(_str);
+  std::string part;
+  while (std::getline(stream, part, _delim))
+  {
+    const std::size_t first = part.find_first_not_of(" \t\n");
+    if (first == std::string::npos)
+      continue;
+    const std::size_t last = part.find_last_not_of(" \t\n");
+    parts.push_back(part.substr(first, last - first + 1));
+  }
+  return parts;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the CPUs of a NUMA node.
+/// \param[in] _node The node.
+/// \param[out] _cpus Its CPUs.
+/// \return False if the node doesn't exist.
+static bool numaCpus(const int _node, std::vector<int> &_cpus)
+{
+  std::ifstream file("/sys/devices/system/node/node" +
+      std::to_string(_node) + "/cpulist");
+  std::string list;
+  if (!std::getline(file, list))
+    return false;
+  return ThreadConfig::ParseCpuList(list, _cpus) && !_cpus.empty();
+}
+
+/////////////////////////////////////////////////
+ThreadConfig::ThreadConfig()
+  : dataPtr(new ThreadConfigPrivate)
+{
+  const char *spec = getEnv("GAZEBO_THREAD_CONFIG");
+  if (spec && *spec && !this->Parse(spec))
+    gzwarn << "Invalid GAZEBO_THREAD_CONFIG[" << spec << "]\n";
+}
+
+/////////////////////////////////////////////////
+ThreadConfig::~ThreadConfig()
+{
+  this->dataPtr->taskObserver.reset();
+  this->dataPtr->taskInit.reset();
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Parse(const std::string &_spec, const bool _override)
+{
+  static const std::set<std::string> policies =
+    {"other", "batch", "idle", "fifo", "rr"};
+
+  std::map<std::string, ThreadSettings> parsed;
+  for (auto const &entry : split(_spec, ';'))
+  {
+    const std::size_t colon = entry.find(':');
+    const std::string name = entry.substr(0, colon);
+    if (name.empty())
+    {
+      gzerr << "Missing thread class in [" << entry << "]\n";
+      return false;
+    }
+
+    ThreadSettings &settings = parsed[name];
+    if (colon == std::string::npos)
+      continue;
+
+    // The CPU lists contain commas, so a part without '=' continues the
+    // value before it.
+    std::string key;
+    for (auto const &part : split(entry.substr(colon + 1), ','))
+    {
+      const std::size_t equal = part.find('=');
+      std::string value;
+      if (equal == std::string::npos)
+      {
+        if (key != "cpus")
+        {
+          gzerr << "Invalid thread setting [" << part << "] of ["
+                << name << "]\n";
+          return false;
+        }
+        value = part;
+      }
+      else
+      {
+        key = part.substr(0, equal);
+        value = part.substr(equal + 1);
+      }
+
+      int number = 0;
+      bool valid = true;
+      if (key == "cpus")
+      {
+        std::vector<int> cpus;
+        valid = ParseCpuList(value, cpus);
+        settings.cpus.insert(settings.cpus.end(), cpus.begin(), cpus.end());
+      }
+      else if (key == "numa")
+      {
+        valid = parseInt(value, number) && number >= 0;
+        settings.numaNode = number;
+      }
+      else if (key == "policy")
+      {
+        valid = policies.count(value) > 0;
+        settings.policy = value;
+      }
+      else if (key == "priority")
+      {
+        valid = parseInt(value, number);
+        settings.priority = number;
+      }
+      else if (key == "pool")
+      {
+        valid = parseInt(value, number) && number >= 0;
+        settings.poolSize = static_cast<unsigned int>(number);
+      }
+      else
+      {
+        valid = false;
+      }
+
+      if (!valid)
+      {
+        gzerr << "Invalid thread setting [" << part << "] of ["
+              << name << "]\n";
+        return false;
+      }
+    }
+
+    std::sort(settings.cpus.begin(), settings.cpus.end());
+    settings.cpus.erase(std::unique(settings.cpus.begin(),
+          settings.cpus.end()), settings.cpus.end());
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &entry : parsed)
+  {
+    if (_override || !this->dataPtr->classes.count(entry.first))
+      this->dataPtr->classes[entry.first] = entry.second;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void ThreadConfig::Set(const std::string &_class,
+    const ThreadSettings &_settings)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->classes[_class] = _settings;
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Has(const std::string &_class) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->classes.count(_class) > 0;
+}
+
+/////////////////////////////////////////////////
+ThreadSettings ThreadConfig::Settings(const std::string &_class) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->classes.find(_class);
+  if (iter == this->dataPtr->classes.end())
+    return ThreadSettings();
+  return iter->second;
+}
+
+/////////////////////////////////////////////////
+void ThreadConfig::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->classes.clear();
+  this->dataPtr->warned.clear();
+}
+
+/////////////////////////////////////////////////
+unsigned int ThreadConfig::PoolSize(const std::string &_class,
+    const unsigned int _default) const
+{
+  const ThreadSettings settings = this->Settings(_class);
+  return settings.poolSize > 0 ? settings.poolSize : _default;
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::Apply(const std::string &_class) const
+{
+  const ThreadSettings settings = this->Settings(_class);
+
+  // Thread names are at most 15 characters on Linux.
+  const std::string name = ("gz-" + _class).substr(0, 15);
+  std::string error;
+
+#ifdef __linux__
+  pthread_setname_np(pthread_self(), name.c_str());
+
+  std::vector<int> cpus = settings.cpus;
+  if (cpus.empty() && settings.numaNode >= 0 &&
+      !numaCpus(settings.numaNode, cpus))
+  {
+    error = "unknown NUMA node " + std::to_string(settings.numaNode);
+  }
+
+  if (!cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+      error = "unable to set the CPU affinity";
+  }
+
+  bool realTime = settings.policy == "fifo" || settings.policy == "rr";
+  if (!settings.policy.empty())
+  {
+    int policy = SCHED_OTHER;
+    if (settings.policy == "fifo")
+      policy = SCHED_FIFO;
+    else if (settings.policy == "rr")
+      policy = SCHED_RR;
+    else if (settings.policy == "batch")
+      policy = SCHED_BATCH;
+    else if (settings.policy == "idle")
+      policy = SCHED_IDLE;
+
+    sched_param param;
+    param.sched_priority = realTime ? settings.priority : 0;
+    if (pthread_setschedparam(pthread_self(), policy, &param) != 0)
+      error = "unable to set the scheduling policy " + settings.policy;
+  }
+
+  // The nice value of a Linux thread is set through its id.
+  if (!realTime && settings.priority != 0 &&
+      setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)),
+        settings.priority) != 0)
+  {
+    error = "unable to set the nice value";
+  }
+#else
+#ifdef __APPLE__
+  pthread_setname_np(name.c_str());
+#endif
+  if (!settings.cpus.empty() || settings.numaNode >= 0 ||
+      !settings.policy.empty() || settings.priority != 0)
+  {
+    error = "thread settings are only supported on Linux";
+  }
+#endif
+
+  if (error.empty())
+    return true;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->warned.insert(_class).second)
+    gzwarn << "Thread class [" << _class << "]: " << error << "\n";
+  return false;
+}
+
+/////////////////////////////////////////////////
+void ThreadConfig::InitTaskPool()
+{
+  const ThreadSettings settings = this->Settings("tasks");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->classes.count("tasks") || this->dataPtr->taskObserver)
+    return;
+
+  if (settings.poolSize > 0)
+  {
+    this->dataPtr->taskInit.reset(
+        new tbb::task_scheduler_init(static_cast<int>(settings.poolSize)));
+  }
+  this->dataPtr->taskObserver.reset(new TaskObserver);
+}
+
+/////////////////////////////////////////////////
+bool ThreadConfig::ParseCpuList(const std::string &_list,
+    std::vector<int> &_cpus)
+{
+  _cpus.clear();
+  for (auto const &range : split(_list, ','))
+  {
+    const std::size_t dash = range.find('-');
+    int first = 0;
+    int last = 0;
+    if (!parseInt(range.substr(0, dash), first) || first < 0)
+      return false;
+
+    if (dash == std::string::npos)
+      last = first;
+    else if (!parseInt(range.substr(dash + 1), last) || last < first)
+      return false;
+
+    for (int cpu = first; cpu <= last; ++cpu)
+      _cpus.push_back(cpu);
+  }
+  return !_cpus.empty();
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_THREADCONFIG_HH_
+#define GAZEBO_COMMON_THREADCONFIG_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_COMMON_VISIBLE, gazebo, common, ThreadConfig)
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class.
+    class ThreadConfigPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \brief Placement and scheduling of a class of threads.
+    class GZ_COMMON_VISIBLE ThreadSettings
+    {
+      /// \brief CPUs the threads may run on, empty to not pin them.
+      public: std::vector<int> cpus;
+
+      /// \brief NUMA node whose CPUs the threads run on when cpus is
+      /// empty, -1 for none.
+      public: int numaNode = -1;
+
+      /// \brief Scheduling policy: "other", "batch", "idle", "fifo" or
+      /// "rr". Empty to keep the policy of the process.
+      public: std::string policy;
+
+      /// \brief Real time priority for "fifo" and "rr", from 1 to 99, or
+      /// nice value for the other policies.
+      public: int priority = 0;
+
+      /// \brief Largest number of threads of a pool, 0 for its default.
+      public: unsigned int poolSize = 0;
+    };
+
+    /// \class ThreadConfig ThreadConfig.hh common/common.hh
+    /// \brief Settings of the threads of gazebo, by class. Each thread
+    /// applies the settings of its class when it starts. The classes are:
+    ///
+    /// - physics: the world update loop. Its pool size bounds the
+    ///   narrow phase threads of ODE.
+    /// - log_worker: the thread that serializes the world state.
+    /// - log_record: the update, write and cleanup threads of LogRecord.
+    /// - log_compress: the compression threads of LogRecord. Its pool
+    ///   size is the number of threads.
+    /// - sensors: the sensor container threads.
+    /// - io: the asio thread of the transport.
+    /// - tasks: the TBB worker threads, which run the transport tasks
+    ///   and the parallel loops. Its pool size bounds their number.
+    ///
+    /// The settings are read from GAZEBO_THREAD_CONFIG, then from the
+    /// --thread_config option of gzserver, and last from the
+    /// <gz:threads> element of the world, which doesn't override the
+    /// classes set before. All use the format of Parse.
+    class GZ_COMMON_VISIBLE ThreadConfig
+      : public SingletonT<ThreadConfig>
+    {
+      /// \brief Constructor. Parses GAZEBO_THREAD_CONFIG.
+      private: ThreadConfig();
+
+      /// \brief Destructor.
+      private: virtual ~ThreadConfig();
+
+      /// \brief Parse settings, such as
+      /// "physics:cpus=0-3,policy=fifo,priority=50;io:cpus=4-7,numa=1".
+      /// Classes are separated by ';', and their settings by ','. The
+      /// keys are cpus, numa, policy, priority and pool.
+      /// \param[in] _spec Settings to parse.
+      /// \param[in] _override False to keep the classes already set.
+      /// \return False if _spec is invalid, in which case nothing is set.
+      public: bool Parse(const std::string &_spec,
+                  const bool _override = true);
+
+      /// \brief Set the settings of a class.
+      /// \param[in] _class Name of the class.
+      /// \param[in] _settings The settings.
+      public: void Set(const std::string &_class,
+                  const ThreadSettings &_settings);
+
+      /// \brief Get whether a class is set.
+      /// \param[in] _class Name of the class.
+      /// \return True if it is.
+      public: bool Has(const std::string &_class) const;
+
+      /// \brief Get the settings of a class.
+      /// \param[in] _class Name of the class.
+      /// \return The settings, default ones if the class isn't set.
+      public: ThreadSettings Settings(const std::string &_class) const;
+
+      /// \brief Remove the settings of all the classes.
+      public: void Clear();
+
+      /// \brief Get the size of a pool.
+      /// \param[in] _class Name of the class of the pool.
+      /// \param[in] _default Size used when the class bounds none.
+      /// \return The bounded size.
+      public: unsigned int PoolSize(const std::string &_class,
+                  const unsigned int _default) const;
+
+      /// \brief Name the calling thread after a class, and apply the
+      /// settings of the class to it. Failures are reported once per
+      /// class.
+      /// \param[in] _class Name of the class.
+      /// \return False if a setting couldn't be applied.
+      public: bool Apply(const std::string &_class) const;
+
+      /// \brief Bound the TBB worker threads by the pool size of the
+      /// tasks class, and apply its settings to them when they start.
+      /// Call it once, from the main thread, before the first TBB task.
+      public: void InitTaskPool();
+
+      /// \brief Parse a list of CPUs, such as "0-3,8,10-11".
+      /// \param[in] _list The list.
+      /// \param[out] _cpus The CPUs.
+      /// \return False if _list is invalid.
+      public: static bool ParseCpuList(const std::string &_list,
+                  std::vector<int> &_cpus);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ThreadConfigPrivate> dataPtr;
+
+      /// \brief This is a singleton class.
+      private: friend class SingletonT<ThreadConfig>;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/common/ThreadConfig.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ThreadConfigTest : public gazebo::testing::AutoLogFixture
+{
+  // Documentation inherited
+  protected: virtual void TearDown()
+  {
+    common::ThreadConfig::Instance()->Clear();
+  }
+};
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, ParseCpuList)
+{
+  std::vector<int> cpus;
+  EXPECT_TRUE(common::ThreadConfig::ParseCpuList("0-3,8, 10-11", cpus));
+  EXPECT_EQ(cpus, std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+
+  EXPECT_TRUE(common::ThreadConfig::ParseCpuList("5", cpus));
+  EXPECT_EQ(cpus, std::vector<int>({5}));
+
+  EXPECT_FALSE(common::ThreadConfig::ParseCpuList("", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpuList("3-1", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpuList("-1", cpus));
+  EXPECT_FALSE(common::ThreadConfig::ParseCpuList("a", cpus));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, Parse)
+{
+  common::ThreadConfig *config = common::ThreadConfig::Instance();
+  EXPECT_TRUE(config->Parse(
+        "physics:cpus=0-1,3,policy=fifo,priority=50,pool=4; "
+        "io:numa=1,policy=batch,priority=5;sensors"));
+
+  common::ThreadSettings physics = config->Settings("physics");
+  EXPECT_EQ(physics.cpus, std::vector<int>({0, 1, 3}));
+  EXPECT_EQ(physics.numaNode, -1);
+  EXPECT_EQ(physics.policy, "fifo");
+  EXPECT_EQ(physics.priority, 50);
+  EXPECT_EQ(physics.poolSize, 4u);
+  EXPECT_EQ(config->PoolSize("physics", 8), 4u);
+
+  common::ThreadSettings io = config->Settings("io");
+  EXPECT_TRUE(io.cpus.empty());
+  EXPECT_EQ(io.numaNode, 1);
+  EXPECT_EQ(io.policy, "batch");
+  EXPECT_EQ(io.priority, 5);
+  EXPECT_EQ(config->PoolSize("io", 8), 8u);
+
+  EXPECT_TRUE(config->Has("sensors"));
+  EXPECT_FALSE(config->Has("tasks"));
+  EXPECT_EQ(config->PoolSize("tasks", 2), 2u);
+
+  // Without override, only the classes not set yet are parsed
+  EXPECT_TRUE(config->Parse("physics:cpus=7;tasks:pool=2", false));
+  EXPECT_EQ(config->Settings("physics").cpus, std::vector<int>({0, 1, 3}));
+  EXPECT_EQ(config->PoolSize("tasks", 8), 2u);
+
+  // Invalid settings set nothing
+  EXPECT_FALSE(config->Parse("log_worker:cpus=1;physics:policy=fast"));
+  EXPECT_FALSE(config->Parse("log_worker:speed=1"));
+  EXPECT_FALSE(config->Parse("log_worker:pool=-1"));
+  EXPECT_FALSE(config->Parse(":cpus=1"));
+  EXPECT_FALSE(config->Has("log_worker"));
+  EXPECT_EQ(config->Settings("physics").policy, "fifo");
+}
+
+/////////////////////////////////////////////////
+TEST_F(ThreadConfigTest, Apply)
+{
+  common::ThreadConfig *config = common::ThreadConfig::Instance();
+
+  // A class without settings is only named
+  std::thread([config]()
+      {
+        EXPECT_TRUE(config->Apply("unset"));
+      }).join();
+
+#ifdef __linux__
+  // Pin to the first CPU the test may run on
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed))
+    ++cpu;
+
+  ASSERT_TRUE(config->Parse("pinned:cpus=" + std::to_string(cpu)));
+  std::thread([config, cpu]()
+      {
+        EXPECT_TRUE(config->Apply("pinned"));
+
+        char name[16];
+        ASSERT_EQ(pthread_getname_np(pthread_self(), name, sizeof(name)), 0);
+        EXPECT_STREQ(name, "gz-pinned");
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(set), &set),
+            0);
+        EXPECT_EQ(CPU_COUNT(&set), 1);
+        EXPECT_TRUE(CPU_ISSET(cpu, &set));
+      }).join();
+
+  // No such NUMA node
+  ASSERT_TRUE(config->Parse("far:numa=4096"));
+  std::thread([config]()
+      {
+        EXPECT_FALSE(config->Apply("far"));
+      }).join();
+#endif
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
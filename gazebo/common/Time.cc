@@ -33,6 +33,7 @@
 
 #include <time.h>
 #include <math.h>
+#include <chrono>
 #include <boost/date_time.hpp>
 
 #ifdef __MACH__
@@ -46,7 +47,6 @@
 using namespace gazebo;
 using namespace common;
 
-Time Time::wallTime;
 std::string Time::wallTimeISO;
 
 struct timespec Time::clockResolution;
@@ -219,12 +219,43 @@ const Time &Time::GetWallTime()
   tv.tv_sec = secSum;
   tv.tv_nsec = nsecSum;
 #else
-  clock_gettime(0, &tv);
+  clock_gettime(CLOCK_REALTIME, &tv);
 #endif
+  // Each thread has its own, so that concurrent callers don't race
+  static thread_local Time wallTime;
   wallTime = tv;
   return wallTime;
 }
 
+/////////////////////////////////////////////////
+int64_t Time::SteadyNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/////////////////////////////////////////////////
+Time Time::SteadyTime()
+{
+  return FromNs(SteadyNs());
+}
+
+/////////////////////////////////////////////////
+Time Time::FromNs(const int64_t _ns)
+{
+  Time result;
+  result.sec = static_cast<int32_t>(_ns / nsInSec);
+  result.nsec = static_cast<int32_t>(_ns % nsInSec);
+  result.Correct();
+  return result;
+}
+
+/////////////////////////////////////////////////
+int64_t Time::Ns() const
+{
+  return static_cast<int64_t>(this->sec) * nsInSec + this->nsec;
+}
+
 /////////////////////////////////////////////////
 const std::string &Time::GetWallTimeAsISOString()
 {
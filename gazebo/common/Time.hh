@@ -107,10 +107,31 @@ namespace gazebo
       /// data structure. This is approximately 68 years.
       public: static Time Maximum();
 
-      /// \brief Get the wall time
-      /// \return the current time
+      /// \brief Get the wall time. The wall time jumps when the system
+      /// clock is set, prefer SteadyNs() to measure durations.
+      /// \return the current time, in storage of the calling thread
       public: static const Time &GetWallTime();
 
+      /// \brief Get the time of the monotonic clock of the system, which
+      /// doesn't jump when the system clock is set. On Linux the clock is
+      /// read through the vDSO, without a system call.
+      /// \return Nanoseconds since an unspecified start.
+      public: static int64_t SteadyNs();
+
+      /// \brief Get the time of the monotonic clock of the system.
+      /// \return Time since an unspecified start.
+      /// \sa SteadyNs
+      public: static Time SteadyTime();
+
+      /// \brief Get a time from nanoseconds.
+      /// \param[in] _ns Nanoseconds.
+      /// \return The time.
+      public: static Time FromNs(const int64_t _ns);
+
+      /// \brief Get the time in nanoseconds.
+      /// \return Nanoseconds.
+      public: int64_t Ns() const;
+
       /// \brief Get the wall time as an ISO string: YYYY-MM-DDTHH:MM:SS
       /// \return The current wall time as an ISO string.
       public: static const std::string &GetWallTimeAsISOString();
@@ -468,9 +489,6 @@ namespace gazebo
       /// milliseconds.
       public: static const int32_t nsInMs;
 
-      /// \brief a singleton value of the last GetWallTime() value
-      private: static Time wallTime;
-
       /// \brief Wall time as an ISO string.
       private: static std::string wallTimeISO;
 
@@ -478,6 +496,13 @@ namespace gazebo
       /// preserve the internal seconds and nanoseconds separation
       private: inline void Correct()
                {
+                 // Most times are already normal
+                 if (this->nsec >= 0 && this->nsec < this->nsInSec &&
+                     this->sec >= 0)
+                 {
+                   return;
+                 }
+
                  // In the case sec and nsec have different signs, normalize
                  if (this->sec > 0 && this->nsec < 0)
                  {
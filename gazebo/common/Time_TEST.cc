@@ -252,6 +252,28 @@ TEST_F(TimeTest, Maximum)
   EXPECT_EQ(common::Time::Maximum(), maximum);
 }
 
+/////////////////////////////////////////////////
+TEST_F(TimeTest, Steady)
+{
+  const int64_t start = common::Time::SteadyNs();
+  common::Time::MSleep(10);
+  const int64_t end = common::Time::SteadyNs();
+  EXPECT_GE(end - start, 10000000);
+
+  EXPECT_LE(common::Time::FromNs(start), common::Time::SteadyTime());
+
+  EXPECT_EQ(common::Time(1, 500000000), common::Time::FromNs(1500000000));
+  EXPECT_EQ(common::Time(-1.5), common::Time::FromNs(-1500000000));
+  EXPECT_EQ(1500000000, common::Time(1, 500000000).Ns());
+  EXPECT_EQ(-1500000000, common::Time(-1.5).Ns());
+  EXPECT_EQ(start, common::Time::FromNs(start).Ns());
+
+  // Times that don't need a correction are left alone
+  common::Time time(2, 999999999);
+  time += common::Time(0, 1);
+  EXPECT_EQ(common::Time(3, 0), time);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
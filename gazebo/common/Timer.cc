@@ -46,13 +46,13 @@ void Timer::Start()
 {
   if (this->reset)
   {
-    this->start = Time::GetWallTime();
+    this->start = Time::SteadyTime();
     this->reset = false;
   }
   else if (!this->running)
   {
     // Add the time that has elapsed since stopping to the start time.
-    this->start += (Time::GetWallTime() - this->stop);
+    this->start += (Time::SteadyTime() - this->stop);
   }
 
   this->running = true;
@@ -61,7 +61,7 @@ void Timer::Start()
 //////////////////////////////////////////////////
 void Timer::Stop()
 {
-  this->stop = Time::GetWallTime();
+  this->stop = Time::SteadyTime();
   this->running = false;
 }
 
@@ -70,7 +70,7 @@ void Timer::Reset()
 {
   this->running = false;
   this->reset = true;
-  this->start = this->stop = Time::GetWallTime();
+  this->start = this->stop = Time::SteadyTime();
 }
 
 //////////////////////////////////////////////////
@@ -85,7 +85,7 @@ Time Timer::GetElapsed() const
   Time elapsedTime;
   if (this->running)
   {
-    elapsedTime = Time::GetWallTime() - this->start;
+    elapsedTime = Time::SteadyTime() - this->start;
   }
   else
   {
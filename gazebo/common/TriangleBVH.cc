@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gazebo/common/TriangleBVH.hh"
+
+using namespace gazebo;
+using namespace common;
+
+/// \brief Largest number of triangles in a leaf node.
+static const unsigned int kLeafSize = 4;
+
+namespace
+{
+  /// \brief Node of the hierarchy.
+  struct BVHNode
+  {
+    /// \brief Minimum corner of the bounds.
+    ignition::math::Vector3d min;
+
+    /// \brief Maximum corner of the bounds.
+    ignition::math::Vector3d max;
+
+    /// \brief Index of the first triangle of a leaf, or of the right child
+    /// of an inner node. The left child follows its parent.
+    unsigned int offset = 0;
+
+    /// \brief Number of triangles of a leaf, 0 for an inner node.
+    unsigned int count = 0;
+  };
+}
+
+/// \brief Private data for the TriangleBVH class
+class gazebo::common::TriangleBVHPrivate
+{
+  /// \brief Build the node of a range of triangles, and its children.
+  /// \param[in] _begin First entry of the range in the order.
+  /// \param[in] _end One past the last entry of the range.
+  /// \param[in] _centroids Centroid of every triangle.
+  public: void BuildNode(const unsigned int _begin, const unsigned int _end,
+              const std::vector<ignition::math::Vector3d> &_centroids);
+
+  /// \brief Test a ray against the bounds of a node.
+  /// \param[in] _node The node.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _invDir Inverse of each component of the direction.
+  /// \param[in] _maxDistance Distance of the closest hit so far.
+  /// \return True if the ray enters the bounds before _maxDistance.
+  public: bool HitBounds(const BVHNode &_node,
+              const ignition::math::Vector3d &_origin,
+              const ignition::math::Vector3d &_invDir,
+              const double _maxDistance) const;
+
+  /// \brief Get the squared distance from a point to the bounds of a
+  /// node.
+  /// \param[in] _node The node.
+  /// \param[in] _point The point.
+  /// \return 0 if the point is inside the bounds.
+  public: static double BoundsDistance(const BVHNode &_node,
+              const ignition::math::Vector3d &_point);
+
+  /// \brief Three vertices per triangle.
+  public: std::vector<ignition::math::Vector3d> vertices;
+
+  /// \brief Triangle indices, in the order of the leaves.
+  public: std::vector<unsigned int> order;
+
+  /// \brief Nodes in depth first order. The first node is the root.
+  public: std::vector<BVHNode> nodes;
+};
+
+//////////////////////////////////////////////////
+void TriangleBVHPrivate::BuildNode(const unsigned int _begin,
+    const unsigned int _end,
+    const std::vector<ignition::math::Vector3d> &_centroids)
+{
+  const unsigned int index = this->nodes.size();
+  this->nodes.push_back(BVHNode());
+
+  ignition::math::Vector3d min(ignition::math::MAX_D, ignition::math::MAX_D,
+      ignition::math::MAX_D);
+  ignition::math::Vector3d max(-min);
+  ignition::math::Vector3d centroidMin(min);
+  ignition::math::Vector3d centroidMax(max);
+  for (unsigned int i = _begin; i < _end; ++i)
+  {
+    const unsigned int triangle = this->order[i];
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      min.Min(this->vertices[triangle * 3 + j]);
+      max.Max(this->vertices[triangle * 3 + j]);
+    }
+    centroidMin.Min(_centroids[triangle]);
+    centroidMax.Max(_centroids[triangle]);
+  }
+  this->nodes[index].min = min;
+  this->nodes[index].max = max;
+
+  if (_end - _begin <= kLeafSize)
+  {
+    this->nodes[index].offset = _begin;
+    this->nodes[index].count = _end - _begin;
+    return;
+  }
+
+  // Split at the median centroid along the longest axis.
+  const ignition::math::Vector3d extent = centroidMax - centroidMin;
+  int axis = 0;
+  if (extent.Y() > extent.X())
+    axis = 1;
+  if (extent.Z() > extent[axis])
+    axis = 2;
+
+  const unsigned int middle = (_begin + _end) / 2;
+  std::nth_element(this->order.begin() + _begin,
+      this->order.begin() + middle, this->order.begin() + _end,
+      [&_centroids, axis](const unsigned int _a, const unsigned int _b)
+      {
+        return _centroids[_a][axis] < _centroids[_b][axis];
+      });
+
+  this->BuildNode(_begin, middle, _centroids);
+  this->nodes[index].offset = this->nodes.size();
+  this->BuildNode(middle, _end, _centroids);
+}
+
+//////////////////////////////////////////////////
+bool TriangleBVHPrivate::HitBounds(const BVHNode &_node,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_invDir, const double _maxDistance) const
+{
+  double tNear = 0;
+  double tFar = _maxDistance;
+  for (int i = 0; i < 3; ++i)
+  {
+    double t0 = (_node.min[i] - _origin[i]) * _invDir[i];
+    double t1 = (_node.max[i] - _origin[i]) * _invDir[i];
+    if (t0 > t1)
+      std::swap(t0, t1);
+
+    tNear = std::max(tNear, t0);
+    tFar = std::min(tFar, t1);
+    if (tNear > tFar)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+double TriangleBVHPrivate::BoundsDistance(const BVHNode &_node,
+    const ignition::math::Vector3d &_point)
+{
+  double result = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    const double d = std::max(std::max(_node.min[i] - _point[i], 0.0),
+        _point[i] - _node.max[i]);
+    result += d * d;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the point of a triangle closest to a point, following
+/// Ericson's Real-Time Collision Detection.
+/// \param[in] _p The point.
+/// \param[in] _a First vertex of the triangle.
+/// \param[in] _b Second vertex of the triangle.
+/// \param[in] _c Third vertex of the triangle.
+/// \return The closest point.
+static ignition::math::Vector3d closestOnTriangle(
+    const ignition::math::Vector3d &_p, const ignition::math::Vector3d &_a,
+    const ignition::math::Vector3d &_b, const ignition::math::Vector3d &_c)
+{
+  const ignition::math::Vector3d ab = _b - _a;
+  const ignition::math::Vector3d ac = _c - _a;
+  const ignition::math::Vector3d ap = _p - _a;
+  const double d1 = ab.Dot(ap);
+  const double d2 = ac.Dot(ap);
+  if (d1 <= 0 && d2 <= 0)
+    return _a;
+
+  const ignition::math::Vector3d bp = _p - _b;
+  const double d3 = ab.Dot(bp);
+  const double d4 = ac.Dot(bp);
+  if (d3 >= 0 && d4 <= d3)
+    return _b;
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0 && d1 >= 0 && d3 <= 0)
+    return _a + ab * (d1 / (d1 - d3));
+
+  const ignition::math::Vector3d cp = _p - _c;
+  const double d5 = ab.Dot(cp);
+  const double d6 = ac.Dot(cp);
+  if (d6 >= 0 && d5 <= d6)
+    return _c;
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0 && d2 >= 0 && d6 <= 0)
+    return _a + ac * (d2 / (d2 - d6));
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+    return _b + (_c - _b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+  const double denom = va + vb + vc;
+  if (std::abs(denom) <= 1e-300)
+    return _a;
+  return _a + ab * (vb / denom) + ac * (vc / denom);
+}
+
+//////////////////////////////////////////////////
+TriangleBVH::TriangleBVH()
+  : dataPtr(new TriangleBVHPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TriangleBVH::~TriangleBVH()
+{
+}
+
+//////////////////////////////////////////////////
+void TriangleBVH::Build(const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  this->dataPtr->vertices.clear();
+  this->dataPtr->order.clear();
+  this->dataPtr->nodes.clear();
+
+  std::vector<ignition::math::Vector3d> centroids;
+  for (size_t i = 0; i + 2 < _indices.size(); i += 3)
+  {
+    if (_indices[i] >= _vertices.size() ||
+        _indices[i + 1] >= _vertices.size() ||
+        _indices[i + 2] >= _vertices.size())
+    {
+      continue;
+    }
+
+    const ignition::math::Vector3d &a = _vertices[_indices[i]];
+    const ignition::math::Vector3d &b = _vertices[_indices[i + 1]];
+    const ignition::math::Vector3d &c = _vertices[_indices[i + 2]];
+    this->dataPtr->order.push_back(centroids.size());
+    centroids.push_back((a + b + c) / 3.0);
+    this->dataPtr->vertices.push_back(a);
+    this->dataPtr->vertices.push_back(b);
+    this->dataPtr->vertices.push_back(c);
+  }
+
+  if (centroids.empty())
+    return;
+
+  this->dataPtr->nodes.reserve(2 * centroids.size() / kLeafSize + 1);
+  this->dataPtr->BuildNode(0, centroids.size(), centroids);
+}
+
+//////////////////////////////////////////////////
+bool TriangleBVH::Intersect(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, const bool _cullBackFaces,
+    double &_distance, unsigned int &_triangle) const
+{
+  if (this->dataPtr->nodes.empty())
+    return false;
+
+  const double inf = std::numeric_limits<double>::infinity();
+  const ignition::math::Vector3d invDir(
+      ignition::math::equal(_dir.X(), 0.0) ? inf : 1.0 / _dir.X(),
+      ignition::math::equal(_dir.Y(), 0.0) ? inf : 1.0 / _dir.Y(),
+      ignition::math::equal(_dir.Z(), 0.0) ? inf : 1.0 / _dir.Z());
+
+  double closest = inf;
+  bool hit = false;
+
+  std::vector<unsigned int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    const BVHNode &node = this->dataPtr->nodes[stack.back()];
+    const unsigned int index = stack.back();
+    stack.pop_back();
+
+    if (!this->dataPtr->HitBounds(node, _origin, invDir, closest))
+      continue;
+
+    if (node.count == 0)
+    {
+      stack.push_back(node.offset);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    // Moller-Trumbore test of the triangles of the leaf.
+    for (unsigned int i = node.offset; i < node.offset + node.count; ++i)
+    {
+      const unsigned int triangle = this->dataPtr->order[i];
+      const ignition::math::Vector3d &a =
+        this->dataPtr->vertices[triangle * 3];
+      const ignition::math::Vector3d edge1 =
+        this->dataPtr->vertices[triangle * 3 + 1] - a;
+      const ignition::math::Vector3d edge2 =
+        this->dataPtr->vertices[triangle * 3 + 2] - a;
+
+      const ignition::math::Vector3d p = _dir.Cross(edge2);
+      const double det = edge1.Dot(p);
+      if ((_cullBackFaces && det <= 1e-12) ||
+          (!_cullBackFaces && std::abs(det) <= 1e-12))
+      {
+        continue;
+      }
+
+      const double invDet = 1.0 / det;
+      const ignition::math::Vector3d s = _origin - a;
+      const double u = s.Dot(p) * invDet;
+      if (u < 0 || u > 1)
+        continue;
+
+      const ignition::math::Vector3d q = s.Cross(edge1);
+      const double v = _dir.Dot(q) * invDet;
+      if (v < 0 || u + v > 1)
+        continue;
+
+      const double t = edge2.Dot(q) * invDet;
+      if (t >= 0 && t < closest)
+      {
+        closest = t;
+        _triangle = triangle;
+        hit = true;
+      }
+    }
+  }
+
+  if (hit)
+    _distance = closest;
+  return hit;
+}
+
+//////////////////////////////////////////////////
+bool TriangleBVH::Closest(const ignition::math::Vector3d &_point,
+    double &_distance, unsigned int &_triangle,
+    ignition::math::Vector3d &_closest) const
+{
+  if (this->dataPtr->nodes.empty())
+    return false;
+
+  double best = std::numeric_limits<double>::infinity();
+
+  std::vector<unsigned int> stack;
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    const unsigned int index = stack.back();
+    const BVHNode &node = this->dataPtr->nodes[index];
+    stack.pop_back();
+
+    if (TriangleBVHPrivate::BoundsDistance(node, _point) >= best)
+      continue;
+
+    if (node.count == 0)
+    {
+      // Visit the nearest child first, so that the other may be skipped
+      const BVHNode &left = this->dataPtr->nodes[index + 1];
+      const BVHNode &right = this->dataPtr->nodes[node.offset];
+      if (TriangleBVHPrivate::BoundsDistance(left, _point) <
+          TriangleBVHPrivate::BoundsDistance(right, _point))
+      {
+        stack.push_back(node.offset);
+        stack.push_back(index + 1);
+      }
+      else
+      {
+        stack.push_back(index + 1);
+        stack.push_back(node.offset);
+      }
+      continue;
+    }
+
+    for (unsigned int i = node.offset; i < node.offset + node.count; ++i)
+    {
+      const unsigned int triangle = this->dataPtr->order[i];
+      const ignition::math::Vector3d p = closestOnTriangle(_point,
+          this->dataPtr->vertices[triangle * 3],
+          this->dataPtr->vertices[triangle * 3 + 1],
+          this->dataPtr->vertices[triangle * 3 + 2]);
+      const double d = (p - _point).SquaredLength();
+      if (d < best)
+      {
+        best = d;
+        _triangle = triangle;
+        _closest = p;
+      }
+    }
+  }
+
+  _distance = std::sqrt(best);
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int TriangleBVH::TriangleCount() const
+{
+  return this->dataPtr->vertices.size() / 3;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Triangle3d TriangleBVH::Triangle(
+    const unsigned int _index) const
+{
+  if (_index >= this->TriangleCount())
+    return ignition::math::Triangle3d();
+
+  return ignition::math::Triangle3d(this->dataPtr->vertices[_index * 3],
+      this->dataPtr->vertices[_index * 3 + 1],
+      this->dataPtr->vertices[_index * 3 + 2]);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_COMMON_TRIANGLEBVH_HH_
+#define GAZEBO_COMMON_TRIANGLEBVH_HH_
+
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Triangle3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    // Forward declare private data class
+    class TriangleBVHPrivate;
+
+    /// \addtogroup gazebo_common Common
+    /// \{
+
+    /// \class TriangleBVH TriangleBVH.hh common/common.hh
+    /// \brief Bounding volume hierarchy of the triangles of a mesh, used
+    /// to find the first triangle hit by a ray, or the triangle closest to
+    /// a point, without testing every triangle.
+    ///
+    /// The hierarchy is built once from a copy of the vertices, so a ray
+    /// query doesn't read the mesh again. Rays are given in the frame of
+    /// the vertices.
+    class GZ_COMMON_VISIBLE TriangleBVH
+    {
+      /// \brief Constructor
+      public: TriangleBVH();
+
+      /// \brief Destructor
+      public: virtual ~TriangleBVH();
+
+      /// \brief Build the hierarchy, replacing the previous one.
+      /// \param[in] _vertices Vertex positions.
+      /// \param[in] _indices Three vertex indices per triangle. Trailing
+      /// indices that don't make a whole triangle, and triangles with an
+      /// index out of range, are ignored.
+      public: void Build(const std::vector<ignition::math::Vector3d> &_vertices,
+                         const std::vector<unsigned int> &_indices);
+
+      /// \brief Find the closest triangle hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray. The distance is measured in
+      /// multiples of its length.
+      /// \param[in] _cullBackFaces True to ignore the triangles whose
+      /// counterclockwise side faces away from the ray.
+      /// \param[out] _distance Distance from the origin to the hit.
+      /// \param[out] _triangle Index of the triangle that was hit.
+      /// \return True if a triangle was hit in front of the origin.
+      public: bool Intersect(const ignition::math::Vector3d &_origin,
+                             const ignition::math::Vector3d &_dir,
+                             const bool _cullBackFaces,
+                             double &_distance,
+                             unsigned int &_triangle) const;
+
+      /// \brief Find the triangle closest to a point.
+      /// \param[in] _point The point.
+      /// \param[out] _distance Distance from the point to the triangle.
+      /// \param[out] _triangle Index of the closest triangle.
+      /// \param[out] _closest Closest point of the triangle.
+      /// \return False if the hierarchy is empty.
+      public: bool Closest(const ignition::math::Vector3d &_point,
+                           double &_distance,
+                           unsigned int &_triangle,
+                           ignition::math::Vector3d &_closest) const;
+
+      /// \brief Get the number of triangles.
+      /// \return Number of triangles in the hierarchy.
+      public: unsigned int TriangleCount() const;
+
+      /// \brief Get the vertices of a triangle.
+      /// \param[in] _index Index of the triangle.
+      /// \return The triangle, which is invalid if _index is out of range.
+      public: ignition::math::Triangle3d Triangle(
+                  const unsigned int _index) const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<TriangleBVHPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/common/TriangleBVH.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TriangleBVH : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Make a grid of unit squares in the z = _z plane, facing +z.
+/// \param[in] _size Number of squares along x and y.
+/// \param[in] _z Height of the grid.
+/// \param[out] _vertices Vertices of the grid.
+/// \param[out] _indices Two triangles per square.
+void makeGrid(const unsigned int _size, const double _z,
+    std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices)
+{
+  const unsigned int offset = _vertices.size();
+  for (unsigned int y = 0; y <= _size; ++y)
+  {
+    for (unsigned int x = 0; x <= _size; ++x)
+      _vertices.push_back(ignition::math::Vector3d(x, y, _z));
+  }
+
+  for (unsigned int y = 0; y < _size; ++y)
+  {
+    for (unsigned int x = 0; x < _size; ++x)
+    {
+      unsigned int a = offset + y * (_size + 1) + x;
+      unsigned int b = a + 1;
+      unsigned int c = a + _size + 1;
+      unsigned int d = c + 1;
+      _indices.insert(_indices.end(), {a, b, d, a, d, c});
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(TriangleBVH, Empty)
+{
+  common::TriangleBVH bvh;
+  EXPECT_EQ(bvh.TriangleCount(), 0u);
+
+  double distance;
+  unsigned int triangle;
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitZ, false, distance, triangle));
+
+  // Indices out of range and trailing indices are ignored
+  std::vector<ignition::math::Vector3d> vertices = {
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::UnitX};
+  bvh.Build(vertices, {0, 1, 2, 0, 1});
+  EXPECT_EQ(bvh.TriangleCount(), 0u);
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d::Zero,
+      ignition::math::Vector3d::UnitZ, false, distance, triangle));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TriangleBVH, Closest)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  makeGrid(16, 0, vertices, indices);
+  makeGrid(16, 2, vertices, indices);
+
+  common::TriangleBVH bvh;
+  bvh.Build(vertices, indices);
+  EXPECT_EQ(bvh.TriangleCount(), 16u * 16u * 4u);
+
+  // From above, the top grid is hit first
+  double distance;
+  unsigned int triangle;
+  EXPECT_TRUE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 5),
+      -ignition::math::Vector3d::UnitZ, false, distance, triangle));
+  EXPECT_DOUBLE_EQ(distance, 3);
+  ignition::math::Triangle3d tri = bvh.Triangle(triangle);
+  EXPECT_DOUBLE_EQ(tri[0].Z(), 2);
+  EXPECT_TRUE(tri.Contains(ignition::math::Vector3d(3.25, 7.5, 2)));
+
+  // The distance is in multiples of the direction
+  EXPECT_TRUE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 5),
+      ignition::math::Vector3d(0, 0, -2), false, distance, triangle));
+  EXPECT_DOUBLE_EQ(distance, 1.5);
+
+  // Between the grids, the lower grid is hit from its front side only
+  EXPECT_TRUE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 1),
+      -ignition::math::Vector3d::UnitZ, true, distance, triangle));
+  EXPECT_DOUBLE_EQ(distance, 1);
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 1),
+      ignition::math::Vector3d::UnitZ, true, distance, triangle));
+  EXPECT_TRUE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 1),
+      ignition::math::Vector3d::UnitZ, false, distance, triangle));
+  EXPECT_DOUBLE_EQ(distance, 1);
+
+  // Nothing outside of the grids
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d(20, 7.5, 5),
+      -ignition::math::Vector3d::UnitZ, false, distance, triangle));
+  EXPECT_FALSE(bvh.Intersect(ignition::math::Vector3d(3.25, 7.5, 5),
+      ignition::math::Vector3d::UnitZ, false, distance, triangle));
+
+  // Out of range triangle
+  EXPECT_DOUBLE_EQ(bvh.Triangle(bvh.TriangleCount())[0].Length(), 0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TriangleBVH, ClosestPoint)
+{
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  makeGrid(16, 0, vertices, indices);
+  makeGrid(16, 2, vertices, indices);
+
+  common::TriangleBVH bvh;
+  double distance;
+  unsigned int triangle;
+  ignition::math::Vector3d closest;
+  EXPECT_FALSE(bvh.Closest(ignition::math::Vector3d::Zero, distance,
+      triangle, closest));
+  bvh.Build(vertices, indices);
+
+  // Above the grids, the top grid is the closest
+  EXPECT_TRUE(bvh.Closest(ignition::math::Vector3d(3.25, 7.5, 2.5),
+      distance, triangle, closest));
+  EXPECT_DOUBLE_EQ(distance, 0.5);
+  EXPECT_EQ(closest, ignition::math::Vector3d(3.25, 7.5, 2));
+  EXPECT_TRUE(bvh.Triangle(triangle).Contains(closest));
+
+  // Just above the lower grid
+  EXPECT_TRUE(bvh.Closest(ignition::math::Vector3d(3.25, 7.5, 0.75),
+      distance, triangle, closest));
+  EXPECT_DOUBLE_EQ(distance, 0.75);
+  EXPECT_DOUBLE_EQ(closest.Z(), 0);
+
+  // Beyond a corner, the corner is the closest
+  EXPECT_TRUE(bvh.Closest(ignition::math::Vector3d(-3, -4, 0), distance,
+      triangle, closest));
+  EXPECT_DOUBLE_EQ(distance, 5);
+  EXPECT_EQ(closest, ignition::math::Vector3d::Zero);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TriangleBVH, BruteForce)
+{
+  // Random triangles
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < 600; ++i)
+  {
+    ignition::math::Vector3d center(ignition::math::Rand::DblUniform(-5, 5),
+        ignition::math::Rand::DblUniform(-5, 5),
+        ignition::math::Rand::DblUniform(-5, 5));
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      indices.push_back(vertices.size());
+      vertices.push_back(center + ignition::math::Vector3d(
+            ignition::math::Rand::DblUniform(-1, 1),
+            ignition::math::Rand::DblUniform(-1, 1),
+            ignition::math::Rand::DblUniform(-1, 1)));
+    }
+  }
+
+  common::TriangleBVH bvh;
+  bvh.Build(vertices, indices);
+  ASSERT_EQ(bvh.TriangleCount(), 600u);
+
+  // Every ray gives the same hit as testing all the triangles
+  unsigned int hits = 0;
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    ignition::math::Vector3d origin(ignition::math::Rand::DblUniform(-8, 8),
+        ignition::math::Rand::DblUniform(-8, 8), 10);
+    ignition::math::Vector3d target(ignition::math::Rand::DblUniform(-5, 5),
+        ignition::math::Rand::DblUniform(-5, 5),
+        ignition::math::Rand::DblUniform(-5, 5));
+    ignition::math::Vector3d dir = (target - origin).Normalize();
+
+    double expected = -1;
+    for (unsigned int j = 0; j < bvh.TriangleCount(); ++j)
+    {
+      ignition::math::Triangle3d tri = bvh.Triangle(j);
+      ignition::math::Vector3d edge1 = tri[1] - tri[0];
+      ignition::math::Vector3d edge2 = tri[2] - tri[0];
+      ignition::math::Vector3d normal = edge1.Cross(edge2);
+      double denom = normal.Dot(dir);
+      if (std::abs(denom) < 1e-12)
+        continue;
+      double t = normal.Dot(tri[0] - origin) / denom;
+      ignition::math::Vector3d pt = origin + dir * t;
+      ignition::math::Vector3d w = pt - tri[0];
+      double d00 = edge1.Dot(edge1);
+      double d01 = edge1.Dot(edge2);
+      double d11 = edge2.Dot(edge2);
+      double d20 = w.Dot(edge1);
+      double d21 = w.Dot(edge2);
+      double det = d00 * d11 - d01 * d01;
+      double v = (d11 * d20 - d01 * d21) / det;
+      double u = (d00 * d21 - d01 * d20) / det;
+      if (t >= 0 && u >= 0 && v >= 0 && u + v <= 1 &&
+          (expected < 0 || t < expected))
+      {
+        expected = t;
+      }
+    }
+
+    double distance;
+    unsigned int triangle;
+    bool hit = bvh.Intersect(origin, dir, false, distance, triangle);
+    EXPECT_EQ(hit, expected >= 0);
+    if (hit && expected >= 0)
+    {
+      EXPECT_NEAR(distance, expected, 1e-6);
+      ++hits;
+    }
+  }
+  EXPECT_GT(hits, 0u);
+}
@@ -15,14 +15,95 @@
  *
 */
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "gazebo/gazebo_config.h"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Video.hh"
 #include "gazebo/common/ffmpeg_inc.h"
 
+namespace gazebo
+{
+  namespace common
+  {
+    /// \internal
+    /// \brief Private data for the Video class.
+    class VideoPrivate
+    {
+      /// \brief Name of the ffmpeg decoder to try first.
+      public: std::string hwDecoder;
+
+      /// \brief True if the loaded video is decoded by hwDecoder.
+      public: bool hwDecoding = false;
+
+      /// \brief Pixel format of the frames.
+      public: Image::PixelFormat outFormat = Image::RGB_INT8;
+
+      /// \brief Thread that decodes the video.
+      public: std::thread decodeThread;
+
+      /// \brief Decoded frames.
+      public: std::deque<std::vector<unsigned char>> queue;
+
+      /// \brief Buffers of popped frames, reused for new frames.
+      public: std::vector<std::vector<unsigned char>> pool;
+
+      /// \brief Number of frames the queue can hold.
+      public: std::size_t queueLimit = 3;
+
+      /// \brief True to stop the thread.
+      public: bool stopThread = false;
+
+      /// \brief True once the thread reached the end of the video.
+      public: bool eof = false;
+
+      /// \brief Protects the queue, the pool and the flags.
+      public: mutable std::mutex mutex;
+
+      /// \brief Signaled when a frame is popped or the thread must stop.
+      public: std::condition_variable cond;
+    };
+  }
+}
+
 using namespace gazebo;
 using namespace common;
 
+/////////////////////////////////////////////////
+/// \brief Get the number of bytes of a pixel.
+/// \param[in] _format A pixel format supported by Video.
+/// \return Bytes per pixel.
+static int bytesPerPixel(const Image::PixelFormat _format)
+{
+  return _format == Image::BGRA_INT8 ? 4 : 3;
+}
+
+#ifdef HAVE_FFMPEG
+/////////////////////////////////////////////////
+/// \brief Get the libav format of a pixel format.
+/// \param[in] _format A pixel format supported by Video.
+/// \return The libav format.
+static AVPixelFormat avPixelFormat(const Image::PixelFormat _format)
+{
+  switch (_format)
+  {
+    case Image::BGR_INT8:
+      return AV_PIX_FMT_BGR24;
+    case Image::BGRA_INT8:
+      return AV_PIX_FMT_BGRA;
+    default:
+      return AV_PIX_FMT_RGB24;
+  }
+}
+#endif
+
 /////////////////////////////////////////////////
 // #ifdef HAVE_FFMPEG
 // static void pgm_save(unsigned char *buf, int wrap, int xsize, int ysize,
@@ -41,6 +122,7 @@ using namespace common;
 
 /////////////////////////////////////////////////
 Video::Video()
+  : dataPtr(new VideoPrivate)
 {
   this->formatCtx = nullptr;
   this->codecCtx = nullptr;
@@ -48,6 +130,10 @@ Video::Video()
   this->avFrame = nullptr;
   this->videoStream = -1;
   this->avFrameDst = nullptr;
+
+  const char *decoderEnv = getenv("GAZEBO_VIDEO_DECODER");
+  if (decoderEnv)
+    this->dataPtr->hwDecoder = decoderEnv;
 }
 
 /////////////////////////////////////////////////
@@ -59,18 +145,30 @@ Video::~Video()
 /////////////////////////////////////////////////
 void Video::Cleanup()
 {
+  this->StopDecoding();
+
 #ifdef HAVE_FFMPEG
   // Free the YUV frame
   av_free(this->avFrame);
+  this->avFrame = nullptr;
+
+  // Close the codec
+  if (this->codecCtx)
+    avcodec_close(this->codecCtx);
+  this->codecCtx = nullptr;
 
   // Close the video file
   avformat_close_input(&this->formatCtx);
 
-  // Close the codec
-  avcodec_close(this->codecCtx);
-
+  if (this->avFrameDst)
+    av_freep(&this->avFrameDst->data[0]);
   av_free(this->avFrameDst);
+  this->avFrameDst = nullptr;
+
+  sws_freeContext(this->swsCtx);
+  this->swsCtx = nullptr;
 #endif
+  this->dataPtr->hwDecoding = false;
 }
 
 /////////////////////////////////////////////////
@@ -133,8 +231,27 @@ bool Video::Load(const std::string &_filename)
 # pragma GCC diagnostic pop
 #endif
 
+  // Try the hardware decoder first, if it decodes the codec of the video
+  if (!this->dataPtr->hwDecoder.empty())
+  {
+    AVCodec *hwCodec =
+        avcodec_find_decoder_by_name(this->dataPtr->hwDecoder.c_str());
+    if (hwCodec && hwCodec->id == this->codecCtx->codec_id &&
+        avcodec_open2(this->codecCtx, hwCodec, nullptr) >= 0)
+    {
+      codec = hwCodec;
+      this->dataPtr->hwDecoding = true;
+    }
+    else
+    {
+      gzwarn << "Unable to open video decoder[" << this->dataPtr->hwDecoder
+             << "], using the default decoder\n";
+    }
+  }
+
   // Find the decoder for the video stream
-  codec = avcodec_find_decoder(this->codecCtx->codec_id);
+  if (codec == nullptr)
+    codec = avcodec_find_decoder(this->codecCtx->codec_id);
   if (codec == nullptr)
   {
     gzerr << "Codec not found\n";
@@ -152,34 +269,17 @@ bool Video::Load(const std::string &_filename)
 #endif
 
   // Open codec
-  if (avcodec_open2(this->codecCtx, codec, nullptr) < 0)
+  if (!this->dataPtr->hwDecoding &&
+      avcodec_open2(this->codecCtx, codec, nullptr) < 0)
   {
     gzerr << "Could not open codec\n";
     return false;
   }
 
-  this->swsCtx = sws_getContext(
-      this->codecCtx->width,
-      this->codecCtx->height,
-      this->codecCtx->pix_fmt,
-      this->codecCtx->width,
-      this->codecCtx->height,
-      AV_PIX_FMT_RGB24,
-      SWS_BICUBIC, nullptr, nullptr, nullptr);
-
-  if (this->swsCtx == nullptr)
-  {
-    gzerr << "Error while calling sws_getContext\n";
+  // The scaler is created for the format of the first decoded frame, since
+  // hardware decoders may only know it then.
+  if (!this->SetOutputFormat(this->dataPtr->outFormat))
     return false;
-  }
-
-  this->avFrameDst = common::AVFrameAlloc();
-  this->avFrameDst->format = this->codecCtx->pix_fmt;
-  this->avFrameDst->width = this->codecCtx->width;
-  this->avFrameDst->height = this->codecCtx->height;
-  av_image_alloc(this->avFrameDst->data, this->avFrameDst->linesize,
-      this->codecCtx->width, this->codecCtx->height, this->codecCtx->pix_fmt,
-      1);
 
   // DEBUG: Will save all the frames
   /*Image img;
@@ -207,25 +307,34 @@ bool Video::Load(const std::string &/*_filename*/)
 
 /////////////////////////////////////////////////
 #ifdef HAVE_FFMPEG
-bool Video::GetNextFrame(unsigned char **_buffer)
+bool Video::ReadFrame(unsigned char *_buffer, bool &_decoded)
 {
-  AVPacket packet, tmpPacket;
-  int frameAvailable = 0;
-
-  av_init_packet(&packet);
-
-  // Read a frame.
-  if (av_read_frame(this->formatCtx, &packet) < 0)
-    return false;
-
-  if (packet.stream_index == this->videoStream)
+  _decoded = false;
+  while (!_decoded)
   {
+    AVPacket packet, tmpPacket;
+    av_init_packet(&packet);
+    packet.data = nullptr;
+    packet.size = 0;
+
+    // Read a frame. At the end, empty packets flush the frames that the
+    // decoder still holds.
+    const bool end = av_read_frame(this->formatCtx, &packet) < 0;
+    if (!end && packet.stream_index != this->videoStream)
+    {
+      AVPacketUnref(&packet);
+      continue;
+    }
+
+    av_init_packet(&tmpPacket);
     tmpPacket.data = packet.data;
     tmpPacket.size = packet.size;
 
     // Process all the data in the frame
-    while (tmpPacket.size > 0)
+    do
     {
+      int frameAvailable = 0;
+
       // sending data to libavcodec
 #ifndef _WIN32
 # pragma GCC diagnostic push
@@ -248,30 +357,207 @@ bool Video::GetNextFrame(unsigned char **_buffer)
       // processing the image if available
       if (frameAvailable)
       {
-        sws_scale(swsCtx, this->avFrame->data, this->avFrame->linesize, 0,
-            this->codecCtx->height, this->avFrameDst->data,
+        this->swsCtx = sws_getCachedContext(this->swsCtx,
+            this->avFrame->width, this->avFrame->height,
+            static_cast<AVPixelFormat>(this->avFrame->format),
+            this->codecCtx->width, this->codecCtx->height,
+            avPixelFormat(this->dataPtr->outFormat),
+            SWS_BICUBIC, nullptr, nullptr, nullptr);
+        if (this->swsCtx == nullptr)
+        {
+          gzerr << "Error while calling sws_getContext\n";
+          break;
+        }
+
+        sws_scale(this->swsCtx, this->avFrame->data, this->avFrame->linesize,
+            0, this->avFrame->height, this->avFrameDst->data,
             this->avFrameDst->linesize);
 
-        memcpy(*_buffer, this->avFrameDst->data[0],
-            this->codecCtx->height * (this->codecCtx->width*3));
-
-        // Debug:
-        // pgm_save(this->pic.data[0], this->pic.linesize[0],
-        //          this->codecCtx->width, this->codecCtx->height, buf);
+        memcpy(_buffer, this->avFrameDst->data[0], this->FrameSize());
+        _decoded = true;
       }
     }
+    while (tmpPacket.size > 0);
+
+    if (end)
+      return _decoded;
+
+    AVPacketUnref(&packet);
   }
-  AVPacketUnref(&packet);
 
   return true;
 }
 #else
-bool Video::GetNextFrame(unsigned char ** /*_buffer*/)
+bool Video::ReadFrame(unsigned char * /*_buffer*/, bool &_decoded)
 {
+  _decoded = false;
   return false;
 }
 #endif
 
+/////////////////////////////////////////////////
+bool Video::GetNextFrame(unsigned char **_buffer)
+{
+  bool decoded = false;
+  return this->ReadFrame(*_buffer, decoded) || decoded;
+}
+
+/////////////////////////////////////////////////
+void Video::SetHardwareDecoder(const std::string &_decoder)
+{
+  this->dataPtr->hwDecoder = _decoder;
+}
+
+/////////////////////////////////////////////////
+bool Video::HardwareDecoding() const
+{
+  return this->dataPtr->hwDecoding;
+}
+
+/////////////////////////////////////////////////
+bool Video::SetOutputFormat(const Image::PixelFormat _format)
+{
+  if (_format != Image::RGB_INT8 && _format != Image::BGR_INT8 &&
+      _format != Image::BGRA_INT8)
+  {
+    gzerr << "Unsupported video output format["
+          << PixelFormatNames[_format] << "]\n";
+    return false;
+  }
+  this->dataPtr->outFormat = _format;
+
+#ifdef HAVE_FFMPEG
+  if (this->codecCtx == nullptr)
+    return true;
+
+  if (this->avFrameDst)
+    av_freep(&this->avFrameDst->data[0]);
+  else
+    this->avFrameDst = common::AVFrameAlloc();
+
+  this->avFrameDst->format = avPixelFormat(_format);
+  this->avFrameDst->width = this->codecCtx->width;
+  this->avFrameDst->height = this->codecCtx->height;
+  if (av_image_alloc(this->avFrameDst->data, this->avFrameDst->linesize,
+      this->codecCtx->width, this->codecCtx->height, avPixelFormat(_format),
+      1) < 0)
+  {
+    gzerr << "Unable to allocate the video frame\n";
+    return false;
+  }
+#endif
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::size_t Video::FrameSize() const
+{
+#ifdef HAVE_FFMPEG
+  if (this->codecCtx == nullptr)
+    return 0;
+#endif
+  return static_cast<std::size_t>(this->GetWidth()) * this->GetHeight() *
+      bytesPerPixel(this->dataPtr->outFormat);
+}
+
+/////////////////////////////////////////////////
+bool Video::StartDecoding(const std::size_t _queueSize)
+{
+  this->StopDecoding();
+  if (this->FrameSize() == 0)
+    return false;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->queueLimit = std::max(_queueSize, std::size_t(1));
+    this->dataPtr->stopThread = false;
+    this->dataPtr->eof = false;
+  }
+
+  this->dataPtr->decodeThread = std::thread([this]()
+  {
+    const std::size_t size = this->FrameSize();
+    bool more = true;
+    while (more)
+    {
+      std::vector<unsigned char> buffer;
+      {
+        std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+        if (!this->dataPtr->pool.empty())
+        {
+          buffer = std::move(this->dataPtr->pool.back());
+          this->dataPtr->pool.pop_back();
+        }
+      }
+      buffer.resize(size);
+
+      bool decoded = false;
+      more = this->ReadFrame(buffer.data(), decoded);
+
+      std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->cond.wait(lock, [this]()
+          {
+            return this->dataPtr->stopThread ||
+                this->dataPtr->queue.size() < this->dataPtr->queueLimit;
+          });
+      if (this->dataPtr->stopThread)
+        return;
+
+      if (decoded)
+        this->dataPtr->queue.push_back(std::move(buffer));
+      else
+        this->dataPtr->pool.push_back(std::move(buffer));
+    }
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->eof = true;
+  });
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void Video::StopDecoding()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stopThread = true;
+  }
+  this->dataPtr->cond.notify_all();
+
+  if (this->dataPtr->decodeThread.joinable())
+    this->dataPtr->decodeThread.join();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->queue.clear();
+  this->dataPtr->pool.clear();
+}
+
+/////////////////////////////////////////////////
+bool Video::PopFrame(unsigned char *_buffer)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->queue.empty())
+      return false;
+
+    std::vector<unsigned char> &frame = this->dataPtr->queue.front();
+    memcpy(_buffer, frame.data(), frame.size());
+    this->dataPtr->pool.push_back(std::move(frame));
+    this->dataPtr->queue.pop_front();
+  }
+  this->dataPtr->cond.notify_all();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Video::Ended() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->eof && this->dataPtr->queue.empty();
+}
+
 /////////////////////////////////////////////////
 int Video::GetWidth() const
 {
@@ -17,7 +17,10 @@
 #ifndef _GAZEBO_COMMON_VIDEO_HH_
 #define _GAZEBO_COMMON_VIDEO_HH_
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include "gazebo/common/Image.hh"
 #include "gazebo/util/system.hh"
 
 struct AVFormatContext;
@@ -30,6 +33,9 @@ namespace gazebo
 {
   namespace common
   {
+    // Forward declare private data class
+    class VideoPrivate;
+
     /// \addtogroup gazebo_common
     /// \{
 
@@ -62,6 +68,58 @@ namespace gazebo
       /// \return false if HAVE_FFMPEG is not defined, true otherwise
       public: bool GetNextFrame(unsigned char **_buffer);
 
+      /// \brief Set the ffmpeg decoder to try first on the next Load, such
+      /// as "h264_cuvid" or "h264_qsv". The decoder must output frames in
+      /// system memory. The default decoder of the video is used if it
+      /// can't be opened. Defaults to the GAZEBO_VIDEO_DECODER environment
+      /// variable.
+      /// \param[in] _decoder Name of the decoder, empty for the default.
+      public: void SetHardwareDecoder(const std::string &_decoder);
+
+      /// \brief Get whether the loaded video is decoded by the decoder
+      /// set with SetHardwareDecoder.
+      /// \return True if the hardware decoder was opened.
+      public: bool HardwareDecoding() const;
+
+      /// \brief Set the pixel format of the frames. Converting to the
+      /// format of the texture the frames are drawn on saves a copy per
+      /// pixel on the render thread. This can't be called while the video
+      /// is decoded on a worker thread.
+      /// \param[in] _format RGB_INT8, the default, BGR_INT8 or BGRA_INT8.
+      /// \return False if the format isn't supported.
+      public: bool SetOutputFormat(const Image::PixelFormat _format);
+
+      /// \brief Get the number of bytes of a frame.
+      /// \return Bytes of a frame in the output format.
+      public: std::size_t FrameSize() const;
+
+      /// \brief Decode the video on a worker thread. The frames are queued
+      /// and retrieved with PopFrame. The thread waits while the queue is
+      /// full, so it decodes at the pace the frames are popped.
+      /// \param[in] _queueSize Number of frames the queue can hold.
+      /// \return False if no video is loaded.
+      public: bool StartDecoding(const std::size_t _queueSize = 3);
+
+      /// \brief Stop the worker thread, and drop the queued frames.
+      public: void StopDecoding();
+
+      /// \brief Get the next decoded frame from the queue, without waiting.
+      /// \param[out] _buffer Buffer of FrameSize() bytes that receives the
+      /// frame.
+      /// \return False if no frame is ready.
+      public: bool PopFrame(unsigned char *_buffer);
+
+      /// \brief Get whether the worker thread reached the end of the video
+      /// and all its frames were popped.
+      /// \return True at the end of the video.
+      public: bool Ended() const;
+
+      /// \brief Read packets until a frame is decoded or the video ends.
+      /// \param[out] _buffer Buffer that receives the frame.
+      /// \param[out] _decoded True if a frame was written to the buffer.
+      /// \return False at the end of the video or on errors.
+      private: bool ReadFrame(unsigned char *_buffer, bool &_decoded);
+
       /// \brief free up open Video object, close files, streams
       private: void Cleanup();
 
@@ -82,6 +140,10 @@ namespace gazebo
 
       /// \brief index of first video stream or -1
       private: int videoStream;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<VideoPrivate> dataPtr;
     };
     /// \}
   }
@@ -14,7 +14,14 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <stdio.h>
 #include <gazebo/gazebo_config.h>
 
@@ -58,9 +65,59 @@ using namespace common;
 #define AV_ERROR_MAX_STRING_SIZE 64
 #endif
 
+/// \brief Size of the I/O buffer of a streamed video.
+static const int kStreamBufferSize = 32768;
+
+/// \brief A frame waiting to be encoded.
+class VideoEncoderFrame
+{
+  /// \brief RGB pixels, taken from and returned to the buffer pool.
+  public: std::vector<unsigned char> data;
+
+  /// \brief Frame width
+  public: unsigned int width = 0;
+
+  /// \brief Frame height
+  public: unsigned int height = 0;
+};
+
 // Private data class
 class gazebo::common::VideoEncoderPrivate
 {
+#ifdef HAVE_FFMPEG
+  /// \brief Allocate and open the codec context.
+  /// \param[in] _encoder Encoder to open.
+  /// \param[in] _width Width of the video.
+  /// \param[in] _height Height of the video.
+  /// \param[in] _quiet True to print failures as warnings.
+  /// \return True if the codec was opened.
+  public: bool OpenCodec(AVCodec *_encoder, const unsigned int _width,
+              const unsigned int _height, const bool _quiet);
+
+  /// \brief Convert, encode and write a frame.
+  /// \param[in] _frame Frame to encode.
+  /// \return True on success.
+  public: bool Encode(const VideoEncoderFrame &_frame);
+
+  /// \brief Write the muxed bytes of a streamed video.
+  /// \param[in] _opaque The private data.
+  /// \param[in] _buf Bytes of the video.
+  /// \param[in] _size Number of bytes.
+  /// \return Number of bytes written.
+#if LIBAVFORMAT_VERSION_MAJOR >= 61
+  public: static int WriteStream(void *_opaque, const uint8_t *_buf,
+              int _size);
+#else
+  public: static int WriteStream(void *_opaque, uint8_t *_buf, int _size);
+#endif
+#endif
+
+  /// \brief Encode the queued frames until StopThread is called.
+  public: void EncodeLoop();
+
+  /// \brief Encode the frames left in the queue and stop the thread.
+  public: void StopThread();
+
   /// \brief Name of the file which stores the video while it is being
   ///        recorded.
   public: std::string filename;
@@ -75,6 +132,9 @@ class gazebo::common::VideoEncoderPrivate
   /// \brief libav format I/O context
   public: AVFormatContext *formatCtx = nullptr;
 
+  /// \brief libav I/O context of a streamed video
+  public: AVIOContext *streamCtx = nullptr;
+
   /// \brief libav output video frame
   public: AVFrame *avOutFrame = nullptr;
 
@@ -115,14 +175,112 @@ class gazebo::common::VideoEncoderPrivate
 
   /// \brief Mutex for thread safety.
   public: std::mutex mutex;
+
+  /// \brief Name of the ffmpeg encoder to try first.
+  public: std::string hwEncoder;
+
+  /// \brief Callback of the stream for the next Start.
+  public: VideoEncoder::StreamCallback nextStream;
+
+  /// \brief Callback of the current stream, null when writing to a file.
+  public: VideoEncoder::StreamCallback stream;
+
+  /// \brief Thread that encodes the queued frames.
+  public: std::thread encodeThread;
+
+  /// \brief Frames waiting to be encoded.
+  public: std::deque<VideoEncoderFrame> queue;
+
+  /// \brief Buffers of encoded frames, reused for new frames.
+  public: std::vector<std::vector<unsigned char>> pool;
+
+  /// \brief Number of frames the queue can hold.
+  public: std::size_t queueLimit = VIDEO_ENCODER_QUEUE_DEFAULT;
+
+  /// \brief Number of frames dropped because the queue was full.
+  public: uint64_t droppedFrames = 0;
+
+  /// \brief True to stop the thread once the queue is empty.
+  public: bool stopThread = false;
+
+  /// \brief Protects the queue, the pool and the counters.
+  public: mutable std::mutex queueMutex;
+
+  /// \brief Signaled when a frame is queued or the thread must stop.
+  public: std::condition_variable queueCond;
 };
 
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::EncodeLoop()
+{
+  while (true)
+  {
+    VideoEncoderFrame frame;
+    {
+      std::unique_lock<std::mutex> lock(this->queueMutex);
+      this->queueCond.wait(lock, [this]
+          {
+            return this->stopThread || !this->queue.empty();
+          });
+
+      if (this->queue.empty())
+        return;
+
+      frame = std::move(this->queue.front());
+      this->queue.pop_front();
+    }
+
+#ifdef HAVE_FFMPEG
+    this->Encode(frame);
+#endif
+
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->pool.push_back(std::move(frame.data));
+  }
+}
+
+/////////////////////////////////////////////////
+void VideoEncoderPrivate::StopThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->queueMutex);
+    this->stopThread = true;
+  }
+  this->queueCond.notify_all();
+
+  if (this->encodeThread.joinable())
+    this->encodeThread.join();
+
+  std::lock_guard<std::mutex> lock(this->queueMutex);
+  this->stopThread = false;
+}
+
+/////////////////////////////////////////////////
+#ifdef HAVE_FFMPEG
+#if LIBAVFORMAT_VERSION_MAJOR >= 61
+int VideoEncoderPrivate::WriteStream(void *_opaque, const uint8_t *_buf,
+    int _size)
+#else
+int VideoEncoderPrivate::WriteStream(void *_opaque, uint8_t *_buf, int _size)
+#endif
+{
+  auto dataPtr = static_cast<VideoEncoderPrivate *>(_opaque);
+  if (dataPtr->stream && _size > 0)
+    dataPtr->stream(_buf, static_cast<std::size_t>(_size));
+  return _size;
+}
+#endif
+
 /////////////////////////////////////////////////
 VideoEncoder::VideoEncoder()
 : dataPtr(new VideoEncoderPrivate)
 {
   // Make sure libav is loaded.
   common::load();
+
+  const char *encoderEnv = getenv("GAZEBO_VIDEO_ENCODER");
+  if (encoderEnv)
+    this->dataPtr->hwEncoder = encoderEnv;
 }
 
 /////////////////////////////////////////////////
@@ -143,6 +301,161 @@ unsigned int VideoEncoder::BitRate() const
   return this->dataPtr->bitRate;
 }
 
+/////////////////////////////////////////////////
+void VideoEncoder::SetQueueLimit(const unsigned int _frames)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  this->dataPtr->queueLimit = std::max(_frames, 1u);
+}
+
+/////////////////////////////////////////////////
+uint64_t VideoEncoder::DroppedFrames() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+  return this->dataPtr->droppedFrames;
+}
+
+/////////////////////////////////////////////////
+void VideoEncoder::SetHardwareEncoder(const std::string &_encoder)
+{
+  this->dataPtr->hwEncoder = _encoder;
+}
+
+/////////////////////////////////////////////////
+void VideoEncoder::SetStreamCallback(const StreamCallback &_callback)
+{
+  this->dataPtr->nextStream = _callback;
+}
+
+/////////////////////////////////////////////////
+#ifdef HAVE_FFMPEG
+bool VideoEncoderPrivate::OpenCodec(AVCodec *_encoder,
+    const unsigned int _width, const unsigned int _height, const bool _quiet)
+{
+  // Allocate a new video context
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+  this->codecCtx = this->videoStream->codec;
+#else
+  this->codecCtx = avcodec_alloc_context3(_encoder);
+#endif
+
+  if (!this->codecCtx)
+  {
+    gzerr << "Could not allocate an encoding context."
+          << "Video encoding is not started\n";
+    return false;
+  }
+
+  // some formats want stream headers to be separate
+  if (this->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
+  {
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+    this->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
+#else
+    this->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+#endif
+  }
+
+  // Frames per second
+  this->codecCtx->time_base.den = this->fps;
+  this->codecCtx->time_base.num = 1;
+
+  // The video stream must have the same time base as the context
+  this->videoStream->time_base.den = this->fps;
+  this->videoStream->time_base.num = 1;
+
+  // Bitrate
+  this->codecCtx->bit_rate = this->bitRate;
+
+  // The resolution must be divisible by two
+  this->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
+  this->codecCtx->height = _height % 2 == 0 ? _height : _height + 1;
+
+  // Emit one intra-frame every 10 frames. Streams emit one every second,
+  // so that new viewers start quickly, and have no B-frames, which would
+  // delay the output of each frame.
+  this->codecCtx->gop_size = this->stream ? std::max(this->fps, 1u) : 10;
+  this->codecCtx->max_b_frames = this->stream ? 0 : 1;
+  this->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
+
+  // Hardware encoders may not take YUV420P, use the first system memory
+  // format they take that the software scaler can produce.
+  if (_encoder->pix_fmts)
+  {
+    bool yuv420p = false;
+    for (const AVPixelFormat *fmt = _encoder->pix_fmts;
+         *fmt != AV_PIX_FMT_NONE; ++fmt)
+    {
+      yuv420p = yuv420p || *fmt == AV_PIX_FMT_YUV420P;
+    }
+    for (const AVPixelFormat *fmt = _encoder->pix_fmts;
+         !yuv420p && *fmt != AV_PIX_FMT_NONE; ++fmt)
+    {
+      if (sws_isSupportedOutput(*fmt))
+      {
+        this->codecCtx->pix_fmt = *fmt;
+        break;
+      }
+    }
+  }
+
+  this->codecCtx->thread_count = 5;
+
+  // Set the codec id
+  this->codecCtx->codec_id = _encoder->id;
+
+  if (this->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
+  {
+    // Needed to avoid using macroblocks in which some coeffs overflow.
+    // This does not happen with normal video, it just happens here as
+    // the motion of the chroma plane does not match the luma plane.
+    this->codecCtx->mb_decision = 2;
+  }
+
+  if (this->codecCtx->codec_id == AV_CODEC_ID_H264 && this->stream)
+  {
+    av_opt_set(this->codecCtx->priv_data, "preset", "ultrafast", 0);
+    av_opt_set(this->codecCtx->priv_data, "tune", "zerolatency", 0);
+  }
+  else if (this->codecCtx->codec_id == AV_CODEC_ID_H264)
+  {
+    av_opt_set(this->codecCtx->priv_data, "preset", "slow", 0);
+
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
+    av_opt_set(this->videoStream->codec->priv_data,
+        "preset", "slow", 0);
+#else
+    av_opt_set(this->videoStream->priv_data, "preset", "slow", 0);
+#endif
+  }
+
+  // Open the video context
+  int ret = avcodec_open2(this->codecCtx, _encoder, 0);
+  if (ret < 0)
+  {
+    char errBuff[AV_ERROR_MAX_STRING_SIZE];
+    av_strerror(ret, errBuff, AV_ERROR_MAX_STRING_SIZE);
+
+    if (_quiet)
+    {
+      gzlog << "Could not open video codec: " << errBuff << "\n";
+    }
+    else
+    {
+      gzerr << "Could not open video codec: " << errBuff
+            << "Video encoding is not started\n";
+    }
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+    avcodec_free_context(&this->codecCtx);
+#endif
+    this->codecCtx = nullptr;
+    return false;
+  }
+
+  return true;
+}
+#endif
+
 /////////////////////////////////////////////////
 #ifdef HAVE_FFMPEG
 bool VideoEncoder::Start(const std::string &_format,
@@ -204,9 +517,15 @@ bool VideoEncoder::Start(const std::string &_format,
   this->dataPtr->fps = _fps;
   this->dataPtr->frameCount = 0;
   this->dataPtr->filename = _filename;
+  this->dataPtr->stream = this->dataPtr->nextStream;
 
+  // A streamed video has no file
+  if (this->dataPtr->stream)
+  {
+    this->dataPtr->filename = "";
+  }
   // Create a default filenamae if the provided filename is empty.
-  if (this->dataPtr->filename.empty())
+  else if (this->dataPtr->filename.empty())
   {
     if (this->dataPtr->format.compare("v4l2") == 0)
     {
@@ -233,7 +552,7 @@ bool VideoEncoder::Start(const std::string &_format,
   this->dataPtr->formatCtx = nullptr;
 
   // Special case for video4linux2. Here we attempt to find the v4l2 device
-  if (this->dataPtr->format.compare("v4l2") == 0)
+  if (!this->dataPtr->stream && this->dataPtr->format.compare("v4l2") == 0)
   {
 #if LIBAVDEVICE_VERSION_INT >= AV_VERSION_INT(56, 4, 100)
     while ((outputFormat = av_output_video_device_next(outputFormat))
@@ -254,6 +573,23 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
 #endif
   }
+  // A streamed video takes its format from the name of the format
+  else if (this->dataPtr->stream)
+  {
+    outputFormat = av_guess_format(this->dataPtr->format.c_str(), nullptr,
+        nullptr);
+    if (!outputFormat || (outputFormat->flags & AVFMT_NOFILE))
+    {
+      gzerr << "Format[" << this->dataPtr->format << "] can't be streamed. "
+            << "Video encoding is not started\n";
+      this->Reset();
+      return false;
+    }
+
+    this->dataPtr->formatCtx = avformat_alloc_context();
+    if (this->dataPtr->formatCtx)
+      this->dataPtr->formatCtx->oformat = outputFormat;
+  }
   else
   {
     outputFormat = av_guess_format(nullptr,
@@ -326,89 +662,32 @@ bool VideoEncoder::Start(const std::string &_format,
   }
   this->dataPtr->videoStream->id = this->dataPtr->formatCtx->nb_streams-1;
 
-  // Allocate a new video context
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-  this->dataPtr->codecCtx = this->dataPtr->videoStream->codec;
-#else
-  this->dataPtr->codecCtx = avcodec_alloc_context3(encoder);
-#endif
-
-  if (!this->dataPtr->codecCtx)
-  {
-    gzerr << "Could not allocate an encoding context."
-          << "Video encoding is not started\n";
-    this->Reset();
-    return false;
-  }
-
-  // some formats want stream headers to be separate
-  if (this->dataPtr->formatCtx->oformat->flags & AVFMT_GLOBALHEADER)
-  {
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    this->dataPtr->codecCtx->flags |= CODEC_FLAG_GLOBAL_HEADER;
-#else
-    this->dataPtr->codecCtx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
-#endif
-  }
-
-  // Frames per second
-  this->dataPtr->codecCtx->time_base.den = this->dataPtr->fps;
-  this->dataPtr->codecCtx->time_base.num = 1;
-
-  // The video stream must have the same time base as the context
-  this->dataPtr->videoStream->time_base.den = this->dataPtr->fps;
-  this->dataPtr->videoStream->time_base.num = 1;
-
-  // Bitrate
-  this->dataPtr->codecCtx->bit_rate = this->dataPtr->bitRate;
-
-  // The resolution must be divisible by two
-  this->dataPtr->codecCtx->width = _width % 2 == 0 ? _width : _width + 1;
-  this->dataPtr->codecCtx->height = _height % 2 == 0 ? _height : _height + 1;
-
-  // Emit one intra-frame every 10 frames
-  this->dataPtr->codecCtx->gop_size = 10;
-  this->dataPtr->codecCtx->max_b_frames = 1;
-  this->dataPtr->codecCtx->pix_fmt = AV_PIX_FMT_YUV420P;
-  this->dataPtr->codecCtx->thread_count = 5;
-
-  // Set the codec id
-  this->dataPtr->codecCtx->codec_id =
-    this->dataPtr->formatCtx->oformat->video_codec;
-
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_MPEG1VIDEO)
+  bool opened = false;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
+  // Try the requested encoder first, and fall back to the default one
+  if (!this->dataPtr->hwEncoder.empty())
   {
-    // Needed to avoid using macroblocks in which some coeffs overflow.
-    // This does not happen with normal video, it just happens here as
-    // the motion of the chroma plane does not match the luma plane.
-    this->dataPtr->codecCtx->mb_decision = 2;
+    AVCodec *hwCodec =
+      avcodec_find_encoder_by_name(this->dataPtr->hwEncoder.c_str());
+    if (hwCodec && this->dataPtr->OpenCodec(hwCodec, _width, _height, true))
+    {
+      opened = true;
+    }
+    else
+    {
+      gzwarn << "Unable to open video encoder[" << this->dataPtr->hwEncoder
+             << "]. Using the default encoder.\n";
+    }
   }
-
-  if (this->dataPtr->codecCtx->codec_id == AV_CODEC_ID_H264)
-  {
-    av_opt_set(this->dataPtr->codecCtx->priv_data, "preset", "slow", 0);
-
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-    av_opt_set(this->dataPtr->videoStream->codec->priv_data,
-        "preset", "slow", 0);
-#else
-    av_opt_set(this->dataPtr->videoStream->priv_data, "preset", "slow", 0);
 #endif
-  }
 
-  // Open the video context
-  int ret = avcodec_open2(this->dataPtr->codecCtx, encoder, 0);
-  if (ret < 0)
+  if (!opened && !this->dataPtr->OpenCodec(encoder, _width, _height, false))
   {
-    char errBuff[AV_ERROR_MAX_STRING_SIZE];
-    av_strerror(ret, errBuff, AV_ERROR_MAX_STRING_SIZE);
-
-    gzerr << "Could not open video codec: " << errBuff
-          << "Video encoding is not started\n";
     this->Reset();
     return false;
   }
 
+  int ret = 0;
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(55, 28, 1)
   this->dataPtr->avOutFrame = avcodec_alloc_frame();
 #else
@@ -465,8 +744,32 @@ bool VideoEncoder::Start(const std::string &_format,
   this->dataPtr->formatCtx->max_delay =
     static_cast<int>(muxMaxDelay * AV_TIME_BASE);
 
+  // A streamed video is written by the callback, one frame at a time
+  if (this->dataPtr->stream)
+  {
+    auto buffer = static_cast<unsigned char *>(av_malloc(kStreamBufferSize));
+    if (buffer)
+    {
+      this->dataPtr->streamCtx = avio_alloc_context(buffer, kStreamBufferSize,
+          1, this->dataPtr.get(), nullptr, &VideoEncoderPrivate::WriteStream,
+          nullptr);
+    }
+
+    if (!this->dataPtr->streamCtx)
+    {
+      av_free(buffer);
+      gzerr << "Could not allocate the stream. "
+            << "Video encoding is not started\n";
+      this->Reset();
+      return false;
+    }
+
+    this->dataPtr->formatCtx->pb = this->dataPtr->streamCtx;
+    this->dataPtr->formatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+    this->dataPtr->formatCtx->max_delay = 0;
+  }
   // Open the video stream
-  if (!(this->dataPtr->formatCtx->oformat->flags & AVFMT_NOFILE))
+  else if (!(this->dataPtr->formatCtx->oformat->flags & AVFMT_NOFILE))
   {
     ret = avio_open(&this->dataPtr->formatCtx->pb,
         this->dataPtr->filename.c_str(), AVIO_FLAG_WRITE);
@@ -496,7 +799,13 @@ bool VideoEncoder::Start(const std::string &_format,
     return false;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    this->dataPtr->droppedFrames = 0;
+  }
   this->dataPtr->encoding = true;
+  this->dataPtr->encodeThread = std::thread(
+      &VideoEncoderPrivate::EncodeLoop, this->dataPtr.get());
   return true;
 }
 // #else for HAVE_FFMPEG version check
@@ -552,56 +861,90 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   if (dt < std::chrono::duration<double>(1.0/this->dataPtr->fps))
     return false;
 
+  // Copy the frame to a pooled buffer, the encoder thread converts and
+  // encodes it.
+  VideoEncoderFrame frame;
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    if (this->dataPtr->queue.size() >= this->dataPtr->queueLimit)
+    {
+      this->dataPtr->droppedFrames++;
+      return false;
+    }
+
+    if (!this->dataPtr->pool.empty())
+    {
+      frame.data = std::move(this->dataPtr->pool.back());
+      this->dataPtr->pool.pop_back();
+    }
+  }
+
   this->dataPtr->timePrev = _timestamp;
 
+  frame.data.assign(_frame, _frame + _width * _height * 3);
+  frame.width = _width;
+  frame.height = _height;
+
+  {
+    std::lock_guard<std::mutex> queueLock(this->dataPtr->queueMutex);
+    this->dataPtr->queue.push_back(std::move(frame));
+  }
+  this->dataPtr->queueCond.notify_one();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool VideoEncoderPrivate::Encode(const VideoEncoderFrame &_frame)
+{
   // Cause the sws to be recreated on image resize
-  if (this->dataPtr->swsCtx &&
-      (this->dataPtr->inWidth != _width || this->dataPtr->inHeight != _height))
+  if (this->swsCtx &&
+      (this->inWidth != _frame.width || this->inHeight != _frame.height))
   {
-    sws_freeContext(this->dataPtr->swsCtx);
-    this->dataPtr->swsCtx = nullptr;
+    sws_freeContext(this->swsCtx);
+    this->swsCtx = nullptr;
 
-    if (this->dataPtr->avInFrame)
+    if (this->avInFrame)
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      av_free(this->dataPtr->avInFrame);
+      av_free(this->avInFrame);
 #else
-      av_frame_free(&this->dataPtr->avInFrame);
+      av_frame_free(&this->avInFrame);
 #endif
-    this->dataPtr->avInFrame = nullptr;
+    this->avInFrame = nullptr;
   }
 
-  if (!this->dataPtr->swsCtx)
+  if (!this->swsCtx)
   {
-    this->dataPtr->inWidth = _width;
-    this->dataPtr->inHeight = _height;
+    this->inWidth = _frame.width;
+    this->inHeight = _frame.height;
 
-    if (!this->dataPtr->avInFrame)
+    if (!this->avInFrame)
     {
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 24, 1)
-      this->dataPtr->avInFrame = new AVPicture;
-      avpicture_alloc(this->dataPtr->avInFrame,
-          AV_PIX_FMT_RGB24, this->dataPtr->inWidth,
-          this->dataPtr->inHeight);
+      this->avInFrame = new AVPicture;
+      avpicture_alloc(this->avInFrame,
+          AV_PIX_FMT_RGB24, this->inWidth,
+          this->inHeight);
 #else
-      this->dataPtr->avInFrame = av_frame_alloc();
+      this->avInFrame = av_frame_alloc();
 
-      av_image_alloc(this->dataPtr->avInFrame->data,
-          this->dataPtr->avInFrame->linesize,
-          this->dataPtr->inWidth, this->dataPtr->inHeight,
+      av_image_alloc(this->avInFrame->data,
+          this->avInFrame->linesize,
+          this->inWidth, this->inHeight,
           AV_PIX_FMT_RGB24, 1);
 #endif
     }
 
-    this->dataPtr->swsCtx = sws_getContext(
-        this->dataPtr->inWidth,
-        this->dataPtr->inHeight,
+    this->swsCtx = sws_getContext(
+        this->inWidth,
+        this->inHeight,
         AV_PIX_FMT_RGB24,
-        this->dataPtr->codecCtx->width,
-        this->dataPtr->codecCtx->height,
-        this->dataPtr->codecCtx->pix_fmt,
+        this->codecCtx->width,
+        this->codecCtx->height,
+        this->codecCtx->pix_fmt,
         SWS_BICUBIC, nullptr, nullptr, nullptr);
 
-    if (this->dataPtr->swsCtx == nullptr)
+    if (this->swsCtx == nullptr)
     {
       gzerr << "Error while calling sws_getContext\n";
       return false;
@@ -609,17 +952,17 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   }
 
   // encode
-  memcpy(this->dataPtr->avInFrame->data[0], _frame,
-         this->dataPtr->inWidth * this->dataPtr->inHeight * 3);
+  memcpy(this->avInFrame->data[0], _frame.data.data(),
+         this->inWidth * this->inHeight * 3);
 
-  sws_scale(this->dataPtr->swsCtx,
-      this->dataPtr->avInFrame->data,
-      this->dataPtr->avInFrame->linesize,
-      0, this->dataPtr->inHeight,
-      this->dataPtr->avOutFrame->data,
-      this->dataPtr->avOutFrame->linesize);
+  sws_scale(this->swsCtx,
+      this->avInFrame->data,
+      this->avInFrame->linesize,
+      0, this->inHeight,
+      this->avOutFrame->data,
+      this->avOutFrame->linesize);
 
-  this->dataPtr->avOutFrame->pts = this->dataPtr->frameCount++;
+  this->avOutFrame->pts = this->frameCount++;
 
 #if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(57, 40, 101)
   int gotOutput = 0;
@@ -628,37 +971,41 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket.data = nullptr;
   avPacket.size = 0;
 
-  int ret = avcodec_encode_video2(this->dataPtr->codecCtx, &avPacket,
-      this->dataPtr->avOutFrame, &gotOutput);
+  int ret = avcodec_encode_video2(this->codecCtx, &avPacket,
+      this->avOutFrame, &gotOutput);
 
   if (ret >= 0 && gotOutput == 1)
   {
-    avPacket.stream_index = this->dataPtr->videoStream->index;
+    avPacket.stream_index = this->videoStream->index;
 
     // Scale timestamp appropriately.
     if (avPacket.pts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.pts = av_rescale_q(avPacket.pts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     if (avPacket.dts != static_cast<int64_t>(AV_NOPTS_VALUE))
     {
       avPacket.dts = av_rescale_q(
           avPacket.dts,
-          this->dataPtr->codecCtx->time_base,
-          this->dataPtr->videoStream->time_base);
+          this->codecCtx->time_base,
+          this->videoStream->time_base);
     }
 
     // Write frame to disk
-    ret = av_interleaved_write_frame(this->dataPtr->formatCtx, &avPacket);
+    ret = av_interleaved_write_frame(this->formatCtx, &avPacket);
 
     if (ret < 0)
     {
       gzerr << "Error writing frame" << std::endl;
       return false;
     }
+
+    // Pass the frame to the stream now, rather than when the buffer fills
+    if (this->streamCtx)
+      avio_flush(this->streamCtx);
   }
 
   av_packet_unref(&avPacket);
@@ -672,39 +1019,42 @@ bool VideoEncoder::AddFrame(const unsigned char *_frame,
   avPacket->data = nullptr;
   avPacket->size = 0;
 
-  int ret = avcodec_send_frame(this->dataPtr->codecCtx,
-                               this->dataPtr->avOutFrame);
+  int ret = avcodec_send_frame(this->codecCtx,
+                               this->avOutFrame);
 
   // This loop will retrieve and write available packets
   while (ret >= 0)
   {
-    ret = avcodec_receive_packet(this->dataPtr->codecCtx, avPacket);
+    ret = avcodec_receive_packet(this->codecCtx, avPacket);
 
     // Potential performance improvement: Queue the packets and write in
     // a separate thread.
     if (ret >= 0)
     {
-      avPacket->stream_index = this->dataPtr->videoStream->index;
+      avPacket->stream_index = this->videoStream->index;
 
       // Scale timestamp appropriately.
       if (avPacket->pts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->pts = av_rescale_q(avPacket->pts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       if (avPacket->dts != static_cast<int64_t>(AV_NOPTS_VALUE))
       {
         avPacket->dts = av_rescale_q(
             avPacket->dts,
-            this->dataPtr->codecCtx->time_base,
-            this->dataPtr->videoStream->time_base);
+            this->codecCtx->time_base,
+            this->videoStream->time_base);
       }
 
       // Write frame to disk
-      if (av_interleaved_write_frame(this->dataPtr->formatCtx, avPacket) < 0)
+      if (av_interleaved_write_frame(this->formatCtx, avPacket) < 0)
         gzerr << "Error writing frame" << std::endl;
+      // Pass the frame to the stream now, rather than when the buffer fills
+      else if (this->streamCtx)
+        avio_flush(this->streamCtx);
     }
   }
 
@@ -730,7 +1080,17 @@ bool VideoEncoder::AddFrame(const unsigned char */*_frame*/,
 bool VideoEncoder::Stop()
 {
 #ifdef HAVE_FFMPEG
-  if (this->dataPtr->encoding && this->dataPtr->formatCtx)
+  bool wasEncoding;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    wasEncoding = this->dataPtr->encoding;
+    this->dataPtr->encoding = false;
+  }
+
+  // Encode the frames that are still queued
+  this->dataPtr->StopThread();
+
+  if (wasEncoding && this->dataPtr->formatCtx)
     av_write_trailer(this->dataPtr->formatCtx);
 
 #if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(57, 24, 1)
@@ -765,6 +1125,18 @@ bool VideoEncoder::Stop()
   this->dataPtr->formatCtx = nullptr;
   this->dataPtr->videoStream = nullptr;
 
+  // The I/O context of a stream belongs to the encoder
+  if (this->dataPtr->streamCtx)
+  {
+    av_freep(&this->dataPtr->streamCtx->buffer);
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(57, 80, 100)
+    avio_context_free(&this->dataPtr->streamCtx);
+#else
+    av_free(this->dataPtr->streamCtx);
+#endif
+  }
+  this->dataPtr->streamCtx = nullptr;
+
   this->dataPtr->encoding = false;
   return true;
 #endif
@@ -781,7 +1153,12 @@ bool VideoEncoder::SaveToFile(const std::string &_filename)
 #ifdef HAVE_FFMPEG
   bool result = true;
 
-  if (this->dataPtr->format != "v4l2")
+  if (this->dataPtr->stream)
+  {
+    gzerr << "A streamed video can't be saved to [" << _filename << "]\n";
+    result = false;
+  }
+  else if (this->dataPtr->format != "v4l2")
   {
     result = common::moveFile(this->dataPtr->filename, _filename);
 
@@ -819,6 +1196,11 @@ void VideoEncoder::Reset()
   this->dataPtr->inHeight = 0;
   this->dataPtr->timePrev = {};
   this->dataPtr->bitRate = VIDEO_ENCODER_BITRATE_DEFAULT;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->queueMutex);
+    this->dataPtr->pool.clear();
+  }
   this->dataPtr->fps = VIDEO_ENCODER_FPS_DEFAULT;
   this->dataPtr->format = VIDEO_ENCODER_FORMAT_DEFAULT;
+  this->dataPtr->stream = nullptr;
 }
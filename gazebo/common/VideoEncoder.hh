@@ -18,6 +18,9 @@
 #define GAZEBO_COMMON_VIDEOENCODER_HH_
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
 #include <gazebo/util/system.hh>
@@ -29,6 +32,7 @@
 #define VIDEO_ENCODER_HEIGHT_DEFAULT 720
 #define VIDEO_ENCODER_FPS_DEFAULT 25
 #define VIDEO_ENCODER_FORMAT_DEFAULT "mp4"
+#define VIDEO_ENCODER_QUEUE_DEFAULT 8
 
 namespace gazebo
 {
@@ -43,8 +47,22 @@ namespace gazebo
     /// \class VideoEncoder VideoEncoder.hh common/common.hh
     /// \brief The VideoEncoder class supports encoding a series of images
     /// to a video format, and then writing the video to disk.
+    ///
+    /// Frames are copied to a bounded queue of reused buffers, and are
+    /// converted and encoded on a thread of the encoder, so that AddFrame
+    /// doesn't block the caller. The environment variable
+    /// GAZEBO_VIDEO_ENCODER can name an ffmpeg encoder to use instead of
+    /// the default encoder of the format, see SetHardwareEncoder. The
+    /// video can also be streamed to a callback instead of a file, see
+    /// SetStreamCallback.
     class GZ_COMMON_VISIBLE VideoEncoder
     {
+      /// \brief Receives the muxed bytes of a streamed video.
+      /// \param[in] _data Bytes of the video.
+      /// \param[in] _size Number of bytes.
+      public: typedef std::function<void (const unsigned char *_data,
+                  const std::size_t _size)> StreamCallback;
+
       /// \brief Constructor
       public: VideoEncoder();
 
@@ -89,7 +107,8 @@ namespace gazebo
       /// \param[in] _frame Image buffer to be encoded
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
-      /// \return True on success
+      /// \return True if the frame was queued, false if it arrived faster
+      /// than the video's fps or the queue is full.
       public: bool AddFrame(const unsigned char *_frame,
                             const unsigned int _width,
                             const unsigned int _height);
@@ -99,7 +118,8 @@ namespace gazebo
       /// \param[in] _width Input frame width
       /// \param[in] _height Input frame height
       /// \param[in] _timestamp Timestamp of the image frame
-      /// \return True on success.
+      /// \return True if the frame was queued, false if it arrived faster
+      /// than the video's fps or the queue is full.
       public: bool AddFrame(const unsigned char *_frame,
                   const unsigned int _width,
                   const unsigned int _height,
@@ -122,6 +142,33 @@ namespace gazebo
       /// memory. This will also delete any temporary files.
       public: void Reset();
 
+      /// \brief Set the number of frames that can wait to be encoded.
+      /// Frames added while the queue is full are dropped.
+      /// \param[in] _frames Queue limit, at least 1.
+      public: void SetQueueLimit(const unsigned int _frames);
+
+      /// \brief Get the number of frames dropped because the queue was full
+      /// since Start was called.
+      /// \return Number of dropped frames.
+      public: uint64_t DroppedFrames() const;
+
+      /// \brief Set the ffmpeg encoder to try first on the next Start, such
+      /// as "h264_nvenc" or "h264_qsv". The encoder must accept frames in
+      /// system memory. The default encoder of the format is used if it
+      /// can't be opened.
+      /// \param[in] _encoder Name of the encoder, empty for the default.
+      public: void SetHardwareEncoder(const std::string &_encoder);
+
+      /// \brief Stream the video to a callback instead of a file, from the
+      /// next Start. The _format of Start must then be a format that can be
+      /// streamed, such as "mpegts", and _filename is ignored. The bytes of
+      /// each frame are passed to the callback as soon as it is encoded, on
+      /// the thread of the encoder. Streams favor latency: there are no
+      /// B-frames and there is an intra-frame every second.
+      /// \param[in] _callback Callback of the stream, null to write to a
+      /// file.
+      public: void SetStreamCallback(const StreamCallback &_callback);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<VideoEncoderPrivate> dataPtr;
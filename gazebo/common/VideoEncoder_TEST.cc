@@ -15,6 +15,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <vector>
+
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "test/util.hh"
@@ -57,6 +60,71 @@ TEST_F(VideoEncoderTest, StartStop)
 #endif
 }
 
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, QueueFrames)
+{
+  VideoEncoder video;
+  EXPECT_EQ(0u, video.DroppedFrames());
+
+#ifdef HAVE_FFMPEG
+  video.SetQueueLimit(2);
+  EXPECT_TRUE(video.Start("mp4", "", 320, 240, 25));
+
+  // Frames are spaced by the video's period, so only a full queue can
+  // reject them
+  std::vector<unsigned char> frame(320 * 240 * 3, 128);
+  auto timestamp = std::chrono::steady_clock::now();
+  unsigned int queued = 0;
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    timestamp += std::chrono::milliseconds(40);
+    if (video.AddFrame(frame.data(), 320, 240, timestamp))
+      ++queued;
+  }
+  EXPECT_EQ(20u, queued + video.DroppedFrames());
+
+  // Stop encodes the queued frames
+  EXPECT_TRUE(video.Stop());
+  EXPECT_FALSE(video.IsEncoding());
+  EXPECT_GT(queued, 0u);
+  video.Reset();
+#endif
+}
+
+/////////////////////////////////////////////////
+TEST_F(VideoEncoderTest, Stream)
+{
+  VideoEncoder video;
+  std::size_t bytes = 0;
+  video.SetStreamCallback([&bytes](const unsigned char *,
+      const std::size_t _size)
+      {
+        bytes += _size;
+      });
+
+#ifdef HAVE_FFMPEG
+  // Formats without a muxer that can stream are refused
+  EXPECT_FALSE(video.Start("v4l2", "", 320, 240, 25));
+
+  EXPECT_TRUE(video.Start("mpegts", "", 320, 240, 25));
+  EXPECT_FALSE(common::exists(common::cwd() + "/TMP_RECORDING.mpegts"));
+
+  std::vector<unsigned char> frame(320 * 240 * 3, 128);
+  auto timestamp = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    timestamp += std::chrono::milliseconds(40);
+    video.AddFrame(frame.data(), 320, 240, timestamp);
+  }
+
+  // The stream has the frames, and there is no file to save
+  EXPECT_TRUE(video.Stop());
+  EXPECT_GT(bytes, 0u);
+  EXPECT_FALSE(video.SaveToFile("stream.mpegts"));
+  EXPECT_FALSE(common::exists("stream.mpegts"));
+#endif
+}
+
 /////////////////////////////////////////////////
 TEST_F(VideoEncoderTest, Exists)
 {
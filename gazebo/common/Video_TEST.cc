@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/common/Video.hh"
+#include "gazebo/common/VideoEncoder.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+using namespace common;
+
+class VideoTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(VideoTest, NotLoaded)
+{
+  Video video;
+  EXPECT_FALSE(video.Load("/not/a/video.mp4"));
+  EXPECT_FALSE(video.HardwareDecoding());
+  EXPECT_FALSE(video.SetOutputFormat(Image::L_INT8));
+  EXPECT_TRUE(video.SetOutputFormat(Image::BGRA_INT8));
+}
+
+/////////////////////////////////////////////////
+TEST_F(VideoTest, DecodeThread)
+{
+#ifdef HAVE_FFMPEG
+  // Encode a short video
+  VideoEncoder encoder;
+  ASSERT_TRUE(encoder.Start("mp4", "", 320, 240, 25));
+  std::vector<unsigned char> frame(320 * 240 * 3, 128);
+  auto timestamp = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    timestamp += std::chrono::milliseconds(40);
+    encoder.AddFrame(frame.data(), 320, 240, timestamp);
+  }
+  const std::string filename = common::cwd() + "/video_test.mp4";
+  ASSERT_TRUE(encoder.SaveToFile(filename));
+
+  // A decoder that doesn't exist falls back to the default one
+  Video video;
+  video.SetHardwareDecoder("not_a_decoder");
+  ASSERT_TRUE(video.Load(filename));
+  EXPECT_FALSE(video.HardwareDecoding());
+  EXPECT_EQ(video.GetWidth(), 320);
+  EXPECT_EQ(video.GetHeight(), 240);
+
+  EXPECT_TRUE(video.SetOutputFormat(Image::BGRA_INT8));
+  EXPECT_EQ(video.FrameSize(), 320u * 240u * 4u);
+
+  // Pop the frames decoded by the thread, until the end of the video
+  ASSERT_TRUE(video.StartDecoding(2));
+  std::vector<unsigned char> buffer(video.FrameSize());
+  unsigned int frames = 0;
+  for (int i = 0; i < 1000 && !video.Ended(); ++i)
+  {
+    if (video.PopFrame(buffer.data()))
+      ++frames;
+    else
+      common::Time::MSleep(5);
+  }
+  EXPECT_TRUE(video.Ended());
+  EXPECT_GT(frames, 0u);
+  EXPECT_EQ(buffer[3], 255);
+
+  video.StopDecoding();
+  EXPECT_FALSE(video.PopFrame(buffer.data()));
+#endif
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -66,32 +66,47 @@ bool gazebo::setupServer(int _argc, char **_argv)
 
   gazebo::transport::get_master_uri(host, port);
 
-  g_master = new gazebo::Master();
-  g_master->Init(port);
-  g_master->RunThread();
+  {
+    common::StartupScope startupScope("Master::Init");
+    g_master = new gazebo::Master();
+    g_master->Init(port);
+    g_master->RunThread();
+  }
 
-  if (!gazebo_shared::setup("server-", _argc, _argv, g_plugins))
   {
-    gzerr << "Unable to setup Gazebo\n";
-    return false;
+    common::StartupScope startupScope("gazebo_shared::setup");
+    if (!gazebo_shared::setup("server-", _argc, _argv, g_plugins))
+    {
+      gzerr << "Unable to setup Gazebo\n";
+      return false;
+    }
   }
 
-  if (!sensors::load())
   {
-    gzerr << "Unable to load sensors\n";
-    return false;
+    common::StartupScope startupScope("sensors::load");
+    if (!sensors::load())
+    {
+      gzerr << "Unable to load sensors\n";
+      return false;
+    }
   }
 
-  if (!gazebo::physics::load())
   {
-    gzerr << "Unable to initialize physics.\n";
-    return false;
+    common::StartupScope startupScope("physics::load");
+    if (!gazebo::physics::load())
+    {
+      gzerr << "Unable to initialize physics.\n";
+      return false;
+    }
   }
 
-  if (!sensors::init())
   {
-    gzerr << "Unable to initialize sensors\n";
-    return false;
+    common::StartupScope startupScope("sensors::init");
+    if (!sensors::init())
+    {
+      gzerr << "Unable to initialize sensors\n";
+      return false;
+    }
   }
 
   return true;
@@ -20,6 +20,7 @@
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/PluginCosts.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo_shared.hh"
 
@@ -36,6 +37,7 @@ void gazebo_shared::addPlugin(const std::string &_filename,
   if (_filename.empty())
     return;
 
+  gazebo::common::PluginCostScope costScope(_filename, _filename);
   gazebo::SystemPluginPtr plugin =
     gazebo::SystemPlugin::Create(_filename, _filename);
 
@@ -69,6 +71,8 @@ bool gazebo_shared::setup(const std::string &_prefix, int _argc, char **_argv,
   for (std::vector<gazebo::SystemPluginPtr>::iterator iter =
        _plugins.begin(); iter != _plugins.end(); ++iter)
   {
+    gazebo::common::PluginCostScope costScope((*iter)->GetHandle(),
+        (*iter)->GetFilename());
     (*iter)->Load(_argc, _argv);
   }
 
@@ -88,6 +92,8 @@ bool gazebo_shared::setup(const std::string &_prefix, int _argc, char **_argv,
   for (std::vector<gazebo::SystemPluginPtr>::iterator iter = _plugins.begin();
        iter != _plugins.end(); ++iter)
   {
+    gazebo::common::PluginCostScope costScope((*iter)->GetHandle(),
+        (*iter)->GetFilename());
     (*iter)->Init();
   }
 
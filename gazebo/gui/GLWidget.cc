@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <functional>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -25,6 +26,7 @@
 
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/FPSViewController.hh"
 #include "gazebo/rendering/Heightmap.hh"
@@ -67,7 +69,14 @@ GLWidget::GLWidget(QWidget *_parent)
 
   this->dataPtr->updateTimer = new QTimer(this);
   connect(this->dataPtr->updateTimer, SIGNAL(timeout()),
-  this, SLOT(update()));
+  this, SLOT(OnUpdateTimer()));
+
+  // Idle clients may render only on changes, at a limited rate, to leave
+  // the GPU to the sensors.
+  this->dataPtr->onDemand =
+    gazebo::gui::getINIProperty<int>("rendering.on_demand", 0) != 0;
+  this->dataPtr->maxFrameRate = std::max(0.0,
+      gazebo::gui::getINIProperty<double>("rendering.max_fps", 0.0));
 
   this->dataPtr->windowId = -1;
 
@@ -214,6 +223,29 @@ GLWidget::~GLWidget()
 /////////////////////////////////////////////////
 bool GLWidget::eventFilter(QObject * /*_obj*/, QEvent *_event)
 {
+  // User input and window changes are drawn by the next frame.
+  switch (_event->type())
+  {
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseButtonRelease:
+    case QEvent::MouseButtonDblClick:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::KeyPress:
+    case QEvent::KeyRelease:
+    case QEvent::Resize:
+    case QEvent::Show:
+    case QEvent::Expose:
+    case QEvent::Enter:
+    case QEvent::Leave:
+    case QEvent::FocusIn:
+    case QEvent::FocusOut:
+      this->dataPtr->renderRequested = true;
+      break;
+    default:
+      break;
+  }
+
   if (_event->type() == QEvent::Enter)
   {
     this->setFocus(Qt::OtherFocusReason);
@@ -280,6 +312,10 @@ void GLWidget::paintEvent(QPaintEvent *_e)
   rendering::UserCameraPtr cam = gui::get_active_camera();
   if (cam && cam->Initialized())
   {
+    this->dataPtr->renderRequested = false;
+    this->dataPtr->lastFrameTime = common::Time::GetWallTime();
+    ++this->dataPtr->frameCount;
+
     {
       IGN_PROFILE("gui::GLWidget::paintEvent pre-render");
       event::Events::preRender();
@@ -295,6 +331,10 @@ void GLWidget::paintEvent(QPaintEvent *_e)
       IGN_PROFILE("gui::GLWidget::paintEvent post-render");
       event::Events::postRender();
     }
+
+    // The client startup ends with its first frame.
+    if (common::StartupProfiler::Instance()->Enabled())
+      common::StartupProfiler::Instance()->Finish();
   }
   else
   {
@@ -917,10 +957,119 @@ void GLWidget::ViewScene(rendering::ScenePtr _scene)
   // client side heightmap configuration
   _scene->SetHeightmapLOD(gazebo::gui::getINIProperty<int>("heightmap.lod", 0));
 
+  // client side interpolation of the poses received from the server
+  _scene->SetPoseInterpolation(gazebo::gui::getINIProperty<int>(
+      "rendering.pose_interpolation", 0) != 0);
+
   // Update at the camera's update rate
-  this->dataPtr->updateTimer->start(
-      static_cast<int>(
-        std::round(1000.0 / this->dataPtr->userCamera->RenderRate())));
+  this->UpdateTimerInterval();
+  this->dataPtr->updateTimer->start();
+}
+
+/////////////////////////////////////////////////
+void GLWidget::UpdateTimerInterval()
+{
+  if (!this->dataPtr->userCamera)
+    return;
+
+  double rate = this->dataPtr->userCamera->RenderRate();
+  if (this->dataPtr->maxFrameRate > 0)
+    rate = std::min(rate, this->dataPtr->maxFrameRate);
+
+  this->dataPtr->updateTimer->setInterval(
+      static_cast<int>(std::round(1000.0 / rate)));
+}
+
+/////////////////////////////////////////////////
+void GLWidget::OnUpdateTimer()
+{
+  if (!this->dataPtr->onDemand)
+  {
+    this->update();
+    return;
+  }
+
+  bool changed = this->dataPtr->renderRequested;
+
+  // Poses, visuals and the other messages of the scene, including the
+  // visuals still being loaded.
+  if (this->dataPtr->scene)
+  {
+    const uint64_t changeCount = this->dataPtr->scene->ChangeCount();
+    if (changeCount != this->dataPtr->sceneChangeCount ||
+        this->dataPtr->scene->PendingVisualCount() > 0)
+    {
+      this->dataPtr->sceneChangeCount = changeCount;
+      changed = true;
+    }
+  }
+
+  // The camera, moved by a view controller, an animation or a joystick.
+  if (this->dataPtr->userCamera)
+  {
+    const ignition::math::Pose3d pose =
+      this->dataPtr->userCamera->WorldPose();
+    if (pose != this->dataPtr->cameraPose ||
+        this->dataPtr->userCamera->IsAnimating())
+    {
+      this->dataPtr->cameraPose = pose;
+      changed = true;
+    }
+  }
+
+  const common::Time now = common::Time::GetWallTime();
+  if (changed)
+    this->dataPtr->lastChangeTime = now;
+
+  // Keep rendering a little after a change, for the interpolated poses and
+  // the view controllers that move the camera in the next frames, and
+  // redraw an idle scene now and then for the changes it doesn't report,
+  // such as visual plugins.
+  const common::Time settleTime(0, 500000000);
+  const common::Time idleInterval(1, 0);
+  if (now - this->dataPtr->lastChangeTime < settleTime ||
+      now - this->dataPtr->lastFrameTime >= idleInterval)
+  {
+    this->update();
+  }
+}
+
+/////////////////////////////////////////////////
+void GLWidget::SetOnDemandRendering(const bool _enable)
+{
+  this->dataPtr->onDemand = _enable;
+  this->dataPtr->renderRequested = true;
+}
+
+/////////////////////////////////////////////////
+bool GLWidget::OnDemandRendering() const
+{
+  return this->dataPtr->onDemand;
+}
+
+/////////////////////////////////////////////////
+void GLWidget::SetMaxFrameRate(const double _rate)
+{
+  this->dataPtr->maxFrameRate = std::max(0.0, _rate);
+  this->UpdateTimerInterval();
+}
+
+/////////////////////////////////////////////////
+double GLWidget::MaxFrameRate() const
+{
+  return this->dataPtr->maxFrameRate;
+}
+
+/////////////////////////////////////////////////
+void GLWidget::RequestRender()
+{
+  this->dataPtr->renderRequested = true;
+}
+
+/////////////////////////////////////////////////
+uint64_t GLWidget::FrameCount() const
+{
+  return this->dataPtr->frameCount;
 }
 
 /////////////////////////////////////////////////
@@ -975,6 +1124,8 @@ void GLWidget::OnCreateScene(const std::string &_name)
 /////////////////////////////////////////////////
 void GLWidget::OnMoveMode(bool _mode)
 {
+  this->RequestRender();
+
   if (_mode)
   {
     this->dataPtr->entityMaker = NULL;
@@ -1139,6 +1290,8 @@ void GLWidget::DeselectAllVisuals()
 /////////////////////////////////////////////////
 void GLWidget::OnManipMode(const std::string &_mode)
 {
+  this->RequestRender();
+
   this->dataPtr->state = _mode;
 
   if (!this->dataPtr->selectedVisuals.empty())
@@ -1255,6 +1408,8 @@ void GLWidget::ClearSelection()
 void GLWidget::OnSetSelectedEntity(const std::string &_name,
                                    const std::string &_mode)
 {
+  this->RequestRender();
+
   if (!_name.empty())
   {
     std::string name = _name;
@@ -1283,7 +1438,7 @@ void GLWidget::OnSetSelectedEntity(const std::string &_name,
 /////////////////////////////////////////////////
 void GLWidget::OnRequest(ConstRequestPtr &_msg)
 {
-  if (_msg->request() == "entity_delete")
+  for (auto const &name : msgs::DeletedEntities(*_msg))
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->selectedVisMutex);
     if (!this->dataPtr->selectedVisuals.empty())
@@ -1293,7 +1448,7 @@ void GLWidget::OnRequest(ConstRequestPtr &_msg)
           it != this->dataPtr->selectedVisuals.end();
           ++it)
       {
-        if ((*it)->Name() == _msg->data())
+        if ((*it)->Name() == name)
         {
           ModelManipulator::Instance()->Detach();
           this->dataPtr->selectedVisuals.erase(it);
@@ -1302,7 +1457,7 @@ void GLWidget::OnRequest(ConstRequestPtr &_msg)
       }
     }
 
-    if (this->dataPtr->copyEntityName == _msg->data())
+    if (this->dataPtr->copyEntityName == name)
     {
       this->dataPtr->copyEntityName = "";
       g_pasteAct->setEnabled(false);
@@ -1314,6 +1469,8 @@ void GLWidget::OnRequest(ConstRequestPtr &_msg)
 void GLWidget::OnAlignMode(const std::string &_axis, const std::string &_config,
     const std::string &_target, const bool _preview, const bool _inverted)
 {
+  this->RequestRender();
+
   ModelAlign::Instance()->AlignVisuals(this->dataPtr->selectedVisuals, _axis,
       _config, _target, !_preview, _inverted);
 }
@@ -1332,6 +1489,8 @@ void GLWidget::OnModelEditor(bool _checked)
 /////////////////////////////////////////////////
 void GLWidget::OnOrtho()
 {
+  this->RequestRender();
+
   // Disable view control options when in ortho projection
   g_fpsAct->setEnabled(false);
   g_orbitAct->setEnabled(false);
@@ -1341,6 +1500,8 @@ void GLWidget::OnOrtho()
 /////////////////////////////////////////////////
 void GLWidget::OnPerspective()
 {
+  this->RequestRender();
+
   // Enable view control options when in perspective projection
   g_fpsAct->setEnabled(true);
   g_orbitAct->setEnabled(true);
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_GUI_GLWIDGET_HH_
 #define GAZEBO_GUI_GLWIDGET_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -74,6 +75,38 @@ namespace gazebo
       /// \return List with pointers to selected visuals.
       public: std::vector<rendering::VisualPtr> SelectedVisuals() const;
 
+      /// \brief Set whether to render only when something changes: the
+      /// scene, the camera or the widget, through user input. After a
+      /// change, frames are rendered for a short while so that
+      /// interpolated poses and camera motions settle, and an idle scene
+      /// is still redrawn about once a second. It can also be set with
+      /// rendering.on_demand in gui.ini.
+      /// \param[in] _enable True to render on demand, false to render at
+      /// the frame rate.
+      public: void SetOnDemandRendering(const bool _enable);
+
+      /// \brief Get whether the widget renders on demand.
+      /// \return True if it renders on demand.
+      public: bool OnDemandRendering() const;
+
+      /// \brief Set the largest frame rate. The widget renders at most at
+      /// the render rate of the user camera. It can also be set with
+      /// rendering.max_fps in gui.ini.
+      /// \param[in] _rate Frames per second, 0 for no limit.
+      public: void SetMaxFrameRate(const double _rate);
+
+      /// \brief Get the largest frame rate.
+      /// \return Frames per second, 0 for no limit.
+      public: double MaxFrameRate() const;
+
+      /// \brief Render the next frame in on-demand mode, e.g. after a
+      /// change to the scene that it doesn't report.
+      public: void RequestRender();
+
+      /// \brief Get the number of frames rendered.
+      /// \return The number of frames.
+      public: uint64_t FrameCount() const;
+
       signals: void clicked();
 
       /// \brief QT signal to notify when we received a selection msg.
@@ -206,6 +239,14 @@ namespace gazebo
       /// \brief QT Callback that turns on perspective projection
       private slots: void OnPerspective();
 
+      /// \brief QT callback of the update timer, which renders a frame
+      /// unless rendering on demand with nothing changed.
+      private slots: void OnUpdateTimer();
+
+      /// \brief Set the interval of the update timer from the camera
+      /// render rate and the largest frame rate.
+      private: void UpdateTimerInterval();
+
       /// \brief Set this->mouseEvent's Buttons property to the value of
       /// _event->buttons(). Note that this is different from the
       /// SetMouseEventButtons, plural, function.
@@ -17,10 +17,13 @@
 #ifndef _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 #define _GAZEBO_GUI_GLWIDGET_PRIVATE_HH_
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include <ignition/math/Pose3.hh>
+
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/KeyEvent.hh"
 #include "gazebo/common/MouseEvent.hh"
@@ -117,6 +120,31 @@ namespace gazebo
 
       /// \brief Time when the last wheel event was processed
       public: common::Time lastWheelEventTime;
+
+      /// \brief True to render only when something changes.
+      public: bool onDemand = false;
+
+      /// \brief Largest frame rate, 0 for no limit.
+      public: double maxFrameRate = 0.0;
+
+      /// \brief True if the next frame must be rendered in on-demand
+      /// mode.
+      public: std::atomic<bool> renderRequested{true};
+
+      /// \brief Change count of the scene at the last check.
+      public: uint64_t sceneChangeCount = 0;
+
+      /// \brief Pose of the user camera at the last check.
+      public: ignition::math::Pose3d cameraPose;
+
+      /// \brief Wall time of the last change.
+      public: common::Time lastChangeTime;
+
+      /// \brief Wall time of the last frame.
+      public: common::Time lastFrameTime;
+
+      /// \brief Number of frames rendered.
+      public: uint64_t frameCount = 0;
     };
   }
 }
@@ -15,6 +15,7 @@
  *
 */
 #include <boost/filesystem.hpp>
+#include <ignition/math/Helpers.hh>
 #include "gazebo/common/KeyEvent.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/transport.hh"
@@ -92,5 +93,78 @@ void GLWidget_TEST::SelectObject()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void GLWidget_TEST::OnDemandRendering()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  // Paused, so that the scene doesn't change
+  this->Load("worlds/empty.world", true, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != NULL);
+
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::gui::GLWidget *glWidget =
+      mainWindow->findChild<gazebo::gui::GLWidget *>("GLWidget");
+  QVERIFY(glWidget != NULL);
+
+  // Renders continuously by default
+  QVERIFY(!glWidget->OnDemandRendering());
+  QVERIFY(ignition::math::equal(glWidget->MaxFrameRate(), 0.0));
+
+  glWidget->SetMaxFrameRate(20);
+  QVERIFY(ignition::math::equal(glWidget->MaxFrameRate(), 20.0));
+  glWidget->SetMaxFrameRate(-1);
+  QVERIFY(ignition::math::equal(glWidget->MaxFrameRate(), 0.0));
+
+  glWidget->SetOnDemandRendering(true);
+  QVERIFY(glWidget->OnDemandRendering());
+
+  // Let the scene settle without touching it
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    gazebo::common::Time::MSleep(20);
+    QCoreApplication::processEvents();
+  }
+
+  // An idle scene is only redrawn about once a second
+  uint64_t frames = glWidget->FrameCount();
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    gazebo::common::Time::MSleep(20);
+    QCoreApplication::processEvents();
+  }
+  QVERIFY(glWidget->FrameCount() - frames <= 2u);
+
+  // A request renders again
+  frames = glWidget->FrameCount();
+  glWidget->RequestRender();
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    gazebo::common::Time::MSleep(20);
+    QCoreApplication::processEvents();
+  }
+  QVERIFY(glWidget->FrameCount() > frames);
+
+  // Continuous rendering again
+  glWidget->SetOnDemandRendering(false);
+  frames = glWidget->FrameCount();
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    gazebo::common::Time::MSleep(20);
+    QCoreApplication::processEvents();
+  }
+  QVERIFY(glWidget->FrameCount() - frames > 5u);
+
+  delete mainWindow;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(GLWidget_TEST)
@@ -27,6 +27,9 @@ class GLWidget_TEST : public QTestFixture
 
   /// \brief Test selecting an object.
   private slots: void SelectObject();
+
+  /// \brief Test rendering only when the scene changes.
+  private slots: void OnDemandRendering();
 };
 
 #endif
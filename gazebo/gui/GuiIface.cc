@@ -35,6 +35,7 @@
 #include "gazebo/common/ModelDatabase.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/gui/SplashScreen.hh"
 #include "gazebo/gui/MainWindow.hh"
@@ -158,7 +159,10 @@ bool parse_args(int _argc, char **_argv)
     ("gui-client-plugin", po::value<std::vector<std::string> >(),
      "Load a GUI plugin.")
     ("gui-plugin,g", po::value<std::vector<std::string> >(),
-     "Load a System plugin (deprecated, backwards compatibility reasons).");
+     "Load a System plugin (deprecated, backwards compatibility reasons).")
+    ("startup-profile", po::value<std::string>(),
+     "Write a Chrome trace of the startup phases to a file, with \"_client\" "
+     "appended to its name, and a summary table next to it.");
 
   po::options_description desc("Options");
   desc.add(v_desc);
@@ -193,6 +197,16 @@ bool parse_args(int _argc, char **_argv)
     gazebo::common::Console::SetQuiet(false);
   }
 
+  // The gazebo executable passes the same option to gzserver, so the client
+  // writes its own trace next to the one of the server.
+  if (vm.count("startup-profile"))
+  {
+    boost::filesystem::path path(vm["startup-profile"].as<std::string>());
+    path = path.parent_path() / (path.stem().string() + "_client" +
+        path.extension().string());
+    gazebo::common::StartupProfiler::Instance()->Start(path.string());
+  }
+
   /// Load the System plugins specified on the command line
   /// see https://github.com/osrf/gazebo/issues/2279 for details
   if (vm.count("gui-plugin"))
@@ -322,8 +336,11 @@ bool gui::load()
   g_modelRightMenu = new gui::ModelRightMenu();
 
   // Load the rendering engine.
-  rendering::load();
-  rendering::init();
+  {
+    common::StartupScope startupScope("gui::LoadRendering");
+    rendering::load();
+    rendering::init();
+  }
 
   g_argv = new char*[g_argc];
   for (int i = 0; i < g_argc; i++)
@@ -355,14 +372,18 @@ bool gui::load()
   }
 #endif
 
-  g_app = new QApplication(g_argc, g_argv);
-  set_style();
+  {
+    common::StartupScope startupScope("QApplication");
+    g_app = new QApplication(g_argc, g_argv);
+    set_style();
+  }
 
   if (!gui::register_metatypes())
     std::cerr << "Unable to register Qt metatypes" << std::endl;
 
   g_splashScreen = new gui::SplashScreen();
 
+  common::StartupScope startupScope("MainWindow::Load");
   g_main_win = new gui::MainWindow();
 
   g_main_win->Load();
@@ -15,6 +15,8 @@
  *
  */
 #include <functional>
+#include <string>
+#include <unordered_map>
 
 #include <google/protobuf/descriptor.h>
 #include <google/protobuf/message.h>
@@ -183,7 +185,7 @@ void ModelListWidget::OnModelSelection(QTreeWidgetItem *_item, int /*_column*/)
   if (_item)
   {
     std::string name = _item->data(0, Qt::UserRole).toString().toStdString();
-    this->dataPtr->propTreeBrowser->clear();
+    this->ClearPropertyTree();
     if (name == "Scene")
     {
       this->dataPtr->requestMsg = msgs::CreateRequest("scene_info",
@@ -232,7 +234,7 @@ void ModelListWidget::OnModelSelection(QTreeWidgetItem *_item, int /*_column*/)
     }
     else
     {
-      this->dataPtr->propTreeBrowser->clear();
+      this->ClearPropertyTree();
       event::Events::setSelectedEntity(name, "normal");
     }
   }
@@ -246,7 +248,7 @@ void ModelListWidget::OnSetSelectedEntity(const std::string &_name,
 {
   this->dataPtr->selectedEntityName = _name;
 
-  this->dataPtr->propTreeBrowser->clear();
+  this->ClearPropertyTree();
   if (!this->dataPtr->selectedEntityName.empty())
   {
     QTreeWidgetItem *mItem = this->ListItem(
@@ -292,7 +294,7 @@ void ModelListWidget::OnSetSelectedEntity(const std::string &_name,
               << "]."
               << std::endl;
       }
-      this->dataPtr->propTreeBrowser->clear();
+      this->ClearPropertyTree();
       this->dataPtr->fillTypes.push_back("Light");
 
       this->dataPtr->modelTreeWidget->setCurrentItem(lItem);
@@ -310,37 +312,74 @@ void ModelListWidget::Update()
   if (!this->dataPtr->fillTypes.empty())
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->propMutex);
-    this->dataPtr->fillingPropertyTree = true;
-    this->dataPtr->propTreeBrowser->clear();
-
-    if (this->dataPtr->fillTypes[0] == "Model")
-      this->FillPropertyTree(this->dataPtr->modelMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Link")
-      this->FillPropertyTree(this->dataPtr->linkMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Joint")
-      this->FillPropertyTree(this->dataPtr->jointMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Plugin")
-      this->FillPropertyTree(this->dataPtr->pluginMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Scene")
-      this->FillPropertyTree(this->dataPtr->sceneMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Physics")
-      this->FillPropertyTree(this->dataPtr->physicsMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Atmosphere")
-      this->FillPropertyTree(this->dataPtr->atmosphereMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Wind")
-      this->FillPropertyTree(this->dataPtr->windMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Light")
-      this->FillPropertyTree(this->dataPtr->lightMsg, nullptr);
-    else if (this->dataPtr->fillTypes[0] == "Spherical Coordinates")
-      this->FillPropertyTree(this->dataPtr->sphericalCoordMsg, nullptr);
-    this->dataPtr->fillingPropertyTree = false;
+
+    // Only the last fill of the queue is visible
+    while (this->dataPtr->fillTypes.size() > 1)
+      this->dataPtr->fillTypes.pop_front();
+    const std::string type = this->dataPtr->fillTypes[0];
     this->dataPtr->fillTypes.pop_front();
+
+    const google::protobuf::Message *msg = nullptr;
+    if (type == "Model")
+      msg = &this->dataPtr->modelMsg;
+    else if (type == "Link")
+      msg = &this->dataPtr->linkMsg;
+    else if (type == "Joint")
+      msg = &this->dataPtr->jointMsg;
+    else if (type == "Plugin")
+      msg = &this->dataPtr->pluginMsg;
+    else if (type == "Scene")
+      msg = &this->dataPtr->sceneMsg;
+    else if (type == "Physics")
+      msg = &this->dataPtr->physicsMsg;
+    else if (type == "Atmosphere")
+      msg = &this->dataPtr->atmosphereMsg;
+    else if (type == "Wind")
+      msg = &this->dataPtr->windMsg;
+    else if (type == "Light")
+      msg = &this->dataPtr->lightMsg;
+    else if (type == "Spherical Coordinates")
+      msg = &this->dataPtr->sphericalCoordMsg;
+
+    // Rebuilding the property tree resets its scroll position and the
+    // expanded items, so it is left as it is when the message didn't change
+    std::string key = type;
+    if (msg)
+      key += msg->SerializeAsString();
+    if (key != this->dataPtr->propertyTreeKey ||
+        this->dataPtr->propTreeBrowser->properties().isEmpty())
+    {
+      this->dataPtr->fillingPropertyTree = true;
+      this->ClearPropertyTree();
+      if (type == "Model")
+        this->FillPropertyTree(this->dataPtr->modelMsg, nullptr);
+      else if (type == "Link")
+        this->FillPropertyTree(this->dataPtr->linkMsg, nullptr);
+      else if (type == "Joint")
+        this->FillPropertyTree(this->dataPtr->jointMsg, nullptr);
+      else if (type == "Plugin")
+        this->FillPropertyTree(this->dataPtr->pluginMsg, nullptr);
+      else if (type == "Scene")
+        this->FillPropertyTree(this->dataPtr->sceneMsg, nullptr);
+      else if (type == "Physics")
+        this->FillPropertyTree(this->dataPtr->physicsMsg, nullptr);
+      else if (type == "Atmosphere")
+        this->FillPropertyTree(this->dataPtr->atmosphereMsg, nullptr);
+      else if (type == "Wind")
+        this->FillPropertyTree(this->dataPtr->windMsg, nullptr);
+      else if (type == "Light")
+        this->FillPropertyTree(this->dataPtr->lightMsg, nullptr);
+      else if (type == "Spherical Coordinates")
+        this->FillPropertyTree(this->dataPtr->sphericalCoordMsg, nullptr);
+      this->dataPtr->propertyTreeKey = key;
+      this->dataPtr->fillingPropertyTree = false;
+    }
   }
 
   if (!this->dataPtr->modelTreeWidget->currentItem())
   {
     std::lock_guard<std::mutex> lock(*this->dataPtr->propMutex);
-    this->dataPtr->propTreeBrowser->clear();
+    this->ClearPropertyTree();
   }
 
   this->ProcessRemoveEntity();
@@ -367,13 +406,34 @@ void ModelListWidget::OnLightUpdate(const msgs::Light &_msg)
   this->dataPtr->lightMsgs.push_back(msg);
 }
 
+/////////////////////////////////////////////////
+/// \brief Remove an item and its children from an index of tree items.
+/// \param[in] _item The item to remove.
+/// \param[in,out] _index The index.
+static void unindexItem(QTreeWidgetItem *_item,
+    std::unordered_map<std::string, QTreeWidgetItem *> &_index)
+{
+  auto iter = _index.find(
+      _item->data(0, Qt::UserRole).toString().toStdString());
+  if (iter != _index.end() && iter->second == _item)
+    _index.erase(iter);
+
+  for (int i = 0; i < _item->childCount(); ++i)
+    unindexItem(_item->child(i), _index);
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget::ProcessModelMsgs()
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  if (this->dataPtr->modelMsgs.empty())
+    return;
+
   QFont subheaderFont;
   subheaderFont.setBold(true);
 
+  // New models are added to the tree together, so that it is laid out once
+  QList<QTreeWidgetItem *> newItems;
   for (auto iter = this->dataPtr->modelMsgs.begin();
        iter != this->dataPtr->modelMsgs.end(); ++iter)
   {
@@ -388,11 +448,11 @@ void ModelListWidget::ProcessModelMsgs()
       {
         // Create an item for the model name
         QTreeWidgetItem *topItem = new QTreeWidgetItem(
-            this->dataPtr->modelsItem,
             QStringList(QString("%1").arg(QString::fromStdString(name))));
 
         topItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-        this->dataPtr->modelTreeWidget->addTopLevelItem(topItem);
+        this->dataPtr->modelItems.emplace(name, topItem);
+        newItems.append(topItem);
 
         if ((*iter).link_size() > 0)
         {
@@ -401,7 +461,6 @@ void ModelListWidget::ProcessModelMsgs()
           QStringList(QString("%1").arg(QString::fromStdString("LINKS"))));
           linkHeaderItem->setFont(0, subheaderFont);
           linkHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkHeaderItem);
         }
 
         for (int i = 0; i < (*iter).link_size(); ++i)
@@ -419,7 +478,7 @@ void ModelListWidget::ProcessModelMsgs()
           linkItem->setData(1, Qt::UserRole, QVariant((*iter).name().c_str()));
           linkItem->setData(2, Qt::UserRole, QVariant((*iter).id()));
           linkItem->setData(3, Qt::UserRole, QVariant("Link"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(linkItem);
+          this->dataPtr->modelItems.emplace(linkName, linkItem);
         }
 
         if ((*iter).joint_size() > 0)
@@ -429,7 +488,6 @@ void ModelListWidget::ProcessModelMsgs()
           QStringList(QString("%1").arg(QString::fromStdString("JOINTS"))));
           jointHeaderItem->setFont(0, subheaderFont);
           jointHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointHeaderItem);
         }
 
         for (int i = 0; i < (*iter).joint_size(); ++i)
@@ -446,7 +504,7 @@ void ModelListWidget::ProcessModelMsgs()
 
           jointItem->setData(0, Qt::UserRole, QVariant(jointName.c_str()));
           jointItem->setData(3, Qt::UserRole, QVariant("Joint"));
-          this->dataPtr->modelTreeWidget->addTopLevelItem(jointItem);
+          this->dataPtr->modelItems.emplace(jointName, jointItem);
         }
 
         if ((*iter).plugin_size() > 0)
@@ -456,7 +514,6 @@ void ModelListWidget::ProcessModelMsgs()
           QStringList(QString("%1").arg("PLUGINS")));
           pluginHeaderItem->setFont(0, subheaderFont);
           pluginHeaderItem->setFlags(Qt::NoItemFlags);
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginHeaderItem);
         }
 
         for (int i = 0; i < (*iter).plugin_size(); ++i)
@@ -480,8 +537,7 @@ void ModelListWidget::ProcessModelMsgs()
           pluginItem->setData(0, Qt::UserRole,
               QVariant(pluginUri.Str().c_str()));
           pluginItem->setData(3, Qt::UserRole, QVariant("Plugin"));
-
-          this->dataPtr->modelTreeWidget->addTopLevelItem(pluginItem);
+          this->dataPtr->modelItems.emplace(pluginUri.Str(), pluginItem);
         }
       }
     }
@@ -489,8 +545,15 @@ void ModelListWidget::ProcessModelMsgs()
     {
       if ((*iter).has_deleted() && (*iter).deleted())
       {
-        int i = this->dataPtr->modelsItem->indexOfChild(listItem);
-        this->dataPtr->modelsItem->takeChild(i);
+        // Models added by this batch aren't in the tree yet
+        const bool isNew = newItems.removeOne(listItem);
+        if (isNew || listItem->parent() == this->dataPtr->modelsItem)
+        {
+          unindexItem(listItem, this->dataPtr->modelItems);
+          if (!isNew)
+            this->dataPtr->modelsItem->removeChild(listItem);
+          delete listItem;
+        }
       }
       else
       {
@@ -500,6 +563,9 @@ void ModelListWidget::ProcessModelMsgs()
     }
   }
   this->dataPtr->modelMsgs.clear();
+
+  if (!newItems.isEmpty())
+    this->dataPtr->modelsItem->addChildren(newItems);
 }
 
 /////////////////////////////////////////////////
@@ -610,8 +676,14 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
     QTreeWidgetItem *listItem = this->ListItem(_name, items[i]);
     if (listItem)
     {
-      items[i]->takeChild(items[i]->indexOfChild(listItem));
-      this->dataPtr->propTreeBrowser->clear();
+      if (listItem->parent() == items[i])
+      {
+        unindexItem(listItem, i == 0 ? this->dataPtr->modelItems :
+            this->dataPtr->lightItems);
+        items[i]->removeChild(listItem);
+        delete listItem;
+      }
+      this->ClearPropertyTree();
       this->dataPtr->selectedEntityName.clear();
       this->dataPtr->sdfElement.reset();
       this->dataPtr->fillTypes.clear();
@@ -624,33 +696,14 @@ void ModelListWidget::RemoveEntity(const std::string &_name)
 QTreeWidgetItem *ModelListWidget::ListItem(const std::string &_name,
                                               QTreeWidgetItem *_parent)
 {
-  QTreeWidgetItem *listItem = nullptr;
-
-  // Find an existing element with the name from the message
-  for (int i = 0; i < _parent->childCount() && !listItem; ++i)
-  {
-    QTreeWidgetItem *item = _parent->child(i);
-    std::string listData = item->data(0, Qt::UserRole).toString().toStdString();
-
-    if (listData == _name)
-    {
-      listItem = item;
-      break;
-    }
+  // Models and their links, joints and plugins, or lights
+  const auto &index = _parent == this->dataPtr->lightsItem ?
+      this->dataPtr->lightItems : this->dataPtr->modelItems;
 
-    for (int j = 0; j < item->childCount(); j++)
-    {
-      QTreeWidgetItem *childItem = item->child(j);
-      listData = childItem->data(0, Qt::UserRole).toString().toStdString();
-      if (listData == _name)
-      {
-        listItem = childItem;
-        break;
-      }
-    }
-  }
-
-  return listItem;
+  auto iter = index.find(_name);
+  if (iter == index.end())
+    return nullptr;
+  return iter->second;
 }
 
 /////////////////////////////////////////////////
@@ -717,10 +770,14 @@ void ModelListWidget::OnPropertyChanged(QtProperty *_item)
   if (!currentItem)
     return;
 
-  if (this->dataPtr->modelsItem->indexOfChild(currentItem) != -1 ||
-      this->dataPtr->modelsItem->indexOfChild(currentItem->parent()) != -1)
+  // The property tree no longer shows the last message
+  this->dataPtr->propertyTreeKey.clear();
+
+  QTreeWidgetItem *parentItem = currentItem->parent();
+  if (parentItem == this->dataPtr->modelsItem ||
+      (parentItem && parentItem->parent() == this->dataPtr->modelsItem))
     this->ModelPropertyChanged(_item);
-  else if (this->dataPtr->lightsItem->indexOfChild(currentItem) != -1)
+  else if (parentItem == this->dataPtr->lightsItem)
     this->LightPropertyChanged(_item);
   else if (currentItem == this->dataPtr->sceneItem)
     this->ScenePropertyChanged(_item);
@@ -2794,10 +2851,8 @@ void ModelListWidget::FillPoseProperty(const msgs::Pose &_msg,
 /////////////////////////////////////////////////
 void ModelListWidget::OnRequest(ConstRequestPtr &_msg)
 {
-  if (_msg->request() == "entity_delete")
-  {
-    this->dataPtr->removeEntityList.push_back(_msg->data());
-  }
+  for (auto const &name : msgs::DeletedEntities(*_msg))
+    this->dataPtr->removeEntityList.push_back(name);
 }
 
 /////////////////////////////////////////////////
@@ -2815,7 +2870,7 @@ void ModelListWidget::ProcessRemoveEntity()
 void ModelListWidget::OnRemoveScene(const std::string &/*_name*/)
 {
   this->ResetTree();
-  this->dataPtr->propTreeBrowser->clear();
+  this->ClearPropertyTree();
   if (this->dataPtr->node)
     this->dataPtr->node->Fini();
   this->dataPtr->node.reset();
@@ -2836,7 +2891,7 @@ void ModelListWidget::OnCreateScene(const std::string &_name)
 {
   this->ResetTree();
 
-  this->dataPtr->propTreeBrowser->clear();
+  this->ClearPropertyTree();
   this->InitTransport(_name);
 
   // this->requestMsg = msgs::CreateRequest("scene_info");
@@ -2896,6 +2951,8 @@ void ModelListWidget::InitTransport(const std::string &_name)
 void ModelListWidget::ResetTree()
 {
   this->dataPtr->modelTreeWidget->clear();
+  this->dataPtr->modelItems.clear();
+  this->dataPtr->lightItems.clear();
 
   // Create the top level of items in the tree widget
   {
@@ -3391,16 +3448,19 @@ void ModelListWidget::ProcessLightMsgs()
           QStringList(QString("%1").arg(QString::fromStdString(name))));
 
       item->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
-      this->dataPtr->modelTreeWidget->addTopLevelItem(item);
-    }
-    else
-    {
-      listItem->setData(0, Qt::UserRole, QVariant((*iter).name().c_str()));
+      this->dataPtr->lightItems.emplace(name, item);
     }
   }
   this->dataPtr->lightMsgs.clear();
 }
 
+/////////////////////////////////////////////////
+void ModelListWidget::ClearPropertyTree()
+{
+  this->dataPtr->propTreeBrowser->clear();
+  this->dataPtr->propertyTreeKey.clear();
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget::AddProperty(QtProperty *_item, QtProperty *_parent)
 {
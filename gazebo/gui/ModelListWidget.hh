@@ -187,6 +187,9 @@ namespace gazebo
       /// \param[in] _parent Pointer to the parent property, if applicable.
       private: void AddProperty(QtProperty *_item, QtProperty *_parent);
 
+      /// \brief Remove all the properties from the property tree.
+      private: void ClearPropertyTree();
+
       private: void ProcessModelMsgs();
       private: void ProcessLightMsgs();
       private: void ProcessRemoveEntity();
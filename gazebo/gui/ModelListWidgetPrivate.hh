@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include <deque>
 #include <sdf/sdf.hh>
@@ -81,6 +82,13 @@ namespace gazebo
       /// \brief Spherical coordinates tree item.
       public: QTreeWidgetItem *sphericalCoordItem;
 
+      /// \brief Tree items of the models and of their links, joints and
+      /// plugins, by name.
+      public: std::unordered_map<std::string, QTreeWidgetItem *> modelItems;
+
+      /// \brief Tree items of the lights, by name.
+      public: std::unordered_map<std::string, QTreeWidgetItem *> lightItems;
+
       public: QtVariantPropertyManager *variantManager;
       public: QtVariantEditorFactory *variantFactory;
       public: std::mutex *propMutex, *receiveMutex;
@@ -122,6 +130,10 @@ namespace gazebo
       public: bool fillPropertyTree;
       public: std::deque<std::string> fillTypes;
 
+      /// \brief Type and content of the message shown in the property
+      /// tree, empty if it shows something else.
+      public: std::string propertyTreeKey;
+
       public: msgs::Light::LightType lightType;
 
       /// \brief Type of physics engine.
@@ -16,6 +16,9 @@
 */
 #include <boost/filesystem.hpp>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/gui/GuiEvents.hh"
@@ -377,6 +380,119 @@ void ModelListWidget_TEST::ModelsTree()
   modelListWidget = nullptr;
 }
 
+/////////////////////////////////////////////////
+void ModelListWidget_TEST::AddRemoveEntities()
+{
+  gazebo::gui::ModelListWidget *modelListWidget
+      = new gazebo::gui::ModelListWidget;
+  QCoreApplication::processEvents();
+
+  this->Load("worlds/shapes.world");
+
+  gazebo::transport::NodePtr node;
+  node = gazebo::transport::NodePtr(new gazebo::transport::Node());
+  node->Init();
+  gazebo::transport::PublisherPtr requestPub =
+      node->Advertise<gazebo::msgs::Request>("~/request");
+  gazebo::transport::PublisherPtr factoryPub =
+      node->Advertise<gazebo::msgs::Factory>("~/factory");
+
+  gazebo::msgs::Request *requestMsg =
+      gazebo::msgs::CreateRequest("entity_list");
+  requestPub->Publish(*requestMsg);
+
+  QTreeWidget *modelTreeWidget = modelListWidget->findChild<QTreeWidget *>(
+      "modelTreeWidget");
+  QTreeWidgetItem *modelsItem =
+      modelTreeWidget->findItems(tr("Models"), Qt::MatchExactly).front();
+  QVERIFY(modelsItem != nullptr);
+  QTreeWidgetItem *lightsItem =
+      modelTreeWidget->findItems(tr("Lights"), Qt::MatchExactly).front();
+  QVERIFY(lightsItem != nullptr);
+
+  // wait for the ground plane, sphere, box and cylinder, and the sun
+  int maxSleep = 10;
+  int sleep = 0;
+  while ((modelsItem->childCount() < 4 || lightsItem->childCount() < 1) &&
+      sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(500);
+    sleep++;
+  }
+  QVERIFY(sleep < maxSleep);
+  QCOMPARE(lightsItem->child(0)->text(0), tr("sun"));
+
+  // remove a model and a light
+  gazebo::transport::requestNoReply(node, "entity_delete", "sphere");
+  gazebo::transport::requestNoReply(node, "entity_delete", "sun");
+  sleep = 0;
+  while ((modelsItem->childCount() > 3 || lightsItem->childCount() > 0) &&
+      sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(500);
+    sleep++;
+  }
+  QVERIFY(sleep < maxSleep);
+  for (int i = 0; i < modelsItem->childCount(); ++i)
+    QVERIFY(modelsItem->child(i)->text(0) != tr("sphere"));
+
+  // spawn a model with the name of the removed one, and a few others
+  std::vector<std::string> names = {"sphere"};
+  for (int i = 0; i < 5; ++i)
+    names.push_back("new_box_" + std::to_string(i));
+  for (unsigned int i = 0; i < names.size(); ++i)
+  {
+    std::ostringstream sdf;
+    sdf << "<sdf version='" << SDF_VERSION << "'>"
+        << "<model name='" << names[i] << "'>"
+        << "  <pose>" << i << " 5 0.5 0 0 0</pose>"
+        << "  <link name='link'>"
+        << "    <collision name='collision'>"
+        << "      <geometry><box><size>1 1 1</size></box></geometry>"
+        << "    </collision>"
+        << "  </link>"
+        << "</model>"
+        << "</sdf>";
+    gazebo::msgs::Factory msg;
+    msg.set_sdf(sdf.str());
+    factoryPub->Publish(msg);
+  }
+
+  const int modelCount = 3 + static_cast<int>(names.size());
+  sleep = 0;
+  while (modelsItem->childCount() < modelCount && sleep < maxSleep)
+  {
+    QCoreApplication::processEvents();
+    QTest::qWait(500);
+    sleep++;
+  }
+  QVERIFY(sleep < maxSleep);
+  QCOMPARE(modelsItem->childCount(), modelCount);
+
+  // each new model is in the tree once, with its link
+  for (auto const &name : names)
+  {
+    int found = 0;
+    for (int i = 0; i < modelsItem->childCount(); ++i)
+    {
+      QTreeWidgetItem *item = modelsItem->child(i);
+      if (item->text(0) != tr(name.c_str()))
+        continue;
+      ++found;
+      QVERIFY(item->childCount() > 0);
+      QCOMPARE(item->child(0)->text(0), tr("link"));
+    }
+    QCOMPARE(found, 1);
+  }
+
+  node.reset();
+  delete requestMsg;
+  delete modelListWidget;
+  modelListWidget = nullptr;
+}
+
 /////////////////////////////////////////////////
 void ModelListWidget_TEST::ModelProperties()
 {
@@ -103,6 +103,11 @@ class ModelListWidget_TEST : public QTestFixture
   /// \brief Test that the model widget item contains all models in the world.
   private slots: void ModelsTree();
 
+  /// \brief Test that removed models and lights leave the tree, and that
+  /// models spawned afterwards, one of them with the name of a removed
+  /// model, are all added.
+  private slots: void AddRemoveEntities();
+
   /// \brief Test that the property browser displays correct model properties.
   /// The test then modifies the properties, refresh the property browser, and
   /// verify the changes are set.
@@ -84,6 +84,10 @@ namespace gazebo
 
       /// \brief Flag to indicate that the introspection client is initialized.
       public: bool initialized = false;
+
+      /// \brief Last received parameter of each item. Updates only contain
+      /// the items that changed.
+      public: std::map<std::string, gazebo::msgs::Param> lastParams;
     };
   }
 }
@@ -282,9 +286,15 @@ void IntrospectionCurveHandler::OnIntrospection(
   bool hasSimTime = false;
   for (auto i = 0; i < _msg.param_size(); ++i)
   {
-    auto param = _msg.param(i);
+    const auto &param = _msg.param(i);
     if (param.name().empty() || !param.has_value())
       continue;
+    this->dataPtr->lastParams[param.name()] = param;
+  }
+
+  for (auto const &lastParam : this->dataPtr->lastParams)
+  {
+    const auto &param = lastParam.second;
 
     std::string paramName = param.name();
     auto paramValue = param.value();
@@ -599,6 +609,7 @@ void IntrospectionCurveHandler::RemoveItemFromFilter(const std::string &_name,
               std::lock_guard<std::recursive_mutex> lock(this->dataPtr->mutex);
               this->dataPtr->introspectFilter.erase(item);
               this->dataPtr->introspectFilterCount.erase(item);
+              this->dataPtr->lastParams.erase(item);
             };
 
             // update filter
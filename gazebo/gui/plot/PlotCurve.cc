@@ -14,7 +14,11 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <deque>
 #include <map>
+#include <vector>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Assert.hh"
@@ -45,12 +49,59 @@ namespace gazebo
           Colors[ColorGroupCount][ColorCount];
     };
 
-    /// \brief A class that manages curve data
-    class CurveData: public QwtArraySeriesData<QPointF>
+    /// \brief Number of decimation levels of a curve.
+    static const std::size_t kLevelCount = 6;
+
+    /// \brief Maximum number of points of a level.
+    static const std::size_t kLevelSize = 11000;
+
+    /// \brief Number of points moved to the next level when a level is full.
+    static const std::size_t kChunkSize = 1000;
+
+    /// \brief Number of points of a level reduced to their min and max
+    /// points in the next level.
+    static const std::size_t kDecimation = 10;
+
+    /// \brief A class that manages curve data.
+    ///
+    /// The newest points are kept as they are. When there are too many of
+    /// them, the oldest ones are reduced to the points with the min and max
+    /// values of each group of kDecimation points, in a coarser level, and
+    /// so on. The envelope of the curve is kept, each level covers five
+    /// times the duration of the previous one, and the memory is bounded:
+    /// a curve at 1 kHz keeps about 11 hours of history in 66000 points.
+    class CurveData: public QwtSeriesData<QPointF>
     {
       public: CurveData()
+              : levels(kLevelCount)
               {}
 
+      /// \brief Get the number of points of all the levels.
+      /// \return Number of points.
+      public: virtual size_t size() const
+              {
+                size_t count = 0;
+                for (auto const &level : this->levels)
+                  count += level.size();
+                return count;
+              }
+
+      /// \brief Get a point, from the oldest to the newest.
+      /// \param[in] _i Index of the point.
+      /// \return The point.
+      public: virtual QPointF sample(size_t _i) const
+              {
+                // Coarser levels hold older points
+                for (auto level = this->levels.rbegin();
+                     level != this->levels.rend(); ++level)
+                {
+                  if (_i < level->size())
+                    return (*level)[_i];
+                  _i -= level->size();
+                }
+                return QPointF();
+              }
+
       /// \brief Add a point to the sample.
       /// \return Bounding box of the sample.
       public: virtual QRectF boundingRect() const
@@ -79,16 +130,11 @@ namespace gazebo
       /// \param[in] _point Point to add.
       public: inline void Add(const QPointF &_point)
               {
-                this->d_samples += _point;
+                this->levels[0].push_back(_point);
+                if (this->levels[0].size() > kLevelSize)
+                  this->Decimate(0);
 
-                if (this->d_samples.size() > maxSampleSize)
-                {
-                  // remove sample window
-                  // update bounding rect?
-                  this->d_samples.remove(0, windowSize);
-                }
-
-                if (this->d_samples.size() == 1)
+                if (this->size() == 1)
                 {
                   // init bounding rect
                   this->d_boundingRect.setTopLeft(_point);
@@ -110,8 +156,8 @@ namespace gazebo
       /// \brief Clear the sample data.
       public: void Clear()
               {
-                this->d_samples.clear();
-                this->d_samples.squeeze();
+                for (auto &level : this->levels)
+                  level.clear();
                 this->d_boundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
               }
 
@@ -119,14 +165,53 @@ namespace gazebo
       /// \return A vector of same points.
       public: QVector<QPointF> Samples() const
               {
-                return this->d_samples;
+                QVector<QPointF> samples;
+                samples.reserve(static_cast<int>(this->size()));
+                for (auto level = this->levels.rbegin();
+                     level != this->levels.rend(); ++level)
+                {
+                  for (auto const &point : *level)
+                    samples.append(point);
+                }
+                return samples;
               }
 
-      /// \brief maxium sample size of this curve.
-      private: int maxSampleSize = 11000;
+      /// \brief Move the oldest points of a level to the next one. The
+      /// oldest points of the last level are dropped.
+      /// \param[in] _level Index of the level.
+      private: void Decimate(const std::size_t _level)
+              {
+                std::deque<QPointF> &level = this->levels[_level];
+                const std::size_t count = std::min(kChunkSize, level.size());
+                const bool last = _level + 1 >= this->levels.size();
+
+                for (std::size_t i = 0; i < count && !last; i += kDecimation)
+                {
+                  const std::size_t end = std::min(i + kDecimation, count);
+                  std::size_t minIndex = i;
+                  std::size_t maxIndex = i;
+                  for (std::size_t j = i + 1; j < end; ++j)
+                  {
+                    if (level[j].y() < level[minIndex].y())
+                      minIndex = j;
+                    if (level[j].y() > level[maxIndex].y())
+                      maxIndex = j;
+                  }
+
+                  // In the order of the points
+                  std::deque<QPointF> &next = this->levels[_level + 1];
+                  next.push_back(level[std::min(minIndex, maxIndex)]);
+                  if (minIndex != maxIndex)
+                    next.push_back(level[std::max(minIndex, maxIndex)]);
+                }
+                level.erase(level.begin(), level.begin() + count);
+
+                if (!last && this->levels[_level + 1].size() > kLevelSize)
+                  this->Decimate(_level + 1);
+              }
 
-      /// \brief Size of samples to remove when maxSampleSize is reached.
-      private: int windowSize = 1000;
+      /// \brief Points of each level, from the newest to the coarsest.
+      private: std::vector<std::deque<QPointF>> levels;
     };
 
 
@@ -235,6 +320,10 @@ PlotCurve::PlotCurve(const std::string &_label)
   curve->setSymbol(new QwtSymbol(QwtSymbol::Ellipse,
         Qt::NoBrush, QPen(penColor), QSize(2, 2)));
 
+  // Only paint the points that fall on different pixels of the canvas
+  curve->setPaintAttribute(QwtPlotCurve::FilterPoints, true);
+  curve->setPaintAttribute(QwtPlotCurve::ClipPolygons, true);
+
   this->dataPtr->curveData =
       static_cast<CurveData *>(this->dataPtr->curve->data());
   GZ_ASSERT(this->dataPtr->curveData != nullptr, "Curve data is nullptr");
@@ -342,7 +431,7 @@ void PlotCurve::SetAge(const unsigned int _age)
 /////////////////////////////////////////////////
 unsigned int PlotCurve::Size() const
 {
-  return static_cast<unsigned int>(this->dataPtr->curveData->samples().size());
+  return static_cast<unsigned int>(this->dataPtr->curveData->size());
 }
 
 /////////////////////////////////////////////////
@@ -363,13 +452,13 @@ ignition::math::Vector2d PlotCurve::Max()
 ignition::math::Vector2d PlotCurve::Point(const unsigned int _index) const
 {
   if (_index >= static_cast<unsigned int>(
-      this->dataPtr->curveData->samples().size()))
+      this->dataPtr->curveData->size()))
   {
     return ignition::math::Vector2d(ignition::math::NAN_D,
         ignition::math::NAN_D);
   }
 
-  const QPointF &pt = this->dataPtr->curveData->samples()[_index];
+  const QPointF pt = this->dataPtr->curveData->sample(_index);
   return ignition::math::Vector2d(pt.x(), pt.y());
 }
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
 
 #include "gazebo/gui/plot/PlottingTypes.hh"
 #include "gazebo/gui/plot/PlotCurve.hh"
@@ -133,5 +135,46 @@ void PlotCurve_TEST::AddPoint()
   delete plotCurve;
 }
 
+/////////////////////////////////////////////////
+void PlotCurve_TEST::Decimation()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty.world");
+
+  gazebo::gui::PlotCurve *plotCurve = new gazebo::gui::PlotCurve("curve01");
+  QVERIFY(plotCurve != nullptr);
+
+  // Add more points than are kept, with a single spike in the old points
+  const unsigned int ptSize = 200000;
+  for (unsigned int i = 0; i < ptSize; ++i)
+  {
+    plotCurve->AddPoint(ignition::math::Vector2d(i * 0.001,
+        i == 1234 ? 100.0 : std::sin(i * 0.01)));
+  }
+  QVERIFY(plotCurve->Size() < ptSize);
+
+  // The history starts at the first point and ends at the last one
+  QCOMPARE(plotCurve->Point(0).X(), 0.0);
+  QCOMPARE(plotCurve->Point(plotCurve->Size() - 1),
+      ignition::math::Vector2d((ptSize - 1) * 0.001,
+      std::sin((ptSize - 1) * 0.01)));
+
+  // The points are in order, and the spike is kept
+  double maxY = 0;
+  for (unsigned int i = 1; i < plotCurve->Size(); ++i)
+  {
+    QVERIFY(plotCurve->Point(i).X() > plotCurve->Point(i - 1).X());
+    maxY = std::max(maxY, plotCurve->Point(i).Y());
+  }
+  QCOMPARE(maxY, 100.0);
+
+  plotCurve->Clear();
+  QCOMPARE(plotCurve->Size(), 0u);
+
+  delete plotCurve;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(PlotCurve_TEST)
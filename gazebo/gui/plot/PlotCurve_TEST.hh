@@ -32,5 +32,8 @@ class PlotCurve_TEST : public QTestFixture
 
   /// \brief Test adding points to the curve
   private slots: void AddPoint();
+
+  /// \brief Test that old points are decimated and keep their envelope
+  private slots: void Decimation();
 };
 #endif
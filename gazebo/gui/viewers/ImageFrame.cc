@@ -15,7 +15,13 @@
  *
  */
 
+#include <cmath>
+#include <cstring>
+
+#include <boost/make_shared.hpp>
+
 #include "gazebo/common/Image.hh"
+#include "gazebo/common/PixelConvert.hh"
 #include "gazebo/gui/viewers/ImageFramePrivate.hh"
 #include "gazebo/gui/viewers/ImageFrame.hh"
 
@@ -41,7 +47,21 @@ ImageFrame::~ImageFrame()
 /////////////////////////////////////////////////
 void ImageFrame::paintEvent(QPaintEvent * /*_event*/)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  // Take the latest image, the transport thread may replace it meanwhile
+  boost::shared_ptr<const void> owner;
+  const msgs::Image *msg = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    owner.swap(this->dataPtr->pendingOwner);
+    msg = this->dataPtr->pending;
+    this->dataPtr->pending = nullptr;
+    this->dataPtr->updateRequested = false;
+  }
+
+  // Images are only converted when they are shown
+  if (msg)
+    this->ConvertImage(*msg);
+
   QPainter painter(this);
 
   if (!this->dataPtr->image.isNull())
@@ -67,7 +87,55 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
   if (_msg.width() == 0 || _msg.height() == 0)
     return;
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto msg = boost::make_shared<msgs::Image>(_msg);
+  this->SetImage(msg, *msg);
+}
+
+/////////////////////////////////////////////////
+void ImageFrame::OnImage(ConstImageStampedPtr &_msg)
+{
+  if (_msg->image().width() == 0 || _msg->image().height() == 0)
+    return;
+
+  this->SetImage(_msg, _msg->image());
+}
+
+/////////////////////////////////////////////////
+void ImageFrame::OnImage(ConstImagesStampedPtr &_msg, const int _index)
+{
+  if (_index < 0 || _index >= _msg->image_size() ||
+      _msg->image(_index).width() == 0 || _msg->image(_index).height() == 0)
+  {
+    return;
+  }
+
+  this->SetImage(_msg, _msg->image(_index));
+}
+
+/////////////////////////////////////////////////
+void ImageFrame::SetImage(const boost::shared_ptr<const void> &_owner,
+    const msgs::Image &_msg)
+{
+  bool request = false;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+    // Only the latest image is kept
+    this->dataPtr->pendingOwner = _owner;
+    this->dataPtr->pending = &_msg;
+    request = !this->dataPtr->updateRequested;
+    this->dataPtr->updateRequested = true;
+  }
+
+  // Repaints are requested once per painted frame, so the frame is
+  // converted and drawn at most at the rate of the screen
+  if (request)
+    QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+}
+
+/////////////////////////////////////////////////
+void ImageFrame::ConvertImage(const msgs::Image &_msg)
+{
   QImage::Format qFormat;
   bool isDepthImage = false;
   switch (_msg.pixel_format())
@@ -113,7 +181,18 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
 
     if (!this->dataPtr->depthBuffer)
       this->dataPtr->depthBuffer = new float[depthSamples];
-    memcpy(this->dataPtr->depthBuffer, _msg.data().c_str(), depthBufferSize);
+
+    if (_msg.pixel_format() == common::Image::PixelFormat::R_FLOAT16)
+    {
+      common::HalfToFloat(
+          reinterpret_cast<const uint16_t *>(_msg.data().c_str()),
+          this->dataPtr->depthBuffer, depthSamples);
+    }
+    else
+    {
+      memcpy(this->dataPtr->depthBuffer, _msg.data().c_str(),
+          depthBufferSize);
+    }
 
     float maxDepth = 0;
     for (unsigned int i = 0; i < _msg.height() * _msg.width(); ++i)
@@ -128,12 +207,13 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
     double factor = 255 / maxDepth;
     for (unsigned int j = 0; j < _msg.height(); ++j)
     {
+      uchar *line = this->dataPtr->image.scanLine(j);
       for (unsigned int i = 0; i < _msg.width(); ++i)
       {
         float d = this->dataPtr->depthBuffer[idx++];
         d = 255 - (d * factor);
-        QRgb value = qRgb(d, d, d);
-        this->dataPtr->image.setPixel(i, j, value);
+        line[0] = line[1] = line[2] = static_cast<uchar>(static_cast<int>(d));
+        line += 3;
       }
     }
   }
@@ -159,6 +239,7 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
     unsigned int width = _msg.width()*channels;
     for (unsigned int j = 0; j < _msg.height(); ++j)
     {
+      uchar *line = this->dataPtr->image.scanLine(j);
       for (unsigned int i = 0; i < width; i+=channels)
       {
         u = uint16Buffer[j*width + i] * factor;
@@ -169,8 +250,10 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
         {
           rgb[k] = uint16Buffer[j*width + i + k] * factor;
         }
-        QRgb value = qRgb(rgb[0], rgb[1], rgb[2]);
-        this->dataPtr->image.setPixel(i/channels, j, value);
+        line[0] = static_cast<uchar>(rgb[0]);
+        line[1] = static_cast<uchar>(rgb[1]);
+        line[2] = static_cast<uchar>(rgb[2]);
+        line += 3;
       }
     }
   }
@@ -184,5 +267,4 @@ void ImageFrame::OnImage(const msgs::Image &_msg)
           this->dataPtr->image.bytesPerLine());
     }
   }
-  this->update();
 }
@@ -19,6 +19,8 @@
 
 #include <memory>
 
+#include <boost/shared_ptr.hpp>
+
 #include "gazebo/gui/qt.h"
 #include "gazebo/msgs/msgs.hh"
 
@@ -40,14 +42,36 @@ namespace gazebo
       /// \brief Destructor
       public: virtual ~ImageFrame();
 
-      /// \brief Receives incoming image messages.
+      /// \brief Receives incoming image messages. The message is copied.
       /// \param[in] _msg New image message.
       public: void OnImage(const msgs::Image &_msg);
 
+      /// \brief Receives incoming image messages. The message is kept
+      /// until it is painted, without a copy.
+      /// \param[in] _msg New image message.
+      public: void OnImage(ConstImageStampedPtr &_msg);
+
+      /// \brief Receives an image of incoming images messages. The message
+      /// is kept until it is painted, without a copy.
+      /// \param[in] _msg New images message.
+      /// \param[in] _index Index of the image in the message.
+      public: void OnImage(ConstImagesStampedPtr &_msg, const int _index);
+
       /// \brief Event used to paint the image.
       /// \param[in] _event Pointer to the event information.
       protected: void paintEvent(QPaintEvent *_event);
 
+      /// \brief Keep the latest image, and request a repaint if none is
+      /// pending. Older images that were not painted are dropped.
+      /// \param[in] _owner Message that holds the image.
+      /// \param[in] _msg The image.
+      private: void SetImage(const boost::shared_ptr<const void> &_owner,
+                             const msgs::Image &_msg);
+
+      /// \brief Convert an image to the image that is drawn.
+      /// \param[in] _msg The image.
+      private: void ConvertImage(const msgs::Image &_msg);
+
       /// \brief Pointer to private data
       private: std::unique_ptr<ImageFramePrivate> dataPtr;
     };
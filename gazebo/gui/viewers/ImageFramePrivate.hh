@@ -18,7 +18,10 @@
 #define GAZEBO_GUI_VIEWERS_IMAGEFRAMEPRIVATE_HH_
 
 #include <mutex>
+#include <boost/shared_ptr.hpp>
+
 #include "gazebo/gui/qt.h"
+#include "gazebo/msgs/msgs.hh"
 
 namespace gazebo
 {
@@ -29,9 +32,18 @@ namespace gazebo
       /// \brief The image to draw.
       public: QImage image;
 
-      /// \brief Mutex for protecting the image.
+      /// \brief Mutex for protecting the pending image.
       public: std::mutex mutex;
 
+      /// \brief Latest image received and not painted yet, null if none.
+      public: const msgs::Image *pending = nullptr;
+
+      /// \brief Message that holds the pending image.
+      public: boost::shared_ptr<const void> pendingOwner;
+
+      /// \brief True if a repaint was requested and didn't happen yet.
+      public: bool updateRequested = false;
+
       /// \brief Depth camera image data buffer.
       public: float *depthBuffer = nullptr;
 
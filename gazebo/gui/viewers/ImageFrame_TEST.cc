@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <memory>
+#include <string>
+
+#include <boost/make_shared.hpp>
+
+#include "gazebo/common/Image.hh"
+#include "gazebo/gui/viewers/ImageFrame.hh"
+#include "gazebo/gui/viewers/ImageFrame_TEST.hh"
+
+/////////////////////////////////////////////////
+/// \brief Fill an image of one color.
+/// \param[out] _msg The image.
+/// \param[in] _color Color of the image.
+static void fillImage(gazebo::msgs::Image &_msg, const QColor &_color)
+{
+  const unsigned int size = 4;
+  _msg.set_width(size);
+  _msg.set_height(size);
+  _msg.set_step(size * 3);
+  _msg.set_pixel_format(gazebo::common::Image::RGB_INT8);
+
+  std::string data;
+  for (unsigned int i = 0; i < size * size; ++i)
+  {
+    data += static_cast<char>(_color.red());
+    data += static_cast<char>(_color.green());
+    data += static_cast<char>(_color.blue());
+  }
+  _msg.set_data(data);
+}
+
+/////////////////////////////////////////////////
+/// \brief Make an image message of one color.
+/// \param[in] _color Color of the image.
+/// \return The message.
+static ConstImageStampedPtr imageMsg(const QColor &_color)
+{
+  auto msg = boost::make_shared<gazebo::msgs::ImageStamped>();
+  fillImage(*msg->mutable_image(), _color);
+  return msg;
+}
+
+/////////////////////////////////////////////////
+void ImageFrame_TEST::Latest()
+{
+  std::unique_ptr<gazebo::gui::ImageFrame> frame(
+      new gazebo::gui::ImageFrame(nullptr));
+  frame->resize(40, 40);
+
+  // Images that are replaced before a repaint are released unconverted
+  ConstImageStampedPtr red = imageMsg(Qt::red);
+  ConstImageStampedPtr blue = imageMsg(Qt::blue);
+  frame->OnImage(red);
+  QVERIFY(red.use_count() > 1);
+  frame->OnImage(blue);
+  QCOMPARE(red.use_count(), 1L);
+  QVERIFY(blue.use_count() > 1);
+
+  // The latest image is painted, and released once it is converted
+  QImage image = frame->grab().toImage();
+  QCOMPARE(image.pixelColor(20, 20), QColor(Qt::blue));
+  QCOMPARE(blue.use_count(), 1L);
+
+  // The converted image is painted again until another image comes in
+  QCoreApplication::processEvents();
+  image = frame->grab().toImage();
+  QCOMPARE(image.pixelColor(20, 20), QColor(Qt::blue));
+
+  // Copied images are painted too
+  gazebo::msgs::Image green;
+  fillImage(green, Qt::green);
+  frame->OnImage(green);
+  image = frame->grab().toImage();
+  QCOMPARE(image.pixelColor(20, 20), QColor(Qt::green));
+}
+
+/////////////////////////////////////////////////
+void ImageFrame_TEST::ImagesMessage()
+{
+  std::unique_ptr<gazebo::gui::ImageFrame> frame(
+      new gazebo::gui::ImageFrame(nullptr));
+  frame->resize(40, 40);
+
+  auto msg = boost::make_shared<gazebo::msgs::ImagesStamped>();
+  fillImage(*msg->add_image(), Qt::red);
+  fillImage(*msg->add_image(), Qt::green);
+  ConstImagesStampedPtr images = msg;
+
+  // Indices out of range are ignored
+  frame->OnImage(images, 2);
+  QCOMPARE(images.use_count(), 1L);
+  frame->OnImage(images, -1);
+  QCOMPARE(images.use_count(), 1L);
+
+  frame->OnImage(images, 1);
+  QImage image = frame->grab().toImage();
+  QCOMPARE(image.pixelColor(20, 20), QColor(Qt::green));
+  QCOMPARE(images.use_count(), 1L);
+}
+
+/////////////////////////////////////////////////
+void ImageFrame_TEST::Depth()
+{
+  std::unique_ptr<gazebo::gui::ImageFrame> frame(
+      new gazebo::gui::ImageFrame(nullptr));
+  frame->resize(40, 20);
+
+  // The farthest depth is black, and nearer depths are lighter
+  auto msg = boost::make_shared<gazebo::msgs::ImageStamped>();
+  gazebo::msgs::Image *depth = msg->mutable_image();
+  const float data[2] = {1.0f, 2.0f};
+  depth->set_width(2);
+  depth->set_height(1);
+  depth->set_step(sizeof(data));
+  depth->set_pixel_format(gazebo::common::Image::R_FLOAT32);
+  depth->set_data(std::string(reinterpret_cast<const char *>(data),
+      sizeof(data)));
+  ConstImageStampedPtr depthMsg = msg;
+
+  frame->OnImage(depthMsg);
+  QImage image = frame->grab().toImage();
+  QCOMPARE(image.pixelColor(10, 10), QColor(127, 127, 127));
+  QCOMPARE(image.pixelColor(30, 10), QColor(0, 0, 0));
+}
+
+// Generate a main function for the test
+QTEST_MAIN(ImageFrame_TEST)
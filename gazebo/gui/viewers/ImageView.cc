@@ -71,5 +71,5 @@ void ImageView::OnImage(ConstImageStampedPtr &_msg)
   // Update the Hz and Bandwidth info
   this->OnMsg(msgs::Convert(_msg->time()), _msg->image().data().size());
 
-  this->dataPtr->imageFrame->OnImage(_msg->image());
+  this->dataPtr->imageFrame->OnImage(_msg);
 }
@@ -51,6 +51,33 @@ namespace gazebo
       return request;
     }
 
+    /////////////////////////////////////////////
+    msgs::Request *CreateDeleteRequest(const std::vector<std::string> &_names)
+    {
+      msgs::GzString_V names;
+      for (auto const &name : _names)
+        names.add_data(name);
+
+      return CreateRequest("entities_delete", names.SerializeAsString());
+    }
+
+    /////////////////////////////////////////////
+    std::vector<std::string> DeletedEntities(const msgs::Request &_msg)
+    {
+      std::vector<std::string> result;
+      if (_msg.request() == "entity_delete")
+      {
+        result.push_back(_msg.data());
+      }
+      else if (_msg.request() == "entities_delete")
+      {
+        msgs::GzString_V names;
+        if (names.ParseFromString(_msg.data()))
+          result.assign(names.data().begin(), names.data().end());
+      }
+      return result;
+    }
+
     /////////////////////////////////////////////
     const google::protobuf::FieldDescriptor *GetFD(
         google::protobuf::Message &message, const std::string &name)
@@ -1058,6 +1085,10 @@ namespace gazebo
           meta->set_layer(metaElem->Get<int32_t>("layer"));
       }
 
+      // Custom element that disables the levels of detail of the mesh
+      if (_sdf->HasElement("gz:lod"))
+        result.set_lod(_sdf->Get<bool>("gz:lod"));
+
       // Load the geometry
       if (_sdf->HasElement("geometry"))
       {
@@ -18,6 +18,7 @@
 #define GAZEBO_MSGS_MSGS_HH_
 
 #include <string>
+#include <vector>
 
 #include <sdf/sdf.hh>
 
@@ -56,6 +57,21 @@ namespace gazebo
     msgs::Request *CreateRequest(const std::string &_request,
                                  const std::string &_data = "");
 
+    /// \brief Create a request that deletes several entities at once. Its
+    /// request string is "entities_delete", and its data is a serialized
+    /// GzString_V of the scoped names of the entities.
+    /// \param[in] _names Scoped names of the entities.
+    /// \return A Request message
+    GAZEBO_VISIBLE
+    msgs::Request *CreateDeleteRequest(const std::vector<std::string> &_names);
+
+    /// \brief Get the names of the entities deleted by an "entity_delete"
+    /// or an "entities_delete" request.
+    /// \param[in] _msg The request.
+    /// \return Names of the deleted entities, empty for other requests.
+    GAZEBO_VISIBLE
+    std::vector<std::string> DeletedEntities(const msgs::Request &_msg);
+
     /// \brief Initialize a message
     /// \param[in] _message Message to initialize
     /// \param[in] _id Optional string id
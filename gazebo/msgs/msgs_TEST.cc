@@ -68,6 +68,23 @@ TEST_F(MsgsTest, Request)
   EXPECT_GT(request->id(), 0);
 }
 
+TEST_F(MsgsTest, DeleteRequest)
+{
+  msgs::Request *request = msgs::CreateDeleteRequest({"box", "sun"});
+  EXPECT_EQ("entities_delete", request->request());
+  EXPECT_EQ(msgs::DeletedEntities(*request),
+      std::vector<std::string>({"box", "sun"}));
+  delete request;
+
+  request = msgs::CreateRequest("entity_delete", "box");
+  EXPECT_EQ(msgs::DeletedEntities(*request), std::vector<std::string>({"box"}));
+  delete request;
+
+  request = msgs::CreateRequest("entity_info", "box");
+  EXPECT_TRUE(msgs::DeletedEntities(*request).empty());
+  delete request;
+}
+
 TEST_F(MsgsTest, Time)
 {
   common::Time t = common::Time::GetWallTime();
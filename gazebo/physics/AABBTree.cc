@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/AABBTree.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Node of the tree. Leaves hold the proxies, the other nodes
+    /// always have two children.
+    class AABBTreeNode
+    {
+      /// \brief True if the node is a leaf.
+      /// \return True for a leaf.
+      public: bool IsLeaf() const
+              {
+                return this->child1 < 0;
+              }
+
+      /// \brief Smallest corner of the box.
+      public: ignition::math::Vector3d min;
+
+      /// \brief Largest corner of the box.
+      public: ignition::math::Vector3d max;
+
+      /// \brief Parent node, or the next free node of a free node.
+      public: int parent = -1;
+
+      /// \brief First child, -1 for a leaf.
+      public: int child1 = -1;
+
+      /// \brief Second child, -1 for a leaf.
+      public: int child2 = -1;
+
+      /// \brief Height of the node, 0 for a leaf and -1 for a free node.
+      public: int height = -1;
+
+      /// \brief Data of a leaf.
+      public: unsigned int data = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for AABBTree
+    class AABBTreePrivate
+    {
+      /// \brief Get a free node.
+      /// \return Index of the node.
+      public: int Allocate()
+              {
+                if (this->freeList < 0)
+                {
+                  this->nodes.emplace_back();
+                  this->freeList = static_cast<int>(this->nodes.size()) - 1;
+                  this->nodes.back().parent = -1;
+                }
+
+                const int index = this->freeList;
+                AABBTreeNode &node = this->nodes[index];
+                this->freeList = node.parent;
+                node.parent = -1;
+                node.child1 = -1;
+                node.child2 = -1;
+                node.height = 0;
+                return index;
+              }
+
+      /// \brief Put a node back on the free list.
+      /// \param[in] _index Index of the node.
+      public: void Free(const int _index)
+              {
+                this->nodes[_index].parent = this->freeList;
+                this->nodes[_index].height = -1;
+                this->freeList = _index;
+              }
+
+      /// \brief Surface area of the union of two nodes.
+      /// \param[in] _a First node.
+      /// \param[in] _b Second node.
+      /// \return Surface area.
+      public: static double MergedArea(const AABBTreeNode &_a,
+                                       const AABBTreeNode &_b)
+              {
+                ignition::math::Vector3d min = _a.min;
+                min.Min(_b.min);
+                ignition::math::Vector3d max = _a.max;
+                max.Max(_b.max);
+                return Area(min, max);
+              }
+
+      /// \brief Surface area of a box.
+      /// \param[in] _min Smallest corner.
+      /// \param[in] _max Largest corner.
+      /// \return Surface area.
+      public: static double Area(const ignition::math::Vector3d &_min,
+                                 const ignition::math::Vector3d &_max)
+              {
+                const ignition::math::Vector3d d = _max - _min;
+                return 2.0 * (d.X() * d.Y() + d.Y() * d.Z() + d.Z() * d.X());
+              }
+
+      /// \brief Set the box and height of a node from its children.
+      /// \param[in] _index Index of the node.
+      public: void Refit(const int _index)
+              {
+                AABBTreeNode &node = this->nodes[_index];
+                const AABBTreeNode &c1 = this->nodes[node.child1];
+                const AABBTreeNode &c2 = this->nodes[node.child2];
+                node.min = c1.min;
+                node.min.Min(c2.min);
+                node.max = c1.max;
+                node.max.Max(c2.max);
+                node.height = 1 + std::max(c1.height, c2.height);
+              }
+
+      /// \brief Insert a leaf, next to the sibling that grows the surface
+      /// area of the tree the least.
+      /// \param[in] _leaf Index of the leaf.
+      public: void InsertLeaf(const int _leaf);
+
+      /// \brief Remove a leaf.
+      /// \param[in] _leaf Index of the leaf.
+      public: void RemoveLeaf(const int _leaf);
+
+      /// \brief Rotate a node if its children are unbalanced.
+      /// \param[in] _index Index of the node.
+      /// \return Index of the node that replaced it.
+      public: int Balance(const int _index);
+
+      /// \brief The nodes, including the free ones.
+      public: std::vector<AABBTreeNode> nodes;
+
+      /// \brief Root node, -1 if the tree is empty.
+      public: int root = -1;
+
+      /// \brief First free node, -1 if there is none.
+      public: int freeList = -1;
+
+      /// \brief Number of leaves.
+      public: unsigned int leafCount = 0;
+
+      /// \brief Distance by which the boxes are enlarged.
+      public: double margin = 0.1;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+void AABBTreePrivate::InsertLeaf(const int _leaf)
+{
+  if (this->root < 0)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = -1;
+    return;
+  }
+
+  // Walk down while descending is cheaper than pairing with the node
+  const AABBTreeNode &leaf = this->nodes[_leaf];
+  int index = this->root;
+  while (!this->nodes[index].IsLeaf())
+  {
+    const AABBTreeNode &node = this->nodes[index];
+    const double area = Area(node.min, node.max);
+    const double combinedArea = MergedArea(node, leaf);
+
+    // Cost of a new parent for this node and the leaf, and the cost that
+    // is added to the nodes below when the leaf goes further down.
+    const double cost = 2.0 * combinedArea;
+    const double inheritance = 2.0 * (combinedArea - area);
+
+    double childCost[2];
+    const int children[2] = {node.child1, node.child2};
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      const AABBTreeNode &child = this->nodes[children[i]];
+      childCost[i] = MergedArea(child, leaf) + inheritance;
+      if (!child.IsLeaf())
+        childCost[i] -= Area(child.min, child.max);
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+
+    index = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+
+  const int sibling = index;
+  const int oldParent = this->nodes[sibling].parent;
+  const int newParent = this->Allocate();
+  this->nodes[newParent].parent = oldParent;
+  this->nodes[newParent].child1 = sibling;
+  this->nodes[newParent].child2 = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+  this->Refit(newParent);
+
+  if (oldParent < 0)
+    this->root = newParent;
+  else if (this->nodes[oldParent].child1 == sibling)
+    this->nodes[oldParent].child1 = newParent;
+  else
+    this->nodes[oldParent].child2 = newParent;
+
+  for (index = this->nodes[_leaf].parent; index >= 0;
+       index = this->nodes[index].parent)
+  {
+    index = this->Balance(index);
+    this->Refit(index);
+  }
+}
+
+/////////////////////////////////////////////////
+void AABBTreePrivate::RemoveLeaf(const int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = -1;
+    return;
+  }
+
+  const int parent = this->nodes[_leaf].parent;
+  const int grandParent = this->nodes[parent].parent;
+  const int sibling = this->nodes[parent].child1 == _leaf ?
+      this->nodes[parent].child2 : this->nodes[parent].child1;
+
+  this->Free(parent);
+  this->nodes[sibling].parent = grandParent;
+  if (grandParent < 0)
+  {
+    this->root = sibling;
+    return;
+  }
+
+  if (this->nodes[grandParent].child1 == parent)
+    this->nodes[grandParent].child1 = sibling;
+  else
+    this->nodes[grandParent].child2 = sibling;
+
+  for (int index = grandParent; index >= 0;
+       index = this->nodes[index].parent)
+  {
+    index = this->Balance(index);
+    this->Refit(index);
+  }
+}
+
+/////////////////////////////////////////////////
+int AABBTreePrivate::Balance(const int _index)
+{
+  AABBTreeNode &a = this->nodes[_index];
+  if (a.IsLeaf() || a.height < 2)
+    return _index;
+
+  const int b = a.child1;
+  const int c = a.child2;
+  const int balance = this->nodes[c].height - this->nodes[b].height;
+  if (balance >= -1 && balance <= 1)
+    return _index;
+
+  // Move the taller child up, and give its shorter grandchild to _index
+  const int up = balance > 1 ? c : b;
+  const int stay = balance > 1 ? b : c;
+  AABBTreeNode &upNode = this->nodes[up];
+  const int g1 = upNode.child1;
+  const int g2 = upNode.child2;
+
+  upNode.child1 = _index;
+  upNode.parent = a.parent;
+  a.parent = up;
+
+  if (upNode.parent < 0)
+    this->root = up;
+  else if (this->nodes[upNode.parent].child1 == _index)
+    this->nodes[upNode.parent].child1 = up;
+  else
+    this->nodes[upNode.parent].child2 = up;
+
+  const bool firstTaller = this->nodes[g1].height > this->nodes[g2].height;
+  const int keep = firstTaller ? g1 : g2;
+  const int give = firstTaller ? g2 : g1;
+  upNode.child2 = keep;
+  a.child1 = stay;
+  a.child2 = give;
+  this->nodes[give].parent = _index;
+
+  this->Refit(_index);
+  this->Refit(up);
+  return up;
+}
+
+/////////////////////////////////////////////////
+AABBTree::AABBTree(const double _margin)
+  : dataPtr(new AABBTreePrivate)
+{
+  this->dataPtr->margin = std::max(0.0, _margin);
+}
+
+/////////////////////////////////////////////////
+AABBTree::~AABBTree()
+{
+}
+
+/////////////////////////////////////////////////
+int AABBTree::Insert(const ignition::math::AxisAlignedBox &_box,
+    const unsigned int _data)
+{
+  const int proxy = this->dataPtr->Allocate();
+  AABBTreeNode &node = this->dataPtr->nodes[proxy];
+  const ignition::math::Vector3d margin(this->dataPtr->margin,
+      this->dataPtr->margin, this->dataPtr->margin);
+  node.min = _box.Min() - margin;
+  node.max = _box.Max() + margin;
+  node.data = _data;
+
+  this->dataPtr->InsertLeaf(proxy);
+  ++this->dataPtr->leafCount;
+  return proxy;
+}
+
+/////////////////////////////////////////////////
+void AABBTree::Remove(const int _proxy)
+{
+  GZ_ASSERT(_proxy >= 0 &&
+      _proxy < static_cast<int>(this->dataPtr->nodes.size()) &&
+      this->dataPtr->nodes[_proxy].height == 0, "Invalid proxy");
+
+  this->dataPtr->RemoveLeaf(_proxy);
+  this->dataPtr->Free(_proxy);
+  --this->dataPtr->leafCount;
+}
+
+/////////////////////////////////////////////////
+bool AABBTree::Update(const int _proxy,
+    const ignition::math::AxisAlignedBox &_box)
+{
+  GZ_ASSERT(_proxy >= 0 &&
+      _proxy < static_cast<int>(this->dataPtr->nodes.size()) &&
+      this->dataPtr->nodes[_proxy].height == 0, "Invalid proxy");
+
+  AABBTreeNode &node = this->dataPtr->nodes[_proxy];
+  const ignition::math::Vector3d &min = _box.Min();
+  const ignition::math::Vector3d &max = _box.Max();
+  if (node.min.X() <= min.X() && node.min.Y() <= min.Y() &&
+      node.min.Z() <= min.Z() && node.max.X() >= max.X() &&
+      node.max.Y() >= max.Y() && node.max.Z() >= max.Z())
+  {
+    return false;
+  }
+
+  this->dataPtr->RemoveLeaf(_proxy);
+
+  const ignition::math::Vector3d margin(this->dataPtr->margin,
+      this->dataPtr->margin, this->dataPtr->margin);
+  node.min = min - margin;
+  node.max = max + margin;
+  node.parent = -1;
+
+  this->dataPtr->InsertLeaf(_proxy);
+  return true;
+}
+
+/////////////////////////////////////////////////
+ignition::math::AxisAlignedBox AABBTree::FatBox(const int _proxy) const
+{
+  const AABBTreeNode &node = this->dataPtr->nodes[_proxy];
+  return ignition::math::AxisAlignedBox(node.min, node.max);
+}
+
+/////////////////////////////////////////////////
+void AABBTree::Query(const OverlapFunc &_overlaps,
+    const VisitFunc &_visit) const
+{
+  if (this->dataPtr->root < 0)
+    return;
+
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(this->dataPtr->root);
+  while (!stack.empty())
+  {
+    const AABBTreeNode &node = this->dataPtr->nodes[stack.back()];
+    stack.pop_back();
+
+    if (!_overlaps(ignition::math::AxisAlignedBox(node.min, node.max)))
+      continue;
+
+    if (node.IsLeaf())
+    {
+      _visit(node.data);
+    }
+    else
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void AABBTree::Clear()
+{
+  this->dataPtr->nodes.clear();
+  this->dataPtr->root = -1;
+  this->dataPtr->freeList = -1;
+  this->dataPtr->leafCount = 0;
+}
+
+/////////////////////////////////////////////////
+unsigned int AABBTree::Size() const
+{
+  return this->dataPtr->leafCount;
+}
+
+/////////////////////////////////////////////////
+int AABBTree::Height() const
+{
+  if (this->dataPtr->root < 0)
+    return -1;
+  return this->dataPtr->nodes[this->dataPtr->root].height;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_AABBTREE_HH_
+#define GAZEBO_PHYSICS_AABBTREE_HH_
+
+#include <functional>
+#include <memory>
+
+#include <ignition/math/AxisAlignedBox.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class AABBTreePrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class AABBTree AABBTree.hh physics/physics.hh
+    /// \brief Dynamic bounding volume tree of axis aligned boxes.
+    ///
+    /// Each box is stored enlarged by a margin, so that a box that moves
+    /// a little doesn't change the tree. The tree is kept balanced as boxes
+    /// are inserted and removed, and a query only visits the branches that
+    /// overlap the queried volume.
+    class GZ_PHYSICS_VISIBLE AABBTree
+    {
+      /// \brief Function that tells whether a box overlaps a volume. It
+      /// may return true for a box that is close to the volume, but must
+      /// not return false for a box that overlaps it.
+      public: using OverlapFunc =
+          std::function<bool (const ignition::math::AxisAlignedBox &)>;
+
+      /// \brief Function that is given the data of a proxy.
+      public: using VisitFunc = std::function<void (const unsigned int)>;
+
+      /// \brief Constructor
+      /// \param[in] _margin Distance by which the boxes are enlarged.
+      public: explicit AABBTree(const double _margin = 0.1);
+
+      /// \brief Destructor
+      public: virtual ~AABBTree();
+
+      /// \brief Add a box to the tree.
+      /// \param[in] _box The box, which must be finite.
+      /// \param[in] _data Data given back by Query().
+      /// \return Id of the new proxy.
+      public: int Insert(const ignition::math::AxisAlignedBox &_box,
+                         const unsigned int _data);
+
+      /// \brief Remove a box from the tree.
+      /// \param[in] _proxy Id returned by Insert().
+      public: void Remove(const int _proxy);
+
+      /// \brief Move a box. The tree only changes when the box leaves the
+      /// enlarged box of the proxy.
+      /// \param[in] _proxy Id returned by Insert().
+      /// \param[in] _box The new box, which must be finite.
+      /// \return True if the proxy was moved in the tree.
+      public: bool Update(const int _proxy,
+                          const ignition::math::AxisAlignedBox &_box);
+
+      /// \brief Get the enlarged box of a proxy.
+      /// \param[in] _proxy Id returned by Insert().
+      /// \return The enlarged box.
+      public: ignition::math::AxisAlignedBox FatBox(const int _proxy) const;
+
+      /// \brief Visit the proxies whose enlarged box overlaps a volume.
+      /// \param[in] _overlaps Tells whether a box overlaps the volume.
+      /// \param[in] _visit Called with the data of each proxy found.
+      public: void Query(const OverlapFunc &_overlaps,
+                         const VisitFunc &_visit) const;
+
+      /// \brief Remove all the boxes.
+      public: void Clear();
+
+      /// \brief Get the number of boxes in the tree.
+      /// \return Number of boxes.
+      public: unsigned int Size() const;
+
+      /// \brief Get the height of the tree.
+      /// \return Number of levels below the root, or -1 if the tree is
+      /// empty.
+      public: int Height() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<AABBTreePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include "gazebo/physics/AABBTree.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+class AABBTree_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Box of unit size at a position.
+ignition::math::AxisAlignedBox unitBox(const double _x, const double _y)
+{
+  return ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(_x, _y, 0),
+      ignition::math::Vector3d(_x + 1, _y + 1, 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(AABBTree_TEST, InsertQuery)
+{
+  physics::AABBTree tree(0.1);
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(-1, tree.Height());
+
+  // A row of shelf items, which would degenerate an unbalanced tree
+  std::vector<int> proxies;
+  for (unsigned int i = 0; i < 256; ++i)
+    proxies.push_back(tree.Insert(unitBox(i * 2.0, 0), i));
+  EXPECT_EQ(256u, tree.Size());
+  EXPECT_LE(tree.Height(), 16);
+
+  const ignition::math::AxisAlignedBox query(
+      ignition::math::Vector3d(8.5, -1, -1),
+      ignition::math::Vector3d(14.5, 1, 1));
+  auto overlaps = [&query](const ignition::math::AxisAlignedBox &_box)
+      {
+        return query.Intersects(_box);
+      };
+
+  std::set<unsigned int> found;
+  tree.Query(overlaps, [&found](const unsigned int _data)
+      {
+        found.insert(_data);
+      });
+  EXPECT_EQ(std::set<unsigned int>({4, 5, 6, 7}), found);
+
+  // Small moves stay inside the enlarged box
+  EXPECT_FALSE(tree.Update(proxies[5], unitBox(10.05, 0)));
+  EXPECT_TRUE(tree.Update(proxies[5], unitBox(100, 0)));
+  tree.Remove(proxies[6]);
+  EXPECT_EQ(255u, tree.Size());
+
+  found.clear();
+  tree.Query(overlaps, [&found](const unsigned int _data)
+      {
+        found.insert(_data);
+      });
+  EXPECT_EQ(std::set<unsigned int>({4, 7}), found);
+
+  const ignition::math::AxisAlignedBox fat = tree.FatBox(proxies[5]);
+  EXPECT_EQ(ignition::math::Vector3d(99.9, -0.1, -0.1), fat.Min());
+  EXPECT_EQ(ignition::math::Vector3d(101.1, 1.1, 1.1), fat.Max());
+
+  // Freed nodes are reused
+  for (unsigned int i = 0; i < 256; ++i)
+  {
+    if (i != 6)
+      tree.Remove(proxies[i]);
+  }
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(-1, tree.Height());
+  tree.Insert(unitBox(0, 0), 1);
+  tree.Clear();
+  EXPECT_EQ(0u, tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(AABBTree_TEST, MatchesBruteForce)
+{
+  physics::AABBTree tree(0.0);
+  std::vector<ignition::math::AxisAlignedBox> boxes;
+  std::vector<int> proxies;
+
+  // Deterministic pseudo random grid
+  unsigned int seed = 7;
+  auto next = [&seed]()
+      {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 16) % 1000) / 10.0;
+      };
+
+  for (unsigned int i = 0; i < 500; ++i)
+  {
+    boxes.push_back(unitBox(next(), next()));
+    proxies.push_back(tree.Insert(boxes.back(), i));
+  }
+  for (unsigned int i = 0; i < 500; i += 3)
+  {
+    boxes[i] = unitBox(next(), next());
+    tree.Update(proxies[i], boxes[i]);
+  }
+
+  for (unsigned int q = 0; q < 20; ++q)
+  {
+    const double x = next();
+    const double y = next();
+    const ignition::math::AxisAlignedBox query(
+        ignition::math::Vector3d(x, y, -1),
+        ignition::math::Vector3d(x + 10, y + 10, 2));
+
+    std::set<unsigned int> expected;
+    for (unsigned int i = 0; i < boxes.size(); ++i)
+    {
+      if (query.Intersects(boxes[i]))
+        expected.insert(i);
+    }
+
+    std::set<unsigned int> found;
+    tree.Query([&query](const ignition::math::AxisAlignedBox &_box)
+        {
+          return query.Intersects(_box);
+        },
+        [&found](const unsigned int _data)
+        {
+          found.insert(_data);
+        });
+    EXPECT_EQ(expected, found);
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,8 @@
 #include <sstream>
 #include <limits>
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 
 #include "gazebo/common/BVHLoader.hh"
 #include "gazebo/common/Console.hh"
@@ -54,12 +56,104 @@ class gazebo::physics::ActorPrivate
 
   /// \brief Last map associating skeleton nodes from skin and animation
   public: std::map<std::string, std::string> lastSkelMap;
+
+  /// \brief Skeleton animation sampled at a fixed rate.
+  public: class BakedTrack
+  {
+    /// \brief Interpolate the bone poses at a time.
+    /// \param[in] _time Time in the animation, which loops.
+    /// \param[out] _poses Pose of every bone relative to its parent.
+    public: void Sample(double _time,
+                std::vector<ignition::math::Pose3d> &_poses) const;
+
+    /// \brief Pose of every bone relative to its parent at every sample,
+    /// indexed by sample * bone count + bone handle.
+    public: std::vector<ignition::math::Pose3d> poses;
+
+    /// \brief Number of samples.
+    public: unsigned int sampleCount = 0;
+
+    /// \brief Length of the animation in seconds.
+    public: double length = 0;
+  };
+
+  /// \brief True if the skeleton animations are baked.
+  public: bool baked = false;
+
+  /// \brief Baked skeleton animations, indexed by name.
+  public: std::map<std::string, BakedTrack> bakedTracks;
+
+  /// \brief Bone handles, parents before their children.
+  public: std::vector<unsigned int> boneOrder;
+
+  /// \brief Handle of the parent of every bone, -1 for none.
+  public: std::vector<int> boneParents;
+
+  /// \brief Handle of the root bone.
+  public: unsigned int rootHandle = 0;
+
+  /// \brief Link of every bone.
+  public: std::vector<LinkPtr> boneLinks;
+
+  /// \brief Last baked bone poses.
+  public: std::vector<ignition::math::Pose3d> lastPoses;
+
+  /// \brief World transform of every bone, reused by every update.
+  public: std::vector<ignition::math::Matrix4d> boneWorld;
 };
 
 using namespace gazebo;
 using namespace physics;
 using namespace common;
 
+/// \brief Samples per second of the baked animations.
+static const double kBakeRate = 60.0;
+
+//////////////////////////////////////////////////
+/// \brief Write a pose as x, y, z, qw, qx, qy, qz.
+/// \param[in] _pose Pose to write.
+/// \param[out] _out The 7 values.
+static void writePose(const ignition::math::Pose3d &_pose, float *_out)
+{
+  _out[0] = static_cast<float>(_pose.Pos().X());
+  _out[1] = static_cast<float>(_pose.Pos().Y());
+  _out[2] = static_cast<float>(_pose.Pos().Z());
+  _out[3] = static_cast<float>(_pose.Rot().W());
+  _out[4] = static_cast<float>(_pose.Rot().X());
+  _out[5] = static_cast<float>(_pose.Rot().Y());
+  _out[6] = static_cast<float>(_pose.Rot().Z());
+}
+
+//////////////////////////////////////////////////
+void ActorPrivate::BakedTrack::Sample(double _time,
+    std::vector<ignition::math::Pose3d> &_poses) const
+{
+  if (this->sampleCount == 0)
+    return;
+
+  const unsigned int boneCount = this->poses.size() / this->sampleCount;
+  _poses.resize(boneCount);
+
+  // Loop like SkeletonAnimation::PoseAt
+  if (_time > this->length && this->length > 0)
+    _time -= std::floor(_time / this->length) * this->length;
+
+  const double sample = std::max(_time, 0.0) * kBakeRate;
+  const unsigned int first = std::min(static_cast<unsigned int>(sample),
+      this->sampleCount - 1);
+  const unsigned int second = std::min(first + 1, this->sampleCount - 1);
+  const double t = std::min(sample - first, 1.0);
+
+  const ignition::math::Pose3d *prev = &this->poses[first * boneCount];
+  const ignition::math::Pose3d *next = &this->poses[second * boneCount];
+  for (unsigned int i = 0; i < boneCount; ++i)
+  {
+    _poses[i].Pos() = prev[i].Pos() + (next[i].Pos() - prev[i].Pos()) * t;
+    _poses[i].Rot() = ignition::math::Quaterniond::Slerp(t, prev[i].Rot(),
+        next[i].Rot(), true);
+  }
+}
+
 //////////////////////////////////////////////////
 Actor::Actor(BasePtr _parent)
   : Model(_parent), dataPtr(new ActorPrivate)
@@ -68,6 +162,9 @@ Actor::Actor(BasePtr _parent)
   this->pathLength = 0.0;
   this->lastTraj = 1e+5;
   this->skinScale = 1.0;
+
+  const char *baked = getenv("GAZEBO_ACTOR_BAKED_ANIMATION");
+  this->dataPtr->baked = baked && std::string(baked) == "1";
 }
 
 //////////////////////////////////////////////////
@@ -649,6 +746,8 @@ void Actor::Init()
   if (this->autoStart)
     this->Play();
   this->mainLink = this->GetChildLink(this->GetName() + "_pose");
+  if (this->dataPtr->baked)
+    this->BakeAnimations();
 }
 
 //////////////////////////////////////////////////
@@ -674,10 +773,22 @@ bool Actor::IsActive() const
 void Actor::Update()
 {
   common::Time currentTime = this->world->SimTime();
+
+  // Keep the last animated pose
+  auto holdPose = [&]()
+  {
+    if (this->dataPtr->baked && !this->dataPtr->boneOrder.empty())
+      this->SetBakedPose(this->dataPtr->lastPoses, currentTime.Double());
+    else
+    {
+      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
+                    currentTime.Double());
+    }
+  };
+
   if (!this->active)
   {
-    this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                  currentTime.Double());
+    holdPose();
     return;
   }
 
@@ -698,8 +809,7 @@ void Actor::Update()
     // waiting for delayed start
     if (this->scriptTime < 0)
     {
-      this->SetPose(this->dataPtr->lastFrame, this->dataPtr->lastSkelMap,
-                    currentTime.Double());
+      holdPose();
       return;
     }
 
@@ -785,6 +895,38 @@ void Actor::Update()
 
   auto skelMap = this->skelNodesMap[tinfo->type];
 
+  auto baked = this->dataPtr->bakedTracks.find(tinfo->type);
+  if (this->dataPtr->baked && baked != this->dataPtr->bakedTracks.end())
+  {
+    const std::string rootName =
+        skelMap[this->skeleton->GetRootNode()->GetName()];
+
+    double time = this->scriptTime;
+    if (!this->customTrajectoryInfo && this->interpolateX[tinfo->type] &&
+        this->trajectories.find(tinfo->id) != this->trajectories.end())
+    {
+      time = skelAnim->TimeAtX(this->pathLength, rootName);
+    }
+
+    this->lastTraj = tinfo->id;
+
+    std::vector<ignition::math::Pose3d> &poses = this->dataPtr->lastPoses;
+    baked->second.Sample(time, poses);
+
+    const unsigned int root = this->dataPtr->rootHandle;
+    ignition::math::Matrix4d rootM = this->RootTransform(
+        ignition::math::Matrix4d(poses[root]), modelPose, *tinfo);
+    if (this->dataPtr->bvhFile)
+    {
+      rootM = this->dataPtr->translationAligner[rootName] * rootM *
+          this->dataPtr->rotationAligner[rootName];
+    }
+    poses[root] = rootM.Pose();
+
+    this->SetBakedPose(poses, currentTime.Double());
+    return;
+  }
+
   std::map<std::string, ignition::math::Matrix4d> frame;
   if (!this->customTrajectoryInfo)
   {
@@ -813,44 +955,8 @@ void Actor::Update()
     rootTrans = frame[skelMap[this->skeleton->GetRootNode()->GetName()]];
   }
 
-  ignition::math::Vector3d rootPos = rootTrans.Translation();
-  ignition::math::Quaterniond rootRot = rootTrans.Rotation();
-  // Zero root pos for BVH
-  if (this->dataPtr->bvhFile)
-  {
-    rootPos = ignition::math::Vector3d::Zero;
-  }
-
-  if (tinfo->translated)
-    rootPos.X() = 0.0;
-  ignition::math::Pose3d actorPose;
-
-  if (!this->customTrajectoryInfo)
-  {
-    actorPose.Pos() = modelPose.Pos() + modelPose.Rot().RotateVector(rootPos);
-    actorPose.Rot() = modelPose.Rot() * rootRot;
-  }
-  else
-  {
-    actorPose.Pos() = this->WorldPose().Pos();
-    actorPose.Rot() = this->WorldPose().Rot();
-  }
-
-  ignition::math::Matrix4d rootM(actorPose.Rot());
-
-  rootM.SetTranslation(actorPose.Pos());
-
-  // TODO: Possible bug here? Rotation changed after scaling. Maybe the
-  // rotation algorithm is not suppose to work on non unit quaternion.
-//    gzdbg << "before: " << rootM.Rotation() << std::endl;
-//    rootM.Scale(this->skinScale, this->skinScale, this->skinScale);
-//    auto scaleTrans = ignition::math::Matrix4d::Identity;
-//    scaleTrans.Scale(this->skinScale, this->skinScale, this->skinScale);
-//    rootM = scaleTrans * rootM;
-//    gzdbg << "after: " << rootM.Rotation() << std::endl;
-
-  // workaround for rotation bug
-  rootM.SetTranslation(rootM.Translation() * this->skinScale);
+  ignition::math::Matrix4d rootM =
+      this->RootTransform(rootTrans, modelPose, *tinfo);
 
   frame[skelMap[this->skeleton->GetRootNode()->GetName()]] = rootM;
 
@@ -977,6 +1083,240 @@ void Actor::SetPose(std::map<std::string, ignition::math::Matrix4d> _frame,
     this->SetWorldPose(mainLinkPose, true, false);
 }
 
+//////////////////////////////////////////////////
+void Actor::BakeAnimations()
+{
+  this->dataPtr->bakedTracks.clear();
+  this->dataPtr->boneOrder.clear();
+  if (!this->skeleton || !this->skeleton->GetRootNode())
+    return;
+
+  const unsigned int boneCount = this->skeleton->GetNumNodes();
+  this->dataPtr->rootHandle = this->skeleton->GetRootNode()->GetHandle();
+  this->dataPtr->boneParents.assign(boneCount, -1);
+  this->dataPtr->boneLinks.assign(boneCount, LinkPtr());
+  this->dataPtr->lastPoses.resize(boneCount);
+
+  std::vector<std::vector<unsigned int>> children(boneCount);
+  std::vector<unsigned int> order(1, this->dataPtr->rootHandle);
+  for (unsigned int i = 0; i < boneCount; ++i)
+  {
+    SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+    this->dataPtr->boneLinks[i] = this->GetChildLink(bone->GetName());
+    if (!this->dataPtr->boneLinks[i])
+    {
+      gzerr << "No link for bone [" << bone->GetName() << "] of actor ["
+            << this->GetName() << "], the animations won't be baked.\n";
+      return;
+    }
+
+    this->dataPtr->lastPoses[i] = bone->Transform().Pose();
+    if (bone->GetParent())
+    {
+      this->dataPtr->boneParents[i] = bone->GetParent()->GetHandle();
+      children[this->dataPtr->boneParents[i]].push_back(i);
+    }
+    else if (i != this->dataPtr->rootHandle)
+      order.push_back(i);
+  }
+
+  // Parents before their children, starting from the root
+  for (unsigned int i = 0; i < order.size(); ++i)
+  {
+    order.insert(order.end(), children[order[i]].begin(),
+        children[order[i]].end());
+  }
+
+  for (const auto &anim : this->skelAnimation)
+  {
+    if (!anim.second)
+      continue;
+
+    const std::map<std::string, std::string> &skelMap =
+        this->skelNodesMap[anim.first];
+
+    ActorPrivate::BakedTrack &track = this->dataPtr->bakedTracks[anim.first];
+    track.length = anim.second->GetLength();
+    track.sampleCount =
+        static_cast<unsigned int>(std::ceil(track.length * kBakeRate)) + 1;
+    track.poses.resize(track.sampleCount * boneCount);
+
+    for (unsigned int sample = 0; sample < track.sampleCount; ++sample)
+    {
+      auto frame = anim.second->PoseAt(
+          std::min(sample / kBakeRate, track.length));
+
+      for (unsigned int i = 0; i < boneCount; ++i)
+      {
+        SkeletonNode *bone = this->skeleton->GetNodeByHandle(i);
+        const bool isRoot = i == this->dataPtr->rootHandle;
+
+        // The same transform as SetPose, except for the root which is
+        // kept as animated and combined with the trajectory by Update
+        ignition::math::Matrix4d transform = isRoot ?
+            ignition::math::Matrix4d::Identity : bone->Transform();
+
+        auto node = skelMap.find(bone->GetName());
+        auto iter = node != skelMap.end() ? frame.find(node->second) :
+            frame.end();
+        if (iter != frame.end())
+        {
+          transform = iter->second;
+          if (this->dataPtr->bvhFile && !isRoot)
+          {
+            ignition::math::Vector3d bvhOffset = transform.Translation();
+            ignition::math::Vector3d daeOffset =
+                bone->Transform().Translation();
+            // scale bvh offset to dae link length
+            transform.SetTranslation(
+                daeOffset.Length() * bvhOffset.Normalize());
+
+            transform = this->dataPtr->translationAligner[node->second] *
+                transform * this->dataPtr->rotationAligner[node->second];
+          }
+        }
+
+        ignition::math::Pose3d pose = transform.Pose();
+        if (!pose.IsFinite())
+        {
+          gzerr << "ACTOR: " << anim.first << " " << sample / kBakeRate
+                << " " << bone->GetName() << " " << pose << "\n";
+          pose.Correct();
+        }
+        track.poses[sample * boneCount + i] = pose;
+      }
+    }
+  }
+
+  this->dataPtr->boneOrder = order;
+}
+
+//////////////////////////////////////////////////
+void Actor::SetBakedPose(const std::vector<ignition::math::Pose3d> &_poses,
+    const double _time)
+{
+  msgs::PoseAnimation msg;
+  msg.set_model_name(this->visualName);
+  msg.set_model_id(this->visualId);
+
+  const unsigned int boneCount = _poses.size();
+  const unsigned int root = this->dataPtr->rootHandle;
+
+  ignition::math::Pose3d rootPose = _poses[root];
+  if (!rootPose.IsFinite())
+  {
+    gzerr << "ACTOR: " << _time << " " << this->skeleton->GetRootNode()->
+        GetName() << " " << rootPose << "\n";
+    rootPose.Correct();
+  }
+
+  ignition::math::Pose3d mainLinkPose;
+  if (this->customTrajectoryInfo)
+  {
+    mainLinkPose.Pos() = this->worldPose.Pos();
+    mainLinkPose.Rot() = this->worldPose.Rot();
+  }
+  else
+    mainLinkPose = rootPose;
+
+  // Bones in the order of their handles, links in the order of boneOrder
+  msg.mutable_bone_pose()->Resize(boneCount * 7, 0.0f);
+  msg.mutable_link_id()->Resize(boneCount, 0);
+  msg.mutable_link_pose()->Resize(boneCount * 7, 0.0f);
+  float *bonePoses = msg.mutable_bone_pose()->mutable_data();
+  float *linkPoses = msg.mutable_link_pose()->mutable_data();
+
+  std::vector<ignition::math::Matrix4d> &boneWorld = this->dataPtr->boneWorld;
+  boneWorld.resize(boneCount);
+  for (unsigned int k = 0; k < boneCount; ++k)
+  {
+    const unsigned int i = this->dataPtr->boneOrder[k];
+    const int parent = this->dataPtr->boneParents[i];
+    const ignition::math::Pose3d &pose = i == root ? rootPose : _poses[i];
+
+    if (parent < 0)
+    {
+      boneWorld[i] = ignition::math::Matrix4d(pose);
+      writePose(ignition::math::Pose3d::Zero, bonePoses + i * 7);
+    }
+    else
+    {
+      boneWorld[i] = boneWorld[parent] * ignition::math::Matrix4d(pose);
+      writePose(pose, bonePoses + i * 7);
+    }
+
+    const LinkPtr &link = this->dataPtr->boneLinks[i];
+    const ignition::math::Pose3d linkWorldPose = boneWorld[i].Pose();
+    msg.set_link_id(k, link->GetId());
+    writePose(linkWorldPose - mainLinkPose, linkPoses + k * 7);
+    link->SetWorldPose(linkWorldPose, true, false);
+  }
+
+  msgs::Time *stamp = msg.add_time();
+  stamp->CopyFrom(msgs::Convert(_time));
+
+  msgs::Pose *model_pose = msg.add_pose();
+  model_pose->set_name(this->GetScopedName());
+  model_pose->set_id(this->GetId());
+  model_pose->mutable_position()->CopyFrom(msgs::Convert(mainLinkPose.Pos()));
+  model_pose->mutable_orientation()->CopyFrom(
+      msgs::Convert(mainLinkPose.Rot()));
+
+  if (this->bonePosePub && this->bonePosePub->HasConnections())
+    this->bonePosePub->Publish(msg);
+  if (!this->customTrajectoryInfo)
+    this->SetWorldPose(mainLinkPose, true, false);
+}
+
+//////////////////////////////////////////////////
+ignition::math::Matrix4d Actor::RootTransform(
+    const ignition::math::Matrix4d &_rootTrans,
+    const ignition::math::Pose3d &_modelPose,
+    const TrajectoryInfo &_tinfo) const
+{
+  ignition::math::Vector3d rootPos = _rootTrans.Translation();
+  ignition::math::Quaterniond rootRot = _rootTrans.Rotation();
+  // Zero root pos for BVH
+  if (this->dataPtr->bvhFile)
+  {
+    rootPos = ignition::math::Vector3d::Zero;
+  }
+
+  if (_tinfo.translated)
+    rootPos.X() = 0.0;
+  ignition::math::Pose3d actorPose;
+
+  if (!this->customTrajectoryInfo)
+  {
+    actorPose.Pos() = _modelPose.Pos() +
+        _modelPose.Rot().RotateVector(rootPos);
+    actorPose.Rot() = _modelPose.Rot() * rootRot;
+  }
+  else
+  {
+    actorPose.Pos() = this->WorldPose().Pos();
+    actorPose.Rot() = this->WorldPose().Rot();
+  }
+
+  ignition::math::Matrix4d rootM(actorPose.Rot());
+
+  rootM.SetTranslation(actorPose.Pos());
+
+  // TODO: Possible bug here? Rotation changed after scaling. Maybe the
+  // rotation algorithm is not suppose to work on non unit quaternion.
+//    gzdbg << "before: " << rootM.Rotation() << std::endl;
+//    rootM.Scale(this->skinScale, this->skinScale, this->skinScale);
+//    auto scaleTrans = ignition::math::Matrix4d::Identity;
+//    scaleTrans.Scale(this->skinScale, this->skinScale, this->skinScale);
+//    rootM = scaleTrans * rootM;
+//    gzdbg << "after: " << rootM.Rotation() << std::endl;
+
+  // workaround for rotation bug
+  rootM.SetTranslation(rootM.Translation() * this->skinScale);
+
+  return rootM;
+}
+
 //////////////////////////////////////////////////
 void Actor::Fini()
 {
@@ -1051,6 +1391,20 @@ void Actor::ResetCustomTrajectory()
   this->customTrajectoryInfo.reset();
 }
 
+//////////////////////////////////////////////////
+void Actor::SetBakedAnimation(const bool _baked)
+{
+  this->dataPtr->baked = _baked;
+  if (_baked && this->dataPtr->boneOrder.empty())
+    this->BakeAnimations();
+}
+
+//////////////////////////////////////////////////
+bool Actor::BakedAnimation() const
+{
+  return this->dataPtr->baked;
+}
+
 //////////////////////////////////////////////////
 void Actor::AddSphereInertia(const sdf::ElementPtr &_linkSdf,
                              const ignition::math::Pose3d &_pose,
@@ -168,6 +168,20 @@ namespace gazebo
       /// \sa SetCustomTrajectory
       public: void ResetCustomTrajectory();
 
+      /// \brief Set whether the skeleton animations are baked. A baked
+      /// animation is sampled once into contiguous tracks of bone poses,
+      /// which are interpolated at every update instead of the keyframes,
+      /// and the bones are published in one compact message. This is
+      /// enabled by default when GAZEBO_ACTOR_BAKED_ANIMATION is set to 1.
+      /// \param[in] _baked True to bake the animations.
+      /// \sa BakedAnimation
+      public: void SetBakedAnimation(const bool _baked);
+
+      /// \brief Get whether the skeleton animations are baked.
+      /// \return True if the animations are baked.
+      /// \sa SetBakedAnimation
+      public: bool BakedAnimation() const;
+
       /// \brief Get whether the links in the actor can collide with each other.
       /// This is always false for actors.
       /// \return False, because actors can't self-collide.
@@ -287,6 +301,28 @@ namespace gazebo
                    std::map<std::string, std::string> _skelMap,
                    const double _time);
 
+      /// \brief Sample every skeleton animation into the baked tracks.
+      private: void BakeAnimations();
+
+      /// \brief Set the actor's pose from baked bone poses, like SetPose.
+      /// \param[in] _poses Pose of every bone relative to its parent, in
+      /// the order of the bone handles.
+      /// \param[in] _time Time over which to animate the set pose.
+      private: void SetBakedPose(
+                   const std::vector<ignition::math::Pose3d> &_poses,
+                   const double _time);
+
+      /// \brief Get the transform of the root bone, which combines the
+      /// trajectory and the animated root.
+      /// \param[in] _rootTrans Animated transform of the root bone.
+      /// \param[in] _modelPose Pose of the trajectory.
+      /// \param[in] _tinfo Trajectory being played.
+      /// \return Transform of the root bone in the world.
+      private: ignition::math::Matrix4d RootTransform(
+                   const ignition::math::Matrix4d &_rootTrans,
+                   const ignition::math::Pose3d &_modelPose,
+                   const TrajectoryInfo &_tinfo) const;
+
       /// \brief Pointer to the actor's mesh.
       protected: const common::Mesh *mesh = nullptr;
 
@@ -15,6 +15,9 @@
  *
 */
 
+#include <cmath>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Actor.hh"
 
@@ -102,6 +105,55 @@ TEST_F(ActorTest, TrajectoryFromSDF)
   EXPECT_LT(fabs(actor->ScriptTime() - world->SimTime().Double()), 1.0 / 30);
 }
 
+//////////////////////////////////////////////////
+TEST_F(ActorTest, BakedAnimation)
+{
+  // Load a world with an actor
+  this->Load("worlds/actor.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  // Get model
+  auto model = world->ModelByName("actor");
+  ASSERT_TRUE(model != nullptr);
+
+  // Convert to actor
+  auto actor = boost::dynamic_pointer_cast<physics::Actor>(model);
+  ASSERT_TRUE(actor != nullptr);
+
+  // Play the animation at a fixed time
+  physics::TrajectoryInfoPtr trajInfo(new physics::TrajectoryInfo());
+  trajInfo->type = "walking";
+  trajInfo->duration = 1.0;
+  actor->SetCustomTrajectory(trajInfo);
+
+  auto linkPoses = [&](const bool _baked)
+  {
+    actor->SetBakedAnimation(_baked);
+    EXPECT_EQ(actor->BakedAnimation(), _baked);
+    actor->SetScriptTime(0.55);
+    world->Step(100);
+
+    std::vector<ignition::math::Pose3d> poses;
+    for (const auto &link : actor->GetLinks())
+      poses.push_back(link->WorldPose());
+    return poses;
+  };
+
+  // The baked tracks interpolate between samples, so the bones are close
+  // to those of the keyframes
+  auto keyframePoses = linkPoses(false);
+  auto bakedPoses = linkPoses(true);
+  ASSERT_EQ(keyframePoses.size(), bakedPoses.size());
+  EXPECT_GT(keyframePoses.size(), 1u);
+  for (unsigned int i = 0; i < keyframePoses.size(); ++i)
+  {
+    EXPECT_LT((keyframePoses[i].Pos() - bakedPoses[i].Pos()).Length(), 0.01);
+    EXPECT_GT(std::abs(keyframePoses[i].Rot().Dot(bakedPoses[i].Rot())),
+        0.999);
+  }
+}
+
 //////////////////////////////////////////////////
 TEST_F(ActorTest, ActorCollision)
 {
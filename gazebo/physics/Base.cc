@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <unordered_set>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
@@ -73,6 +76,11 @@ void Base::Load(sdf::ElementPtr _sdf)
 
   this->ComputeScopedName();
 
+  if (this->world)
+  {
+    this->world->AddToEntityIndex(shared_from_this());
+  }
+
   this->RegisterIntrospectionItems();
 }
 
@@ -106,6 +114,9 @@ void Base::Fini()
   }
   this->children.clear();
 
+  if (this->world)
+    this->world->RemoveFromEntityIndex(this->id);
+
   this->sdf.reset();
 
   this->world.reset();
@@ -274,9 +285,37 @@ void Base::RemoveChildren()
   this->children.clear();
 }
 
+//////////////////////////////////////////////////
+void Base::RemoveChildren(const Base_V &_children)
+{
+  std::unordered_set<Base *> removed;
+  for (auto const &child : _children)
+  {
+    if (!child || !removed.insert(child.get()).second)
+      continue;
+
+    child->SetParent(nullptr);
+    child->Fini();
+  }
+
+  this->children.erase(std::remove_if(this->children.begin(),
+      this->children.end(), [&removed](const BasePtr &_child)
+      {
+        return removed.count(_child.get()) > 0;
+      }), this->children.end());
+}
+
 //////////////////////////////////////////////////
 BasePtr Base::GetById(unsigned int _id) const
 {
+  if (this->world)
+  {
+    BasePtr entity = this->world->BaseById(_id);
+    if (entity && entity->GetParent().get() == this)
+      return entity;
+  }
+
+  // A child that is being removed has no parent anymore
   BasePtr result;
   Base_V::const_iterator biter;
 
@@ -295,9 +334,12 @@ BasePtr Base::GetById(unsigned int _id) const
 //////////////////////////////////////////////////
 BasePtr Base::GetByName(const std::string &_name)
 {
-  if (this->GetScopedName() == _name || this->GetName() == _name)
+  if (this->scopedName == _name || this->name == _name)
     return shared_from_this();
 
+  if (this->world && this->world->InEntityIndex(this->id))
+    return this->world->IndexedEntityByName(_name, this);
+
   BasePtr result;
   Base_V::const_iterator iter;
 
@@ -371,6 +413,13 @@ void Base::ComputeScopedName()
       this->scopedName.insert(0, p->GetName()+"::");
     p = p->GetParent();
   }
+
+  // A rename changes the scoped names of the children
+  if (this->world && this->world->InEntityIndex(this->id))
+    this->world->AddToEntityIndex(shared_from_this());
+
+  for (auto &child : this->children)
+    child->ComputeScopedName();
 }
 
 //////////////////////////////////////////////////
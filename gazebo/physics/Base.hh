@@ -215,6 +215,10 @@ namespace gazebo
       /// \brief Remove all children.
       public: void RemoveChildren();
 
+      /// \brief Remove several children, in one pass over the children.
+      /// \param[in] _children Pointers to the children.
+      public: void RemoveChildren(const Base_V &_children);
+
       /// \brief Get the number of children.
       /// \return The number of children.
       public: unsigned int GetChildCount() const;
@@ -227,7 +231,9 @@ namespace gazebo
       public: BasePtr GetById(unsigned int _id) const;
       /// \endcond
 
-      /// \brief Get by name.
+      /// \brief Get by name. Once the object is loaded in a world, the
+      /// index of the world finds the object without a walk of the tree,
+      /// and a match of the scoped name comes before a match of the name.
       /// \param[in] _name Get a child (or self) object by name
       /// \return A pointer to the object, NULL if not found
       public: BasePtr GetByName(const std::string &_name);
@@ -336,8 +342,9 @@ namespace gazebo
       /// \brief Unregister items in the introspection service.
       protected: virtual void UnregisterIntrospectionItems();
 
-      /// \brief Compute the scoped name of this object based on its
-      /// parents.
+      /// \brief Compute the scoped name of this object and of its
+      /// children based on their parents, and update the index of the
+      /// world.
       /// \sa Base::GetScopedName
       protected: void ComputeScopedName();
 
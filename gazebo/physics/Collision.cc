@@ -79,7 +79,7 @@ Collision::~Collision()
 //////////////////////////////////////////////////
 void Collision::Fini()
 {
-  if (this->requestPub)
+  if (this->requestPub && !(this->world && this->world->RemovingModels()))
   {
     msgs::Request *msg = msgs::CreateRequest("entity_delete",
         this->GetScopedName()+"__COLLISION_VISUAL__");
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -26,12 +28,27 @@
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/ContactManagerPrivate.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
 
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+ContactPublisher::ContactPublisher()
+  : dataPtr(new ContactPublisherPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ContactPublisher::~ContactPublisher()
+{
+}
+
 /////////////////////////////////////////////////
 ContactManager::ContactManager()
+  : dataPtr(new ContactManagerPrivate)
 {
   this->contactIndex = 0;
   this->customMutex = new boost::recursive_mutex();
@@ -116,10 +133,10 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
           return true;
         }
         // We could do the same transformation which is done in
-        // GetCustomPublishers() here (insert collisions which now have been
+        // ResolveCollisionNames() here (insert collisions which now have been
         // loaded), but this would remove the const qualifier of this function.
         // It would however speed up repeated calls of this function without
-        // a call of NewContact() or GetCustomPublishers() in between.
+        // a call of ResetCount() in between.
       }
     }
 
@@ -137,35 +154,64 @@ bool ContactManager::SubscribersConnected(Collision *_collision1,
 }
 
 /////////////////////////////////////////////////
-void ContactManager::GetCustomPublishers(Collision *_collision1,
-                     Collision *_collision2, const bool _getOnlyConnected,
-                     std::vector<ContactPublisher*> &_publishers)
+void ContactManager::ResolveCollisionNames()
 {
   boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+
+  bool resolved = false;
+  this->dataPtr->pendingCollisionNames = false;
+
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
        iter != this->customContactPublishers.end(); ++iter)
   {
     // A model can simply be loaded later, so convert ones that are not yet
     // found
-    if (!iter->second->collisionNames.empty())
+    std::vector<std::string>::iterator it;
+    for (it = iter->second->collisionNames.begin();
+        it != iter->second->collisionNames.end();)
     {
-      std::vector<std::string>::iterator it;
-      for (it = iter->second->collisionNames.begin();
-          it != iter->second->collisionNames.end();)
+      Collision *col = boost::dynamic_pointer_cast<Collision>(
+          this->world->BaseByName(*it)).get();
+      if (!col)
       {
-        Collision *col = boost::dynamic_pointer_cast<Collision>(
-            this->world->BaseByName(*it)).get();
-        if (!col)
-        {
-          ++it;
-          continue;
-        }
-        it = iter->second->collisionNames.erase(it);
-        iter->second->collisions.insert(col);
+        ++it;
+        continue;
       }
+      it = iter->second->collisionNames.erase(it);
+      iter->second->collisions.insert(col);
+      resolved = true;
     }
 
+    if (!iter->second->collisionNames.empty())
+      this->dataPtr->pendingCollisionNames = true;
+  }
+
+  if (resolved)
+    this->dataPtr->publisherCache.clear();
+}
+
+/////////////////////////////////////////////////
+const std::vector<ContactPublisher *> &ContactManager::CustomPublishers(
+    Collision *_collision1, Collision *_collision2)
+{
+  auto key = std::make_pair(_collision1, _collision2);
+  auto cached = this->dataPtr->publisherCache.find(key);
+  if (cached != this->dataPtr->publisherCache.end())
+    return cached->second;
+
+  // Collisions that are removed from the world leave their pairs behind,
+  // so keep the cache bounded.
+  if (this->dataPtr->publisherCache.size() > 100000)
+    this->dataPtr->publisherCache.clear();
+
+  std::vector<ContactPublisher *> &publishers =
+      this->dataPtr->publisherCache[key];
+
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
+  for (iter = this->customContactPublishers.begin();
+       iter != this->customContactPublishers.end(); ++iter)
+  {
     // only reason _collision1 or _collision1 cannot be const parameters
     // is that compiler can't find const pointers in unordered set
     if (iter->second->collisions.find(_collision1) !=
@@ -175,12 +221,11 @@ void ContactManager::GetCustomPublishers(Collision *_collision1,
     {
       GZ_ASSERT(iter->second->publisher != NULL,
                 "ContactPublisher must have a valid publisher");
-      if (!_getOnlyConnected || iter->second->publisher->HasConnections())
-      {
-        _publishers.push_back(iter->second);
-      }
+      publishers.push_back(iter->second);
     }
   }
+
+  return publishers;
 }
 
 /////////////////////////////////////////////////
@@ -198,36 +243,48 @@ Contact *ContactManager::NewContact(Collision *_collision1,
   // This is a signal to the Physics engine that it can skip the extra
   // processing necessary to get back contact information.
 
-  std::vector<ContactPublisher *> publishers;
-  bool getOnlyConnected = false;
-  // TODO check: getOnlyConnected set to false to keep same behaviour as before.
-  // But should we not only add publishers which are connected, as is done
-  // for this->contactPub->HasConnections() condition?
-  this->GetCustomPublishers(_collision1, _collision2,
-                            getOnlyConnected, publishers);
+  // TODO check: publishers without connections are included to keep same
+  // behaviour as before. But should we not only add publishers which are
+  // connected, as is done for this->contactPub->HasConnections() condition?
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  const std::vector<ContactPublisher *> &publishers =
+      this->CustomPublishers(_collision1, _collision2);
 
   if (this->NeverDropContacts() ||
       this->contactPub->HasConnections() ||
       !publishers.empty())
   {
-    // Get or create a contact feedback object.
+    // Get or create a contact feedback object. New ones come from the
+    // pool, which doubles when it runs out.
+    unsigned int index = this->contactIndex;
     if (this->contactIndex < this->contacts.size())
       result = this->contacts[this->contactIndex++];
     else
     {
-      result = new Contact();
+      if (this->contacts.size() >= this->dataPtr->contactPool.size())
+      {
+        this->AllocateContacts(std::max(16u,
+            static_cast<unsigned int>(this->dataPtr->contactPool.size())));
+        ++this->dataPtr->contactAllocationCount;
+      }
+      result = this->dataPtr->contactPool[this->contacts.size()];
       this->contacts.push_back(result);
       this->contactIndex = this->contacts.size();
     }
+    this->dataPtr->contactHighWaterMark =
+        std::max(this->dataPtr->contactHighWaterMark, this->contactIndex);
+
     for (unsigned int i = 0; i < publishers.size(); ++i)
     {
       publishers[i]->contacts.push_back(result);
+      publishers[i]->dataPtr->contactIndices.push_back(index);
     }
   }
 
   if (!result)
     return result;
 
+  this->dataPtr->contactIndexDirty = true;
   result->count = 0;
   result->collision1 = _collision1;
   result->collision2 = _collision2;
@@ -258,28 +315,171 @@ const std::vector<Contact*> &ContactManager::GetContacts() const
   return this->contacts;
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the distinct collisions, links and models of a contact.
+/// \param[in] _contact The contact.
+/// \param[out] _keys The entities.
+/// \return Number of entities.
+static unsigned int contactKeys(const Contact *_contact,
+    const Base *_keys[6])
+{
+  const Collision *collisions[2] = {_contact->collision1,
+      _contact->collision2};
+  const Base *all[6];
+  for (int i = 0; i < 2; ++i)
+  {
+    const LinkPtr link = collisions[i]->GetLink();
+    all[i] = collisions[i];
+    all[2 + i] = link.get();
+    all[4 + i] = link ? link->GetModel().get() : nullptr;
+  }
+
+  unsigned int count = 0;
+  for (const Base *key : all)
+  {
+    if (key && std::find(_keys, _keys + count, key) == _keys + count)
+      _keys[count++] = key;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::IndexContacts()
+{
+  // Count the contacts of each entity, then place them in one array, so
+  // that the index allocates nothing once it has seen a similar step.
+  for (auto &range : this->dataPtr->contactRanges)
+    range.second = std::make_pair(0u, 0u);
+
+  const Base *keys[6];
+  for (unsigned int i = 0; i < this->contactIndex; ++i)
+  {
+    const unsigned int count = contactKeys(this->contacts[i], keys);
+    for (unsigned int k = 0; k < count; ++k)
+      ++this->dataPtr->contactRanges[keys[k]].second;
+  }
+
+  unsigned int offset = 0;
+  for (auto &range : this->dataPtr->contactRanges)
+  {
+    range.second.first = offset;
+    offset += range.second.second;
+    range.second.second = range.second.first;
+  }
+
+  this->dataPtr->indexedContacts.resize(offset);
+  for (unsigned int i = 0; i < this->contactIndex; ++i)
+  {
+    const unsigned int count = contactKeys(this->contacts[i], keys);
+    for (unsigned int k = 0; k < count; ++k)
+    {
+      auto &range = this->dataPtr->contactRanges[keys[k]];
+      this->dataPtr->indexedContacts[range.second++] = this->contacts[i];
+    }
+  }
+
+  this->dataPtr->contactIndexDirty = false;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::ContactsOf(const Base *_entity,
+    std::vector<Contact *> &_contacts)
+{
+  _contacts.clear();
+  if (!_entity)
+    return;
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  if (this->dataPtr->contactIndexDirty)
+    this->IndexContacts();
+
+  auto iter = this->dataPtr->contactRanges.find(_entity);
+  if (iter == this->dataPtr->contactRanges.end())
+    return;
+
+  // The index keeps the last entities, so a range may be empty
+  _contacts.assign(this->dataPtr->indexedContacts.begin() + iter->second.first,
+      this->dataPtr->indexedContacts.begin() + iter->second.second);
+}
+
 /////////////////////////////////////////////////
 void ContactManager::ResetCount()
 {
   this->contactIndex = 0;
+  this->dataPtr->contactIndexDirty = true;
+
+  // Called before each collision update, which is a good time to look for
+  // collisions loaded since the last update.
+  if (this->dataPtr->pendingCollisionNames)
+    this->ResolveCollisionNames();
 }
 
 /////////////////////////////////////////////////
 void ContactManager::Clear()
 {
   // Delete all the contacts.
-  for (unsigned int i = 0; i < this->contacts.size(); ++i)
-    delete this->contacts[i];
-
   this->contacts.clear();
+  this->dataPtr->contactPool.clear();
+  this->dataPtr->contactBlocks.clear();
+  this->dataPtr->contactHighWaterMark = 0;
+  this->dataPtr->contactAllocationCount = 0;
+  this->dataPtr->contactMemory.Set(0, 0);
 
   boost::unordered_map<std::string, ContactPublisher *>::iterator iter;
   for (iter = this->customContactPublishers.begin();
       iter != this->customContactPublishers.end(); ++iter)
+  {
     iter->second->contacts.clear();
+    iter->second->dataPtr->contactIndices.clear();
+  }
 
   // Reset the contact count to zero.
   this->contactIndex = 0;
+  this->dataPtr->contactRanges.clear();
+  this->dataPtr->indexedContacts.clear();
+  this->dataPtr->contactIndexDirty = true;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::SetContactCapacity(const unsigned int _capacity)
+{
+  if (_capacity > this->dataPtr->contactPool.size())
+    this->AllocateContacts(_capacity - this->dataPtr->contactPool.size());
+}
+
+/////////////////////////////////////////////////
+unsigned int ContactManager::ContactCapacity() const
+{
+  return this->dataPtr->contactPool.size();
+}
+
+/////////////////////////////////////////////////
+unsigned int ContactManager::ContactHighWaterMark() const
+{
+  return this->dataPtr->contactHighWaterMark;
+}
+
+/////////////////////////////////////////////////
+unsigned int ContactManager::ContactAllocationCount() const
+{
+  return this->dataPtr->contactAllocationCount;
+}
+
+/////////////////////////////////////////////////
+void ContactManager::AllocateContacts(const unsigned int _count)
+{
+  std::unique_ptr<Contact[]> block(new Contact[_count]);
+  for (unsigned int i = 0; i < _count; ++i)
+    this->dataPtr->contactPool.push_back(&block[i]);
+  this->dataPtr->contactBlocks.push_back(std::move(block));
+
+  // Handing out contacts doesn't grow the vector either
+  this->contacts.reserve(this->dataPtr->contactPool.size());
+
+  const std::size_t count = this->dataPtr->contactPool.size();
+  this->dataPtr->contactMemory.Set(
+      count * (sizeof(this->dataPtr->contactBlocks[0][0]) +
+        2 * sizeof(this->dataPtr->contactPool[0])), count);
 }
 
 /////////////////////////////////////////////////
@@ -295,21 +495,45 @@ void ContactManager::PublishContacts()
     return;
   }
 
-  // publish to default topic, ~/physics/contacts
-  if (!transport::getMinimalComms())
+  // The message of each contact is filled once, into the first message
+  // that holds the contact, and copied from there into the others.
+  this->dataPtr->contactMsgs.assign(this->contactIndex, nullptr);
+  auto addContact = [this](msgs::Contacts &_msg, const unsigned int _index)
   {
-    msgs::Contacts msg;
+    const msgs::Contact *&filled = this->dataPtr->contactMsgs[_index];
+    msgs::Contact *contactMsg = _msg.add_contact();
+    if (filled)
+    {
+      contactMsg->CopyFrom(*filled);
+    }
+    else
+    {
+      this->contacts[_index]->FillMsg(*contactMsg);
+      filled = contactMsg;
+    }
+  };
+
+  // The published messages are shared with the publishers, and keep the
+  // filled contact messages alive until the end of this function.
+  std::vector<boost::shared_ptr<msgs::Contacts>> published;
+
+  // publish to default topic, ~/physics/contacts. Contacts that are only
+  // kept for NeverDropContacts() or the custom topics aren't converted.
+  if (!transport::getMinimalComms() && this->contactPub->HasConnections())
+  {
+    boost::shared_ptr<msgs::Contacts> msg =
+      this->contactPub->CreateMessage<msgs::Contacts>();
     for (unsigned int i = 0; i < this->contactIndex; ++i)
     {
       if (this->contacts[i]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg.add_contact();
-      this->contacts[i]->FillMsg(*contactMsg);
+      addContact(*msg, i);
     }
 
-    msgs::Set(msg.mutable_time(), this->world->SimTime());
+    msgs::Set(msg->mutable_time(), this->world->SimTime());
     this->contactPub->Publish(msg);
+    published.push_back(msg);
   }
 
   // publish to other custom topics
@@ -319,19 +543,41 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+
+    // Contacts delivered in process are only converted to a message for
+    // remote subscribers.
+    if (contactPublisher->dataPtr->callback)
+    {
+      this->dataPtr->callbackContacts.clear();
+      for (auto const index : contactPublisher->dataPtr->contactIndices)
+      {
+        if (index < this->contactIndex && this->contacts[index]->count > 0)
+          this->dataPtr->callbackContacts.push_back(this->contacts[index]);
+      }
+      contactPublisher->dataPtr->callback(this->dataPtr->callbackContacts);
+
+      if (!contactPublisher->publisher->HasConnections())
+      {
+        contactPublisher->contacts.clear();
+        contactPublisher->dataPtr->contactIndices.clear();
+        continue;
+      }
+    }
+
+    boost::shared_ptr<msgs::Contacts> msg2 =
+      contactPublisher->publisher->CreateMessage<msgs::Contacts>();
+    for (auto const index : contactPublisher->dataPtr->contactIndices)
     {
-      if (contactPublisher->contacts[j]->count == 0)
+      if (index >= this->contactIndex || this->contacts[index]->count == 0)
         continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      addContact(*msg2, index);
     }
-    msgs::Set(msg2.mutable_time(), this->world->SimTime());
+    msgs::Set(msg2->mutable_time(), this->world->SimTime());
     contactPublisher->publisher->Publish(msg2);
+    published.push_back(msg2);
     contactPublisher->contacts.clear();
+    contactPublisher->dataPtr->contactIndices.clear();
   }
 }
 
@@ -375,6 +621,7 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   {
     boost::recursive_mutex::scoped_lock lock(*this->customMutex);
     this->customContactPublishers[name] = contactPublisher;
+    this->dataPtr->publisherCache.clear();
   }
 
   return topic;
@@ -419,11 +666,29 @@ std::string ContactManager::CreateFilter(const std::string &_name,
 
     // Let it know about collisions not yet found.
     this->customContactPublishers[name]->collisionNames = collisionNames;
+    if (!collisionNames.empty())
+      this->dataPtr->pendingCollisionNames = true;
   }
 
   return topic;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const ContactPublisher::Callback &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  auto iter = this->customContactPublishers.find(name);
+  if (iter == this->customContactPublishers.end())
+    return false;
+
+  iter->second->dataPtr->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(const std::string &_name)
 {
@@ -437,11 +702,14 @@ void ContactManager::RemoveFilter(const std::string &_name)
   {
     ContactPublisher *contactPublisher = iter->second;
     contactPublisher->contacts.clear();
+    contactPublisher->dataPtr->contactIndices.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
+    contactPublisher->dataPtr->callback = nullptr;
     contactPublisher->publisher->Fini();
     contactPublisher->publisher.reset();
     this->customContactPublishers.erase(iter);
+    this->dataPtr->publisherCache.clear();
   }
 }
 
@@ -18,9 +18,11 @@
 #ifndef GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 #define GAZEBO_PHYSICS_CONTACTMANAGER_HH_
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
 #include <ignition/transport/Node.hh>
 
 #include <boost/unordered/unordered_set.hpp>
@@ -37,10 +39,25 @@ namespace gazebo
 {
   namespace physics
   {
+    class ContactManagerPrivate;
+    class ContactPublisherPrivate;
+
     /// \brief A custom contact publisher created for each contact filter
     /// in the Contact Manager.
     class GZ_PHYSICS_VISIBLE ContactPublisher
     {
+      /// \brief Function that is given the contacts of a filter after each
+      /// step, in the physics thread. The contacts belong to the contact
+      /// manager, and are only valid during the call.
+      public: using Callback =
+                  std::function<void (const std::vector<const Contact *> &)>;
+
+      /// \brief Constructor.
+      public: ContactPublisher();
+
+      /// \brief Destructor.
+      public: ~ContactPublisher();
+
       /// \brief Contact message publisher
       public: transport::PublisherPtr publisher;
 
@@ -56,6 +73,13 @@ namespace gazebo
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
 
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ContactPublisherPrivate> dataPtr;
+
+      /// \brief The contact manager fills the private data.
+      private: friend class ContactManager;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
@@ -156,6 +180,17 @@ namespace gazebo
       /// \return Vector of contact pointers.
       public: const std::vector<Contact *> &GetContacts() const;
 
+      /// \brief Get the contacts of the last step that involve a collision,
+      /// a link or a model, without scanning all the contacts. The first
+      /// query after a step indexes the contacts of the step, and each
+      /// query then costs the number of contacts it returns.
+      /// \param[in] _entity A collision, a link or a model. The contacts of
+      /// a model are those of its own links, not of its nested models.
+      /// \param[out] _contacts The contacts, cleared first. They are valid
+      /// until the next step.
+      public: void ContactsOf(const Base *_entity,
+                  std::vector<Contact *> &_contacts);
+
       /// \brief Clear all stored contacts.
       public: void Clear();
 
@@ -165,6 +200,27 @@ namespace gazebo
       /// \brief Set the contact count to zero.
       public: void ResetCount();
 
+      /// \brief Allocate the contacts up front, so that NewContact doesn't
+      /// allocate while the number of contacts per step stays below the
+      /// capacity. Contacts are allocated in blocks, never one by one, and
+      /// the capacity never shrinks until Clear() is called.
+      /// \param[in] _capacity Number of contacts.
+      public: void SetContactCapacity(const unsigned int _capacity);
+
+      /// \brief Get the number of allocated contacts.
+      /// \return Number of contacts.
+      public: unsigned int ContactCapacity() const;
+
+      /// \brief Get the largest number of contacts of a step since the
+      /// last call to Clear().
+      /// \return Number of contacts.
+      public: unsigned int ContactHighWaterMark() const;
+
+      /// \brief Get the number of times NewContact had to allocate a block
+      /// of contacts since the last call to Clear().
+      /// \return Number of allocations.
+      public: unsigned int ContactAllocationCount() const;
+
       /// \brief Create a filter for contacts. A new publisher will be created
       /// that publishes contacts associated to the input collisions.
       /// param[in] _name Filter name.
@@ -191,6 +247,17 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Deliver the contacts of a filter to a function in process,
+      /// instead of going through the filter topic. Contacts are still
+      /// published on the topic while it has subscribers.
+      /// \param[in] _name Filter name.
+      /// \param[in] _callback Function given the contacts of each step, or
+      /// an empty function to stop delivering them. It is called with the
+      /// filters locked, so it must not create or remove filters.
+      /// \return False if there is no filter with that name.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const ContactPublisher::Callback &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(const std::string &_name);
@@ -205,15 +272,25 @@ namespace gazebo
       public: bool HasFilter(const std::string &_name);
 
       /// \brief Helper function which gets the custom publishers which publish
-      ///   contacts of either \e _collision1 or \e _collision2.
+      ///   contacts of either \e _collision1 or \e _collision2. The result
+      ///   is cached per collision pair. The custom mutex must be locked.
       /// \param[in] _collision1 the first collision object
       /// \param[in] _collision2 the second collision object
-      /// \param[in] _getOnlyConnected return only publishers which currently
-      ///   have subscribers
-      /// \param[out] _publishers the resulting publishers.
-      private: void GetCustomPublishers(Collision *_collision1,
-                       Collision *_collision2, const bool _getOnlyConnected,
-                       std::vector<ContactPublisher*> &_publishers);
+      /// \return The publishers, valid until the filters change.
+      private: const std::vector<ContactPublisher *> &CustomPublishers(
+                   Collision *_collision1, Collision *_collision2);
+
+      /// \brief Convert the names of collisions that were not loaded when
+      /// a filter was created to pointers, once they are loaded.
+      private: void ResolveCollisionNames();
+
+      /// \brief Index the contacts of the step by entity.
+      /// The custom mutex must be locked.
+      private: void IndexContacts();
+
+      /// \brief Allocate a block of contacts.
+      /// \param[in] _count Number of contacts in the block.
+      private: void AllocateContacts(const unsigned int _count);
 
       private: std::vector<Contact*> contacts;
 
@@ -236,6 +313,10 @@ namespace gazebo
       /// \brief Mutex to protect the list of custom publishers.
       private: boost::recursive_mutex *customMutex;
 
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ContactManagerPrivate> dataPtr;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
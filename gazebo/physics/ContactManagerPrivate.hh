@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_CONTACTMANAGERPRIVATE_HH_
+#define GAZEBO_PHYSICS_CONTACTMANAGERPRIVATE_HH_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <boost/unordered/unordered_map.hpp>
+
+#include "gazebo/common/MemoryAccounts.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/Contact.hh"
+#include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the ContactPublisher class.
+    class ContactPublisherPrivate
+    {
+      /// \brief Indices of the contacts in the contact manager, in the same
+      /// order as the contacts of the publisher.
+      public: std::vector<unsigned int> contactIndices;
+
+      /// \brief Function given the contacts in process, if any. The
+      /// publisher is then only used when it has remote subscribers.
+      public: ContactPublisher::Callback callback;
+    };
+
+    /// \internal
+    /// \brief Private data for the ContactManager class.
+    class ContactManagerPrivate
+    {
+      /// \brief Custom publishers of each collision pair that had a
+      /// contact since the filters last changed.
+      public: boost::unordered_map<std::pair<Collision *, Collision *>,
+              std::vector<ContactPublisher *>> publisherCache;
+
+      /// \brief True if a filter has collision names that are not
+      /// resolved yet.
+      public: bool pendingCollisionNames = false;
+
+      /// \brief Message of each contact filled by PublishContacts, indexed
+      /// like contacts. Each contact is filled once into the first message
+      /// that holds it and copied from there into the others.
+      public: std::vector<const msgs::Contact *> contactMsgs;
+
+      /// \brief Blocks of contacts, pointed to by contactPool.
+      public: std::vector<std::unique_ptr<Contact[]>> contactBlocks;
+
+      /// \brief All the allocated contacts. The contacts handed out so far
+      /// are the first ones, in the same order as in contacts.
+      public: std::vector<Contact*> contactPool;
+
+      /// \brief Largest number of contacts of a step.
+      public: unsigned int contactHighWaterMark = 0;
+
+      /// \brief Number of blocks allocated by NewContact.
+      public: unsigned int contactAllocationCount = 0;
+
+      /// \brief Contacts given to a filter callback by PublishContacts.
+      public: std::vector<const Contact *> callbackContacts;
+
+      /// \brief Range in indexedContacts of the contacts of each collision,
+      /// link and model of the step.
+      public: boost::unordered_map<const Base *,
+              std::pair<unsigned int, unsigned int>> contactRanges;
+
+      /// \brief Contacts of the step, grouped by entity.
+      public: std::vector<Contact *> indexedContacts;
+
+      /// \brief True if the contacts changed since they were indexed.
+      public: bool contactIndexDirty = true;
+
+      /// \brief Share of the contact pool in the memory accounts.
+      public: common::MemoryUsage contactMemory{"physics/contacts"};
+    };
+  }
+}
+#endif
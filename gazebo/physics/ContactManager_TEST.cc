@@ -15,6 +15,10 @@
  *
 */
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -194,6 +198,212 @@ TEST_F(ContactManagerTest, NeverDropContacts)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, ContactPool)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  // A pool sized up front is never grown
+  EXPECT_TRUE(physics->SetParam("contact_pool_capacity", 64));
+  EXPECT_EQ(64, boost::any_cast<int>(
+      physics->GetParam("contact_pool_capacity")));
+  EXPECT_EQ(64u, manager->ContactCapacity());
+  EXPECT_EQ(0u, manager->ContactHighWaterMark());
+
+  world->Step(10);
+  const unsigned int numContacts = manager->GetContactCount();
+  ASSERT_GT(numContacts, 0u);
+  EXPECT_GE(manager->ContactHighWaterMark(), numContacts);
+  EXPECT_EQ(0u, manager->ContactAllocationCount());
+  EXPECT_EQ(manager->ContactHighWaterMark(), manager->GetContacts().size());
+  EXPECT_EQ(64u, manager->ContactCapacity());
+
+  // The capacity never shrinks
+  manager->SetContactCapacity(8);
+  EXPECT_EQ(64u, manager->ContactCapacity());
+
+  // Without a pool, contacts are allocated in blocks
+  manager->Clear();
+  EXPECT_EQ(0u, manager->ContactCapacity());
+  EXPECT_EQ(0u, manager->ContactHighWaterMark());
+  world->Step(1);
+  EXPECT_GT(manager->GetContactCount(), 0u);
+  EXPECT_EQ(1u, manager->ContactAllocationCount());
+  EXPECT_EQ(16u, manager->ContactCapacity());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, ContactsOf)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ContactManager *manager =
+      world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+  manager->SetNeverDropContacts(true);
+
+  physics::ModelPtr model = world->ModelByName("box");
+  ASSERT_TRUE(model != nullptr);
+  physics::LinkPtr link = model->GetLink("link");
+  ASSERT_TRUE(link != nullptr);
+  physics::CollisionPtr collision = link->GetCollision("collision");
+  ASSERT_TRUE(collision != nullptr);
+
+  std::vector<physics::Contact *> contacts;
+  manager->ContactsOf(model.get(), contacts);
+  EXPECT_TRUE(contacts.empty());
+
+  world->Step(10);
+  const unsigned int numContacts = manager->GetContactCount();
+  ASSERT_GT(numContacts, 0u);
+
+  // The box is only in contact with the ground
+  manager->ContactsOf(model.get(), contacts);
+  EXPECT_EQ(numContacts, contacts.size());
+  for (auto const &contact : contacts)
+  {
+    EXPECT_TRUE(contact->collision1 == collision.get() ||
+        contact->collision2 == collision.get());
+  }
+
+  std::vector<physics::Contact *> linkContacts;
+  manager->ContactsOf(link.get(), linkContacts);
+  EXPECT_EQ(contacts, linkContacts);
+  manager->ContactsOf(collision.get(), linkContacts);
+  EXPECT_EQ(contacts, linkContacts);
+
+  physics::ModelPtr ground = world->ModelByName("ground_plane");
+  ASSERT_TRUE(ground != nullptr);
+  manager->ContactsOf(ground.get(), linkContacts);
+  EXPECT_EQ(contacts, linkContacts);
+
+  // Lifted, the box has no contacts at the next step
+  model->SetWorldPose(ignition::math::Pose3d(0, 0, 10, 0, 0, 0));
+  world->Step(1);
+  manager->ContactsOf(model.get(), contacts);
+  EXPECT_TRUE(contacts.empty());
+  manager->ContactsOf(nullptr, contacts);
+  EXPECT_TRUE(contacts.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterCallback)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  physics::ContactManager *manager = physics->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  const std::string filterName = "box_filter";
+  EXPECT_FALSE(manager->SetFilterCallback(filterName, nullptr));
+
+  manager->CreateFilter(filterName, "box::link::collision");
+  unsigned int calls = 0;
+  unsigned int contactCount = 0;
+  EXPECT_TRUE(manager->SetFilterCallback(filterName,
+      [&](const std::vector<const physics::Contact *> &_contacts)
+      {
+        ++calls;
+        contactCount += _contacts.size();
+        for (auto const *contact : _contacts)
+        {
+          EXPECT_GT(contact->count, 0);
+          EXPECT_TRUE(contact->collision1->GetScopedName() ==
+              "box::link::collision" ||
+              contact->collision2->GetScopedName() ==
+              "box::link::collision");
+        }
+      }));
+
+  // The box rests on the ground plane
+  world->Step(10);
+  EXPECT_EQ(10u, calls);
+  EXPECT_GT(contactCount, 0u);
+
+  // Removing the filter stops the callback
+  manager->RemoveFilter(filterName);
+  world->Step(1);
+  EXPECT_EQ(10u, calls);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ContactManagerTest, FilterChanges)
+{
+  Load("test/worlds/box.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ContactManager *manager =
+      world->Physics()->GetContactManager();
+  ASSERT_TRUE(manager != nullptr);
+
+  // Count the contacts given to the callback of a filter
+  std::map<std::string, unsigned int> contactCounts;
+  auto countContacts = [&](const std::string &_filter,
+      const std::string &_collision)
+  {
+    manager->CreateFilter(_filter, _collision);
+    EXPECT_TRUE(manager->SetFilterCallback(_filter,
+        [&contactCounts, _filter, _collision](
+        const std::vector<const physics::Contact *> &_contacts)
+        {
+          for (auto const *contact : _contacts)
+          {
+            EXPECT_TRUE(contact->collision1->GetScopedName() == _collision ||
+                contact->collision2->GetScopedName() == _collision);
+          }
+          contactCounts[_filter] += _contacts.size();
+        }));
+  };
+
+  // The second box isn't loaded yet
+  countContacts("box_filter", "box::link::collision");
+  countContacts("late_filter", "late_box::link::collision");
+  world->Step(10);
+  EXPECT_GT(contactCounts["box_filter"], 0u);
+  EXPECT_EQ(0u, contactCounts["late_filter"]);
+
+  // A filter created once the contacts of the box are cached gets them too
+  countContacts("box_filter2", "box::link::collision");
+  world->Step(10);
+  EXPECT_GT(contactCounts["box_filter2"], 0u);
+
+  // The filter finds the second box once it's loaded
+  SpawnBox("late_box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(3, 0, 0.5));
+  world->Step(10);
+  EXPECT_GT(contactCounts["late_filter"], 0u);
+
+  // A removed filter no longer gets contacts, the others still do
+  manager->RemoveFilter("box_filter");
+  contactCounts.clear();
+  world->Step(10);
+  EXPECT_EQ(0u, contactCounts["box_filter"]);
+  EXPECT_GT(contactCounts["box_filter2"], 0u);
+  EXPECT_GT(contactCounts["late_filter"], 0u);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -486,6 +486,25 @@ void Entity::SetWorldPose(const ignition::math::Pose3d &_pose,
     std::lock_guard<std::mutex> lock(this->GetWorld()->WorldPoseMutex());
     (*this.*setWorldPoseFunc)(_pose, _notify, _publish);
   }
+
+  // Moving a link or a model moves the joints attached to it and the
+  // bounding box of the model
+  Model *model = nullptr;
+  if (this->HasType(MODEL))
+    model = static_cast<Model *>(this);
+  else if (this->HasType(LINK) && this->parent &&
+      this->parent->HasType(MODEL))
+  {
+    model = static_cast<Model *>(this->parent.get());
+  }
+
+  if (model)
+  {
+    model->InvalidateJointStates();
+    if (this->world)
+      this->world->_ModelMoved(model);
+  }
+
   if (_publish)
     this->PublishPose();
 }
@@ -588,7 +607,8 @@ void Entity::Fini()
   // TODO: put this back in
   // this->GetWorld()-Physics()->RemoveEntity(this);
 
-  if (this->requestPub)
+  // The world deletes the entities it removes in a batch at once
+  if (this->requestPub && !(this->world && this->world->RemovingModels()))
   {
     auto msg = msgs::CreateRequest("entity_delete", this->GetScopedName());
     this->requestPub->Publish(*msg, true);
@@ -674,6 +694,33 @@ const ignition::math::Pose3d &Entity::DirtyPose() const
   return this->dirtyPose;
 }
 
+//////////////////////////////////////////////////
+bool Entity::ApplyDirtyPose()
+{
+  // The world pose is a corrected copy of the last dirty pose, so an
+  // unchanged body compares equal up to rounding.
+  const double tolerance = 1e-12;
+  const ignition::math::Quaterniond &rot = this->dirtyPose.Rot();
+  const ignition::math::Quaterniond &worldRot = this->worldPose.Rot();
+  if (this->dirtyPose.Pos().Equal(this->worldPose.Pos(), tolerance) &&
+      ignition::math::equal(rot.W(), worldRot.W(), tolerance) &&
+      ignition::math::equal(rot.X(), worldRot.X(), tolerance) &&
+      ignition::math::equal(rot.Y(), worldRot.Y(), tolerance) &&
+      ignition::math::equal(rot.Z(), worldRot.Z(), tolerance))
+  {
+    return false;
+  }
+
+  (*this.*setWorldPoseFunc)(this->dirtyPose, false, true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Entity::ApplyWorldPose(const ignition::math::Pose3d &_pose)
+{
+  (*this.*setWorldPoseFunc)(_pose, true, false);
+}
+
 //////////////////////////////////////////////////
 ignition::math::AxisAlignedBox Entity::CollisionBoundingBox() const
 {
@@ -227,6 +227,22 @@ namespace gazebo
       /// \return The dirty pose of the entity.
       public: const ignition::math::Pose3d &DirtyPose() const;
 
+      /// \brief Set the world pose to the dirty pose, without notifying the
+      /// children. The model's pose is published as with SetWorldPose().
+      /// Nothing is done if the dirty pose matches the world pose, as for a
+      /// body that didn't move. Unlike SetWorldPose(), the world pose mutex
+      /// isn't locked, the caller must hold it.
+      /// \return True if the world pose changed.
+      public: bool ApplyDirtyPose();
+
+      /// \brief Set the world pose and notify the physics engine, as
+      /// SetWorldPose() does, without publishing. Unlike SetWorldPose(), the
+      /// world pose mutex isn't locked, the caller must hold it, and the
+      /// joints and the bounding boxes aren't told. This is used by
+      /// World::SetModelPoses() for a batch of models.
+      /// \param[in] _pose The new world pose.
+      public: void ApplyWorldPose(const ignition::math::Pose3d &_pose);
+
       /// \brief This function is called when the entity's
       /// (or one of its parents) pose of the parent has changed.
       protected: virtual void OnPoseChange() = 0;
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/physics/ForceFields.hh"
+#include "gazebo/physics/Inertial.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief A force field.
+    class ForceField
+    {
+      /// \brief Selects the links of the field, null for a list of links.
+      public: ForceFields::Filter filter;
+
+      /// \brief Kernel of the field.
+      public: ForceFields::Kernel kernel;
+
+      /// \brief True if the kernel can run on several threads.
+      public: bool parallel = false;
+
+      /// \brief Links of the field.
+      public: Link_V links;
+
+      /// \brief Slot of each link of the field.
+      public: std::vector<std::size_t> slots;
+    };
+
+    /// \internal
+    /// \brief Private data for the ForceFields class.
+    class ForceFieldsPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _world A reference to the world.
+      public: explicit ForceFieldsPrivate(World &_world)
+        : world(_world)
+      {
+      }
+
+      /// \brief Rebuild the links of the fields and their slots.
+      public: void Rebuild();
+
+      /// \brief Reference to the world.
+      public: World &world;
+
+      /// \brief Fields, by id.
+      public: std::map<int, ForceField> fields;
+
+      /// \brief Id of the next field.
+      public: int nextId = 0;
+
+      /// \brief State of the links of all the fields.
+      public: ForceFieldLinks state;
+
+      /// \brief True for the slots whose link is in the world.
+      public: std::vector<char> active;
+
+      /// \brief True if the slots must be rebuilt.
+      public: bool dirty = true;
+
+      /// \brief Protects the fields.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Number of links of a task of a parallel field.
+static const std::size_t kGrainSize = 64;
+
+/////////////////////////////////////////////////
+void ForceFieldLinks::AddForceAtWorldPosition(const std::size_t _slot,
+    const ignition::math::Vector3d &_force,
+    const ignition::math::Vector3d &_pos)
+{
+  this->forces[_slot] += _force;
+  this->torques[_slot] += (_pos - this->cogs[_slot]).Cross(_force);
+}
+
+/////////////////////////////////////////////////
+void ForceFieldsPrivate::Rebuild()
+{
+  const Link_V &worldLinks = this->world.AllLinks();
+
+  std::unordered_set<Link *> inWorld;
+  for (auto const &link : worldLinks)
+    inWorld.insert(link.get());
+
+  // One slot per link, shared by the fields that affect it.
+  std::unordered_map<Link *, std::size_t> slotOf;
+  this->state.links.clear();
+  this->active.clear();
+  for (auto &iter : this->fields)
+  {
+    ForceField &field = iter.second;
+    if (field.filter)
+    {
+      field.links.clear();
+      for (auto const &link : worldLinks)
+      {
+        if (field.filter(link))
+          field.links.push_back(link);
+      }
+    }
+
+    field.slots.resize(field.links.size());
+    for (std::size_t i = 0; i < field.links.size(); ++i)
+    {
+      const LinkPtr &link = field.links[i];
+      auto slot = slotOf.insert(
+          std::make_pair(link.get(), this->state.links.size()));
+      if (slot.second)
+      {
+        this->state.links.push_back(link);
+        this->active.push_back(inWorld.count(link.get()) > 0);
+      }
+      field.slots[i] = slot.first->second;
+    }
+  }
+
+  const std::size_t count = this->state.links.size();
+  this->state.poses.resize(count);
+  this->state.cogs.resize(count);
+  this->state.linearVels.resize(count);
+  this->state.windVels.resize(count);
+  this->state.masses.resize(count);
+  this->state.forces.resize(count);
+  this->state.torques.resize(count);
+
+  this->dirty = false;
+}
+
+/////////////////////////////////////////////////
+ForceFields::ForceFields(World &_world)
+  : dataPtr(new ForceFieldsPrivate(_world))
+{
+}
+
+/////////////////////////////////////////////////
+ForceFields::~ForceFields()
+{
+}
+
+/////////////////////////////////////////////////
+int ForceFields::Add(const Filter &_filter, const Kernel &_kernel,
+    const bool _parallel)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  ForceField &field = this->dataPtr->fields[this->dataPtr->nextId];
+  field.filter = _filter;
+  field.kernel = _kernel;
+  field.parallel = _parallel;
+  this->dataPtr->dirty = true;
+  return this->dataPtr->nextId++;
+}
+
+/////////////////////////////////////////////////
+int ForceFields::Add(const Link_V &_links, const Kernel &_kernel,
+    const bool _parallel)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  ForceField &field = this->dataPtr->fields[this->dataPtr->nextId];
+  field.links = _links;
+  field.kernel = _kernel;
+  field.parallel = _parallel;
+  this->dataPtr->dirty = true;
+  return this->dataPtr->nextId++;
+}
+
+/////////////////////////////////////////////////
+void ForceFields::Remove(const int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->fields.erase(_id) > 0)
+    this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+Link_V ForceFields::Links(const int _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->fields.find(_id);
+  if (iter == this->dataPtr->fields.end())
+    return Link_V();
+
+  // Filters are evaluated lazily
+  if (this->dataPtr->dirty)
+    this->dataPtr->Rebuild();
+  return iter->second.links;
+}
+
+/////////////////////////////////////////////////
+std::size_t ForceFields::FieldCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->fields.size();
+}
+
+/////////////////////////////////////////////////
+void ForceFields::Refresh()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void ForceFields::Update()
+{
+  IGN_PROFILE("ForceFields::Update");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->fields.empty())
+    return;
+
+  if (this->dataPtr->dirty)
+    this->dataPtr->Rebuild();
+
+  ForceFieldLinks &state = this->dataPtr->state;
+  const std::size_t count = state.links.size();
+
+  // Gather the state of the links.
+  IGN_PROFILE_BEGIN("Gather");
+  state.gravity = this->dataPtr->world.Gravity();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    state.forces[i] = ignition::math::Vector3d::Zero;
+    state.torques[i] = ignition::math::Vector3d::Zero;
+    if (!this->dataPtr->active[i])
+      continue;
+
+    const LinkPtr &link = state.links[i];
+    state.poses[i] = link->WorldPose();
+    state.cogs[i] = link->WorldCoGPose().Pos();
+    state.linearVels[i] = link->WorldLinearVel();
+    state.windVels[i] = link->WorldWindLinearVel();
+    state.masses[i] = link->GetInertial()->Mass();
+  }
+  IGN_PROFILE_END();
+
+  // Run the kernels. Fields run one after the other, so that a parallel
+  // field is the only writer of its slots.
+  IGN_PROFILE_BEGIN("Kernels");
+  for (auto &iter : this->dataPtr->fields)
+  {
+    ForceField &field = iter.second;
+    const std::size_t size = field.slots.size();
+    if (field.parallel && size > kGrainSize)
+    {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, size, kGrainSize),
+          [&](const tbb::blocked_range<std::size_t> &_r)
+          {
+            field.kernel(state, field.slots, _r.begin(), _r.end());
+          });
+    }
+    else if (size > 0)
+    {
+      field.kernel(state, field.slots, 0, size);
+    }
+  }
+  IGN_PROFILE_END();
+
+  // Apply the sums.
+  IGN_PROFILE_BEGIN("Apply");
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!this->dataPtr->active[i])
+      continue;
+
+    if (state.forces[i] != ignition::math::Vector3d::Zero)
+      state.links[i]->AddForce(state.forces[i]);
+    if (state.torques[i] != ignition::math::Vector3d::Zero)
+      state.links[i]->AddTorque(state.torques[i]);
+  }
+  IGN_PROFILE_END();
+}
+
+/////////////////////////////////////////////////
+void ForceFields::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->fields.clear();
+  this->dataPtr->state = ForceFieldLinks();
+  this->dataPtr->active.clear();
+  this->dataPtr->dirty = true;
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_FORCEFIELDS_HH_
+#define GAZEBO_PHYSICS_FORCEFIELDS_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class ForceFieldsPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class ForceFieldLinks ForceFields.hh physics/physics.hh
+    /// \brief State of the links affected by the force fields of a world,
+    /// stored as contiguous arrays indexed by slot. All vectors are
+    /// expressed in the world frame.
+    class GZ_PHYSICS_VISIBLE ForceFieldLinks
+    {
+      /// \brief Add a force applied at a point.
+      /// \param[in] _slot Slot of the link.
+      /// \param[in] _force Force.
+      /// \param[in] _pos Point of application.
+      public: void AddForceAtWorldPosition(const std::size_t _slot,
+                  const ignition::math::Vector3d &_force,
+                  const ignition::math::Vector3d &_pos);
+
+      /// \brief Gravity of the world.
+      public: ignition::math::Vector3d gravity;
+
+      /// \brief Links.
+      public: Link_V links;
+
+      /// \brief Pose of each link frame.
+      public: std::vector<ignition::math::Pose3d> poses;
+
+      /// \brief Position of the center of gravity of each link.
+      public: std::vector<ignition::math::Vector3d> cogs;
+
+      /// \brief Linear velocity of each link frame.
+      public: std::vector<ignition::math::Vector3d> linearVels;
+
+      /// \brief Wind velocity at each link, zero when the link has no wind.
+      public: std::vector<ignition::math::Vector3d> windVels;
+
+      /// \brief Mass of each link.
+      public: std::vector<double> masses;
+
+      /// \brief Force applied at the center of gravity of each link. The
+      /// fields add to it.
+      public: std::vector<ignition::math::Vector3d> forces;
+
+      /// \brief Torque applied to each link. The fields add to it.
+      public: std::vector<ignition::math::Vector3d> torques;
+    };
+
+    /// \class ForceFields ForceFields.hh physics/physics.hh
+    /// \brief Force fields of a world, such as wind, buoyancy, drag or
+    /// magnetics.
+    ///
+    /// A field is a kernel that runs over the links it affects. Once per
+    /// step, before the physics update, the state of every affected link
+    /// is gathered in a ForceFieldLinks, the kernels add their forces
+    /// and torques to it, and the sums are applied to the links. Kernels
+    /// only read and write the arrays, so the kernel of a parallel field
+    /// may run on several threads at once, over disjoint ranges.
+    class GZ_PHYSICS_VISIBLE ForceFields
+    {
+      /// \brief Kernel of a field.
+      /// The i-th link of the field is in slot _slots[i] of _links, for
+      /// i in [_begin, _end).
+      public: typedef std::function<void (ForceFieldLinks &_links,
+                  const std::vector<std::size_t> &_slots,
+                  const std::size_t _begin, const std::size_t _end)> Kernel;
+
+      /// \brief Selects the links affected by a field.
+      public: typedef std::function<bool (const LinkPtr &_link)> Filter;
+
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit ForceFields(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~ForceFields();
+
+      /// \brief Add a field over the links of the world selected by a
+      /// filter. The filter is evaluated when models are inserted or
+      /// removed, and on Refresh.
+      /// \param[in] _filter Selects the links affected by the field.
+      /// \param[in] _kernel Kernel of the field.
+      /// \param[in] _parallel True if the kernel can run on several
+      /// threads.
+      /// \return Id of the field.
+      public: int Add(const Filter &_filter, const Kernel &_kernel,
+                  const bool _parallel = false);
+
+      /// \brief Add a field over a list of links. The i-th link of the
+      /// field is _links[i]. Links removed from the world are skipped.
+      /// \param[in] _links Links affected by the field.
+      /// \param[in] _kernel Kernel of the field.
+      /// \param[in] _parallel True if the kernel can run on several
+      /// threads.
+      /// \return Id of the field.
+      public: int Add(const Link_V &_links, const Kernel &_kernel,
+                  const bool _parallel = false);
+
+      /// \brief Remove a field.
+      /// \param[in] _id Id of the field.
+      public: void Remove(const int _id);
+
+      /// \brief Get the links affected by a field, in field order.
+      /// \param[in] _id Id of the field.
+      /// \return The links, empty if there is no such field.
+      public: Link_V Links(const int _id) const;
+
+      /// \brief Get the number of fields.
+      /// \return Number of fields.
+      public: std::size_t FieldCount() const;
+
+      /// \brief Re-evaluate the filters of the fields before the next
+      /// update, e.g. after the wind mode of a link changed.
+      public: void Refresh();
+
+      /// \brief Run the fields and apply their forces. This is called by
+      /// the world before the physics update.
+      public: void Update();
+
+      /// \brief Remove all the fields.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ForceFieldsPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ForceFieldsTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+/// \brief Kernel that cancels gravity.
+static void antiGravity(physics::ForceFieldLinks &_links,
+    const std::vector<std::size_t> &_slots, const std::size_t _begin,
+    const std::size_t _end)
+{
+  for (std::size_t i = _begin; i < _end; ++i)
+  {
+    const std::size_t s = _slots[i];
+    _links.forces[s] -= _links.masses[s] * _links.gravity;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ForceFieldsTest, Filter)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("floating", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5), ignition::math::Vector3d::Zero);
+  this->SpawnBox("falling", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(3, 0, 5), ignition::math::Vector3d::Zero);
+
+  physics::ForceFields &fields = world->ForceFields();
+  const int id = fields.Add([](const physics::LinkPtr &_link)
+      {
+        return _link->GetModel()->GetName() == "floating";
+      }, antiGravity);
+  EXPECT_EQ(fields.FieldCount(), 1u);
+
+  physics::Link_V links = fields.Links(id);
+  ASSERT_EQ(links.size(), 1u);
+  EXPECT_EQ(links[0]->GetModel()->GetName(), "floating");
+
+  world->Step(100);
+  EXPECT_NEAR(world->ModelByName("floating")->WorldPose().Pos().Z(), 5,
+      1e-6);
+  EXPECT_LT(world->ModelByName("falling")->WorldPose().Pos().Z(), 4.9);
+
+  // Models inserted later are selected by the filter
+  this->SpawnBox("later", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(6, 0, 5), ignition::math::Vector3d::Zero);
+  EXPECT_EQ(fields.Links(id).size(), 1u);
+
+  fields.Remove(id);
+  EXPECT_EQ(fields.FieldCount(), 0u);
+  EXPECT_TRUE(fields.Links(id).empty());
+  world->Step(100);
+  EXPECT_LT(world->ModelByName("floating")->WorldPose().Pos().Z(), 4.9);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ForceFieldsTest, ParallelLinks)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  const int count = 100;
+  for (int i = 0; i < count; ++i)
+  {
+    this->SpawnBox("box_" + std::to_string(i), ignition::math::Vector3d::One,
+        ignition::math::Vector3d(i * 2, 0, 5), ignition::math::Vector3d::Zero,
+        false);
+  }
+  while (world->ModelCount() < count + 1u)
+    common::Time::MSleep(10);
+
+  // Two fields on the same links, with a list of links, add up
+  physics::Link_V links;
+  for (int i = 0; i < count; ++i)
+    links.push_back(world->ModelByName("box_" + std::to_string(i))->GetLink());
+
+  std::atomic<int> calls(0);
+  physics::ForceFields &fields = world->ForceFields();
+  const physics::ForceFields::Kernel half = [&calls](
+      physics::ForceFieldLinks &_links, const std::vector<std::size_t> &_slots,
+      const std::size_t _begin, const std::size_t _end)
+  {
+    ++calls;
+    for (std::size_t i = _begin; i < _end; ++i)
+    {
+      const std::size_t s = _slots[i];
+      _links.forces[s] -= 0.5 * _links.masses[s] * _links.gravity;
+    }
+  };
+  const int id = fields.Add(links, half, true);
+  fields.Add(links, half, true);
+  EXPECT_EQ(fields.Links(id), links);
+
+  world->Step(100);
+  EXPECT_GE(calls, 200);
+  for (auto const &link : links)
+    EXPECT_NEAR(link->WorldPose().Pos().Z(), 5, 1e-6);
+
+  // Removed links are skipped
+  world->RemoveModel("box_0");
+  world->Step(10);
+  EXPECT_NEAR(links[1]->WorldPose().Pos().Z(), 5, 1e-6);
+
+  fields.Clear();
+  EXPECT_EQ(fields.FieldCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,7 +16,11 @@
 */
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <boost/filesystem.hpp>
 #include <ignition/math/Helpers.hh>
 #include <gazebo/gazebo_config.h>
 
@@ -24,7 +28,9 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Image.hh"
 #include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/physics/HeightmapShape.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/transport/transport.hh"
@@ -32,6 +38,15 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Tables with more vertices along each side than this are stored
+/// in tiles, when the shape is tileable.
+static const unsigned int kMaxUntiledVertSize = 4097;
+
+/// \brief Number of vertices along each side of a tile.
+static const unsigned int kTileSize = 64;
+
+/// \brief Number of world updates between two trims of the tiles.
+static const unsigned int kTrimPeriod = 1000;
 
 //////////////////////////////////////////////////
 HeightmapShape::HeightmapShape(CollisionPtr _parent)
@@ -42,12 +57,15 @@ HeightmapShape::HeightmapShape(CollisionPtr _parent)
       std::is_same<HeightType, double>::value,
       "Height field needs to be double or float");
   this->vertSize = 0;
+  this->tileable = false;
+  this->updateCount = 0;
   this->AddType(Base::HEIGHTMAP_SHAPE);
 }
 
 //////////////////////////////////////////////////
 HeightmapShape::~HeightmapShape()
 {
+  this->updateConnection.reset();
   this->requestSub.reset();
   this->responsePub.reset();
   if (this->node)
@@ -246,7 +264,88 @@ void HeightmapShape::Init()
     this->scale.Z() = fabs(terrainSize.Z()) / heightmapSizeZ;
 
   // Construct the heightmap lookup table
-  this->FillHeightfield(this->heights);
+  this->InitHeights();
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::InitHeights()
+{
+  this->tiles.reset();
+  this->updateConnection.reset();
+
+  const char *tilesEnv = getenv("GAZEBO_HEIGHTMAP_TILES");
+  std::string filename = common::find_file(this->GetURI());
+  if (!this->tileable || this->vertSize <= kMaxUntiledVertSize ||
+      (tilesEnv && std::string(tilesEnv) == "0") || filename.empty())
+  {
+    this->FillHeightfield(this->heights);
+    return;
+  }
+
+  // The tile file depends on the terrain file and on the parameters that
+  // are used to sample it.
+  boost::system::error_code ec;
+  std::time_t mtime = boost::filesystem::last_write_time(filename, ec);
+  uintmax_t fileSize = ec ? 0 : boost::filesystem::file_size(filename, ec);
+  if (ec)
+  {
+    this->FillHeightfield(this->heights);
+    return;
+  }
+
+  std::ostringstream key;
+  key << filename << '\n' << mtime << '\n' << fileSize << '\n'
+      << this->subSampling << '\n' << this->Size() << '\n' << this->flipY
+      << '\n' << kTileSize << '\n' << HeightmapTiles::kVersion;
+
+  // 64 bit FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto const c : key.str())
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash
+       << ".tiles";
+  std::string path = (boost::filesystem::path(
+      common::SystemPaths::Instance()->GetLogPath()) / "heightmap_cache" /
+      name.str()).string();
+
+  this->tiles.reset(new HeightmapTiles());
+  if (!this->tiles->Open(path) || this->tiles->VertSize() != this->vertSize)
+  {
+    gzmsg << "Writing heightmap tiles[" << path << "]" << std::endl;
+
+    std::vector<float> table;
+    this->FillHeightfield(table);
+    if (!HeightmapTiles::Write(path, table, this->vertSize, kTileSize) ||
+        !this->tiles->Open(path))
+    {
+      gzwarn << "Unable to use heightmap tiles, the heights are kept in "
+             << "memory" << std::endl;
+      this->tiles.reset();
+      this->heights.assign(table.begin(), table.end());
+      return;
+    }
+  }
+
+  this->heights.clear();
+  this->heights.shrink_to_fit();
+
+  this->updateConnection = event::Events::ConnectWorldUpdateEnd(
+      std::bind(&HeightmapShape::OnWorldUpdateEnd, this));
+}
+
+//////////////////////////////////////////////////
+void HeightmapShape::OnWorldUpdateEnd()
+{
+  if (++this->updateCount < kTrimPeriod)
+    return;
+
+  this->updateCount = 0;
+  this->tiles->Trim();
 }
 
 //////////////////////////////////////////////////
@@ -298,8 +397,8 @@ void HeightmapShape::FillHeights(msgs::Geometry &_msg) const
   {
     for (unsigned int x = 0; x < this->vertSize; ++x)
     {
-      int index = (this->vertSize - y - 1) * this->vertSize + x;
-      _msg.mutable_heightmap()->add_heights(this->heights[index]);
+      _msg.mutable_heightmap()->add_heights(
+          this->GetHeight(x, this->vertSize - y - 1));
     }
   }
 }
@@ -319,6 +418,9 @@ ignition::math::Vector2i HeightmapShape::VertexCount() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 {
+  if (this->tiles)
+    return this->tiles->Height(_x, _y);
+
   int index =  _y * this->vertSize + _x;
   if (_x < 0 || _y < 0 || index >= static_cast<int>(this->heights.size()))
     return 0.0;
@@ -329,6 +431,9 @@ HeightmapShape::HeightType HeightmapShape::GetHeight(int _x, int _y) const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 {
+  if (this->tiles)
+    return this->tiles->MaxHeight();
+
   HeightType max = -std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -342,6 +447,9 @@ HeightmapShape::HeightType HeightmapShape::GetMaxHeight() const
 /////////////////////////////////////////////////
 HeightmapShape::HeightType HeightmapShape::GetMinHeight() const
 {
+  if (this->tiles)
+    return this->tiles->MinHeight();
+
   HeightType min = std::numeric_limits<HeightType>::max();
   for (unsigned int i = 0; i < this->heights.size(); ++i)
   {
@@ -17,16 +17,19 @@
 #ifndef GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 #define GAZEBO_PHYSICS_HEIGHTMAPSHAPE_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <ignition/transport/Node.hh>
 
 #include <ignition/math/Vector2.hh>
 
+#include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/ImageHeightmap.hh"
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/Dem.hh"
 #include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/Shape.hh"
 #include "gazebo/util/system.hh"
@@ -140,6 +143,16 @@ namespace gazebo
       /// \param[in] _msg The request message.
       private: void OnRequest(ConstRequestPtr &_msg);
 
+      /// \brief Construct the height lookup table. Large tables of
+      /// tileable shapes are read from a tile file in the heightmap cache,
+      /// which is written the first time the heightmap is loaded.
+      /// Set the GAZEBO_HEIGHTMAP_TILES environment variable to 0 to
+      /// always keep the table in memory.
+      private: void InitHeights();
+
+      /// \brief Release the tiles that weren't read recently.
+      private: void OnWorldUpdateEnd();
+
       /// \brief Fills the heightmap data (float) into the vector
       /// by calling HeightmapData::FillHeightMap with \e heights
       /// \param[in] heights height field to fill with data.
@@ -148,9 +161,18 @@ namespace gazebo
       /// \brief Version of FillHeightfield() for double vectors.
       public: void FillHeightfield(std::vector<double>& heights);
 
-      /// \brief Lookup table of heights.
+      /// \brief Lookup table of heights. It is empty when the table is
+      /// stored in tiles.
       protected: std::vector<HeightType> heights;
 
+      /// \brief Lookup table of heights stored in tiles, or null if the
+      /// table is in memory.
+      protected: std::unique_ptr<HeightmapTiles> tiles;
+
+      /// \brief True if the physics engine only reads the heights through
+      /// GetHeight(), which allows the table to be stored in tiles.
+      protected: bool tileable;
+
       /// \brief Image used to generate the heights.
       protected: common::ImageHeightmap img;
 
@@ -181,6 +203,13 @@ namespace gazebo
       /// \brief Terrain size
       private: ignition::math::Vector3d heightmapSize;
 
+      /// \brief Connection to the world update end event, used to trim
+      /// the tiles.
+      private: event::ConnectionPtr updateConnection;
+
+      /// \brief Number of world updates since the tiles were trimmed.
+      private: unsigned int updateCount;
+
       #ifdef HAVE_GDAL
       /// \brief DEM used to generate the heights.
       private: common::Dem dem;
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/HeightmapTiles.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Header at the start of a tile file. The tiles follow at
+    /// kDataOffset, in row major order, each one tileSize * tileSize
+    /// floats in row major order.
+    class HeightmapTilesHeader
+    {
+      /// \brief Identifies a tile file.
+      public: uint32_t magic;
+
+      /// \brief Version of the file format.
+      public: uint32_t version;
+
+      /// \brief Number of vertices along each side.
+      public: uint32_t vertSize;
+
+      /// \brief Number of vertices along each side of a tile.
+      public: uint32_t tileSize;
+
+      /// \brief Number of tiles along each side.
+      public: uint32_t tilesPerSide;
+
+      /// \brief Smallest height.
+      public: float minHeight;
+
+      /// \brief Largest height.
+      public: float maxHeight;
+    };
+
+    /// \internal
+    /// \brief Private data for HeightmapTiles
+    class HeightmapTilesPrivate
+    {
+      /// \brief Identifies a tile file.
+      public: static const uint32_t kMagic = 0x6c69746d;
+
+      /// \brief Offset of the first tile, which keeps the tiles page
+      /// aligned.
+      public: static const size_t kDataOffset = 4096;
+
+      /// \brief The mapped file.
+      public: boost::interprocess::mapped_region region;
+
+      /// \brief Header of the mapped file.
+      public: HeightmapTilesHeader header;
+
+      /// \brief Start of the first tile.
+      public: const float *data = nullptr;
+
+      /// \brief Number of floats in a tile.
+      public: size_t tileLength = 0;
+
+      /// \brief For each tile, true if it was read since the last Trim().
+      public: std::unique_ptr<std::atomic<bool>[]> used;
+
+      /// \brief For each tile, true if it may be paged in. Only accessed
+      /// by Trim().
+      public: std::vector<bool> resident;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+HeightmapTiles::HeightmapTiles()
+  : dataPtr(new HeightmapTilesPrivate)
+{
+  std::memset(&this->dataPtr->header, 0, sizeof(this->dataPtr->header));
+}
+
+/////////////////////////////////////////////////
+HeightmapTiles::~HeightmapTiles()
+{
+}
+
+/////////////////////////////////////////////////
+bool HeightmapTiles::Write(const std::string &_path,
+    const std::vector<float> &_heights, const unsigned int _vertSize,
+    const unsigned int _tileSize)
+{
+  if (_vertSize == 0 || _tileSize == 0 ||
+      _heights.size() != static_cast<size_t>(_vertSize) * _vertSize)
+  {
+    gzerr << "Invalid heightmap tile size" << std::endl;
+    return false;
+  }
+
+  HeightmapTilesHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = HeightmapTilesPrivate::kMagic;
+  header.version = kVersion;
+  header.vertSize = _vertSize;
+  header.tileSize = _tileSize;
+  header.tilesPerSide = (_vertSize + _tileSize - 1) / _tileSize;
+  auto range = std::minmax_element(_heights.begin(), _heights.end());
+  header.minHeight = *range.first;
+  header.maxHeight = *range.second;
+
+  // Write to a temporary file and rename it, so that other processes
+  // never see a partial file.
+  boost::system::error_code ec;
+  boost::filesystem::path path(_path);
+  if (path.has_parent_path())
+    boost::filesystem::create_directories(path.parent_path(), ec);
+
+  boost::filesystem::path tmpPath = boost::filesystem::unique_path(
+      _path + ".%%%%-%%%%-%%%%", ec);
+  if (ec)
+    return false;
+
+  {
+    std::ofstream out(tmpPath.string(), std::ios::out | std::ios::binary);
+    std::vector<char> pad(HeightmapTilesPrivate::kDataOffset, 0);
+    std::memcpy(pad.data(), &header, sizeof(header));
+    out.write(pad.data(), pad.size());
+
+    // Vertices of the edge tiles that are past the end of the table are
+    // written as zero.
+    std::vector<float> tile(static_cast<size_t>(_tileSize) * _tileSize);
+    for (unsigned int ty = 0; ty < header.tilesPerSide && out; ++ty)
+    {
+      for (unsigned int tx = 0; tx < header.tilesPerSide && out; ++tx)
+      {
+        std::fill(tile.begin(), tile.end(), 0.0f);
+        const unsigned int x0 = tx * _tileSize;
+        const unsigned int y0 = ty * _tileSize;
+        const unsigned int width = std::min(_tileSize, _vertSize - x0);
+        const unsigned int height = std::min(_tileSize, _vertSize - y0);
+        for (unsigned int y = 0; y < height; ++y)
+        {
+          std::copy_n(&_heights[(y0 + y) * _vertSize + x0], width,
+              &tile[y * _tileSize]);
+        }
+        out.write(reinterpret_cast<const char *>(tile.data()),
+            tile.size() * sizeof(tile[0]));
+      }
+    }
+
+    if (!out)
+    {
+      out.close();
+      boost::filesystem::remove(tmpPath, ec);
+      gzwarn << "Unable to write heightmap tiles[" << _path << "]\n";
+      return false;
+    }
+  }
+
+  boost::filesystem::rename(tmpPath, _path, ec);
+  if (ec)
+  {
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool HeightmapTiles::Open(const std::string &_path)
+{
+  this->Close();
+
+  if (!boost::filesystem::exists(_path))
+    return false;
+
+  boost::interprocess::mapped_region region;
+  try
+  {
+    boost::interprocess::file_mapping file(_path.c_str(),
+        boost::interprocess::read_only);
+    region = boost::interprocess::mapped_region(file,
+        boost::interprocess::read_only);
+  }
+  catch(boost::interprocess::interprocess_exception &)
+  {
+    return false;
+  }
+
+  if (region.get_size() < HeightmapTilesPrivate::kDataOffset)
+    return false;
+
+  HeightmapTilesHeader header;
+  std::memcpy(&header, region.get_address(), sizeof(header));
+  if (header.magic != HeightmapTilesPrivate::kMagic ||
+      header.version != kVersion || header.vertSize == 0 ||
+      header.tileSize == 0 || header.tilesPerSide !=
+      (header.vertSize + header.tileSize - 1) / header.tileSize)
+  {
+    return false;
+  }
+
+  const size_t tileLength =
+      static_cast<size_t>(header.tileSize) * header.tileSize;
+  const size_t tileCount =
+      static_cast<size_t>(header.tilesPerSide) * header.tilesPerSide;
+  if (region.get_size() != HeightmapTilesPrivate::kDataOffset +
+      tileCount * tileLength * sizeof(*this->dataPtr->data))
+  {
+    return false;
+  }
+
+  this->dataPtr->region.swap(region);
+  this->dataPtr->header = header;
+  this->dataPtr->data = reinterpret_cast<const float *>(
+      static_cast<const char *>(this->dataPtr->region.get_address()) +
+      HeightmapTilesPrivate::kDataOffset);
+  this->dataPtr->tileLength = tileLength;
+  this->dataPtr->used.reset(new std::atomic<bool>[tileCount]);
+  for (size_t i = 0; i < tileCount; ++i)
+    this->dataPtr->used[i].store(false, std::memory_order_relaxed);
+  this->dataPtr->resident.assign(tileCount, false);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void HeightmapTiles::Close()
+{
+  boost::interprocess::mapped_region().swap(this->dataPtr->region);
+  std::memset(&this->dataPtr->header, 0, sizeof(this->dataPtr->header));
+  this->dataPtr->data = nullptr;
+  this->dataPtr->tileLength = 0;
+  this->dataPtr->used.reset();
+  this->dataPtr->resident.clear();
+}
+
+/////////////////////////////////////////////////
+bool HeightmapTiles::IsOpen() const
+{
+  return this->dataPtr->data != nullptr;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapTiles::VertSize() const
+{
+  return this->dataPtr->header.vertSize;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapTiles::TileSize() const
+{
+  return this->dataPtr->header.tileSize;
+}
+
+/////////////////////////////////////////////////
+float HeightmapTiles::Height(const int _x, const int _y) const
+{
+  const HeightmapTilesHeader &header = this->dataPtr->header;
+  if (_x < 0 || _y < 0 || static_cast<unsigned int>(_x) >= header.vertSize ||
+      static_cast<unsigned int>(_y) >= header.vertSize)
+  {
+    return 0.0f;
+  }
+
+  const unsigned int tx = _x / header.tileSize;
+  const unsigned int ty = _y / header.tileSize;
+  const size_t tile = static_cast<size_t>(ty) * header.tilesPerSide + tx;
+
+  // Skip the store when the flag is already set, which keeps the cache
+  // line shared between the threads that read the same tile.
+  std::atomic<bool> &used = this->dataPtr->used[tile];
+  if (!used.load(std::memory_order_relaxed))
+    used.store(true, std::memory_order_relaxed);
+
+  const size_t offset = (_y % header.tileSize) * header.tileSize +
+      (_x % header.tileSize);
+  return this->dataPtr->data[tile * this->dataPtr->tileLength + offset];
+}
+
+/////////////////////////////////////////////////
+float HeightmapTiles::MinHeight() const
+{
+  return this->dataPtr->header.minHeight;
+}
+
+/////////////////////////////////////////////////
+float HeightmapTiles::MaxHeight() const
+{
+  return this->dataPtr->header.maxHeight;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapTiles::UsedTileCount() const
+{
+  unsigned int count = 0;
+  for (size_t i = 0; i < this->dataPtr->resident.size(); ++i)
+  {
+    if (this->dataPtr->used[i].load(std::memory_order_relaxed))
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+unsigned int HeightmapTiles::Trim()
+{
+  if (!this->IsOpen())
+    return 0;
+
+#ifndef _WIN32
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+#endif
+
+  unsigned int count = 0;
+  for (size_t i = 0; i < this->dataPtr->resident.size(); ++i)
+  {
+    if (this->dataPtr->used[i].exchange(false, std::memory_order_relaxed))
+    {
+      this->dataPtr->resident[i] = true;
+      continue;
+    }
+
+    if (!this->dataPtr->resident[i])
+      continue;
+    this->dataPtr->resident[i] = false;
+    ++count;
+
+#ifndef _WIN32
+    // Only the pages that lie entirely inside the tile are released.
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(
+        this->dataPtr->data + i * this->dataPtr->tileLength);
+    const uintptr_t end = begin + this->dataPtr->tileLength *
+        sizeof(*this->dataPtr->data);
+    const uintptr_t alignedBegin = (begin + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t alignedEnd = end & ~(pageSize - 1);
+    if (alignedEnd > alignedBegin)
+    {
+      madvise(reinterpret_cast<void *>(alignedBegin),
+          alignedEnd - alignedBegin, MADV_DONTNEED);
+    }
+#endif
+  }
+
+  return count;
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+#define GAZEBO_PHYSICS_HEIGHTMAPTILES_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class HeightmapTilesPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class HeightmapTiles HeightmapTiles.hh physics/physics.hh
+    /// \brief Height lookup table of a heightmap, stored on disk in square
+    /// tiles and read through a memory mapping.
+    ///
+    /// Only the tiles that are read, such as those under the links that
+    /// collide with the terrain, are paged into memory. Trim() gives back
+    /// the memory of the tiles that weren't read since the previous call.
+    /// The file is written once and may be shared by several processes.
+    class GZ_PHYSICS_VISIBLE HeightmapTiles
+    {
+      /// \brief Version of the file format.
+      public: static const uint32_t kVersion = 1;
+
+      /// \brief Constructor
+      public: HeightmapTiles();
+
+      /// \brief Destructor
+      public: virtual ~HeightmapTiles();
+
+      /// \brief Write a tile file.
+      /// \param[in] _path Path of the file. Missing directories are
+      /// created, and the file is written atomically.
+      /// \param[in] _heights Row major heights, _vertSize * _vertSize
+      /// values.
+      /// \param[in] _vertSize Number of vertices along each side.
+      /// \param[in] _tileSize Number of vertices along each side of a
+      /// tile.
+      /// \return True if the file was written.
+      public: static bool Write(const std::string &_path,
+                                const std::vector<float> &_heights,
+                                const unsigned int _vertSize,
+                                const unsigned int _tileSize);
+
+      /// \brief Map a tile file written by Write().
+      /// \param[in] _path Path of the file.
+      /// \return True if the file is a valid tile file.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Close the file.
+      public: void Close();
+
+      /// \brief Get whether a file is open.
+      /// \return True if a file is open.
+      public: bool IsOpen() const;
+
+      /// \brief Get the number of vertices along each side.
+      /// \return Number of vertices, or 0 if no file is open.
+      public: unsigned int VertSize() const;
+
+      /// \brief Get the number of vertices along each side of a tile.
+      /// \return Number of vertices, or 0 if no file is open.
+      public: unsigned int TileSize() const;
+
+      /// \brief Get the height of a vertex.
+      /// \param[in] _x Column of the vertex.
+      /// \param[in] _y Row of the vertex.
+      /// \return The height, or 0 outside of the table.
+      public: float Height(const int _x, const int _y) const;
+
+      /// \brief Get the smallest height of the table.
+      /// \return Smallest height.
+      public: float MinHeight() const;
+
+      /// \brief Get the largest height of the table.
+      /// \return Largest height.
+      public: float MaxHeight() const;
+
+      /// \brief Get the number of tiles read since the last call to
+      /// Trim().
+      /// \return Number of tiles.
+      public: unsigned int UsedTileCount() const;
+
+      /// \brief Release the memory of the tiles that weren't read since
+      /// the last call. They are paged in again when they are read.
+      /// \return Number of tiles released.
+      public: unsigned int Trim();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<HeightmapTilesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
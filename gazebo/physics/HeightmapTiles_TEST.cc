@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/physics/HeightmapTiles.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+class HeightmapTiles_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTiles_TEST, WriteOpen)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_tiles_%%%%-%%%%");
+  const std::string path = (dir / "terrain.tiles").string();
+
+  // 65 vertices in tiles of 32 leaves a partial tile on each edge
+  const unsigned int vertSize = 65;
+  std::vector<float> heights(vertSize * vertSize);
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    for (unsigned int x = 0; x < vertSize; ++x)
+      heights[y * vertSize + x] = x * 0.5f - y * 0.25f;
+  }
+
+  ASSERT_TRUE(physics::HeightmapTiles::Write(path, heights, vertSize, 32));
+  EXPECT_FALSE(physics::HeightmapTiles::Write(path, heights, vertSize + 1,
+      32));
+
+  physics::HeightmapTiles tiles;
+  EXPECT_FALSE(tiles.IsOpen());
+  EXPECT_EQ(0.0f, tiles.Height(0, 0));
+  ASSERT_TRUE(tiles.Open(path));
+  EXPECT_TRUE(tiles.IsOpen());
+  EXPECT_EQ(vertSize, tiles.VertSize());
+  EXPECT_EQ(32u, tiles.TileSize());
+  EXPECT_FLOAT_EQ(-16.0f, tiles.MinHeight());
+  EXPECT_FLOAT_EQ(32.0f, tiles.MaxHeight());
+  EXPECT_EQ(0u, tiles.UsedTileCount());
+
+  for (unsigned int y = 0; y < vertSize; ++y)
+  {
+    for (unsigned int x = 0; x < vertSize; ++x)
+      EXPECT_EQ(heights[y * vertSize + x], tiles.Height(x, y));
+  }
+  EXPECT_EQ(0.0f, tiles.Height(-1, 0));
+  EXPECT_EQ(0.0f, tiles.Height(0, vertSize));
+  EXPECT_EQ(9u, tiles.UsedTileCount());
+
+  // The first trim records the tiles that were read, the second releases
+  // those that weren't read since.
+  EXPECT_EQ(0u, tiles.Trim());
+  EXPECT_EQ(0u, tiles.UsedTileCount());
+  EXPECT_FLOAT_EQ(heights[0], tiles.Height(0, 0));
+  EXPECT_EQ(1u, tiles.UsedTileCount());
+  EXPECT_EQ(8u, tiles.Trim());
+  EXPECT_EQ(1u, tiles.Trim());
+  EXPECT_EQ(0u, tiles.Trim());
+
+  // Released tiles are read back from the file
+  EXPECT_FLOAT_EQ(heights[64 * vertSize + 64], tiles.Height(64, 64));
+
+  tiles.Close();
+  EXPECT_FALSE(tiles.IsOpen());
+  EXPECT_EQ(0u, tiles.VertSize());
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(HeightmapTiles_TEST, InvalidFile)
+{
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_tiles_%%%%-%%%%");
+  boost::filesystem::create_directories(dir);
+
+  physics::HeightmapTiles tiles;
+  EXPECT_FALSE(tiles.Open((dir / "missing.tiles").string()));
+
+  const std::string path = (dir / "bad.tiles").string();
+  {
+    std::ofstream out(path, std::ios::out | std::ios::binary);
+    std::vector<char> data(8192, 1);
+    out.write(data.data(), data.size());
+  }
+  EXPECT_FALSE(tiles.Open(path));
+  EXPECT_FALSE(tiles.IsOpen());
+
+  // A truncated file is rejected
+  std::vector<float> heights(33 * 33, 1.0f);
+  ASSERT_TRUE(physics::HeightmapTiles::Write(path, heights, 33, 32));
+  EXPECT_TRUE(tiles.Open(path));
+  tiles.Close();
+  boost::filesystem::resize_file(path, 4096 + 100);
+  EXPECT_FALSE(tiles.Open(path));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
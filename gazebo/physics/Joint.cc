@@ -15,6 +15,10 @@
  *
 */
 
+#include <functional>
+#include <map>
+#include <set>
+
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Publisher.hh"
 
@@ -689,8 +693,12 @@ double Joint::Position(const unsigned int _index) const
 {
   if (this->model->IsStatic())
     return this->staticPosition;
-  else
-    return this->PositionImpl(_index);
+
+  double position;
+  if (this->model->CachedJointPosition(*this, _index, position))
+    return position;
+
+  return this->PositionImpl(_index);
 }
 
 //////////////////////////////////////////////////
@@ -834,6 +842,123 @@ bool Joint::SetPositionMaximal(
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Joint::SetPositionsMaximal(
+    const std::vector<std::pair<JointPtr, double>> &_positions,
+    const bool _preserveWorldVelocity)
+{
+  // Motion of the links of each joint, as a world frame transform applied
+  // to their poses, and the links moved by any of the joints
+  std::map<const Joint *, ignition::math::Pose3d> jointMotions;
+  std::set<const Link *> moved;
+  Link_V links;
+  for (auto const &target : _positions)
+  {
+    const JointPtr &joint = target.first;
+    if (!joint || !joint->childLink || !joint->model ||
+        joint->model->IsStatic() ||
+        !(joint->HasType(Base::HINGE_JOINT) ||
+          joint->HasType(Base::UNIVERSAL_JOINT) ||
+          joint->HasType(Base::SLIDER_JOINT)))
+    {
+      return false;
+    }
+
+    // truncate position by joint limits
+    double position = target.second;
+    double lower = joint->LowerLimit(0);
+    double upper = joint->UpperLimit(0);
+    if (lower < upper)
+      position = ignition::math::clamp(position, lower, upper);
+    else
+      position = ignition::math::clamp(position, upper, lower);
+
+    jointMotions[joint.get()] = joint->childLink->WorldPose().Inverse() +
+        joint->ChildLinkPose(0, position);
+
+    Link_V stack(1, joint->childLink);
+    while (!stack.empty())
+    {
+      LinkPtr link = stack.back();
+      stack.pop_back();
+      if (!moved.insert(link.get()).second)
+        continue;
+      links.push_back(link);
+      for (auto const &childJoint : link->GetChildJoints())
+      {
+        if (childJoint->GetChild())
+          stack.push_back(childJoint->GetChild());
+      }
+    }
+  }
+
+  // The motion of a link is the motion of its parent link, after the
+  // motion of the joint between them. A link with several parent joints,
+  // or whose parents lead back to it, is inside a loop.
+  std::map<const Link *, ignition::math::Pose3d> linkMotions;
+  std::set<const Link *> visiting;
+  std::function<bool (const LinkPtr &)> computeMotion =
+      [&](const LinkPtr &_link)
+  {
+    if (linkMotions.count(_link.get()))
+      return true;
+
+    Joint_V parentJoints = _link->GetParentJoints();
+    if (parentJoints.size() != 1 || !visiting.insert(_link.get()).second)
+      return false;
+
+    const JointPtr &parentJoint = parentJoints[0];
+    ignition::math::Pose3d motion;
+    auto jointMotion = jointMotions.find(parentJoint.get());
+    if (jointMotion != jointMotions.end())
+      motion = jointMotion->second;
+
+    LinkPtr parentLink = parentJoint->GetParent();
+    if (parentLink && moved.count(parentLink.get()))
+    {
+      if (!computeMotion(parentLink))
+        return false;
+      motion = motion + linkMotions[parentLink.get()];
+    }
+
+    linkMotions[_link.get()] = motion;
+    return true;
+  };
+
+  std::vector<ignition::math::Pose3d> poses;
+  poses.reserve(links.size());
+  for (auto const &link : links)
+  {
+    if (!computeMotion(link))
+    {
+      gzwarn << "failed to find a clean set of connected links,"
+             << " i.e. a joint is inside a loop, cannot SetPosition"
+             << " kinematically.
+";
+      return false;
+    }
+    poses.push_back(link->WorldPose() + linkMotions[link.get()]);
+  }
+
+  if (links.empty())
+    return true;
+
+  // block any other physics pose updates
+  boost::recursive_mutex::scoped_lock lock(
+    *links[0]->GetWorld()->Physics()->GetPhysicsUpdateMutex());
+
+  for (std::size_t i = 0; i < links.size(); ++i)
+  {
+    links[i]->SetWorldPose(poses[i]);
+    if (!_preserveWorldVelocity)
+    {
+      links[i]->SetWorldTwist(ignition::math::Vector3d::Zero,
+        ignition::math::Vector3d::Zero);
+    }
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool Joint::SetVelocityMaximal(unsigned int _index, double _velocity)
 {
@@ -920,6 +1045,7 @@ bool Joint::SetVelocityMaximal(unsigned int _index, double _velocity)
     return false;
   }
 
+  this->model->InvalidateJointStates();
   return true;
 }
 
@@ -931,6 +1057,7 @@ void Joint::SetState(const JointState &_state)
     this->SetVelocity(i, 0.0);
     this->SetPosition(i, _state.Position(i));
   }
+  this->model->InvalidateJointStates();
 }
 
 //////////////////////////////////////////////////
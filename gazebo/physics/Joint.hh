@@ -18,6 +18,7 @@
 #define GAZEBO_PHYSICS_JOINT_HH_
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/any.hpp>
@@ -364,6 +365,22 @@ namespace gazebo
                   const unsigned int _index, const double _position,
                   const bool _preserveWorldVelocity = false);
 
+      /// \brief Set the positions of joints of a maximal coordinate solver
+      /// with a single pass over their links. The motion of the links of
+      /// each joint is computed about the current configuration, as
+      /// SetPositionMaximal does, and the motions are composed from the
+      /// parents down, so that every link is moved once. Only the first
+      /// axis of each joint is set.
+      /// \param[in] _positions Joints and their positions.
+      /// \param[in] _preserveWorldVelocity True to preserve the world
+      /// velocities of the links, default is false.
+      /// \return False if a joint isn't a hinge, universal or slider joint
+      /// of a dynamic model, or if its links aren't a tree. Nothing is moved
+      /// then.
+      public: static bool SetPositionsMaximal(
+                  const std::vector<std::pair<JointPtr, double>> &_positions,
+                  const bool _preserveWorldVelocity = false);
+
       /// \brief Helper function for maximal coordinate solver SetPosition.
       /// The child links of this joint are updated based on position change.
       /// And all the links connected to the child link of this joint
@@ -718,6 +735,9 @@ namespace gazebo
       /// \brief Position used when the joint is parent of a static model.
       private: double staticPosition;
 
+      /// \brief The model fills the joint state cache.
+      private: friend class Model;
+
       /// \brief Joint stop stiffness
       private: double stopStiffness[MAX_JOINT_AXIS];
 
@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <boost/algorithm/string.hpp>
 
 #include "gazebo/transport/Node.hh"
@@ -31,6 +33,11 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Bits of the controls set on a joint.
+static const uint8_t kForceControl = 1;
+static const uint8_t kPositionControl = 2;
+static const uint8_t kVelocityControl = 4;
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -69,21 +76,51 @@ JointController::~JointController()
 /////////////////////////////////////////////////
 void JointController::AddJoint(JointPtr _joint)
 {
-  this->dataPtr->joints[_joint->GetScopedName()] = _joint;
-  this->dataPtr->posPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
-  this->dataPtr->velPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
+  auto index = this->dataPtr->indices.insert(std::make_pair(
+      _joint->GetScopedName(), this->dataPtr->joints.size()));
+  const std::size_t i = index.first->second;
+  if (index.second)
+  {
+    this->dataPtr->joints.push_back(_joint);
+    this->dataPtr->posPids.push_back(common::PID());
+    this->dataPtr->velPids.push_back(common::PID());
+    this->dataPtr->forces.push_back(0);
+    this->dataPtr->positions.push_back(0);
+    this->dataPtr->velocities.push_back(0);
+    this->dataPtr->controls.push_back(0);
+  }
+  else
+    this->dataPtr->joints[i] = _joint;
+
+  this->dataPtr->posPids[i].Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
+  this->dataPtr->velPids[i].Init(1, 0.1, 0.01, 1, -1, 1000, -1000);
 }
 
 /////////////////////////////////////////////////
 void JointController::RemoveJoint(Joint *_joint)
 {
-  if (_joint)
+  if (!_joint)
+    return;
+
+  auto index = this->dataPtr->indices.find(_joint->GetScopedName());
+  if (index == this->dataPtr->indices.end())
+    return;
+
+  const std::size_t i = index->second;
+  this->dataPtr->indices.erase(index);
+  this->dataPtr->joints.erase(this->dataPtr->joints.begin() + i);
+  this->dataPtr->posPids.erase(this->dataPtr->posPids.begin() + i);
+  this->dataPtr->velPids.erase(this->dataPtr->velPids.begin() + i);
+  this->dataPtr->forces.erase(this->dataPtr->forces.begin() + i);
+  this->dataPtr->positions.erase(this->dataPtr->positions.begin() + i);
+  this->dataPtr->velocities.erase(this->dataPtr->velocities.begin() + i);
+  this->dataPtr->controls.erase(this->dataPtr->controls.begin() + i);
+
+  // The joints after the removed one move down
+  for (auto &other : this->dataPtr->indices)
   {
-    this->dataPtr->joints.erase(_joint->GetScopedName());
-    this->dataPtr->posPids.erase(_joint->GetScopedName());
-    this->dataPtr->velPids.erase(_joint->GetScopedName());
+    if (other.second > i)
+      --other.second;
   }
 }
 
@@ -91,23 +128,14 @@ void JointController::RemoveJoint(Joint *_joint)
 void JointController::Reset()
 {
   // Reset setpoints and feed-forward.
-  this->dataPtr->positions.clear();
-  this->dataPtr->velocities.clear();
-  this->dataPtr->forces.clear();
+  std::fill(this->dataPtr->controls.begin(), this->dataPtr->controls.end(),
+      0);
 
-  std::map<std::string, common::PID>::iterator iter;
+  for (auto &pid : this->dataPtr->posPids)
+    pid.Reset();
 
-  for (iter = this->dataPtr->posPids.begin();
-    iter != this->dataPtr->posPids.end(); ++iter)
-  {
-    iter->second.Reset();
-  }
-
-  for (iter = this->dataPtr->velPids.begin();
-    iter != this->dataPtr->velPids.end(); ++iter)
-  {
-    iter->second.Reset();
-  }
+  for (auto &pid : this->dataPtr->velPids)
+    pid.Reset();
 }
 
 /////////////////////////////////////////////////
@@ -121,65 +149,34 @@ void JointController::Update()
   // Negative update time wreaks havok on the integrators.
   // This happens when World::ResetTime is called.
   // TODO: fix this when World::ResetTime is improved
-  if (stepTime > 0)
-  {
-    if (!this->dataPtr->forces.empty())
-    {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
-    }
+  if (stepTime <= 0)
+    return;
 
-    if (!this->dataPtr->positions.empty())
-    {
-      std::map<std::string, double>::iterator iter;
+  // The force, then the position and velocity commands, are added to each
+  // joint
+  const std::size_t count = this->dataPtr->joints.size();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const uint8_t controls = this->dataPtr->controls[i];
+    if (!controls)
+      continue;
 
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
-      {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->Position(0) -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
-    }
+    Joint *joint = this->dataPtr->joints[i].get();
+    if (controls & kForceControl)
+      joint->SetForce(0, this->dataPtr->forces[i]);
 
-    if (!this->dataPtr->velocities.empty())
+    if (controls & kPositionControl)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
-      {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      joint->SetForce(0, this->dataPtr->posPids[i].Update(
+          joint->Position(0) - this->dataPtr->positions[i], stepTime));
     }
-  }
 
-  /* enable below if we want to set position kinematically
-  if (this->dataPtr->positions.size() > 0)
-  {
-    std::map<std::string, JointPtr>::iterator iter;
-    for (iter = this->dataPtr->joints.begin();
-         iter != this->dataPtr->joints.end(); ++iter)
+    if (controls & kVelocityControl)
     {
-      if (this->dataPtr->positions.find(iter->first) ==
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions[iter->first] =
-          iter->second->Position(0);
-      }
+      joint->SetForce(0, this->dataPtr->velPids[i].Update(
+          joint->GetVelocity(0) - this->dataPtr->velocities[i], stepTime));
     }
-    this->SetJointPositions(this->dataPtr->positions);
-    this->dataPtr->positions.clear();
   }
-  */
 }
 
 /////////////////////////////////////////////////
@@ -189,228 +186,217 @@ bool JointController::OnJointCmdReq(const ignition::msgs::StringMsg &_req,
   const std::string &jointName = _req.data();
   _rep.set_name(jointName);
 
-  if (this->dataPtr->forces.find(jointName) !=
-      this->dataPtr->forces.end())
-  {
-    _rep.mutable_force_optional()->set_data(this->dataPtr->forces[jointName]);
-  }
+  auto index = this->dataPtr->indices.find(jointName);
+  if (index == this->dataPtr->indices.end())
+    return true;
+
+  const std::size_t i = index->second;
+  const uint8_t controls = this->dataPtr->controls[i];
+  if (controls & kForceControl)
+    _rep.mutable_force_optional()->set_data(this->dataPtr->forces[i]);
 
-  if (this->dataPtr->positions.find(jointName) !=
-      this->dataPtr->positions.end())
+  if (controls & kPositionControl)
   {
     _rep.mutable_position()->mutable_target_optional()->set_data(
-        this->dataPtr->positions[jointName]);
+        this->dataPtr->positions[i]);
   }
 
-  if (this->dataPtr->velocities.find(jointName) !=
-      this->dataPtr->velocities.end())
+  if (controls & kVelocityControl)
   {
     _rep.mutable_velocity()->mutable_target_optional()->set_data(
-        this->dataPtr->velocities[jointName]);
+        this->dataPtr->velocities[i]);
   }
 
-  if (this->dataPtr->posPids.find(jointName) !=
-      this->dataPtr->posPids.end())
-  {
-    _rep.mutable_position()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetPGain());
-    _rep.mutable_position()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetDGain());
-    _rep.mutable_position()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->posPids[jointName].GetIGain());
-  }
-
-  if (this->dataPtr->velPids.find(jointName) !=
-      this->dataPtr->velPids.end())
-  {
-    _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetPGain());
-    _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetDGain());
-    _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
-        this->dataPtr->velPids[jointName].GetIGain());
-  }
+  const common::PID &posPid = this->dataPtr->posPids[i];
+  _rep.mutable_position()->mutable_p_gain_optional()->set_data(
+      posPid.GetPGain());
+  _rep.mutable_position()->mutable_d_gain_optional()->set_data(
+      posPid.GetDGain());
+  _rep.mutable_position()->mutable_i_gain_optional()->set_data(
+      posPid.GetIGain());
+
+  const common::PID &velPid = this->dataPtr->velPids[i];
+  _rep.mutable_velocity()->mutable_p_gain_optional()->set_data(
+      velPid.GetPGain());
+  _rep.mutable_velocity()->mutable_d_gain_optional()->set_data(
+      velPid.GetDGain());
+  _rep.mutable_velocity()->mutable_i_gain_optional()->set_data(
+      velPid.GetIGain());
 
   return true;
 }
 
 /////////////////////////////////////////////////
-void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
+/// \brief Apply the PID fields of a joint command.
+/// \param[in] _msg PID fields of the command.
+/// \param[in,out] _pid The controller.
+static void applyPid(const ignition::msgs::PID &_msg,
+    common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_msg.name());
-  if (iter != this->dataPtr->joints.end())
-  {
-    if (_msg.reset())
-    {
-      if (this->dataPtr->forces.find(_msg.name()) !=
-          this->dataPtr->forces.end())
-      {
-        this->dataPtr->forces.erase(this->dataPtr->forces.find(_msg.name()));
-      }
-
-      if (this->dataPtr->positions.find(_msg.name()) !=
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions.erase(
-            this->dataPtr->positions.find(_msg.name()));
-      }
+  if (_msg.has_p_gain_optional())
+    _pid.SetPGain(_msg.p_gain_optional().data());
 
-      if (this->dataPtr->velocities.find(_msg.name()) !=
-          this->dataPtr->velocities.end())
-      {
-        this->dataPtr->velocities.erase(
-            this->dataPtr->velocities.find(_msg.name()));
-      }
-    }
+  if (_msg.has_i_gain_optional())
+    _pid.SetIGain(_msg.i_gain_optional().data());
 
-    if (_msg.has_force_optional())
-      this->dataPtr->forces[_msg.name()] = _msg.force_optional().data();
+  if (_msg.has_d_gain_optional())
+    _pid.SetDGain(_msg.d_gain_optional().data());
 
-    if (_msg.has_position())
-    {
-      if (_msg.position().has_target_optional())
-      {
-        if (!this->SetPositionTarget(_msg.name(),
-            _msg.position().target_optional().data()))
-        {
-          gzerr << "Unable to set position target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
-      }
+  if (_msg.has_i_max_optional())
+    _pid.SetIMax(_msg.i_max_optional().data());
 
-      if (_msg.position().has_p_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetPGain(
-            _msg.position().p_gain_optional().data());
-      }
+  if (_msg.has_i_min_optional())
+    _pid.SetIMin(_msg.i_min_optional().data());
 
-      if (_msg.position().has_i_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIGain(
-            _msg.position().i_gain_optional().data());
-      }
+  if (_msg.has_limit_optional())
+  {
+    _pid.SetCmdMax(_msg.limit_optional().data());
+    _pid.SetCmdMin(-_msg.limit_optional().data());
+  }
+}
 
-      if (_msg.position().has_d_gain_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetDGain(
-            _msg.position().d_gain_optional().data());
-      }
+/////////////////////////////////////////////////
+void JointController::OnJointCommand(const ignition::msgs::JointCmd &_msg)
+{
+  auto index = this->dataPtr->indices.find(_msg.name());
+  if (index == this->dataPtr->indices.end())
+  {
+    gzerr << "Unable to find joint[" << _msg.name() << "]\n";
+    return;
+  }
 
-      if (_msg.position().has_i_max_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMax(
-            _msg.position().i_max_optional().data());
-      }
+  const std::size_t i = index->second;
+  if (_msg.reset())
+    this->dataPtr->controls[i] = 0;
 
-      if (_msg.position().has_i_min_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetIMin(
-            _msg.position().i_min_optional().data());
-      }
+  if (_msg.has_force_optional())
+  {
+    this->dataPtr->forces[i] = _msg.force_optional().data();
+    this->dataPtr->controls[i] |= kForceControl;
+  }
 
-      if (_msg.position().has_limit_optional())
-      {
-        this->dataPtr->posPids[_msg.name()].SetCmdMax(
-            _msg.position().limit_optional().data());
-        this->dataPtr->posPids[_msg.name()].SetCmdMin(
-            -_msg.position().limit_optional().data());
-      }
+  if (_msg.has_position())
+  {
+    if (_msg.position().has_target_optional())
+    {
+      this->dataPtr->positions[i] = _msg.position().target_optional().data();
+      this->dataPtr->controls[i] |= kPositionControl;
     }
+    applyPid(_msg.position(), this->dataPtr->posPids[i]);
+  }
 
-    if (_msg.has_velocity())
+  if (_msg.has_velocity())
+  {
+    if (_msg.velocity().has_target_optional())
     {
-      if (_msg.velocity().has_target_optional())
-      {
-        if (!this->SetVelocityTarget(_msg.name(),
-            _msg.velocity().target_optional().data()))
-        {
-          gzerr << "Unable to set velocity target for joint["
-            << _msg.name() << "]. Joint is not found.\n";
-        }
-      }
-
-      if (_msg.velocity().has_p_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetPGain(
-            _msg.velocity().p_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_i_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIGain(
-            _msg.velocity().i_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_d_gain_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetDGain(
-            _msg.velocity().d_gain_optional().data());
-      }
-
-      if (_msg.velocity().has_i_max_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIMax(
-            _msg.velocity().i_max_optional().data());
-      }
-
-      if (_msg.velocity().has_i_min_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetIMin(
-            _msg.velocity().i_min_optional().data());
-      }
-
-      if (_msg.velocity().has_limit_optional())
-      {
-        this->dataPtr->velPids[_msg.name()].SetCmdMax(
-            _msg.velocity().limit_optional().data());
-        this->dataPtr->velPids[_msg.name()].SetCmdMin(
-            -_msg.velocity().limit_optional().data());
-      }
+      this->dataPtr->velocities[i] =
+          _msg.velocity().target_optional().data();
+      this->dataPtr->controls[i] |= kVelocityControl;
     }
+    applyPid(_msg.velocity(), this->dataPtr->velPids[i]);
   }
-  else
-    gzerr << "Unable to find joint[" << _msg.name() << "]\n";
 }
 
 //////////////////////////////////////////////////
 void JointController::SetJointPosition(const std::string & _name,
                                        double _position, int _index)
 {
-  std::map<std::string, JointPtr>::iterator jiter =
-    this->dataPtr->joints.find(_name);
-
-  if (jiter != this->dataPtr->joints.end())
-    this->SetJointPosition(jiter->second, _position, _index);
+  auto index = this->dataPtr->indices.find(_name);
+  if (index != this->dataPtr->indices.end())
+  {
+    this->SetJointPosition(this->dataPtr->joints[index->second], _position,
+        _index);
+  }
   else
     gzwarn << "SetJointPosition [" << _name << "] not found\n";
 }
 
+/////////////////////////////////////////////////
+/// \brief Set the positions of joints. ODE sets a position by moving the
+/// links of the joint, so there the links are moved once for all the
+/// joints, see Joint::SetPositionsMaximal.
+/// \param[in] _model Model of the joints.
+/// \param[in] _positions Joints and their positions.
+static void setJointPositions(const ModelPtr &_model,
+    const std::vector<std::pair<JointPtr, double>> &_positions)
+{
+  std::vector<std::pair<JointPtr, double>> single;
+  WorldPtr world = _model->GetWorld();
+  if (world && world->Physics() && world->Physics()->GetType() == "ode" &&
+      !_model->IsStatic())
+  {
+    // ODEJoint::SetPosition sets the cumulative angle of hinges beyond
+    // [-pi, pi], so these are set one at a time
+    std::vector<std::pair<JointPtr, double>> batch;
+    for (auto const &position : _positions)
+    {
+      if (position.first->HasType(Base::HINGE_JOINT) &&
+          std::abs(position.second) >= M_PI)
+      {
+        single.push_back(position);
+      }
+      else
+        batch.push_back(position);
+    }
+
+    if (!Joint::SetPositionsMaximal(batch))
+      single = _positions;
+  }
+  else
+    single = _positions;
+
+  for (auto const &position : single)
+    position.first->SetPosition(0, position.second);
+}
+
 //////////////////////////////////////////////////
 void JointController::SetJointPositions(
     const std::map<std::string, double> & _jointPositions)
 {
-  // go through all joints in this model and update each one
-  //   for each joint update, recursively update all children
-  std::map<std::string, JointPtr>::iterator iter;
-  std::map<std::string, double>::const_iterator jiter;
-
-  for (iter = this->dataPtr->joints.begin();
-      iter != this->dataPtr->joints.end(); ++iter)
+  std::vector<std::pair<JointPtr, double>> positions;
+  for (auto const &joint : this->dataPtr->joints)
   {
     // First try name without scope, i.e. joint_name
-    jiter = _jointPositions.find(iter->second->GetName());
+    auto jiter = _jointPositions.find(joint->GetName());
 
     if (jiter == _jointPositions.end())
     {
       // Second try name with scope, i.e. model_name::joint_name
-      jiter = _jointPositions.find(iter->second->GetScopedName());
+      jiter = _jointPositions.find(joint->GetScopedName());
       if (jiter == _jointPositions.end())
         continue;
     }
 
-    this->SetJointPosition(iter->second, jiter->second);
+    positions.push_back(std::make_pair(joint, jiter->second));
   }
+
+  setJointPositions(this->dataPtr->model, positions);
+}
+
+//////////////////////////////////////////////////
+bool JointController::SetJointPositions(
+    const std::vector<double> &_positions)
+{
+  if (_positions.size() != this->dataPtr->joints.size())
+  {
+    gzerr << "SetJointPositions given " << _positions.size()
+          << " positions for " << this->dataPtr->joints.size()
+          << " joints\n";
+    return false;
+  }
+
+  std::vector<std::pair<JointPtr, double>> positions;
+  for (std::size_t i = 0; i < _positions.size(); ++i)
+  {
+    if (!std::isnan(_positions[i]))
+    {
+      positions.push_back(std::make_pair(this->dataPtr->joints[i],
+          _positions[i]));
+    }
+  }
+
+  setJointPositions(this->dataPtr->model, positions);
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -429,77 +415,243 @@ common::Time JointController::GetLastUpdateTime() const
 /////////////////////////////////////////////////
 std::map<std::string, JointPtr> JointController::GetJoints() const
 {
-  return this->dataPtr->joints;
+  std::map<std::string, JointPtr> joints;
+  for (auto const &index : this->dataPtr->indices)
+    joints[index.first] = this->dataPtr->joints[index.second];
+  return joints;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> JointController::JointNames() const
+{
+  std::vector<std::string> names(this->dataPtr->joints.size());
+  for (auto const &index : this->dataPtr->indices)
+    names[index.second] = index.first;
+  return names;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetPositionPIDs() const
 {
-  return this->dataPtr->posPids;
+  std::map<std::string, common::PID> pids;
+  for (auto const &index : this->dataPtr->indices)
+    pids[index.first] = this->dataPtr->posPids[index.second];
+  return pids;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetVelocityPIDs() const
 {
-  return this->dataPtr->velPids;
+  std::map<std::string, common::PID> pids;
+  for (auto const &index : this->dataPtr->indices)
+    pids[index.first] = this->dataPtr->velPids[index.second];
+  return pids;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the values of the joints that have a control.
+/// \param[in] _data Private data of the controller.
+/// \param[in] _values Values of the control, by index of joint.
+/// \param[in] _control Bit of the control.
+/// \return Values of the joints that have the control, by scoped name.
+static std::map<std::string, double> controlValues(
+    const JointControllerPrivate &_data, const std::vector<double> &_values,
+    const uint8_t _control)
+{
+  std::map<std::string, double> values;
+  for (auto const &index : _data.indices)
+  {
+    if (_data.controls[index.second] & _control)
+      values[index.first] = _values[index.second];
+  }
+  return values;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetForces() const
 {
-  return this->dataPtr->forces;
+  return controlValues(*this->dataPtr, this->dataPtr->forces,
+      kForceControl);
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetPositions() const
 {
-  return this->dataPtr->positions;
+  return controlValues(*this->dataPtr, this->dataPtr->positions,
+      kPositionControl);
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetVelocities() const
 {
-  return this->dataPtr->velocities;
+  return controlValues(*this->dataPtr, this->dataPtr->velocities,
+      kVelocityControl);
+}
+
+//////////////////////////////////////////////////
+void JointController::SaveSnapshot(std::vector<double> &_data) const
+{
+  _data.push_back(this->dataPtr->prevUpdateTime.sec);
+  _data.push_back(this->dataPtr->prevUpdateTime.nsec);
+  _data.push_back(this->dataPtr->joints.size());
+
+  // Each target is saved with a flag that tells whether it is set.
+  auto saveTarget = [&_data](const uint8_t _controls, const uint8_t _control,
+      const double _value)
+  {
+    _data.push_back((_controls & _control) ? 1.0 : 0.0);
+    _data.push_back((_controls & _control) ? _value : 0.0);
+  };
+
+  auto savePid = [&_data](const common::PID &_pid)
+  {
+    double state[common::PID::kStateSize] = {0};
+    _pid.State(state);
+    _data.insert(_data.end(), state, state + common::PID::kStateSize);
+  };
+
+  for (std::size_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    const uint8_t controls = this->dataPtr->controls[i];
+    saveTarget(controls, kPositionControl, this->dataPtr->positions[i]);
+    savePid(this->dataPtr->posPids[i]);
+    saveTarget(controls, kVelocityControl, this->dataPtr->velocities[i]);
+    savePid(this->dataPtr->velPids[i]);
+    saveTarget(controls, kForceControl, this->dataPtr->forces[i]);
+  }
+}
+
+//////////////////////////////////////////////////
+bool JointController::RestoreSnapshot(const double *&_data,
+    const double *_end)
+{
+  const std::size_t jointSize = 6 + 2 * common::PID::kStateSize;
+  if (_end - _data < 3 ||
+      static_cast<std::size_t>(_data[2]) != this->dataPtr->joints.size() ||
+      static_cast<std::size_t>(_end - _data - 3) <
+      jointSize * this->dataPtr->joints.size())
+  {
+    return false;
+  }
+
+  this->dataPtr->prevUpdateTime.Set(static_cast<int32_t>(_data[0]),
+      static_cast<int32_t>(_data[1]));
+  _data += 3;
+
+  auto restoreTarget = [&_data](uint8_t &_controls, const uint8_t _control,
+      double &_value)
+  {
+    if (_data[0] != 0.0)
+    {
+      _controls |= _control;
+      _value = _data[1];
+    }
+    else
+      _controls &= ~_control;
+    _data += 2;
+  };
+
+  auto restorePid = [&_data](common::PID &_pid)
+  {
+    _pid.SetState(_data);
+    _data += common::PID::kStateSize;
+  };
+
+  for (std::size_t i = 0; i < this->dataPtr->joints.size(); ++i)
+  {
+    uint8_t &controls = this->dataPtr->controls[i];
+    restoreTarget(controls, kPositionControl, this->dataPtr->positions[i]);
+    restorePid(this->dataPtr->posPids[i]);
+    restoreTarget(controls, kVelocityControl, this->dataPtr->velocities[i]);
+    restorePid(this->dataPtr->velPids[i]);
+    restoreTarget(controls, kForceControl, this->dataPtr->forces[i]);
+  }
+  return true;
 }
 
 //////////////////////////////////////////////////
 void JointController::SetPositionPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
-
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->posPids[_jointName] = _pid;
+  auto index = this->dataPtr->indices.find(_jointName);
+  if (index != this->dataPtr->indices.end())
+    this->dataPtr->posPids[index->second] = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
 
 /////////////////////////////////////////////////
-bool JointController::SetPositionTarget(const std::string &_jointName,
-    const double _target)
+/// \brief Set a control of a joint.
+/// \param[in,out] _data Private data of the controller.
+/// \param[in] _jointName Scoped name of the joint.
+/// \param[in,out] _values Values of the control, by index of joint.
+/// \param[in] _control Bit of the control.
+/// \param[in] _value Value of the control.
+/// \return False if the joint was not found.
+static bool setControl(JointControllerPrivate &_data,
+    const std::string &_jointName, std::vector<double> &_values,
+    const uint8_t _control, const double _value)
+{
+  auto index = _data.indices.find(_jointName);
+  if (index == _data.indices.end())
+    return false;
+
+  _values[index->second] = _value;
+  _data.controls[index->second] |= _control;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Set a control of all the joints.
+/// \param[in,out] _data Private data of the controller.
+/// \param[in,out] _values Values of the control, by index of joint.
+/// \param[in] _control Bit of the control.
+/// \param[in] _targets One value per joint, NaN to clear the control.
+/// \return False if there isn't one value per joint.
+static bool setControls(JointControllerPrivate &_data,
+    std::vector<double> &_values, const uint8_t _control,
+    const std::vector<double> &_targets)
 {
-  bool result = false;
+  if (_targets.size() != _values.size())
+    return false;
 
-  if (this->dataPtr->posPids.find(_jointName) !=
-      this->dataPtr->posPids.end())
+  for (std::size_t i = 0; i < _targets.size(); ++i)
   {
-    this->dataPtr->positions[_jointName] = _target;
-    result = true;
+    if (std::isnan(_targets[i]))
+    {
+      _data.controls[i] &= ~_control;
+    }
+    else
+    {
+      _values[i] = _targets[i];
+      _data.controls[i] |= _control;
+    }
   }
+  return true;
+}
 
-  return result;
+/////////////////////////////////////////////////
+bool JointController::SetPositionTarget(const std::string &_jointName,
+    const double _target)
+{
+  return setControl(*this->dataPtr, _jointName, this->dataPtr->positions,
+      kPositionControl, _target);
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetPositionTargets(const std::vector<double> &_targets)
+{
+  return setControls(*this->dataPtr, this->dataPtr->positions,
+      kPositionControl, _targets);
 }
 
 //////////////////////////////////////////////////
 void JointController::SetVelocityPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
-
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->velPids[_jointName] = _pid;
+  auto index = this->dataPtr->indices.find(_jointName);
+  if (index != this->dataPtr->indices.end())
+    this->dataPtr->velPids[index->second] = _pid;
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -508,30 +660,28 @@ void JointController::SetVelocityPID(const std::string &_jointName,
 bool JointController::SetVelocityTarget(const std::string &_jointName,
     const double _target)
 {
-  bool result = false;
-
-  if (this->dataPtr->velPids.find(_jointName) !=
-      this->dataPtr->velPids.end())
-  {
-    this->dataPtr->velocities[_jointName] = _target;
-    result = true;
-  }
+  return setControl(*this->dataPtr, _jointName, this->dataPtr->velocities,
+      kVelocityControl, _target);
+}
 
-  return result;
+/////////////////////////////////////////////////
+bool JointController::SetVelocityTargets(const std::vector<double> &_targets)
+{
+  return setControls(*this->dataPtr, this->dataPtr->velocities,
+      kVelocityControl, _targets);
 }
 
 /////////////////////////////////////////////////
 bool JointController::SetForce(const std::string &_jointName,
     const double _force)
 {
-  bool result = false;
-
-  if (this->dataPtr->joints.find(_jointName) !=
-      this->dataPtr->joints.end())
-  {
-    this->dataPtr->forces[_jointName] = _force;
-    result = true;
-  }
+  return setControl(*this->dataPtr, _jointName, this->dataPtr->forces,
+      kForceControl, _force);
+}
 
-  return result;
+/////////////////////////////////////////////////
+bool JointController::SetForces(const std::vector<double> &_forces)
+{
+  return setControls(*this->dataPtr, this->dataPtr->forces, kForceControl,
+      _forces);
 }
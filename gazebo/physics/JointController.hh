@@ -69,11 +69,19 @@ namespace gazebo
       public: void SetJointPosition(
         const std::string &_name, double _position, int _index = 0);
 
-      /// \brief Set the positions of a set of Joint's.
+      /// \brief Set the positions of a set of Joint's. With ODE the links
+      /// are moved once for all the joints, see Joint::SetPositionsMaximal.
       /// \sa JointController::SetJointPosition(JointPtr, double)
       public: void SetJointPositions(
                   const std::map<std::string, double> &_jointPositions);
 
+      /// \brief Set the positions of all the joints, as the map overload
+      /// does, without looking up names.
+      /// \param[in] _positions One position per joint, in the order of
+      /// JointNames. NaN leaves a joint where it is.
+      /// \return False if there isn't one position per joint.
+      public: bool SetJointPositions(const std::vector<double> &_positions);
+
       /// \brief Get the last time the controller was updated.
       /// \return Last time the controller was updated.
       public: common::Time GetLastUpdateTime() const;
@@ -83,6 +91,11 @@ namespace gazebo
       /// be controlled.
       public: std::map<std::string, JointPtr> GetJoints() const;
 
+      /// \brief Get the scoped names of the joints, by index. The bulk
+      /// setters take one value per joint, in this order.
+      /// \return Scoped names of the joints.
+      public: std::vector<std::string> JointNames() const;
+
       /// \brief Set the position PID values for a joint.
       /// \param[in] _jointName Scoped name of the joint.
       /// \param[in] _pid New position PID controller.
@@ -96,6 +109,13 @@ namespace gazebo
       public: bool SetPositionTarget(const std::string &_jointName,
                   const double _target);
 
+      /// \brief Set the targets of the position PID controllers of all the
+      /// joints.
+      /// \param[in] _targets One target per joint, in the order of
+      /// JointNames. NaN clears the target of a joint.
+      /// \return False if there isn't one target per joint.
+      public: bool SetPositionTargets(const std::vector<double> &_targets);
+
       /// \brief Set the velocity PID values for a joint.
       /// \param[in] _jointName Scoped name of the joint.
       /// \param[in] _pid New velocity PID controller.
@@ -109,6 +129,13 @@ namespace gazebo
       public: bool SetVelocityTarget(const std::string &_jointName,
                   const double _target);
 
+      /// \brief Set the targets of the velocity PID controllers of all the
+      /// joints.
+      /// \param[in] _targets One target per joint, in the order of
+      /// JointNames. NaN clears the target of a joint.
+      /// \return False if there isn't one target per joint.
+      public: bool SetVelocityTargets(const std::vector<double> &_targets);
+
       /// \brief Set the applied effort for the specified joint.
       /// This force will persist across time steps.
       /// \param[in] _jointName Scoped name of the joint.
@@ -116,6 +143,13 @@ namespace gazebo
       /// \return False if the joint was not found.
       public: bool SetForce(const std::string &_jointName, const double _force);
 
+      /// \brief Set the applied efforts of all the joints. They persist
+      /// across time steps.
+      /// \param[in] _forces One force per joint, in the order of
+      /// JointNames. NaN clears the force of a joint.
+      /// \return False if there isn't one force per joint.
+      public: bool SetForces(const std::vector<double> &_forces);
+
       /// \brief Get all the position PID controllers.
       /// \return A map<joint_name, PID> for all the position PID
       /// controllers.
@@ -141,6 +175,18 @@ namespace gazebo
       /// set by the user of the JointController.
       public: std::map<std::string, double> GetVelocities() const;
 
+      /// \brief Append the state of the controller to a buffer: the last
+      /// update time and, for each joint, the targets, the force and the
+      /// PID errors. The gains aren't saved.
+      /// \param[in,out] _data Buffer that receives the state.
+      public: void SaveSnapshot(std::vector<double> &_data) const;
+
+      /// \brief Restore the state appended by SaveSnapshot.
+      /// \param[in,out] _data Start of the state, moved past it.
+      /// \param[in] _end End of the buffer.
+      /// \return False if the buffer doesn't match the controlled joints.
+      public: bool RestoreSnapshot(const double *&_data, const double *_end);
+
       /// \brief Callback for service to request the current control parameters.
       /// \param[in] _req The service request. The service expects a joint
       /// name.
@@ -17,8 +17,10 @@
 #ifndef _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 #define _GAZEBO_JOINTCONTROLLER_PRIVATE_HH_
 
-#include <string>
+#include <cstdint>
 #include <map>
+#include <string>
+#include <vector>
 #include <ignition/transport.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -38,23 +40,31 @@ namespace gazebo
       /// \brief List of links that have been updated.
       public: Link_V updatedLinks;
 
-      /// \brief Map of joint names to the joint pointer.
-      public: std::map<std::string, JointPtr> joints;
+      /// \brief Index of each joint, by scoped name.
+      public: std::map<std::string, std::size_t> indices;
+
+      /// \brief Controlled joints. The controls below are arrays indexed
+      /// like this one, so the update is a single loop over the joints.
+      public: Joint_V joints;
 
       /// \brief Position PID controllers.
-      public: std::map<std::string, common::PID> posPids;
+      public: std::vector<common::PID> posPids;
 
       /// \brief Velocity PID controllers.
-      public: std::map<std::string, common::PID> velPids;
+      public: std::vector<common::PID> velPids;
 
       /// \brief Forces applied to joints.
-      public: std::map<std::string, double> forces;
+      public: std::vector<double> forces;
+
+      /// \brief Joint position targets.
+      public: std::vector<double> positions;
 
-      /// \brief Joint positions.
-      public: std::map<std::string, double> positions;
+      /// \brief Joint velocity targets.
+      public: std::vector<double> velocities;
 
-      /// \brief Joint velocities.
-      public: std::map<std::string, double> velocities;
+      /// \brief Controls set on each joint, a combination of the
+      /// kForceControl, kPositionControl and kVelocityControl bits.
+      public: std::vector<uint8_t> controls;
 
       /// \brief Node for communication.
       /// \deprecated See JointControllerPrivate::node.
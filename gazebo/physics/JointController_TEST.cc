@@ -16,6 +16,11 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/transport.hh>
@@ -278,6 +283,76 @@ TEST_F(JointControllerTest, SetJointPositions)
   positions[joint1->GetScopedName()] = 1.2;
   positions[joint2->GetScopedName()] = 2.3;
   EXPECT_NO_THROW(jointController->SetJointPositions(positions));
+
+  // One position per joint, in the order of JointNames
+  EXPECT_FALSE(jointController->SetJointPositions(std::vector<double>(1)));
+  EXPECT_TRUE(jointController->SetJointPositions(
+      std::vector<double>{1.2, std::nan("")}));
+}
+
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, BulkTargets)
+{
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+
+  physics::JointPtr joint1(new FakeJoint(model));
+  joint1->SetName("joint1");
+  physics::JointPtr joint2(new FakeJoint(model));
+  joint2->SetName("joint2");
+  physics::JointPtr joint3(new FakeJoint(model));
+  joint3->SetName("joint3");
+  jointController->AddJoint(joint2);
+  jointController->AddJoint(joint1);
+  jointController->AddJoint(joint3);
+
+  // Joints are indexed in the order they were added
+  std::vector<std::string> names = jointController->JointNames();
+  ASSERT_EQ(names.size(), 3u);
+  EXPECT_EQ(names[0], joint2->GetScopedName());
+  EXPECT_EQ(names[1], joint1->GetScopedName());
+  EXPECT_EQ(names[2], joint3->GetScopedName());
+
+  // One value per joint, NaN leaves a joint without target
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(jointController->SetPositionTargets({1, 2}));
+  EXPECT_TRUE(jointController->SetPositionTargets({1, nan, 3}));
+  std::map<std::string, double> positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 2u);
+  EXPECT_DOUBLE_EQ(positions[joint2->GetScopedName()], 1);
+  EXPECT_DOUBLE_EQ(positions[joint3->GetScopedName()], 3);
+
+  EXPECT_TRUE(jointController->SetVelocityTargets({nan, 5, nan}));
+  std::map<std::string, double> velocities =
+      jointController->GetVelocities();
+  EXPECT_EQ(velocities.size(), 1u);
+  EXPECT_DOUBLE_EQ(velocities[joint1->GetScopedName()], 5);
+
+  EXPECT_TRUE(jointController->SetForces({7, 8, 9}));
+  EXPECT_EQ(jointController->GetForces().size(), 3u);
+
+  // Removing a joint moves the next ones down
+  jointController->RemoveJoint(joint1.get());
+  names = jointController->JointNames();
+  ASSERT_EQ(names.size(), 2u);
+  EXPECT_EQ(names[1], joint3->GetScopedName());
+  EXPECT_TRUE(jointController->GetVelocities().empty());
+  positions = jointController->GetPositions();
+  EXPECT_DOUBLE_EQ(positions[joint3->GetScopedName()], 3);
+  EXPECT_EQ(jointController->GetPositionPIDs().size(), 2u);
+
+  // The state goes through a snapshot
+  std::vector<double> snapshot;
+  jointController->SaveSnapshot(snapshot);
+  jointController->Reset();
+  EXPECT_TRUE(jointController->GetForces().empty());
+  const double *data = snapshot.data();
+  EXPECT_TRUE(jointController->RestoreSnapshot(data,
+      snapshot.data() + snapshot.size()));
+  EXPECT_EQ(data, snapshot.data() + snapshot.size());
+  EXPECT_EQ(jointController->GetPositions(), positions);
+  EXPECT_EQ(jointController->GetForces().size(), 2u);
 }
 
 /////////////////////////////////////////////////
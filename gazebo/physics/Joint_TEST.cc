@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class JointTest : public ServerFixture,
+                  public testing::WithParamInterface<const char*>
+{
+  /// \brief Set a joint position between steps and read it back, through
+  /// the joint state cache.
+  /// \param[in] _physicsEngine Physics engine to use.
+  public: void SetPositionCached(const std::string &_physicsEngine);
+};
+
+/////////////////////////////////////////////////
+void JointTest::SetPositionCached(const std::string &_physicsEngine)
+{
+  if (_physicsEngine == "simbody")
+  {
+    gzerr << "Simbody doesn't support Joint::SetPosition, skipping test\n";
+    return;
+  }
+
+  this->Load("test/worlds/pendulum_axes.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  physics::ModelPtr model = world->ModelByName("pendulum_longX_Yaxis");
+  ASSERT_TRUE(model != nullptr);
+  physics::JointPtr joint = model->GetJoint("joint");
+  ASSERT_TRUE(joint != nullptr);
+
+  // Fill the cache, then step so that it is in use.
+  EXPECT_EQ(1u, model->JointPositions().size());
+  world->Step(20);
+  const double swung = joint->Position(0);
+
+  // The position set between steps is read back, not the cached one.
+  for (const double position : {0.3, -0.2})
+  {
+    EXPECT_TRUE(joint->SetPosition(0, position));
+    EXPECT_NEAR(position, joint->Position(0), 1e-6);
+    EXPECT_NEAR(position, model->JointPositions()[0], 1e-6);
+  }
+  EXPECT_NE(swung, joint->Position(0));
+
+  // The cache follows the steps after it.
+  world->Step(1);
+  EXPECT_DOUBLE_EQ(joint->Position(0), model->JointPositions()[0]);
+}
+
+/////////////////////////////////////////////////
+TEST_P(JointTest, SetPositionCached)
+{
+  SetPositionCached(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, JointTest,
+                        PHYSICS_ENGINE_VALUES,);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
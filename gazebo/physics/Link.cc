@@ -18,6 +18,7 @@
 #include <boost/algorithm/string.hpp>
 #include <functional>
 #include <mutex>
+#include <set>
 #include <sstream>
 
 #include "gazebo/transport/TransportIface.hh"
@@ -117,6 +118,13 @@ class gazebo::physics::LinkPrivate
 
   /// \brief SDF Link DOM object
   public: const sdf::Link *linkSDFDom = nullptr;
+
+  /// \brief Ids of the visuals whose geometry changed since the last
+  /// FillChangedVisualGeometry call.
+  public: std::set<uint32_t> changedGeometries;
+
+  /// \brief True to use continuous collision detection.
+  public: bool continuousCollision = false;
 };
 
 using namespace gazebo;
@@ -182,6 +190,13 @@ void Link::Load(sdf::ElementPtr _sdf)
     }
   }
 
+  // Physics engines apply it when they create their body
+  if (this->sdf->HasElement("gz:continuous_collision"))
+  {
+    this->dataPtr->continuousCollision =
+        this->sdf->Get<bool>("gz:continuous_collision");
+  }
+
   if (this->sdf->HasElement("sensor"))
   {
     sdf::ElementPtr sensorElem = this->sdf->GetElement("sensor");
@@ -363,7 +378,10 @@ void Link::Fini()
 
   // Clean up visuals
   // FIXME: Do we really need to send 2 msgs to delete a visual?!
-  if (this->visPub && this->requestPub)
+  // The visuals of the models the world removes in a batch are deleted with
+  // the models.
+  if (this->visPub && this->requestPub &&
+      !(this->world && this->world->RemovingModels()))
   {
     for (auto iter : this->visuals)
     {
@@ -846,6 +864,9 @@ void Link::SetWindMode(const bool _mode)
     this->SetWindEnabled(false);
   else if (this->WindMode() && !this->dataPtr->updateConnection)
     this->SetWindEnabled(true);
+
+  // Fields may select the links with wind
+  this->world->ForceFields().Refresh();
 }
 
 /////////////////////////////////////////////////
@@ -864,6 +885,27 @@ void Link::SetWindEnabled(const bool _enable)
   }
 }
 
+//////////////////////////////////////////////////
+void Link::SetContinuousCollision(const bool _enable)
+{
+  this->dataPtr->continuousCollision = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Link::ContinuousCollision() const
+{
+  return this->dataPtr->continuousCollision;
+}
+
+//////////////////////////////////////////////////
+double Link::ContinuousCollisionRadius() const
+{
+  if (this->dataPtr->collisions.empty())
+    return 0.0;
+
+  return 0.5 * this->BoundingBox().Size().Min();
+}
+
 //////////////////////////////////////////////////
 const ignition::math::Vector3d Link::WorldWindLinearVel() const
 {
@@ -1181,6 +1223,10 @@ void Link::SetState(const LinkState &_state)
   this->SetForce(_state.Wrench().Pos());
   this->SetTorque(_state.Wrench().Rot().Euler());
 
+  ModelPtr model = this->GetModel();
+  if (model)
+    model->InvalidateJointStates();
+
   /*
   for (unsigned int i = 0; i < _state.GetCollisionStateCount(); ++i)
   {
@@ -1378,6 +1424,48 @@ bool Link::SetVisualPose(const uint32_t _id,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Link::SetVisualMaterial(const uint32_t _id,
+                             const msgs::Material &_material)
+{
+  auto iter = this->visuals.find(_id);
+  if (iter == this->visuals.end())
+  {
+    gzerr << "Trying to set material of visual from invalid visual id["
+          << _id << "] for link [" << this->GetScopedName() << "]\n";
+    return false;
+  }
+  msgs::Visual &msg = iter->second;
+  msg.mutable_material()->CopyFrom(_material);
+  std::string linkName = this->GetScopedName();
+  if (this->sdf->HasElement("visual"))
+  {
+    sdf::ElementPtr visualElem = this->sdf->GetElement("visual");
+    while (visualElem)
+    {
+      std::string visName = linkName + "::" +
+        visualElem->Get<std::string>("name");
+
+      // update visual msg if it exists
+      if (msg.name() == visName)
+      {
+        msgs::MaterialToSDF(_material, visualElem->GetElement("material"));
+        break;
+      }
+
+      visualElem = visualElem->GetNextElement("visual");
+    }
+  }
+  msgs::Visual visual;
+  visual.set_name(msg.name());
+  visual.set_id(_id);
+  visual.set_parent_name(linkName);
+  visual.set_parent_id(this->GetId());
+  visual.mutable_material()->CopyFrom(_material);
+  this->visPub->Publish(visual);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Link::OnCollision(ConstContactsPtr &_msg)
 {
@@ -1463,6 +1551,66 @@ void Link::SetScale(const ignition::math::Vector3d &_scale)
   this->UpdateVisualGeomSDF(_scale);
 
   this->scale = _scale;
+
+  // Keep the visual messages in sync, so that a scale update doesn't need
+  // the whole link message
+  this->UpdateVisualGeometry();
+}
+
+//////////////////////////////////////////////////
+void Link::UpdateVisualGeometry()
+{
+  // Visuals that aren't parsed yet take their geometry from the SDF
+  if (this->visuals.empty() || !this->sdf->HasElement("visual"))
+    return;
+
+  const std::string prefix = this->GetScopedName() + "::";
+  sdf::ElementPtr visualElem = this->sdf->GetElement("visual");
+  for (; visualElem; visualElem = visualElem->GetNextElement("visual"))
+  {
+    if (!visualElem->HasElement("geometry"))
+      continue;
+
+    const std::string name = prefix + visualElem->Get<std::string>("name");
+    for (auto &iter : this->visuals)
+    {
+      if (iter.second.name() != name)
+        continue;
+
+      msgs::Geometry geom =
+          msgs::GeometryFromSDF(visualElem->GetElement("geometry"));
+      if (!iter.second.has_geometry() ||
+          geom.SerializeAsString() !=
+          iter.second.geometry().SerializeAsString())
+      {
+        iter.second.mutable_geometry()->Swap(&geom);
+        this->dataPtr->changedGeometries.insert(iter.first);
+      }
+      break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool Link::FillChangedVisualGeometry(msgs::Link &_msg)
+{
+  bool changed = false;
+  for (auto const id : this->dataPtr->changedGeometries)
+  {
+    auto iter = this->visuals.find(id);
+    if (iter == this->visuals.end() || !iter->second.has_geometry())
+      continue;
+
+    msgs::Visual *visualMsg = _msg.add_visual();
+    visualMsg->set_name(iter->second.name());
+    visualMsg->set_id(iter->second.id());
+    visualMsg->set_parent_name(iter->second.parent_name());
+    visualMsg->set_parent_id(iter->second.parent_id());
+    visualMsg->mutable_geometry()->CopyFrom(iter->second.geometry());
+    changed = true;
+  }
+  this->dataPtr->changedGeometries.clear();
+  return changed;
 }
 
 //////////////////////////////////////////////////
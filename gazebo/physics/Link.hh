@@ -561,6 +561,26 @@ namespace gazebo
       /// \param[in] _enable True to enable the wind.
       public: void SetWindEnabled(const bool _enable);
 
+      /// \brief Set whether the link uses continuous collision detection,
+      /// so that it doesn't pass through thin objects when it moves more
+      /// than its own size in a step. This is meant for fast links, such
+      /// as projectiles, and is supported by ODE and Bullet. It can also be
+      /// set with <gz:continuous_collision> in the SDF of the link.
+      /// \param[in] _enable True to sweep the link between steps.
+      public: virtual void SetContinuousCollision(const bool _enable);
+
+      /// \brief Get whether the link uses continuous collision detection.
+      /// \return True if enabled.
+      /// \sa SetContinuousCollision
+      public: bool ContinuousCollision() const;
+
+      /// \brief Get the radius of the sphere swept by continuous collision
+      /// detection, half of the smallest side of the bounding box of the
+      /// collisions. A step that moves the link less than this radius
+      /// isn't swept.
+      /// \return Radius in meters, 0 if the link has no collision.
+      public: double ContinuousCollisionRadius() const;
+
       /// \brief Returns this link's wind velocity in the world coordinate
       /// frame.
       /// \return this link's wind velocity.
@@ -609,6 +629,13 @@ namespace gazebo
       public: bool SetVisualPose(const uint32_t _id,
                                  const ignition::math::Pose3d &_pose);
 
+      /// \brief Set the material of a visual.
+      /// \param[in] _id Unique ID of visual message.
+      /// \param[in] _material New material of the visual.
+      /// \return True if setting the material of the visual was successful.
+      public: bool SetVisualMaterial(const uint32_t _id,
+                                     const msgs::Material &_material);
+
       /// \brief Get the SDF DOM object of this link
       /// \return Pointer to SDF DOM Object
       public: const sdf::Link *GetSDFDom() const;
@@ -624,6 +651,13 @@ namespace gazebo
       /// \return a map of unique ID to visual message
       public: const Visuals_M &Visuals() const;
 
+      /// \brief Add the visuals whose geometry changed since the last
+      /// call, such as after SetScale, to a message.
+      /// \param[out] _msg Link message that receives the names, the ids
+      /// and the geometries of the visuals.
+      /// \return True if a visual was added.
+      public: bool FillChangedVisualGeometry(msgs::Link &_msg);
+
       /// \brief Publish timestamped link data such as velocity.
       private: void PublishData();
 
@@ -659,6 +693,10 @@ namespace gazebo
       /// \brief Update visual msgs.
       private: void UpdateVisualMsg();
 
+      /// \brief Update the geometry of the visual msgs from the SDF, and
+      /// record the visuals whose geometry changed.
+      private: void UpdateVisualGeometry();
+
       /// \brief Called when a new wrench message arrives. The wrench's force,
       /// torque and force offset are described in the link frame,
       /// \param[in] _msg The wrench message.
@@ -133,6 +133,32 @@ void MeshShape::SetMesh(const std::string &_uri,
   this->Init();
 }
 
+//////////////////////////////////////////////////
+void MeshShape::Triangles(std::vector<ignition::math::Vector3d> &_vertices,
+    std::vector<unsigned int> &_indices) const
+{
+  _vertices.clear();
+  _indices.clear();
+
+  const ignition::math::Vector3d scale = this->Size();
+  auto append = [&](const common::SubMesh *_subMesh)
+  {
+    const unsigned int offset = _vertices.size();
+    for (unsigned int i = 0; i < _subMesh->GetVertexCount(); ++i)
+      _vertices.push_back(_subMesh->Vertex(i) * scale);
+    for (unsigned int i = 0; i < _subMesh->GetIndexCount(); ++i)
+      _indices.push_back(offset + _subMesh->GetIndex(i));
+  };
+
+  if (this->submesh)
+    append(this->submesh);
+  else if (this->mesh)
+  {
+    for (unsigned int i = 0; i < this->mesh->GetSubMeshCount(); ++i)
+      append(this->mesh->GetSubMesh(i));
+  }
+}
+
 //////////////////////////////////////////////////
 void MeshShape::FillMsg(msgs::Geometry &_msg)
 {
@@ -18,6 +18,9 @@
 #define GAZEBO_PHYSICS_MESHSHAPE_HH_
 
 #include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -69,6 +72,13 @@ namespace gazebo
       /// \param[in] _scale Scaling factor.
       public: void SetScale(const ignition::math::Vector3d &_scale);
 
+      /// \brief Get the triangles of the mesh, or of the submesh if one is
+      /// used, scaled, in the frame of the collision.
+      /// \param[out] _vertices Vertex positions.
+      /// \param[out] _indices Three vertex indices per triangle.
+      public: void Triangles(std::vector<ignition::math::Vector3d> &_vertices,
+                  std::vector<unsigned int> &_indices) const;
+
       /// \brief Populate a msgs::Geometry message with data from this
       /// shape.
       /// \param[out] _msg Message to fill.
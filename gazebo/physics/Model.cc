@@ -17,8 +17,13 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 #include <float.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/thread/recursive_mutex.hpp>
@@ -32,10 +37,13 @@
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/LockProfiler.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/PluginCosts.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/common/URI.hh"
 
 #include "gazebo/physics/Gripper.hh"
@@ -45,6 +53,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/ModelPrivate.hh"
 #include "gazebo/physics/Contact.hh"
 
 #include "gazebo/transport/Node.hh"
@@ -58,7 +67,7 @@ using namespace physics;
 
 //////////////////////////////////////////////////
 Model::Model(BasePtr _parent)
-  : Entity(_parent)
+  : Entity(_parent), dataPtr(new ModelPrivate)
 {
   this->AddType(MODEL);
 }
@@ -72,6 +81,8 @@ Model::~Model()
 //////////////////////////////////////////////////
 void Model::Load(sdf::ElementPtr _sdf)
 {
+  common::StartupScope startupScope("Model::Load",
+      _sdf->Get<std::string>("name"));
   // Create a DOM object to compute the resolved initial pose (with frame
   // semantics)
   // Only <model> is supported right now, <actor> is not supported.
@@ -227,6 +238,7 @@ void Model::LoadLinks()
       link->Load(linkElem);
       linkElem = linkElem->GetNextElement("link");
       this->links.push_back(link);
+      this->LinksChanged();
     }
   }
 }
@@ -246,6 +258,7 @@ void Model::LoadModels()
       model->SetWorld(this->GetWorld());
       model->Load(modelElem);
       this->models.push_back(model);
+      this->LinksChanged();
       modelElem = modelElem->GetNextElement("model");
     }
 
@@ -352,7 +365,11 @@ void Model::Update()
   if (this->IsStatic())
     return;
 
-  boost::recursive_mutex::scoped_lock lock(this->updateMutex);
+  // The update mutex of every model reports to the same account
+  static common::LockStats *lockStats =
+      common::LockProfiler::Instance()->Stats("physics/model_update");
+  common::ProfiledLock<boost::recursive_mutex> lock(this->updateMutex,
+      lockStats);
 
   for (Joint_V::iterator jiter = this->joints.begin();
        jiter != this->joints.end(); ++jiter)
@@ -401,6 +418,81 @@ void Model::Update()
     model->Update();
 }
 
+//////////////////////////////////////////////////
+event::ConnectionPtr Model::ConnectLocalUpdate(
+    std::function<void (const common::UpdateInfo &)> _subscriber)
+{
+  return this->dataPtr->localUpdate.Connect(_subscriber);
+}
+
+//////////////////////////////////////////////////
+bool Model::HasLocalUpdate() const
+{
+  if (this->dataPtr->localUpdate.ConnectionCount() > 0)
+    return true;
+
+  for (auto const &model : this->models)
+  {
+    if (model->HasLocalUpdate())
+      return true;
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void Model::LocalUpdate(const common::UpdateInfo &_info)
+{
+  this->dataPtr->localUpdate(_info);
+
+  for (auto &model : this->models)
+    model->LocalUpdate(_info);
+}
+
+//////////////////////////////////////////////////
+bool Model::ParallelUpdateSafe() const
+{
+  if (this->HasType(ACTOR))
+    return false;
+
+  boost::recursive_mutex::scoped_lock lock(this->updateMutex);
+
+  // Joint animations kinematically move links through the joint controller,
+  // which is not safe to do from several threads at once.
+  if (!this->jointAnimations.empty())
+    return false;
+
+  // A joint that attaches to another top level model applies forces to
+  // that model's links.
+  BasePtr topModel = boost::const_pointer_cast<Base>(shared_from_this());
+  while (topModel->GetParent() && topModel->GetParent()->HasType(MODEL))
+    topModel = topModel->GetParent();
+
+  std::vector<const Joint_V *> jointLists = {&this->joints};
+  Model_V nested = this->models;
+  while (!nested.empty())
+  {
+    ModelPtr model = nested.back();
+    nested.pop_back();
+    jointLists.push_back(&model->GetJoints());
+    nested.insert(nested.end(), model->NestedModels().begin(),
+        model->NestedModels().end());
+  }
+
+  for (auto const &jointList : jointLists)
+  {
+    for (auto const &joint : *jointList)
+    {
+      for (auto const &link : {joint->GetParent(), joint->GetChild()})
+      {
+        if (link && link->GetParentModel() != topModel)
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 void Model::SetJointPosition(
   const std::string &_jointName, double _position, int _index)
@@ -442,7 +534,9 @@ void Model::RemoveChild(EntityPtr _child)
             jlink1->GetName() == _child->GetName() ||
             jlink0->GetName() == jlink1->GetName())
         {
+          this->dataPtr->jointStateRanges.erase(jiter->get());
           this->joints.erase(jiter);
+          this->InvalidateJointStates();
           done = false;
           break;
         }
@@ -493,6 +587,8 @@ void Model::Fini()
       joint->Fini();
   }
   this->joints.clear();
+  this->dataPtr->jointStateRanges.clear();
+  this->dataPtr->jointStatesValid.store(false, std::memory_order_release);
   this->jointController.reset();
 
   // Destroy all links
@@ -503,6 +599,7 @@ void Model::Fini()
   }
   this->canonicalLink.reset();
   this->links.clear();
+  this->LinksChanged();
 
   this->plugins.clear();
 
@@ -727,6 +824,8 @@ void Model::ResetPhysicsStates()
   // reset nested model physics states
   for (auto &m : this->models)
     m->ResetPhysicsStates();
+
+  this->InvalidateJointStates();
 }
 
 //////////////////////////////////////////////////
@@ -741,6 +840,7 @@ void Model::SetLinearVel(const ignition::math::Vector3d &_vel)
       (*iter)->SetLinearVel(_vel);
     }
   }
+  this->InvalidateJointStates();
 }
 
 //////////////////////////////////////////////////
@@ -755,6 +855,7 @@ void Model::SetAngularVel(const ignition::math::Vector3d &_vel)
       (*iter)->SetAngularVel(_vel);
     }
   }
+  this->InvalidateJointStates();
 }
 
 //////////////////////////////////////////////////
@@ -865,6 +966,19 @@ const Joint_V &Model::GetJoints() const
   return this->joints;
 }
 
+//////////////////////////////////////////////////
+void Model::SnapshotEntities(Link_V &_links, Joint_V &_joints,
+    JointController_V &_controllers) const
+{
+  _links.insert(_links.end(), this->links.begin(), this->links.end());
+  _joints.insert(_joints.end(), this->joints.begin(), this->joints.end());
+  if (this->jointController)
+    _controllers.push_back(this->jointController);
+
+  for (auto const &model : this->models)
+    model->SnapshotEntities(_links, _joints, _controllers);
+}
+
 //////////////////////////////////////////////////
 JointPtr Model::GetJoint(const std::string &_name)
 {
@@ -883,6 +997,123 @@ JointPtr Model::GetJoint(const std::string &_name)
   return result;
 }
 
+//////////////////////////////////////////////////
+const std::vector<double> &Model::JointPositions()
+{
+  this->dataPtr->jointStatesUsed.store(true, std::memory_order_relaxed);
+  if (!this->dataPtr->jointStatesValid.load(std::memory_order_acquire))
+    this->FillJointStates();
+  return this->dataPtr->jointPositionCache;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &Model::JointVelocities()
+{
+  this->dataPtr->jointStatesUsed.store(true, std::memory_order_relaxed);
+  if (!this->dataPtr->jointStatesValid.load(std::memory_order_acquire))
+    this->FillJointStates();
+  return this->dataPtr->jointVelocityCache;
+}
+
+//////////////////////////////////////////////////
+void Model::CacheJointStates()
+{
+  for (auto &model : this->models)
+    model->CacheJointStates();
+
+  // The step changed the joint states, so a model that nobody read since
+  // the last step is only marked stale.
+  if (this->dataPtr->jointStatesUsed.exchange(false,
+        std::memory_order_relaxed))
+  {
+    this->FillJointStates();
+  }
+  else
+    this->dataPtr->jointStatesValid.store(false, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void Model::FillJointStates()
+{
+  unsigned int count = 0;
+  for (auto const &joint : this->joints)
+    count += joint->DOF();
+  this->dataPtr->jointPositionCache.resize(count);
+  this->dataPtr->jointVelocityCache.resize(count);
+
+  const bool isStatic = this->IsStatic();
+  unsigned int offset = 0;
+  for (auto const &joint : this->joints)
+  {
+    const unsigned int dof = joint->DOF();
+    for (unsigned int i = 0; i < dof; ++i)
+    {
+      this->dataPtr->jointPositionCache[offset + i] =
+          isStatic ? joint->staticPosition : joint->PositionImpl(i);
+      this->dataPtr->jointVelocityCache[offset + i] =
+          isStatic ? 0.0 : joint->GetVelocity(i);
+    }
+
+    // The ranges only change when joints are added or removed, so the
+    // map is only written then
+    const std::pair<unsigned int, unsigned int> range(offset, dof);
+    auto iter = this->dataPtr->jointStateRanges.find(joint.get());
+    if (iter == this->dataPtr->jointStateRanges.end())
+      this->dataPtr->jointStateRanges.emplace(joint.get(), range);
+    else if (iter->second != range)
+      iter->second = range;
+    offset += dof;
+  }
+
+  this->dataPtr->jointStatesValid.store(true, std::memory_order_release);
+}
+
+//////////////////////////////////////////////////
+void Model::InvalidateJointStates()
+{
+  // Joints between a nested model and its parent move when either is set,
+  // so the whole tree is marked stale.
+  Model *top = this;
+  while (top->parent && top->parent->HasType(MODEL))
+    top = static_cast<Model *>(top->parent.get());
+
+  std::vector<Model *> stack = {top};
+  while (!stack.empty())
+  {
+    Model *model = stack.back();
+    stack.pop_back();
+    model->dataPtr->jointStatesValid.store(false,
+        std::memory_order_release);
+    for (auto const &nested : model->models)
+      stack.push_back(nested.get());
+  }
+}
+
+//////////////////////////////////////////////////
+bool Model::CachedJointPosition(const Joint &_joint,
+    const unsigned int _index, double &_position) const
+{
+  if (!this->dataPtr->jointStatesUsed.load(std::memory_order_relaxed))
+    this->dataPtr->jointStatesUsed.store(true, std::memory_order_relaxed);
+
+  if (!this->dataPtr->jointStatesValid.load(std::memory_order_acquire))
+    return false;
+
+  auto iter = this->dataPtr->jointStateRanges.find(&_joint);
+  if (iter == this->dataPtr->jointStateRanges.end() ||
+      _index >= iter->second.second)
+  {
+    return false;
+  }
+
+  const unsigned int offset = iter->second.first + _index;
+  if (offset >= this->dataPtr->jointPositionCache.size())
+    return false;
+
+  _position = this->dataPtr->jointPositionCache[offset];
+  return true;
+}
+
 //////////////////////////////////////////////////
 const Model_V &Model::NestedModels() const
 {
@@ -918,6 +1149,51 @@ const Link_V &Model::GetLinks() const
   return this->links;
 }
 
+//////////////////////////////////////////////////
+const Link_V &Model::AllLinks() const
+{
+  if (this->dataPtr->allLinksValid.load(std::memory_order_acquire))
+    return this->dataPtr->allLinks;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->allLinksMutex);
+  if (!this->dataPtr->allLinksValid.load(std::memory_order_relaxed))
+  {
+    this->dataPtr->allLinks = this->links;
+    for (auto const &model : this->models)
+    {
+      const Link_V &nested = model->AllLinks();
+      this->dataPtr->allLinks.insert(this->dataPtr->allLinks.end(),
+          nested.begin(), nested.end());
+    }
+    this->dataPtr->allLinksValid.store(true, std::memory_order_release);
+  }
+  return this->dataPtr->allLinks;
+}
+
+//////////////////////////////////////////////////
+void Model::LinksChanged()
+{
+  // Not shared_from_this(), since Fini also runs in the destructor
+  Model *model = this;
+  while (model)
+  {
+    // The links are released after the mutex
+    Link_V links;
+    {
+      std::lock_guard<std::mutex> lock(model->dataPtr->allLinksMutex);
+      model->dataPtr->allLinksValid.store(false, std::memory_order_release);
+      links.swap(model->dataPtr->allLinks);
+    }
+
+    BasePtr parent = model->GetParent();
+    model = parent && parent->HasType(MODEL) ?
+        static_cast<Model *>(parent.get()) : nullptr;
+  }
+
+  if (this->world)
+    this->world->_LinksChanged();
+}
+
 //////////////////////////////////////////////////
 LinkPtr Model::GetLink(const std::string &_name) const
 {
@@ -1018,41 +1294,120 @@ std::vector<std::string> Model::SensorScopedName(
 void Model::LoadPlugins()
 {
   // Check to see if we need to load any model plugins
-  if (this->GetPluginCount() > 0)
+  if (this->GetPluginCount() > 0 && this->WaitForSensors())
   {
-    int iterations = 0;
-
-    // Wait for the sensors to be initialized before loading
-    // plugins, if there are any sensors
-    while (this->GetSensorCount() > 0 && !this->world->SensorsInitialized() &&
-           iterations < 50)
+    // Load the plugins
+    sdf::ElementPtr pluginElem = this->sdf->GetElement("plugin");
+    while (pluginElem)
     {
-      common::Time::MSleep(100);
-      iterations++;
+      this->LoadPlugin(pluginElem);
+      pluginElem = pluginElem->GetNextElement("plugin");
     }
+  }
+
+  for (auto &model : this->models)
+    model->LoadPlugins();
+}
 
-    // Load the plugins if the sensors have been loaded, or if there
-    // are no sensors attached to the model.
-    if (iterations < 50)
+//////////////////////////////////////////////////
+void Model::LoadPlugins(const Model_V &_models, const int _threads)
+{
+  common::StartupScope startupScope("Model::LoadPlugins");
+
+  // A created plugin, and whether its Load succeeded
+  struct PendingPlugin
+  {
+    ModelPtr model;
+    ModelPluginPtr plugin;
+    sdf::ElementPtr sdf;
+    bool loaded;
+  };
+  std::vector<PendingPlugin> pending;
+
+  // Create the plugins serially, in the order of LoadPlugins, since
+  // creating them opens their libraries
+  std::function<void(const ModelPtr &)> create = [&](const ModelPtr &_model)
+  {
+    if (_model->GetPluginCount() > 0 && _model->WaitForSensors())
     {
-      // Load the plugins
-      sdf::ElementPtr pluginElem = this->sdf->GetElement("plugin");
-      while (pluginElem)
+      for (sdf::ElementPtr pluginElem = _model->sdf->GetElement("plugin");
+           pluginElem; pluginElem = pluginElem->GetNextElement("plugin"))
       {
-        this->LoadPlugin(pluginElem);
-        pluginElem = pluginElem->GetNextElement("plugin");
+        ModelPluginPtr plugin = _model->CreatePlugin(pluginElem);
+        if (plugin)
+          pending.push_back({_model, plugin, pluginElem, false});
       }
     }
-    else
+
+    for (auto &model : _model->models)
+      create(model);
+  };
+  for (auto const &model : _models)
+    create(model);
+
+  std::vector<size_t> concurrent;
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    if (pending[i].plugin->ConcurrentLoad())
+      concurrent.push_back(i);
+  }
+
+  if (!concurrent.empty())
+  {
+    // Plugin loads are heavy and uneven, so each plugin is a task
+    tbb::task_arena arena(std::max(1, _threads));
+    arena.execute([&]()
     {
-      gzerr << "Sensors failed to initialize when loading model["
-        << this->GetName() << "] via the factory mechanism."
-        << " Plugins for the model will not be loaded.\n";
-    }
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, concurrent.size(), 1),
+          [&](const tbb::blocked_range<size_t> &_r)
+          {
+            for (size_t i = _r.begin(); i != _r.end(); ++i)
+            {
+              PendingPlugin &entry = pending[concurrent[i]];
+              entry.loaded =
+                  entry.model->CallPluginLoad(entry.plugin, entry.sdf);
+            }
+          });
+    });
   }
 
-  for (auto &model : this->models)
-    model->LoadPlugins();
+  for (auto &entry : pending)
+  {
+    if (!entry.plugin->ConcurrentLoad())
+      entry.loaded = entry.model->CallPluginLoad(entry.plugin, entry.sdf);
+  }
+
+  for (auto &entry : pending)
+  {
+    if (entry.loaded)
+      entry.model->CallPluginInit(entry.plugin, entry.sdf);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Model::WaitForSensors() const
+{
+  int iterations = 0;
+
+  // Wait for the sensors to be initialized before loading
+  // plugins, if there are any sensors
+  while (this->GetSensorCount() > 0 && !this->world->SensorsInitialized() &&
+         iterations < 50)
+  {
+    common::Time::MSleep(100);
+    iterations++;
+  }
+
+  // Load the plugins if the sensors have been loaded, or if there
+  // are no sensors attached to the model.
+  if (iterations >= 50)
+  {
+    gzerr << "Sensors failed to initialize when loading model["
+      << this->GetName() << "] via the factory mechanism."
+      << " Plugins for the model will not be loaded.\n";
+    return false;
+  }
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -1091,9 +1446,21 @@ unsigned int Model::GetSensorCount() const
 
 //////////////////////////////////////////////////
 void Model::LoadPlugin(sdf::ElementPtr _sdf)
+{
+  common::StartupScope startupScope("Model::LoadPlugin",
+      _sdf->Get<std::string>("filename"));
+  gazebo::ModelPluginPtr plugin = this->CreatePlugin(_sdf);
+  if (plugin && this->CallPluginLoad(plugin, _sdf))
+    this->CallPluginInit(plugin, _sdf);
+}
+
+//////////////////////////////////////////////////
+ModelPluginPtr Model::CreatePlugin(sdf::ElementPtr _sdf)
 {
   std::string pluginName = _sdf->Get<std::string>("name");
   std::string filename = _sdf->Get<std::string>("filename");
+  common::PluginCostScope costScope(
+      this->GetScopedName() + "::" + pluginName, filename);
 
   gazebo::ModelPluginPtr plugin;
 
@@ -1112,60 +1479,79 @@ void Model::LoadPlugin(sdf::ElementPtr _sdf)
     gzlog << "Exception occured in the constructor of plugin with name["
       << pluginName << "] and filename[" << filename << "]. "
       << "This plugin will not run." << std::endl;
-    return;
+    return ModelPluginPtr();
   }
 
-  if (plugin)
+  if (plugin && plugin->GetType() != MODEL_PLUGIN)
   {
-    if (plugin->GetType() != MODEL_PLUGIN)
-    {
-      gzerr << "Model[" << this->GetName() << "] is attempting to load "
-            << "a plugin, but detected an incorrect plugin type. "
-            << "Plugin filename[" << filename << "] name["
-            << pluginName << "]\n";
-      return;
-    }
+    gzerr << "Model[" << this->GetName() << "] is attempting to load "
+          << "a plugin, but detected an incorrect plugin type. "
+          << "Plugin filename[" << filename << "] name["
+          << pluginName << "]\n";
+    return ModelPluginPtr();
+  }
 
-    ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
+  return plugin;
+}
 
-    try
-    {
-      plugin->Load(myself, _sdf);
-    }
-    catch(...)
-    {
-      gzerr << "Exception occured in the Load function of plugin with name["
-        << pluginName << "] and filename[" << filename << "]. "
-        << "This plugin will not run.\n";
-
-      // Log the message. gzerr has problems with this in 1.9. Remove the
-      // gzlog command in gazebo2.
-      gzlog << "Exception occured in the Load function of plugin with name["
-        << pluginName << "] and filename[" << filename << "]. "
-        << "This plugin will not run." << std::endl;
-      return;
-    }
+//////////////////////////////////////////////////
+bool Model::CallPluginLoad(ModelPluginPtr _plugin, sdf::ElementPtr _sdf)
+{
+  std::string pluginName = _sdf->Get<std::string>("name");
+  std::string filename = _sdf->Get<std::string>("filename");
+  common::PluginCostScope costScope(
+      this->GetScopedName() + "::" + pluginName, filename);
 
-    try
-    {
-      plugin->Init();
-    }
-    catch(...)
-    {
-      gzerr << "Exception occured in the Init function of plugin with name["
-        << pluginName << "] and filename[" << filename << "]. "
-        << "This plugin will not run\n";
-
-      // Log the message. gzerr has problems with this in 1.9. Remove the
-      // gzlog command in gazebo2.
-      gzlog << "Exception occured in the Init function of plugin with name["
-        << pluginName << "] and filename[" << filename << "]. "
-        << "This plugin will not run." << std::endl;
-      return;
-    }
+  ModelPtr myself = boost::static_pointer_cast<Model>(shared_from_this());
+
+  try
+  {
+    _plugin->Load(myself, _sdf);
+  }
+  catch(...)
+  {
+    gzerr << "Exception occured in the Load function of plugin with name["
+      << pluginName << "] and filename[" << filename << "]. "
+      << "This plugin will not run.\n";
 
-    this->plugins.push_back(plugin);
+    // Log the message. gzerr has problems with this in 1.9. Remove the
+    // gzlog command in gazebo2.
+    gzlog << "Exception occured in the Load function of plugin with name["
+      << pluginName << "] and filename[" << filename << "]. "
+      << "This plugin will not run." << std::endl;
+    return false;
   }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Model::CallPluginInit(ModelPluginPtr _plugin, sdf::ElementPtr _sdf)
+{
+  std::string pluginName = _sdf->Get<std::string>("name");
+  std::string filename = _sdf->Get<std::string>("filename");
+  common::PluginCostScope costScope(
+      this->GetScopedName() + "::" + pluginName, filename);
+
+  try
+  {
+    _plugin->Init();
+  }
+  catch(...)
+  {
+    gzerr << "Exception occured in the Init function of plugin with name["
+      << pluginName << "] and filename[" << filename << "]. "
+      << "This plugin will not run\n";
+
+    // Log the message. gzerr has problems with this in 1.9. Remove the
+    // gzlog command in gazebo2.
+    gzlog << "Exception occured in the Init function of plugin with name["
+      << pluginName << "] and filename[" << filename << "]. "
+      << "This plugin will not run." << std::endl;
+    return;
+  }
+
+  this->plugins.push_back(_plugin);
 }
 
 //////////////////////////////////////////////////
@@ -1479,6 +1865,28 @@ bool Model::GetAutoDisable() const
   return this->sdf->Get<bool>("allow_auto_disable");
 }
 
+/////////////////////////////////////////////////
+void Model::SetKinematic(const bool _kinematic)
+{
+  for (auto const &link : this->AllLinks())
+    link->SetKinematic(_kinematic);
+}
+
+/////////////////////////////////////////////////
+bool Model::IsKinematic() const
+{
+  const Link_V &links = this->AllLinks();
+  if (links.empty())
+    return false;
+
+  for (auto const &link : links)
+  {
+    if (!link->GetKinematic())
+      return false;
+  }
+  return true;
+}
+
 /////////////////////////////////////////////////
 void Model::SetSelfCollide(bool _self_collide)
 {
@@ -1500,6 +1908,7 @@ void Model::RemoveLink(const std::string &_name)
     if ((*iter)->GetName() == _name || (*iter)->GetScopedName() == _name)
     {
       this->links.erase(iter);
+      this->LinksChanged();
       break;
     }
   }
@@ -1740,6 +2149,7 @@ LinkPtr Model::CreateLink(const std::string &_name)
 
   link->SetName(_name);
   this->links.push_back(link);
+  this->LinksChanged();
 
   return link;
 }
@@ -17,14 +17,17 @@
 #ifndef GAZEBO_PHYSICS_MODEL_HH_
 #define GAZEBO_PHYSICS_MODEL_HH_
 
+#include <functional>
 #include <string>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <boost/function.hpp>
 #include <boost/thread/recursive_mutex.hpp>
 
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/ModelState.hh"
 #include "gazebo/physics/Entity.hh"
@@ -50,6 +53,7 @@ namespace gazebo
   namespace physics
   {
     class Gripper;
+    class ModelPrivate;
 
     /// \addtogroup gazebo_physics
     /// \{
@@ -78,6 +82,40 @@ namespace gazebo
       /// \brief Update the model.
       public: void Update() override;
 
+      /// \brief Check whether this model can be updated concurrently with
+      /// other models. This is the case when the model is not an actor, has
+      /// no joint animations in progress and none of its joints (including
+      /// those of nested models) connect to a link of another top level
+      /// model. Joint update callbacks registered by plugins must only touch
+      /// their own model for parallel updates to be safe.
+      /// \return True if Model::Update may run on a worker thread.
+      /// \sa PhysicsEngine::SetModelUpdateThreads
+      public: bool ParallelUpdateSafe() const;
+
+      /// \brief Connect to the local update event of the model. The world
+      /// signals it at every step, after Events::worldUpdateBegin and before
+      /// collision detection. The callbacks of a model run in connection
+      /// order, but the callbacks of different top level models may run
+      /// concurrently on the model update threads, so a callback must only
+      /// touch this model and its nested models. Plugins that read or
+      /// write other models must connect to Events::worldUpdateBegin
+      /// instead, whose callbacks run serially.
+      /// \param[in] _subscriber Callback for the connection.
+      /// \return Connection pointer, which must be kept in scope.
+      /// \sa PhysicsEngine::SetModelUpdateThreads
+      public: event::ConnectionPtr ConnectLocalUpdate(
+          std::function<void (const common::UpdateInfo &)> _subscriber);
+
+      /// \brief Check whether this model or one of its nested models has
+      /// local update callbacks.
+      /// \return True if LocalUpdate has callbacks to call.
+      public: bool HasLocalUpdate() const;
+
+      /// \brief Call the local update callbacks of this model, then those of
+      /// its nested models. This is called by the world.
+      /// \param[in] _info Update information.
+      public: void LocalUpdate(const common::UpdateInfo &_info);
+
       /// \brief Finalize the model.
       public: virtual void Fini() override;
 
@@ -192,6 +230,13 @@ namespace gazebo
       /// \return a vector of Link's in this model
       public: const Link_V &GetLinks() const;
 
+      /// \brief Get the links of this model and of its nested models,
+      /// depth first. The list is cached until links or nested models are
+      /// added or removed, so that iterating it doesn't allocate.
+      /// \return The links, valid until links or nested models are added
+      /// or removed.
+      public: const Link_V &AllLinks() const;
+
       /// \brief Get the joints.
       /// \return Vector of joints.
       public: const Joint_V &GetJoints() const;
@@ -201,6 +246,38 @@ namespace gazebo
       /// \return Pointer to the joint
       public: JointPtr GetJoint(const std::string &name);
 
+      /// \brief Get the positions of all the joint axes of this model. The
+      /// axes of a joint follow each other, and the joints are in the order
+      /// of GetJoints(). The positions are read from the physics engine
+      /// once after each physics update, and again when a pose or a
+      /// velocity was set since.
+      /// \return Positions of the joint axes.
+      public: const std::vector<double> &JointPositions();
+
+      /// \brief Get the velocities of all the joint axes of this model, in
+      /// the order of JointPositions().
+      /// \return Velocities of the joint axes.
+      public: const std::vector<double> &JointVelocities();
+
+      /// \brief Read the joint states of this model and its nested models
+      /// into the joint state cache. Only the models whose joint states
+      /// were read since the previous call are updated. This is called by
+      /// the world after each physics update.
+      public: void CacheJointStates();
+
+      /// \brief Mark the cached joint states of this model, the models it
+      /// is nested in and its nested models as stale.
+      public: void InvalidateJointStates();
+
+      /// \internal
+      /// \brief Get a position from the joint state cache.
+      /// \param[in] _joint A joint of this model.
+      /// \param[in] _index Index of the axis of the joint.
+      /// \param[out] _position The position.
+      /// \return False if the cache is stale, or doesn't have the axis.
+      public: bool CachedJointPosition(const Joint &_joint,
+                  const unsigned int _index, double &_position) const;
+
       /// \cond
       /// This is an internal function
       /// \brief Get a link by id.
@@ -344,11 +421,34 @@ namespace gazebo
       /// \return True if auto disable is allowed for this model.
       public: bool GetAutoDisable() const;
 
+      /// \brief Make the links of the model, and of its nested models,
+      /// kinematic. A kinematic link isn't integrated nor solved for, it
+      /// stays where its pose is set and pushes the dynamic bodies it
+      /// touches. Use World::SetModelPoses() to move many kinematic models
+      /// at each step.
+      /// \param[in] _kinematic True to make the links kinematic.
+      public: void SetKinematic(const bool _kinematic);
+
+      /// \brief Get whether all the links of the model are kinematic.
+      /// \return True if the model has links, and they're all kinematic.
+      public: bool IsKinematic() const;
+
       /// \brief Load all plugins
       ///
       /// Load all plugins specified in the SDF for the model.
       public: void LoadPlugins();
 
+      /// \brief Load all the plugins of several models and of their nested
+      /// models. The Load of the plugins that allow it runs concurrently
+      /// on a pool of threads, and the Load of the other plugins runs
+      /// afterwards on the calling thread, in order. The plugins are then
+      /// initialized in order.
+      /// \param[in] _models The models.
+      /// \param[in] _threads Number of threads of the pool.
+      /// \sa ModelPlugin::ConcurrentLoad
+      public: static void LoadPlugins(const Model_V &_models,
+                  const int _threads);
+
       /// \brief Get the number of plugins this model has.
       /// \return Number of plugins associated with this model.
       public: unsigned int GetPluginCount() const;
@@ -377,6 +477,16 @@ namespace gazebo
       /// \return A handle to the Controller for the joints in this model.
       public: JointControllerPtr GetJointController();
 
+      /// \brief Append the links, the joints and the joint controller of
+      /// this model and of its nested models to lists, in a fixed order.
+      /// A joint controller is only listed if it was already created.
+      /// Used by World::SaveSnapshot and World::RestoreSnapshot.
+      /// \param[in,out] _links List of links.
+      /// \param[in,out] _joints List of joints.
+      /// \param[in,out] _controllers List of joint controllers.
+      public: void SnapshotEntities(Link_V &_links, Joint_V &_joints,
+                  JointController_V &_controllers) const;
+
       /// \brief Get a gripper based on an index.
       /// \return A pointer to a Gripper. Null if the _index is invalid.
       public: GripperPtr GetGripper(size_t _index) const;
@@ -483,6 +593,9 @@ namespace gazebo
       /// \brief Register items in the introspection service.
       protected: virtual void RegisterIntrospectionItems() override;
 
+      /// \brief Read the joint states into the joint state cache.
+      private: void FillJointStates();
+
       /// \brief Load all the links.
       private: void LoadLinks();
 
@@ -497,6 +610,29 @@ namespace gazebo
       /// \param[in] _sdf SDF parameter.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
 
+      /// \brief Wait for the sensors of the model before loading its
+      /// plugins.
+      /// \return False if the sensors failed to initialize.
+      private: bool WaitForSensors() const;
+
+      /// \brief Create a plugin.
+      /// \param[in] _sdf SDF of the plugin.
+      /// \return The plugin, null on failure.
+      private: ModelPluginPtr CreatePlugin(sdf::ElementPtr _sdf);
+
+      /// \brief Call the Load of a plugin.
+      /// \param[in] _plugin The plugin.
+      /// \param[in] _sdf SDF of the plugin.
+      /// \return False if Load threw.
+      private: bool CallPluginLoad(ModelPluginPtr _plugin,
+                   sdf::ElementPtr _sdf);
+
+      /// \brief Call the Init of a loaded plugin, and keep it.
+      /// \param[in] _plugin The plugin.
+      /// \param[in] _sdf SDF of the plugin.
+      private: void CallPluginInit(ModelPluginPtr _plugin,
+                   sdf::ElementPtr _sdf);
+
       /// \brief Load a gripper helper function.
       /// \param[in] _sdf SDF parameter.
       private: void LoadGripper(sdf::ElementPtr _sdf);
@@ -506,6 +642,11 @@ namespace gazebo
       /// \param[in] _name Name of the link to remove.
       private: void RemoveLink(const std::string &_name);
 
+      /// \brief Drop the lists of AllLinks() of this model, of the models
+      /// it is nested in and of the world, after links or nested models
+      /// were added or removed.
+      private: void LinksChanged();
+
       /// \brief Publish the scale.
       private: virtual void PublishScale();
 
@@ -559,6 +700,10 @@ namespace gazebo
 
       /// \brief SDF Model DOM object
       private: const sdf::Model *modelSDFDom = nullptr;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ModelPrivate> dataPtr;
     };
     /// \}
   }
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_MODELPRIVATE_HH_
+#define GAZEBO_PHYSICS_MODELPRIVATE_HH_
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/UpdateInfo.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    class Joint;
+
+    /// \internal
+    /// \brief Private data for the Model class.
+    class ModelPrivate
+    {
+      /// \brief Positions of the joint axes, see Model::JointPositions().
+      public: std::vector<double> jointPositionCache;
+
+      /// \brief Velocities of the joint axes, see
+      /// Model::JointVelocities().
+      public: std::vector<double> jointVelocityCache;
+
+      /// \brief Index of the first axis and number of axes of each joint
+      /// in the joint state cache.
+      public: std::unordered_map<const Joint *,
+              std::pair<unsigned int, unsigned int>> jointStateRanges;
+
+      /// \brief True if the joint state cache matches the physics engine.
+      public: std::atomic<bool> jointStatesValid{false};
+
+      /// \brief True if the joint state cache was read since it was last
+      /// filled, so that the joint states of the models nobody reads
+      /// aren't cached.
+      public: std::atomic<bool> jointStatesUsed{false};
+
+      /// \brief Links of the model and of its nested models, see
+      /// Model::AllLinks().
+      public: Link_V allLinks;
+
+      /// \brief True if allLinks is up to date.
+      public: std::atomic<bool> allLinksValid{false};
+
+      /// \brief Protects allLinks.
+      public: std::mutex allLinksMutex;
+
+      /// \brief Local update event, see Model::ConnectLocalUpdate.
+      public: event::EventT<void (const common::UpdateInfo &)> localUpdate;
+    };
+  }
+}
+#endif
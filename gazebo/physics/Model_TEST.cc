@@ -15,12 +15,16 @@
  *
 */
 
+#include <algorithm>
 #include <ignition/msgs/plugin_v.pb.h>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "test/util.hh"
 #include "gazebo/common/URI.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointState.hh"
+#include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 
 using namespace gazebo;
@@ -58,6 +62,40 @@ TEST_F(ModelTest, Scale)
   modelPtr.reset();
 }
 
+//////////////////////////////////////////////////
+TEST_F(ModelTest, ScaleVisualGeometry)
+{
+  this->Load("worlds/empty.world", true);
+  SpawnBox("box", ignition::math::Vector3d(1, 2, 3));
+  auto model = GetModel("box");
+  ASSERT_TRUE(model != nullptr);
+  auto link = model->GetLink();
+  ASSERT_TRUE(link != nullptr);
+
+  // Nothing changed since the visuals were loaded
+  msgs::Link msg;
+  EXPECT_FALSE(link->FillChangedVisualGeometry(msg));
+  EXPECT_EQ(0, msg.visual_size());
+
+  // Scaling updates the visual messages directly
+  model->SetScale(ignition::math::Vector3d(2, 2, 2));
+  EXPECT_TRUE(link->FillChangedVisualGeometry(msg));
+  ASSERT_EQ(1, msg.visual_size());
+  EXPECT_EQ(ignition::math::Vector3d(2, 4, 6),
+      msgs::ConvertIgn(msg.visual(0).geometry().box().size()));
+  ASSERT_EQ(1u, link->Visuals().size());
+  EXPECT_EQ(ignition::math::Vector3d(2, 4, 6), msgs::ConvertIgn(
+      link->Visuals().begin()->second.geometry().box().size()));
+
+  // The changes are only reported once
+  msg.Clear();
+  EXPECT_FALSE(link->FillChangedVisualGeometry(msg));
+
+  // The same scale doesn't change the geometry
+  link->SetScale(ignition::math::Vector3d(2, 2, 2));
+  EXPECT_FALSE(link->FillChangedVisualGeometry(msg));
+}
+
 //////////////////////////////////////////////////
 TEST_F(ModelTest, NestedModelSensorScopedName)
 {
@@ -242,6 +280,77 @@ TEST_F(ModelTest, BoundingBox)
       model->BoundingBox());
 }
 
+//////////////////////////////////////////////////
+TEST_F(ModelTest, JointStateCache)
+{
+  this->Load("test/worlds/pendulum_axes.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto model = world->ModelByName("pendulum_longX_Yaxis");
+  ASSERT_TRUE(model != nullptr);
+  auto joint = model->GetJoint("joint");
+  ASSERT_TRUE(joint != nullptr);
+
+  const std::vector<double> &positions = model->JointPositions();
+  const std::vector<double> &velocities = model->JointVelocities();
+  ASSERT_EQ(1u, positions.size());
+  ASSERT_EQ(1u, velocities.size());
+  const double initialPosition = positions[0];
+  EXPECT_DOUBLE_EQ(initialPosition, joint->Position(0));
+
+  // The pendulum swings under gravity and the cache follows it
+  world->Step(20);
+  EXPECT_NE(initialPosition, model->JointPositions()[0]);
+  EXPECT_DOUBLE_EQ(joint->Position(0), positions[0]);
+  EXPECT_DOUBLE_EQ(joint->GetVelocity(0), velocities[0]);
+  EXPECT_DOUBLE_EQ(joint->Position(0),
+      physics::JointState(joint).Position(0));
+
+  // Setting the position between steps isn't hidden by the cache
+  EXPECT_TRUE(joint->SetPosition(0, 0.3));
+  EXPECT_NEAR(0.3, joint->Position(0), 1e-6);
+  EXPECT_NEAR(0.3, model->JointPositions()[0], 1e-6);
+}
+
+//////////////////////////////////////////////////
+TEST_F(ModelTest, AllLinks)
+{
+  this->Load("worlds/nested_model.world", true);
+
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  auto model = world->ModelByName("model_00");
+  ASSERT_TRUE(model != nullptr);
+  auto nested = model->NestedModel("model_01");
+  ASSERT_TRUE(nested != nullptr);
+
+  // The links of the nested models follow the links of the model
+  const physics::Link_V &links = model->AllLinks();
+  ASSERT_EQ(2u, links.size());
+  EXPECT_EQ("link_00", links[0]->GetName());
+  EXPECT_EQ("link_01", links[1]->GetName());
+  EXPECT_EQ(&links, &model->AllLinks());
+  EXPECT_EQ(nested->GetLinks(), nested->AllLinks());
+
+  const physics::Link_V &worldLinks = world->AllLinks();
+  EXPECT_EQ(&worldLinks, &world->AllLinks());
+  EXPECT_NE(worldLinks.end(),
+      std::find(worldLinks.begin(), worldLinks.end(), links[1]));
+  EXPECT_EQ(world->ModelCount(), world->ModelsRef().size());
+
+  // A removed model leaves the list of the world
+  physics::LinkPtr link = links[1];
+  model.reset();
+  nested.reset();
+  world->RemoveModel("model_00");
+  const physics::Link_V &remaining = world->AllLinks();
+  EXPECT_EQ(remaining.end(),
+      std::find(remaining.begin(), remaining.end(), link));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -164,6 +164,21 @@ int MultiRayShape::GetFiducial(unsigned int _index)
   return this->rays[_index]->GetFiducial();
 }
 
+//////////////////////////////////////////////////
+void MultiRayShape::Scan(std::vector<double> &_ranges,
+    std::vector<double> &_retros) const
+{
+  _ranges.resize(this->rays.size());
+  _retros.resize(this->rays.size());
+
+  // Add min range, because we measured from min range.
+  for (unsigned int i = 0; i < this->rays.size(); ++i)
+  {
+    _ranges[i] = this->minRange + this->rays[i]->GetLength();
+    _retros[i] = this->rays[i]->GetRetro();
+  }
+}
+
 //////////////////////////////////////////////////
 void MultiRayShape::Update()
 {
@@ -80,6 +80,14 @@ namespace gazebo
       /// \return Fiducial value for the ray.
       public: int GetFiducial(unsigned int _index);
 
+      /// \brief Get the detected ranges and retro (intensity) values of all
+      /// the rays in one call.
+      /// \param[out] _ranges Range of each ray, resized to the ray count.
+      /// \param[out] _retros Retro value of each ray, resized to the ray
+      /// count.
+      public: void Scan(std::vector<double> &_ranges,
+                  std::vector<double> &_retros) const;
+
       /// \brief Get the minimum range.
       /// \return Minimum range of all the rays.
       public: double GetMinRange() const;
@@ -15,6 +15,11 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include <boost/lexical_cast.hpp>
 
 #include <sdf/sdf.hh>
@@ -27,11 +32,13 @@
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 
+#include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ContactManager.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PhysicsEnginePrivate.hh"
 #include "gazebo/physics/PresetManager.hh"
 
 using namespace gazebo;
@@ -39,7 +46,7 @@ using namespace physics;
 
 //////////////////////////////////////////////////
 PhysicsEngine::PhysicsEngine(WorldPtr _world)
-  : world(_world)
+  : world(_world), dataPtr(new PhysicsEnginePrivate)
 {
   this->sdf.reset(new sdf::Element);
   sdf::initFile("physics.sdf", this->sdf);
@@ -60,6 +67,8 @@ PhysicsEngine::PhysicsEngine(WorldPtr _world)
                                            &PhysicsEngine::OnRequest, this);
 
   this->physicsUpdateMutex = new boost::recursive_mutex();
+  this->dataPtr->physicsUpdateLockStats =
+    common::LockProfiler::Instance()->Stats("physics/physics_update");
 
   // Create and initialized the contact manager.
   this->contactManager = new ContactManager();
@@ -77,6 +86,92 @@ void PhysicsEngine::Load(sdf::ElementPtr _sdf)
       this->sdf->GetElement("real_time_factor")->Get<double>();
   this->maxStepSize =
       this->sdf->GetElement("max_step_size")->Get<double>();
+
+  // Parallel model updates and plugin loads are opt-in, and not part of
+  // the SDF physics specification.
+  if (_sdf->HasElement("gz:model_update_threads"))
+  {
+    this->SetModelUpdateThreads(_sdf->Get<int>("gz:model_update_threads"));
+  }
+  if (_sdf->HasElement("gz:plugin_load_threads"))
+  {
+    this->SetPluginLoadThreads(_sdf->Get<int>("gz:plugin_load_threads"));
+  }
+
+  // The contact pool grows on demand unless it's sized up front.
+  if (_sdf->HasElement("gz:contact_pool_capacity"))
+  {
+    this->contactManager->SetContactCapacity(
+        std::max(0, _sdf->Get<int>("gz:contact_pool_capacity")));
+  }
+
+  // The adaptive step is opt-in as well.
+  if (_sdf->HasElement("gz:adaptive_step"))
+    this->SetAdaptiveStep(_sdf->Get<bool>("gz:adaptive_step"));
+  if (_sdf->HasElement("gz:adaptive_min_step_size"))
+  {
+    this->SetAdaptiveMinStepSize(
+        _sdf->Get<double>("gz:adaptive_min_step_size"));
+  }
+  if (_sdf->HasElement("gz:adaptive_max_penetration"))
+  {
+    this->SetAdaptiveMaxPenetration(
+        _sdf->Get<double>("gz:adaptive_max_penetration"));
+  }
+
+  // And so is sleeping, with the same thresholds for every engine.
+  if (_sdf->HasElement("gz:sleep"))
+    this->SetSleepEnabled(_sdf->Get<bool>("gz:sleep"));
+  if (_sdf->HasElement("gz:sleep_linear_velocity"))
+  {
+    this->SetSleepLinearVelocity(
+        _sdf->Get<double>("gz:sleep_linear_velocity"));
+  }
+  if (_sdf->HasElement("gz:sleep_angular_velocity"))
+  {
+    this->SetSleepAngularVelocity(
+        _sdf->Get<double>("gz:sleep_angular_velocity"));
+  }
+  if (_sdf->HasElement("gz:sleep_time"))
+    this->SetSleepTime(_sdf->Get<double>("gz:sleep_time"));
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SaveSnapshot(const Link_V &_links,
+    const Joint_V &/*_joints*/, std::vector<double> &_data) const
+{
+  for (auto const &link : _links)
+  {
+    const ignition::math::Pose3d &pose = link->WorldPose();
+    const ignition::math::Vector3d linearVel = link->WorldLinearVel();
+    const ignition::math::Vector3d angularVel = link->WorldAngularVel();
+    const double values[13] = {
+        pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+        pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+        linearVel.X(), linearVel.Y(), linearVel.Z(),
+        angularVel.X(), angularVel.Y(), angularVel.Z()};
+    _data.insert(_data.end(), values, values + 13);
+  }
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::RestoreSnapshot(const Link_V &_links,
+    const Joint_V &/*_joints*/, const double *&_data, const double *_end)
+{
+  if (static_cast<std::size_t>(_end - _data) < 13 * _links.size())
+    return false;
+
+  for (auto const &link : _links)
+  {
+    link->SetWorldPose(ignition::math::Pose3d(_data[0], _data[1], _data[2],
+        _data[3], _data[4], _data[5], _data[6]));
+    link->SetLinearVel(
+        ignition::math::Vector3d(_data[7], _data[8], _data[9]));
+    link->SetAngularVel(
+        ignition::math::Vector3d(_data[10], _data[11], _data[12]));
+    _data += 13;
+  }
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -192,6 +287,200 @@ void PhysicsEngine::SetMaxStepSize(double _stepSize)
   this->maxStepSize = _stepSize;
 }
 
+//////////////////////////////////////////////////
+int PhysicsEngine::ModelUpdateThreads() const
+{
+  return this->dataPtr->modelUpdateThreads;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetModelUpdateThreads(const int _threads)
+{
+  this->dataPtr->modelUpdateThreads = std::max(0, _threads);
+}
+
+//////////////////////////////////////////////////
+int PhysicsEngine::PluginLoadThreads() const
+{
+  return this->dataPtr->pluginLoadThreads;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetPluginLoadThreads(const int _threads)
+{
+  this->dataPtr->pluginLoadThreads = std::max(0, _threads);
+}
+
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::UpdatePhysicsSteps()
+{
+  unsigned int subSteps = 1;
+  if (this->dataPtr->adaptiveStep && this->maxStepSize > 0 &&
+      this->dataPtr->adaptiveMaxPenetration > 0)
+  {
+    const double minStepSize = this->dataPtr->adaptiveMinStepSize > 0 ?
+        std::min(this->dataPtr->adaptiveMinStepSize, this->maxStepSize) :
+        this->maxStepSize / 8.0;
+    const unsigned int maxSubSteps = static_cast<unsigned int>(
+        std::ceil(this->maxStepSize / minStepSize - 1e-9));
+
+    const double depth = this->MaxPenetration();
+    if (depth > this->dataPtr->adaptiveMaxPenetration)
+    {
+      subSteps = static_cast<unsigned int>(std::min<double>(maxSubSteps,
+          std::ceil(depth / this->dataPtr->adaptiveMaxPenetration)));
+    }
+
+    // The sub-steps keep the penetration down, leave the contact-rich
+    // phase gradually so that the step size doesn't oscillate.
+    subSteps = std::max(subSteps, this->dataPtr->adaptiveSubSteps / 2);
+    subSteps = std::max(1u, std::min(subSteps, maxSubSteps));
+  }
+  this->dataPtr->adaptiveSubSteps = subSteps;
+
+  if (subSteps == 1)
+  {
+    this->UpdatePhysics();
+    return subSteps;
+  }
+
+  // The engines clear the forces of the links after each step.
+  const Link_V &links = this->world->AllLinks();
+  std::vector<std::pair<ignition::math::Vector3d,
+      ignition::math::Vector3d>> wrenches;
+  wrenches.reserve(links.size());
+  for (auto const &link : links)
+    wrenches.push_back(std::make_pair(link->WorldForce(), link->WorldTorque()));
+
+  // The engines step, and compute the contact parameters, with
+  // maxStepSize. The contacts of the first collision update were computed
+  // for the step of the world, so they are updated for each sub-step.
+  const double stepSize = this->maxStepSize;
+  this->maxStepSize = stepSize / subSteps;
+  for (unsigned int i = 0; i < subSteps; ++i)
+  {
+    if (i > 0)
+    {
+      for (size_t l = 0; l < links.size(); ++l)
+      {
+        if (wrenches[l].first != ignition::math::Vector3d::Zero)
+          links[l]->SetForce(wrenches[l].first);
+        if (wrenches[l].second != ignition::math::Vector3d::Zero)
+          links[l]->SetTorque(wrenches[l].second);
+      }
+    }
+    this->UpdateCollision();
+    this->UpdatePhysics();
+  }
+  this->maxStepSize = stepSize;
+
+  return subSteps;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::AdaptiveStep() const
+{
+  return this->dataPtr->adaptiveStep;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetAdaptiveStep(const bool _enable)
+{
+  this->dataPtr->adaptiveStep = _enable;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::AdaptiveMinStepSize() const
+{
+  return this->dataPtr->adaptiveMinStepSize;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetAdaptiveMinStepSize(const double _stepSize)
+{
+  this->dataPtr->adaptiveMinStepSize = std::max(0.0, _stepSize);
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::AdaptiveMaxPenetration() const
+{
+  return this->dataPtr->adaptiveMaxPenetration;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetAdaptiveMaxPenetration(const double _depth)
+{
+  this->dataPtr->adaptiveMaxPenetration = std::max(0.0, _depth);
+}
+
+//////////////////////////////////////////////////
+unsigned int PhysicsEngine::AdaptiveSubSteps() const
+{
+  return this->dataPtr->adaptiveSubSteps;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::SleepEnabled() const
+{
+  return this->dataPtr->sleepEnabled;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetSleepEnabled(const bool _enable)
+{
+  this->dataPtr->sleepEnabled = _enable;
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepLinearVelocity() const
+{
+  return this->dataPtr->sleepLinearVelocity;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetSleepLinearVelocity(const double _velocity)
+{
+  this->dataPtr->sleepLinearVelocity = std::max(0.0, _velocity);
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepAngularVelocity() const
+{
+  return this->dataPtr->sleepAngularVelocity;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetSleepAngularVelocity(const double _velocity)
+{
+  this->dataPtr->sleepAngularVelocity = std::max(0.0, _velocity);
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::SleepTime() const
+{
+  return this->dataPtr->sleepTime;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetSleepTime(const double _time)
+{
+  this->dataPtr->sleepTime = std::max(0.0, _time);
+}
+
+//////////////////////////////////////////////////
+double PhysicsEngine::MaxPenetration() const
+{
+  double depth = 0;
+  const unsigned int count = this->contactManager->GetContactCount();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const Contact *contact = this->contactManager->GetContact(i);
+    for (int j = 0; j < contact->count; ++j)
+      depth = std::max(depth, contact->depths[j]);
+  }
+  return depth;
+}
+
 //////////////////////////////////////////////////
 void PhysicsEngine::SetAutoDisableFlag(bool /*_autoDisable*/)
 {
@@ -230,6 +519,29 @@ bool PhysicsEngine::SetParam(const std::string &_key,
       this->SetRealTimeUpdateRate(any_cast<double>(_value));
     else if (_key == "real_time_factor")
       this->SetTargetRealTimeFactor(any_cast<double>(_value));
+    else if (_key == "model_update_threads")
+      this->SetModelUpdateThreads(any_cast<int>(_value));
+    else if (_key == "plugin_load_threads")
+      this->SetPluginLoadThreads(any_cast<int>(_value));
+    else if (_key == "adaptive_step")
+      this->SetAdaptiveStep(any_cast<bool>(_value));
+    else if (_key == "adaptive_min_step_size")
+      this->SetAdaptiveMinStepSize(any_cast<double>(_value));
+    else if (_key == "adaptive_max_penetration")
+      this->SetAdaptiveMaxPenetration(any_cast<double>(_value));
+    else if (_key == "sleep")
+      this->SetSleepEnabled(any_cast<bool>(_value));
+    else if (_key == "sleep_linear_velocity")
+      this->SetSleepLinearVelocity(any_cast<double>(_value));
+    else if (_key == "sleep_angular_velocity")
+      this->SetSleepAngularVelocity(any_cast<double>(_value));
+    else if (_key == "sleep_time")
+      this->SetSleepTime(any_cast<double>(_value));
+    else if (_key == "contact_pool_capacity")
+    {
+      this->contactManager->SetContactCapacity(
+          std::max(0, any_cast<int>(_value)));
+    }
     else if (_key == "gravity")
     {
       boost::any copy = boost::lexical_cast<ignition::math::Vector3d>
@@ -291,6 +603,26 @@ bool PhysicsEngine::GetParam(const std::string &_key,
     _value = this->GetRealTimeUpdateRate();
   else if (_key == "real_time_factor")
     _value = this->GetTargetRealTimeFactor();
+  else if (_key == "model_update_threads")
+    _value = this->ModelUpdateThreads();
+  else if (_key == "plugin_load_threads")
+    _value = this->PluginLoadThreads();
+  else if (_key == "adaptive_step")
+    _value = this->AdaptiveStep();
+  else if (_key == "adaptive_min_step_size")
+    _value = this->AdaptiveMinStepSize();
+  else if (_key == "adaptive_max_penetration")
+    _value = this->AdaptiveMaxPenetration();
+  else if (_key == "sleep")
+    _value = this->SleepEnabled();
+  else if (_key == "sleep_linear_velocity")
+    _value = this->SleepLinearVelocity();
+  else if (_key == "sleep_angular_velocity")
+    _value = this->SleepAngularVelocity();
+  else if (_key == "sleep_time")
+    _value = this->SleepTime();
+  else if (_key == "contact_pool_capacity")
+    _value = static_cast<int>(this->contactManager->ContactCapacity());
   else if (_key == "gravity")
     _value = this->world->Gravity();
   else if (_key == "magnetic_field")
@@ -322,3 +654,15 @@ WorldPtr PhysicsEngine::World() const
 {
   return this->world;
 }
+
+//////////////////////////////////////////////////
+SceneQueries &PhysicsEngine::SceneQueries() const
+{
+  return this->world->SceneQueries();
+}
+
+//////////////////////////////////////////////////
+common::LockStats *PhysicsEngine::PhysicsUpdateLockStats() const
+{
+  return this->dataPtr->physicsUpdateLockStats;
+}
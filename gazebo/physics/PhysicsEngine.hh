@@ -19,9 +19,12 @@
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <boost/any.hpp>
+#include <memory>
 #include <string>
+#include <vector>
 #include <ignition/transport/Node.hh>
 
+#include "gazebo/common/LockProfiler.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 
@@ -33,6 +36,7 @@ namespace gazebo
   namespace physics
   {
     class ContactManager;
+    class PhysicsEnginePrivate;
 
     /// \addtogroup gazebo_physics
     /// \{
@@ -97,6 +101,38 @@ namespace gazebo
       /// \param[in] _seed The random number seed.
       public: virtual void SetSeed(uint32_t _seed) = 0;
 
+      /// \brief Append the dynamic state of links and joints to a world
+      /// snapshot. The default implementation saves the pose and velocity
+      /// of each link. Engines override it to save their exact body state
+      /// and solver data.
+      /// \param[in] _links Links of the world.
+      /// \param[in] _joints Joints of the world.
+      /// \param[in,out] _data Buffer that receives the state.
+      /// \sa World::SaveSnapshot
+      public: virtual void SaveSnapshot(const Link_V &_links,
+                  const Joint_V &_joints, std::vector<double> &_data) const;
+
+      /// \brief Restore the state appended by SaveSnapshot.
+      /// \param[in] _links Links of the world.
+      /// \param[in] _joints Joints of the world.
+      /// \param[in,out] _data Start of the state, moved past it.
+      /// \param[in] _end End of the buffer.
+      /// \return False if the buffer is too short.
+      public: virtual bool RestoreSnapshot(const Link_V &_links,
+                  const Joint_V &_joints, const double *&_data,
+                  const double *_end);
+
+      /// \brief Start initializing several models at once. Engines that
+      /// rebuild their whole system when a model is initialized may defer
+      /// that work until the matching EndModelBatch call. Batches nest.
+      /// \sa EndModelBatch
+      public: virtual void BeginModelBatch() {}
+
+      /// \brief Finish initializing the models of a batch. The models are
+      /// fully initialized once the outermost batch ends.
+      /// \sa BeginModelBatch
+      public: virtual void EndModelBatch() {}
+
       /// \brief Get the simulation update period.
       /// \return Simulation update period.
       public: double GetUpdatePeriod();
@@ -125,12 +161,125 @@ namespace gazebo
       /// \param[in] _stepSize Max step size.
       public: void SetMaxStepSize(double _stepSize);
 
+      /// \brief Get the number of threads used to update models in
+      /// parallel. A value smaller than 2 means models are updated serially.
+      /// \return Number of model update threads.
+      /// \sa World::Update
+      public: int ModelUpdateThreads() const;
+
+      /// \brief Set the number of threads used to update models in
+      /// parallel. Only models whose update does not touch other models are
+      /// updated concurrently; see Model::ParallelUpdateSafe.
+      /// \param[in] _threads Number of model update threads, values smaller
+      /// than 2 disable parallel model updates.
+      public: void SetModelUpdateThreads(const int _threads);
+
+      /// \brief Get the number of threads used to load model plugins in
+      /// parallel. A value smaller than 2 means plugins are loaded serially.
+      /// \return Number of plugin load threads.
+      /// \sa World::LoadPlugins
+      public: int PluginLoadThreads() const;
+
+      /// \brief Set the number of threads used to load model plugins in
+      /// parallel. Only plugins that allow it are loaded concurrently; see
+      /// ModelPlugin::ConcurrentLoad.
+      /// \param[in] _threads Number of plugin load threads, values smaller
+      /// than 2 disable parallel plugin loads.
+      public: void SetPluginLoadThreads(const int _threads);
+
       /// \brief Update the physics engine.
       /// Will only be called if the physics are enabled, which
       /// is the case when World::PhysicsEnabled() returns true.
       /// \sa PhysicsEngine::UpdateCollision()
       public: virtual void UpdatePhysics() {}
 
+      /// \brief Advance the physics over a step of the world, which lasts
+      /// GetMaxStepSize(). With the adaptive step, the step is split into
+      /// sub-steps when the deepest penetration found by the last
+      /// UpdateCollision() exceeds AdaptiveMaxPenetration(). The collisions
+      /// are then updated again before each sub-step, GetMaxStepSize()
+      /// returns the sub-step size during the sub-steps, and the forces
+      /// applied to the links before the step act during each sub-step.
+      /// The events, sensors and plugins keep the rate of the world.
+      /// \return Number of sub-steps.
+      /// \sa SetAdaptiveStep
+      public: unsigned int UpdatePhysicsSteps();
+
+      /// \brief Get whether the adaptive step is enabled.
+      /// \return True if the step of the world may be split into sub-steps.
+      public: bool AdaptiveStep() const;
+
+      /// \brief Enable the adaptive step. The step size of the world stays
+      /// GetMaxStepSize(), the internal step size of the physics goes down
+      /// to AdaptiveMinStepSize() during contact-rich phases.
+      /// \param[in] _enable True to enable the adaptive step.
+      public: void SetAdaptiveStep(const bool _enable);
+
+      /// \brief Get the smallest internal step size of the adaptive step.
+      /// \return Step size in seconds, 0 for an eighth of GetMaxStepSize().
+      public: double AdaptiveMinStepSize() const;
+
+      /// \brief Set the smallest internal step size of the adaptive step.
+      /// \param[in] _stepSize Step size in seconds, 0 for an eighth of
+      /// GetMaxStepSize().
+      public: void SetAdaptiveMinStepSize(const double _stepSize);
+
+      /// \brief Get the penetration above which the adaptive step splits
+      /// the step of the world.
+      /// \return Penetration depth in meters.
+      public: double AdaptiveMaxPenetration() const;
+
+      /// \brief Set the penetration above which the adaptive step splits
+      /// the step of the world. The sub-step size is the step size scaled by
+      /// the ratio of this penetration to the deepest one.
+      /// \param[in] _depth Penetration depth in meters.
+      public: void SetAdaptiveMaxPenetration(const double _depth);
+
+      /// \brief Get the number of sub-steps of the last step of the world.
+      /// \return Number of sub-steps, 0 before the first step.
+      public: unsigned int AdaptiveSubSteps() const;
+
+      /// \brief Get the deepest penetration between two collisions found
+      /// by the last UpdateCollision(), the error estimate of the adaptive
+      /// step. The default implementation reads the contacts of the contact
+      /// manager, which only holds the contacts that someone listens to.
+      /// \return Penetration depth in meters.
+      public: virtual double MaxPenetration() const;
+
+      /// \brief Get whether the idle models are put to sleep.
+      /// \return True if the sleep manager of the world is enabled.
+      /// \sa SleepManager
+      public: bool SleepEnabled() const;
+
+      /// \brief Enable putting the idle models to sleep, with the same
+      /// thresholds for every engine. Disabling it wakes the models.
+      /// \param[in] _enable True to enable sleeping.
+      public: void SetSleepEnabled(const bool _enable);
+
+      /// \brief Get the linear velocity under which a link is idle.
+      /// \return Velocity in m/s.
+      public: double SleepLinearVelocity() const;
+
+      /// \brief Set the linear velocity under which a link is idle.
+      /// \param[in] _velocity Velocity in m/s.
+      public: void SetSleepLinearVelocity(const double _velocity);
+
+      /// \brief Get the angular velocity under which a link is idle.
+      /// \return Velocity in rad/s.
+      public: double SleepAngularVelocity() const;
+
+      /// \brief Set the angular velocity under which a link is idle.
+      /// \param[in] _velocity Velocity in rad/s.
+      public: void SetSleepAngularVelocity(const double _velocity);
+
+      /// \brief Get the sim time a model stays idle before it sleeps.
+      /// \return Time in seconds.
+      public: double SleepTime() const;
+
+      /// \brief Set the sim time a model stays idle before it sleeps.
+      /// \param[in] _time Time in seconds.
+      public: void SetSleepTime(const double _time);
+
       /// \brief Create a new model.
       /// \param[in] _base Boost shared pointer to a new model.
       public: virtual ModelPtr CreateModel(BasePtr _base);
@@ -215,6 +364,22 @@ namespace gazebo
       ///          (defined but not used in ode).
       ///       -# "max_step_size" (double) - maximum physics step size when
       ///          physics update step must return.
+      ///       -# "model_update_threads" (int) - number of worker threads
+      ///          used by World::Update to update models concurrently.
+      ///          Values smaller than 2 keep the serial model update.
+      ///       -# "adaptive_step" (bool) - split the step of the world into
+      ///          sub-steps during contact-rich phases.
+      ///       -# "adaptive_min_step_size" (double) - smallest sub-step
+      ///          size of the adaptive step.
+      ///       -# "adaptive_max_penetration" (double) - penetration depth
+      ///          above which the adaptive step splits the step.
+      ///       -# "sleep" (bool) - put the idle models to sleep.
+      ///       -# "sleep_linear_velocity" (double) - linear velocity under
+      ///          which a link is idle.
+      ///       -# "sleep_angular_velocity" (double) - angular velocity under
+      ///          which a link is idle.
+      ///       -# "sleep_time" (double) - sim time a model stays idle
+      ///          before it sleeps.
       ///
       /// \param[in] _value The value to set to
       /// \return true if SetParam is successful, false if operation fails.
@@ -242,6 +407,11 @@ namespace gazebo
       /// \return Pointer to the world.
       public: WorldPtr World() const;
 
+      /// \brief Get the scene queries of the world, that run rays, sweeps
+      /// and overlap tests from any thread.
+      /// \return Reference to the scene queries.
+      public: physics::SceneQueries &SceneQueries() const;
+
       /// \brief Get a pointer to the contact manger.
       /// \return Pointer to the contact manager.
       public: ContactManager *GetContactManager() const;
@@ -288,6 +458,11 @@ namespace gazebo
       /// \param[in] _msg Physics message.
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
 
+      /// \brief Account of physicsUpdateMutex, for the engines to lock it
+      /// with a common::ProfiledLock in the step path.
+      /// \return The lock statistics of the physics update mutex.
+      protected: common::LockStats *PhysicsUpdateLockStats() const;
+
       /// \brief Pointer to the world.
       protected: WorldPtr world;
 
@@ -322,6 +497,10 @@ namespace gazebo
       /// \brief Real time update rate.
       protected: double maxStepSize;
 
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PhysicsEnginePrivate> dataPtr;
+
       // Place ignition::transport objects at the end of this file to
       // guarantee they are destructed first.
 
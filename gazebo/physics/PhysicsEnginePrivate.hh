@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_PHYSICSENGINEPRIVATE_HH_
+#define GAZEBO_PHYSICS_PHYSICSENGINEPRIVATE_HH_
+
+#include "gazebo/common/LockProfiler.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for the PhysicsEngine class.
+    class PhysicsEnginePrivate
+    {
+      /// \brief Account of the physics update mutex.
+      public: common::LockStats *physicsUpdateLockStats = nullptr;
+
+      /// \brief Number of threads used to update models in parallel.
+      public: int modelUpdateThreads = 0;
+
+      /// \brief Number of threads used to load model plugins in parallel.
+      public: int pluginLoadThreads = 0;
+
+      /// \brief True to put the idle models to sleep.
+      public: bool sleepEnabled = false;
+
+      /// \brief Linear velocity under which a link is idle.
+      public: double sleepLinearVelocity = 0.05;
+
+      /// \brief Angular velocity under which a link is idle.
+      public: double sleepAngularVelocity = 0.05;
+
+      /// \brief Sim time a model stays idle before it sleeps.
+      public: double sleepTime = 0.5;
+
+      /// \brief True to split the step of the world into sub-steps.
+      public: bool adaptiveStep = false;
+
+      /// \brief Smallest sub-step size, 0 for an eighth of maxStepSize.
+      public: double adaptiveMinStepSize = 0;
+
+      /// \brief Penetration depth above which the step is split.
+      public: double adaptiveMaxPenetration = 0.005;
+
+      /// \brief Number of sub-steps of the last step of the world.
+      public: unsigned int adaptiveSubSteps = 0;
+    };
+  }
+}
+#endif
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <any>
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/test/helper_physics_generator.hh"
@@ -28,6 +29,7 @@ class PhysicsEngineTest : public ServerFixture,
   public: void OnPhysicsMsgResponse(ConstResponsePtr &_msg);
   public: void PhysicsEngineParam(const std::string &_physicsEngine);
   public: void PhysicsEngineGetParamBool(const std::string &_physicsEngine);
+  public: void AdaptiveStep(const std::string &_physicsEngine);
   public: static msgs::Physics physicsPubMsg;
   public: static msgs::Physics physicsResponseMsg;
 };
@@ -242,6 +244,63 @@ TEST_P(PhysicsEngineTest, PhysicsEngineGetParamBool)
   PhysicsEngineGetParamBool(GetParam());
 }
 
+/////////////////////////////////////////////////
+void PhysicsEngineTest::AdaptiveStep(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode")
+  {
+    gzerr << "Aborting test for " << _physicsEngine << ", only ODE "
+          << "estimates the penetration of all the contacts.\n";
+    return;
+  }
+
+  Load("worlds/shapes.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  const double dt = physics->GetMaxStepSize();
+
+  EXPECT_FALSE(physics->AdaptiveStep());
+  EXPECT_TRUE(physics->SetParam("adaptive_step", true));
+  EXPECT_TRUE(physics->SetParam("adaptive_max_penetration", 0.01));
+  EXPECT_TRUE(boost::any_cast<bool>(physics->GetParam("adaptive_step")));
+  EXPECT_DOUBLE_EQ(0.01, boost::any_cast<double>(
+      physics->GetParam("adaptive_max_penetration")));
+  EXPECT_DOUBLE_EQ(0.0, physics->AdaptiveMinStepSize());
+
+  // Resting shapes don't split the step
+  world->Step(50);
+  EXPECT_EQ(1u, physics->AdaptiveSubSteps());
+
+  // A fast impact does, and the world keeps its step size
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != NULL);
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 0.6, 0, 0, 0));
+  box->SetLinearVel(ignition::math::Vector3d(0, 0, -50));
+
+  const common::Time start = world->SimTime();
+  unsigned int maxSubSteps = 0;
+  for (int i = 0; i < 20; ++i)
+  {
+    world->Step(1);
+    maxSubSteps = std::max(maxSubSteps, physics->AdaptiveSubSteps());
+  }
+  EXPECT_GT(maxSubSteps, 1u);
+  EXPECT_LE(maxSubSteps, 8u);
+  EXPECT_NEAR((world->SimTime() - start).Double(), 20 * dt, 1e-9);
+  EXPECT_DOUBLE_EQ(dt, physics->GetMaxStepSize());
+
+  // Then leaves the contact-rich phase
+  world->Step(500);
+  EXPECT_EQ(1u, physics->AdaptiveSubSteps());
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsEngineTest, AdaptiveStep)
+{
+  AdaptiveStep(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsEngineTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
@@ -96,6 +96,12 @@ bool physics::has_world(const std::string &_name)
   return false;
 }
 
+/////////////////////////////////////////////////
+std::vector<physics::WorldPtr> physics::get_worlds()
+{
+  return g_worlds;
+}
+
 /////////////////////////////////////////////////
 void physics::load_worlds(sdf::ElementPtr _sdf)
 {
@@ -51,6 +51,11 @@ namespace gazebo
     class UserCmd;
     class UserCmdManager;
     class PhysicsEngine;
+    class ForceFields;
+    class RegionTriggers;
+    class SceneQueries;
+    class SleepManager;
+    class StepStatePublisher;
     class Wind;
     class Atmosphere;
     class Mass;
@@ -37,19 +37,34 @@ PolylineShape::~PolylineShape()
 {
 }
 
+//////////////////////////////////////////////////
+void PolylineShape::Load(sdf::ElementPtr _sdf)
+{
+  Base::Load(_sdf);
+
+  this->meshName = boost::lexical_cast<std::string>(physics::getUniqueId()) +
+      "_extruded_polyline";
+  common::MeshManager::Instance()->CreateExtrudedPolylineAsync(
+      this->meshName, this->Vertices(), this->GetHeight());
+}
+
 //////////////////////////////////////////////////
 void PolylineShape::Init()
 {
   this->SetPolylineShape(this->GetHeight(), this->Vertices());
 
-  std::string meshName =
-      boost::lexical_cast<std::string>(physics::getUniqueId()) +
-      "_extruded_polyline";
+  if (this->meshName.empty())
+  {
+    this->meshName =
+        boost::lexical_cast<std::string>(physics::getUniqueId()) +
+        "_extruded_polyline";
+  }
 
+  // Waits for the mesh if it is still generated on a worker thread
   common::MeshManager::Instance()->CreateExtrudedPolyline(
-      meshName, this->Vertices(), this->GetHeight());
+      this->meshName, this->Vertices(), this->GetHeight());
 
-  this->mesh = common::MeshManager::Instance()->GetMesh(meshName);
+  this->mesh = common::MeshManager::Instance()->GetMesh(this->meshName);
 
   if (!this->mesh)
     gzerr << "Unable to create polyline mesh\n";
@@ -155,6 +170,8 @@ void PolylineShape::ProcessMsg(const msgs::Geometry &_msg)
   {
     this->SetHeight(_msg.polyline(0).height());
     this->SetVertices(_msg);
+    // The next Init extrudes the new polylines
+    this->meshName.clear();
   }
   else
     gzerr << "Unable to process message, no polyline shape.\n";
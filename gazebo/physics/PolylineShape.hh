@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_POLYLINESHAPE_HH_
 #define GAZEBO_PHYSICS_POLYLINESHAPE_HH_
 
+#include <string>
 #include <vector>
 #include "gazebo/physics/Shape.hh"
 
@@ -38,6 +39,12 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~PolylineShape();
 
+      /// \brief Load the polyline, and start generating its mesh on a
+      /// worker thread, so that the meshes of several polylines are
+      /// generated in parallel while the world loads.
+      /// \param[in] _sdf SDF of the polyline.
+      public: virtual void Load(sdf::ElementPtr _sdf);
+
       /// \brief Initialize the polyLine.
       public: virtual void Init();
 
@@ -95,6 +102,9 @@ namespace gazebo
 
       /// \brief Pointer to the mesh data.
       protected: const common::Mesh *mesh;
+
+      /// \brief Name of the mesh, empty until it is requested.
+      private: std::string meshName;
     };
     /// \}
   }
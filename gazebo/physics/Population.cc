@@ -15,12 +15,14 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <string>
 #include <vector>
-#include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
-#include <ignition/math/Kmeans.hh>
 #include <ignition/math/Rand.hh>
+#include <ignition/math/Vector2.hh>
 #include <sdf/sdf.hh>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -33,6 +35,162 @@ using namespace gazebo;
 using namespace common;
 using namespace physics;
 
+/// \brief Number of candidates tried around a sample before it is retired.
+static const int kPoissonCandidates = 30;
+
+/////////////////////////////////////////////////
+/// \brief Poisson-disk samples of a region (Bridson's algorithm). A
+/// background grid, with cells small enough to hold a single sample, limits
+/// the spacing check of a candidate to its neighbouring cells.
+/// \param[in] _min Minimum corner of the rectangle bounding the region.
+/// \param[in] _size Size of the rectangle bounding the region.
+/// \param[in] _spacing Minimum distance between two samples.
+/// \param[in] _inside Returns true if a point is in the region.
+/// \return Samples, in the order they were generated.
+static std::vector<ignition::math::Vector2d> poissonDisk(
+    const ignition::math::Vector2d &_min, const ignition::math::Vector2d &_size,
+    const double _spacing,
+    const std::function<bool (const ignition::math::Vector2d &)> &_inside)
+{
+  std::vector<ignition::math::Vector2d> samples;
+
+  const double cell = _spacing / std::sqrt(2.0);
+  const int cols = std::max(1, static_cast<int>(std::ceil(_size.X() / cell)));
+  const int rows = std::max(1, static_cast<int>(std::ceil(_size.Y() / cell)));
+  std::vector<int> grid(cols * rows, -1);
+
+  auto cellOf = [&](const ignition::math::Vector2d &_p, int &_col, int &_row)
+  {
+    _col = std::min(cols - 1, static_cast<int>((_p.X() - _min.X()) / cell));
+    _row = std::min(rows - 1, static_cast<int>((_p.Y() - _min.Y()) / cell));
+  };
+
+  auto accept = [&](const ignition::math::Vector2d &_p)
+  {
+    if (_p.X() < _min.X() || _p.Y() < _min.Y() ||
+        _p.X() > _min.X() + _size.X() || _p.Y() > _min.Y() + _size.Y() ||
+        !_inside(_p))
+    {
+      return false;
+    }
+
+    int col, row;
+    cellOf(_p, col, row);
+    for (int r = std::max(0, row - 2); r <= std::min(rows - 1, row + 2); ++r)
+    {
+      for (int c = std::max(0, col - 2); c <= std::min(cols - 1, col + 2); ++c)
+      {
+        const int index = grid[r * cols + c];
+        if (index >= 0 && samples[index].Distance(_p) < _spacing)
+          return false;
+      }
+    }
+    return true;
+  };
+
+  auto add = [&](const ignition::math::Vector2d &_p)
+  {
+    int col, row;
+    cellOf(_p, col, row);
+    grid[row * cols + col] = static_cast<int>(samples.size());
+    samples.push_back(_p);
+  };
+
+  // Seed with the first random point of the region.
+  for (int i = 0; i < kPoissonCandidates && samples.empty(); ++i)
+  {
+    ignition::math::Vector2d p(
+        _min.X() + ignition::math::Rand::DblUniform(0, _size.X()),
+        _min.Y() + ignition::math::Rand::DblUniform(0, _size.Y()));
+    if (_inside(p))
+      add(p);
+  }
+
+  // Grow from the active samples, trying candidates in the annulus
+  // [spacing, 2 * spacing] around each of them.
+  std::vector<int> active(samples.size(), 0);
+  while (!active.empty())
+  {
+    const int pick = ignition::math::Rand::IntUniform(0,
+        static_cast<int>(active.size()) - 1);
+    const ignition::math::Vector2d center = samples[active[pick]];
+
+    bool found = false;
+    for (int i = 0; i < kPoissonCandidates && !found; ++i)
+    {
+      const double ang = ignition::math::Rand::DblUniform(0, 2 * M_PI);
+      const double r = ignition::math::Rand::DblUniform(_spacing,
+          2 * _spacing);
+      ignition::math::Vector2d p(center.X() + r * cos(ang),
+          center.Y() + r * sin(ang));
+      if (accept(p))
+      {
+        active.push_back(static_cast<int>(samples.size()));
+        add(p);
+        found = true;
+      }
+    }
+
+    if (!found)
+    {
+      active[pick] = active.back();
+      active.pop_back();
+    }
+  }
+
+  return samples;
+}
+
+/////////////////////////////////////////////////
+/// \brief Pick '_count' well spaced points of a region. The spacing is
+/// derived from the area of the region, and reduced until Poisson-disk
+/// sampling yields enough points. A random subset of the samples keeps
+/// their spacing.
+/// \param[in] _count Number of points.
+/// \param[in] _min Minimum corner of the rectangle bounding the region.
+/// \param[in] _size Size of the rectangle bounding the region.
+/// \param[in] _area Area of the region.
+/// \param[in] _inside Returns true if a point is in the region.
+/// \return The points.
+static std::vector<ignition::math::Vector2d> spacedPoints(const int _count,
+    const ignition::math::Vector2d &_min, const ignition::math::Vector2d &_size,
+    const double _area,
+    const std::function<bool (const ignition::math::Vector2d &)> &_inside)
+{
+  std::vector<ignition::math::Vector2d> samples;
+  if (_count <= 0)
+    return samples;
+
+  // A Poisson-disk set covers about 0.6 / spacing^2 points per unit area.
+  double spacing = std::sqrt(0.5 * _area / _count);
+  while (spacing > 1e-6)
+  {
+    samples = poissonDisk(_min, _size, spacing, _inside);
+    if (static_cast<int>(samples.size()) >= _count)
+      break;
+    spacing *= 0.9;
+  }
+
+  // Degenerate region: use random points.
+  while (static_cast<int>(samples.size()) < _count)
+  {
+    samples.push_back(ignition::math::Vector2d(
+        _min.X() + ignition::math::Rand::DblUniform(0, _size.X()),
+        _min.Y() + ignition::math::Rand::DblUniform(0, _size.Y())));
+  }
+
+  // Random subset of the samples.
+  for (int i = 0; i < _count; ++i)
+  {
+    const int j = ignition::math::Rand::IntUniform(i,
+        static_cast<int>(samples.size()) - 1);
+    std::swap(samples[i], samples[j]);
+  }
+  samples.resize(_count);
+
+  return samples;
+}
+
 //////////////////////////////////////////////////
 Population::Population(sdf::ElementPtr _sdf, boost::shared_ptr<World> _world)
   : dataPtr(new PopulationPrivate)
@@ -101,37 +259,26 @@ bool Population::PopulateOne(const sdf::ElementPtr _population)
     return false;
   }
 
-  // Create an sdf containing the model description.
+  // Create an sdf containing the model description. Every clone is spawned
+  // from it in one batch.
   sdf::SDF sdf;
   sdf.SetFromString("<sdf version ='" + std::string(SDF_PROTOCOL_VERSION) +
     "'>" + params.modelSdf + "</sdf>");
 
+  std::vector<ignition::math::Pose3d> poses;
+  std::vector<std::string> names;
+  poses.reserve(objects.size());
+  names.reserve(objects.size());
   for (size_t i = 0; i < objects.size(); ++i)
   {
-    ignition::math::Vector3d p(objects[i].X(), objects[i].Y(), objects[i].Z());
-
-    // Create a unique model for each clone.
-    std::string cloneSdf = sdf.ToString();
-    std::string delim = "model name='";
-    size_t first = cloneSdf.find(delim) + delim.size();
-    size_t last = cloneSdf.find("'", first);
-    std::string newName = params.modelName + std::string("_clone_") +
-      boost::lexical_cast<std::string>(i);
-    cloneSdf.replace(first, last - first, newName);
-
-    // Insert the <pose> element.
-    std::string endDelim = "'>";
-    first = cloneSdf.find(delim) + delim.size();
-    last = cloneSdf.find(endDelim, first);
-    std::string pose = "\n    <pose>" +
-      boost::lexical_cast<std::string>(p.X()) + " " +
-      boost::lexical_cast<std::string>(p.Y()) + " " +
-      boost::lexical_cast<std::string>(p.Z()) + " 0 0 0</pose>";
-    cloneSdf.insert(last + endDelim.size(), pose);
-
-    this->dataPtr->world->InsertModelString(cloneSdf);
+    poses.push_back(ignition::math::Pose3d(objects[i],
+        ignition::math::Quaterniond::Identity));
+    names.push_back(params.modelName + "_clone_" + std::to_string(i));
   }
 
+  if (!poses.empty())
+    this->dataPtr->world->InsertModelCopies(sdf, poses, names);
+
   return true;
 }
 
@@ -356,38 +503,22 @@ void Population::CreatePosesBoxUniform(const PopulationParams &_populParams,
   // _poses should be empty.
   GZ_ASSERT(_poses.empty(), "Output parameter '_poses' is not empty");
 
-  std::vector<ignition::math::Vector3d> obs;
-
-  // Step1: Sample points in a box.
-  double x = 0.0;
-  double y = 0.0;
-  while (y < _populParams.size.Y())
-  {
-    while (x < _populParams.size.X())
-    {
-      ignition::math::Vector3d p;
-      p.X(x);
-      p.Y(y);
-      p.Z(ignition::math::Rand::DblUniform(0, _populParams.size.Z()));
-      obs.push_back(p);
-      x += .1;
-    }
-    x = 0.0;
-    y += .1;
-  }
-
-  // Step2: Cluster the sampled points in 'modelCount' clusters.
-  std::vector<ignition::math::Vector3d> centroids;
-  std::vector<unsigned int> labels;
-  ignition::math::Kmeans kmeans(obs);
-  kmeans.Cluster(_populParams.modelCount, centroids, labels);
+  // Well spaced points in the XY rectangle of the box, at random heights.
+  const ignition::math::Vector2d size(_populParams.size.X(),
+      _populParams.size.Y());
+  std::vector<ignition::math::Vector2d> points = spacedPoints(
+      _populParams.modelCount, ignition::math::Vector2d::Zero, size,
+      size.X() * size.Y(),
+      [](const ignition::math::Vector2d &)
+      {
+        return true;
+      });
 
-  // Step3: Create the list of object positions.
   _poses.clear();
-  for (int i = 0; i < _populParams.modelCount; ++i)
+  for (auto const &point : points)
   {
-    ignition::math::Pose3d p(centroids[i],
-                             ignition::math::Quaterniond::Identity);
+    ignition::math::Pose3d p(point.X(), point.Y(),
+        ignition::math::Rand::DblUniform(0, _populParams.size.Z()), 0, 0, 0);
     _poses.push_back((p + _populParams.pose).Pos());
   }
 
@@ -526,33 +657,22 @@ void Population::CreatePosesCylinderUniform(
   // _poses should be empty.
   GZ_ASSERT(_poses.empty(), "Output parameter '_poses' is not empty");
 
-  std::vector<ignition::math::Vector3d> obs;
-
-  // Step1: Sample points in the cylinder.
-  unsigned int points = 10000;
-  for (size_t i = 0; i < points; ++i)
-  {
-    double ang = ignition::math::Rand::DblUniform(0, 2 * M_PI);
-    double r = ignition::math::Rand::DblUniform(0, _populParams.radius);
-    ignition::math::Vector3d p;
-    p.X(r * cos(ang));
-    p.Y(r * sin(ang));
-    p.Z(ignition::math::Rand::DblUniform(0, _populParams.length));
-    obs.push_back(p);
-  }
-
-  // Step2: Cluster the sampled points in 'modelCount' clusters.
-  std::vector<ignition::math::Vector3d> centroids;
-  std::vector<unsigned int> labels;
-  ignition::math::Kmeans kmeans(obs);
-  kmeans.Cluster(_populParams.modelCount, centroids, labels);
+  // Well spaced points in the base of the cylinder, at random heights.
+  const double radius = _populParams.radius;
+  std::vector<ignition::math::Vector2d> points = spacedPoints(
+      _populParams.modelCount, ignition::math::Vector2d(-radius, -radius),
+      ignition::math::Vector2d(2 * radius, 2 * radius), M_PI * radius * radius,
+      [radius](const ignition::math::Vector2d &_p)
+      {
+        return _p.Length() <= radius;
+      });
 
-  // Step3: Create the list of object positions.
   _poses.clear();
   ignition::math::Pose3d offset = ignition::math::Pose3d::Zero;
-  for (int i = 0; i < _populParams.modelCount; ++i)
+  for (auto const &point : points)
   {
-    offset.Pos() = centroids[i];
+    offset.Pos().Set(point.X(), point.Y(),
+        ignition::math::Rand::DblUniform(0, _populParams.length));
     _poses.push_back((offset + _populParams.pose).Pos());
   }
 
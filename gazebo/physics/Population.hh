@@ -154,8 +154,9 @@ namespace gazebo
         std::vector<ignition::math::Vector3d> &_poses);
 
       /// \brief Populate a vector of poses with '_modelCount' elements,
-      /// uniformly distributed within a box. We use k-means to split the
-      /// box in similar subregions.
+      /// uniformly distributed within a box. The XY positions are a
+      /// Poisson-disk sample of the box, so that the models keep a minimum
+      /// spacing.
       /// \param[in] _modelCount Number of poses.
       /// \param[in] _min Minimum corner of the box containing the models.
       /// \param[in] _max Maximum corner of the box containing the models.
@@ -222,8 +223,9 @@ namespace gazebo
         std::vector<ignition::math::Vector3d> &_poses);
 
       /// \brief Populate a vector of poses with '_modelCount' elements,
-      /// uniformly distributed within a cylinder. We use k-means to split the
-      /// cylinder in similar subregions.
+      /// uniformly distributed within a cylinder. The XY positions are a
+      /// Poisson-disk sample of the cylinder's base, so that the models keep
+      /// a minimum spacing.
       /// \param[in] _modelCount Number of poses.
       /// \param[in] _center Center of the cylinder's base containing
       /// the models.
@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Helpers.hh>
+
+#include "gazebo/physics/AABBTree.hh"
+#include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/RegionTriggers.hh"
+#include "gazebo/physics/World.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief An entity watched by at least one region.
+    class TriggerEntity
+    {
+      /// \brief Scoped name of the entity.
+      public: std::string name;
+
+      /// \brief The entity, once found.
+      public: boost::weak_ptr<Entity> entity;
+
+      /// \brief Proxy of the origin of the entity in the tree, -1 if the
+      /// entity is missing.
+      public: int proxy = -1;
+
+      /// \brief Origin of the entity in the world frame.
+      public: ignition::math::Vector3d pos;
+    };
+
+    /// \internal
+    /// \brief A region.
+    class TriggerRegion
+    {
+      /// \brief Box of the region.
+      public: ignition::math::OrientedBoxd box;
+
+      /// \brief Scoped name of the frame entity, empty for the world.
+      public: std::string frame;
+
+      /// \brief The frame entity, once found.
+      public: boost::weak_ptr<Entity> frameEntity;
+
+      /// \brief Names of the watched entities.
+      public: std::vector<std::string> names;
+
+      /// \brief Index in the region of each watched entity, by index of
+      /// the entity in RegionTriggersPrivate::entities.
+      public: std::unordered_map<unsigned int, std::size_t> slots;
+
+      /// \brief State of each watched entity, 1 inside, 0 outside and -1
+      /// before the first evaluation.
+      public: std::vector<int> states;
+
+      /// \brief Callback of the transitions.
+      public: RegionTriggers::Callback callback;
+    };
+
+    /// \internal
+    /// \brief A transition, reported after the evaluation.
+    class TriggerTransition
+    {
+      /// \brief Id of the region.
+      public: int region;
+
+      /// \brief Name of the entity.
+      public: std::string entity;
+
+      /// \brief True if the entity entered the region.
+      public: bool inside;
+    };
+
+    /// \internal
+    /// \brief Private data for the RegionTriggers class.
+    class RegionTriggersPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _world A reference to the world.
+      public: explicit RegionTriggersPrivate(World &_world)
+        : world(_world), tree(0.5)
+      {
+      }
+
+      /// \brief Rebuild the list of watched entities from the regions.
+      public: void Rebuild();
+
+      /// \brief Evaluate the regions.
+      /// \param[out] _transitions Transitions of the entities.
+      public: void Evaluate(std::vector<TriggerTransition> &_transitions);
+
+      /// \brief Reference to the world.
+      public: World &world;
+
+      /// \brief Regions, by id.
+      public: std::map<int, TriggerRegion> regions;
+
+      /// \brief Id of the next region.
+      public: int nextId = 0;
+
+      /// \brief Entities watched by the regions.
+      public: std::vector<TriggerEntity> entities;
+
+      /// \brief Tree of the origins of the entities.
+      public: AABBTree tree;
+
+      /// \brief True if the regions changed since the entities were
+      /// listed.
+      public: bool dirty = true;
+
+      /// \brief True if the missing entities must be looked up.
+      public: bool lookup = true;
+
+      /// \brief Evaluation rate, 0 for every step.
+      public: double updateRate = 0;
+
+      /// \brief Simulation time of the last evaluation, negative before
+      /// the first one.
+      public: double lastTime = -1;
+
+      /// \brief Protects the regions.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Get the axis aligned box that bounds an oriented box.
+/// \param[in] _box The oriented box.
+/// \return The bounding box.
+static ignition::math::AxisAlignedBox boundingBox(
+    const ignition::math::OrientedBoxd &_box)
+{
+  const ignition::math::Vector3d half = _box.Size() * 0.5;
+  ignition::math::Vector3d min(ignition::math::MAX_D, ignition::math::MAX_D,
+      ignition::math::MAX_D);
+  ignition::math::Vector3d max(-min);
+  for (int i = 0; i < 8; ++i)
+  {
+    const ignition::math::Vector3d corner = _box.Pose().CoordPositionAdd(
+        ignition::math::Vector3d((i & 1) ? half.X() : -half.X(),
+          (i & 2) ? half.Y() : -half.Y(), (i & 4) ? half.Z() : -half.Z()));
+    min.Min(corner);
+    max.Max(corner);
+  }
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+void RegionTriggersPrivate::Rebuild()
+{
+  // Keep the entities that were found, so they don't need a lookup
+  std::unordered_map<std::string, boost::weak_ptr<Entity>> found;
+  for (auto const &entity : this->entities)
+    found[entity.name] = entity.entity;
+  this->entities.clear();
+  this->tree.Clear();
+
+  std::unordered_map<std::string, unsigned int> indices;
+  for (auto &iter : this->regions)
+  {
+    TriggerRegion &region = iter.second;
+    region.slots.clear();
+    for (std::size_t i = 0; i < region.names.size(); ++i)
+    {
+      auto index = indices.insert(
+          std::make_pair(region.names[i], this->entities.size()));
+      if (index.second)
+      {
+        TriggerEntity entity;
+        entity.name = region.names[i];
+        entity.entity = found[entity.name];
+        this->entities.push_back(entity);
+      }
+      region.slots[index.first->second] = i;
+    }
+  }
+
+  this->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void RegionTriggersPrivate::Evaluate(
+    std::vector<TriggerTransition> &_transitions)
+{
+  if (this->dirty)
+    this->Rebuild();
+
+  // Move the origins of the entities in the tree
+  for (std::size_t i = 0; i < this->entities.size(); ++i)
+  {
+    TriggerEntity &tracked = this->entities[i];
+    EntityPtr entity = tracked.entity.lock();
+    if (!entity && this->lookup)
+    {
+      entity = this->world.EntityByName(tracked.name);
+      tracked.entity = entity;
+    }
+
+    if (!entity)
+    {
+      if (tracked.proxy >= 0)
+        this->tree.Remove(tracked.proxy);
+      tracked.proxy = -1;
+      continue;
+    }
+
+    tracked.pos = entity->WorldPose().Pos();
+    const ignition::math::AxisAlignedBox point(tracked.pos, tracked.pos);
+    if (tracked.proxy < 0)
+      tracked.proxy = this->tree.Insert(point, static_cast<unsigned int>(i));
+    else
+      this->tree.Update(tracked.proxy, point);
+  }
+
+  // Test the entities near each region
+  std::vector<char> inside;
+  for (auto &iter : this->regions)
+  {
+    TriggerRegion &region = iter.second;
+    inside.assign(region.names.size(), 0);
+
+    bool hasFrame = true;
+    ignition::math::OrientedBoxd box = region.box;
+    if (!region.frame.empty())
+    {
+      EntityPtr frame = region.frameEntity.lock();
+      if (!frame && this->lookup)
+      {
+        frame = this->world.EntityByName(region.frame);
+        region.frameEntity = frame;
+      }
+
+      if (frame)
+      {
+        box = ignition::math::OrientedBoxd(region.box.Size(),
+            region.box.Pose() + frame->WorldPose());
+      }
+      else
+        hasFrame = false;
+    }
+
+    if (hasFrame)
+    {
+      const ignition::math::AxisAlignedBox bounds = boundingBox(box);
+      this->tree.Query(
+          [&bounds](const ignition::math::AxisAlignedBox &_box)
+          {
+            return _box.Intersects(bounds);
+          },
+          [&](const unsigned int _index)
+          {
+            auto slot = region.slots.find(_index);
+            if (slot != region.slots.end() &&
+                box.Contains(this->entities[_index].pos))
+            {
+              inside[slot->second] = 1;
+            }
+          });
+    }
+
+    for (std::size_t i = 0; i < region.names.size(); ++i)
+    {
+      if (region.states[i] != inside[i])
+      {
+        region.states[i] = inside[i];
+        _transitions.push_back({iter.first, region.names[i], inside[i] != 0});
+      }
+    }
+  }
+
+  this->lookup = false;
+}
+
+/////////////////////////////////////////////////
+RegionTriggers::RegionTriggers(World &_world)
+  : dataPtr(new RegionTriggersPrivate(_world))
+{
+}
+
+/////////////////////////////////////////////////
+RegionTriggers::~RegionTriggers()
+{
+}
+
+/////////////////////////////////////////////////
+int RegionTriggers::Add(const ignition::math::OrientedBoxd &_box,
+    const std::vector<std::string> &_entities, const Callback &_callback,
+    const std::string &_frame)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  TriggerRegion &region = this->dataPtr->regions[this->dataPtr->nextId];
+  region.box = _box;
+  region.frame = _frame;
+  region.callback = _callback;
+
+  // Each entity is watched once
+  for (auto const &name : _entities)
+  {
+    if (std::find(region.names.begin(), region.names.end(), name) ==
+        region.names.end())
+    {
+      region.names.push_back(name);
+    }
+  }
+  region.states.assign(region.names.size(), -1);
+
+  this->dataPtr->dirty = true;
+  this->dataPtr->lookup = true;
+  return this->dataPtr->nextId++;
+}
+
+/////////////////////////////////////////////////
+void RegionTriggers::Remove(const int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->regions.erase(_id) > 0)
+    this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+std::size_t RegionTriggers::RegionCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->regions.size();
+}
+
+/////////////////////////////////////////////////
+void RegionTriggers::SetUpdateRate(const double _hz)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->updateRate = std::max(0.0, _hz);
+}
+
+/////////////////////////////////////////////////
+double RegionTriggers::UpdateRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->updateRate;
+}
+
+/////////////////////////////////////////////////
+void RegionTriggers::Refresh()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lookup = true;
+}
+
+/////////////////////////////////////////////////
+void RegionTriggers::Update(const common::Time &_simTime)
+{
+  IGN_PROFILE("RegionTriggers::Update");
+  std::vector<TriggerTransition> transitions;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->regions.empty())
+      return;
+
+    // Evaluate at the update rate, and again when time goes backward
+    const double simTime = _simTime.Double();
+    if (this->dataPtr->updateRate > 0 && this->dataPtr->lastTime >= 0 &&
+        simTime >= this->dataPtr->lastTime &&
+        simTime - this->dataPtr->lastTime < 1.0 / this->dataPtr->updateRate)
+    {
+      return;
+    }
+    this->dataPtr->lastTime = simTime;
+
+    this->dataPtr->Evaluate(transitions);
+  }
+
+  // Callbacks are called without the lock, so that they can remove their
+  // region
+  for (auto const &transition : transitions)
+  {
+    Callback callback;
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      auto iter = this->dataPtr->regions.find(transition.region);
+      if (iter == this->dataPtr->regions.end())
+        continue;
+      callback = iter->second.callback;
+    }
+
+    if (callback)
+      callback(transition.entity, transition.inside);
+  }
+}
+
+/////////////////////////////////////////////////
+void RegionTriggers::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->regions.clear();
+  this->dataPtr->entities.clear();
+  this->dataPtr->tree.Clear();
+  this->dataPtr->dirty = true;
+}
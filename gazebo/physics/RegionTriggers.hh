@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_REGIONTRIGGERS_HH_
+#define GAZEBO_PHYSICS_REGIONTRIGGERS_HH_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/OrientedBox.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class RegionTriggersPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class RegionTriggers RegionTriggers.hh physics/physics.hh
+    /// \brief Volumes of a world that report when entities enter or leave
+    /// them.
+    ///
+    /// A region is an oriented box, in the world frame or in the frame of
+    /// an entity, and the entities it watches. The origins of all the
+    /// watched entities are kept in a dynamic AABB tree, so each region
+    /// only tests the entities near it. All the regions are evaluated
+    /// together once per step, or at the update rate. A callback is called
+    /// with the first state of each entity, then only when the entity
+    /// enters or leaves the region. Missing entities are outside.
+    class GZ_PHYSICS_VISIBLE RegionTriggers
+    {
+      /// \brief Called when an entity enters or leaves a region.
+      /// \param[in] _entity Name of the entity, as given to Add.
+      /// \param[in] _inside True if the entity is in the region.
+      public: typedef std::function<void (const std::string &_entity,
+                  const bool _inside)> Callback;
+
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit RegionTriggers(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~RegionTriggers();
+
+      /// \brief Add a region.
+      /// \param[in] _box Box of the region.
+      /// \param[in] _entities Scoped names of the entities to watch.
+      /// \param[in] _callback Called with the transitions of the entities.
+      /// It is called from the world update, and may remove the region.
+      /// \param[in] _frame Scoped name of the entity whose frame the pose
+      /// of the box is in, empty for the world frame. The entities are
+      /// outside while it is missing.
+      /// \return Id of the region.
+      public: int Add(const ignition::math::OrientedBoxd &_box,
+                  const std::vector<std::string> &_entities,
+                  const Callback &_callback, const std::string &_frame = "");
+
+      /// \brief Remove a region. Its callback won't be called anymore.
+      /// \param[in] _id Id of the region.
+      public: void Remove(const int _id);
+
+      /// \brief Get the number of regions.
+      /// \return Number of regions.
+      public: std::size_t RegionCount() const;
+
+      /// \brief Set the rate at which the regions are evaluated.
+      /// \param[in] _hz Rate in simulation time, 0 to evaluate them at
+      /// every step.
+      public: void SetUpdateRate(const double _hz);
+
+      /// \brief Get the rate at which the regions are evaluated.
+      /// \return Rate in simulation time, 0 for every step.
+      public: double UpdateRate() const;
+
+      /// \brief Look up the missing entities at the next evaluation. This
+      /// is called by the world when models are inserted or removed.
+      public: void Refresh();
+
+      /// \brief Evaluate the regions, if the update rate allows it. This is
+      /// called by the world at every step.
+      /// \param[in] _simTime Simulation time.
+      public: void Update(const common::Time &_simTime);
+
+      /// \brief Remove all the regions.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RegionTriggersPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
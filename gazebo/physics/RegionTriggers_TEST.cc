@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class RegionTriggersTest : public ServerFixture {};
+
+/// \brief Transitions received by a callback.
+typedef std::vector<std::pair<std::string, bool>> Transitions;
+
+/////////////////////////////////////////////////
+TEST_F(RegionTriggersTest, Transitions)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box1", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnBox("box2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(10, 0, 0.5), ignition::math::Vector3d::Zero);
+
+  physics::RegionTriggers &triggers = world->RegionTriggers();
+  Transitions transitions;
+  const int id = triggers.Add(ignition::math::OrientedBoxd(
+      ignition::math::Vector3d(2, 2, 2),
+      ignition::math::Pose3d(10, 0, 1, 0, 0, IGN_PI / 4)),
+      {"box1", "box2", "missing"},
+      [&transitions](const std::string &_entity, const bool _inside)
+      {
+        transitions.push_back(std::make_pair(_entity, _inside));
+      });
+  EXPECT_EQ(triggers.RegionCount(), 1u);
+
+  // The first evaluation reports every state
+  world->Step(1);
+  ASSERT_EQ(transitions.size(), 3u);
+  EXPECT_EQ(transitions[0], std::make_pair(std::string("box1"), false));
+  EXPECT_EQ(transitions[1], std::make_pair(std::string("box2"), true));
+  EXPECT_EQ(transitions[2], std::make_pair(std::string("missing"), false));
+
+  // Then only the transitions
+  transitions.clear();
+  world->Step(10);
+  EXPECT_TRUE(transitions.empty());
+
+  world->ModelByName("box1")->SetWorldPose(
+      ignition::math::Pose3d(10.5, 0.5, 0.5, 0, 0, 0));
+  world->ModelByName("box2")->SetWorldPose(
+      ignition::math::Pose3d(0, 5, 0.5, 0, 0, 0));
+  world->Step(1);
+  ASSERT_EQ(transitions.size(), 2u);
+  EXPECT_EQ(transitions[0], std::make_pair(std::string("box1"), true));
+  EXPECT_EQ(transitions[1], std::make_pair(std::string("box2"), false));
+
+  // Entities inserted later are found
+  transitions.clear();
+  this->SpawnBox("missing", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(9.5, 0, 0.5), ignition::math::Vector3d::Zero);
+  world->Step(1);
+  ASSERT_EQ(transitions.size(), 1u);
+  EXPECT_EQ(transitions[0], std::make_pair(std::string("missing"), true));
+
+  // Removed entities leave
+  transitions.clear();
+  world->RemoveModel("missing");
+  world->Step(1);
+  ASSERT_EQ(transitions.size(), 1u);
+  EXPECT_EQ(transitions[0], std::make_pair(std::string("missing"), false));
+
+  triggers.Remove(id);
+  EXPECT_EQ(triggers.RegionCount(), 0u);
+  transitions.clear();
+  world->ModelByName("box1")->SetWorldPose(
+      ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_TRUE(transitions.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(RegionTriggersTest, FrameAndRate)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("carrier", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnBox("cargo", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+
+  // Many regions, most of them far from the entities
+  physics::RegionTriggers &triggers = world->RegionTriggers();
+  int far = 0;
+  for (int i = 0; i < 200; ++i)
+  {
+    triggers.Add(ignition::math::OrientedBoxd(
+        ignition::math::Vector3d::One,
+        ignition::math::Pose3d(100 + i * 2, 100, 0, 0, 0, 0)),
+        {"carrier", "cargo"},
+        [&far](const std::string &, const bool _inside)
+        {
+          if (_inside)
+            ++far;
+        });
+  }
+
+  // A region that follows the carrier, 5 m ahead of it
+  int inside = -1;
+  triggers.Add(ignition::math::OrientedBoxd(
+      ignition::math::Vector3d(2, 2, 2),
+      ignition::math::Pose3d(5, 0, 0, 0, 0, 0)), {"cargo"},
+      [&inside](const std::string &, const bool _inside)
+      {
+        inside = _inside;
+      }, "carrier");
+
+  triggers.SetUpdateRate(10);
+  EXPECT_DOUBLE_EQ(triggers.UpdateRate(), 10);
+
+  world->Step(1);
+  EXPECT_EQ(inside, 1);
+
+  // Moving the carrier moves the region. At 10 Hz, the next evaluation is
+  // 0.1 s of simulation time later.
+  world->ModelByName("carrier")->SetWorldPose(
+      ignition::math::Pose3d(0, 0, 0.5, 0, 0, IGN_PI / 2));
+  world->Step(1);
+  EXPECT_EQ(inside, 1);
+
+  const double step = world->Physics()->GetMaxStepSize();
+  world->Step(static_cast<int>(0.1 / step) + 1);
+  EXPECT_EQ(inside, 0);
+  EXPECT_EQ(far, 0);
+
+  triggers.Clear();
+  EXPECT_EQ(triggers.RegionCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
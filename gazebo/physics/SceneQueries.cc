@@ -0,0 +1,982 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+
+#include <boost/thread/recursive_mutex.hpp>
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/common/TriangleBVH.hh"
+#include "gazebo/physics/AABBTree.hh"
+#include "gazebo/physics/BoxShape.hh"
+#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/CylinderShape.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/PlaneShape.hh"
+#include "gazebo/physics/RayShape.hh"
+#include "gazebo/physics/SceneQueries.hh"
+#include "gazebo/physics/SphereShape.hh"
+#include "gazebo/physics/World.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Kinds of shapes of a snapshot.
+    enum SceneShapeKind
+    {
+      /// \brief Box, size in SceneShape::size.
+      SCENE_BOX,
+
+      /// \brief Sphere, radius in SceneShape::size.X().
+      SCENE_SPHERE,
+
+      /// \brief Cylinder along Z, radius in SceneShape::size.X() and
+      /// length in SceneShape::size.Z().
+      SCENE_CYLINDER,
+
+      /// \brief Half space below a plane through the origin of the
+      /// collision, normal in SceneShape::size.
+      SCENE_PLANE,
+
+      /// \brief Triangle mesh, in SceneShape::bvh.
+      SCENE_MESH,
+
+      /// \brief Any other shape, tested against SceneShape::box.
+      SCENE_BOUNDS
+    };
+
+    /// \internal
+    /// \brief A collision in a snapshot.
+    class SceneShape
+    {
+      /// \brief The collision.
+      public: boost::weak_ptr<Collision> collision;
+
+      /// \brief Scoped name of the collision.
+      public: std::string name;
+
+      /// \brief Kind of shape.
+      public: SceneShapeKind kind = SCENE_BOUNDS;
+
+      /// \brief Pose of the collision in the world frame.
+      public: ignition::math::Pose3d pose;
+
+      /// \brief Dimensions of the shape, see SceneShapeKind.
+      public: ignition::math::Vector3d size;
+
+      /// \brief Bounding box in the world frame.
+      public: ignition::math::AxisAlignedBox box;
+
+      /// \brief Triangles of a mesh, in the frame of the collision.
+      public: std::shared_ptr<const common::TriangleBVH> bvh;
+    };
+
+    /// \internal
+    /// \brief Poses and shapes of the collisions of a world, read only
+    /// once built.
+    class SceneSnapshot
+    {
+      /// \brief Constructor.
+      public: SceneSnapshot() : tree(0.0)
+      {
+      }
+
+      /// \brief Collisions.
+      public: std::vector<SceneShape> shapes;
+
+      /// \brief Tree of the bounding boxes of the shapes.
+      public: AABBTree tree;
+
+      /// \brief Shapes without a finite bounding box, such as planes.
+      public: std::vector<unsigned int> unbounded;
+    };
+
+    /// \internal
+    /// \brief Triangles of a mesh shape, kept between snapshots.
+    class SceneMesh
+    {
+      /// \brief The shape.
+      public: boost::weak_ptr<Shape> shape;
+
+      /// \brief Scale of the shape when the triangles were read.
+      public: ignition::math::Vector3d scale;
+
+      /// \brief Hierarchy of the triangles.
+      public: std::shared_ptr<common::TriangleBVH> bvh;
+
+      /// \brief Bounding box of the triangles, in the frame of the
+      /// collision.
+      public: ignition::math::AxisAlignedBox box;
+    };
+
+    /// \internal
+    /// \brief Private data for the SceneQueries class.
+    class SceneQueriesPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _world A reference to the world.
+      public: explicit SceneQueriesPrivate(World &_world)
+        : world(_world)
+      {
+      }
+
+      /// \brief Get the current snapshot, taking a new one if the world
+      /// changed.
+      /// \return The snapshot.
+      public: std::shared_ptr<const SceneSnapshot> Snapshot();
+
+      /// \brief Take a snapshot of the world.
+      /// \return The snapshot.
+      public: std::shared_ptr<SceneSnapshot> Build();
+
+      /// \brief Add a collision to a snapshot.
+      /// \param[in] _collision The collision.
+      /// \param[in,out] _snapshot The snapshot.
+      public: void Add(const CollisionPtr &_collision,
+                  SceneSnapshot &_snapshot);
+
+      /// \brief Reference to the world.
+      public: World &world;
+
+      /// \brief The current snapshot, null before the first query.
+      public: std::shared_ptr<const SceneSnapshot> snapshot;
+
+      /// \brief Protects snapshot.
+      public: std::mutex mutex;
+
+      /// \brief Held by the thread that takes a snapshot.
+      public: std::mutex buildMutex;
+
+      /// \brief True if the world changed since the snapshot.
+      public: std::atomic<bool> stale{true};
+
+      /// \brief Number of snapshots taken.
+      public: std::atomic<uint64_t> snapshotCount{0};
+
+      /// \brief Triangles of the mesh shapes, by shape.
+      public: std::map<const Shape *, SceneMesh> meshes;
+
+      /// \brief Protects meshes.
+      public: std::mutex meshMutex;
+
+      /// \brief Ray of the physics engine, for the shapes that the
+      /// snapshot only knows by their bounding box. It is used under the
+      /// physics update mutex.
+      public: RayShapePtr testRay;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+/// \brief Get the axis aligned box that bounds a box of a given pose.
+/// \param[in] _pose Pose of the center of the box.
+/// \param[in] _min Minimum corner of the box in its frame.
+/// \param[in] _max Maximum corner of the box in its frame.
+/// \return The bounding box in the frame of the pose.
+static ignition::math::AxisAlignedBox boundingBox(
+    const ignition::math::Pose3d &_pose, const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max)
+{
+  ignition::math::Vector3d min(ignition::math::MAX_D, ignition::math::MAX_D,
+      ignition::math::MAX_D);
+  ignition::math::Vector3d max(-min);
+  for (int i = 0; i < 8; ++i)
+  {
+    const ignition::math::Vector3d corner = _pose.CoordPositionAdd(
+        ignition::math::Vector3d((i & 1) ? _max.X() : _min.X(),
+          (i & 2) ? _max.Y() : _min.Y(), (i & 4) ? _max.Z() : _min.Z()));
+    min.Min(corner);
+    max.Max(corner);
+  }
+  return ignition::math::AxisAlignedBox(min, max);
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersect a ray with the slabs of a box.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Direction of the ray, the segment is [0, 1].
+/// \param[in] _min Minimum corner of the box.
+/// \param[in] _max Maximum corner of the box.
+/// \param[in,out] _enter Entry parameter, with the axis of entry.
+/// \param[in,out] _exit Exit parameter.
+/// \param[out] _axis Axis of the slab of entry, -1 if the ray starts in
+/// all the slabs.
+/// \return False if the ray misses the box.
+static bool raySlabs(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, const ignition::math::Vector3d &_min,
+    const ignition::math::Vector3d &_max, double &_enter, double &_exit,
+    int &_axis)
+{
+  _axis = -1;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(_dir[i]) < 1e-12)
+    {
+      if (_origin[i] < _min[i] || _origin[i] > _max[i])
+        return false;
+      continue;
+    }
+
+    double t0 = (_min[i] - _origin[i]) / _dir[i];
+    double t1 = (_max[i] - _origin[i]) / _dir[i];
+    if (t0 > t1)
+      std::swap(t0, t1);
+    if (t0 > _enter)
+    {
+      _enter = t0;
+      _axis = i;
+    }
+    _exit = std::min(_exit, t1);
+    if (_enter > _exit)
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Tell whether a segment touches an axis aligned box.
+/// \param[in] _origin Start of the segment.
+/// \param[in] _dir End of the segment minus its start.
+/// \param[in] _tMax Fraction of the segment to test.
+/// \param[in] _box The box.
+/// \param[in] _margin Distance by which the box is enlarged.
+/// \return True if the segment touches the box.
+static bool segmentTouches(const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir, const double _tMax,
+    const ignition::math::AxisAlignedBox &_box, const double _margin)
+{
+  const ignition::math::Vector3d margin(_margin, _margin, _margin);
+  double enter = -std::numeric_limits<double>::max();
+  double exit = std::numeric_limits<double>::max();
+  int axis;
+  return raySlabs(_origin, _dir, _box.Min() - margin, _box.Max() + margin,
+      enter, exit, axis) && exit >= 0 && enter <= _tMax;
+}
+
+/////////////////////////////////////////////////
+/// \brief Intersect a segment with a shape inflated by a radius. Boxes and
+/// cylinders grow along their axes, which is conservative near the edges.
+/// \param[in] _shape The shape.
+/// \param[in] _start Start of the segment in the world frame.
+/// \param[in] _dir End of the segment minus its start.
+/// \param[in] _radius Radius by which the shape grows, 0 for rays.
+/// \param[out] _t Fraction of the segment at the hit, 0 if the segment
+/// starts in the shape.
+/// \param[out] _normal Normal of the hit in the world frame, zero if it is
+/// unknown.
+/// \return True if the segment hits the shape.
+static bool intersect(const SceneShape &_shape,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_dir, const double _radius, double &_t,
+    ignition::math::Vector3d &_normal)
+{
+  const ignition::math::Quaterniond &rot = _shape.pose.Rot();
+  const ignition::math::Vector3d origin =
+      rot.RotateVectorReverse(_start - _shape.pose.Pos());
+  const ignition::math::Vector3d dir = rot.RotateVectorReverse(_dir);
+  const double lowest = -std::numeric_limits<double>::max();
+  const double highest = std::numeric_limits<double>::max();
+  const ignition::math::Vector3d inflate(_radius, _radius, _radius);
+
+  ignition::math::Vector3d normal;
+  double enter = lowest;
+  double exit = highest;
+  int axis = -1;
+  switch (_shape.kind)
+  {
+    case SCENE_BOX:
+    {
+      const ignition::math::Vector3d half = _shape.size * 0.5 + inflate;
+      if (!raySlabs(origin, dir, -half, half, enter, exit, axis))
+        return false;
+      if (axis >= 0)
+        normal[axis] = dir[axis] > 0 ? -1 : 1;
+      break;
+    }
+    case SCENE_SPHERE:
+    {
+      const double r = _shape.size.X() + _radius;
+      const double a = dir.SquaredLength();
+      const double b = 2 * origin.Dot(dir);
+      const double c = origin.SquaredLength() - r * r;
+      const double disc = b * b - 4 * a * c;
+      if (a < 1e-24 || disc < 0)
+      {
+        if (c > 0)
+          return false;
+        enter = 0;
+        exit = highest;
+        break;
+      }
+      enter = (-b - std::sqrt(disc)) / (2 * a);
+      exit = (-b + std::sqrt(disc)) / (2 * a);
+      normal = origin + dir * enter;
+      break;
+    }
+    case SCENE_CYLINDER:
+    {
+      const double r = _shape.size.X() + _radius;
+      const double h = _shape.size.Z() * 0.5 + _radius;
+
+      // The caps
+      if (!raySlabs(origin, dir, ignition::math::Vector3d(lowest, lowest, -h),
+            ignition::math::Vector3d(highest, highest, h), enter, exit, axis))
+      {
+        return false;
+      }
+
+      // The side
+      const double a = dir.X() * dir.X() + dir.Y() * dir.Y();
+      const double b = 2 * (origin.X() * dir.X() + origin.Y() * dir.Y());
+      const double c = origin.X() * origin.X() + origin.Y() * origin.Y() -
+          r * r;
+      if (a < 1e-24)
+      {
+        if (c > 0)
+          return false;
+      }
+      else
+      {
+        const double disc = b * b - 4 * a * c;
+        if (disc < 0)
+          return false;
+        const double t0 = (-b - std::sqrt(disc)) / (2 * a);
+        const double t1 = (-b + std::sqrt(disc)) / (2 * a);
+        if (t0 > enter)
+        {
+          enter = t0;
+          axis = -1;
+          const ignition::math::Vector3d p = origin + dir * t0;
+          normal.Set(p.X(), p.Y(), 0);
+        }
+        exit = std::min(exit, t1);
+        if (enter > exit)
+          return false;
+      }
+      if (axis == 2)
+        normal.Set(0, 0, dir.Z() > 0 ? -1 : 1);
+      break;
+    }
+    case SCENE_PLANE:
+    {
+      const ignition::math::Vector3d &n = _shape.size;
+      const double s0 = n.Dot(origin) - _radius;
+      const double s1 = n.Dot(origin + dir) - _radius;
+      if (s0 <= 0)
+      {
+        enter = 0;
+      }
+      else if (s1 >= 0)
+        return false;
+      else
+        enter = s0 / (s0 - s1);
+      exit = highest;
+      normal = n;
+      break;
+    }
+    case SCENE_MESH:
+    {
+      if (_radius <= 0)
+      {
+        unsigned int triangle;
+        if (!_shape.bvh->Intersect(origin, dir, false, enter, triangle))
+          return false;
+        normal = _shape.bvh->Triangle(triangle).Normal();
+        if (normal.Dot(dir) > 0)
+          normal = -normal;
+        exit = highest;
+        break;
+      }
+
+      // Meshes are swept as their bounding box
+      if (!raySlabs(_start, _dir, _shape.box.Min() - inflate,
+            _shape.box.Max() + inflate, enter, exit, axis))
+      {
+        return false;
+      }
+      _t = std::max(enter, 0.0);
+      _normal = ignition::math::Vector3d::Zero;
+      if (axis >= 0)
+        _normal[axis] = _dir[axis] > 0 ? -1 : 1;
+      return exit >= 0 && enter <= 1;
+    }
+    default:
+    {
+      if (!raySlabs(_start, _dir, _shape.box.Min() - inflate,
+            _shape.box.Max() + inflate, enter, exit, axis))
+      {
+        return false;
+      }
+      _t = std::max(enter, 0.0);
+      _normal = ignition::math::Vector3d::Zero;
+      if (axis >= 0)
+        _normal[axis] = _dir[axis] > 0 ? -1 : 1;
+      return exit >= 0 && enter <= 1;
+    }
+  }
+
+  if (exit < 0 || enter > 1)
+    return false;
+
+  if (enter <= 0)
+  {
+    // The segment starts in the shape
+    _t = 0;
+    _normal = -_dir;
+  }
+  else
+  {
+    _t = enter;
+    _normal = rot.RotateVector(normal);
+  }
+  if (_normal != ignition::math::Vector3d::Zero)
+    _normal.Normalize();
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the point of a shape closest to a point.
+/// \param[in] _shape The shape.
+/// \param[in] _point Point in the world frame.
+/// \param[out] _closest Closest point of the shape in the world frame,
+/// _point if it is in the shape.
+/// \return True if the shape was tested exactly, false if only its
+/// bounding box was.
+static bool closestPoint(const SceneShape &_shape,
+    const ignition::math::Vector3d &_point, ignition::math::Vector3d &_closest)
+{
+  const ignition::math::Vector3d p = _shape.pose.Rot().RotateVectorReverse(
+      _point - _shape.pose.Pos());
+  ignition::math::Vector3d local = p;
+  switch (_shape.kind)
+  {
+    case SCENE_BOX:
+    {
+      const ignition::math::Vector3d half = _shape.size * 0.5;
+      local.Min(half);
+      local.Max(-half);
+      break;
+    }
+    case SCENE_SPHERE:
+    {
+      if (p.Length() > _shape.size.X())
+        local = p.Normalized() * _shape.size.X();
+      break;
+    }
+    case SCENE_CYLINDER:
+    {
+      const double h = _shape.size.Z() * 0.5;
+      local.Z(ignition::math::clamp(p.Z(), -h, h));
+      const double radial = std::hypot(p.X(), p.Y());
+      if (radial > _shape.size.X())
+      {
+        local.X(p.X() * _shape.size.X() / radial);
+        local.Y(p.Y() * _shape.size.X() / radial);
+      }
+      break;
+    }
+    case SCENE_PLANE:
+    {
+      const double s = _shape.size.Dot(p);
+      if (s > 0)
+        local = p - _shape.size * s;
+      break;
+    }
+    default:
+    {
+      _closest = _point;
+      _closest.Min(_shape.box.Max());
+      _closest.Max(_shape.box.Min());
+      return false;
+    }
+  }
+  _closest = _shape.pose.CoordPositionAdd(local);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Fill a hit from a shape.
+/// \param[in] _shape The shape.
+/// \param[out] _hit The hit.
+static void fillHit(const SceneShape &_shape, SceneQueryHit &_hit)
+{
+  _hit.collision = _shape.collision.lock();
+  _hit.name = _shape.name;
+  _hit.approximate = _shape.kind == SCENE_BOUNDS;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the first shape hit by a segment in a snapshot.
+/// \param[in] _snapshot The snapshot.
+/// \param[in] _start Start of the segment.
+/// \param[in] _end End of the segment.
+/// \param[in] _radius Radius by which the shapes grow, 0 for rays.
+/// \param[in] _filter Shapes to test, null for all of them.
+/// \param[out] _t Fraction of the segment at the hit.
+/// \param[out] _normal Normal of the hit.
+/// \return Index of the shape, -1 if none was hit.
+static int firstHit(const SceneSnapshot &_snapshot,
+    const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, const double _radius,
+    const SceneQueries::Filter &_filter, double &_t,
+    ignition::math::Vector3d &_normal)
+{
+  const ignition::math::Vector3d dir = _end - _start;
+  int best = -1;
+  _t = 1;
+
+  auto test = [&](const unsigned int _index)
+  {
+    const SceneShape &shape = _snapshot.shapes[_index];
+    if (_filter && !_filter(shape.name))
+      return;
+
+    double t;
+    ignition::math::Vector3d normal;
+    if (intersect(shape, _start, dir, _radius, t, normal) &&
+        (best < 0 || t < _t))
+    {
+      best = static_cast<int>(_index);
+      _t = t;
+      _normal = normal;
+    }
+  };
+
+  for (auto const index : _snapshot.unbounded)
+    test(index);
+
+  // The segment is clipped at the closest hit so far
+  _snapshot.tree.Query(
+      [&](const ignition::math::AxisAlignedBox &_box)
+      {
+        return segmentTouches(_start, dir, _t, _box, _radius);
+      }, test);
+
+  return best;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const SceneSnapshot> SceneQueriesPrivate::Snapshot()
+{
+  if (this->stale.load())
+  {
+    std::unique_lock<std::mutex> build(this->buildMutex, std::try_to_lock);
+    if (!build.owns_lock())
+    {
+      // Another thread takes a snapshot, use the previous one. The first
+      // snapshot isn't waited for, since the other thread may wait for
+      // the physics update mutex that this thread holds.
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->snapshot)
+          return this->snapshot;
+      }
+      return this->Build();
+    }
+
+    // Changes made while the snapshot is taken call for the next one
+    if (this->stale.exchange(false))
+    {
+      std::shared_ptr<const SceneSnapshot> snapshot = this->Build();
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->snapshot = snapshot;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->snapshot)
+    this->snapshot = std::make_shared<SceneSnapshot>();
+  return this->snapshot;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<SceneSnapshot> SceneQueriesPrivate::Build()
+{
+  IGN_PROFILE("SceneQueries::Build");
+  std::shared_ptr<SceneSnapshot> snapshot = std::make_shared<SceneSnapshot>();
+
+  PhysicsEnginePtr physics = this->world.Physics();
+  if (!physics)
+    return snapshot;
+
+  boost::recursive_mutex::scoped_lock lock(*physics->GetPhysicsUpdateMutex());
+
+  Model_V stack = this->world.Models();
+  while (!stack.empty())
+  {
+    ModelPtr model = stack.back();
+    stack.pop_back();
+
+    for (auto const &link : model->GetLinks())
+    {
+      for (auto const &collision : link->GetCollisions())
+        this->Add(collision, *snapshot);
+    }
+
+    const Model_V &nested = model->NestedModels();
+    stack.insert(stack.end(), nested.begin(), nested.end());
+  }
+
+  // Forget the meshes of the removed shapes
+  {
+    std::lock_guard<std::mutex> meshLock(this->meshMutex);
+    for (auto iter = this->meshes.begin(); iter != this->meshes.end();)
+    {
+      if (iter->second.shape.expired())
+        this->meshes.erase(iter++);
+      else
+        ++iter;
+    }
+  }
+
+  ++this->snapshotCount;
+  return snapshot;
+}
+
+/////////////////////////////////////////////////
+void SceneQueriesPrivate::Add(const CollisionPtr &_collision,
+    SceneSnapshot &_snapshot)
+{
+  ShapePtr shape = _collision->GetShape();
+  if (!shape || shape->HasType(Base::RAY_SHAPE) ||
+      shape->HasType(Base::MULTIRAY_SHAPE))
+  {
+    return;
+  }
+
+  SceneShape entry;
+  entry.collision = _collision;
+  entry.name = _collision->GetScopedName();
+  entry.pose = _collision->WorldPose();
+
+  ignition::math::Vector3d min, max;
+  bool bounded = true;
+  if (shape->HasType(Base::BOX_SHAPE))
+  {
+    entry.kind = SCENE_BOX;
+    entry.size = boost::static_pointer_cast<BoxShape>(shape)->Size();
+    max = entry.size * 0.5;
+    min = -max;
+  }
+  else if (shape->HasType(Base::SPHERE_SHAPE))
+  {
+    entry.kind = SCENE_SPHERE;
+    const double r =
+        boost::static_pointer_cast<SphereShape>(shape)->GetRadius();
+    entry.size.Set(r, r, r);
+    max = entry.size;
+    min = -max;
+  }
+  else if (shape->HasType(Base::CYLINDER_SHAPE))
+  {
+    entry.kind = SCENE_CYLINDER;
+    auto cylinder = boost::static_pointer_cast<CylinderShape>(shape);
+    entry.size.Set(cylinder->GetRadius(), cylinder->GetRadius(),
+        cylinder->GetLength());
+    max.Set(entry.size.X(), entry.size.X(), entry.size.Z() * 0.5);
+    min = -max;
+  }
+  else if (shape->HasType(Base::PLANE_SHAPE))
+  {
+    entry.kind = SCENE_PLANE;
+    entry.size = boost::static_pointer_cast<PlaneShape>(shape)->Normal();
+    if (entry.size == ignition::math::Vector3d::Zero)
+      return;
+    entry.size.Normalize();
+    bounded = false;
+  }
+  else if (shape->HasType(Base::MESH_SHAPE))
+  {
+    // The triangles are read once per shape and scale
+    auto mesh = boost::static_pointer_cast<MeshShape>(shape);
+    std::lock_guard<std::mutex> meshLock(this->meshMutex);
+    SceneMesh &cached = this->meshes[shape.get()];
+    if (cached.shape.lock() != shape || !cached.bvh ||
+        cached.scale != mesh->Size())
+    {
+      std::vector<ignition::math::Vector3d> vertices;
+      std::vector<unsigned int> indices;
+      mesh->Triangles(vertices, indices);
+
+      cached.shape = shape;
+      cached.scale = mesh->Size();
+      cached.bvh = std::make_shared<common::TriangleBVH>();
+      cached.bvh->Build(vertices, indices);
+
+      ignition::math::Vector3d low(ignition::math::MAX_D,
+          ignition::math::MAX_D, ignition::math::MAX_D);
+      ignition::math::Vector3d high(-low);
+      for (auto const &v : vertices)
+      {
+        low.Min(v);
+        high.Max(v);
+      }
+      cached.box = ignition::math::AxisAlignedBox(low, high);
+    }
+
+    if (cached.bvh->TriangleCount() == 0)
+      return;
+    entry.kind = SCENE_MESH;
+    entry.bvh = cached.bvh;
+    min = cached.box.Min();
+    max = cached.box.Max();
+  }
+  else
+  {
+    entry.kind = SCENE_BOUNDS;
+    entry.box = _collision->BoundingBox();
+    min = entry.box.Min();
+    max = entry.box.Max();
+    bounded = std::isfinite(min.X()) && std::isfinite(min.Y()) &&
+        std::isfinite(min.Z()) && std::isfinite(max.X()) &&
+        std::isfinite(max.Y()) && std::isfinite(max.Z()) &&
+        min.X() <= max.X() && min.Y() <= max.Y() && min.Z() <= max.Z();
+    if (!bounded)
+      return;
+  }
+
+  if (entry.kind != SCENE_BOUNDS && bounded)
+    entry.box = boundingBox(entry.pose, min, max);
+
+  const unsigned int index = _snapshot.shapes.size();
+  _snapshot.shapes.push_back(entry);
+  if (bounded)
+    _snapshot.tree.Insert(entry.box, index);
+  else
+    _snapshot.unbounded.push_back(index);
+}
+
+/////////////////////////////////////////////////
+SceneQueries::SceneQueries(World &_world)
+  : dataPtr(new SceneQueriesPrivate(_world))
+{
+}
+
+/////////////////////////////////////////////////
+SceneQueries::~SceneQueries()
+{
+}
+
+/////////////////////////////////////////////////
+bool SceneQueries::Ray(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, SceneQueryHit &_hit,
+    const Filter &_filter)
+{
+  IGN_PROFILE("SceneQueries::Ray");
+  std::shared_ptr<const SceneSnapshot> snapshot = this->dataPtr->Snapshot();
+
+  double t;
+  ignition::math::Vector3d normal;
+  const int index = firstHit(*snapshot, _start, _end, 0, _filter, t, normal);
+  if (index < 0)
+    return false;
+
+  const SceneShape &shape = snapshot->shapes[index];
+  if (shape.kind != SCENE_BOUNDS || _filter)
+  {
+    fillHit(shape, _hit);
+    _hit.distance = t * _start.Distance(_end);
+    _hit.point = _start + (_end - _start) * t;
+    _hit.normal = normal;
+    return true;
+  }
+
+  // The closest hit is only a bounding box, ask the physics engine
+  PhysicsEnginePtr physics = this->dataPtr->world.Physics();
+  if (!physics)
+    return false;
+
+  boost::recursive_mutex::scoped_lock lock(*physics->GetPhysicsUpdateMutex());
+  physics->InitForThread();
+  if (!this->dataPtr->testRay)
+  {
+    this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
+        physics->CreateShape("ray", CollisionPtr()));
+  }
+  if (!this->dataPtr->testRay)
+    return false;
+
+  double dist;
+  std::string name;
+  this->dataPtr->testRay->SetPoints(_start, _end);
+  this->dataPtr->testRay->GetIntersection(dist, name);
+  if (name.empty())
+    return false;
+
+  _hit.collision = boost::dynamic_pointer_cast<Collision>(
+      this->dataPtr->world.EntityByName(name));
+  _hit.name = name;
+  _hit.distance = dist;
+  _hit.point = _start + (_end - _start).Normalized() * dist;
+  _hit.normal = ignition::math::Vector3d::Zero;
+  _hit.approximate = false;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool SceneQueries::SweepSphere(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end, const double _radius,
+    SceneQueryHit &_hit, const Filter &_filter)
+{
+  IGN_PROFILE("SceneQueries::SweepSphere");
+  std::shared_ptr<const SceneSnapshot> snapshot = this->dataPtr->Snapshot();
+
+  double t;
+  ignition::math::Vector3d normal;
+  const int index = firstHit(*snapshot, _start, _end, std::max(_radius, 0.0),
+      _filter, t, normal);
+  if (index < 0)
+    return false;
+
+  const SceneShape &shape = snapshot->shapes[index];
+  fillHit(shape, _hit);
+  _hit.approximate = _hit.approximate || shape.kind == SCENE_MESH;
+  _hit.distance = t * _start.Distance(_end);
+  _hit.normal = normal;
+  _hit.point = _start + (_end - _start) * t - normal * _radius;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SceneQueries::OverlapSphere(const ignition::math::Vector3d &_center,
+    const double _radius, std::vector<SceneQueryHit> &_hits,
+    const Filter &_filter)
+{
+  IGN_PROFILE("SceneQueries::OverlapSphere");
+  std::shared_ptr<const SceneSnapshot> snapshot = this->dataPtr->Snapshot();
+
+  auto test = [&](const unsigned int _index)
+  {
+    const SceneShape &shape = snapshot->shapes[_index];
+    if (_filter && !_filter(shape.name))
+      return;
+
+    ignition::math::Vector3d closest;
+    const bool exact = closestPoint(shape, _center, closest);
+    const double distance = closest.Distance(_center);
+    if (distance <= _radius)
+    {
+      SceneQueryHit hit;
+      fillHit(shape, hit);
+      hit.approximate = !exact;
+      hit.distance = distance;
+      hit.point = closest;
+      if (distance > 0)
+        hit.normal = (_center - closest) / distance;
+      _hits.push_back(hit);
+    }
+  };
+
+  for (auto const index : snapshot->unbounded)
+    test(index);
+
+  const ignition::math::Vector3d half(_radius, _radius, _radius);
+  const ignition::math::AxisAlignedBox bounds(_center - half, _center + half);
+  snapshot->tree.Query([&bounds](const ignition::math::AxisAlignedBox &_box)
+      {
+        return _box.Intersects(bounds);
+      }, test);
+}
+
+/////////////////////////////////////////////////
+void SceneQueries::OverlapBox(const ignition::math::AxisAlignedBox &_box,
+    std::vector<SceneQueryHit> &_hits, const Filter &_filter)
+{
+  IGN_PROFILE("SceneQueries::OverlapBox");
+  std::shared_ptr<const SceneSnapshot> snapshot = this->dataPtr->Snapshot();
+
+  auto test = [&](const unsigned int _index)
+  {
+    const SceneShape &shape = snapshot->shapes[_index];
+    if (_filter && !_filter(shape.name))
+      return;
+
+    if (shape.kind == SCENE_PLANE)
+    {
+      // The box overlaps the half space if its lowest corner does
+      ignition::math::Vector3d corner;
+      for (int i = 0; i < 3; ++i)
+      {
+        const ignition::math::Vector3d n =
+            shape.pose.Rot().RotateVector(shape.size);
+        corner[i] = n[i] > 0 ? _box.Min()[i] : _box.Max()[i];
+      }
+      const ignition::math::Vector3d local =
+          shape.pose.Rot().RotateVectorReverse(corner - shape.pose.Pos());
+      if (shape.size.Dot(local) > 0)
+        return;
+    }
+    else if (!shape.box.Intersects(_box))
+      return;
+
+    SceneQueryHit hit;
+    fillHit(shape, hit);
+    hit.approximate = true;
+    hit.point = shape.box.Center();
+    _hits.push_back(hit);
+  };
+
+  for (auto const index : snapshot->unbounded)
+    test(index);
+
+  snapshot->tree.Query([&_box](const ignition::math::AxisAlignedBox &_b)
+      {
+        return _b.Intersects(_box);
+      }, test);
+}
+
+/////////////////////////////////////////////////
+void SceneQueries::Refresh()
+{
+  this->dataPtr->stale.store(true);
+}
+
+/////////////////////////////////////////////////
+uint64_t SceneQueries::SnapshotCount() const
+{
+  return this->dataPtr->snapshotCount;
+}
+
+/////////////////////////////////////////////////
+void SceneQueries::Clear()
+{
+  std::lock_guard<std::mutex> build(this->dataPtr->buildMutex);
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->snapshot.reset();
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->meshMutex);
+    this->dataPtr->meshes.clear();
+  }
+  this->dataPtr->testRay.reset();
+  this->dataPtr->stale.store(true);
+}
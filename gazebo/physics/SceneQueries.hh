@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SCENEQUERIES_HH_
+#define GAZEBO_PHYSICS_SCENEQUERIES_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class SceneQueriesPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \brief A collision found by a scene query.
+    class GZ_PHYSICS_VISIBLE SceneQueryHit
+    {
+      /// \brief The collision, null if it was removed since the query.
+      public: CollisionPtr collision;
+
+      /// \brief Scoped name of the collision.
+      public: std::string name;
+
+      /// \brief Distance from the start of the ray or of the sweep.
+      public: double distance = 0;
+
+      /// \brief Point of the hit in the world frame. For sweeps, it is the
+      /// point of the sphere that touches the collision.
+      public: ignition::math::Vector3d point;
+
+      /// \brief Normal of the surface at the hit, zero when it is unknown.
+      public: ignition::math::Vector3d normal;
+
+      /// \brief True if the collision was tested against its bounding box
+      /// instead of its shape.
+      public: bool approximate = false;
+    };
+
+    /// \class SceneQueries SceneQueries.hh physics/physics.hh
+    /// \brief Rays, sphere sweeps and overlap tests against the collisions
+    /// of a world, that can run on any thread without locking against the
+    /// physics step.
+    ///
+    /// The queries run against a snapshot of the poses and shapes of the
+    /// collisions, kept in a bounding volume tree. The snapshot is taken by
+    /// the first query after the world stepped or an entity moved, under
+    /// the physics update mutex, and shared by the queries until the next
+    /// change. Threads that query while another thread takes a new
+    /// snapshot use the previous one.
+    ///
+    /// Boxes, spheres, cylinders, planes and meshes are tested exactly.
+    /// The other shapes, such as heightmaps, are tested against their
+    /// bounding box. A ray whose closest hit is such a shape is run again
+    /// by the physics engine.
+    class GZ_PHYSICS_VISIBLE SceneQueries
+    {
+      /// \brief Tells whether a collision takes part in a query.
+      /// \param[in] _collision Scoped name of the collision.
+      /// \return True to test the collision.
+      public: typedef std::function<bool (const std::string &_collision)>
+              Filter;
+
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit SceneQueries(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~SceneQueries();
+
+      /// \brief Find the closest collision hit by a ray.
+      /// \param[in] _start Start of the ray in the world frame.
+      /// \param[in] _end End of the ray in the world frame.
+      /// \param[out] _hit The closest hit.
+      /// \param[in] _filter Collisions to test, null for all of them.
+      /// \return True if a collision was hit.
+      public: bool Ray(const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end, SceneQueryHit &_hit,
+                  const Filter &_filter = nullptr);
+
+      /// \brief Find the first collision touched by a sphere moving along
+      /// a segment. Boxes and cylinders are swept conservatively: the hit
+      /// may come slightly early near their edges.
+      /// \param[in] _start Start of the center of the sphere.
+      /// \param[in] _end End of the center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      /// \param[out] _hit The first hit. The distance is traveled by the
+      /// center of the sphere.
+      /// \param[in] _filter Collisions to test, null for all of them.
+      /// \return True if a collision was touched.
+      public: bool SweepSphere(const ignition::math::Vector3d &_start,
+                  const ignition::math::Vector3d &_end, const double _radius,
+                  SceneQueryHit &_hit, const Filter &_filter = nullptr);
+
+      /// \brief Find the collisions that overlap a sphere.
+      /// \param[in] _center Center of the sphere in the world frame.
+      /// \param[in] _radius Radius of the sphere.
+      /// \param[out] _hits The overlapping collisions are appended, with
+      /// their closest point to the center.
+      /// \param[in] _filter Collisions to test, null for all of them.
+      public: void OverlapSphere(const ignition::math::Vector3d &_center,
+                  const double _radius, std::vector<SceneQueryHit> &_hits,
+                  const Filter &_filter = nullptr);
+
+      /// \brief Find the collisions whose bounding box overlaps a box.
+      /// \param[in] _box Box in the world frame.
+      /// \param[out] _hits The overlapping collisions are appended.
+      /// \param[in] _filter Collisions to test, null for all of them.
+      public: void OverlapBox(const ignition::math::AxisAlignedBox &_box,
+                  std::vector<SceneQueryHit> &_hits,
+                  const Filter &_filter = nullptr);
+
+      /// \brief Take a new snapshot at the next query. This is called by
+      /// the world when it steps, and when entities move, are inserted or
+      /// are removed.
+      public: void Refresh();
+
+      /// \brief Get the number of snapshots taken so far.
+      /// \return Number of snapshots.
+      public: uint64_t SnapshotCount() const;
+
+      /// \brief Drop the snapshot and the cached mesh hierarchies.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SceneQueriesPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SceneQueriesTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+TEST_F(SceneQueriesTest, Ray)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnSphere("sphere", ignition::math::Vector3d(10, 0, 0.5),
+      ignition::math::Vector3d::Zero);
+
+  physics::SceneQueries &queries = world->Physics()->SceneQueries();
+
+  // The closest face of the box
+  physics::SceneQueryHit hit;
+  ASSERT_TRUE(queries.Ray(ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Vector3d(20, 0, 0.5), hit));
+  EXPECT_EQ(hit.name, "box::body::geom");
+  EXPECT_TRUE(hit.collision != nullptr);
+  EXPECT_NEAR(hit.distance, 4.5, 1e-6);
+  EXPECT_EQ(hit.point, ignition::math::Vector3d(4.5, 0, 0.5));
+  EXPECT_EQ(hit.normal, -ignition::math::Vector3d::UnitX);
+  EXPECT_FALSE(hit.approximate);
+
+  // The filter skips the box
+  ASSERT_TRUE(queries.Ray(ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Vector3d(20, 0, 0.5), hit,
+      [](const std::string &_name)
+      {
+        return _name.find("box") != 0;
+      }));
+  EXPECT_EQ(hit.name, "sphere::body::geom");
+  EXPECT_NEAR(hit.distance, 9.5, 1e-6);
+
+  // The ground plane stops rays that go down
+  ASSERT_TRUE(queries.Ray(ignition::math::Vector3d(0, 5, 2),
+      ignition::math::Vector3d(0, 5, -2), hit));
+  EXPECT_NEAR(hit.distance, 2, 1e-6);
+  EXPECT_EQ(hit.normal, ignition::math::Vector3d::UnitZ);
+
+  // And nothing is hit above the ground
+  EXPECT_FALSE(queries.Ray(ignition::math::Vector3d(0, 5, 2),
+      ignition::math::Vector3d(20, 5, 2), hit));
+
+  // The world uses the queries to find entities
+  physics::EntityPtr below =
+      world->EntityBelowPoint(ignition::math::Vector3d(5, 0, 3));
+  ASSERT_TRUE(below != nullptr);
+  EXPECT_EQ(below->GetScopedName(), "box::body::geom");
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneQueriesTest, SweepAndOverlap)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnCylinder("cylinder", ignition::math::Vector3d(0, 5, 0.5),
+      ignition::math::Vector3d::Zero);
+
+  physics::SceneQueries &queries = world->SceneQueries();
+  auto noGround = [](const std::string &_name)
+  {
+    return _name.find("ground_plane") != 0;
+  };
+
+  // A sphere of radius 0.5 touches the box 1 m before a ray would
+  physics::SceneQueryHit hit;
+  ASSERT_TRUE(queries.SweepSphere(ignition::math::Vector3d(0, 0, 0.5),
+      ignition::math::Vector3d(10, 0, 0.5), 0.5, hit, noGround));
+  EXPECT_EQ(hit.name, "box::body::geom");
+  EXPECT_NEAR(hit.distance, 4, 1e-6);
+  EXPECT_EQ(hit.point, ignition::math::Vector3d(4.5, 0, 0.5));
+
+  // Overlaps of a sphere
+  std::vector<physics::SceneQueryHit> hits;
+  queries.OverlapSphere(ignition::math::Vector3d(2.5, 2.5, 0.5), 1.0, hits,
+      noGround);
+  EXPECT_TRUE(hits.empty());
+
+  queries.OverlapSphere(ignition::math::Vector3d(5, 1.2, 0.5), 1.0, hits,
+      noGround);
+  ASSERT_EQ(hits.size(), 1u);
+  EXPECT_EQ(hits[0].name, "box::body::geom");
+  EXPECT_NEAR(hits[0].distance, 0.7, 1e-6);
+
+  // Overlaps of a box, with the ground plane
+  hits.clear();
+  queries.OverlapBox(ignition::math::AxisAlignedBox(
+      ignition::math::Vector3d(-1, -1, 0), ignition::math::Vector3d(6, 6, 1)),
+      hits);
+  EXPECT_EQ(hits.size(), 3u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(SceneQueriesTest, Snapshot)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+
+  physics::SceneQueries &queries = world->SceneQueries();
+  physics::SceneQueryHit hit;
+  const ignition::math::Vector3d start(0, 0, 0.5);
+  const ignition::math::Vector3d end(20, 0, 0.5);
+
+  // Queries share a snapshot while nothing moves
+  EXPECT_TRUE(queries.Ray(start, end, hit));
+  const uint64_t count = queries.SnapshotCount();
+  EXPECT_TRUE(queries.Ray(start, end, hit));
+  EXPECT_EQ(queries.SnapshotCount(), count);
+
+  // Moving the box calls for a new snapshot
+  world->ModelByName("box")->SetWorldPose(
+      ignition::math::Pose3d(8, 0, 0.5, 0, 0, 0));
+  ASSERT_TRUE(queries.Ray(start, end, hit));
+  EXPECT_GT(queries.SnapshotCount(), count);
+  EXPECT_NEAR(hit.distance, 7.5, 1e-6);
+
+  // Removed models are gone
+  world->RemoveModel("box");
+  EXPECT_FALSE(queries.Ray(start, end, hit));
+
+  // Queries from many threads while the world steps
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+  std::atomic<int> misses(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([&]()
+        {
+          for (int j = 0; j < 200; ++j)
+          {
+            physics::SceneQueryHit threadHit;
+            if (!queries.Ray(start, end, threadHit) ||
+                threadHit.name != "box::body::geom")
+            {
+              ++misses;
+            }
+          }
+        }));
+  }
+  world->Step(50);
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(misses, 0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
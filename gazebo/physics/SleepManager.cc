@@ -0,0 +1,487 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "gazebo/physics/SleepManager.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Models that sleep and wake up together.
+    class SleepIsland
+    {
+      /// \brief Dynamic links of the island.
+      public: Link_V links;
+
+      /// \brief Sim time during which the links stayed under the
+      /// thresholds, in seconds.
+      public: double idleTime = 0;
+
+      /// \brief True if the links are disabled.
+      public: bool sleeping = false;
+
+      /// \brief False if a model doesn't allow auto disable, or carries
+      /// sensors.
+      public: bool allowed = true;
+
+      /// \brief True if the engine didn't disable the links.
+      public: bool unsupported = false;
+    };
+
+    /// \internal
+    /// \brief Private data for the SleepManager class.
+    class SleepManagerPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _world A reference to the world.
+      public: explicit SleepManagerPrivate(World &_world)
+        : world(_world)
+      {
+      }
+
+      /// \brief Rebuild the islands from the models of the world.
+      public: void Rebuild();
+
+      /// \brief Disable the links of an island.
+      /// \param[in] _island The island.
+      public: void Sleep(SleepIsland &_island);
+
+      /// \brief Enable the links of an island.
+      /// \param[in] _island The island.
+      public: void Wake(SleepIsland &_island);
+
+      /// \brief Get the island of a model.
+      /// \param[in] _model The model, or one of its nested models.
+      /// \return The island, null if the model has none.
+      public: SleepIsland *IslandOf(const Model *_model);
+
+      /// \brief Reference to the world.
+      public: World &world;
+
+      /// \brief The islands.
+      public: std::vector<SleepIsland> islands;
+
+      /// \brief Index in islands of each top level model.
+      public: std::unordered_map<const Model *, std::size_t> islandOf;
+
+      /// \brief Links of the last update over the velocity thresholds.
+      public: std::vector<Link *> moving;
+
+      /// \brief Models near a moving link.
+      public: Model_V near;
+
+      /// \brief Number of sleeping islands.
+      public: std::size_t sleepingIslands = 0;
+
+      /// \brief Number of links of the sleeping islands.
+      public: std::size_t sleepingLinks = 0;
+
+      /// \brief True if the islands must be rebuilt.
+      public: bool dirty = true;
+
+      /// \brief Protects the islands.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Distance around a moving link within which the sleeping models
+/// wake up, on top of the distance it travels during a step.
+static const double kSleepWakeMargin = 0.01;
+
+/////////////////////////////////////////////////
+/// \brief Get the top level model of an entity.
+/// \param[in] _base The entity.
+/// \return The outermost model that contains the entity, the entity itself
+/// if it is a top level model, null if it isn't in a model.
+static const Model *topModel(const Base *_base)
+{
+  const Model *top = nullptr;
+  for (const Base *base = _base; base; base = base->GetParent().get())
+  {
+    if (base->HasType(Base::MODEL))
+      top = static_cast<const Model *>(base);
+  }
+  return top;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the root of an element of a union-find.
+/// \param[in,out] _parents Parent of each element.
+/// \param[in] _i The element.
+/// \return The root.
+static std::size_t findRoot(std::vector<std::size_t> &_parents,
+    std::size_t _i)
+{
+  while (_parents[_i] != _i)
+  {
+    _parents[_i] = _parents[_parents[_i]];
+    _i = _parents[_i];
+  }
+  return _i;
+}
+
+/////////////////////////////////////////////////
+/// \brief Append the joints of a model and of its nested models.
+/// \param[in] _model The model.
+/// \param[out] _joints The joints are appended.
+static void appendJoints(const Model &_model, Joint_V &_joints)
+{
+  const Joint_V &joints = _model.GetJoints();
+  _joints.insert(_joints.end(), joints.begin(), joints.end());
+  for (auto const &nested : _model.NestedModels())
+    appendJoints(*nested, _joints);
+}
+
+/////////////////////////////////////////////////
+void SleepManagerPrivate::Rebuild()
+{
+  this->islands.clear();
+  this->islandOf.clear();
+  this->sleepingIslands = 0;
+  this->sleepingLinks = 0;
+  this->dirty = false;
+
+  const Model_V &models = this->world.ModelsRef();
+  std::vector<const Model *> tops;
+  for (auto const &model : models)
+  {
+    if (model->IsStatic() || model->HasType(Base::ACTOR))
+      continue;
+    this->islandOf[model.get()] = tops.size();
+    tops.push_back(model.get());
+  }
+
+  // Join the models connected by a joint.
+  std::vector<std::size_t> parents(tops.size());
+  for (std::size_t i = 0; i < parents.size(); ++i)
+    parents[i] = i;
+
+  Joint_V joints;
+  for (auto const *model : tops)
+  {
+    joints.clear();
+    appendJoints(*model, joints);
+    for (auto const &joint : joints)
+    {
+      LinkPtr parent = joint->GetParent();
+      LinkPtr child = joint->GetChild();
+      if (!parent || !child)
+        continue;
+
+      auto parentIter = this->islandOf.find(topModel(parent.get()));
+      auto childIter = this->islandOf.find(topModel(child.get()));
+      if (parentIter == this->islandOf.end() ||
+          childIter == this->islandOf.end())
+      {
+        continue;
+      }
+
+      parents[findRoot(parents, parentIter->second)] =
+          findRoot(parents, childIter->second);
+    }
+  }
+
+  std::vector<std::size_t> islandOfRoot(tops.size(), tops.size());
+  for (std::size_t i = 0; i < tops.size(); ++i)
+  {
+    const std::size_t root = findRoot(parents, i);
+    if (islandOfRoot[root] == tops.size())
+    {
+      islandOfRoot[root] = this->islands.size();
+      this->islands.push_back(SleepIsland());
+    }
+    SleepIsland &island = this->islands[islandOfRoot[root]];
+    this->islandOf[tops[i]] = islandOfRoot[root];
+
+    if (!tops[i]->GetAutoDisable())
+      island.allowed = false;
+
+    for (auto const &link : tops[i]->AllLinks())
+    {
+      if (link->IsStatic() || link->GetKinematic())
+        continue;
+      if (link->GetSensorCount() > 0)
+        island.allowed = false;
+      island.links.push_back(link);
+    }
+  }
+
+  // Keep the islands that sleep, such as those disabled by the engine.
+  for (auto &island : this->islands)
+  {
+    if (island.links.empty())
+      continue;
+
+    island.sleeping = true;
+    for (auto const &link : island.links)
+    {
+      if (link->GetEnabled())
+      {
+        island.sleeping = false;
+        break;
+      }
+    }
+
+    if (island.sleeping)
+    {
+      ++this->sleepingIslands;
+      this->sleepingLinks += island.links.size();
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void SleepManagerPrivate::Sleep(SleepIsland &_island)
+{
+  // The engines enable the links whose velocity is set, so disable last.
+  for (auto const &link : _island.links)
+  {
+    link->SetLinearVel(ignition::math::Vector3d::Zero);
+    link->SetAngularVel(ignition::math::Vector3d::Zero);
+    link->SetEnabled(false);
+  }
+
+  for (auto const &link : _island.links)
+  {
+    if (link->GetEnabled())
+    {
+      for (auto const &l : _island.links)
+        l->SetEnabled(true);
+      _island.unsupported = true;
+      gzlog << "Physics engine [" << this->world.Physics()->GetType()
+            << "] can't disable link [" << link->GetScopedName()
+            << "], its model won't sleep" << std::endl;
+      return;
+    }
+  }
+
+  _island.sleeping = true;
+  ++this->sleepingIslands;
+  this->sleepingLinks += _island.links.size();
+}
+
+/////////////////////////////////////////////////
+void SleepManagerPrivate::Wake(SleepIsland &_island)
+{
+  if (!_island.sleeping)
+    return;
+
+  for (auto const &link : _island.links)
+    link->SetEnabled(true);
+
+  _island.sleeping = false;
+  _island.idleTime = 0;
+  --this->sleepingIslands;
+  this->sleepingLinks -= _island.links.size();
+}
+
+/////////////////////////////////////////////////
+SleepIsland *SleepManagerPrivate::IslandOf(const Model *_model)
+{
+  auto iter = this->islandOf.find(topModel(_model));
+  if (iter == this->islandOf.end())
+    return nullptr;
+  return &this->islands[iter->second];
+}
+
+/////////////////////////////////////////////////
+SleepManager::SleepManager(World &_world)
+  : dataPtr(new SleepManagerPrivate(_world))
+{
+}
+
+/////////////////////////////////////////////////
+SleepManager::~SleepManager()
+{
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Refresh()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Update()
+{
+  IGN_PROFILE("SleepManager::Update");
+  PhysicsEnginePtr physics = this->dataPtr->world.Physics();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!physics->SleepEnabled())
+  {
+    // Wake the islands once the sleeping is turned off
+    if (!this->dataPtr->islands.empty())
+    {
+      for (auto &island : this->dataPtr->islands)
+        this->dataPtr->Wake(island);
+      this->dataPtr->islands.clear();
+      this->dataPtr->islandOf.clear();
+      this->dataPtr->dirty = true;
+    }
+    return;
+  }
+
+  if (this->dataPtr->dirty)
+    this->dataPtr->Rebuild();
+
+  const double dt = physics->GetMaxStepSize();
+  const double linear = physics->SleepLinearVelocity();
+  const double angular = physics->SleepAngularVelocity();
+  const double sleepTime = physics->SleepTime();
+
+  std::vector<Link *> &moving = this->dataPtr->moving;
+  moving.clear();
+  for (auto &island : this->dataPtr->islands)
+  {
+    if (island.links.empty())
+      continue;
+
+    // The engines enable the links that are hit by an awake body, and
+    // those whose force, velocity or pose is set.
+    if (island.sleeping)
+    {
+      for (auto const &link : island.links)
+      {
+        if (link->GetEnabled())
+        {
+          this->dataPtr->Wake(island);
+          break;
+        }
+      }
+      continue;
+    }
+
+    bool enabled = false;
+    bool still = true;
+    for (auto const &link : island.links)
+    {
+      if (link->GetEnabled())
+        enabled = true;
+      if (link->WorldCoGLinearVel().SquaredLength() > linear * linear ||
+          link->WorldAngularVel().SquaredLength() > angular * angular)
+      {
+        still = false;
+        moving.push_back(link.get());
+      }
+    }
+
+    // The engine disabled all the links itself
+    if (!enabled)
+    {
+      island.sleeping = true;
+      ++this->dataPtr->sleepingIslands;
+      this->dataPtr->sleepingLinks += island.links.size();
+      continue;
+    }
+
+    if (!still || !island.allowed || island.unsupported)
+    {
+      island.idleTime = 0;
+      continue;
+    }
+
+    island.idleTime += dt;
+    if (island.idleTime >= sleepTime)
+      this->dataPtr->Sleep(island);
+  }
+
+  if (this->dataPtr->sleepingIslands == 0)
+    return;
+
+  // Wake the sleeping models near the moving links, which the engines
+  // don't always collide with.
+  Model_V &near = this->dataPtr->near;
+  for (auto const *link : moving)
+  {
+    const double margin = kSleepWakeMargin +
+        link->WorldCoGLinearVel().Length() * dt;
+    const ignition::math::AxisAlignedBox linkBox = link->BoundingBox();
+    const ignition::math::AxisAlignedBox box(
+        linkBox.Min() - ignition::math::Vector3d(margin, margin, margin),
+        linkBox.Max() + ignition::math::Vector3d(margin, margin, margin));
+
+    near.clear();
+    this->dataPtr->world.ModelsInVolume(
+        [&box](const ignition::math::AxisAlignedBox &_box)
+        {
+          return _box.Intersects(box);
+        }, near);
+
+    for (auto const &model : near)
+    {
+      SleepIsland *island = this->dataPtr->IslandOf(model.get());
+      if (island && island->sleeping)
+        this->dataPtr->Wake(*island);
+    }
+  }
+  near.clear();
+}
+
+/////////////////////////////////////////////////
+bool SleepManager::Sleeping(const Model *_model) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  SleepIsland *island = this->dataPtr->IslandOf(_model);
+  return island && island->sleeping;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Wake(const Model *_model)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  SleepIsland *island = this->dataPtr->IslandOf(_model);
+  if (island)
+    this->dataPtr->Wake(*island);
+}
+
+/////////////////////////////////////////////////
+std::size_t SleepManager::SleepingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->sleepingLinks;
+}
+
+/////////////////////////////////////////////////
+void SleepManager::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &island : this->dataPtr->islands)
+    this->dataPtr->Wake(island);
+  this->dataPtr->islands.clear();
+  this->dataPtr->islandOf.clear();
+  this->dataPtr->moving.clear();
+  this->dataPtr->dirty = true;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+#define GAZEBO_PHYSICS_SLEEPMANAGER_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class.
+    class SleepManagerPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class SleepManager SleepManager.hh physics/physics.hh
+    /// \brief Puts the idle models of a world to sleep, with the same
+    /// thresholds for every physics engine.
+    ///
+    /// The models are grouped in islands: a model with its nested models,
+    /// and the models joined to it by joints. After each physics update,
+    /// an island whose links all stay under the velocity thresholds of
+    /// PhysicsEngine::SleepLinearVelocity() and
+    /// PhysicsEngine::SleepAngularVelocity() for PhysicsEngine::SleepTime()
+    /// is put to sleep by disabling its links in the engine. A sleeping
+    /// island is neither integrated nor collided with the static world,
+    /// its links aren't dirty, and its poses aren't published.
+    ///
+    /// An island wakes up when one of its links is enabled again, which
+    /// the engines do on contact with an awake body and when a force, a
+    /// joint effort, a velocity or a pose is set, or when a moving link
+    /// comes close to it. Models that don't allow auto disable or that
+    /// carry sensors never sleep, and the islands of an engine that can't
+    /// disable links stay awake.
+    class GZ_PHYSICS_VISIBLE SleepManager
+    {
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit SleepManager(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~SleepManager();
+
+      /// \brief Rebuild the islands before the next update. This is called
+      /// by the world when models are inserted or removed.
+      public: void Refresh();
+
+      /// \brief Put the idle islands to sleep, and wake the islands that
+      /// were disturbed. This is called by the world after the physics
+      /// update, and does nothing unless PhysicsEngine::SleepEnabled().
+      public: void Update();
+
+      /// \brief Get whether a model sleeps.
+      /// \param[in] _model The model, or one of its nested models.
+      /// \return True if the island of the model sleeps.
+      public: bool Sleeping(const Model *_model) const;
+
+      /// \brief Wake the island of a model.
+      /// \param[in] _model The model, or one of its nested models.
+      public: void Wake(const Model *_model);
+
+      /// \brief Get the number of sleeping links.
+      /// \return Number of links of the sleeping islands.
+      public: std::size_t SleepingCount() const;
+
+      /// \brief Wake all the islands, and forget them.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SleepManagerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
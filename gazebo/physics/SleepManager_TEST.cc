@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class SleepManagerTest : public ServerFixture,
+                         public testing::WithParamInterface<const char*>
+{
+  /// \brief Idle models sleep, and wake up when disturbed.
+  /// \param[in] _physicsEngine Name of the physics engine.
+  public: void SleepAndWake(const std::string &_physicsEngine);
+};
+
+/////////////////////////////////////////////////
+void SleepManagerTest::SleepAndWake(const std::string &_physicsEngine)
+{
+  this->Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+
+  this->SpawnBox("resting", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnBox("falling", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(3, 0, 20), ignition::math::Vector3d::Zero);
+  physics::ModelPtr resting = world->ModelByName("resting");
+  physics::ModelPtr falling = world->ModelByName("falling");
+  ASSERT_TRUE(resting != nullptr);
+  ASSERT_TRUE(falling != nullptr);
+
+  physics::SleepManager &sleep = world->SleepManager();
+  EXPECT_FALSE(physics->SleepEnabled());
+  EXPECT_TRUE(physics->SetParam("sleep", true));
+  EXPECT_TRUE(physics->SetParam("sleep_time", 0.2));
+  EXPECT_TRUE(boost::any_cast<bool>(physics->GetParam("sleep")));
+  EXPECT_DOUBLE_EQ(0.2, boost::any_cast<double>(
+      physics->GetParam("sleep_time")));
+  EXPECT_DOUBLE_EQ(0.05, physics->SleepLinearVelocity());
+  EXPECT_DOUBLE_EQ(0.05, physics->SleepAngularVelocity());
+
+  world->Step(500);
+  EXPECT_FALSE(sleep.Sleeping(falling.get()));
+
+  // Engines that can't disable the links keep the models awake
+  if (_physicsEngine == "dart" || _physicsEngine == "simbody")
+  {
+    EXPECT_FALSE(sleep.Sleeping(resting.get()));
+    EXPECT_EQ(0u, sleep.SleepingCount());
+    return;
+  }
+
+  EXPECT_TRUE(sleep.Sleeping(resting.get()));
+  EXPECT_EQ(1u, sleep.SleepingCount());
+  EXPECT_FALSE(resting->GetLink("link")->GetEnabled());
+
+  // A velocity wakes the island
+  resting->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+  world->Step(1);
+  EXPECT_FALSE(sleep.Sleeping(resting.get()));
+  EXPECT_GT(resting->WorldPose().Pos().X(), 0);
+
+  // It sleeps again once it stops, and the falling box too
+  world->Step(5000);
+  EXPECT_TRUE(sleep.Sleeping(resting.get()));
+  EXPECT_TRUE(sleep.Sleeping(falling.get()));
+  EXPECT_EQ(2u, sleep.SleepingCount());
+
+  sleep.Wake(falling.get());
+  EXPECT_FALSE(sleep.Sleeping(falling.get()));
+  EXPECT_TRUE(falling->GetLink("link")->GetEnabled());
+
+  // Turning sleeping off wakes every model
+  EXPECT_TRUE(physics->SetParam("sleep", false));
+  world->Step(1);
+  EXPECT_FALSE(sleep.Sleeping(resting.get()));
+  EXPECT_EQ(0u, sleep.SleepingCount());
+  EXPECT_TRUE(resting->GetLink("link")->GetEnabled());
+}
+
+/////////////////////////////////////////////////
+TEST_P(SleepManagerTest, SleepAndWake)
+{
+  SleepAndWake(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, SleepManagerTest,
+                        PHYSICS_ENGINE_VALUES,);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/StepState.hh"
+#include "gazebo/physics/World.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Indices of the links and joints of the states, shared by all
+    /// the states published since the last change of the entities.
+    class StepStateLayout
+    {
+      /// \brief Index of each link, by scoped name.
+      public: std::unordered_map<std::string, unsigned int> links;
+
+      /// \brief Index of the first axis and number of axes of each joint,
+      /// by scoped name.
+      public: std::unordered_map<std::string,
+              std::pair<unsigned int, unsigned int>> joints;
+
+      /// \brief Number of joint axes.
+      public: unsigned int axisCount = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for the StepState class.
+    class StepStatePrivate
+    {
+      /// \brief Indices of the links and joints.
+      public: std::shared_ptr<const StepStateLayout> layout;
+
+      /// \brief Sim time.
+      public: common::Time simTime;
+
+      /// \brief Iteration count.
+      public: uint64_t iterations = 0;
+
+      /// \brief Poses of the links.
+      public: std::vector<ignition::math::Pose3d> poses;
+
+      /// \brief Linear velocities of the origins of the links.
+      public: std::vector<ignition::math::Vector3d> linearVels;
+
+      /// \brief Angular velocities of the links.
+      public: std::vector<ignition::math::Vector3d> angularVels;
+
+      /// \brief Positions of the joint axes.
+      public: std::vector<double> positions;
+
+      /// \brief Velocities of the joint axes.
+      public: std::vector<double> velocities;
+    };
+
+    /// \internal
+    /// \brief Private data for the StepStatePublisher class.
+    class StepStatePublisherPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _world A reference to the world.
+      public: explicit StepStatePublisherPrivate(World &_world)
+        : world(_world), latest(std::make_shared<StepState>())
+      {
+      }
+
+      /// \brief List the links and joints of the world.
+      public: void Rebuild();
+
+      /// \brief Reference to the world.
+      public: World &world;
+
+      /// \brief The last published state, accessed with the atomic
+      /// functions of shared_ptr.
+      public: std::shared_ptr<const StepState> latest;
+
+      /// \brief Buffers that were published, including the latest one. A
+      /// buffer that only this list holds is free.
+      public: std::vector<std::shared_ptr<StepState>> buffers;
+
+      /// \brief Indices of the links and joints.
+      public: std::shared_ptr<const StepStateLayout> layout;
+
+      /// \brief The links, in the order of the layout.
+      public: Link_V links;
+
+      /// \brief The models, whose joint axes follow each other in the
+      /// layout.
+      public: Model_V models;
+
+      /// \brief True once a reader asked for a state.
+      public: mutable std::atomic<bool> used{false};
+
+      /// \brief True if the entities must be listed again.
+      public: std::atomic<bool> dirty{true};
+
+      /// \brief Protects the buffers and the lists, for Clear.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+StepState::StepState()
+  : dataPtr(new StepStatePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+StepState::~StepState()
+{
+}
+
+/////////////////////////////////////////////////
+common::Time StepState::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t StepState::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+bool StepState::LinkPose(const std::string &_link,
+    ignition::math::Pose3d &_pose) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->links.find(_link);
+  if (iter == this->dataPtr->layout->links.end())
+    return false;
+
+  _pose = this->dataPtr->poses[iter->second];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StepState::LinkVelocity(const std::string &_link,
+    const ignition::math::Vector3d &_offset,
+    ignition::math::Vector3d &_linear,
+    ignition::math::Vector3d &_angular) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->links.find(_link);
+  if (iter == this->dataPtr->layout->links.end())
+    return false;
+
+  const unsigned int index = iter->second;
+  _angular = this->dataPtr->angularVels[index];
+  _linear = this->dataPtr->linearVels[index] + _angular.Cross(
+      this->dataPtr->poses[index].Rot().RotateVector(_offset));
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StepState::JointPosition(const std::string &_joint,
+    const unsigned int _axis, double &_position) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->joints.find(_joint);
+  if (iter == this->dataPtr->layout->joints.end() ||
+      _axis >= iter->second.second)
+  {
+    return false;
+  }
+
+  _position = this->dataPtr->positions[iter->second.first + _axis];
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool StepState::JointVelocity(const std::string &_joint,
+    const unsigned int _axis, double &_velocity) const
+{
+  if (!this->dataPtr->layout)
+    return false;
+
+  auto iter = this->dataPtr->layout->joints.find(_joint);
+  if (iter == this->dataPtr->layout->joints.end() ||
+      _axis >= iter->second.second)
+  {
+    return false;
+  }
+
+  _velocity = this->dataPtr->velocities[iter->second.first + _axis];
+  return true;
+}
+
+/////////////////////////////////////////////////
+void StepStatePublisherPrivate::Rebuild()
+{
+  std::shared_ptr<StepStateLayout> newLayout =
+      std::make_shared<StepStateLayout>();
+  this->links.clear();
+  this->models.clear();
+
+  Model_V stack = this->world.Models();
+  std::reverse(stack.begin(), stack.end());
+  while (!stack.empty())
+  {
+    ModelPtr model = stack.back();
+    stack.pop_back();
+    this->models.push_back(model);
+
+    for (auto const &link : model->GetLinks())
+    {
+      newLayout->links[link->GetScopedName()] = this->links.size();
+      this->links.push_back(link);
+    }
+
+    for (auto const &joint : model->GetJoints())
+    {
+      newLayout->joints[joint->GetScopedName()] =
+          std::make_pair(newLayout->axisCount, joint->DOF());
+      newLayout->axisCount += joint->DOF();
+    }
+
+    const Model_V &nested = model->NestedModels();
+    stack.insert(stack.end(), nested.rbegin(), nested.rend());
+  }
+
+  this->layout = newLayout;
+}
+
+/////////////////////////////////////////////////
+StepStatePublisher::StepStatePublisher(World &_world)
+  : dataPtr(new StepStatePublisherPrivate(_world))
+{
+}
+
+/////////////////////////////////////////////////
+StepStatePublisher::~StepStatePublisher()
+{
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const StepState> StepStatePublisher::Latest() const
+{
+  this->dataPtr->used.store(true, std::memory_order_relaxed);
+  return std::atomic_load(&this->dataPtr->latest);
+}
+
+/////////////////////////////////////////////////
+void StepStatePublisher::Publish()
+{
+  // Nobody reads the states, don't write them
+  if (!this->dataPtr->used.load(std::memory_order_relaxed))
+    return;
+
+  IGN_PROFILE("StepStatePublisher::Publish");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->dirty.exchange(false))
+    this->dataPtr->Rebuild();
+
+  // A buffer that no reader holds anymore is written again. Readers only
+  // get the latest state, so the count of the others can only drop.
+  std::shared_ptr<StepState> state;
+  for (auto const &buffer : this->dataPtr->buffers)
+  {
+    if (buffer.use_count() == 1)
+    {
+      state = buffer;
+      break;
+    }
+  }
+  if (!state)
+  {
+    state = std::make_shared<StepState>();
+    this->dataPtr->buffers.push_back(state);
+  }
+
+  StepStatePrivate &data = *state->dataPtr;
+  data.layout = this->dataPtr->layout;
+  data.simTime = this->dataPtr->world.SimTime();
+  data.iterations = this->dataPtr->world.Iterations();
+
+  const std::size_t linkCount = this->dataPtr->links.size();
+  data.poses.resize(linkCount);
+  data.linearVels.resize(linkCount);
+  data.angularVels.resize(linkCount);
+  for (std::size_t i = 0; i < linkCount; ++i)
+  {
+    const LinkPtr &link = this->dataPtr->links[i];
+    data.poses[i] = link->WorldPose();
+    data.linearVels[i] = link->WorldLinearVel();
+    data.angularVels[i] = link->WorldAngularVel();
+  }
+
+  // The joint states come from the cache of the models
+  const unsigned int axisCount = this->dataPtr->layout->axisCount;
+  data.positions.assign(axisCount, 0);
+  data.velocities.assign(axisCount, 0);
+  unsigned int offset = 0;
+  for (auto const &model : this->dataPtr->models)
+  {
+    const std::vector<double> &positions = model->JointPositions();
+    const std::vector<double> &velocities = model->JointVelocities();
+    const std::size_t count = std::min(positions.size(),
+        static_cast<std::size_t>(axisCount - offset));
+    std::copy(positions.begin(), positions.begin() + count,
+        data.positions.begin() + offset);
+    std::copy(velocities.begin(),
+        velocities.begin() + std::min(count, velocities.size()),
+        data.velocities.begin() + offset);
+
+    for (auto const &joint : model->GetJoints())
+      offset += joint->DOF();
+  }
+
+  std::atomic_store(&this->dataPtr->latest,
+      std::shared_ptr<const StepState>(state));
+}
+
+/////////////////////////////////////////////////
+void StepStatePublisher::Refresh()
+{
+  this->dataPtr->dirty.store(true);
+}
+
+/////////////////////////////////////////////////
+std::size_t StepStatePublisher::BufferCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->buffers.size();
+}
+
+/////////////////////////////////////////////////
+void StepStatePublisher::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::atomic_store(&this->dataPtr->latest,
+      std::shared_ptr<const StepState>(std::make_shared<StepState>()));
+  this->dataPtr->buffers.clear();
+  this->dataPtr->links.clear();
+  this->dataPtr->models.clear();
+  this->dataPtr->layout.reset();
+  this->dataPtr->dirty.store(true);
+}
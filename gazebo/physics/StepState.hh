@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_STEPSTATE_HH_
+#define GAZEBO_PHYSICS_STEPSTATE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data classes.
+    class StepStatePrivate;
+    class StepStatePublisherPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class StepState StepState.hh physics/physics.hh
+    /// \brief Poses and velocities of the links and states of the joints of
+    /// a world at the end of a step. A published state never changes, so
+    /// it can be read from any thread without locking.
+    class GZ_PHYSICS_VISIBLE StepState
+    {
+      /// \brief Constructor.
+      public: StepState();
+
+      /// \brief Destructor.
+      public: virtual ~StepState();
+
+      /// \brief Get the sim time at the end of the step.
+      /// \return The sim time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the iteration count at the end of the step.
+      /// \return The iteration count, 0 before the first step.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the pose of a link.
+      /// \param[in] _link Scoped name of the link.
+      /// \param[out] _pose Pose of the link in the world frame.
+      /// \return False if the link isn't in the state.
+      public: bool LinkPose(const std::string &_link,
+                  ignition::math::Pose3d &_pose) const;
+
+      /// \brief Get the velocity of a point of a link.
+      /// \param[in] _link Scoped name of the link.
+      /// \param[in] _offset Position of the point in the link frame.
+      /// \param[out] _linear Linear velocity of the point in the world
+      /// frame.
+      /// \param[out] _angular Angular velocity of the link in the world
+      /// frame.
+      /// \return False if the link isn't in the state.
+      public: bool LinkVelocity(const std::string &_link,
+                  const ignition::math::Vector3d &_offset,
+                  ignition::math::Vector3d &_linear,
+                  ignition::math::Vector3d &_angular) const;
+
+      /// \brief Get the position of an axis of a joint.
+      /// \param[in] _joint Scoped name of the joint.
+      /// \param[in] _axis Index of the axis.
+      /// \param[out] _position The position.
+      /// \return False if the axis isn't in the state.
+      public: bool JointPosition(const std::string &_joint,
+                  const unsigned int _axis, double &_position) const;
+
+      /// \brief Get the velocity of an axis of a joint.
+      /// \param[in] _joint Scoped name of the joint.
+      /// \param[in] _axis Index of the axis.
+      /// \param[out] _velocity The velocity.
+      /// \return False if the axis isn't in the state.
+      public: bool JointVelocity(const std::string &_joint,
+                  const unsigned int _axis, double &_velocity) const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepStatePrivate> dataPtr;
+
+      /// \brief The publisher writes the states.
+      private: friend class StepStatePublisher;
+    };
+
+    /// \class StepStatePublisher StepState.hh physics/physics.hh
+    /// \brief Publishes the state of a world after each step, for the
+    /// sensors, the GUI request handlers and the plugins that read poses
+    /// while the world steps.
+    ///
+    /// The world writes the next state into a spare buffer while the
+    /// readers hold the last published one, then swaps it in. A reader
+    /// keeps the state it got alive for as long as it holds it, and a
+    /// buffer is written again only once its last reader released it, so
+    /// the step never waits for the readers and the readers never wait for
+    /// the step.
+    class GZ_PHYSICS_VISIBLE StepStatePublisher
+    {
+      /// \brief Constructor.
+      /// \param[in] _world Reference to the world.
+      public: explicit StepStatePublisher(World &_world);
+
+      /// \brief Destructor.
+      public: virtual ~StepStatePublisher();
+
+      /// \brief Get the last published state. The world publishes a state
+      /// after each step from the first call on.
+      /// \return The state, never null. It is empty until a step was
+      /// published.
+      public: std::shared_ptr<const StepState> Latest() const;
+
+      /// \brief Write and publish the state of the world. This is called by
+      /// the world after each step, under the physics update mutex.
+      public: void Publish();
+
+      /// \brief List the links and joints again at the next publication.
+      /// This is called by the world when models are inserted or removed.
+      public: void Refresh();
+
+      /// \brief Get the number of state buffers allocated so far.
+      /// \return Number of buffers.
+      public: std::size_t BufferCount() const;
+
+      /// \brief Publish an empty state and release the spare buffers.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepStatePublisherPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
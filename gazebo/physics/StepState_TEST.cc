@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StepStateTest : public ServerFixture {};
+
+/////////////////////////////////////////////////
+TEST_F(StepStateTest, Publish)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(1, 2, 3), ignition::math::Vector3d::Zero);
+
+  // Nothing is published before a reader asks
+  physics::StepStatePublisher &states = world->StepStates();
+  std::shared_ptr<const physics::StepState> state = states.Latest();
+  ASSERT_TRUE(state != nullptr);
+  ignition::math::Pose3d pose;
+  EXPECT_FALSE(state->LinkPose("box::body", pose));
+  EXPECT_EQ(state->Iterations(), 0u);
+
+  world->Step(1);
+  std::shared_ptr<const physics::StepState> first = states.Latest();
+  EXPECT_EQ(first->Iterations(), world->Iterations());
+  EXPECT_EQ(first->SimTime(), world->SimTime());
+  ASSERT_TRUE(first->LinkPose("box::body", pose));
+  physics::LinkPtr link = world->ModelByName("box")->GetLink("body");
+  EXPECT_EQ(pose, link->WorldPose());
+  EXPECT_FALSE(first->LinkPose("missing", pose));
+
+  // The box falls, the state that's held doesn't change
+  const ignition::math::Pose3d firstPose = pose;
+  world->Step(100);
+  ASSERT_TRUE(first->LinkPose("box::body", pose));
+  EXPECT_EQ(pose, firstPose);
+
+  std::shared_ptr<const physics::StepState> last = states.Latest();
+  EXPECT_EQ(last->Iterations(), world->Iterations());
+  ASSERT_TRUE(last->LinkPose("box::body", pose));
+  EXPECT_LT(pose.Pos().Z(), firstPose.Pos().Z());
+
+  ignition::math::Vector3d linear, angular;
+  ASSERT_TRUE(last->LinkVelocity("box::body", ignition::math::Vector3d::Zero,
+      linear, angular));
+  EXPECT_LT(linear.Z(), 0);
+
+  // Buffers are reused once released
+  first.reset();
+  last.reset();
+  state.reset();
+  world->Step(100);
+  EXPECT_LE(states.BufferCount(), 3u);
+
+  // Inserted models are published after the next step
+  this->SpawnBox("box2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+  world->Step(1);
+  EXPECT_TRUE(states.Latest()->LinkPose("box2::body", pose));
+  EXPECT_NEAR(pose.Pos().X(), 5, 1e-3);
+
+  states.Clear();
+  EXPECT_FALSE(states.Latest()->LinkPose("box2::body", pose));
+  EXPECT_EQ(states.BufferCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepStateTest, Readers)
+{
+  this->Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5), ignition::math::Vector3d::Zero);
+
+  physics::StepStatePublisher &states = world->StepStates();
+  states.Latest();
+  world->Step(1);
+
+  // Readers see the iterations go forward while the world steps
+  std::atomic<bool> stop(false);
+  std::atomic<int> errors(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(std::thread([&]()
+        {
+          uint64_t iterations = 0;
+          while (!stop)
+          {
+            std::shared_ptr<const physics::StepState> state = states.Latest();
+            ignition::math::Pose3d pose;
+            if (state->Iterations() < iterations ||
+                !state->LinkPose("box::body", pose))
+            {
+              ++errors;
+            }
+            iterations = state->Iterations();
+          }
+        }));
+  }
+
+  world->Step(500);
+  stop = true;
+  for (auto &thread : threads)
+    thread.join();
+  EXPECT_EQ(errors, 0);
+  EXPECT_EQ(states.Latest()->Iterations(), world->Iterations());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/StepTelemetry.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Histogram of a phase over a window.
+    class StepTelemetryHistogram
+    {
+      /// \brief Add a duration.
+      /// \param[in] _seconds The duration.
+      public: void Add(const double _seconds)
+              {
+                ++this->count;
+                this->sum += _seconds;
+                this->max = std::max(this->max, _seconds);
+
+                const double us = _seconds * 1e6;
+                unsigned int bin = 0;
+                if (us >= 1)
+                {
+                  bin = std::min(StepTelemetry::BinCount - 1,
+                      static_cast<unsigned int>(std::ilogb(us)) + 1);
+                }
+                ++this->bins[bin];
+              }
+
+      /// \brief Number of durations.
+      public: uint64_t count = 0;
+
+      /// \brief Sum of the durations in seconds.
+      public: double sum = 0;
+
+      /// \brief Longest duration in seconds.
+      public: double max = 0;
+
+      /// \brief Number of durations by bin.
+      public: uint64_t bins[StepTelemetry::BinCount] = {};
+    };
+
+    /// \internal
+    /// \brief A step kept among the worst of a window.
+    class StepTelemetryWorst
+    {
+      /// \brief Iteration of the step.
+      public: uint64_t iteration = 0;
+
+      /// \brief Wall time of the step in seconds.
+      public: double duration = 0;
+
+      /// \brief Longest phase of the step.
+      public: StepTelemetry::Phase phase = StepTelemetry::COLLISION;
+
+      /// \brief Wall time of the longest phase in seconds.
+      public: double phaseDuration = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for StepTelemetry
+    class StepTelemetryPrivate
+    {
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Histogram of the steps.
+      public: StepTelemetryHistogram step;
+
+      /// \brief Histogram of the intervals between the steps.
+      public: StepTelemetryHistogram interval;
+
+      /// \brief Histogram of each phase.
+      public: StepTelemetryHistogram phases[StepTelemetry::PHASE_COUNT];
+
+      /// \brief Worst steps of the window, from the longest.
+      public: std::vector<StepTelemetryWorst> worst;
+
+      /// \brief Start of the window.
+      public: StepTelemetry::Clock::time_point windowStart =
+          StepTelemetry::Clock::now();
+
+      /// \brief Start of the previous step.
+      public: StepTelemetry::Clock::time_point prevStart;
+
+      /// \brief True once a step was recorded.
+      public: bool hasPrev = false;
+
+      /// \brief Period of the last step in seconds.
+      public: double period = 0;
+
+      /// \brief Steps of the window that exceeded their period.
+      public: uint64_t deadlineMisses = 0;
+
+      /// \brief Steps that exceeded their period since the construction.
+      public: uint64_t totalDeadlineMisses = 0;
+    };
+  }
+}
+
+const unsigned int StepTelemetry::BinCount;
+const unsigned int StepTelemetry::WorstCount;
+
+/////////////////////////////////////////////////
+/// \brief Fill a phase of a message.
+/// \param[in] _name Name of the phase.
+/// \param[in] _histogram Histogram of the phase.
+/// \param[out] _msg The message.
+static void fillPhase(const std::string &_name,
+    const StepTelemetryHistogram &_histogram, msgs::StepStatistics &_msg)
+{
+  msgs::StepStatistics::Phase *phase = _msg.add_phase();
+  phase->set_name(_name);
+  phase->set_count(_histogram.count);
+  phase->set_mean(_histogram.count > 0 ? _histogram.sum / _histogram.count : 0);
+  phase->set_max(_histogram.max);
+  for (auto const bin : _histogram.bins)
+    phase->add_histogram(bin);
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::StepSample::Reset()
+{
+  this->start = Clock::now();
+  std::fill(this->phases, this->phases + PHASE_COUNT, 0.0);
+  this->sleep = 0;
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::StepSample::Add(const Phase _phase,
+    const Clock::time_point &_start)
+{
+  this->phases[_phase] +=
+      std::chrono::duration<double>(Clock::now() - _start).count();
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::StepSample::Merge(const StepSample &_other)
+{
+  for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+    this->phases[i] += _other.phases[i];
+}
+
+/////////////////////////////////////////////////
+StepTelemetry::PhaseTimer::PhaseTimer(StepSample &_sample,
+    const Phase _phase)
+  : sample(_sample), phase(_phase), start(Clock::now())
+{
+}
+
+/////////////////////////////////////////////////
+StepTelemetry::PhaseTimer::~PhaseTimer()
+{
+  this->sample.Add(this->phase, this->start);
+}
+
+/////////////////////////////////////////////////
+StepTelemetry::StepTelemetry()
+  : dataPtr(new StepTelemetryPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+StepTelemetry::~StepTelemetry()
+{
+}
+
+/////////////////////////////////////////////////
+std::string StepTelemetry::PhaseName(const Phase _phase)
+{
+  switch (_phase)
+  {
+    case COLLISION:
+      return "collision";
+    case PHYSICS:
+      return "physics";
+    case PLUGINS:
+      return "plugins";
+    case SENSOR_WAIT:
+      return "sensor_wait";
+    case MESSAGES:
+      return "messages";
+    default:
+      return "";
+  }
+}
+
+/////////////////////////////////////////////////
+double StepTelemetry::BinUpperBound(const unsigned int _bin)
+{
+  if (_bin + 1 >= BinCount)
+    return std::numeric_limits<double>::infinity();
+  return std::ldexp(1e-6, static_cast<int>(_bin));
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::Record(const StepSample &_sample,
+    const uint64_t _iteration, const double _period)
+{
+  const Clock::time_point end = Clock::now();
+  const double duration = std::max(0.0,
+      std::chrono::duration<double>(end - _sample.start).count() -
+      _sample.sleep);
+
+  StepTelemetryWorst step;
+  step.iteration = _iteration;
+  step.duration = duration;
+  for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+  {
+    if (_sample.phases[i] > step.phaseDuration)
+    {
+      step.phase = static_cast<Phase>(i);
+      step.phaseDuration = _sample.phases[i];
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->step.Add(duration);
+  for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+    this->dataPtr->phases[i].Add(_sample.phases[i]);
+
+  if (this->dataPtr->hasPrev)
+  {
+    this->dataPtr->interval.Add(std::chrono::duration<double>(
+        _sample.start - this->dataPtr->prevStart).count());
+  }
+  this->dataPtr->prevStart = _sample.start;
+  this->dataPtr->hasPrev = true;
+
+  this->dataPtr->period = _period;
+  if (_period > 0 && duration > _period)
+  {
+    ++this->dataPtr->deadlineMisses;
+    ++this->dataPtr->totalDeadlineMisses;
+  }
+
+  // Keep the worst steps sorted, from the longest.
+  auto &worst = this->dataPtr->worst;
+  if (worst.size() < WorstCount || duration > worst.back().duration)
+  {
+    auto iter = std::upper_bound(worst.begin(), worst.end(), step,
+        [](const StepTelemetryWorst &_a, const StepTelemetryWorst &_b)
+        {
+          return _a.duration > _b.duration;
+        });
+    worst.insert(iter, step);
+    if (worst.size() > WorstCount)
+      worst.pop_back();
+  }
+}
+
+/////////////////////////////////////////////////
+uint64_t StepTelemetry::TotalDeadlineMisses() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->totalDeadlineMisses;
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::Fill(msgs::StepStatistics &_msg)
+{
+  _msg.Clear();
+  const Clock::time_point now = Clock::now();
+  msgs::Set(_msg.mutable_stamp(), common::Time::GetWallTime());
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  _msg.set_window(std::chrono::duration<double>(
+      now - this->dataPtr->windowStart).count());
+  _msg.set_period(this->dataPtr->period);
+  _msg.set_deadline_misses(this->dataPtr->deadlineMisses);
+  _msg.set_total_deadline_misses(this->dataPtr->totalDeadlineMisses);
+
+  fillPhase("step", this->dataPtr->step, _msg);
+  fillPhase("interval", this->dataPtr->interval, _msg);
+  for (unsigned int i = 0; i < PHASE_COUNT; ++i)
+  {
+    fillPhase(PhaseName(static_cast<Phase>(i)), this->dataPtr->phases[i],
+        _msg);
+  }
+
+  for (auto const &worst : this->dataPtr->worst)
+  {
+    msgs::StepStatistics::Step *step = _msg.add_worst();
+    step->set_iteration(worst.iteration);
+    step->set_duration(worst.duration);
+    step->set_phase(PhaseName(worst.phase));
+    step->set_phase_duration(worst.phaseDuration);
+  }
+
+  // Start a new window.
+  this->dataPtr->step = StepTelemetryHistogram();
+  this->dataPtr->interval = StepTelemetryHistogram();
+  for (auto &phase : this->dataPtr->phases)
+    phase = StepTelemetryHistogram();
+  this->dataPtr->worst.clear();
+  this->dataPtr->deadlineMisses = 0;
+  this->dataPtr->windowStart = now;
+}
+
+/////////////////////////////////////////////////
+void StepTelemetry::Reset()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->step = StepTelemetryHistogram();
+  this->dataPtr->interval = StepTelemetryHistogram();
+  for (auto &phase : this->dataPtr->phases)
+    phase = StepTelemetryHistogram();
+  this->dataPtr->worst.clear();
+  this->dataPtr->windowStart = Clock::now();
+  this->dataPtr->hasPrev = false;
+  this->dataPtr->period = 0;
+  this->dataPtr->deadlineMisses = 0;
+  this->dataPtr->totalDeadlineMisses = 0;
+}
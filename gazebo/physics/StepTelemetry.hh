@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_STEPTELEMETRY_HH_
+#define GAZEBO_PHYSICS_STEPTELEMETRY_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class StepTelemetryPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class StepTelemetry StepTelemetry.hh physics/physics.hh
+    /// \brief Histograms of the wall time of the steps of a world and of
+    /// their phases, with the steps that missed the update period.
+    ///
+    /// The world times each step in a StepSample, and records it when the
+    /// step ran an update. The histograms cover the steps recorded since
+    /// the last call to Fill(). Their bins are powers of two of
+    /// microseconds: bin 0 counts the durations below 1 us, bin i those
+    /// from 2^(i-1) to 2^i us, and the last bin the longer ones.
+    class GZ_PHYSICS_VISIBLE StepTelemetry
+    {
+      /// \brief Phases of a step.
+      public: enum Phase
+      {
+        /// \brief PhysicsEngine::UpdateCollision.
+        COLLISION,
+
+        /// \brief PhysicsEngine::UpdatePhysics.
+        PHYSICS,
+
+        /// \brief Callbacks of the world update events, where the plugins
+        /// run.
+        PLUGINS,
+
+        /// \brief Wait for the sensors in lockstep.
+        SENSOR_WAIT,
+
+        /// \brief World::ProcessMessages.
+        MESSAGES,
+
+        /// \brief Number of phases.
+        PHASE_COUNT
+      };
+
+      /// \brief Clock of the samples.
+      public: using Clock = std::chrono::steady_clock;
+
+      /// \brief Wall time of the phases of one step.
+      public: class StepSample
+      {
+        /// \brief Restart the sample.
+        public: void Reset();
+
+        /// \brief Add the wall time since a time point to a phase.
+        /// \param[in] _phase The phase.
+        /// \param[in] _start Start of the phase.
+        public: void Add(const Phase _phase, const Clock::time_point &_start);
+
+        /// \brief Add the phases of another sample.
+        /// \param[in] _other The other sample.
+        public: void Merge(const StepSample &_other);
+
+        /// \brief Start of the step.
+        public: Clock::time_point start;
+
+        /// \brief Wall time of each phase in seconds.
+        public: double phases[PHASE_COUNT] = {0, 0, 0, 0, 0};
+
+        /// \brief Wall time the step slept to keep the update rate, left out
+        /// of its duration, in seconds.
+        public: double sleep = 0;
+      };
+
+      /// \brief Adds the wall time of its scope to a phase of a sample.
+      public: class PhaseTimer
+      {
+        /// \brief Constructor.
+        /// \param[in] _sample The sample.
+        /// \param[in] _phase The phase.
+        public: PhaseTimer(StepSample &_sample, const Phase _phase);
+
+        /// \brief Destructor.
+        public: ~PhaseTimer();
+
+        /// \brief The sample.
+        private: StepSample &sample;
+
+        /// \brief The phase.
+        private: Phase phase;
+
+        /// \brief Start of the scope.
+        private: Clock::time_point start;
+      };
+
+      /// \brief Number of bins of the histograms.
+      public: static const unsigned int BinCount = 24;
+
+      /// \brief Number of worst steps kept.
+      public: static const unsigned int WorstCount = 5;
+
+      /// \brief Constructor.
+      public: StepTelemetry();
+
+      /// \brief Destructor.
+      public: virtual ~StepTelemetry();
+
+      /// \brief Get the name of a phase.
+      /// \param[in] _phase The phase.
+      /// \return Name such as "collision".
+      public: static std::string PhaseName(const Phase _phase);
+
+      /// \brief Get the upper bound of a bin of the histograms.
+      /// \param[in] _bin Index of the bin.
+      /// \return Upper bound in seconds, infinite for the last bin.
+      public: static double BinUpperBound(const unsigned int _bin);
+
+      /// \brief Record a step that ran an update.
+      /// \param[in] _sample Sample of the step.
+      /// \param[in] _iteration Iteration of the update.
+      /// \param[in] _period Update period in seconds, the deadline of the
+      /// step. Zero for no deadline.
+      public: void Record(const StepSample &_sample, const uint64_t _iteration,
+                  const double _period);
+
+      /// \brief Get the number of steps that exceeded their period since
+      /// the construction.
+      /// \return Number of steps.
+      public: uint64_t TotalDeadlineMisses() const;
+
+      /// \brief Fill a message with the steps recorded since the last call,
+      /// and start a new window.
+      /// \param[out] _msg The message.
+      public: void Fill(msgs::StepStatistics &_msg);
+
+      /// \brief Discard every recorded step.
+      public: void Reset();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<StepTelemetryPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
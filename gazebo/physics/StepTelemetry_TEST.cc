@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/physics/StepTelemetry.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class StepTelemetryTest : public ServerFixture
+{
+  /// \brief Step telemetry callback.
+  /// \param[in] _msg The message.
+  public: void OnStepStats(ConstStepStatisticsPtr &_msg)
+          {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->msg = *_msg;
+            ++this->count;
+          }
+
+  /// \brief Protects the members below.
+  public: std::mutex mutex;
+
+  /// \brief Last message received.
+  public: msgs::StepStatistics msg;
+
+  /// \brief Number of messages received.
+  public: unsigned int count = 0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get a phase of a message.
+/// \param[in] _msg The message.
+/// \param[in] _name Name of the phase.
+/// \return The phase, null if not found.
+static const msgs::StepStatistics::Phase *findPhase(
+    const msgs::StepStatistics &_msg, const std::string &_name)
+{
+  for (auto const &phase : _msg.phase())
+  {
+    if (phase.name() == _name)
+      return &phase;
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepTelemetryTest, Bins)
+{
+  EXPECT_DOUBLE_EQ(1e-6, physics::StepTelemetry::BinUpperBound(0));
+  EXPECT_DOUBLE_EQ(2e-6, physics::StepTelemetry::BinUpperBound(1));
+  EXPECT_DOUBLE_EQ(1024e-6, physics::StepTelemetry::BinUpperBound(10));
+  EXPECT_TRUE(std::isinf(physics::StepTelemetry::BinUpperBound(
+      physics::StepTelemetry::BinCount - 1)));
+  EXPECT_EQ("collision", physics::StepTelemetry::PhaseName(
+      physics::StepTelemetry::COLLISION));
+  EXPECT_EQ("sensor_wait", physics::StepTelemetry::PhaseName(
+      physics::StepTelemetry::SENSOR_WAIT));
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepTelemetryTest, Record)
+{
+  physics::StepTelemetry telemetry;
+
+  // Twenty fast steps and one slow step in the physics.
+  for (unsigned int i = 0; i < 21; ++i)
+  {
+    physics::StepTelemetry::StepSample sample;
+    sample.Reset();
+    {
+      physics::StepTelemetry::PhaseTimer timer(sample,
+          i == 10 ? physics::StepTelemetry::PHYSICS :
+          physics::StepTelemetry::COLLISION);
+      if (i == 10)
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    telemetry.Record(sample, i + 1, 0.005);
+  }
+
+  msgs::StepStatistics msg;
+  telemetry.Fill(msg);
+  EXPECT_DOUBLE_EQ(0.005, msg.period());
+  EXPECT_EQ(1u, msg.deadline_misses());
+  EXPECT_EQ(1u, msg.total_deadline_misses());
+  EXPECT_GT(msg.window(), 0.02);
+
+  const msgs::StepStatistics::Phase *step = findPhase(msg, "step");
+  ASSERT_TRUE(step != nullptr);
+  EXPECT_EQ(21u, step->count());
+  EXPECT_GE(step->max(), 0.02);
+  ASSERT_EQ(physics::StepTelemetry::BinCount,
+      static_cast<unsigned int>(step->histogram_size()));
+  uint64_t total = 0;
+  for (auto const bin : step->histogram())
+    total += bin;
+  EXPECT_EQ(21u, total);
+
+  const msgs::StepStatistics::Phase *interval = findPhase(msg, "interval");
+  ASSERT_TRUE(interval != nullptr);
+  EXPECT_EQ(20u, interval->count());
+
+  ASSERT_TRUE(findPhase(msg, "physics") != nullptr);
+  EXPECT_GE(findPhase(msg, "physics")->max(), 0.02);
+
+  // The slow step is the worst one, blamed on the physics.
+  ASSERT_EQ(physics::StepTelemetry::WorstCount,
+      static_cast<unsigned int>(msg.worst_size()));
+  EXPECT_EQ(11u, msg.worst(0).iteration());
+  EXPECT_EQ("physics", msg.worst(0).phase());
+  EXPECT_GE(msg.worst(0).phase_duration(), 0.02);
+  for (int i = 1; i < msg.worst_size(); ++i)
+    EXPECT_LE(msg.worst(i).duration(), msg.worst(i - 1).duration());
+
+  // A new window starts empty, but keeps the total.
+  telemetry.Fill(msg);
+  EXPECT_EQ(0u, findPhase(msg, "step")->count());
+  EXPECT_EQ(0u, msg.deadline_misses());
+  EXPECT_EQ(1u, msg.total_deadline_misses());
+  EXPECT_EQ(0, msg.worst_size());
+
+  // The sleep isn't part of the step.
+  physics::StepTelemetry::StepSample sample;
+  sample.Reset();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  sample.sleep = 0.02;
+  telemetry.Record(sample, 22, 0.005);
+  EXPECT_EQ(1u, telemetry.TotalDeadlineMisses());
+
+  telemetry.Reset();
+  EXPECT_EQ(0u, telemetry.TotalDeadlineMisses());
+}
+
+/////////////////////////////////////////////////
+TEST_F(StepTelemetryTest, Publish)
+{
+  this->Load("worlds/empty.world", false);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  transport::SubscriberPtr sub = this->node->Subscribe("~/step_stats",
+      &StepTelemetryTest::OnStepStats, this);
+
+  // Published once per second.
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->count >= 2)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ASSERT_GE(this->count, 2u);
+  EXPECT_NEAR(1.0, this->msg.window(), 0.5);
+  EXPECT_DOUBLE_EQ(world->Physics()->GetUpdatePeriod(), this->msg.period());
+
+  const msgs::StepStatistics::Phase *step = findPhase(this->msg, "step");
+  ASSERT_TRUE(step != nullptr);
+  EXPECT_GT(step->count(), 0u);
+  for (auto const &name : {"interval", "collision", "physics", "plugins",
+      "sensor_wait", "messages"})
+  {
+    EXPECT_TRUE(findPhase(this->msg, name) != nullptr) << name;
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
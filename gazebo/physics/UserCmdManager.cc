@@ -19,6 +19,8 @@
 
 #include "gazebo/transport/transport.hh"
 
+#include "gazebo/physics/Light.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -28,6 +30,73 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+/// \brief Estimate the memory of a model state.
+/// \param[in] _state The state.
+/// \return Bytes of the state, and of its link, joint and nested states.
+static std::size_t modelBytes(const ModelState &_state)
+{
+  std::size_t bytes = sizeof(ModelState) +
+      _state.GetLinkStateCount() * sizeof(LinkState) +
+      _state.GetJointStateCount() * sizeof(JointState);
+  for (auto const &nested : _state.NestedModelStates())
+    bytes += modelBytes(nested.second);
+  return bytes;
+}
+
+/////////////////////////////////////////////////
+/// \brief Record the states of the affected entities of a command.
+/// \param[in] _data Private data of the command.
+/// \param[out] _models States of the models that were found.
+/// \param[out] _lights States of the lights that were found.
+static void recordStates(const UserCmdPrivate &_data,
+    ModelState_M &_models, LightState_M &_lights)
+{
+  _models.clear();
+  _lights.clear();
+  for (auto const &name : _data.models)
+  {
+    ModelPtr model = _data.world->ModelByName(name);
+    if (model)
+      _models[name] = ModelState(model);
+  }
+  for (auto const &name : _data.lights)
+  {
+    LightPtr light = _data.world->LightByName(name);
+    if (light)
+    {
+      _lights[name] = LightState(light, _data.world->RealTime(),
+          _data.world->SimTime(), _data.world->Iterations());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Restore the states of the affected entities of a command. The
+/// entities that were removed since are skipped.
+/// \param[in] _data Private data of the command.
+/// \param[in] _models States of the models.
+/// \param[in] _lights States of the lights.
+static void restoreStates(const UserCmdPrivate &_data,
+    const ModelState_M &_models, const LightState_M &_lights)
+{
+  for (auto const &state : _models)
+  {
+    ModelPtr model = _data.world->ModelByName(state.first);
+    if (model)
+    {
+      model->ResetPhysicsStates();
+      model->SetState(state.second);
+    }
+  }
+  for (auto const &state : _lights)
+  {
+    LightPtr light = _data.world->LightByName(state.first);
+    if (light)
+      light->SetState(state.second);
+  }
+}
+
 
 /////////////////////////////////////////////////
 UserCmd::UserCmd(const unsigned int _id,
@@ -45,6 +114,28 @@ UserCmd::UserCmd(const unsigned int _id,
   this->dataPtr->startState = WorldState(this->dataPtr->world);
 }
 
+/////////////////////////////////////////////////
+UserCmd::UserCmd(const unsigned int _id,
+                 physics::WorldPtr _world,
+                 const std::string &_description,
+                 const msgs::UserCmd::Type &_type,
+                 const std::vector<std::string> &_models,
+                 const std::vector<std::string> &_lights)
+  : dataPtr(new UserCmdPrivate())
+{
+  this->dataPtr->id = _id;
+  this->dataPtr->world = _world;
+  this->dataPtr->description = _description;
+  this->dataPtr->type = _type;
+  this->dataPtr->wholeWorld = false;
+  this->dataPtr->models = _models;
+  this->dataPtr->lights = _lights;
+
+  // Record current state of the affected entities
+  recordStates(*this->dataPtr, this->dataPtr->startModels,
+      this->dataPtr->startLights);
+}
+
 /////////////////////////////////////////////////
 UserCmd::~UserCmd()
 {
@@ -59,6 +150,15 @@ UserCmd::~UserCmd()
 /////////////////////////////////////////////////
 void UserCmd::Undo()
 {
+  if (!this->dataPtr->wholeWorld)
+  {
+    recordStates(*this->dataPtr, this->dataPtr->endModels,
+        this->dataPtr->endLights);
+    restoreStates(*this->dataPtr, this->dataPtr->startModels,
+        this->dataPtr->startLights);
+    return;
+  }
+
   // Record / override the state for redo
   this->dataPtr->endState = WorldState(this->dataPtr->world);
 
@@ -72,6 +172,13 @@ void UserCmd::Undo()
 /////////////////////////////////////////////////
 void UserCmd::Redo()
 {
+  if (!this->dataPtr->wholeWorld)
+  {
+    restoreStates(*this->dataPtr, this->dataPtr->endModels,
+        this->dataPtr->endLights);
+    return;
+  }
+
   // Reset physics states for the whole world
   this->dataPtr->world->ResetPhysicsStates();
 
@@ -97,6 +204,33 @@ msgs::UserCmd::Type UserCmd::Type() const
   return this->dataPtr->type;
 }
 
+/////////////////////////////////////////////////
+std::size_t UserCmd::MemoryBytes() const
+{
+  std::size_t bytes = sizeof(UserCmd) + sizeof(UserCmdPrivate);
+  if (this->dataPtr->wholeWorld)
+  {
+    for (auto const *state :
+        {&this->dataPtr->startState, &this->dataPtr->endState})
+    {
+      bytes += state->LightStateCount() * sizeof(LightState);
+      for (auto const &model : state->GetModelStates())
+        bytes += modelBytes(model.second);
+    }
+    return bytes;
+  }
+
+  for (auto const *states :
+      {&this->dataPtr->startModels, &this->dataPtr->endModels})
+  {
+    for (auto const &state : *states)
+      bytes += modelBytes(state.second);
+  }
+  bytes += (this->dataPtr->startLights.size() +
+      this->dataPtr->endLights.size()) * sizeof(LightState);
+  return bytes;
+}
+
 /////////////////////////////////////////////////
 UserCmdManager::UserCmdManager(const WorldPtr _world)
   : dataPtr(new UserCmdManagerPrivate())
@@ -154,15 +288,66 @@ UserCmdManager::~UserCmdManager()
   this->dataPtr = NULL;
 }
 
+/////////////////////////////////////////////////
+void UserCmdManager::SetHistoryLimit(const std::size_t _bytes)
+{
+  this->dataPtr->historyLimit = _bytes;
+}
+
+/////////////////////////////////////////////////
+std::size_t UserCmdManager::HistoryLimit() const
+{
+  return this->dataPtr->historyLimit;
+}
+
 /////////////////////////////////////////////////
 void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
 {
   // Generate unique id
   unsigned int id = this->dataPtr->idCounter++;
 
+  // Commands on models and lights only keep the states of these entities,
+  // other commands keep the state of the whole world
+  std::vector<std::string> models;
+  std::vector<std::string> lights;
+  bool wholeWorld = false;
+  switch (_msg->type())
+  {
+    case msgs::UserCmd::MOVING:
+    case msgs::UserCmd::SCALING:
+    {
+      for (int i = 0; i < _msg->model_size(); ++i)
+        models.push_back(_msg->model(i).name());
+      for (int i = 0; i < _msg->light_size(); ++i)
+        lights.push_back(_msg->light(i).name());
+      break;
+    }
+    case msgs::UserCmd::WRENCH:
+    {
+      // The wrench moves the whole model of the link
+      const std::string &entity = _msg->entity_name();
+      models.push_back(entity.substr(0, entity.find("::")));
+      break;
+    }
+    default:
+    {
+      wholeWorld = true;
+      break;
+    }
+  }
+
   // Create command
-  UserCmdPtr cmd(new UserCmd(id, this->dataPtr->world, _msg->description(),
-      _msg->type()));
+  UserCmdPtr cmd;
+  if (wholeWorld)
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type()));
+  }
+  else
+  {
+    cmd.reset(new UserCmd(id, this->dataPtr->world, _msg->description(),
+        _msg->type(), models, lights));
+  }
 
   // Forward message after we've saved the current state
   switch (_msg->type())
@@ -226,6 +411,8 @@ void UserCmdManager::OnUserCmdMsg(ConstUserCmdPtr &_msg)
   // Clear redo list
   this->dataPtr->redoCmds.clear();
 
+  this->EnforceHistoryLimit();
+
   // Publish stats
   this->PublishCurrentStats();
 }
@@ -328,9 +515,34 @@ void UserCmdManager::OnUndoRedoMsg(ConstUndoRedoPtr &_msg)
     }
   }
 
+  this->EnforceHistoryLimit();
   this->PublishCurrentStats();
 }
 
+/////////////////////////////////////////////////
+void UserCmdManager::EnforceHistoryLimit()
+{
+  std::size_t bytes = 0;
+  for (auto const &cmd : this->dataPtr->redoCmds)
+    bytes += cmd->MemoryBytes();
+  for (auto const &cmd : this->dataPtr->undoCmds)
+    bytes += cmd->MemoryBytes();
+
+  // Forget the oldest commands, which are the first ones to undo
+  std::size_t forget = 0;
+  while (bytes > this->dataPtr->historyLimit &&
+      forget + 1 < this->dataPtr->undoCmds.size())
+  {
+    bytes -= this->dataPtr->undoCmds[forget]->MemoryBytes();
+    ++forget;
+  }
+  this->dataPtr->undoCmds.erase(this->dataPtr->undoCmds.begin(),
+      this->dataPtr->undoCmds.begin() + forget);
+
+  this->dataPtr->memory.Set(bytes, this->dataPtr->undoCmds.size() +
+      this->dataPtr->redoCmds.size());
+}
+
 /////////////////////////////////////////////////
 void UserCmdManager::PublishCurrentStats()
 {
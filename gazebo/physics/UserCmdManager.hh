@@ -17,7 +17,9 @@
 #ifndef GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 #define GAZEBO_PHYSICS_USERCMDMANAGER_HH_
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -45,6 +47,22 @@ namespace gazebo
                       const std::string &_description,
                       const msgs::UserCmd::Type &_type);
 
+      /// \brief Constructor of a command that only affects some entities.
+      /// It keeps the states of these entities instead of the state of the
+      /// whole world, and only restores them.
+      /// \param[in] _id Unique ID for this command
+      /// \param[in] _world Pointer to the world
+      /// \param[in] _description Description for the command.
+      /// \param[in] _type Type of command, such as MOVING, DELETING, etc.
+      /// \param[in] _models Scoped names of the affected models.
+      /// \param[in] _lights Names of the affected lights.
+      public: UserCmd(const unsigned int _id,
+                      physics::WorldPtr _world,
+                      const std::string &_description,
+                      const msgs::UserCmd::Type &_type,
+                      const std::vector<std::string> &_models,
+                      const std::vector<std::string> &_lights);
+
       /// \brief Destructor
       public: virtual ~UserCmd();
 
@@ -66,6 +84,11 @@ namespace gazebo
       /// \return Command type
       public: msgs::UserCmd::Type Type() const;
 
+      /// \brief Get an estimate of the memory of the states kept by this
+      /// command.
+      /// \return Bytes of the states.
+      public: std::size_t MemoryBytes() const;
+
       /// \internal
       /// \brief Pointer to private data.
       protected: UserCmdPrivate *dataPtr;
@@ -83,6 +106,16 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~UserCmdManager();
 
+      /// \brief Set the memory limit of the undo history. The oldest
+      /// commands are forgotten when the states kept by all the commands
+      /// are over it. The last command is always kept.
+      /// \param[in] _bytes Limit in bytes.
+      public: void SetHistoryLimit(const std::size_t _bytes);
+
+      /// \brief Get the memory limit of the undo history.
+      /// \return Limit in bytes.
+      public: std::size_t HistoryLimit() const;
+
       /// \brief Callback when a UserCmd message is received, notifying that
       /// a new command has been executed by a user.
       /// \param[in] _msg Incoming message
@@ -96,6 +129,10 @@ namespace gazebo
       /// \brief Publish a message about current user command statistics.
       private: void PublishCurrentStats();
 
+      /// \brief Forget the oldest commands until the history is under its
+      /// memory limit.
+      private: void EnforceHistoryLimit();
+
       /// \internal
       /// \brief Pointer to private data.
       private: UserCmdManagerPrivate *dataPtr;
@@ -17,20 +17,21 @@
 #ifndef _GAZEBO_USER_CMD_MANAGER_PRIVATE_HH_
 #define _GAZEBO_USER_CMD_MANAGER_PRIVATE_HH_
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <sdf/sdf.hh>
 
+#include "gazebo/common/MemoryAccounts.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
-    class WorldState;
-
     /// \internal
     /// \brief Private data for the UserCmdManager class
     class UserCmdPrivate
@@ -38,6 +39,10 @@ namespace gazebo
       /// \brief Pointer to the world.
       public: WorldPtr world;
 
+      /// \brief True if the command keeps the state of the whole world,
+      /// false if it only keeps the states of the affected entities.
+      public: bool wholeWorld = true;
+
       /// \brief Whole world state the moment the user command was executed.
       public: WorldState startState;
 
@@ -45,6 +50,22 @@ namespace gazebo
       /// triggered undo for this command.
       public: WorldState endState;
 
+      /// \brief Scoped names of the affected models.
+      public: std::vector<std::string> models;
+
+      /// \brief Names of the affected lights.
+      public: std::vector<std::string> lights;
+
+      /// \brief States of the affected models, by scoped name, the moment
+      /// the command was executed and the most recent time it was undone.
+      public: ModelState_M startModels;
+      public: ModelState_M endModels;
+
+      /// \brief States of the affected lights, by name, the moment the
+      /// command was executed and the most recent time it was undone.
+      public: LightState_M startLights;
+      public: LightState_M endLights;
+
       /// \brief Unique ID identifying this command in the server.
       public: unsigned int id;
 
@@ -93,6 +114,12 @@ namespace gazebo
 
       /// \brief List of commands which can be redone.
       public: std::vector<UserCmdPtr> redoCmds;
+
+      /// \brief Memory limit of the undo history, in bytes.
+      public: std::atomic<std::size_t> historyLimit{64u * 1024u * 1024u};
+
+      /// \brief Memory of the undo history.
+      public: common::MemoryUsage memory{"physics/undo_history"};
     };
   }
 }
@@ -61,6 +61,48 @@ TEST_F(UserCmdManagerTest, CreateCmd)
   manager = NULL;
 }
 
+/////////////////////////////////////////////////
+TEST_F(UserCmdManagerTest, EntityCmd)
+{
+  Load("test/worlds/empty_test.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  this->SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 0.5), ignition::math::Vector3d::Zero);
+  this->SpawnBox("other", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(5, 0, 0.5), ignition::math::Vector3d::Zero);
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr other = world->ModelByName("other");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(other != NULL);
+
+  physics::UserCmdManager manager(world);
+  EXPECT_GT(manager.HistoryLimit(), 0u);
+  manager.SetHistoryLimit(1024);
+  EXPECT_EQ(manager.HistoryLimit(), 1024u);
+
+  // Only the state of the box is kept
+  physics::UserCmd worldCmd(1, world, "World", msgs::UserCmd::MOVING);
+  physics::UserCmd cmd(2, world, "Move box", msgs::UserCmd::MOVING,
+      {"box", "missing"}, {});
+  EXPECT_LT(cmd.MemoryBytes(), worldCmd.MemoryBytes());
+
+  const ignition::math::Pose3d start = box->WorldPose();
+  const ignition::math::Pose3d moved(1, 2, 0.5, 0, 0, 0);
+  box->SetWorldPose(moved);
+  other->SetWorldPose(ignition::math::Pose3d(5, 5, 0.5, 0, 0, 0));
+
+  // Undo only restores the box
+  cmd.Undo();
+  EXPECT_EQ(box->WorldPose(), start);
+  EXPECT_EQ(other->WorldPose(), ignition::math::Pose3d(5, 5, 0.5, 0, 0, 0));
+
+  cmd.Redo();
+  EXPECT_EQ(box->WorldPose(), moved);
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
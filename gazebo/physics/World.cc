@@ -19,13 +19,22 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <deque>
+#include <functional>
+#include <iterator>
 #include <list>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -38,7 +47,6 @@
 #include <ignition/msgs/stringmsg.pb.h>
 
 #include "ignition/common/Profiler.hh"
-#include "ignition/common/URI.hh"
 #include "gazebo/common/FuelModelDatabase.hh"
 
 #include "gazebo/transport/Node.hh"
@@ -48,13 +56,19 @@
 
 #include "gazebo/util/LogPlay.hh"
 
+#include "gazebo/common/IterationProfiler.hh"
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/ModelSdfCache.hh"
+#include "gazebo/common/PluginCosts.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Plugin.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -68,6 +82,7 @@
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointController.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
@@ -81,6 +96,7 @@
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshotPrivate.hh"
 #include "gazebo/common/SphericalCoordinates.hh"
 
 #include "gazebo/physics/Collision.hh"
@@ -90,13 +106,9 @@
 using namespace gazebo;
 using namespace physics;
 
-/// \brief Flag used to say if/when to clear all models.
-/// This will be replaced with a class member variable in Gazebo 3.0
-bool g_clearModels;
-
 class ModelUpdate_TBB
 {
-  public: explicit ModelUpdate_TBB(Model_V *_models) : models(_models) {}
+  public: explicit ModelUpdate_TBB(const Model_V *_models) : models(_models) {}
   public: void operator() (const tbb::blocked_range<size_t> &_r) const
   {
     for (size_t i = _r.begin(); i != _r.end(); i++)
@@ -105,14 +117,499 @@ class ModelUpdate_TBB
     }
   }
 
-  private: Model_V *models;
+  private: const Model_V *models;
 };
 
+//////////////////////////////////////////////////
+/// \brief Get the task arena of the model updates, with as many threads as
+/// the physics engine allows.
+/// \param[in] _data Private data of the world.
+/// \param[in] _engine Physics engine of the world.
+/// \return The task arena.
+static tbb::task_arena &modelUpdateArena(WorldPrivate &_data,
+    const PhysicsEngine &_engine)
+{
+  const int threads = _engine.ModelUpdateThreads();
+  if (!_data.modelUpdateArena ||
+      _data.modelUpdateArena->max_concurrency() != threads)
+  {
+    _data.modelUpdateArena.reset(new tbb::task_arena(threads));
+  }
+  return *_data.modelUpdateArena;
+}
+
+/// \brief Wall time, in seconds, spent filling scene requests per step.
+static const double kSceneRequestBudget = 0.0005;
+
+//////////////////////////////////////////////////
+/// \brief Mix values into a 64 bit FNV-1a hash, so that two runs give the
+/// same checksum only if their values are bitwise identical.
+/// \param[in] _hash The hash so far.
+/// \param[in] _values The values.
+/// \param[in] _count Number of values.
+/// \return The new hash.
+static uint64_t hashValues(uint64_t _hash, const double *_values,
+    const std::size_t _count)
+{
+  const unsigned char *bytes =
+      reinterpret_cast<const unsigned char *>(_values);
+  for (std::size_t i = 0; i < _count * sizeof(*_values); ++i)
+  {
+    _hash ^= bytes[i];
+    _hash *= 1099511628211ull;
+  }
+  return _hash;
+}
+
+//////////////////////////////////////////////////
+/// \brief Mix the poses and velocities of the links of models into a hash,
+/// in the order of the models.
+/// \param[in] _hash The hash so far.
+/// \param[in] _models The models.
+/// \return The new hash.
+static uint64_t hashModels(uint64_t _hash, const Model_V &_models)
+{
+  for (auto const &model : _models)
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      const ignition::math::Pose3d &pose = link->WorldPose();
+      const ignition::math::Vector3d lin = link->WorldLinearVel();
+      const ignition::math::Vector3d ang = link->WorldAngularVel();
+      const double values[13] = {
+          pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+          pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(), pose.Rot().Z(),
+          lin.X(), lin.Y(), lin.Z(), ang.X(), ang.Y(), ang.Z()};
+      _hash = hashValues(_hash, values, 13);
+    }
+    _hash = hashModels(_hash, model->NestedModels());
+  }
+  return _hash;
+}
+
+//////////////////////////////////////////////////
+/// \brief Serialize and publish the queued responses until the world
+/// stops them.
+/// \param[in] _data Private data of the world.
+static void responseWorker(WorldPrivate &_data)
+{
+  while (true)
+  {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(_data.responseMutex);
+      _data.responseCondition.wait(lock, [&_data]
+          {
+            return _data.stopResponses || !_data.responseJobs.empty();
+          });
+
+      if (_data.responseJobs.empty())
+        return;
+
+      job = std::move(_data.responseJobs.front());
+      _data.responseJobs.pop_front();
+    }
+    job();
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Queue a response for the response thread, which starts with the
+/// first response.
+/// \param[in] _data Private data of the world.
+/// \param[in] _job Serializes and publishes the response.
+static void queueResponse(WorldPrivate &_data,
+    const std::function<void()> &_job)
+{
+  {
+    std::lock_guard<std::mutex> lock(_data.responseMutex);
+    _data.responseJobs.push_back(_job);
+    if (!_data.responseThread.joinable())
+      _data.responseThread = std::thread(responseWorker, std::ref(_data));
+  }
+  _data.responseCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+/// \brief List the models of a scene message, in the order of
+/// World::BuildSceneMsg.
+/// \param[in] _entity Entity whose models are listed.
+/// \param[out] _models The models.
+static void collectModels(const BasePtr &_entity,
+    std::vector<boost::weak_ptr<Model>> &_models)
+{
+  if (_entity->HasType(Base::MODEL))
+    _models.push_back(boost::static_pointer_cast<Model>(_entity));
+
+  for (unsigned int i = 0; i < _entity->GetChildCount(); ++i)
+    collectModels(_entity->GetChild(i), _models);
+}
+
+//////////////////////////////////////////////////
+/// \brief Remove an entity from the names of the index of the entities.
+/// \param[in] _names Ids of the indexed entities by name.
+/// \param[in] _name Name under which the entity is indexed.
+/// \param[in] _id Id of the entity.
+static void eraseIndexedName(
+    std::unordered_multimap<std::string, uint32_t> &_names,
+    const std::string &_name, const uint32_t _id)
+{
+  auto range = _names.equal_range(_name);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    if (iter->second == _id)
+    {
+      _names.erase(iter);
+      return;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Collect the indexed entities of a name.
+/// \param[in] _data World private data, with the index locked.
+/// \param[in] _names Ids of the indexed entities by name.
+/// \param[in] _name The name.
+/// \param[out] _entities The entities that are still alive.
+static void collectIndexed(const WorldPrivate &_data,
+    const std::unordered_multimap<std::string, uint32_t> &_names,
+    const std::string &_name, Base_V &_entities)
+{
+  auto range = _names.equal_range(_name);
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    auto indexed = _data.entityIds.find(iter->second);
+    if (indexed == _data.entityIds.end())
+      continue;
+
+    BasePtr entity = indexed->second.entity.lock();
+    if (entity)
+      _entities.push_back(entity);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Update the poses and states of a model message filled by
+/// Model::FillMsg, which may be out of date.
+/// \param[in] _model The model.
+/// \param[in,out] _msg Message of the model.
+static void refreshState(Model &_model, msgs::Model &_msg)
+{
+  const ignition::math::Pose3d relPose = _model.RelativePose();
+  msgs::Set(_msg.mutable_pose(), relPose);
+  if (_msg.visual_size() > 0)
+    msgs::Set(_msg.mutable_visual(0)->mutable_pose(), relPose);
+  _msg.set_is_static(_model.IsStatic());
+  _msg.set_self_collide(_model.GetSelfCollide());
+  _msg.set_enable_wind(_model.WindMode());
+
+  const Link_V &links = _model.GetLinks();
+  for (int i = 0; i < _msg.link_size() &&
+       i < static_cast<int>(links.size()); ++i)
+  {
+    Link &link = *links[i];
+    const ignition::math::Pose3d linkPose = link.RelativePose();
+    msgs::Link *linkMsg = _msg.mutable_link(i);
+    msgs::Set(linkMsg->mutable_pose(), linkPose);
+    if (linkMsg->visual_size() > 0)
+      msgs::Set(linkMsg->mutable_visual(0)->mutable_pose(), linkPose);
+    linkMsg->set_self_collide(link.GetSelfCollide());
+    linkMsg->set_gravity(link.GetGravityMode());
+    linkMsg->set_enable_wind(link.WindMode());
+    linkMsg->set_kinematic(link.GetKinematic());
+    linkMsg->set_enabled(link.GetEnabled());
+
+    const InertialPtr inertial = link.GetInertial();
+    msgs::Inertial *inertialMsg = linkMsg->mutable_inertial();
+    inertialMsg->set_mass(inertial->Mass());
+    inertialMsg->set_ixx(inertial->IXX());
+    inertialMsg->set_ixy(inertial->IXY());
+    inertialMsg->set_ixz(inertial->IXZ());
+    inertialMsg->set_iyy(inertial->IYY());
+    inertialMsg->set_iyz(inertial->IYZ());
+    inertialMsg->set_izz(inertial->IZZ());
+    msgs::Set(inertialMsg->mutable_pose(), inertial->Pose());
+  }
+
+  const Joint_V &joints = _model.GetJoints();
+  for (int i = 0; i < _msg.joint_size() &&
+       i < static_cast<int>(joints.size()); ++i)
+  {
+    msgs::Joint *jointMsg = _msg.mutable_joint(i);
+    for (int j = 0; j < jointMsg->angle_size(); ++j)
+      jointMsg->set_angle(j, joints[i]->Position(j));
+  }
+
+  const Model_V &models = _model.NestedModels();
+  for (int i = 0; i < _msg.model_size() &&
+       i < static_cast<int>(models.size()); ++i)
+  {
+    refreshState(*models[i], *_msg.mutable_model(i));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a cached model message still has the links, joints,
+/// nested models and scale of its model.
+/// \param[in] _model The model.
+/// \param[in] _msg Cached message of the model.
+/// \return True if the message can be refreshed instead of filled again.
+static bool matchesModel(const Model &_model, const msgs::Model &_msg)
+{
+  const Model_V &models = _model.NestedModels();
+  if (_msg.link_size() != static_cast<int>(_model.GetLinks().size()) ||
+      _msg.joint_size() != static_cast<int>(_model.GetJoints().size()) ||
+      _msg.model_size() != static_cast<int>(models.size()) ||
+      msgs::ConvertIgn(_msg.scale()) != _model.Scale())
+  {
+    return false;
+  }
+
+  for (int i = 0; i < _msg.model_size(); ++i)
+  {
+    if (!matchesModel(*models[i], _msg.model(i)))
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Drop the cached scene messages of a model and of its nested
+/// models.
+/// \param[in,out] _cache Cached messages, by model id.
+/// \param[in] _model The model.
+static void forgetNested(std::unordered_map<uint32_t, msgs::Model> &_cache,
+    const Model &_model)
+{
+  _cache.erase(_model.GetId());
+  for (auto const &nested : _model.NestedModels())
+    forgetNested(_cache, *nested);
+}
+
+//////////////////////////////////////////////////
+/// \brief Drop the cached scene messages that contain a model: its own,
+/// those of its nested models and those of the models it is nested in.
+/// \param[in,out] _cache Cached messages, by model id.
+/// \param[in] _model The model.
+static void forgetModel(std::unordered_map<uint32_t, msgs::Model> &_cache,
+    const Model &_model)
+{
+  forgetNested(_cache, _model);
+  for (BasePtr parent = _model.GetParent(); parent;
+       parent = parent->GetParent())
+  {
+    if (parent->HasType(Base::MODEL))
+      _cache.erase(parent->GetId());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Add a model, its links, joints and nested models to the schema
+/// of the state stream.
+/// \param[in] _model The model.
+/// \param[out] _msg The schema.
+static void addStreamSchema(const Model &_model,
+    msgs::StateStreamSchema &_msg)
+{
+  auto entity = _msg.add_entity();
+  entity->set_id(_model.GetId());
+  entity->set_name(_model.GetScopedName());
+  entity->set_type(msgs::StateStreamSchema::Entity::MODEL);
+  BasePtr parent = _model.GetParent();
+  if (parent && parent->HasType(Base::MODEL))
+    entity->set_parent(parent->GetId());
+
+  for (auto const &link : _model.GetLinks())
+  {
+    entity = _msg.add_entity();
+    entity->set_id(link->GetId());
+    entity->set_name(link->GetScopedName());
+    entity->set_type(msgs::StateStreamSchema::Entity::LINK);
+    entity->set_parent(_model.GetId());
+  }
+
+  for (auto const &joint : _model.GetJoints())
+  {
+    auto jointMsg = _msg.add_joint();
+    jointMsg->set_id(joint->GetId());
+    jointMsg->set_name(joint->GetScopedName());
+    jointMsg->set_dof(joint->DOF());
+    jointMsg->set_parent(_model.GetId());
+  }
+
+  for (auto const &nested : _model.NestedModels())
+    addStreamSchema(*nested, _msg);
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the state of an entity to the state stream.
+/// \param[in] _entity The entity.
+/// \param[out] _msg The state stream message.
+static void addStreamEntity(const Entity &_entity, msgs::StateStream &_msg)
+{
+  _msg.add_id(_entity.GetId());
+
+  const ignition::math::Pose3d &pose = _entity.WorldPose();
+  _msg.add_pose(static_cast<float>(pose.Pos().X()));
+  _msg.add_pose(static_cast<float>(pose.Pos().Y()));
+  _msg.add_pose(static_cast<float>(pose.Pos().Z()));
+  _msg.add_pose(static_cast<float>(pose.Rot().W()));
+  _msg.add_pose(static_cast<float>(pose.Rot().X()));
+  _msg.add_pose(static_cast<float>(pose.Rot().Y()));
+  _msg.add_pose(static_cast<float>(pose.Rot().Z()));
+
+  const ignition::math::Vector3d linear = _entity.WorldLinearVel();
+  const ignition::math::Vector3d angular = _entity.WorldAngularVel();
+  _msg.add_velocity(static_cast<float>(linear.X()));
+  _msg.add_velocity(static_cast<float>(linear.Y()));
+  _msg.add_velocity(static_cast<float>(linear.Z()));
+  _msg.add_velocity(static_cast<float>(angular.X()));
+  _msg.add_velocity(static_cast<float>(angular.Y()));
+  _msg.add_velocity(static_cast<float>(angular.Z()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the state of a model, its links, joints and nested models
+/// to the state stream.
+/// \param[in] _model The model.
+/// \param[out] _msg The state stream message.
+static void addStreamModel(const Model &_model, msgs::StateStream &_msg)
+{
+  addStreamEntity(_model, _msg);
+  for (auto const &link : _model.GetLinks())
+    addStreamEntity(*link, _msg);
+
+  for (auto const &joint : _model.GetJoints())
+  {
+    _msg.add_joint_id(joint->GetId());
+    for (unsigned int i = 0; i < joint->DOF(); ++i)
+    {
+      _msg.add_joint_position(static_cast<float>(joint->Position(i)));
+      _msg.add_joint_velocity(static_cast<float>(joint->GetVelocity(i)));
+    }
+  }
+
+  for (auto const &nested : _model.NestedModels())
+    addStreamModel(*nested, _msg);
+}
+
+//////////////////////////////////////////////////
+/// \brief Publish the schema of the state stream if models were inserted
+/// or removed, and the state of the models that moved, or of every model
+/// after a new schema or subscriber.
+/// \param[in] _data Private data of the world.
+/// \param[in] _simTime Time of the state.
+static void publishStateStream(WorldPrivate &_data,
+    const common::Time &_simTime)
+{
+  const bool connected = _data.statePub && _data.statePub->HasConnections();
+  const unsigned int subscribers =
+      connected ? _data.statePub->GetRemoteSubscriptionCount() : 0;
+  bool full = connected && (!_data.stateConnected ||
+      subscribers > _data.stateSubscribers);
+  _data.stateConnected = connected;
+  _data.stateSubscribers = subscribers;
+
+  if (_data.stateSchemaDirty && ((_data.stateSchemaPub &&
+      _data.stateSchemaPub->HasConnections()) || connected))
+  {
+    _data.stateSchemaDirty = false;
+    msgs::StateStreamSchema schema;
+    schema.set_version(++_data.stateSchemaVersion);
+    for (auto const &model : _data.models)
+      addStreamSchema(*model, schema);
+    _data.stateSchemaPub->Publish(schema);
+    full = connected;
+  }
+
+  if (!connected)
+  {
+    _data.streamModels.clear();
+    _data.streamPrevious.clear();
+    return;
+  }
+
+  if (!full && !_data.stateThrottle.Due(_simTime))
+    return;
+
+  if (!full && _data.streamModels.empty() && _data.streamPrevious.empty())
+    return;
+
+  msgs::StateStream &msg = _data.stateMsg;
+  msg.Clear();
+  msgs::Set(msg.mutable_time(), _simTime);
+  msg.set_schema(_data.stateSchemaVersion);
+  if (full)
+  {
+    for (auto const &model : _data.models)
+      addStreamModel(*model, msg);
+  }
+  else
+  {
+    for (auto const &model : _data.streamModels)
+      addStreamModel(*model, msg);
+    for (auto const &model : _data.streamPrevious)
+    {
+      if (!_data.streamModels.count(model))
+        addStreamModel(*model, msg);
+    }
+  }
+  _data.statePub->Publish(msg);
+
+  _data.streamPrevious.swap(_data.streamModels);
+  _data.streamModels.clear();
+}
+
+//////////////////////////////////////////////////
+/// \brief Estimate the memory of a logged world state.
+/// \param[in] _state The state.
+/// \return Bytes of the state, and of its model, link and joint states.
+static int64_t stateBytes(const WorldState &_state)
+{
+  int64_t bytes = sizeof(WorldState) +
+      _state.LightStateCount() * sizeof(LightState);
+  for (auto const &model : _state.GetModelStates())
+  {
+    bytes += sizeof(ModelState) +
+        model.second.GetLinkStateCount() * sizeof(LinkState) +
+        model.second.GetJointStateCount() * sizeof(JointState);
+  }
+  return bytes;
+}
+
+//////////////////////////////////////////////////
+/// \brief Clear a buffer of logged world states, and its memory account.
+/// \param[in] _data Private data of the world.
+/// \param[in] _index Index of the buffer.
+static void clearStates(WorldPrivate &_data, const int _index)
+{
+  _data.stateMemory->Add(-_data.stateBytes[_index],
+      -static_cast<int64_t>(_data.states[_index].size()));
+  _data.stateBytes[_index] = 0;
+  _data.states[_index].clear();
+}
+
+//////////////////////////////////////////////////
+/// \brief Close the window of the step telemetry once per second, and
+/// publish it if someone listens.
+/// \param[in] _data Private data of the world.
+static void publishStepStats(WorldPrivate &_data)
+{
+  const int64_t nowNs = common::Time::SteadyNs();
+  if (nowNs - _data.prevStepStatsNs < common::Time::nsInSec)
+    return;
+  _data.prevStepStatsNs = nowNs;
+
+  _data.stepTelemetry.Fill(_data.stepStatsMsg);
+  if (_data.stepStatsPub && _data.stepStatsPub->HasConnections())
+    _data.stepStatsPub->Publish(_data.stepStatsMsg);
+}
+
 //////////////////////////////////////////////////
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   this->dataPtr->sdf.reset(new sdf::Element);
   sdf::initFile("world.sdf", this->dataPtr->sdf);
 
@@ -132,9 +629,13 @@ World::World(const std::string &_name)
   this->dataPtr->logThread = nullptr;
   this->dataPtr->stop = false;
   this->dataPtr->sensorsInitialized = false;
+  this->dataPtr->stateChecksumEnabled = false;
+  this->dataPtr->stateChecksum = 0;
 
   this->dataPtr->currentStateBuffer = 0;
   this->dataPtr->stateToggle = 0;
+  this->dataPtr->stateMemory =
+      &common::MemoryAccounts::Instance()->Account("physics/world_states");
 
   this->dataPtr->pluginsLoaded = false;
 
@@ -145,13 +646,14 @@ World::World(const std::string &_name)
   this->dataPtr->resetTimeOnly = false;
   this->dataPtr->resetModelOnly = false;
   this->dataPtr->enablePhysicsEngine = true;
+  this->dataPtr->batchStepping = false;
   this->dataPtr->enableWind = true;
   this->dataPtr->enableAtmosphere = true;
 
-  this->dataPtr->sleepOffset = common::Time(0);
+  this->dataPtr->sleepOffsetNs = 0;
 
-  this->dataPtr->prevStatTime = common::Time::GetWallTime();
-  this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
+  this->dataPtr->prevStatNs = common::Time::SteadyNs();
+  this->dataPtr->prevProcessMsgsNs = this->dataPtr->prevStatNs;
   this->dataPtr->logLastStatePlayedSimTime = common::Time(0);
   this->dataPtr->logLastStatePlayedRealTime = common::Time(0);
   this->dataPtr->logPlayRealTimeFactor = 0.0;
@@ -178,6 +680,8 @@ World::~World()
 //////////////////////////////////////////////////
 void World::Load(sdf::ElementPtr _sdf)
 {
+  common::StartupScope startupScope("World::Load",
+      _sdf->Get<std::string>("name"));
   this->dataPtr->loaded = false;
   this->dataPtr->sdf = _sdf;
   common::convertToFullPaths(this->dataPtr->sdf);
@@ -209,6 +713,17 @@ void World::Load(sdf::ElementPtr _sdf)
   else
     this->dataPtr->name = this->dataPtr->sdf->Get<std::string>("name");
 
+  // Thread settings of the world, which don't override those given on
+  // the command line. Load them before the physics engine, which sizes
+  // its pools from them.
+  if (this->dataPtr->sdf->HasElement("gz:threads"))
+  {
+    const std::string threads =
+      this->dataPtr->sdf->Get<std::string>("gz:threads");
+    if (!common::ThreadConfig::Instance()->Parse(threads, false))
+      gzerr << "Invalid <gz:threads>[" << threads << "]\n";
+  }
+
 #ifdef HAVE_OPENAL
   util::OpenAL::Instance()->Load(this->dataPtr->sdf->GetElement("audio"));
 #endif
@@ -218,7 +733,7 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->sceneMsg.set_name(this->Name());
 
   // The period at which messages are processed
-  this->dataPtr->processMsgsPeriod = common::Time(0, 200000000);
+  this->dataPtr->processMsgsPeriodNs = 200000000;
 
   this->dataPtr->node = transport::NodePtr(new transport::Node());
   this->dataPtr->node->Init(this->Name());
@@ -234,6 +749,13 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact state stream for external consumers, and its schema
+  this->dataPtr->statePub = this->dataPtr->node->Advertise<msgs::StateStream>(
+    "~/state/stream", 10);
+  this->dataPtr->stateSchemaPub =
+    this->dataPtr->node->Advertise<msgs::StateStreamSchema>(
+    "~/state/schema", 1);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -247,6 +769,8 @@ void World::Load(sdf::ElementPtr _sdf)
                                            &World::OnControl, this);
   this->dataPtr->playbackControlSub = this->dataPtr->node->Subscribe(
       "~/playback_control", &World::OnPlaybackControl, this);
+  this->dataPtr->profileSub = this->dataPtr->node->Subscribe("~/profile",
+      &World::OnProfileControl, this);
 
   this->dataPtr->requestSub = this->dataPtr->node->Subscribe("~/request",
                                            &World::OnRequest, this, true);
@@ -265,9 +789,13 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
+  this->dataPtr->requestPub = this->dataPtr->node->Advertise<msgs::Request>(
+      "~/request");
   this->dataPtr->statPub =
     this->dataPtr->node->Advertise<msgs::WorldStatistics>(
         "~/world_stats", 100, 5);
+  this->dataPtr->stepStatsPub =
+    this->dataPtr->node->Advertise<msgs::StepStatistics>("~/step_stats");
   this->dataPtr->modelPub = this->dataPtr->node->Advertise<msgs::Model>(
       "~/model/info");
   this->dataPtr->lightPub = this->dataPtr->node->Advertise<msgs::Light>(
@@ -307,6 +835,12 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->wind->Load(windElem);
 
+  this->dataPtr->forceFields.reset(new physics::ForceFields(*this));
+  this->dataPtr->regionTriggers.reset(new physics::RegionTriggers(*this));
+  this->dataPtr->sceneQueries.reset(new physics::SceneQueries(*this));
+  this->dataPtr->stepStates.reset(new physics::StepStatePublisher(*this));
+  this->dataPtr->sleepManager.reset(new physics::SleepManager(*this));
+
   // This should come after loading physics engine
   sdf::ElementPtr atmosphereElem = this->dataPtr->sdf->GetElement("atmosphere");
 
@@ -346,6 +880,9 @@ void World::Load(sdf::ElementPtr _sdf)
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
   {
+    // Decode the meshes up front, in parallel
+    this->PrefetchMeshes(this->dataPtr->sdf);
+
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
@@ -353,13 +890,9 @@ void World::Load(sdf::ElementPtr _sdf)
       this->ModelByIndex(i)->LoadJoints();
   }
 
-  // TODO: Performance test to see if TBB model updating is necessary
-  // Choose threaded or unthreaded model updating depending on the number of
-  // models in the scene
-  // if (this->ModelCount() < 20)
+  // Models are updated serially unless parallel updates were requested
+  // through the "model_update_threads" physics parameter.
   this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
-  // else
-  // this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
 
   event::Events::worldCreated(this->Name());
 
@@ -417,6 +950,7 @@ void World::Init()
 //////////////////////////////////////////////////
 void World::Init(UpdateScenePosesFunc _func)
 {
+  common::StartupScope startupScope("World::Init", this->Name());
   if (nullptr == this->dataPtr->rootElement)
   {
     gzerr << "Null root element. Not initializing." << std::endl;
@@ -424,8 +958,10 @@ void World::Init(UpdateScenePosesFunc _func)
   }
 
   // Initialize all the entities (i.e. Model)
+  this->dataPtr->physicsEngine->BeginModelBatch();
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
     this->dataPtr->rootElement->GetChild(i)->Init();
+  this->dataPtr->physicsEngine->EndModelBatch();
 
   // Initialize the physics engine
   this->dataPtr->physicsEngine->Init();
@@ -520,6 +1056,7 @@ bool World::Running() const
 void World::Stop()
 {
   this->dataPtr->stop = true;
+  this->dataPtr->stepCond.notify_all();
 
   // Make sure that the thread does not try to join with itself
   if (this->dataPtr->thread &&
@@ -536,15 +1073,17 @@ void World::Stop()
 //////////////////////////////////////////////////
 void World::RunLoop()
 {
+  common::ThreadConfig::Instance()->Apply("physics");
   this->dataPtr->physicsEngine->InitForThread();
 
   this->dataPtr->startTime = common::Time::GetWallTime();
+  this->dataPtr->startNs = common::Time::SteadyNs();
 
   // This fixes a minor issue when the world is paused before it's started
   if (this->IsPaused())
-    this->dataPtr->pauseStartTime = this->dataPtr->startTime;
+    this->dataPtr->pauseStartNs = this->dataPtr->startNs;
 
-  this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
+  this->dataPtr->prevStepNs = common::Time::SteadyNs();
 
   // Get the first state
   this->dataPtr->prevStates[0] = WorldState(shared_from_this());
@@ -580,7 +1119,7 @@ void World::RunLoop()
   {
     this->dataPtr->logCondition.notify_all();
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->logMutex);
+      std::lock_guard<WorldMutex> lock(this->dataPtr->logMutex);
       this->dataPtr->logCondition.notify_all();
     }
     this->dataPtr->logThread->join();
@@ -593,15 +1132,33 @@ void World::RunLoop()
 void World::LogStep()
 {
   {
-    std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lk(this->dataPtr->worldUpdateMutex);
 
     if (!this->IsPaused() || this->dataPtr->stepInc != 0)
     {
       if (!this->IsPaused() && this->dataPtr->stepInc == 0)
         this->dataPtr->stepInc = 1;
 
+      // When fast-forwarding and behind the playback clock, jump to the
+      // last state that is due instead of playing every state. States
+      // that insert or delete entities are still played.
+      bool skip = false;
+      common::Time dueSimTime;
+      if (!this->IsPaused() && this->dataPtr->logPlayRealTimeFactor > 1.0 &&
+          this->dataPtr->logLastStatePlayedRealTime != common::Time(0))
+      {
+        dueSimTime = this->dataPtr->logLastStatePlayedSimTime +
+            common::Time((common::Time::SteadyTime() -
+                  this->dataPtr->logLastStatePlayedRealTime).Double() *
+                this->dataPtr->logPlayRealTimeFactor);
+        skip = true;
+      }
+
       std::string data;
-      if (!util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data))
+      const bool stepped = skip ?
+          util::LogPlay::Instance()->StepUntil(dueSimTime, data) :
+          util::LogPlay::Instance()->Step(this->dataPtr->stepInc, data);
+      if (!stepped)
       {
         // There are no more chunks, time to exit.
         this->SetPaused(true);
@@ -631,7 +1188,7 @@ void World::LogStep()
           common::Time realTimeOfNextStep =
               this->dataPtr->logLastStatePlayedRealTime + timeUntilNextStep;
           common::Time realTimeSleep =
-              realTimeOfNextStep - common::Time::GetWallTime();
+              realTimeOfNextStep - common::Time::SteadyTime();
           if (realTimeSleep > common::Time(0))
           {
             common::Time::Sleep(realTimeSleep);
@@ -646,7 +1203,7 @@ void World::LogStep()
             this->dataPtr->iterations + 1);
         }
 
-        this->dataPtr->logLastStatePlayedRealTime = common::Time::GetWallTime();
+        this->dataPtr->logLastStatePlayedRealTime = common::Time::SteadyTime();
         this->dataPtr->logLastStatePlayedSimTime =
             this->dataPtr->logPlayState.GetSimTime();
         this->SetState(this->dataPtr->logPlayState);
@@ -658,7 +1215,8 @@ void World::LogStep()
     }
   }
 
-  this->PublishWorldStats();
+  if (this->dataPtr->statsThrottle.Due(this->SimTime()))
+    this->PublishWorldStats();
 
   this->ProcessMessages();
 }
@@ -675,6 +1233,12 @@ bool World::SensorsInitialized() const
   return this->dataPtr->sensorsInitialized;
 }
 
+//////////////////////////////////////////////////
+bool World::PluginsLoaded() const
+{
+  return this->dataPtr->pluginsLoaded;
+}
+
 /////////////////////////////////////////////////
 void World::SetSensorWaitFunc(std::function<void(double, double)> _func)
 {
@@ -686,8 +1250,12 @@ void World::Step()
 {
   DIAG_TIMER_START("World::Step");
 
-  IGN_PROFILE("World::Step");
-  IGN_PROFILE_BEGIN("loadPlugins");
+  GZ_PROFILE("World::Step");
+  StepTelemetry::StepSample sample;
+  sample.Reset();
+  bool updated = false;
+
+  GZ_PROFILE_BEGIN("loadPlugins");
   /// need this because ODE does not call dxReallocateWorldProcessContext()
   /// until dWorld.*Step
   /// Plugins that manipulate joints (and probably other properties) require
@@ -698,54 +1266,60 @@ void World::Step()
     this->dataPtr->pluginsLoaded = true;
   }
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "loadPlugins");
 
-  IGN_PROFILE_BEGIN("publishWorldStats");
+  GZ_PROFILE_BEGIN("publishWorldStats");
   // Send statistics about the world simulation
-  this->PublishWorldStats();
-  IGN_PROFILE_END();
+  if (this->dataPtr->statsThrottle.Due(this->SimTime()))
+    this->PublishWorldStats();
+  GZ_PROFILE_END();
 
   DIAG_TIMER_LAP("World::Step", "publishWorldStats");
 
-  IGN_PROFILE_BEGIN("sleepOffset");
+  GZ_PROFILE_BEGIN("sleepOffset");
   if (this->dataPtr->waitForSensors)
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::SENSOR_WAIT);
     this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
         this->dataPtr->physicsEngine->GetMaxStepSize());
+  }
 
-  double updatePeriod = this->dataPtr->physicsEngine->GetUpdatePeriod();
+  const int64_t updatePeriodNs = static_cast<int64_t>(std::round(
+      this->dataPtr->physicsEngine->GetUpdatePeriod() * 1e9));
   // sleep here to get the correct update rate
-  common::Time tmpTime = common::Time::GetWallTime();
-  common::Time sleepTime = this->dataPtr->prevStepWallTime +
-    common::Time(updatePeriod) - tmpTime - this->dataPtr->sleepOffset;
+  const int64_t tmpNs = common::Time::SteadyNs();
+  int64_t sleepNs = this->dataPtr->prevStepNs + updatePeriodNs - tmpNs -
+      this->dataPtr->sleepOffsetNs;
 
-  common::Time actualSleep;
-  if (sleepTime > 0)
+  int64_t actualSleepNs = 0;
+  if (sleepNs > 0)
   {
-    common::Time::Sleep(sleepTime);
-    actualSleep = common::Time::GetWallTime() - tmpTime;
+    common::Time::Sleep(common::Time::FromNs(sleepNs));
+    actualSleepNs = common::Time::SteadyNs() - tmpNs;
+    sample.sleep = actualSleepNs * 1e-9;
   }
   else
-    sleepTime = 0;
+    sleepNs = 0;
 
   // exponentially avg out
-  this->dataPtr->sleepOffset = (actualSleep - sleepTime) * 0.01 +
-                      this->dataPtr->sleepOffset * 0.99;
+  this->dataPtr->sleepOffsetNs = static_cast<int64_t>(
+      (actualSleepNs - sleepNs) * 0.01 + this->dataPtr->sleepOffsetNs * 0.99);
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Step", "sleepOffset");
 
-  IGN_PROFILE_BEGIN("worldUpdateMutex");
+  GZ_PROFILE_BEGIN("worldUpdateMutex");
   // throttling update rate, with sleepOffset as tolerance
   // the tolerance is needed as the sleep time is not exact
-  if (common::Time::GetWallTime() - this->dataPtr->prevStepWallTime +
-      this->dataPtr->sleepOffset >= common::Time(updatePeriod))
+  if (common::Time::SteadyNs() - this->dataPtr->prevStepNs +
+      this->dataPtr->sleepOffsetNs >= updatePeriodNs)
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
 
     DIAG_TIMER_LAP("World::Step", "worldUpdateMutex");
 
-    this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
+    this->dataPtr->prevStepNs = common::Time::SteadyNs();
 
     double stepTime = this->dataPtr->physicsEngine->GetMaxStepSize();
 
@@ -756,11 +1330,16 @@ void World::Step()
       this->dataPtr->simTime += stepTime;
       this->dataPtr->iterations++;
       this->Update();
+      sample.Merge(this->dataPtr->updateSample);
+      updated = true;
 
       DIAG_TIMER_LAP("World::Step", "update");
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
-        this->dataPtr->stepInc--;
+      {
+        if (--this->dataPtr->stepInc == 0)
+          this->dataPtr->stepCond.notify_all();
+      }
     }
     else
     {
@@ -770,19 +1349,29 @@ void World::Step()
       this->dataPtr->pauseTime += stepTime;
     }
   }
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 
-  IGN_PROFILE_BEGIN("Step");
+  GZ_PROFILE_BEGIN("Step");
 
   gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
 
-  this->ProcessMessages();
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::MESSAGES);
+    this->ProcessMessages();
+  }
 
   DIAG_TIMER_STOP("World::Step");
 
-  if (g_clearModels)
+  if (this->dataPtr->clearModels)
     this->ClearModels();
-  IGN_PROFILE_END();
+
+  if (updated)
+  {
+    this->dataPtr->stepTelemetry.Record(sample, this->dataPtr->iterations,
+        updatePeriod);
+  }
+  publishStepStats(*this->dataPtr);
+  GZ_PROFILE_END();
 }
 
 //////////////////////////////////////////////////
@@ -795,19 +1384,87 @@ void World::Step(const unsigned int _steps)
   }
 
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
     this->dataPtr->stepInc = _steps;
   }
 
-  // block on completion
-  bool wait = true;
-  while (wait)
+  // block on completion, the world thread wakes us up. Stop and the
+  // other writers of stepInc don't notify under the lock, so the wait
+  // checks again from time to time.
+  std::unique_lock<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+  while (this->dataPtr->stepInc != 0 && !this->dataPtr->stop)
+    this->dataPtr->stepCond.wait_for(lock, std::chrono::milliseconds(10));
+}
+
+//////////////////////////////////////////////////
+unsigned int World::StepBatch(const unsigned int _steps,
+    const unsigned int _flushPeriod)
+{
+  if (!this->IsPaused())
+  {
+    gzwarn << "Calling World::StepBatch while world is not paused\n";
+    this->SetPaused(true);
+  }
+
+  // The world thread blocks on this mutex until the batch is done.
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+
+  // The physics engine may keep per thread data, such as the ODE
+  // collision and step memory.
+  this->dataPtr->physicsEngine->InitForThread();
+
+  if (!this->dataPtr->pluginsLoaded && this->SensorsInitialized())
+  {
+    this->LoadPlugins();
+    this->dataPtr->pluginsLoaded = true;
+  }
+
+  auto flush = [this]()
+  {
+    this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
+    this->PublishWorldStats();
+    this->dataPtr->poseThrottle.Expire();
+    this->dataPtr->localPoseThrottle.Expire();
+    this->dataPtr->stateThrottle.Expire();
+    gazebo::util::IntrospectionManager::Instance()->NotifyUpdates();
+    this->ProcessMessages();
+    publishStepStats(*this->dataPtr);
+  };
+
+  unsigned int count = 0;
+  this->dataPtr->batchStepping = true;
+  StepTelemetry::StepSample sample;
+  while (count < _steps && !this->dataPtr->stop)
   {
-    common::Time::NSleep(1);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
-    if (this->dataPtr->stepInc == 0 || this->dataPtr->stop)
-      wait = false;
+    sample.Reset();
+    if (this->dataPtr->waitForSensors)
+    {
+      StepTelemetry::PhaseTimer timer(sample, StepTelemetry::SENSOR_WAIT);
+      this->dataPtr->waitForSensors(this->dataPtr->simTime.Double(),
+          this->dataPtr->physicsEngine->GetMaxStepSize());
+    }
+
+    this->dataPtr->simTime += this->dataPtr->physicsEngine->GetMaxStepSize();
+    this->dataPtr->iterations++;
+    this->Update();
+    ++count;
+
+    // A batch has no deadline, it runs as fast as it can.
+    sample.Merge(this->dataPtr->updateSample);
+    this->dataPtr->stepTelemetry.Record(sample, this->dataPtr->iterations, 0);
+
+    if (_flushPeriod > 0 && count % _flushPeriod == 0 && count < _steps)
+      flush();
   }
+  this->dataPtr->batchStepping = false;
+
+  this->dataPtr->prevStepNs = common::Time::SteadyNs();
+  flush();
+
+  if (this->dataPtr->clearModels)
+    this->ClearModels();
+
+  return count;
 }
 
 //////////////////////////////////////////////////
@@ -815,8 +1472,15 @@ void World::Update()
 {
   DIAG_TIMER_START("World::Update");
 
-  IGN_PROFILE("World::Update");
-  IGN_PROFILE_BEGIN("needsReset");
+  // Opens and closes the windows of the iteration profiler
+  common::IterationProfiler::Instance()->SetIteration(
+      this->dataPtr->iterations, this->dataPtr->simTime.Double());
+
+  GZ_PROFILE("World::Update");
+  StepTelemetry::StepSample &sample = this->dataPtr->updateSample;
+  sample.Reset();
+
+  GZ_PROFILE_BEGIN("needsReset");
   if (this->dataPtr->needsReset)
   {
     if (this->dataPtr->resetAll)
@@ -828,33 +1492,56 @@ void World::Update()
     this->dataPtr->needsReset = false;
     return;
   }
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "needsReset");
 
-  IGN_PROFILE_BEGIN("worldUpdateBegin");
+  GZ_PROFILE_BEGIN("worldUpdateBegin");
   this->dataPtr->updateInfo.simTime = this->SimTime();
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
-  IGN_PROFILE_END();
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::PLUGINS);
+    event::Events::worldUpdateBegin(this->dataPtr->updateInfo);
+  }
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::worldUpdateBegin");
 
-  IGN_PROFILE_BEGIN("Update");
+  GZ_PROFILE_BEGIN("RegionTriggers");
+  this->dataPtr->regionTriggers->Update(this->dataPtr->updateInfo.simTime);
+  GZ_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "RegionTriggers::Update");
+
+  GZ_PROFILE_BEGIN("LocalUpdate");
+  this->LocalUpdate();
+  GZ_PROFILE_END();
+  DIAG_TIMER_LAP("World::Update", "Model::LocalUpdate");
+
+  GZ_PROFILE_BEGIN("Update");
   // Update all the models
+  if (this->dataPtr->physicsEngine->ModelUpdateThreads() > 1)
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateTBB;
+  else
+    this->dataPtr->modelUpdateFunc = &World::ModelUpdateSingleLoop;
   (*this.*dataPtr->modelUpdateFunc)();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Model::Update");
 
-  IGN_PROFILE_BEGIN("UpdateCollision");
+  GZ_PROFILE_BEGIN("UpdateCollision");
   // This must be called before PhysicsEngine::UpdatePhysics for ODE.
-  this->dataPtr->physicsEngine->UpdateCollision();
-  IGN_PROFILE_END();
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::COLLISION);
+    this->dataPtr->physicsEngine->UpdateCollision();
+  }
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdateCollision");
 
-  IGN_PROFILE_BEGIN("beforePhysicsUpdate");
+  GZ_PROFILE_BEGIN("beforePhysicsUpdate");
   // Wait for logging to finish, if it's running.
   if (util::LogRecord::Instance()->Running())
   {
-    std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+    // Stamp the topic messages recorded from now on with this step
+    util::LogRecord::Instance()->SetSimTime(this->dataPtr->simTime);
+
+    std::unique_lock<WorldMutex> lock(this->dataPtr->logMutex);
 
     // It's possible the logWorker thread never processed the previous
     // state. This checks to make sure that we don't continute until the log
@@ -869,57 +1556,95 @@ void World::Update()
   // Give clients a possibility to react to collisions before the physics
   // gets updated.
   this->dataPtr->updateInfo.realTime = this->RealTime();
-  event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::PLUGINS);
+    event::Events::beforePhysicsUpdate(this->dataPtr->updateInfo);
+  }
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "Events::beforePhysicsUpdate");
 
   // Update the physics engine
   if (this->dataPtr->enablePhysicsEngine && this->dataPtr->physicsEngine)
   {
-    IGN_PROFILE_BEGIN("UpdatePhysics");
+    GZ_PROFILE_BEGIN("ForceFields");
+    this->dataPtr->forceFields->Update();
+    GZ_PROFILE_END();
+    DIAG_TIMER_LAP("World::Update", "ForceFields::Update");
+
+    GZ_PROFILE_BEGIN("UpdatePhysics");
     // This must be called directly after PhysicsEngine::UpdateCollision.
-    this->dataPtr->physicsEngine->UpdatePhysics();
+    {
+      StepTelemetry::PhaseTimer timer(sample, StepTelemetry::PHYSICS);
+      this->dataPtr->physicsEngine->UpdatePhysicsSteps();
+    }
 
-    IGN_PROFILE_END();
+    GZ_PROFILE_END();
     DIAG_TIMER_LAP("World::Update", "PhysicsEngine::UpdatePhysics");
 
     // do this after physics update as
     //   ode --> MoveCallback sets the dirtyPoses
     //           and we need to propagate it into Entity::worldPose
     {
-      IGN_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
+      GZ_PROFILE_BEGIN("SetWorldPose(dirtyPoses)");
       // block any other pose updates (e.g. Joint::SetPosition)
-      boost::recursive_mutex::scoped_lock plock(
-          *this->Physics()->GetPhysicsUpdateMutex());
+      common::ProfiledLock<boost::recursive_mutex> plock(
+          *this->Physics()->GetPhysicsUpdateMutex(),
+          this->dataPtr->physicsLockStats);
+
+      this->ApplyDirtyPoses();
+      GZ_PROFILE_END();
+
+      // Put the idle models to sleep before their state is read
+      GZ_PROFILE_BEGIN("SleepManager");
+      this->dataPtr->sleepManager->Update();
+      GZ_PROFILE_END();
+
+      // Read the joint states once for the plugins and the state log
+      GZ_PROFILE_BEGIN("CacheJointStates");
+      for (auto &model : this->dataPtr->models)
+        model->CacheJointStates();
+      GZ_PROFILE_END();
+
+      // Then hand the state of the step to the readers
+      this->dataPtr->stepStates->Publish();
 
-      for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+      if (this->dataPtr->stateChecksumEnabled)
       {
-        dirtyEntity->SetWorldPose(dirtyEntity->DirtyPose(), false);
+        const double iterations =
+            static_cast<double>(this->dataPtr->iterations);
+        this->dataPtr->stateChecksum = hashModels(
+            hashValues(14695981039346656037ull, &iterations, 1),
+            this->dataPtr->models);
+        gzlog << "State checksum " << this->dataPtr->iterations << " "
+              << std::hex << this->dataPtr->stateChecksum << std::dec
+              << std::endl;
       }
-
-      this->dataPtr->dirtyPoses.clear();
-      IGN_PROFILE_END();
     }
 
     DIAG_TIMER_LAP("World::Update", "SetWorldPose(dirtyPoses)");
   }
 
-  IGN_PROFILE_BEGIN("LogRecordNotify");
+  GZ_PROFILE_BEGIN("LogRecordNotify");
   // Only update state information if logging data.
   if (util::LogRecord::Instance()->Running())
     this->dataPtr->logCondition.notify_one();
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "LogRecordNotify");
 
-  IGN_PROFILE_BEGIN("PublishContacts");
-  // Output the contact information
-  this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
+  GZ_PROFILE_BEGIN("PublishContacts");
+  // Output the contact information. A batch publishes them when it
+  // flushes.
+  if (!this->dataPtr->batchStepping)
+    this->dataPtr->physicsEngine->GetContactManager()->PublishContacts();
 
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
   DIAG_TIMER_LAP("World::Update", "ContactManager::PublishContacts");
 
-  event::Events::worldUpdateEnd();
+  {
+    StepTelemetry::PhaseTimer timer(sample, StepTelemetry::PLUGINS);
+    event::Events::worldUpdateEnd();
+  }
 
   gazebo::util::IntrospectionManager::Instance()->Update();
 
@@ -936,10 +1661,22 @@ void World::Fini()
   util::OpenAL::Instance()->Fini();
 #endif
 
+  // Publish the queued responses
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->responseMutex);
+    this->dataPtr->stopResponses = true;
+  }
+  this->dataPtr->responseCondition.notify_all();
+  if (this->dataPtr->responseThread.joinable())
+    this->dataPtr->responseThread.join();
+  this->dataPtr->stopResponses = false;
+
   // Clean transport
   {
     this->dataPtr->deleteEntity.clear();
     this->dataPtr->requestMsgs.clear();
+    this->dataPtr->sceneRequests.clear();
+    this->dataPtr->sceneModels.clear();
     this->dataPtr->factoryMsgs.clear();
     this->dataPtr->modelMsgs.clear();
     this->dataPtr->lightFactoryMsgs.clear();
@@ -948,9 +1685,13 @@ void World::Fini()
 
     this->dataPtr->poseLocalPub.reset();
     this->dataPtr->posePub.reset();
+    this->dataPtr->statePub.reset();
+    this->dataPtr->stateSchemaPub.reset();
     this->dataPtr->guiPub.reset();
     this->dataPtr->responsePub.reset();
+    this->dataPtr->requestPub.reset();
     this->dataPtr->statPub.reset();
+    this->dataPtr->stepStatsPub.reset();
     this->dataPtr->modelPub.reset();
     this->dataPtr->lightPub.reset();
     this->dataPtr->lightFactoryPub.reset();
@@ -958,6 +1699,7 @@ void World::Fini()
     this->dataPtr->factorySub.reset();
     this->dataPtr->controlSub.reset();
     this->dataPtr->playbackControlSub.reset();
+    this->dataPtr->profileSub.reset();
     this->dataPtr->requestSub.reset();
     this->dataPtr->jointSub.reset();
     this->dataPtr->lightSub.reset();
@@ -980,6 +1722,10 @@ void World::Fini()
   this->dataPtr->publishModelPoses.clear();
   this->dataPtr->publishModelScales.clear();
   this->dataPtr->publishLightPoses.clear();
+  this->dataPtr->streamModels.clear();
+  this->dataPtr->streamPrevious.clear();
+  this->dataPtr->localModelPoses.clear();
+  this->dataPtr->localLightPoses.clear();
 
   // Clean entities
   for (auto &model : this->dataPtr->models)
@@ -989,6 +1735,14 @@ void World::Fini()
   }
   this->dataPtr->models.clear();
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+    this->dataPtr->modelIndexDirty = true;
+    this->dataPtr->indexedModels.clear();
+    this->dataPtr->movedModels.clear();
+  }
+  this->_LinksChanged();
+
   for (auto &road : this->dataPtr->roads)
   {
     if (road)
@@ -1008,12 +1762,19 @@ void World::Fini()
     this->dataPtr->rootElement->Fini();
     this->dataPtr->rootElement.reset();
   }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    this->dataPtr->entityIds.clear();
+    this->dataPtr->entityNames.clear();
+    this->dataPtr->entityScopedNames.clear();
+  }
   this->dataPtr->prevStates[0].SetWorld(WorldPtr());
   this->dataPtr->prevStates[1].SetWorld(WorldPtr());
-  this->dataPtr->prevUnfilteredState.SetWorld(WorldPtr());
+  this->dataPtr->logModelNames.clear();
+  this->dataPtr->logLightNames.clear();
   this->dataPtr->logPlayState.SetWorld(WorldPtr());
-  this->dataPtr->states[0].clear();
-  this->dataPtr->states[1].clear();
+  clearStates(*this->dataPtr, 0);
+  clearStates(*this->dataPtr, 1);
 
   this->dataPtr->presetManager.reset();
   this->dataPtr->userCmdManager.reset();
@@ -1021,6 +1782,18 @@ void World::Fini()
   this->dataPtr->atmosphere.reset();
   this->dataPtr->wind.reset();
 
+  // Plugins may remove their fields after the world is finalized
+  if (this->dataPtr->forceFields)
+    this->dataPtr->forceFields->Clear();
+  if (this->dataPtr->regionTriggers)
+    this->dataPtr->regionTriggers->Clear();
+  if (this->dataPtr->sceneQueries)
+    this->dataPtr->sceneQueries->Clear();
+  if (this->dataPtr->stepStates)
+    this->dataPtr->stepStates->Clear();
+  if (this->dataPtr->sleepManager)
+    this->dataPtr->sleepManager->Clear();
+
   // Engine shouldn't outlive world
   if (this->dataPtr->physicsEngine)
     this->dataPtr->physicsEngine->Fini();
@@ -1044,21 +1817,21 @@ void World::Fini()
 //////////////////////////////////////////////////
 void World::Clear()
 {
-  g_clearModels = true;
+  this->dataPtr->clearModels = true;
   /// \todo Clear lights too?
 }
 
 //////////////////////////////////////////////////
 void World::ClearModels()
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   bool pauseState = this->IsPaused();
   this->SetPaused(true);
 
-  while (!this->dataPtr->models.empty())
-  {
-    this->RemoveModel(this->dataPtr->models[0]);
-  }
+  std::vector<std::string> names;
+  for (auto const &model : this->dataPtr->models)
+    names.push_back(model->GetScopedName());
+  this->RemoveModels(names);
   this->dataPtr->models.clear();
 
   for (auto &road : this->dataPtr->roads)
@@ -1090,31 +1863,76 @@ Wind &World::Wind() const
 }
 
 //////////////////////////////////////////////////
-Atmosphere &World::Atmosphere() const
+ForceFields &World::ForceFields() const
 {
-  return *this->dataPtr->atmosphere;
+  return *this->dataPtr->forceFields;
 }
 
 //////////////////////////////////////////////////
-PresetManagerPtr World::PresetMgr() const
+RegionTriggers &World::RegionTriggers() const
 {
-  return this->dataPtr->presetManager;
+  return *this->dataPtr->regionTriggers;
 }
 
 //////////////////////////////////////////////////
-common::SphericalCoordinatesPtr World::SphericalCoords() const
+SceneQueries &World::SceneQueries() const
 {
-  return this->dataPtr->sphericalCoordinates;
+  return *this->dataPtr->sceneQueries;
 }
 
 //////////////////////////////////////////////////
-ignition::math::Vector3d World::Gravity() const
+StepStatePublisher &World::StepStates() const
 {
-  return this->dataPtr->sdf->Get<ignition::math::Vector3d>("gravity");
+  return *this->dataPtr->stepStates;
 }
 
 //////////////////////////////////////////////////
-void World::SetGravity(const ignition::math::Vector3d &_gravity)
+SleepManager &World::SleepManager() const
+{
+  return *this->dataPtr->sleepManager;
+}
+
+//////////////////////////////////////////////////
+void World::SetStateChecksum(const bool _enable)
+{
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+  this->dataPtr->stateChecksumEnabled = _enable;
+  this->dataPtr->stateChecksum = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t World::StateChecksum() const
+{
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+  return this->dataPtr->stateChecksum;
+}
+
+//////////////////////////////////////////////////
+Atmosphere &World::Atmosphere() const
+{
+  return *this->dataPtr->atmosphere;
+}
+
+//////////////////////////////////////////////////
+PresetManagerPtr World::PresetMgr() const
+{
+  return this->dataPtr->presetManager;
+}
+
+//////////////////////////////////////////////////
+common::SphericalCoordinatesPtr World::SphericalCoords() const
+{
+  return this->dataPtr->sphericalCoordinates;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector3d World::Gravity() const
+{
+  return this->dataPtr->sdf->Get<ignition::math::Vector3d>("gravity");
+}
+
+//////////////////////////////////////////////////
+void World::SetGravity(const ignition::math::Vector3d &_gravity)
 {
   // This function calls `PhysicsEngine::SetGravity`,
   // which in turn should call `World::SetGravitySDF`.
@@ -1142,17 +1960,114 @@ void World::SetMagneticField(const ignition::math::Vector3d &_mag)
 //////////////////////////////////////////////////
 BasePtr World::BaseByName(const std::string &_name) const
 {
-  if (this->dataPtr->rootElement)
-    return this->dataPtr->rootElement->GetByName(_name);
-  else
+  if (!this->dataPtr->rootElement)
     return BasePtr();
+
+  if (this->dataPtr->rootElement->GetName() == _name)
+    return this->dataPtr->rootElement;
+
+  return this->IndexedEntityByName(_name,
+      this->dataPtr->rootElement.get());
+}
+
+//////////////////////////////////////////////////
+BasePtr World::BaseById(const uint32_t _id) const
+{
+  BasePtr entity;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    auto indexed = this->dataPtr->entityIds.find(_id);
+    if (indexed != this->dataPtr->entityIds.end())
+      entity = indexed->second.entity.lock();
+  }
+  return entity;
+}
+
+//////////////////////////////////////////////////
+BasePtr World::IndexedEntityByName(const std::string &_name,
+    const Base *_ancestor) const
+{
+  // The entities are released after the index is unlocked
+  Base_V scoped;
+  Base_V named;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+    collectIndexed(*this->dataPtr, this->dataPtr->entityScopedNames, _name,
+        scoped);
+    collectIndexed(*this->dataPtr, this->dataPtr->entityNames, _name, named);
+  }
+
+  for (auto const *matches : {&scoped, &named})
+  {
+    // The ids grow, so that the lowest id is the first loaded
+    BasePtr result;
+    for (auto const &entity : *matches)
+    {
+      if (result && result->GetId() < entity->GetId())
+        continue;
+
+      BasePtr parent = entity;
+      while (_ancestor && parent && parent.get() != _ancestor)
+        parent = parent->GetParent();
+
+      if (parent)
+        result = entity;
+    }
+
+    if (result)
+      return result;
+  }
+
+  return BasePtr();
+}
+
+//////////////////////////////////////////////////
+void World::AddToEntityIndex(const BasePtr &_entity)
+{
+  GZ_ASSERT(_entity != nullptr, "_entity is nullptr");
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  const uint32_t id = _entity->GetId();
+  IndexedEntity &indexed = this->dataPtr->entityIds[id];
+  if (!indexed.entity.expired())
+  {
+    eraseIndexedName(this->dataPtr->entityNames, indexed.name, id);
+    eraseIndexedName(this->dataPtr->entityScopedNames, indexed.scopedName,
+        id);
+  }
+
+  indexed.entity = _entity;
+  indexed.name = _entity->GetName();
+  indexed.scopedName = _entity->GetScopedName();
+  this->dataPtr->entityNames.emplace(indexed.name, id);
+  this->dataPtr->entityScopedNames.emplace(indexed.scopedName, id);
+}
+
+//////////////////////////////////////////////////
+void World::RemoveFromEntityIndex(const uint32_t _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  auto indexed = this->dataPtr->entityIds.find(_id);
+  if (indexed == this->dataPtr->entityIds.end())
+    return;
+
+  eraseIndexedName(this->dataPtr->entityNames, indexed->second.name, _id);
+  eraseIndexedName(this->dataPtr->entityScopedNames,
+      indexed->second.scopedName, _id);
+  this->dataPtr->entityIds.erase(indexed);
+}
+
+//////////////////////////////////////////////////
+bool World::InEntityIndex(const uint32_t _id) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->entityIndexMutex);
+  return this->dataPtr->entityIds.count(_id) > 0;
 }
 
 /////////////////////////////////////////////////
 ModelPtr World::ModelById(unsigned int _id) const
 {
-  return boost::dynamic_pointer_cast<Model>(
-      this->dataPtr->rootElement->GetById(_id));
+  return boost::dynamic_pointer_cast<Model>(this->BaseById(_id));
 }
 
 //////////////////////////////////////////////////
@@ -1214,6 +2129,18 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
 
   this->PublishModelPose(model);
   this->dataPtr->models.push_back(model);
+  this->dataPtr->stateSchemaDirty = true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+    this->dataPtr->modelIndexDirty = true;
+  }
+  this->dataPtr->forceFields->Refresh();
+  this->dataPtr->regionTriggers->Refresh();
+  this->dataPtr->sceneQueries->Refresh();
+  this->dataPtr->stepStates->Refresh();
+  this->dataPtr->sleepManager->Refresh();
+  this->_LinksChanged();
   return model;
 }
 
@@ -1269,6 +2196,18 @@ ActorPtr World::LoadActor(sdf::ElementPtr _sdf , BasePtr _parent)
   this->EnableAllModels();
   this->PublishModelPose(actor);
   this->dataPtr->models.push_back(actor);
+  this->dataPtr->stateSchemaDirty = true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+    this->dataPtr->modelIndexDirty = true;
+  }
+  this->dataPtr->forceFields->Refresh();
+  this->dataPtr->regionTriggers->Refresh();
+  this->dataPtr->sceneQueries->Refresh();
+  this->dataPtr->stepStates->Refresh();
+  this->dataPtr->sleepManager->Refresh();
+  this->_LinksChanged();
 
   return actor;
 }
@@ -1285,6 +2224,7 @@ RoadPtr World::LoadRoad(sdf::ElementPtr _sdf , BasePtr _parent)
 //////////////////////////////////////////////////
 void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
 {
+  common::StartupScope startupScope("World::LoadEntities");
   if (_sdf->HasElement("light"))
   {
     sdf::ElementPtr childElem = _sdf->GetElement("light");
@@ -1334,6 +2274,70 @@ void World::LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent)
   }
 }
 
+//////////////////////////////////////////////////
+void World::PrefetchMeshes(sdf::ElementPtr _sdf)
+{
+  GZ_PROFILE("World::PrefetchMeshes");
+
+  // Collect the mesh files of all the collisions, resolved the same way
+  // as in MeshShape::Init.
+  std::set<std::string> filenames;
+  std::vector<sdf::ElementPtr> elems;
+  elems.push_back(_sdf);
+  while (!elems.empty())
+  {
+    sdf::ElementPtr elem = elems.back();
+    elems.pop_back();
+
+    if (elem->GetName() == "mesh" && elem->HasElement("uri") &&
+        elem->GetParent() && elem->GetParent()->GetName() == "geometry" &&
+        elem->GetParent()->GetParent() &&
+        elem->GetParent()->GetParent()->GetName() == "collision")
+    {
+      auto uri = common::asFullPath(elem->Get<std::string>("uri"),
+          elem->FilePath());
+      std::string filename = common::find_file(uri);
+      if (!filename.empty() && filename != "__default__" &&
+          common::MeshManager::Instance()->IsValidFilename(filename))
+      {
+        filenames.insert(filename);
+      }
+      continue;
+    }
+
+    // Lights, roads and plugins can't hold collisions.
+    for (sdf::ElementPtr child = elem->GetFirstElement(); child;
+         child = child->GetNextElement())
+    {
+      if (child->GetName() != "light" && child->GetName() != "plugin" &&
+          child->GetName() != "road")
+      {
+        elems.push_back(child);
+      }
+    }
+  }
+
+  if (filenames.size() < 2)
+    return;
+
+  const std::vector<std::string> files(filenames.begin(), filenames.end());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, files.size(), 1),
+      [&files](const tbb::blocked_range<size_t> &_r)
+  {
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+    {
+      try
+      {
+        common::MeshManager::Instance()->Load(files[i]);
+      }
+      catch(common::Exception &)
+      {
+        // Reported again when the collision is loaded.
+      }
+    }
+  });
+}
+
 //////////////////////////////////////////////////
 unsigned int World::ModelCount() const
 {
@@ -1365,6 +2369,33 @@ Model_V World::Models() const
   return this->dataPtr->models;
 }
 
+//////////////////////////////////////////////////
+const Model_V &World::ModelsRef() const
+{
+  return this->dataPtr->models;
+}
+
+//////////////////////////////////////////////////
+const Link_V &World::AllLinks() const
+{
+  if (this->dataPtr->allLinksValid.load(std::memory_order_acquire))
+    return this->dataPtr->allLinks;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->allLinksMutex);
+  if (!this->dataPtr->allLinksValid.load(std::memory_order_relaxed))
+  {
+    this->dataPtr->allLinks.clear();
+    for (auto const &model : this->dataPtr->models)
+    {
+      const Link_V &links = model->AllLinks();
+      this->dataPtr->allLinks.insert(this->dataPtr->allLinks.end(),
+          links.begin(), links.end());
+    }
+    this->dataPtr->allLinksValid.store(true, std::memory_order_release);
+  }
+  return this->dataPtr->allLinks;
+}
+
 //////////////////////////////////////////////////
 Light_V World::Lights() const
 {
@@ -1377,11 +2408,12 @@ void World::ResetTime()
   this->dataPtr->simTime = common::Time(0);
   this->dataPtr->pauseTime = common::Time(0);
   this->dataPtr->startTime = common::Time::GetWallTime();
-  this->dataPtr->realTimeOffset = common::Time(0);
+  this->dataPtr->startNs = common::Time::SteadyNs();
+  this->dataPtr->realTimeOffsetNs = 0;
   this->dataPtr->iterations = 0;
 
   if (this->IsPaused())
-    this->dataPtr->pauseStartTime = this->dataPtr->startTime;
+    this->dataPtr->pauseStartNs = this->dataPtr->startNs;
 
   // Signal a reset has occurred. The SensorManager listens to this event
   // to reset each sensor's last update time.
@@ -1401,7 +2433,7 @@ void World::Reset()
   this->SetPaused(true);
 
   {
-    std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lk(this->dataPtr->worldUpdateMutex);
 
     ignition::math::Rand::Seed(ignition::math::Rand::Seed());
     this->dataPtr->physicsEngine->SetSeed(ignition::math::Rand::Seed());
@@ -1464,16 +2496,12 @@ common::Time World::RealTime() const
 {
   if (!util::LogPlay::Instance()->IsOpen())
   {
-    if (this->dataPtr->pause)
-    {
-      return (this->dataPtr->pauseStartTime - this->dataPtr->startTime) -
-        this->dataPtr->realTimeOffset;
-    }
-    else
-    {
-      return (common::Time::GetWallTime() - this->dataPtr->startTime) -
-        this->dataPtr->realTimeOffset;
-    }
+    // Counted on the steady clock, so that a change of the system clock
+    // doesn't change it
+    const int64_t endNs = this->dataPtr->pause ?
+        this->dataPtr->pauseStartNs : common::Time::SteadyNs();
+    return common::Time::FromNs(endNs - this->dataPtr->startNs -
+        this->dataPtr->realTimeOffsetNs);
   }
   else
     return this->dataPtr->logRealTime;
@@ -1492,21 +2520,24 @@ void World::SetPaused(const bool _p)
     return;
 
   {
-    std::lock_guard<std::recursive_mutex> lk(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lk(this->dataPtr->worldUpdateMutex);
     this->dataPtr->pause = _p;
   }
 
+  // Let clients know right away
+  this->dataPtr->statsThrottle.Expire();
+
   if (_p)
   {
     // This is also a good time to clear out the logging buffer.
     util::LogRecord::Instance()->Notify();
 
-    this->dataPtr->pauseStartTime = common::Time::GetWallTime();
+    this->dataPtr->pauseStartNs = common::Time::SteadyNs();
   }
   else
   {
-    this->dataPtr->realTimeOffset += common::Time::GetWallTime() -
-      this->dataPtr->pauseStartTime;
+    this->dataPtr->realTimeOffsetNs += common::Time::SteadyNs() -
+      this->dataPtr->pauseStartNs;
   }
 
   event::Events::pause(_p);
@@ -1515,10 +2546,27 @@ void World::SetPaused(const bool _p)
 //////////////////////////////////////////////////
 void World::OnFactoryMsg(ConstFactoryPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->factoryMsgs.push_back(*_msg);
 }
 
+//////////////////////////////////////////////////
+void World::OnProfileControl(ConstProfileControlPtr &_msg)
+{
+  const std::string filename = _msg->has_filename() ? _msg->filename() : "";
+  if (common::IterationProfiler::Instance()->Start(_msg->iterations(),
+      filename))
+  {
+    gzmsg << "Profiling " << _msg->iterations() << " iterations of world ["
+          << this->Name() << "]\n";
+  }
+  else
+  {
+    gzwarn << "Unable to start the iteration profiler, a window is already "
+           << "running\n";
+  }
+}
+
 //////////////////////////////////////////////////
 void World::OnControl(ConstWorldControlPtr &_data)
 {
@@ -1533,7 +2581,7 @@ void World::OnControl(ConstWorldControlPtr &_data)
     // stepWorld is a blocking call so set stepInc directly so that world stats
     // will still be published
     this->SetPaused(true);
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
     this->dataPtr->stepInc = _data->multi_step();
   }
 
@@ -1567,36 +2615,40 @@ void World::OnControl(ConstWorldControlPtr &_data)
 //////////////////////////////////////////////////
 void World::OnPlaybackControl(ConstLogPlaybackControlPtr &_data)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->playbackControlMsgs.push_back(*_data);
 }
 
 //////////////////////////////////////////////////
 void World::ProcessPlaybackControlMsgs()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->worldUpdateMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
 
-  for (auto const &msg : this->dataPtr->playbackControlMsgs)
+  auto &controls = this->dataPtr->playbackControlMsgs;
+  for (auto msg = controls.begin(); msg != controls.end(); ++msg)
   {
-    if (msg.has_pause())
-      this->SetPaused(msg.pause());
+    if (msg->has_pause())
+      this->SetPaused(msg->pause());
 
-    if (msg.has_multi_step())
+    if (msg->has_multi_step())
     {
       // stepWorld is a blocking call so set stepInc directly so that
       // world stats will still be published
       this->SetPaused(true);
-      this->dataPtr->stepInc += msg.multi_step();
+      this->dataPtr->stepInc += msg->multi_step();
     }
 
-    if (msg.has_seek())
+    // Seeks sent while scrubbing the timeline pile up, and each one
+    // would decode a chunk. Only the last of consecutive seeks is done.
+    auto next = std::next(msg);
+    if (msg->has_seek() && (next == controls.end() || !next->has_seek()))
     {
-      common::Time targetSimTime = msgs::Convert(msg.seek());
+      common::Time targetSimTime = msgs::Convert(msg->seek());
       util::LogPlay::Instance()->Seek(targetSimTime);
       this->dataPtr->stepInc = 1;
     }
 
-    if (msg.has_rewind() && msg.rewind())
+    if (msg->has_rewind() && msg->rewind())
     {
       util::LogPlay::Instance()->Rewind();
       this->dataPtr->stepInc = 1;
@@ -1604,7 +2656,7 @@ void World::ProcessPlaybackControlMsgs()
         this->dataPtr->iterations = 0;
     }
 
-    if (msg.has_forward() && msg.forward())
+    if (msg->has_forward() && msg->forward())
     {
       util::LogPlay::Instance()->Forward();
       this->dataPtr->stepInc = -1;
@@ -1612,9 +2664,9 @@ void World::ProcessPlaybackControlMsgs()
       // ToDo: Update iterations if the log doesn't have it.
     }
 
-    if (msg.has_rt_factor())
+    if (msg->has_rt_factor())
     {
-      this->dataPtr->logPlayRealTimeFactor = msg.rt_factor();
+      this->dataPtr->logPlayRealTimeFactor = msg->rt_factor();
     }
   }
 
@@ -1624,14 +2676,14 @@ void World::ProcessPlaybackControlMsgs()
 //////////////////////////////////////////////////
 void World::OnRequest(ConstRequestPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->requestMsgs.push_back(*_msg);
 }
 
 //////////////////////////////////////////////////
 void World::JointLog(ConstJointPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   int i = 0;
   for (; i < this->dataPtr->sceneMsg.joint_size(); i++)
   {
@@ -1652,7 +2704,7 @@ void World::JointLog(ConstJointPtr &_msg)
 //////////////////////////////////////////////////
 void World::OnModelMsg(ConstModelPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->modelMsgs.push_back(*_msg);
 }
 
@@ -1682,12 +2734,42 @@ void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 
 
 //////////////////////////////////////////////////
-// void World::ModelUpdateTBB()
-// {
-//   tbb::parallel_for (tbb::blocked_range<size_t>(0,
-//   this->dataPtr->models.size(), 10),
-//       ModelUpdate_TBB(&this->dataPtr->models));
-// }
+void World::ModelUpdateTBB()
+{
+  modelUpdateArena(*this->dataPtr, *this->dataPtr->physicsEngine);
+
+  // Split the top level entities into models that only touch their own
+  // links and joints, and everything else. The split is redone every
+  // iteration since joint animations and cross model joints come and go.
+  this->dataPtr->parallelUpdateModels.clear();
+  this->dataPtr->serialUpdateEntities.clear();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (child->HasType(Base::MODEL) &&
+        boost::static_pointer_cast<Model>(child)->ParallelUpdateSafe())
+    {
+      this->dataPtr->parallelUpdateModels.push_back(
+          boost::static_pointer_cast<Model>(child));
+    }
+    else
+      this->dataPtr->serialUpdateEntities.push_back(child);
+  }
+
+  // Model::Update only calls into the physics engine for joints and links
+  // owned by the model itself, so the models can run concurrently.
+  const Model_V &models = this->dataPtr->parallelUpdateModels;
+  this->dataPtr->modelUpdateArena->execute([&models]()
+  {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, models.size(), 10),
+        ModelUpdate_TBB(&models));
+  });
+
+  // Everything else runs on the physics thread, in the same order as
+  // ModelUpdateSingleLoop.
+  for (auto &entity : this->dataPtr->serialUpdateEntities)
+    entity->Update();
+}
 
 //////////////////////////////////////////////////
 void World::ModelUpdateSingleLoop()
@@ -1698,9 +2780,56 @@ void World::ModelUpdateSingleLoop()
 }
 
 
+//////////////////////////////////////////////////
+void World::LocalUpdate()
+{
+  // Models with cross model joints run their callbacks serially, like
+  // their Model::Update.
+  const int threads = this->dataPtr->physicsEngine->ModelUpdateThreads();
+  this->dataPtr->parallelLocalModels.clear();
+  this->dataPtr->serialLocalModels.clear();
+  for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
+  {
+    BasePtr child = this->dataPtr->rootElement->GetChild(i);
+    if (!child->HasType(Base::MODEL))
+      continue;
+
+    ModelPtr model = boost::static_pointer_cast<Model>(child);
+    if (!model->HasLocalUpdate())
+      continue;
+
+    if (threads > 1 && model->ParallelUpdateSafe())
+      this->dataPtr->parallelLocalModels.push_back(model);
+    else
+      this->dataPtr->serialLocalModels.push_back(model);
+  }
+
+  const common::UpdateInfo &info = this->dataPtr->updateInfo;
+  const Model_V &models = this->dataPtr->parallelLocalModels;
+  if (!models.empty())
+  {
+    // Plugin callbacks are usually heavier than Model::Update, so each
+    // model is a task.
+    modelUpdateArena(*this->dataPtr, *this->dataPtr->physicsEngine).execute(
+        [&models, &info]()
+        {
+          tbb::parallel_for(tbb::blocked_range<size_t>(0, models.size(), 1),
+              [&models, &info](const tbb::blocked_range<size_t> &_r)
+              {
+                for (size_t i = _r.begin(); i != _r.end(); ++i)
+                  models[i]->LocalUpdate(info);
+              });
+        });
+  }
+
+  for (auto &model : this->dataPtr->serialLocalModels)
+    model->LocalUpdate(info);
+}
+
 //////////////////////////////////////////////////
 void World::LoadPlugins()
 {
+  common::StartupScope startupScope("World::LoadPlugins", this->Name());
   // Load the plugins
   if (this->dataPtr->sdf->HasElement("plugin"))
   {
@@ -1713,15 +2842,28 @@ void World::LoadPlugins()
   }
 
   // Load the plugins for all the models
+  Model_V models;
   for (unsigned int i = 0; i < this->dataPtr->rootElement->GetChildCount(); ++i)
   {
     if (this->dataPtr->rootElement->GetChild(i)->HasType(Base::MODEL))
     {
-      ModelPtr model = boost::static_pointer_cast<Model>(
-          this->dataPtr->rootElement->GetChild(i));
-      model->LoadPlugins();
+      models.push_back(boost::static_pointer_cast<Model>(
+          this->dataPtr->rootElement->GetChild(i)));
     }
   }
+
+  // Plugins load serially unless parallel loads were requested through
+  // the "plugin_load_threads" physics parameter.
+  const int threads = this->dataPtr->physicsEngine->PluginLoadThreads();
+  if (threads > 1)
+  {
+    Model::LoadPlugins(models, threads);
+  }
+  else
+  {
+    for (auto const &model : models)
+      model->LoadPlugins();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -1729,6 +2871,8 @@ void World::LoadPlugin(const std::string &_filename,
                        const std::string &_name,
                        sdf::ElementPtr _sdf)
 {
+  common::StartupScope startupScope("World::LoadPlugin", _filename);
+  common::PluginCostScope costScope(this->Name() + "::" + _name, _filename);
   gazebo::WorldPluginPtr plugin = gazebo::WorldPlugin::Create(_filename,
                                                               _name);
 
@@ -1774,15 +2918,14 @@ void World::LoadPlugin(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void World::ProcessEntityMsgs()
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->entityDeleteMutex);
-
-  for (auto &entityName : this->dataPtr->deleteEntity)
-  {
-    this->RemoveModel(entityName);
-  }
+  std::lock_guard<WorldMutex> lock(this->dataPtr->entityDeleteMutex);
 
   if (!this->dataPtr->deleteEntity.empty())
   {
+    this->RemoveModels(std::vector<std::string>(
+        this->dataPtr->deleteEntity.begin(),
+        this->dataPtr->deleteEntity.end()));
+
     this->EnableAllModels();
     this->dataPtr->deleteEntity.clear();
   }
@@ -1791,7 +2934,7 @@ void World::ProcessEntityMsgs()
 //////////////////////////////////////////////////
 void World::ProcessRequestMsgs()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   msgs::Response response;
 
   for (auto const &requestMsg : this->dataPtr->requestMsgs)
@@ -1803,33 +2946,37 @@ void World::ProcessRequestMsgs()
 
     if (requestMsg.request() == "entity_list")
     {
-      msgs::Model_V modelVMsg;
-
+      // The models are filled over the next steps
+      WorldSceneRequest sceneRequest;
+      sceneRequest.responses.push_back(response);
+      sceneRequest.scene = false;
       for (unsigned int i = 0;
           i < this->dataPtr->rootElement->GetChildCount(); ++i)
       {
         BasePtr entity = this->dataPtr->rootElement->GetChild(i);
         if (entity->HasType(Base::MODEL))
         {
-          msgs::Model *modelMsg = modelVMsg.add_models();
-          ModelPtr model = boost::dynamic_pointer_cast<Model>(entity);
-          model->FillMsg(*modelMsg);
+          sceneRequest.models.push_back(
+              boost::static_pointer_cast<Model>(entity));
         }
       }
-
-      response.set_type(modelVMsg.GetTypeName());
-      std::string *serializedData = response.mutable_serialized_data();
-      modelVMsg.SerializeToString(serializedData);
+      this->dataPtr->sceneRequests.push_back(std::move(sceneRequest));
+      send = false;
     }
     else if (requestMsg.request() == "entity_delete")
     {
-      std::lock_guard<std::mutex> lock2(this->dataPtr->entityDeleteMutex);
+      std::lock_guard<WorldMutex> lock2(this->dataPtr->entityDeleteMutex);
       this->dataPtr->deleteEntity.push_back(requestMsg.data());
     }
+    else if (requestMsg.request() == "entities_delete")
+    {
+      std::lock_guard<WorldMutex> lock2(this->dataPtr->entityDeleteMutex);
+      for (auto const &name : msgs::DeletedEntities(requestMsg))
+        this->dataPtr->deleteEntity.push_back(name);
+    }
     else if (requestMsg.request() == "entity_info")
     {
-      BasePtr entity(
-        this->dataPtr->rootElement->GetByName(requestMsg.data()));
+      BasePtr entity(this->BaseByName(requestMsg.data()));
       if (entity)
       {
         if (entity->HasType(Base::MODEL))
@@ -1884,7 +3031,8 @@ void World::ProcessRequestMsgs()
     {
       this->UpdateStateSDF();
 
-      sdf::ElementPtr newSdf(this->dataPtr->sdf);
+      // The copy is written to a string on the response thread
+      sdf::ElementPtr newSdf = this->dataPtr->sdf->Clone();
 
       // FIXME: Handle scale better on the server so we don't need to unscale
       // SDF here. Issue #1825
@@ -1910,34 +3058,45 @@ void World::ProcessRequestMsgs()
         }
       }
 
-      msgs::GzString msg;
-      std::ostringstream stream;
-      stream << "<?xml version='1.0'?>\n"
-             << "<sdf version='" << SDF_VERSION << "'>\n"
-             << newSdf->ToString("")
-             << "</sdf>";
-
-      msg.set_data(stream.str());
-
-      std::string *serializedData = response.mutable_serialized_data();
-      msg.SerializeToString(serializedData);
-      response.set_type(msg.GetTypeName());
+      response.set_type(msgs::GzString().GetTypeName());
+      transport::PublisherPtr pub = this->dataPtr->responsePub;
+      queueResponse(*this->dataPtr, [pub, response, newSdf]() mutable
+          {
+            msgs::GzString msg;
+            std::ostringstream stream;
+            stream << "<?xml version='1.0'?>\n"
+                   << "<sdf version='" << SDF_VERSION << "'>\n"
+                   << newSdf->ToString("")
+                   << "</sdf>";
+
+            msg.set_data(stream.str());
+
+            std::string *serializedData = response.mutable_serialized_data();
+            msg.SerializeToString(serializedData);
+            pub->Publish(response);
+          });
+      send = false;
     }
     else if (requestMsg.request() == "scene_info")
     {
-      this->dataPtr->sceneMsg.clear_model();
-      this->dataPtr->sceneMsg.clear_light();
-      this->BuildSceneMsg(this->dataPtr->sceneMsg, this->dataPtr->rootElement);
-
-      std::string *serializedData = response.mutable_serialized_data();
-      this->dataPtr->sceneMsg.SerializeToString(serializedData);
-      response.set_type(this->dataPtr->sceneMsg.GetTypeName());
-
-      for (auto road : this->dataPtr->roads)
+      // The models are filled over the next steps. A scene that is still
+      // being filled is shared, since it is sent once it is current.
+      auto pending = std::find_if(this->dataPtr->sceneRequests.begin(),
+          this->dataPtr->sceneRequests.end(),
+          [](const WorldSceneRequest &_request)
+          {
+            return _request.scene;
+          });
+      if (pending != this->dataPtr->sceneRequests.end())
+        pending->responses.push_back(response);
+      else
       {
-        // this causes the roads to publish road msgs.
-        road->Init();
+        WorldSceneRequest sceneRequest;
+        sceneRequest.responses.push_back(response);
+        collectModels(this->dataPtr->rootElement, sceneRequest.models);
+        this->dataPtr->sceneRequests.push_back(std::move(sceneRequest));
       }
+      send = false;
     }
     else if (requestMsg.request() == "spherical_coordinates_info")
     {
@@ -1961,51 +3120,163 @@ void World::ProcessRequestMsgs()
 }
 
 //////////////////////////////////////////////////
-void World::ProcessModelMsgs()
+void World::ProcessSceneRequests()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
-  for (auto const &modelMsg : this->dataPtr->modelMsgs)
-  {
-    ModelPtr model;
-    if (modelMsg.has_id())
-      model = this->ModelById(modelMsg.id());
-    else
-      model = this->ModelByName(modelMsg.name());
+  if (this->dataPtr->sceneRequests.empty())
+    return;
 
-    if (!model)
-      gzerr << "Unable to find model["
-            << modelMsg.name() << "] Id[" << modelMsg.id() << "]\n";
-    else
+  // Fill at least one model per call, and more until the budget is spent.
+  // Cached models are only copied.
+  const int64_t deadlineNs = common::Time::SteadyNs() +
+      static_cast<int64_t>(kSceneRequestBudget * 1e9);
+  bool first = true;
+  while (!this->dataPtr->sceneRequests.empty())
+  {
+    WorldSceneRequest &request = this->dataPtr->sceneRequests.front();
+    while (request.next < request.models.size() &&
+           (first || common::Time::SteadyNs() < deadlineNs))
     {
-      model->ProcessMsg(modelMsg);
+      ModelPtr model = request.models[request.next++].lock();
+      if (!model)
+        continue;
 
-      // May 30, 2013: The following code was removed because it has a
-      // major performance impact when dragging complex object via the GUI.
-      // This code also does not seem to be necessary, since can just
-      // publish the incoming changes instead of a full model message. We
-      // are leaving it temporarily in case we find a need for it.
-      //
-      // Let all other subscribers know about the change
-      // msgs::Model msg;
-      // model->FillMsg(msg);
-      // // FillMsg fills the visual components from initial sdf
-      // // but problem is that Visuals may have changed e.g. through ~/visual,
-      // // so don't publish them to subscribers.
-      // for (int i = 0; i < msg.link_size(); ++i)
-      // {
-      //   msg.mutable_link(i)->clear_visual();
-      //   for (int j = 0; j < msg.link(i).collision_size(); ++j)
-      //   {
-      //     msg.mutable_link(i)->mutable_collision(j)->clear_visual();
-      //   }
-      // }
+      auto cached = this->dataPtr->sceneModels.find(model->GetId());
+      if (cached == this->dataPtr->sceneModels.end() ||
+          !matchesModel(*model, cached->second))
+      {
+        first = false;
+        msgs::Model &msg = this->dataPtr->sceneModels[model->GetId()];
+        msg.Clear();
+        model->FillMsg(msg);
+        request.msg.add_model()->CopyFrom(msg);
+      }
+      else
+        request.msg.add_model()->CopyFrom(cached->second);
+      request.filled.push_back(model);
+    }
 
-      this->dataPtr->modelPub->Publish(modelMsg);
+    if (request.next < request.models.size())
+      return;
+
+    // Drop the models removed since they were filled, and refresh the poses
+    // and states of the others, which may have changed
+    for (int i = request.msg.model_size() - 1; i >= 0; --i)
+    {
+      ModelPtr model = request.filled[i].lock();
+      if (model)
+        refreshState(*model, *request.msg.mutable_model(i));
+      else
+        request.msg.mutable_model()->DeleteSubrange(i, 1);
     }
-  }
 
-  if (!this->dataPtr->modelMsgs.empty())
-  {
+    // The message is serialized once for all the requests that share it
+    transport::PublisherPtr pub = this->dataPtr->responsePub;
+    std::vector<msgs::Response> responses;
+    responses.swap(request.responses);
+    if (request.scene)
+    {
+      // Lights are few, and filled last so they are current
+      for (unsigned int i = 0;
+          i < this->dataPtr->rootElement->GetChildCount(); ++i)
+      {
+        BasePtr entity = this->dataPtr->rootElement->GetChild(i);
+        if (entity->HasType(Base::LIGHT))
+        {
+          boost::static_pointer_cast<physics::Light>(entity)->FillMsg(
+              *request.msg.add_light());
+        }
+      }
+
+      this->dataPtr->sceneMsg.mutable_model()->Swap(
+          request.msg.mutable_model());
+      this->dataPtr->sceneMsg.mutable_light()->Swap(
+          request.msg.mutable_light());
+
+      auto sceneMsg = std::make_shared<msgs::Scene>(this->dataPtr->sceneMsg);
+      queueResponse(*this->dataPtr, [pub, responses, sceneMsg]() mutable
+          {
+            const std::string data = sceneMsg->SerializeAsString();
+            for (auto &response : responses)
+            {
+              response.set_type(sceneMsg->GetTypeName());
+              response.set_serialized_data(data);
+              pub->Publish(response);
+            }
+          });
+
+      for (auto road : this->dataPtr->roads)
+      {
+        // this causes the roads to publish road msgs.
+        road->Init();
+      }
+    }
+    else
+    {
+      auto modelVMsg = std::make_shared<msgs::Model_V>();
+      modelVMsg->mutable_models()->Swap(request.msg.mutable_model());
+      queueResponse(*this->dataPtr, [pub, responses, modelVMsg]() mutable
+          {
+            const std::string data = modelVMsg->SerializeAsString();
+            for (auto &response : responses)
+            {
+              response.set_type(modelVMsg->GetTypeName());
+              response.set_serialized_data(data);
+              pub->Publish(response);
+            }
+          });
+    }
+
+    this->dataPtr->sceneRequests.pop_front();
+  }
+}
+
+//////////////////////////////////////////////////
+void World::ProcessModelMsgs()
+{
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
+  for (auto const &modelMsg : this->dataPtr->modelMsgs)
+  {
+    ModelPtr model;
+    if (modelMsg.has_id())
+      model = this->ModelById(modelMsg.id());
+    else
+      model = this->ModelByName(modelMsg.name());
+
+    if (!model)
+      gzerr << "Unable to find model["
+            << modelMsg.name() << "] Id[" << modelMsg.id() << "]\n";
+    else
+    {
+      forgetModel(this->dataPtr->sceneModels, *model);
+      model->ProcessMsg(modelMsg);
+
+      // May 30, 2013: The following code was removed because it has a
+      // major performance impact when dragging complex object via the GUI.
+      // This code also does not seem to be necessary, since can just
+      // publish the incoming changes instead of a full model message. We
+      // are leaving it temporarily in case we find a need for it.
+      //
+      // Let all other subscribers know about the change
+      // msgs::Model msg;
+      // model->FillMsg(msg);
+      // // FillMsg fills the visual components from initial sdf
+      // // but problem is that Visuals may have changed e.g. through ~/visual,
+      // // so don't publish them to subscribers.
+      // for (int i = 0; i < msg.link_size(); ++i)
+      // {
+      //   msg.mutable_link(i)->clear_visual();
+      //   for (int j = 0; j < msg.link(i).collision_size(); ++j)
+      //   {
+      //     msg.mutable_link(i)->mutable_collision(j)->clear_visual();
+      //   }
+      // }
+
+      this->dataPtr->modelPub->Publish(modelMsg);
+    }
+  }
+
+  if (!this->dataPtr->modelMsgs.empty())
+  {
     this->EnableAllModels();
     this->dataPtr->modelMsgs.clear();
   }
@@ -2014,7 +3285,7 @@ void World::ProcessModelMsgs()
 //////////////////////////////////////////////////
 void World::ProcessLightModifyMsgs()
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   for (auto const &lightModifyMsg : this->dataPtr->lightModifyMsgs)
   {
     LightPtr light = this->LightByName(lightModifyMsg.name());
@@ -2055,7 +3326,7 @@ void World::ProcessLightFactoryMsgs()
   // avoid deadlock in OnLightFactory callback when trying to lock receiveMutex
   std::list<msgs::Light> lightFactoryMsgsCopy;
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
     std::copy(this->dataPtr->lightFactoryMsgs.begin(),
         this->dataPtr->lightFactoryMsgs.end(),
@@ -2090,7 +3361,7 @@ void World::ProcessFactoryMsgs()
 
   std::list<msgs::Factory> factoryMsgsCopy;
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
     std::copy(this->dataPtr->factoryMsgs.begin(),
       this->dataPtr->factoryMsgs.end(),
@@ -2098,12 +3369,34 @@ void World::ProcessFactoryMsgs()
     this->dataPtr->factoryMsgs.clear();
   }
 
-  for (auto const &factoryMsg : factoryMsgsCopy)
+  // SDF of every template parsed for these messages, indexed by source
+  std::map<std::string, sdf::ElementPtr> templates;
+
+  // Names of the models to load, which must be unique as well
+  std::set<std::string> newModelNames;
+  auto nameTaken = [&](const std::string &_name)
   {
+    return this->ModelByName(_name) || newModelNames.count(_name) > 0;
+  };
 
+  for (auto const &factoryMsg : factoryMsgsCopy)
+  {
     this->dataPtr->factorySDF->Clear();
 
+    std::string source;
     if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
+      source = "sdf:" + factoryMsg.sdf();
+    else if (factoryMsg.has_sdf_filename() &&
+            !factoryMsg.sdf_filename().empty())
+      source = "file:" + factoryMsg.sdf_filename();
+
+    sdf::ElementPtr root;
+    auto tmpl = templates.find(source);
+    if (!source.empty() && tmpl != templates.end())
+    {
+      root = tmpl->second;
+    }
+    else if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
     {
       // SDF Parsing happens here
       if (!sdf::readString(factoryMsg.sdf(), this->dataPtr->factorySDF))
@@ -2111,32 +3404,22 @@ void World::ProcessFactoryMsgs()
         gzerr << "Unable to read sdf string[" << factoryMsg.sdf() << "]\n";
         continue;
       }
+      root = this->dataPtr->factorySDF->Root();
+      templates[source] = root->Clone();
     }
     else if (factoryMsg.has_sdf_filename() &&
             !factoryMsg.sdf_filename().empty())
     {
-      std::string filename;
-      // If http(s), look at Fuel
-      auto uri = ignition::common::URI(factoryMsg.sdf_filename());
-      if (uri.Valid() && (uri.Scheme() == "https" || uri.Scheme() == "http"))
-      {
-        filename = common::FuelModelDatabase::Instance()->ModelFile(
-            factoryMsg.sdf_filename());
-      }
-      // Otherwise, look at database
-      else
-      {
-        filename = common::ModelDatabase::Instance()->GetModelFile(
-            factoryMsg.sdf_filename());
-      }
-
-      if (!sdf::readFile(filename, this->dataPtr->factorySDF))
+      // Parsed once per file version, with full paths
+      root = common::ModelSdfCache::Instance()->Root(
+          factoryMsg.sdf_filename());
+      if (!root)
       {
-        gzerr << "Unable to read sdf file [" << filename << "]\n";
+        gzerr << "Unable to read sdf file [" << factoryMsg.sdf_filename()
+              << "]\n";
         continue;
       }
-
-      common::convertToFullPaths(this->dataPtr->factorySDF->Root());
+      templates[source] = root->Clone();
     }
     else if (factoryMsg.has_clone_model_name())
     {
@@ -2148,14 +3431,13 @@ void World::ProcessFactoryMsgs()
         continue;
       }
 
-      this->dataPtr->factorySDF->Root()->InsertElement(
-          model->GetSDF()->Clone());
+      root = this->dataPtr->factorySDF->Root();
+      root->InsertElement(model->GetSDF()->Clone());
 
       std::string newName = model->GetName() + "_clone";
       newName = this->UniqueModelName(newName);
 
-      this->dataPtr->factorySDF->Root()->GetElement("model")->GetAttribute(
-          "name")->Set(newName);
+      root->GetElement("model")->GetAttribute("name")->Set(newName);
     }
     else
     {
@@ -2166,15 +3448,14 @@ void World::ProcessFactoryMsgs()
 
     if (factoryMsg.has_edit_name())
     {
-      BasePtr base(
-        this->dataPtr->rootElement->GetByName(factoryMsg.edit_name()));
+      BasePtr base(this->BaseByName(factoryMsg.edit_name()));
       if (base)
       {
         sdf::ElementPtr elem;
-        if (this->dataPtr->factorySDF->Root()->GetName() == "sdf")
-          elem = this->dataPtr->factorySDF->Root()->GetFirstElement();
+        if (root->GetName() == "sdf")
+          elem = root->GetFirstElement();
         else
-          elem = this->dataPtr->factorySDF->Root();
+          elem = root;
 
         base->UpdateParameters(elem);
       }
@@ -2185,12 +3466,12 @@ void World::ProcessFactoryMsgs()
       bool isModel = false;
       bool isLight = false;
 
-      sdf::ElementPtr elem = this->dataPtr->factorySDF->Root()->Clone();
+      sdf::ElementPtr elem = root->Clone();
 
       if (!elem)
       {
         gzerr << "Invalid SDF:";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        root->PrintValues("");
         continue;
       }
 
@@ -2215,7 +3496,7 @@ void World::ProcessFactoryMsgs()
       else
       {
         gzerr << "Unable to find a model, light, or actor in:\n";
-        this->dataPtr->factorySDF->Root()->PrintValues("");
+        root->PrintValues("");
         continue;
       }
 
@@ -2242,23 +3523,48 @@ void World::ProcessFactoryMsgs()
           continue;
         }
 
-        // Model with the given name already exists
-        if (this->ModelByName(entityName))
+        // One model per copy pose, cloned from the same SDF
+        const int copyCount = std::max(factoryMsg.copy_pose_size(), 1);
+        for (int i = 0; i < copyCount; ++i)
         {
-          // If allow renaming is disabled
-          if (!factoryMsg.allow_renaming())
+          sdf::ElementPtr modelElem = elem;
+          std::string modelName = entityName;
+          if (factoryMsg.copy_pose_size() > 0)
           {
-            gzwarn << "A model named [" << entityName << "] already exists "
-                  << "and allow_renaming is false. Model won't be inserted."
-                  << std::endl;
-            continue;
+            if (i > 0)
+            {
+              modelElem = elem->Clone();
+              modelElem->SetParent(this->dataPtr->sdf);
+              modelElem->GetParent()->InsertElement(modelElem);
+            }
+            modelElem->GetElement("pose")->Set(
+                msgs::ConvertIgn(factoryMsg.copy_pose(i)));
+            if (i < factoryMsg.copy_name_size())
+              modelName = factoryMsg.copy_name(i);
           }
 
-          entityName = this->UniqueModelName(entityName);
-          elem->GetAttribute("name")->Set(entityName);
-        }
+          // Model with the given name already exists
+          if (nameTaken(modelName))
+          {
+            // If allow renaming is disabled
+            if (!factoryMsg.allow_renaming())
+            {
+              gzwarn << "A model named [" << modelName << "] already exists "
+                    << "and allow_renaming is false. Model won't be inserted."
+                    << std::endl;
+              continue;
+            }
 
-        modelsToLoad.push_back(elem);
+            // Same names as UniqueModelName
+            const std::string baseName = modelName;
+            for (int n = 0; nameTaken(modelName); ++n)
+              modelName = baseName + "_" + std::to_string(n);
+          }
+
+          modelElem->GetAttribute("name")->Set(modelName);
+          newModelNames.insert(modelName);
+          modelsToLoad.push_back(modelElem);
+        }
       }
       else if (isLight)
       {
@@ -2267,23 +3573,50 @@ void World::ProcessFactoryMsgs()
     }
   }
 
-  // Load models
-  for (auto const &elem : modelsToLoad)
+  // Load models. They are initialized as one batch, so that the physics
+  // engine can set them up together, before their plugins are loaded.
   {
-    try
-    {
-      std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
+    std::lock_guard<std::mutex> lock(this->dataPtr->factoryDeleteMutex);
 
-      ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
-      if (model != nullptr)
+    Model_V newModels;
+    this->dataPtr->physicsEngine->BeginModelBatch();
+    for (auto const &elem : modelsToLoad)
+    {
+      try
       {
-        model->Init();
-        model->LoadPlugins();
+        ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
+        if (model != nullptr)
+        {
+          model->Init();
+          newModels.push_back(model);
+        }
       }
+      catch(...)
+      {
+        gzerr << "Loading model from factory message failed\n";
+      }
+    }
+
+    try
+    {
+      this->dataPtr->physicsEngine->EndModelBatch();
     }
     catch(...)
     {
-      gzerr << "Loading model from factory message failed\n";
+      gzerr << "Initializing models from factory message failed\n";
+      newModels.clear();
+    }
+
+    for (auto const &model : newModels)
+    {
+      try
+      {
+        model->LoadPlugins();
+      }
+      catch(...)
+      {
+        gzerr << "Loading model from factory message failed\n";
+      }
     }
   }
 
@@ -2319,17 +3652,100 @@ ModelPtr World::ModelBelowPoint(const ignition::math::Vector3d &_pt) const
 //////////////////////////////////////////////////
 EntityPtr World::EntityBelowPoint(const ignition::math::Vector3d &_pt) const
 {
-  std::string entityName;
-  double dist;
-  ignition::math::Vector3d end;
-
-  end = _pt;
+  ignition::math::Vector3d end = _pt;
   end.Z() -= 1000;
 
-  this->dataPtr->physicsEngine->InitForThread();
-  this->dataPtr->testRay->SetPoints(_pt, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
-  return this->EntityByName(entityName);
+  SceneQueryHit hit;
+  if (!this->dataPtr->sceneQueries->Ray(_pt, end, hit))
+    return EntityPtr();
+  if (hit.collision)
+    return hit.collision;
+  return this->EntityByName(hit.name);
+}
+
+//////////////////////////////////////////////////
+void World::CollectSnapshotEntities()
+{
+  this->dataPtr->snapshotLinks.clear();
+  this->dataPtr->snapshotJoints.clear();
+  this->dataPtr->snapshotControllers.clear();
+
+  for (auto const &model : this->dataPtr->models)
+  {
+    model->SnapshotEntities(this->dataPtr->snapshotLinks,
+        this->dataPtr->snapshotJoints, this->dataPtr->snapshotControllers);
+  }
+}
+
+//////////////////////////////////////////////////
+void World::SaveSnapshot(WorldSnapshot &_snapshot)
+{
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+
+  this->CollectSnapshotEntities();
+
+  WorldSnapshotPrivate &snapshot = *_snapshot.dataPtr;
+  snapshot.simTime = this->dataPtr->simTime;
+  snapshot.iterations = this->dataPtr->iterations;
+  snapshot.linkCount = this->dataPtr->snapshotLinks.size();
+  snapshot.jointCount = this->dataPtr->snapshotJoints.size();
+  snapshot.controllerCount = this->dataPtr->snapshotControllers.size();
+
+  snapshot.data.clear();
+  this->dataPtr->physicsEngine->SaveSnapshot(this->dataPtr->snapshotLinks,
+      this->dataPtr->snapshotJoints, snapshot.data);
+  for (auto const &controller : this->dataPtr->snapshotControllers)
+    controller->SaveSnapshot(snapshot.data);
+
+  snapshot.valid = true;
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshot(const WorldSnapshot &_snapshot)
+{
+  const WorldSnapshotPrivate &snapshot = *_snapshot.dataPtr;
+  if (!snapshot.valid)
+  {
+    gzerr << "Unable to restore an empty world snapshot\n";
+    return false;
+  }
+
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->worldUpdateMutex);
+
+  this->CollectSnapshotEntities();
+  if (snapshot.linkCount != this->dataPtr->snapshotLinks.size() ||
+      snapshot.jointCount != this->dataPtr->snapshotJoints.size() ||
+      snapshot.controllerCount != this->dataPtr->snapshotControllers.size())
+  {
+    gzerr << "Unable to restore a snapshot of world [" << this->Name()
+          << "], its models changed since the snapshot was saved\n";
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock plock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  this->dataPtr->simTime = snapshot.simTime;
+  this->dataPtr->iterations = snapshot.iterations;
+
+  const double *data = snapshot.data.data();
+  const double *end = data + snapshot.data.size();
+  bool restored = this->dataPtr->physicsEngine->RestoreSnapshot(
+      this->dataPtr->snapshotLinks, this->dataPtr->snapshotJoints, data, end);
+  for (auto const &controller : this->dataPtr->snapshotControllers)
+    restored = restored && controller->RestoreSnapshot(data, end);
+
+  // Propagate the restored body poses to the links, as after a step
+  this->ApplyDirtyPoses();
+
+  if (!restored || data != end)
+  {
+    gzerr << "Unable to restore a snapshot of world [" << this->Name()
+          << "], its data doesn't match the world\n";
+    return false;
+  }
+
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -2455,19 +3871,14 @@ void World::SetState(const WorldState &_state)
     }
   }
 
-  // Deletions
-  auto deletions = _state.Deletions();
-  for (auto const &deletion : deletions)
-  {
-    // This works for models and lights
-    this->RemoveModel(deletion);
-  }
+  // Deletions. This works for models and lights
+  this->RemoveModels(_state.Deletions());
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf_filename(_sdfFilename);
   this->dataPtr->factoryMsgs.push_back(msg);
@@ -2476,16 +3887,32 @@ void World::InsertModelFile(const std::string &_sdfFilename)
 //////////////////////////////////////////////////
 void World::InsertModelSDF(const sdf::SDF &_sdf)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
+  msgs::Factory msg;
+  msg.set_sdf(_sdf.ToString());
+  this->dataPtr->factoryMsgs.push_back(msg);
+}
+
+//////////////////////////////////////////////////
+void World::InsertModelCopies(const sdf::SDF &_sdf,
+    const std::vector<ignition::math::Pose3d> &_poses,
+    const std::vector<std::string> &_names)
+{
   msgs::Factory msg;
   msg.set_sdf(_sdf.ToString());
+  for (auto const &pose : _poses)
+    msgs::Set(msg.add_copy_pose(), pose);
+  for (auto const &name : _names)
+    msg.add_copy_name(name);
+
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->factoryMsgs.push_back(msg);
 }
 
 //////////////////////////////////////////////////
 void World::InsertModelString(const std::string &_sdfString)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   msgs::Factory msg;
   msg.set_sdf(_sdfString);
   this->dataPtr->factoryMsgs.push_back(msg);
@@ -2518,6 +3945,60 @@ void World::DisableAllModels()
   }
 }
 
+//////////////////////////////////////////////////
+void World::SetModelPoses(const Model_V &_models,
+    const std::vector<ignition::math::Pose3d> &_poses)
+{
+  GZ_PROFILE("World::SetModelPoses");
+  if (_models.size() != _poses.size())
+  {
+    gzerr << "SetModelPoses given " << _models.size() << " models and "
+          << _poses.size() << " poses" << std::endl;
+    return;
+  }
+
+  {
+    common::ProfiledLock<boost::recursive_mutex> plock(
+        *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex(),
+        this->dataPtr->physicsLockStats);
+    std::lock_guard<std::mutex> lock(this->dataPtr->setWorldPoseMutex);
+    for (std::size_t i = 0; i < _models.size(); ++i)
+    {
+      if (_models[i])
+        _models[i]->ApplyWorldPose(_poses[i]);
+    }
+  }
+
+  for (auto const &model : _models)
+  {
+    if (model)
+      model->InvalidateJointStates();
+  }
+
+  if (this->dataPtr->sceneQueries)
+    this->dataPtr->sceneQueries->Refresh();
+
+  if (this->dataPtr->modelIndexEnabled.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+    for (auto const &model : _models)
+    {
+      if (model)
+        this->dataPtr->movedModels.insert(model.get());
+    }
+  }
+
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
+  for (auto const &model : _models)
+  {
+    if (!model)
+      continue;
+    this->dataPtr->publishModelPoses.insert(model);
+    this->dataPtr->localModelPoses.insert(model);
+    this->dataPtr->streamModels.insert(model);
+  }
+}
+
 //////////////////////////////////////////////////
 void World::UpdateStateSDF()
 {
@@ -2655,7 +4136,7 @@ bool World::OnLog(std::ostringstream &_stream)
               << "</sdf>";
     }
 
-    this->dataPtr->states[bufferIndex].clear();
+    clearStates(*this->dataPtr, bufferIndex);
   }
 
   // Logging has stopped. Wait for log worker to finish. Output last bit
@@ -2684,8 +4165,8 @@ bool World::OnLog(std::ostringstream &_stream)
     }
 
     // Clear everything.
-    this->dataPtr->states[0].clear();
-    this->dataPtr->states[1].clear();
+    clearStates(*this->dataPtr, 0);
+    clearStates(*this->dataPtr, 1);
     this->dataPtr->stateToggle = 0;
     this->dataPtr->prevStates[0] = WorldState();
     this->dataPtr->prevStates[1] = WorldState();
@@ -2700,67 +4181,98 @@ bool World::OnLog(std::ostringstream &_stream)
 void World::ProcessMessages()
 {
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
-    if ((this->dataPtr->posePub && this->dataPtr->posePub->HasConnections()) ||
-      // When ready to use the direct API for updating scene poses from server,
-      // uncomment the following line:
-         this->dataPtr->updateScenePoses ||
+    const bool poseConnected =
+        this->dataPtr->posePub && this->dataPtr->posePub->HasConnections();
+    const bool localConnected =
         (this->dataPtr->poseLocalPub &&
-         this->dataPtr->poseLocalPub->HasConnections()))
+         this->dataPtr->poseLocalPub->HasConnections()) ||
+        // When ready to use the direct API for updating scene poses from
+        // server, uncomment the following line:
+        this->dataPtr->updateScenePoses;
+
+    // Each topic has its own rate, and keeps the entities that moved
+    // since its last message.
+    const common::Time simTime = this->SimTime();
+    const bool poseDue =
+        poseConnected && this->dataPtr->poseThrottle.Due(simTime);
+    const bool localDue =
+        localConnected && this->dataPtr->localPoseThrottle.Due(simTime);
+
+    // Reuse the pose message from the previous step. Clear keeps the
+    // pose entries allocated, so add_pose below does not allocate once
+    // the message has grown to the size of the scene.
+    msgs::PosesStamped &msg = this->dataPtr->posesMsg;
+    auto fillPoses = [&](const std::set<ModelPtr> &_models,
+                         const std::set<LightPtr> &_lights)
     {
-      msgs::PosesStamped msg;
+      msg.Clear();
 
       // Time stamp this PosesStamped message
-      msgs::Set(msg.mutable_time(), this->SimTime());
+      msgs::Set(msg.mutable_time(), simTime);
 
-      if (!this->dataPtr->publishModelPoses.empty() ||
-          !this->dataPtr->publishLightPoses.empty())
+      Model_V &modelQueue = this->dataPtr->posesModelQueue;
+      for (auto const &model : _models)
       {
-        for (auto const &model : this->dataPtr->publishModelPoses)
+        modelQueue.clear();
+        modelQueue.push_back(model);
+        for (size_t i = 0; i < modelQueue.size(); ++i)
         {
-          std::list<ModelPtr> modelList;
-          modelList.push_back(model);
-          while (!modelList.empty())
-          {
-            ModelPtr m = modelList.front();
-            modelList.pop_front();
-            msgs::Pose *poseMsg = msg.add_pose();
+          ModelPtr m = modelQueue[i];
+          msgs::Pose *poseMsg = msg.add_pose();
 
-            // Publish the model's relative pose
-            poseMsg->set_name(m->GetScopedName());
-            poseMsg->set_id(m->GetId());
-            msgs::Set(poseMsg, m->RelativePose());
+          // Publish the model's relative pose
+          poseMsg->set_name(m->GetScopedName());
+          poseMsg->set_id(m->GetId());
+          msgs::Set(poseMsg, m->RelativePose());
 
-            // Publish each of the model's child links relative poses
-            Link_V links = m->GetLinks();
-            for (auto const &link : links)
-            {
-              poseMsg = msg.add_pose();
-              poseMsg->set_name(link->GetScopedName());
-              poseMsg->set_id(link->GetId());
-              msgs::Set(poseMsg, link->RelativePose());
-            }
-
-            // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
-              modelList.push_back(n);
+          // Publish each of the model's child links relative poses
+          for (auto const &link : m->GetLinks())
+          {
+            poseMsg = msg.add_pose();
+            poseMsg->set_name(link->GetScopedName());
+            poseMsg->set_id(link->GetId());
+            msgs::Set(poseMsg, link->RelativePose());
           }
+
+          // add all nested models to the queue
+          const Model_V &models = m->NestedModels();
+          modelQueue.insert(modelQueue.end(), models.begin(), models.end());
         }
+      }
+      modelQueue.clear();
 
-        for (auto const &light : this->dataPtr->publishLightPoses)
-        {
-          msgs::Pose *poseMsg = msg.add_pose();
+      for (auto const &light : _lights)
+      {
+        msgs::Pose *poseMsg = msg.add_pose();
 
-          // Publish the light's pose
-          poseMsg->set_name(light->GetScopedName());
-          poseMsg->set_id(light->GetId());
-          msgs::Set(poseMsg, light->RelativePose());
-        }
+        // Publish the light's pose
+        poseMsg->set_name(light->GetScopedName());
+        poseMsg->set_id(light->GetId());
+        msgs::Set(poseMsg, light->RelativePose());
+      }
+    };
+
+    bool localFilled = false;
+    if (poseDue && (!this->dataPtr->publishModelPoses.empty() ||
+                    !this->dataPtr->publishLightPoses.empty()))
+    {
+      fillPoses(this->dataPtr->publishModelPoses,
+                this->dataPtr->publishLightPoses);
+      this->dataPtr->posePub->Publish(msg);
 
-        if (this->dataPtr->posePub && this->dataPtr->posePub->HasConnections())
-          this->dataPtr->posePub->Publish(msg);
+      localFilled =
+          this->dataPtr->localModelPoses == this->dataPtr->publishModelPoses &&
+          this->dataPtr->localLightPoses == this->dataPtr->publishLightPoses;
+    }
+
+    if (localDue)
+    {
+      if (!localFilled)
+      {
+        fillPoses(this->dataPtr->localModelPoses,
+                  this->dataPtr->localLightPoses);
       }
 
       if (this->dataPtr->poseLocalPub &&
@@ -2780,12 +4292,24 @@ void World::ProcessMessages()
       }
     }
 
-    this->dataPtr->publishModelPoses.clear();
-    this->dataPtr->publishLightPoses.clear();
+    if (poseDue || !poseConnected)
+    {
+      this->dataPtr->publishModelPoses.clear();
+      this->dataPtr->publishLightPoses.clear();
+    }
+    if (localDue || !localConnected)
+    {
+      this->dataPtr->localModelPoses.clear();
+      this->dataPtr->localLightPoses.clear();
+    }
+
+    // The state stream is throttled on its own, and follows the same
+    // models
+    publishStateStream(*this->dataPtr, simTime);
   }
 
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+    std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
     if (this->dataPtr->modelPub && this->dataPtr->modelPub->HasConnections())
     {
@@ -2801,44 +4325,24 @@ void World::ProcessMessages()
             modelList.pop_front();
 
             // add all nested models to the queue
-            Model_V models = m->NestedModels();
-            for (auto const &n : models)
+            for (auto const &n : m->NestedModels())
               modelList.push_back(n);
 
-            // Publish the model's scale and visual geometry data at the same
-            // time to fix race condition on rendering side when updating
-            // visuals
+            // Publish the model's scale and the visual geometries that
+            // changed at the same time to fix race condition on rendering
+            // side when updating visuals. Without such changes, only the
+            // scale is published.
             msgs::Model msg;
             msg.set_name(m->GetScopedName());
             msg.set_id(m->GetId());
-            Link_V links = m->GetLinks();
-            for (auto l : links)
+            for (auto const &l : m->GetLinks())
             {
-              msgs::Link *linkMsg = msg.add_link();
-              linkMsg->set_id(l->GetId());
-              linkMsg->set_name(l->GetScopedName());
-
-              // tmpMsg is unused. The Link::FillMsg call is made in order to
-              // keep link's visual msgs up-to-date with latest sdf values.
-              // The for loop below does the actual copy of visual geom msg.
-              {
-                msgs::Link tmpMsg;
-                l->FillMsg(tmpMsg);
-              }
-
-              auto visualMsgs = l->Visuals();
-              for (auto v : visualMsgs)
-              {
-                if (!v.second.has_geometry())
-                  continue;
-                msgs::Visual *visualMsg = linkMsg->add_visual();
-                visualMsg->set_name(v.second.name());
-                visualMsg->set_id(v.second.id());
-                visualMsg->set_parent_name(v.second.parent_name());
-                visualMsg->set_parent_id(v.second.parent_id());
-                auto geomMsg = visualMsg->mutable_geometry();
-                geomMsg->CopyFrom(v.second.geometry());
-              }
+              msgs::Link linkMsg;
+              if (!l->FillChangedVisualGeometry(linkMsg))
+                continue;
+              linkMsg.set_id(l->GetId());
+              linkMsg.set_name(l->GetScopedName());
+              msg.add_link()->Swap(&linkMsg);
             }
 
             // set scale
@@ -2852,8 +4356,8 @@ void World::ProcessMessages()
     this->dataPtr->publishModelScales.clear();
   }
 
-  if (common::Time::GetWallTime() - this->dataPtr->prevProcessMsgsTime >
-      this->dataPtr->processMsgsPeriod)
+  if (common::Time::SteadyNs() - this->dataPtr->prevProcessMsgsNs >
+      this->dataPtr->processMsgsPeriodNs)
   {
     this->ProcessPlaybackControlMsgs();
     this->ProcessEntityMsgs();
@@ -2862,8 +4366,11 @@ void World::ProcessMessages()
     this->ProcessModelMsgs();
     this->ProcessLightFactoryMsgs();
     this->ProcessLightModifyMsgs();
-    this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
+    this->dataPtr->prevProcessMsgsNs = common::Time::SteadyNs();
   }
+
+  // Scene requests are filled at each step, a little at a time
+  this->ProcessSceneRequests();
 }
 
 //////////////////////////////////////////////////
@@ -2895,7 +4402,55 @@ void World::PublishWorldStats()
 
   if (this->dataPtr->statPub && this->dataPtr->statPub->HasConnections())
     this->dataPtr->statPub->Publish(this->dataPtr->worldStatsMsg);
-  this->dataPtr->prevStatTime = common::Time::GetWallTime();
+  this->dataPtr->prevStatNs = common::Time::SteadyNs();
+}
+
+//////////////////////////////////////////////////
+void World::SetWorldStatsPublishRate(const double _hz)
+{
+  this->dataPtr->statsThrottle.SetRate(_hz);
+}
+
+//////////////////////////////////////////////////
+double World::WorldStatsPublishRate() const
+{
+  return this->dataPtr->statsThrottle.Rate();
+}
+
+//////////////////////////////////////////////////
+void World::SetPosePublishRate(const double _hz)
+{
+  this->dataPtr->poseThrottle.SetRate(_hz);
+}
+
+//////////////////////////////////////////////////
+double World::PosePublishRate() const
+{
+  return this->dataPtr->poseThrottle.Rate();
+}
+
+//////////////////////////////////////////////////
+void World::SetLocalPosePublishRate(const double _hz)
+{
+  this->dataPtr->localPoseThrottle.SetRate(_hz);
+}
+
+//////////////////////////////////////////////////
+double World::LocalPosePublishRate() const
+{
+  return this->dataPtr->localPoseThrottle.Rate();
+}
+
+//////////////////////////////////////////////////
+void World::SetStateStreamRate(const double _hz)
+{
+  this->dataPtr->stateThrottle.SetRate(_hz);
+}
+
+//////////////////////////////////////////////////
+double World::StateStreamRate() const
+{
+  return this->dataPtr->stateThrottle.Rate();
 }
 
 //////////////////////////////////////////////////
@@ -2907,16 +4462,18 @@ bool World::IsLoaded() const
 //////////////////////////////////////////////////
 void World::PublishModelPose(physics::ModelPtr _model)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelPoses.insert(_model);
+  this->dataPtr->localModelPoses.insert(_model);
+  this->dataPtr->streamModels.insert(_model);
 }
 
 //////////////////////////////////////////////////
 void World::PublishModelScale(physics::ModelPtr _model)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelScales.insert(_model);
@@ -2925,50 +4482,45 @@ void World::PublishModelScale(physics::ModelPtr _model)
 //////////////////////////////////////////////////
 void World::PublishLightPose(const physics::LightPtr _light)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
 
   // Only add if the light name is not in the list
   this->dataPtr->publishLightPoses.insert(_light);
+  this->dataPtr->localLightPoses.insert(_light);
 }
 
 //////////////////////////////////////////////////
 void World::LogWorker()
 {
-  std::unique_lock<std::mutex> lock(this->dataPtr->logMutex);
+  common::ThreadConfig::Instance()->Apply("log_worker");
+
+  std::unique_lock<WorldMutex> lock(this->dataPtr->logMutex);
 
   WorldPtr self = shared_from_this();
   this->dataPtr->logPrevIteration = this->dataPtr->iterations;
 
   GZ_ASSERT(self, "Self pointer to World is invalid");
 
-  // Init the prevUnfilteredState
-  this->dataPtr->prevUnfilteredState.Load(self);
+  // Init the set of logged entities
+  {
+    std::vector<std::string> insertions;
+    std::vector<std::string> deletions;
+    std::lock_guard<WorldMutex> dLock(this->dataPtr->entityDeleteMutex);
+    this->dataPtr->logModelNames.clear();
+    this->dataPtr->logLightNames.clear();
+    this->LogInsertionsDeletions(insertions, deletions);
+  }
 
   while (!this->dataPtr->stop)
   {
-    // get unfiltered world state
-    WorldState unfilteredState;
-    {
-      std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
-      unfilteredState.Load(self);
-    }
-
-    // compute world state diff and find out about insertions and deletions
+    // find out about insertions and deletions
     std::vector<std::string> insertions;
     std::vector<std::string> deletions;
     bool insertDelete = false;
-
     {
-      WorldState unfilteredDiffState = unfilteredState -
-          this->dataPtr->prevUnfilteredState;
-      if (!unfilteredDiffState.IsZero())
-      {
-        insertions = unfilteredDiffState.Insertions();
-        deletions = unfilteredDiffState.Deletions();
-        insertDelete = !insertions.empty() || !deletions.empty();
-      }
+      std::lock_guard<WorldMutex> dLock(this->dataPtr->entityDeleteMutex);
+      insertDelete = this->LogInsertionsDeletions(insertions, deletions);
     }
-    this->dataPtr->prevUnfilteredState = unfilteredState;
 
     // Throttle state capture based on log recording frequency.
     auto simTime = this->SimTime();
@@ -2980,7 +4532,7 @@ void World::LogWorker()
       std::string filterStr = util::LogRecord::Instance()->Filter();
       // compute diff for filtered states
       {
-        std::lock_guard<std::mutex> dLock(this->dataPtr->entityDeleteMutex);
+        std::lock_guard<WorldMutex> dLock(this->dataPtr->entityDeleteMutex);
         this->dataPtr->prevStates[currState].LoadWithFilter(self, filterStr);
       }
       WorldState diffState = this->dataPtr->prevStates[currState] -
@@ -2999,6 +4551,11 @@ void World::LogWorker()
           this->dataPtr->prevStates[currState].SetDeletions(deletions);
           this->dataPtr->states[this->dataPtr->currentStateBuffer].push_back(
               this->dataPtr->prevStates[currState]);
+          const int64_t bytes =
+              stateBytes(this->dataPtr->prevStates[currState]);
+          this->dataPtr->stateBytes[this->dataPtr->currentStateBuffer] +=
+              bytes;
+          this->dataPtr->stateMemory->Add(bytes);
 
           // Tell the logger to update, once the number of states exceeds 1000
           if (this->dataPtr->states[this->dataPtr->currentStateBuffer].size() >
@@ -3022,6 +4579,53 @@ void World::LogWorker()
   this->dataPtr->logContinueCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+bool World::LogInsertionsDeletions(std::vector<std::string> &_insertions,
+    std::vector<std::string> &_deletions)
+{
+  std::set<std::string> modelNames;
+  for (auto const &model : this->dataPtr->models)
+    modelNames.insert(model->GetName());
+
+  std::set<std::string> lightNames;
+  for (auto const &light : this->Lights())
+    lightNames.insert(light->GetName());
+
+  // Same order as WorldState::operator-: model deletions, light deletions,
+  // model insertions, light insertions.
+  std::set_difference(this->dataPtr->logModelNames.begin(),
+      this->dataPtr->logModelNames.end(), modelNames.begin(),
+      modelNames.end(), std::back_inserter(_deletions));
+  std::set_difference(this->dataPtr->logLightNames.begin(),
+      this->dataPtr->logLightNames.end(), lightNames.begin(),
+      lightNames.end(), std::back_inserter(_deletions));
+
+  for (auto const &name : modelNames)
+  {
+    if (this->dataPtr->logModelNames.count(name))
+      continue;
+
+    ModelPtr model = this->ModelByName(name);
+    if (model)
+      _insertions.push_back(model->UnscaledSDF()->ToString(""));
+  }
+
+  for (auto const &name : lightNames)
+  {
+    if (this->dataPtr->logLightNames.count(name))
+      continue;
+
+    LightPtr light = this->LightByName(name);
+    if (light)
+      _insertions.push_back(light->GetSDF()->ToString(""));
+  }
+
+  this->dataPtr->logModelNames.swap(modelNames);
+  this->dataPtr->logLightNames.swap(lightNames);
+
+  return !_insertions.empty() || !_deletions.empty();
+}
+
 /////////////////////////////////////////////////
 uint32_t World::Iterations() const
 {
@@ -3037,19 +4641,13 @@ void World::RemoveModel(const std::string &_name)
   std::lock_guard<std::mutex> flock(this->dataPtr->factoryDeleteMutex);
 
   // Remove all the dirty poses from the delete entity.
-  {
-    for (auto entity = this->dataPtr->dirtyPoses.begin();
-             entity != this->dataPtr->dirtyPoses.end(); ++entity)
-    {
-      if ((*entity)->GetName() == _name ||
-         ((*entity)->GetParent() && (*entity)->GetParent()->GetName() == _name))
+  this->dataPtr->dirtyPoses.erase(std::remove_if(
+      this->dataPtr->dirtyPoses.begin(), this->dataPtr->dirtyPoses.end(),
+      [&_name](Entity *_entity)
       {
-        this->dataPtr->dirtyPoses.erase(entity++);
-      }
-      else
-        ++entity;
-    }
-  }
+        return _entity->GetName() == _name ||
+            (_entity->GetParent() && _entity->GetParent()->GetName() == _name);
+      }), this->dataPtr->dirtyPoses.end());
 
   // Remove from SDF
   if (this->dataPtr->sdf->HasElement("model"))
@@ -3085,8 +4683,21 @@ void World::RemoveModel(const std::string &_name)
     {
       if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
       {
+        forgetNested(this->dataPtr->sceneModels, **model);
         this->dataPtr->models.erase(model);
         this->dataPtr->rootElement->RemoveChild(_name);
+
+        // Let go of the removed models before the tree is rebuilt
+        std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+        this->dataPtr->modelIndexDirty = true;
+        this->dataPtr->indexedModels.clear();
+        this->dataPtr->movedModels.clear();
+        this->dataPtr->forceFields->Refresh();
+        this->dataPtr->regionTriggers->Refresh();
+        this->dataPtr->sceneQueries->Refresh();
+        this->dataPtr->stepStates->Refresh();
+        this->dataPtr->sleepManager->Refresh();
+        this->_LinksChanged();
         break;
       }
     }
@@ -3125,45 +4736,209 @@ void World::RemoveModel(const std::string &_name)
     }
   }
 
-  // Cleanup the publishModelPoses list.
+  // Cleanup the lists of poses to publish.
   {
-    std::lock_guard<std::recursive_mutex> lock2(this->dataPtr->receiveMutex);
-    for (auto model = this->dataPtr->publishModelPoses.begin();
-             model != this->dataPtr->publishModelPoses.end(); ++model)
+    std::lock_guard<WorldRecursiveMutex> lock2(this->dataPtr->receiveMutex);
+    this->dataPtr->stateSchemaDirty = true;
+    for (auto *poses : {&this->dataPtr->publishModelPoses,
+                        &this->dataPtr->localModelPoses,
+                        &this->dataPtr->streamModels,
+                        &this->dataPtr->streamPrevious})
     {
-      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
+      for (auto model = poses->begin(); model != poses->end(); ++model)
       {
-        this->dataPtr->publishModelPoses.erase(model);
-        break;
+        if ((*model)->GetName() == _name ||
+            (*model)->GetScopedName() == _name)
+        {
+          poses->erase(model);
+          break;
+        }
       }
     }
+
+    for (auto *poses : {&this->dataPtr->publishLightPoses,
+                        &this->dataPtr->localLightPoses})
+    {
+      for (auto light = poses->begin(); light != poses->end(); ++light)
+      {
+        if ((*light)->GetName() == _name ||
+            (*light)->GetScopedName() == _name)
+        {
+          poses->erase(light);
+          break;
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void World::RemoveModels(const std::vector<std::string> &_names)
+{
+  if (_names.empty())
+    return;
+
+  const std::unordered_set<std::string> names(_names.begin(), _names.end());
+
+  boost::recursive_mutex::scoped_lock plock(
+      *this->Physics()->GetPhysicsUpdateMutex());
+
+  std::lock_guard<std::mutex> flock(this->dataPtr->factoryDeleteMutex);
+
+  // Remove all the dirty poses of the deleted entities.
+  this->dataPtr->dirtyPoses.erase(std::remove_if(
+      this->dataPtr->dirtyPoses.begin(), this->dataPtr->dirtyPoses.end(),
+      [&names](Entity *_entity)
+      {
+        return names.count(_entity->GetName()) || (_entity->GetParent() &&
+            names.count(_entity->GetParent()->GetName()));
+      }), this->dataPtr->dirtyPoses.end());
+
+  // Remove from SDF
+  for (auto const &type : {"model", "light"})
+  {
+    sdf::ElementPtr childElem;
+    if (this->dataPtr->sdf->HasElement(type))
+      childElem = this->dataPtr->sdf->GetElement(type);
+    while (childElem)
+    {
+      sdf::ElementPtr next = childElem->GetNextElement(type);
+      if (names.count(childElem->Get<std::string>("name")))
+        this->dataPtr->sdf->RemoveChild(childElem);
+      childElem = next;
+    }
+  }
+
+  std::vector<std::string> deleted;
+  std::unordered_set<Entity *> removed;
+
+  // Remove the model and light objects, and finalize them without a request
+  // per entity
+  {
+    Base_V removedModels;
+    this->dataPtr->models.erase(std::remove_if(
+        this->dataPtr->models.begin(), this->dataPtr->models.end(),
+        [&](const ModelPtr &_model)
+        {
+          if (!names.count(_model->GetName()) &&
+              !names.count(_model->GetScopedName()))
+          {
+            return false;
+          }
+          removedModels.push_back(_model);
+          removed.insert(_model.get());
+          deleted.push_back(_model->GetScopedName());
+          return true;
+        }), this->dataPtr->models.end());
+
+    Light_V removedLights;
+    this->dataPtr->lights.erase(std::remove_if(
+        this->dataPtr->lights.begin(), this->dataPtr->lights.end(),
+        [&](const LightPtr &_light)
+        {
+          if (!names.count(_light->GetScopedName()))
+            return false;
+          removedLights.push_back(_light);
+          removed.insert(_light.get());
+          deleted.push_back(_light->GetScopedName());
+          return true;
+        }), this->dataPtr->lights.end());
+
+    this->dataPtr->removingModels = true;
+    for (auto const &model : removedModels)
+    {
+      forgetNested(this->dataPtr->sceneModels,
+          *boost::static_pointer_cast<Model>(model));
+    }
+    this->dataPtr->rootElement->RemoveChildren(removedModels);
+    for (auto const &light : removedLights)
+    {
+      if (light->GetParent())
+        light->GetParent()->RemoveChild(light);
+    }
+    this->dataPtr->removingModels = false;
+
+    if (!removedModels.empty())
+    {
+      // Let go of the removed models before the tree is rebuilt
+      std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+      this->dataPtr->modelIndexDirty = true;
+      this->dataPtr->indexedModels.clear();
+      this->dataPtr->movedModels.clear();
+      this->dataPtr->forceFields->Refresh();
+      this->dataPtr->regionTriggers->Refresh();
+      this->dataPtr->sceneQueries->Refresh();
+      this->dataPtr->stepStates->Refresh();
+      this->dataPtr->sleepManager->Refresh();
+      this->_LinksChanged();
+    }
+
+    // Remove the lights from the scene msg.
+    auto *sceneLights = this->dataPtr->sceneMsg.mutable_light();
+    sceneLights->erase(std::remove_if(sceneLights->begin(),
+        sceneLights->end(), [&names](const msgs::Light &_light)
+        {
+          return names.count(_light.name()) > 0;
+        }), sceneLights->end());
   }
 
-  // Cleanup the publishLightPoses list.
+  // Cleanup the lists of poses to publish.
   {
-    std::lock_guard<std::recursive_mutex> lock2(this->dataPtr->receiveMutex);
-    for (auto light : this->dataPtr->publishLightPoses)
+    std::lock_guard<WorldRecursiveMutex> lock2(this->dataPtr->receiveMutex);
+    this->dataPtr->stateSchemaDirty = true;
+    for (auto *poses : {&this->dataPtr->publishModelPoses,
+                        &this->dataPtr->localModelPoses,
+                        &this->dataPtr->streamModels,
+                        &this->dataPtr->streamPrevious})
     {
-      if (light->GetName() == _name || light->GetScopedName() == _name)
+      for (auto model = poses->begin(); model != poses->end();)
       {
-        this->dataPtr->publishLightPoses.erase(light);
-        break;
+        if (removed.count(model->get()))
+          model = poses->erase(model);
+        else
+          ++model;
+      }
+    }
+
+    for (auto *poses : {&this->dataPtr->publishLightPoses,
+                        &this->dataPtr->localLightPoses})
+    {
+      for (auto light = poses->begin(); light != poses->end();)
+      {
+        if (removed.count(light->get()))
+          light = poses->erase(light);
+        else
+          ++light;
       }
     }
   }
+
+  // One request deletes all the entities from the clients
+  if (!deleted.empty() && this->dataPtr->requestPub)
+  {
+    msgs::Request *msg = msgs::CreateDeleteRequest(deleted);
+    this->dataPtr->requestPub->Publish(*msg, true);
+    delete msg;
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::RemovingModels() const
+{
+  return this->dataPtr->removingModels;
 }
 
 /////////////////////////////////////////////////
 void World::OnLightModifyMsg(ConstLightPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->lightModifyMsgs.push_back(*_msg);
 }
 
 /////////////////////////////////////////////////
 void World::OnLightFactoryMsg(ConstLightPtr &_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(this->dataPtr->receiveMutex);
+  std::lock_guard<WorldRecursiveMutex> lock(this->dataPtr->receiveMutex);
   this->dataPtr->lightFactoryMsgs.push_back(*_msg);
 }
 
@@ -3207,8 +4982,7 @@ void World::SetWindEnabled(const bool _enable)
 
   for (auto const &model : this->dataPtr->models)
   {
-    Link_V links = model->GetLinks();
-    for (auto const &link : links)
+    for (auto const &link : model->GetLinks())
     {
       if (link->WindMode())
         link->SetWindEnabled(this->dataPtr->enableWind);
@@ -3228,6 +5002,35 @@ void World::SetAtmosphereEnabled(const bool _enable)
   this->dataPtr->enableAtmosphere = _enable;
 }
 
+/////////////////////////////////////////////////
+void World::ApplyDirtyPoses()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->setWorldPoseMutex);
+  for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+    dirtyEntity->ApplyDirtyPose();
+
+  // The scene queries need a new snapshot
+  if (!this->dataPtr->dirtyPoses.empty() && this->dataPtr->sceneQueries)
+    this->dataPtr->sceneQueries->Refresh();
+
+  // The models of the links that moved need a new bounding box
+  if (this->dataPtr->modelIndexEnabled.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> indexLock(this->dataPtr->modelIndexMutex);
+    for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+    {
+      BasePtr parent = dirtyEntity->GetParent();
+      if (parent && parent->HasType(Base::MODEL))
+      {
+        this->dataPtr->movedModels.insert(
+            static_cast<const Model *>(parent.get()));
+      }
+    }
+  }
+
+  this->dataPtr->dirtyPoses.clear();
+}
+
 /////////////////////////////////////////////////
 void World::_AddDirty(Entity *_entity)
 {
@@ -3235,6 +5038,152 @@ void World::_AddDirty(Entity *_entity)
   this->dataPtr->dirtyPoses.push_back(_entity);
 }
 
+/////////////////////////////////////////////////
+void World::_ModelMoved(Model *_model)
+{
+  if (this->dataPtr->sceneQueries)
+    this->dataPtr->sceneQueries->Refresh();
+
+  if (!this->dataPtr->modelIndexEnabled.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+  this->dataPtr->movedModels.insert(_model);
+}
+
+/////////////////////////////////////////////////
+void World::_LinksChanged()
+{
+  // The links are released after the mutex
+  Link_V links;
+  std::lock_guard<std::mutex> lock(this->dataPtr->allLinksMutex);
+  this->dataPtr->allLinksValid.store(false, std::memory_order_release);
+  links.swap(this->dataPtr->allLinks);
+}
+
+/////////////////////////////////////////////////
+void World::ModelsInVolume(
+    const std::function<bool (const ignition::math::AxisAlignedBox &)>
+    &_overlaps, Model_V &_models)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->modelIndexMutex);
+  this->dataPtr->modelIndexEnabled.store(true, std::memory_order_release);
+  this->UpdateModelIndex();
+
+  std::vector<unsigned int> candidates = this->dataPtr->unboundedModels;
+  this->dataPtr->modelTree.Query(_overlaps,
+      [&candidates](const unsigned int _index)
+      {
+        candidates.push_back(_index);
+      });
+  std::sort(candidates.begin(), candidates.end());
+
+  for (auto const index : candidates)
+  {
+    const ModelPtr &model = this->dataPtr->indexedModels[index];
+    if (_overlaps(model->BoundingBox()))
+      _models.push_back(model);
+  }
+}
+
+/////////////////////////////////////////////////
+void World::UpdateModelIndex()
+{
+  if (this->dataPtr->modelIndexDirty)
+  {
+    this->dataPtr->modelTree.Clear();
+    this->dataPtr->indexedModels.clear();
+    this->dataPtr->modelProxies.clear();
+    this->dataPtr->unboundedModels.clear();
+    this->dataPtr->modelIndices.clear();
+    this->dataPtr->movedModels.clear();
+
+    // Depth first, so that nested models follow their parent
+    Model_V stack(this->dataPtr->models.rbegin(),
+        this->dataPtr->models.rend());
+    while (!stack.empty())
+    {
+      ModelPtr model = stack.back();
+      stack.pop_back();
+
+      this->dataPtr->modelIndices[model.get()] =
+          this->dataPtr->indexedModels.size();
+      this->dataPtr->movedModels.insert(model.get());
+      this->dataPtr->indexedModels.push_back(model);
+      this->dataPtr->modelProxies.push_back(-2);
+
+      const Model_V &nested = model->NestedModels();
+      stack.insert(stack.end(), nested.rbegin(), nested.rend());
+    }
+    this->dataPtr->modelIndexDirty = false;
+  }
+
+  if (this->dataPtr->movedModels.empty())
+    return;
+
+  // A model that is moved as a whole moves its nested models
+  std::vector<bool> updated(this->dataPtr->indexedModels.size(), false);
+  std::vector<const Model *> stack(this->dataPtr->movedModels.begin(),
+      this->dataPtr->movedModels.end());
+  this->dataPtr->movedModels.clear();
+
+  bool unboundedChanged = false;
+  while (!stack.empty())
+  {
+    const Model *model = stack.back();
+    stack.pop_back();
+
+    auto iter = this->dataPtr->modelIndices.find(model);
+    if (iter == this->dataPtr->modelIndices.end() || updated[iter->second])
+      continue;
+    const unsigned int index = iter->second;
+    updated[index] = true;
+
+    for (auto const &nested : model->NestedModels())
+      stack.push_back(nested.get());
+
+    const ignition::math::AxisAlignedBox box = model->BoundingBox();
+    const ignition::math::Vector3d &min = box.Min();
+    const ignition::math::Vector3d &max = box.Max();
+    const bool finite =
+        std::isfinite(min.X()) && std::isfinite(min.Y()) &&
+        std::isfinite(min.Z()) && std::isfinite(max.X()) &&
+        std::isfinite(max.Y()) && std::isfinite(max.Z()) &&
+        min.X() <= max.X() && min.Y() <= max.Y() && min.Z() <= max.Z();
+
+    int &proxy = this->dataPtr->modelProxies[index];
+    if (finite)
+    {
+      if (proxy >= 0)
+      {
+        this->dataPtr->modelTree.Update(proxy, box);
+      }
+      else
+      {
+        unboundedChanged = unboundedChanged || proxy == -1;
+        proxy = this->dataPtr->modelTree.Insert(box, index);
+      }
+    }
+    else if (proxy != -1)
+    {
+      if (proxy >= 0)
+        this->dataPtr->modelTree.Remove(proxy);
+      proxy = -1;
+      unboundedChanged = true;
+    }
+  }
+
+  if (unboundedChanged)
+  {
+    this->dataPtr->unboundedModels.clear();
+    for (unsigned int i = 0; i < this->dataPtr->modelProxies.size(); ++i)
+    {
+      if (this->dataPtr->modelProxies[i] == -1)
+        this->dataPtr->unboundedModels.push_back(i);
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 void World::ResetPhysicsStates()
 {
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_PHYSICS_WORLD_HH_
 #define GAZEBO_PHYSICS_WORLD_HH_
 
+#include <functional>
 #include <vector>
 #include <list>
 #include <set>
@@ -26,6 +27,8 @@
 
 #include <boost/enable_shared_from_this.hpp>
 
+#include <ignition/math/AxisAlignedBox.hh>
+
 #include <sdf/sdf.hh>
 
 #include "gazebo/transport/TransportTypes.hh"
@@ -39,7 +42,13 @@
 
 #include "gazebo/physics/Base.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/WorldState.hh"
+#include "gazebo/physics/ForceFields.hh"
+#include "gazebo/physics/RegionTriggers.hh"
+#include "gazebo/physics/SceneQueries.hh"
+#include "gazebo/physics/SleepManager.hh"
+#include "gazebo/physics/StepState.hh"
 #include "gazebo/physics/Wind.hh"
 #include "gazebo/util/system.hh"
 
@@ -155,6 +164,40 @@ namespace gazebo
       /// \return Reference to the wind.
       public: physics::Wind &Wind() const;
 
+      /// \brief Get a reference to the force fields of the world.
+      /// \return Reference to the force fields.
+      public: physics::ForceFields &ForceFields() const;
+
+      /// \brief Get a reference to the region triggers of the world.
+      /// \return Reference to the region triggers.
+      public: physics::RegionTriggers &RegionTriggers() const;
+
+      /// \brief Get a reference to the scene queries of the world.
+      /// \return Reference to the scene queries.
+      public: physics::SceneQueries &SceneQueries() const;
+
+      /// \brief Get the publisher of the state of the world after each
+      /// step, that threads read without locking against the step.
+      /// \return Reference to the publisher.
+      public: StepStatePublisher &StepStates() const;
+
+      /// \brief Get the manager that puts the idle models to sleep.
+      /// \return Reference to the sleep manager.
+      public: physics::SleepManager &SleepManager() const;
+
+      /// \brief Set whether a checksum of the state is computed after each
+      /// step. It mixes the iteration count with the bits of the poses and
+      /// velocities of all the links, and is written to the log with the
+      /// iteration count. Two runs diverge at the first iteration whose
+      /// checksums differ.
+      /// \param[in] _enable True to compute the checksum.
+      /// \sa ODEPhysics::SetDeterministic
+      public: void SetStateChecksum(const bool _enable);
+
+      /// \brief Get the checksum of the state after the last step.
+      /// \return The checksum, 0 if it isn't computed.
+      public: uint64_t StateChecksum() const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr SphericalCoords() const;
@@ -194,6 +237,21 @@ namespace gazebo
       /// \return A list of all the Models in the world.
       public: Model_V Models() const;
 
+      /// \brief Get the models without a copy. The world adds and removes
+      /// models on its update thread, so the list can be iterated there,
+      /// such as in the update callbacks of plugins.
+      /// \return The models, valid until a model is added or removed.
+      /// \sa Models
+      public: const Model_V &ModelsRef() const;
+
+      /// \brief Get the links of all the models, nested models included.
+      /// The list is cached until links or models are added or removed, so
+      /// that iterating it doesn't allocate.
+      /// \return The links, valid until links or models are added or
+      /// removed.
+      /// \sa Model::AllLinks
+      public: const Link_V &AllLinks() const;
+
       /// \brief Get the number of lights.
       /// \return The number of lights in the World.
       public: unsigned int LightCount() const;
@@ -248,12 +306,18 @@ namespace gazebo
       public: void SetPaused(const bool _p);
 
       /// \brief Get an element by name.
-      /// Searches the list of entities, and return a pointer to the model
-      /// with a matching _name.
+      /// Searches the index of the entities, and return a pointer to the
+      /// entity with a matching scoped name or, if there is none, with a
+      /// matching name. Of several matches, the first loaded is returned.
       /// \param[in] _name The name of the Model to find.
       /// \return A pointer to the entity, or NULL if no entity was found.
       public: BasePtr BaseByName(const std::string &_name) const;
 
+      /// \brief Get an element by id.
+      /// \param[in] _id The id of the entity, see Base::GetId.
+      /// \return A pointer to the entity, or NULL if no entity was found.
+      public: BasePtr BaseById(const uint32_t _id) const;
+
       /// \brief Get a model by name.
       /// This function is the same as BaseByName, but limits the search to
       /// only models.
@@ -297,6 +361,24 @@ namespace gazebo
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Save the dynamic state of the world into a snapshot: the
+      /// sim time, the state of the physics engine, such as the pose and
+      /// velocity of each link, and the state of the joint controllers.
+      /// This is much faster than saving a WorldState, and meant for
+      /// resetting a world many times to the same state.
+      /// \param[out] _snapshot Snapshot that receives the state. Its
+      /// buffer is reused.
+      /// \sa RestoreSnapshot
+      public: void SaveSnapshot(WorldSnapshot &_snapshot);
+
+      /// \brief Restore a state saved by SaveSnapshot. With the ODE
+      /// engine, the simulation continues exactly as it did after the
+      /// state was saved.
+      /// \param[in] _snapshot The saved state.
+      /// \return False if the snapshot isn't valid or doesn't match the
+      /// entities of this world.
+      public: bool RestoreSnapshot(const WorldSnapshot &_snapshot);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world base on and SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -312,6 +394,17 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Insert copies of a model using SDF.
+      /// Spawns one model per pose, all cloned from the same parsed SDF, as
+      /// a single batch.
+      /// \param[in] _sdf A reference to an SDF object with one model.
+      /// \param[in] _poses Pose of each copy.
+      /// \param[in] _names Name of each copy. Copies without a name use the
+      /// name of the model, made unique.
+      public: void InsertModelCopies(const sdf::SDF &_sdf,
+                  const std::vector<ignition::math::Pose3d> &_poses,
+                  const std::vector<std::string> &_names);
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -327,10 +420,35 @@ namespace gazebo
       /// engine should not update an entity.
       public: void DisableAllModels();
 
+      /// \brief Set the world poses of many models at once, such as the
+      /// kinematic models that plugins move at each step. The physics
+      /// update mutex and the world pose mutex are locked once for the
+      /// batch, and the poses are published with the next pose message,
+      /// instead of once per model as with Entity::SetWorldPose().
+      /// \param[in] _models The models.
+      /// \param[in] _poses The world pose of each model.
+      /// \sa Model::SetKinematic
+      public: void SetModelPoses(const Model_V &_models,
+                  const std::vector<ignition::math::Pose3d> &_poses);
+
       /// \brief Step the world forward in time.
       /// \param[in] _steps The number of steps the World should take.
       public: void Step(const unsigned int _steps);
 
+      /// \brief Run physics iterations back to back from the calling
+      /// thread, for offline data generation. Unlike Step(unsigned int),
+      /// the update rate isn't throttled, and world statistics, contacts
+      /// and poses are only published every _flushPeriod iterations and
+      /// after the last one. The world is paused if it isn't, and the
+      /// world thread waits until the batch is done.
+      /// \param[in] _steps Number of iterations to run.
+      /// \param[in] _flushPeriod Number of iterations between
+      /// publications, or 0 to publish only at the end of the batch.
+      /// \return Number of iterations run, fewer than _steps if the world
+      /// was stopped.
+      public: unsigned int StepBatch(const unsigned int _steps,
+                                     const unsigned int _flushPeriod = 0);
+
       /// \brief Load a plugin
       /// \param[in] _filename The filename of the plugin.
       /// \param[in] _name A unique name for the plugin.
@@ -400,6 +518,68 @@ namespace gazebo
       /// \param[in] _light Pointer to the light to publish.
       public: void PublishLightPose(const physics::LightPtr _light);
 
+      /// \brief Set the maximum rate of ~/world_stats messages, in
+      /// messages per second of sim time. A paused or slow world also
+      /// publishes at this rate in wall time. Pausing or resuming the
+      /// world publishes right away.
+      /// \param[in] _hz Maximum rate, or zero to publish on every step,
+      /// which is the default.
+      /// \sa WorldStatsPublishRate
+      public: void SetWorldStatsPublishRate(const double _hz);
+
+      /// \brief Get the maximum rate of ~/world_stats messages.
+      /// \return Rate in messages per second of sim time, zero if every
+      /// step publishes.
+      /// \sa SetWorldStatsPublishRate
+      public: double WorldStatsPublishRate() const;
+
+      /// \brief Set the maximum rate of ~/pose/info messages, counted like
+      /// the world statistics rate. Each message holds every model and
+      /// light that moved since the previous one.
+      /// \param[in] _hz Maximum rate, or zero to publish on every step,
+      /// which is the default.
+      /// \sa PosePublishRate
+      public: void SetPosePublishRate(const double _hz);
+
+      /// \brief Get the maximum rate of ~/pose/info messages.
+      /// \return Rate in messages per second of sim time, zero if every
+      /// step publishes.
+      /// \sa SetPosePublishRate
+      public: double PosePublishRate() const;
+
+      /// \brief Set the maximum rate of ~/pose/local/info messages,
+      /// counted like the world statistics rate. Rendering sensors time
+      /// stamp their data with these messages, so a low rate delays them.
+      /// \param[in] _hz Maximum rate, or zero to publish on every step,
+      /// which is the default.
+      /// \sa LocalPosePublishRate
+      public: void SetLocalPosePublishRate(const double _hz);
+
+      /// \brief Get the maximum rate of ~/pose/local/info messages.
+      /// \return Rate in messages per second of sim time, zero if every
+      /// step publishes.
+      /// \sa SetLocalPosePublishRate
+      public: double LocalPosePublishRate() const;
+
+      /// \brief Set the maximum rate of ~/state/stream messages, counted
+      /// like the world statistics rate. Each message holds the world
+      /// poses and velocities of the models and links that moved since the
+      /// previous one, and the positions and velocities of their joints,
+      /// in packed arrays. The entities are referred to by id, and listed
+      /// on ~/state/schema, which is latched and published again when
+      /// models are inserted or removed. A message with every model
+      /// follows each schema and each new subscriber.
+      /// \param[in] _hz Maximum rate, or zero to publish on every step,
+      /// which is the default.
+      /// \sa StateStreamRate
+      public: void SetStateStreamRate(const double _hz);
+
+      /// \brief Get the maximum rate of ~/state/stream messages.
+      /// \return Rate in messages per second of sim time, zero if every
+      /// step publishes.
+      /// \sa SetStateStreamRate
+      public: double StateStreamRate() const;
+
       /// \brief Get the total number of iterations.
       /// \return Number of iterations that simulation has taken.
       public: uint32_t Iterations() const;
@@ -426,6 +606,21 @@ namespace gazebo
       /// \param[in] _name Name of the model to remove.
       public: void RemoveModel(const std::string &_name);
 
+      /// \brief Remove several models, or lights, by name. The world's
+      /// lists are updated in one pass, and clients receive a single
+      /// "entities_delete" request for all the entities, instead of a
+      /// request per model, link, collision and visual. This function will
+      /// block until the physics engine is not locked.
+      /// \param[in] _names Names of the models and lights to remove.
+      /// \sa msgs::CreateDeleteRequest
+      public: void RemoveModels(const std::vector<std::string> &_names);
+
+      /// \brief Get whether RemoveModels is removing entities. The
+      /// entities don't request the deletion of their visuals then, since
+      /// the world requests it once for all of them.
+      /// \return True while RemoveModels finalizes entities.
+      public: bool RemovingModels() const;
+
       /// \brief Reset the velocity, acceleration, force and torque of
       /// all child models.
       public: void ResetPhysicsStates();
@@ -438,10 +633,42 @@ namespace gazebo
       /// \param[in] _entity Entity that has moved.
       public: void _AddDirty(Entity *_entity);
 
+      /// \internal
+      /// \brief Inform the World that the bounding box of a model and its
+      /// nested models may have changed, after a pose was set.
+      /// \param[in] _model The model.
+      public: void _ModelMoved(Model *_model);
+
+      /// \internal
+      /// \brief Inform the World that links or nested models were added to
+      /// or removed from a model, so that AllLinks() is rebuilt.
+      public: void _LinksChanged();
+
+      /// \brief Get the models, including the nested models, whose
+      /// bounding box overlaps a volume. The bounding boxes are kept in a
+      /// tree that follows the poses of the links, so that only the models
+      /// near the volume are tested. The tree is built by the first call.
+      /// \param[in] _overlaps Tells whether a box overlaps the volume. It
+      /// is called on the boxes of the tree before the bounding boxes of
+      /// the models, and may return true for a box that is only close to
+      /// the volume.
+      /// \param[out] _models The models whose bounding box overlaps the
+      /// volume are appended, in the order of Models() with the nested
+      /// models after their parent.
+      public: void ModelsInVolume(
+          const std::function<bool (const ignition::math::AxisAlignedBox &)>
+          &_overlaps, Model_V &_models);
+
       /// \brief Get whether sensors have been initialized.
       /// \return True if sensors have been initialized.
       public: bool SensorsInitialized() const;
 
+      /// \brief Get whether the plugins of the world and of its models
+      /// have been loaded, which happens in the first step once the
+      /// sensors are initialized.
+      /// \return True if the plugins have been loaded.
+      public: bool PluginsLoaded() const;
+
       /// \internal
       /// \brief Set whether sensors have been initialized. This should only
       /// be called by SensorManager.
@@ -473,6 +700,31 @@ namespace gazebo
       private: ModelPtr ModelById(const unsigned int _id) const;
       /// \endcond
 
+      /// \brief Find an entity in the index of the entities.
+      /// \param[in] _name Scoped name or name of the entity.
+      /// \param[in] _ancestor Only entities below or equal to this one are
+      /// returned, nullptr for any entity.
+      /// \return The entity, NULL if not found.
+      /// \sa BaseByName
+      private: BasePtr IndexedEntityByName(const std::string &_name,
+                   const Base *_ancestor) const;
+
+      /// \brief Add an entity to the index of the entities, or update its
+      /// names after a rename. Called by Base.
+      /// \param[in] _entity The entity.
+      private: void AddToEntityIndex(const BasePtr &_entity);
+
+      /// \brief Remove an entity from the index of the entities. Called by
+      /// Base.
+      /// \param[in] _id Id of the entity.
+      private: void RemoveFromEntityIndex(const uint32_t _id);
+
+      /// \brief Tell whether an entity is in the index of the entities.
+      /// Called by Base.
+      /// \param[in] _id Id of the entity.
+      /// \return True if the entity was added and not removed yet.
+      private: bool InEntityIndex(const uint32_t _id) const;
+
       /// \brief Load all plugins.
       ///
       /// Load all plugins specified in the SDF for the model.
@@ -483,6 +735,16 @@ namespace gazebo
       /// \param[in] _parent Parent of the model to load.
       private: void LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent);
 
+      /// \brief Load the meshes used by all collisions in parallel, so that
+      /// the serial LoadEntities finds them already loaded in the
+      /// MeshManager.
+      /// \param[in] _sdf SDF element of the world.
+      private: void PrefetchMeshes(sdf::ElementPtr _sdf);
+
+      /// \brief Fill the lists of links, joints and joint controllers
+      /// used by snapshots, in model order.
+      private: void CollectSnapshotEntities();
+
       /// \brief Load a model.
       /// \param[in] _sdf SDF element containing the Model description.
       /// \param[in] _parent Parent of the model.
@@ -520,6 +782,11 @@ namespace gazebo
       /// \brief Update the world.
       private: void Update();
 
+      /// \brief Propagate the poses set by the physics engine to the
+      /// entities in dirtyPoses, under a single lock of the world pose
+      /// mutex. The caller must hold the physics update mutex.
+      private: void ApplyDirtyPoses();
+
       /// \brief Pause callback.
       /// \param[in] _p True if paused.
       private: void OnPause(bool _p);
@@ -531,6 +798,11 @@ namespace gazebo
       /// \param[in] _data The world control message.
       private: void OnControl(ConstWorldControlPtr &_data);
 
+      /// \brief Called when an iteration profiler control message is
+      /// received.
+      /// \param[in] _msg The profiler control message.
+      private: void OnProfileControl(ConstProfileControlPtr &_msg);
+
       /// \brief Called when log playback control message is received.
       /// \param[in] _data The log playback control message.
       private: void OnPlaybackControl(ConstLogPlaybackControlPtr &_data);
@@ -563,6 +835,11 @@ namespace gazebo
       /// \brief Single loop version of model updating.
       private: void ModelUpdateSingleLoop();
 
+      /// \brief Call the local update callbacks of the models, concurrently
+      /// when there are several model update threads.
+      /// \sa Model::ConnectLocalUpdate
+      private: void LocalUpdate();
+
       /// \brief Helper function to load a plugin from SDF.
       /// \param[in] _sdf SDF plugin description.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
@@ -580,6 +857,11 @@ namespace gazebo
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessRequestMsgs();
 
+      /// \brief Fill the pending scene_info and entity_list requests for a
+      /// short time, and queue the responses of the complete ones.
+      /// Must only be called from the World::ProcessMessages function.
+      private: void ProcessSceneRequests();
+
       /// \brief Process all received factory messages.
       /// Must only be called from the World::ProcessMessages function.
       private: void ProcessFactoryMsgs();
@@ -616,6 +898,19 @@ namespace gazebo
       /// \brief Thread function for logging state data.
       private: void LogWorker();
 
+      /// \brief Compare the models and lights in the world against the ones
+      /// seen at the previous call, and update the stored set.
+      /// \param[out] _insertions SDF of the inserted models and lights.
+      /// \param[out] _deletions Names of the deleted models and lights.
+      /// \return True if there was at least one insertion or deletion.
+      private: bool LogInsertionsDeletions(
+                   std::vector<std::string> &_insertions,
+                   std::vector<std::string> &_deletions);
+
+      /// \brief Bring the model bounding box tree up to date with the
+      /// model list and the models that moved.
+      private: void UpdateModelIndex();
+
       /// \brief Register items in the introspection service.
       private: void RegisterIntrospectionItems();
 
@@ -660,6 +955,9 @@ namespace gazebo
 
       /// Friend SimbodyPhysics so that it has access to dataPtr->dirtyPoses
       private: friend class SimbodyPhysics;
+
+      /// Friend Base so that it maintains the index of the entities
+      private: friend class Base;
     };
     /// \}
   }
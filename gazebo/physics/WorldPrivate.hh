@@ -28,10 +28,17 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <ignition/transport.hh>
 
+#include <tbb/task_arena.h>
+
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/LockProfiler.hh"
+#include "gazebo/common/MemoryAccounts.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/URI.hh"
 
@@ -39,18 +46,140 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/AABBTree.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/physics/StepTelemetry.hh"
 #include "gazebo/physics/WorldState.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief Mutex of the world that reports its contention.
+    typedef common::ProfiledMutex<std::mutex> WorldMutex;
+
+    /// \brief Recursive mutex of the world that reports its contention.
+    typedef common::ProfiledMutex<std::recursive_mutex> WorldRecursiveMutex;
+
+    /// \brief An entity in the index of the entities of the world.
+    class IndexedEntity
+    {
+      /// \brief The entity, expired while it is destroyed.
+      public: boost::weak_ptr<Base> entity;
+
+      /// \brief Name under which the entity is indexed.
+      public: std::string name;
+
+      /// \brief Scoped name under which the entity is indexed.
+      public: std::string scopedName;
+    };
+
+    /// \brief Limits how often a topic is published. The period is
+    /// counted in sim time, so that the number of messages doesn't depend
+    /// on the physics update rate. It is also counted in wall time, so
+    /// that a paused or slow world still publishes.
+    class PublishThrottle
+    {
+      /// \brief Check whether a message is due, and start a new period if
+      /// it is.
+      /// \param[in] _simTime Current sim time.
+      /// \return True if the message should be published.
+      public: bool Due(const common::Time &_simTime)
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (this->period <= common::Time::Zero)
+                  return true;
+
+                const common::Time wallTime = common::Time::GetWallTime();
+                if (!this->expired && _simTime >= this->prevSimTime &&
+                    _simTime - this->prevSimTime < this->period &&
+                    wallTime - this->prevWallTime < this->period)
+                {
+                  return false;
+                }
+
+                this->expired = false;
+                this->prevSimTime = _simTime;
+                this->prevWallTime = wallTime;
+                return true;
+              }
+
+      /// \brief Make the next call to Due return true.
+      public: void Expire()
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->expired = true;
+              }
+
+      /// \brief Set the maximum rate.
+      /// \param[in] _hz Messages per second, zero for no limit.
+      public: void SetRate(const double _hz)
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->period =
+                    _hz > 0 ? common::Time(1.0 / _hz) : common::Time::Zero;
+                this->expired = true;
+              }
+
+      /// \brief Get the maximum rate.
+      /// \return Messages per second, zero for no limit.
+      public: double Rate() const
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                return this->period > common::Time::Zero ?
+                    1.0 / this->period.Double() : 0.0;
+              }
+
+      /// \brief Minimum time between two messages, zero to publish every
+      /// time.
+      private: common::Time period;
+
+      /// \brief Sim time of the last message.
+      private: common::Time prevSimTime;
+
+      /// \brief Wall time of the last message.
+      private: common::Time prevWallTime;
+
+      /// \brief True if the next message is due regardless of the period.
+      private: bool expired = false;
+
+      /// \brief Protects the members, since the rate is set from other
+      /// threads than the world thread.
+      private: mutable std::mutex mutex;
+    };
+
+    /// \brief A scene_info or entity_list request. Its models are filled
+    /// a few at a time, at each step of the world, so that a large world
+    /// doesn't stall while a client joins. The scene_info requests that
+    /// arrive while one is filled share it.
+    class WorldSceneRequest
+    {
+      /// \brief The responses, without their data.
+      public: std::vector<msgs::Response> responses;
+
+      /// \brief True for scene_info, false for entity_list.
+      public: bool scene = true;
+
+      /// \brief Models to fill, in order.
+      public: std::vector<boost::weak_ptr<Model>> models;
+
+      /// \brief Index of the next model to fill.
+      public: std::size_t next = 0;
+
+      /// \brief The filled models, and the lights once all the models are
+      /// filled.
+      public: msgs::Scene msg;
+
+      /// \brief Model of each filled model message.
+      public: std::vector<boost::weak_ptr<Model>> filled;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
-      /// \brief For keeping track of time step throttling.
-      public: common::Time prevStepWallTime;
+      /// \brief For keeping track of time step throttling, steady time of
+      /// the previous step in nanoseconds, see common::Time::SteadyNs.
+      public: int64_t prevStepNs = 0;
 
       /// \brief Pointer the physics engine.
       public: PhysicsEnginePtr physicsEngine;
@@ -58,6 +187,29 @@ namespace gazebo
       /// \brief Unique pointer the wind. The world owns this pointer.
       public: std::unique_ptr<Wind> wind;
 
+      /// \brief Force fields, run before each physics update.
+      public: std::unique_ptr<ForceFields> forceFields;
+
+      /// \brief Region triggers, evaluated after the world update begin
+      /// event.
+      public: std::unique_ptr<RegionTriggers> regionTriggers;
+
+      /// \brief Rays, sweeps and overlap tests against a snapshot of the
+      /// collisions.
+      public: std::unique_ptr<SceneQueries> sceneQueries;
+
+      /// \brief Publishes the state of the world after each step.
+      public: std::unique_ptr<StepStatePublisher> stepStates;
+
+      /// \brief Puts the idle models to sleep after each physics update.
+      public: std::unique_ptr<SleepManager> sleepManager;
+
+      /// \brief True to compute a checksum of the state after each step.
+      public: bool stateChecksumEnabled;
+
+      /// \brief Checksum of the state after the last step.
+      public: uint64_t stateChecksum;
+
       /// \brief Unique pointer the atmosphere model.
       /// The world owns this pointer.
       public: std::unique_ptr<Atmosphere> atmosphere;
@@ -86,12 +238,19 @@ namespace gazebo
       /// \brief Clock time when simulation was started.
       public: common::Time startTime;
 
+      /// \brief Steady time when simulation was started, in nanoseconds.
+      public: int64_t startNs = 0;
+
       /// \brief True if simulation is paused.
       public: bool pause;
 
       /// \brief Number of steps in increment by.
       public: int stepInc;
 
+      /// \brief Notified, with worldUpdateMutex, when stepInc drops to 0
+      /// or the world stops. World::Step(steps) waits on it.
+      public: std::condition_variable_any stepCond;
+
       /// \brief All the event connections.
       public: event::Connection_V connections;
 
@@ -101,9 +260,18 @@ namespace gazebo
       /// \brief Publisher for world statistics messages.
       public: transport::PublisherPtr statPub;
 
+      /// \brief Publisher for step telemetry messages.
+      public: transport::PublisherPtr stepStatsPub;
+
       /// \brief Publisher for request response messages.
       public: transport::PublisherPtr responsePub;
 
+      /// \brief Publisher for the requests that delete removed entities.
+      public: transport::PublisherPtr requestPub;
+
+      /// \brief True while RemoveModels finalizes entities.
+      public: std::atomic<bool> removingModels{false};
+
       /// \brief Publisher for model messages.
       public: transport::PublisherPtr modelPub;
 
@@ -122,12 +290,22 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher of the state stream, on ~/state/stream.
+      public: transport::PublisherPtr statePub;
+
+      /// \brief Publisher of the schema of the state stream, on
+      /// ~/state/schema.
+      public: transport::PublisherPtr stateSchemaPub;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
       /// \brief Subscriber to log playback control messages.
       public: transport::SubscriberPtr playbackControlSub;
 
+      /// \brief Subscriber to the iteration profiler control messages.
+      public: transport::SubscriberPtr profileSub;
+
       /// \brief Subscriber to factory messages.
       public: transport::SubscriberPtr factorySub;
 
@@ -155,20 +333,60 @@ namespace gazebo
       /// \brief Outgoing scene message.
       public: msgs::Scene sceneMsg;
 
+      /// \brief Messages of the models of the scene, by model id, filled
+      /// once by Model::FillMsg. Model messages and scaling drop them, and
+      /// the poses and states are refreshed for each request.
+      public: std::unordered_map<uint32_t, msgs::Model> sceneModels;
+
       /// \brief Function pointer to the model update function.
       public: void (World::*modelUpdateFunc)();
 
-      /// \brief Last time a world statistics message was sent.
-      public: common::Time prevStatTime;
+      /// \brief Task arena limiting the number of threads used by
+      /// World::ModelUpdateTBB.
+      public: std::unique_ptr<tbb::task_arena> modelUpdateArena;
+
+      /// \brief Models updated concurrently by World::ModelUpdateTBB.
+      /// Kept here to avoid reallocating every iteration.
+      public: Model_V parallelUpdateModels;
+
+      /// \brief Top level entities updated serially by
+      /// World::ModelUpdateTBB.
+      public: Base_V serialUpdateEntities;
+
+      /// \brief Top level models with local update callbacks that run
+      /// concurrently in World::LocalUpdate.
+      public: Model_V parallelLocalModels;
+
+      /// \brief Top level models with local update callbacks that run
+      /// serially in World::LocalUpdate.
+      public: Model_V serialLocalModels;
+
+      /// \brief Last steady time a world statistics message was sent, in
+      /// nanoseconds.
+      public: int64_t prevStatNs = 0;
 
-      /// \brief Time at which pause started.
-      public: common::Time pauseStartTime;
+      /// \brief Wall time and phases of the recent steps.
+      public: StepTelemetry stepTelemetry;
 
-      /// \brief Used to compute a more accurate real time value.
-      public: common::Time realTimeOffset;
+      /// \brief Phases of the current update, only used by World::Update
+      /// under worldUpdateMutex.
+      public: StepTelemetry::StepSample updateSample;
+
+      /// \brief Outgoing step telemetry message.
+      public: msgs::StepStatistics stepStatsMsg;
+
+      /// \brief Last steady time the step telemetry window was closed, in
+      /// nanoseconds.
+      public: int64_t prevStepStatsNs = 0;
+
+      /// \brief Steady time at which pause started, in nanoseconds.
+      public: int64_t pauseStartNs = 0;
+
+      /// \brief Time spent paused in nanoseconds, left out of the real time.
+      public: int64_t realTimeOffsetNs = 0;
 
       /// \brief Mutex to protect incoming message buffers.
-      public: std::recursive_mutex receiveMutex;
+      public: WorldRecursiveMutex receiveMutex{"physics/world_receive"};
 
       /// \brief Mutex to protext loading of models.
       public: std::mutex loadModelMutex;
@@ -188,7 +406,12 @@ namespace gazebo
       /// and waits on setpInc on World::stepIhc as it's decremented.
       /// World::Reset while World::ResetTime, entities, World::physicsEngine
       /// World::SetPaused to assign world::pause
-      public: std::recursive_mutex worldUpdateMutex;
+      public: WorldRecursiveMutex worldUpdateMutex{"physics/world_update"};
+
+      /// \brief Account of the physics update mutex, which is part of the
+      /// public API of the physics engine, as locked by the world.
+      public: common::LockStats *physicsLockStats =
+          common::LockProfiler::Instance()->Stats("physics/physics_update");
 
       /// \brief The world's current SDF description.
       public: sdf::ElementPtr sdf;
@@ -202,6 +425,24 @@ namespace gazebo
       /// \brief Request message buffer.
       public: std::list<msgs::Request> requestMsgs;
 
+      /// \brief scene_info and entity_list requests being filled.
+      public: std::deque<WorldSceneRequest> sceneRequests;
+
+      /// \brief Thread that serializes and publishes the large responses.
+      public: std::thread responseThread;
+
+      /// \brief Responses waiting to be serialized and published.
+      public: std::deque<std::function<void()>> responseJobs;
+
+      /// \brief True to stop the response thread once its jobs are done.
+      public: bool stopResponses = false;
+
+      /// \brief Protects the response jobs.
+      public: std::mutex responseMutex;
+
+      /// \brief Signaled when a response is queued or the thread must stop.
+      public: std::condition_variable responseCondition;
+
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
@@ -229,6 +470,10 @@ namespace gazebo
       /// \brief True to reset only model poses.
       public: bool resetModelOnly;
 
+      /// \brief True to clear all the models at the end of the next
+      /// update.
+      public: std::atomic<bool> clearModels;
+
       /// \brief True if the world has been initialized.
       public: bool initialized;
 
@@ -248,29 +493,41 @@ namespace gazebo
       public: RayShapePtr testRay;
 
       /// \brief True if the plugins have been loaded.
-      public: bool pluginsLoaded;
+      public: std::atomic<bool> pluginsLoaded;
 
-      /// \brief sleep timing error offset due to clock wake up latency
-      public: common::Time sleepOffset;
+      /// \brief sleep timing error offset due to clock wake up latency, in
+      /// nanoseconds
+      public: int64_t sleepOffsetNs = 0;
 
-      /// \brief Last time incoming messages were processed.
-      public: common::Time prevProcessMsgsTime;
+      /// \brief Last steady time incoming messages were processed, in
+      /// nanoseconds.
+      public: int64_t prevProcessMsgsNs = 0;
 
       /// \brief Period over which messages should be processed.
-      public: common::Time processMsgsPeriod;
+      public: int64_t processMsgsPeriodNs = 0;
 
       /// \brief Alternating buffer of states.
       public: std::deque<WorldState> states[2];
 
+      /// \brief Estimated bytes of each buffer of states.
+      public: int64_t stateBytes[2] = {0, 0};
+
+      /// \brief Memory account of the buffers of states.
+      public: common::MemoryAccount *stateMemory = nullptr;
+
       /// \brief Keep track of current state buffer being updated
       public: int currentStateBuffer;
 
       /// \brief Buffer of prev states
       public: WorldState prevStates[2];
 
-      /// \brief Previous unfiltered state. Used for determining insertions
-      /// and deletions
-      public: WorldState prevUnfilteredState;
+      /// \brief Names of the models present at the previous log update.
+      /// Used for determining insertions and deletions without loading
+      /// the full unfiltered world state.
+      public: std::set<std::string> logModelNames;
+
+      /// \brief Names of the lights present at the previous log update.
+      public: std::set<std::string> logLightNames;
 
       /// \brief Int used to toggle between prevStates
       public: int stateToggle;
@@ -294,6 +551,60 @@ namespace gazebo
       /// \brief The list of lights that need to publish their pose.
       public: std::set<LightPtr> publishLightPoses;
 
+      /// \brief The list of models whose pose wasn't published on
+      /// ~/pose/local/info yet. It differs from publishModelPoses when the
+      /// two topics are published at different rates.
+      public: std::set<ModelPtr> localModelPoses;
+
+      /// \brief The list of lights whose pose wasn't published on
+      /// ~/pose/local/info yet.
+      public: std::set<LightPtr> localLightPoses;
+
+      /// \brief Throttles ~/world_stats.
+      public: PublishThrottle statsThrottle;
+
+      /// \brief Throttles ~/pose/info.
+      public: PublishThrottle poseThrottle;
+
+      /// \brief Throttles ~/pose/local/info and the scene pose callback.
+      public: PublishThrottle localPoseThrottle;
+
+      /// \brief Pose message reused by ProcessMessages. Clearing it keeps
+      /// the allocated pose entries and name strings for the next step.
+      public: msgs::PosesStamped posesMsg;
+
+      /// \brief Queue of models visited while filling posesMsg, reused
+      /// between steps.
+      public: Model_V posesModelQueue;
+
+      /// \brief Throttles ~/state/stream.
+      public: PublishThrottle stateThrottle;
+
+      /// \brief Models that moved since the last state stream message.
+      public: std::set<ModelPtr> streamModels;
+
+      /// \brief Models that moved before the last state stream message.
+      /// They are sent once more, so that the models which stop are sent
+      /// at rest.
+      public: std::set<ModelPtr> streamPrevious;
+
+      /// \brief State stream message reused between messages.
+      public: msgs::StateStream stateMsg;
+
+      /// \brief Version of the schema of the state stream.
+      public: uint32_t stateSchemaVersion = 0;
+
+      /// \brief True when models were inserted or removed since the schema
+      /// was published.
+      public: std::atomic<bool> stateSchemaDirty{true};
+
+      /// \brief True if the state stream had subscribers at the last step.
+      public: bool stateConnected = false;
+
+      /// \brief Number of remote subscribers of the state stream at the
+      /// last step.
+      public: unsigned int stateSubscribers = 0;
+
       /// \brief Info passed through the WorldUpdateBegin event.
       public: common::UpdateInfo updateInfo;
 
@@ -304,11 +615,11 @@ namespace gazebo
       public: uint64_t stopIterations;
 
       /// \brief Condition used for log worker.
-      public: std::condition_variable logCondition;
+      public: std::condition_variable_any logCondition;
 
       /// \brief Condition used to guarantee the log worker thread doesn't
       /// skip an interation.
-      public: std::condition_variable logContinueCondition;
+      public: std::condition_variable_any logContinueCondition;
 
       /// \brief Last iteration recorded by the log worker thread.
       public: uint64_t logPrevIteration;
@@ -317,13 +628,13 @@ namespace gazebo
       public: common::Time logRealTime;
 
       /// \brief Mutex to protect the log worker thread.
-      public: std::mutex logMutex;
+      public: WorldMutex logMutex{"physics/world_log"};
 
       /// \brief Mutex to protect the log state buffers
       public: std::mutex logBufferMutex;
 
       /// \brief Mutex to protect the deleteEntity list.
-      public: std::mutex entityDeleteMutex;
+      public: WorldMutex entityDeleteMutex{"physics/entity_delete"};
 
       /// \brief Worker thread for logging.
       public: std::thread *logThread;
@@ -341,7 +652,7 @@ namespace gazebo
       /// \brief when physics engine makes an update and changes a link pose,
       /// this flag is set to trigger Entity::SetWorldPose on the
       /// physics::Link in World::Update.
-      public: std::list<Entity*> dirtyPoses;
+      public: std::vector<Entity*> dirtyPoses;
 
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
@@ -385,6 +696,75 @@ namespace gazebo
 
       /// \brief SDF World DOM object
       public: std::unique_ptr<sdf::World> worldSDFDom;
+
+      /// \brief Links of all the models, reused by snapshots.
+      public: Link_V snapshotLinks;
+
+      /// \brief Joints of all the models, reused by snapshots.
+      public: Joint_V snapshotJoints;
+
+      /// \brief Joint controllers of all the models, reused by snapshots.
+      public: JointController_V snapshotControllers;
+
+      /// \brief True while World::StepBatch runs iterations, which skips
+      /// the contact publishing of each update.
+      public: bool batchStepping;
+
+      /// \brief Tree of the bounding boxes of the models, used by
+      /// World::ModelsInVolume.
+      public: AABBTree modelTree;
+
+      /// \brief Models of the tree, depth first in the order of the world
+      /// models. The tree proxies hold indices into this list.
+      public: Model_V indexedModels;
+
+      /// \brief Tree proxy of each indexed model, -1 for the models whose
+      /// bounding box isn't finite.
+      public: std::vector<int> modelProxies;
+
+      /// \brief Indices of the models whose bounding box isn't finite,
+      /// such as empty models and models with a plane. They are always
+      /// tested.
+      public: std::vector<unsigned int> unboundedModels;
+
+      /// \brief Index of each indexed model.
+      public: std::unordered_map<const Model *, unsigned int> modelIndices;
+
+      /// \brief Models that moved since the tree was last updated.
+      public: std::unordered_set<const Model *> movedModels;
+
+      /// \brief True once the tree was built, after which the moved models
+      /// are tracked.
+      public: std::atomic<bool> modelIndexEnabled{false};
+
+      /// \brief True if models were added or removed since the tree was
+      /// built.
+      public: bool modelIndexDirty = true;
+
+      /// \brief Protects the model tree.
+      public: std::mutex modelIndexMutex;
+
+      /// \brief Links of all the models, see World::AllLinks.
+      public: Link_V allLinks;
+
+      /// \brief True if allLinks is up to date.
+      public: std::atomic<bool> allLinksValid{false};
+
+      /// \brief Protects allLinks.
+      public: std::mutex allLinksMutex;
+
+      /// \brief Indexed entities by id, see World::BaseByName.
+      public: std::unordered_map<uint32_t, IndexedEntity> entityIds;
+
+      /// \brief Ids of the indexed entities by scoped name.
+      public: std::unordered_multimap<std::string, uint32_t> entityScopedNames;
+
+      /// \brief Ids of the indexed entities by name.
+      public: std::unordered_multimap<std::string, uint32_t> entityNames;
+
+      /// \brief Protects the index of the entities. Entities aren't
+      /// released while it is held, since their Fini locks it.
+      public: std::mutex entityIndexMutex;
     };
   }
 }
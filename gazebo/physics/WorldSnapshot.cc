@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/WorldSnapshot.hh"
+#include "gazebo/physics/WorldSnapshotPrivate.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot()
+  : dataPtr(new WorldSnapshotPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot(const WorldSnapshot &_snapshot)
+  : dataPtr(new WorldSnapshotPrivate(*_snapshot.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot::~WorldSnapshot()
+{
+}
+
+/////////////////////////////////////////////////
+WorldSnapshot &WorldSnapshot::operator=(const WorldSnapshot &_snapshot)
+{
+  if (this != &_snapshot)
+    *this->dataPtr = *_snapshot.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool WorldSnapshot::Valid() const
+{
+  return this->dataPtr->valid;
+}
+
+/////////////////////////////////////////////////
+common::Time WorldSnapshot::SimTime() const
+{
+  return this->dataPtr->simTime;
+}
+
+/////////////////////////////////////////////////
+uint64_t WorldSnapshot::Iterations() const
+{
+  return this->dataPtr->iterations;
+}
+
+/////////////////////////////////////////////////
+std::size_t WorldSnapshot::Size() const
+{
+  return this->dataPtr->data.size() * sizeof(this->dataPtr->data[0]);
+}
+
+/////////////////////////////////////////////////
+void WorldSnapshot::Clear()
+{
+  this->dataPtr->valid = false;
+  this->dataPtr->data.clear();
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    // Forward declare private data class
+    class WorldSnapshotPrivate;
+
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief In-memory copy of the dynamic state of a world.
+    ///
+    /// World::SaveSnapshot stores the sim time, the state of the physics
+    /// engine and the state of the joint controllers into a contiguous
+    /// buffer, and World::RestoreSnapshot writes it back. Unlike
+    /// WorldState, a snapshot holds no names, links or models are matched
+    /// by order, so it can only be restored into the world it was saved
+    /// from, as long as no entity was added or removed. A snapshot can be
+    /// saved into repeatedly without allocating.
+    class GZ_PHYSICS_VISIBLE WorldSnapshot
+    {
+      /// \brief Constructor
+      public: WorldSnapshot();
+
+      /// \brief Copy constructor
+      /// \param[in] _snapshot Snapshot to copy.
+      public: WorldSnapshot(const WorldSnapshot &_snapshot);
+
+      /// \brief Destructor
+      public: virtual ~WorldSnapshot();
+
+      /// \brief Assignment operator
+      /// \param[in] _snapshot Snapshot to copy.
+      /// \return Reference to this snapshot.
+      public: WorldSnapshot &operator=(const WorldSnapshot &_snapshot);
+
+      /// \brief Get whether the snapshot holds a saved state.
+      /// \return True if a state was saved.
+      public: bool Valid() const;
+
+      /// \brief Get the sim time of the saved state.
+      /// \return The sim time.
+      public: common::Time SimTime() const;
+
+      /// \brief Get the number of iterations of the saved state.
+      /// \return The iteration count.
+      public: uint64_t Iterations() const;
+
+      /// \brief Get the size of the saved state.
+      /// \return Size in bytes.
+      public: std::size_t Size() const;
+
+      /// \brief Discard the saved state.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<WorldSnapshotPrivate> dataPtr;
+
+      /// \brief The world saves and restores the state.
+      private: friend class World;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_WORLDSNAPSHOTPRIVATE_HH_
+#define GAZEBO_PHYSICS_WORLDSNAPSHOTPRIVATE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \internal
+    /// \brief Private data for WorldSnapshot
+    class WorldSnapshotPrivate
+    {
+      /// \brief True if a state was saved.
+      public: bool valid = false;
+
+      /// \brief Sim time of the state.
+      public: common::Time simTime;
+
+      /// \brief Iteration count of the state.
+      public: uint64_t iterations = 0;
+
+      /// \brief Number of links the state was saved from.
+      public: std::size_t linkCount = 0;
+
+      /// \brief Number of joints the state was saved from.
+      public: std::size_t jointCount = 0;
+
+      /// \brief Number of joint controllers the state was saved from.
+      public: std::size_t controllerCount = 0;
+
+      /// \brief State of the physics engine followed by the state of the
+      /// joint controllers.
+      public: std::vector<double> data;
+    };
+  }
+}
+#endif
@@ -113,7 +113,7 @@ void WorldState::Load(const WorldPtr _world)
   std::list<std::string>::iterator partIter = parts.begin();
 
   // Add a state for all the models that match the filter
-  Model_V models = _world->Models();
+  const Model_V &models = _world->ModelsRef();
   for (Model_V::const_iterator iter = models.begin();
        iter != models.end(); ++iter)
   {
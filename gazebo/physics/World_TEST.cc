@@ -15,9 +15,27 @@
  *
 */
 
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/PID.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointController.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldState.hh"
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/util/LogPlay.hh"
+#include "gazebo/util/LogRecord.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -216,6 +234,817 @@ TEST_F(WorldTest, Stop)
   EXPECT_TRUE(world->Running());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that stepping with parallel model updates gives the same
+/// result as the serial model update.
+TEST_F(WorldTest, ParallelModelUpdate)
+{
+  this->Load("test/worlds/actuated_arms.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  EXPECT_EQ(0, physics->ModelUpdateThreads());
+
+  // Negative values disable parallel updates
+  physics->SetModelUpdateThreads(-3);
+  EXPECT_EQ(0, physics->ModelUpdateThreads());
+
+  EXPECT_TRUE(physics->SetParam("model_update_threads", 4));
+  EXPECT_EQ(4, boost::any_cast<int>(physics->GetParam("model_update_threads")));
+
+  // Every arm is driven to its own angle by its joint controller, which
+  // runs in the update of its model
+  std::vector<physics::ModelPtr> arms;
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    auto model = world->ModelByIndex(i);
+    EXPECT_TRUE(model->ParallelUpdateSafe()) << model->GetName();
+    if (model->GetJoint("hinge"))
+      arms.push_back(model);
+  }
+  ASSERT_EQ(16u, arms.size());
+
+  auto actuate = [&arms]()
+  {
+    for (unsigned int i = 0; i < arms.size(); ++i)
+    {
+      const std::string joint = arms[i]->GetName() + "::hinge";
+      auto controller = arms[i]->GetJointController();
+      controller->SetPositionPID(joint, common::PID(50, 0, 5));
+      EXPECT_TRUE(controller->SetPositionTarget(joint, 0.1 * i - 0.8));
+    }
+  };
+
+  // The controllers skip their first update after a reset, so both runs
+  // below start from a reset
+  actuate();
+  world->Step(100);
+  world->Reset();
+
+  actuate();
+  world->Step(500);
+  const auto parallelState = physics::WorldState(world);
+
+  world->Reset();
+  physics->SetModelUpdateThreads(0);
+  actuate();
+  world->Step(500);
+  const auto serialState = physics::WorldState(world);
+
+  for (unsigned int i = 0; i < arms.size(); ++i)
+  {
+    // The arms have moved towards their targets
+    if (i != 8)
+    {
+      EXPECT_GT(std::abs(arms[i]->GetJoint("hinge")->Position(0)), 0.05)
+        << arms[i]->GetName();
+    }
+  }
+
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    auto name = world->ModelByIndex(i)->GetName();
+    EXPECT_EQ(parallelState.GetModelState(name).Pose(),
+              serialState.GetModelState(name).Pose()) << name;
+    const auto parallelLinks =
+      parallelState.GetModelState(name).GetLinkStates();
+    const auto serialLinks = serialState.GetModelState(name).GetLinkStates();
+    for (auto const &link : parallelLinks)
+    {
+      EXPECT_EQ(link.second.Pose(), serialLinks.at(link.first).Pose())
+        << link.first;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the parameter of parallel plugin loads.
+TEST_F(WorldTest, PluginLoadThreads)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto physics = world->Physics();
+  ASSERT_NE(nullptr, physics);
+  EXPECT_EQ(0, physics->PluginLoadThreads());
+
+  // Negative values disable parallel loads
+  physics->SetPluginLoadThreads(-3);
+  EXPECT_EQ(0, physics->PluginLoadThreads());
+
+  EXPECT_TRUE(physics->SetParam("plugin_load_threads", 4));
+  EXPECT_EQ(4, boost::any_cast<int>(physics->GetParam("plugin_load_threads")));
+
+  // Models without plugins are left alone
+  physics::Model_V models = world->Models();
+  physics::Model::LoadPlugins(models, 4);
+  EXPECT_EQ(models.size(), world->ModelCount());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the local update callbacks of the models are called
+/// once per step, after worldUpdateBegin, with and without threads.
+TEST_F(WorldTest, LocalUpdate)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  std::mutex mutex;
+  std::map<std::string, int> calls;
+  std::vector<event::ConnectionPtr> connections;
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    auto model = world->ModelByIndex(i);
+    EXPECT_FALSE(model->HasLocalUpdate());
+    connections.push_back(model->ConnectLocalUpdate(
+        [&mutex, &calls, model](const common::UpdateInfo &)
+        {
+          // Each model only touches itself
+          model->SetLinearVel(ignition::math::Vector3d::Zero);
+          std::lock_guard<std::mutex> lock(mutex);
+          ++calls[model->GetName()];
+        }));
+    EXPECT_TRUE(model->HasLocalUpdate());
+  }
+
+  int begins = 0;
+  auto beginConnection = event::Events::ConnectWorldUpdateBegin(
+      [&begins](const common::UpdateInfo &)
+      {
+        ++begins;
+      });
+
+  world->Step(10);
+  world->Physics()->SetModelUpdateThreads(4);
+  world->Step(10);
+  EXPECT_EQ(begins, 20);
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    auto name = world->ModelByIndex(i)->GetName();
+    EXPECT_EQ(calls[name], 20) << name;
+  }
+
+  // Disconnected callbacks aren't called anymore
+  connections.clear();
+  world->Step(10);
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    auto model = world->ModelByIndex(i);
+    EXPECT_FALSE(model->HasLocalUpdate());
+    EXPECT_EQ(calls[model->GetName()], 20) << model->GetName();
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the poses set by the physics engine are propagated to
+/// the moving links and their models.
+TEST_F(WorldTest, DirtyPoses)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  auto link = box->GetLink("link");
+  ASSERT_NE(nullptr, link);
+
+  box->SetWorldPose(ignition::math::Pose3d(0, 0, 2, 0, 0, 0));
+  world->Step(20);
+
+  // The falling box moves its model with its canonical link
+  EXPECT_LT(link->WorldPose().Pos().Z(), 2.0);
+  EXPECT_EQ(link->WorldPose(), box->WorldPose());
+  for (auto const &collision : link->GetCollisions())
+    EXPECT_EQ(link->WorldPose(), collision->WorldPose());
+
+  // Once the dirty pose is applied, applying it again changes nothing
+  EXPECT_FALSE(link->ApplyDirtyPose());
+}
+
+//////////////////////////////////////////////////
+/// \brief Requests received by onRequest.
+static std::vector<msgs::Request> g_requests;
+
+/// \brief Protects g_requests.
+static std::mutex g_requestMutex;
+
+//////////////////////////////////////////////////
+/// \brief Store a request.
+/// \param[in] _msg The request.
+static void onRequest(ConstRequestPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_requestMutex);
+  g_requests.push_back(*_msg);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, RemoveModels)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  ASSERT_NE(nullptr, world->ModelByName("box"));
+  ASSERT_NE(nullptr, world->ModelByName("sphere"));
+  const unsigned int count = world->ModelCount();
+
+  transport::SubscriberPtr sub =
+      this->node->Subscribe("~/request", &onRequest);
+
+  // Missing names are ignored
+  world->RemoveModels({"box", "sphere", "missing"});
+  EXPECT_EQ(nullptr, world->ModelByName("box"));
+  EXPECT_EQ(nullptr, world->ModelByName("sphere"));
+  EXPECT_NE(nullptr, world->ModelByName("cylinder"));
+  EXPECT_EQ(count - 2, world->ModelCount());
+  EXPECT_FALSE(world->RemovingModels());
+
+  sdf::ElementPtr modelElem = world->SDF()->GetElement("model");
+  while (modelElem)
+  {
+    EXPECT_NE("box", modelElem->Get<std::string>("name"));
+    EXPECT_NE("sphere", modelElem->Get<std::string>("name"));
+    modelElem = modelElem->GetNextElement("model");
+  }
+
+  // Clients receive a single request for both models
+  int sleep = 0;
+  while (sleep++ < 100)
+  {
+    std::lock_guard<std::mutex> lock(g_requestMutex);
+    if (!g_requests.empty())
+      break;
+    common::Time::MSleep(10);
+  }
+  world->Step(10);
+
+  std::lock_guard<std::mutex> lock(g_requestMutex);
+  ASSERT_EQ(1u, g_requests.size());
+  EXPECT_EQ("entities_delete", g_requests[0].request());
+  EXPECT_EQ(msgs::DeletedEntities(g_requests[0]),
+      std::vector<std::string>({"box", "sphere"}));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, EntityIndex)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  physics::EntityPtr link = world->EntityByName("box::link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ(box, link->GetParent());
+  EXPECT_EQ(link, box->GetChild("link"));
+  EXPECT_EQ(link, box->GetByName("box::link"));
+  EXPECT_EQ(nullptr, box->GetByName("sphere::link"));
+  EXPECT_EQ(box, world->BaseById(box->GetId()));
+  EXPECT_EQ(link, world->BaseById(link->GetId()));
+  EXPECT_EQ(link, box->GetById(link->GetId()));
+  EXPECT_EQ(nullptr, world->BaseByName("missing"));
+
+  // A name matches when no scoped name does
+  physics::BasePtr anyLink = world->BaseByName("link");
+  ASSERT_NE(nullptr, anyLink);
+  EXPECT_EQ("link", anyLink->GetName());
+
+  // The world name is the root element
+  EXPECT_EQ(nullptr, world->ModelByName("default"));
+  EXPECT_NE(nullptr, world->BaseByName("default"));
+
+  // A rename updates the scoped names of the children
+  box->SetName("crate");
+  EXPECT_EQ(box, world->ModelByName("crate"));
+  EXPECT_EQ(nullptr, world->ModelByName("box"));
+  EXPECT_EQ(link, world->EntityByName("crate::link"));
+  EXPECT_EQ("crate::link", link->GetScopedName());
+  EXPECT_EQ(nullptr, world->EntityByName("box::link"));
+
+  const uint32_t id = link->GetId();
+  link.reset();
+  world->RemoveModel("crate");
+  box.reset();
+  EXPECT_EQ(nullptr, world->ModelByName("crate"));
+  EXPECT_EQ(nullptr, world->EntityByName("crate::link"));
+  EXPECT_EQ(nullptr, world->BaseById(id));
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, KinematicPoses)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::ModelPtr box = world->ModelByName("box");
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_NE(nullptr, box);
+  ASSERT_NE(nullptr, sphere);
+  EXPECT_FALSE(box->IsKinematic());
+  box->SetKinematic(true);
+  EXPECT_TRUE(box->IsKinematic());
+
+  // A kinematic box doesn't fall
+  physics::Model_V models = {box};
+  std::vector<ignition::math::Pose3d> poses = {
+      ignition::math::Pose3d(0, 0, 2, 0, 0, 0)};
+  world->SetModelPoses(models, poses);
+  EXPECT_EQ(poses[0], box->WorldPose());
+  world->Step(100);
+  EXPECT_NEAR(2, box->WorldPose().Pos().Z(), 1e-6);
+
+  // And pushes the sphere as it's moved towards it
+  const double sphereY = sphere->WorldPose().Pos().Y();
+  for (int i = 0; i <= 200; ++i)
+  {
+    poses[0] = ignition::math::Pose3d(0, i * 0.01, 0.5, 0, 0, 0);
+    world->SetModelPoses(models, poses);
+    world->Step(1);
+    EXPECT_NEAR(i * 0.01, box->WorldPose().Pos().Y(), 1e-6);
+  }
+  EXPECT_GT(sphere->WorldPose().Pos().Y(), sphereY + 0.4);
+
+  // The sizes must match
+  poses.push_back(ignition::math::Pose3d::Zero);
+  world->SetModelPoses(models, poses);
+  EXPECT_NEAR(2, box->WorldPose().Pos().Y(), 1e-6);
+
+  box->SetKinematic(false);
+  EXPECT_FALSE(box->IsKinematic());
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SceneRequests)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  const ignition::math::Pose3d pose(1, 2, 0.5, 0, 0, 0);
+  box->SetWorldPose(pose);
+
+  // The scene has every model, with its current pose
+  auto response = transport::request("default", "scene_info", "", 10.0);
+  ASSERT_NE(nullptr, response);
+  EXPECT_EQ("success", response->response());
+  msgs::Scene scene;
+  ASSERT_TRUE(scene.ParseFromString(response->serialized_data()));
+  EXPECT_EQ(static_cast<int>(world->ModelCount()), scene.model_size());
+  bool found = false;
+  for (auto const &model : scene.model())
+  {
+    if (model.name() == "box")
+    {
+      found = true;
+      EXPECT_EQ(pose, msgs::ConvertIgn(model.pose()));
+    }
+  }
+  EXPECT_TRUE(found);
+
+  response = transport::request("default", "entity_list", "", 10.0);
+  ASSERT_NE(nullptr, response);
+  msgs::Model_V models;
+  ASSERT_TRUE(models.ParseFromString(response->serialized_data()));
+  EXPECT_EQ(static_cast<int>(world->ModelCount()), models.models_size());
+
+  // The world's SDF is written on the response thread
+  response = transport::request("default", "world_sdf", "", 10.0);
+  ASSERT_NE(nullptr, response);
+  msgs::GzString sdfString;
+  ASSERT_TRUE(sdfString.ParseFromString(response->serialized_data()));
+  EXPECT_NE(std::string::npos, sdfString.data().find("<model name='box'>"));
+}
+
+//////////////////////////////////////////////////
+/// \brief Request the scene and find a model in it.
+/// \param[in] _name Name of the model.
+/// \param[out] _model The model message, if found.
+/// \return True if the model is in the scene.
+static bool sceneModel(const std::string &_name, msgs::Model &_model)
+{
+  auto response = transport::request("default", "scene_info", "", 10.0);
+  msgs::Scene scene;
+  if (!response || !scene.ParseFromString(response->serialized_data()))
+    return false;
+
+  for (auto const &model : scene.model())
+  {
+    if (model.name() == _name)
+    {
+      _model = model;
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SceneCache)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  msgs::Model msg;
+  ASSERT_TRUE(sceneModel("box", msg));
+  EXPECT_EQ(ignition::math::Vector3d::One, msgs::ConvertIgn(msg.scale()));
+
+  // Cached models are refreshed
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  const ignition::math::Pose3d pose(3, 2, 0.5, 0, 0, 0);
+  box->SetWorldPose(pose);
+  box->SetStatic(true);
+  ASSERT_TRUE(sceneModel("box", msg));
+  EXPECT_EQ(pose, msgs::ConvertIgn(msg.pose()));
+  EXPECT_TRUE(msg.is_static());
+
+  // and filled again once scaled
+  box->SetScale(ignition::math::Vector3d(2, 2, 2));
+  ASSERT_TRUE(sceneModel("box", msg));
+  EXPECT_EQ(ignition::math::Vector3d(2, 2, 2),
+      msgs::ConvertIgn(msg.scale()));
+
+  // Inserted and removed models
+  this->SpawnBox("later", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 5, 0.5), ignition::math::Vector3d::Zero);
+  EXPECT_TRUE(sceneModel("later", msg));
+  world->RemoveModel("later");
+  EXPECT_FALSE(sceneModel("later", msg));
+}
+
+//////////////////////////////////////////////////
+/// \brief Protects g_sceneResponses.
+static std::mutex g_sceneResponsesMutex;
+
+/// \brief Number of models of each scene response, by request id.
+static std::map<int, int> g_sceneResponses;
+
+//////////////////////////////////////////////////
+/// \brief Keep the number of models of the scene responses.
+/// \param[in] _msg The response.
+static void onSceneResponse(ConstResponsePtr &_msg)
+{
+  msgs::Scene scene;
+  if (_msg->request() != "scene_info" ||
+      !scene.ParseFromString(_msg->serialized_data()))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(g_sceneResponsesMutex);
+  g_sceneResponses[_msg->id()] = scene.model_size();
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, SceneJoin)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  // Requests that arrive together each get the whole scene
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr requestPub =
+    node->Advertise<msgs::Request>("~/request");
+  transport::SubscriberPtr responseSub =
+    node->Subscribe("~/response", &onSceneResponse);
+  requestPub->WaitForConnection();
+
+  std::set<int> ids;
+  for (int i = 0; i < 4; ++i)
+  {
+    std::unique_ptr<msgs::Request> request(msgs::CreateRequest("scene_info"));
+    ids.insert(request->id());
+    requestPub->Publish(*request);
+  }
+
+  int sleep = 0;
+  bool received = false;
+  while (!received && sleep++ < 300)
+  {
+    common::Time::MSleep(10);
+    std::lock_guard<std::mutex> lock(g_sceneResponsesMutex);
+    received = true;
+    for (auto const id : ids)
+      received = received && g_sceneResponses.count(id) > 0;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(g_sceneResponsesMutex);
+    for (auto const id : ids)
+    {
+      ASSERT_EQ(1u, g_sceneResponses.count(id));
+      EXPECT_EQ(static_cast<int>(world->ModelCount()), g_sceneResponses[id]);
+    }
+  }
+
+  // A model message fills the model again
+  msgs::Model msg;
+  ASSERT_TRUE(sceneModel("box", msg));
+  EXPECT_FALSE(msg.enable_wind());
+
+  transport::PublisherPtr modelPub =
+    node->Advertise<msgs::Model>("~/model/modify");
+  msgs::Model modify;
+  modify.set_name("box");
+  modify.set_enable_wind(true);
+  modelPub->WaitForConnection();
+  modelPub->Publish(modify);
+
+  sleep = 0;
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  while (!box->WindMode() && sleep++ < 300)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(box->WindMode());
+  ASSERT_TRUE(sceneModel("box", msg));
+  EXPECT_TRUE(msg.enable_wind());
+
+  // A model inserted with the name of a removed one isn't mistaken for it
+  world->RemoveModel("box");
+  this->SpawnSphere("box", ignition::math::Vector3d(0, 5, 0.5),
+      ignition::math::Vector3d::Zero);
+  ASSERT_TRUE(sceneModel("box", msg));
+  ASSERT_GT(msg.link_size(), 0);
+  ASSERT_GT(msg.link(0).collision_size(), 0);
+  EXPECT_TRUE(msg.link(0).collision(0).geometry().has_sphere());
+}
+
+//////////////////////////////////////////////////
+/// \brief Last state stream schema received by onStateSchema.
+static msgs::StateStreamSchema g_stateSchema;
+
+/// \brief State stream messages received by onState.
+static std::vector<msgs::StateStream> g_states;
+
+/// \brief Protects g_stateSchema and g_states.
+static std::mutex g_stateMutex;
+
+//////////////////////////////////////////////////
+/// \brief Store a state stream schema.
+/// \param[in] _msg The schema.
+static void onStateSchema(ConstStateStreamSchemaPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_stateMutex);
+  g_stateSchema = *_msg;
+}
+
+//////////////////////////////////////////////////
+/// \brief Store a state stream message.
+/// \param[in] _msg The message.
+static void onState(ConstStateStreamPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_stateMutex);
+  g_states.push_back(*_msg);
+}
+
+//////////////////////////////////////////////////
+TEST_F(WorldTest, StateStream)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  world->SetStateStreamRate(100);
+  EXPECT_DOUBLE_EQ(100, world->StateStreamRate());
+
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+
+  transport::SubscriberPtr schemaSub =
+      this->node->Subscribe("~/state/schema", &onStateSchema, true);
+  transport::SubscriberPtr stateSub =
+      this->node->Subscribe("~/state/stream", &onState);
+
+  // The schema lists every model, then every model is sent
+  int sleep = 0;
+  while (sleep++ < 100)
+  {
+    world->Step(1);
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    if (g_stateSchema.version() > 0 && !g_states.empty())
+      break;
+    common::Time::MSleep(10);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    ASSERT_FALSE(g_states.empty());
+    bool found = false;
+    for (auto const &entity : g_stateSchema.entity())
+    {
+      if (entity.name() == "box")
+      {
+        found = true;
+        EXPECT_EQ(box->GetId(), entity.id());
+        EXPECT_EQ(msgs::StateStreamSchema::Entity::MODEL, entity.type());
+      }
+    }
+    EXPECT_TRUE(found);
+
+    const msgs::StateStream &state = g_states.front();
+    EXPECT_EQ(g_stateSchema.version(), state.schema());
+    EXPECT_EQ(state.id_size() * 7, state.pose_size());
+    EXPECT_EQ(state.id_size() * 6, state.velocity_size());
+    EXPECT_GE(state.id_size(), static_cast<int>(world->ModelCount()));
+    g_states.clear();
+  }
+
+  // Then only the models that moved
+  const ignition::math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  box->SetWorldPose(pose);
+  sleep = 0;
+  while (sleep++ < 100)
+  {
+    world->Step(1);
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    if (!g_states.empty())
+      break;
+    common::Time::MSleep(10);
+  }
+
+  std::lock_guard<std::mutex> lock(g_stateMutex);
+  ASSERT_FALSE(g_states.empty());
+  const msgs::StateStream &state = g_states.front();
+  int index = -1;
+  for (int i = 0; i < state.id_size(); ++i)
+  {
+    if (state.id(i) == box->GetId())
+      index = i;
+  }
+  ASSERT_GE(index, 0);
+  EXPECT_NEAR(1, state.pose(index * 7), 1e-3);
+  EXPECT_NEAR(2, state.pose(index * 7 + 1), 1e-3);
+  EXPECT_NEAR(3, state.pose(index * 7 + 2), 1e-2);
+}
+
+/// \brief Names of the poses received, one set per message.
+static std::vector<std::set<std::string>> g_poseNames;
+
+//////////////////////////////////////////////////
+/// \brief Store the names of a pose message.
+/// \param[in] _msg The message.
+static void onPoses(ConstPosesStampedPtr &_msg)
+{
+  std::set<std::string> names;
+  for (auto const &pose : _msg->pose())
+    names.insert(pose.name());
+  std::lock_guard<std::mutex> lock(g_stateMutex);
+  g_poseNames.push_back(names);
+}
+
+//////////////////////////////////////////////////
+/// \brief Step the world until a pose message is received.
+/// \param[in] _world The world.
+/// \return Names of the poses of the message, empty if none was received.
+static std::set<std::string> waitForPoses(const physics::WorldPtr &_world)
+{
+  for (int sleep = 0; sleep < 200; ++sleep)
+  {
+    _world->Step(1);
+    common::Time::MSleep(10);
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    if (!g_poseNames.empty())
+    {
+      std::set<std::string> names = g_poseNames.back();
+      g_poseNames.clear();
+      return names;
+    }
+  }
+  return std::set<std::string>();
+}
+
+//////////////////////////////////////////////////
+// The pose message reused between steps has the nested models of the
+// models that moved, and nothing left from the previous message
+TEST_F(WorldTest, PoseMessages)
+{
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  world->Physics()->SetGravity(ignition::math::Vector3d::Zero);
+
+  world->InsertModelString(
+      "<sdf version='1.6'>"
+      "  <model name='outer'>"
+      "    <pose>0 4 5 0 0 0</pose>"
+      "    <link name='link'/>"
+      "    <model name='inner'>"
+      "      <pose>0 1 0 0 0 0</pose>"
+      "      <link name='link'/>"
+      "    </model>"
+      "  </model>"
+      "</sdf>");
+  int sleep = 0;
+  while (!world->ModelByName("outer") && sleep++ < 100)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  auto outer = world->ModelByName("outer");
+  ASSERT_NE(nullptr, outer);
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+
+  transport::SubscriberPtr poseSub =
+      this->node->Subscribe("~/pose/info", &onPoses);
+  world->Step(100);
+  {
+    std::lock_guard<std::mutex> lock(g_stateMutex);
+    g_poseNames.clear();
+  }
+
+  outer->SetWorldPose(ignition::math::Pose3d(1, 4, 5, 0, 0, 0));
+  std::set<std::string> names = waitForPoses(world);
+  EXPECT_EQ(1u, names.count("outer"));
+  EXPECT_EQ(1u, names.count("outer::link"));
+  EXPECT_EQ(1u, names.count("outer::inner"));
+  EXPECT_EQ(1u, names.count("outer::inner::link"));
+
+  // Wait for the models moved by the insertion to settle
+  for (int i = 0; i < 10 && !names.empty(); ++i)
+    names = waitForPoses(world);
+
+  box->SetWorldPose(ignition::math::Pose3d(3, 3, 3, 0, 0, 0));
+  names = waitForPoses(world);
+  EXPECT_EQ(1u, names.count("box"));
+  EXPECT_EQ(1u, names.count("box::link"));
+  EXPECT_EQ(0u, names.count("outer"));
+  EXPECT_EQ(0u, names.count("outer::inner::link"));
+}
+
+//////////////////////////////////////////////////
+// The state log records the models inserted and removed while recording
+TEST_F(WorldTest, LogInsertionsDeletions)
+{
+  const boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo-world-%%%%%%");
+  ASSERT_TRUE(boost::filesystem::create_directories(dir));
+
+  util::LogRecord *recorder = util::LogRecord::Instance();
+  recorder->Init("test");
+
+  this->Load("worlds/shapes.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  world->Step(100);
+
+  EXPECT_TRUE(recorder->Start("txt", dir.string()));
+  world->Step(100);
+
+  world->InsertModelString(
+      "<sdf version='1.6'>"
+      "  <model name='new_box'>"
+      "    <pose>0 4 0.5 0 0 0</pose>"
+      "    <link name='link'>"
+      "      <collision name='collision'>"
+      "        <geometry><box><size>1 1 1</size></box></geometry>"
+      "      </collision>"
+      "    </link>"
+      "  </model>"
+      "</sdf>");
+  world->Step(200);
+  ASSERT_NE(nullptr, world->ModelByName("new_box"));
+
+  world->RemoveModel("sphere");
+  world->Step(200);
+
+  const std::string filename = recorder->Filename();
+  recorder->Stop();
+  recorder->Fini();
+
+  util::LogPlay *player = util::LogPlay::Instance();
+  player->Open(filename);
+  std::string log;
+  std::string data;
+  while (player->Step(data))
+    log += data;
+
+  // The initial models aren't inserted again, and the new box is inserted
+  // before the sphere is deleted
+  const std::size_t insertion = log.find("<insertions><model name='new_box'>");
+  const std::size_t deletion =
+      log.find("<deletions><name>sphere</name></deletions>");
+  EXPECT_NE(std::string::npos, insertion);
+  EXPECT_NE(std::string::npos, deletion);
+  EXPECT_LT(insertion, deletion);
+  EXPECT_EQ(log.find("<insertions>"), insertion);
+  EXPECT_EQ(std::string::npos,
+      log.find("<insertions><model name='box'>"));
+
+  boost::filesystem::remove_all(dir);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
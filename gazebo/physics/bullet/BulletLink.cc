@@ -164,9 +164,7 @@ void BulletLink::Init()
   this->rigidLink->setFriction(0.5*(hackMu1 + hackMu2));  // Hack
 
   // Setup motion clamping to prevent objects from moving too fast.
-  // this->rigidLink->setCcdMotionThreshold(1);
-  // auto size = this->BoundingBox().Size();
-  // this->rigidLink->setCcdSweptSphereRadius(size.GetMax()*0.8);
+  this->SetContinuousCollision(this->ContinuousCollision());
 
   if (this->inertial->Mass() <= 0.0)
     this->rigidLink->setCollisionFlags(btCollisionObject::CF_KINEMATIC_OBJECT);
@@ -208,6 +206,20 @@ void BulletLink::Init()
   this->SetAngularDamping(this->GetAngularDamping());
 }
 
+//////////////////////////////////////////////////
+void BulletLink::SetContinuousCollision(const bool _enable)
+{
+  Link::SetContinuousCollision(_enable);
+  if (!this->rigidLink)
+    return;
+
+  // Bullet sweeps a sphere from the start of a step when the body moves
+  // more than the threshold, and stops the body at the first hit.
+  const double radius = _enable ? this->ContinuousCollisionRadius() : 0.0;
+  this->rigidLink->setCcdMotionThreshold(radius);
+  this->rigidLink->setCcdSweptSphereRadius(radius);
+}
+
 //////////////////////////////////////////////////
 void BulletLink::Fini()
 {
@@ -327,7 +339,7 @@ void BulletLink::OnPoseChange()
     return;
   }
 
-  // this->SetEnabled(true);
+  this->SetEnabled(true);
 
   const ignition::math::Pose3d myPose = this->WorldInertialPose();
 
@@ -338,23 +350,31 @@ void BulletLink::OnPoseChange()
 //////////////////////////////////////////////////
 bool BulletLink::GetEnabled() const
 {
-  // This function and its counterpart BulletLink::SetEnabled
-  // don't do anything yet.
-  return true;
+  if (!this->rigidLink)
+    return true;
+
+  // Bullet wakes a sleeping body that an active body touches.
+  return this->rigidLink->isActive();
 }
 
 //////////////////////////////////////////////////
-void BulletLink::SetEnabled(bool /*_enable*/) const
+void BulletLink::SetEnabled(bool _enable) const
 {
-  /*
   if (!this->rigidLink)
     return;
 
+  // The deactivation of Bullet stays off, the sleep manager of the world
+  // puts the links to sleep.
   if (_enable)
-    this->rigidLink->activate(true);
+  {
+    if (this->rigidLink->getActivationState() != DISABLE_DEACTIVATION)
+    {
+      this->rigidLink->forceActivationState(DISABLE_DEACTIVATION);
+      this->rigidLink->setDeactivationTime(0);
+    }
+  }
   else
-    this->rigidLink->setActivationState(WANTS_DEACTIVATION);
-    */
+    this->rigidLink->forceActivationState(ISLAND_SLEEPING);
 }
 
 //////////////////////////////////////////////////
@@ -368,6 +388,7 @@ void BulletLink::SetLinearVel(const ignition::math::Vector3d &_vel)
   }
 
   this->rigidLink->setLinearVelocity(BulletTypes::ConvertVector3(_vel));
+  this->SetEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -442,6 +463,7 @@ void BulletLink::SetAngularVel(const ignition::math::Vector3d &_vel)
   }
 
   this->rigidLink->setAngularVelocity(BulletTypes::ConvertVector3(_vel));
+  this->SetEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -468,6 +490,8 @@ void BulletLink::SetForce(const ignition::math::Vector3d &_force)
 
   this->rigidLink->applyCentralForce(
     btVector3(_force.X(), _force.Y(), _force.Z()));
+  if (_force != ignition::math::Vector3d::Zero)
+    this->SetEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -494,6 +518,8 @@ void BulletLink::SetTorque(const ignition::math::Vector3d &_torque)
   }
 
   this->rigidLink->applyTorque(BulletTypes::ConvertVector3(_torque));
+  if (_torque != ignition::math::Vector3d::Zero)
+    this->SetEnabled(true);
 }
 
 //////////////////////////////////////////////////
@@ -159,6 +159,10 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      // Documentation inherited
+      public: virtual void SetContinuousCollision(const bool _enable)
+          override;
+
       // Documentation inherited.
       public: virtual void UpdateMass();
 
@@ -267,9 +267,6 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Default setup for memory and collisions
   this->collisionConfig = new btDefaultCollisionConfiguration();
 
-  // Default collision dispatcher, a multi-threaded dispatcher may be available
-  this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
-
   // Broadphase collision detection uses axis-aligned bounding boxes (AABB)
   // to detect pairs of objects that may be in contact.
   // The narrow-phase collision detection evaluates each pair generated by the
@@ -282,18 +279,9 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   // Here we are using btDbvtBroadphase.
   this->broadPhase = new btDbvtBroadphase();
 
-  // Create btSequentialImpulseConstraintSolver, the default constraint solver.
-  // Note that a multi-threaded solver may be available.
-  this->solver = new btSequentialImpulseConstraintSolver;
-
-  // Create a btDiscreteDynamicsWorld, which is used for discrete rigid bodies.
-  // An alternative is btSoftRigidDynamicsWorld, which handles both soft and
-  // rigid bodies.
-  this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
-      this->broadPhase, this->solver, this->collisionConfig);
-
   btOverlapFilterCallback *filterCallback = new CollisionFilter();
-  btOverlappingPairCache* pairCache = this->dynamicsWorld->getPairCache();
+  btOverlappingPairCache* pairCache =
+      this->broadPhase->getOverlappingPairCache();
   GZ_ASSERT(pairCache != nullptr,
       "Bullet broadphase overlapping pair cache is null");
   pairCache->setOverlapFilterCallback(filterCallback);
@@ -302,14 +290,120 @@ BulletPhysics::BulletPhysics(WorldPtr _world)
   gContactAddedCallback = ContactCallback;
   gContactProcessedCallback = ContactProcessed;
 
-  this->dynamicsWorld->setInternalTickCallback(
-      InternalTickCallback, static_cast<void *>(this));
+  // Single threaded until the SDF asks for more threads.
+  this->dispatcher = nullptr;
+  this->solver = nullptr;
+  this->dynamicsWorld = nullptr;
+  this->CreateDynamicsWorld(0);
 
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
+}
+
+//////////////////////////////////////////////////
+void BulletPhysics::CreateDynamicsWorld(const int _threads)
+{
+  // Keep the settings of the world being replaced
+  btContactSolverInfo info;
+  btVector3 gravity(0, 0, -10);
+  if (this->dynamicsWorld)
+  {
+    info = this->dynamicsWorld->getSolverInfo();
+    gravity = this->dynamicsWorld->getGravity();
+  }
 
-  btGImpactCollisionAlgorithm::registerAlgorithm(dispatcher);
+  delete this->dynamicsWorld;
+  delete this->solver;
+  delete this->solverPool;
+  delete this->dispatcher;
+  this->dynamicsWorld = nullptr;
+  this->solver = nullptr;
+  this->solverPool = nullptr;
+  this->dispatcher = nullptr;
+  this->threads = 0;
+
+#ifdef LIBBULLET_VERSION_GT_287
+  if (_threads > 1)
+  {
+    // The task scheduler is global to Bullet. It is null if Bullet was
+    // built without BT_THREADSAFE.
+    if (!btGetTaskScheduler() ||
+        btGetTaskScheduler() == btGetSequentialTaskScheduler())
+    {
+      btITaskScheduler *scheduler = btCreateDefaultTaskScheduler();
+      if (scheduler)
+        btSetTaskScheduler(scheduler);
+    }
+
+    btITaskScheduler *scheduler = btGetTaskScheduler();
+    if (scheduler && scheduler != btGetSequentialTaskScheduler())
+    {
+      scheduler->setNumThreads(_threads);
+      this->threads = scheduler->getNumThreads();
+
+      // The narrow phase of the pairs runs in parallel. The contact added
+      // callback only writes to the contact point it gets, and the contact
+      // feedback is read in the tick callback, on the stepping thread.
+      this->dispatcher = new btCollisionDispatcherMt(this->collisionConfig);
+
+      // One solver per thread, each solving its own islands.
+      btConstraintSolver *solvers[BT_MAX_THREAD_COUNT];
+      const int solverCount = std::min(this->threads, BT_MAX_THREAD_COUNT);
+      for (int i = 0; i < solverCount; ++i)
+        solvers[i] = new btSequentialImpulseConstraintSolverMt();
+      btConstraintSolverPoolMt *pool =
+          new btConstraintSolverPoolMt(solvers, solverCount);
+      this->solverPool = pool;
+
+      // Solver for the large islands, which splits them into batches.
+      this->solver = new btSequentialImpulseConstraintSolverMt();
+
+      this->dynamicsWorld = new btDiscreteDynamicsWorldMt(this->dispatcher,
+          this->broadPhase, pool, this->solver, this->collisionConfig);
+    }
+    else
+    {
+      gzwarn << "Bullet was built without multithreading support, "
+             << "using a single threaded dynamics world.\n";
+    }
+  }
+#else
+  if (_threads > 1)
+  {
+    gzwarn << "A multithreaded dynamics world needs Bullet 2.88 or later, "
+           << "using a single threaded dynamics world.\n";
+  }
+#endif
+
+  if (!this->dynamicsWorld)
+  {
+    // Default collision dispatcher
+    this->dispatcher = new btCollisionDispatcher(this->collisionConfig);
+
+    // Create btSequentialImpulseConstraintSolver, the default constraint
+    // solver.
+    this->solver = new btSequentialImpulseConstraintSolver;
+
+    // Create a btDiscreteDynamicsWorld, which is used for discrete rigid
+    // bodies. An alternative is btSoftRigidDynamicsWorld, which handles both
+    // soft and rigid bodies.
+    this->dynamicsWorld = new btDiscreteDynamicsWorld(this->dispatcher,
+        this->broadPhase, this->solver, this->collisionConfig);
+  }
+
+  this->dynamicsWorld->getSolverInfo() = info;
+  this->dynamicsWorld->setGravity(gravity);
+  this->dynamicsWorld->setInternalTickCallback(
+      InternalTickCallback, static_cast<void *>(this));
+
+  btGImpactCollisionAlgorithm::registerAlgorithm(this->dispatcher);
+}
+
+//////////////////////////////////////////////////
+int BulletPhysics::Threads() const
+{
+  return this->threads;
 }
 
 //////////////////////////////////////////////////
@@ -325,6 +419,12 @@ void BulletPhysics::Load(sdf::ElementPtr _sdf)
 
   sdf::ElementPtr bulletElem = this->sdf->GetElement("bullet");
 
+  // The multithreaded world is opt-in, and is created before any body is
+  // added to the world.
+  sdf::ElementPtr solverElem = bulletElem->GetElement("solver");
+  if (solverElem->HasElement("gz:threads"))
+    this->CreateDynamicsWorld(solverElem->Get<int>("gz:threads"));
+
   auto g = this->world->Gravity();
   // ODEPhysics checks this, so we will too.
   if (g == ignition::math::Vector3d::Zero)
@@ -542,6 +642,10 @@ void BulletPhysics::Fini()
     delete this->solver;
   this->solver = nullptr;
 
+  if (this->solverPool)
+    delete this->solverPool;
+  this->solverPool = nullptr;
+
   if (this->broadPhase)
     delete this->broadPhase;
   this->broadPhase = nullptr;
@@ -659,6 +763,35 @@ bool BulletPhysics::SetParam(const std::string &_key, const boost::any &_value)
       double value = any_cast<double>(_value);
       bulletElem->GetElement("solver")->GetElement("min_step_size")->Set(value);
     }
+    else if (_key == "threads")
+    {
+      int value = any_cast<int>(_value);
+      if ((value > 1) == (this->threads > 0))
+      {
+#ifdef LIBBULLET_VERSION_GT_287
+        // Only the size of the thread pool changes
+        if (value > 1)
+        {
+          btGetTaskScheduler()->setNumThreads(value);
+          this->threads = btGetTaskScheduler()->getNumThreads();
+        }
+#endif
+      }
+      else if (this->dynamicsWorld->getNumCollisionObjects() == 0)
+      {
+        boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+        this->CreateDynamicsWorld(value);
+        if (value > 1 && this->threads == 0)
+          return false;
+      }
+      else
+      {
+        gzwarn << "The Bullet dynamics world can only switch between single "
+               << "and multithreaded before bodies are added. Set "
+               << "<bullet><solver><threads> in the world file instead.\n";
+        return false;
+      }
+    }
     else
     {
       return PhysicsEngine::SetParam(_key, _value);
@@ -721,6 +854,8 @@ bool BulletPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->sdf->GetElement("max_contacts")->Get<int>();
   else if (_key == "min_step_size")
     _value = bulletElem->GetElement("solver")->Get<double>("min_step_size");
+  else if (_key == "threads")
+    _value = this->threads;
   else
   {
     return PhysicsEngine::GetParam(_key, _value);
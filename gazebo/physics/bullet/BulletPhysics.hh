@@ -172,12 +172,33 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSORPGSIters(unsigned int iters);
 
+      /// \brief Get the number of threads of the dynamics world.
+      /// \return Number of threads, or 0 for the single threaded world.
+      public: int Threads() const;
+
+      /// \brief Create the collision dispatcher, the constraint solver and
+      /// the dynamics world. A thread count above 1 creates the
+      /// multithreaded world of Bullet 2.88 and later, which runs the
+      /// narrow phase, the island solvers and the integration on a pool
+      /// of threads. It must be called before any body is added.
+      /// \param[in] _threads Number of threads, 0 or 1 for the single
+      /// threaded world.
+      private: void CreateDynamicsWorld(const int _threads);
+
       private: btBroadphaseInterface *broadPhase;
       private: btDefaultCollisionConfiguration *collisionConfig;
       private: btCollisionDispatcher *dispatcher;
-      private: btSequentialImpulseConstraintSolver *solver;
+      private: btConstraintSolver *solver;
       private: btDiscreteDynamicsWorld *dynamicsWorld;
 
+      /// \brief Pool of constraint solvers of the multithreaded world, or
+      /// null.
+      private: btConstraintSolver *solverPool = nullptr;
+
+      /// \brief Number of threads of the dynamics world, 0 if it is
+      /// single threaded.
+      private: int threads = 0;
+
       private: common::Time lastUpdateTime;
 
       /// \brief The type of the solver.
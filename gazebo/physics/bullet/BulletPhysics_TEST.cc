@@ -267,6 +267,49 @@ TEST_F(BulletPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test switching to the multithreaded dynamics world
+TEST_F(BulletPhysics_TEST, Threads)
+{
+  Load("worlds/blank.world", true, "bullet");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  BulletPhysicsPtr bulletPhysics =
+      boost::dynamic_pointer_cast<BulletPhysics>(world->Physics());
+  ASSERT_TRUE(bulletPhysics != nullptr);
+
+  EXPECT_EQ(0, bulletPhysics->Threads());
+  EXPECT_EQ(0, boost::any_cast<int>(bulletPhysics->GetParam("threads")));
+  EXPECT_TRUE(bulletPhysics->SetParam("threads", 0));
+
+  // Solver settings carry over to the new world
+  EXPECT_TRUE(bulletPhysics->SetParam("iters", 42));
+
+  // The multithreaded world depends on how Bullet was built
+  const bool mt = bulletPhysics->SetParam("threads", 2);
+  EXPECT_EQ(mt ? 2 : 0, bulletPhysics->Threads());
+  EXPECT_EQ(42, bulletPhysics->GetDynamicsWorld()->getSolverInfo()
+      .m_numIterations);
+
+  // Bodies are stepped in either world
+  SpawnBox("box1", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(0, 0, 1), ignition::math::Vector3d::Zero);
+  SpawnBox("box2", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(0, 0, 3), ignition::math::Vector3d::Zero);
+  ModelPtr box1 = world->ModelByName("box1");
+  ModelPtr box2 = world->ModelByName("box2");
+  ASSERT_TRUE(box1 != nullptr);
+  ASSERT_TRUE(box2 != nullptr);
+  world->Step(100);
+  EXPECT_LT(box1->WorldPose().Pos().Z(), 1.0);
+  EXPECT_GT(box2->WorldPose().Pos().Z(), box1->WorldPose().Pos().Z());
+
+  // The mode can't change once bodies were added
+  EXPECT_FALSE(bulletPhysics->SetParam("threads", mt ? 0 : 2));
+  EXPECT_EQ(mt ? 2 : 0, bulletPhysics->Threads());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
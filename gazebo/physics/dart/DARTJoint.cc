@@ -716,6 +716,11 @@ bool DARTJoint::SetPosition(const unsigned int _index, const double _position,
   if (_index < dofs)
   {
     this->dataPtr->dtJoint->setPosition(_index, _position);
+
+    // The position is written to DART directly, so the cached joint states
+    // of the model are stale until the next step.
+    if (this->model)
+      this->model->InvalidateJointStates();
     return true;
   }
 
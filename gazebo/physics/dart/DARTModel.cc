@@ -82,7 +82,7 @@ void DARTModel::Init()
   // Create a local link for joints with the world as their parent.
   LinkPtr worldLink(new DARTLink(
       boost::static_pointer_cast<Model>(shared_from_this())));
-  for (auto joint : this->GetJoints())
+  for (auto const &joint : this->GetJoints())
   {
     if (!joint->GetParent())
     {
@@ -95,7 +95,7 @@ void DARTModel::Init()
 
   // Links that need to be added to the DART skeleton
   std::list<LinkPtr> linksToAdd;
-  for (auto link : this->GetLinks())
+  for (auto const &link : this->GetLinks())
   {
     linksToAdd.push_back(link);
   }
@@ -229,7 +229,7 @@ void DARTModel::Init()
   // Check whether there exist at least one pair of self collidable links.
   int numSelfCollidableLinks = 0;
   bool hasPairOfSelfCollidableLinks = false;
-  for (auto link : this->GetLinks())
+  for (auto const &link : this->GetLinks())
   {
     if (link->GetSelfCollide())
     {
@@ -255,6 +255,7 @@ void DARTModel::Init()
 
   // Add the skeleton to the world
   this->DARTWorld()->addSkeleton(this->dataPtr->dtSkeleton);
+  this->GetDARTPhysics()->SetLinksDirty();
 }
 
 
@@ -269,6 +270,7 @@ void DARTModel::Fini()
 {
   // get a backup of the world, because Model::Fini() (eventually
   // calling Base::Fini()) will reset the world pointer
+  DARTPhysicsPtr physics = this->GetDARTPhysics();
   dart::simulation::WorldPtr _world = this->DARTWorld();
   // remove all links and joints properly
   Model::Fini();
@@ -277,6 +279,9 @@ void DARTModel::Fini()
   {
     _world->removeSkeleton(this->dataPtr->dtSkeleton);
   }
+  // the links of this model are gone
+  if (physics)
+    physics->SetLinksDirty();
 }
 
 //////////////////////////////////////////////////
@@ -225,29 +225,14 @@ static DARTLinkPtr StaticFindDARTLink(
     DARTPhysics *_dtPhysics,
     const dart::dynamics::BodyNode *_dtBodyNode)
 {
-  DARTLinkPtr res;
-
-  const Model_V& models = _dtPhysics->World()->Models();
-
-  for (Model_V::const_iterator itModel = models.begin();
-       itModel != models.end(); ++itModel)
+  for (auto const &link : _dtPhysics->World()->AllLinks())
   {
-    const Link_V& links = (*itModel)->GetLinks();
-
-    for (Link_V::const_iterator itLink = links.begin();
-         itLink != links.end(); ++itLink)
-    {
-      DARTLinkPtr dartLink = boost::dynamic_pointer_cast<DARTLink>(*itLink);
-
-      if (dartLink->DARTBodyNode() == _dtBodyNode)
-      {
-        res = dartLink;
-        break;
-      }
-    }
+    DARTLink *dartLink = dynamic_cast<DARTLink *>(link.get());
+    if (dartLink && dartLink->DARTBodyNode() == _dtBodyNode)
+      return boost::static_pointer_cast<DARTLink>(link);
   }
 
-  return res;
+  return DARTLinkPtr();
 }
 
 //////////////////////////////////////////////////
@@ -452,26 +437,15 @@ void DARTPhysics::UpdatePhysics()
         this->dataPtr->resetAllForcesAfterSimulationStep);
 
   // Update all the transformation of DART's links to gazebo's links
-  // TODO: How to visit all the links in the world?
-  unsigned int modelCount = this->world->ModelCount();
-  ModelPtr modelItr;
-
-  for (unsigned int i = 0; i < modelCount; ++i)
+  if (this->dataPtr->linksDirty ||
+      this->dataPtr->linksModelCount != this->world->ModelCount())
   {
-    modelItr = this->world->ModelByIndex(i);
-    // TODO: need to improve speed
-    Link_V links = modelItr->GetLinks();
-    unsigned int linkCount = links.size();
-    DARTLinkPtr dartLinkItr;
-
-    for (unsigned int j = 0; j < linkCount; ++j)
-    {
-      dartLinkItr
-          = boost::dynamic_pointer_cast<DARTLink>(links.at(j));
-      dartLinkItr->updateDirtyPoseFromDARTTransformation();
-    }
+    this->UpdateLinks();
   }
 
+  for (auto *link : this->dataPtr->links)
+    link->updateDirtyPoseFromDARTTransformation();
+
   RetrieveDARTCollisions(
         this,
         &(this->dataPtr->dtWorld->getLastCollisionResult()),
@@ -479,6 +453,31 @@ void DARTPhysics::UpdatePhysics()
   IGN_PROFILE_END();
 }
 
+//////////////////////////////////////////////////
+void DARTPhysics::SetLinksDirty()
+{
+  this->dataPtr->linksDirty = true;
+}
+
+//////////////////////////////////////////////////
+void DARTPhysics::UpdateLinks()
+{
+  this->dataPtr->links.clear();
+  const unsigned int modelCount = this->world->ModelCount();
+  for (unsigned int i = 0; i < modelCount; ++i)
+  {
+    for (auto const &link : this->world->ModelByIndex(i)->GetLinks())
+    {
+      DARTLinkPtr dartLink = boost::dynamic_pointer_cast<DARTLink>(link);
+      if (dartLink)
+        this->dataPtr->links.push_back(dartLink.get());
+    }
+  }
+
+  this->dataPtr->linksModelCount = modelCount;
+  this->dataPtr->linksDirty = false;
+}
+
 //////////////////////////////////////////////////
 std::string DARTPhysics::GetType() const
 {
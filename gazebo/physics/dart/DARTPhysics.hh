@@ -159,6 +159,11 @@ namespace gazebo
       /// detector has been loaded yet, the empty string is returned.
       public: std::string CollisionDetectorInUse() const;
 
+      /// \brief Rebuild the list of links before the next pose update.
+      /// Called when a skeleton is added to or removed from the DART
+      /// world.
+      public: void SetLinksDirty();
+
       // Documentation inherited
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
@@ -171,6 +176,9 @@ namespace gazebo
       private: DARTLinkPtr FindDARTLink(
           const dart::dynamics::BodyNode *_dtBodyNode);
 
+      /// \brief Rebuild the list of links of all the models.
+      private: void UpdateLinks();
+
       /// \internal
       /// \brief Pointer to private data.
       private: DARTPhysicsPrivate *dataPtr = nullptr;
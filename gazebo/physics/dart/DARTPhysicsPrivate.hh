@@ -18,12 +18,16 @@
 #ifndef _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 #define _GAZEBO_DARTPHYSICS_PRIVATE_HH_
 
+#include <vector>
+
 #include "gazebo/physics/dart/dart_inc.h"
 
 namespace gazebo
 {
   namespace physics
   {
+    class DARTLink;
+
     /// \internal
     /// \brief Private data class for DARTPhysics
     class DARTPhysicsPrivate
@@ -31,7 +35,9 @@ namespace gazebo
       /// \brief Constructor
       public: DARTPhysicsPrivate()
         : dtWorld(new dart::simulation::World()),
-          resetAllForcesAfterSimulationStep(true)
+          resetAllForcesAfterSimulationStep(true),
+          linksDirty(true),
+          linksModelCount(0)
       {
       }
 
@@ -50,6 +56,16 @@ namespace gazebo
       /// and torques (both internal and external) after completing a simulation
       /// step. Default value is true.
       public: bool resetAllForcesAfterSimulationStep;
+
+      /// \brief Links of all the models, whose poses are read back from
+      /// DART after each step.
+      public: std::vector<DARTLink *> links;
+
+      /// \brief True if links must be rebuilt before it is used.
+      public: bool linksDirty;
+
+      /// \brief Number of models in the world when links was built.
+      public: unsigned int linksModelCount;
     };
   }
 }
@@ -24,6 +24,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -49,6 +50,8 @@ ODECollision::ODECollision(LinkPtr _link)
 //////////////////////////////////////////////////
 ODECollision::~ODECollision()
 {
+  this->Unbake();
+
   if (this->collisionId)
     dGeomDestroy(this->collisionId);
   this->collisionId = nullptr;
@@ -78,6 +81,13 @@ void ODECollision::Load(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void ODECollision::Fini()
 {
+  this->Unbake();
+
+  // The convex geoms use the arrays of the shape
+  for (auto const part : this->parts)
+    dGeomDestroy(part);
+  this->parts.clear();
+
   /*
      if (this->collisionId)
      dGeomDestroy(this->collisionId);
@@ -212,6 +222,13 @@ void ODECollision::OnPoseChangeGlobal()
 
   dQuaternion q;
 
+  // A baked collision that moves keeps its own geom from now on
+  if (this->baked)
+  {
+    this->bakeable = false;
+    this->Unbake();
+  }
+
   // Transform into global pose since a static collision does not have a link
   ignition::math::Pose3d localPose = this->WorldPose();
 
@@ -227,6 +244,8 @@ void ODECollision::OnPoseChangeGlobal()
   dGeomSetPosition(this->collisionId, localPose.Pos().X(),
       localPose.Pos().Y(), localPose.Pos().Z());
   dGeomSetQuaternion(this->collisionId, q);
+
+  this->PlaceCollisionParts();
 }
 
 /////////////////////////////////////////////////
@@ -254,9 +273,111 @@ void ODECollision::OnPoseChangeRelative()
   dGeomSetOffsetPosition(this->collisionId,
       localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
   dGeomSetOffsetQuaternion(this->collisionId, q);
+
+  this->PlaceCollisionParts();
 }
 
 /////////////////////////////////////////////////
 void ODECollision::OnPoseChangeNull()
 {
 }
+
+/////////////////////////////////////////////////
+void ODECollision::SetBaked(const bool _baked)
+{
+  this->baked = _baked;
+}
+
+/////////////////////////////////////////////////
+bool ODECollision::Baked() const
+{
+  return this->baked;
+}
+
+/////////////////////////////////////////////////
+bool ODECollision::Bakeable() const
+{
+  // The parts replace the geom, which a baked region would hide
+  return this->bakeable && this->parts.empty();
+}
+
+/////////////////////////////////////////////////
+void ODECollision::Unbake()
+{
+  if (!this->baked)
+    return;
+
+  WorldPtr world = this->GetWorld();
+  ODEPhysicsPtr physics;
+  if (world)
+    physics = boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+
+  // The engine clears the baked flag of every baked collision
+  if (physics)
+    physics->UnbakeStaticCollisions();
+  this->baked = false;
+}
+
+/////////////////////////////////////////////////
+void ODECollision::SetCollisionParts(const std::vector<dGeomID> &_parts)
+{
+  for (auto const part : this->parts)
+    dGeomDestroy(part);
+  this->parts = _parts;
+
+  for (auto const part : this->parts)
+  {
+    GZ_ASSERT(dGeomGetSpace(part) == 0, "Collision part is in a space");
+    dGeomSetData(part, this);
+  }
+  this->PlaceCollisionParts();
+}
+
+/////////////////////////////////////////////////
+const std::vector<dGeomID> &ODECollision::CollisionParts() const
+{
+  return this->parts;
+}
+
+/////////////////////////////////////////////////
+void ODECollision::PlaceCollisionParts()
+{
+  if (this->parts.empty() || !this->collisionId || !this->placeable)
+    return;
+
+  dBodyID body = dGeomGetBody(this->collisionId);
+  dQuaternion q;
+  if (body)
+  {
+    const dReal *pos = dGeomGetOffsetPosition(this->collisionId);
+    dGeomGetOffsetQuaternion(this->collisionId, q);
+    for (auto const part : this->parts)
+    {
+      if (dGeomGetBody(part) != body)
+        dGeomSetBody(part, body);
+      dGeomSetOffsetPosition(part, pos[0], pos[1], pos[2]);
+      dGeomSetOffsetQuaternion(part, q);
+    }
+  }
+  else
+  {
+    const dReal *pos = dGeomGetPosition(this->collisionId);
+    dGeomGetQuaternion(this->collisionId, q);
+    for (auto const part : this->parts)
+    {
+      if (dGeomGetBody(part))
+        dGeomSetBody(part, 0);
+      dGeomSetPosition(part, pos[0], pos[1], pos[2]);
+      dGeomSetQuaternion(part, q);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ODECollision::RefreshCollisionParts()
+{
+  // Computing the bounding box cleans the pose of a geom moved by its body
+  dReal aabb[6];
+  for (auto const part : this->parts)
+    dGeomGetAABB(part, aabb);
+}
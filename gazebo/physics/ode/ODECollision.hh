@@ -22,6 +22,8 @@
 #ifndef _ODECOLLISION_HH_
 #define _ODECOLLISION_HH_
 
+#include <vector>
+
 #include "gazebo/physics/ode/ode_inc.h"
 
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -90,6 +92,48 @@ namespace gazebo
       /// \return Dynamically casted pointer to ODESurfaceParams.
       public: ODESurfaceParamsPtr GetODESurface() const;
 
+      /// \brief Set whether the collision is baked into a merged static
+      /// collision of the physics engine. The geom of a baked collision is
+      /// kept out of its space.
+      /// \param[in] _baked True if the collision is baked.
+      /// \sa ODEPhysics::SetBakeStaticCollisions
+      public: void SetBaked(const bool _baked);
+
+      /// \brief Get whether the collision is baked.
+      /// \return True if the collision is baked.
+      public: bool Baked() const;
+
+      /// \brief Get whether the collision may be baked. Static collisions
+      /// that are moved after they were baked keep their own geom, as do the
+      /// collisions with parts.
+      /// \return True if the collision may be baked.
+      public: bool Bakeable() const;
+
+      /// \brief Set the convex geoms, or the distance field geom, that
+      /// replace the geom of the collision in the narrow phase. The
+      /// collision owns them and keeps them at its pose. They must not be
+      /// in a space.
+      /// \param[in] _parts The geoms.
+      /// \sa ODEPhysics::NarrowPhase
+      public: void SetCollisionParts(const std::vector<dGeomID> &_parts);
+
+      /// \brief Get the convex geoms of the collision.
+      /// \return The geoms, empty if the collision uses its own geom.
+      public: const std::vector<dGeomID> &CollisionParts() const;
+
+      /// \brief Attach the convex geoms to the body of the geom of the
+      /// collision, at its offset, or at its pose without a body.
+      public: void PlaceCollisionParts();
+
+      /// \brief Update the poses and the bounding boxes of the convex geoms
+      /// before they are collided. The geoms aren't in a space, so this
+      /// must be called serially, before a parallel narrow phase.
+      public: void RefreshCollisionParts();
+
+      /// \brief Ask the physics engine to unbake the static collisions, if
+      /// this collision is baked.
+      private: void Unbake();
+
       /// \brief Used when this is static to set the posse.
       private: void OnPoseChangeGlobal();
 
@@ -107,6 +151,15 @@ namespace gazebo
 
       /// \brief Function used to set the pose of the ODE object.
       private: void (ODECollision::*onPoseChangeFunc)();
+
+      /// \brief True if the collision is baked.
+      private: bool baked = false;
+
+      /// \brief True if the collision may be baked.
+      private: bool bakeable = true;
+
+      /// \brief Convex geoms of the collision.
+      private: std::vector<dGeomID> parts;
     };
     /// \}
   }
@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/SignedDistanceField.hh"
+#include "gazebo/physics/ode/ODEDistanceField.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Most points sampled along an edge of a box or a capsule.
+static const int kMaxEdgeSamples = 8;
+
+/// \brief Points sampled on the rim of a cylinder cap.
+static const int kRimSamples = 16;
+
+/// \brief Class number of the field geoms, -1 when not registered.
+static std::atomic<int> fieldClass(-1);
+
+/// \brief Number of engines that registered the class.
+static int fieldUsers = 0;
+
+/// \brief Protects the registration of the class.
+static std::mutex fieldMutex;
+
+/// \internal
+/// \brief Data of a field geom.
+struct ODEDistanceFieldData
+{
+  /// \brief The field, in the frame of the geom.
+  const common::SignedDistanceField *field;
+};
+
+/// \internal
+/// \brief A point of the other geom, with the radius of the sphere it is
+/// the center of.
+struct ODEDistanceFieldSample
+{
+  /// \brief World position of the point.
+  ignition::math::Vector3d point;
+
+  /// \brief Radius around the point, 0 for a surface point.
+  double radius;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the field of a geom.
+/// \param[in] _geom A field geom.
+/// \return The field.
+static const common::SignedDistanceField *fieldOf(dGeomID _geom)
+{
+  return static_cast<ODEDistanceFieldData *>(
+      dGeomGetClassData(_geom))->field;
+}
+
+//////////////////////////////////////////////////
+/// \brief Transform a point from the frame of a geom to the world.
+/// \param[in] _geom The geom.
+/// \param[in] _point Point in the frame of the geom.
+/// \return The world point.
+static ignition::math::Vector3d toWorld(dGeomID _geom,
+    const ignition::math::Vector3d &_point)
+{
+  const dReal *pos = dGeomGetPosition(_geom);
+  const dReal *rot = dGeomGetRotation(_geom);
+  ignition::math::Vector3d result;
+  for (int i = 0; i < 3; ++i)
+  {
+    result[i] = rot[i*4] * _point.X() + rot[i*4+1] * _point.Y() +
+        rot[i*4+2] * _point.Z() + pos[i];
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Rotate a direction from the frame of a geom to the world.
+/// \param[in] _geom The geom.
+/// \param[in] _dir Direction in the frame of the geom.
+/// \return The world direction.
+static ignition::math::Vector3d rotateToWorld(dGeomID _geom,
+    const ignition::math::Vector3d &_dir)
+{
+  const dReal *rot = dGeomGetRotation(_geom);
+  ignition::math::Vector3d result;
+  for (int i = 0; i < 3; ++i)
+  {
+    result[i] = rot[i*4] * _dir.X() + rot[i*4+1] * _dir.Y() +
+        rot[i*4+2] * _dir.Z();
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Transform a world point to the frame of a geom.
+/// \param[in] _geom The geom.
+/// \param[in] _point The world point.
+/// \return Point in the frame of the geom.
+static ignition::math::Vector3d toLocal(dGeomID _geom,
+    const ignition::math::Vector3d &_point)
+{
+  const dReal *pos = dGeomGetPosition(_geom);
+  const dReal *rot = dGeomGetRotation(_geom);
+  const ignition::math::Vector3d d(_point.X() - pos[0],
+      _point.Y() - pos[1], _point.Z() - pos[2]);
+  ignition::math::Vector3d result;
+  for (int i = 0; i < 3; ++i)
+    result[i] = rot[i] * d.X() + rot[4+i] * d.Y() + rot[8+i] * d.Z();
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the number of samples along an edge.
+/// \param[in] _length Length of the edge.
+/// \param[in] _resolution Resolution of the field.
+/// \return At least the two ends of the edge.
+static int edgeSamples(const double _length, const double _resolution)
+{
+  return ignition::math::clamp(
+      static_cast<int>(std::ceil(_length / _resolution)) + 1,
+      2, kMaxEdgeSamples);
+}
+
+//////////////////////////////////////////////////
+/// \brief Make contacts from the samples that are inside of the field,
+/// keeping the deepest ones.
+/// \param[in] _field The field geom.
+/// \param[in] _other The other geom.
+/// \param[in] _samples Points of the other geom.
+/// \param[in] _flags Collision flags, the lower bits being the most
+/// contacts to make.
+/// \param[out] _contact Contact array.
+/// \param[in] _skip Size of an element of the contact array.
+/// \return Number of contacts.
+static int collideSamples(dGeomID _field, dGeomID _other,
+    const std::vector<ODEDistanceFieldSample> &_samples, const int _flags,
+    dContactGeom *_contact, const int _skip)
+{
+  const common::SignedDistanceField *field = fieldOf(_field);
+  const std::size_t maxContacts = std::max(_flags & 0xffff, 1);
+
+  std::vector<dContactGeom> contacts;
+  for (auto const &sample : _samples)
+  {
+    const ignition::math::Vector3d local = toLocal(_field, sample.point);
+    const double depth = sample.radius - field->Distance(local);
+    if (depth <= 0)
+      continue;
+
+    const ignition::math::Vector3d gradient =
+        rotateToWorld(_field, field->Gradient(local));
+    if (gradient == ignition::math::Vector3d::Zero)
+      continue;
+
+    // The normal points into the field geom, which is geom 1, and the
+    // contact is at the deepest point of the other geom
+    const ignition::math::Vector3d pos = sample.point -
+        gradient * sample.radius;
+    dContactGeom contact;
+    for (int i = 0; i < 3; ++i)
+    {
+      contact.pos[i] = pos[i];
+      contact.normal[i] = -gradient[i];
+    }
+    contact.pos[3] = contact.normal[3] = 0;
+    contact.depth = depth;
+    contact.g1 = _field;
+    contact.g2 = _other;
+    contact.side1 = contact.side2 = -1;
+    contacts.push_back(contact);
+  }
+
+  // Keep the deepest contacts, once per position since the vertices of a
+  // mesh are shared by several triangles
+  std::sort(contacts.begin(), contacts.end(),
+      [](const dContactGeom &_a, const dContactGeom &_b)
+      {
+        return _a.depth > _b.depth;
+      });
+
+  int count = 0;
+  for (auto const &contact : contacts)
+  {
+    if (static_cast<std::size_t>(count) >= maxContacts)
+      break;
+
+    bool duplicate = false;
+    for (int i = 0; i < count && !duplicate; ++i)
+    {
+      const dContactGeom *kept = reinterpret_cast<dContactGeom *>(
+          reinterpret_cast<char *>(_contact) + i * _skip);
+      duplicate = kept->pos[0] == contact.pos[0] &&
+          kept->pos[1] == contact.pos[1] && kept->pos[2] == contact.pos[2];
+    }
+    if (duplicate)
+      continue;
+
+    *reinterpret_cast<dContactGeom *>(
+        reinterpret_cast<char *>(_contact) + count * _skip) = contact;
+    ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+/// \brief Collide a field with a sphere.
+static int collideSphere(dGeomID _o1, dGeomID _o2, int _flags,
+    dContactGeom *_contact, int _skip)
+{
+  const dReal *pos = dGeomGetPosition(_o2);
+  std::vector<ODEDistanceFieldSample> samples;
+  samples.push_back({ignition::math::Vector3d(pos[0], pos[1], pos[2]),
+      dGeomSphereGetRadius(_o2)});
+  return collideSamples(_o1, _o2, samples, _flags, _contact, _skip);
+}
+
+//////////////////////////////////////////////////
+/// \brief Collide a field with a capsule, as spheres along its axis.
+static int collideCapsule(dGeomID _o1, dGeomID _o2, int _flags,
+    dContactGeom *_contact, int _skip)
+{
+  dReal radius, length;
+  dGeomCapsuleGetParams(_o2, &radius, &length);
+  const int n = edgeSamples(length, fieldOf(_o1)->Resolution());
+
+  std::vector<ODEDistanceFieldSample> samples;
+  for (int i = 0; i < n; ++i)
+  {
+    const double z = length * (static_cast<double>(i) / (n - 1) - 0.5);
+    samples.push_back({toWorld(_o2, ignition::math::Vector3d(0, 0, z)),
+        radius});
+  }
+  return collideSamples(_o1, _o2, samples, _flags, _contact, _skip);
+}
+
+//////////////////////////////////////////////////
+/// \brief Collide a field with a box, at points of a lattice on its faces.
+static int collideBox(dGeomID _o1, dGeomID _o2, int _flags,
+    dContactGeom *_contact, int _skip)
+{
+  dVector3 lengths;
+  dGeomBoxGetLengths(_o2, lengths);
+  const double resolution = fieldOf(_o1)->Resolution();
+  int n[3];
+  for (int i = 0; i < 3; ++i)
+    n[i] = edgeSamples(lengths[i], resolution);
+
+  std::vector<ODEDistanceFieldSample> samples;
+  for (int i = 0; i < n[0]; ++i)
+  {
+    for (int j = 0; j < n[1]; ++j)
+    {
+      for (int k = 0; k < n[2]; ++k)
+      {
+        // Only the points on the faces
+        if (i != 0 && i != n[0]-1 && j != 0 && j != n[1]-1 &&
+            k != 0 && k != n[2]-1)
+        {
+          continue;
+        }
+        const ignition::math::Vector3d local(
+            lengths[0] * (static_cast<double>(i) / (n[0] - 1) - 0.5),
+            lengths[1] * (static_cast<double>(j) / (n[1] - 1) - 0.5),
+            lengths[2] * (static_cast<double>(k) / (n[2] - 1) - 0.5));
+        samples.push_back({toWorld(_o2, local), 0});
+      }
+    }
+  }
+  return collideSamples(_o1, _o2, samples, _flags, _contact, _skip);
+}
+
+//////////////////////////////////////////////////
+/// \brief Collide a field with a cylinder, at the rims and the centers of
+/// its caps.
+static int collideCylinder(dGeomID _o1, dGeomID _o2, int _flags,
+    dContactGeom *_contact, int _skip)
+{
+  dReal radius, length;
+  dGeomCylinderGetParams(_o2, &radius, &length);
+
+  std::vector<ODEDistanceFieldSample> samples;
+  for (const double z : {-0.5 * length, 0.5 * length})
+  {
+    samples.push_back({toWorld(_o2, ignition::math::Vector3d(0, 0, z)), 0});
+    for (int i = 0; i < kRimSamples; ++i)
+    {
+      const double angle = 2 * IGN_PI * i / kRimSamples;
+      samples.push_back({toWorld(_o2, ignition::math::Vector3d(
+          radius * std::cos(angle), radius * std::sin(angle), z)), 0});
+    }
+  }
+  return collideSamples(_o1, _o2, samples, _flags, _contact, _skip);
+}
+
+//////////////////////////////////////////////////
+/// \brief Collide a field with a triangle mesh, at its vertices.
+static int collideTrimesh(dGeomID _o1, dGeomID _o2, int _flags,
+    dContactGeom *_contact, int _skip)
+{
+  const int triangles = dGeomTriMeshGetTriangleCount(_o2);
+  std::vector<ODEDistanceFieldSample> samples;
+  samples.reserve(triangles * 3);
+  for (int i = 0; i < triangles; ++i)
+  {
+    dVector3 v[3];
+    dGeomTriMeshGetTriangle(_o2, i, &v[0], &v[1], &v[2]);
+    for (int j = 0; j < 3; ++j)
+    {
+      samples.push_back(
+          {ignition::math::Vector3d(v[j][0], v[j][1], v[j][2]), 0});
+    }
+  }
+  return collideSamples(_o1, _o2, samples, _flags, _contact, _skip);
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the collider of a field with a geom class.
+/// \param[in] _class The class of the other geom.
+/// \return The collider, null for the classes that aren't handled.
+static dColliderFn *fieldCollider(int _class)
+{
+  switch (_class)
+  {
+    case dSphereClass:
+      return &collideSphere;
+    case dCapsuleClass:
+      return &collideCapsule;
+    case dBoxClass:
+      return &collideBox;
+    case dCylinderClass:
+      return &collideCylinder;
+    case dTriMeshClass:
+      return &collideTrimesh;
+    default:
+      return nullptr;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute the world bounds of a field geom, from the corners of
+/// its grid.
+static void fieldAABB(dGeomID _geom, dReal _aabb[6])
+{
+  const ignition::math::AxisAlignedBox box = fieldOf(_geom)->Box();
+  for (int i = 0; i < 3; ++i)
+  {
+    _aabb[2*i] = dInfinity;
+    _aabb[2*i+1] = -dInfinity;
+  }
+
+  for (int c = 0; c < 8; ++c)
+  {
+    const ignition::math::Vector3d corner(
+        (c & 1) ? box.Max().X() : box.Min().X(),
+        (c & 2) ? box.Max().Y() : box.Min().Y(),
+        (c & 4) ? box.Max().Z() : box.Min().Z());
+    const ignition::math::Vector3d world = toWorld(_geom, corner);
+    for (int i = 0; i < 3; ++i)
+    {
+      _aabb[2*i] = std::min<dReal>(_aabb[2*i], world[i]);
+      _aabb[2*i+1] = std::max<dReal>(_aabb[2*i+1], world[i]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEDistanceField::Init()
+{
+  std::lock_guard<std::mutex> lock(fieldMutex);
+  if (fieldUsers++ > 0)
+    return;
+
+  dGeomClass geomClass;
+  geomClass.bytes = sizeof(ODEDistanceFieldData);
+  geomClass.collider = &fieldCollider;
+  geomClass.aabb = &fieldAABB;
+  geomClass.aabb_test = nullptr;
+  geomClass.dtor = nullptr;
+  fieldClass = dCreateGeomClass(&geomClass);
+}
+
+//////////////////////////////////////////////////
+void ODEDistanceField::Fini()
+{
+  // dCloseODE drops the user classes with the last engine
+  std::lock_guard<std::mutex> lock(fieldMutex);
+  if (fieldUsers > 0 && --fieldUsers == 0)
+    fieldClass = -1;
+}
+
+//////////////////////////////////////////////////
+dGeomID ODEDistanceField::CreateGeom(
+    const common::SignedDistanceField *_field)
+{
+  if (!_field || !_field->Valid())
+    return nullptr;
+
+  const int geomClass = fieldClass;
+  if (geomClass < 0)
+    return nullptr;
+
+  dGeomID geom = dCreateGeom(geomClass);
+  static_cast<ODEDistanceFieldData *>(dGeomGetClassData(geom))->field =
+      _field;
+  return geom;
+}
+
+//////////////////////////////////////////////////
+bool ODEDistanceField::IsField(dGeomID _geom)
+{
+  const int geomClass = fieldClass;
+  return _geom && geomClass >= 0 && dGeomGetClass(_geom) == geomClass;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ODE_ODEDISTANCEFIELD_HH_
+#define GAZEBO_PHYSICS_ODE_ODEDISTANCEFIELD_HH_
+
+#include "gazebo/physics/ode/ode_inc.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace common
+  {
+    class SignedDistanceField;
+  }
+
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics_ode
+    /// \{
+
+    /// \brief ODE geom class of signed distance fields.
+    ///
+    /// A field geom collides with spheres, capsules, boxes, cylinders and
+    /// triangle meshes, by sampling points on the other geom and looking
+    /// up their distances in the field. The colliders are registered as an
+    /// ODE user class, between Init() and Fini().
+    class GZ_PHYSICS_VISIBLE ODEDistanceField
+    {
+      /// \brief Register the geom class. Called once per ODE physics
+      /// engine, after dInitODE2.
+      public: static void Init();
+
+      /// \brief Release the geom class. Called once per ODE physics
+      /// engine, before dCloseODE.
+      public: static void Fini();
+
+      /// \brief Create a geom of a field. The geom isn't in a space.
+      /// \param[in] _field The field, which must outlive the geom.
+      /// \return The geom, null if the class isn't registered.
+      public: static dGeomID CreateGeom(
+                  const common::SignedDistanceField *_field);
+
+      /// \brief Get whether a geom is a field geom.
+      /// \param[in] _geom The geom.
+      /// \return True for a geom created by CreateGeom().
+      public: static bool IsField(dGeomID _geom);
+    };
+    /// \}
+  }
+}
+#endif
@@ -26,6 +26,8 @@ ODEHeightmapShape::ODEHeightmapShape(CollisionPtr _parent)
     : HeightmapShape(_parent)
 {
   this->flipY = false;
+  // ODE reads large tables through GetHeightCallback
+  this->tileable = true;
 }
 
 //////////////////////////////////////////////////
@@ -110,19 +112,39 @@ void ODEHeightmapShape::Init()
 
 
   // Step 3: Setup a callback method for ODE
-  setOdeHeightfieldDetails(
-      this->odeData,
-      this->heights.data(),
-      // in meters
-      this->Size().X(),
-      // in meters
-      this->Size().Y(),
-      // number of vertices
-      this->vertSize,
-      // vertical (z-axis) offset
-      this->Pos().Z(),
-      // vertical thickness for closing the height map mesh
-      1.0);
+  if (this->tiles)
+  {
+    // The tiles are paged in as ODE reads the heights near the colliding
+    // geoms.
+    dGeomHeightfieldDataBuildCallback(
+        this->odeData,
+        this,
+        ODEHeightmapShape::GetHeightCallback,
+        this->Size().X(),  // width (in meters)
+        this->Size().Y(),  // height (in meters)
+        this->vertSize,    // width (sampling size)
+        this->vertSize,    // height (sampling size)
+        1.0,               // vertical (z-axis) scaling
+        this->Pos().Z(),   // vertical (z-axis) offset
+        1.0,               // vertical thickness
+        0);                // wrap mode
+  }
+  else
+  {
+    setOdeHeightfieldDetails(
+        this->odeData,
+        this->heights.data(),
+        // in meters
+        this->Size().X(),
+        // in meters
+        this->Size().Y(),
+        // number of vertices
+        this->vertSize,
+        // vertical (z-axis) offset
+        this->Pos().Z(),
+        // vertical thickness for closing the height map mesh
+        1.0);
+  }
 
   // Step 4: Restrict the bounds of the AABB to improve efficiency
   dGeomHeightfieldDataSetBounds(this->odeData, this->GetMinHeight(),
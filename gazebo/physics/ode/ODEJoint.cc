@@ -284,6 +284,12 @@ dJointFeedback *ODEJoint::GetFeedback()
   return nullptr;
 }
 
+//////////////////////////////////////////////////
+dJointID ODEJoint::JointId() const
+{
+  return this->jointId;
+}
+
 //////////////////////////////////////////////////
 void ODEJoint::SetUpperLimit(const unsigned int _index, const double _limit)
 {
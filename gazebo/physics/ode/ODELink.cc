@@ -101,6 +101,7 @@ void ODELink::Init()
         if (g->IsPlaceable() && g->GetCollisionId())
         {
           dGeomSetBody(g->GetCollisionId(), this->linkId);
+          g->PlaceCollisionParts();
         }
       }
     }
@@ -130,6 +131,8 @@ void ODELink::Init()
           << " does not exist, unable to set callbacks in ODELink::Init"
           << std::endl;
   }
+
+  this->SetContinuousCollision(this->ContinuousCollision());
 }
 
 //////////////////////////////////////////////////
@@ -177,6 +180,9 @@ void ODELink::MoveCallback(dBodyID _id)
 //////////////////////////////////////////////////
 void ODELink::Fini()
 {
+  if (this->odePhysics)
+    this->odePhysics->SetContinuousCollision(this, false);
+
   if (this->linkId)
     dBodyDestroy(this->linkId);
   this->linkId = nullptr;
@@ -186,6 +192,16 @@ void ODELink::Fini()
   Link::Fini();
 }
 
+//////////////////////////////////////////////////
+void ODELink::SetContinuousCollision(const bool _enable)
+{
+  Link::SetContinuousCollision(_enable);
+
+  // Static links have no body to sweep
+  if (this->odePhysics)
+    this->odePhysics->SetContinuousCollision(this, _enable && this->linkId);
+}
+
 //////////////////////////////////////////////////
 void ODELink::SetGravityMode(bool _mode)
 {
@@ -336,6 +352,7 @@ void ODELink::UpdateCollisionOffsets()
           dGeomSetOffsetPosition(g->GetCollisionId(),
               localPose.Pos().X(), localPose.Pos().Y(), localPose.Pos().Z());
           dGeomSetOffsetQuaternion(g->GetCollisionId(), q);
+          g->PlaceCollisionParts();
         }
       }
     }
@@ -737,8 +754,13 @@ void ODELink::SetKinematic(const bool &_state)
   if (this->linkId)
   {
     if (_state && !dBodyIsKinematic(this->linkId))
+    {
+      // A kinematic body keeps its velocity, so stop it where it is.
       dBodySetKinematic(this->linkId);
-    else if (dBodyIsKinematic(this->linkId))
+      dBodySetLinearVel(this->linkId, 0, 0, 0);
+      dBodySetAngularVel(this->linkId, 0, 0, 0);
+    }
+    else if (!_state && dBodyIsKinematic(this->linkId))
       dBodySetDynamic(this->linkId);
   }
   else if (!this->IsStatic() && this->initialized)
@@ -182,6 +182,10 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      // Documentation inherited
+      public: virtual void SetContinuousCollision(const bool _enable)
+          override;
+
       /// \brief ODE link handle
       private: dBodyID linkId;
 
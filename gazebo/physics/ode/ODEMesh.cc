@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <utility>
+#include <vector>
+
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
@@ -155,3 +158,78 @@ void ODEMesh::CreateMesh(unsigned int _numVertices, unsigned int _numIndices,
   memset(this->transform, 0, 32*sizeof(dReal));
   this->transformIndex = 0;
 }
+
+//////////////////////////////////////////////////
+bool ODEMesh::InitConvex(const common::Mesh *_hulls,
+    ODECollisionPtr _collision, const ignition::math::Vector3d &_scale)
+{
+  if (!_hulls)
+    return false;
+
+  // Release the geoms of a previous decomposition before their arrays
+  _collision->SetCollisionParts(std::vector<dGeomID>());
+  this->convexPlanes.clear();
+  this->convexPoints.clear();
+  this->convexPolygons.clear();
+
+  // A mirroring scale turns the triangles inside out
+  const bool flip = _scale.X() * _scale.Y() * _scale.Z() < 0;
+
+  std::vector<dGeomID> parts;
+  for (unsigned int i = 0; i < _hulls->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *hull = _hulls->GetSubMesh(i);
+    std::vector<dReal> points;
+    for (unsigned int j = 0; j < hull->GetVertexCount(); ++j)
+    {
+      const ignition::math::Vector3d v = hull->Vertex(j) * _scale;
+      points.push_back(v.X());
+      points.push_back(v.Y());
+      points.push_back(v.Z());
+    }
+
+    std::vector<dReal> planes;
+    std::vector<unsigned int> polygons;
+    for (unsigned int j = 0; j + 2 < hull->GetIndexCount(); j += 3)
+    {
+      unsigned int face[3] = {hull->GetIndex(j), hull->GetIndex(j+1),
+          hull->GetIndex(j+2)};
+      if (flip)
+        std::swap(face[1], face[2]);
+
+      const ignition::math::Vector3d a = hull->Vertex(face[0]) * _scale;
+      ignition::math::Vector3d normal =
+          (hull->Vertex(face[1]) * _scale - a).Cross(
+           hull->Vertex(face[2]) * _scale - a);
+      if (normal.SquaredLength() <= 0)
+        continue;
+      normal.Normalize();
+
+      planes.push_back(normal.X());
+      planes.push_back(normal.Y());
+      planes.push_back(normal.Z());
+      planes.push_back(normal.Dot(a));
+      polygons.push_back(3);
+      polygons.insert(polygons.end(), face, face + 3);
+    }
+
+    if (planes.size() < 16)
+      continue;
+
+    // ODE doesn't copy the arrays of a convex geom
+    this->convexPlanes.push_back(std::move(planes));
+    this->convexPoints.push_back(std::move(points));
+    this->convexPolygons.push_back(std::move(polygons));
+    parts.push_back(dCreateConvex(0, this->convexPlanes.back().data(),
+        this->convexPlanes.back().size() / 4,
+        this->convexPoints.back().data(),
+        this->convexPoints.back().size() / 3,
+        this->convexPolygons.back().data()));
+  }
+
+  if (parts.empty())
+    return false;
+
+  _collision->SetCollisionParts(parts);
+  return true;
+}
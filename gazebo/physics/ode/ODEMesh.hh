@@ -18,6 +18,8 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMESH_HH_
 
+#include <vector>
+
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/ode/ODETypes.hh"
@@ -57,6 +59,17 @@ namespace gazebo
                       ODECollisionPtr _collision,
                       const ignition::math::Vector3d &_scale);
 
+      /// \brief Create convex geoms for the collision, one per hull of a
+      /// convex decomposition.
+      /// \param[in] _hulls One triangle submesh per hull.
+      /// \param[in] _collision Pointer to the collision object.
+      /// \param[in] _scale Scaling factor.
+      /// \return False if no hull could be created.
+      /// \sa common::MeshManager::CreateConvexDecomposition
+      public: bool InitConvex(const common::Mesh *_hulls,
+                  ODECollisionPtr _collision,
+                  const ignition::math::Vector3d &_scale);
+
       /// \brief Update the collision mesh.
       public: virtual void Update();
 
@@ -85,6 +98,16 @@ namespace gazebo
 
       /// \brief The collision id that this mesh is attached to.
       private: dGeomID collisionId;
+
+      /// \brief Planes of the convex geoms, four values per face.
+      private: std::vector<std::vector<dReal>> convexPlanes;
+
+      /// \brief Points of the convex geoms, three values per point.
+      private: std::vector<std::vector<dReal>> convexPoints;
+
+      /// \brief Faces of the convex geoms, as a count and the indices of
+      /// the points per face.
+      private: std::vector<std::vector<unsigned int>> convexPolygons;
     };
     /// \}
   }
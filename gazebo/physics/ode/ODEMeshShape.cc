@@ -14,10 +14,15 @@
  * limitations under the License.
  *
 */
+#include <string>
+
 #include "gazebo/common/Mesh.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/SignedDistanceField.hh"
 
+#include "gazebo/physics/ode/ODEDistanceField.hh"
 #include "gazebo/physics/ode/ODEMesh.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
@@ -69,4 +74,78 @@ void ODEMeshShape::Init()
         boost::static_pointer_cast<ODECollision>(this->collisionParent),
         this->sdf->Get<ignition::math::Vector3d>("scale"));
   }
+
+  // Collide the convex hulls of the mesh with the other shapes
+  if (this->sdf->HasElement("gz:convex_decomposition") &&
+      this->sdf->Get<bool>("gz:convex_decomposition"))
+  {
+    std::string name = this->mesh->GetName() + "::convex_decomposition";
+    common::Mesh subMesh;
+    const common::Mesh *source = this->mesh;
+    if (this->submesh)
+    {
+      name += "::" + this->submesh->GetName();
+      sdf::ElementPtr submeshElem = this->sdf->GetElement("submesh");
+      if (submeshElem->HasElement("center") &&
+          submeshElem->Get<bool>("center"))
+      {
+        name += "::center";
+      }
+      subMesh.AddSubMesh(new common::SubMesh(this->submesh));
+      source = &subMesh;
+    }
+
+    common::MeshManager::Instance()->CreateConvexDecomposition(name, source);
+    if (!this->odeMesh->InitConvex(
+        common::MeshManager::Instance()->GetMesh(name),
+        boost::static_pointer_cast<ODECollision>(this->collisionParent),
+        this->sdf->Get<ignition::math::Vector3d>("scale")))
+    {
+      gzwarn << "Unable to decompose mesh [" << this->mesh->GetName()
+             << "] in convex hulls, using its triangles" << std::endl;
+    }
+  }
+  // Collide a static mesh through the signed distance field of its volume
+  else if (this->sdf->HasElement("gz:signed_distance_field") &&
+      this->sdf->Get<bool>("gz:signed_distance_field"))
+  {
+    this->InitDistanceField();
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEMeshShape::InitDistanceField()
+{
+  ODECollisionPtr collision =
+      boost::static_pointer_cast<ODECollision>(this->collisionParent);
+  if (!collision->IsStatic())
+  {
+    gzwarn << "Signed distance field of mesh [" << this->mesh->GetName()
+           << "] ignored, only static meshes have one" << std::endl;
+    return;
+  }
+
+  common::Mesh subMesh;
+  const common::Mesh *source = this->mesh;
+  if (this->submesh)
+  {
+    subMesh.AddSubMesh(new common::SubMesh(this->submesh));
+    source = &subMesh;
+  }
+
+  double resolution = 0;
+  if (this->sdf->HasElement("gz:signed_distance_field_resolution"))
+    resolution = this->sdf->Get<double>("gz:signed_distance_field_resolution");
+
+  const common::SignedDistanceField *field =
+      common::MeshManager::Instance()->DistanceField(source,
+      this->sdf->Get<ignition::math::Vector3d>("scale"), resolution);
+  dGeomID geom = ODEDistanceField::CreateGeom(field);
+  if (!geom)
+  {
+    gzwarn << "Unable to build the signed distance field of mesh ["
+           << this->mesh->GetName() << "], using its triangles" << std::endl;
+    return;
+  }
+  collision->SetCollisionParts({geom});
 }
@@ -49,6 +49,11 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Update();
 
+      /// \brief Collide the mesh through its signed distance field, set
+      /// as the only part of the collision.
+      /// \sa common::MeshManager::DistanceField
+      private: void InitDistanceField();
+
       /// \brief ODE collision mesh helper class.
       private: ODEMesh *odeMesh;
     };
@@ -93,10 +93,25 @@ void ODEMultiRayShape::UpdateRays()
   {
     boost::recursive_mutex::scoped_lock lock(*ode->GetPhysicsUpdateMutex());
 
+    this->hitCollisions.assign(this->rays.size(), nullptr);
+    this->physics = ode.get();
+
     // Do collision detection
     dSpaceCollide2((dGeomID) (this->superSpaceId),
         (dGeomID) (ode->GetSpaceId()),
         this, &UpdateCallback);
+    this->physics = nullptr;
+  }
+
+  // Apply the closest hit of each ray
+  for (unsigned int i = 0; i < this->hitCollisions.size(); ++i)
+  {
+    ODECollision *hitCollision = this->hitCollisions[i];
+    if (hitCollision)
+    {
+      this->rays[i]->SetRetro(hitCollision->GetLaserRetro());
+      this->rays[i]->SetCollisionName(hitCollision->GetScopedName());
+    }
   }
 }
 
@@ -128,6 +143,7 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
     ODECollision *collision1 = nullptr;
     ODECollision *collision2 = nullptr;
     dGeomID rayId = 0;
+    dGeomID hitGeom = 0;
 
     // Get pointers to the underlying collisions
     if (dGeomGetClass(_o1) == dGeomTransformClass)
@@ -155,13 +171,13 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
 
     // Figure out which one is a ray; note that this assumes
     // that the ODE dRayClass is used *soley* by the RayCollision.
+    // The ray parameters were set once in AddRay.
     if (dGeomGetClass(_o1) == dRayClass)
     {
       rayCollision = collision1;
       rayId = _o1;
       hitCollision = collision2;
-      dGeomRaySetParams(_o1, 0, 0);
-      dGeomRaySetClosestHit(_o1, 1);
+      hitGeom = _o2;
     }
     else if (dGeomGetClass(_o2) == dRayClass)
     {
@@ -169,15 +185,25 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
       rayCollision = collision2;
       hitCollision = collision1;
       rayId = _o2;
-      dGeomRaySetParams(_o2, 0, 0);
-      dGeomRaySetClosestHit(_o2, 1);
+      hitGeom = _o1;
     }
 
-    if (!self->defaultUpdate || (rayCollision && hitCollision))
+    // Merged meshes of baked collisions have no collision of their own
+    const bool baked = !hitCollision && hitGeom && self->physics &&
+        dGeomGetClass(hitGeom) == dTriMeshClass;
+
+    if (!self->defaultUpdate || (rayCollision && (hitCollision || baked)))
     {
       int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
 
-      if (n > 0 && self->defaultUpdate)
+      if (n > 0 && baked)
+      {
+        hitCollision = self->physics->BakedCollision(hitGeom,
+            hitGeom == _o1 ? contact.side1 : contact.side2);
+      }
+
+      // Standalone rays keep their shape in the geom data
+      if (n > 0 && rayId)
       {
         RayShape *shape = self->defaultUpdate ?
           boost::static_pointer_cast<RayShape>(rayCollision->GetShape()).get() :
@@ -197,8 +223,10 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
           //      << " pose[" << hitCollision->GetWorldPose() << "]"
           //      << "\n";
           shape->SetLength(contact.depth);
-          shape->SetRetro(hitCollision->GetLaserRetro());
-          shape->SetCollisionName(hitCollision->GetScopedName());
+
+          auto index = self->rayIndices.find(shape);
+          if (index != self->rayIndices.end())
+            self->hitCollisions[index->second] = hitCollision;
         }
       }
     }
@@ -235,5 +263,9 @@ void ODEMultiRayShape::AddRay(const ignition::math::Vector3d &_start,
   }
 
   ray->SetPoints(_start, _end);
+  dGeomRaySetParams(ray->ODEGeomId(), 0, 0);
+  dGeomRaySetClosestHit(ray->ODEGeomId(), 1);
+
+  this->rayIndices[ray.get()] = this->rays.size();
   this->rays.push_back(ray);
 }
@@ -17,7 +17,11 @@
 #ifndef GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 #define GAZEBO_PHYSICS_ODE_ODEMULTIRAYSHAPE_HH_
 
+#include <unordered_map>
+#include <vector>
+
 #include "gazebo/physics/MultiRayShape.hh"
+#include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -66,6 +70,19 @@ namespace gazebo
       /// \brief Helper to get the correct ray shape in the UpdateCallback
       /// function.
       private: bool defaultUpdate = true;
+
+      /// \brief Index of each ray in the rays vector, used by UpdateCallback
+      /// to record hits.
+      private: std::unordered_map<const RayShape *, unsigned int> rayIndices;
+
+      /// \brief Closest collision hit by each ray during UpdateRays. The hit
+      /// collision's retro and name are applied once per ray after the
+      /// collision pass, instead of for every closer hit found.
+      private: std::vector<ODECollision *> hitCollisions;
+
+      /// \brief Physics engine during UpdateRays, which maps the hits on
+      /// baked collisions back to their collision.
+      private: ODEPhysics *physics = nullptr;
     };
     /// \}
   }
@@ -17,25 +17,34 @@
 
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
 
 #include <sdf/sdf.hh>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Rand.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/common/Profiler.hh>
 
 #include "gazebo/util/Diagnostics.hh"
+#include "gazebo/util/IntrospectionManager.hh"
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/IterationProfiler.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Timer.hh"
+#include "gazebo/common/URI.hh"
 
 #include "gazebo/transport/Publisher.hh"
 
@@ -50,8 +59,10 @@
 #include "gazebo/physics/ContactManager.hh"
 
 #include "gazebo/physics/ode/ODECollision.hh"
+#include "gazebo/physics/ode/ODEDistanceField.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
+#include "gazebo/physics/ode/ODEStepMemory.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
 #include "gazebo/physics/ode/ODEGearboxJoint.hh"
 #include "gazebo/physics/ode/ODEHinge2Joint.hh"
@@ -98,36 +109,120 @@ class ContactUpdate_TBB
 };
 */
 
-class Colliders_TBB
+/// \brief Number of steps between two checks of the adaptive broad phase.
+static const unsigned int kBroadPhaseAdaptPeriod = 1000;
+
+/// \brief Largest number of objects that the adaptive broad phase puts in a
+/// simple space.
+static const size_t kSimpleSpaceMaxObjects = 8;
+
+/// \brief Largest number of hash space levels that the adaptive broad phase
+/// uses, beyond which objects sizes are too spread for a hash space.
+static const int kHashSpaceMaxLevels = 10;
+
+/// \brief Depth of the quadtree space.
+static const int kQuadTreeDepth = 6;
+
+/// \brief Vertices of the triangles of a box, two per face and wound
+/// counterclockwise seen from outside. Bit 0, 1 and 2 of a vertex select
+/// the positive side along x, y and z.
+static const int kBoxTriangles[36] = {
+  0, 4, 6,  0, 6, 2,
+  1, 3, 7,  1, 7, 5,
+  0, 1, 5,  0, 5, 4,
+  2, 6, 7,  2, 7, 3,
+  0, 2, 3,  0, 3, 1,
+  4, 5, 7,  4, 7, 6};
+
+//////////////////////////////////////////////////
+extern "C" void dMessageQuiet(int, const char *, va_list)
 {
-  public: Colliders_TBB(
-              std::vector<std::pair<ODECollision*, ODECollision*> > *_colliders,
-              ODEPhysics *_engine,
-              dContactGeom* _contactCollisions) :
-    colliders(_colliders),
-              engine(_engine), contactCollisions(_contactCollisions)
-  {
-    // dAllocateODEDataForThread(dAllocateMaskAll);
-  }
+}
 
-  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+//////////////////////////////////////////////////
+/// \brief Get the bounding boxes of the objects of a space. Planes and
+/// other unbounded geoms are left out, since every space type tests them
+/// against all the other objects.
+/// \param[in] _space The space.
+/// \return The bounding boxes, as min x, max x, min y, max y, min z and
+/// max z.
+static std::vector<std::array<dReal, 6>> boundedAABBs(dSpaceID _space)
+{
+  std::vector<std::array<dReal, 6>> result;
+  const int count = dSpaceGetNumGeoms(_space);
+  result.reserve(count);
+  for (int i = 0; i < count; ++i)
   {
-    for (size_t i = _r.begin(); i != _r.end(); i++)
+    std::array<dReal, 6> aabb;
+    dGeomGetAABB(dSpaceGetGeom(_space, i), aabb.data());
+    if (std::all_of(aabb.begin(), aabb.end(),
+          [](const dReal _v) { return std::isfinite(_v); }))
     {
-      ODECollision *collision1 = (*this->colliders)[i].first;
-      ODECollision *collision2 = (*this->colliders)[i].second;
-      this->engine->Collide(collision1, collision2, contactCollisions);
+      result.push_back(aabb);
     }
   }
-
-  private: std::vector< std::pair<ODECollision*, ODECollision*> > *colliders;
-  private: ODEPhysics *engine;
-  private: dContactGeom* contactCollisions;
-};
+  return result;
+}
 
 //////////////////////////////////////////////////
-extern "C" void dMessageQuiet(int, const char *, va_list)
+/// \brief Append the triangles of a box or triangle mesh geom to a merged
+/// mesh.
+/// \param[in] _geom The geom.
+/// \param[in] _origin Position of the merged mesh.
+/// \param[in] _owner Index of the collision of the geom in the merged mesh.
+/// \param[in,out] _region The merged mesh.
+static void bakeTriangles(dGeomID _geom, const dReal *_origin,
+    const unsigned int _owner, ODEBakedRegion &_region)
 {
+  std::vector<std::array<dReal, 3>> vertices;
+  std::vector<int> indices;
+
+  if (dGeomGetClass(_geom) == dBoxClass)
+  {
+    dVector3 lengths;
+    dGeomBoxGetLengths(_geom, lengths);
+    const dReal *pos = dGeomGetPosition(_geom);
+    const dReal *rot = dGeomGetRotation(_geom);
+    for (int i = 0; i < 8; ++i)
+    {
+      const dReal local[3] = {
+        (i & 1 ? 0.5 : -0.5) * lengths[0],
+        (i & 2 ? 0.5 : -0.5) * lengths[1],
+        (i & 4 ? 0.5 : -0.5) * lengths[2]};
+      std::array<dReal, 3> vertex;
+      for (int j = 0; j < 3; ++j)
+      {
+        vertex[j] = pos[j] + rot[j*4] * local[0] + rot[j*4+1] * local[1] +
+            rot[j*4+2] * local[2];
+      }
+      vertices.push_back(vertex);
+    }
+    indices.assign(kBoxTriangles, kBoxTriangles + 36);
+  }
+  else
+  {
+    const int count = dGeomTriMeshGetTriangleCount(_geom);
+    for (int i = 0; i < count; ++i)
+    {
+      dVector3 v[3];
+      dGeomTriMeshGetTriangle(_geom, i, &v[0], &v[1], &v[2]);
+      for (int k = 0; k < 3; ++k)
+      {
+        indices.push_back(vertices.size());
+        vertices.push_back({{v[k][0], v[k][1], v[k][2]}});
+      }
+    }
+  }
+
+  const int offset = _region.vertices.size() / 3;
+  for (const auto &vertex : vertices)
+  {
+    for (int j = 0; j < 3; ++j)
+      _region.vertices.push_back(static_cast<float>(vertex[j] - _origin[j]));
+  }
+  for (const int index : indices)
+    _region.indices.push_back(offset + index);
+  _region.owners.insert(_region.owners.end(), indices.size() / 3, _owner);
 }
 
 //////////////////////////////////////////////////
@@ -139,11 +234,17 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   // Collision detection init
   dInitODE2(0);
+  ODEDistanceField::Init();
 
   dAllocateODEDataForThread(dAllocateMaskAll);
 
   this->dataPtr->worldId = dWorldCreate();
 
+  // The step memory is counted, and kept from step to step in persistent
+  // mode.
+  if (!ODEStepMemory::Install(this->dataPtr->worldId))
+    gzerr << "Unable to set the step memory manager of ODE\n";
+
   this->dataPtr->spaceId = dHashSpaceCreate(0);
   dHashSpaceSetLevels(this->dataPtr->spaceId, -2, 8);
 
@@ -151,6 +252,26 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 
   this->dataPtr->colliders.resize(100);
 
+  this->dataPtr->narrowPhaseThreads = 0;
+  this->dataPtr->contactWarmStart = false;
+  this->dataPtr->contactWarmStartDistance = 0.01;
+  this->dataPtr->deterministic = false;
+  this->dataPtr->broadPhase = "hash";
+  this->dataPtr->activeBroadPhase = "hash";
+  this->dataPtr->spaceDirty = false;
+  this->dataPtr->sapAxisOrder = dSAP_AXES_XYZ;
+  this->dataPtr->broadPhasePairs = 0;
+  this->dataPtr->lastBroadPhasePairs = 0;
+  this->dataPtr->broadPhaseSteps = 0;
+  this->dataPtr->maxPenetration = 0;
+  this->dataPtr->bakeStatic = false;
+  this->dataPtr->bakeDirty = false;
+  this->dataPtr->bakeRegionSize = 50.0;
+  this->dataPtr->maxCollide = MAX_CONTACT_JOINTS;
+  this->dataPtr->ccdRay = nullptr;
+  for (int i = 0; i < MAX_CONTACT_JOINTS; ++i)
+    this->dataPtr->sequentialIndices[i] = i;
+
   // Set random seed for physics engine based on gazebo's random seed.
   // Note: this was moved from physics::PhysicsEngine constructor.
   this->SetSeed(ignition::math::Rand::Seed());
@@ -165,6 +286,34 @@ ODEPhysics::~ODEPhysics()
   this->dataPtr = nullptr;
 }
 
+//////////////////////////////////////////////////
+/// \brief Order colliders by the ids of their collisions, which don't
+/// depend on the broad phase.
+/// \param[in] _a First collider.
+/// \param[in] _b Second collider.
+/// \return True if _a comes before _b.
+static bool colliderLess(const std::pair<ODECollision *, ODECollision *> &_a,
+    const std::pair<ODECollision *, ODECollision *> &_b)
+{
+  const uint32_t a1 = _a.first->GetId();
+  const uint32_t a2 = _a.second->GetId();
+  const uint32_t b1 = _b.first->GetId();
+  const uint32_t b2 = _b.second->GetId();
+  return std::make_pair(std::min(a1, a2), std::max(a1, a2)) <
+      std::make_pair(std::min(b1, b2), std::max(b1, b2));
+}
+
+//////////////////////////////////////////////////
+/// \brief Get whether a collision collides with its triangles, and not
+/// with the convex hulls of a decomposition or with a distance field.
+/// \param[in] _collision The collision.
+/// \return True for a mesh without parts.
+static bool collidesAsTrimesh(const ODECollision *_collision)
+{
+  return _collision->HasType(Base::MESH_SHAPE) &&
+      _collision->CollisionParts().empty();
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Load(sdf::ElementPtr _sdf)
 {
@@ -187,6 +336,48 @@ void ODEPhysics::Load(sdf::ElementPtr _sdf)
     dWorldSetQuickStepInertiaRatioReduction(this->dataPtr->worldId, true);
   }
 
+  // Multi-threaded narrow phase collision is opt-in.
+  if (solverElem->HasElement("gz:narrow_phase_threads"))
+  {
+    this->SetNarrowPhaseThreads(
+        solverElem->Get<int>("gz:narrow_phase_threads"));
+  }
+
+  // Contact warm starting is opt-in.
+  if (solverElem->HasElement("gz:contact_warm_start"))
+  {
+    this->SetContactWarmStart(solverElem->Get<bool>("gz:contact_warm_start"));
+  }
+
+  // Deterministic stepping is opt-in.
+  if (solverElem->HasElement("gz:deterministic"))
+    this->SetDeterministic(solverElem->Get<bool>("gz:deterministic"));
+
+  // The default broad phase is a hash space.
+  if (solverElem->HasElement("gz:broad_phase"))
+    this->SetBroadPhase(solverElem->Get<std::string>("gz:broad_phase"));
+
+  // Persistent step memory is opt-in.
+  if (solverElem->HasElement("gz:persistent_step_memory"))
+  {
+    ODEStepMemory::SetPersistent(
+        solverElem->Get<bool>("gz:persistent_step_memory"));
+  }
+  if (solverElem->HasElement("gz:step_memory_huge_pages"))
+  {
+    ODEStepMemory::SetHugePages(
+        solverElem->Get<bool>("gz:step_memory_huge_pages"));
+  }
+
+  // Baking static collisions is opt-in.
+  if (solverElem->HasElement("gz:bake_region_size"))
+    this->SetBakeRegionSize(solverElem->Get<double>("gz:bake_region_size"));
+  if (solverElem->HasElement("gz:bake_static_collisions"))
+  {
+    this->SetBakeStaticCollisions(
+        solverElem->Get<bool>("gz:bake_static_collisions"));
+  }
+
   /// \TODO: defaultvelocity decay!? This is BAD if it's true.
   dWorldSetDamping(this->dataPtr->worldId, 0.0001, 0.0001);
 
@@ -348,6 +539,14 @@ void ODEPhysics::OnPhysicsMsg(ConstPhysicsPtr &_msg)
 //////////////////////////////////////////////////
 void ODEPhysics::Init()
 {
+  common::URI uri(this->world->URI());
+  uri.Query().Insert("p", "physics/broad_phase_pairs");
+  this->dataPtr->introspectionItems.push_back(uri.Str());
+  util::IntrospectionManager::Instance()->Register<int>(uri.Str(),
+      std::function<int()>([this]()
+      {
+        return static_cast<int>(this->BroadPhasePairCount());
+      }));
 }
 
 //////////////////////////////////////////////////
@@ -361,37 +560,91 @@ void ODEPhysics::InitForThread()
 void ODEPhysics::UpdateCollision()
 {
   DIAG_TIMER_START("ODEPhysics::UpdateCollision");
-  IGN_PROFILE("ODEPhysics:UpdateCollision");
-  IGN_PROFILE_BEGIN("dSpaceCollide");
+  GZ_PROFILE("ODEPhysics:UpdateCollision");
+  GZ_PROFILE_BEGIN("dSpaceCollide");
+
+  common::ProfiledLock<boost::recursive_mutex> lock(*this->physicsUpdateMutex,
+      this->PhysicsUpdateLockStats());
+
+  // Keep the forces of the contacts of the previous step before their
+  // joints are destroyed.
+  if (this->dataPtr->contactWarmStart)
+    this->CacheContacts();
 
-  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   dJointGroupEmpty(this->dataPtr->contactGroup);
 
+  if (this->dataPtr->broadPhase == "adaptive" &&
+      this->dataPtr->broadPhaseSteps++ % kBroadPhaseAdaptPeriod == 0)
+  {
+    this->AdaptBroadPhase();
+  }
+  if (this->dataPtr->spaceDirty)
+    this->CreateSpace();
+  if (this->dataPtr->bakeDirty)
+    this->Bake();
+
   unsigned int i = 0;
   this->dataPtr->collidersCount = 0;
+  this->dataPtr->bakedColliders.clear();
   this->dataPtr->trimeshCollidersCount = 0;
   this->dataPtr->jointFeedbackIndex = 0;
 
   // Reset the contact count
   this->contactManager->ResetCount();
+  this->dataPtr->maxPenetration = 0;
+
+  // max_contacts specified globally
+  this->dataPtr->maxCollide = MAX_CONTACT_JOINTS;
+  if (this->GetMaxContacts() > 0 && this->GetMaxContacts() < MAX_CONTACT_JOINTS)
+    this->dataPtr->maxCollide = this->GetMaxContacts();
 
   // Do collision detection; this will add contacts to the contact group
+  this->dataPtr->broadPhasePairs = 0;
   dSpaceCollide(this->dataPtr->spaceId, this, CollisionCallback);
+  this->dataPtr->lastBroadPhasePairs = this->dataPtr->broadPhasePairs;
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "dSpaceCollide");
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 
-  IGN_PROFILE_BEGIN("collideShapes");
+  // The contact joints are created, and the islands solved, in collider
+  // order. Fix it, so that it doesn't depend on the broad phase.
+  if (this->dataPtr->deterministic)
+  {
+    std::sort(this->dataPtr->colliders.begin(),
+        this->dataPtr->colliders.begin() + this->dataPtr->collidersCount,
+        colliderLess);
+    std::sort(this->dataPtr->trimeshColliders.begin(),
+        this->dataPtr->trimeshColliders.begin() +
+        this->dataPtr->trimeshCollidersCount, colliderLess);
+    std::stable_sort(this->dataPtr->bakedColliders.begin(),
+        this->dataPtr->bakedColliders.end(),
+        [](const std::pair<ODECollision *, ODEBakedRegion *> &_a,
+           const std::pair<ODECollision *, ODEBakedRegion *> &_b)
+        {
+          return _a.first->GetId() < _b.first->GetId();
+        });
+  }
+
+  GZ_PROFILE_BEGIN("collideShapes");
   // Generate non-trimesh collisions.
-  for (i = 0; i < this->dataPtr->collidersCount; ++i)
+  if (this->dataPtr->narrowPhaseThreads > 1 &&
+      this->dataPtr->collidersCount > 1)
+  {
+    this->ParallelCollide();
+  }
+  else
   {
-    this->Collide(this->dataPtr->colliders[i].first,
-        this->dataPtr->colliders[i].second, this->dataPtr->contactCollisions);
+    for (i = 0; i < this->dataPtr->collidersCount; ++i)
+    {
+      this->Collide(this->dataPtr->colliders[i].first,
+          this->dataPtr->colliders[i].second,
+          this->dataPtr->contactCollisions);
+    }
   }
   DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideShapes");
-  IGN_PROFILE_END();
+  GZ_PROFILE_END();
 
 
-  IGN_PROFILE_BEGIN("collideTrimeshes");
+  GZ_PROFILE_BEGIN("collideTrimeshes");
   // Generate trimesh collision.
   // This must happen in this thread sequentially
   for (i = 0; i < this->dataPtr->trimeshCollidersCount; ++i)
@@ -400,65 +653,270 @@ void ODEPhysics::UpdateCollision()
     ODECollision *collision2 = this->dataPtr->trimeshColliders[i].second;
     this->Collide(collision1, collision2, this->dataPtr->contactCollisions);
   }
-  DIAG_TIMER_LAP("UpdateCollision", "collideTrimeshes");
-  IGN_PROFILE_END();
+  DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideTrimeshes");
+  GZ_PROFILE_END();
+
+  GZ_PROFILE_BEGIN("collideBaked");
+  for (const auto &collider : this->dataPtr->bakedColliders)
+    this->CollideBaked(collider.first, collider.second);
+  DIAG_TIMER_LAP("ODEPhysics::UpdateCollision", "collideBaked");
+  GZ_PROFILE_END();
 
   DIAG_TIMER_STOP("ODEPhysics::UpdateCollision");
 }
 
+/// \brief Fewest contact feedbacks whose wrenches are filled in parallel.
+static const unsigned int kParallelWrenchCount = 256;
+
+//////////////////////////////////////////////////
+/// \brief Fill the wrenches of a contact from its joint feedbacks, in the
+/// frames of the two links.
+/// \param[in] _feedback The joint feedbacks of the contact.
+static void fillContactWrenches(const ODEJointFeedback &_feedback)
+{
+  Contact *contact = _feedback.contact;
+  GZ_ASSERT(contact->collision1 != nullptr, "Collision 1 is null");
+  GZ_ASSERT(contact->collision2 != nullptr, "Collision 2 is null");
+
+  // The rotations of the links are the same for all the points of the
+  // contact, so they are converted once to matrices.
+  const ignition::math::Matrix3d rot1(
+      contact->collision1->GetLink()->WorldPose().Rot().Inverse());
+  const ignition::math::Matrix3d rot2(
+      contact->collision2->GetLink()->WorldPose().Rot().Inverse());
+
+  for (int j = 0; j < _feedback.count; ++j)
+  {
+    const dJointFeedback &fb = _feedback.feedbacks[j];
+    JointWrench &wrench = contact->wrench[j];
+
+    // set force torque in link frame
+    wrench.body1Force =
+        rot1 * ignition::math::Vector3d(fb.f1[0], fb.f1[1], fb.f1[2]);
+    wrench.body2Force =
+        rot2 * ignition::math::Vector3d(fb.f2[0], fb.f2[1], fb.f2[2]);
+    wrench.body1Torque =
+        rot1 * ignition::math::Vector3d(fb.t1[0], fb.t1[1], fb.t1[2]);
+    wrench.body2Torque =
+        rot2 * ignition::math::Vector3d(fb.t2[0], fb.t2[1], fb.t2[2]);
+  }
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::UpdatePhysics()
 {
   DIAG_TIMER_START("ODEPhysics::UpdatePhysics");
-  IGN_PROFILE("ODEPhysics:UpdatePhysics");
+  GZ_PROFILE("ODEPhysics:UpdatePhysics");
 
   // need to lock, otherwise might conflict with world resetting
   {
-    boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+    common::ProfiledLock<boost::recursive_mutex> lock(
+        *this->physicsUpdateMutex, this->PhysicsUpdateLockStats());
+
+    // Positions that the swept links start the step from
+    if (!this->dataPtr->ccdLinks.empty())
+    {
+      this->dataPtr->ccdStarts.resize(this->dataPtr->ccdLinks.size());
+      for (std::size_t i = 0; i < this->dataPtr->ccdLinks.size(); ++i)
+      {
+        dBodyID body = this->dataPtr->ccdLinks[i]->GetODEId();
+        if (body && dBodyIsEnabled(body) && !dBodyIsKinematic(body))
+        {
+          const dReal *p = dBodyGetPosition(body);
+          this->dataPtr->ccdStarts[i].Set(p[0], p[1], p[2]);
+        }
+        else
+          this->dataPtr->ccdStarts[i] = ignition::math::Vector3d::NaN;
+      }
+    }
 
     // Update the dynamical model
     (*(this->dataPtr->physicsStepFunc))
       (this->dataPtr->worldId, this->maxStepSize);
 
-    ignition::math::Vector3d f1, f2, t1, t2;
+    if (!this->dataPtr->ccdLinks.empty())
+      this->SweepContinuousCollisions();
 
-    // Set the joint contact feedback for each contact.
-    for (unsigned int i = 0; i < this->dataPtr->jointFeedbackIndex; ++i)
+    // Set the joint contact feedback for each contact. Contacts only get
+    // a feedback when someone reads them, see ContactManager::NewContact.
+    const unsigned int count = this->dataPtr->jointFeedbackIndex;
+    auto fill = [this](const tbb::blocked_range<unsigned int> &_r)
     {
-      Contact *contactFeedback = this->dataPtr->jointFeedbacks[i]->contact;
-      Collision *col1 = contactFeedback->collision1;
-      Collision *col2 = contactFeedback->collision2;
-
-      GZ_ASSERT(col1 != nullptr, "Collision 1 is null");
-      GZ_ASSERT(col2 != nullptr, "Collision 2 is null");
-
-      for (int j = 0; j < this->dataPtr->jointFeedbacks[i]->count; ++j)
+      for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+        fillContactWrenches(*this->dataPtr->jointFeedbacks[i]);
+    };
+
+    // Contacts are independent, so many of them are spread on the narrow
+    // phase threads.
+    if (count >= kParallelWrenchCount && this->dataPtr->narrowPhaseArena &&
+        this->dataPtr->narrowPhaseThreads > 1)
+    {
+      this->dataPtr->narrowPhaseArena->execute([&fill, count]()
       {
-        dJointFeedback fb = this->dataPtr->jointFeedbacks[i]->feedbacks[j];
-        f1.Set(fb.f1[0], fb.f1[1], fb.f1[2]);
-        f2.Set(fb.f2[0], fb.f2[1], fb.f2[2]);
-        t1.Set(fb.t1[0], fb.t1[1], fb.t1[2]);
-        t2.Set(fb.t2[0], fb.t2[1], fb.t2[2]);
-
-        // set force torque in link frame
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Force =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(f1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Force =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(f2);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body1Torque =
-             col1->GetLink()->WorldPose().Rot().RotateVectorReverse(t1);
-        this->dataPtr->jointFeedbacks[i]->contact->wrench[j].body2Torque =
-             col2->GetLink()->WorldPose().Rot().RotateVectorReverse(t2);
-      }
+        tbb::parallel_for(tbb::blocked_range<unsigned int>(0, count,
+              kParallelWrenchCount / 4), fill);
+      });
+    }
+    else if (count > 0)
+    {
+      fill(tbb::blocked_range<unsigned int>(0, count));
     }
   }
 
   DIAG_TIMER_STOP("ODEPhysics::UpdatePhysics");
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SetContinuousCollision(ODELink *_link, const bool _enable)
+{
+  auto &links = this->dataPtr->ccdLinks;
+  auto iter = std::find(links.begin(), links.end(), _link);
+  if (_enable && iter == links.end())
+    links.push_back(_link);
+  else if (!_enable && iter != links.end())
+    links.erase(iter);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::ContinuousCollisionLinkCount() const
+{
+  return this->dataPtr->ccdLinks.size();
+}
+
+/// \brief Nearest hit of a ray sweeping a link.
+struct ODESweep
+{
+  /// \brief The sweeping ray.
+  dGeomID ray;
+
+  /// \brief Body of the swept link, whose geoms are skipped.
+  dBodyID body;
+
+  /// \brief Model of the swept link.
+  const Model *model;
+
+  /// \brief Distance of the nearest hit along the ray.
+  dReal nearest;
+};
+
+//////////////////////////////////////////////////
+/// \brief Collide the sweeping ray with a geom or a space.
+/// \param[in] _data The ODESweep.
+/// \param[in] _o1 First geom.
+/// \param[in] _o2 Second geom.
+static void sweepCallback(void *_data, dGeomID _o1, dGeomID _o2)
+{
+  ODESweep *sweep = static_cast<ODESweep *>(_data);
+  dGeomID other = _o1 == sweep->ray ? _o2 : _o1;
+
+  if (dGeomIsSpace(other))
+  {
+    dSpaceCollide2(sweep->ray, other, _data, &sweepCallback);
+    return;
+  }
+
+  // The link doesn't stop on itself, on rays, on what it doesn't collide
+  // with, or on the links of its model, which move along with it.
+  if (dGeomGetBody(other) == sweep->body ||
+      dGeomGetClass(other) == dRayClass ||
+      !(dGeomGetCategoryBits(other) & dGeomGetCollideBits(sweep->ray)))
+  {
+    return;
+  }
+  ODECollision *collision = static_cast<ODECollision *>(dGeomGetData(other));
+  if (collision && collision->GetLink() &&
+      collision->GetLink()->GetModel().get() == sweep->model)
+  {
+    return;
+  }
+
+  dContactGeom contact;
+  if (dCollide(sweep->ray, other, 1, &contact, sizeof(contact)) > 0)
+    sweep->nearest = std::min(sweep->nearest, contact.depth);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SweepContinuousCollisions()
+{
+  if (!this->dataPtr->ccdRay)
+    this->dataPtr->ccdRay = dCreateRay(nullptr, 1.0);
+
+  for (std::size_t i = 0; i < this->dataPtr->ccdLinks.size(); ++i)
+  {
+    const ignition::math::Vector3d &start = this->dataPtr->ccdStarts[i];
+    if (!start.IsFinite())
+      continue;
+
+    ODELink *link = this->dataPtr->ccdLinks[i];
+    dBodyID body = link->GetODEId();
+    const dReal *p = dBodyGetPosition(body);
+    ignition::math::Vector3d motion =
+        ignition::math::Vector3d(p[0], p[1], p[2]) - start;
+    const double distance = motion.Length();
+    const double radius = link->ContinuousCollisionRadius();
+    if (radius <= 0 || distance <= radius)
+      continue;
+
+    // Sweep the sphere from the start of the step to past its end
+    motion /= distance;
+    ODESweep sweep;
+    sweep.ray = this->dataPtr->ccdRay;
+    sweep.body = body;
+    sweep.model = link->GetModel().get();
+    sweep.nearest = distance + radius;
+    dGeomRaySet(sweep.ray, start.X(), start.Y(), start.Z(),
+        motion.X(), motion.Y(), motion.Z());
+    dGeomRaySetLength(sweep.ray, sweep.nearest);
+
+    unsigned int collideBits = GZ_ALL_COLLIDE;
+    Collision_V collisions = link->GetCollisions();
+    if (!collisions.empty())
+    {
+      ODECollisionPtr collision =
+          boost::static_pointer_cast<ODECollision>(collisions.front());
+      if (collision->GetCollisionId())
+        collideBits = dGeomGetCollideBits(collision->GetCollisionId());
+    }
+    dGeomSetCollideBits(sweep.ray, collideBits);
+
+    dSpaceCollide2(sweep.ray, reinterpret_cast<dGeomID>(
+          this->dataPtr->spaceId), &sweep, &sweepCallback);
+
+    // Stop where the sphere touches the hit, the next step collides there
+    if (sweep.nearest - radius < distance)
+    {
+      const ignition::math::Vector3d stop =
+          start + motion * std::max(0.0, sweep.nearest - radius);
+      dBodySetPosition(body, stop.X(), stop.Y(), stop.Z());
+      ODELink::MoveCallback(body);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+double ODEPhysics::MaxPenetration() const
+{
+  return this->dataPtr->maxPenetration;
+}
+
 //////////////////////////////////////////////////
 void ODEPhysics::Fini()
 {
+  for (const auto &item : this->dataPtr->introspectionItems)
+    util::IntrospectionManager::Instance()->Unregister(item);
+  this->dataPtr->introspectionItems.clear();
+
+  this->UnbakeStaticCollisions();
+  this->dataPtr->bakeDirty = false;
+
+  if (this->dataPtr->ccdRay)
+    dGeomDestroy(this->dataPtr->ccdRay);
+  this->dataPtr->ccdRay = nullptr;
+  this->dataPtr->ccdLinks.clear();
+
+  // The world is destroyed by the first call
+  if (this->dataPtr->worldId)
+    ODEDistanceField::Fini();
   dCloseODE();
 
   if (this->dataPtr->contactGroup)
@@ -494,6 +952,7 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+  this->ClearContactCache();
 }
 
 //////////////////////////////////////////////////
@@ -525,6 +984,11 @@ CollisionPtr ODEPhysics::CreateCollision(const std::string &_type,
   ShapePtr shape = this->CreateShape(_type, collision);
   collision->SetShape(shape);
   shape->SetWorld(_body->GetWorld());
+
+  // Bake again to include new static collisions
+  if (this->dataPtr->bakeStatic && _body->IsStatic())
+    this->dataPtr->bakeDirty = true;
+
   return collision;
 }
 
@@ -659,123 +1123,695 @@ ODEPhysics::ConvertWorldStepSolverType(const std::string &_solverType)
           << "], returning ODE_DANTZIG"
           << std::endl;
   }
-  return result;
+  return result;
+}
+
+//////////////////////////////////////////////////
+std::string
+ODEPhysics::ConvertWorldStepSolverType(const World_Solver_Type _solverType)
+{
+  std::string result;
+  switch (_solverType)
+  {
+    case ODE_DEFAULT:
+    {
+      result = "ODE_DANTZIG";
+      break;
+    }
+    case DART_PGS:
+    {
+      result = "DART_PGS";
+      break;
+    }
+    case BULLET_LEMKE:
+    {
+      result = "BULLET_LEMKE";
+      break;
+    }
+    case BULLET_PGS:
+    {
+      result = "BULLET_PGS";
+      break;
+    }
+    default:
+    {
+      result = "unknown";
+      gzerr << "Unrecognized world step solver [" << _solverType << "]"
+            << std::endl;
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetSORPGSPreconIters(unsigned int _iters)
+{
+  this->sdf->GetElement("ode")->GetElement("solver")->
+    GetElement("precon_iters")->Set(_iters);
+
+  dWorldSetQuickStepPreconIterations(this->dataPtr->worldId, _iters);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetSORPGSIters(unsigned int _iters)
+{
+  this->sdf->GetElement("ode")->GetElement(
+      "solver")->GetElement("iters")->Set(_iters);
+  dWorldSetQuickStepNumIterations(this->dataPtr->worldId, _iters);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetSORPGSW(double _w)
+{
+  this->sdf->GetElement("ode")->GetElement(
+      "solver")->GetElement("sor")->Set(_w);
+  dWorldSetQuickStepW(this->dataPtr->worldId, _w);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetFrictionModel(const std::string &_fricModel)
+{
+  /// Uncomment this until sdformat changes (sdformat repo issue #96)
+  ///
+  /// this->sdf->GetElement("ode")->GetElement(
+  ///   "solver")->GetElement("friction_model")->Set(_fricModel);
+  dWorldSetQuickStepFrictionModel(this->dataPtr->worldId,
+    ConvertFrictionModel(_fricModel));
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetWorldCFM(double _cfm)
+{
+  sdf::ElementPtr elem = this->sdf->GetElement("ode");
+  elem = elem->GetElement("constraints");
+  elem->GetElement("cfm")->Set(_cfm);
+
+  dWorldSetCFM(this->dataPtr->worldId, _cfm);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetWorldERP(double _erp)
+{
+  sdf::ElementPtr elem = this->sdf->GetElement("ode");
+  elem = elem->GetElement("constraints");
+  elem->GetElement("erp")->Set(_erp);
+  dWorldSetERP(this->dataPtr->worldId, _erp);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetContactMaxCorrectingVel(double _vel)
+{
+  this->sdf->GetElement("ode")->GetElement(
+      "constraints")->GetElement(
+        "contact_max_correcting_vel")->Set(_vel);
+  dWorldSetContactMaxCorrectingVel(this->dataPtr->worldId, _vel);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetContactSurfaceLayer(double _depth)
+{
+  this->sdf->GetElement("ode")->GetElement(
+      "constraints")->GetElement("contact_surface_layer")->Set(_depth);
+  dWorldSetContactSurfaceLayer(this->dataPtr->worldId, _depth);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetMaxContacts(unsigned int _maxContacts)
+{
+  this->dataPtr->maxContacts = _maxContacts;
+  this->sdf->GetElement("max_contacts")->GetValue()->Set(_maxContacts);
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetNarrowPhaseThreads(const int _threads)
+{
+  // The pool size of the physics threads bounds the narrow phase.
+  const unsigned int bound = common::ThreadConfig::Instance()->PoolSize(
+      "physics", static_cast<unsigned int>(std::max(0, _threads)));
+  this->dataPtr->narrowPhaseThreads =
+    std::min(std::max(0, _threads), static_cast<int>(bound));
+}
+
+//////////////////////////////////////////////////
+int ODEPhysics::NarrowPhaseThreads() const
+{
+  return this->dataPtr->narrowPhaseThreads;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetContactWarmStart(const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->contactWarmStart = _enable;
+  this->ClearContactCache();
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::ContactWarmStart() const
+{
+  return this->dataPtr->contactWarmStart;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetContactWarmStartDistance(const double _distance)
+{
+  this->dataPtr->contactWarmStartDistance = std::max(0.0, _distance);
+}
+
+//////////////////////////////////////////////////
+double ODEPhysics::ContactWarmStartDistance() const
+{
+  return this->dataPtr->contactWarmStartDistance;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetDeterministic(const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->deterministic = _enable;
+  dWorldSetDeterministic(this->dataPtr->worldId, _enable);
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::Deterministic() const
+{
+  return this->dataPtr->deterministic;
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::SetBroadPhase(const std::string &_type)
+{
+  if (_type != "hash" && _type != "sap" && _type != "quadtree" &&
+      _type != "simple" && _type != "adaptive")
+  {
+    gzerr << "Unknown broad phase[" << _type << "], expected hash, sap, "
+          << "quadtree, simple or adaptive" << std::endl;
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->broadPhase = _type;
+  if (_type == "adaptive")
+  {
+    // Check at the start of the next step
+    this->dataPtr->broadPhaseSteps = 0;
+  }
+  else if (_type != this->dataPtr->activeBroadPhase)
+  {
+    this->dataPtr->activeBroadPhase = _type;
+    this->dataPtr->spaceDirty = true;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string ODEPhysics::BroadPhase() const
+{
+  return this->dataPtr->broadPhase;
+}
+
+//////////////////////////////////////////////////
+std::string ODEPhysics::ActiveBroadPhase() const
+{
+  return this->dataPtr->activeBroadPhase;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::BroadPhasePairCount() const
+{
+  return this->dataPtr->lastBroadPhasePairs;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetBakeStaticCollisions(const bool _enable)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+  this->dataPtr->bakeStatic = _enable;
+  this->UnbakeStaticCollisions();
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::BakeStaticCollisions() const
+{
+  return this->dataPtr->bakeStatic;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetBakeRegionSize(const double _size)
+{
+  if (_size <= 0)
+  {
+    gzerr << "Bake region size[" << _size << "] must be positive\n";
+    return;
+  }
+  this->dataPtr->bakeRegionSize = _size;
+}
+
+//////////////////////////////////////////////////
+double ODEPhysics::BakeRegionSize() const
+{
+  return this->dataPtr->bakeRegionSize;
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::BakedRegionCount() const
+{
+  return this->dataPtr->bakedRegions.size();
+}
+
+//////////////////////////////////////////////////
+ODECollision *ODEPhysics::BakedCollision(dGeomID _geom,
+    const int _triangle) const
+{
+  auto iter = this->dataPtr->bakedGeoms.find(_geom);
+  if (iter == this->dataPtr->bakedGeoms.end())
+    return nullptr;
+
+  const ODEBakedRegion *region = iter->second;
+  if (_triangle < 0 ||
+      static_cast<size_t>(_triangle) >= region->owners.size())
+  {
+    return nullptr;
+  }
+  return region->collisions[region->owners[_triangle]];
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::UnbakeStaticCollisions()
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  for (auto &region : this->dataPtr->bakedRegions)
+  {
+    if (region->geom)
+      dGeomDestroy(region->geom);
+    if (region->data)
+      dGeomTriMeshDataDestroy(region->data);
+  }
+  this->dataPtr->bakedRegions.clear();
+  this->dataPtr->bakedGeoms.clear();
+  this->dataPtr->bakedColliders.clear();
+
+  for (ODECollision *collision : this->dataPtr->bakedCollisions)
+  {
+    dGeomID geom = collision->GetCollisionId();
+    if (geom && dGeomGetSpace(geom) == 0)
+      dSpaceAdd(collision->GetSpaceId(), geom);
+    collision->SetBaked(false);
+  }
+  this->dataPtr->bakedCollisions.clear();
+
+  this->dataPtr->bakeDirty = this->dataPtr->bakeStatic;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::Bake()
+{
+  this->UnbakeStaticCollisions();
+  this->dataPtr->bakeDirty = false;
+  if (!this->dataPtr->bakeStatic)
+    return;
+
+  // Static collisions of all the models, nested models included
+  std::vector<ODECollision *> collisions;
+  for (const auto &link : this->world->AllLinks())
+  {
+    if (!link->IsStatic())
+      continue;
+    for (const auto &collision : link->GetCollisions())
+    {
+      collisions.push_back(
+          boost::static_pointer_cast<ODECollision>(collision).get());
+    }
+  }
+
+  // Only boxes and triangle meshes are baked, since the other shapes have
+  // exact colliders. Collisions with custom category bits, such as
+  // sensors, are left out.
+  const double size = this->dataPtr->bakeRegionSize;
+  std::map<std::pair<int, int>, std::unique_ptr<ODEBakedRegion> > regions;
+  for (ODECollision *collision : collisions)
+  {
+    dGeomID geom = collision->GetCollisionId();
+    if (!geom || !collision->Bakeable() || dGeomGetBody(geom) ||
+        dGeomGetSpace(geom) == 0 ||
+        dGeomGetCategoryBits(geom) != GZ_FIXED_COLLIDE ||
+        (dGeomGetClass(geom) != dBoxClass &&
+         dGeomGetClass(geom) != dTriMeshClass))
+    {
+      continue;
+    }
+
+    dReal aabb[6];
+    dGeomGetAABB(geom, aabb);
+    const std::pair<int, int> key(
+        static_cast<int>(std::floor(0.5 * (aabb[0] + aabb[1]) / size)),
+        static_cast<int>(std::floor(0.5 * (aabb[2] + aabb[3]) / size)));
+    const dReal origin[3] = {
+        (key.first + 0.5) * size, (key.second + 0.5) * size, 0};
+
+    std::unique_ptr<ODEBakedRegion> &region = regions[key];
+    if (!region)
+      region.reset(new ODEBakedRegion);
+
+    bakeTriangles(geom, origin, region->collisions.size(), *region);
+    region->collisions.push_back(collision);
+
+    dSpaceRemove(dGeomGetSpace(geom), geom);
+    collision->SetBaked(true);
+    this->dataPtr->bakedCollisions.push_back(collision);
+  }
+
+  for (auto &entry : regions)
+  {
+    ODEBakedRegion *region = entry.second.get();
+    region->data = dGeomTriMeshDataCreate();
+    dGeomTriMeshDataBuildSingle(region->data,
+        region->vertices.data(), 3*sizeof(region->vertices[0]),
+        region->vertices.size() / 3,
+        region->indices.data(), region->indices.size(),
+        3*sizeof(region->indices[0]));
+
+    region->geom = dCreateTriMesh(this->dataPtr->spaceId, region->data,
+        0, 0, 0);
+    dGeomSetPosition(region->geom, (entry.first.first + 0.5) * size,
+        (entry.first.second + 0.5) * size, 0);
+    dGeomSetData(region->geom, nullptr);
+    dGeomSetCategoryBits(region->geom, GZ_FIXED_COLLIDE);
+    dGeomSetCollideBits(region->geom, ~GZ_FIXED_COLLIDE);
+
+    this->dataPtr->bakedGeoms[region->geom] = region;
+    this->dataPtr->bakedRegions.push_back(std::move(entry.second));
+  }
+
+  gzlog << "Baked " << this->dataPtr->bakedCollisions.size()
+        << " static collisions into " << this->dataPtr->bakedRegions.size()
+        << " meshes" << std::endl;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddBakedCollider(ODECollision *_collision,
+    ODEBakedRegion *_region)
+{
+  this->dataPtr->bakedColliders.push_back(
+      std::make_pair(_collision, _region));
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CollideBaked(ODECollision *_collision,
+    ODEBakedRegion *_region)
+{
+  dContactGeom *contacts = this->dataPtr->contactCollisions;
+  const int numc = dCollide(_collision->GetCollisionId(), _region->geom,
+      MAX_COLLIDE_RETURNS, contacts, sizeof(contacts[0]));
+  if (numc <= 0)
+    return;
+
+  // Group the contacts by the collision their triangle was baked from, in
+  // the order the collisions were baked.
+  std::vector<std::pair<unsigned int, int> > owned;
+  owned.reserve(numc);
+  for (int i = 0; i < numc; ++i)
+  {
+    const int triangle = contacts[i].side2;
+    if (triangle >= 0 &&
+        static_cast<size_t>(triangle) < _region->owners.size())
+    {
+      owned.push_back(std::make_pair(_region->owners[triangle], i));
+    }
+  }
+  std::stable_sort(owned.begin(), owned.end(),
+      [](const std::pair<unsigned int, int> &_a,
+         const std::pair<unsigned int, int> &_b)
+      {
+        return _a.first < _b.first;
+      });
+
+  int indices[MAX_COLLIDE_RETURNS];
+  size_t begin = 0;
+  while (begin < owned.size())
+  {
+    size_t end = begin + 1;
+    while (end < owned.size() && owned[end].first == owned[begin].first)
+      ++end;
+
+    ODECollision *owner = _region->collisions[owned[begin].first];
+    const SurfaceParamsPtr &surface1 = _collision->GetSurface();
+    const SurfaceParamsPtr &surface2 = owner->GetSurface();
+
+    // Same filters as in CollisionCallback
+    const bool collide =
+        (surface1->collideBitmask & surface2->collideBitmask) != 0 &&
+        (!(surface1->collideWithoutContact ||
+           surface2->collideWithoutContact) ||
+         (surface1->collideWithoutContactBitmask &
+          surface2->collideWithoutContactBitmask) != 0);
+
+    if (collide)
+    {
+      unsigned int maxCollide = this->dataPtr->maxCollide;
+      maxCollide = std::min(maxCollide, _collision->GetMaxContacts());
+      maxCollide = std::min(maxCollide, owner->GetMaxContacts());
+
+      unsigned int count = end - begin;
+      for (unsigned int j = 0; j < count; ++j)
+        indices[j] = owned[begin + j].second;
+
+      // Keep the deepest of the extra contacts, as in NarrowPhase
+      if (maxCollide > 0 && count > maxCollide)
+      {
+        unsigned int deepest = maxCollide-1;
+        for (unsigned int j = maxCollide; j < count; ++j)
+        {
+          if (contacts[indices[j]].depth > contacts[indices[deepest]].depth)
+            deepest = j;
+        }
+        indices[maxCollide-1] = indices[deepest];
+        count = maxCollide;
+      }
+
+      this->AddContactJoints(_collision, owner, contacts, indices, count);
+    }
+
+    begin = end;
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::CreateSpace()
+{
+  const std::string &type = this->dataPtr->activeBroadPhase;
+  const dSpaceID oldSpace = this->dataPtr->spaceId;
+  dSpaceID space = nullptr;
+
+  if (type == "simple")
+  {
+    space = dSimpleSpaceCreate(0);
+  }
+  else if (type == "sap")
+  {
+    space = dSweepAndPruneSpaceCreate(0, this->dataPtr->sapAxisOrder);
+  }
+  else if (type == "quadtree")
+  {
+    // The root block covers the objects in the space, and is centered on
+    // the origin when there are none.
+    dVector3 center = {0, 0, 0, 0};
+    dVector3 extents = {100, 100, 100, 0};
+    auto aabbs = boundedAABBs(oldSpace);
+    if (!aabbs.empty())
+    {
+      std::array<dReal, 6> bounds = aabbs.front();
+      for (const auto &aabb : aabbs)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          bounds[2*j] = std::min(bounds[2*j], aabb[2*j]);
+          bounds[2*j+1] = std::max(bounds[2*j+1], aabb[2*j+1]);
+        }
+      }
+      for (int j = 0; j < 3; ++j)
+      {
+        center[j] = 0.5 * (bounds[2*j] + bounds[2*j+1]);
+        extents[j] = std::max(dReal(1), 0.5 * (bounds[2*j+1] - bounds[2*j]));
+      }
+    }
+    space = dQuadTreeSpaceCreate(0, center, extents, kQuadTreeDepth);
+  }
+  else
+  {
+    space = dHashSpaceCreate(0);
+    dHashSpaceSetLevels(space, -2, 8);
+  }
+
+  // Move the geoms and model spaces without destroying them.
+  dSpaceSetCleanup(oldSpace, 0);
+  while (dSpaceGetNumGeoms(oldSpace) > 0)
+  {
+    dGeomID geom = dSpaceGetGeom(oldSpace, 0);
+    dSpaceRemove(oldSpace, geom);
+    dSpaceAdd(space, geom);
+  }
+  dSpaceDestroy(oldSpace);
+
+  this->dataPtr->spaceId = space;
+  this->dataPtr->spaceDirty = false;
 }
 
 //////////////////////////////////////////////////
-std::string
-ODEPhysics::ConvertWorldStepSolverType(const World_Solver_Type _solverType)
+void ODEPhysics::AdaptBroadPhase()
 {
-  std::string result;
-  switch (_solverType)
+  auto aabbs = boundedAABBs(this->dataPtr->spaceId);
+
+  std::string type = "hash";
+  int minLevel = -2;
+  int maxLevel = 8;
+  if (aabbs.size() <= kSimpleSpaceMaxObjects)
   {
-    case ODE_DEFAULT:
-    {
-      result = "ODE_DANTZIG";
-      break;
-    }
-    case DART_PGS:
-    {
-      result = "DART_PGS";
-      break;
-    }
-    case BULLET_LEMKE:
+    // Testing every pair is cheapest for a few objects.
+    type = "simple";
+  }
+  else
+  {
+    // A hash space puts each object in the cells of the level that matches
+    // its size, so the levels are fitted to the sizes of the objects. Sizes
+    // that are too spread, such as large static objects among small ones,
+    // suit sweep and prune better.
+    dReal minSize = dInfinity;
+    dReal maxSize = 0;
+    for (const auto &aabb : aabbs)
     {
-      result = "BULLET_LEMKE";
-      break;
+      const dReal size = std::max({aabb[1] - aabb[0], aabb[3] - aabb[2],
+          aabb[5] - aabb[4], dReal(1e-3)});
+      minSize = std::min(minSize, size);
+      maxSize = std::max(maxSize, size);
     }
-    case BULLET_PGS:
+    minLevel = static_cast<int>(std::floor(std::log2(minSize)));
+    maxLevel = static_cast<int>(std::ceil(std::log2(maxSize)));
+    if (maxLevel - minLevel > kHashSpaceMaxLevels)
+      type = "sap";
+  }
+
+  if (type == "sap")
+  {
+    // Sort along the axis on which the objects are the most spread first,
+    // which leaves the fewest overlapping intervals.
+    std::array<dReal, 3> lower = {dInfinity, dInfinity, dInfinity};
+    std::array<dReal, 3> upper = {-dInfinity, -dInfinity, -dInfinity};
+    for (const auto &aabb : aabbs)
     {
-      result = "BULLET_PGS";
-      break;
+      for (int j = 0; j < 3; ++j)
+      {
+        const dReal center = 0.5 * (aabb[2*j] + aabb[2*j+1]);
+        lower[j] = std::min(lower[j], center);
+        upper[j] = std::max(upper[j], center);
+      }
     }
-    default:
+    std::array<int, 3> axes = {0, 1, 2};
+    std::stable_sort(axes.begin(), axes.end(), [&](const int _a, const int _b)
+        {
+          return upper[_a] - lower[_a] > upper[_b] - lower[_b];
+        });
+    const int order = axes[0] | (axes[1] << 2) | (axes[2] << 4);
+    if (order != this->dataPtr->sapAxisOrder)
     {
-      result = "unknown";
-      gzerr << "Unrecognized world step solver [" << _solverType << "]"
-            << std::endl;
+      this->dataPtr->sapAxisOrder = order;
+      if (this->dataPtr->activeBroadPhase == "sap")
+        this->dataPtr->spaceDirty = true;
     }
   }
-  return result;
-}
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetSORPGSPreconIters(unsigned int _iters)
-{
-  this->sdf->GetElement("ode")->GetElement("solver")->
-    GetElement("precon_iters")->Set(_iters);
+  if (type != this->dataPtr->activeBroadPhase)
+  {
+    this->dataPtr->activeBroadPhase = type;
+    this->dataPtr->spaceDirty = true;
+  }
+  if (this->dataPtr->spaceDirty)
+    this->CreateSpace();
 
-  dWorldSetQuickStepPreconIterations(this->dataPtr->worldId, _iters);
+  if (type == "hash")
+    dHashSpaceSetLevels(this->dataPtr->spaceId, minLevel, maxLevel);
 }
 
 //////////////////////////////////////////////////
-void ODEPhysics::SetSORPGSIters(unsigned int _iters)
+void ODEPhysics::CacheContacts()
 {
-  this->sdf->GetElement("ode")->GetElement(
-      "solver")->GetElement("iters")->Set(_iters);
-  dWorldSetQuickStepNumIterations(this->dataPtr->worldId, _iters);
-}
+  for (auto &contact : this->dataPtr->contacts)
+  {
+    dJointGetLambda(contact.joint, contact.lambda);
+    contact.joint = nullptr;
+    contact.matched = false;
+  }
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetSORPGSW(double _w)
-{
-  this->sdf->GetElement("ode")->GetElement(
-      "solver")->GetElement("sor")->Set(_w);
-  dWorldSetQuickStepW(this->dataPtr->worldId, _w);
+  std::swap(this->dataPtr->prevContacts, this->dataPtr->contacts);
+  std::swap(this->dataPtr->prevPairs, this->dataPtr->pairs);
+  std::sort(this->dataPtr->prevPairs.begin(), this->dataPtr->prevPairs.end());
+  this->dataPtr->contacts.clear();
+  this->dataPtr->pairs.clear();
 }
 
 //////////////////////////////////////////////////
-void ODEPhysics::SetFrictionModel(const std::string &_fricModel)
+void ODEPhysics::ClearContactCache()
 {
-  /// Uncomment this until sdformat changes (sdformat repo issue #96)
-  ///
-  /// this->sdf->GetElement("ode")->GetElement(
-  ///   "solver")->GetElement("friction_model")->Set(_fricModel);
-  dWorldSetQuickStepFrictionModel(this->dataPtr->worldId,
-    ConvertFrictionModel(_fricModel));
+  this->dataPtr->prevContacts.clear();
+  this->dataPtr->prevPairs.clear();
+  this->dataPtr->contacts.clear();
+  this->dataPtr->pairs.clear();
 }
 
 //////////////////////////////////////////////////
-void ODEPhysics::SetWorldCFM(double _cfm)
+void ODEPhysics::WarmStartContact(const ODECachedPair *_pair,
+    const dContactGeom &_geom, const dJointID _joint)
 {
-  sdf::ElementPtr elem = this->sdf->GetElement("ode");
-  elem = elem->GetElement("constraints");
-  elem->GetElement("cfm")->Set(_cfm);
+  ODECachedContact contact;
+  dCopyVector3(contact.pos, _geom.pos);
+  dCopyVector3(contact.normal, _geom.normal);
+  contact.side1 = _geom.side1;
+  contact.side2 = _geom.side2;
+  contact.joint = _joint;
+  contact.matched = false;
+  this->dataPtr->contacts.push_back(contact);
+
+  if (!_pair)
+    return;
 
-  dWorldSetCFM(this->dataPtr->worldId, _cfm);
-}
+  // Contacts with the same features are the same contact. Otherwise take
+  // the closest contact with about the same normal.
+  const bool hasFeatures = _geom.side1 >= 0 && _geom.side2 >= 0;
+  const double maxDist2 = this->dataPtr->contactWarmStartDistance *
+      this->dataPtr->contactWarmStartDistance;
+  ODECachedContact *best = nullptr;
+  double bestDist2 = maxDist2;
+  for (size_t i = _pair->begin; i < _pair->end; ++i)
+  {
+    ODECachedContact &prev = this->dataPtr->prevContacts[i];
+    if (prev.matched || dCalcVectorDot3(prev.normal, _geom.normal) < 0.9)
+      continue;
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetWorldERP(double _erp)
-{
-  sdf::ElementPtr elem = this->sdf->GetElement("ode");
-  elem = elem->GetElement("constraints");
-  elem->GetElement("erp")->Set(_erp);
-  dWorldSetERP(this->dataPtr->worldId, _erp);
-}
+    const double dist = dCalcPointsDistance3(prev.pos, _geom.pos);
+    const double dist2 = dist * dist;
+    if (dist2 > maxDist2)
+      continue;
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetContactMaxCorrectingVel(double _vel)
-{
-  this->sdf->GetElement("ode")->GetElement(
-      "constraints")->GetElement(
-        "contact_max_correcting_vel")->Set(_vel);
-  dWorldSetContactMaxCorrectingVel(this->dataPtr->worldId, _vel);
-}
+    if (hasFeatures && prev.side1 == _geom.side1 &&
+        prev.side2 == _geom.side2)
+    {
+      best = &prev;
+      break;
+    }
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetContactSurfaceLayer(double _depth)
-{
-  this->sdf->GetElement("ode")->GetElement(
-      "constraints")->GetElement("contact_surface_layer")->Set(_depth);
-  dWorldSetContactSurfaceLayer(this->dataPtr->worldId, _depth);
-}
+    if (dist2 <= bestDist2)
+    {
+      best = &prev;
+      bestDist2 = dist2;
+    }
+  }
 
-//////////////////////////////////////////////////
-void ODEPhysics::SetMaxContacts(unsigned int _maxContacts)
-{
-  this->dataPtr->maxContacts = _maxContacts;
-  this->sdf->GetElement("max_contacts")->GetValue()->Set(_maxContacts);
+  if (best)
+  {
+    best->matched = true;
+    dJointSetLambda(_joint, best->lambda);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -927,8 +1963,14 @@ void ODEPhysics::SetStepType(const std::string &_type)
   this->dataPtr->stepType = _type;
 
   // Set the physics update function
-  if (this->dataPtr->stepType == "quick")
+  if (this->dataPtr->stepType == "quick" ||
+      this->dataPtr->stepType == "quick_simd")
+  {
+    // quick_simd runs the same solver with vectorized row kernels
     this->dataPtr->physicsStepFunc = &dWorldQuickStep;
+    dWorldSetQuickStepSIMDRows(this->dataPtr->worldId,
+        this->dataPtr->stepType == "quick_simd");
+  }
   else if (this->dataPtr->stepType == "world")
     this->dataPtr->physicsStepFunc = &dWorldStep;
   else
@@ -947,7 +1989,7 @@ void ODEPhysics::SetGravity(const ignition::math::Vector3d &_gravity)
 //////////////////////////////////////////////////
 void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
 {
-  IGN_PROFILE("ODEPhysics::CollisionCallback");
+  GZ_PROFILE("ODEPhysics::CollisionCallback");
   dBodyID b1 = dGeomGetBody(_o1);
   dBodyID b2 = dGeomGetBody(_o2);
 
@@ -965,6 +2007,52 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
   }
   else
   {
+    ++self->dataPtr->broadPhasePairs;
+
+    // Merged meshes of baked collisions have no collision of their own,
+    // their triangles are mapped back to collisions in CollideBaked.
+    if (!self->dataPtr->bakedGeoms.empty() &&
+        (dGeomGetClass(_o1) == dTriMeshClass ||
+         dGeomGetClass(_o2) == dTriMeshClass))
+    {
+      auto &bakedGeoms = self->dataPtr->bakedGeoms;
+      auto region1 = bakedGeoms.find(_o1);
+      auto region2 = bakedGeoms.find(_o2);
+      if (region1 != bakedGeoms.end() || region2 != bakedGeoms.end())
+      {
+        // Baked collisions are static, so they never collide together
+        if (region1 != bakedGeoms.end() && region2 != bakedGeoms.end())
+          return;
+
+        ODEBakedRegion *region = region1 != bakedGeoms.end() ?
+            region1->second : region2->second;
+        dGeomID other = region1 != bakedGeoms.end() ? _o2 : _o1;
+        dBodyID body = region1 != bakedGeoms.end() ? b2 : b1;
+
+        ODECollision *collision = nullptr;
+        if (dGeomGetClass(other) == dGeomTransformClass)
+        {
+          collision = static_cast<ODECollision*>(
+              dGeomGetData(dGeomTransformGetGeom(other)));
+        }
+        else
+        {
+          collision = static_cast<ODECollision*>(dGeomGetData(other));
+        }
+
+        // Exit if the body is not enabled
+        if (!collision || (body && !dBodyIsEnabled(body) &&
+            dGeomGetCategoryBits(other) != GZ_SENSOR_COLLIDE &&
+            !self->contactManager->NeverDropContacts()))
+        {
+          return;
+        }
+
+        self->AddBakedCollider(collision, region);
+        return;
+      }
+    }
+
     ODECollision *collision1 = nullptr;
     ODECollision *collision2 = nullptr;
 
@@ -981,14 +2069,17 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
     else
       collision2 = static_cast<ODECollision*>(dGeomGetData(_o2));
 
-    // Exit if both bodies are not enabled
+    // Exit if both bodies are not enabled, or if neither is dynamic, as
+    // kinematic bodies only push the dynamic bodies.
     if (dGeomGetCategoryBits(_o1) != GZ_SENSOR_COLLIDE &&
         dGeomGetCategoryBits(_o2) != GZ_SENSOR_COLLIDE &&
         !self->contactManager->NeverDropContacts() &&
         !self->contactManager->SubscribersConnected(collision1, collision2) &&
         ((b1 && b2 && !dBodyIsEnabled(b1) && !dBodyIsEnabled(b2)) ||
         (!b2 && b1 && !dBodyIsEnabled(b1)) ||
-        (!b1 && b2 && !dBodyIsEnabled(b2))))
+        (!b1 && b2 && !dBodyIsEnabled(b2)) ||
+        ((b1 || b2) && (!b1 || dBodyIsKinematic(b1)) &&
+        (!b2 || dBodyIsKinematic(b2)))))
     {
       return;
     }
@@ -996,41 +2087,153 @@ void ODEPhysics::CollisionCallback(void *_data, dGeomID _o1, dGeomID _o2)
     // Make sure both collision pointers are valid.
     if (collision1 && collision2)
     {
-      // Add either a tri-mesh collider or a regular collider.
-      if (collision1->HasType(Base::MESH_SHAPE) ||
-          collision2->HasType(Base::MESH_SHAPE))
+      const SurfaceParamsPtr &surface1 = collision1->GetSurface();
+      const SurfaceParamsPtr &surface2 = collision2->GetSurface();
+
+      // Filter collisions based on collide bitmask, before any narrow phase
+      // work is queued for the pair.
+      if ((surface1->collideBitmask & surface2->collideBitmask) == 0)
+        return;
+
+      // Filter collisions based on contact bitmask if
+      // collide_without_contact is on. The bitmask is set mainly for speed
+      // improvements otherwise a collision with collide_without_contact may
+      // potentially generate a large number of contacts.
+      if ((surface1->collideWithoutContact ||
+           surface2->collideWithoutContact) &&
+          (surface1->collideWithoutContactBitmask &
+           surface2->collideWithoutContactBitmask) == 0)
+      {
+        return;
+      }
+
+      // Add either a tri-mesh collider or a regular collider. Meshes
+      // decomposed in convex hulls collide with them against the other
+      // shapes, which may be done in parallel.
+      collision1->RefreshCollisionParts();
+      collision2->RefreshCollisionParts();
+      if (collidesAsTrimesh(collision1) || collidesAsTrimesh(collision2))
         self->AddTrimeshCollider(collision1, collision2);
       else
-      {
         self->AddCollider(collision1, collision2);
-      }
     }
   }
 }
 
 
 //////////////////////////////////////////////////
-void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
-                         dContactGeom *_contactCollisions)
+void ODEPhysics::ParallelCollide()
 {
-  // Filter collisions based on collide bitmask.
-  if ((_collision1->GetSurface()->collideBitmask &
-        _collision2->GetSurface()->collideBitmask) == 0)
-    return;
+  const unsigned int count = this->dataPtr->collidersCount;
+  const unsigned int threads = static_cast<unsigned int>(
+      this->dataPtr->narrowPhaseThreads);
+
+  if (!this->dataPtr->narrowPhaseArena ||
+      this->dataPtr->narrowPhaseArena->max_concurrency() !=
+      this->dataPtr->narrowPhaseThreads)
+  {
+    this->dataPtr->narrowPhaseArena.reset(
+        new tbb::task_arena(this->dataPtr->narrowPhaseThreads));
+  }
+
+  if (this->dataPtr->narrowPhaseBuffers.size() < threads)
+    this->dataPtr->narrowPhaseBuffers.resize(threads);
+
+  // Each buffer owns a fixed, contiguous range of colliders. Merging the
+  // buffers in order therefore creates the contact joints in the same order
+  // as the serial loop, independent of how the ranges get scheduled.
+  const unsigned int chunkSize = (count + threads - 1) / threads;
 
-  // Filter collisions based on contact bitmask if collide_without_contact is
-  // on.The bitmask is set mainly for speed improvements otherwise a collision
-  // with collide_without_contact may potentially generate a large number of
-  // contacts.
-  if (_collision1->GetSurface()->collideWithoutContact ||
-      _collision2->GetSurface()->collideWithoutContact)
+  auto narrowPhase = [this, count, chunkSize](
+      const tbb::blocked_range<unsigned int> &_r)
   {
-    if ((_collision1->GetSurface()->collideWithoutContactBitmask &
-         _collision2->GetSurface()->collideWithoutContactBitmask) == 0)
+    // Worker threads need their own ODE collision data.
+    dAllocateODEDataForThread(dAllocateMaskAll);
+
+    for (unsigned int b = _r.begin(); b != _r.end(); ++b)
     {
-      return;
+      ODENarrowPhaseBuffer &buffer = this->dataPtr->narrowPhaseBuffers[b];
+      buffer.contacts.clear();
+      buffer.pairs.clear();
+
+      const unsigned int end = std::min(count, (b + 1) * chunkSize);
+      for (unsigned int i = b * chunkSize; i < end; ++i)
+      {
+        ODECollision *collision1 = this->dataPtr->colliders[i].first;
+        ODECollision *collision2 = this->dataPtr->colliders[i].second;
+
+        // Heightfield geoms keep per-geom scratch data in ODE, so two
+        // threads can't collide against the same heightfield. Those pairs
+        // are collided on the physics thread during the merge.
+        if (collision1->HasType(Base::HEIGHTMAP_SHAPE) ||
+            collision2->HasType(Base::HEIGHTMAP_SHAPE))
+        {
+          buffer.pairs.push_back(std::make_pair(i, -1));
+          continue;
+        }
+
+        unsigned int numc = this->NarrowPhase(collision1, collision2,
+            buffer.contactCollisions);
+        if (numc == 0)
+          continue;
+
+        buffer.contacts.insert(buffer.contacts.end(),
+            buffer.contactCollisions, buffer.contactCollisions + numc);
+        buffer.pairs.push_back(std::make_pair(i, static_cast<int>(numc)));
+      }
+    }
+  };
+
+  this->dataPtr->narrowPhaseArena->execute([&narrowPhase, threads]()
+  {
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, threads, 1),
+        narrowPhase, tbb::simple_partitioner());
+  });
+
+  // Create the contact joints on this thread, in collider order.
+  for (unsigned int b = 0; b < threads; ++b)
+  {
+    ODENarrowPhaseBuffer &buffer = this->dataPtr->narrowPhaseBuffers[b];
+    size_t offset = 0;
+    for (auto const &pair : buffer.pairs)
+    {
+      ODECollision *collision1 = this->dataPtr->colliders[pair.first].first;
+      ODECollision *collision2 = this->dataPtr->colliders[pair.first].second;
+      if (pair.second < 0)
+      {
+        this->Collide(collision1, collision2,
+            this->dataPtr->contactCollisions);
+        continue;
+      }
+
+      this->AddContactJoints(collision1, collision2,
+          &buffer.contacts[offset], this->dataPtr->sequentialIndices,
+          static_cast<unsigned int>(pair.second));
+      offset += pair.second;
     }
   }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
+                         dContactGeom *_contactCollisions)
+{
+  unsigned int numc = this->NarrowPhase(_collision1, _collision2,
+      _contactCollisions);
+
+  // Return if no contacts.
+  if (numc == 0)
+    return;
+
+  this->AddContactJoints(_collision1, _collision2, _contactCollisions,
+      this->dataPtr->sequentialIndices, numc);
+}
+
+//////////////////////////////////////////////////
+unsigned int ODEPhysics::NarrowPhase(ODECollision *_collision1,
+    ODECollision *_collision2, dContactGeom *_contactCollisions)
+{
+  // The collide bitmasks were already checked in CollisionCallback.
 
   /*
   if (_collision1->GetCollisionId() && _collision2->GetCollisionId())
@@ -1045,15 +2248,10 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   }*/
 
   unsigned int numc = 0;
-  dContact contact;
 
-  // maxCollide must less than the size of this->dataPtr->indices
+  // maxCollide must less than the size of _indices
   // Check the header
-  unsigned int maxCollide = MAX_CONTACT_JOINTS;
-
-  // max_contacts specified globally
-  if (this->GetMaxContacts() > 0 && this->GetMaxContacts() < MAX_CONTACT_JOINTS)
-    maxCollide = this->GetMaxContacts();
+  unsigned int maxCollide = this->dataPtr->maxCollide;
 
   // over-ride with minimum of max_contacts from both collisions
   if (_collision1->GetMaxContacts() < maxCollide)
@@ -1062,35 +2260,83 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   if (_collision2->GetMaxContacts() < maxCollide)
     maxCollide = _collision2->GetMaxContacts();
 
-  // Generate the contacts
-  numc = dCollide(_collision1->GetCollisionId(), _collision2->GetCollisionId(),
-      MAX_COLLIDE_RETURNS, _contactCollisions, sizeof(_contactCollisions[0]));
+  // Generate the contacts, of each pair of convex hulls for decomposed
+  // meshes. A distance field samples the own geom of the other collision,
+  // since it can't sample convex geoms.
+  const std::vector<dGeomID> &parts1 = _collision1->CollisionParts();
+  const std::vector<dGeomID> &parts2 = _collision2->CollisionParts();
+  if (parts1.empty() && parts2.empty())
+  {
+    numc = dCollide(_collision1->GetCollisionId(),
+        _collision2->GetCollisionId(), MAX_COLLIDE_RETURNS,
+        _contactCollisions, sizeof(_contactCollisions[0]));
+  }
+  else
+  {
+    const bool field1 =
+        !parts1.empty() && ODEDistanceField::IsField(parts1[0]);
+    const bool field2 =
+        !parts2.empty() && ODEDistanceField::IsField(parts2[0]);
+
+    const dGeomID primary1 = _collision1->GetCollisionId();
+    const dGeomID primary2 = _collision2->GetCollisionId();
+    const dGeomID *geoms1 = &primary1;
+    const dGeomID *geoms2 = &primary2;
+    std::size_t count1 = 1;
+    std::size_t count2 = 1;
+    if (!parts1.empty() && !field2)
+    {
+      geoms1 = parts1.data();
+      count1 = parts1.size();
+    }
+    if (!parts2.empty() && (field2 || !field1))
+    {
+      geoms2 = parts2.data();
+      count2 = parts2.size();
+    }
+
+    for (std::size_t i = 0; i < count1 && numc < MAX_COLLIDE_RETURNS; ++i)
+    {
+      for (std::size_t j = 0; j < count2 && numc < MAX_COLLIDE_RETURNS; ++j)
+      {
+        const int flags = static_cast<int>(MAX_COLLIDE_RETURNS - numc);
+        numc += dCollide(geoms1[i], geoms2[j], flags,
+            _contactCollisions + numc, sizeof(_contactCollisions[0]));
+      }
+    }
+  }
 
   // Return if no contacts.
   if (numc == 0)
-    return;
-
-  // Store the indices of the contacts.
-  for (int i = 0; i < MAX_CONTACT_JOINTS; i++)
-    this->dataPtr->indices[i] = i;
+    return 0;
 
   // Choose only the best contacts if too many were generated.
+  // The deepest of the extra contacts replaces the last kept contact, so
+  // that the kept contacts are the first ones of the array.
   if (maxCollide > 0 && numc > maxCollide)
   {
-    double max = _contactCollisions[maxCollide-1].depth;
+    unsigned int deepest = maxCollide-1;
     for (unsigned int i = maxCollide; i < numc; ++i)
     {
-      if (_contactCollisions[i].depth > max)
-      {
-        max = _contactCollisions[i].depth;
-        this->dataPtr->indices[maxCollide-1] = i;
-      }
+      if (_contactCollisions[i].depth > _contactCollisions[deepest].depth)
+        deepest = i;
     }
+    _contactCollisions[maxCollide-1] = _contactCollisions[deepest];
 
     // Make sure numc has the valid number of contacts.
     numc = maxCollide;
   }
 
+  return numc;
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::AddContactJoints(ODECollision *_collision1,
+    ODECollision *_collision2, const dContactGeom *_contactCollisions,
+    const int *_indices, const unsigned int _numc)
+{
+  dContact contact;
+
   // Set the contact surface parameter flags.
   contact.surface.mode = dContactBounce |
                          dContactMu2 |
@@ -1181,9 +2427,9 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
   // number of contact points (numc).
   // To eliminate this dependence on numc, the inverse damping
   // is multipled by numc.
-  contact.surface.slip1 *= numc;
-  contact.surface.slip2 *= numc;
-  contact.surface.slip3 *= numc;
+  contact.surface.slip1 *= _numc;
+  contact.surface.slip2 *= _numc;
+  contact.surface.slip3 *= _numc;
 
   // Combine torsional friction patch radius values
   contact.surface.patch_radius =
@@ -1287,10 +2533,33 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     jointFeedback->contact = contactFeedback;
   }
 
+  // Contacts of the previous step between the same collisions
+  const bool attach = !_collision1->GetSurface()->collideWithoutContact &&
+                      !_collision2->GetSurface()->collideWithoutContact;
+  const bool warmStart = this->dataPtr->contactWarmStart && attach;
+  const ODECachedPair *cachedPair = nullptr;
+  if (warmStart)
+  {
+    ODECachedPair key;
+    key.collision1 = _collision1;
+    key.collision2 = _collision2;
+    auto iter = std::lower_bound(this->dataPtr->prevPairs.begin(),
+        this->dataPtr->prevPairs.end(), key);
+    if (iter != this->dataPtr->prevPairs.end() &&
+        iter->collision1 == _collision1 && iter->collision2 == _collision2)
+    {
+      cachedPair = &(*iter);
+    }
+
+    key.begin = this->dataPtr->contacts.size();
+    key.end = key.begin + _numc;
+    this->dataPtr->pairs.push_back(key);
+  }
+
   // Create a joint for each contact
-  for (unsigned int j = 0; j < numc; ++j)
+  for (unsigned int j = 0; j < _numc; ++j)
   {
-    contact.geom = _contactCollisions[this->dataPtr->indices[j]];
+    contact.geom = _contactCollisions[_indices[j]];
 
     // Create the contact joint. This introduces the contact constraint to
     // ODE
@@ -1302,19 +2571,19 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     {
       // Store the contact depth
       contactFeedback->depths[j] =
-        _contactCollisions[this->dataPtr->indices[j]].depth;
+        _contactCollisions[_indices[j]].depth;
 
       // Store the contact position
       contactFeedback->positions[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].pos[0],
-          _contactCollisions[this->dataPtr->indices[j]].pos[1],
-          _contactCollisions[this->dataPtr->indices[j]].pos[2]);
+          _contactCollisions[_indices[j]].pos[0],
+          _contactCollisions[_indices[j]].pos[1],
+          _contactCollisions[_indices[j]].pos[2]);
 
       // Store the contact normal
       contactFeedback->normals[j].Set(
-          _contactCollisions[this->dataPtr->indices[j]].normal[0],
-          _contactCollisions[this->dataPtr->indices[j]].normal[1],
-          _contactCollisions[this->dataPtr->indices[j]].normal[2]);
+          _contactCollisions[_indices[j]].normal[0],
+          _contactCollisions[_indices[j]].normal[1],
+          _contactCollisions[_indices[j]].normal[2]);
 
       // Set the joint feedback.
       dJointSetFeedback(contactJoint, &(jointFeedback->feedbacks[j]));
@@ -1325,9 +2594,15 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     }
 
     // Attach the contact joint if collideWithoutContact flags aren't set.
-    if (!_collision1->GetSurface()->collideWithoutContact &&
-        !_collision2->GetSurface()->collideWithoutContact)
+    if (attach)
+    {
       dJointAttach(contactJoint, b1, b2);
+      this->dataPtr->maxPenetration =
+          std::max(this->dataPtr->maxPenetration, contact.geom.depth);
+    }
+
+    if (warmStart)
+      this->WarmStartContact(cachedPair, contact.geom, contactJoint);
   }
 }
 
@@ -1417,6 +2692,112 @@ void ODEPhysics::SetSeed(uint32_t _seed)
   dRandSetSeed(_seed);
 }
 
+/////////////////////////////////////////////////
+void ODEPhysics::SaveSnapshot(const Link_V &_links, const Joint_V &_joints,
+    std::vector<double> &_data) const
+{
+  // The random number generator is used by the solver to shuffle rows.
+  _data.push_back(dRandGetSeed());
+
+  // Save the body state as ODE stores it, so that the restored state is
+  // bit identical. Static links don't have a body.
+  for (auto const &link : _links)
+  {
+    dBodyID body = boost::static_pointer_cast<ODELink>(link)->GetODEId();
+    if (!body)
+    {
+      _data.push_back(0.0);
+      continue;
+    }
+
+    _data.push_back(dBodyIsEnabled(body) ? 1.0 : -1.0);
+    for (const dReal *values : {dBodyGetPosition(body),
+        dBodyGetLinearVel(body), dBodyGetAngularVel(body),
+        dBodyGetForce(body), dBodyGetTorque(body)})
+    {
+      _data.insert(_data.end(), values, values + 3);
+    }
+    const dReal *q = dBodyGetQuaternion(body);
+    _data.insert(_data.end(), q, q + 4);
+  }
+
+  // Save the constraint forces that warm start the solver. Contact joints
+  // are created again at each step, so they don't have any.
+  dReal lambda[12];
+  for (auto const &joint : _joints)
+  {
+    dJointID id = boost::static_pointer_cast<ODEJoint>(joint)->JointId();
+    if (!id)
+    {
+      _data.push_back(0.0);
+      continue;
+    }
+
+    _data.push_back(1.0);
+    dJointGetLambda(id, lambda);
+    _data.insert(_data.end(), lambda, lambda + 12);
+  }
+}
+
+/////////////////////////////////////////////////
+bool ODEPhysics::RestoreSnapshot(const Link_V &_links,
+    const Joint_V &_joints, const double *&_data, const double *_end)
+{
+  if (_data == _end)
+    return false;
+  dRandSetSeed(static_cast<decltype(dRandGetSeed())>(*_data++));
+
+  // The cached contacts belong to the state before the restore.
+  this->ClearContactCache();
+
+  for (auto const &link : _links)
+  {
+    ODELinkPtr odeLink = boost::static_pointer_cast<ODELink>(link);
+    dBodyID body = odeLink->GetODEId();
+    if (_data == _end || (*_data != 0.0) != (body != nullptr) ||
+        (body && _end - _data < 20))
+    {
+      return false;
+    }
+    if (!body)
+    {
+      ++_data;
+      continue;
+    }
+
+    if (_data[0] > 0.0)
+      dBodyEnable(body);
+    else
+      dBodyDisable(body);
+    dBodySetPosition(body, _data[1], _data[2], _data[3]);
+    dBodySetLinearVel(body, _data[4], _data[5], _data[6]);
+    dBodySetAngularVel(body, _data[7], _data[8], _data[9]);
+    dBodySetForce(body, _data[10], _data[11], _data[12]);
+    dBodySetTorque(body, _data[13], _data[14], _data[15]);
+    const dQuaternion q = {_data[16], _data[17], _data[18], _data[19]};
+    dBodySetUnitQuaternion(body, q);
+    _data += 20;
+
+    // Update the pose of the link from its body
+    ODELink::MoveCallback(body);
+  }
+
+  for (auto const &joint : _joints)
+  {
+    dJointID id = boost::static_pointer_cast<ODEJoint>(joint)->JointId();
+    if (_data == _end || (*_data != 0.0) != (id != nullptr) ||
+        (id && _end - _data < 13))
+    {
+      return false;
+    }
+
+    if (id)
+      dJointSetLambda(id, _data + 1);
+    _data += id ? 13 : 1;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
 {
@@ -1555,6 +2936,42 @@ bool ODEPhysics::SetParam(const std::string &_key, const boost::any &_value)
       }
       dWorldSetIslandThreads(this->dataPtr->worldId, value);
     }
+    else if (_key == "narrow_phase_threads")
+    {
+      this->SetNarrowPhaseThreads(any_cast<int>(_value));
+    }
+    else if (_key == "contact_warm_start")
+    {
+      this->SetContactWarmStart(any_cast<bool>(_value));
+    }
+    else if (_key == "contact_warm_start_distance")
+    {
+      this->SetContactWarmStartDistance(any_cast<double>(_value));
+    }
+    else if (_key == "deterministic")
+    {
+      this->SetDeterministic(any_cast<bool>(_value));
+    }
+    else if (_key == "broad_phase")
+    {
+      return this->SetBroadPhase(any_cast<std::string>(_value));
+    }
+    else if (_key == "bake_static_collisions")
+    {
+      this->SetBakeStaticCollisions(any_cast<bool>(_value));
+    }
+    else if (_key == "bake_region_size")
+    {
+      this->SetBakeRegionSize(any_cast<double>(_value));
+    }
+    else if (_key == "persistent_step_memory")
+    {
+      ODEStepMemory::SetPersistent(any_cast<bool>(_value));
+    }
+    else if (_key == "step_memory_huge_pages")
+    {
+      ODEStepMemory::SetHugePages(any_cast<bool>(_value));
+    }
     else if (_key == "ode_quiet")
     {
       bool odeQuiet = any_cast<bool>(_value);
@@ -1662,6 +3079,26 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
     _value = this->GetFrictionModel();
   else if (_key == "island_threads")
     _value = dWorldGetIslandThreads(this->dataPtr->worldId);
+  else if (_key == "narrow_phase_threads")
+    _value = this->NarrowPhaseThreads();
+  else if (_key == "contact_warm_start")
+    _value = this->ContactWarmStart();
+  else if (_key == "contact_warm_start_distance")
+    _value = this->ContactWarmStartDistance();
+  else if (_key == "deterministic")
+    _value = this->Deterministic();
+  else if (_key == "broad_phase")
+    _value = this->BroadPhase();
+  else if (_key == "broad_phase_pairs")
+    _value = this->BroadPhasePairCount();
+  else if (_key == "bake_static_collisions")
+    _value = this->BakeStaticCollisions();
+  else if (_key == "bake_region_size")
+    _value = this->BakeRegionSize();
+  else if (_key == "persistent_step_memory")
+    _value = ODEStepMemory::Persistent();
+  else if (_key == "step_memory_huge_pages")
+    _value = ODEStepMemory::HugePages();
   else if (_key == "ode_quiet")
     _value = dGetMessageHandler() != 0;
   else if (_key == "world_step_solver")
@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -36,6 +37,8 @@ namespace gazebo
 {
   namespace physics
   {
+    class ODEBakedRegion;
+    class ODECachedPair;
     class ODEJointFeedback;
     class ODEPhysicsPrivate;
 
@@ -117,6 +120,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void UpdatePhysics();
 
+      // Documentation inherited
+      public: virtual double MaxPenetration() const;
+
       // Documentation inherited
       public: virtual void Fini();
 
@@ -213,6 +219,16 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      // Documentation inherited
+      public: virtual void SaveSnapshot(const Link_V &_links,
+                  const Joint_V &_joints,
+                  std::vector<double> &_data) const override;
+
+      // Documentation inherited
+      public: virtual bool RestoreSnapshot(const Link_V &_links,
+                  const Joint_V &_joints, const double *&_data,
+                  const double *_end) override;
+
       /// Documentation inherited
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
@@ -271,15 +287,138 @@ namespace gazebo
       public: static World_Solver_Type
               ConvertWorldStepSolverType(const std::string &_solverType);
 
-      /// \brief Get the step type (quick, world).
+      /// \brief Get the step type (quick, quick_simd, world).
       /// \return The step type.
       public: virtual std::string GetStepType() const;
 
-      /// \brief Set the step type (quick, world).
-      /// \param[in] _type The step type (quick or world).
+      /// \brief Set the step type (quick, quick_simd, world).
+      /// quick_simd is the quick solver with its constraint rows solved by
+      /// vectorized kernels, chosen at runtime for the cpu. Its results
+      /// differ slightly from quick because of fused multiply-adds.
+      /// \param[in] _type The step type (quick, quick_simd or world).
       public: virtual void SetStepType(const std::string &_type);
 
 
+      /// \brief Set the number of threads used for narrow phase collision
+      /// detection of non-trimesh collision pairs. Contacts are merged in
+      /// collider order, so results match the single threaded narrow phase.
+      /// \param[in] _threads Number of threads. Values smaller than 2 use
+      /// the single threaded narrow phase.
+      public: void SetNarrowPhaseThreads(const int _threads);
+
+      /// \brief Get the number of threads used for narrow phase collision
+      /// detection.
+      /// \return Number of narrow phase threads.
+      public: int NarrowPhaseThreads() const;
+
+      /// \brief Keep the contacts of each step, and seed the contact
+      /// joints of the next step with the forces of the matching contacts.
+      /// A contact matches if it is between the same collisions, has about
+      /// the same normal, and either touches the same features or lies
+      /// within the warm start distance. The quick solver then starts from
+      /// those forces, scaled by its warm start factor, and converges in
+      /// fewer iterations. It has no effect with the world solver.
+      /// \param[in] _enable True to warm start contacts.
+      /// \sa SetContactWarmStartDistance
+      public: void SetContactWarmStart(const bool _enable);
+
+      /// \brief Get whether contacts are warm started.
+      /// \return True if contacts are warm started.
+      public: bool ContactWarmStart() const;
+
+      /// \brief Set the largest distance between a contact and the
+      /// contact of the previous step it takes its forces from.
+      /// \param[in] _distance Distance in meters, 0.01 by default.
+      public: void SetContactWarmStartDistance(const double _distance);
+
+      /// \brief Get the contact warm start distance.
+      /// \return Distance in meters.
+      public: double ContactWarmStartDistance() const;
+
+      /// \brief Set whether the results of a step are independent of the
+      /// number of threads. The colliders are then sorted by the ids of
+      /// their collisions before the contact joints are created, each
+      /// island draws its random numbers from its own seed, derived from
+      /// SetSeed, and the rows of an island are solved on one thread. Runs
+      /// with the same seed and world then give the same results whatever
+      /// the number of island, narrow phase and model update threads.
+      /// \param[in] _enable True to step deterministically.
+      public: void SetDeterministic(const bool _enable);
+
+      /// \brief Get whether the results of a step are independent of the
+      /// number of threads.
+      /// \return True if the steps are deterministic.
+      public: bool Deterministic() const;
+
+      /// \brief Set the broad phase of the top level collision space, which
+      /// finds the model spaces and geoms whose bounding boxes overlap. The
+      /// space is replaced at the start of the next step.
+      /// \param[in] _type One of "hash" (the default), "sap" (sweep and
+      /// prune), "quadtree", "simple" or "adaptive". The adaptive broad
+      /// phase periodically picks one of "simple", "hash" and "sap" from the
+      /// number and the sizes of the objects, and rebalances the levels of
+      /// the hash space or the axis order of the sweep and prune space.
+      /// \return False if the type is unknown.
+      public: bool SetBroadPhase(const std::string &_type);
+
+      /// \brief Get the requested broad phase.
+      /// \return The type passed to SetBroadPhase().
+      public: std::string BroadPhase() const;
+
+      /// \brief Get the broad phase of the top level space, which the
+      /// adaptive broad phase resolves to.
+      /// \return One of "hash", "sap", "quadtree" and "simple".
+      public: std::string ActiveBroadPhase() const;
+
+      /// \brief Get the number of geom pairs whose bounding boxes overlapped
+      /// during the last step, including the pairs that made no contact. It
+      /// is also published as the physics/broad_phase_pairs introspection
+      /// item of the world.
+      /// \return Number of pairs.
+      public: unsigned int BroadPhasePairCount() const;
+
+      /// \brief Set whether the static box and mesh collisions are baked
+      /// into merged triangle meshes, one per square region of the XY
+      /// plane. Each merged mesh is a single object for the broad phase,
+      /// with an AABB tree over its triangles, and maps each triangle back
+      /// to its collision for the surface parameters and the contacts. The
+      /// collisions are baked at the start of the next step, and baked
+      /// again whenever static collisions are added or removed. Static
+      /// collisions moved after they were baked keep their own geom.
+      /// \param[in] _enable True to bake static collisions.
+      public: void SetBakeStaticCollisions(const bool _enable);
+
+      /// \brief Get whether static collisions are baked.
+      /// \return True if static collisions are baked.
+      public: bool BakeStaticCollisions() const;
+
+      /// \brief Set the side length of the square regions of the baked
+      /// collisions, which takes effect the next time they are baked.
+      /// \param[in] _size Side length in meters.
+      public: void SetBakeRegionSize(const double _size);
+
+      /// \brief Get the side length of the regions of baked collisions.
+      /// \return Side length in meters.
+      public: double BakeRegionSize() const;
+
+      /// \brief Get the number of merged meshes of baked collisions.
+      /// \return Number of merged meshes.
+      public: unsigned int BakedRegionCount() const;
+
+      /// \brief Get the collision a triangle of a merged mesh was baked
+      /// from.
+      /// \param[in] _geom A geom of the top level space.
+      /// \param[in] _triangle Index of the triangle, as reported in the
+      /// side1 or side2 field of the contact.
+      /// \return The collision, or nullptr if _geom isn't a merged mesh.
+      public: ODECollision *BakedCollision(dGeomID _geom,
+                                           const int _triangle) const;
+
+      /// \brief Put the geoms of the baked collisions back into their
+      /// spaces and destroy the merged meshes. They are baked again at the
+      /// start of the next step if baking is enabled.
+      public: void UnbakeStaticCollisions();
+
       /// \brief Collide two collision objects.
       /// \param[in] _collision1 First collision object.
       /// \param[in] _collision2 Second collision object.
@@ -291,6 +430,21 @@ namespace gazebo
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
+      /// \brief Add or remove a link from continuous collision detection.
+      /// After each step, a link that moved more than its swept sphere
+      /// radius is swept with a ray from its previous position, and moved
+      /// back to where its sphere first touches another collision, so that
+      /// the next step finds the contact. Its velocity is kept. This is
+      /// called by ODELink::SetContinuousCollision.
+      /// \param[in] _link The link.
+      /// \param[in] _enable True to sweep the link.
+      public: void SetContinuousCollision(ODELink *_link, const bool _enable);
+
+      /// \brief Get the number of links swept by continuous collision
+      /// detection.
+      /// \return Number of links.
+      public: unsigned int ContinuousCollisionLinkCount() const;
+
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
@@ -315,6 +469,80 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Run the narrow phase for all normal colliders on a pool of
+      /// threads, then create the contact joints on the calling thread.
+      private: void ParallelCollide();
+
+      /// \brief Generate contact geometry for two collision objects, and
+      /// select the contacts to keep. This doesn't modify the engine state
+      /// and is safe to call from several threads. The pair must already
+      /// have passed the collide bitmask checks of CollisionCallback.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[out] _contactCollisions Array of MAX_COLLIDE_RETURNS
+      /// contacts generated by ODE. The selected contacts are moved to the
+      /// front of the array.
+      /// \return Number of selected contacts.
+      private: unsigned int NarrowPhase(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   dContactGeom *_contactCollisions);
+
+      /// \brief Create the contact joints and contact feedback for
+      /// contacts generated by NarrowPhase.
+      /// \param[in] _collision1 First collision object.
+      /// \param[in] _collision2 Second collision object.
+      /// \param[in] _contactCollisions Contact geometry.
+      /// \param[in] _indices Indices into _contactCollisions.
+      /// \param[in] _numc Number of contacts in _indices.
+      private: void AddContactJoints(ODECollision *_collision1,
+                   ODECollision *_collision2,
+                   const dContactGeom *_contactCollisions,
+                   const int *_indices, const unsigned int _numc);
+
+      /// \brief Read the forces of the contacts of the step, and keep them
+      /// as the contacts of the previous step.
+      private: void CacheContacts();
+
+      /// \brief Forget the contacts of the current and previous steps.
+      private: void ClearContactCache();
+
+      /// \brief Record a new contact joint, and seed it with the forces of
+      /// the matching contact of the previous step.
+      /// \param[in] _pair Contacts of the previous step between the same
+      /// collisions, or null if there are none.
+      /// \param[in] _geom Contact geometry.
+      /// \param[in] _joint The contact joint.
+      private: void WarmStartContact(const ODECachedPair *_pair,
+                   const dContactGeom &_geom, const dJointID _joint);
+
+      /// \brief Replace the top level space with a space of the active
+      /// broad phase, and move all its geoms and model spaces into it.
+      private: void CreateSpace();
+
+      /// \brief Pick the active broad phase of the adaptive mode from the
+      /// bounding boxes of the objects in the top level space.
+      private: void AdaptBroadPhase();
+
+      /// \brief Bake the static collisions into merged meshes.
+      private: void Bake();
+
+      /// \brief Queue a collision to be collided with a merged mesh.
+      /// \param[in] _collision The collision.
+      /// \param[in] _region The merged mesh.
+      private: void AddBakedCollider(ODECollision *_collision,
+                   ODEBakedRegion *_region);
+
+      /// \brief Collide a collision with a merged mesh, and add the
+      /// contacts of each baked collision it touches.
+      /// \param[in] _collision The collision.
+      /// \param[in] _region The merged mesh.
+      private: void CollideBaked(ODECollision *_collision,
+                   ODEBakedRegion *_region);
+
+      /// \brief Move back the links with continuous collision detection
+      /// that passed through a collision during the step.
+      private: void SweepContinuousCollisions();
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
@@ -18,11 +18,16 @@
 #ifndef _ODEPHYSICS_PRIVATE_HH_
 #define _ODEPHYSICS_PRIVATE_HH_
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <utility>
 
+#include <tbb/task_arena.h>
+
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 
@@ -45,6 +50,100 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief Output of the multi-threaded narrow phase for one contiguous
+    /// range of colliders.
+    class ODENarrowPhaseBuffer
+    {
+      /// \brief Contacts generated by dCollide for the current pair.
+      public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
+
+      /// \brief Selected contacts of all pairs in the range, back to back.
+      public: std::vector<dContactGeom> contacts;
+
+      /// \brief Index into the colliders and number of contacts for each
+      /// pair with contacts. A count of -1 means the pair must be collided
+      /// on the physics thread.
+      public: std::vector<std::pair<unsigned int, int> > pairs;
+    };
+
+    /// \brief Contact joint kept from one step to the next, to warm start
+    /// the solver with its constraint forces.
+    class ODECachedContact
+    {
+      /// \brief Contact position in world frame.
+      public: dVector3 pos;
+
+      /// \brief Contact normal in world frame.
+      public: dVector3 normal;
+
+      /// \brief Features of the two geoms that touch, such as triangle
+      /// indices, or -1 if the colliders don't report them.
+      public: int side1;
+
+      /// \brief Feature of the second geom.
+      public: int side2;
+
+      /// \brief The contact joint, valid until the contact group is
+      /// emptied.
+      public: dJointID joint;
+
+      /// \brief Constraint forces of the joint, followed by the position
+      /// correction forces, as read by dJointGetLambda.
+      public: dReal lambda[12];
+
+      /// \brief True once a contact of the next step took its forces.
+      public: bool matched;
+    };
+
+    /// \brief Static collisions of one region merged into a single triangle
+    /// mesh.
+    class ODEBakedRegion
+    {
+      /// \brief The merged mesh, placed at the center of the region.
+      public: dGeomID geom = nullptr;
+
+      /// \brief Triangle data of the merged mesh.
+      public: dTriMeshDataID data = nullptr;
+
+      /// \brief Vertices, relative to the center of the region.
+      public: std::vector<float> vertices;
+
+      /// \brief Vertex indices of the triangles.
+      public: std::vector<int> indices;
+
+      /// \brief Collisions baked into the merged mesh.
+      public: std::vector<ODECollision *> collisions;
+
+      /// \brief For each triangle, index of the collision it was baked
+      /// from.
+      public: std::vector<unsigned int> owners;
+    };
+
+    /// \brief Range of cached contacts that belong to a collision pair.
+    class ODECachedPair
+    {
+      /// \brief First collision.
+      public: ODECollision *collision1;
+
+      /// \brief Second collision.
+      public: ODECollision *collision2;
+
+      /// \brief Index of the first contact of the pair.
+      public: size_t begin;
+
+      /// \brief One past the last contact of the pair.
+      public: size_t end;
+
+      /// \brief Order pairs by collisions, to search them.
+      /// \param[in] _other Pair to compare with.
+      /// \return True if this pair sorts first.
+      public: bool operator<(const ODECachedPair &_other) const
+              {
+                return std::tie(this->collision1, this->collision2) <
+                    std::tie(_other.collision1, _other.collision2);
+              }
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -78,8 +177,22 @@ namespace gazebo
       /// \brief Array of contact collisions.
       public: dContactGeom contactCollisions[MAX_COLLIDE_RETURNS];
 
-      /// \brief Indices used during creation of contact joints.
-      public: int indices[MAX_CONTACT_JOINTS];
+      /// \brief Identity indices, used to create joints for contacts that
+      /// are already sorted.
+      public: int sequentialIndices[MAX_CONTACT_JOINTS];
+
+      /// \brief Limit on the contacts of each pair set by the physics
+      /// engine max_contacts, resolved once per step.
+      public: unsigned int maxCollide;
+
+      /// \brief Number of threads used for the narrow phase.
+      public: int narrowPhaseThreads;
+
+      /// \brief Task arena limiting the number of narrow phase threads.
+      public: std::unique_ptr<tbb::task_arena> narrowPhaseArena;
+
+      /// \brief One buffer for each narrow phase thread.
+      public: std::vector<ODENarrowPhaseBuffer> narrowPhaseBuffers;
 
       /// \brief Current index into the contactFeedbacks buffer
       public: unsigned int jointFeedbackIndex;
@@ -92,6 +205,98 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief True to seed contact joints with the forces of the
+      /// matching contacts of the previous step.
+      public: bool contactWarmStart;
+
+      /// \brief Largest distance between a contact and the contact of the
+      /// previous step it takes its forces from.
+      public: double contactWarmStartDistance;
+
+      /// \brief True to make the results of a step independent of the
+      /// number of threads and of the order of the broad phase pairs.
+      public: bool deterministic;
+
+      /// \brief Contacts created in the previous step.
+      public: std::vector<ODECachedContact> prevContacts;
+
+      /// \brief Collision pairs of prevContacts, sorted.
+      public: std::vector<ODECachedPair> prevPairs;
+
+      /// \brief Contacts created in the current step.
+      public: std::vector<ODECachedContact> contacts;
+
+      /// \brief Collision pairs of contacts, in creation order.
+      public: std::vector<ODECachedPair> pairs;
+
+      /// \brief Requested broad phase of the top level space.
+      public: std::string broadPhase;
+
+      /// \brief Broad phase of the top level space. It differs from
+      /// broadPhase in the adaptive mode, and until the space is replaced at
+      /// the start of the next step.
+      public: std::string activeBroadPhase;
+
+      /// \brief True if the top level space must be replaced by a space of
+      /// the active broad phase.
+      public: bool spaceDirty;
+
+      /// \brief Axis order of the sweep and prune space, as one of the
+      /// dSAP_AXES_* values.
+      public: int sapAxisOrder;
+
+      /// \brief Number of geom pairs found by the broad phase during the
+      /// current step.
+      public: unsigned int broadPhasePairs;
+
+      /// \brief Number of geom pairs found by the broad phase during the
+      /// last step.
+      public: std::atomic<unsigned int> lastBroadPhasePairs;
+
+      /// \brief Deepest penetration of the contact joints of the last
+      /// collision update.
+      public: double maxPenetration;
+
+      /// \brief Number of steps since the adaptive broad phase was checked.
+      public: unsigned int broadPhaseSteps;
+
+      /// \brief True if static collisions are baked.
+      public: bool bakeStatic;
+
+      /// \brief True if the static collisions must be baked at the start
+      /// of the next step.
+      public: bool bakeDirty;
+
+      /// \brief Side length of the regions of baked collisions.
+      public: double bakeRegionSize;
+
+      /// \brief Merged meshes of baked collisions.
+      public: std::vector<std::unique_ptr<ODEBakedRegion> > bakedRegions;
+
+      /// \brief Merged mesh of each merged mesh geom.
+      public: std::map<dGeomID, ODEBakedRegion *> bakedGeoms;
+
+      /// \brief All the baked collisions.
+      public: std::vector<ODECollision *> bakedCollisions;
+
+      /// \brief Collisions to collide with merged meshes during this step.
+      public: std::vector<std::pair<ODECollision *, ODEBakedRegion *> >
+              bakedColliders;
+
+      /// \brief Names of the introspection items registered by the engine.
+      public: std::vector<std::string> introspectionItems;
+
+      /// \brief Links with continuous collision detection, in the order
+      /// they were added.
+      public: std::vector<ODELink *> ccdLinks;
+
+      /// \brief Center of mass of each of ccdLinks at the start of the
+      /// step, or NaN if its body isn't moving.
+      public: std::vector<ignition::math::Vector3d> ccdStarts;
+
+      /// \brief Ray that sweeps the links, outside of any space.
+      public: dGeomID ccdRay;
     };
   }
 }
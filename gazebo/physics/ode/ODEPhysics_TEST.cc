@@ -16,10 +16,15 @@
 */
 
 #include <gtest/gtest.h>
+#include <map>
+#include <sstream>
+#include <string>
 
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
+#include "gazebo/physics/ode/ODEStepMemory.hh"
 #include "gazebo/physics/ode/ODETypes.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -490,6 +495,373 @@ TEST_F(ODEPhysics_TEST, PhysicsMsgParam)
   PhysicsMsgParam();
 }
 
+/////////////////////////////////////////////////
+/// Test that the multi-threaded narrow phase generates the same contacts
+/// as the single threaded narrow phase.
+TEST_F(ODEPhysics_TEST, ParallelNarrowPhase)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_EQ(0, odePhysics->NarrowPhaseThreads());
+  EXPECT_TRUE(odePhysics->SetParam("narrow_phase_threads", 4));
+  EXPECT_EQ(4, boost::any_cast<int>(
+      odePhysics->GetParam("narrow_phase_threads")));
+
+  // Let the shapes settle on the ground plane
+  world->Step(200);
+  const WorldState parallelState(world);
+  const unsigned int parallelContacts =
+      world->Physics()->GetContactManager()->GetContactCount();
+
+  world->Reset();
+  odePhysics->SetNarrowPhaseThreads(0);
+  world->Step(200);
+  const WorldState serialState(world);
+
+  EXPECT_EQ(parallelContacts,
+      world->Physics()->GetContactManager()->GetContactCount());
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    std::string name = world->ModelByIndex(i)->GetName();
+    EXPECT_EQ(parallelState.GetModelState(name).Pose(),
+              serialState.GetModelState(name).Pose()) << name;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that the vectorized row kernels solve the same problem as the
+/// quick solver, up to rounding.
+TEST_F(ODEPhysics_TEST, QuickSIMD)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_EQ("quick", odePhysics->GetStepType());
+  EXPECT_FALSE(dWorldGetQuickStepSIMDRows(odePhysics->GetWorldId()));
+
+  EXPECT_TRUE(odePhysics->SetParam("solver_type", std::string("quick_simd")));
+  EXPECT_EQ("quick_simd", odePhysics->GetStepType());
+  EXPECT_EQ("quick_simd", boost::any_cast<std::string>(
+      odePhysics->GetParam("solver_type")));
+  EXPECT_TRUE(dWorldGetQuickStepSIMDRows(odePhysics->GetWorldId()));
+
+  // Let the shapes settle on the ground plane
+  world->Step(500);
+  const WorldState simdState(world);
+
+  world->Reset();
+  odePhysics->SetStepType("quick");
+  EXPECT_FALSE(dWorldGetQuickStepSIMDRows(odePhysics->GetWorldId()));
+  world->Step(500);
+  const WorldState quickState(world);
+
+  for (unsigned int i = 0; i < world->ModelCount(); ++i)
+  {
+    std::string name = world->ModelByIndex(i)->GetName();
+    EXPECT_NEAR(0.0, (simdState.GetModelState(name).Pose().Pos() -
+        quickState.GetModelState(name).Pose().Pos()).Length(), 1e-4) << name;
+  }
+}
+
+/////////////////////////////////////////////////
+/// Test that warm started contacts let shapes rest on the ground with few
+/// solver iterations.
+TEST_F(ODEPhysics_TEST, ContactWarmStart)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_FALSE(odePhysics->ContactWarmStart());
+  EXPECT_DOUBLE_EQ(0.01, odePhysics->ContactWarmStartDistance());
+  EXPECT_TRUE(odePhysics->SetParam("contact_warm_start", true));
+  EXPECT_TRUE(boost::any_cast<bool>(
+      odePhysics->GetParam("contact_warm_start")));
+  EXPECT_TRUE(odePhysics->SetParam("contact_warm_start_distance", 0.02));
+  EXPECT_DOUBLE_EQ(0.02, boost::any_cast<double>(
+      odePhysics->GetParam("contact_warm_start_distance")));
+  odePhysics->SetContactWarmStartDistance(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, odePhysics->ContactWarmStartDistance());
+  odePhysics->SetContactWarmStartDistance(0.01);
+
+  // Few iterations, carried over from step to step by the warm start
+  odePhysics->SetSORPGSIters(10);
+  odePhysics->SetParam("warm_start_factor", 1.0);
+
+  world->Step(1000);
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2);
+  EXPECT_NEAR(0.0, box->WorldLinearVel().Length(), 1e-3);
+  EXPECT_LT(0u, world->Physics()->GetContactManager()->GetContactCount());
+
+  // Turning it off drops the cached contacts and keeps the box at rest
+  odePhysics->SetContactWarmStart(false);
+  EXPECT_FALSE(odePhysics->ContactWarmStart());
+  world->Step(100);
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2);
+}
+
+/////////////////////////////////////////////////
+/// Test that the collide bitmask filter in the broad phase callback
+/// follows changes to the surface parameters.
+TEST_F(ODEPhysics_TEST, CollideBitmaskFilter)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  CollisionPtr collision = box->GetLink("link")->GetCollision("collision");
+  ASSERT_TRUE(collision != nullptr);
+
+  // The box rests on the ground plane
+  world->Step(100);
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2);
+
+  // It falls through once it no longer collides with the ground
+  collision->GetSurface()->collideBitmask = 0x0;
+  world->Step(100);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 0.0);
+
+  // Colliding without contact keeps it falling
+  world->Reset();
+  collision->GetSurface()->collideBitmask = 0xffff;
+  collision->GetSurface()->collideWithoutContact = true;
+  world->Step(100);
+  EXPECT_LT(box->WorldPose().Pos().Z(), 0.0);
+}
+
+/////////////////////////////////////////////////
+/// Test that every broad phase finds the contacts with the ground plane,
+/// and that the adaptive broad phase resolves to a space type.
+TEST_F(ODEPhysics_TEST, BroadPhase)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_EQ("hash", odePhysics->BroadPhase());
+  EXPECT_EQ("hash", odePhysics->ActiveBroadPhase());
+  EXPECT_FALSE(odePhysics->SetBroadPhase("bvh"));
+  EXPECT_EQ("hash", odePhysics->BroadPhase());
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+
+  for (const std::string type : {"sap", "quadtree", "simple", "hash"})
+  {
+    world->Reset();
+    EXPECT_TRUE(odePhysics->SetParam("broad_phase", type));
+    EXPECT_EQ(type, boost::any_cast<std::string>(
+        odePhysics->GetParam("broad_phase")));
+    world->Step(200);
+    EXPECT_EQ(type, odePhysics->ActiveBroadPhase());
+    EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2) << type;
+    EXPECT_LT(0u, odePhysics->BroadPhasePairCount()) << type;
+    EXPECT_EQ(odePhysics->BroadPhasePairCount(), boost::any_cast<unsigned int>(
+        odePhysics->GetParam("broad_phase_pairs")));
+  }
+
+  // A few shapes are tested pair by pair
+  world->Reset();
+  EXPECT_TRUE(odePhysics->SetBroadPhase("adaptive"));
+  world->Step(200);
+  EXPECT_EQ("adaptive", odePhysics->BroadPhase());
+  EXPECT_EQ("simple", odePhysics->ActiveBroadPhase());
+  EXPECT_NEAR(0.5, box->WorldPose().Pos().Z(), 1e-2);
+}
+
+/////////////////////////////////////////////////
+/// Test that baked static collisions keep their contacts and ray hits.
+TEST_F(ODEPhysics_TEST, BakeStaticCollisions)
+{
+  Load("worlds/empty.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_FALSE(odePhysics->BakeStaticCollisions());
+  EXPECT_DOUBLE_EQ(50.0, odePhysics->BakeRegionSize());
+  EXPECT_TRUE(odePhysics->SetParam("bake_region_size", 10.0));
+  EXPECT_DOUBLE_EQ(10.0, boost::any_cast<double>(
+      odePhysics->GetParam("bake_region_size")));
+  EXPECT_TRUE(odePhysics->SetParam("bake_static_collisions", true));
+  EXPECT_TRUE(boost::any_cast<bool>(
+      odePhysics->GetParam("bake_static_collisions")));
+
+  // Two static boxes in one region and one in another, and a box that
+  // falls on the first one
+  SpawnBox("block1", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(1, 1, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  SpawnBox("block2", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(3, 1, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  SpawnBox("block3", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(25, 1, 0.5), ignition::math::Vector3d::Zero,
+      true);
+  SpawnBox("box", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(1, 1, 2.0));
+
+  world->Step(500);
+  EXPECT_EQ(2u, odePhysics->BakedRegionCount());
+
+  ModelPtr box = world->ModelByName("box");
+  ASSERT_TRUE(box != nullptr);
+  EXPECT_NEAR(1.5, box->WorldPose().Pos().Z(), 1e-2);
+
+  // Rays hit the collision the triangles were baked from
+  RayShapePtr ray = boost::dynamic_pointer_cast<RayShape>(
+      world->Physics()->CreateShape("ray", CollisionPtr()));
+  ASSERT_TRUE(ray != nullptr);
+
+  double dist;
+  std::string entity;
+  ray->SetPoints(ignition::math::Vector3d(5, 1, 0.5),
+                 ignition::math::Vector3d(-5, 1, 0.5));
+  ray->GetIntersection(dist, entity);
+  EXPECT_NEAR(1.5, dist, 1e-4);
+  EXPECT_EQ("block2::body::geom", entity);
+
+  ray->SetPoints(ignition::math::Vector3d(23, 1, 0.5),
+                 ignition::math::Vector3d(30, 1, 0.5));
+  ray->GetIntersection(dist, entity);
+  EXPECT_NEAR(1.5, dist, 1e-4);
+  EXPECT_EQ("block3::body::geom", entity);
+
+  // Moving a baked collision takes it out of its merged mesh
+  ModelPtr block1 = world->ModelByName("block1");
+  ASSERT_TRUE(block1 != nullptr);
+  block1->SetWorldPose(ignition::math::Pose3d(1, -1, 0.5, 0, 0, 0));
+  world->Step(1);
+  EXPECT_FALSE(boost::static_pointer_cast<ODECollision>(
+      block1->GetLink("body")->GetCollision("geom"))->Baked());
+  EXPECT_EQ(2u, odePhysics->BakedRegionCount());
+  ray->SetPoints(ignition::math::Vector3d(-5, -1, 0.5),
+                 ignition::math::Vector3d(5, -1, 0.5));
+  ray->GetIntersection(dist, entity);
+  EXPECT_NEAR(5.5, dist, 1e-4);
+  EXPECT_EQ("block1::body::geom", entity);
+
+  // Turning it off puts the geoms back into their spaces
+  odePhysics->SetBakeStaticCollisions(false);
+  world->Step(100);
+  EXPECT_EQ(0u, odePhysics->BakedRegionCount());
+  ray->SetPoints(ignition::math::Vector3d(5, 1, 0.5),
+                 ignition::math::Vector3d(-5, 1, 0.5));
+  ray->GetIntersection(dist, entity);
+  EXPECT_EQ("block2::body::geom", entity);
+}
+
+/////////////////////////////////////////////////
+/// Test that persistent step memory serves repeated transients from its
+/// reserve.
+TEST_F(ODEPhysics_TEST, PersistentStepMemory)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_FALSE(ODEStepMemory::Persistent());
+  EXPECT_TRUE(odePhysics->SetParam("persistent_step_memory", true));
+  EXPECT_TRUE(boost::any_cast<bool>(
+      odePhysics->GetParam("persistent_step_memory")));
+
+  // Let the shapes fall and settle on the ground plane
+  const ODEStepMemoryStats start = ODEStepMemory::Stats();
+  world->Step(200);
+  const ODEStepMemoryStats settled = ODEStepMemory::Stats();
+  EXPECT_GT(settled.allocations, start.allocations);
+  EXPECT_GT(settled.bytesInUse, 0u);
+  EXPECT_GE(settled.highWater, settled.bytesInUse);
+  EXPECT_GE(settled.bytesReserved, settled.bytesInUse);
+
+  // The same transient again is served by the reserve
+  world->Reset();
+  world->Step(200);
+  const ODEStepMemoryStats repeated = ODEStepMemory::Stats();
+  EXPECT_EQ(settled.systemAllocations, repeated.systemAllocations);
+
+  // Disabling it returns the reserve
+  odePhysics->SetParam("persistent_step_memory", false);
+  const ODEStepMemoryStats released = ODEStepMemory::Stats();
+  EXPECT_EQ(released.bytesReserved, released.bytesInUse);
+  world->Step(10);
+}
+
+/////////////////////////////////////////////////
+/// Test that deterministic steps don't depend on the number of threads.
+TEST_F(ODEPhysics_TEST, Deterministic)
+{
+  Load("worlds/shapes.world", true, "ode");
+  WorldPtr world = get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  ODEPhysicsPtr odePhysics =
+      boost::dynamic_pointer_cast<ODEPhysics>(world->Physics());
+  ASSERT_TRUE(odePhysics != nullptr);
+
+  EXPECT_FALSE(odePhysics->Deterministic());
+  EXPECT_TRUE(odePhysics->SetParam("deterministic", true));
+  EXPECT_TRUE(boost::any_cast<bool>(odePhysics->GetParam("deterministic")));
+  EXPECT_TRUE(dWorldGetDeterministic(odePhysics->GetWorldId()));
+
+  EXPECT_EQ(0u, world->StateChecksum());
+  world->SetStateChecksum(true);
+
+  // Let the shapes settle on the ground plane with threads
+  odePhysics->SetParam("island_threads", 4);
+  odePhysics->SetNarrowPhaseThreads(4);
+  odePhysics->SetSeed(7);
+  world->Step(1);
+  const uint64_t first = world->StateChecksum();
+  EXPECT_NE(0u, first);
+  world->Step(299);
+  const uint64_t threaded = world->StateChecksum();
+  EXPECT_NE(first, threaded);
+
+  // Then without
+  world->Reset();
+  odePhysics->SetParam("island_threads", 0);
+  odePhysics->SetNarrowPhaseThreads(0);
+  odePhysics->SetSeed(7);
+  world->Step(300);
+  EXPECT_EQ(threaded, world->StateChecksum());
+
+  world->SetStateChecksum(false);
+  EXPECT_EQ(0u, world->StateChecksum());
+  odePhysics->SetDeterministic(false);
+  EXPECT_FALSE(dWorldGetDeterministic(odePhysics->GetWorldId()));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -129,6 +129,7 @@ void ODERayShape::GetIntersection(double &_dist, std::string &_entity)
   {
     Intersection intersection;
     intersection.depth = 1000;
+    intersection.physics = this->physicsEngine.get();
 
     {
       boost::recursive_mutex::scoped_lock lock(
@@ -180,6 +181,7 @@ void ODERayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
   {
     ODECollision *collision1, *collision2;
     ODECollision *hitCollision = nullptr;
+    dGeomID hitGeom = nullptr;
 
     // Get pointers to the underlying collisions
     if (dGeomGetClass(_o1) == dGeomTransformClass)
@@ -199,22 +201,34 @@ void ODERayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
     if (dGeomGetClass(_o1) == dRayClass)
     {
       hitCollision = collision2;
+      hitGeom = _o2;
       dGeomRaySetParams(_o1, 0, 0);
       dGeomRaySetClosestHit(_o1, 1);
     }
     else if (dGeomGetClass(_o2) == dRayClass)
     {
       hitCollision = collision1;
+      hitGeom = _o1;
       dGeomRaySetParams(_o2, 0, 0);
       dGeomRaySetClosestHit(_o2, 1);
     }
 
-    if (hitCollision)
+    // Merged meshes of baked collisions have no collision of their own
+    const bool baked = !hitCollision && hitGeom && inter->physics &&
+        dGeomGetClass(hitGeom) == dTriMeshClass;
+
+    if (hitCollision || baked)
     {
       // Check for ray/collision intersections
       int n = dCollide(_o1, _o2, 1, &contact, sizeof(contact));
 
-      if (n > 0)
+      if (n > 0 && baked)
+      {
+        hitCollision = inter->physics->BakedCollision(hitGeom,
+            hitGeom == _o1 ? contact.side1 : contact.side2);
+      }
+
+      if (n > 0 && hitCollision)
       {
         if (contact.depth < inter->depth)
         {
@@ -90,6 +90,10 @@ namespace gazebo
 
                  /// \brief Name of the collision object that was hit.
                  public: std::string name;
+
+                 /// \brief Physics engine, which maps the hits on baked
+                 /// collisions back to their collision.
+                 public: ODEPhysics *physics = nullptr;
                };
     };
     /// \}
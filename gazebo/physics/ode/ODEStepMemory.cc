@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "gazebo/physics/ode/ODEStepMemory.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \internal
+/// \brief A block taken from the system.
+struct StepMemoryBlock
+{
+  /// \brief Size in bytes.
+  std::size_t size;
+
+  /// \brief True if it was mapped with huge pages, false if it was
+  /// allocated with malloc.
+  bool mapped;
+};
+
+/// \internal
+/// \brief State of the step memory manager.
+struct StepMemoryState
+{
+  /// \brief Blocks taken from the system, in use or in the reserve.
+  std::unordered_map<void *, StepMemoryBlock> blocks;
+
+  /// \brief Free blocks of the reserve, by size.
+  std::map<std::size_t, std::vector<void *>> reserve;
+
+  /// \brief True to keep the freed blocks.
+  bool persistent = false;
+
+  /// \brief True to back large blocks with huge pages.
+  bool hugePages = false;
+
+  /// \brief The counters.
+  ODEStepMemoryStats stats;
+
+  /// \brief Protects the members.
+  std::mutex mutex;
+};
+
+//////////////////////////////////////////////////
+/// \brief Get the state of the manager. It's never destroyed, as the
+/// working memory of the islands may be freed after static destruction.
+/// \return The state.
+static StepMemoryState &state()
+{
+  static StepMemoryState *memoryState = new StepMemoryState;
+  return *memoryState;
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the size of the reserve blocks that serve a request.
+/// \param[in] _size Requested size.
+/// \return The smallest power of two at least kMinBlockSize and _size.
+static std::size_t reserveSize(const std::size_t _size)
+{
+  std::size_t size = ODEStepMemory::kMinBlockSize;
+  while (size < _size)
+    size *= 2;
+  return size;
+}
+
+//////////////////////////////////////////////////
+/// \brief Take a block from the system. The mutex of the state is held.
+/// \param[in] _size Size in bytes.
+/// \param[out] _block The block.
+/// \return Its address, null on failure.
+static void *systemAlloc(const std::size_t _size, StepMemoryBlock &_block)
+{
+  StepMemoryState &memory = state();
+#ifdef __linux__
+  if (memory.hugePages && _size >= ODEStepMemory::kHugePageSize)
+  {
+    const std::size_t pages = (_size + ODEStepMemory::kHugePageSize - 1) /
+      ODEStepMemory::kHugePageSize;
+    const std::size_t size = pages * ODEStepMemory::kHugePageSize;
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr != MAP_FAILED)
+    {
+      madvise(ptr, size, MADV_HUGEPAGE);
+
+      // Fault the pages in now rather than in the step that first uses
+      // them.
+      volatile char *bytes = static_cast<char *>(ptr);
+      for (std::size_t i = 0; i < size; i += 4096)
+        bytes[i] = 0;
+
+      _block.size = size;
+      _block.mapped = true;
+      memory.stats.hugePageBytes += size;
+      return ptr;
+    }
+  }
+#endif
+
+  void *ptr = std::malloc(_size);
+  _block.size = _size;
+  _block.mapped = false;
+  return ptr;
+}
+
+//////////////////////////////////////////////////
+/// \brief Return a block to the system. The mutex of the state is held.
+/// \param[in] _ptr Address of the block.
+/// \param[in] _block The block.
+static void systemFree(void *_ptr, const StepMemoryBlock &_block)
+{
+  StepMemoryState &memory = state();
+  memory.stats.bytesReserved -= _block.size;
+#ifdef __linux__
+  if (_block.mapped)
+  {
+    memory.stats.hugePageBytes -= _block.size;
+    munmap(_ptr, _block.size);
+    return;
+  }
+#endif
+  std::free(_ptr);
+}
+
+//////////////////////////////////////////////////
+/// \brief Allocate a block for ODE.
+/// \param[in] _size Size in bytes.
+/// \return The block, null on failure.
+static void *allocBlock(size_t _size)
+{
+  StepMemoryState &memory = state();
+  std::lock_guard<std::mutex> lock(memory.mutex);
+  ++memory.stats.allocations;
+
+  const std::size_t size = memory.persistent ? reserveSize(_size) : _size;
+  void *ptr = nullptr;
+  if (memory.persistent)
+  {
+    auto iter = memory.reserve.find(size);
+    if (iter != memory.reserve.end() && !iter->second.empty())
+    {
+      ptr = iter->second.back();
+      iter->second.pop_back();
+      ++memory.stats.reuses;
+    }
+  }
+
+  if (!ptr)
+  {
+    StepMemoryBlock block;
+    ptr = systemAlloc(size, block);
+    if (!ptr)
+      return nullptr;
+    memory.blocks[ptr] = block;
+    memory.stats.bytesReserved += block.size;
+    ++memory.stats.systemAllocations;
+  }
+
+  memory.stats.bytesInUse += memory.blocks[ptr].size;
+  memory.stats.highWater =
+    std::max(memory.stats.highWater, memory.stats.bytesInUse);
+  return ptr;
+}
+
+//////////////////////////////////////////////////
+/// \brief Shrink a block for ODE. ODE only shrinks the arena it is about
+/// to replace, so the block is kept whole.
+/// \param[in] _ptr The block.
+/// \return _ptr.
+static void *shrinkBlock(void *_ptr, size_t /*_size*/, size_t /*_smaller*/)
+{
+  return _ptr;
+}
+
+//////////////////////////////////////////////////
+/// \brief Free a block for ODE.
+/// \param[in] _ptr The block.
+/// \param[in] _size Size of the block, as ODE knows it.
+static void freeBlock(void *_ptr, size_t _size)
+{
+  StepMemoryState &memory = state();
+  std::lock_guard<std::mutex> lock(memory.mutex);
+
+  auto iter = memory.blocks.find(_ptr);
+  if (iter == memory.blocks.end())
+  {
+    // Allocated by ODE before the manager was installed.
+    dFree(_ptr, _size);
+    return;
+  }
+
+  memory.stats.bytesInUse -= iter->second.size;
+  if (memory.persistent && reserveSize(iter->second.size) ==
+      iter->second.size)
+  {
+    memory.reserve[iter->second.size].push_back(_ptr);
+    return;
+  }
+
+  systemFree(_ptr, iter->second);
+  memory.blocks.erase(iter);
+}
+
+//////////////////////////////////////////////////
+bool ODEStepMemory::Install(dWorldID _worldId)
+{
+  dWorldStepMemoryFunctionsInfo info;
+  info.struct_size = sizeof(info);
+  info.alloc_block = &allocBlock;
+  info.shrink_block = &shrinkBlock;
+  info.free_block = &freeBlock;
+  return dWorldSetStepMemoryManager(_worldId, &info) != 0;
+}
+
+//////////////////////////////////////////////////
+void ODEStepMemory::SetPersistent(const bool _enable)
+{
+  {
+    std::lock_guard<std::mutex> lock(state().mutex);
+    state().persistent = _enable;
+  }
+
+  if (!_enable)
+    ReleaseReserve();
+}
+
+//////////////////////////////////////////////////
+bool ODEStepMemory::Persistent()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  return state().persistent;
+}
+
+//////////////////////////////////////////////////
+void ODEStepMemory::SetHugePages(const bool _enable)
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  state().hugePages = _enable;
+}
+
+//////////////////////////////////////////////////
+bool ODEStepMemory::HugePages()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  return state().hugePages;
+}
+
+//////////////////////////////////////////////////
+ODEStepMemoryStats ODEStepMemory::Stats()
+{
+  std::lock_guard<std::mutex> lock(state().mutex);
+  return state().stats;
+}
+
+//////////////////////////////////////////////////
+void ODEStepMemory::ReleaseReserve()
+{
+  StepMemoryState &memory = state();
+  std::lock_guard<std::mutex> lock(memory.mutex);
+  for (auto &entry : memory.reserve)
+  {
+    for (void *ptr : entry.second)
+    {
+      auto iter = memory.blocks.find(ptr);
+      systemFree(ptr, iter->second);
+      memory.blocks.erase(iter);
+    }
+  }
+  memory.reserve.clear();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PHYSICS_ODE_ODESTEPMEMORY_HH_
+#define GAZEBO_PHYSICS_ODE_ODESTEPMEMORY_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "gazebo/physics/ode/ode_inc.h"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics_ode
+    /// \{
+
+    /// \brief Counters of the step memory of ODE.
+    class GZ_PHYSICS_VISIBLE ODEStepMemoryStats
+    {
+      /// \brief Number of blocks requested by ODE.
+      public: uint64_t allocations = 0;
+
+      /// \brief Number of the requested blocks taken from the reserve,
+      /// without asking the system.
+      public: uint64_t reuses = 0;
+
+      /// \brief Number of blocks taken from the system.
+      public: uint64_t systemAllocations = 0;
+
+      /// \brief Bytes of the blocks ODE holds.
+      public: std::size_t bytesInUse = 0;
+
+      /// \brief Most bytes ODE held at once.
+      public: std::size_t highWater = 0;
+
+      /// \brief Bytes taken from the system, in use or in the reserve.
+      public: std::size_t bytesReserved = 0;
+
+      /// \brief Bytes of the taken bytes that are backed by huge pages.
+      public: std::size_t hugePageBytes = 0;
+    };
+
+    /// \class ODEStepMemory ODEStepMemory.hh physics/physics.hh
+    /// \brief Memory manager of the working memory of the ODE steps, the
+    /// arenas of the world and island contexts. ODE reallocates an arena
+    /// when an island grows past it, which happens whenever contacts
+    /// merge islands.
+    ///
+    /// In persistent mode, freed blocks stay in a reserve of power of two
+    /// sizes and serve the next requests of their size, so after the
+    /// first transients the reserve holds the high-water mark and the
+    /// steps no longer allocate. The reserve never shrinks until
+    /// persistent mode is disabled. With huge pages, blocks of 2 MiB or
+    /// more are mapped with transparent huge pages and pre-faulted.
+    ///
+    /// The settings and counters are shared by all the worlds of the
+    /// process, as ODE only takes plain functions.
+    class GZ_PHYSICS_VISIBLE ODEStepMemory
+    {
+      /// \brief Make a world allocate its step memory from this manager.
+      /// Call it before the world is first stepped.
+      /// \param[in] _worldId The world.
+      /// \return False if ODE failed to set the manager.
+      public: static bool Install(dWorldID _worldId);
+
+      /// \brief Set whether freed blocks are kept for the next steps.
+      /// Disabling it returns the reserve to the system.
+      /// \param[in] _enable True to keep the freed blocks.
+      public: static void SetPersistent(const bool _enable);
+
+      /// \brief Get whether freed blocks are kept.
+      /// \return True in persistent mode.
+      public: static bool Persistent();
+
+      /// \brief Set whether large blocks are backed by huge pages and
+      /// pre-faulted. It applies to the blocks taken afterwards. It has no
+      /// effect outside of Linux.
+      /// \param[in] _enable True to use huge pages.
+      public: static void SetHugePages(const bool _enable);
+
+      /// \brief Get whether large blocks are backed by huge pages.
+      /// \return True if they are.
+      public: static bool HugePages();
+
+      /// \brief Get the counters.
+      /// \return The counters.
+      public: static ODEStepMemoryStats Stats();
+
+      /// \brief Return the blocks of the reserve to the system.
+      public: static void ReleaseReserve();
+
+      /// \brief Smallest block of the reserve in bytes.
+      public: static const std::size_t kMinBlockSize = 64 * 1024;
+
+      /// \brief Smallest block backed by huge pages in bytes.
+      public: static const std::size_t kHugePageSize = 2 * 1024 * 1024;
+    };
+    /// \}
+  }
+}
+#endif
@@ -89,7 +89,15 @@ void SimbodyModel::Init()
     simbodyPhysics->InitModel(
         boost::static_pointer_cast<Model>(shared_from_this()));
   }
+  else
+  {
+    this->InitJoints();
+  }
+}
 
+//////////////////////////////////////////////////
+void SimbodyModel::InitJoints()
+{
   // Initialize the joints last.
   Joint_V myJoints = this->GetJoints();
   for (Joint_V::iterator iter = myJoints.begin();
@@ -44,6 +44,10 @@ namespace gazebo
 
       // Documentation inherited
       public: virtual void Init();
+
+      /// \brief Initialize the joints, once SimbodyPhysics added the
+      /// model to its system.
+      public: void InitJoints();
     };
     /// \}
   }
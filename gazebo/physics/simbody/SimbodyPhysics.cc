@@ -86,6 +86,9 @@ SimbodyPhysics::SimbodyPhysics(WorldPtr _world)
       , contactStictionTransitionVelocity(0.0)
       , dynamicsWorld(nullptr)
       , stepTimeDouble(0.0)
+      , modelBatchDepth(0)
+      , pendingStateSaved(false)
+      , pendingStateTime(0.0)
 {
   // Instantiate the Multibody System
   // Instantiate the Simbody Matter Subsystem
@@ -263,44 +266,70 @@ void SimbodyPhysics::Init()
   this->simbodyPhysicsInitialized = true;
 }
 
+//////////////////////////////////////////////////
+void SimbodyPhysics::BeginModelBatch()
+{
+  ++this->modelBatchDepth;
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::EndModelBatch()
+{
+  if (this->modelBatchDepth == 0)
+  {
+    gzerr << "EndModelBatch called without BeginModelBatch\n";
+    return;
+  }
+
+  if (--this->modelBatchDepth == 0 && !this->pendingModels.empty())
+  {
+    physics::Model_V models;
+    std::swap(models, this->pendingModels);
+    this->FinishModels(models);
+  }
+}
+
 //////////////////////////////////////////////////
 void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
 {
   // Before building a new system, transfer all joints in existing
-  // models, save Simbody joint states in Gazebo Model.
-  const SimTK::State& currentState = this->integ->getState();
-  double stateTime = 0;
-  bool simbodyStateSaved = false;
-
-  if (currentState.getSystemStage() != SimTK::Stage::Empty)
+  // models, save Simbody joint states in Gazebo Model. In a batch this is
+  // done once, before the first model is added.
+  if (this->pendingModels.empty())
   {
-    stateTime = currentState.getTime();
-    physics::Model_V models = this->world->Models();
-    for (physics::Model_V::iterator mi = models.begin();
-         mi != models.end(); ++mi)
+    const SimTK::State& currentState = this->integ->getState();
+    this->pendingStateSaved = false;
+
+    if (currentState.getSystemStage() != SimTK::Stage::Empty)
     {
-      if ((*mi) != _model)
+      this->pendingStateTime = currentState.getTime();
+      physics::Model_V models = this->world->Models();
+      for (physics::Model_V::iterator mi = models.begin();
+           mi != models.end(); ++mi)
       {
-        physics::Joint_V joints = (*mi)->GetJoints();
-        for (physics::Joint_V::iterator jx = joints.begin();
-             jx != joints.end(); ++jx)
+        if ((*mi) != _model)
         {
-          SimbodyJointPtr simbodyJoint =
-            boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
-          simbodyJoint->SaveSimbodyState(currentState);
-        }
+          physics::Joint_V joints = (*mi)->GetJoints();
+          for (physics::Joint_V::iterator jx = joints.begin();
+               jx != joints.end(); ++jx)
+          {
+            SimbodyJointPtr simbodyJoint =
+              boost::dynamic_pointer_cast<physics::SimbodyJoint>(*jx);
+            simbodyJoint->SaveSimbodyState(currentState);
+          }
 
-        physics::Link_V links = (*mi)->GetLinks();
-        for (physics::Link_V::iterator lx = links.begin();
-             lx != links.end(); ++lx)
-        {
-          SimbodyLinkPtr simbodyLink =
-            boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
-          simbodyLink->SaveSimbodyState(currentState);
+          physics::Link_V links = (*mi)->GetLinks();
+          for (physics::Link_V::iterator lx = links.begin();
+               lx != links.end(); ++lx)
+          {
+            SimbodyLinkPtr simbodyLink =
+              boost::dynamic_pointer_cast<physics::SimbodyLink>(*lx);
+            simbodyLink->SaveSimbodyState(currentState);
+          }
         }
       }
+      this->pendingStateSaved = true;
     }
-    simbodyStateSaved = true;
   }
 
   try
@@ -327,6 +356,20 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
     gzthrow(std::string("Simbody build EXCEPTION: ") + e.what());
   }
 
+  // Realizing the topology costs as much as all the models in the system,
+  // so in a batch it is done once for all the new models.
+  this->pendingModels.push_back(_model);
+  if (this->modelBatchDepth == 0)
+  {
+    physics::Model_V models;
+    std::swap(models, this->pendingModels);
+    this->FinishModels(models);
+  }
+}
+
+//////////////////////////////////////////////////
+void SimbodyPhysics::FinishModels(const physics::Model_V &_models)
+{
   try
   {
     //------------------------ CREATE SIMBODY SYSTEM ---------------------------
@@ -342,10 +385,10 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
 
   // Restore Gazebo saved Joint states
   // back into Simbody state.
-  if (simbodyStateSaved)
+  if (this->pendingStateSaved)
   {
     // set/retsore state time.
-    state.setTime(stateTime);
+    state.setTime(this->pendingStateTime);
 
     physics::Model_V models = this->world->Models();
     for (physics::Model_V::iterator mi = models.begin();
@@ -369,38 +412,51 @@ void SimbodyPhysics::InitModel(const physics::ModelPtr _model)
       }
     }
   }
+  this->pendingStateSaved = false;
 
   // initialize integrator from state
   this->integ->initialize(state);
 
-  // mark links as initialized
-  Link_V links = _model->GetLinks();
-  for (Link_V::iterator li = links.begin(); li != links.end(); ++li)
+  for (auto const &model : _models)
   {
-    physics::SimbodyLinkPtr simbodyLink =
-      boost::dynamic_pointer_cast<physics::SimbodyLink>(*li);
-    if (simbodyLink)
-      simbodyLink->physicsInitialized = true;
-    else
-      gzerr << "failed to cast link [" << (*li)->GetName()
-            << "] as simbody link\n";
-  }
+    // mark links as initialized
+    Link_V links = model->GetLinks();
+    for (Link_V::iterator li = links.begin(); li != links.end(); ++li)
+    {
+      physics::SimbodyLinkPtr simbodyLink =
+        boost::dynamic_pointer_cast<physics::SimbodyLink>(*li);
+      if (simbodyLink)
+        simbodyLink->physicsInitialized = true;
+      else
+        gzerr << "failed to cast link [" << (*li)->GetName()
+              << "] as simbody link\n";
+    }
 
-  // mark joints as initialized
-  physics::Joint_V joints = _model->GetJoints();
-  for (physics::Joint_V::iterator ji = joints.begin();
-       ji != joints.end(); ++ji)
-  {
-    SimbodyJointPtr simbodyJoint =
-      boost::dynamic_pointer_cast<SimbodyJoint>(*ji);
-    if (simbodyJoint)
-      simbodyJoint->physicsInitialized = true;
-    else
-      gzerr << "simbodyJoint [" << (*ji)->GetName()
-            << "]is not a SimbodyJointPtr\n";
+    // mark joints as initialized
+    physics::Joint_V joints = model->GetJoints();
+    for (physics::Joint_V::iterator ji = joints.begin();
+         ji != joints.end(); ++ji)
+    {
+      SimbodyJointPtr simbodyJoint =
+        boost::dynamic_pointer_cast<SimbodyJoint>(*ji);
+      if (simbodyJoint)
+        simbodyJoint->physicsInitialized = true;
+      else
+        gzerr << "simbodyJoint [" << (*ji)->GetName()
+              << "]is not a SimbodyJointPtr\n";
+    }
   }
 
   this->simbodyPhysicsInitialized = true;
+
+  // The joints can only be set up once the state exists.
+  for (auto const &model : _models)
+  {
+    SimbodyModelPtr simbodyModel =
+      boost::dynamic_pointer_cast<SimbodyModel>(model);
+    if (simbodyModel)
+      simbodyModel->InitJoints();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -717,6 +773,14 @@ void SimbodyPhysics::UpdatePhysics()
   IGN_PROFILE_END();
 }
 
+//////////////////////////////////////////////////
+double SimbodyPhysics::MaxPenetration() const
+{
+  // The integrator already controls its error, and steps to the time of
+  // the world, so the step is never split.
+  return 0;
+}
+
 //////////////////////////////////////////////////
 void SimbodyPhysics::Fini()
 {
@@ -56,10 +56,19 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Reset();
 
-      /// \brief Add a Model to the Simbody system.
+      /// \brief Add a Model to the Simbody system, and initialize its
+      /// joints. Inside a model batch, the system is only rebuilt and the
+      /// joints initialized when the batch ends.
       /// \param[in] _model Pointer to the model to add into Simbody.
+      /// \sa BeginModelBatch
       public: void InitModel(const physics::ModelPtr _model);
 
+      // Documentation inherited
+      public: virtual void BeginModelBatch();
+
+      // Documentation inherited
+      public: virtual void EndModelBatch();
+
       // Documentation inherited
       public: virtual void InitForThread();
 
@@ -69,6 +78,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void UpdatePhysics();
 
+      // Documentation inherited
+      public: virtual double MaxPenetration() const;
+
       // Documentation inherited
       public: virtual void Fini();
 
@@ -203,6 +215,12 @@ namespace gazebo
         const SimTK::MultibodyGraphMaker &_mbgraph,
         const physics::ModelPtr _model);
 
+      /// \brief Realize the topology of the Simbody system once models
+      /// were added to it, restore the state of the other models, and
+      /// initialize the joints of the new models.
+      /// \param[in] _models The models added since the last rebuild.
+      private: void FinishModels(const physics::Model_V &_models);
+
       /// \brief helper function for building SimbodySystem
       private: void AddCollisionsToLink(const physics::SimbodyLink *_link,
         SimTK::MobilizedBody &_mobod, SimTK::ContactCliqueId _modelClique);
@@ -272,6 +290,19 @@ namespace gazebo
 
       private: double stepTimeDouble;
 
+      /// \brief Number of nested BeginModelBatch calls.
+      private: unsigned int modelBatchDepth;
+
+      /// \brief Models added to the system since the last rebuild.
+      private: physics::Model_V pendingModels;
+
+      /// \brief True if the state of the models was saved before the
+      /// pending models were added.
+      private: bool pendingStateSaved;
+
+      /// \brief Time of the saved state.
+      private: double pendingStateTime;
+
       /// \brief The type of the solver.
       /// Not used, just getting ready for optional pgs rigid contacts.
       private: std::string solverType;
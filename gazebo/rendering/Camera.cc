@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include <boost/algorithm/string.hpp>
@@ -25,6 +27,22 @@
 #include <ignition/math/Helpers.hh>
 #include <sdf/sdf.hh>
 
+// Pixel buffer objects are only used where the OpenGL library exports the
+// buffer object entry points directly.
+#if defined(HAVE_OPENGL) && !defined(_WIN32)
+  #define GAZEBO_CAMERA_ASYNC_READBACK
+  #if defined(__APPLE__)
+    #include <OpenGL/gl.h>
+    #include <OpenGL/glext.h>
+  #else
+    #ifndef GL_GLEXT_PROTOTYPES
+      #define GL_GLEXT_PROTOTYPES
+    #endif
+    #include <GL/gl.h>
+    #include <GL/glext.h>
+  #endif
+#endif
+
 #ifndef _WIN32
   #include <dirent.h>
 #else
@@ -187,6 +205,19 @@ void Camera::Load()
     this->dataPtr->distortion->Load(this->sdf->GetElement("distortion"));
   }
 
+  if (this->sdf->HasElement("gz:shadows"))
+    this->dataPtr->shadowsEnabled = this->sdf->Get<bool>("gz:shadows");
+  if (this->sdf->HasElement("gz:shadow_caching"))
+  {
+    this->dataPtr->shadowCaching =
+        this->sdf->Get<bool>("gz:shadow_caching");
+  }
+  if (this->sdf->HasElement("gz:fuse_post_effects"))
+  {
+    this->dataPtr->postEffectFusion =
+        this->sdf->Get<bool>("gz:fuse_post_effects");
+  }
+
   this->LoadCameraIntrinsics();
 }
 
@@ -347,6 +378,20 @@ void Camera::Init()
   this->dataPtr->trackMaxDistance = 8.0;
   this->dataPtr->trackPos = ignition::math::Vector3d(-5.0, 0.0, 3.0);
   this->dataPtr->trackInheritYaw = false;
+
+  const char *culling = getenv("GAZEBO_OCCLUSION_CULLING");
+  if (culling && std::string(culling) == "1")
+    this->dataPtr->occlusionCulling = true;
+  this->SetOcclusionCulling(this->dataPtr->occlusionCulling);
+
+  const char *shadowCaching = getenv("GAZEBO_SHADOW_CACHING");
+  if (shadowCaching && std::string(shadowCaching) == "1")
+    this->dataPtr->shadowCaching = true;
+  this->SetShadowCaching(this->dataPtr->shadowCaching);
+
+  const char *fusion = getenv("GAZEBO_FUSE_POST_EFFECTS");
+  if (fusion && std::string(fusion) == "1")
+    this->dataPtr->postEffectFusion = true;
 }
 
 //////////////////////////////////////////////////
@@ -354,6 +399,11 @@ void Camera::Fini()
 {
   this->dataPtr->videoEncoder.Reset();
 
+  this->ReleaseReadbackBuffers();
+
+  this->dataPtr->occlusionCuller.reset();
+  this->dataPtr->shadowCache.reset();
+
   if (this->saveFrameBuffer)
     delete [] this->saveFrameBuffer;
   this->saveFrameBuffer = NULL;
@@ -432,6 +482,15 @@ void Camera::Update()
   {
     if ((*iter)->has_follow_model())
       this->TrackVisual((*iter)->follow_model());
+    if ((*iter)->has_roi_width() || (*iter)->has_roi_height())
+    {
+      this->SetRenderRegion(
+          ignition::math::Vector2i((*iter)->roi_x(), (*iter)->roi_y()),
+          ignition::math::Vector2i((*iter)->roi_width(),
+          (*iter)->roi_height()));
+    }
+    if ((*iter)->has_render_scale())
+      this->SetRenderScale((*iter)->render_scale());
   }
   this->dataPtr->commandMsgs.clear();
 
@@ -598,12 +657,18 @@ void Camera::ReadPixelBuffer()
     size = Ogre::PixelUtil::getMemorySize(width, height, 1,
         static_cast<Ogre::PixelFormat>(this->imageFormat));
 
+    // The asynchronous readback reads the whole texture
+    if (this->dataPtr->readbackLatency > 0 &&
+        !this->dataPtr->regionApplied &&
+        this->ReadPixelBufferAsync(size))
+    {
+      return;
+    }
+
     // Allocate buffer
     if (!this->saveFrameBuffer)
       this->saveFrameBuffer = new unsigned char[size];
 
-    memset(this->saveFrameBuffer, 128, size);
-
     Ogre::PixelBox box(width, height, 1,
         static_cast<Ogre::PixelFormat>(this->imageFormat),
         this->saveFrameBuffer);
@@ -649,11 +714,300 @@ void Camera::ReadPixelBuffer()
     // There is a fix in ogre-1.8 for a buffer overrun problem in
     // OgreGLXWindow.cpp's copyContentsToMemory(). It fixes reading
     // pixels from buffer into memory.
-    this->viewport->getTarget()->copyContentsToMemory(box);
+    if (this->dataPtr->regionApplied && this->renderTexture)
+    {
+      // Only the pixels of the viewport, which would be scaled otherwise
+      this->renderTexture->getBuffer()->blitToMemory(
+          Ogre::Box(0, 0, width, height), box);
+    }
+    else
+      this->viewport->getTarget()->copyContentsToMemory(box);
 #endif
+
+    this->dataPtr->imageSimTime = this->scene->SimTime();
+    this->dataPtr->imageReady = true;
   }
 }
 
+//////////////////////////////////////////////////
+bool Camera::ReadPixelBufferAsync(const size_t _size)
+{
+#ifdef GAZEBO_CAMERA_ASYNC_READBACK
+  if (this->dataPtr->readbackUnsupported || !this->renderTexture)
+    return false;
+
+  GLenum format;
+  GLenum type;
+  switch (this->imageFormat)
+  {
+    case Ogre::PF_L8:
+      format = GL_LUMINANCE;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_L16:
+      format = GL_LUMINANCE;
+      type = GL_UNSIGNED_SHORT;
+      break;
+    case Ogre::PF_BYTE_RGB:
+      format = GL_RGB;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_BYTE_BGR:
+      format = GL_BGR;
+      type = GL_UNSIGNED_BYTE;
+      break;
+    case Ogre::PF_SHORT_RGB:
+      format = GL_RGB;
+      type = GL_UNSIGNED_SHORT;
+      break;
+    case Ogre::PF_FLOAT32_R:
+      format = GL_RED;
+      type = GL_FLOAT;
+      break;
+    default:
+      gzwarn << "Asynchronous readback is not supported for camera["
+             << this->Name() << "] with image format[" << this->ImageFormat()
+             << "], reading pixels synchronously.\n";
+      this->dataPtr->readbackUnsupported = true;
+      return false;
+  }
+
+  GLuint texId = 0;
+  this->renderTexture->getCustomAttribute("GLID", &texId);
+  if (texId == 0)
+  {
+    gzwarn << "Asynchronous readback requires the OpenGL render system, "
+           << "reading pixels synchronously for camera[" << this->Name()
+           << "].\n";
+    this->dataPtr->readbackUnsupported = true;
+    return false;
+  }
+
+  // Save the state we touch, since Ogre keeps its own copy of it.
+  GLint prevPackBuffer = 0;
+  GLint prevTexture = 0;
+  GLint prevAlignment = 0;
+  glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &prevPackBuffer);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
+  glGetIntegerv(GL_PACK_ALIGNMENT, &prevAlignment);
+
+  // (Re)create the ring when the latency or image size changes.
+  unsigned int count = this->dataPtr->readbackLatency + 1;
+  if (this->dataPtr->readbackBuffers.size() != count ||
+      this->dataPtr->readbackSize != _size)
+  {
+    this->ReleaseReadbackBuffers();
+
+    this->dataPtr->readbackBuffers.resize(count, 0);
+    this->dataPtr->readbackTimes.resize(count);
+    glGenBuffers(count, &this->dataPtr->readbackBuffers[0]);
+    for (auto const buffer : this->dataPtr->readbackBuffers)
+    {
+      glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+      glBufferData(GL_PIXEL_PACK_BUFFER, _size, nullptr, GL_STREAM_READ);
+    }
+    this->dataPtr->readbackSize = _size;
+  }
+
+  // Queue the readback of this frame. glGetTexImage returns immediately
+  // when a pixel pack buffer is bound.
+  unsigned int &index = this->dataPtr->readbackIndex;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, this->dataPtr->readbackBuffers[index]);
+  glBindTexture(GL_TEXTURE_2D, texId);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, 0, format, type, nullptr);
+  this->dataPtr->readbackTimes[index] = this->scene->SimTime();
+
+  index = (index + 1) % count;
+  this->dataPtr->readbackPending =
+      std::min(this->dataPtr->readbackPending + 1, count);
+
+  // Once the ring is full, the buffer queued next is the oldest one.
+  if (this->dataPtr->readbackPending == count)
+  {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, this->dataPtr->readbackBuffers[index]);
+    void *data = glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (data)
+    {
+      if (!this->saveFrameBuffer)
+        this->saveFrameBuffer = new unsigned char[_size];
+      memcpy(this->saveFrameBuffer, data, _size);
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+
+      this->dataPtr->imageSimTime = this->dataPtr->readbackTimes[index];
+      this->dataPtr->imageReady = true;
+    }
+    this->dataPtr->readbackPending--;
+  }
+
+  glPixelStorei(GL_PACK_ALIGNMENT, prevAlignment);
+  glBindTexture(GL_TEXTURE_2D, prevTexture);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, prevPackBuffer);
+
+  return true;
+#else
+  (void)_size;
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+void Camera::ReleaseReadbackBuffers()
+{
+#ifdef GAZEBO_CAMERA_ASYNC_READBACK
+  if (!this->dataPtr->readbackBuffers.empty())
+  {
+    glDeleteBuffers(this->dataPtr->readbackBuffers.size(),
+        &this->dataPtr->readbackBuffers[0]);
+  }
+#endif
+  this->dataPtr->readbackBuffers.clear();
+  this->dataPtr->readbackTimes.clear();
+  this->dataPtr->readbackSize = 0;
+  this->dataPtr->readbackIndex = 0;
+  this->dataPtr->readbackPending = 0;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetReadbackLatency(const unsigned int _frames)
+{
+  if (_frames > 2)
+  {
+    gzwarn << "Readback latency of " << _frames
+           << " frames is not supported, using 2.\n";
+  }
+  this->dataPtr->readbackLatency = std::min(_frames, 2u);
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::ReadbackLatency() const
+{
+  return this->dataPtr->readbackLatency;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetOcclusionCulling(const bool _enable)
+{
+  this->dataPtr->occlusionCulling = _enable;
+  if (!_enable)
+  {
+    this->dataPtr->occlusionCuller.reset();
+    return;
+  }
+
+  // The culler is created by Init() if the camera doesn't exist yet
+  if (this->dataPtr->occlusionCuller || !this->camera || !this->scene)
+    return;
+
+  this->dataPtr->occlusionCuller.reset(new OcclusionCuller(
+      this->scene->OgreSceneManager(), this->camera));
+  if (!this->dataPtr->occlusionCuller->Supported())
+  {
+    this->dataPtr->occlusionCuller.reset();
+    this->dataPtr->occlusionCulling = false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool Camera::OcclusionCulling() const
+{
+  return this->dataPtr->occlusionCulling;
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::OccludedObjectCount() const
+{
+  if (!this->dataPtr->occlusionCuller)
+    return 0;
+  return this->dataPtr->occlusionCuller->OccludedCount();
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::RenderedBatchCount() const
+{
+  if (!this->camera)
+    return 0;
+  return this->camera->_getNumRenderedBatches();
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::RenderedFaceCount() const
+{
+  if (!this->camera)
+    return 0;
+  return this->camera->_getNumRenderedFaces();
+}
+
+//////////////////////////////////////////////////
+void Camera::SetShadowsEnabled(const bool _enable)
+{
+  this->dataPtr->shadowsEnabled = _enable;
+  if (this->viewport)
+    this->viewport->setShadowsEnabled(_enable);
+}
+
+//////////////////////////////////////////////////
+bool Camera::ShadowsEnabled() const
+{
+  return this->dataPtr->shadowsEnabled;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetShadowCaching(const bool _enable)
+{
+  this->dataPtr->shadowCaching = _enable;
+  if (!_enable)
+  {
+    this->dataPtr->shadowCache.reset();
+    return;
+  }
+
+  // The cache is created by Init() if the camera doesn't exist yet
+  if (this->dataPtr->shadowCache || !this->camera || !this->scene)
+    return;
+
+  this->dataPtr->shadowCache.reset(new ShadowTextureCache(
+      this->scene->OgreSceneManager(), this->camera));
+}
+
+//////////////////////////////////////////////////
+bool Camera::ShadowCaching() const
+{
+  return this->dataPtr->shadowCaching;
+}
+
+//////////////////////////////////////////////////
+unsigned int Camera::CachedShadowSplitCount() const
+{
+  if (!this->dataPtr->shadowCache)
+    return 0;
+  return this->dataPtr->shadowCache->CachedSplitCount();
+}
+
+//////////////////////////////////////////////////
+void Camera::SetPostEffectFusion(const bool _enable)
+{
+  this->dataPtr->postEffectFusion = _enable;
+}
+
+//////////////////////////////////////////////////
+bool Camera::PostEffectFusion() const
+{
+  return this->dataPtr->postEffectFusion;
+}
+
+//////////////////////////////////////////////////
+bool Camera::ImageReady() const
+{
+  return this->dataPtr->imageReady;
+}
+
+//////////////////////////////////////////////////
+common::Time Camera::ImageSimTime() const
+{
+  return this->dataPtr->imageSimTime;
+}
+
 //////////////////////////////////////////////////
 common::Time Camera::LastRenderWallTime() const
 {
@@ -664,6 +1018,7 @@ common::Time Camera::LastRenderWallTime() const
 void Camera::PostRender()
 {
   IGN_PROFILE("rendering::Camera::PostRender");
+  this->dataPtr->imageReady = false;
   this->ReadPixelBuffer();
 
   // Only record last render time if data was actually generated
@@ -671,7 +1026,8 @@ void Camera::PostRender()
   if (this->newData)
     this->lastRenderWallTime = common::Time::GetWallTime();
 
-  if (this->newData && (this->captureData || this->captureDataOnce ||
+  if (this->newData && this->dataPtr->imageReady &&
+      (this->captureData || this->captureDataOnce ||
       this->dataPtr->videoEncoder.IsEncoding()))
   {
     unsigned int width = this->ImageWidth();
@@ -1571,7 +1927,7 @@ void Camera::SetRenderTarget(Ogre::RenderTarget *_target)
     // Setup the viewport to use the texture
     this->viewport = this->renderTarget->addViewport(this->camera);
     this->viewport->setClearEveryFrame(true);
-    this->viewport->setShadowsEnabled(true);
+    this->viewport->setShadowsEnabled(this->dataPtr->shadowsEnabled);
     this->viewport->setOverlaysEnabled(false);
 
     if (this->camera->getProjectionType() == Ogre::PT_ORTHOGRAPHIC)
@@ -1582,7 +1938,8 @@ void Camera::SetRenderTarget(Ogre::RenderTarget *_target)
     auto const &ignBG = this->scene->BackgroundColor();
     this->viewport->setBackgroundColour(Conversions::Convert(ignBG));
     this->viewport->setVisibilityMask(GZ_VISIBILITY_ALL &
-        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+          GZ_VISIBILITY_INSTANCE_SOURCE));
 
     this->UpdateFOV();
 
@@ -2011,6 +2368,9 @@ void Camera::UpdateFOV()
 {
   if (this->viewport)
   {
+    const unsigned int oldWidth = this->viewport->getActualWidth();
+    const unsigned int oldHeight = this->viewport->getActualHeight();
+
     this->viewport->setDimensions(0, 0, 1, 1);
     double ratio = static_cast<double>(this->viewport->getActualWidth()) /
       static_cast<double>(this->viewport->getActualHeight());
@@ -2027,7 +2387,117 @@ void Camera::UpdateFOV()
       this->camera->setAspectRatio(ratio);
       this->camera->setFOVy(Ogre::Radian(this->LimitFOV(vfov)));
     }
+
+    this->UpdateRenderRegion();
+
+    // The images change size
+    if (this->viewport->getActualWidth() != static_cast<int>(oldWidth) ||
+        this->viewport->getActualHeight() != static_cast<int>(oldHeight))
+    {
+      delete [] this->saveFrameBuffer;
+      this->saveFrameBuffer = nullptr;
+      delete [] this->bayerFrameBuffer;
+      this->bayerFrameBuffer = nullptr;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void Camera::UpdateRenderRegion()
+{
+  const double fullWidth = this->viewport->getActualWidth();
+  const double fullHeight = this->viewport->getActualHeight();
+  const bool fullImage = this->dataPtr->regionSize.X() <= 0 ||
+      this->dataPtr->regionSize.Y() <= 0;
+  const bool applied = this->dataPtr->regionApplied;
+  this->dataPtr->regionApplied = false;
+
+  if ((fullImage && ignition::math::equal(this->dataPtr->renderScale, 1.0)) ||
+      this->camera->getProjectionType() != Ogre::PT_PERSPECTIVE ||
+      fullWidth <= 0 || fullHeight <= 0)
+  {
+    // The projection of the full image was set by UpdateFOV
+    if (applied && !this->cameraUsingIntrinsics)
+      this->camera->setCustomProjectionMatrix(false);
+    return;
+  }
+
+  // The region, within the image
+  double x = 0, y = 0, w = fullWidth, h = fullHeight;
+  if (!fullImage)
+  {
+    x = std::min(static_cast<double>(
+        std::max(this->dataPtr->regionOffset.X(), 0)), fullWidth - 1);
+    y = std::min(static_cast<double>(
+        std::max(this->dataPtr->regionOffset.Y(), 0)), fullHeight - 1);
+    w = std::min(static_cast<double>(this->dataPtr->regionSize.X()),
+        fullWidth - x);
+    h = std::min(static_cast<double>(this->dataPtr->regionSize.Y()),
+        fullHeight - y);
+  }
+
+  // Rasterize only the top left corner of the render target, at the size
+  // of the scaled region
+  const double width =
+      std::max(1.0, std::round(w * this->dataPtr->renderScale));
+  const double height =
+      std::max(1.0, std::round(h * this->dataPtr->renderScale));
+  this->viewport->setDimensions(0, 0, (width + 0.5) / fullWidth,
+      (height + 0.5) / fullHeight);
+
+  // Map the region of the full image to the whole clip space
+  if (!this->cameraUsingIntrinsics)
+    this->camera->setCustomProjectionMatrix(false);
+  Ogre::Matrix4 proj = this->cameraUsingIntrinsics ?
+      Conversions::Convert(this->cameraProjectiveMatrix) :
+      this->camera->getProjectionMatrix();
+  Ogre::Matrix4 crop = Ogre::Matrix4::IDENTITY;
+  crop[0][0] = fullWidth / w;
+  crop[0][3] = -(2 * x + w - fullWidth) / w;
+  crop[1][1] = fullHeight / h;
+  crop[1][3] = (2 * y + h - fullHeight) / h;
+  this->camera->setCustomProjectionMatrix(true, crop * proj);
+
+  this->dataPtr->regionApplied = true;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetRenderRegion(const ignition::math::Vector2i &_offset,
+    const ignition::math::Vector2i &_size)
+{
+  this->dataPtr->regionOffset = _offset;
+  this->dataPtr->regionSize = _size;
+  this->UpdateFOV();
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector2i Camera::RenderRegionOffset() const
+{
+  return this->dataPtr->regionOffset;
+}
+
+//////////////////////////////////////////////////
+ignition::math::Vector2i Camera::RenderRegionSize() const
+{
+  return this->dataPtr->regionSize;
+}
+
+//////////////////////////////////////////////////
+void Camera::SetRenderScale(const double _scale)
+{
+  if (_scale <= 0 || _scale > 1)
+  {
+    gzerr << "Render scale[" << _scale << "] must be in (0, 1]\n";
+    return;
   }
+  this->dataPtr->renderScale = _scale;
+  this->UpdateFOV();
+}
+
+//////////////////////////////////////////////////
+double Camera::RenderScale() const
+{
+  return this->dataPtr->renderScale;
 }
 
 //////////////////////////////////////////////////
@@ -492,6 +492,145 @@ namespace gazebo
       /// \brief Capture data once and save to disk
       public: void SetCaptureDataOnce();
 
+      /// \brief Set the number of frames by which captured image data
+      /// lags behind rendering. With a latency of zero, the default, the
+      /// pixels of each frame are read back right after it is rendered,
+      /// which stalls until the GPU has finished the frame. A latency of
+      /// one or two reads back asynchronously into a ring of pixel buffer
+      /// objects, so that frame N-1 (or N-2) is delivered while frame N
+      /// renders. This only takes effect with the OpenGL render system
+      /// and 8 or 16 bit integer or 32 bit float image formats; otherwise
+      /// pixels are read back synchronously.
+      /// \param[in] _frames Number of frames of latency, at most 2.
+      /// \sa ReadbackLatency()
+      public: void SetReadbackLatency(const unsigned int _frames);
+
+      /// \brief Get the number of frames by which captured image data lags
+      /// behind rendering.
+      /// \return Number of frames of latency.
+      /// \sa SetReadbackLatency()
+      public: unsigned int ReadbackLatency() const;
+
+      /// \brief Enable or disable hardware occlusion culling. When
+      /// enabled, the bounding boxes of the entities in the view frustum
+      /// are tested against the depth buffer after each frame, and the
+      /// entities found hidden behind other geometry are skipped until a
+      /// later test finds them visible. Results are one frame late, so an
+      /// entity that comes out from behind an occluder may be missing from
+      /// one image. Disabled by default, or enabled for every camera by
+      /// setting the GAZEBO_OCCLUSION_CULLING environment variable to 1.
+      /// \param[in] _enable True to enable occlusion culling.
+      /// \sa OccludedObjectCount()
+      public: void SetOcclusionCulling(const bool _enable);
+
+      /// \brief Get whether occlusion culling is enabled.
+      /// \return True if occluded entities are skipped.
+      public: bool OcclusionCulling() const;
+
+      /// \brief Get the number of entities skipped by occlusion culling in
+      /// the last frame.
+      /// \return Number of occluded entities, 0 if culling is disabled.
+      public: unsigned int OccludedObjectCount() const;
+
+      /// \brief Get the number of batches, i.e. draw calls, of the last
+      /// frame rendered by this camera.
+      /// \return Number of batches.
+      public: unsigned int RenderedBatchCount() const;
+
+      /// \brief Get the number of faces of the last frame rendered by this
+      /// camera.
+      /// \return Number of faces.
+      public: unsigned int RenderedFaceCount() const;
+
+      /// \brief Enable or disable the shadows of this camera. A camera
+      /// without shadows doesn't render the shadow textures, which is the
+      /// cheapest shadow quality. Enabled by default, or set from SDF with
+      /// the custom element <gz:shadows>.
+      /// \param[in] _enable True to render shadows.
+      public: void SetShadowsEnabled(const bool _enable);
+
+      /// \brief Get whether this camera renders shadows.
+      /// \return True if shadows are enabled for the camera.
+      public: bool ShadowsEnabled() const;
+
+      /// \brief Enable or disable the caching of the shadow textures.
+      /// When enabled, a shadow split whose light, view and shadow casters
+      /// are unchanged since the last frame of the camera is reused
+      /// instead of rendered, so that a fixed camera in a static world
+      /// renders its shadows once. Changes of materials are not detected.
+      /// Disabled by default, or enabled for every camera by setting the
+      /// GAZEBO_SHADOW_CACHING environment variable to 1, or from SDF with
+      /// the custom element <gz:shadow_caching>.
+      /// \param[in] _enable True to cache the shadow textures.
+      /// \sa CachedShadowSplitCount()
+      public: void SetShadowCaching(const bool _enable);
+
+      /// \brief Get whether the shadow textures are cached.
+      /// \return True if unchanged shadow splits are reused.
+      public: bool ShadowCaching() const;
+
+      /// \brief Get the number of shadow splits the last frame reused
+      /// instead of rendering them.
+      /// \return Number of cached splits, 0 if caching is disabled.
+      public: unsigned int CachedShadowSplitCount() const;
+
+      /// \brief Enable or disable the fusion of post-effects. When
+      /// enabled, the Gaussian image noise of a camera with lens
+      /// distortion is added by the distortion pass, so that the two
+      /// post-effects render one full-screen quad into one intermediate
+      /// texture. Only affects the post-effects added afterwards.
+      /// Disabled by default, or enabled for every camera by setting the
+      /// GAZEBO_FUSE_POST_EFFECTS environment variable to 1, or from SDF
+      /// with the custom element <gz:fuse_post_effects>.
+      /// \param[in] _enable True to fuse post-effects.
+      public: void SetPostEffectFusion(const bool _enable);
+
+      /// \brief Get whether post-effects are fused.
+      /// \return True if post-effects are fused where possible.
+      public: bool PostEffectFusion() const;
+
+      /// \brief Render and read back only a region of the image. The
+      /// images of the camera then have the size of the region, times
+      /// the render scale, and show what the full image shows in that
+      /// region. Can also be set by CameraCmd messages on the cmd topic
+      /// of the camera.
+      /// \param[in] _offset Top left corner of the region, in pixels of
+      /// the full image.
+      /// \param[in] _size Size of the region, in pixels of the full image,
+      /// or 0 to render the full image, the default.
+      /// \sa SetRenderScale(const double)
+      public: void SetRenderRegion(const ignition::math::Vector2i &_offset,
+                  const ignition::math::Vector2i &_size);
+
+      /// \brief Get the top left corner of the rendered region.
+      /// \return Offset in pixels of the full image.
+      public: ignition::math::Vector2i RenderRegionOffset() const;
+
+      /// \brief Get the size of the rendered region.
+      /// \return Size in pixels of the full image, 0 for the full image.
+      public: ignition::math::Vector2i RenderRegionSize() const;
+
+      /// \brief Render the image, or its region, at a lower resolution.
+      /// Can also be set by CameraCmd messages on the cmd topic of the
+      /// camera.
+      /// \param[in] _scale Scale in (0, 1], 1 by default.
+      /// \sa SetRenderRegion()
+      public: void SetRenderScale(const double _scale);
+
+      /// \brief Get the scale of the rendered image.
+      /// \return Scale in (0, 1].
+      public: double RenderScale() const;
+
+      /// \brief Get whether the last call to PostRender delivered new image
+      /// data. This is false while an asynchronous readback is filling up.
+      /// \return True if ImageData() holds a new image.
+      public: bool ImageReady() const;
+
+      /// \brief Get the simulation time at which the image held by
+      /// ImageData() was rendered.
+      /// \return Simulation time of the image.
+      public: common::Time ImageSimTime() const;
+
       /// \brief Turn on video recording.
       /// \param[in] _format String that represents the video type.
       /// Supported types include: "avi", "ogv", mp4", "v4l2". If using
@@ -774,6 +913,17 @@ namespace gazebo
       /// \brief Read image data from pixel buffer
       protected: void ReadPixelBuffer();
 
+      /// \brief Queue an asynchronous readback of the render texture, and
+      /// copy the oldest finished readback into saveFrameBuffer.
+      /// \param[in] _size Size of the image in bytes.
+      /// \return False if asynchronous readback isn't supported, in which
+      /// case the caller should read pixels synchronously.
+      private: bool ReadPixelBufferAsync(const size_t _size);
+
+      /// \brief Release the pixel buffer objects used by asynchronous
+      /// readback.
+      private: void ReleaseReadbackBuffers();
+
       /// \brief Implementation of the Camera::TrackVisual call
       /// \param[in] _visualName Name of the visual to track
       /// \return True if able to track the visual
@@ -834,6 +984,10 @@ namespace gazebo
       /// \brief Update the camera's field of view.
       protected: virtual void UpdateFOV();
 
+      /// \brief Apply the render region and scale to the viewport and the
+      /// projection, once UpdateFOV set those of the full image.
+      private: void UpdateRenderRegion();
+
       /// \brief Set the clip distance based on stored SDF values
       protected: virtual void SetClipDist();
 
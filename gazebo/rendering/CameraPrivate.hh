@@ -21,11 +21,17 @@
 #include <mutex>
 #include <utility>
 #include <list>
+#include <memory>
+#include <vector>
 #include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector2.hh>
 
 #include "gazebo/common/PID.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/common/VideoEncoder.hh"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/OcclusionCuller.hh"
+#include "gazebo/rendering/ShadowTextureCache.hh"
 #include "gazebo/util/system.hh"
 
 namespace Ogre
@@ -117,6 +123,67 @@ namespace gazebo
 
       /// \brief Fixed axis to yaw around.
       public: ignition::math::Vector3d yawFixedAxis;
+
+      /// \brief Requested number of frames of readback latency.
+      public: unsigned int readbackLatency = 0;
+
+      /// \brief OpenGL pixel buffer objects used as a ring for
+      /// asynchronous readback. Holds readbackLatency + 1 buffers once in
+      /// use.
+      public: std::vector<unsigned int> readbackBuffers;
+
+      /// \brief Simulation time of the frame queued in each pixel buffer.
+      public: std::vector<common::Time> readbackTimes;
+
+      /// \brief Size in bytes of each pixel buffer object.
+      public: size_t readbackSize = 0;
+
+      /// \brief Index of the pixel buffer to queue the next readback into.
+      public: unsigned int readbackIndex = 0;
+
+      /// \brief Number of queued readbacks not yet copied out.
+      public: unsigned int readbackPending = 0;
+
+      /// \brief True once asynchronous readback has been found to be
+      /// unsupported for this camera.
+      public: bool readbackUnsupported = false;
+
+      /// \brief True if the last PostRender delivered new image data.
+      public: bool imageReady = false;
+
+      /// \brief Simulation time of the image in saveFrameBuffer.
+      public: common::Time imageSimTime;
+
+      /// \brief True if occlusion culling was requested.
+      public: bool occlusionCulling = false;
+
+      /// \brief Occlusion culler, created once the camera is initialized.
+      public: std::unique_ptr<OcclusionCuller> occlusionCuller;
+
+      /// \brief True if the camera renders shadows.
+      public: bool shadowsEnabled = true;
+
+      /// \brief True if shadow caching was requested.
+      public: bool shadowCaching = false;
+
+      /// \brief Shadow texture cache, created once the camera is
+      /// initialized.
+      public: std::unique_ptr<ShadowTextureCache> shadowCache;
+
+      /// \brief True if post-effects are fused where possible.
+      public: bool postEffectFusion = false;
+
+      /// \brief Top left corner of the rendered region.
+      public: ignition::math::Vector2i regionOffset;
+
+      /// \brief Size of the rendered region, 0 for the full image.
+      public: ignition::math::Vector2i regionSize;
+
+      /// \brief Scale of the rendered image.
+      public: double renderScale = 1.0;
+
+      /// \brief True if the viewport covers part of the render target.
+      public: bool regionApplied = false;
     };
   }
 }
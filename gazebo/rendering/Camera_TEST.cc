@@ -184,6 +184,267 @@ TEST_F(Camera_TEST, Create)
   }
 }
 
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, OcclusionCulling)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_occlusion", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>0.78</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_occlusion_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(0, 0, 0.5, 0, 0, 0));
+
+  // Off by default
+  EXPECT_FALSE(camera->OcclusionCulling());
+  EXPECT_EQ(0u, camera->OccludedObjectCount());
+
+  // A wall in front of the camera hides a small box
+  rendering::VisualPtr wall(new rendering::Visual("wall",
+      scene->WorldVisual()));
+  wall->Load();
+  wall->AttachMesh("unit_box");
+  wall->SetScale(ignition::math::Vector3d(0.1, 20, 20));
+  wall->SetPosition(ignition::math::Vector3d(2, 0, 0.5));
+  scene->AddVisual(wall);
+
+  rendering::VisualPtr box(new rendering::Visual("box",
+      scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh("unit_box");
+  box->SetPosition(ignition::math::Vector3d(5, 0, 0.5));
+  scene->AddVisual(box);
+
+  camera->SetOcclusionCulling(true);
+  if (!camera->OcclusionCulling())
+  {
+    gzwarn << "Occlusion queries are not supported, skipping test"
+           << std::endl;
+    scene->RemoveCamera(camera->Name());
+    return;
+  }
+
+  // Results are read back a frame or more after the queries
+  for (unsigned int i = 0; i < 10; ++i)
+    camera->Render(true);
+  EXPECT_GE(camera->OccludedObjectCount(), 1u);
+  EXPECT_GT(camera->RenderedBatchCount(), 0u);
+  EXPECT_GT(camera->RenderedFaceCount(), 0u);
+
+  // Nothing is occluded once the wall is gone
+  wall->SetVisible(false);
+  for (unsigned int i = 0; i < 10; ++i)
+    camera->Render(true);
+  EXPECT_EQ(0u, camera->OccludedObjectCount());
+
+  camera->SetOcclusionCulling(false);
+  EXPECT_FALSE(camera->OcclusionCulling());
+  EXPECT_EQ(0u, camera->OccludedObjectCount());
+
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, ShadowCaching)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_shadow_cache", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>0.78</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_shadow_cache_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 2, 0, 0.3, 0));
+
+  // Off by default
+  EXPECT_TRUE(camera->ShadowsEnabled());
+  EXPECT_FALSE(camera->ShadowCaching());
+  EXPECT_EQ(0u, camera->CachedShadowSplitCount());
+
+  rendering::VisualPtr box(new rendering::Visual("box",
+      scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh("unit_box");
+  box->SetPosition(ignition::math::Vector3d(0, 0, 0.5));
+  scene->AddVisual(box);
+
+  camera->SetShadowCaching(true);
+  EXPECT_TRUE(camera->ShadowCaching());
+  if (!scene->ShadowsEnabled())
+  {
+    gzwarn << "Shadows are disabled, skipping test" << std::endl;
+    scene->RemoveCamera(camera->Name());
+    return;
+  }
+
+  // Nothing changes after the first frame
+  camera->Render(true);
+  camera->Render(true);
+  EXPECT_GT(camera->CachedShadowSplitCount(), 0u);
+
+  // A moved caster renders the splits again
+  box->SetPosition(ignition::math::Vector3d(1, 0, 0.5));
+  camera->Render(true);
+  EXPECT_EQ(0u, camera->CachedShadowSplitCount());
+
+  // And so does a moved camera
+  camera->Render(true);
+  EXPECT_GT(camera->CachedShadowSplitCount(), 0u);
+  camera->SetWorldPose(ignition::math::Pose3d(-6, 0, 2, 0, 0.3, 0));
+  camera->Render(true);
+  EXPECT_EQ(0u, camera->CachedShadowSplitCount());
+
+  camera->SetShadowCaching(false);
+  EXPECT_FALSE(camera->ShadowCaching());
+  EXPECT_EQ(0u, camera->CachedShadowSplitCount());
+
+  camera->SetShadowsEnabled(false);
+  EXPECT_FALSE(camera->ShadowsEnabled());
+
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Camera_TEST, RenderRegion)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+
+  if (!scene)
+    scene = gazebo::rendering::create_scene("default", false);
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_render_region", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>0.78</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_render_region_RttTex");
+  camera->SetCaptureData(true);
+
+  // The full image by default
+  EXPECT_EQ(ignition::math::Vector2i::Zero, camera->RenderRegionSize());
+  EXPECT_DOUBLE_EQ(1.0, camera->RenderScale());
+  EXPECT_EQ(320u, camera->ImageWidth());
+  EXPECT_EQ(240u, camera->ImageHeight());
+
+  // The images have the size of the region
+  unsigned int frameWidth = 0;
+  unsigned int frameHeight = 0;
+  event::ConnectionPtr c = camera->ConnectNewImageFrame(
+      [&](const unsigned char *, unsigned int _width, unsigned int _height,
+          unsigned int, const std::string &)
+      {
+        frameWidth = _width;
+        frameHeight = _height;
+      });
+
+  camera->SetRenderRegion(ignition::math::Vector2i(80, 60),
+      ignition::math::Vector2i(160, 120));
+  EXPECT_EQ(ignition::math::Vector2i(80, 60), camera->RenderRegionOffset());
+  EXPECT_EQ(ignition::math::Vector2i(160, 120), camera->RenderRegionSize());
+  EXPECT_EQ(160u, camera->ImageWidth());
+  EXPECT_EQ(120u, camera->ImageHeight());
+  camera->Render(true);
+  camera->PostRender();
+  EXPECT_EQ(160u, frameWidth);
+  EXPECT_EQ(120u, frameHeight);
+
+  // Scaled down
+  camera->SetRenderScale(0.5);
+  EXPECT_DOUBLE_EQ(0.5, camera->RenderScale());
+  EXPECT_EQ(80u, camera->ImageWidth());
+  EXPECT_EQ(60u, camera->ImageHeight());
+  camera->Render(true);
+  camera->PostRender();
+  EXPECT_EQ(80u, frameWidth);
+  EXPECT_EQ(60u, frameHeight);
+
+  // Invalid scales are ignored
+  camera->SetRenderScale(0.0);
+  EXPECT_DOUBLE_EQ(0.5, camera->RenderScale());
+
+  // Back to the full image
+  camera->SetRenderRegion(ignition::math::Vector2i::Zero,
+      ignition::math::Vector2i::Zero);
+  camera->SetRenderScale(1.0);
+  EXPECT_EQ(320u, camera->ImageWidth());
+  EXPECT_EQ(240u, camera->ImageHeight());
+
+  c.reset();
+  scene->RemoveCamera(camera->Name());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -48,6 +48,7 @@ THE SOFTWARE.
 */
 
 #include "gazebo/rendering/CustomPSSMShadowCameraSetup.hh"
+#include "gazebo/rendering/ShadowTextureCache.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 
 using namespace gazebo;
@@ -624,6 +625,9 @@ void CustomPSSMShadowCameraSetup::getShadowCamera(const Ogre::SceneManager *_sm,
   // restore near/far
   cam->setNearClipDistance(oldNear);
   cam->setFarClipDistance(oldFar);
+
+  // Skip the rendering of the split if the camera has it already
+  ShadowTextureCache::PrepareSplit(_sm, _cam, _texCam, _iteration);
 }
 
 //////////////////////////////////////////////////
@@ -23,6 +23,7 @@
 
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/PixelConvert.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Conversions.hh"
@@ -163,6 +164,9 @@ DepthCamera::~DepthCamera()
   if (this->dataPtr->depthBuffer)
     delete [] this->dataPtr->depthBuffer;
 
+  if (this->dataPtr->compactDepthBuffer)
+    delete [] this->dataPtr->compactDepthBuffer;
+
   if (this->dataPtr->reflectanceBuffer)
     delete [] this->dataPtr->reflectanceBuffer;
 
@@ -185,6 +189,9 @@ void DepthCamera::Load(sdf::ElementPtr _sdf)
   this->dataPtr->outputReflectance =  found != std::string::npos;
   found = outputs.find("normals");
   this->dataPtr->outputNormals =  found != std::string::npos;
+
+  if (_sdf->HasElement("gz:depth_format"))
+    this->SetDepthFormat(_sdf->Get<std::string>("gz:depth_format"));
 }
 
 //////////////////////////////////////////////////
@@ -225,12 +232,32 @@ void DepthCamera::CreateDepthTexture(const std::string &_textureName)
   // Create the depth buffer
   std::string depthMaterialName = this->Name() + "_RttMat_Camera_Depth";
 
+  // The compact formats are rendered into 16 bit textures when the render
+  // system can, and are otherwise converted from floats after the readback
+  Ogre::PixelFormat depthPixelFormat = Ogre::PF_FLOAT32_R;
+  if (this->dataPtr->depthFormat != "FLOAT32")
+  {
+    Ogre::PixelFormat compactFormat =
+        this->dataPtr->depthFormat == "FLOAT16" ?
+        Ogre::PF_FLOAT16_R : Ogre::PF_L16;
+    if (Ogre::TextureManager::getSingleton().isFormatSupported(
+          Ogre::TEX_TYPE_2D, compactFormat, Ogre::TU_RENDERTARGET))
+    {
+      depthPixelFormat = compactFormat;
+    }
+    else
+    {
+      gzwarn << "Unable to render depth format[" << this->dataPtr->depthFormat
+             << "], converting from floats instead\n";
+    }
+  }
+
   this->depthTexture = Ogre::TextureManager::getSingleton().createManual(
       _textureName,
       Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
       Ogre::TEX_TYPE_2D,
       this->ImageWidth(), this->ImageHeight(), 0,
-      Ogre::PF_FLOAT32_R,
+      depthPixelFormat,
       Ogre::TU_RENDERTARGET).getPointer();
 
   this->depthTarget = this->depthTexture->getBuffer()->getRenderTarget();
@@ -283,7 +310,8 @@ void DepthCamera::CreateDepthTexture(const std::string &_textureName)
         Conversions::Convert(ignBG));
     this->dataPtr->pcdViewport->setOverlaysEnabled(false);
     this->dataPtr->pcdViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
 
     this->dataPtr->pcdMaterial = (Ogre::Material*)(
     Ogre::MaterialManager::getSingleton().getByName("Gazebo/XYZPoints").get());
@@ -342,7 +370,8 @@ void DepthCamera::CreateReflectanceTexture(const std::string &_textureName)
     this->dataPtr->reflectanceViewport->setSkiesEnabled(false);
     this->dataPtr->reflectanceViewport->setShadowsEnabled(false);
     this->dataPtr->reflectanceViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
 
     this->dataPtr->reflectanceMaterialSwitcher.reset(
         new ReflectanceMaterialSwitcher(this->scene,
@@ -379,7 +408,8 @@ void DepthCamera::CreateNormalsTexture(const std::string &_textureName)
         Conversions::Convert(ignBG));
     this->dataPtr->normalsViewport->setOverlaysEnabled(false);
     this->dataPtr->normalsViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
 
     this->dataPtr->normalsMaterial = (Ogre::Material*)(
     Ogre::MaterialManager::getSingleton().getByName("Gazebo/XYZNormals").get());
@@ -394,9 +424,10 @@ void DepthCamera::CreateNormalsTexture(const std::string &_textureName)
 //////////////////////////////////////////////////
 void DepthCamera::PostRender()
 {
-  this->depthTarget->swapBuffers();
   if (this->dataPtr->outputPoints)
     this->dataPtr->pcdTarget->swapBuffers();
+  else
+    this->depthTarget->swapBuffers();
   if (this->dataPtr->outputReflectance)
     this->dataPtr->reflectanceTarget->swapBuffers();
   if (this->dataPtr->outputNormals)
@@ -413,23 +444,63 @@ void DepthCamera::PostRender()
 
       // Get access to the buffer and make an image and write it to file
       pixelBuffer = this->depthTexture->getBuffer();
+      Ogre::PixelFormat format = this->depthTexture->getFormat();
+      const std::string &depthFormat = this->dataPtr->depthFormat;
 
-      size_t size = Ogre::PixelUtil::getMemorySize(width, height, 1,
-          Ogre::PF_FLOAT32_R);
+      if (format == Ogre::PF_FLOAT32_R)
+      {
+        size_t size = Ogre::PixelUtil::getMemorySize(width, height, 1,
+            Ogre::PF_FLOAT32_R);
 
-      // Blit the depth buffer if needed
-      if (!this->dataPtr->depthBuffer)
-        this->dataPtr->depthBuffer = new float[size];
+        // Blit the depth buffer if needed
+        if (!this->dataPtr->depthBuffer)
+          this->dataPtr->depthBuffer = new float[size];
 
-      Ogre::PixelBox dstBox(width, height,
-          1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
+        Ogre::PixelBox dstBox(width, height,
+            1, Ogre::PF_FLOAT32_R, this->dataPtr->depthBuffer);
 
-      pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
-      pixelBuffer->blitToMemory(dstBox);
-      pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
+        pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+        pixelBuffer->blitToMemory(dstBox);
+        pixelBuffer->unlock();  // FIXME: do we need to lock/unlock still?
+      }
 
-      this->dataPtr->newDepthFrame(
-          this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+      if (depthFormat == "FLOAT32")
+      {
+        this->dataPtr->newDepthFrame(
+            this->dataPtr->depthBuffer, width, height, 1, "FLOAT32");
+      }
+      else
+      {
+        if (!this->dataPtr->compactDepthBuffer)
+          this->dataPtr->compactDepthBuffer = new uint16_t[width * height];
+
+        if (format != Ogre::PF_FLOAT32_R)
+        {
+          // The pass gave the final values, so the readback is a copy
+          Ogre::PixelBox dstBox(width, height,
+              1, format, this->dataPtr->compactDepthBuffer);
+
+          pixelBuffer->lock(Ogre::HardwarePixelBuffer::HBL_NORMAL);
+          pixelBuffer->blitToMemory(dstBox);
+          pixelBuffer->unlock();
+        }
+        else if (depthFormat == "L_INT16")
+        {
+          common::DepthToUInt16(this->dataPtr->depthBuffer,
+              this->dataPtr->compactDepthBuffer, width * height, 1000.0f);
+        }
+        else
+        {
+          for (unsigned int i = 0; i < width * height; ++i)
+          {
+            this->dataPtr->compactDepthBuffer[i] =
+                common::FloatToHalf(this->dataPtr->depthBuffer[i]);
+          }
+        }
+
+        this->dataPtr->newCompactDepthFrame(
+            this->dataPtr->compactDepthBuffer, width, height, 1, depthFormat);
+      }
     }
     else
     {
@@ -442,8 +513,7 @@ void DepthCamera::PostRender()
       if (!this->dataPtr->pcdBuffer)
         this->dataPtr->pcdBuffer = new float[width * height * 4];
 
-      memset(this->dataPtr->pcdBuffer, 0, width * height * 4);
-
+      // The blit writes every pixel, so the buffer isn't cleared first.
       Ogre::Box pcd_src_box(0, 0, width, height);
       Ogre::PixelBox pcd_dst_box(width, height,
           1, Ogre::PF_FLOAT32_RGBA, this->dataPtr->pcdBuffer);
@@ -535,12 +605,28 @@ void DepthCamera::UpdateRenderTarget(Ogre::RenderTarget *_target,
   vp = _target->getViewport(0);
 
   // return farClip in case no renderable object is inside frustrum
-  if (_target == this->dataPtr->normalsTarget)
+  if (_target == this->dataPtr->normalsTarget ||
+      (_target == this->depthTarget &&
+       this->dataPtr->depthFormat == "L_INT16"))
+  {
+    // Millimeter depths mark the pixels that hit nothing with 0
     vp->setBackgroundColour(Ogre::ColourValue(0, 0, 0));
+  }
   else
     vp->setBackgroundColour(Ogre::ColourValue(this->FarClip(),
         this->FarClip(), this->FarClip()));
 
+  // A 16 bit integer texture stores [0, 1], so the depth pass scales
+  // meters to millimeters over 65535
+  if (_target == this->depthTarget && pass->hasFragmentProgram())
+  {
+    float depthScale = 1.0f;
+    if (this->depthTexture->getFormat() == Ogre::PF_L16)
+      depthScale = 1000.0f / 65535.0f;
+    pass->getFragmentProgramParameters()->setNamedConstant(
+        "depthScale", depthScale);
+  }
+
   Ogre::CompositorManager::getSingleton().setCompositorEnabled(
                                                 vp, _matName, true);
 
@@ -607,11 +693,16 @@ void DepthCamera::RenderImpl()
   sceneMgr->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
   sceneMgr->_suppressRenderStateChanges(true);
 
-  this->UpdateRenderTarget(this->depthTarget,
-                  this->dataPtr->depthMaterial, "Gazebo/DepthMap");
+  // The depth image is not read back when generating point clouds, since
+  // the point cloud pass gives the depth of each pixel as well.
+  if (!this->dataPtr->outputPoints)
+  {
+    this->UpdateRenderTarget(this->depthTarget,
+                    this->dataPtr->depthMaterial, "Gazebo/DepthMap");
 
-  // Does actual rendering
-  this->depthTarget->update(false);
+    // Does actual rendering
+    this->depthTarget->update(false);
+  }
 
   sceneMgr->_suppressRenderStateChanges(false);
   sceneMgr->setShadowTechnique(shadowTech);
@@ -659,6 +750,44 @@ const float* DepthCamera::DepthData() const
   return this->dataPtr->depthBuffer;
 }
 
+//////////////////////////////////////////////////
+const uint16_t *DepthCamera::CompactDepthData() const
+{
+  return this->dataPtr->compactDepthBuffer;
+}
+
+//////////////////////////////////////////////////
+bool DepthCamera::SetDepthFormat(const std::string &_format)
+{
+  if (_format != "FLOAT32" && _format != "FLOAT16" && _format != "L_INT16")
+  {
+    gzerr << "Unknown depth format[" << _format << "]\n";
+    return false;
+  }
+
+  if (this->depthTexture)
+  {
+    gzerr << "The depth format must be set before the depth texture is "
+          << "created\n";
+    return false;
+  }
+
+  this->dataPtr->depthFormat = _format;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string DepthCamera::DepthFormat() const
+{
+  return this->dataPtr->depthFormat;
+}
+
+//////////////////////////////////////////////////
+const float *DepthCamera::PointCloudData() const
+{
+  return this->dataPtr->pcdBuffer;
+}
+
 //////////////////////////////////////////////////
 void DepthCamera::SetDepthTarget(Ogre::RenderTarget *_target)
 {
@@ -672,7 +801,8 @@ void DepthCamera::SetDepthTarget(Ogre::RenderTarget *_target)
     auto const &ignBG = this->scene->BackgroundColor();
     this->depthViewport->setBackgroundColour(Conversions::Convert(ignBG));
     this->depthViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
 
     double ratio = static_cast<double>(this->depthViewport->getActualWidth()) /
                    static_cast<double>(this->depthViewport->getActualHeight());
@@ -693,6 +823,14 @@ event::ConnectionPtr DepthCamera::ConnectNewDepthFrame(
   return this->dataPtr->newDepthFrame.Connect(_subscriber);
 }
 
+//////////////////////////////////////////////////
+event::ConnectionPtr DepthCamera::ConnectNewCompactDepthFrame(
+    std::function<void (const uint16_t *, unsigned int, unsigned int,
+    unsigned int, const std::string &)>  _subscriber)
+{
+  return this->dataPtr->newCompactDepthFrame.Connect(_subscriber);
+}
+
 //////////////////////////////////////////////////
 event::ConnectionPtr DepthCamera::ConnectNewRGBPointCloud(
     std::function<void (const float *, unsigned int, unsigned int, unsigned int,
@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_RENDERING_DEPTHCAMERA_HH_
 #define _GAZEBO_RENDERING_DEPTHCAMERA_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -92,6 +93,34 @@ namespace gazebo
       /// \return The z-buffer as a float array
       public: virtual const float *DepthData() const;
 
+      /// \brief Get the last depth image of the compact depth formats, see
+      /// SetDepthFormat.
+      /// \return One half float or one integer number of millimeters per
+      /// pixel, or nullptr if the format is FLOAT32 or no depth image was
+      /// generated yet.
+      public: const uint16_t *CompactDepthData() const;
+
+      /// \brief Set the format of the depth image. Must be called before
+      /// CreateDepthTexture.
+      /// "FLOAT32", the default, gives floats in meters, see DepthData.
+      /// "FLOAT16" gives half floats in meters and "L_INT16" gives
+      /// millimeters, rounded and clamped to 65535, with 0 where nothing
+      /// was hit. Both are rendered into a 16 bit texture when the render
+      /// system supports it, and are read with CompactDepthData.
+      /// \param[in] _format Name of the depth format.
+      /// \return False if the format is unknown or the depth texture
+      /// already exists.
+      public: bool SetDepthFormat(const std::string &_format);
+
+      /// \brief Get the format of the depth image, see SetDepthFormat.
+      /// \return Name of the depth format.
+      public: std::string DepthFormat() const;
+
+      /// \brief Get the last rgb point cloud, see ConnectNewRGBPointCloud.
+      /// \return Four floats per pixel, or nullptr if no point cloud was
+      /// generated yet.
+      public: const float *PointCloudData() const;
+
       /// \brief Set the render target, which renders the depth data
       /// \param[in] _target Pointer to the render target
       public: virtual void SetDepthTarget(Ogre::RenderTarget *_target);
@@ -103,7 +132,22 @@ namespace gazebo
           std::function<void (const float *, unsigned int, unsigned int,
           unsigned int, const std::string &)>  _subscriber);
 
-      /// \brief Connect a to the new rgb point cloud signal
+      /// \brief Connect to the new depth image signal of the compact depth
+      /// formats, see SetDepthFormat. The name of the format is given to
+      /// the subscriber.
+      /// \param[in] _subscriber Subscriber callback function
+      /// \return Pointer to the new Connection. This must be kept in scope
+      public: event::ConnectionPtr ConnectNewCompactDepthFrame(
+          std::function<void (const uint16_t *, unsigned int, unsigned int,
+          unsigned int, const std::string &)>  _subscriber);
+
+      /// \brief Connect a to the new rgb point cloud signal. The cloud is
+      /// only generated when the "points" output is enabled, and is then
+      /// computed in a single render pass instead of the depth image.
+      /// The buffer is organized like the image, with four floats per
+      /// pixel: X, Y and Z in the camera frame, and the color packed as
+      /// r * 65536 + g * 256 + b. The pointer given to the subscriber is
+      /// the camera's own buffer, which is valid until the next frame.
       /// \param[in] _subscriber Subscriber callback function
       /// \return Pointer to the new Connection. This must be kept in scope
       public: event::ConnectionPtr ConnectNewRGBPointCloud(
@@ -139,7 +183,7 @@ namespace gazebo
                                        const std::string &_matName);
 
       /// \brief Pointer to the depth texture
-      protected: Ogre::Texture *depthTexture;
+      protected: Ogre::Texture *depthTexture = nullptr;
 
       /// \brief Pointer to the depth target
       protected: Ogre::RenderTarget *depthTarget = nullptr;
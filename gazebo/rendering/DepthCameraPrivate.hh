@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_RENDERING_DEPTHCAMERA_PRIVATE_HH_
 #define _GAZEBO_RENDERING_DEPTHCAMERA_PRIVATE_HH_
 
+#include <cstdint>
 #include <string>
 
 #include "gazebo/common/Event.hh"
@@ -57,6 +58,12 @@ namespace gazebo
       /// \brief The depth buffer
       public: float *depthBuffer = nullptr;
 
+      /// \brief The depth buffer of the compact depth formats
+      public: uint16_t *compactDepthBuffer = nullptr;
+
+      /// \brief Format of the depth image, see DepthCamera::SetDepthFormat
+      public: std::string depthFormat = "FLOAT32";
+
       /// \brief The depth material
       public: Ogre::Material *depthMaterial = nullptr;
 
@@ -125,6 +132,10 @@ namespace gazebo
       public: event::EventT<void(const float *, unsigned int, unsigned int,
                    unsigned int, const std::string &)> newDepthFrame;
 
+      /// \brief Event used to signal depth data of the compact formats
+      public: event::EventT<void(const uint16_t *, unsigned int, unsigned int,
+                   unsigned int, const std::string &)> newCompactDepthFrame;
+
       /// \brief Event used to signal reflectance data
       public: event::EventT<void(const float *, unsigned int, unsigned int,
                   unsigned int, const std::string &)> newReflectanceFrame;
@@ -17,6 +17,7 @@
 #include <sdf/sdf.hh>
 
 #include <ignition/math/Helpers.hh>
+#include <ignition/math/Rand.hh>
 
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Camera.hh"
@@ -58,7 +59,7 @@ namespace gazebo
       public: bool distortionCrop = true;
 
       /// \brief Lens distortion compositor
-      public: Ogre::CompositorInstance *lensDistortionInstance;
+      public: Ogre::CompositorInstance *lensDistortionInstance = nullptr;
 
       /// \brief Ogre Material that contains the distortion shader
       public: Ogre::MaterialPtr distortionMaterial;
@@ -75,6 +76,15 @@ namespace gazebo
       /// \brief Height of distortion texture map
       public: unsigned int distortionTexHeight;
 
+      /// \brief True if Gaussian noise is added by the distortion pass.
+      public: bool noise = false;
+
+      /// \brief Mean of the Gaussian noise.
+      public: double noiseMean = 0;
+
+      /// \brief Standard deviation of the Gaussian noise.
+      public: double noiseStdDev = 0;
+
       // \brief Set scale parameter in shader before rendering frame
       public:
       virtual void notifyMaterialRender(Ogre::uint32 _passId,
@@ -87,6 +97,20 @@ namespace gazebo
         params->setNamedConstant("scale",
             Ogre::Vector3(1.0/distortionScale.X(),
             1.0/distortionScale.Y(), 1.0));
+
+        // Same parameters as the noise compositor, see
+        // ImageGaussianNoiseModel
+        if (this->noise)
+        {
+          params->setNamedConstant("offsets", Ogre::Vector3(
+              ignition::math::Rand::DblUniform(0.0, 1.0),
+              ignition::math::Rand::DblUniform(0.0, 1.0),
+              ignition::math::Rand::DblUniform(0.0, 1.0)));
+          params->setNamedConstant("mean",
+              static_cast<Ogre::Real>(this->noiseMean));
+          params->setNamedConstant("stddev",
+              static_cast<Ogre::Real>(this->noiseStdDev));
+        }
       }
     };
   }
@@ -343,6 +367,51 @@ void Distortion::SetCamera(CameraPtr _camera)
   this->dataPtr->lensDistortionInstance->addListener(this->dataPtr.get());
 }
 
+//////////////////////////////////////////////////
+bool Distortion::SetNoise(const double _mean, const double _stdDev)
+{
+  if (!this->dataPtr->lensDistortionInstance ||
+      this->dataPtr->distortionMaterial.isNull())
+  {
+    return false;
+  }
+
+  this->dataPtr->noiseMean = _mean;
+  this->dataPtr->noiseStdDev = _stdDev;
+  if (this->dataPtr->noise)
+    return true;
+
+  Ogre::Pass *pass =
+      this->dataPtr->distortionMaterial->getTechnique(0)->getPass(0);
+  try
+  {
+    pass->setFragmentProgram("Gazebo/CameraDistortionMapNoiseFS");
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to add noise to the distortion pass: "
+           << _e.getDescription() << std::endl;
+    pass->setFragmentProgram("Gazebo/CameraDistortionMapFS");
+    return false;
+  }
+  this->dataPtr->noise = true;
+
+  // The compositor copies the material when it's compiled, which happens
+  // again once it's enabled
+  this->dataPtr->lensDistortionInstance->setEnabled(false);
+  this->dataPtr->lensDistortionInstance->getTechnique()->
+      getOutputTargetPass()->getPass(0)->setMaterial(
+      this->dataPtr->distortionMaterial);
+  this->dataPtr->lensDistortionInstance->setEnabled(true);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Distortion::Noise() const
+{
+  return this->dataPtr->noise;
+}
+
 //////////////////////////////////////////////////
 void Distortion::CalculateAndApplyDistortionScale()
 {
@@ -53,6 +53,21 @@ namespace gazebo
       /// \param[in] _camera Camera to be distorted
       public: void SetCamera(CameraPtr _camera);
 
+      /// \brief Add Gaussian noise to the distorted image in the same
+      /// full-screen pass, instead of a separate noise compositor. Must be
+      /// called after SetCamera.
+      /// \param[in] _mean Mean of the noise.
+      /// \param[in] _stdDev Standard deviation of the noise.
+      /// \return False if the camera isn't distorted, in which case the
+      /// noise needs a pass of its own.
+      /// \sa Noise()
+      public: bool SetNoise(const double _mean, const double _stdDev);
+
+      /// \brief Get whether the distortion pass adds Gaussian noise.
+      /// \return True if noise was fused with the distortion.
+      /// \sa SetNoise(const double, const double)
+      public: bool Noise() const;
+
       /// \brief Set whether to crop the black border around the distorted
       /// image points.
       /// \param[in] _crop True to crop the black border
@@ -116,6 +116,38 @@ TEST_F(Distortion_TEST, DistortionModelBasics)
   EXPECT_DOUBLE_EQ(distortion.Center().Y(), 0.5);
 }
 
+/////////////////////////////////////////////////
+TEST_F(Distortion_TEST, NoiseFusion)
+{
+  Load("worlds/empty.world");
+
+  rendering::ScenePtr scene = rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Noise can't be fused without a distortion pass
+  rendering::Distortion undistorted;
+  undistorted.Load(CreateDistortionSDFElement(0, 0, 0, 0, 0, 0.5, 0.5));
+  EXPECT_FALSE(undistorted.SetNoise(0.0, 0.01));
+  EXPECT_FALSE(undistorted.Noise());
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_noise_fusion", false);
+  ASSERT_TRUE(camera != nullptr);
+  camera->Load(CreateDistortionSDFElement(
+      -0.1, -0.05, -0.01, 0, 0, 0.5, 0.5)->GetParent());
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_noise_fusion_RttTex");
+
+  rendering::DistortionPtr distortion = camera->LensDistortion();
+  ASSERT_TRUE(distortion != nullptr);
+  EXPECT_FALSE(distortion->Noise());
+  EXPECT_TRUE(distortion->SetNoise(0.0, 0.01));
+  EXPECT_TRUE(distortion->Noise());
+  camera->Render(true);
+
+  scene->RemoveCamera(camera->Name());
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -16,6 +16,7 @@
 */
 #include <math.h>
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <ignition/common/Profiler.hh>
@@ -37,6 +38,18 @@ class gazebo::rendering::DynamicLinesPrivate
 {
   /// \brief list of colors at each point
   public: std::vector<ignition::math::Color> colors;
+
+  /// \brief True if the whole hardware buffer must be filled again,
+  /// because points were added or removed.
+  public: bool rebuild = true;
+
+  /// \brief First point changed by SetPoint or SetColor since the last
+  /// update.
+  public: unsigned int dirtyBegin = 0;
+
+  /// \brief One past the last point changed by SetPoint or SetColor since
+  /// the last update.
+  public: unsigned int dirtyEnd = 0;
 };
 
 /////////////////////////////////////////////////
@@ -72,6 +85,7 @@ void DynamicLines::AddPoint(const ignition::math::Vector3d &_pt,
 {
   this->points.push_back(_pt);
   this->dataPtr->colors.push_back(_color);
+  this->dataPtr->rebuild = true;
   this->dirty = true;
 }
 
@@ -95,14 +109,37 @@ void DynamicLines::SetPoint(const unsigned int _index,
 
   this->points[_index] = _value;
 
-  this->dirty = true;
+  this->MarkDirty(_index);
 }
 
 /////////////////////////////////////////////////
 void DynamicLines::SetColor(const unsigned int _index,
                             const ignition::math::Color &_color)
 {
+  if (_index >= this->dataPtr->colors.size())
+  {
+    gzerr << "Point index[" << _index << "] is out of bounds[0-"
+           << this->dataPtr->colors.size()-1 << "]\n";
+    return;
+  }
+
   this->dataPtr->colors[_index] = _color;
+  this->MarkDirty(_index);
+}
+
+/////////////////////////////////////////////////
+void DynamicLines::MarkDirty(const unsigned int _index)
+{
+  if (this->dataPtr->dirtyBegin >= this->dataPtr->dirtyEnd)
+  {
+    this->dataPtr->dirtyBegin = _index;
+    this->dataPtr->dirtyEnd = _index + 1;
+  }
+  else
+  {
+    this->dataPtr->dirtyBegin = std::min(this->dataPtr->dirtyBegin, _index);
+    this->dataPtr->dirtyEnd = std::max(this->dataPtr->dirtyEnd, _index + 1);
+  }
   this->dirty = true;
 }
 
@@ -133,6 +170,8 @@ unsigned int DynamicLines::GetPointCount() const
 void DynamicLines::Clear()
 {
   this->points.clear();
+  this->dataPtr->colors.clear();
+  this->dataPtr->rebuild = true;
   this->dirty = true;
 }
 
@@ -157,6 +196,16 @@ void DynamicLines::CreateVertexDeclaration()
 /////////////////////////////////////////////////
 void DynamicLines::FillHardwareBuffers()
 {
+  // Only write the changed points when no point was added or removed
+  // since the buffers were filled.
+  if (!this->dataPtr->rebuild &&
+      this->points.size() == this->mRenderOp.vertexData->vertexCount)
+  {
+    this->FillHardwareBufferRange(this->dataPtr->dirtyBegin,
+        this->dataPtr->dirtyEnd);
+    return;
+  }
+
   int size = this->points.size();
   this->PrepareHardwareBuffers(size, 0);
 
@@ -202,5 +251,59 @@ void DynamicLines::FillHardwareBuffers()
   // of scope based on old mBox
   this->getParentSceneNode()->needUpdate();
 
+  this->dataPtr->rebuild = false;
+  this->dataPtr->dirtyBegin = 0;
+  this->dataPtr->dirtyEnd = 0;
+  this->dirty = false;
+}
+
+/////////////////////////////////////////////////
+void DynamicLines::FillHardwareBufferRange(const unsigned int _begin,
+    const unsigned int _end)
+{
+  const unsigned int end = std::min(_end,
+      static_cast<unsigned int>(this->points.size()));
+
+  if (_begin < end)
+  {
+    const size_t count = end - _begin;
+
+    Ogre::HardwareVertexBufferSharedPtr vbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(0);
+
+    Ogre::Real *prPos = static_cast<Ogre::Real*>(vbuf->lock(
+          _begin * vbuf->getVertexSize(), count * vbuf->getVertexSize(),
+          Ogre::HardwareBuffer::HBL_NORMAL));
+    for (unsigned int i = _begin; i < end; ++i)
+    {
+      *prPos++ = this->points[i].X();
+      *prPos++ = this->points[i].Y();
+      *prPos++ = this->points[i].Z();
+
+      this->mBox.merge(Conversions::Convert(this->points[i]));
+    }
+    vbuf->unlock();
+
+    Ogre::HardwareVertexBufferSharedPtr cbuf =
+      this->mRenderOp.vertexData->vertexBufferBinding->getBuffer(1);
+
+    Ogre::RGBA *colorArrayBuffer = static_cast<Ogre::RGBA*>(cbuf->lock(
+          _begin * cbuf->getVertexSize(), count * cbuf->getVertexSize(),
+          Ogre::HardwareBuffer::HBL_NORMAL));
+    Ogre::RenderSystem *renderSystemForVertex =
+          Ogre::Root::getSingleton().getRenderSystem();
+    for (unsigned int i = _begin; i < end; ++i)
+    {
+      Ogre::ColourValue color = Conversions::Convert(this->dataPtr->colors[i]);
+      renderSystemForVertex->convertColourValue(color,
+          &colorArrayBuffer[i - _begin]);
+    }
+    cbuf->unlock();
+
+    this->getParentSceneNode()->needUpdate();
+  }
+
+  this->dataPtr->dirtyBegin = 0;
+  this->dataPtr->dirtyEnd = 0;
   this->dirty = false;
 }
@@ -100,6 +100,8 @@ namespace gazebo
       public: void Clear();
 
       /// \brief Call this to update the hardware buffer after making changes.
+      /// If points were only changed by SetPoint and SetColor, only the
+      /// range of changed points is written.
       public: void Update();
 
       /// \brief Implementation DynamicRenderable,
@@ -110,6 +112,17 @@ namespace gazebo
       /// list out to hardware memory
       private: virtual void FillHardwareBuffers();
 
+      /// \brief Push a range of the point list out to hardware memory,
+      /// without reallocating the buffers.
+      /// \param[in] _begin Index of the first point to write.
+      /// \param[in] _end One past the index of the last point to write.
+      private: void FillHardwareBufferRange(const unsigned int _begin,
+                                            const unsigned int _end);
+
+      /// \brief Add a point to the range written by the next update.
+      /// \param[in] _index Index of the changed point.
+      private: void MarkDirty(const unsigned int _index);
+
       /// \brief List of points for the line
       private: std::vector<ignition::math::Vector3d> points;
 
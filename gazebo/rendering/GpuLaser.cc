@@ -15,6 +15,8 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 #include <ignition/common/Profiler.hh>
@@ -244,32 +246,32 @@ void GpuLaser::PostRender()
     // Get access to the buffer and make an image and write it to file
     pixelBuffer = this->dataPtr->secondPassTexture->getBuffer();
 
-    size_t size = Ogre::PixelUtil::getMemorySize(
-                    width, height, 1, Ogre::PF_FLOAT32_RGB);
-
-    // Blit the depth buffer if needed
+    // The second pass packs one range and intensity per ray, so it is
+    // read back as is, without clearing the buffer first.
     if (!this->dataPtr->laserBuffer)
-      this->dataPtr->laserBuffer = new float[size];
-
-    memset(this->dataPtr->laserBuffer, 255, size);
+      this->dataPtr->laserBuffer = new float[width * height * 3];
 
     Ogre::PixelBox dstBox(width, height,
         1, Ogre::PF_FLOAT32_RGB, this->dataPtr->laserBuffer);
 
     pixelBuffer->blitToMemory(dstBox);
 
-    if (!this->dataPtr->laserScan)
+    // Only copy the scan out for listeners of the new laser frame event.
+    if (this->dataPtr->newLaserFrame.ConnectionCount() > 0)
     {
-      int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
-      this->dataPtr->laserScan = new float[len];
-    }
+      if (!this->dataPtr->laserScan)
+      {
+        int len = this->dataPtr->w2nd * this->dataPtr->h2nd * 3;
+        this->dataPtr->laserScan = new float[len];
+      }
 
-    memcpy(this->dataPtr->laserScan, this->dataPtr->laserBuffer,
-           this->dataPtr->w2nd * this->dataPtr->h2nd * 3 *
-           sizeof(this->dataPtr->laserScan[0]));
+      memcpy(this->dataPtr->laserScan, this->dataPtr->laserBuffer,
+             this->dataPtr->w2nd * this->dataPtr->h2nd * 3 *
+             sizeof(this->dataPtr->laserScan[0]));
 
-    this->dataPtr->newLaserFrame(this->dataPtr->laserScan, this->dataPtr->w2nd,
-        this->dataPtr->h2nd, 3, "BLABLA");
+      this->dataPtr->newLaserFrame(this->dataPtr->laserScan,
+          this->dataPtr->w2nd, this->dataPtr->h2nd, 3, "BLABLA");
+    }
   }
 
   this->newData = false;
@@ -423,6 +425,11 @@ void GpuLaser::RenderImpl()
   sceneMgr->_suppressRenderStateChanges(true);
   sceneMgr->addRenderObjectListener(this);
 
+  // The textures of the sectors that a rotating scan swept
+  bool sectors[3] = {true, true, true};
+  this->UpdateScanSectors(sectors);
+
+  this->dataPtr->renderedTextureCount = 0;
   for (unsigned int i = 0; i < this->dataPtr->textureCount; ++i)
   {
     if (this->dataPtr->textureCount > 1)
@@ -432,6 +439,10 @@ void GpuLaser::RenderImpl()
       this->sceneNode->roll(Ogre::Radian(this->dataPtr->cameraYaws[i]));
     }
 
+    if (!sectors[i])
+      continue;
+    ++this->dataPtr->renderedTextureCount;
+
     this->dataPtr->currentMat = this->dataPtr->matFirstPass;
     this->dataPtr->currentTarget = this->dataPtr->firstPassTargets[i];
 
@@ -462,6 +473,51 @@ void GpuLaser::RenderImpl()
   this->dataPtr->lastRenderDuration = firstPassDur + secondPassDur;
 }
 
+//////////////////////////////////////////////////
+void GpuLaser::UpdateScanSectors(bool _sectors[3])
+{
+  const unsigned int count =
+      std::min(this->dataPtr->textureCount, 3u);
+  if (this->dataPtr->scanRate <= 0 || count == 0)
+    return;
+
+  const common::Time simTime = this->scene->SimTime();
+  const double sectorFov = this->hfov;
+  const double fov = sectorFov * count;
+
+  // Everything is rendered by the first update, and after time went back
+  if (!this->dataPtr->scanStarted || simTime < this->dataPtr->scanTime ||
+      sectorFov <= 0)
+  {
+    this->dataPtr->scanStarted = true;
+    this->dataPtr->scanTime = simTime;
+    this->dataPtr->scanAngle = 0;
+    return;
+  }
+
+  const double swept = (simTime - this->dataPtr->scanTime).Double() *
+      this->dataPtr->scanRate * fov;
+  this->dataPtr->scanTime = simTime;
+  if (swept >= fov)
+    return;
+
+  // The sectors from the one of the previous angle to the one of the new
+  // angle, the latter excluded if the sweep stops at its start
+  const double end = this->dataPtr->scanAngle + swept;
+  const unsigned int first =
+      static_cast<unsigned int>(this->dataPtr->scanAngle / sectorFov);
+  unsigned int last = static_cast<unsigned int>(end / sectorFov);
+  if (last > first && ignition::math::equal(end, last * sectorFov))
+    --last;
+
+  for (unsigned int i = 0; i < count; ++i)
+    _sectors[i] = false;
+  for (unsigned int i = first; i <= last; ++i)
+    _sectors[i % count] = true;
+
+  this->dataPtr->scanAngle = std::fmod(end, fov);
+}
+
 //////////////////////////////////////////////////
 GpuLaser::DataIter GpuLaser::LaserDataBegin() const
 {
@@ -560,7 +616,8 @@ void GpuLaser::Set1stPassTarget(Ogre::RenderTarget *_target,
     this->dataPtr->firstPassViewports[_index]->setBackgroundColour(
         Ogre::ColourValue(this->farClip, 0.0, 1.0));
     this->dataPtr->firstPassViewports[_index]->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
   }
 
   if (_index == 0)
@@ -587,7 +644,8 @@ void GpuLaser::Set2ndPassTarget(Ogre::RenderTarget *_target)
     this->dataPtr->secondPassViewport->setBackgroundColour(
         Ogre::ColourValue(0.0, 1.0, 0.0));
     this->dataPtr->secondPassViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+        GZ_VISIBILITY_INSTANCED));
   }
   Ogre::Matrix4 p = this->BuildScaledOrthoMatrix(
       0, static_cast<float>(this->dataPtr->w2nd / 10.0),
@@ -888,6 +946,25 @@ void GpuLaser::SetRayCountRatio(const double _rayCountRatio)
   this->rayCountRatio = _rayCountRatio;
 }
 
+//////////////////////////////////////////////////
+void GpuLaser::SetScanRate(const double _rate)
+{
+  this->dataPtr->scanRate = std::max(_rate, 0.0);
+  this->dataPtr->scanStarted = false;
+}
+
+//////////////////////////////////////////////////
+double GpuLaser::ScanRate() const
+{
+  return this->dataPtr->scanRate;
+}
+
+//////////////////////////////////////////////////
+unsigned int GpuLaser::RenderedTextureCount() const
+{
+  return this->dataPtr->renderedTextureCount;
+}
+
 //////////////////////////////////////////////////
 event::ConnectionPtr GpuLaser::ConnectNewLaserFrame(
     std::function<void (const float *_frame, unsigned int _width,
@@ -207,6 +207,28 @@ namespace gazebo
       /// \param[in] _rayCountRatio ray count ratio (equivalent to aspect ratio)
       public: void SetRayCountRatio(const double _rayCountRatio);
 
+      /// \brief Scan like a spinning lidar. Each update only renders the
+      /// first pass textures whose sector of the horizontal FOV was swept
+      /// since the previous update, at the given revolution rate and in
+      /// simulation time. The other textures keep the ranges of an older
+      /// update, so that a scan is assembled over a revolution with the
+      /// motion distortion of a real spinning lidar. A full revolution
+      /// sweeps the horizontal FOV once.
+      /// \param[in] _rate Revolutions per second, 0 to render the whole
+      /// FOV on every update, the default.
+      /// \sa ScanRate()
+      public: void SetScanRate(const double _rate);
+
+      /// \brief Get the revolution rate of the rotating scan.
+      /// \return Revolutions per second, 0 if disabled.
+      /// \sa SetScanRate(const double)
+      public: double ScanRate() const;
+
+      /// \brief Get the number of first pass textures rendered by the last
+      /// update.
+      /// \return Number of textures, at most CameraCount().
+      public: unsigned int RenderedTextureCount() const;
+
       // Documentation inherited.
       private: virtual void RenderImpl();
 
@@ -220,6 +242,12 @@ namespace gazebo
                                        Ogre::Camera *_cam,
                                        const bool _updateTex = false);
 
+      /// \brief Choose the first pass textures that a rotating scan
+      /// renders, and advance the scan.
+      /// \param[in,out] _sectors True for each texture to render, all
+      /// true on input.
+      private: void UpdateScanSectors(bool _sectors[3]);
+
       /// \brief Create an ortho camera.
       private: void CreateOrthoCam();
 
@@ -24,6 +24,7 @@
 #include "gazebo/rendering/RenderTypes.hh"
 
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/Time.hh"
 
 namespace Ogre
 {
@@ -133,6 +134,24 @@ namespace gazebo
 
       /// Number of second pass texture units created.
       public: static int texCount;
+
+      /// \brief Revolutions per second of a rotating scan, 0 to render
+      /// all the first pass textures on every update.
+      public: double scanRate = 0;
+
+      /// \brief Angle of the rotating scan within the horizontal FOV,
+      /// from the start of the first texture, in radians.
+      public: double scanAngle = 0;
+
+      /// \brief Simulation time of the last rotating scan update.
+      public: common::Time scanTime;
+
+      /// \brief True once the rotating scan rendered every texture.
+      public: bool scanStarted = false;
+
+      /// \brief Number of first pass textures rendered by the last
+      /// update.
+      public: unsigned int renderedTextureCount = 0;
     };
   }
 }
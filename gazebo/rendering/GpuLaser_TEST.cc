@@ -81,6 +81,13 @@ TEST_F(GpuLaser_TEST, BasicGpuLaserAPITest)
 
     laserCam->SetCameraCount(4u);
     EXPECT_EQ(laserCam->CameraCount(), 4u);
+
+    EXPECT_DOUBLE_EQ(laserCam->ScanRate(), 0.0);
+    laserCam->SetScanRate(10.0);
+    EXPECT_DOUBLE_EQ(laserCam->ScanRate(), 10.0);
+    laserCam->SetScanRate(-1.0);
+    EXPECT_DOUBLE_EQ(laserCam->ScanRate(), 0.0);
+    EXPECT_EQ(laserCam->RenderedTextureCount(), 0u);
   }
 }
 
@@ -15,7 +15,9 @@
  *
 */
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 
 #include <string.h>
 #include <math.h>
@@ -29,6 +31,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Dem.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/HeightmapData.hh"
 #include "gazebo/common/SystemPaths.hh"
@@ -56,6 +59,9 @@ using Ogre::LOW_LOD;
 
 const double HeightmapPrivate::loadRadiusFactor = 1.0;
 const double HeightmapPrivate::holdRadiusFactor = 1.15;
+const double HeightmapPrivate::streamLoadRadiusFactor = 1.5;
+const double HeightmapPrivate::streamHoldRadiusFactor = 2.0;
+const unsigned int HeightmapPrivate::terrainCacheVersion = 1;
 const boost::filesystem::path HeightmapPrivate::pagingDirname = "paging";
 const boost::filesystem::path HeightmapPrivate::hashFilename = "gzterrain.SHA1";
 
@@ -85,6 +91,7 @@ Heightmap::Heightmap(ScenePtr _scene)
 //////////////////////////////////////////////////
 Heightmap::~Heightmap()
 {
+  this->dataPtr->cameraConnection.reset();
   this->dataPtr->scene.reset();
 
   if (this->dataPtr->terrainPaging)
@@ -319,7 +326,11 @@ bool Heightmap::PrepareTerrain(
   bool updateHash = true;
 
   // Compute the original heightmap's image.
-  heightmapHash = common::get_sha1<std::vector<float> >(this->dataPtr->heights);
+  if (!this->dataPtr->terrainCacheHash.empty())
+    heightmapHash = this->dataPtr->terrainCacheHash;
+  else
+    heightmapHash =
+        common::get_sha1<std::vector<float> >(this->dataPtr->heights);
 
   // Check if the terrain hash exists
   terrainHashFullPath = _terrainDirPath / this->dataPtr->hashFilename;
@@ -340,8 +351,10 @@ bool Heightmap::PrepareTerrain(
     }
   }
 
-  // Update the terrain hash and split the terrain into small pieces
-  if (updateHash)
+  // Update the terrain hash and split the terrain into small pieces. The
+  // hash of the heightmap file is only written once the terrain data is
+  // saved, see SaveHeightmap().
+  if (updateHash && this->dataPtr->terrainCacheHash.empty())
   {
     this->UpdateTerrainHash(heightmapHash, _terrainDirPath);
   }
@@ -434,17 +447,31 @@ void Heightmap::Load()
       else
         scale.Z(fabs(this->dataPtr->terrainSize.Z()) / heightmapSizeZ);
 
-      // Construct the heightmap lookup table
-      std::vector<float> lookup;
-      this->dataPtr->heightmapData->FillHeightMap(this->dataPtr->sampling,
-          vertSize, this->dataPtr->terrainSize, scale, flipY, lookup);
+      // The paged terrain data is cached for the heightmap file and the
+      // parameters used to sample it. When it is up to date, the terrain
+      // is streamed from the cache and the heights aren't generated.
+      if (this->dataPtr->useTerrainPaging)
+        this->dataPtr->streamTerrain = this->TerrainCacheValid();
 
-      for (unsigned int y = 0; y < vertSize; ++y)
+      if (this->dataPtr->streamTerrain)
+      {
+        gzmsg << "Streaming heightmap from cache data" << std::endl;
+      }
+      else
       {
-        for (unsigned int x = 0; x < vertSize; ++x)
+        // Construct the heightmap lookup table
+        std::vector<float> lookup;
+        this->dataPtr->heightmapData->FillHeightMap(this->dataPtr->sampling,
+            vertSize, this->dataPtr->terrainSize, scale, flipY, lookup);
+
+        this->dataPtr->heights.reserve(lookup.size());
+        for (unsigned int y = 0; y < vertSize; ++y)
         {
-          int index = (vertSize - y - 1) * vertSize + x;
-          this->dataPtr->heights.push_back(lookup[index] - minElevation);
+          for (unsigned int x = 0; x < vertSize; ++x)
+          {
+            int index = (vertSize - y - 1) * vertSize + x;
+            this->dataPtr->heights.push_back(lookup[index] - minElevation);
+          }
         }
       }
 
@@ -453,7 +480,7 @@ void Heightmap::Load()
   }
 
   // if heightmap fails to load locally, get the data from the server side
-  if (this->dataPtr->heights.empty())
+  if (this->dataPtr->heights.empty() && !this->dataPtr->streamTerrain)
   {
     gzmsg << "Heightmap could not be loaded locally "
           << "(is it in the GAZEBO_RESOURCE_PATH?)- requesting data from "
@@ -480,7 +507,7 @@ void Heightmap::Load()
     }
   }
 
-  if (this->dataPtr->heights.empty())
+  if (this->dataPtr->heights.empty() && !this->dataPtr->streamTerrain)
   {
     gzerr << "Failed to load terrain. Heightmap data is empty" << std::endl;
     return;
@@ -503,6 +530,7 @@ void Heightmap::Load()
     imgPath = this->dataPtr->filename;
     terrainName = imgPath.filename().stem();
     terrainDirPath = this->dataPtr->gzPagingDir / terrainName;
+    this->dataPtr->terrainDirPath = terrainDirPath;
 
     // Add the top level terrain paging directory to the OGRE
     // ResourceGroupManager
@@ -572,7 +600,7 @@ void Heightmap::Load()
   this->dataPtr->terrainGroup->setOrigin(Conversions::Convert(origin));
   this->ConfigureTerrainDefaults();
 
-  if (!this->dataPtr->heights.empty())
+  if (!this->dataPtr->heights.empty() || this->dataPtr->streamTerrain)
   {
     UserCameraPtr userCam = this->dataPtr->scene->GetUserCamera(0);
 
@@ -580,9 +608,14 @@ void Heightmap::Load()
     // camera position in the world file
     if (userCam && !userCam->IsCameraSetInWorldFile())
     {
-      double h = *std::max_element(
-        &this->dataPtr->heights[0],
-        &this->dataPtr->heights[0] + this->dataPtr->heights.size());
+      // The heights of a streamed terrain are bounded by its size
+      double h = this->dataPtr->terrainSize.Z();
+      if (!this->dataPtr->heights.empty())
+      {
+        h = *std::max_element(
+          &this->dataPtr->heights[0],
+          &this->dataPtr->heights[0] + this->dataPtr->heights.size());
+      }
 
       ignition::math::Vector3d camPos(5, -5, h + 200);
       ignition::math::Vector3d lookAt(0, 0, h);
@@ -607,17 +640,22 @@ void Heightmap::Load()
     this->dataPtr->pageManager->setPageProvider(
         &this->dataPtr->dummyPageProvider);
 
-    // Add cameras
-    for (unsigned int i = 0; i < this->dataPtr->scene->CameraCount(); ++i)
-    {
-      this->dataPtr->pageManager->addCamera(
-          this->dataPtr->scene->GetCamera(i)->OgreCamera());
-    }
-    for (unsigned int i = 0; i < this->dataPtr->scene->UserCameraCount();
-        ++i)
+    // Add cameras, and keep them in sync as cameras are created and
+    // destroyed
+    this->UpdatePagingCameras();
+    this->dataPtr->cameraConnection = event::Events::ConnectPreRender(
+        std::bind(&Heightmap::UpdatePagingCameras, this));
+
+    // A streamed terrain only keeps the slots near the cameras
+    double loadRadius =
+        this->dataPtr->loadRadiusFactor * this->dataPtr->terrainSize.X();
+    double holdRadius =
+        this->dataPtr->holdRadiusFactor * this->dataPtr->terrainSize.X();
+    if (this->dataPtr->streamTerrain)
     {
-      this->dataPtr->pageManager->addCamera(
-          this->dataPtr->scene->GetUserCamera(i)->OgreCamera());
+      double slotSize = this->dataPtr->terrainSize.X() / sqrtN;
+      loadRadius = this->dataPtr->streamLoadRadiusFactor * slotSize;
+      holdRadius = this->dataPtr->streamHoldRadiusFactor * slotSize;
     }
 
     this->dataPtr->terrainPaging =
@@ -625,9 +663,7 @@ void Heightmap::Load()
     this->dataPtr->world = this->dataPtr->pageManager->createWorld();
     this->dataPtr->terrainPaging->createWorldSection(
         this->dataPtr->world, this->dataPtr->terrainGroup,
-        this->dataPtr->loadRadiusFactor * this->dataPtr->terrainSize.X(),
-        this->dataPtr->holdRadiusFactor * this->dataPtr->terrainSize.X(),
-        0, 0, sqrtN - 1, sqrtN - 1);
+        loadRadius, holdRadius, 0, 0, sqrtN - 1, sqrtN - 1);
   }
 
   gzmsg << "Loading heightmap: " << terrainName.string() << std::endl;
@@ -637,11 +673,24 @@ void Heightmap::Load()
     for (int x = 0; x <= sqrtN - 1; ++x)
       this->DefineTerrain(x, y);
 
+  // Ogre keeps a copy of the imported heights, so the paged terrain
+  // doesn't need them anymore
+  if (this->dataPtr->useTerrainPaging)
+  {
+    std::vector<float>().swap(this->dataPtr->heights);
+    std::vector<std::vector<float> >().swap(this->dataPtr->subTerrains);
+  }
+
   // use gazebo shaders
   this->CreateMaterial();
 
-  // Sync load since we want everything in place when we start
-  this->dataPtr->terrainGroup->loadAllTerrains(true);
+  // The paging system loads the streamed terrain slots around the cameras
+  // in the background.
+  if (!this->dataPtr->streamTerrain)
+  {
+    // Sync load since we want everything in place when we start
+    this->dataPtr->terrainGroup->loadAllTerrains(true);
+  }
 
   gzmsg << "Heightmap loaded. Process took: "
         <<  (common::Time::GetWallTime() - time).Double()
@@ -694,6 +743,13 @@ void Heightmap::SaveHeightmap()
 
     this->dataPtr->terrainGroup->saveAllTerrains(true);
 
+    // The terrain data is complete, so the next loads may stream it
+    if (!this->dataPtr->terrainCacheHash.empty())
+    {
+      this->UpdateTerrainHash(this->dataPtr->terrainCacheHash,
+          this->dataPtr->terrainDirPath);
+    }
+
     gzmsg << "Heightmap cache data saved. Process took: "
           << (common::Time::GetWallTime() - time).Double() << " seconds."
           << std::endl;
@@ -703,6 +759,75 @@ void Heightmap::SaveHeightmap()
   }
 }
 
+///////////////////////////////////////////////////
+bool Heightmap::TerrainCacheValid()
+{
+  boost::system::error_code ec;
+  std::time_t mtime =
+      boost::filesystem::last_write_time(this->dataPtr->filename, ec);
+  if (ec)
+    return false;
+  uintmax_t fileSize =
+      boost::filesystem::file_size(this->dataPtr->filename, ec);
+  if (ec)
+    return false;
+
+  std::ostringstream key;
+  key << this->dataPtr->filename << '\n' << mtime << '\n' << fileSize << '\n'
+      << this->dataPtr->sampling << '\n' << this->dataPtr->terrainSize << '\n'
+      << this->dataPtr->numTerrainSubdivisions << '\n'
+      << this->dataPtr->terrainCacheVersion;
+  this->dataPtr->terrainCacheHash = common::get_sha1<std::string>(key.str());
+
+  boost::filesystem::path terrainHashFullPath =
+      this->dataPtr->gzPagingDir /
+      boost::filesystem::path(this->dataPtr->filename).filename().stem() /
+      this->dataPtr->hashFilename;
+  if (!boost::filesystem::exists(terrainHashFullPath))
+    return false;
+
+  std::ifstream in(terrainHashFullPath.string().c_str());
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str() == this->dataPtr->terrainCacheHash;
+}
+
+///////////////////////////////////////////////////
+void Heightmap::UpdatePagingCameras()
+{
+  if (!this->dataPtr->pageManager || !this->dataPtr->scene)
+    return;
+
+  std::vector<Ogre::Camera *> cameras;
+  for (unsigned int i = 0; i < this->dataPtr->scene->CameraCount(); ++i)
+  {
+    CameraPtr camera = this->dataPtr->scene->GetCamera(i);
+    if (camera && camera->OgreCamera())
+      cameras.push_back(camera->OgreCamera());
+  }
+  for (unsigned int i = 0; i < this->dataPtr->scene->UserCameraCount(); ++i)
+  {
+    UserCameraPtr camera = this->dataPtr->scene->GetUserCamera(i);
+    if (camera && camera->OgreCamera())
+      cameras.push_back(camera->OgreCamera());
+  }
+
+  // Copy the list, since removing a camera modifies it
+  Ogre::PageManager::CameraList pagingCameras =
+      this->dataPtr->pageManager->getCameraList();
+  for (auto camera : pagingCameras)
+  {
+    if (std::find(cameras.begin(), cameras.end(), camera) == cameras.end())
+      this->dataPtr->pageManager->removeCamera(camera);
+  }
+
+  for (auto camera : cameras)
+  {
+    if (!this->dataPtr->pageManager->hasCamera(camera))
+      this->dataPtr->pageManager->addCamera(camera);
+  }
+}
+
 ///////////////////////////////////////////////////
 void Heightmap::ConfigureTerrainDefaults()
 {
@@ -845,6 +970,11 @@ void Heightmap::DefineTerrain(const int _x, const int _y)
     this->dataPtr->terrainGroup->defineTerrain(_x, _y);
     this->dataPtr->terrainsImported = false;
   }
+  else if (this->dataPtr->streamTerrain)
+  {
+    gzerr << "Missing heightmap cache data: " << filename
+          << ". Remove the terrain hash to regenerate it." << std::endl;
+  }
   else
   {
     if (this->dataPtr->splitTerrain)
@@ -273,6 +273,17 @@ namespace gazebo
       /// \brief Save the heightmap tiles to disk
       private: void SaveHeightmap();
 
+      /// \brief Compute the hash of the heightmap file and of the parameters
+      /// used to generate the paged terrain data, and compare it against the
+      /// one stored in the terrain directory.
+      /// \return True if the cached terrain data is complete and up to date.
+      private: bool TerrainCacheValid();
+
+      /// \brief Add the cameras of the scene to the page manager, and
+      /// remove the ones that no longer exist, so that the terrain is paged
+      /// around all the active cameras.
+      private: void UpdatePagingCameras();
+
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<HeightmapPrivate> dataPtr;
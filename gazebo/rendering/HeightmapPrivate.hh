@@ -371,6 +371,18 @@ namespace gazebo
       /// depends on the terrain size.
       public: static const double holdRadiusFactor;
 
+      /// \brief Load radius of the streamed terrain, as a factor of the
+      /// size of a terrain slot.
+      public: static const double streamLoadRadiusFactor;
+
+      /// \brief Hold radius of the streamed terrain, as a factor of the
+      /// size of a terrain slot. Slots beyond it are unloaded.
+      public: static const double streamHoldRadiusFactor;
+
+      /// \brief Version of the cached terrain data. Increase it when the way
+      /// the terrain data is generated changes.
+      public: static const unsigned int terrainCacheVersion;
+
       /// \brief Hash file name that should be present for every terrain file
       /// loaded using paging.
       public: static const boost::filesystem::path hashFilename;
@@ -453,6 +465,21 @@ namespace gazebo
       /// \brief True if the terrain's hash does not match the image's hash
       public: bool terrainHashChanged;
 
+      /// \brief Hash of the heightmap file and of the parameters used to
+      /// generate the cached terrain data. It is only set when the paging
+      /// is enabled for a local heightmap file. It is written once all the
+      /// terrain data is saved, which lets the reloads skip the generation
+      /// of the heights.
+      public: std::string terrainCacheHash;
+
+      /// \brief True if the terrain slots are loaded in the background
+      /// around the cameras, from the cached terrain data, instead of all
+      /// being loaded up front.
+      public: bool streamTerrain = false;
+
+      /// \brief Directory where the terrain hash and data are stored.
+      public: boost::filesystem::path terrainDirPath;
+
       /// \brief Name of custom material to use for the terrain. If empty,
       /// default material with glsl shader will be used.
       public: std::string materialName;
@@ -485,6 +512,10 @@ namespace gazebo
 
       /// \brief Event connections
       public: std::vector<event::ConnectionPtr> connections;
+
+      /// \brief Connection to the pre render event, used to keep the
+      /// cameras of the page manager in sync with the scene.
+      public: event::ConnectionPtr cameraConnection;
     };
   }
 }
@@ -16,7 +16,12 @@
 */
 
 #include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <boost/assign/list_of.hpp>
+#include <boost/filesystem.hpp>
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/test/ServerFixture.hh"
 
 #include "test_config.h"
@@ -166,6 +171,86 @@ TEST_F(Heightmap_TEST, LoadDEM)
 }
 #endif
 
+/////////////////////////////////////////////////
+/// \brief Read the terrain hash of a paged heightmap.
+/// \param[in] _path Path of the hash file.
+/// \return The hash, empty if there is none.
+static std::string terrainHash(const boost::filesystem::path &_path)
+{
+  std::ifstream in(_path.string().c_str());
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that the paged terrain cache is kept until the heightmap
+/// file changes
+TEST_F(Heightmap_TEST, TerrainCache)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene("default");
+  ASSERT_TRUE(scene != nullptr);
+
+  // A copy of the heightmap, with its own terrain directory
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("heightmap-%%%%%%");
+  ASSERT_TRUE(boost::filesystem::create_directories(dir));
+  const std::string stem = dir.filename().string();
+  boost::filesystem::path file = dir / (stem + ".png");
+  boost::filesystem::copy_file(boost::filesystem::path(PROJECT_SOURCE_PATH) /
+      "media/materials/textures/heightmap_bowl.png", file);
+
+  const boost::filesystem::path hashPath =
+      boost::filesystem::path(common::SystemPaths::Instance()->GetLogPath()) /
+      "paging" / stem / "gzterrain.SHA1";
+
+  msgs::Visual msg;
+  msg.set_name("heightmap_visual");
+  msg.set_parent_name("heightmap_visual_parent");
+  auto geomMsg = msg.mutable_geometry();
+  geomMsg->set_type(msgs::Geometry::HEIGHTMAP);
+  msgs::Set(geomMsg->mutable_heightmap()->mutable_size(),
+      ignition::math::Vector3d(129, 129, 10));
+  geomMsg->mutable_heightmap()->set_filename(file.string());
+  geomMsg->mutable_heightmap()->set_use_terrain_paging(true);
+  ConstVisualPtr visMsg(new msgs::Visual(msg));
+
+  // The hash is written once the terrain data is saved
+  gazebo::rendering::Heightmap *heightmap =
+      new gazebo::rendering::Heightmap(scene);
+  heightmap->LoadFromMsg(visMsg);
+  int i = 0;
+  while (terrainHash(hashPath).empty() && i++ < 300)
+    common::Time::MSleep(100);
+  const std::string hash = terrainHash(hashPath);
+  EXPECT_FALSE(hash.empty());
+  delete heightmap;
+
+  // A reload streams the cached terrain data, and keeps the hash
+  heightmap = new gazebo::rendering::Heightmap(scene);
+  heightmap->LoadFromMsg(visMsg);
+  common::Time::MSleep(1000);
+  EXPECT_EQ(hash, terrainHash(hashPath));
+  delete heightmap;
+
+  // A changed heightmap file regenerates the terrain data
+  boost::filesystem::last_write_time(file,
+      boost::filesystem::last_write_time(file) + 100);
+  heightmap = new gazebo::rendering::Heightmap(scene);
+  heightmap->LoadFromMsg(visMsg);
+  i = 0;
+  while (terrainHash(hashPath) == hash && i++ < 300)
+    common::Time::MSleep(100);
+  EXPECT_NE(hash, terrainHash(hashPath));
+  EXPECT_FALSE(terrainHash(hashPath).empty());
+  delete heightmap;
+
+  boost::filesystem::remove_all(dir);
+  boost::filesystem::remove_all(hashPath.parent_path());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
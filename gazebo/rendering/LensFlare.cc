@@ -15,7 +15,10 @@
  *
 */
 
+#include <algorithm>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 
@@ -496,8 +499,9 @@ void LensFlare::Update()
 void LensFlare::OnRequest(ConstRequestPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  if (_msg->request() == "entity_delete" &&
-      _msg->data() == this->dataPtr->lightName)
+  const std::vector<std::string> names = msgs::DeletedEntities(*_msg);
+  if (std::find(names.begin(), names.end(), this->dataPtr->lightName) !=
+      names.end())
   {
     this->dataPtr->removeLensFlare = true;
     this->dataPtr->preRenderConnection = event::Events::ConnectPreRender(
@@ -0,0 +1,492 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/LightClusterer.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Number of cluster columns.
+static const int kTilesX = 16;
+
+/// \brief Number of cluster rows.
+static const int kTilesY = 8;
+
+/// \brief Number of cluster depth slices.
+static const int kSlices = 16;
+
+/// \brief Depth of the last slice of cameras without far clip plane.
+static const Ogre::Real kInfiniteFar = 10000;
+
+/// \brief Name of the light given to unused slots.
+static const char *kBlackLight = "__GZ_CLUSTER_BLACK_LIGHT__";
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Clusters overlapped by a box.
+    class ClusterRange
+    {
+      /// \brief First and last column.
+      public: int x0 = 0, x1 = 0;
+
+      /// \brief First and last row.
+      public: int y0 = 0, y1 = 0;
+
+      /// \brief First and last slice.
+      public: int z0 = 0, z1 = 0;
+
+      /// \brief Get the number of clusters of the range.
+      /// \return Number of clusters.
+      public: int Count() const
+              {
+                return (this->x1 - this->x0 + 1) * (this->y1 - this->y0 + 1) *
+                    (this->z1 - this->z0 + 1);
+              }
+    };
+
+    /// \internal
+    /// \brief Lights of an entity.
+    class ClusterObjectLights
+    {
+      /// \brief Camera frame of the lights.
+      public: unsigned int frame = 0;
+
+      /// \brief The light slots.
+      public: Ogre::LightList lights;
+    };
+
+    /// \internal
+    /// \brief Private data for LightClusterer
+    class LightClustererPrivate
+      : public Ogre::SceneManager::Listener,
+        public Ogre::MovableObject::Listener
+    {
+      /// \brief Bin the lights for a camera.
+      /// \param[in] _camera The camera.
+      public: void Bin(const Ogre::Camera *_camera);
+
+      /// \brief Get the clusters overlapped by a box.
+      /// \param[in] _min Minimum corner of the box, in view space.
+      /// \param[in] _max Maximum corner of the box, in view space.
+      /// \param[out] _range The clusters.
+      /// \return False if the box is behind the camera.
+      public: bool Range(const Ogre::Vector3 &_min, const Ogre::Vector3 &_max,
+                  ClusterRange &_range) const;
+
+      /// \brief Get the slice of a depth.
+      /// \param[in] _depth Distance along the view direction.
+      /// \return Index of the slice.
+      public: int Slice(const Ogre::Real _depth) const;
+
+      // Documentation inherited
+      public: virtual void preFindVisibleObjects(Ogre::SceneManager *_source,
+                  Ogre::SceneManager::IlluminationRenderStage _irs,
+                  Ogre::Viewport *_v);
+
+      // Documentation inherited
+      public: virtual const Ogre::LightList *objectQueryLights(
+                  const Ogre::MovableObject *_obj);
+
+      // Documentation inherited
+      public: virtual void objectDestroyed(Ogre::MovableObject *_obj);
+
+      /// \brief Scene manager whose entities are lit.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief Number of slots per light type.
+      public: int slots[3] = {0, 0, 0};
+
+      /// \brief Light given to unused slots.
+      public: Ogre::Light *blackLight = nullptr;
+
+      /// \brief Camera frame counter, 0 before the first frame.
+      public: unsigned int frame = 0;
+
+      /// \brief View matrix of the camera.
+      public: Ogre::Matrix4 view = Ogre::Matrix4::IDENTITY;
+
+      /// \brief Projection matrix of the camera.
+      public: Ogre::Matrix4 proj = Ogre::Matrix4::IDENTITY;
+
+      /// \brief Near clip distance of the camera.
+      public: Ogre::Real nearDist = 0.1;
+
+      /// \brief Depth of the last slice.
+      public: Ogre::Real farDist = kInfiniteFar;
+
+      /// \brief Directional lights of the frame.
+      public: std::vector<Ogre::Light *> directional;
+
+      /// \brief Point and spot lights of the frame.
+      public: std::vector<Ogre::Light *> local;
+
+      /// \brief Indices in local of the lights of each cluster.
+      public: std::vector<std::vector<unsigned int>> clusters;
+
+      /// \brief Query stamp of each local light, to visit it once.
+      public: std::vector<unsigned int> stamps;
+
+      /// \brief Query counter.
+      public: unsigned int stamp = 0;
+
+      /// \brief Lights of the entities.
+      public: std::unordered_map<const Ogre::MovableObject *,
+              ClusterObjectLights> objects;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the brightness of a light.
+/// \param[in] _light The light.
+/// \return Luminance of its diffuse color.
+static Ogre::Real brightness(const Ogre::Light *_light)
+{
+  const Ogre::ColourValue &c = _light->getDiffuseColour();
+  return 0.299f * c.r + 0.587f * c.g + 0.114f * c.b;
+}
+
+//////////////////////////////////////////////////
+LightClusterer::LightClusterer(Ogre::SceneManager *_manager,
+    const int _point, const int _directional, const int _spot)
+  : dataPtr(new LightClustererPrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->slots[Ogre::Light::LT_POINT] = _point;
+  this->dataPtr->slots[Ogre::Light::LT_DIRECTIONAL] = _directional;
+  this->dataPtr->slots[Ogre::Light::LT_SPOTLIGHT] = _spot;
+  this->dataPtr->clusters.resize(kTilesX * kTilesY * kSlices);
+
+  Ogre::Light *light = _manager->createLight(kBlackLight);
+  light->setType(Ogre::Light::LT_POINT);
+  light->setDiffuseColour(Ogre::ColourValue::Black);
+  light->setSpecularColour(Ogre::ColourValue::Black);
+  light->setCastShadows(false);
+  light->setVisible(false);
+  this->dataPtr->blackLight = light;
+
+  _manager->addListener(this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+LightClusterer::~LightClusterer()
+{
+  this->dataPtr->manager->removeListener(this->dataPtr.get());
+
+  Ogre::SceneManager::MovableObjectIterator iter =
+      this->dataPtr->manager->getMovableObjectIterator("Entity");
+  while (iter.hasMoreElements())
+  {
+    Ogre::MovableObject *obj = iter.getNext();
+    if (obj->getListener() == this->dataPtr.get())
+      obj->setListener(nullptr);
+  }
+  this->dataPtr->objects.clear();
+
+  this->dataPtr->manager->destroyLight(this->dataPtr->blackLight);
+}
+
+//////////////////////////////////////////////////
+unsigned int LightClusterer::ClusteredLightCount() const
+{
+  return this->dataPtr->local.size();
+}
+
+//////////////////////////////////////////////////
+void LightClustererPrivate::preFindVisibleObjects(
+    Ogre::SceneManager * /*_source*/,
+    Ogre::SceneManager::IlluminationRenderStage _irs, Ogre::Viewport *_v)
+{
+  if (_irs == Ogre::SceneManager::IRS_RENDER_TO_TEXTURE || !_v ||
+      !_v->getCamera())
+  {
+    return;
+  }
+
+  // Entities created since the last frame get the listener. Ogre keeps
+  // one listener per object, so entities that have one are left alone.
+  Ogre::SceneManager::MovableObjectIterator iter =
+      this->manager->getMovableObjectIterator("Entity");
+  while (iter.hasMoreElements())
+  {
+    Ogre::MovableObject *obj = iter.getNext();
+    if (!obj->getListener())
+      obj->setListener(this);
+  }
+
+  this->Bin(_v->getCamera());
+}
+
+//////////////////////////////////////////////////
+void LightClustererPrivate::Bin(const Ogre::Camera *_camera)
+{
+  IGN_PROFILE("rendering::LightClusterer::Bin");
+
+  ++this->frame;
+  this->view = _camera->getViewMatrix(true);
+  this->proj = _camera->getProjectionMatrix();
+  this->nearDist = _camera->getNearClipDistance();
+  this->farDist = _camera->getFarClipDistance() > 0 ?
+      _camera->getFarClipDistance() : kInfiniteFar;
+  this->farDist = std::max(this->farDist, this->nearDist * 2);
+
+  this->directional.clear();
+  this->local.clear();
+  for (auto &cluster : this->clusters)
+    cluster.clear();
+
+  // The lights that Ogre found in the view frustum, shadow casters first
+  const Ogre::LightList &lights = this->manager->_getLightsAffectingFrustum();
+  for (Ogre::Light *light : lights)
+  {
+    if (light == this->blackLight)
+      continue;
+
+    if (light->getType() == Ogre::Light::LT_DIRECTIONAL)
+    {
+      this->directional.push_back(light);
+      continue;
+    }
+
+    const Ogre::Vector3 center = this->view * light->getDerivedPosition();
+    const Ogre::Real radius = light->getAttenuationRange();
+    const Ogre::Vector3 extent(radius, radius, radius);
+    ClusterRange range;
+    if (!this->Range(center - extent, center + extent, range))
+      continue;
+
+    const unsigned int index = this->local.size();
+    this->local.push_back(light);
+    for (int z = range.z0; z <= range.z1; ++z)
+    {
+      for (int y = range.y0; y <= range.y1; ++y)
+      {
+        for (int x = range.x0; x <= range.x1; ++x)
+          this->clusters[(z * kTilesY + y) * kTilesX + x].push_back(index);
+      }
+    }
+  }
+  this->stamps.assign(this->local.size(), this->stamp);
+}
+
+//////////////////////////////////////////////////
+int LightClustererPrivate::Slice(const Ogre::Real _depth) const
+{
+  const Ogre::Real depth =
+      std::min(std::max(_depth, this->nearDist), this->farDist);
+  const int slice = static_cast<int>(std::log(depth / this->nearDist) /
+      std::log(this->farDist / this->nearDist) * kSlices);
+  return std::min(std::max(slice, 0), kSlices - 1);
+}
+
+//////////////////////////////////////////////////
+bool LightClustererPrivate::Range(const Ogre::Vector3 &_min,
+    const Ogre::Vector3 &_max, ClusterRange &_range) const
+{
+  // The camera looks down -z
+  const Ogre::Real minDepth = std::max(-_max.z, this->nearDist);
+  const Ogre::Real maxDepth = -_min.z;
+  if (maxDepth < this->nearDist)
+    return false;
+
+  _range.z0 = this->Slice(minDepth);
+  _range.z1 = this->Slice(maxDepth);
+
+  // The projection of the part of the box in front of the near plane is
+  // bounded by the projections of its corners
+  Ogre::Real ndcMin[2] = {1, 1};
+  Ogre::Real ndcMax[2] = {-1, -1};
+  for (int i = 0; i < 8; ++i)
+  {
+    const Ogre::Vector4 corner(
+        (i & 1) ? _max.x : _min.x,
+        (i & 2) ? _max.y : _min.y,
+        (i & 4) ? -minDepth : -std::min(maxDepth, this->farDist),
+        1);
+    const Ogre::Vector4 clip = this->proj * corner;
+    if (clip.w <= 0)
+      continue;
+    for (int k = 0; k < 2; ++k)
+    {
+      ndcMin[k] = std::min(ndcMin[k], clip[k] / clip.w);
+      ndcMax[k] = std::max(ndcMax[k], clip[k] / clip.w);
+    }
+  }
+  if (ndcMin[0] > 1 || ndcMax[0] < -1 || ndcMin[1] > 1 || ndcMax[1] < -1)
+    return false;
+
+  auto tile = [](const Ogre::Real _ndc, const int _count)
+  {
+    const int t = static_cast<int>((_ndc + 1) * 0.5f * _count);
+    return std::min(std::max(t, 0), _count - 1);
+  };
+  _range.x0 = tile(ndcMin[0], kTilesX);
+  _range.x1 = tile(ndcMax[0], kTilesX);
+  _range.y0 = tile(ndcMin[1], kTilesY);
+  _range.y1 = tile(ndcMax[1], kTilesY);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const Ogre::LightList *LightClustererPrivate::objectQueryLights(
+    const Ogre::MovableObject *_obj)
+{
+  // Ogre's lights until the first camera frame
+  if (this->frame == 0)
+    return nullptr;
+
+  // Ogre queries the lights of every renderable of every pass
+  ClusterObjectLights &entry = this->objects[_obj];
+  if (entry.frame == this->frame)
+    return &entry.lights;
+  entry.frame = this->frame;
+  entry.lights.clear();
+
+  // Candidates are the lights of the clusters overlapped by the entity,
+  // or all lights when that's fewer
+  const Ogre::AxisAlignedBox &box = _obj->getWorldBoundingBox(true);
+  std::vector<unsigned int> candidates;
+  ++this->stamp;
+  bool all = !box.isFinite();
+  if (!all && !box.isNull())
+  {
+    Ogre::Vector3 min(Ogre::Math::POS_INFINITY, Ogre::Math::POS_INFINITY,
+        Ogre::Math::POS_INFINITY);
+    Ogre::Vector3 max(Ogre::Math::NEG_INFINITY, Ogre::Math::NEG_INFINITY,
+        Ogre::Math::NEG_INFINITY);
+    const Ogre::Vector3 *corners = box.getAllCorners();
+    for (int i = 0; i < 8; ++i)
+    {
+      const Ogre::Vector3 corner = this->view * corners[i];
+      min.makeFloor(corner);
+      max.makeCeil(corner);
+    }
+
+    ClusterRange range;
+    if (this->Range(min, max, range) &&
+        static_cast<unsigned int>(range.Count()) < this->local.size())
+    {
+      for (int z = range.z0; z <= range.z1; ++z)
+      {
+        for (int y = range.y0; y <= range.y1; ++y)
+        {
+          for (int x = range.x0; x <= range.x1; ++x)
+          {
+            for (unsigned int index :
+                 this->clusters[(z * kTilesY + y) * kTilesX + x])
+            {
+              if (this->stamps[index] == this->stamp)
+                continue;
+              this->stamps[index] = this->stamp;
+              candidates.push_back(index);
+            }
+          }
+        }
+      }
+    }
+    else
+      all = true;
+  }
+  if (all)
+  {
+    for (unsigned int i = 0; i < this->local.size(); ++i)
+      candidates.push_back(i);
+  }
+
+  // Rank the lights that reach the entity by their brightness at it
+  std::vector<std::pair<Ogre::Real, Ogre::Light *>> ranked[3];
+  const Ogre::uint32 lightMask = _obj->getLightMask();
+  for (unsigned int index : candidates)
+  {
+    Ogre::Light *light = this->local[index];
+    if (!(light->getLightMask() & lightMask))
+      continue;
+
+    Ogre::Real dist = 0;
+    if (box.isFinite() && !box.isNull())
+    {
+      const Ogre::Vector3 pos = light->getDerivedPosition();
+      const Ogre::Vector3 nearest(
+          std::min(std::max(pos.x, box.getMinimum().x), box.getMaximum().x),
+          std::min(std::max(pos.y, box.getMinimum().y), box.getMaximum().y),
+          std::min(std::max(pos.z, box.getMinimum().z), box.getMaximum().z));
+      dist = pos.distance(nearest);
+      if (dist > light->getAttenuationRange())
+        continue;
+    }
+    ranked[light->getType()].push_back(
+        std::make_pair(brightness(light) / (1 + dist * dist), light));
+  }
+
+  // Fill the slots in the order of the shader lights
+  const Ogre::Light::LightTypes order[3] = {Ogre::Light::LT_POINT,
+      Ogre::Light::LT_DIRECTIONAL, Ogre::Light::LT_SPOTLIGHT};
+  for (const Ogre::Light::LightTypes type : order)
+  {
+    const int count = this->slots[type];
+    int used = 0;
+    if (type == Ogre::Light::LT_DIRECTIONAL)
+    {
+      for (Ogre::Light *light : this->directional)
+      {
+        if (used == count)
+          break;
+        if (light->getLightMask() & lightMask)
+        {
+          entry.lights.push_back(light);
+          ++used;
+        }
+      }
+    }
+    else
+    {
+      auto &lights = ranked[type];
+      const int n = std::min(count, static_cast<int>(lights.size()));
+      std::partial_sort(lights.begin(), lights.begin() + n, lights.end(),
+          [](const std::pair<Ogre::Real, Ogre::Light *> &_a,
+             const std::pair<Ogre::Real, Ogre::Light *> &_b)
+          {
+            return _a.first > _b.first;
+          });
+      for (; used < n; ++used)
+        entry.lights.push_back(lights[used].second);
+    }
+
+    for (; used < count; ++used)
+      entry.lights.push_back(this->blackLight);
+  }
+
+  return &entry.lights;
+}
+
+//////////////////////////////////////////////////
+void LightClustererPrivate::objectDestroyed(Ogre::MovableObject *_obj)
+{
+  this->objects.erase(_obj);
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_LIGHTCLUSTERER_HH_
+#define GAZEBO_RENDERING_LIGHTCLUSTERER_HH_
+
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declarations.
+    class LightClustererPrivate;
+
+    /// \cond
+    /// \brief Gives every entity a fixed number of the lights that reach
+    /// it, chosen from a cluster grid built once per camera frame.
+    ///
+    /// Before each camera frame, the point and spot lights that affect
+    /// the view frustum are binned into clusters, screen tiles split into
+    /// logarithmic depth slices, by the bounds of their attenuation range.
+    /// When Ogre queries the lights of an entity, the lights of the
+    /// clusters that the entity overlaps are tested against its bounds,
+    /// and the brightest ones at the entity fill the light slots: point
+    /// lights first, then directional lights, then spot lights, which is
+    /// the order of the lights in the generated shaders. Unused slots get
+    /// a black light. The shaders of the scene are then generated once for
+    /// the fixed slot counts, see RTShaderSystem::SetLightCount, so that
+    /// neither the shader cost nor the shaders change with the number of
+    /// lights in the scene.
+    ///
+    /// Ogre keeps a single listener per object, so entities that have one
+    /// already, such as those tracked by occlusion culling, get Ogre's
+    /// light lists. Only the Scene class should use this class.
+    class GZ_RENDERING_VISIBLE LightClusterer
+    {
+      /// \brief Constructor
+      /// \param[in] _manager Scene manager whose entities are lit.
+      /// \param[in] _point Number of point light slots.
+      /// \param[in] _directional Number of directional light slots.
+      /// \param[in] _spot Number of spot light slots.
+      public: LightClusterer(Ogre::SceneManager *_manager, const int _point,
+                             const int _directional, const int _spot);
+
+      /// \brief Destructor. Must be called while the scene manager exists.
+      public: virtual ~LightClusterer();
+
+      /// \brief Get the number of point and spot lights binned by the last
+      /// camera frame.
+      /// \return Number of clustered lights.
+      public: unsigned int ClusteredLightCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<LightClustererPrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
@@ -64,6 +64,15 @@ class gazebo::rendering::MarkerManagerPrivate
   /// \param[in] _req The marker message.
   public: void OnMarkerMsg(const ignition::msgs::Marker &_req);
 
+  /// \brief Service callback that receives many markers at once. They
+  /// are all queued under a single lock, and processed by the same
+  /// PreRender event.
+  /// \param[in] _req The marker messages.
+  /// \param[out] _rep True if the markers were queued.
+  /// \return True on success.
+  public: bool OnMarkerArray(const ignition::msgs::Marker_V &_req,
+                             ignition::msgs::Boolean &_rep);
+
   /// \brief Service callback that returns a list of markers.
   /// \param[out] _rep Service reply
   /// \return True on success.
@@ -142,6 +151,13 @@ bool MarkerManager::Init(Scene *_scene)
     gzerr << "Unable to advertise to the /marker service.\n";
   }
 
+  // Advertise to the bulk marker service
+  if (!this->dataPtr->node.Advertise("/marker_array",
+        &MarkerManagerPrivate::OnMarkerArray, this->dataPtr.get()))
+  {
+    gzerr << "Unable to advertise to the /marker_array service.\n";
+  }
+
   this->dataPtr->gznode = transport::NodePtr(new transport::Node());
   this->dataPtr->gznode->Init();
 
@@ -331,6 +347,22 @@ void MarkerManagerPrivate::OnMarkerMsg(const ignition::msgs::Marker &_req)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
   this->markerMsgs.push_back(_req);
+  if (this->scene)
+    this->scene->MarkChanged();
+}
+
+/////////////////////////////////////////////////
+bool MarkerManagerPrivate::OnMarkerArray(const ignition::msgs::Marker_V &_req,
+    ignition::msgs::Boolean &_rep)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (int i = 0; i < _req.marker_size(); ++i)
+    this->markerMsgs.push_back(_req.marker(i));
+  if (this->scene)
+    this->scene->MarkChanged();
+
+  _rep.set_data(true);
+  return true;
 }
 
 /////////////////////////////////////////////////
@@ -283,6 +283,23 @@ void MarkerVisual::DynamicRenderable(const ignition::msgs::Marker &_msg)
       };
     }
 
+    // When the number of points is unchanged, only the points that moved
+    // are set, so that the update only writes their range of the hardware
+    // buffer.
+    if (_msg.point_size() > 0 && static_cast<unsigned int>(_msg.point_size())
+        == this->dPtr->dynamicRenderable->GetPointCount())
+    {
+      for (int i = 0; i < _msg.point_size(); ++i)
+      {
+        ignition::math::Vector3d pt(_msg.point(i).x(),
+                                    _msg.point(i).y(),
+                                    _msg.point(i).z());
+        if (this->dPtr->dynamicRenderable->Point(i) != pt)
+          this->dPtr->dynamicRenderable->SetPoint(i, pt);
+      }
+      return;
+    }
+
     // We make the assumption that the presence of points means the existing
     // points should be removed.
     if (_msg.point_size() > 0)
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <mutex>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Mesh.hh"
+#include "gazebo/common/TriangleBVH.hh"
+#include "gazebo/rendering/MeshBVHCache.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Private data for the MeshBVHCache class
+    class MeshBVHCachePrivate
+    {
+      /// \brief Protects the hierarchies.
+      public: mutable std::mutex mutex;
+
+      /// \brief Hierarchies by key.
+      public: std::map<std::string, std::shared_ptr<const common::TriangleBVH>>
+              bvhs;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+MeshBVHCache::MeshBVHCache()
+  : dataPtr(new MeshBVHCachePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+MeshBVHCache::~MeshBVHCache()
+{
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const common::TriangleBVH> MeshBVHCache::MeshBVH(
+    const common::Mesh *_mesh)
+{
+  if (!_mesh)
+    return nullptr;
+
+  const std::string key = "mesh:" + _mesh->GetName() + "#" +
+    std::to_string(_mesh->GetVertexCount()) + "#" +
+    std::to_string(_mesh->GetIndexCount());
+
+  auto bvh = this->Find(key);
+  if (bvh)
+    return bvh;
+
+  std::vector<ignition::math::Vector3d> vertices;
+  std::vector<unsigned int> indices;
+  for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); ++i)
+  {
+    const common::SubMesh *submesh = _mesh->GetSubMesh(i);
+    if (submesh->GetVertexCount() < 3u)
+      continue;
+
+    const unsigned int offset = vertices.size();
+    for (unsigned int j = 0; j < submesh->GetVertexCount(); ++j)
+      vertices.push_back(submesh->Vertex(j));
+    for (unsigned int j = 0; j + 2 < submesh->GetIndexCount(); j += 3)
+    {
+      indices.push_back(offset + submesh->GetIndex(j));
+      indices.push_back(offset + submesh->GetIndex(j + 1));
+      indices.push_back(offset + submesh->GetIndex(j + 2));
+    }
+  }
+
+  return this->Add(key, vertices, indices);
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const common::TriangleBVH> MeshBVHCache::Find(
+    const std::string &_key) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->bvhs.find(_key);
+  if (iter == this->dataPtr->bvhs.end())
+    return nullptr;
+  return iter->second;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const common::TriangleBVH> MeshBVHCache::Add(
+    const std::string &_key,
+    const std::vector<ignition::math::Vector3d> &_vertices,
+    const std::vector<unsigned int> &_indices)
+{
+  IGN_PROFILE("rendering::MeshBVHCache::Add");
+
+  std::shared_ptr<common::TriangleBVH> bvh(new common::TriangleBVH());
+  bvh->Build(_vertices, _indices);
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->bvhs[_key] = bvh;
+  return bvh;
+}
+
+//////////////////////////////////////////////////
+void MeshBVHCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->bvhs.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int MeshBVHCache::Count() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->bvhs.size();
+}
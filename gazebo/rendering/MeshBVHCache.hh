@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_MESHBVHCACHE_HH_
+#define GAZEBO_RENDERING_MESHBVHCACHE_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_RENDERING_VISIBLE, gazebo, rendering,
+    MeshBVHCache)
+
+namespace gazebo
+{
+  namespace common
+  {
+    class Mesh;
+    class TriangleBVH;
+  }
+
+  namespace rendering
+  {
+    // Forward declarations.
+    class MeshBVHCachePrivate;
+
+    /// \cond
+    /// \brief Keeps a common::TriangleBVH of the meshes tested by ray
+    /// queries, so that the vertices of a mesh are read and indexed once
+    /// instead of on every query.
+    ///
+    /// The hierarchies are in the frame of the meshes. A hierarchy is
+    /// built again when its mesh is replaced by one with the same name but
+    /// a different number of vertices or indices. Only the Scene and
+    /// RayQuery classes should use this class.
+    class GZ_RENDERING_VISIBLE MeshBVHCache :
+      public SingletonT<MeshBVHCache>
+    {
+      /// \brief Constructor.
+      private: MeshBVHCache();
+
+      /// \brief Destructor.
+      private: virtual ~MeshBVHCache();
+
+      /// \brief Get the hierarchy of all the submeshes of a mesh.
+      /// \param[in] _mesh A mesh of the common::MeshManager.
+      /// \return The hierarchy, built by the first call.
+      public: std::shared_ptr<const common::TriangleBVH> MeshBVH(
+                  const common::Mesh *_mesh);
+
+      /// \brief Find a hierarchy added with Add().
+      /// \param[in] _key Key of the hierarchy.
+      /// \return The hierarchy, or null if there is none.
+      public: std::shared_ptr<const common::TriangleBVH> Find(
+                  const std::string &_key) const;
+
+      /// \brief Build a hierarchy, for meshes that aren't in the
+      /// common::MeshManager.
+      /// \param[in] _key Key of the hierarchy, which must identify the
+      /// mesh and its content.
+      /// \param[in] _vertices Vertex positions.
+      /// \param[in] _indices Three vertex indices per triangle.
+      /// \return The new hierarchy.
+      public: std::shared_ptr<const common::TriangleBVH> Add(
+                  const std::string &_key,
+                  const std::vector<ignition::math::Vector3d> &_vertices,
+                  const std::vector<unsigned int> &_indices);
+
+      /// \brief Forget every hierarchy.
+      public: void Clear();
+
+      /// \brief Get the number of hierarchies.
+      /// \return Number of cached hierarchies.
+      public: unsigned int Count() const;
+
+      /// \brief Make the cache a singleton.
+      private: friend class SingletonT<MeshBVHCache>;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<MeshBVHCachePrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
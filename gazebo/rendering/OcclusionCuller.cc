@@ -0,0 +1,446 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <set>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/OcclusionCuller.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Name of the material used to draw the query boxes.
+static const char *kQueryMaterial = "__GZ_OCCLUSION_QUERY__";
+
+/// \brief Number of frames between the queries of a visible entity.
+static const unsigned int kVisibleQueryPeriod = 4;
+
+/// \brief Number of frames after which the query of an entity that
+/// wasn't seen is released.
+static const unsigned int kForgetFrames = 256;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Occlusion state of an entity.
+    class OcclusionCullerEntry
+    {
+      /// \brief Query of the entity, created by its first test.
+      public: Ogre::HardwareOcclusionQuery *query = nullptr;
+
+      /// \brief True if the last query result was zero pixels.
+      public: bool occluded = false;
+
+      /// \brief True while the query hasn't been read.
+      public: bool pending = false;
+
+      /// \brief Frame of the last query.
+      public: unsigned int queryFrame = 0;
+
+      /// \brief Frame in which the entity survived frustum culling.
+      public: unsigned int seenFrame = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for OcclusionCuller
+    class OcclusionCullerPrivate
+      : public Ogre::RenderQueueListener, public Ogre::SceneManager::Listener
+    {
+      /// \brief Called by the rendering listener of the entities.
+      /// \param[in] _obj The entity.
+      /// \return False to skip the entity in this frame.
+      public: bool ObjectRendering(const Ogre::MovableObject *_obj);
+
+      /// \brief Forget a destroyed entity.
+      /// \param[in] _obj The entity.
+      public: void Forget(const Ogre::MovableObject *_obj);
+
+      /// \brief Issue the queries of the frame.
+      public: void Query();
+
+      /// \brief Create the query box and its material.
+      public: void CreateBox();
+
+      // Documentation inherited
+      public: virtual void preFindVisibleObjects(Ogre::SceneManager *_source,
+                  Ogre::SceneManager::IlluminationRenderStage _irs,
+                  Ogre::Viewport *_v);
+
+      // Documentation inherited
+      public: virtual void renderQueueEnded(Ogre::uint8 _queueGroupId,
+                  const Ogre::String &_invocation, bool &_repeat);
+
+      /// \brief Scene manager of the camera.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief The camera.
+      public: Ogre::Camera *camera = nullptr;
+
+      /// \brief Render system, null if queries aren't supported.
+      public: Ogre::RenderSystem *renderSystem = nullptr;
+
+      /// \brief Entities known to the culler.
+      public: std::map<const Ogre::MovableObject *,
+              OcclusionCullerEntry> entries;
+
+      /// \brief Entities that survived frustum culling in this frame.
+      public: std::set<const Ogre::MovableObject *> candidates;
+
+      /// \brief Unit cube drawn by the queries.
+      public: Ogre::RenderOperation boxOp;
+
+      /// \brief Pass used to draw the cube.
+      public: Ogre::Pass *boxPass = nullptr;
+
+      /// \brief Frame counter.
+      public: unsigned int frame = 0;
+
+      /// \brief Entities skipped by the last frame.
+      public: unsigned int occludedCount = 0;
+
+      /// \brief Queries issued by the last frame.
+      public: unsigned int queryCount = 0;
+    };
+  }
+}
+
+/// \brief Cullers by camera.
+static std::map<const Ogre::Camera *, OcclusionCullerPrivate *> gCullers;
+
+/// \brief Rendering listener shared by the entities of every culler. Ogre
+/// keeps a single listener per object, so it dispatches to the culler of
+/// the camera being rendered.
+class OcclusionCullerListener : public Ogre::MovableObject::Listener
+{
+  // Documentation inherited
+  public: virtual bool objectRendering(const Ogre::MovableObject *_obj,
+              const Ogre::Camera *_cam)
+  {
+    auto iter = gCullers.find(_cam);
+    if (iter == gCullers.end())
+      return true;
+    return iter->second->ObjectRendering(_obj);
+  }
+
+  // Documentation inherited
+  public: virtual void objectDestroyed(Ogre::MovableObject *_obj)
+  {
+    for (auto &culler : gCullers)
+      culler.second->Forget(_obj);
+  }
+};
+static OcclusionCullerListener gListener;
+
+//////////////////////////////////////////////////
+OcclusionCuller::OcclusionCuller(Ogre::SceneManager *_manager,
+    Ogre::Camera *_camera)
+  : dataPtr(new OcclusionCullerPrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->camera = _camera;
+
+  Ogre::RenderSystem *rs = Ogre::Root::getSingleton().getRenderSystem();
+  if (!rs || !rs->getCapabilities() ||
+      !rs->getCapabilities()->hasCapability(Ogre::RSC_HWOCCLUSION))
+  {
+    gzwarn << "Occlusion queries are not supported, "
+           << "occlusion culling is disabled.\n";
+    return;
+  }
+
+  this->dataPtr->renderSystem = rs;
+  this->dataPtr->CreateBox();
+
+  gCullers[_camera] = this->dataPtr.get();
+  _manager->addListener(this->dataPtr.get());
+  _manager->addRenderQueueListener(this->dataPtr.get());
+}
+
+//////////////////////////////////////////////////
+OcclusionCuller::~OcclusionCuller()
+{
+  if (!this->dataPtr->renderSystem)
+    return;
+
+  this->dataPtr->manager->removeRenderQueueListener(this->dataPtr.get());
+  this->dataPtr->manager->removeListener(this->dataPtr.get());
+  gCullers.erase(this->dataPtr->camera);
+
+  for (auto &entry : this->dataPtr->entries)
+  {
+    if (entry.second.query)
+      this->dataPtr->renderSystem->destroyHardwareOcclusionQuery(
+          entry.second.query);
+  }
+  this->dataPtr->entries.clear();
+
+  delete this->dataPtr->boxOp.vertexData;
+  delete this->dataPtr->boxOp.indexData;
+}
+
+//////////////////////////////////////////////////
+bool OcclusionCuller::Supported() const
+{
+  return this->dataPtr->renderSystem != nullptr;
+}
+
+//////////////////////////////////////////////////
+unsigned int OcclusionCuller::OccludedCount() const
+{
+  return this->dataPtr->occludedCount;
+}
+
+//////////////////////////////////////////////////
+unsigned int OcclusionCuller::QueryCount() const
+{
+  return this->dataPtr->queryCount;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCullerPrivate::CreateBox()
+{
+  Ogre::MaterialPtr mat =
+      Ogre::MaterialManager::getSingleton().getByName(kQueryMaterial);
+  if (mat.isNull())
+  {
+    mat = Ogre::MaterialManager::getSingleton().create(kQueryMaterial,
+        Ogre::ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
+    Ogre::Pass *pass = mat->getTechnique(0)->getPass(0);
+    pass->setDepthCheckEnabled(true);
+    pass->setDepthWriteEnabled(false);
+    pass->setColourWriteEnabled(false);
+    pass->setCullingMode(Ogre::CULL_NONE);
+    pass->setLightingEnabled(false);
+    mat->load();
+  }
+  this->boxPass = mat->getBestTechnique()->getPass(0);
+
+  static const float vertices[] = {
+    -0.5f, -0.5f, -0.5f,  0.5f, -0.5f, -0.5f,
+     0.5f,  0.5f, -0.5f, -0.5f,  0.5f, -0.5f,
+    -0.5f, -0.5f,  0.5f,  0.5f, -0.5f,  0.5f,
+     0.5f,  0.5f,  0.5f, -0.5f,  0.5f,  0.5f};
+  static const Ogre::uint16 indices[] = {
+    0, 2, 1, 0, 3, 2,  4, 5, 6, 4, 6, 7,
+    0, 1, 5, 0, 5, 4,  3, 6, 2, 3, 7, 6,
+    0, 4, 7, 0, 7, 3,  1, 2, 6, 1, 6, 5};
+
+  Ogre::VertexData *vertexData = new Ogre::VertexData();
+  vertexData->vertexDeclaration->addElement(0, 0, Ogre::VET_FLOAT3,
+      Ogre::VES_POSITION);
+  Ogre::HardwareVertexBufferSharedPtr vbuf =
+      Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        vertexData->vertexDeclaration->getVertexSize(0), 8,
+        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+  vbuf->writeData(0, vbuf->getSizeInBytes(), vertices, true);
+  vertexData->vertexBufferBinding->setBinding(0, vbuf);
+  vertexData->vertexStart = 0;
+  vertexData->vertexCount = 8;
+
+  Ogre::IndexData *indexData = new Ogre::IndexData();
+  indexData->indexBuffer =
+      Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, 36,
+        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+  indexData->indexBuffer->writeData(0,
+      indexData->indexBuffer->getSizeInBytes(), indices, true);
+  indexData->indexStart = 0;
+  indexData->indexCount = 36;
+
+  this->boxOp.operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+  this->boxOp.useIndexes = true;
+  this->boxOp.vertexData = vertexData;
+  this->boxOp.indexData = indexData;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCullerPrivate::preFindVisibleObjects(
+    Ogre::SceneManager * /*_source*/,
+    Ogre::SceneManager::IlluminationRenderStage _irs, Ogre::Viewport *_v)
+{
+  if (_irs == Ogre::SceneManager::IRS_RENDER_TO_TEXTURE || !_v ||
+      _v->getCamera() != this->camera)
+  {
+    return;
+  }
+
+  // Entities created since the last frame get the shared listener. Ogre
+  // keeps one listener per object, so entities that have one are left
+  // alone and never culled.
+  Ogre::SceneManager::MovableObjectIterator iter =
+      this->manager->getMovableObjectIterator("Entity");
+  while (iter.hasMoreElements())
+  {
+    Ogre::MovableObject *obj = iter.getNext();
+    if (!obj->getListener())
+      obj->setListener(&gListener);
+  }
+
+  this->candidates.clear();
+}
+
+//////////////////////////////////////////////////
+bool OcclusionCullerPrivate::ObjectRendering(const Ogre::MovableObject *_obj)
+{
+  if (_obj->getRenderQueueGroup() != Ogre::RENDER_QUEUE_MAIN ||
+      !_obj->getVisible())
+  {
+    return true;
+  }
+
+  Ogre::Viewport *viewport = this->camera->getViewport();
+  if (viewport && !(_obj->getVisibilityFlags() &
+      viewport->getVisibilityMask()))
+  {
+    return true;
+  }
+
+  const Ogre::AxisAlignedBox &box = _obj->getWorldBoundingBox(true);
+  if (!box.isFinite())
+    return true;
+
+  // An entity that comes back into view is assumed to be visible
+  OcclusionCullerEntry &entry = this->entries[_obj];
+  if (this->frame - entry.seenFrame > 1)
+    entry.occluded = false;
+  entry.seenFrame = this->frame;
+  this->candidates.insert(_obj);
+
+  // The camera is inside the box, whose faces would be clipped away
+  Ogre::AxisAlignedBox grown = box;
+  const Ogre::Real nearClip = this->camera->getNearClipDistance();
+  grown.setExtents(box.getMinimum() - Ogre::Vector3(nearClip),
+      box.getMaximum() + Ogre::Vector3(nearClip));
+  if (grown.contains(this->camera->getDerivedPosition()))
+  {
+    entry.occluded = false;
+    return true;
+  }
+
+  return !entry.occluded;
+}
+
+//////////////////////////////////////////////////
+void OcclusionCullerPrivate::Forget(const Ogre::MovableObject *_obj)
+{
+  auto iter = this->entries.find(_obj);
+  if (iter == this->entries.end())
+    return;
+
+  if (iter->second.query)
+    this->renderSystem->destroyHardwareOcclusionQuery(iter->second.query);
+  this->entries.erase(iter);
+  this->candidates.erase(_obj);
+}
+
+//////////////////////////////////////////////////
+void OcclusionCullerPrivate::renderQueueEnded(Ogre::uint8 _queueGroupId,
+    const Ogre::String &_invocation, bool & /*_repeat*/)
+{
+  if (_queueGroupId != Ogre::RENDER_QUEUE_MAIN || !_invocation.empty() ||
+      this->manager->_getCurrentRenderStage() ==
+      Ogre::SceneManager::IRS_RENDER_TO_TEXTURE)
+  {
+    return;
+  }
+
+  Ogre::Viewport *viewport = this->manager->getCurrentViewport();
+  if (!viewport || viewport->getCamera() != this->camera)
+    return;
+
+  this->Query();
+}
+
+//////////////////////////////////////////////////
+void OcclusionCullerPrivate::Query()
+{
+  IGN_PROFILE("rendering::OcclusionCuller::Query");
+
+  ++this->frame;
+  this->occludedCount = 0;
+  this->queryCount = 0;
+
+  // The depth buffer holds the opaque geometry of the frame, so the
+  // boxes are tested against it without writing to it.
+  this->manager->_setPass(this->boxPass, true, false);
+
+  for (const Ogre::MovableObject *obj : this->candidates)
+  {
+    OcclusionCullerEntry &entry = this->entries[obj];
+
+    if (entry.pending && !entry.query->isStillOutstanding())
+    {
+      unsigned int pixels = 0;
+      entry.query->pullOcclusionQuery(&pixels);
+      entry.occluded = pixels == 0;
+      entry.pending = false;
+    }
+
+    if (entry.occluded)
+      ++this->occludedCount;
+
+    // Hidden entities are tested every frame so that they reappear
+    // quickly, visible ones only now and then.
+    if (entry.pending || (!entry.occluded && entry.query &&
+        this->frame - entry.queryFrame < kVisibleQueryPeriod))
+    {
+      continue;
+    }
+
+    if (!entry.query)
+      entry.query = this->renderSystem->createHardwareOcclusionQuery();
+
+    const Ogre::AxisAlignedBox &box = obj->getWorldBoundingBox();
+    Ogre::Matrix4 transform;
+    transform.makeTransform(box.getCenter(), box.getSize(),
+        Ogre::Quaternion::IDENTITY);
+    this->renderSystem->_setWorldMatrix(transform);
+
+    entry.query->beginOcclusionQuery();
+    this->renderSystem->_render(this->boxOp);
+    entry.query->endOcclusionQuery();
+
+    entry.pending = true;
+    entry.queryFrame = this->frame;
+    ++this->queryCount;
+  }
+
+  // Release the queries of entities that left the view long ago
+  for (auto iter = this->entries.begin(); iter != this->entries.end();)
+  {
+    if (this->frame - iter->second.seenFrame > kForgetFrames &&
+        !iter->second.pending)
+    {
+      if (iter->second.query)
+      {
+        this->renderSystem->destroyHardwareOcclusionQuery(
+            iter->second.query);
+      }
+      iter = this->entries.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+}
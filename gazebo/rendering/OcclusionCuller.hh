@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_OCCLUSIONCULLER_HH_
+#define GAZEBO_RENDERING_OCCLUSIONCULLER_HH_
+
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Camera;
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declarations.
+    class OcclusionCullerPrivate;
+
+    /// \cond
+    /// \brief Skips the entities of a camera that are hidden behind other
+    /// geometry, using hardware occlusion queries.
+    ///
+    /// The scene manager already culls the scene nodes outside of the
+    /// view frustum with its octree. After the opaque geometry of a frame
+    /// is drawn, the bounding box of every entity that survived frustum
+    /// culling is tested against the depth buffer. An entity whose box
+    /// produced no pixels is not rendered by the camera until a later
+    /// query finds it visible again. Entities that are rendered are tested
+    /// again every few frames only. Since query results are read one frame
+    /// late, an entity that comes out from behind an occluder may be
+    /// missing from a single frame. Only the Camera class should use this
+    /// class.
+    class GZ_RENDERING_VISIBLE OcclusionCuller
+    {
+      /// \brief Constructor
+      /// \param[in] _manager Scene manager of the camera.
+      /// \param[in] _camera The camera whose entities are culled.
+      public: OcclusionCuller(Ogre::SceneManager *_manager,
+                              Ogre::Camera *_camera);
+
+      /// \brief Destructor. Must be called while the camera exists.
+      public: virtual ~OcclusionCuller();
+
+      /// \brief Tell whether the render system supports occlusion
+      /// queries.
+      /// \return True if entities can be culled.
+      public: bool Supported() const;
+
+      /// \brief Get the number of entities skipped by the last frame.
+      /// \return Number of occluded entities.
+      public: unsigned int OccludedCount() const;
+
+      /// \brief Get the number of occlusion queries issued by the last
+      /// frame.
+      /// \return Number of queries.
+      public: unsigned int QueryCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<OcclusionCullerPrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
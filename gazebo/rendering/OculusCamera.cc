@@ -473,7 +473,8 @@ void OculusCamera::SetRenderTarget(Ogre::RenderTarget *_target)
   rt->getViewport(0)->setBackgroundColour(
         Conversions::Convert(this->scene->BackgroundColor()));
   rt->getViewport(0)->setVisibilityMask(GZ_VISIBILITY_ALL &
-        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+          GZ_VISIBILITY_INSTANCE_SOURCE));
   RTShaderSystem::AttachViewport(rt->getViewport(0), this->GetScene());
 
   if (this->GetScene()->GetSkyX() != NULL)
@@ -487,7 +488,8 @@ void OculusCamera::SetRenderTarget(Ogre::RenderTarget *_target)
   rt->getViewport(0)->setBackgroundColour(
         Conversions::Convert(this->scene->BackgroundColor()));
   rt->getViewport(0)->setVisibilityMask(GZ_VISIBILITY_ALL &
-        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+          GZ_VISIBILITY_INSTANCE_SOURCE));
   RTShaderSystem::AttachViewport(rt->getViewport(0), this->GetScene());
 
   if (this->GetScene()->GetSkyX() != NULL)
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+#include "gazebo/rendering/PoseInterpolator.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Last two poses of an entity.
+    class PoseTrack
+    {
+      /// \brief Previous pose.
+      public: ignition::math::Pose3d from;
+
+      /// \brief Last pose.
+      public: ignition::math::Pose3d to;
+
+      /// \brief Simulation time of the previous pose.
+      public: double fromTime = 0;
+
+      /// \brief Simulation time of the last pose.
+      public: double toTime = 0;
+
+      /// \brief True if the last pose was applied and is no longer
+      /// interpolated.
+      public: bool settled = false;
+    };
+
+    /// \internal
+    /// \brief Private data for the PoseInterpolator class.
+    class PoseInterpolatorPrivate
+    {
+      /// \brief Poses of the entities, by id.
+      public: std::unordered_map<uint32_t, PoseTrack> tracks;
+
+      /// \brief Simulation time of the last message, negative before the
+      /// first one.
+      public: double lastTime = -1;
+
+      /// \brief Wall time at which the last message was received.
+      public: double lastWallTime = 0;
+
+      /// \brief Average interval between messages, in simulation time.
+      public: double interval = 0;
+
+      /// \brief Average rate of simulation time over wall time.
+      public: double rate = 1;
+
+      /// \brief Protects the poses.
+      public: mutable std::mutex mutex;
+    };
+  }
+}
+
+/// \brief Weight of a new sample in the averages.
+static const double kSmoothing = 0.1;
+
+/// \brief Fraction of an interval for which the poses of the last message
+/// are extrapolated.
+static const double kMaxExtrapolation = 0.5;
+
+/////////////////////////////////////////////////
+PoseInterpolator::PoseInterpolator()
+  : dataPtr(new PoseInterpolatorPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PoseInterpolator::~PoseInterpolator()
+{
+}
+
+/////////////////////////////////////////////////
+void PoseInterpolator::Add(const double _simTime, const double _wallTime,
+    const Poses &_poses)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_simTime < this->dataPtr->lastTime)
+  {
+    this->dataPtr->tracks.clear();
+    this->dataPtr->lastTime = -1;
+    this->dataPtr->interval = 0;
+    this->dataPtr->rate = 1;
+  }
+
+  if (this->dataPtr->lastTime >= 0 && _simTime > this->dataPtr->lastTime)
+  {
+    const double dt = _simTime - this->dataPtr->lastTime;
+    const double dw = _wallTime - this->dataPtr->lastWallTime;
+    this->dataPtr->interval = this->dataPtr->interval > 0 ?
+        this->dataPtr->interval + kSmoothing * (dt - this->dataPtr->interval) :
+        dt;
+    if (dw > 0)
+    {
+      this->dataPtr->rate += kSmoothing * (dt / dw - this->dataPtr->rate);
+      this->dataPtr->rate = std::max(0.0, this->dataPtr->rate);
+    }
+  }
+  this->dataPtr->lastTime = _simTime;
+  this->dataPtr->lastWallTime = _wallTime;
+
+  for (auto const &pose : _poses)
+  {
+    auto inserted = this->dataPtr->tracks.insert(
+        std::make_pair(pose.first, PoseTrack()));
+    PoseTrack &track = inserted.first->second;
+    if (inserted.second)
+    {
+      track.from = pose.second;
+      track.fromTime = _simTime;
+    }
+    else if (_simTime > track.toTime)
+    {
+      track.from = track.to;
+      track.fromTime = track.toTime;
+    }
+    track.to = pose.second;
+    track.toTime = _simTime;
+    track.settled = false;
+  }
+}
+
+/////////////////////////////////////////////////
+void PoseInterpolator::Apply(const double _wallTime,
+    const PoseTable::ApplyFunc &_func)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->lastTime < 0)
+    return;
+
+  // Time of the poses that are shown, one interval behind the server
+  const double renderTime = this->dataPtr->lastTime +
+      (_wallTime - this->dataPtr->lastWallTime) * this->dataPtr->rate -
+      this->dataPtr->interval;
+
+  for (auto &iter : this->dataPtr->tracks)
+  {
+    PoseTrack &track = iter.second;
+    if (track.settled)
+      continue;
+
+    // Only the entities of the last message may be moving
+    const bool moving = track.toTime >= this->dataPtr->lastTime;
+    const double span = track.toTime - track.fromTime;
+    double alpha = 1;
+    if (span > 0)
+    {
+      const double maxAlpha = moving ?
+          1 + kMaxExtrapolation * this->dataPtr->interval / span : 1;
+      alpha = std::max(0.0,
+          std::min((renderTime - track.fromTime) / span, maxAlpha));
+    }
+
+    const ignition::math::Pose3d pose(
+        track.from.Pos() + (track.to.Pos() - track.from.Pos()) * alpha,
+        ignition::math::Quaterniond::Slerp(alpha, track.from.Rot(),
+          track.to.Rot(), true));
+
+    if (_func(iter.first, pose) && alpha >= 1 && !moving)
+      track.settled = true;
+  }
+}
+
+/////////////////////////////////////////////////
+double PoseInterpolator::Delay() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->interval;
+}
+
+/////////////////////////////////////////////////
+void PoseInterpolator::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->tracks.clear();
+  this->dataPtr->lastTime = -1;
+  this->dataPtr->interval = 0;
+  this->dataPtr->rate = 1;
+}
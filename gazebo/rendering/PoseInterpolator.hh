@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_POSEINTERPOLATOR_HH_
+#define GAZEBO_RENDERING_POSEINTERPOLATOR_HH_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/rendering/PoseTable.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class PoseInterpolatorPrivate;
+
+    /// \cond
+    /// \brief Poses of the entities of a scene, interpolated between the
+    /// last two pose messages at display rate.
+    ///
+    /// Each entity keeps the last two poses received for it, with their
+    /// simulation times. Poses are shown one pose message interval late,
+    /// so they are interpolated between the two. The interval and the rate
+    /// of simulation time over wall time are averaged over the messages,
+    /// so the delay adapts to the publication rate. When a message is
+    /// late, entities of the last message are extrapolated for up to half
+    /// an interval, and the others stay at their last pose. A pose message
+    /// may be split in several messages with the same time. Only the Scene
+    /// class should use this class.
+    class GZ_RENDERING_VISIBLE PoseInterpolator
+    {
+      /// \brief Poses of a message, as entity ids and poses.
+      public: using Poses =
+          std::vector<std::pair<uint32_t, ignition::math::Pose3d> >;
+
+      /// \brief Constructor
+      public: PoseInterpolator();
+
+      /// \brief Destructor
+      public: virtual ~PoseInterpolator();
+
+      /// \brief Add the poses of a message. Poses older than the last
+      /// message reset the interpolation, as after a world reset.
+      /// \param[in] _simTime Simulation time of the poses.
+      /// \param[in] _wallTime Wall time at which they were received.
+      /// \param[in] _poses The poses.
+      public: void Add(const double _simTime, const double _wallTime,
+                       const Poses &_poses);
+
+      /// \brief Call a function with the pose of each entity at a wall
+      /// time. Entities whose pose was applied and doesn't change anymore
+      /// are skipped until they receive a new pose.
+      /// \param[in] _wallTime Wall time of the frame.
+      /// \param[in] _func Function to call.
+      public: void Apply(const double _wallTime,
+                         const PoseTable::ApplyFunc &_func);
+
+      /// \brief Get the current delay of the poses.
+      /// \return Delay in simulation time.
+      public: double Delay() const;
+
+      /// \brief Discard all the poses.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<PoseInterpolatorPrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
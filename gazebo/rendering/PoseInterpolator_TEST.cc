@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "gazebo/rendering/PoseInterpolator.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+class PoseInterpolator_TEST : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Poses applied, by id.
+typedef std::map<uint32_t, ignition::math::Pose3d> Applied;
+
+/////////////////////////////////////////////////
+/// \brief Apply the poses of an interpolator.
+/// \param[in] _interpolator The interpolator.
+/// \param[in] _wallTime Wall time of the frame.
+/// \return The poses applied.
+static Applied apply(rendering::PoseInterpolator &_interpolator,
+    const double _wallTime)
+{
+  Applied applied;
+  _interpolator.Apply(_wallTime,
+      [&applied](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        applied[_id] = _pose;
+        return true;
+      });
+  return applied;
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseInterpolator_TEST, Interpolate)
+{
+  rendering::PoseInterpolator interpolator;
+  EXPECT_TRUE(apply(interpolator, 0).empty());
+
+  // Messages at 10 Hz, in real time
+  interpolator.Add(0, 0, {{1, ignition::math::Pose3d(0, 0, 0, 0, 0, 0)},
+      {2, ignition::math::Pose3d(5, 0, 0, 0, 0, 0)}});
+  interpolator.Add(0.1, 0.1, {{1, ignition::math::Pose3d(1, 0, 0, 0, 0, 0)}});
+  EXPECT_DOUBLE_EQ(interpolator.Delay(), 0.1);
+
+  // Poses are shown one interval late, between the last two poses
+  Applied applied = apply(interpolator, 0.15);
+  ASSERT_EQ(applied.size(), 2u);
+  EXPECT_NEAR(applied[1].Pos().X(), 0.5, 1e-6);
+  EXPECT_EQ(applied[2], ignition::math::Pose3d(5, 0, 0, 0, 0, 0));
+
+  // Entities that stopped are no longer applied
+  applied = apply(interpolator, 0.2);
+  ASSERT_EQ(applied.size(), 1u);
+  EXPECT_NEAR(applied[1].Pos().X(), 1, 1e-6);
+
+  // Until a message is late, which extrapolates up to half an interval
+  applied = apply(interpolator, 0.25);
+  EXPECT_NEAR(applied[1].Pos().X(), 1.5, 1e-6);
+  applied = apply(interpolator, 1.0);
+  EXPECT_NEAR(applied[1].Pos().X(), 1.5, 1e-6);
+
+  // Rotations are interpolated too
+  interpolator.Add(0.2, 1.0, {{2, ignition::math::Pose3d(5, 0, 0, 0, 0, 1)}});
+  applied = apply(interpolator, 1.05);
+  ASSERT_EQ(applied.size(), 2u);
+  EXPECT_GT(applied[2].Rot().Yaw(), 0);
+  EXPECT_LT(applied[2].Rot().Yaw(), 1);
+
+  // Going back in time resets the poses
+  interpolator.Add(0, 2.0, {{3, ignition::math::Pose3d(1, 2, 3, 0, 0, 0)}});
+  applied = apply(interpolator, 2.0);
+  ASSERT_EQ(applied.size(), 1u);
+  EXPECT_EQ(applied[3], ignition::math::Pose3d(1, 2, 3, 0, 0, 0));
+
+  interpolator.Clear();
+  EXPECT_TRUE(apply(interpolator, 3.0).empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseInterpolator_TEST, Pending)
+{
+  rendering::PoseInterpolator interpolator;
+  interpolator.Add(0, 0, {{1, ignition::math::Pose3d(1, 0, 0, 0, 0, 0)}});
+  interpolator.Add(0.1, 0.1, {{2, ignition::math::Pose3d(2, 0, 0, 0, 0, 0)}});
+
+  // Poses that aren't applied are tried again
+  unsigned int calls = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    interpolator.Apply(1.0,
+        [&calls](const uint32_t _id, const ignition::math::Pose3d &)
+        {
+          if (_id != 1)
+            return true;
+          ++calls;
+          return false;
+        });
+  }
+  EXPECT_EQ(calls, 3u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
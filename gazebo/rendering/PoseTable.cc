@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include "gazebo/rendering/PoseTable.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Pending pose of one entity. The pose is written under a
+    /// sequence lock, so that the reader never sees a partial pose.
+    class PoseTableSlot
+    {
+      /// \brief Sequence number, odd while the pose is being written.
+      public: std::atomic<uint32_t> seq;
+
+      /// \brief True if the pose hasn't been applied yet.
+      public: std::atomic<bool> dirty;
+
+      /// \brief Position followed by the w, x, y and z components of the
+      /// rotation.
+      public: std::array<std::atomic<double>, 7> values;
+    };
+
+    /// \internal
+    /// \brief Fixed size block of slots.
+    class PoseTableChunk
+    {
+      /// \brief Number of slots in a chunk.
+      public: static const uint32_t kSize = 1024;
+
+      /// \brief Number of dirty slots in the chunk. It may briefly be off
+      /// by one while a pose is set and applied at the same time.
+      public: std::atomic<int> pending;
+
+      /// \brief The slots.
+      public: std::array<PoseTableSlot, kSize> slots;
+    };
+
+    /// \internal
+    /// \brief Private data for PoseTable
+    class PoseTablePrivate
+    {
+      /// \brief Maximum number of chunks, which bounds the dense ids.
+      public: static const uint32_t kMaxChunks = 4096;
+
+      /// \brief Write a pose into a slot.
+      /// \param[in] _slot The slot.
+      /// \param[in] _pose The pose.
+      public: static void Write(PoseTableSlot &_slot,
+                                const ignition::math::Pose3d &_pose)
+              {
+                const uint32_t seq = _slot.seq.load(std::memory_order_relaxed);
+                _slot.seq.store(seq + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                const double values[7] = {
+                    _pose.Pos().X(), _pose.Pos().Y(), _pose.Pos().Z(),
+                    _pose.Rot().W(), _pose.Rot().X(), _pose.Rot().Y(),
+                    _pose.Rot().Z()};
+                for (unsigned int i = 0; i < 7; ++i)
+                  _slot.values[i].store(values[i], std::memory_order_relaxed);
+
+                _slot.seq.store(seq + 2, std::memory_order_release);
+              }
+
+      /// \brief Read the pose of a slot, retrying while it is being
+      /// written.
+      /// \param[in] _slot The slot.
+      /// \return The pose.
+      public: static ignition::math::Pose3d Read(const PoseTableSlot &_slot)
+              {
+                double values[7];
+                uint32_t before;
+                uint32_t after;
+                do
+                {
+                  before = _slot.seq.load(std::memory_order_acquire);
+                  for (unsigned int i = 0; i < 7; ++i)
+                    values[i] = _slot.values[i].load(std::memory_order_relaxed);
+                  std::atomic_thread_fence(std::memory_order_acquire);
+                  after = _slot.seq.load(std::memory_order_relaxed);
+                }
+                while (before != after || (before & 1u));
+
+                return ignition::math::Pose3d(values[0], values[1], values[2],
+                    values[3], values[4], values[5], values[6]);
+              }
+
+      /// \brief Chunks of slots, allocated by the writers.
+      public: std::array<std::atomic<PoseTableChunk *>, kMaxChunks> chunks;
+
+      /// \brief One past the highest dense id that was ever set.
+      public: std::atomic<uint32_t> end;
+
+      /// \brief Pending poses of the ids beyond the dense range.
+      public: std::map<uint32_t, ignition::math::Pose3d> overflow;
+
+      /// \brief True if the overflow map isn't empty.
+      public: std::atomic<bool> overflowPending;
+
+      /// \brief Serializes the writers, the allocation of chunks and the
+      /// access to the overflow map.
+      public: mutable std::mutex writeMutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+PoseTable::PoseTable()
+  : dataPtr(new PoseTablePrivate)
+{
+  for (auto &chunk : this->dataPtr->chunks)
+    chunk.store(nullptr, std::memory_order_relaxed);
+  this->dataPtr->end.store(0, std::memory_order_relaxed);
+  this->dataPtr->overflowPending.store(false, std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+PoseTable::~PoseTable()
+{
+  for (auto &chunk : this->dataPtr->chunks)
+    delete chunk.load(std::memory_order_relaxed);
+}
+
+/////////////////////////////////////////////////
+void PoseTable::Set(const uint32_t _id, const ignition::math::Pose3d &_pose)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+  const uint32_t index = _id / PoseTableChunk::kSize;
+  if (index >= PoseTablePrivate::kMaxChunks)
+  {
+    this->dataPtr->overflow[_id] = _pose;
+    this->dataPtr->overflowPending.store(true, std::memory_order_release);
+    return;
+  }
+
+  PoseTableChunk *chunk =
+      this->dataPtr->chunks[index].load(std::memory_order_relaxed);
+  if (!chunk)
+  {
+    // Value initialization zeroes the slots and the pending count.
+    chunk = new PoseTableChunk();
+    this->dataPtr->chunks[index].store(chunk, std::memory_order_release);
+  }
+
+  PoseTableSlot &slot = chunk->slots[_id % PoseTableChunk::kSize];
+  PoseTablePrivate::Write(slot, _pose);
+  if (!slot.dirty.exchange(true, std::memory_order_acq_rel))
+    chunk->pending.fetch_add(1, std::memory_order_release);
+
+  if (_id >= this->dataPtr->end.load(std::memory_order_relaxed))
+    this->dataPtr->end.store(_id + 1, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void PoseTable::Apply(const ApplyFunc &_func)
+{
+  const uint32_t end = this->dataPtr->end.load(std::memory_order_acquire);
+  const uint32_t chunkCount =
+      (end + PoseTableChunk::kSize - 1) / PoseTableChunk::kSize;
+
+  for (uint32_t c = 0; c < chunkCount; ++c)
+  {
+    PoseTableChunk *chunk =
+        this->dataPtr->chunks[c].load(std::memory_order_acquire);
+    if (!chunk || chunk->pending.load(std::memory_order_acquire) <= 0)
+      continue;
+
+    for (uint32_t i = 0; i < PoseTableChunk::kSize; ++i)
+    {
+      PoseTableSlot &slot = chunk->slots[i];
+      if (!slot.dirty.load(std::memory_order_relaxed) ||
+          !slot.dirty.exchange(false, std::memory_order_acq_rel))
+      {
+        continue;
+      }
+      chunk->pending.fetch_sub(1, std::memory_order_acq_rel);
+
+      // A pose set after the flag was cleared marks the slot dirty again,
+      // so it is never lost.
+      if (!_func(c * PoseTableChunk::kSize + i, PoseTablePrivate::Read(slot)))
+      {
+        if (!slot.dirty.exchange(true, std::memory_order_acq_rel))
+          chunk->pending.fetch_add(1, std::memory_order_release);
+      }
+    }
+  }
+
+  if (!this->dataPtr->overflowPending.load(std::memory_order_acquire))
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+  for (auto iter = this->dataPtr->overflow.begin();
+       iter != this->dataPtr->overflow.end();)
+  {
+    if (_func(iter->first, iter->second))
+      iter = this->dataPtr->overflow.erase(iter);
+    else
+      ++iter;
+  }
+  this->dataPtr->overflowPending.store(!this->dataPtr->overflow.empty(),
+      std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+void PoseTable::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+  for (auto &c : this->dataPtr->chunks)
+  {
+    PoseTableChunk *chunk = c.load(std::memory_order_relaxed);
+    if (!chunk)
+      continue;
+
+    for (auto &slot : chunk->slots)
+      slot.dirty.store(false, std::memory_order_relaxed);
+    chunk->pending.store(0, std::memory_order_release);
+  }
+
+  this->dataPtr->overflow.clear();
+  this->dataPtr->overflowPending.store(false, std::memory_order_release);
+}
+
+/////////////////////////////////////////////////
+unsigned int PoseTable::PendingCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+  unsigned int count = this->dataPtr->overflow.size();
+  for (auto &c : this->dataPtr->chunks)
+  {
+    PoseTableChunk *chunk = c.load(std::memory_order_relaxed);
+    if (!chunk)
+      continue;
+
+    for (auto &slot : chunk->slots)
+    {
+      if (slot.dirty.load(std::memory_order_relaxed))
+        ++count;
+    }
+  }
+  return count;
+}
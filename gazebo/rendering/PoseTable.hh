@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_POSETABLE_HH_
+#define GAZEBO_RENDERING_POSETABLE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <ignition/math/Pose3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declare private data class.
+    class PoseTablePrivate;
+
+    /// \cond
+    /// \brief Latest pending pose of each entity in a scene, indexed by
+    /// entity id.
+    ///
+    /// Poses are stored in dense slots, allocated in chunks as ids grow,
+    /// so setting a pose doesn't allocate once its chunk exists. A pose
+    /// set for an id that already has a pending pose replaces it. Any
+    /// number of threads may call Set() while a single thread calls
+    /// Apply(), which doesn't wait for the writers. Ids beyond the dense
+    /// range, such as those of client side visuals, are kept in a
+    /// separate map. Only the Scene class should use this class.
+    class GZ_RENDERING_VISIBLE PoseTable
+    {
+      /// \brief Function called for each pending pose.
+      /// Its arguments are the entity id and its pose. It returns false
+      /// if the pose couldn't be applied and must stay pending.
+      public: using ApplyFunc =
+          std::function<bool (const uint32_t,
+                              const ignition::math::Pose3d &)>;
+
+      /// \brief Constructor
+      public: PoseTable();
+
+      /// \brief Destructor
+      public: virtual ~PoseTable();
+
+      /// \brief Set the pending pose of an entity.
+      /// \param[in] _id Id of the entity.
+      /// \param[in] _pose New pose of the entity.
+      public: void Set(const uint32_t _id,
+                       const ignition::math::Pose3d &_pose);
+
+      /// \brief Call a function for each pending pose, in order of
+      /// increasing id. Poses applied by the function are no longer
+      /// pending.
+      /// \param[in] _func Function to call.
+      public: void Apply(const ApplyFunc &_func);
+
+      /// \brief Discard all the pending poses.
+      public: void Clear();
+
+      /// \brief Get the number of pending poses.
+      /// \return Number of pending poses.
+      public: unsigned int PendingCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<PoseTablePrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
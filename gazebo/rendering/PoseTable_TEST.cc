@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+#include "gazebo/rendering/PoseTable.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+class PoseTable_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(PoseTable_TEST, SetApply)
+{
+  rendering::PoseTable table;
+  EXPECT_EQ(0u, table.PendingCount());
+
+  const ignition::math::Pose3d pose1(1, 2, 3, 0.1, 0.2, 0.3);
+  const ignition::math::Pose3d pose2(4, 5, 6, 0.4, 0.5, 0.6);
+  const ignition::math::Pose3d pose3(7, 8, 9, 0.7, 0.8, 0.9);
+
+  // The last pose set for an id replaces the previous one
+  table.Set(5, pose1);
+  table.Set(5, pose2);
+  table.Set(3000, pose3);
+  // Client side visuals count down from the top of the id range
+  table.Set(UINT32_MAX, pose1);
+  EXPECT_EQ(3u, table.PendingCount());
+
+  // Poses that aren't applied stay pending
+  std::map<uint32_t, ignition::math::Pose3d> applied;
+  table.Apply([&](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        if (_id == 3000)
+          return false;
+        applied[_id] = _pose;
+        return true;
+      });
+  ASSERT_EQ(2u, applied.size());
+  EXPECT_EQ(pose2, applied[5]);
+  EXPECT_EQ(pose1, applied[UINT32_MAX]);
+  EXPECT_EQ(1u, table.PendingCount());
+
+  applied.clear();
+  table.Apply([&](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        applied[_id] = _pose;
+        return true;
+      });
+  ASSERT_EQ(1u, applied.size());
+  EXPECT_EQ(pose3, applied[3000]);
+  EXPECT_EQ(0u, table.PendingCount());
+
+  table.Set(1, pose1);
+  table.Set(UINT32_MAX - 1, pose1);
+  table.Clear();
+  EXPECT_EQ(0u, table.PendingCount());
+
+  applied.clear();
+  table.Apply([&](const uint32_t _id, const ignition::math::Pose3d &_pose)
+      {
+        applied[_id] = _pose;
+        return true;
+      });
+  EXPECT_TRUE(applied.empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(PoseTable_TEST, ConcurrentWriter)
+{
+  rendering::PoseTable table;
+  std::atomic<bool> done(false);
+
+  // Each pose written has equal components, so a torn read is detected
+  std::thread writer([&]()
+      {
+        for (int i = 1; i <= 20000; ++i)
+        {
+          table.Set(i % 8, ignition::math::Pose3d(i, i, i, 1, 0, 0, 0));
+        }
+        done = true;
+      });
+
+  unsigned int torn = 0;
+  auto check = [&](const uint32_t, const ignition::math::Pose3d &_pose)
+      {
+        if (_pose.Pos().X() != _pose.Pos().Y() ||
+            _pose.Pos().X() != _pose.Pos().Z())
+        {
+          ++torn;
+        }
+        return true;
+      };
+
+  while (!done)
+    table.Apply(check);
+  writer.join();
+  table.Apply(check);
+
+  EXPECT_EQ(0u, torn);
+  EXPECT_EQ(0u, table.PendingCount());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,9 @@
 */
 
 #include <sys/stat.h>
+#include <fstream>
+#include <functional>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #include <ignition/common/Profiler.hh>
@@ -38,11 +41,13 @@
 
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/StartupProfiler.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/CustomPSSMShadowCameraSetup.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/Scene.hh"
+#include "gazebo/rendering/ShadowTextureCache.hh"
 #include "gazebo/rendering/Visual.hh"
 #include "gazebo/rendering/RTShaderSystemPrivate.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
@@ -72,6 +77,8 @@ RTShaderSystem::~RTShaderSystem()
 //////////////////////////////////////////////////
 void RTShaderSystem::Init()
 {
+  common::StartupScope startupScope("RTShaderSystem::Init");
+
 #if INCLUDE_RTSHADER && OGRE_VERSION_MAJOR >= 1 &&\
     OGRE_VERSION_MINOR >= MINOR_VERSION
 
@@ -98,6 +105,7 @@ void RTShaderSystem::Init()
 
     // Set shader cache path.
     this->dataPtr->shaderGenerator->setShaderCachePath(cachePath);
+    this->dataPtr->cachePath = cachePath;
 
 #if OGRE_VERSION_MAJOR >= 1 && OGRE_VERSION_MINOR <= 8
     this->dataPtr->programWriterFactory =
@@ -128,6 +136,9 @@ void RTShaderSystem::Init()
   glVersion.release = 0;
   if (capabilities->isDriverOlderThanVersion(glVersion))
     this->dataPtr->enableNormalMap = false;
+
+  if (this->dataPtr->initialized)
+    this->LoadShaderCache();
 }
 
 //////////////////////////////////////////////////
@@ -136,6 +147,8 @@ void RTShaderSystem::Fini()
   if (!this->dataPtr->initialized)
     return;
 
+  this->SaveShaderCache();
+
   // Restore default scheme.
   Ogre::MaterialManager::getSingleton().setActiveScheme(
       Ogre::MaterialManager::DEFAULT_SCHEME_NAME);
@@ -382,6 +395,125 @@ void RTShaderSystem::GenerateShaders(const VisualPtr &_vis)
   }
 }
 
+//////////////////////////////////////////////////
+std::string RTShaderSystem::ShaderCachePath() const
+{
+  return this->dataPtr->cachePath;
+}
+
+//////////////////////////////////////////////////
+void RTShaderSystem::LoadShaderCache()
+{
+  this->dataPtr->microcodeFile.clear();
+
+  // Compiled shaders are cached unless GAZEBO_RTSHADER_CACHE=0
+  const char *cacheEnv = getenv("GAZEBO_RTSHADER_CACHE");
+  if (this->dataPtr->cachePath.empty() ||
+      (cacheEnv && std::string(cacheEnv) == "0"))
+  {
+    return;
+  }
+
+  Ogre::GpuProgramManager &gpuMgr = Ogre::GpuProgramManager::getSingleton();
+  if (!gpuMgr.canGetCompiledShaderBuffer())
+  {
+    gzlog << "The render system can't save compiled shaders, they will be "
+          << "compiled again by every run.\n";
+    return;
+  }
+
+  // The compiled shaders are only valid for the driver that compiled them,
+  // so each driver gets its own file.
+  const Ogre::RenderSystemCapabilities *capabilities =
+      Ogre::Root::getSingleton().getRenderSystem()->getCapabilities();
+  std::ostringstream driver;
+  driver << OGRE_VERSION << ":"
+         << capabilities->getRenderSystemName() << ":"
+         << Ogre::RenderSystemCapabilities::vendorToString(
+             capabilities->getVendor()) << ":"
+         << capabilities->getDeviceName() << ":"
+         << capabilities->getDriverVersion().toString();
+
+  std::ostringstream filename;
+  filename << "microcode_" << std::hex
+           << std::hash<std::string>()(driver.str()) << ".cache";
+  this->dataPtr->microcodeFile = (boost::filesystem::path(
+      this->dataPtr->cachePath) / filename.str()).string();
+
+  gpuMgr.setSaveMicrocodesToCache(true);
+
+  std::ifstream input(this->dataPtr->microcodeFile.c_str(),
+      std::ios::in | std::ios::binary);
+  if (!input.is_open())
+    return;
+
+  try
+  {
+    Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(
+        this->dataPtr->microcodeFile, &input, false));
+    gpuMgr.loadMicrocodeCache(stream);
+  }
+  catch(Ogre::Exception &_e)
+  {
+    gzwarn << "Unable to load compiled shaders from ["
+           << this->dataPtr->microcodeFile << "]: " << _e.getDescription()
+           << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+bool RTShaderSystem::SaveShaderCache()
+{
+  if (!this->dataPtr->initialized || this->dataPtr->microcodeFile.empty())
+    return false;
+
+  Ogre::GpuProgramManager &gpuMgr = Ogre::GpuProgramManager::getSingleton();
+  if (!gpuMgr.isCacheDirty())
+    return true;
+
+  // Write a temporary file that is renamed once complete, so that other
+  // runs never read a partial cache.
+  boost::filesystem::path tmpPath(this->dataPtr->microcodeFile + "." +
+      boost::filesystem::unique_path().string());
+  {
+    std::fstream output(tmpPath.string().c_str(),
+        std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open())
+    {
+      gzwarn << "Unable to write compiled shaders to [" << tmpPath.string()
+             << "]\n";
+      return false;
+    }
+
+    try
+    {
+      Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(
+          tmpPath.string(), &output, false));
+      gpuMgr.saveMicrocodeCache(stream);
+    }
+    catch(Ogre::Exception &_e)
+    {
+      gzwarn << "Unable to save compiled shaders: " << _e.getDescription()
+             << std::endl;
+      output.close();
+      boost::filesystem::remove(tmpPath);
+      return false;
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmpPath, this->dataPtr->microcodeFile, ec);
+  if (ec)
+  {
+    gzwarn << "Unable to save compiled shaders to ["
+           << this->dataPtr->microcodeFile << "]: " << ec.message() << "\n";
+    boost::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool RTShaderSystem::GetPaths(std::string &coreLibsPath, std::string &cachePath)
 {
@@ -428,37 +560,19 @@ bool RTShaderSystem::GetPaths(std::string &coreLibsPath, std::string &cachePath)
         {
           coreLibsPath = (*it)->archive->getName() + "/";
 #endif
-          // setup patch name for rt shader cache in tmp
-          char *tmpdir;
-          char *user;
-          std::ostringstream stream;
-          std::ostringstream errStream;
-          // Get the tmp dir
-          tmpdir = getenv("TMP");
-          if (!tmpdir)
-          {
-            common::SystemPaths *paths = common::SystemPaths::Instance();
-            tmpdir = const_cast<char*>(paths->TmpPath().c_str());
-          }
-          // Get the user
-          user = getenv("USER");
-          if (!user)
-            user = const_cast<char*>("nobody");
-          stream << tmpdir << "/gazebo-" << user << "-rtshaderlibcache" << "/";
-          cachePath = stream.str();
-          // Create the directory
-#ifdef _WIN32
-          if (_mkdir(cachePath.c_str()) != 0)
-#else
-          if (mkdir(cachePath.c_str(), S_IRUSR | S_IWUSR | S_IXUSR) != 0)
-#endif
+          // Keep the generated shaders with the other caches, so that the
+          // next runs reuse them. The programs are named after a hash of
+          // their source, which makes the directory content addressed.
+          cachePath = common::SystemPaths::Instance()->GetLogPath() +
+              "/rtshader_cache/";
+          boost::system::error_code ec;
+          boost::filesystem::create_directories(cachePath, ec);
+          if (ec)
           {
-            if (errno != EEXIST)
-            {
-              errStream << "failed to create [" << cachePath << "] : ["
-                <<  strerror(errno) << "]";
-              throw(errStream.str());
-            }
+            std::ostringstream errStream;
+            errStream << "failed to create [" << cachePath << "] : ["
+              << ec.message() << "]";
+            throw(errStream.str());
           }
 
           coreLibsFound = true;
@@ -488,6 +602,7 @@ void RTShaderSystem::RemoveShadows(ScenePtr _scene)
   if (!this->dataPtr->initialized || !this->dataPtr->shadowsApplied)
     return;
 
+  ShadowTextureCache::Invalidate();
   _scene->OgreSceneManager()->setShadowTechnique(Ogre::SHADOWTYPE_NONE);
   _scene->OgreSceneManager()->setShadowCameraSetup(
       Ogre::ShadowCameraSetupPtr());
@@ -507,6 +622,48 @@ void RTShaderSystem::RemoveShadows(ScenePtr _scene)
   this->dataPtr->shadowsApplied = false;
 }
 
+/////////////////////////////////////////////////
+void RTShaderSystem::SetLightCount(ScenePtr _scene, const int _point,
+    const int _directional, const int _spot)
+{
+  if (!this->dataPtr->initialized)
+    return;
+
+  Ogre::RTShader::RenderState *schemeRenderState =
+    this->dataPtr->shaderGenerator->getRenderState(_scene->Name() +
+        Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+
+  // Same order as Ogre::Light::LightTypes
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR >= 11
+  schemeRenderState->setLightCount(
+      Ogre::Vector3i(_point, _directional, _spot));
+#else
+  const int lightCount[3] = {_point, _directional, _spot};
+  schemeRenderState->setLightCount(lightCount);
+#endif
+  schemeRenderState->setLightCountAutoUpdate(false);
+
+  this->dataPtr->shaderGenerator->invalidateScheme(_scene->Name() +
+      Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+  this->UpdateShaders();
+}
+
+/////////////////////////////////////////////////
+void RTShaderSystem::ResetLightCount(ScenePtr _scene)
+{
+  if (!this->dataPtr->initialized)
+    return;
+
+  Ogre::RTShader::RenderState *schemeRenderState =
+    this->dataPtr->shaderGenerator->getRenderState(_scene->Name() +
+        Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+  schemeRenderState->setLightCountAutoUpdate(true);
+
+  this->dataPtr->shaderGenerator->invalidateScheme(_scene->Name() +
+      Ogre::RTShader::ShaderGenerator::DEFAULT_SCHEME_NAME);
+  this->UpdateShaders();
+}
+
 /////////////////////////////////////////////////
 void RTShaderSystem::ApplyShadows(ScenePtr _scene)
 {
@@ -515,6 +672,9 @@ void RTShaderSystem::ApplyShadows(ScenePtr _scene)
 
   Ogre::SceneManager *sceneMgr = _scene->OgreSceneManager();
 
+  // The shadow textures are configured again
+  ShadowTextureCache::Invalidate();
+
   // Grab the scheme render state.
   Ogre::RTShader::RenderState* schemRenderState =
     this->dataPtr->shaderGenerator->getRenderState(_scene->Name() +
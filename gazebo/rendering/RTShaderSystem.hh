@@ -119,6 +119,22 @@ namespace gazebo
       /// \param[in] _scene The scene to remove shadows from.
       public: void RemoveShadows(ScenePtr _scene);
 
+      /// \brief Generate the shaders of a scene for a fixed number of
+      /// lights of each type, instead of the number of lights that light
+      /// each entity. Used by clustered lighting, which gives every entity
+      /// as many lights.
+      /// \param[in] _scene The scene.
+      /// \param[in] _point Number of point lights.
+      /// \param[in] _directional Number of directional lights.
+      /// \param[in] _spot Number of spot lights.
+      public: void SetLightCount(ScenePtr _scene, const int _point,
+                  const int _directional, const int _spot);
+
+      /// \brief Generate the shaders of a scene for the lights that light
+      /// each entity again, the default.
+      /// \param[in] _scene The scene.
+      public: void ResetLightCount(ScenePtr _scene);
+
       /// \brief Get the Ogre PSSM Shadows camera setup.
       /// \return The Ogre PSSM Shadows camera setup.
       public: Ogre::PSSMShadowCameraSetup *GetPSSMShadowCameraSetup() const;
@@ -166,6 +182,25 @@ namespace gazebo
       /// \return PSSM split point overlap.
       public: double ShadowSplitPadding() const;
 
+      /// \brief Get the directory where the generated shaders and the
+      /// compiled shaders are cached across runs. It is rtshader_cache in
+      /// the log path, see GAZEBO_LOG_PATH.
+      /// \return The directory, empty if the shader system isn't
+      /// initialized.
+      public: std::string ShaderCachePath() const;
+
+      /// \brief Save the shaders compiled since the cache was loaded. This
+      /// is done by Fini(), and can be called earlier to make sure that the
+      /// cache is complete. Compiled shaders aren't cached if
+      /// GAZEBO_RTSHADER_CACHE is 0, or if the render system can't
+      /// retrieve them.
+      /// \return True if the cache is up to date.
+      public: bool SaveShaderCache();
+
+      /// \brief Load the compiled shaders of the current driver, and start
+      /// recording the new ones.
+      private: void LoadShaderCache();
+
       /// \brief Get paths for the shader system
       /// \param[out] _coreLibsPath Path to the core libraries.
       /// \param[out] _cachePath Path to where the generated shaders are
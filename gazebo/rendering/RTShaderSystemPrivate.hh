@@ -79,6 +79,13 @@ namespace gazebo
 
       /// \brief Flag to indicate if normal map should be enabled
       public: bool enableNormalMap = true;
+
+      /// \brief Directory of the generated shaders.
+      public: std::string cachePath;
+
+      /// \brief File of the compiled shaders of the current driver, empty
+      /// if compiled shaders aren't cached.
+      public: std::string microcodeFile;
     };
   }
 }
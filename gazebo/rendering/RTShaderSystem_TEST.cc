@@ -16,6 +16,12 @@
 */
 
 #include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <boost/filesystem.hpp>
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -55,6 +61,90 @@ TEST_F(RTShaderSystem_TEST, Shadows)
   EXPECT_DOUBLE_EQ(4.8, shaderSys->ShadowSplitPadding());
 }
 
+/////////////////////////////////////////////////
+TEST_F(RTShaderSystem_TEST, ShaderCache)
+{
+  Load("worlds/shapes.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  rendering::RTShaderSystem *shaderSys =
+      rendering::RTShaderSystem::Instance();
+
+  // The shaders are cached in the log path
+  const std::string cachePath = shaderSys->ShaderCachePath();
+  EXPECT_EQ(0u, cachePath.find(
+      common::SystemPaths::Instance()->GetLogPath() + "/rtshader_cache"));
+  EXPECT_TRUE(boost::filesystem::is_directory(cachePath));
+
+  // Render the shapes, which generates and compiles their shaders
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_shader_cache", false);
+  ASSERT_TRUE(camera != nullptr);
+
+  std::stringstream ss;
+  ss << "<sdf version='" << SDF_VERSION << "'>"
+     << "  <camera>"
+     << "    <horizontal_fov>0.78</horizontal_fov>"
+     << "    <image>"
+     << "      <width>320</width>"
+     << "      <height>240</height>"
+     << "      <format>R8G8B8</format>"
+     << "    </image>"
+     << "    <clip>"
+     << "      <near>0.1</near><far>100</far>"
+     << "    </clip>"
+     << "  </camera>"
+     << "</sdf>";
+  sdf::ElementPtr cameraSDF(new sdf::Element);
+  sdf::initFile("camera.sdf", cameraSDF);
+  sdf::readString(ss.str(), cameraSDF);
+  camera->Load(cameraSDF);
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_shader_cache_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 1, 0, 0, 0));
+  for (unsigned int i = 0; i < 10; ++i)
+    camera->Render(true);
+  scene->RemoveCamera(camera->Name());
+
+  unsigned int shaders = 0;
+  unsigned int microcodes = 0;
+  unsigned int partials = 0;
+  auto countFiles = [&]()
+  {
+    shaders = microcodes = partials = 0;
+    for (boost::filesystem::directory_iterator iter(cachePath), end;
+         iter != end; ++iter)
+    {
+      const std::string name = iter->path().filename().string();
+      if (name.find("microcode_") != 0)
+        ++shaders;
+      else if (iter->path().extension() == ".cache")
+        ++microcodes;
+      else
+        ++partials;
+    }
+  };
+
+  countFiles();
+  EXPECT_GT(shaders, 0u);
+
+  // The compiled shaders are saved in a file per driver, without leaving
+  // partial files behind
+  if (Ogre::GpuProgramManager::getSingleton().canGetCompiledShaderBuffer())
+  {
+    EXPECT_TRUE(shaderSys->SaveShaderCache());
+    countFiles();
+    EXPECT_GE(microcodes, 1u);
+    EXPECT_EQ(0u, partials);
+  }
+  else
+  {
+    EXPECT_FALSE(shaderSys->SaveShaderCache());
+  }
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
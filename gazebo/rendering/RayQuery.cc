@@ -19,10 +19,12 @@
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/TriangleBVH.hh"
 
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/rendering/UserCamera.hh"
 #include "gazebo/rendering/Conversions.hh"
+#include "gazebo/rendering/MeshBVHCache.hh"
 #include "gazebo/rendering/RayQueryPrivate.hh"
 #include "gazebo/rendering/RayQuery.hh"
 #include "gazebo/rendering/Scene.hh"
@@ -78,49 +80,31 @@ bool RayQuery::SelectMeshTriangle(const int _x, const int _y,
     if (!mesh)
       continue;
 
+    std::shared_ptr<const common::TriangleBVH> bvh =
+      MeshBVHCache::Instance()->MeshBVH(mesh);
+
+    // Test the ray in the frame of the mesh, so that the vertices don't
+    // need to be transformed. The distance along the ray is unchanged.
     Ogre::Matrix4 transform = visuals[i]->GetSceneNode()->_getFullTransform();
-    // test for hitting individual triangles on the mesh
-    for (unsigned int j = 0; j < mesh->GetSubMeshCount(); ++j)
+    Ogre::Matrix4 inverse = transform.inverseAffine();
+    Ogre::Vector3 origin = inverse * ray.getOrigin();
+    Ogre::Vector3 dir = inverse * (ray.getOrigin() + ray.getDirection()) -
+      origin;
+
+    double distance;
+    unsigned int triangle;
+    if (bvh->Intersect(Conversions::ConvertIgn(origin),
+          Conversions::ConvertIgn(dir), false, distance, triangle) &&
+        (closestDistance < 0.0f || distance < closestDistance))
     {
-      const common::SubMesh *submesh = mesh->GetSubMesh(j);
-      if (submesh->GetVertexCount() < 3u)
-        continue;
-      unsigned int indexCount = submesh->GetIndexCount();
-      for (unsigned int k = 0; k < indexCount; k += 3)
-      {
-        if (indexCount <= k+2)
-          continue;
-
-        ignition::math::Vector3d vertexA =
-          submesh->Vertex(submesh->GetIndex(k));
-        ignition::math::Vector3d vertexB =
-          submesh->Vertex(submesh->GetIndex(k+1));
-        ignition::math::Vector3d vertexC =
-          submesh->Vertex(submesh->GetIndex(k+2));
-
-        Ogre::Vector3 worldVertexA = transform * Conversions::Convert(vertexA);
-        Ogre::Vector3 worldVertexB = transform * Conversions::Convert(vertexB);
-        Ogre::Vector3 worldVertexC = transform * Conversions::Convert(vertexC);
-
-        // check for a hit against this triangle
-        std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(ray,
-            worldVertexA, worldVertexB, worldVertexC,
-           (worldVertexB - worldVertexA).crossProduct(
-           worldVertexC - worldVertexA));
-
-        // if it was a hit check if its the closest
-        if (hit.first &&
-            (closestDistance < 0.0f || hit.second < closestDistance))
-        {
-          // this is the closest so far, save it off
-          closestDistance = hit.second;
-          vertices.clear();
-          vertices.push_back(worldVertexA);
-          vertices.push_back(worldVertexB);
-          vertices.push_back(worldVertexC);
-          newClosestFound = true;
-        }
-      }
+      // this is the closest so far, save it off
+      closestDistance = distance;
+      ignition::math::Triangle3d tri = bvh->Triangle(triangle);
+      vertices.clear();
+      vertices.push_back(transform * Conversions::Convert(tri[0]));
+      vertices.push_back(transform * Conversions::Convert(tri[1]));
+      vertices.push_back(transform * Conversions::Convert(tri[2]));
+      newClosestFound = true;
     }
   }
 
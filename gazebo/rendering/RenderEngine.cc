@@ -25,6 +25,7 @@
 # include <X11/Xlib.h>
 # include <X11/Xutil.h>
 # include <GL/glx.h>
+# include <unistd.h>
 #endif
 
 #ifndef _WIN32
@@ -41,12 +42,15 @@
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MemoryAccounts.hh"
 #include "gazebo/common/SystemPaths.hh"
 
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Material.hh"
+#include "gazebo/rendering/MeshBVHCache.hh"
 #include "gazebo/rendering/RenderEvents.hh"
 #include "gazebo/rendering/RTShaderSystem.hh"
+#include "gazebo/rendering/TextureStreamer.hh"
 #include "gazebo/rendering/WindowManager.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/RenderTypes.hh"
@@ -265,6 +269,7 @@ void RenderEngine::PreRender()
 {
   IGN_PROFILE("rendering::RenderEngine::PreRender");
   this->dataPtr->root->_fireFrameStarted();
+  TextureStreamer::Instance()->Update();
 }
 
 //////////////////////////////////////////////////
@@ -313,6 +318,17 @@ void RenderEngine::Init()
       Ogre::TFO_ANISOTROPIC);
 
   RTShaderSystem::Instance()->Init();
+  TextureStreamer::Instance()->Init();
+
+  // Textures are held by Ogre, which keeps their total size
+  common::MemoryAccount &textures =
+      common::MemoryAccounts::Instance()->Account("rendering/textures");
+  common::MemoryAccounts::Instance()->SetProbe("rendering/textures",
+      [&textures]()
+      {
+        textures.Set(static_cast<int64_t>(
+            Ogre::TextureManager::getSingleton().getMemoryUsage()), 0);
+      });
   rendering::Material::CreateMaterials();
 
   for (unsigned int i = 0; i < this->dataPtr->scenes.size(); i++)
@@ -334,7 +350,11 @@ void RenderEngine::Fini()
 
   this->dataPtr->connections.clear();
 
+  common::MemoryAccounts::Instance()->SetProbe("rendering/textures",
+      common::MemoryAccounts::Probe());
   RTShaderSystem::Instance()->Fini();
+  TextureStreamer::Instance()->Fini();
+  MeshBVHCache::Instance()->Clear();
 
   // Deallocate memory for every scene
   while (!this->dataPtr->scenes.empty())
@@ -750,6 +770,59 @@ bool RenderEngine::CreateContext()
       return false;
     }
 
+    // On multi-GPU nodes, each screen of the X server is usually driven by
+    // its own GPU. GAZEBO_RENDER_GPU=<screen> renders on a given screen,
+    // and GAZEBO_RENDER_GPU=auto spreads the processes over the screens.
+    const char *gpuEnv = getenv("GAZEBO_RENDER_GPU");
+    const int screenCount =
+        ScreenCount(static_cast<Display*>(this->dummyDisplay));
+    if (gpuEnv && screenCount > 1)
+    {
+      int target = -1;
+      if (std::string(gpuEnv) == "auto")
+        target = getpid() % screenCount;
+      else
+      {
+        try
+        {
+          target = std::stoi(gpuEnv);
+        }
+        catch(...)
+        {
+          // Reported below
+        }
+      }
+
+      if (target < 0 || target >= screenCount)
+      {
+        gzerr << "GAZEBO_RENDER_GPU[" << gpuEnv << "] isn't a screen of "
+              << "display[" << XDisplayName(0) << "], which has "
+              << screenCount << " screens. Using the default screen.\n";
+      }
+      else if (target != DefaultScreen(this->dummyDisplay))
+      {
+        // Change DISPLAY as well, so that the render system opens the
+        // same screen as the context.
+        std::string name = XDisplayName(0);
+        const std::size_t colon = name.rfind(':');
+        const std::size_t dot = name.find('.', colon);
+        if (colon != std::string::npos && dot != std::string::npos)
+          name = name.substr(0, dot);
+        name += "." + std::to_string(target);
+
+        XCloseDisplay(static_cast<Display*>(this->dummyDisplay));
+        setenv("DISPLAY", name.c_str(), 1);
+        this->dummyDisplay = XOpenDisplay(0);
+        if (!this->dummyDisplay)
+        {
+          gzerr << "Can't open display: " << name << "\n";
+          return false;
+        }
+      }
+      gzmsg << "Rendering on screen " << DefaultScreen(this->dummyDisplay)
+            << " of display[" << XDisplayName(0) << "]\n";
+    }
+
     int screen = DefaultScreen(this->dummyDisplay);
 
     int attribList[] = {GLX_RGBA, GLX_DOUBLEBUFFER, GLX_DEPTH_SIZE, 16,
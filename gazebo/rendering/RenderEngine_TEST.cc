@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 
@@ -50,6 +53,47 @@ TEST_F(RenderEngine_TEST, FSAATest)
   }
 }
 
+/// \brief Loads the render engine with GAZEBO_RENDER_GPU set to a screen
+/// that doesn't exist.
+class RenderEngineGpu_TEST : public RenderingFixture
+{
+  /// \brief Set GAZEBO_RENDER_GPU before the render engine loads.
+  public: virtual void SetUp()
+  {
+    const char *display = getenv("DISPLAY");
+    if (display)
+      this->display = display;
+    setenv("GAZEBO_RENDER_GPU", "99", 1);
+    RenderingFixture::SetUp();
+  }
+
+  /// \brief DISPLAY before the render engine loaded.
+  protected: std::string display;
+};
+
+/////////////////////////////////////////////////
+TEST_F(RenderEngineGpu_TEST, InvalidScreen)
+{
+  Load("worlds/empty.world");
+  unsetenv("GAZEBO_RENDER_GPU");
+
+  // The default screen is used
+  const char *display = getenv("DISPLAY");
+  EXPECT_EQ(this->display, display ? std::string(display) : std::string());
+
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzwarn << "No rendering engine, skipping test" << std::endl;
+    return;
+  }
+
+  rendering::ScenePtr scene = rendering::get_scene("default");
+  if (!scene)
+    scene = rendering::create_scene("default", false);
+  EXPECT_TRUE(scene != nullptr);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
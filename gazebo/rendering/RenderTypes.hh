@@ -37,6 +37,16 @@
 /// \brief Render visuals that are selectable mask.
 #define GZ_VISIBILITY_SELECTABLE      0x00000002
 
+/// \def GZ_VISIBILITY_INSTANCED
+/// \brief Render the batches of hardware instanced visuals mask. Only
+/// the cameras that render color should include it.
+#define GZ_VISIBILITY_INSTANCED       0x00000004
+
+/// \def GZ_VISIBILITY_INSTANCE_SOURCE
+/// \brief Render the entities of hardware instanced visuals mask. The
+/// cameras that render color should exclude it.
+#define GZ_VISIBILITY_INSTANCE_SOURCE 0x00000008
+
 namespace gazebo
 {
   namespace rendering
@@ -17,6 +17,7 @@
 #include <boost/thread.hpp>
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/StartupProfiler.hh"
 
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/RenderingIface.hh"
@@ -29,6 +30,7 @@ bool g_lockstep = false;
 //////////////////////////////////////////////////
 bool rendering::load()
 {
+  common::StartupScope startupScope("rendering::load");
   bool result = true;
 
   try
@@ -47,6 +49,7 @@ bool rendering::load()
 //////////////////////////////////////////////////
 bool rendering::init()
 {
+  common::StartupScope startupScope("rendering::init");
   bool result = true;
 
   // Initialize RenderEngine
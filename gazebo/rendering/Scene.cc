@@ -15,7 +15,11 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <map>
+#include <set>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
@@ -30,7 +34,11 @@
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/MeshManager.hh"
+#include "gazebo/common/StartupProfiler.hh"
+#include "gazebo/common/TriangleBVH.hh"
 #include "gazebo/rendering/Road2d.hh"
 #include "gazebo/rendering/Projector.hh"
 #include "gazebo/rendering/Heightmap.hh"
@@ -48,6 +56,7 @@
 #include "gazebo/rendering/ContactVisual.hh"
 #include "gazebo/rendering/Conversions.hh"
 #include "gazebo/rendering/Light.hh"
+#include "gazebo/rendering/MeshBVHCache.hh"
 #include "gazebo/rendering/Visual.hh"
 #include "gazebo/rendering/RenderEngine.hh"
 #include "gazebo/rendering/UserCamera.hh"
@@ -97,6 +106,43 @@ struct VisualMessageLess {
     }
 } VisualMessageLessOp;
 
+//////////////////////////////////////////////////
+/// \brief Sort visual messages by the distance of their visual to a point.
+/// \param[in] _scene Scene of the visuals.
+/// \param[in] _origin The point.
+/// \param[in,out] _msgs The messages.
+static void SortVisualMsgs(const Scene &_scene,
+    const ignition::math::Vector3d &_origin, VisualMsgs_L &_msgs)
+{
+  // Visuals are ranked by the position of their parent, which all the
+  // messages of a visual share. The stable sort keeps their order.
+  std::map<const msgs::Visual *, double> distances;
+  for (auto const &msg : _msgs)
+  {
+    // Visuals of the world itself come first
+    if ((!msg->has_parent_id() && !msg->has_parent_name()) ||
+        msg->parent_name() == _scene.Name())
+    {
+      distances[msg.get()] = 0;
+      continue;
+    }
+
+    VisualPtr parent = msg->has_parent_id() ?
+        _scene.GetVisual(msg->parent_id()) :
+        _scene.GetVisual(msg->parent_name());
+
+    // Visuals whose parent doesn't exist yet can't be created anyway
+    distances[msg.get()] = parent ?
+        _origin.Distance(parent->WorldPose().Pos()) : ignition::math::MAX_D;
+  }
+
+  _msgs.sort([&distances](boost::shared_ptr<msgs::Visual const> _a,
+        boost::shared_ptr<msgs::Visual const> _b)
+      {
+        return distances[_a.get()] < distances[_b.get()];
+      });
+}
+
 //////////////////////////////////////////////////
 Scene::Scene()
   : dataPtr(new ScenePrivate)
@@ -133,6 +179,11 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
   this->dataPtr->name = _name;
   this->dataPtr->isServer = _isServer;
   this->dataPtr->manager = NULL;
+
+  // Sensors need the complete scene, while the GUI should stay interactive
+  // while a large world is streaming in.
+  if (!_isServer)
+    this->dataPtr->visualLoadBudget.Set(0, 10000000);
   this->dataPtr->raySceneQuery = NULL;
   this->dataPtr->skyx = NULL;
 
@@ -149,6 +200,9 @@ Scene::Scene(const std::string &_name, const bool _enableVisualizations,
                                           &Scene::OnSensorMsg, this, true);
   this->dataPtr->visSub =
       this->dataPtr->node->Subscribe("~/visual", &Scene::OnVisualMsg, this);
+  this->dataPtr->visPropertiesSub =
+      this->dataPtr->node->Subscribe("~/visual/properties",
+      &Scene::OnVisualPropertiesMsg, this);
 
   this->dataPtr->lightFactorySub =
       this->dataPtr->node->Subscribe("~/factory/light",
@@ -213,6 +267,13 @@ void Scene::Clear()
 {
   this->dataPtr->initialized = false;
 
+  // Wait for the meshes being loaded for visuals that won't be created.
+  this->dataPtr->meshLoaders.wait();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->meshLoadMutex);
+    this->dataPtr->meshLoads.clear();
+  }
+
   this->dataPtr->connections.clear();
 
   this->dataPtr->poseSub.reset();
@@ -221,6 +282,7 @@ void Scene::Clear()
   this->dataPtr->sceneSub.reset();
   this->dataPtr->skeletonPoseSub.reset();
   this->dataPtr->visSub.reset();
+  this->dataPtr->visPropertiesSub.reset();
   this->dataPtr->skySub.reset();
   this->dataPtr->lightFactorySub.reset();
   this->dataPtr->lightModifySub.reset();
@@ -239,6 +301,7 @@ void Scene::Clear()
     std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
     this->dataPtr->modelMsgs.clear();
     this->dataPtr->visualMsgs.clear();
+    this->dataPtr->visualProperties.clear();
     this->dataPtr->lightFactoryMsgs.clear();
     this->dataPtr->lightModifyMsgs.clear();
     this->dataPtr->sceneMsgs.clear();
@@ -248,10 +311,8 @@ void Scene::Clear()
     this->dataPtr->roadMsgs.clear();
   }
 
-  {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    this->dataPtr->poseMsgs.clear();
-  }
+  this->dataPtr->poseTable.Clear();
+  this->dataPtr->poseInterpolator.Clear();
 
   this->dataPtr->joints.clear();
 
@@ -263,6 +324,9 @@ void Scene::Clear()
 
   this->dataPtr->visuals.clear();
 
+  if (this->dataPtr->instancer)
+    this->dataPtr->instancer->Clear();
+
   if (this->dataPtr->originVisual)
   {
     this->dataPtr->originVisual->Fini();
@@ -275,6 +339,8 @@ void Scene::Clear()
     this->dataPtr->worldVisual.reset();
   }
 
+  this->dataPtr->lightClusterer.reset();
+
   while (!this->dataPtr->lights.empty())
     if (this->dataPtr->lights.begin()->second)
       this->RemoveLight(this->dataPtr->lights.begin()->second);
@@ -333,13 +399,19 @@ void Scene::Load(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void Scene::Load()
 {
+  common::StartupScope startupScope("Scene::Load", this->Name());
   this->dataPtr->initialized = false;
   Ogre::Root *root = RenderEngine::Instance()->Root();
 
+  if (this->dataPtr->instancer)
+    this->dataPtr->instancer->Clear();
+  this->dataPtr->lightClusterer.reset();
+
   if (this->dataPtr->manager)
     root->destroySceneManager(this->dataPtr->manager);
 
   this->dataPtr->manager = root->createSceneManager(Ogre::ST_GENERIC);
+  this->dataPtr->instancer.reset(new VisualInstancer(this->dataPtr->manager));
   this->dataPtr->manager->setAmbientLight(
       Ogre::ColourValue(0.1, 0.1, 0.1, 0.1));
 
@@ -358,6 +430,7 @@ VisualPtr Scene::WorldVisual() const
 //////////////////////////////////////////////////
 void Scene::Init()
 {
+  common::StartupScope startupScope("Scene::Init", this->Name());
   this->dataPtr->worldVisual.reset(new Visual("__world_node__",
       shared_from_this()));
   this->dataPtr->worldVisual->SetId(0);
@@ -367,6 +440,10 @@ void Scene::Init()
   RTShaderSystem::Instance()->AddScene(shared_from_this());
   RTShaderSystem::Instance()->ApplyShadows(shared_from_this());
 
+  const char *clustered = getenv("GAZEBO_CLUSTERED_LIGHTING");
+  if (clustered && std::string(clustered) == "1")
+    this->SetClusteredLighting(true);
+
   if (RenderEngine::Instance()->GetRenderPathType() == RenderEngine::DEFERRED)
     this->InitDeferredShading();
 
@@ -1093,52 +1170,63 @@ Ogre::Entity *Scene::OgreEntityAt(CameraPtr _camera,
         continue;
 
       Ogre::Entity *ogreEntity = static_cast<Ogre::Entity*>(iter->movable);
+      const Ogre::Mesh *ogreMesh = ogreEntity->getMesh().get();
+
+      // Get the triangle hierarchy of the mesh, which is built the first
+      // time the mesh is tested.
+      const std::string key = "entity:" + ogreMesh->getName() + "#" +
+        std::to_string(ogreMesh->getHandle());
+      std::shared_ptr<const common::TriangleBVH> bvh =
+        MeshBVHCache::Instance()->Find(key);
+      if (!bvh)
+      {
+        // mesh data to retrieve
+        size_t vertex_count;
+        size_t index_count;
+        Ogre::Vector3 *vertices;
+        uint64_t *indices;
+
+        // Get the mesh information, in the frame of the mesh
+        this->MeshInformation(ogreMesh, vertex_count, vertices, index_count,
+            indices, ignition::math::Vector3d::Zero,
+            ignition::math::Quaterniond::Identity,
+            ignition::math::Vector3d::One);
+
+        std::vector<ignition::math::Vector3d> meshVertices(vertex_count);
+        for (size_t i = 0; i < vertex_count; ++i)
+          meshVertices[i] = Conversions::ConvertIgn(vertices[i]);
+        std::vector<unsigned int> meshIndices(indices, indices + index_count);
+
+        delete [] vertices;
+        delete [] indices;
+
+        bvh = MeshBVHCache::Instance()->Add(key, meshVertices, meshIndices);
+      }
 
-      // mesh data to retrieve
-      size_t vertex_count;
-      size_t index_count;
-      Ogre::Vector3 *vertices;
-      uint64_t *indices;
-
-      // Get the mesh information
-      this->MeshInformation(ogreEntity->getMesh().get(), vertex_count,
-          vertices, index_count, indices,
-          Conversions::ConvertIgn(
-            ogreEntity->getParentNode()->_getDerivedPosition()),
-          Conversions::ConvertIgn(
-          ogreEntity->getParentNode()->_getDerivedOrientation()),
-          Conversions::ConvertIgn(
-          ogreEntity->getParentNode()->_getDerivedScale()));
+      // Test the ray in the frame of the mesh. Only front faces are hit,
+      // unless the node mirrors the mesh.
+      Ogre::Matrix4 transform =
+        ogreEntity->getParentNode()->_getFullTransform();
+      Ogre::Matrix4 inverse = transform.inverseAffine();
+      Ogre::Vector3 origin = inverse * mouseRay.getOrigin();
+      Ogre::Vector3 dir =
+        inverse * (mouseRay.getOrigin() + mouseRay.getDirection()) - origin;
 
       bool new_closest_found = false;
-      for (int i = 0; i < static_cast<int>(index_count); i += 3)
+      double distance;
+      unsigned int triangle;
+      if (bvh->Intersect(Conversions::ConvertIgn(origin),
+            Conversions::ConvertIgn(dir), transform.determinant() > 0,
+            distance, triangle))
       {
-        // when indices size is not divisible by 3
-        if (i+2 >= static_cast<int>(index_count))
-          break;
-
-        // check for a hit against this triangle
-        std::pair<bool, Ogre::Real> hit = Ogre::Math::intersects(mouseRay,
-            vertices[indices[i]],
-            vertices[indices[i+1]],
-            vertices[indices[i+2]],
-            true, false);
-
-        // if it was a hit check if its the closest
-        if (hit.first)
+        if ((closest_distance < 0.0f) || (distance < closest_distance))
         {
-          if ((closest_distance < 0.0f) || (hit.second < closest_distance))
-          {
-            // this is the closest so far, save it off
-            closest_distance = hit.second;
-            new_closest_found = true;
-          }
+          // this is the closest so far, save it off
+          closest_distance = distance;
+          new_closest_found = true;
         }
       }
 
-      delete [] vertices;
-      delete [] indices;
-
       if (new_closest_found)
       {
         closestEntity = ogreEntity;
@@ -1532,24 +1620,12 @@ void Scene::MeshInformation(const Ogre::Mesh *_mesh,
 /////////////////////////////////////////////////
 bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 {
+  for (int i = 0; i < _msg->model_size(); ++i)
   {
-    std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-    for (int i = 0; i < _msg->model_size(); ++i)
-    {
-      PoseMsgs_M::iterator iter =
-          this->dataPtr->poseMsgs.find(_msg->model(i).id());
-      if (iter != this->dataPtr->poseMsgs.end())
-        iter->second.CopyFrom(_msg->model(i).pose());
-      else
-        this->dataPtr->poseMsgs.insert(
-            std::make_pair(_msg->model(i).id(), _msg->model(i).pose()));
-
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_name(
-          _msg->model(i).name());
-      this->dataPtr->poseMsgs[_msg->model(i).id()].set_id(_msg->model(i).id());
+    this->dataPtr->poseTable.Set(_msg->model(i).id(),
+        msgs::ConvertIgn(_msg->model(i).pose()));
 
-      this->ProcessModelMsg(_msg->model(i));
-    }
+    this->ProcessModelMsg(_msg->model(i));
   }
 
   for (int i = 0; i < _msg->light_size(); ++i)
@@ -1630,9 +1706,6 @@ bool Scene::ProcessSceneMsg(ConstScenePtr &_msg)
 //////////////////////////////////////////////////
 bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 {
-  std::string modelName, linkName;
-
-  modelName = _msg.name() + "::";
   for (int j = 0; j < _msg.visual_size(); ++j)
   {
     boost::shared_ptr<msgs::Visual> vm(new msgs::Visual(
@@ -1671,23 +1744,10 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 
   for (int j = 0; j < _msg.link_size(); ++j)
   {
-    linkName = modelName + _msg.link(j).name();
-
+    if (_msg.link(j).has_pose())
     {
-      std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
-      if (_msg.link(j).has_pose())
-      {
-        PoseMsgs_M::iterator iter =
-            this->dataPtr->poseMsgs.find(_msg.link(j).id());
-        if (iter != this->dataPtr->poseMsgs.end())
-          iter->second.CopyFrom(_msg.link(j).pose());
-        else
-          this->dataPtr->poseMsgs.insert(
-              std::make_pair(_msg.link(j).id(), _msg.link(j).pose()));
-
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_name(linkName);
-        this->dataPtr->poseMsgs[_msg.link(j).id()].set_id(_msg.link(j).id());
-      }
+      this->dataPtr->poseTable.Set(_msg.link(j).id(),
+          msgs::ConvertIgn(_msg.link(j).pose()));
     }
 
     if (_msg.link(j).has_inertial())
@@ -1749,6 +1809,7 @@ bool Scene::ProcessModelMsg(const msgs::Model &_msg)
 void Scene::OnSensorMsg(ConstSensorPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->sensorMsgs.push_back(_msg);
 }
 
@@ -1756,9 +1817,72 @@ void Scene::OnSensorMsg(ConstSensorPtr &_msg)
 void Scene::OnVisualMsg(ConstVisualPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->visualMsgs.push_back(_msg);
 }
 
+//////////////////////////////////////////////////
+void Scene::OnVisualPropertiesMsg(ConstVisualPropertiesPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
+  for (const auto &property : _msg->property())
+    this->dataPtr->visualProperties[property.id()].MergeFrom(property);
+}
+
+//////////////////////////////////////////////////
+void Scene::ApplyVisualProperties()
+{
+  VisualProperties_M properties;
+  {
+    std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+    if (this->dataPtr->visualProperties.empty())
+      return;
+    std::swap(properties, this->dataPtr->visualProperties);
+  }
+
+  for (auto iter = properties.begin(); iter != properties.end();)
+  {
+    auto visIter = this->dataPtr->visuals.find(iter->first);
+    if (visIter == this->dataPtr->visuals.end())
+    {
+      ++iter;
+      continue;
+    }
+
+    const msgs::VisualProperties::Property &property = iter->second;
+    const VisualPtr &vis = visIter->second;
+    if (property.has_ambient())
+      vis->SetAmbient(msgs::Convert(property.ambient()));
+    if (property.has_diffuse())
+      vis->SetDiffuse(msgs::Convert(property.diffuse()));
+    if (property.has_specular())
+      vis->SetSpecular(msgs::Convert(property.specular()));
+    if (property.has_emissive())
+      vis->SetEmissive(msgs::Convert(property.emissive()));
+    if (property.has_transparency())
+      vis->SetTransparency(property.transparency());
+    if (property.has_visible())
+      vis->SetVisible(property.visible());
+
+    properties.erase(iter++);
+  }
+
+  if (properties.empty())
+    return;
+
+  // Keep the changes of the visuals that don't exist yet, under the ones
+  // received meanwhile.
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  for (auto &entry : properties)
+  {
+    auto newer = this->dataPtr->visualProperties.find(entry.first);
+    if (newer != this->dataPtr->visualProperties.end())
+      entry.second.MergeFrom(newer->second);
+    this->dataPtr->visualProperties[entry.first] = entry.second;
+  }
+}
+
 //////////////////////////////////////////////////
 void Scene::PreRender()
 {
@@ -1813,7 +1937,6 @@ void Scene::PreRender()
   static ModelMsgs_L::iterator modelIter;
   static VisualMsgs_L::iterator visualIter;
   static LightMsgs_L::iterator lightIter;
-  static PoseMsgs_M::iterator pIter;
   static SkeletonPoseMsgs_L::iterator spIter;
   static JointMsgs_L::iterator jointIter;
   static SensorMsgs_L::iterator sensorIter;
@@ -1944,9 +2067,33 @@ void Scene::PreRender()
       ++visualIter;
   }
 
-  // Process the visual messages.
+  // Process the visual messages. With a load budget, the visuals closest
+  // to the user camera are created first, and the others wait for the
+  // next frames.
+  const common::Time budget = this->dataPtr->visualLoadBudget;
+  if (budget > common::Time::Zero && !this->dataPtr->userCameras.empty() &&
+      visualMsgsCopy.size() > 1u)
+  {
+    SortVisualMsgs(*this, this->dataPtr->userCameras[0]->WorldPosition(),
+        visualMsgsCopy);
+  }
+
+  const common::Time loadStart = common::Time::GetWallTime();
+  std::set<std::string> deferred;
   for (visualIter = visualMsgsCopy.begin(); visualIter != visualMsgsCopy.end();)
   {
+    // The messages of a visual are processed in order, so once one of them
+    // waits, the following ones wait too.
+    if (budget > common::Time::Zero &&
+        (deferred.count((*visualIter)->name()) > 0 ||
+         common::Time::GetWallTime() - loadStart > budget ||
+         !this->VisualMeshLoaded(**visualIter)))
+    {
+      deferred.insert((*visualIter)->name());
+      ++visualIter;
+      continue;
+    }
+
     Visual::VisualType visualType = Visual::VT_VISUAL;
     if ((*visualIter)->has_type())
       visualType = Visual::ConvertVisualType((*visualIter)->type());
@@ -1957,6 +2104,9 @@ void Scene::PreRender()
       ++visualIter;
   }
 
+  // Apply the appearance changes once the visuals they change may exist.
+  this->ApplyVisualProperties();
+
   // Process the collision visual messages.
   for (visualIter = collisionVisualMsgsCopy.begin();
       visualIter != collisionVisualMsgsCopy.end();)
@@ -2038,8 +2188,10 @@ void Scene::PreRender()
     std::copy(linkVisualMsgsCopy.begin(), linkVisualMsgsCopy.end(),
         std::front_inserter(this->dataPtr->linkVisualMsgs));
 
-    std::copy(visualMsgsCopy.begin(), visualMsgsCopy.end(),
-        std::front_inserter(this->dataPtr->visualMsgs));
+    // Keep the order of the messages that wait, which are older than the
+    // ones received meanwhile.
+    this->dataPtr->visualMsgs.insert(this->dataPtr->visualMsgs.begin(),
+        visualMsgsCopy.begin(), visualMsgsCopy.end());
 
     std::copy(collisionVisualMsgsCopy.begin(), collisionVisualMsgsCopy.end(),
         std::front_inserter(this->dataPtr->collisionVisualMsgs));
@@ -2057,45 +2209,47 @@ void Scene::PreRender()
   {
     std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
 
-    // Process all the model messages last. Remove pose message from the list
-    // only when a corresponding visual exits. We may receive pose updates
-    // over the wire before  we recieve the visual
-    pIter = this->dataPtr->poseMsgs.begin();
-    while (pIter != this->dataPtr->poseMsgs.end())
-    {
-      Visual_M::iterator iter = this->dataPtr->visuals.find(pIter->first);
-      if (iter != this->dataPtr->visuals.end() && iter->second)
-      {
-        // If an object is selected, don't let the physics engine move it.
-        if (!this->dataPtr->selectedVis
-            || this->dataPtr->selectionMode != "move" ||
-            (iter->first != this->dataPtr->selectedVis->GetId() &&
-            !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
+    // Process all the model poses last. A pose stays pending until a
+    // corresponding visual exists. We may receive pose updates over the
+    // wire before we recieve the visual
+    const PoseTable::ApplyFunc applyPose =
+        [this](const uint32_t _id, const ignition::math::Pose3d &_pose)
         {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          GZ_ASSERT(iter->second, "Visual pointer is NULL");
-          iter->second->SetPose(pose);
-          PoseMsgs_M::iterator prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
-        }
-        else
-          ++pIter;
-      }
-      else
-      {
-        // process light pose messages
-        auto lIter = this->dataPtr->lights.find(pIter->first);
-        if (lIter != this->dataPtr->lights.end())
-        {
-          ignition::math::Pose3d pose = msgs::ConvertIgn(pIter->second);
-          lIter->second->SetPosition(pose.Pos());
-          lIter->second->SetRotation(pose.Rot());
-          auto prev = pIter++;
-          this->dataPtr->poseMsgs.erase(prev);
-        }
-        else
-          ++pIter;
-      }
+          Visual_M::iterator iter = this->dataPtr->visuals.find(_id);
+          if (iter != this->dataPtr->visuals.end() && iter->second)
+          {
+            // If an object is selected, don't let the physics engine move
+            // it.
+            if (this->dataPtr->selectedVis &&
+                this->dataPtr->selectionMode == "move" &&
+                (iter->first == this->dataPtr->selectedVis->GetId() ||
+                this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
+            {
+              return false;
+            }
+            iter->second->SetPose(_pose);
+            return true;
+          }
+
+          // process light poses
+          auto lIter = this->dataPtr->lights.find(_id);
+          if (lIter != this->dataPtr->lights.end())
+          {
+            lIter->second->SetPosition(_pose.Pos());
+            lIter->second->SetRotation(_pose.Rot());
+            return true;
+          }
+          return false;
+        };
+    this->dataPtr->poseTable.Apply(applyPose);
+
+    // Interpolated poses of the pose messages
+    if (this->dataPtr->poseInterpolation)
+    {
+      this->dataPtr->poseInterpolator.Apply(
+          std::chrono::duration<double>(
+            std::chrono::steady_clock::now().time_since_epoch()).count(),
+          applyPose);
     }
 
     // process skeleton pose msgs
@@ -2104,7 +2258,15 @@ void Scene::PreRender()
     {
       Visual_M::iterator iter =
           this->dataPtr->visuals.find((*spIter)->model_id());
-      for (int i = 0; i < (*spIter)->pose_size(); ++i)
+
+      // If an object is selected, don't let the physics engine move it.
+      const bool movable = !this->dataPtr->selectedVis ||
+          this->dataPtr->selectionMode != "move" ||
+          iter == this->dataPtr->visuals.end() ||
+          (iter->first != this->dataPtr->selectedVis->GetId() &&
+          !this->dataPtr->selectedVis->IsAncestorOf(iter->second));
+
+      for (int i = 0; movable && i < (*spIter)->pose_size(); ++i)
       {
         const msgs::Pose& pose_msg = (*spIter)->pose(i);
         if (pose_msg.has_id())
@@ -2112,19 +2274,28 @@ void Scene::PreRender()
           Visual_M::iterator iter2 = this->dataPtr->visuals.find(pose_msg.id());
           if (iter2 != this->dataPtr->visuals.end())
           {
-            // If an object is selected, don't let the physics engine move it.
-            if (!this->dataPtr->selectedVis ||
-                this->dataPtr->selectionMode != "move" ||
-                (iter->first != this->dataPtr->selectedVis->GetId()&&
-                !this->dataPtr->selectedVis->IsAncestorOf(iter->second)))
-            {
-              ignition::math::Pose3d pose = msgs::ConvertIgn(pose_msg);
-              iter2->second->SetPose(pose);
-            }
+            ignition::math::Pose3d pose = msgs::ConvertIgn(pose_msg);
+            iter2->second->SetPose(pose);
           }
         }
       }
 
+      // Compact link poses, as x, y, z, qw, qx, qy, qz
+      const int linkCount = std::min((*spIter)->link_id_size(),
+          (*spIter)->link_pose_size() / 7);
+      const float *linkPoses = (*spIter)->link_pose().data();
+      for (int i = 0; movable && i < linkCount; ++i)
+      {
+        Visual_M::iterator iter2 =
+            this->dataPtr->visuals.find((*spIter)->link_id(i));
+        if (iter2 != this->dataPtr->visuals.end())
+        {
+          const float *p = linkPoses + i * 7;
+          iter2->second->SetPose(ignition::math::Pose3d(
+              p[0], p[1], p[2], p[3], p[4], p[5], p[6]));
+        }
+      }
+
       if (iter != this->dataPtr->visuals.end())
       {
         iter->second->SetSkeletonPose(*(*spIter).get());
@@ -2167,6 +2338,7 @@ void Scene::PreRender()
 void Scene::OnJointMsg(ConstJointPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->jointMsgs.push_back(_msg);
 }
 
@@ -2417,6 +2589,7 @@ bool Scene::ProcessJointMsg(ConstJointPtr &_msg)
 void Scene::OnScene(ConstScenePtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->sceneMsgs.push_back(_msg);
 }
 
@@ -2440,6 +2613,7 @@ void Scene::OnResponse(ConstResponsePtr &_msg)
 void Scene::OnRequest(ConstRequestPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->requestMsgs.push_back(_msg);
 }
 
@@ -2498,6 +2672,10 @@ void Scene::ProcessRequestMsg(ConstRequestPtr &_msg)
         this->RemoveVisual(visPtr);
     }
   }
+  else if (_msg->request() == "entities_delete")
+  {
+    this->RemoveEntities(msgs::DeletedEntities(*_msg));
+  }
   else if (_msg->request() == "show_contact")
   {
     this->ShowContacts(true);
@@ -2727,6 +2905,10 @@ bool Scene::ProcessVisualMsg(ConstVisualPtr &_msg, Visual::VisualType _type)
   {
     if (iter != this->dataPtr->visuals.end())
     {
+      {
+        std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+        this->dataPtr->visualProperties.erase(iter->first);
+      }
       this->dataPtr->visuals.erase(iter);
       return true;
     }
@@ -2867,20 +3049,34 @@ common::Time Scene::SimTime() const
 /////////////////////////////////////////////////
 void Scene::OnPoseMsg(ConstPosesStampedPtr &_msg)
 {
+  ++this->dataPtr->changeCount;
+  if (this->dataPtr->poseInterpolation)
+  {
+    PoseInterpolator::Poses poses;
+    poses.reserve(_msg->pose_size());
+    for (int i = 0; i < _msg->pose_size(); ++i)
+    {
+      const msgs::Pose &p = _msg->pose(i);
+      poses.push_back(std::make_pair(p.id(), msgs::ConvertIgn(p)));
+    }
+    this->dataPtr->poseInterpolator.Add(
+        common::Time(_msg->time().sec(), _msg->time().nsec()).Double(),
+        std::chrono::duration<double>(
+          std::chrono::steady_clock::now().time_since_epoch()).count(),
+        poses);
+  }
+  else
+  {
+    for (int i = 0; i < _msg->pose_size(); ++i)
+    {
+      const msgs::Pose &p = _msg->pose(i);
+      this->dataPtr->poseTable.Set(p.id(), msgs::ConvertIgn(p));
+    }
+  }
+
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
   this->dataPtr->sceneSimTimePosesReceived =
     common::Time(_msg->time().sec(), _msg->time().nsec());
-
-  for (int i = 0; i < _msg->pose_size(); ++i)
-  {
-    auto p = _msg->pose(i);
-    PoseMsgs_M::iterator iter =
-        this->dataPtr->poseMsgs.find(p.id());
-    if (iter != this->dataPtr->poseMsgs.end())
-      iter->second.CopyFrom(p);
-    else
-      this->dataPtr->poseMsgs.insert(std::make_pair(p.id(), p));
-  }
 }
 
 /////////////////////////////////////////////////
@@ -2915,6 +3111,7 @@ bool Scene::WaitForRenderRequest(double _timeoutsec)
 /////////////////////////////////////////////////
 void Scene::OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg)
 {
+  ++this->dataPtr->changeCount;
   std::lock_guard<std::recursive_mutex> lock(this->dataPtr->poseMsgMutex);
   SkeletonPoseMsgs_L::iterator iter;
 
@@ -2936,6 +3133,7 @@ void Scene::OnSkeletonPoseMsg(ConstPoseAnimationPtr &_msg)
 void Scene::OnRoadMsg(ConstRoadPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->roadMsgs.push_back(_msg);
 }
 
@@ -2943,6 +3141,7 @@ void Scene::OnRoadMsg(ConstRoadPtr &_msg)
 void Scene::OnLightFactoryMsg(ConstLightPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->lightFactoryMsgs.push_back(_msg);
 }
 
@@ -2950,6 +3149,7 @@ void Scene::OnLightFactoryMsg(ConstLightPtr &_msg)
 void Scene::OnLightModifyMsg(ConstLightPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->lightModifyMsgs.push_back(_msg);
 }
 
@@ -3011,12 +3211,15 @@ bool Scene::ProcessLightModifyMsg(ConstLightPtr &_msg)
 void Scene::OnModelMsg(ConstModelPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  ++this->dataPtr->changeCount;
   this->dataPtr->modelMsgs.push_back(_msg);
 }
 
 /////////////////////////////////////////////////
 void Scene::OnSkyMsg(ConstSkyPtr &_msg)
 {
+  ++this->dataPtr->changeCount;
+
   if (!this->dataPtr->skyx)
     return;
 
@@ -3331,6 +3534,74 @@ void Scene::RemoveVisual(uint32_t _id)
   }
 }
 
+/////////////////////////////////////////////////
+void Scene::RemoveEntities(const std::vector<std::string> &_names)
+{
+  std::set<Visual *> removed;
+  std::set<std::string> roots;
+  for (auto const &name : _names)
+  {
+    LightPtr light = this->LightByName(name);
+    if (light)
+    {
+      this->RemoveLight(light);
+      continue;
+    }
+
+    VisualPtr vis = this->GetVisual(name);
+    if (vis)
+    {
+      removed.insert(vis.get());
+      roots.insert(vis->GetRootVisual()->Name());
+    }
+  }
+
+  if (removed.empty())
+    return;
+
+  // Remove the projectors of the removed models
+  auto piter = this->dataPtr->projectors.begin();
+  while (piter != this->dataPtr->projectors.end())
+  {
+    if (roots.count(piter->second->GetParent()->GetRootVisual()->Name()))
+    {
+      delete piter->second;
+      this->dataPtr->projectors.erase(piter++);
+    }
+    else
+      ++piter;
+  }
+
+  // One pass over the visuals finds the removed visuals and their
+  // descendants, which go away with them
+  std::vector<VisualPtr> toFini;
+  auto iter = this->dataPtr->visuals.begin();
+  while (iter != this->dataPtr->visuals.end())
+  {
+    bool remove = false;
+    for (VisualPtr vis = iter->second; vis && !remove; vis = vis->GetParent())
+      remove = removed.count(vis.get()) > 0;
+
+    if (!remove)
+    {
+      ++iter;
+      continue;
+    }
+
+    if (removed.count(iter->second.get()))
+      toFini.push_back(iter->second);
+    if (this->dataPtr->selectedVis == iter->second)
+      this->dataPtr->selectedVis.reset();
+    iter = this->dataPtr->visuals.erase(iter);
+  }
+
+  for (auto &vis : toFini)
+  {
+    this->RemoveVisualizations(vis);
+    vis->Fini();
+  }
+}
+
 /////////////////////////////////////////////////
 void Scene::RemoveVisual(VisualPtr _vis)
 {
@@ -3447,6 +3718,22 @@ double Scene::HeightmapSkirtLength() const
   return this->dataPtr->heightmapSkirtLength;
 }
 
+/////////////////////////////////////////////////
+void Scene::SetPoseInterpolation(const bool _enable)
+{
+  if (this->dataPtr->poseInterpolation == _enable)
+    return;
+
+  this->dataPtr->poseInterpolation = _enable;
+  this->dataPtr->poseInterpolator.Clear();
+}
+
+/////////////////////////////////////////////////
+bool Scene::PoseInterpolation() const
+{
+  return this->dataPtr->poseInterpolation;
+}
+
 /////////////////////////////////////////////////
 void Scene::CreateCOMVisual(ConstLinkPtr &_msg, VisualPtr _linkVisual)
 {
@@ -3740,3 +4027,201 @@ bool Scene::EnableVisualizations() const
 {
   return this->dataPtr->enableVisualizations;
 }
+
+/////////////////////////////////////////////////
+void Scene::SetInstancingThreshold(const unsigned int _count)
+{
+  if (!this->dataPtr->instancer)
+    return;
+
+  this->dataPtr->instancer->SetThreshold(_count);
+
+  // Visuals aren't tracked while instancing is disabled
+  for (auto const &vis : this->dataPtr->visuals)
+    this->dataPtr->instancer->Update(vis.second.get());
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::InstancingThreshold() const
+{
+  return this->dataPtr->instancer ? this->dataPtr->instancer->Threshold() : 0;
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::InstancedVisualCount() const
+{
+  return this->dataPtr->instancer ?
+      this->dataPtr->instancer->InstancedCount() : 0;
+}
+
+/////////////////////////////////////////////////
+void Scene::UpdateInstancing(Visual *_vis)
+{
+  if (!this->dataPtr->instancer || !_vis)
+    return;
+
+  // Visuals are checked once they are loaded and added to the scene
+  auto iter = this->dataPtr->visuals.find(_vis->GetId());
+  if (iter != this->dataPtr->visuals.end() && iter->second.get() == _vis)
+    this->dataPtr->instancer->Update(_vis);
+}
+
+/////////////////////////////////////////////////
+void Scene::RemoveInstancing(Visual *_vis)
+{
+  if (this->dataPtr->instancer)
+    this->dataPtr->instancer->Remove(_vis);
+}
+
+/////////////////////////////////////////////////
+void Scene::SetClusteredLighting(const bool _enable)
+{
+  if (_enable == this->ClusteredLighting() || !this->dataPtr->manager)
+    return;
+
+  // 8 lights in all, the default max_lights of a pass
+  const int pointLights = 4;
+  const int directionalLights = 1;
+  const int spotLights = 3;
+
+  if (_enable)
+  {
+    this->dataPtr->lightClusterer.reset(new LightClusterer(
+        this->dataPtr->manager, pointLights, directionalLights, spotLights));
+    RTShaderSystem::Instance()->SetLightCount(shared_from_this(),
+        pointLights, directionalLights, spotLights);
+  }
+  else
+  {
+    this->dataPtr->lightClusterer.reset();
+    RTShaderSystem::Instance()->ResetLightCount(shared_from_this());
+  }
+}
+
+/////////////////////////////////////////////////
+bool Scene::ClusteredLighting() const
+{
+  return this->dataPtr->lightClusterer != nullptr;
+}
+
+/////////////////////////////////////////////////
+void Scene::SetVisualLoadBudget(const common::Time &_budget)
+{
+  this->dataPtr->visualLoadBudget = _budget;
+}
+
+/////////////////////////////////////////////////
+common::Time Scene::VisualLoadBudget() const
+{
+  return this->dataPtr->visualLoadBudget;
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::PendingVisualCount() const
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  return this->dataPtr->visualMsgs.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t Scene::ChangeCount() const
+{
+  return this->dataPtr->changeCount;
+}
+
+/////////////////////////////////////////////////
+void Scene::MarkChanged()
+{
+  ++this->dataPtr->changeCount;
+}
+
+/////////////////////////////////////////////////
+unsigned int Scene::PendingVisualPropertyCount() const
+{
+  std::lock_guard<std::mutex> lock(*this->dataPtr->receiveMutex);
+  return this->dataPtr->visualProperties.size();
+}
+
+/////////////////////////////////////////////////
+bool Scene::VisualMeshLoaded(const msgs::Visual &_msg)
+{
+  // Polylines are extruded by worker threads, under the name the visual
+  // gives to their mesh.
+  if (_msg.has_geometry() &&
+      _msg.geometry().type() == msgs::Geometry::POLYLINE &&
+      _msg.geometry().polyline_size() > 0)
+  {
+    const std::string name = _msg.name();
+    const std::string key = "polyline://" + name;
+
+    std::lock_guard<std::mutex> lock(this->dataPtr->meshLoadMutex);
+    auto iter = this->dataPtr->meshLoads.find(key);
+    if (iter != this->dataPtr->meshLoads.end())
+      return iter->second;
+
+    this->dataPtr->meshLoads[key] = false;
+
+    std::vector<std::vector<ignition::math::Vector2d> > polylines;
+    for (int i = 0; i < _msg.geometry().polyline_size(); ++i)
+    {
+      const msgs::Polyline &polyline = _msg.geometry().polyline(i);
+      polylines.push_back(std::vector<ignition::math::Vector2d>());
+      for (int j = 0; j < polyline.point_size(); ++j)
+        polylines.back().push_back(msgs::ConvertIgn(polyline.point(j)));
+    }
+    const double height = _msg.geometry().polyline(0).height();
+
+    ScenePrivate *dataPtr = this->dataPtr;
+    this->dataPtr->meshLoaders.run([dataPtr, key, name, polylines, height]()
+    {
+      common::MeshManager::Instance()->CreateExtrudedPolyline(name,
+          polylines, height);
+
+      std::lock_guard<std::mutex> loadLock(dataPtr->meshLoadMutex);
+      dataPtr->meshLoads[key] = true;
+    });
+
+    return false;
+  }
+
+  if (!_msg.has_geometry() ||
+      _msg.geometry().type() != msgs::Geometry::MESH ||
+      !_msg.geometry().has_mesh())
+  {
+    return true;
+  }
+
+  const std::string uri = _msg.geometry().mesh().filename();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->meshLoadMutex);
+  auto iter = this->dataPtr->meshLoads.find(uri);
+  if (iter != this->dataPtr->meshLoads.end())
+    return iter->second;
+
+  this->dataPtr->meshLoads[uri] = false;
+
+  // Meshes are resolved and decoded by worker threads. The Ogre mesh and
+  // the textures are still created by the render thread.
+  ScenePrivate *dataPtr = this->dataPtr;
+  this->dataPtr->meshLoaders.run([dataPtr, uri]()
+  {
+    const std::string filename = common::find_file(uri);
+    if (!filename.empty() &&
+        common::MeshManager::Instance()->IsValidFilename(filename))
+    {
+      try
+      {
+        common::MeshManager::Instance()->Load(filename);
+      }
+      catch(common::Exception &)
+      {
+        // Reported again when the visual is loaded.
+      }
+    }
+
+    std::lock_guard<std::mutex> loadLock(dataPtr->meshLoadMutex);
+    dataPtr->meshLoads[uri] = true;
+  });
+
+  return false;
+}
@@ -486,6 +486,19 @@ namespace gazebo
       /// \sa Heightmap::SkirtLength
       public: double HeightmapSkirtLength() const;
 
+      /// \brief Set whether the poses received from the server are
+      /// interpolated at display rate. Motion is then smooth when the
+      /// server publishes poses at a low rate, at the cost of a delay of
+      /// about one publication interval.
+      /// \param[in] _enable True to interpolate the poses.
+      public: void SetPoseInterpolation(const bool _enable);
+
+      /// \brief Get whether the poses received from the server are
+      /// interpolated.
+      /// \return True if the poses are interpolated.
+      /// \sa SetPoseInterpolation
+      public: bool PoseInterpolation() const;
+
       /// \brief Clear rendering::Scene
       public: void Clear();
 
@@ -605,6 +618,95 @@ namespace gazebo
       /// \sa EnableVisualizations(bool)
       public: bool EnableVisualizations() const;
 
+      /// \brief Draw the visuals that share a mesh and a material with
+      /// hardware instancing, once there are enough of them. Instanced
+      /// visuals are still selectable, can be hidden and cast shadows,
+      /// but don't receive shadows. A visual that becomes transparent, or
+      /// whose material stops being shared, is drawn on its own again.
+      /// \param[in] _count Number of visuals a mesh and material must be
+      /// shared by to be instanced, or 0 to disable instancing.
+      /// \sa InstancingThreshold()
+      public: void SetInstancingThreshold(const unsigned int _count);
+
+      /// \brief Get the number of visuals a mesh and material must be
+      /// shared by to be instanced.
+      /// \return The threshold, 0 if instancing is disabled.
+      /// \sa SetInstancingThreshold(const unsigned int)
+      public: unsigned int InstancingThreshold() const;
+
+      /// \brief Get the number of visuals drawn with hardware instancing.
+      /// \return Number of instanced visuals.
+      public: unsigned int InstancedVisualCount() const;
+
+      /// \internal
+      /// \brief Check whether a visual can be instanced, after it was
+      /// loaded or its mesh, material or visibility flags changed. Called
+      /// by Visual.
+      /// \param[in] _vis The visual.
+      public: void UpdateInstancing(Visual *_vis);
+
+      /// \internal
+      /// \brief Stop instancing a visual. Called by Visual.
+      /// \param[in] _vis The visual.
+      public: void RemoveInstancing(Visual *_vis);
+
+      /// \brief Light every entity with a fixed number of the lights
+      /// that reach it: up to 4 point lights, 1 directional light and 3
+      /// spot lights, the brightest at the entity. The lights are chosen
+      /// from a cluster grid built once per camera frame, and the shaders
+      /// are generated once for that light budget, so that scenes with
+      /// many lights render at a steady cost. Only affects the forward
+      /// render path. Can also be enabled by setting the
+      /// GAZEBO_CLUSTERED_LIGHTING environment variable to 1.
+      /// \param[in] _enable True to enable clustered lighting.
+      /// \sa ClusteredLighting()
+      public: void SetClusteredLighting(const bool _enable);
+
+      /// \brief Get whether clustered lighting is enabled.
+      /// \return True if enabled.
+      /// \sa SetClusteredLighting(const bool)
+      public: bool ClusteredLighting() const;
+
+      /// \brief Set how long each frame may spend creating the visuals
+      /// received from the server. While the budget is positive, the meshes
+      /// of new visuals are loaded by worker threads, and the visuals
+      /// closest to the first user camera are created first. The others
+      /// are created by the next frames, so that rendering stays
+      /// interactive while a large world streams in. The default is 10 ms
+      /// for GUI scenes, and no limit for server scenes.
+      /// \param[in] _budget Wall time per frame, 0 to create all the
+      /// visuals as soon as they are received.
+      /// \sa VisualLoadBudget()
+      public: void SetVisualLoadBudget(const common::Time &_budget);
+
+      /// \brief Get how long each frame may spend creating visuals.
+      /// \return Wall time per frame, 0 if there is no limit.
+      /// \sa SetVisualLoadBudget(const common::Time &)
+      public: common::Time VisualLoadBudget() const;
+
+      /// \brief Get the number of visual messages waiting to be processed,
+      /// e.g. to show the progress of the world loading.
+      /// \return Number of pending visual messages.
+      public: unsigned int PendingVisualCount() const;
+
+      /// \brief Get the number of visuals whose appearance changes, from
+      /// the ~/visual/properties topic, wait to be applied. Changes to
+      /// visuals that don't exist yet wait until they're created.
+      /// \return Number of visuals with pending changes.
+      public: unsigned int PendingVisualPropertyCount() const;
+
+      /// \brief Get the number of changes received by the scene, such as
+      /// poses, visuals, lights and markers. It lets a renderer tell if the
+      /// scene changed since its last frame.
+      /// \return The number of changes, which only grows.
+      /// \sa MarkChanged()
+      public: uint64_t ChangeCount() const;
+
+      /// \brief Count a change made to the scene outside of its topics,
+      /// such as by a plugin, so that renderers that only draw changes
+      /// draw it.
+      public: void MarkChanged();
+
       /// \brief Helper function to setup the sky.
       private: void SetSky();
 
@@ -691,6 +793,20 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void OnVisualMsg(ConstVisualPtr &_msg);
 
+      /// \brief Visual properties message callback.
+      /// \param[in] _msg The message data.
+      private: void OnVisualPropertiesMsg(ConstVisualPropertiesPtr &_msg);
+
+      /// \brief Apply the pending appearance changes of the visuals.
+      private: void ApplyVisualProperties();
+
+      /// \brief Check whether the mesh of a visual message is loaded, and
+      /// start loading it, or extruding its polylines, on a worker thread
+      /// otherwise.
+      /// \param[in] _msg The visual message.
+      /// \return True if the visual has no mesh, or if its mesh is loaded.
+      private: bool VisualMeshLoaded(const msgs::Visual &_msg);
+
       /// \brief Process a visual message.
       /// \param[in] _msg The message data.
       /// \param[in] _type Type of visual.
@@ -718,6 +834,11 @@ namespace gazebo
       /// \param[in] _msg The message data.
       private: void ProcessRequestMsg(ConstRequestPtr &_msg);
 
+      /// \brief Remove lights and visuals, with the visuals under them, in
+      /// one pass over the visuals.
+      /// \param[in] _names Names of the lights and visuals.
+      private: void RemoveEntities(const std::vector<std::string> &_names);
+
       /// \brief Sky message callback.
       /// \param[in] _msg The message data.
       private: void OnSkyMsg(ConstSkyPtr &_msg);
@@ -17,6 +17,7 @@
 #ifndef GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 #define GAZEBO_RENDERING_SCENE_PRIVATE_HH_
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <string>
@@ -25,14 +26,19 @@
 #include <condition_variable>
 
 #include <boost/unordered/unordered_map.hpp>
+#include <tbb/task_group.h>
 
 #include <sdf/sdf.hh>
 
 #include "gazebo/common/Events.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/msgs/msgs.hh"
+#include "gazebo/rendering/LightClusterer.hh"
 #include "gazebo/rendering/MarkerManager.hh"
+#include "gazebo/rendering/PoseInterpolator.hh"
+#include "gazebo/rendering/PoseTable.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
 namespace SkyX
@@ -64,14 +70,15 @@ namespace gazebo
     /// \brief List of visual messages.
     typedef std::list<boost::shared_ptr<msgs::Visual const> > VisualMsgs_L;
 
+    /// \def VisualProperties_M
+    /// \brief Map of visual ids to their latest appearance.
+    typedef std::map<uint32_t, msgs::VisualProperties::Property>
+        VisualProperties_M;
+
     /// \def LightMsgs_L.
     /// \brief List of light messages.
     typedef std::list<boost::shared_ptr<msgs::Light const> > LightMsgs_L;
 
-    /// \typedef PoseMsgs_M.
-    /// \brief List of messages.
-    typedef std::map<uint32_t, msgs::Pose> PoseMsgs_M;
-
     /// \typedef LightPoseMsgs_M.
     /// \brief List of messages.
     typedef std::map<std::string, msgs::Pose> LightPoseMsgs_M;
@@ -175,14 +182,35 @@ namespace gazebo
       /// \brief List of collision visual messages to process.
       public: VisualMsgs_L collisionVisualMsgs;
 
+      /// \brief Appearance changes to apply, merged by visual so that a
+      /// visual changed many times between two frames is updated once.
+      public: VisualProperties_M visualProperties;
+
       /// \brief List of light factory message to process.
       public: LightMsgs_L lightFactoryMsgs;
 
       /// \brief List of light modify message to process.
       public: LightMsgs_L lightModifyMsgs;
 
-      /// \brief List of pose message to process.
-      public: PoseMsgs_M poseMsgs;
+      /// \brief Pending poses of visuals and lights, indexed by id.
+      public: PoseTable poseTable;
+
+      /// \brief Poses of pose messages, interpolated at display rate.
+      public: PoseInterpolator poseInterpolator;
+
+      /// \brief True if the poses of pose messages are interpolated.
+      public: std::atomic<bool> poseInterpolation{false};
+
+      /// \brief Number of messages received that change the scene.
+      public: std::atomic<uint64_t> changeCount{0};
+
+      /// \brief Draws the visuals that share a mesh and material with
+      /// hardware instancing.
+      public: std::unique_ptr<VisualInstancer> instancer;
+
+      /// \brief Chooses the lights of each entity, null if clustered
+      /// lighting is disabled.
+      public: std::unique_ptr<LightClusterer> lightClusterer;
 
       /// \brief List of pose message to process.
       public: LightPoseMsgs_M lightPoseMsgs;
@@ -229,7 +257,8 @@ namespace gazebo
       /// \brief Mutex to lock the various message buffers.
       public: std::mutex *receiveMutex = nullptr;
 
-      /// \brief Mutex to lock the pose message buffers.
+      /// \brief Mutex to lock the skeleton pose messages and pose time
+      /// stamps. The pose table doesn't need it.
       public: std::recursive_mutex poseMsgMutex;
 
       /// \brief Communication Node
@@ -247,6 +276,9 @@ namespace gazebo
       /// \brief Subscribe to visual topic
       public: transport::SubscriberPtr visSub;
 
+      /// \brief Subscribe to visual properties topic
+      public: transport::SubscriberPtr visPropertiesSub;
+
       /// \brief Subscribe to light factory topic
       public: transport::SubscriberPtr lightFactorySub;
 
@@ -308,6 +340,20 @@ namespace gazebo
       /// \brief True if this scene is running on the server.
       public: bool isServer;
 
+      /// \brief Wall time PreRender may spend creating visuals in a frame,
+      /// 0 for no limit.
+      public: common::Time visualLoadBudget;
+
+      /// \brief Worker threads that load the meshes of new visuals.
+      public: tbb::task_group meshLoaders;
+
+      /// \brief Protects meshLoads.
+      public: std::mutex meshLoadMutex;
+
+      /// \brief Mesh URIs of the new visuals, and polyline:// followed by
+      /// the names of the new polyline visuals, true once they are loaded.
+      public: std::map<std::string, bool> meshLoads;
+
       /// \brief The heightmap, if any.
       public: Heightmap *terrain = nullptr;
 
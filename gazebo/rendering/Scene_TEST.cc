@@ -16,6 +16,14 @@
 */
 
 #include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/Light.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/test/ServerFixture.hh"
 
@@ -403,6 +411,216 @@ TEST_F(Scene_TEST, AddRemoveLights)
 }
 
 
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, Instancing)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Off by default
+  EXPECT_EQ(0u, scene->InstancingThreshold());
+
+  // Three boxes that share a mesh and a material
+  std::vector<rendering::VisualPtr> boxes;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    rendering::VisualPtr box(new rendering::Visual(
+        "box" + std::to_string(i), scene->WorldVisual()));
+    box->Load();
+    box->AttachMesh("unit_box");
+    box->SetMaterial("Gazebo/Grey");
+    box->SetType(rendering::Visual::VT_VISUAL);
+    box->SetPosition(ignition::math::Vector3d(i * 2.0, 0, 0));
+    scene->AddVisual(box);
+    scene->UpdateInstancing(box.get());
+    boxes.push_back(box);
+  }
+  EXPECT_EQ(0u, scene->InstancedVisualCount());
+
+  scene->SetInstancingThreshold(2);
+  EXPECT_EQ(2u, scene->InstancingThreshold());
+  if (scene->InstancedVisualCount() == 0u)
+  {
+    gzwarn << "Hardware instancing is not supported, skipping test"
+           << std::endl;
+    return;
+  }
+  EXPECT_EQ(3u, scene->InstancedVisualCount());
+
+  // A transparent visual is drawn on its own
+  boxes[0]->SetTransparency(0.5);
+  EXPECT_EQ(2u, scene->InstancedVisualCount());
+  boxes[0]->SetTransparency(0.0);
+  EXPECT_EQ(3u, scene->InstancedVisualCount());
+
+  // A group stays instanced until its last member is gone, while a
+  // visual with a new material starts a group of its own
+  scene->RemoveVisual(boxes[2]);
+  boxes[2]->Fini();
+  EXPECT_EQ(2u, scene->InstancedVisualCount());
+  boxes[1]->SetMaterial("Gazebo/Red");
+  EXPECT_EQ(1u, scene->InstancedVisualCount());
+
+  scene->SetInstancingThreshold(0);
+  EXPECT_EQ(0u, scene->InstancedVisualCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, ClusteredLighting)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Off by default
+  EXPECT_FALSE(scene->ClusteredLighting());
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("test_camera_clustered", false);
+  ASSERT_TRUE(camera != nullptr);
+  camera->Load();
+  camera->Init();
+  camera->CreateRenderTexture("test_camera_clustered_RttTex");
+  camera->SetWorldPose(ignition::math::Pose3d(-5, 0, 0.5, 0, 0, 0));
+
+  rendering::VisualPtr box(new rendering::Visual("box",
+      scene->WorldVisual()));
+  box->Load();
+  box->AttachMesh("unit_box");
+  box->SetPosition(ignition::math::Vector3d(0, 0, 0.5));
+  scene->AddVisual(box);
+
+  // A ring of point lights around the box, and a far one
+  for (unsigned int i = 0; i < 7; ++i)
+  {
+    rendering::LightPtr light(new rendering::Light(scene));
+    light->SetName("point" + std::to_string(i));
+    light->Load();
+    light->SetLightType("point");
+    light->SetRange(i < 6 ? 10 : 1);
+    light->SetPosition(i < 6 ?
+        ignition::math::Vector3d(2 * cos(i), 2 * sin(i), 1) :
+        ignition::math::Vector3d(0, 50, 1));
+    scene->AddLight(light);
+  }
+
+  scene->SetClusteredLighting(true);
+  EXPECT_TRUE(scene->ClusteredLighting());
+  camera->Render(true);
+
+  // Every entity gets the light budget, the far light isn't one of them
+  ASSERT_GT(box->GetSceneNode()->numAttachedObjects(), 0u);
+  Ogre::MovableObject *obj = box->GetSceneNode()->getAttachedObject(0);
+  const Ogre::LightList &lights = obj->queryLights();
+  ASSERT_EQ(8u, lights.size());
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(Ogre::Light::LT_POINT, lights[i]->getType());
+    EXPECT_NE("point6", lights[i]->getName());
+  }
+
+  scene->SetClusteredLighting(false);
+  EXPECT_FALSE(scene->ClusteredLighting());
+
+  scene->RemoveCamera(camera->Name());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, VisualLoadBudget)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  // Server scenes create visuals as soon as they are received
+  EXPECT_EQ(common::Time::Zero, scene->VisualLoadBudget());
+  scene->SetVisualLoadBudget(common::Time(0, 1000000));
+  EXPECT_EQ(common::Time(0, 1000000), scene->VisualLoadBudget());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr visPub = node->Advertise<msgs::Visual>("~/visual");
+  visPub->WaitForConnection();
+
+  msgs::Visual visualMsg;
+  visualMsg.set_name("streamed_mesh");
+  visualMsg.set_parent_name(scene->Name());
+  msgs::Geometry *geomMsg = visualMsg.mutable_geometry();
+  geomMsg->set_type(msgs::Geometry::MESH);
+  geomMsg->mutable_mesh()->set_filename(
+      std::string(TEST_PATH) + "/media/models/box-assimp-4.dae");
+  visPub->Publish(visualMsg);
+
+  // The mesh is loaded in the background, then the visual is created
+  int sleep = 0;
+  int maxSleep = 100;
+  while (!scene->GetVisual("streamed_mesh") && sleep < maxSleep)
+  {
+    event::Events::preRender();
+    common::Time::MSleep(30);
+    sleep++;
+  }
+  EXPECT_TRUE(scene->GetVisual("streamed_mesh") != nullptr);
+  EXPECT_EQ(0u, scene->PendingVisualCount());
+}
+
+/////////////////////////////////////////////////
+TEST_F(Scene_TEST, VisualProperties)
+{
+  Load("worlds/empty.world");
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  ASSERT_TRUE(scene != nullptr);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr propertiesPub =
+      node->Advertise<msgs::VisualProperties>("~/visual/properties");
+  propertiesPub->WaitForConnection();
+
+  // A visual to change
+  rendering::VisualPtr vis(new rendering::Visual("lamp",
+      scene->WorldVisual()));
+  vis->Load();
+  scene->AddVisual(vis);
+  EXPECT_TRUE(vis->GetVisible());
+
+  // Changes of the same visual are merged, and the ones of a visual that
+  // doesn't exist wait
+  msgs::VisualProperties msg;
+  msgs::VisualProperties::Property *property = msg.add_property();
+  property->set_id(vis->GetId());
+  msgs::Set(property->mutable_diffuse(), ignition::math::Color::Red);
+  property->set_transparency(0.5);
+  property = msg.add_property();
+  property->set_id(vis->GetId());
+  msgs::Set(property->mutable_emissive(), ignition::math::Color::Blue);
+  property->set_visible(false);
+  property = msg.add_property();
+  property->set_id(vis->GetId() + 1000);
+  property->set_visible(false);
+  propertiesPub->Publish(msg);
+
+  int sleep = 0;
+  int maxSleep = 50;
+  while (vis->GetVisible() && sleep < maxSleep)
+  {
+    event::Events::preRender();
+    common::Time::MSleep(30);
+    sleep++;
+  }
+
+  EXPECT_FALSE(vis->GetVisible());
+  EXPECT_EQ(ignition::math::Color::Red, vis->Diffuse());
+  EXPECT_EQ(ignition::math::Color::Blue, vis->Emissive());
+  EXPECT_FLOAT_EQ(0.5f, vis->GetTransparency());
+  EXPECT_EQ(1u, scene->PendingVisualPropertyCount());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
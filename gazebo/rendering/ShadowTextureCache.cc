@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/ShadowTextureCache.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+/// \brief Visibility mask of the shadow texture viewports while they
+/// render, which is Ogre's default.
+static const Ogre::uint32 kShadowVisibilityMask = 0xFFFFFFFF;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief What a split was rendered from.
+    class ShadowTextureKey
+    {
+      /// \brief Compare with another key.
+      /// \param[in] _other The other key.
+      /// \return True if both keys are valid and render the same content.
+      public: bool Matches(const ShadowTextureKey &_other) const
+              {
+                return this->valid && _other.valid &&
+                    this->casters == _other.casters &&
+                    this->view == _other.view && this->proj == _other.proj;
+              }
+
+      /// \brief View matrix of the texture camera.
+      public: Ogre::Matrix4 view = Ogre::Matrix4::IDENTITY;
+
+      /// \brief Projection matrix of the texture camera.
+      public: Ogre::Matrix4 proj = Ogre::Matrix4::IDENTITY;
+
+      /// \brief Hash of the shadow casters.
+      public: uint64_t casters = 0;
+
+      /// \brief False if the content can't be reused.
+      public: bool valid = false;
+    };
+
+    /// \internal
+    /// \brief A split of a camera.
+    class ShadowTextureSplit
+    {
+      /// \brief What the split was last rendered from.
+      public: ShadowTextureKey key;
+
+      /// \brief Content of the split, saved when another camera took the
+      /// shadow texture.
+      public: Ogre::TexturePtr copy;
+
+      /// \brief True if the copy holds the content of the key.
+      public: bool copyValid = false;
+    };
+
+    /// \internal
+    /// \brief Shared state of a shadow texture.
+    class ShadowTextureState
+    {
+      /// \brief Camera whose split the texture holds, null if unknown.
+      public: const Ogre::Camera *owner = nullptr;
+
+      /// \brief Index of the split of the owner.
+      public: std::size_t ownerIteration = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for ShadowTextureCache
+    class ShadowTextureCachePrivate
+    {
+      /// \brief Decide whether a split of the camera is rendered.
+      /// \param[in] _texture Shadow texture of the split.
+      /// \param[in, out] _state Shared state of the texture.
+      /// \param[in] _texCam Texture camera of the split.
+      /// \param[in] _iteration Index of the split.
+      /// \return True to skip the rendering of the split.
+      public: bool Prepare(const Ogre::TexturePtr &_texture,
+                  ShadowTextureState &_state, const Ogre::Camera *_texCam,
+                  const std::size_t _iteration);
+
+      /// \brief Copy the content of a split aside.
+      /// \param[in] _texture Shadow texture holding the split.
+      /// \param[in] _iteration Index of the split.
+      public: void Save(const Ogre::TexturePtr &_texture,
+                  const std::size_t _iteration);
+
+      /// \brief Forget the content of every split and release the copies.
+      public: void Forget();
+
+      /// \brief Scene manager of the camera.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief The camera.
+      public: Ogre::Camera *camera = nullptr;
+
+      /// \brief Splits of the camera.
+      public: std::vector<ShadowTextureSplit> splits;
+
+      /// \brief Hash of the shadow casters of the current frame.
+      public: uint64_t casters = 0;
+
+      /// \brief False if the shadow casters of the current frame can't be
+      /// cached.
+      public: bool cacheable = false;
+
+      /// \brief Splits reused by the last frame.
+      public: unsigned int cachedCount = 0;
+
+      /// \brief Splits rendered by the last frame.
+      public: unsigned int renderedCount = 0;
+    };
+  }
+}
+
+/// \brief Caches by camera.
+static std::map<const Ogre::Camera *, ShadowTextureCachePrivate *> gCaches;
+
+/// \brief Shared state of the shadow textures.
+static std::map<const Ogre::Texture *, ShadowTextureState> gTextures;
+
+/// \brief Counter used to name the copies of the splits.
+static unsigned int gCopyCount = 0;
+
+//////////////////////////////////////////////////
+/// \brief Add bytes to a FNV-1a hash.
+/// \param[in, out] _hash The hash.
+/// \param[in] _data The bytes.
+/// \param[in] _size Number of bytes.
+static void hashBytes(uint64_t &_hash, const void *_data,
+    const std::size_t _size)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(_data);
+  for (std::size_t i = 0; i < _size; ++i)
+  {
+    _hash ^= bytes[i];
+    _hash *= 1099511628211ull;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Hash the shadow casters below a scene node.
+/// \param[in] _node The scene node.
+/// \param[in, out] _hash The hash.
+/// \param[in, out] _cacheable Set to false if a caster can't be cached.
+static void hashCasters(Ogre::SceneNode *_node, uint64_t &_hash,
+    bool &_cacheable)
+{
+  for (unsigned int i = 0; i < _node->numAttachedObjects(); ++i)
+  {
+    const Ogre::MovableObject *obj = _node->getAttachedObject(i);
+    if (!obj->getVisible() || !obj->getCastShadows())
+      continue;
+
+    const Ogre::Entity *entity = dynamic_cast<const Ogre::Entity *>(obj);
+    if (entity && entity->hasSkeleton())
+      _cacheable = false;
+
+    const Ogre::AxisAlignedBox &box = obj->getWorldBoundingBox(true);
+    const Ogre::Vector3 &min = box.getMinimum();
+    const Ogre::Vector3 &max = box.getMaximum();
+    const Ogre::uint32 flags = obj->getVisibilityFlags();
+    hashBytes(_hash, &obj, sizeof(obj));
+    hashBytes(_hash, min.ptr(), sizeof(Ogre::Real) * 3);
+    hashBytes(_hash, max.ptr(), sizeof(Ogre::Real) * 3);
+    hashBytes(_hash, &flags, sizeof(flags));
+  }
+
+  for (unsigned int i = 0; i < _node->numChildren(); ++i)
+  {
+    Ogre::SceneNode *child =
+        dynamic_cast<Ogre::SceneNode *>(_node->getChild(i));
+    if (child)
+      hashCasters(child, _hash, _cacheable);
+  }
+}
+
+//////////////////////////////////////////////////
+bool ShadowTextureCachePrivate::Prepare(const Ogre::TexturePtr &_texture,
+    ShadowTextureState &_state, const Ogre::Camera *_texCam,
+    const std::size_t _iteration)
+{
+  // The casters are the same for all the splits of a frame
+  if (_iteration == 0)
+  {
+    this->casters = 14695981039346656037ull;
+    this->cacheable = true;
+    hashCasters(this->manager->getRootSceneNode(), this->casters,
+        this->cacheable);
+    this->cachedCount = 0;
+    this->renderedCount = 0;
+  }
+
+  if (this->splits.size() <= _iteration)
+    this->splits.resize(_iteration + 1);
+  ShadowTextureSplit &split = this->splits[_iteration];
+
+  ShadowTextureKey key;
+  key.view = _texCam->getViewMatrix(true);
+  key.proj = _texCam->getProjectionMatrix();
+  key.casters = this->casters;
+  key.valid = this->cacheable;
+
+  const bool current = split.key.Matches(key);
+  const bool owned = _state.owner == this->camera &&
+      _state.ownerIteration == _iteration;
+  _state.owner = this->camera;
+  _state.ownerIteration = _iteration;
+
+  if (current && owned)
+  {
+    ++this->cachedCount;
+    return true;
+  }
+
+  if (current && split.copyValid)
+  {
+    Ogre::TexturePtr texture = _texture;
+    split.copy->copyToTexture(texture);
+    ++this->cachedCount;
+    return true;
+  }
+
+  split.key = key;
+  split.copyValid = false;
+  ++this->renderedCount;
+  return false;
+}
+
+//////////////////////////////////////////////////
+void ShadowTextureCachePrivate::Save(const Ogre::TexturePtr &_texture,
+    const std::size_t _iteration)
+{
+  if (_iteration >= this->splits.size())
+    return;
+
+  ShadowTextureSplit &split = this->splits[_iteration];
+  if (!split.key.valid || split.copyValid)
+    return;
+
+  if (!split.copy.get() ||
+      split.copy->getWidth() != _texture->getWidth() ||
+      split.copy->getHeight() != _texture->getHeight() ||
+      split.copy->getFormat() != _texture->getFormat())
+  {
+    if (split.copy.get())
+      Ogre::TextureManager::getSingleton().remove(split.copy->getName());
+    split.copy = Ogre::TextureManager::getSingleton().createManual(
+        "__GZ_SHADOW_CACHE_" + std::to_string(gCopyCount++) + "__",
+        "General",
+        Ogre::TEX_TYPE_2D,
+        _texture->getWidth(),
+        _texture->getHeight(),
+        0,
+        _texture->getFormat(),
+        Ogre::TU_RENDERTARGET);
+    split.copy->getBuffer()->getRenderTarget()->setAutoUpdated(false);
+  }
+
+  _texture->copyToTexture(split.copy);
+  split.copyValid = true;
+}
+
+//////////////////////////////////////////////////
+void ShadowTextureCachePrivate::Forget()
+{
+  for (auto &split : this->splits)
+  {
+    if (split.copy.get())
+      Ogre::TextureManager::getSingleton().remove(split.copy->getName());
+  }
+  this->splits.clear();
+}
+
+//////////////////////////////////////////////////
+ShadowTextureCache::ShadowTextureCache(Ogre::SceneManager *_manager,
+    Ogre::Camera *_camera)
+  : dataPtr(new ShadowTextureCachePrivate)
+{
+  this->dataPtr->manager = _manager;
+  this->dataPtr->camera = _camera;
+  gCaches[_camera] = this->dataPtr.get();
+}
+
+//////////////////////////////////////////////////
+ShadowTextureCache::~ShadowTextureCache()
+{
+  gCaches.erase(this->dataPtr->camera);
+  for (auto &texture : gTextures)
+  {
+    if (texture.second.owner == this->dataPtr->camera)
+      texture.second.owner = nullptr;
+  }
+  this->dataPtr->Forget();
+}
+
+//////////////////////////////////////////////////
+void ShadowTextureCache::PrepareSplit(const Ogre::SceneManager *_manager,
+    const Ogre::Camera *_camera, const Ogre::Camera *_texCam,
+    const std::size_t _iteration)
+{
+  // Find the shadow texture rendered by the texture camera
+  Ogre::SceneManager *manager = const_cast<Ogre::SceneManager *>(_manager);
+  Ogre::TexturePtr texture;
+  Ogre::Viewport *viewport = nullptr;
+  for (std::size_t i = 0; i < manager->getShadowTextureCount(); ++i)
+  {
+    const Ogre::TexturePtr &tex = manager->getShadowTexture(i);
+    Ogre::RenderTarget *target = tex->getBuffer()->getRenderTarget();
+    if (target->getNumViewports() > 0 &&
+        target->getViewport(0)->getCamera() == _texCam)
+    {
+      texture = tex;
+      viewport = target->getViewport(0);
+      break;
+    }
+  }
+  if (!viewport)
+    return;
+
+  // Keep the content of the previous owner before it's replaced
+  ShadowTextureState &state = gTextures[texture.get()];
+  if (state.owner && state.owner != _camera)
+  {
+    auto owner = gCaches.find(state.owner);
+    if (owner != gCaches.end())
+      owner->second->Save(texture, state.ownerIteration);
+  }
+
+  bool skip = false;
+  auto iter = gCaches.find(_camera);
+  if (iter == gCaches.end())
+    state.owner = nullptr;
+  else
+    skip = iter->second->Prepare(texture, state, _texCam, _iteration);
+
+  // A skipped split draws nothing and keeps its content
+  viewport->setClearEveryFrame(!skip);
+  viewport->setVisibilityMask(skip ? 0 : kShadowVisibilityMask);
+}
+
+//////////////////////////////////////////////////
+void ShadowTextureCache::Invalidate()
+{
+  gTextures.clear();
+  for (auto &cache : gCaches)
+    cache.second->Forget();
+}
+
+//////////////////////////////////////////////////
+unsigned int ShadowTextureCache::CachedSplitCount() const
+{
+  return this->dataPtr->cachedCount;
+}
+
+//////////////////////////////////////////////////
+unsigned int ShadowTextureCache::RenderedSplitCount() const
+{
+  return this->dataPtr->renderedCount;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_SHADOWTEXTURECACHE_HH_
+#define GAZEBO_RENDERING_SHADOWTEXTURECACHE_HH_
+
+#include <cstddef>
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class Camera;
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declarations.
+    class ShadowTextureCachePrivate;
+
+    /// \cond
+    /// \brief Reuses the shadow textures of a camera while nothing that
+    /// casts shadows has changed.
+    ///
+    /// Every frame of a camera renders all shadow casters into each
+    /// Parallel Split Shadow Map (PSSM) split. A split is a function of
+    /// its texture camera, which follows the light and the view of the
+    /// camera, and of the shadow casters. Before a split is rendered, its
+    /// texture camera and a hash of the world bounds, visibility and
+    /// flags of every shadow caster are compared with those of the last
+    /// rendering for the camera. When they match, the rendering of the
+    /// split is skipped and the texture keeps its content. A fixed camera
+    /// in a world where nothing moves renders its shadows once.
+    ///
+    /// The shadow textures are shared by the cameras of a scene manager.
+    /// When another camera takes a texture, the content of its previous
+    /// owner is copied aside, and copied back on that owner's next frame
+    /// if still valid. Entities with skeletons are animated without
+    /// moving their bounds, so their presence disables the cache. Changes
+    /// of materials are not detected. Only the Camera class and the
+    /// shadow camera setup should use this class.
+    class GZ_RENDERING_VISIBLE ShadowTextureCache
+    {
+      /// \brief Constructor
+      /// \param[in] _manager Scene manager of the camera.
+      /// \param[in] _camera The camera whose shadow textures are cached.
+      public: ShadowTextureCache(Ogre::SceneManager *_manager,
+                                 Ogre::Camera *_camera);
+
+      /// \brief Destructor. Must be called while the camera exists.
+      public: virtual ~ShadowTextureCache();
+
+      /// \brief Decide whether a split is rendered. Called by the shadow
+      /// camera setup once the texture camera of the split is placed,
+      /// right before the split is rendered.
+      /// \param[in] _manager Scene manager being rendered.
+      /// \param[in] _camera Camera being rendered.
+      /// \param[in] _texCam Texture camera of the split.
+      /// \param[in] _iteration Index of the split.
+      public: static void PrepareSplit(const Ogre::SceneManager *_manager,
+                  const Ogre::Camera *_camera, const Ogre::Camera *_texCam,
+                  const std::size_t _iteration);
+
+      /// \brief Forget the content of every shadow texture. Called when
+      /// the shadow textures are configured again.
+      public: static void Invalidate();
+
+      /// \brief Get the number of splits of the last frame that were
+      /// reused instead of rendered.
+      /// \return Number of cached splits.
+      public: unsigned int CachedSplitCount() const;
+
+      /// \brief Get the number of splits rendered by the last frame.
+      /// \return Number of rendered splits.
+      public: unsigned int RenderedSplitCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<ShadowTextureCachePrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
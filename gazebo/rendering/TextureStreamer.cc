@@ -0,0 +1,507 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <ignition/common/Profiler.hh>
+#include <tbb/task_group.h>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/TextureCache.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/TextureStreamer.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief A compressed texture read by a background task.
+    class TextureStreamerResult
+    {
+      /// \brief Name of the original texture.
+      public: std::string texture;
+
+      /// \brief Name of the compressed texture.
+      public: std::string name;
+
+      /// \brief Content of the DDS file.
+      public: std::string data;
+
+      /// \brief True if the data holds the full resolution.
+      public: bool full = false;
+    };
+
+    /// \internal
+    /// \brief An image texture that is being replaced.
+    class TextureStreamerEntry
+    {
+      /// \brief Name of the compressed texture, empty until it exists.
+      public: std::string name;
+
+      /// \brief Materials that use the texture.
+      public: std::set<std::string> materials;
+
+      /// \brief True once the full resolution was uploaded.
+      public: bool full = false;
+    };
+
+    /// \internal
+    /// \brief Private data for the TextureStreamer class
+    class TextureStreamerPrivate
+    {
+      /// \brief Read a whole file.
+      /// \param[in] _path Path of the file.
+      /// \param[out] _data Content of the file.
+      /// \return False if the file can't be read.
+      public: static bool ReadFile(const std::string &_path,
+                                   std::string &_data)
+              {
+                std::ifstream in(_path, std::ios::binary);
+                if (!in)
+                  return false;
+                _data.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+                return !_data.empty();
+              }
+
+      /// \brief Find the file of an image texture.
+      /// \param[in] _texture Name of the texture.
+      /// \return Full path of the file, or an empty string if the texture
+      /// isn't a PNG, JPEG or BMP file on the file system.
+      public: static std::string Resolve(const std::string &_texture)
+              {
+                const std::string ext = boost::to_lower_copy(
+                    boost::filesystem::path(_texture).extension().string());
+                if (ext != ".png" && ext != ".jpg" && ext != ".jpeg" &&
+                    ext != ".bmp")
+                {
+                  return std::string();
+                }
+
+                boost::system::error_code ec;
+                if (boost::filesystem::path(_texture).is_absolute())
+                {
+                  return boost::filesystem::exists(_texture, ec) ?
+                      _texture : std::string();
+                }
+
+                try
+                {
+                  Ogre::FileInfoListPtr infos =
+                      Ogre::ResourceGroupManager::getSingleton().
+                      findResourceFileInfo("General", _texture);
+                  for (auto const &info : *infos)
+                  {
+                    if (info.archive && info.archive->getType() == "FileSystem")
+                    {
+                      return (boost::filesystem::path(
+                          info.archive->getName()) / info.filename).string();
+                    }
+                  }
+                }
+                catch(Ogre::Exception &)
+                {
+                }
+                return std::string();
+              }
+
+      /// \brief Create or replace a texture from the content of a DDS
+      /// file, keeping the mip levels of the file.
+      /// \param[in] _name Name of the texture.
+      /// \param[in] _data Content of the DDS file.
+      /// \return True if the texture was loaded.
+      public: static bool Upload(const std::string &_name,
+                                 const std::string &_data)
+              {
+                try
+                {
+                  Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(
+                      const_cast<char *>(_data.data()), _data.size(),
+                      false, true));
+                  Ogre::Image image;
+                  image.load(stream, "dds");
+
+                  Ogre::TexturePtr texture =
+                      Ogre::TextureManager::getSingleton().getByName(_name);
+                  if (texture.isNull())
+                  {
+                    Ogre::TextureManager::getSingleton().loadImage(_name,
+                        "General", image, Ogre::TEX_TYPE_2D,
+                        image.getNumMipmaps());
+                  }
+                  else
+                  {
+                    texture->unload();
+                    texture->setNumMipmaps(image.getNumMipmaps());
+                    texture->loadImage(image);
+                  }
+                }
+                catch(Ogre::Exception &_e)
+                {
+                  gzwarn << "Unable to load compressed texture[" << _name
+                         << "]: " << _e.getDescription() << "\n";
+                  return false;
+                }
+                return true;
+              }
+
+      /// \brief Point the texture units of a material that use a texture
+      /// to another texture.
+      /// \param[in] _materialName Name of the material.
+      /// \param[in] _from Name of the texture to replace.
+      /// \param[in] _to Name of the new texture.
+      public: static void Swap(const std::string &_materialName,
+                               const std::string &_from,
+                               const std::string &_to)
+              {
+                Ogre::MaterialPtr material =
+                    Ogre::MaterialManager::getSingleton().getByName(
+                    _materialName);
+                if (material.isNull())
+                  return;
+
+                // Every technique, including the ones of the run time
+                // shader system
+                for (auto techIt = material->getTechniqueIterator();
+                     techIt.hasMoreElements();)
+                {
+                  Ogre::Technique *tech = techIt.getNext();
+                  for (auto passIt = tech->getPassIterator();
+                       passIt.hasMoreElements();)
+                  {
+                    Ogre::Pass *pass = passIt.getNext();
+                    for (auto tusIt = pass->getTextureUnitStateIterator();
+                         tusIt.hasMoreElements();)
+                    {
+                      Ogre::TextureUnitState *tus = tusIt.getNext();
+                      if (tus->getNumFrames() == 1 &&
+                          tus->getTextureName() == _from)
+                      {
+                        tus->setTextureName(_to);
+                      }
+                    }
+                  }
+                }
+              }
+
+      /// \brief Swap the texture of every material of an entry.
+      /// \param[in] _texture Name of the original texture.
+      /// \param[in] _entry The entry, whose compressed texture exists.
+      public: static void SwapAll(const std::string &_texture,
+                                  const TextureStreamerEntry &_entry)
+              {
+                for (auto const &materialName : _entry.materials)
+                  Swap(materialName, _texture, _entry.name);
+
+                // Free the original once the texture units let go of it
+                Ogre::TexturePtr original =
+                    Ogre::TextureManager::getSingleton().getByName(_texture);
+                if (!original.isNull() && original.useCount() <=
+                    Ogre::ResourceGroupManager::
+                    RESOURCE_SYSTEM_NUM_REFERENCE_COUNTS + 1)
+                {
+                  original->unload();
+                }
+              }
+
+      /// \brief Queue a result of a background task.
+      /// \param[in] _result The result.
+      public: void Push(TextureStreamerResult &&_result)
+              {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->results.push_back(std::move(_result));
+              }
+
+      /// \brief The cache, null when disabled.
+      public: std::unique_ptr<common::TextureCache> cache;
+
+      /// \brief Materials that were added.
+      public: std::set<std::string> materials;
+
+      /// \brief Replaced textures by original texture name.
+      public: std::map<std::string, TextureStreamerEntry> entries;
+
+      /// \brief Original texture names by compressed texture name.
+      public: std::map<std::string, std::string> originals;
+
+      /// \brief Number of entries waiting for a result.
+      public: unsigned int pending = 0;
+
+      /// \brief Converts images and reads cache entries.
+      public: tbb::task_group workers;
+
+      /// \brief Protects results.
+      public: std::mutex mutex;
+
+      /// \brief Results of the background tasks, in order.
+      public: std::list<TextureStreamerResult> results;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+TextureStreamer::TextureStreamer()
+  : dataPtr(new TextureStreamerPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TextureStreamer::~TextureStreamer()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void TextureStreamer::Init()
+{
+  this->Fini();
+
+  // Compress textures unless GAZEBO_TEXTURE_COMPRESSION=0
+  const char *env = getenv("GAZEBO_TEXTURE_COMPRESSION");
+  if (env && std::string(env) == "0")
+    return;
+
+  Ogre::RenderSystem *renderSys = Ogre::Root::getSingleton().getRenderSystem();
+  if (!renderSys || !renderSys->getCapabilities() ||
+      !renderSys->getCapabilities()->hasCapability(
+      Ogre::RSC_TEXTURE_COMPRESSION_DXT))
+  {
+    gzlog << "Render system doesn't support DXT textures, "
+          << "textures aren't compressed.\n";
+    return;
+  }
+
+  this->dataPtr->cache.reset(new common::TextureCache(
+      common::SystemPaths::Instance()->GetLogPath() + "/texture_cache"));
+
+  // Lets Ogre reload the compressed textures by name, e.g. after the
+  // render system lost its buffers.
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(this->dataPtr->cache->Path(), ec);
+  Ogre::ResourceGroupManager::getSingleton().addResourceLocation(
+      this->dataPtr->cache->Path(), "FileSystem", "General");
+}
+
+//////////////////////////////////////////////////
+void TextureStreamer::Fini()
+{
+  this->dataPtr->workers.wait();
+  this->dataPtr->cache.reset();
+  this->dataPtr->materials.clear();
+  this->dataPtr->entries.clear();
+  this->dataPtr->originals.clear();
+  this->dataPtr->results.clear();
+  this->dataPtr->pending = 0;
+}
+
+//////////////////////////////////////////////////
+bool TextureStreamer::Enabled() const
+{
+  return this->dataPtr->cache != nullptr;
+}
+
+//////////////////////////////////////////////////
+void TextureStreamer::AddMaterial(const std::string &_materialName)
+{
+  if (!this->dataPtr->cache ||
+      !this->dataPtr->materials.insert(_materialName).second)
+  {
+    return;
+  }
+
+  IGN_PROFILE("rendering::TextureStreamer::AddMaterial");
+
+  Ogre::MaterialPtr material =
+      Ogre::MaterialManager::getSingleton().getByName(_materialName);
+  if (material.isNull())
+    return;
+
+  std::set<std::string> textures;
+  for (auto techIt = material->getTechniqueIterator();
+       techIt.hasMoreElements();)
+  {
+    Ogre::Technique *tech = techIt.getNext();
+    for (auto passIt = tech->getPassIterator(); passIt.hasMoreElements();)
+    {
+      Ogre::Pass *pass = passIt.getNext();
+      for (auto tusIt = pass->getTextureUnitStateIterator();
+           tusIt.hasMoreElements();)
+      {
+        Ogre::TextureUnitState *tus = tusIt.getNext();
+        if (tus->getNumFrames() == 1 &&
+            tus->getTextureType() == Ogre::TEX_TYPE_2D &&
+            !tus->getTextureName().empty())
+        {
+          textures.insert(tus->getTextureName());
+        }
+      }
+    }
+  }
+
+  for (auto const &texture : textures)
+  {
+    // Texture units already replaced in the material this one was
+    // cloned from
+    auto original = this->dataPtr->originals.find(texture);
+    if (original != this->dataPtr->originals.end())
+    {
+      this->dataPtr->entries[original->second].materials.insert(
+          _materialName);
+      continue;
+    }
+
+    auto iter = this->dataPtr->entries.find(texture);
+    if (iter != this->dataPtr->entries.end())
+    {
+      iter->second.materials.insert(_materialName);
+      if (!iter->second.name.empty())
+        TextureStreamerPrivate::Swap(_materialName, texture, iter->second.name);
+      continue;
+    }
+
+    const std::string file = TextureStreamerPrivate::Resolve(texture);
+    if (file.empty())
+      continue;
+
+    TextureStreamerEntry &entry = this->dataPtr->entries[texture];
+    entry.materials.insert(_materialName);
+
+    const common::TextureCache *cache = this->dataPtr->cache.get();
+    std::string full, low;
+    if (cache->Find(file, full, low))
+    {
+      // Use the low resolution right away, or the full one if the image
+      // is small.
+      std::string data;
+      const std::string name =
+          boost::filesystem::path(full).filename().string();
+      if (TextureStreamerPrivate::ReadFile(low.empty() ? full : low, data) &&
+          TextureStreamerPrivate::Upload(name, data))
+      {
+        entry.name = name;
+        entry.full = low.empty();
+        this->dataPtr->originals[name] = texture;
+        TextureStreamerPrivate::SwapAll(texture, entry);
+      }
+      if (entry.full)
+        continue;
+    }
+
+    ++this->dataPtr->pending;
+
+    TextureStreamerPrivate *dPtr = this->dataPtr.get();
+    const bool converted = !full.empty();
+    this->dataPtr->workers.run([dPtr, cache, texture, file, converted]()
+    {
+      std::string fullPath, lowPath;
+      if (!converted && !cache->Save(file))
+        gzlog << "Unable to compress texture[" << file << "]\n";
+      else
+        cache->Find(file, fullPath, lowPath);
+
+      TextureStreamerResult result;
+      result.texture = texture;
+      if (!fullPath.empty())
+      {
+        result.name = boost::filesystem::path(fullPath).filename().string();
+        if (!converted && !lowPath.empty())
+        {
+          TextureStreamerResult lowResult = result;
+          if (TextureStreamerPrivate::ReadFile(lowPath, lowResult.data))
+            dPtr->Push(std::move(lowResult));
+        }
+        result.full = TextureStreamerPrivate::ReadFile(fullPath, result.data);
+      }
+      dPtr->Push(std::move(result));
+    });
+  }
+}
+
+//////////////////////////////////////////////////
+void TextureStreamer::Update()
+{
+  if (!this->dataPtr->cache)
+    return;
+
+  // Upload a single texture per frame, to avoid stalls
+  TextureStreamerResult result;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (this->dataPtr->results.empty())
+      return;
+    result = std::move(this->dataPtr->results.front());
+    this->dataPtr->results.pop_front();
+  }
+
+  IGN_PROFILE("rendering::TextureStreamer::Update");
+
+  auto iter = this->dataPtr->entries.find(result.texture);
+  if (iter == this->dataPtr->entries.end())
+    return;
+  TextureStreamerEntry &entry = iter->second;
+
+  if (result.data.empty() ||
+      !TextureStreamerPrivate::Upload(result.name, result.data))
+  {
+    // Keep using the original texture, or the low resolution one
+    if (result.full || result.data.empty())
+      --this->dataPtr->pending;
+    return;
+  }
+
+  if (result.full)
+  {
+    entry.full = true;
+    --this->dataPtr->pending;
+  }
+
+  if (entry.name.empty())
+  {
+    entry.name = result.name;
+    this->dataPtr->originals[entry.name] = result.texture;
+    TextureStreamerPrivate::SwapAll(result.texture, entry);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int TextureStreamer::PendingCount() const
+{
+  return this->dataPtr->pending;
+}
+
+//////////////////////////////////////////////////
+unsigned int TextureStreamer::CompressedCount() const
+{
+  unsigned int count = 0;
+  for (auto const &entry : this->dataPtr->entries)
+  {
+    if (entry.second.full)
+      ++count;
+  }
+  return count;
+}
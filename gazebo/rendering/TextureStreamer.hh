@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_TEXTURESTREAMER_HH_
+#define GAZEBO_RENDERING_TEXTURESTREAMER_HH_
+
+#include <memory>
+#include <string>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_RENDERING_VISIBLE, gazebo, rendering,
+    TextureStreamer)
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declarations.
+    class TextureStreamerPrivate;
+
+    /// \cond
+    /// \brief Replaces the image textures of materials with compressed,
+    /// mipmapped textures from a common::TextureCache.
+    ///
+    /// An image whose cache entry is up to date is swapped right away for
+    /// its low resolution entry, and the full resolution texture is read
+    /// in the background. Other images are converted in the background
+    /// while materials use them as they are, and swapped once converted.
+    /// Update() uploads at most one texture per frame. The original image
+    /// texture is unloaded once no material uses it. Nothing is done when
+    /// the render system lacks DXT support or GAZEBO_TEXTURE_COMPRESSION
+    /// is 0. Only the RenderEngine and Visual classes should use this
+    /// class.
+    class GZ_RENDERING_VISIBLE TextureStreamer :
+      public SingletonT<TextureStreamer>
+    {
+      /// \brief Constructor.
+      private: TextureStreamer();
+
+      /// \brief Destructor.
+      private: virtual ~TextureStreamer();
+
+      /// \brief Check the render system and open the cache. Call after
+      /// the render system is initialized.
+      public: void Init();
+
+      /// \brief Wait for the background work and forget every texture.
+      public: void Fini();
+
+      /// \brief Tell whether textures are compressed.
+      /// \return True if Init() succeeded and streaming is enabled.
+      public: bool Enabled() const;
+
+      /// \brief Compress the image textures of a material. Materials that
+      /// were already added are skipped.
+      /// \param[in] _materialName Name of the Ogre material.
+      public: void AddMaterial(const std::string &_materialName);
+
+      /// \brief Swap in the textures that are ready. Call once per frame
+      /// from the rendering thread.
+      public: void Update();
+
+      /// \brief Get the number of textures that wait for a conversion or
+      /// for their full resolution.
+      /// \return Number of pending textures.
+      public: unsigned int PendingCount() const;
+
+      /// \brief Get the number of textures whose full resolution
+      /// compressed version is in use.
+      /// \return Number of compressed textures.
+      public: unsigned int CompressedCount() const;
+
+      /// \brief Make the streamer a singleton.
+      private: friend class SingletonT<TextureStreamer>;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<TextureStreamerPrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
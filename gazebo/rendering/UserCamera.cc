@@ -689,12 +689,12 @@ void UserCamera::SetRenderTarget(Ogre::RenderTarget *_target)
     this->dataPtr->rightViewport->setDrawBuffer(Ogre::CBT_BACK_RIGHT);
 #endif
 
-    this->dataPtr->rightViewport->setVisibilityMask(
-        GZ_VISIBILITY_ALL & ~GZ_VISIBILITY_SELECTABLE);
+    this->dataPtr->rightViewport->setVisibilityMask(GZ_VISIBILITY_ALL &
+        ~(GZ_VISIBILITY_SELECTABLE | GZ_VISIBILITY_INSTANCE_SOURCE));
   }
 
-  this->viewport->setVisibilityMask(
-      GZ_VISIBILITY_ALL & ~GZ_VISIBILITY_SELECTABLE);
+  this->viewport->setVisibilityMask(GZ_VISIBILITY_ALL &
+      ~(GZ_VISIBILITY_SELECTABLE | GZ_VISIBILITY_INSTANCE_SOURCE));
 
   this->initialized = true;
 
@@ -43,8 +43,6 @@ VideoVisual::VideoVisual(const std::string &_name, VisualPtr _parent)
   dPtr->height = dPtr->video->GetHeight();
   double ratio = dPtr->width / static_cast<double>(dPtr->height);
 
-  dPtr->imageBuffer = new unsigned char[dPtr->height * dPtr->width * 3];
-
   dPtr->connections.push_back(event::Events::ConnectPreRender(
         boost::bind(&VideoVisual::PreRender, this)));
 
@@ -58,6 +56,16 @@ VideoVisual::VideoVisual(const std::string &_name, VisualPtr _parent)
     Ogre::PF_BYTE_BGR,
     Ogre::TU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
 
+  // The requested pixel format of the texture is not always the one that
+  // OGRE creates. The decoder thread converts the frames to the format of
+  // the texture, so that the render thread only copies them.
+  dPtr->bytesPerPixel = Ogre::PixelUtil::getNumElemBytes(
+      dPtr->texture->getFormat());
+  dPtr->video->SetOutputFormat(dPtr->bytesPerPixel > 3 ?
+      common::Image::BGRA_INT8 : common::Image::BGR_INT8);
+  dPtr->imageBuffer = new unsigned char[dPtr->video->FrameSize()];
+  dPtr->video->StartDecoding();
+
   Ogre::MaterialPtr material =
     Ogre::MaterialManager::getSingleton().create(
         _name + "__VideoMaterial__", "General");
@@ -102,6 +110,7 @@ VideoVisual::~VideoVisual()
   VideoVisualPrivate *dPtr =
       reinterpret_cast<VideoVisualPrivate *>(this->dataPtr);
 
+  // Stops the decoder thread
   delete dPtr->video;
   dPtr->video = NULL;
 
@@ -116,7 +125,9 @@ void VideoVisual::PreRender()
   VideoVisualPrivate *dPtr =
       reinterpret_cast<VideoVisualPrivate *>(this->dataPtr);
 
-  dPtr->video->GetNextFrame(&dPtr->imageBuffer);
+  // Upload new frames only
+  if (!dPtr->video->PopFrame(dPtr->imageBuffer))
+    return;
 
   // Get the pixel buffer
   Ogre::HardwarePixelBufferSharedPtr pixelBuffer = dPtr->texture->getBuffer();
@@ -127,31 +138,17 @@ void VideoVisual::PreRender()
   const Ogre::PixelBox& pixelBox = pixelBuffer->getCurrentLock();
   uint8_t* pDest = static_cast<uint8_t*>(pixelBox.data);
 
-  // The request pixel format of the texture is not always the one that OGRE
-  // creates.
-  bool unusedAlpha = Ogre::PixelUtil::getNumElemBytes(
-      dPtr->texture->getFormat()) > 3 ? true : false;
-
-  // If OGRE actually created a texture with no alpha channel, then we
-  // can use memcpy
-  if (!unusedAlpha)
+  // The frames are in the format of the texture, rows may be padded
+  const std::size_t rowSize = dPtr->width * dPtr->bytesPerPixel;
+  const std::size_t pitch = pixelBox.rowPitch * dPtr->bytesPerPixel;
+  if (pitch == rowSize)
   {
-    memcpy(pDest, dPtr->imageBuffer, dPtr->height*dPtr->width*3);
+    memcpy(pDest, dPtr->imageBuffer, rowSize * dPtr->height);
   }
   else
   {
-    int index;
     for (int j = 0; j < dPtr->height; ++j)
-    {
-      for (int i = 0; i < dPtr->width; ++i)
-      {
-        index = j*(dPtr->width*3) + (i*3);
-        *pDest++ = dPtr->imageBuffer[index + 2];  // B
-        *pDest++ = dPtr->imageBuffer[index + 1];  // G
-        *pDest++ = dPtr->imageBuffer[index + 0];  // R
-        *pDest++ = 255;  // Alpha
-      }
-    }
+      memcpy(pDest + j * pitch, dPtr->imageBuffer + j * rowSize, rowSize);
   }
 
   // Unlock the pixel buffer
@@ -43,9 +43,12 @@ namespace gazebo
       /// \brief Texture to draw the video onto.
       public: Ogre::TexturePtr texture;
 
-      /// \brief One frame of the viedeo.
+      /// \brief One frame of the viedeo, in the format of the texture.
       public: unsigned char *imageBuffer;
 
+      /// \brief Bytes per pixel of the texture.
+      public: std::size_t bytesPerPixel = 3;
+
       /// \brief Width of the video.
       public: int width;
 
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
@@ -32,7 +34,9 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Mesh.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginCosts.hh"
 #include "gazebo/common/Skeleton.hh"
+#include "gazebo/common/StartupProfiler.hh"
 
 #include "gazebo/rendering/COMVisual.hh"
 #include "gazebo/rendering/Conversions.hh"
@@ -48,6 +52,7 @@
 #include "gazebo/rendering/RTShaderSystem.hh"
 #include "gazebo/rendering/Scene.hh"
 #include "gazebo/rendering/SelectionObj.hh"
+#include "gazebo/rendering/TextureStreamer.hh"
 #include "gazebo/rendering/Visual.hh"
 #include "gazebo/rendering/VisualPrivate.hh"
 #include "gazebo/rendering/WireBox.hh"
@@ -58,6 +63,86 @@ using namespace rendering;
 // Note: The value of ignition::math::MAX_UI32 is reserved as a flag.
 uint32_t VisualPrivate::visualIdCount = ignition::math::MAX_UI32 - 1;
 
+/// \brief Screen space error, in pixels, from which a camera switches a
+/// mesh to a reduced level of detail.
+static const double kLodPixelError = 1.0;
+
+//////////////////////////////////////////////////
+/// \brief Add the reduced levels of detail of a mesh to its Ogre mesh.
+/// \param[in] _ogreMesh Ogre mesh, with its submeshes and bounds.
+/// \param[in] _errors Geometric error of each reduced level.
+/// \param[in] _subMeshes Submesh of each Ogre submesh.
+static void insertMeshLod(Ogre::MeshPtr _ogreMesh,
+    const std::vector<double> &_errors,
+    const std::vector<const common::SubMesh *> &_subMeshes)
+{
+  // The pixel count strategy measures the projected bounding sphere of the
+  // entity with the camera that renders it
+  Ogre::LodStrategy *strategy =
+      Ogre::LodStrategyManager::getSingleton().getStrategy("pixel_count");
+  if (!strategy || _errors.empty() ||
+      _subMeshes.size() != _ogreMesh->getNumSubMeshes())
+  {
+    return;
+  }
+
+  const uint16_t levels = static_cast<uint16_t>(_errors.size() + 1);
+#if OGRE_VERSION_MAJOR == 1 && OGRE_VERSION_MINOR < 10
+  _ogreMesh->_setLodInfo(levels, false);
+#else
+  _ogreMesh->_setLodInfo(levels);
+#endif
+
+  const double radius = _ogreMesh->getBoundingSphereRadius();
+  for (uint16_t i = 1; i < levels; ++i)
+  {
+    // A level is used once its error projects to less than kLodPixelError
+    // pixels, i.e. once the projected bounding sphere is at most radius /
+    // error times that large. Ogre's pixel count is pi times the square of
+    // the projected diameter.
+    const double diameter = 2.0 * kLodPixelError * radius / _errors[i - 1];
+    Ogre::MeshLodUsage usage;
+    usage.userValue = IGN_PI * diameter * diameter;
+    usage.value = strategy->transformUserValue(usage.userValue);
+    usage.edgeData = nullptr;
+    _ogreMesh->_setLodUsage(i, usage);
+
+    for (unsigned int j = 0; j < _subMeshes.size(); ++j)
+    {
+      Ogre::SubMesh *ogreSubMesh = _ogreMesh->getSubMesh(j);
+      Ogre::IndexData *indexData = new Ogre::IndexData();
+
+      // Submeshes without reduced levels keep their full indices
+      if (_subMeshes[j]->LodLevelCount() < i)
+      {
+        indexData->indexBuffer = ogreSubMesh->indexData->indexBuffer;
+        indexData->indexCount = ogreSubMesh->indexData->indexCount;
+      }
+      else
+      {
+        std::vector<uint32_t> indices(
+            _subMeshes[j]->LodIndices(i - 1).begin(),
+            _subMeshes[j]->LodIndices(i - 1).end());
+
+        // A submesh that vanishes gets a degenerate triangle
+        if (indices.empty())
+          indices.resize(3, 0);
+
+        indexData->indexCount = indices.size();
+        indexData->indexBuffer =
+            Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+              Ogre::HardwareIndexBuffer::IT_32BIT, indices.size(),
+              Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY, false);
+        indexData->indexBuffer->writeData(0,
+            indexData->indexBuffer->getSizeInBytes(), indices.data(), true);
+      }
+      ogreSubMesh->mLodFaceList[i - 1] = indexData;
+    }
+  }
+
+  _ogreMesh->setLodStrategy(strategy);
+}
+
 //////////////////////////////////////////////////
 Visual::Visual(const std::string &_name, VisualPtr _parent, bool _useRTShader)
   : dataPtr(new VisualPrivate)
@@ -193,6 +278,10 @@ Visual::~Visual()
 /////////////////////////////////////////////////
 void Visual::Fini()
 {
+  // Instanced entities must be destroyed before the scene node
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->RemoveInstancing(this);
+
   // Terminate callbacks before clearing other pointers
   this->dataPtr->preRenderConnection.reset();
 
@@ -346,6 +435,7 @@ void Visual::Load(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void Visual::Load()
 {
+  common::StartupScope startupScope("Visual::Load", this->Name());
   std::ostringstream stream;
   ignition::math::Pose3d pose;
   Ogre::MovableObject *obj = nullptr;
@@ -360,6 +450,9 @@ void Visual::Load()
   std::string subMesh = this->GetSubMeshName();
   bool centerSubMesh = this->GetCenterSubMesh();
 
+  if (this->dataPtr->sdf->HasElement("gz:lod"))
+    this->dataPtr->meshLod = this->dataPtr->sdf->Get<bool>("gz:lod");
+
   if (!mesh.empty())
   {
     try
@@ -528,6 +621,9 @@ void Visual::Load()
   // Set invisible if this visual's layer is not active
   if (!this->dataPtr->scene->LayerState(this->dataPtr->layer))
     this->SetVisible(false);
+
+  // Draw with instancing if the visual shares its mesh and material
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -676,6 +772,8 @@ void Visual::AttachObject(Ogre::MovableObject *_obj)
           << _obj->getName() << "] attached.";
 
   _obj->setVisibilityFlags(GZ_VISIBILITY_ALL);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -700,6 +798,9 @@ unsigned int Visual::GetAttachedObjectCount() const
 //////////////////////////////////////////////////
 void Visual::DetachObjects()
 {
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->RemoveInstancing(this);
+
   if (this->dataPtr->sceneNode)
     this->dataPtr->sceneNode->detachAllObjects();
   this->dataPtr->meshName = "";
@@ -800,6 +901,9 @@ Ogre::MovableObject *Visual::AttachMesh(const std::string &_meshName,
         meshName));
   }
 
+  if (!this->dataPtr->meshLod)
+    static_cast<Ogre::Entity *>(obj)->setMeshLodBias(1.0, 0, 0);
+
   this->AttachObject(obj);
   return obj;
 }
@@ -997,6 +1101,8 @@ void Visual::SetLighting(bool _lighting)
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("lighting")->Set(this->dataPtr->lighting);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -1091,6 +1197,10 @@ void Visual::SetMaterial(const std::string &_materialName, bool _unique,
     this->dataPtr->emissive = matEmissive;
   }
 
+  // Compressed textures are swapped in as they become ready
+  TextureStreamer::Instance()->AddMaterial(_materialName);
+  TextureStreamer::Instance()->AddMaterial(this->dataPtr->myMaterialName);
+
   try
   {
     for (unsigned int i = 0;
@@ -1136,6 +1246,8 @@ void Visual::SetMaterial(const std::string &_materialName, bool _unique,
 
   this->dataPtr->sdf->GetElement("material")->GetElement("script")
       ->GetElement("name")->Set(_materialName);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 /////////////////////////////////////////////////
@@ -1314,6 +1426,8 @@ void Visual::SetAmbient(const ignition::math::Color &_color,
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("ambient")->Set(_color);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 /////////////////////////////////////////////////
@@ -1449,6 +1563,8 @@ void Visual::SetSpecular(const ignition::math::Color &_color,
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("specular")->Set(_color);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -1504,6 +1620,8 @@ void Visual::SetEmissive(const ignition::math::Color &_color,
 
   this->dataPtr->sdf->GetElement("material")
       ->GetElement("emissive")->Set(_color);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 /////////////////////////////////////////////////
@@ -1585,6 +1703,8 @@ void Visual::SetWireframe(bool _show)
       }
     }
   }
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -1740,6 +1860,8 @@ void Visual::UpdateTransparency(const bool _cascade)
 
   this->dataPtr->sdf->GetElement("transparency")->Set(
       this->dataPtr->transparency);
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -1861,6 +1983,27 @@ bool Visual::GetCastShadows() const
   return this->dataPtr->castShadows;
 }
 
+//////////////////////////////////////////////////
+void Visual::SetMeshLod(const bool _enable)
+{
+  this->dataPtr->meshLod = _enable;
+
+  // Clamping the range of levels to the first one keeps the full mesh
+  for (int i = 0; i < this->dataPtr->sceneNode->numAttachedObjects(); i++)
+  {
+    Ogre::Entity *ent = dynamic_cast<Ogre::Entity *>(
+        this->dataPtr->sceneNode->getAttachedObject(i));
+    if (ent)
+      ent->setMeshLodBias(1.0, 0, _enable ? 99 : 0);
+  }
+}
+
+//////////////////////////////////////////////////
+bool Visual::MeshLod() const
+{
+  return this->dataPtr->meshLod;
+}
+
 //////////////////////////////////////////////////
 void Visual::SetVisible(bool _visible, bool _cascade)
 {
@@ -2323,11 +2466,16 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
       ogreMesh->setSkeletonName(_mesh->GetName() + "_skeleton");
     }
 
+    // Source of each Ogre submesh, for the levels of detail
+    std::vector<const common::SubMesh *> lodSubMeshes;
+
     for (unsigned int i = 0; i < _mesh->GetSubMeshCount(); i++)
     {
       if (!_subMesh.empty() && _mesh->GetSubMesh(i)->GetName() != _subMesh)
         continue;
 
+      lodSubMeshes.push_back(_mesh->GetSubMesh(i));
+
       Ogre::SubMesh *ogreSubMesh;
       Ogre::VertexData *vertexData;
       Ogre::VertexDeclaration* vertexDecl;
@@ -2545,6 +2693,9 @@ void Visual::InsertMesh(const common::Mesh *_mesh, const std::string &_subMesh,
           Ogre::Vector3(max.X(), max.Y(), max.Z())),
           false);
 
+    if (!_mesh->HasSkeleton())
+      insertMeshLod(ogreMesh, _mesh->LodErrors(), lodSubMeshes);
+
     // this line makes clear the mesh is loaded (avoids memory leaks)
     ogreMesh->load();
   }
@@ -2576,6 +2727,9 @@ void Visual::UpdateFromMsg(const boost::shared_ptr< msgs::Visual const> &_msg)
     }
   }
 
+  if (_msg->has_lod())
+    this->SetMeshLod(_msg->lod());
+
   if (_msg->has_pose())
     this->SetPose(msgs::ConvertIgn(_msg->pose()));
 
@@ -3200,6 +3354,8 @@ void Visual::ShowSkeleton(bool _show)
 //////////////////////////////////////////////////
 void Visual::SetVisibilityFlags(uint32_t _flags)
 {
+  this->dataPtr->scene->RemoveInstancing(this);
+
   for (std::vector<VisualPtr>::iterator iter = this->dataPtr->children.begin();
        iter != this->dataPtr->children.end(); ++iter)
   {
@@ -3221,6 +3377,8 @@ void Visual::SetVisibilityFlags(uint32_t _flags)
   }
 
   this->dataPtr->visibilityFlags = _flags;
+
+  this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
@@ -3384,6 +3542,24 @@ void Visual::SetSkeletonPose(const msgs::PoseAnimation &_pose)
     return;
   }
 
+  // Compact poses of every bone, in the order of the bone handles
+  if (_pose.bone_pose_size() > 0)
+  {
+    const unsigned int boneCount = std::min<unsigned int>(
+        this->dataPtr->skeleton->getNumBones(), _pose.bone_pose_size() / 7);
+    const float *bonePoses = _pose.bone_pose().data();
+    for (unsigned int i = 0; i < boneCount; ++i)
+    {
+      const float *p = bonePoses + i * 7;
+      Ogre::Bone *bone = this->dataPtr->skeleton->getBone(
+          static_cast<uint16_t>(i));
+      bone->setManuallyControlled(true);
+      bone->setPosition(Ogre::Vector3(p[0], p[1], p[2]));
+      bone->setOrientation(Ogre::Quaternion(p[3], p[4], p[5], p[6]));
+    }
+    return;
+  }
+
   for (int i = 0; i < _pose.pose_size(); i++)
   {
     const msgs::Pose& bonePose = _pose.pose(i);
@@ -3423,6 +3599,8 @@ void Visual::LoadPlugins()
       this->dataPtr->plugins.begin();
       iter != this->dataPtr->plugins.end(); ++iter)
   {
+    common::PluginCostScope costScope(
+        this->Name() + "::" + (*iter)->GetHandle(), (*iter)->GetFilename());
     (*iter)->Init();
   }
 }
@@ -3432,6 +3610,7 @@ void Visual::LoadPlugin(const std::string &_filename,
                        const std::string &_name,
                        sdf::ElementPtr _sdf)
 {
+  common::PluginCostScope costScope(this->Name() + "::" + _name, _filename);
   gazebo::VisualPluginPtr plugin = gazebo::VisualPlugin::Create(_filename,
                                                               _name);
 
@@ -3508,6 +3687,10 @@ Visual::VisualType Visual::GetType() const
 void Visual::SetType(const Visual::VisualType _type)
 {
   this->dataPtr->type = _type;
+
+  // Only VT_VISUAL visuals are instanced
+  if (this->dataPtr->scene)
+    this->dataPtr->scene->UpdateInstancing(this);
 }
 
 //////////////////////////////////////////////////
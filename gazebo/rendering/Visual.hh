@@ -321,6 +321,20 @@ namespace gazebo
       /// \return True if the visual casts shadows.
       public: bool GetCastShadows() const;
 
+      /// \brief Set whether the mesh of the visual is drawn with its
+      /// reduced levels of detail, which each camera selects from the
+      /// number of pixels the mesh covers. Enabled by default. It can be
+      /// disabled from SDF with the custom element <gz:lod>false</gz:lod>
+      /// of the visual.
+      /// \param[in] _enable False to always draw the full resolution mesh.
+      /// \sa common::MeshManager::SetLodTriangleThreshold()
+      public: void SetMeshLod(const bool _enable);
+
+      /// \brief Get whether the mesh of the visual is drawn with its
+      /// reduced levels of detail.
+      /// \return True if levels of detail are enabled.
+      public: bool MeshLod() const;
+
       /// \brief Set whether the visual should cast shadows.
       /// \param[in] _shadows True to enable shadows.
       public: void SetCastShadows(bool _shadows);
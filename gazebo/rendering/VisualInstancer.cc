@@ -0,0 +1,597 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/rendering/Visual.hh"
+#include "gazebo/rendering/VisualInstancer.hh"
+
+using namespace gazebo;
+using namespace rendering;
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    /// \internal
+    /// \brief Visuals that share a mesh and material values.
+    class VisualInstancerGroup
+    {
+      /// \brief Instanced material of each submesh, created when the
+      /// group is instanced.
+      public: std::vector<std::string> materials;
+
+      /// \brief The visuals of the group.
+      public: std::set<Visual *> members;
+
+      /// \brief True if the members are drawn with instancing.
+      public: bool instanced = false;
+
+      /// \brief True if instancing the group failed, so it isn't retried.
+      public: bool failed = false;
+    };
+
+    /// \internal
+    /// \brief A visual known to the instancer.
+    class VisualInstancerEntry
+    {
+      /// \brief Key of the group of the visual.
+      public: std::string key;
+
+      /// \brief Mesh entity of the visual.
+      public: Ogre::Entity *entity = nullptr;
+
+      /// \brief Instanced entity of each submesh, empty if the visual is
+      /// drawn by its entity.
+      public: std::vector<Ogre::InstancedEntity *> instances;
+
+      /// \brief True if the visual is drawn with instancing.
+      public: bool instanced = false;
+    };
+
+    /// \internal
+    /// \brief Private data for VisualInstancer
+    class VisualInstancerPrivate
+    {
+      /// \brief Get the group key of a visual.
+      /// \param[in] _vis The visual.
+      /// \param[out] _entity The mesh entity of the visual.
+      /// \return The key, or an empty string if the visual can't be
+      /// instanced.
+      public: std::string Key(Visual *_vis, Ogre::Entity *&_entity) const;
+
+      /// \brief Draw a visual with instancing.
+      /// \param[in] _vis The visual.
+      /// \param[in] _entry The entry of the visual.
+      /// \param[in] _group The group of the visual.
+      /// \return True on success.
+      public: bool Instance(Visual *_vis, VisualInstancerEntry &_entry,
+                            VisualInstancerGroup &_group);
+
+      /// \brief Draw a visual by its entity again.
+      /// \param[in] _vis The visual.
+      /// \param[in] _entry The entry of the visual.
+      public: void Release(Visual *_vis, VisualInstancerEntry &_entry);
+
+      /// \brief Instance all the members of a group.
+      /// \param[in] _group The group.
+      public: void InstanceGroup(VisualInstancerGroup &_group);
+
+      /// \brief Remove a visual from its group, and destroy the group if
+      /// it is empty.
+      /// \param[in] _iter The entry of the visual.
+      public: void Erase(
+                  std::map<Visual *, VisualInstancerEntry>::iterator _iter);
+
+      /// \brief Create the instanced material of a submesh.
+      /// \param[in] _source Material of the submesh.
+      /// \return Name of the new material.
+      public: std::string CreateMaterial(const Ogre::MaterialPtr &_source);
+
+      /// \brief Get the instance manager of a submesh, which is created
+      /// the first time.
+      /// \param[in] _mesh The mesh.
+      /// \param[in] _subMesh Index of the submesh.
+      /// \param[in] _material Instanced material, used to size batches.
+      /// \return The manager, or null if the submesh can't be instanced.
+      public: Ogre::InstanceManager *Manager(const Ogre::MeshPtr &_mesh,
+                  const unsigned int _subMesh, const std::string &_material);
+
+      /// \brief Scene manager of the visuals.
+      public: Ogre::SceneManager *manager = nullptr;
+
+      /// \brief Minimum number of visuals of an instanced group.
+      public: unsigned int threshold = 0;
+
+      /// \brief True if the render system supports instancing.
+      public: bool supported = false;
+
+      /// \brief Groups by key.
+      public: std::map<std::string, VisualInstancerGroup> groups;
+
+      /// \brief Known visuals.
+      public: std::map<Visual *, VisualInstancerEntry> visuals;
+
+      /// \brief Instance managers by mesh and submesh. A null manager
+      /// marks a submesh that can't be instanced.
+      public: std::map<std::string, Ogre::InstanceManager *> instanceManagers;
+
+      /// \brief Number of instanced visuals.
+      public: unsigned int instancedCount = 0;
+
+      /// \brief Number of materials created, used to name them.
+      public: unsigned int materialCount = 0;
+    };
+  }
+}
+
+/// \brief Maximum number of instances drawn by a batch.
+static const size_t kInstancesPerBatch = 256;
+
+/// \brief Visibility flags of the instance batches.
+static const uint32_t kBatchFlags = GZ_VISIBILITY_INSTANCED;
+
+/// \brief Visibility flags of the entity of an instanced visual.
+static const uint32_t kSourceFlags =
+    GZ_VISIBILITY_SELECTABLE | GZ_VISIBILITY_INSTANCE_SOURCE;
+
+/////////////////////////////////////////////////
+VisualInstancer::VisualInstancer(Ogre::SceneManager *_manager)
+  : dataPtr(new VisualInstancerPrivate)
+{
+  this->dataPtr->manager = _manager;
+
+  Ogre::Root *root = Ogre::Root::getSingletonPtr();
+  Ogre::RenderSystem *renderSystem = root ? root->getRenderSystem() : nullptr;
+  this->dataPtr->supported = _manager && renderSystem &&
+      renderSystem->getCapabilities() &&
+      renderSystem->getCapabilities()->hasCapability(
+          Ogre::RSC_VERTEX_BUFFER_INSTANCE_DATA);
+}
+
+/////////////////////////////////////////////////
+VisualInstancer::~VisualInstancer()
+{
+}
+
+/////////////////////////////////////////////////
+void VisualInstancer::SetThreshold(const unsigned int _count)
+{
+  this->dataPtr->threshold = _count;
+
+  if (_count == 0)
+  {
+    while (!this->dataPtr->visuals.empty())
+      this->dataPtr->Erase(this->dataPtr->visuals.begin());
+    return;
+  }
+
+  for (auto &group : this->dataPtr->groups)
+  {
+    if (!group.second.instanced && !group.second.failed &&
+        group.second.members.size() >= _count)
+    {
+      this->dataPtr->InstanceGroup(group.second);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualInstancer::Threshold() const
+{
+  return this->dataPtr->threshold;
+}
+
+/////////////////////////////////////////////////
+bool VisualInstancer::Supported() const
+{
+  return this->dataPtr->supported;
+}
+
+/////////////////////////////////////////////////
+void VisualInstancer::Update(Visual *_vis)
+{
+  if (!this->dataPtr->supported || this->dataPtr->threshold == 0 || !_vis)
+    return;
+
+  Ogre::Entity *entity = nullptr;
+  const std::string key = this->dataPtr->Key(_vis, entity);
+
+  auto iter = this->dataPtr->visuals.find(_vis);
+  if (iter != this->dataPtr->visuals.end())
+  {
+    if (iter->second.key == key && iter->second.entity == entity)
+      return;
+    this->dataPtr->Erase(iter);
+  }
+
+  if (key.empty())
+    return;
+
+  VisualInstancerEntry &entry = this->dataPtr->visuals[_vis];
+  entry.key = key;
+  entry.entity = entity;
+
+  VisualInstancerGroup &group = this->dataPtr->groups[key];
+  group.members.insert(_vis);
+
+  if (group.instanced)
+  {
+    if (!this->dataPtr->Instance(_vis, entry, group))
+      this->dataPtr->Release(_vis, entry);
+  }
+  else if (!group.failed && group.members.size() >= this->dataPtr->threshold)
+  {
+    this->dataPtr->InstanceGroup(group);
+  }
+}
+
+/////////////////////////////////////////////////
+void VisualInstancer::Remove(Visual *_vis)
+{
+  auto iter = this->dataPtr->visuals.find(_vis);
+  if (iter != this->dataPtr->visuals.end())
+    this->dataPtr->Erase(iter);
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualInstancer::InstancedCount() const
+{
+  return this->dataPtr->instancedCount;
+}
+
+/////////////////////////////////////////////////
+unsigned int VisualInstancer::BatchCount() const
+{
+  unsigned int count = 0;
+  for (auto const &mgr : this->dataPtr->instanceManagers)
+  {
+    if (!mgr.second)
+      continue;
+
+    auto iter = mgr.second->getInstanceBatchMapIterator();
+    while (iter.hasMoreElements())
+    {
+      count += iter.peekNextValue().size();
+      iter.moveNext();
+    }
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+void VisualInstancer::Clear()
+{
+  while (!this->dataPtr->visuals.empty())
+    this->dataPtr->Erase(this->dataPtr->visuals.begin());
+
+  for (auto &mgr : this->dataPtr->instanceManagers)
+  {
+    if (mgr.second)
+      this->dataPtr->manager->destroyInstanceManager(mgr.second);
+  }
+  this->dataPtr->instanceManagers.clear();
+}
+
+/////////////////////////////////////////////////
+std::string VisualInstancerPrivate::Key(Visual *_vis,
+    Ogre::Entity *&_entity) const
+{
+  _entity = nullptr;
+
+  Ogre::SceneNode *node = _vis->GetSceneNode();
+  if (!node || _vis->GetType() != Visual::VT_VISUAL ||
+      _vis->GetVisibilityFlags() != GZ_VISIBILITY_ALL ||
+      _vis->DerivedTransparency() > 0)
+  {
+    return std::string();
+  }
+
+  // A single mesh entity, besides the instanced entities of the visual
+  for (unsigned int i = 0; i < node->numAttachedObjects(); ++i)
+  {
+    Ogre::MovableObject *obj = node->getAttachedObject(i);
+    if (dynamic_cast<Ogre::InstancedEntity *>(obj))
+      continue;
+
+    Ogre::Entity *entity = dynamic_cast<Ogre::Entity *>(obj);
+    if (!entity || _entity)
+      return std::string();
+    _entity = entity;
+  }
+
+  if (!_entity || _entity->hasSkeleton() || _entity->hasVertexAnimation())
+    return std::string();
+
+  Ogre::MeshPtr mesh = _entity->getMesh();
+  if (mesh.isNull() || mesh->getNumSubMeshes() != _entity->getNumSubEntities())
+    return std::string();
+
+  std::ostringstream key;
+  key << mesh->getName();
+
+  for (unsigned int i = 0; i < _entity->getNumSubEntities(); ++i)
+  {
+    // The instance data follows the texture coordinates of the mesh, and
+    // the instancing shaders expect a single set of them.
+    Ogre::SubMesh *subMesh = mesh->getSubMesh(i);
+    Ogre::VertexData *vertexData = subMesh->useSharedVertices ?
+        mesh->sharedVertexData : subMesh->vertexData;
+    if (!vertexData)
+      return std::string();
+
+    const Ogre::VertexDeclaration *decl = vertexData->vertexDeclaration;
+    if (!decl->findElementBySemantic(Ogre::VES_NORMAL) ||
+        !decl->findElementBySemantic(Ogre::VES_TEXTURE_COORDINATES, 0) ||
+        decl->findElementBySemantic(Ogre::VES_TEXTURE_COORDINATES, 1))
+    {
+      return std::string();
+    }
+
+    Ogre::MaterialPtr material = _entity->getSubEntity(i)->getMaterial();
+    if (material.isNull())
+      return std::string();
+
+    // Only the default scheme technique, the shader system adds its own
+    Ogre::Technique *technique = nullptr;
+    for (unsigned int t = 0; t < material->getNumTechniques(); ++t)
+    {
+      Ogre::Technique *tech = material->getTechnique(t);
+      if (tech->getSchemeName() != Ogre::MaterialManager::DEFAULT_SCHEME_NAME)
+        continue;
+      if (technique)
+        return std::string();
+      technique = tech;
+    }
+
+    if (!technique || technique->getNumPasses() != 1)
+      return std::string();
+
+    Ogre::Pass *pass = technique->getPass(0);
+    if (pass->isProgrammable() || !pass->getLightingEnabled() ||
+        !pass->getDepthWriteEnabled() ||
+        pass->getPolygonMode() != Ogre::PM_SOLID ||
+        pass->getDestBlendFactor() != Ogre::SBF_ZERO ||
+        pass->getNumTextureUnitStates() > 1)
+    {
+      return std::string();
+    }
+
+    key << "|" << pass->getAmbient() << "," << pass->getDiffuse() << ","
+        << pass->getSpecular() << "," << pass->getSelfIllumination() << ","
+        << pass->getShininess() << "," << pass->getCullingMode();
+    if (pass->getNumTextureUnitStates() > 0)
+      key << "," << pass->getTextureUnitState(0)->getTextureName();
+  }
+
+  return key.str();
+}
+
+/////////////////////////////////////////////////
+bool VisualInstancerPrivate::Instance(Visual *_vis,
+    VisualInstancerEntry &_entry, VisualInstancerGroup &_group)
+{
+  Ogre::MeshPtr mesh = _entry.entity->getMesh();
+
+  try
+  {
+    if (_group.materials.empty())
+    {
+      for (unsigned int i = 0; i < _entry.entity->getNumSubEntities(); ++i)
+      {
+        _group.materials.push_back(this->CreateMaterial(
+            _entry.entity->getSubEntity(i)->getMaterial()));
+      }
+    }
+
+    for (unsigned int i = 0; i < _group.materials.size(); ++i)
+    {
+      Ogre::InstanceManager *mgr =
+          this->Manager(mesh, i, _group.materials[i]);
+      if (!mgr)
+        return false;
+
+      Ogre::InstancedEntity *instance =
+          mgr->createInstancedEntity(_group.materials[i]);
+      if (!instance)
+        return false;
+
+      instance->getUserObjectBindings().setUserAny(Ogre::Any(_vis->Name()));
+      _vis->GetSceneNode()->attachObject(instance);
+      _entry.instances.push_back(instance);
+
+      // The batches are created as needed. The instancing shaders don't
+      // write into shadow textures, the entities cast the shadows.
+      instance->_getOwner()->setVisibilityFlags(kBatchFlags);
+      instance->_getOwner()->setCastShadows(false);
+    }
+  }
+  catch(Ogre::Exception &e)
+  {
+    gzwarn << "Unable to instance visual[" << _vis->Name() << "]: "
+           << e.getDescription() << std::endl;
+    return false;
+  }
+
+  _entry.entity->setVisibilityFlags(kSourceFlags);
+  _entry.instanced = true;
+  ++this->instancedCount;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void VisualInstancerPrivate::Release(Visual *_vis,
+    VisualInstancerEntry &_entry)
+{
+  // A visual that failed half way has instances but isn't instanced
+  if (_entry.instanced)
+  {
+    _entry.entity->setVisibilityFlags(_vis->GetVisibilityFlags());
+    _entry.instanced = false;
+    --this->instancedCount;
+  }
+
+  for (auto instance : _entry.instances)
+  {
+    instance->detachFromParent();
+    this->manager->destroyInstancedEntity(instance);
+  }
+  _entry.instances.clear();
+}
+
+/////////////////////////////////////////////////
+void VisualInstancerPrivate::InstanceGroup(VisualInstancerGroup &_group)
+{
+  _group.instanced = true;
+
+  for (auto vis : _group.members)
+  {
+    VisualInstancerEntry &entry = this->visuals[vis];
+    if (entry.instanced)
+      continue;
+
+    if (!this->Instance(vis, entry, _group))
+    {
+      _group.failed = true;
+      _group.instanced = false;
+      break;
+    }
+  }
+
+  if (!_group.failed)
+    return;
+
+  for (auto vis : _group.members)
+    this->Release(vis, this->visuals[vis]);
+}
+
+/////////////////////////////////////////////////
+void VisualInstancerPrivate::Erase(
+    std::map<Visual *, VisualInstancerEntry>::iterator _iter)
+{
+  this->Release(_iter->first, _iter->second);
+
+  auto groupIter = this->groups.find(_iter->second.key);
+  if (groupIter != this->groups.end())
+  {
+    VisualInstancerGroup &group = groupIter->second;
+    group.members.erase(_iter->first);
+
+    if (group.members.empty())
+    {
+      for (auto &mgr : this->instanceManagers)
+      {
+        if (mgr.second)
+          mgr.second->cleanupEmptyBatches();
+      }
+
+      for (auto const &material : group.materials)
+        Ogre::MaterialManager::getSingleton().remove(material);
+
+      this->groups.erase(groupIter);
+    }
+  }
+
+  this->visuals.erase(_iter);
+}
+
+/////////////////////////////////////////////////
+std::string VisualInstancerPrivate::CreateMaterial(
+    const Ogre::MaterialPtr &_source)
+{
+  std::string name = "__GZ_INSTANCED_MATERIAL_" +
+      std::to_string(this->materialCount++);
+
+  Ogre::MaterialPtr material = _source->clone(name);
+
+  // Keep the default scheme technique only
+  for (int t = material->getNumTechniques() - 1; t >= 0; --t)
+  {
+    if (material->getTechnique(t)->getSchemeName() !=
+        Ogre::MaterialManager::DEFAULT_SCHEME_NAME)
+    {
+      material->removeTechnique(t);
+    }
+  }
+
+  Ogre::Technique *technique = material->getTechnique(0);
+  Ogre::Pass *ambientPass = technique->getPass(0);
+  const float textured =
+      ambientPass->getNumTextureUnitStates() > 0 ? 1.0f : 0.0f;
+
+  // Same surface, added once per light
+  Ogre::Pass *lightPass = technique->createPass();
+  *lightPass = *ambientPass;
+  lightPass->setIteratePerLight(true, false);
+  lightPass->setMaxSimultaneousLights(8);
+  lightPass->setSceneBlending(Ogre::SBT_ADD);
+  lightPass->setDepthWriteEnabled(false);
+  lightPass->setDepthFunction(Ogre::CMPF_LESS_EQUAL);
+
+  ambientPass->setVertexProgram("instancing_vp_glsl");
+  ambientPass->setFragmentProgram("instancing_ambient_fp_glsl");
+  ambientPass->getFragmentProgramParameters()->setNamedConstant(
+      "textured", textured);
+
+  lightPass->setVertexProgram("instancing_vp_glsl");
+  lightPass->setFragmentProgram("instancing_light_fp_glsl");
+  lightPass->getFragmentProgramParameters()->setNamedConstant(
+      "textured", textured);
+
+  material->load();
+  return name;
+}
+
+/////////////////////////////////////////////////
+Ogre::InstanceManager *VisualInstancerPrivate::Manager(
+    const Ogre::MeshPtr &_mesh, const unsigned int _subMesh,
+    const std::string &_material)
+{
+  const std::string name = "__GZ_INSTANCE_MANAGER_" + _mesh->getName() +
+      "::" + std::to_string(_subMesh);
+
+  auto iter = this->instanceManagers.find(name);
+  if (iter != this->instanceManagers.end())
+    return iter->second;
+
+  Ogre::InstanceManager *mgr = nullptr;
+  const size_t count = this->manager->getMaxOrBestNumInstancesPerBatch(
+      _material, _mesh->getName(), _mesh->getGroup(),
+      Ogre::InstanceManager::HWInstancingBasic, kInstancesPerBatch, 0,
+      _subMesh);
+
+  if (count > 0)
+  {
+    mgr = this->manager->createInstanceManager(name, _mesh->getName(),
+        _mesh->getGroup(), Ogre::InstanceManager::HWInstancingBasic, count, 0,
+        _subMesh);
+  }
+  else
+  {
+    gzwarn << "Unable to instance mesh[" << _mesh->getName() << "]\n";
+  }
+
+  this->instanceManagers[name] = mgr;
+  return mgr;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_RENDERING_VISUALINSTANCER_HH_
+#define GAZEBO_RENDERING_VISUALINSTANCER_HH_
+
+#include <memory>
+
+#include "gazebo/util/system.hh"
+
+namespace Ogre
+{
+  class SceneManager;
+}
+
+namespace gazebo
+{
+  namespace rendering
+  {
+    // Forward declarations.
+    class Visual;
+    class VisualInstancerPrivate;
+
+    /// \cond
+    /// \brief Draws the visuals of a scene that share a mesh and a
+    /// material with hardware instancing.
+    ///
+    /// A visual is a candidate when it has a single mesh entity without
+    /// animation, with normals and one set of texture coordinates, and
+    /// opaque, lit, single pass materials without shaders. Candidates are
+    /// grouped by mesh and material values, and the members of a group are
+    /// drawn by instance batches once there are at least Threshold() of
+    /// them. The instanced entities are attached to the scene node of the
+    /// visual, so that they follow its pose and visibility. The entity of
+    /// the visual is only rendered by the cameras that don't draw color,
+    /// such as the selection buffer, shadow textures and depth cameras.
+    /// A visual that stops being a candidate, e.g. because it becomes
+    /// transparent, is drawn by its entity again. Only the Scene class
+    /// should use this class.
+    class GZ_RENDERING_VISIBLE VisualInstancer
+    {
+      /// \brief Constructor
+      /// \param[in] _manager Scene manager of the visuals.
+      public: explicit VisualInstancer(Ogre::SceneManager *_manager);
+
+      /// \brief Destructor. Clear() must be called first while the scene
+      /// manager exists.
+      public: virtual ~VisualInstancer();
+
+      /// \brief Set the number of visuals a group needs to be instanced.
+      /// Lowering it instances the groups that are now large enough.
+      /// \param[in] _count Minimum number of visuals, or 0 to draw every
+      /// visual by its entity.
+      public: void SetThreshold(const unsigned int _count);
+
+      /// \brief Get the number of visuals a group needs to be instanced.
+      /// \return Minimum number of visuals, 0 if instancing is off.
+      public: unsigned int Threshold() const;
+
+      /// \brief Tell whether the render system supports instancing.
+      /// \return True if visuals can be instanced.
+      public: bool Supported() const;
+
+      /// \brief Add a visual, or check it again after its mesh, material,
+      /// transparency or visibility flags changed. Does nothing while the
+      /// threshold is 0.
+      /// \param[in] _vis The visual.
+      public: void Update(Visual *_vis);
+
+      /// \brief Remove a visual, which is drawn by its entity again.
+      /// \param[in] _vis The visual.
+      public: void Remove(Visual *_vis);
+
+      /// \brief Get the number of visuals drawn with instancing.
+      /// \return Number of instanced visuals.
+      public: unsigned int InstancedCount() const;
+
+      /// \brief Get the number of instance batches.
+      /// \return Number of batches, which is the number of draw calls
+      /// used by the instanced visuals of a camera.
+      public: unsigned int BatchCount() const;
+
+      /// \brief Remove all the visuals and destroy the instance managers.
+      public: void Clear();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<VisualInstancerPrivate> dataPtr;
+    };
+    /// \endcond
+  }
+}
+#endif
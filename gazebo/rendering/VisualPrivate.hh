@@ -222,6 +222,9 @@ namespace gazebo
 
       /// \brief Original ogre materials used by the submeshes in the visual
       public: std::map<std::string, Ogre::MaterialPtr> submeshMaterials;
+
+      /// \brief False to draw the mesh at full resolution only.
+      public: bool meshLod = true;
     };
     /// \}
   }
@@ -30,6 +30,9 @@
 
 #endif /* HAVE_OPENGL */
 
+#include <algorithm>
+#include <cmath>
+
 #include <ignition/math/Color.hh>
 
 #include "gazebo/rendering/ogre_gazebo.h"
@@ -512,6 +515,14 @@ int WideAngleCamera::EnvTextureSize() const
   return this->dataPtr->envTextureSize;
 }
 
+//////////////////////////////////////////////////
+unsigned int WideAngleCamera::RenderedFaceCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
+
+  return this->dataPtr->renderedFaceCount;
+}
+
 //////////////////////////////////////////////////
 CameraLens *WideAngleCamera::Lens() const
 {
@@ -682,7 +693,8 @@ void WideAngleCamera::CreateEnvRenderTexture(const std::string &_textureName)
     auto const &gzBgColor = this->scene->BackgroundColor();
     vp->setBackgroundColour(Conversions::Convert(gzBgColor));
     vp->setVisibilityMask(GZ_VISIBILITY_ALL &
-        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+        ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+          GZ_VISIBILITY_INSTANCE_SOURCE));
 
     this->dataPtr->envViewports[i] = vp;
 
@@ -698,8 +710,37 @@ void WideAngleCamera::RenderImpl()
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->renderMutex);
 
+  // The lens maps each pixel to a direction at an angle theta from the
+  // optical axis, and pixels past the cut off angle are black. The face
+  // that looks along the axis (+Z of the cube map) is always sampled. The
+  // side faces are only sampled past 45 degrees, and the back face past
+  // the angle of its corners, acos(-1/sqrt(3)). A margin of a couple of
+  // texels covers the filtering across the seams.
+  const double cutOff = this->dataPtr->lens->CutOffAngle();
+  const double margin = IGN_PI / std::max(this->dataPtr->envTextureSize, 1);
+  const Ogre::Vector3 axis = this->dataPtr->envCameras[4]->getOrientation() *
+      Ogre::Vector3::NEGATIVE_UNIT_Z;
+
+  unsigned int count = 0;
   for (int i = 0; i < 6; ++i)
-    this->dataPtr->envRenderTargets[i]->update();
+  {
+    const double dot = axis.dotProduct(
+        this->dataPtr->envCameras[i]->getOrientation() *
+        Ogre::Vector3::NEGATIVE_UNIT_Z);
+
+    double nearest = 0;
+    if (dot < -0.5)
+      nearest = std::acos(-1.0 / std::sqrt(3.0));
+    else if (dot < 0.5)
+      nearest = IGN_PI * 0.25;
+
+    if (cutOff + margin > nearest)
+    {
+      this->dataPtr->envRenderTargets[i]->update();
+      ++count;
+    }
+  }
+  this->dataPtr->renderedFaceCount = count;
 
   this->dataPtr->compMat->getTechnique(0)->getPass(0)->getTextureUnitState(0)->
       setTextureName(this->dataPtr->envCubeMapTexture->getName());
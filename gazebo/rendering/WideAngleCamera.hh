@@ -213,6 +213,12 @@ namespace gazebo
       /// \param[in] _size Texture size
       public: void SetEnvTextureSize(const int _size);
 
+      /// \brief Get the number of cube faces rendered by the last frame.
+      /// Faces that only cover directions outside the lens cut off angle
+      /// are not rendered.
+      /// \return Number of faces, from 1 to 6.
+      public: unsigned int RenderedFaceCount() const;
+
       /// \brief Creates a set of 6 cameras pointing in different directions
       protected: void CreateEnvCameras();
 
@@ -59,6 +59,9 @@ namespace gazebo
       /// \brief Viewports for the render targets
       public: Ogre::Viewport *envViewports[6];
 
+      /// \brief Number of cube faces rendered by the last frame.
+      public: unsigned int renderedFaceCount = 6;
+
       /// \brief A single cube map texture
       public: Ogre::Texture *envCubeMapTexture;
 
@@ -15,10 +15,15 @@
  *
 */
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <vector>
 #include <ignition/math/Color.hh>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Time.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/RenderTypes.hh"
 #include "gazebo/rendering/selection_buffer/SelectionRenderListener.hh"
@@ -28,6 +33,14 @@
 using namespace gazebo;
 using namespace rendering;
 
+/// \brief Ratio between the size of the render target and the size of the
+/// low resolution cache.
+static const unsigned int kCacheScale = 4;
+
+/// \brief Longest time a cache is used while the camera doesn't move, so
+/// that moving entities are picked up (seconds).
+static const double kCacheMaxAge = 0.25;
+
 namespace gazebo
 {
   namespace rendering
@@ -71,6 +84,44 @@ namespace gazebo
       /// \brief A 2D overlay used for debugging the selection buffer. It
       /// is hidden by default.
       Ogre::Overlay *selectionDebugOverlay;
+
+      /// \brief Name of the camera.
+      std::string cameraName;
+
+      /// \brief True if the low resolution cache may be used.
+      bool cacheEnabled = true;
+
+      /// \brief Material switcher of the cache, which keeps the colors of
+      /// the entities while the 1x1 buffer is updated.
+      std::unique_ptr<MaterialSwitcher> cacheMaterialSwitchListener;
+
+      /// \brief Render target listener of the cache.
+      std::unique_ptr<SelectionRenderListener> cacheTargetListener;
+
+      /// \brief Texture of the cache, 1/kCacheScale of the render target.
+      Ogre::TexturePtr cacheTexture;
+
+      /// \brief Render texture of the cache.
+      Ogre::RenderTexture *cacheRenderTexture = nullptr;
+
+      /// \brief Content of the cache, with room to read 4 bytes at the
+      /// last pixel.
+      std::vector<uint8_t> cacheBuffer;
+
+      /// \brief Ogre pixel box of the cache buffer.
+      std::unique_ptr<Ogre::PixelBox> cachePixelBox;
+
+      /// \brief True if the cache buffer holds the current view.
+      bool cacheValid = false;
+
+      /// \brief Wall time when the cache was rendered.
+      common::Time cacheTime;
+
+      /// \brief View matrix of the camera at the last query.
+      Ogre::Matrix4 lastView = Ogre::Matrix4::ZERO;
+
+      /// \brief Projection matrix of the camera at the last query.
+      Ogre::Matrix4 lastProjection = Ogre::Matrix4::ZERO;
     };
   }
 }
@@ -82,6 +133,11 @@ SelectionBuffer::SelectionBuffer(const std::string &_cameraName,
 {
   this->dataPtr->sceneMgr = _mgr;
   this->dataPtr->renderTarget = _renderTarget;
+  this->dataPtr->cameraName = _cameraName;
+
+  // Cache the view at a low resolution unless GAZEBO_SELECTION_CACHE=0
+  const char *env = getenv("GAZEBO_SELECTION_CACHE");
+  this->dataPtr->cacheEnabled = !env || std::string(env) != "0";
 
   this->dataPtr->camera = this->dataPtr->sceneMgr->getCamera(_cameraName);
 
@@ -91,6 +147,9 @@ SelectionBuffer::SelectionBuffer(const std::string &_cameraName,
   this->dataPtr->materialSwitchListener.reset(new MaterialSwitcher());
   this->dataPtr->selectionTargetListener.reset(new SelectionRenderListener(
       this->dataPtr->materialSwitchListener.get()));
+  this->dataPtr->cacheMaterialSwitchListener.reset(new MaterialSwitcher());
+  this->dataPtr->cacheTargetListener.reset(new SelectionRenderListener(
+      this->dataPtr->cacheMaterialSwitchListener.get()));
   this->CreateRTTBuffer();
   this->CreateRTTOverlays();
 }
@@ -98,6 +157,7 @@ SelectionBuffer::SelectionBuffer(const std::string &_cameraName,
 /////////////////////////////////////////////////
 SelectionBuffer::~SelectionBuffer()
 {
+  this->DeleteCache();
   this->DeleteRTTBuffer();
 
   // remove selection buffer camera
@@ -200,6 +260,10 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
       || _y >= static_cast<int>(targetHeight))
     return nullptr;
 
+  Ogre::Entity *cached = nullptr;
+  if (this->CacheLookup(_x, _y, cached))
+    return cached;
+
   // 1x1 selection buffer, adapted from rviz
   // http://docs.ros.org/indigo/api/rviz/html/c++/selection__manager_8cpp.html
   unsigned int width = 1;
@@ -251,6 +315,188 @@ Ogre::Entity *SelectionBuffer::OnSelectionClick(int _x, int _y)
     return this->dataPtr->sceneMgr->getEntity(entName);
 }
 
+/////////////////////////////////////////////////
+bool SelectionBuffer::CacheLookup(const int _x, const int _y,
+    Ogre::Entity *&_entity)
+{
+  if (!this->dataPtr->cacheEnabled)
+    return false;
+
+  // The cache is only rendered once the camera stops moving, since it
+  // costs more than the 1x1 buffer.
+  const Ogre::Matrix4 &view = this->dataPtr->camera->getViewMatrix();
+  const Ogre::Matrix4 &projection =
+    this->dataPtr->camera->getProjectionMatrix();
+  if (view != this->dataPtr->lastView ||
+      projection != this->dataPtr->lastProjection)
+  {
+    this->dataPtr->lastView = view;
+    this->dataPtr->lastProjection = projection;
+    this->dataPtr->cacheValid = false;
+    return false;
+  }
+
+  if (!this->dataPtr->cacheValid ||
+      (common::Time::GetWallTime() - this->dataPtr->cacheTime).Double() >
+      kCacheMaxAge)
+  {
+    this->UpdateCache();
+    if (!this->dataPtr->cacheValid)
+      return false;
+  }
+
+  const Ogre::PixelBox &box = *this->dataPtr->cachePixelBox;
+  const int width = static_cast<int>(box.getWidth());
+  const int height = static_cast<int>(box.getHeight());
+  const int cx = _x * width / this->dataPtr->renderTarget->getWidth();
+  const int cy = _y * height / this->dataPtr->renderTarget->getHeight();
+  const size_t pixelSize = Ogre::PixelUtil::getNumElemBytes(box.format);
+
+  // Color of a pixel of the cache, or nothing outside of the cache.
+  auto pixel = [&](const int _px, const int _py) -> uint32_t
+  {
+    const int px = std::max(0, std::min(width - 1, _px));
+    const int py = std::max(0, std::min(height - 1, _py));
+    ignition::math::Color::BGRA color(0);
+    memcpy(static_cast<void *>(&color), this->dataPtr->cacheBuffer.data() +
+        (py * box.rowPitch + px) * pixelSize, 4);
+    ignition::math::Color cv;
+    cv.SetFromARGB(color);
+    cv.A(1.0);
+    return cv.AsRGBA();
+  };
+
+  // Only trust the cache away from the edges of entities, where a low
+  // resolution pixel covers a single entity.
+  const uint32_t center = pixel(cx, cy);
+  for (int dy = -1; dy <= 1; ++dy)
+  {
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+      if (pixel(cx + dx, cy + dy) != center)
+        return false;
+    }
+  }
+
+  ignition::math::Color cv;
+  cv.SetFromRGBA(center);
+  const std::string &entName =
+    this->dataPtr->cacheMaterialSwitchListener->GetEntityName(cv);
+
+  if (entName.empty())
+  {
+    _entity = nullptr;
+    return true;
+  }
+
+  // The entity may have been removed since the cache was rendered
+  if (!this->dataPtr->sceneMgr->hasEntity(entName))
+    return false;
+
+  _entity = this->dataPtr->sceneMgr->getEntity(entName);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void SelectionBuffer::UpdateCache()
+{
+  this->dataPtr->cacheValid = false;
+
+  unsigned int width = std::max(1u,
+      this->dataPtr->renderTarget->getWidth() / kCacheScale);
+  unsigned int height = std::max(1u,
+      this->dataPtr->renderTarget->getHeight() / kCacheScale);
+
+  // Create the texture, or create it again when the target is resized
+  if (this->dataPtr->cacheTexture.isNull() ||
+      this->dataPtr->cacheTexture->getWidth() != width ||
+      this->dataPtr->cacheTexture->getHeight() != height)
+  {
+    this->DeleteCache();
+
+    try
+    {
+      this->dataPtr->cacheTexture =
+        Ogre::TextureManager::getSingleton().createManual(
+          this->dataPtr->cameraName + "_SelectionCacheTex",
+          Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+          Ogre::TEX_TYPE_2D, width, height, 0, Ogre::PF_R8G8B8,
+          Ogre::TU_RENDERTARGET);
+    }
+    catch(...)
+    {
+      gzwarn << "Unable to create the selection buffer cache.\n";
+      this->dataPtr->cacheEnabled = false;
+      return;
+    }
+
+    this->dataPtr->cacheRenderTexture =
+      this->dataPtr->cacheTexture->getBuffer()->getRenderTarget();
+    this->dataPtr->cacheRenderTexture->setAutoUpdated(false);
+    this->dataPtr->cacheRenderTexture->setPriority(0);
+    Ogre::Viewport *viewport =
+      this->dataPtr->cacheRenderTexture->addViewport(
+      this->dataPtr->selectionCamera);
+    viewport->setOverlaysEnabled(false);
+    viewport->setShadowsEnabled(false);
+    viewport->setClearEveryFrame(true);
+    viewport->setMaterialScheme("aa");
+    viewport->setVisibilityMask(GZ_VISIBILITY_SELECTABLE);
+    this->dataPtr->cacheRenderTexture->addListener(
+        this->dataPtr->cacheTargetListener.get());
+
+    Ogre::HardwarePixelBufferSharedPtr pixelBuffer =
+      this->dataPtr->cacheTexture->getBuffer();
+    this->dataPtr->cacheBuffer.resize(pixelBuffer->getSizeInBytes() + 4);
+    this->dataPtr->cachePixelBox.reset(new Ogre::PixelBox(
+        pixelBuffer->getWidth(), pixelBuffer->getHeight(),
+        pixelBuffer->getDepth(), pixelBuffer->getFormat(),
+        this->dataPtr->cacheBuffer.data()));
+  }
+
+  // Render the whole view of the camera
+  this->dataPtr->selectionCamera->setCustomProjectionMatrix(true,
+      this->dataPtr->camera->getProjectionMatrix());
+  this->dataPtr->selectionCamera->setPosition(
+      this->dataPtr->camera->getDerivedPosition());
+  this->dataPtr->selectionCamera->setOrientation(
+      this->dataPtr->camera->getDerivedOrientation());
+
+  this->dataPtr->cacheMaterialSwitchListener->Reset();
+
+  // See the FIXME of Update()
+  try
+  {
+    this->dataPtr->cacheRenderTexture->update();
+  }
+  catch(...)
+  {
+    return;
+  }
+
+  this->dataPtr->cacheRenderTexture->copyContentsToMemory(
+      *this->dataPtr->cachePixelBox, Ogre::RenderTarget::FB_FRONT);
+
+  this->dataPtr->cacheTime = common::Time::GetWallTime();
+  this->dataPtr->cacheValid = true;
+}
+
+/////////////////////////////////////////////////
+void SelectionBuffer::DeleteCache()
+{
+  this->dataPtr->cacheValid = false;
+  this->dataPtr->cacheRenderTexture = nullptr;
+  this->dataPtr->cachePixelBox.reset();
+  this->dataPtr->cacheBuffer.clear();
+
+  if (!this->dataPtr->cacheTexture.isNull())
+  {
+    Ogre::TextureManager::getSingleton().remove(
+        this->dataPtr->cacheTexture->getName());
+    this->dataPtr->cacheTexture.setNull();
+  }
+}
+
 /////////////////////////////////////////////////
 void SelectionBuffer::CreateRTTOverlays()
 {
@@ -69,6 +69,23 @@ namespace gazebo
       /// \brief Create the selection buffer offscreen render texture.
       private: void CreateRTTOverlays();
 
+      /// \brief Look up an entity in the low resolution cache of the
+      /// view, which is rendered again when it's older than a fraction of
+      /// a second. The cache isn't used while the camera moves, nor near
+      /// the edges of entities.
+      /// \param[in] _x X coordinate in pixels.
+      /// \param[in] _y Y coordinate in pixels.
+      /// \param[out] _entity The entity at the coordinate, or null.
+      /// \return True if the cache answered the query.
+      private: bool CacheLookup(const int _x, const int _y,
+                               Ogre::Entity *&_entity);
+
+      /// \brief Render the low resolution cache of the view.
+      private: void UpdateCache();
+
+      /// \brief Delete the render texture of the cache.
+      private: void DeleteCache();
+
       /// \internal
       /// \brief Pointer to private data.
       private: std::unique_ptr<SelectionBufferPrivate> dataPtr;
@@ -132,14 +132,23 @@ bool AltimeterSensor::UpdateImpl(const bool /*_force*/)
   // Get latest pose information
   if (this->dataPtr->parentLink)
   {
-    ignition::math::Pose3d parentPose = this->dataPtr->parentLink->WorldPose();
+    // Read the state of the last step, or the link before the first one
+    ignition::math::Pose3d parentPose;
+    ignition::math::Vector3d altVel;
+    ignition::math::Vector3d angularVel;
+    std::shared_ptr<const physics::StepState> state =
+        this->world->StepStates().Latest();
+    if (!state->LinkPose(this->ParentName(), parentPose) ||
+        !state->LinkVelocity(this->ParentName(), this->pose.Pos(), altVel,
+          angularVel))
+    {
+      parentPose = this->dataPtr->parentLink->WorldPose();
+      altVel = this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
+    }
 
     // Get pose in gazebo reference frame
     ignition::math::Pose3d altPose = this->pose + parentPose;
 
-    ignition::math::Vector3d altVel =
-      this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
-
     // Apply noise to the position and velocity
     if (this->noises.find(ALTIMETER_POSITION_NOISE_METERS) !=
         this->noises.end())
@@ -172,8 +181,7 @@ bool AltimeterSensor::UpdateImpl(const bool /*_force*/)
   msgs::Set(this->dataPtr->altMsg.mutable_time(), this->world->SimTime());
 
   // Publish the message if needed
-  if (this->dataPtr->altPub)
-    this->dataPtr->altPub->Publish(this->dataPtr->altMsg);
+  this->Publish(this->dataPtr->altPub, this->dataPtr->altMsg);
   IGN_PROFILE_END();
   return true;
 }
@@ -52,9 +52,11 @@ CameraSensor::CameraSensor()
 : Sensor(sensors::IMAGE),
   dataPtr(new CameraSensorPrivate)
 {
-  this->connections.push_back(
-      event::Events::ConnectRender(
-        std::bind(&CameraSensor::Render, this)));
+  this->SetRenderJob([this]()
+  {
+    this->Render();
+    return this->dataPtr->rendered;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -152,6 +154,7 @@ void CameraSensor::Init()
       return;
     }
     this->camera->SetCaptureData(true);
+    this->camera->SetReadbackLatency(this->dataPtr->readbackLatency);
 
     sdf::ElementPtr cameraSdf = this->sdf->GetElement("camera");
     this->camera->Load(cameraSdf);
@@ -195,6 +198,7 @@ void CameraSensor::Init()
 //////////////////////////////////////////////////
 void CameraSensor::Fini()
 {
+  this->RemoveRenderJob();
   this->imagePub.reset();
 
   if (this->camera)
@@ -337,26 +341,35 @@ bool CameraSensor::UpdateImpl(const bool /*_force*/)
   this->camera->PostRender();
   IGN_PROFILE_END();
 
+  // Nothing to publish while an asynchronous readback is filling up.
+  if (!this->camera->ImageReady())
+  {
+    this->dataPtr->rendered = false;
+    return false;
+  }
+
   IGN_PROFILE_BEGIN("fillarray");
 
   if ((this->imagePub && this->imagePub->HasConnections()) ||
       this->imagePubIgn.HasConnections())
   {
-    auto simTime = this->scene->SimTime();
+    auto simTime = this->camera->ImageSimTime();
     if (this->imagePub && this->imagePub->HasConnections())
     {
-      msgs::ImageStamped msg;
-      msgs::Set(msg.mutable_time(), simTime);
-      msg.mutable_image()->set_width(this->camera->ImageWidth());
-      msg.mutable_image()->set_height(this->camera->ImageHeight());
-      msg.mutable_image()->set_pixel_format(common::Image::ConvertPixelFormat(
-            this->camera->ImageFormat()));
-
-      msg.mutable_image()->set_step(this->camera->ImageWidth() *
+      // Publish a shared message so that the image isn't copied again by
+      // the transport.
+      boost::shared_ptr<msgs::ImageStamped> msg(new msgs::ImageStamped);
+      msgs::Set(msg->mutable_time(), simTime);
+      msg->mutable_image()->set_width(this->camera->ImageWidth());
+      msg->mutable_image()->set_height(this->camera->ImageHeight());
+      msg->mutable_image()->set_pixel_format(
+          common::Image::ConvertPixelFormat(this->camera->ImageFormat()));
+
+      msg->mutable_image()->set_step(this->camera->ImageWidth() *
           this->camera->ImageDepth());
-      msg.mutable_image()->set_data(this->camera->ImageData(),
-          msg.image().width() * this->camera->ImageDepth() *
-          msg.image().height());
+      msg->mutable_image()->set_data(this->camera->ImageData(),
+          msg->image().width() * this->camera->ImageDepth() *
+          msg->image().height());
 
       this->imagePub->Publish(msg);
     }
@@ -441,6 +454,23 @@ bool CameraSensor::SaveFrame(const std::string &_filename)
     return false;
 }
 
+//////////////////////////////////////////////////
+void CameraSensor::SetReadbackLatency(const unsigned int _frames)
+{
+  this->dataPtr->readbackLatency = _frames;
+  if (this->camera)
+  {
+    this->camera->SetReadbackLatency(_frames);
+    this->dataPtr->readbackLatency = this->camera->ReadbackLatency();
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraSensor::ReadbackLatency() const
+{
+  return this->dataPtr->readbackLatency;
+}
+
 //////////////////////////////////////////////////
 bool CameraSensor::IsActive() const
 {
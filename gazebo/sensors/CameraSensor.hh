@@ -109,6 +109,22 @@ namespace gazebo
       /// \return True if successful, false if unsuccessful.
       public: bool SaveFrame(const std::string &_filename);
 
+      /// \brief Trade image latency for rendering throughput. With a
+      /// latency of zero, the default, each image is published in the
+      /// update it was rendered in, and rendering waits for the GPU to
+      /// finish the frame. With a latency of one or two frames, pixels are
+      /// read back asynchronously and each image is published one or two
+      /// updates after it was rendered, stamped with the time it was
+      /// rendered at.
+      /// \param[in] _frames Number of frames of latency, at most 2.
+      /// \sa rendering::Camera::SetReadbackLatency()
+      public: void SetReadbackLatency(const unsigned int _frames);
+
+      /// \brief Get the number of frames by which images lag behind
+      /// rendering.
+      /// \return Number of frames of latency.
+      public: unsigned int ReadbackLatency() const;
+
       // Documentation inherited
       public: virtual bool IsActive() const override;
 
@@ -36,6 +36,9 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Number of frames by which images lag behind rendering.
+      public: unsigned int readbackLatency = 0;
     };
   }
 }
@@ -15,6 +15,7 @@
  *
 */
 #include <boost/algorithm/string.hpp>
+#include <functional>
 #include <sstream>
 
 #include <ignition/common/Profiler.hh>
@@ -116,7 +117,15 @@ void ContactSensor::Load(const std::string &_worldName)
     physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
     std::string topic = mgr->CreateFilter(this->dataPtr->filterName,
         this->dataPtr->collisions);
-    if (!this->dataPtr->contactSub)
+
+    // Take the contacts straight from the contact manager, which avoids
+    // serializing them for a subscriber in the same process.
+    this->dataPtr->directContacts = mgr->SetFilterCallback(
+        this->dataPtr->filterName,
+        std::bind(&ContactSensor::OnDirectContacts, this,
+          std::placeholders::_1));
+
+    if (!this->dataPtr->directContacts && !this->dataPtr->contactSub)
     {
       this->dataPtr->contactSub = this->node->Subscribe(topic,
           &ContactSensor::OnContacts, this);
@@ -138,10 +147,49 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // Don't do anything if there is no new data to process.
-  if (this->dataPtr->incomingContacts.empty())
-    return false;
+  if (this->dataPtr->directContacts)
+  {
+    // Don't do anything if there is no new data to process.
+    if (this->dataPtr->pendingSteps.empty())
+      return false;
+
+    // The contacts were matched by the filter of the contact manager, so
+    // they are moved as they are.
+    this->dataPtr->contactsMsg.mutable_contact()->Swap(
+        this->dataPtr->pendingContacts.mutable_contact());
+    this->dataPtr->pendingContacts.clear_contact();
+    this->dataPtr->pendingSteps.clear();
+  }
+  else
+  {
+    // Don't do anything if there is no new data to process.
+    if (this->dataPtr->incomingContacts.empty())
+      return false;
+
+    this->ProcessIncomingContacts();
+  }
+
+  IGN_PROFILE_END();
+  IGN_PROFILE_BEGIN("Publish");
+
+  this->lastMeasurementTime = this->world->SimTime();
+  msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
+            this->lastMeasurementTime);
+
+  // Generate a outgoing message only if someone is listening.
+  if (this->dataPtr->contactsPub &&
+      (this->dataPtr->contactsPub->HasConnections() || this->Bundled()))
+  {
+    this->Publish(this->dataPtr->contactsPub, this->dataPtr->contactsMsg);
+  }
 
+  IGN_PROFILE_END();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::ProcessIncomingContacts()
+{
   std::vector<std::string>::iterator collIter;
   std::string collision1;
 
@@ -191,25 +239,8 @@ bool ContactSensor::UpdateImpl(const bool /*_force*/)
     }
   }
 
-  IGN_PROFILE_END();
-  IGN_PROFILE_BEGIN("Publish");
-
   // Clear the incoming contact list.
   this->dataPtr->incomingContacts.clear();
-
-  this->lastMeasurementTime = this->world->SimTime();
-  msgs::Set(this->dataPtr->contactsMsg.mutable_time(),
-            this->lastMeasurementTime);
-
-  // Generate a outgoing message only if someone is listening.
-  if (this->dataPtr->contactsPub &&
-      this->dataPtr->contactsPub->HasConnections())
-  {
-    this->dataPtr->contactsPub->Publish(this->dataPtr->contactsMsg);
-  }
-
-  IGN_PROFILE_END();
-  return true;
 }
 
 //////////////////////////////////////////////////
@@ -320,10 +351,33 @@ void ContactSensor::OnContacts(ConstContactsPtr &_msg)
   }
 }
 
+//////////////////////////////////////////////////
+void ContactSensor::OnDirectContacts(
+    const std::vector<const physics::Contact *> &_contacts)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // Only store information if the sensor is active
+  if (!this->IsActive())
+    return;
+
+  for (auto const *contact : _contacts)
+    contact->FillMsg(*this->dataPtr->pendingContacts.add_contact());
+  this->dataPtr->pendingSteps.push_back(static_cast<int>(_contacts.size()));
+
+  // Keep the last 100 steps, like the list of incoming messages.
+  if (this->dataPtr->pendingSteps.size() > 100)
+  {
+    this->dataPtr->pendingContacts.mutable_contact()->DeleteSubrange(
+        0, this->dataPtr->pendingSteps.front());
+    this->dataPtr->pendingSteps.pop_front();
+  }
+}
+
 //////////////////////////////////////////////////
 bool ContactSensor::IsActive() const
 {
-  return this->active ||
+  return Sensor::IsActive() ||
     (this->dataPtr->contactsPub &&
      this->dataPtr->contactsPub->HasConnections());
 }
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 
@@ -94,10 +95,11 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor creates a filter in the ContactManager for the
+      /// <collision> bodies specified by the ContactSensor SDF, which gives
+      /// the sensor the matching contacts of each time step directly, in
+      /// ContactSensor::OnDirectContacts. The filter topic is only used
+      /// by remote subscribers.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -136,6 +138,17 @@ namespace gazebo
       /// \brief Callback for contact messages from the physics engine.
       private: void OnContacts(ConstContactsPtr &_msg);
 
+      /// \brief Copy the contacts of the received messages that involve
+      /// the monitored collisions into the contacts message. The mutex
+      /// must be locked.
+      private: void ProcessIncomingContacts();
+
+      /// \brief Callback for the contacts of a step, given by the contact
+      /// manager in the physics thread.
+      /// \param[in] _contacts Contacts of the filter of this sensor.
+      private: void OnDirectContacts(
+                   const std::vector<const physics::Contact *> &_contacts);
+
       /// \internal
       /// \brief Private data pointer
       private: std::unique_ptr<ContactSensorPrivate> dataPtr;
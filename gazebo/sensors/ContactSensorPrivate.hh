@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_CONTACTSENSOR_PRIVATE_HH_
 
+#include <deque>
 #include <vector>
 #include <list>
 #include <string>
@@ -57,6 +58,17 @@ namespace gazebo
 
       /// \brief Name of filter used to filter contact messages.
       public: std::string filterName;
+
+      /// \brief True if the contact manager gives the contacts to the
+      /// sensor directly, instead of through the filter topic.
+      public: bool directContacts = false;
+
+      /// \brief Contacts given directly since the last update.
+      public: msgs::Contacts pendingContacts;
+
+      /// \brief Number of contacts of each step in pendingContacts, oldest
+      /// first.
+      public: std::deque<int> pendingSteps;
     };
   }
 }
@@ -18,6 +18,8 @@
 
 #include "ignition/common/Profiler.hh"
 
+#include "gazebo/common/PixelConvert.hh"
+
 #include "gazebo/physics/World.hh"
 
 #include "gazebo/rendering/DepthCamera.hh"
@@ -49,6 +51,9 @@ DepthCameraSensor::~DepthCameraSensor()
 {
   if (this->dataPtr->depthBuffer)
     delete [] this->dataPtr->depthBuffer;
+
+  if (this->dataPtr->compactDepthBuffer)
+    delete [] this->dataPtr->compactDepthBuffer;
 }
 
 //////////////////////////////////////////////////
@@ -146,7 +151,47 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("fillarray");
 
+  const std::string depthFormat = this->dataPtr->depthCamera->DepthFormat();
+  const uint16_t *compactDepthData =
+      this->dataPtr->depthCamera->CompactDepthData();
+
   if (this->imagePub && this->imagePub->HasConnections() &&
+      depthFormat != "FLOAT32" && compactDepthData)
+  {
+    msgs::ImageStamped msg;
+    msgs::Set(msg.mutable_time(), this->scene->SimTime());
+    msg.mutable_image()->set_width(this->camera->ImageWidth());
+    msg.mutable_image()->set_height(this->camera->ImageHeight());
+    msg.mutable_image()->set_pixel_format(depthFormat == "FLOAT16" ?
+        common::Image::R_FLOAT16 : common::Image::L_INT16);
+
+    uint16_t u;
+    // cppchecker recommends using sizeof(varname)
+    msg.mutable_image()->set_step(this->camera->ImageWidth() * sizeof(u));
+
+    unsigned int depthSamples = msg.image().width() * msg.image().height();
+    unsigned int depthBufferSize = depthSamples * sizeof(u);
+
+    if (!this->dataPtr->compactDepthBuffer)
+      this->dataPtr->compactDepthBuffer = new uint16_t[depthSamples];
+
+    memcpy(this->dataPtr->compactDepthBuffer, compactDepthData,
+        depthBufferSize);
+
+    // Millimeter depths are 0 where nothing was hit. Half floats are
+    // masked as the float depths are.
+    if (depthFormat == "FLOAT16")
+    {
+      common::ClampDepthHalf(this->dataPtr->compactDepthBuffer, depthSamples,
+          static_cast<float>(this->camera->NearClip()),
+          static_cast<float>(this->camera->FarClip()));
+    }
+    msg.mutable_image()->set_data(this->dataPtr->compactDepthBuffer,
+        depthBufferSize);
+    this->imagePub->Publish(msg);
+  }
+  else if (this->imagePub && this->imagePub->HasConnections() &&
+      depthFormat == "FLOAT32" &&
       // check if depth data is available. If not, the depth camera could be
       // generating point clouds instead
       this->dataPtr->depthCamera->DepthData())
@@ -172,18 +217,10 @@ bool DepthCameraSensor::UpdateImpl(const bool /*_force*/)
     memcpy(this->dataPtr->depthBuffer, this->dataPtr->depthCamera->DepthData(),
         depthBufferSize);
 
-    for (unsigned int i = 0; i < depthSamples; ++i)
-    {
-      // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (this->dataPtr->depthBuffer[i] >= this->camera->FarClip())
-      {
-        this->dataPtr->depthBuffer[i] = ignition::math::INF_D;
-      }
-      else if (this->dataPtr->depthBuffer[i] <= this->camera->NearClip())
-      {
-        this->dataPtr->depthBuffer[i] = -ignition::math::INF_D;
-      }
-    }
+    // Mask ranges outside of min/max to +/- inf, as per REP 117
+    common::ClampDepth(this->dataPtr->depthBuffer, depthSamples,
+        static_cast<float>(this->camera->NearClip()),
+        static_cast<float>(this->camera->FarClip()));
     msg.mutable_image()->set_data(this->dataPtr->depthBuffer, depthBufferSize);
     this->imagePub->Publish(msg);
   }
@@ -199,6 +236,12 @@ const float *DepthCameraSensor::DepthData() const
   return this->dataPtr->depthBuffer;
 }
 
+//////////////////////////////////////////////////
+const uint16_t *DepthCameraSensor::CompactDepthData() const
+{
+  return this->dataPtr->compactDepthBuffer;
+}
+
 //////////////////////////////////////////////////
 rendering::DepthCameraPtr DepthCameraSensor::DepthCamera() const
 {
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_HH_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -55,6 +56,14 @@ namespace gazebo
       /// \return The pointer to the depth data array.
       public: virtual const float *DepthData() const;
 
+      /// \brief Gets the depth data of the compact depth formats, set with
+      /// the gz:depth_format element of the camera, see
+      /// rendering::DepthCamera::SetDepthFormat. Half float depths beyond
+      /// the clip distances are masked as in DepthData.
+      /// \return The pointer to the depth data array, or nullptr if the
+      /// depth format is FLOAT32.
+      public: const uint16_t *CompactDepthData() const;
+
       /// \brief Returns a pointer to the rendering::DepthCamera
       /// \return Depth Camera pointer
       public: virtual rendering::DepthCameraPtr DepthCamera() const;
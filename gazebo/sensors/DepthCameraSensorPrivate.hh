@@ -17,6 +17,8 @@
 #ifndef _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_DEPTHCAMERASENSOR_PRIVATE_HH_
 
+#include <cstdint>
+
 #include "gazebo/rendering/RenderTypes.hh"
 
 namespace gazebo
@@ -30,6 +32,9 @@ namespace gazebo
       /// \brief Depth data buffer.
       public: float *depthBuffer = nullptr;
 
+      /// \brief Depth data buffer of the compact depth formats.
+      public: uint16_t *compactDepthBuffer = nullptr;
+
       /// \brief Local pointer to the depthCamera.
       public: rendering::DepthCameraPtr depthCamera;
     };
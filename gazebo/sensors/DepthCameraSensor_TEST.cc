@@ -17,6 +17,8 @@
 
 #include <functional>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -273,6 +275,83 @@ TEST_F(DepthCameraSensor_normals_TEST, CreateDepthCamera)
   depthCamera.reset();
 }
 
+class DepthCameraSensor_points_TEST : public ServerFixture
+{
+};
+
+std::mutex g_pointsMutex;
+unsigned int g_pointsCounter = 0;
+std::vector<float> g_points;
+
+/////////////////////////////////////////////////
+void OnNewRGBPointCloud(const float * _pcd,
+    unsigned int _width, unsigned int _height,
+    unsigned int /*_depth*/, const std::string &/*_format*/)
+{
+  ASSERT_NE(nullptr, _pcd);
+  std::lock_guard<std::mutex> lock(g_pointsMutex);
+  g_points.assign(_pcd, _pcd + _width * _height * 4);
+  g_pointsCounter++;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the colored point cloud of a Depth Camera sensor
+TEST_F(DepthCameraSensor_points_TEST, RGBPointCloud)
+{
+  Load("worlds/depth_camera2.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  std::string sensorName = "default::camera_model::my_link::camera";
+  sensors::DepthCameraSensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::DepthCameraSensor>
+     (mgr->GetSensor(sensorName));
+  ASSERT_NE(nullptr, sensor);
+
+  rendering::DepthCameraPtr depthCamera = sensor->DepthCamera();
+  ASSERT_NE(nullptr, depthCamera);
+
+  event::ConnectionPtr c = depthCamera->ConnectNewRGBPointCloud(
+      std::bind(&::OnNewRGBPointCloud, std::placeholders::_1,
+      std::placeholders::_2, std::placeholders::_3, std::placeholders::_4,
+      std::placeholders::_5));
+
+  unsigned int framesToWait = 10;
+  int i = 0;
+  while (i < 300 && g_pointsCounter < framesToWait)
+  {
+    common::Time::MSleep(20);
+    i++;
+  }
+  EXPECT_GE(g_pointsCounter, framesToWait);
+  c.reset();
+  EXPECT_NE(nullptr, depthCamera->PointCloudData());
+
+  std::lock_guard<std::mutex> lock(g_pointsMutex);
+  ASSERT_EQ(sensor->ImageWidth() * sensor->ImageHeight() * 4,
+      g_points.size());
+
+  // The green box is 2.5 m in front of the camera, which uses the optical
+  // frame convention: x right, y down, z forward
+  unsigned int center = ((sensor->ImageHeight() / 2) * sensor->ImageWidth() +
+      sensor->ImageWidth() / 2) * 4;
+  EXPECT_NEAR(0.0, g_points[center], 0.05);
+  EXPECT_NEAR(0.0, g_points[center + 1], 0.05);
+  EXPECT_NEAR(2.5, g_points[center + 2], 0.05);
+
+  // The color of the pixel is packed as r * 65536 + g * 256 + b
+  const float packed = g_points[center + 3];
+  const unsigned int rgb = static_cast<unsigned int>(packed);
+  EXPECT_FLOAT_EQ(packed, static_cast<float>(rgb));
+  EXPECT_LT(rgb, 1u << 24);
+  const unsigned int r = (rgb >> 16) & 0xFF;
+  const unsigned int g = (rgb >> 8) & 0xFF;
+  const unsigned int b = rgb & 0xFF;
+  EXPECT_GT(g, r);
+  EXPECT_GT(g, b);
+
+  depthCamera.reset();
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
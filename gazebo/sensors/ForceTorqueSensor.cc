@@ -274,8 +274,7 @@ bool ForceTorqueSensor::UpdateImpl(const bool /*_force*/)
 
   this->dataPtr->update(this->dataPtr->wrenchMsg);
 
-  if (this->dataPtr->wrenchPub)
-    this->dataPtr->wrenchPub->Publish(this->dataPtr->wrenchMsg);
+  this->Publish(this->dataPtr->wrenchPub, this->dataPtr->wrenchMsg);
   IGN_PROFILE_END();
 
   return true;
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
@@ -21,6 +25,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
 #include "gazebo/rendering/Camera.hh"
+#include "gazebo/rendering/Distortion.hh"
 #include "gazebo/sensors/GaussianNoiseModel.hh"
 
 namespace gazebo
@@ -79,6 +84,23 @@ namespace gazebo
 using namespace gazebo;
 using namespace sensors;
 
+/////////////////////////////////////////////////
+/// \brief Counter based random number generator (SplitMix64). Each output
+/// only depends on the key and the counter, so a whole array of values can
+/// be generated without a sequential state.
+/// \param[in] _key Key of the stream.
+/// \param[in] _counter Position in the stream.
+/// \return Uniform value in (0, 1].
+static inline double counterUniform(const uint64_t _key,
+    const uint64_t _counter)
+{
+  uint64_t z = _key + (_counter + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z = z ^ (z >> 31);
+  return static_cast<double>((z >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
 //////////////////////////////////////////////////
 GaussianNoiseModel::GaussianNoiseModel()
   : Noise(Noise::GAUSSIAN),
@@ -184,6 +206,55 @@ double GaussianNoiseModel::ApplyImpl(double _in, double _dt)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBulkImpl(double *_data, const size_t _count,
+    const double _dt)
+{
+  // The correlated bias changes after each value.
+  if (this->dynamicBiasStdDev > 0 && this->dynamicBiasCorrTime > 0)
+  {
+    Noise::ApplyBulkImpl(_data, _count, _dt);
+    return;
+  }
+
+  // The key of the batch is drawn from the global generator, so that the
+  // noise is reproducible when ignition::math::Rand is seeded.
+  const int maxInt = std::numeric_limits<int>::max();
+  const uint64_t key =
+      (static_cast<uint64_t>(ignition::math::Rand::IntUniform(0, maxInt))
+       << 32) ^
+      static_cast<uint64_t>(ignition::math::Rand::IntUniform(0, maxInt));
+
+  // Box-Muller transform, which gives two values per pair of uniform
+  // values. There are no dependencies between iterations, so the compiler
+  // is free to vectorize the loop.
+  const double offset = this->mean + this->bias;
+  const double stdDev = this->stdDev;
+  const size_t pairs = _count / 2;
+  for (size_t i = 0; i < pairs; ++i)
+  {
+    const double u1 = counterUniform(key, 2 * i);
+    const double u2 = counterUniform(key, 2 * i + 1);
+    const double r = stdDev * std::sqrt(-2.0 * std::log(u1));
+    const double theta = 2.0 * M_PI * u2;
+    _data[2 * i] += offset + r * std::cos(theta);
+    _data[2 * i + 1] += offset + r * std::sin(theta);
+  }
+  if (_count % 2 != 0)
+  {
+    const double u1 = counterUniform(key, 2 * pairs);
+    const double u2 = counterUniform(key, 2 * pairs + 1);
+    _data[_count - 1] += offset +
+        stdDev * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+  }
+
+  if (this->quantized && !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    for (size_t i = 0; i < _count; ++i)
+      _data[i] = std::round(_data[i] / this->precision) * this->precision;
+  }
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -262,6 +333,14 @@ void ImageGaussianNoiseModel::SetCamera(rendering::CameraPtr _camera)
 {
   GZ_ASSERT(_camera, "Unable to apply gaussian noise, camera is null");
 
+  // The distortion pass adds the noise, saving a full-screen pass
+  rendering::DistortionPtr distortion = _camera->LensDistortion();
+  if (_camera->PostEffectFusion() && distortion &&
+      distortion->SetNoise(this->mean, this->stdDev))
+  {
+    return;
+  }
+
   this->gaussianNoiseCompositorListener.reset(new
         GaussianNoiseCompositorListener(this->mean, this->stdDev));
 
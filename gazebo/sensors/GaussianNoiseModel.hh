@@ -57,6 +57,10 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in, double _dt);
 
+        // Documentation inherited.
+        public: virtual void ApplyBulkImpl(double *_data,
+                    const size_t _count, const double _dt);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -131,11 +131,24 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
   // Get latest pose information
   if (this->dataPtr->parentLink)
   {
+    // Read the state of the last step, or the link before the first one
+    ignition::math::Pose3d parentPose;
+    ignition::math::Vector3d parentVel;
+    ignition::math::Vector3d angularVel;
+    std::shared_ptr<const physics::StepState> state =
+        this->world->StepStates().Latest();
+    if (!state->LinkPose(this->ParentName(), parentPose) ||
+        !state->LinkVelocity(this->ParentName(), this->pose.Pos(),
+          parentVel, angularVel))
+    {
+      parentPose = this->dataPtr->parentLink->WorldPose();
+      parentVel = this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
+    }
+
     // Measure position and apply noise
     {
       // Get postion in Cartesian gazebo frame
-      ignition::math::Pose3d gpsPose = this->pose +
-        this->dataPtr->parentLink->WorldPose();
+      ignition::math::Pose3d gpsPose = this->pose + parentPose;
 
       // Apply position noise before converting to global frame
       gpsPose.Pos().X(
@@ -158,8 +171,7 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
 
     // Measure velocity and apply noise
     {
-      ignition::math::Vector3d gpsVelocity =
-        this->dataPtr->parentLink->WorldLinearVel(this->pose.Pos());
+      ignition::math::Vector3d gpsVelocity = parentVel;
 
       // Convert to global frame
       gpsVelocity =
@@ -187,8 +199,7 @@ bool GpsSensor::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
-  if (this->dataPtr->gpsPub)
-    this->dataPtr->gpsPub->Publish(this->dataPtr->lastGpsMsg);
+  this->Publish(this->dataPtr->gpsPub, this->dataPtr->lastGpsMsg);
   IGN_PROFILE_END();
   return true;
 }
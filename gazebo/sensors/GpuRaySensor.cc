@@ -56,9 +56,13 @@ GpuRaySensor::GpuRaySensor()
 {
   this->dataPtr->rendered = false;
   this->active = false;
-  this->connections.push_back(
-      event::Events::ConnectRender(
-        std::bind(&GpuRaySensor::Render, this)));
+
+  // Lidars are timing critical, render them before the cameras.
+  this->SetRenderJob([this]()
+  {
+    this->Render();
+    return this->dataPtr->rendered;
+  }, RenderJobQueue::HIGH_PRIORITY);
 }
 
 //////////////////////////////////////////////////
@@ -330,6 +334,13 @@ void GpuRaySensor::Init()
     this->dataPtr->laserCam->SetWorldPose(this->pose);
     this->dataPtr->laserCam->AttachToVisual(this->ParentId(), true, 0, 0);
 
+    // Spinning lidars render the sectors swept since the last update
+    if (this->sdf->HasElement("gz:scan_rate"))
+    {
+      this->dataPtr->laserCam->SetScanRate(
+          this->sdf->Get<double>("gz:scan_rate"));
+    }
+
     this->dataPtr->laserMsg.mutable_scan()->set_frame(this->ParentName());
   }
   else
@@ -347,6 +358,7 @@ void GpuRaySensor::Init()
 //////////////////////////////////////////////////
 void GpuRaySensor::Fini()
 {
+  this->RemoveRenderJob();
   this->dataPtr->scanPub.reset();
 
   if (this->dataPtr->laserCam)
@@ -745,37 +757,63 @@ bool GpuRaySensor::UpdateImpl(const bool /*_force*/)
     }
   }
 
+  const double rangeMin = this->dataPtr->rangeMin;
+  const double rangeMax = this->dataPtr->rangeMax;
+  auto noiseIter = this->noises.find(GPU_RAY_NOISE);
+  NoisePtr noise = noiseIter != this->noises.end() ?
+      noiseIter->second : NoisePtr();
+
+  // Write straight into the repeated fields, which were sized above.
+  double *ranges = scan->mutable_ranges()->mutable_data();
+  double *intensities = scan->mutable_intensities()->mutable_data();
+
   auto dataIter = this->dataPtr->laserCam->LaserDataBegin();
   auto dataEnd = this->dataPtr->laserCam->LaserDataEnd();
   for (int i = 0; dataIter != dataEnd; ++dataIter, ++i)
   {
     const rendering::GpuLaserData data = *dataIter;
     double range = data.range;
-    double intensity = data.intensity;
 
     // Mask ranges outside of min/max to +/- inf, as per REP 117
-    if (range >= this->dataPtr->rangeMax)
+    if (range >= rangeMax)
     {
       range = ignition::math::INF_D;
     }
-    else if (range <= this->dataPtr->rangeMin)
+    else if (range <= rangeMin)
     {
       range = -ignition::math::INF_D;
     }
-    else if (this->noises.find(GPU_RAY_NOISE) != this->noises.end())
+    else if (noise)
     {
-      range = this->noises[GPU_RAY_NOISE]->Apply(range);
-      range = ignition::math::clamp(range,
-          this->dataPtr->rangeMin, this->dataPtr->rangeMax);
+      // Noise is applied to all the ranges at once below
+      this->dataPtr->noisyIndices.push_back(i);
+      this->dataPtr->noisyRanges.push_back(range);
     }
 
-    range = ignition::math::isnan(range) ? this->dataPtr->rangeMax : range;
-    scan->set_ranges(i, range);
-    scan->set_intensities(i, intensity);
+    ranges[i] = ignition::math::isnan(range) ? rangeMax : range;
+    intensities[i] = data.intensity;
   }
 
-  if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
-    this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+  if (!this->dataPtr->noisyRanges.empty())
+  {
+    std::vector<double> &noisyRanges = this->dataPtr->noisyRanges;
+    noise->Apply(noisyRanges.data(), noisyRanges.size());
+    for (size_t i = 0; i < noisyRanges.size(); ++i)
+    {
+      const double range =
+          ignition::math::clamp(noisyRanges[i], rangeMin, rangeMax);
+      ranges[this->dataPtr->noisyIndices[i]] =
+          ignition::math::isnan(range) ? rangeMax : range;
+    }
+    noisyRanges.clear();
+    this->dataPtr->noisyIndices.clear();
+  }
+
+  if (this->dataPtr->scanPub &&
+      (this->dataPtr->scanPub->HasConnections() || this->Bundled()))
+  {
+    this->Publish(this->dataPtr->scanPub, this->dataPtr->laserMsg);
+  }
 
   this->dataPtr->rendered = false;
   IGN_PROFILE_END();
@@ -19,6 +19,7 @@
 
 #include <limits>
 #include <mutex>
+#include <vector>
 #include <sdf/sdf.hh>
 
 #include "gazebo/rendering/RenderTypes.hh"
@@ -94,6 +95,13 @@ namespace gazebo
       /// \brief Timestamp of the forthcoming rendering
       public: double nextRenderingTime
                            = std::numeric_limits<double>::quiet_NaN();
+
+      /// \brief Ranges that get noise applied, gathered so that the noise
+      /// model gets them all at once.
+      public: std::vector<double> noisyRanges;
+
+      /// \brief Index in the scan of each of noisyRanges.
+      public: std::vector<int> noisyIndices;
     };
   }
 }
@@ -15,6 +15,8 @@
  *
 */
 #include <functional>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
@@ -109,6 +111,74 @@ TEST_F(GPURaySensor_TEST, CreateLaser)
   delete [] scan;
 }
 
+/////////////////////////////////////////////////
+/// \brief Copy the whole laser frame, range and intensity of each ray.
+void OnNewLaserFrameCopy(int *_scanCounter, std::vector<float> *_scanDest,
+                  const float *_scan,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _depth,
+                  const std::string &/*_format*/)
+{
+  _scanDest->assign(_scan, _scan + _width * _height * _depth);
+  *_scanCounter += 1;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that the scan is filled without laser frame listeners, and
+/// matches the laser frames once there is one
+TEST_F(GPURaySensor_TEST, ScanWithoutListeners)
+{
+  Load("worlds/gpu_laser2.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  std::string sensorName = "default::model_1::link_1::laser_sensor";
+  sensors::GpuRaySensorPtr sensor =
+     std::dynamic_pointer_cast<sensors::GpuRaySensor>
+     (mgr->GetSensor(sensorName));
+  ASSERT_TRUE(sensor != nullptr);
+
+  // A box 1.4 m in front of the sensor
+  SpawnBox("box", ignition::math::Vector3d(1, 1, 1),
+      ignition::math::Vector3d(2, 0, 0.5), ignition::math::Vector3d::Zero,
+      true);
+
+  const int mid = sensor->RayCount() / 2;
+  int i = 0;
+  while (sensor->Range(mid) > sensor->RangeMax() && i < 300)
+  {
+    common::Time::MSleep(10);
+    i++;
+  }
+  EXPECT_LT(i, 300);
+  EXPECT_NEAR(sensor->Range(mid), 1.4, 0.05);
+  EXPECT_DOUBLE_EQ(sensor->Range(0), ignition::math::INF_D);
+  EXPECT_DOUBLE_EQ(sensor->Range(sensor->RayCount() - 1),
+      ignition::math::INF_D);
+
+  // The laser frames carry the same ranges as the scan
+  std::vector<float> scan;
+  int scanCount = 0;
+  event::ConnectionPtr c =
+    sensor->ConnectNewLaserFrame(
+        std::bind(&::OnNewLaserFrameCopy, &scanCount, &scan,
+          std::placeholders::_1, std::placeholders::_2,
+          std::placeholders::_3, std::placeholders::_4,
+          std::placeholders::_5));
+
+  i = 0;
+  while (scanCount < 2 && i < 300)
+  {
+    common::Time::MSleep(10);
+    i++;
+  }
+  EXPECT_LT(i, 300);
+  c.reset();
+
+  ASSERT_EQ(static_cast<size_t>(sensor->RayCount() * 3), scan.size());
+  EXPECT_NEAR(scan[mid * 3], 1.4, 0.05);
+  EXPECT_NEAR(scan[mid * 3], sensor->Range(mid), 0.05);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
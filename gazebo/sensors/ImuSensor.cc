@@ -14,10 +14,15 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <functional>
+
 #include <boost/algorithm/string.hpp>
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/common/Events.hh"
+
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
@@ -225,9 +230,13 @@ void ImuSensor::Init()
 //////////////////////////////////////////////////
 void ImuSensor::Fini()
 {
+  this->dataPtr->synchronous = false;
+  this->dataPtr->worldUpdateConnection.reset();
+
   // Clean transport
   {
     this->dataPtr->pub.reset();
+    this->dataPtr->batchPub.reset();
     this->dataPtr->linkDataSub.reset();
   }
 
@@ -298,9 +307,209 @@ void ImuSensor::SetWorldToReferenceOrientation(
   this->dataPtr->worldToReference = _orientation;
 }
 
+//////////////////////////////////////////////////
+void ImuSensor::SetSynchronous(const bool _synchronous,
+    const unsigned int _capacity)
+{
+  if (_synchronous == this->dataPtr->synchronous)
+    return;
+
+  if (_synchronous)
+  {
+    // The ring outlives the connection, so that a late callback from the
+    // physics thread never writes to a freed ring.
+    if (!this->dataPtr->ring)
+    {
+      this->dataPtr->ring.reset(
+          new ImuSampleRing(std::max(_capacity, 1u)));
+    }
+
+    if (!this->dataPtr->batchPub && this->dataPtr->pub)
+    {
+      this->dataPtr->batchPub = this->node->Advertise<msgs::IMU_V>(
+          this->dataPtr->pub->GetTopic() + "/batch", 50);
+    }
+
+    this->dataPtr->synchronous = true;
+    this->dataPtr->worldUpdateConnection =
+      event::Events::ConnectWorldUpdateEnd(
+          std::bind(&ImuSensor::OnWorldUpdateEnd, this));
+  }
+  else
+  {
+    this->dataPtr->worldUpdateConnection.reset();
+    this->dataPtr->synchronous = false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool ImuSensor::Synchronous() const
+{
+  return this->dataPtr->synchronous;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImuSensor::DroppedSampleCount() const
+{
+  return this->dataPtr->droppedSamples;
+}
+
+//////////////////////////////////////////////////
+void ImuSensor::OnWorldUpdateEnd()
+{
+  physics::LinkPtr link = this->dataPtr->parentEntity;
+  if (!this->dataPtr->synchronous || !link || !this->world)
+    return;
+
+  ImuSample sample;
+  sample.time = this->world->SimTime();
+  sample.linkPose = link->WorldPose();
+  sample.linearVel = link->WorldLinearVel();
+  sample.angularVel = link->WorldAngularVel();
+
+  if (!this->dataPtr->ring->Push(sample))
+    ++this->dataPtr->droppedSamples;
+}
+
+//////////////////////////////////////////////////
+bool ImuSensor::UpdateSynchronous()
+{
+  IGN_PROFILE("ImuSensor::UpdateSynchronous");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  this->dataPtr->batchMsg.clear_imu();
+
+  ImuSample sample;
+  while (this->dataPtr->ring->Pop(sample))
+  {
+    const double dt = (sample.time - this->lastMeasurementTime).Double();
+    if (dt <= 0.0)
+      continue;
+
+    this->lastMeasurementTime = sample.time;
+    this->Measure(sample.time, sample.linkPose, sample.linearVel,
+        sample.angularVel, dt);
+    this->dataPtr->batchMsg.add_imu()->CopyFrom(this->dataPtr->imuMsg);
+  }
+
+  if (this->dataPtr->batchMsg.imu_size() == 0)
+    return false;
+
+  this->Publish(this->dataPtr->pub, this->dataPtr->imuMsg);
+  if (this->dataPtr->batchPub)
+    this->dataPtr->batchPub->Publish(this->dataPtr->batchMsg);
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ImuSensor::Measure(const common::Time &_time,
+    const ignition::math::Pose3d &_linkPose,
+    const ignition::math::Vector3d &_linkLinearVel,
+    const ignition::math::Vector3d &_linkAngularVel,
+    const double _dt)
+{
+  this->dataPtr->imuMsg.set_entity_name(this->ParentName());
+
+  this->dataPtr->gravity = this->world->Gravity();
+
+  msgs::Set(this->dataPtr->imuMsg.mutable_stamp(), _time);
+
+  ignition::math::Pose3d imuWorldPose = this->pose + _linkPose;
+
+  /////////////////////////////////////////////////////////////////////
+  // Set the IMU angular velocity (defined in imu's local frame)
+  /////////////////////////////////////////////////////////////////////
+  this->dataPtr->angularVel = imuWorldPose.Rot().Inverse().RotateVector(
+      _linkAngularVel);
+  msgs::Set(this->dataPtr->imuMsg.mutable_angular_velocity(),
+      this->dataPtr->angularVel);
+
+  /////////////////////////////////////////////////////////////////////
+  // Compute and set the IMU linear acceleration in the imu local frame
+  /////////////////////////////////////////////////////////////////////
+  // account for vel in world frame of the imu
+  // given the imu frame is offset from link frame, and link is rotating
+  // compute the velocity of the imu axis origin in world frame
+  ignition::math::Vector3d imuWorldLinearVel = _linkLinearVel +
+      _linkAngularVel.Cross(imuWorldPose.Pos() - _linkPose.Pos());
+  // compute acceleration by differentiating velocity in world frame,
+  // and rotate into imu local frame
+  this->dataPtr->linearAcc = imuWorldPose.Rot().Inverse().RotateVector(
+    (imuWorldLinearVel - this->dataPtr->lastImuWorldLinearVel) / _dt);
+
+  // Add contribution from gravity
+  // Do we want to skip if link does not have gravity enabled?
+  //   e.g. if (this->dataPtr->parentEntity->GetGravityMode())
+  this->dataPtr->linearAcc -= imuWorldPose.Rot().Inverse().RotateVector(
+      this->dataPtr->gravity);
+
+  // publish linear acceleration
+  msgs::Set(this->dataPtr->imuMsg.mutable_linear_acceleration(),
+      this->dataPtr->linearAcc);
+
+  // Set the IMU orientation
+  // imu orientation with respect to reference frame
+  ignition::math::Quaterniond imuReferenceOrientation =
+    (this->dataPtr->worldToReference.Inverse() * imuWorldPose.Rot());
+  msgs::Set(this->dataPtr->imuMsg.mutable_orientation(),
+    imuReferenceOrientation);
+
+  this->dataPtr->lastImuWorldLinearVel = imuWorldLinearVel;
+
+  // Apply noise models
+  for (auto const &keyNoise : this->noises)
+  {
+    switch (keyNoise.first)
+    {
+      case IMU_ANGVEL_X_NOISE_RADIANS_PER_S:
+        this->dataPtr->imuMsg.mutable_angular_velocity()->set_x(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.angular_velocity().x(), _dt));
+        break;
+      case IMU_ANGVEL_Y_NOISE_RADIANS_PER_S:
+        this->dataPtr->imuMsg.mutable_angular_velocity()->set_y(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.angular_velocity().y(), _dt));
+        break;
+      case IMU_ANGVEL_Z_NOISE_RADIANS_PER_S:
+        this->dataPtr->imuMsg.mutable_angular_velocity()->set_z(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.angular_velocity().z(), _dt));
+        break;
+      case IMU_LINACC_X_NOISE_METERS_PER_S_SQR:
+        this->dataPtr->imuMsg.mutable_linear_acceleration()->set_x(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.linear_acceleration().x(), _dt));
+        break;
+      case IMU_LINACC_Y_NOISE_METERS_PER_S_SQR:
+        this->dataPtr->imuMsg.mutable_linear_acceleration()->set_y(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.linear_acceleration().y(), _dt));
+        break;
+      case IMU_LINACC_Z_NOISE_METERS_PER_S_SQR:
+        this->dataPtr->imuMsg.mutable_linear_acceleration()->set_z(
+          keyNoise.second->Apply(
+            this->dataPtr->imuMsg.linear_acceleration().z(), _dt));
+        break;
+      default:
+        std::ostringstream out;
+        out << "Removing unrecognized noise model: ";
+        keyNoise.second->Print(out);
+        out << std::endl;
+        gzwarn << out.str() << std::endl;
+        this->noises.erase(keyNoise.first);
+        break;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 bool ImuSensor::UpdateImpl(const bool /*_force*/)
 {
+  if (this->dataPtr->synchronous)
+    return this->UpdateSynchronous();
+
   IGN_PROFILE("ImuSensor::UpdateImpl");
   IGN_PROFILE_BEGIN("Update");
   msgs::LinkData msg;
@@ -331,114 +540,14 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-    this->dataPtr->imuMsg.set_entity_name(this->ParentName());
-
-    this->dataPtr->gravity = this->world->Gravity();
-
-    msgs::Set(this->dataPtr->imuMsg.mutable_stamp(), timestamp);
-
-    ignition::math::Pose3d parentEntityPose =
-      this->dataPtr->parentEntity->WorldPose();
-    ignition::math::Pose3d imuWorldPose = this->pose + parentEntityPose;
-
-    // Get the angular velocity
-    ignition::math::Vector3d linkWorldAngularVel = msgs::ConvertIgn(
-        msg.angular_velocity());
-
-    /////////////////////////////////////////////////////////////////////
-    // Set the IMU angular velocity (defined in imu's local frame)
-    /////////////////////////////////////////////////////////////////////
-    this->dataPtr->angularVel = imuWorldPose.Rot().Inverse().RotateVector(
-        linkWorldAngularVel);
-    msgs::Set(this->dataPtr->imuMsg.mutable_angular_velocity(),
-        this->dataPtr->angularVel);
-
-    /////////////////////////////////////////////////////////////////////
-    // Compute and set the IMU linear acceleration in the imu local frame
-    /////////////////////////////////////////////////////////////////////
-    // first get imu link's linear velocity in world frame
-    ignition::math::Vector3d linkWorldLinearVel
-        = msgs::ConvertIgn(msg.linear_velocity());
-    // next, account for vel in world frame of the imu
-    // given the imu frame is offset from link frame, and link is rotating
-    // compute the velocity of the imu axis origin in world frame
-    ignition::math::Vector3d imuWorldLinearVel = linkWorldLinearVel +
-        linkWorldAngularVel.Cross(imuWorldPose.Pos() - parentEntityPose.Pos());
-    // compute acceleration by differentiating velocity in world frame,
-    // and rotate into imu local frame
-    this->dataPtr->linearAcc = imuWorldPose.Rot().Inverse().RotateVector(
-      (imuWorldLinearVel - this->dataPtr->lastImuWorldLinearVel) / dt);
-
-    // Add contribution from gravity
-    // Do we want to skip if link does not have gravity enabled?
-    //   e.g. if (this->dataPtr->parentEntity->GetGravityMode())
-    this->dataPtr->linearAcc -= imuWorldPose.Rot().Inverse().RotateVector(
-        this->dataPtr->gravity);
-
-    // publish linear acceleration
-    msgs::Set(this->dataPtr->imuMsg.mutable_linear_acceleration(),
-        this->dataPtr->linearAcc);
-
-    // Set the IMU orientation
-    // imu orientation with respect to reference frame
-    ignition::math::Quaterniond imuReferenceOrientation =
-      (this->dataPtr->worldToReference.Inverse() * imuWorldPose.Rot());
-    msgs::Set(this->dataPtr->imuMsg.mutable_orientation(),
-      imuReferenceOrientation);
-
-    this->dataPtr->lastImuWorldLinearVel = imuWorldLinearVel;
-
-    // Apply noise models
-    for (auto const &keyNoise : this->noises)
-    {
-      switch (keyNoise.first)
-      {
-        case IMU_ANGVEL_X_NOISE_RADIANS_PER_S:
-          this->dataPtr->imuMsg.mutable_angular_velocity()->set_x(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().x(), dt));
-          break;
-        case IMU_ANGVEL_Y_NOISE_RADIANS_PER_S:
-          this->dataPtr->imuMsg.mutable_angular_velocity()->set_y(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().y(), dt));
-          break;
-        case IMU_ANGVEL_Z_NOISE_RADIANS_PER_S:
-          this->dataPtr->imuMsg.mutable_angular_velocity()->set_z(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.angular_velocity().z(), dt));
-          break;
-        case IMU_LINACC_X_NOISE_METERS_PER_S_SQR:
-          this->dataPtr->imuMsg.mutable_linear_acceleration()->set_x(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().x(), dt));
-          break;
-        case IMU_LINACC_Y_NOISE_METERS_PER_S_SQR:
-          this->dataPtr->imuMsg.mutable_linear_acceleration()->set_y(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().y(), dt));
-          break;
-        case IMU_LINACC_Z_NOISE_METERS_PER_S_SQR:
-          this->dataPtr->imuMsg.mutable_linear_acceleration()->set_z(
-            keyNoise.second->Apply(
-              this->dataPtr->imuMsg.linear_acceleration().z(), dt));
-          break;
-        default:
-          std::ostringstream out;
-          out << "Removing unrecognized noise model: ";
-          keyNoise.second->Print(out);
-          out << std::endl;
-          gzwarn << out.str() << std::endl;
-          this->noises.erase(keyNoise.first);
-          break;
-      }
-    }
+    this->Measure(timestamp, this->dataPtr->parentEntity->WorldPose(),
+        msgs::ConvertIgn(msg.linear_velocity()),
+        msgs::ConvertIgn(msg.angular_velocity()), dt);
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
     // Publish the message
-    if (this->dataPtr->pub)
-      this->dataPtr->pub->Publish(this->dataPtr->imuMsg);
+    this->Publish(this->dataPtr->pub, this->dataPtr->imuMsg);
     IGN_PROFILE_END();
   }
 
@@ -448,6 +557,6 @@ bool ImuSensor::UpdateImpl(const bool /*_force*/)
 //////////////////////////////////////////////////
 bool ImuSensor::IsActive() const
 {
-  return this->active ||
+  return Sensor::IsActive() ||
          (this->dataPtr->pub && this->dataPtr->pub->HasConnections());
 }
@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
 
@@ -108,10 +109,52 @@ namespace gazebo
       public: void SetWorldToReferenceOrientation(
         const ignition::math::Quaterniond &_orientation);
 
+      /// \brief Sample the parent link in the physics thread at the end of
+      /// every world update, instead of using the link data received by the
+      /// sensor thread. The samples are processed at the update rate of the
+      /// sensor, which publishes the last one on the usual topic and all of
+      /// them, oldest first, on the same topic followed by "/batch".
+      /// \param[in] _synchronous True to sample every physics step.
+      /// \param[in] _capacity Number of samples kept between two updates
+      /// of the sensor. Only used the first time sampling is enabled.
+      public: void SetSynchronous(const bool _synchronous,
+                                  const unsigned int _capacity = 4096);
+
+      /// \brief Tell whether the link is sampled every physics step.
+      /// \return True if synchronous sampling is enabled.
+      /// \sa SetSynchronous
+      public: bool Synchronous() const;
+
+      /// \brief Get the number of samples that were dropped because the
+      /// sensor didn't process them before its buffer was full.
+      /// \return Number of dropped samples.
+      public: unsigned int DroppedSampleCount() const;
+
       /// \brief Callback when link data is received
       /// \param[in] _msg Message containing link data
       private: void OnLinkData(ConstLinkDataPtr &_msg);
 
+      /// \brief Sample the parent link, called by the physics thread at
+      /// the end of each world update.
+      private: void OnWorldUpdateEnd();
+
+      /// \brief Process the samples taken in the physics thread.
+      /// \return True if there were new samples.
+      private: bool UpdateSynchronous();
+
+      /// \brief Compute the measurement from the state of the parent link,
+      /// and store it in the imu message. The mutex must be locked.
+      /// \param[in] _time Time of the measurement.
+      /// \param[in] _linkPose World pose of the link.
+      /// \param[in] _linkLinearVel World linear velocity of the link.
+      /// \param[in] _linkAngularVel World angular velocity of the link.
+      /// \param[in] _dt Time since the previous measurement.
+      private: void Measure(const common::Time &_time,
+                   const ignition::math::Pose3d &_linkPose,
+                   const ignition::math::Vector3d &_linkLinearVel,
+                   const ignition::math::Vector3d &_linkAngularVel,
+                   const double _dt);
+
       /// \internal
       /// \brief Private data pointer.
       private: std::unique_ptr<ImuSensorPrivate> dataPtr;
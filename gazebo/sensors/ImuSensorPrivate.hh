@@ -18,10 +18,16 @@
 #define GAZEBO_SENSORS_IMUSENSOR_PRIVATE_HH_
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Pose3.hh>
 
+#include "gazebo/common/Event.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -29,6 +35,74 @@ namespace gazebo
 {
   namespace sensors
   {
+    /// \internal
+    /// \brief State of the parent link after a physics step.
+    class ImuSample
+    {
+      /// \brief Simulation time of the step.
+      public: common::Time time;
+
+      /// \brief World pose of the link.
+      public: ignition::math::Pose3d linkPose;
+
+      /// \brief World linear velocity of the link origin.
+      public: ignition::math::Vector3d linearVel;
+
+      /// \brief World angular velocity of the link.
+      public: ignition::math::Vector3d angularVel;
+    };
+
+    /// \internal
+    /// \brief Fixed size ring of samples, written by the physics thread and
+    /// read by the sensor thread without a lock. There must be a single
+    /// writer and a single reader.
+    class ImuSampleRing
+    {
+      /// \brief Constructor
+      /// \param[in] _capacity Number of samples the ring can hold.
+      public: explicit ImuSampleRing(const size_t _capacity)
+              : samples(_capacity + 1)
+      {
+      }
+
+      /// \brief Add a sample. Only called by the writer.
+      /// \param[in] _sample The sample.
+      /// \return False if the ring is full, then the sample is dropped.
+      public: bool Push(const ImuSample &_sample)
+      {
+        const size_t h = this->head.load(std::memory_order_relaxed);
+        const size_t next = (h + 1) % this->samples.size();
+        if (next == this->tail.load(std::memory_order_acquire))
+          return false;
+        this->samples[h] = _sample;
+        this->head.store(next, std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Take the oldest sample. Only called by the reader.
+      /// \param[out] _sample The sample.
+      /// \return False if the ring is empty.
+      public: bool Pop(ImuSample &_sample)
+      {
+        const size_t t = this->tail.load(std::memory_order_relaxed);
+        if (t == this->head.load(std::memory_order_acquire))
+          return false;
+        _sample = this->samples[t];
+        this->tail.store((t + 1) % this->samples.size(),
+            std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Storage, with one free slot to tell full from empty.
+      private: std::vector<ImuSample> samples;
+
+      /// \brief Index of the next sample to write.
+      private: std::atomic<size_t> head{0};
+
+      /// \brief Index of the next sample to read.
+      private: std::atomic<size_t> tail{0};
+    };
+
     /// \internal
     /// \brief Imu sensor private data.
     class ImuSensorPrivate
@@ -74,6 +148,24 @@ namespace gazebo
 
       /// \brief Noise free angular velocity.
       public: ignition::math::Vector3d angularVel;
+
+      /// \brief True if the link is sampled after every physics step.
+      public: std::atomic<bool> synchronous{false};
+
+      /// \brief Samples taken in the physics thread.
+      public: std::unique_ptr<ImuSampleRing> ring;
+
+      /// \brief Number of samples dropped because the ring was full.
+      public: std::atomic<unsigned int> droppedSamples{0};
+
+      /// \brief Connection to the end of each world update.
+      public: event::ConnectionPtr worldUpdateConnection;
+
+      /// \brief Publisher of the batches of samples.
+      public: transport::PublisherPtr batchPub;
+
+      /// \brief Batch of samples published by the last update.
+      public: msgs::IMU_V batchMsg;
     };
   }
 }
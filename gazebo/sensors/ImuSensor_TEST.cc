@@ -32,6 +32,7 @@ class ImuSensor_TEST : public ServerFixture,
 {
   public: void BasicImuSensorCheck(const std::string &_physicsEngine);
   public: void LinearAccelerationTest(const std::string &_physicsEngine);
+  public: void SynchronousTest(const std::string &_physicsEngine);
 };
 
 static std::string imuSensorString =
@@ -146,6 +147,49 @@ void ImuSensor_TEST::LinearAccelerationTest(const std::string &_physicsEngine)
   EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), -gravityZ, 0.4);
 }
 
+/////////////////////////////////////////////////
+// Sample every physics step and check the batch of a sensor update
+void ImuSensor_TEST::SynchronousTest(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+
+  std::string imuSensorName = "imuSensor";
+  std::string topic = "~/" + imuSensorName + "_" + _physicsEngine;
+  SpawnUnitImuSensor("imuModel", imuSensorName, "box", topic,
+      ignition::math::Vector3d(0, 0, 3), ignition::math::Vector3d::Zero);
+
+  sensors::ImuSensorPtr imuSensor =
+      std::dynamic_pointer_cast<sensors::ImuSensor>(
+      sensors::get_sensor(imuSensorName));
+  ASSERT_TRUE(imuSensor != nullptr);
+
+  sensors::SensorManager::Instance()->Init();
+  imuSensor->SetActive(true);
+
+  EXPECT_FALSE(imuSensor->Synchronous());
+  imuSensor->SetSynchronous(true);
+  EXPECT_TRUE(imuSensor->Synchronous());
+
+  // The last sample is the one of the current step, whatever the update
+  // rate of the sensor
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    world->Step(7);
+    imuSensor->Update(true);
+    EXPECT_EQ(world->SimTime(),
+        msgs::Convert(imuSensor->ImuMessage().stamp()));
+
+    // Free fall
+    EXPECT_NEAR(imuSensor->LinearAcceleration().Z(), 0, TOL);
+  }
+  EXPECT_EQ(0u, imuSensor->DroppedSampleCount());
+
+  imuSensor->SetSynchronous(false);
+  EXPECT_FALSE(imuSensor->Synchronous());
+}
+
 /////////////////////////////////////////////////
 TEST_P(ImuSensor_TEST, BasicImuSensorCheck)
 {
@@ -158,6 +202,12 @@ TEST_P(ImuSensor_TEST, LinearAccelerationTest)
   LinearAccelerationTest(GetParam());
 }
 
+/////////////////////////////////////////////////
+TEST_P(ImuSensor_TEST, SynchronousTest)
+{
+  SynchronousTest(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, ImuSensor_TEST,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
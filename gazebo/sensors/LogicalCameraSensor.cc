@@ -112,29 +112,32 @@ void LogicalCameraSensor::Fini()
 
 //////////////////////////////////////////////////
 void LogicalCameraSensorPrivate::AddVisibleModels(
-    ignition::math::Pose3d &_myPose, const physics::Model_V &_models)
+    ignition::math::Pose3d &_myPose, physics::World &_world)
 {
-  for (auto const &model : _models)
+  // The world only tests the models whose bounding box is near the
+  // frustum, nested models included.
+  this->visibleModels.clear();
+  _world.ModelsInVolume(
+      [this](const ignition::math::AxisAlignedBox &_box)
+      {
+        return this->frustum.Contains(_box);
+      }, this->visibleModels);
+
+  for (auto const &model : this->visibleModels)
   {
     auto const &scopedName = model->GetScopedName();
-    auto const aabb = model->BoundingBox();
-
-    if (this->modelName != scopedName && this->frustum.Contains(aabb))
-    {
-      // Add new model msg
-      msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
-
-      // Set the name and pose reported by the sensor.
-      modelMsg->set_name(scopedName);
-      msgs::Set(modelMsg->mutable_pose(),
-          model->WorldPose() - _myPose);
-    }
-    // Check nested models
-    // Note, the model AABB does not necessarily contain the nested model
-    // so nested models must be searched even if the frustum does not contain
-    // the parent model.
-    AddVisibleModels(_myPose, model->NestedModels());
+    if (this->modelName == scopedName)
+      continue;
+
+    // Add new model msg
+    msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
+
+    // Set the name and pose reported by the sensor.
+    modelMsg->set_name(scopedName);
+    msgs::Set(modelMsg->mutable_pose(),
+        model->WorldPose() - _myPose);
   }
+  this->visibleModels.clear();
 }
 
 //////////////////////////////////////////////////
@@ -158,13 +161,13 @@ bool LogicalCameraSensor::UpdateImpl(const bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Recursively check if models and nested models are in the frustum.
-    this->dataPtr->AddVisibleModels(myPose, this->world->Models());
+    // Check if models and nested models are in the frustum.
+    this->dataPtr->AddVisibleModels(myPose, *this->world);
     IGN_PROFILE_END();
 
     IGN_PROFILE_BEGIN("Publish");
     // Send the message.
-    this->dataPtr->pub->Publish(this->dataPtr->msg);
+    this->Publish(this->dataPtr->pub, this->dataPtr->msg);
     IGN_PROFILE_END();
   }
 
@@ -23,6 +23,7 @@
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/World.hh"
 
 namespace gazebo
 {
@@ -32,11 +33,11 @@ namespace gazebo
     /// \brief Logical camera sensor private data.
     class LogicalCameraSensorPrivate
     {
-      /// \brief Add models that are visible to the camera to a vector of models
+      /// \brief Add models that are visible to the camera to the message
       /// \param[in] _myPose pose of the logical camera
-      /// \param[in] _models list of models to test against frustum
+      /// \param[in] _world world whose models are tested against frustum
       public: void AddVisibleModels(ignition::math::Pose3d &_myPose,
-        const physics::Model_V &_models);
+        physics::World &_world);
 
       /// \brief Publisher of msgs::LogicalCameraImage messages.
       public: transport::PublisherPtr pub;
@@ -55,6 +56,9 @@ namespace gazebo
 
       /// \brief Name of the parent model.
       public: std::string modelName;
+
+      /// \brief Models found in the frustum, reused by each update.
+      public: physics::Model_V visibleModels;
     };
   }
 }
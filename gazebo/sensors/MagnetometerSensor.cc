@@ -178,8 +178,7 @@ bool MagnetometerSensor::UpdateImpl(const bool /*_force*/)
 
   IGN_PROFILE_BEGIN("Publish");
   // Publish the message if needed
-  if (this->dataPtr->magPub)
-    this->dataPtr->magPub->Publish(this->dataPtr->magMsg);
+  this->Publish(this->dataPtr->magPub, this->dataPtr->magMsg);
   IGN_PROFILE_END();
 
   return true;
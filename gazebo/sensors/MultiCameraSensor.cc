@@ -51,9 +51,11 @@ MultiCameraSensor::MultiCameraSensor()
   dataPtr(new MultiCameraSensorPrivate)
 {
   this->dataPtr->rendered = false;
-  this->connections.push_back(
-      event::Events::ConnectRender(
-        std::bind(&MultiCameraSensor::Render, this)));
+  this->SetRenderJob([this]()
+  {
+    this->Render();
+    return this->dataPtr->rendered;
+  });
 }
 
 //////////////////////////////////////////////////
@@ -202,6 +204,7 @@ void MultiCameraSensor::Init()
 //////////////////////////////////////////////////
 void MultiCameraSensor::Fini()
 {
+  this->RemoveRenderJob();
   this->dataPtr->imagePub.reset();
 
   std::lock_guard<std::mutex> lock(this->dataPtr->cameraMutex);
@@ -334,10 +337,13 @@ void MultiCameraSensor::Render()
       return;
     }
 
+    // Force every camera to render, otherwise the render period of each
+    // camera could make some of them skip this frame and publish an older
+    // image along with the new ones.
     for (auto iter = this->dataPtr->cameras.begin();
         iter != this->dataPtr->cameras.end(); ++iter)
     {
-      (*iter)->Render();
+      (*iter)->Render(true);
     }
 
     this->dataPtr->rendered = true;
@@ -357,10 +363,11 @@ void MultiCameraSensor::Render()
       return;
     }
 
+    // Force every camera to render, see above
     for (auto iter = this->dataPtr->cameras.begin();
         iter != this->dataPtr->cameras.end(); ++iter)
     {
-      (*iter)->Render();
+      (*iter)->Render(true);
     }
 
     this->dataPtr->rendered = true;
@@ -392,8 +399,11 @@ bool MultiCameraSensor::UpdateImpl(const bool /*_force*/)
 
     if (publish)
     {
+      // Copy into the string kept by the message, which keeps its
+      // capacity between updates, instead of through a temporary string.
       msgs::Image *image = this->dataPtr->msg.mutable_image(index);
-      image->set_data((*iter)->ImageData(0),
+      image->mutable_data()->assign(
+          reinterpret_cast<const char *>((*iter)->ImageData(0)),
           image->width() * (*iter)->ImageDepth() * image->height());
     }
   }
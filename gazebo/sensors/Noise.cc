@@ -124,6 +124,42 @@ double Noise::ApplyImpl(double _in, double /*_dt*/)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::Apply(double *_data, const size_t _count, const double _dt)
+{
+  if (this->type == NONE || _count == 0)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    if (this->customNoiseCallbackTime)
+    {
+      for (size_t i = 0; i < _count; ++i)
+        _data[i] = this->customNoiseCallbackTime(_data[i], _dt);
+    }
+    else if (this->customNoiseCallback)
+    {
+      for (size_t i = 0; i < _count; ++i)
+        _data[i] = this->customNoiseCallback(_data[i]);
+    }
+    else
+    {
+      gzerr << "Custom noise callback function not set!"
+          << " Please call SetCustomNoiseCallback within a sensor plugin."
+          << std::endl;
+    }
+  }
+  else
+    this->ApplyBulkImpl(_data, _count, _dt);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBulkImpl(double *_data, const size_t _count,
+    const double _dt)
+{
+  for (size_t i = 0; i < _count; ++i)
+    _data[i] = this->ApplyImpl(_data[i], _dt);
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
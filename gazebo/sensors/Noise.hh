@@ -88,6 +88,25 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in, double _dt = 0.0);
 
+      /// \brief Apply noise to an array of values, in place. This is the
+      /// same as calling Apply() on each value, but lets the noise model
+      /// draw the random values for the whole array at once.
+      /// \param[in,out] _data Values, which are replaced by the values
+      /// with noise applied.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time step of all the values.
+      public: void Apply(double *_data, const size_t _count,
+                         const double _dt = 0.0);
+
+      /// \brief Apply noise to an array of values, in place. This may be
+      /// overriden by derived classes, and is called by Apply. The default
+      /// calls ApplyImpl on each value.
+      /// \param[in,out] _data Values with noise applied.
+      /// \param[in] _count Number of values.
+      /// \param[in] _dt Time step of all the values.
+      public: virtual void ApplyBulkImpl(double *_data, const size_t _count,
+                                         const double _dt);
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
@@ -373,6 +375,67 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+TEST_F(NoiseTest, ApplyBulk)
+{
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", 1.5, 2.0, 0, 0, 0));
+  sensors::GaussianNoiseModelPtr noiseModel =
+      std::dynamic_pointer_cast<sensors::GaussianNoiseModel>(noise);
+  ASSERT_TRUE(noiseModel != nullptr);
+
+  // An odd count also covers the last value that has no pair
+  const unsigned int count = 100001;
+  std::vector<double> values(count, 42.0);
+  noise->Apply(values.data(), values.size());
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto const value : values)
+    acc(value);
+
+  double mean = noiseModel->GetMean() + noiseModel->GetBias();
+  double stddev = noiseModel->GetStdDev();
+  EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean,
+      g_sigma * stddev / sqrt(count));
+  double variance = stddev * stddev;
+  EXPECT_NEAR(boost::accumulators::variance(acc), variance,
+      g_sigma * sqrt(2 * variance * variance / (count - 1)));
+
+  // The same seed gives the same noise
+  std::vector<double> first(1000, 0.0);
+  std::vector<double> second(1000, 0.0);
+  ignition::math::Rand::Seed(42);
+  noise->Apply(first.data(), first.size());
+  ignition::math::Rand::Seed(42);
+  noise->Apply(second.data(), second.size());
+  EXPECT_EQ(first, second);
+
+  // No noise leaves the values as they are
+  sensors::NoisePtr none = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  std::vector<double> unchanged(10, 3.0);
+  none->Apply(unchanged.data(), unchanged.size());
+  EXPECT_EQ(std::vector<double>(10, 3.0), unchanged);
+}
+
+//////////////////////////////////////////////////
+TEST_F(NoiseTest, ApplyBulkCustom)
+{
+  sensors::NoisePtr noise(new sensors::Noise(sensors::Noise::CUSTOM));
+  noise->SetCustomNoiseCallback(
+    boost::bind(&OnApplyCustomNoise, _1));
+
+  std::vector<double> values;
+  for (double i = 0; i < 100; i += 1)
+    values.push_back(i);
+  noise->Apply(values.data(), values.size());
+
+  for (unsigned int i = 0; i < values.size(); ++i)
+    EXPECT_DOUBLE_EQ(i * 2.0, values[i]);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -384,6 +384,21 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
   unsigned int rangeCount = this->RangeCount();
   unsigned int verticalRayCount = this->VerticalRayCount();
   unsigned int verticalRangeCount = this->VerticalRangeCount();
+  double rangeMin = this->RangeMin();
+  double rangeMax = this->RangeMax();
+
+  auto noise = this->noises.find(RAY_NOISE);
+
+  // Read all the ray ranges and retro values at once.
+  const std::vector<double> &rayRanges = this->dataPtr->rayRanges;
+  const std::vector<double> &rayRetros = this->dataPtr->rayRetros;
+  this->dataPtr->laserShape->Scan(this->dataPtr->rayRanges,
+      this->dataPtr->rayRetros);
+  GZ_ASSERT(rayRanges.size() >= rayCount * verticalRayCount,
+      "Fewer rays than expected in the laser shape");
+
+  scan->mutable_ranges()->Reserve(rangeCount * verticalRangeCount);
+  scan->mutable_intensities()->Reserve(rangeCount * verticalRangeCount);
 
   // Interpolation: for every point in range count, compute interpolated value
   // using four bounding ray samples.
@@ -458,53 +473,67 @@ bool RaySensor::UpdateImpl(const bool /*_force*/)
         j4 = hjb + vjb * rayCount;
 
         // range readings of 4 corners
-        r1 = this->LaserShape()->GetRange(j1);
-        r2 = this->LaserShape()->GetRange(j2);
-        r3 = this->LaserShape()->GetRange(j3);
-        r4 = this->LaserShape()->GetRange(j4);
+        r1 = rayRanges[j1];
+        r2 = rayRanges[j2];
+        r3 = rayRanges[j3];
+        r4 = rayRanges[j4];
         range = (1-vb)*((1 - hb) * r1 + hb * r2)
             + vb *((1 - hb) * r3 + hb * r4);
 
         // intensity is averaged
-        intensity = 0.25 * (this->LaserShape()->GetRetro(j1)
-            + this->LaserShape()->GetRetro(j2)
-            + this->LaserShape()->GetRetro(j3)
-            + this->LaserShape()->GetRetro(j4));
+        intensity = 0.25 * (rayRetros[j1] + rayRetros[j2] +
+            rayRetros[j3] + rayRetros[j4]);
       }
       else
       {
-        range = this->dataPtr->laserShape->GetRange(j * this->RayCount() + i);
-        intensity = this->dataPtr->laserShape->GetRetro(j *
-            this->RayCount() + i);
+        range = rayRanges[j * rayCount + i];
+        intensity = rayRetros[j * rayCount + i];
       }
 
       // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (range >= this->RangeMax())
+      if (range >= rangeMax)
       {
         range = ignition::math::INF_D;
       }
-      else if (range <= this->RangeMin())
+      else if (range <= rangeMin)
       {
         range = -ignition::math::INF_D;
       }
-      else if (this->noises.find(RAY_NOISE) !=
-               this->noises.end())
+      else if (noise != this->noises.end())
       {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->RangeMin(), this->RangeMax());
+        // Noise is applied to all the ranges at once below
+        this->dataPtr->noisyIndices.push_back(scan->ranges_size());
+        this->dataPtr->noisyRanges.push_back(range);
       }
 
       scan->add_ranges(range);
       scan->add_intensities(intensity);
     }
   }
+
+  if (!this->dataPtr->noisyRanges.empty())
+  {
+    // currently supports only one noise model per laser sensor
+    std::vector<double> &noisyRanges = this->dataPtr->noisyRanges;
+    noise->second->Apply(noisyRanges.data(), noisyRanges.size());
+
+    double *ranges = scan->mutable_ranges()->mutable_data();
+    for (size_t i = 0; i < noisyRanges.size(); ++i)
+    {
+      ranges[this->dataPtr->noisyIndices[i]] =
+          ignition::math::clamp(noisyRanges[i], rangeMin, rangeMax);
+    }
+    noisyRanges.clear();
+    this->dataPtr->noisyIndices.clear();
+  }
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
-  if (this->dataPtr->scanPub && this->dataPtr->scanPub->HasConnections())
-    this->dataPtr->scanPub->Publish(this->dataPtr->laserMsg);
+  if (this->dataPtr->scanPub &&
+      (this->dataPtr->scanPub->HasConnections() || this->Bundled()))
+  {
+    this->Publish(this->dataPtr->scanPub, this->dataPtr->laserMsg);
+  }
   IGN_PROFILE_END();
 
   return true;
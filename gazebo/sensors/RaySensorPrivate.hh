@@ -18,6 +18,7 @@
 #define _GAZEBO_SENSORS_RAYSENSOR_PRIVATE_HH_
 
 #include <mutex>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -48,6 +49,21 @@ namespace gazebo
 
       /// \brief Laser message.
       public: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Ranges of all the rays, read from laserShape after each
+      /// update.
+      public: std::vector<double> rayRanges;
+
+      /// \brief Retro values of all the rays, read from laserShape after
+      /// each update.
+      public: std::vector<double> rayRetros;
+
+      /// \brief Ranges that get noise applied, gathered so that the noise
+      /// model gets them all at once.
+      public: std::vector<double> noisyRanges;
+
+      /// \brief Index in the scan of each of noisyRanges.
+      public: std::vector<int> noisyIndices;
     };
   }
 }
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/sensors/RenderJobQueue.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief A job and its scheduling state.
+    class RenderJobQueueEntry
+    {
+      /// \brief The job.
+      public: RenderJobQueue::Job job;
+
+      /// \brief Deadline of the job in the current frame.
+      public: common::Time deadline;
+
+      /// \brief True if the job was deferred by the last frame.
+      public: bool deferred = false;
+
+      /// \brief Wall time spent by the job.
+      public: RenderJobQueue::Stats stats;
+    };
+
+    /// \internal
+    /// \brief Private data for RenderJobQueue
+    class RenderJobQueuePrivate
+    {
+      /// \brief Protects every member. Held while the jobs run.
+      public: mutable std::mutex mutex;
+
+      /// \brief Jobs by identifier.
+      public: std::map<unsigned int, RenderJobQueueEntry> entries;
+
+      /// \brief Identifier of the next job.
+      public: unsigned int nextId = 1;
+
+      /// \brief Frame budget.
+      public: common::Time budget;
+
+      /// \brief Number of jobs deferred by the last frame.
+      public: unsigned int deferredCount = 0;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+RenderJobQueue::RenderJobQueue()
+  : dataPtr(new RenderJobQueuePrivate)
+{
+  // Frame budget in milliseconds from GAZEBO_SENSOR_RENDER_BUDGET
+  const char *budgetEnv = getenv("GAZEBO_SENSOR_RENDER_BUDGET");
+  if (budgetEnv)
+  {
+    try
+    {
+      this->dataPtr->budget = common::Time(std::stod(budgetEnv) * 1e-3);
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_SENSOR_RENDER_BUDGET[" << budgetEnv << "]\n";
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+RenderJobQueue::~RenderJobQueue()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int RenderJobQueue::Add(const Job &_job)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const unsigned int id = this->dataPtr->nextId++;
+  this->dataPtr->entries[id].job = _job;
+  return id;
+}
+
+//////////////////////////////////////////////////
+void RenderJobQueue::Remove(const unsigned int _id)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->entries.erase(_id);
+}
+
+//////////////////////////////////////////////////
+bool RenderJobQueue::SetPriority(const std::string &_name,
+    const Priority _priority)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  bool found = false;
+  for (auto &entry : this->dataPtr->entries)
+  {
+    if (entry.second.job.name == _name)
+    {
+      entry.second.job.priority = _priority;
+      found = true;
+    }
+  }
+  return found;
+}
+
+//////////////////////////////////////////////////
+void RenderJobQueue::SetBudget(const common::Time &_budget)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->budget = _budget;
+}
+
+//////////////////////////////////////////////////
+common::Time RenderJobQueue::Budget() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->budget;
+}
+
+//////////////////////////////////////////////////
+unsigned int RenderJobQueue::Run(const common::Time &_simTime,
+    const bool _force)
+{
+  IGN_PROFILE("sensors::RenderJobQueue::Run");
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  std::vector<RenderJobQueueEntry *> order;
+  order.reserve(this->dataPtr->entries.size());
+  for (auto &entry : this->dataPtr->entries)
+  {
+    entry.second.deadline = entry.second.job.deadline ?
+        entry.second.job.deadline() : common::Time::Zero;
+    order.push_back(&entry.second);
+  }
+
+  // Jobs of the same priority and deadline keep the order they were
+  // added in.
+  std::stable_sort(order.begin(), order.end(),
+      [](const RenderJobQueueEntry *_a, const RenderJobQueueEntry *_b)
+      {
+        if (_a->job.priority != _b->job.priority)
+          return _a->job.priority < _b->job.priority;
+        return _a->deadline < _b->deadline;
+      });
+
+  const common::Time budget = this->dataPtr->budget;
+  const common::Time start = common::Time::GetWallTime();
+  unsigned int rendered = 0;
+  this->dataPtr->deferredCount = 0;
+
+  for (auto entry : order)
+  {
+    const Job &job = entry->job;
+    if (budget > common::Time::Zero && !_force &&
+        job.priority != HIGH_PRIORITY && job.deferrable &&
+        !entry->deferred && entry->deadline <= _simTime &&
+        common::Time::GetWallTime() - start >= budget)
+    {
+      entry->deferred = true;
+      ++this->dataPtr->deferredCount;
+      continue;
+    }
+    entry->deferred = false;
+
+    IGN_PROFILE_BEGIN(job.name.c_str());
+    const common::Time renderStart = common::Time::GetWallTime();
+    if (job.render && job.render())
+    {
+      const common::Time publishStart = common::Time::GetWallTime();
+      entry->stats.renderTime += publishStart - renderStart;
+      ++entry->stats.renders;
+      ++rendered;
+      if (job.publish)
+      {
+        job.publish();
+        entry->stats.publishTime +=
+            common::Time::GetWallTime() - publishStart;
+      }
+    }
+    IGN_PROFILE_END();
+  }
+
+  return rendered;
+}
+
+//////////////////////////////////////////////////
+unsigned int RenderJobQueue::DeferredCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->deferredCount;
+}
+
+//////////////////////////////////////////////////
+unsigned int RenderJobQueue::JobCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->entries.size();
+}
+
+//////////////////////////////////////////////////
+bool RenderJobQueue::JobStats(const std::string &_name, Stats &_stats) const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  bool found = false;
+  _stats = Stats();
+  for (auto const &entry : this->dataPtr->entries)
+  {
+    if (entry.second.job.name == _name)
+    {
+      _stats.renders += entry.second.stats.renders;
+      _stats.renderTime += entry.second.stats.renderTime;
+      _stats.publishTime += entry.second.stats.publishTime;
+      found = true;
+    }
+  }
+  return found;
+}
+
+//////////////////////////////////////////////////
+void RenderJobQueue::ResetStats()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto &entry : this->dataPtr->entries)
+    entry.second.stats = Stats();
+}
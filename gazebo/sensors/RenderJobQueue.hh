@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_RENDERJOBQUEUE_HH_
+#define GAZEBO_SENSORS_RENDERJOBQUEUE_HH_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/SingletonT.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+/// \brief Explicit instantiation for typed SingletonT.
+GZ_SINGLETON_DECLARE(GZ_SENSORS_VISIBLE, gazebo, sensors, RenderJobQueue)
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declarations
+    class RenderJobQueuePrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class RenderJobQueue RenderJobQueue.hh sensors/sensors.hh
+    /// \brief Orders the render passes of the rendering sensors.
+    ///
+    /// The scene is updated once per frame by the prerender event, then
+    /// Run() renders the jobs of the sensors that are due, by priority and
+    /// then by deadline. The data of each sensor is read back and published
+    /// right after its render pass, so that high priority sensors, such as
+    /// GPU lidars, don't wait for the passes of the cameras. With a frame
+    /// budget, the due jobs that don't have a high priority and start after
+    /// the budget is spent are deferred to the next frame. A job is never
+    /// deferred twice in a row, and strict rate sensors are never deferred.
+    /// Instance() is the queue run by the SensorManager, whose budget is
+    /// read from GAZEBO_SENSOR_RENDER_BUDGET in milliseconds.
+    class GZ_SENSORS_VISIBLE RenderJobQueue :
+      public SingletonT<RenderJobQueue>
+    {
+      /// \brief Priority of a job. Lower values render first.
+      public: enum Priority
+              {
+                /// \brief Timing critical sensors, never deferred.
+                HIGH_PRIORITY = 0,
+                /// \brief Default priority.
+                NORMAL_PRIORITY = 1,
+                /// \brief Rendered after the other jobs.
+                LOW_PRIORITY = 2
+              };
+
+      /// \brief A render job.
+      public: class Job
+      {
+        /// \brief Name of the job, typically the scoped sensor name.
+        public: std::string name;
+
+        /// \brief Priority of the job.
+        public: Priority priority = NORMAL_PRIORITY;
+
+        /// \brief False if the job must render whenever it is due.
+        public: bool deferrable = true;
+
+        /// \brief Get the simulation time at which the job is due.
+        public: std::function<common::Time()> deadline;
+
+        /// \brief Render, if due. Returns true if rendered.
+        public: std::function<bool()> render;
+
+        /// \brief Called right after a successful render, to read back
+        /// and publish the data.
+        public: std::function<void()> publish;
+      };
+
+      /// \brief Wall time spent by the passes of a job.
+      public: class Stats
+      {
+        /// \brief Number of passes that rendered.
+        public: uint64_t renders = 0;
+
+        /// \brief Total wall time of the render callbacks that rendered.
+        public: common::Time renderTime;
+
+        /// \brief Total wall time of the publish callbacks, which read
+        /// back and publish the data.
+        public: common::Time publishTime;
+      };
+
+      /// \brief Constructor
+      public: RenderJobQueue();
+
+      /// \brief Destructor
+      public: virtual ~RenderJobQueue();
+
+      /// \brief Add a job.
+      /// \param[in] _job The job.
+      /// \return Identifier of the job, used to remove it.
+      public: unsigned int Add(const Job &_job);
+
+      /// \brief Remove a job. Waits for a running Run() call to finish.
+      /// \param[in] _id Identifier returned by Add(). Removing an id that
+      /// doesn't exist, such as 0, does nothing.
+      public: void Remove(const unsigned int _id);
+
+      /// \brief Change the priority of the jobs of a name.
+      /// \param[in] _name Name of the jobs.
+      /// \param[in] _priority The new priority.
+      /// \return True if a job has that name.
+      public: bool SetPriority(const std::string &_name,
+                               const Priority _priority);
+
+      /// \brief Set the wall time the jobs of a frame can take before the
+      /// deferrable jobs are postponed.
+      /// \param[in] _budget Budget, or zero to never postpone a job.
+      public: void SetBudget(const common::Time &_budget);
+
+      /// \brief Get the frame budget.
+      /// \return Budget wall time, zero if jobs are never postponed.
+      public: common::Time Budget() const;
+
+      /// \brief Run the jobs of a frame.
+      /// \param[in] _simTime Current simulation time, to know which jobs
+      /// are due.
+      /// \param[in] _force True to run every job within the frame.
+      /// \return Number of jobs that rendered.
+      public: unsigned int Run(const common::Time &_simTime,
+                               const bool _force = false);
+
+      /// \brief Get the number of jobs deferred by the last Run() call.
+      /// \return Number of deferred jobs.
+      public: unsigned int DeferredCount() const;
+
+      /// \brief Get the number of jobs.
+      /// \return Number of jobs.
+      public: unsigned int JobCount() const;
+
+      /// \brief Get the wall time spent by the jobs of a name since they
+      /// were added or since the last ResetStats() call.
+      /// \param[in] _name Name of the jobs.
+      /// \param[out] _stats Sum of the stats of the jobs.
+      /// \return True if a job has that name.
+      public: bool JobStats(const std::string &_name, Stats &_stats) const;
+
+      /// \brief Reset the stats of every job.
+      public: void ResetStats();
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<RenderJobQueuePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
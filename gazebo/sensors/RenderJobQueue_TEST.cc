@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/sensors/RenderJobQueue.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+/// \brief Create a job that records its render passes.
+/// \param[in] _name Name of the job.
+/// \param[in] _priority Priority of the job.
+/// \param[in] _deadline Simulation time at which the job is due.
+/// \param[in,out] _log Names of the jobs that rendered, followed by
+/// "publish" for each published pass.
+/// \param[in] _sleep Wall time each render pass takes.
+/// \return The job.
+sensors::RenderJobQueue::Job makeJob(const std::string &_name,
+    const sensors::RenderJobQueue::Priority _priority,
+    const common::Time &_deadline, std::vector<std::string> &_log,
+    const common::Time &_sleep = common::Time::Zero)
+{
+  sensors::RenderJobQueue::Job job;
+  job.name = _name;
+  job.priority = _priority;
+  job.deadline = [_deadline]()
+  {
+    return _deadline;
+  };
+  job.render = [_name, _sleep, &_log]()
+  {
+    common::Time::Sleep(_sleep);
+    _log.push_back(_name);
+    return true;
+  };
+  job.publish = [&_log]()
+  {
+    _log.push_back("publish");
+  };
+  return job;
+}
+
+/////////////////////////////////////////////////
+TEST(RenderJobQueueTest, Order)
+{
+  sensors::RenderJobQueue queue;
+  std::vector<std::string> log;
+
+  queue.Add(makeJob("camera_late", sensors::RenderJobQueue::NORMAL_PRIORITY,
+      common::Time(2.0), log));
+  queue.Add(makeJob("camera_early", sensors::RenderJobQueue::NORMAL_PRIORITY,
+      common::Time(1.0), log));
+  const unsigned int lidar = queue.Add(makeJob("lidar",
+      sensors::RenderJobQueue::HIGH_PRIORITY, common::Time(3.0), log));
+  EXPECT_EQ(3u, queue.JobCount());
+
+  // High priority first, then by deadline, each pass published right away
+  EXPECT_EQ(3u, queue.Run(common::Time(5.0)));
+  std::vector<std::string> expected = {"lidar", "publish", "camera_early",
+      "publish", "camera_late", "publish"};
+  EXPECT_EQ(expected, log);
+
+  log.clear();
+  EXPECT_TRUE(queue.SetPriority("camera_late",
+      sensors::RenderJobQueue::LOW_PRIORITY));
+  EXPECT_FALSE(queue.SetPriority("missing",
+      sensors::RenderJobQueue::LOW_PRIORITY));
+  queue.Remove(lidar);
+  queue.Remove(0);
+  EXPECT_EQ(2u, queue.JobCount());
+
+  EXPECT_EQ(2u, queue.Run(common::Time(5.0)));
+  expected = {"camera_early", "publish", "camera_late", "publish"};
+  EXPECT_EQ(expected, log);
+
+  // A pass that doesn't render isn't published
+  log.clear();
+  sensors::RenderJobQueue::Job idle = makeJob("idle",
+      sensors::RenderJobQueue::HIGH_PRIORITY, common::Time::Zero, log);
+  idle.render = []()
+  {
+    return false;
+  };
+  queue.Add(idle);
+  EXPECT_EQ(2u, queue.Run(common::Time(5.0)));
+  EXPECT_EQ(expected, log);
+}
+
+/////////////////////////////////////////////////
+TEST(RenderJobQueueTest, Budget)
+{
+  sensors::RenderJobQueue queue;
+  EXPECT_EQ(common::Time::Zero, queue.Budget());
+  queue.SetBudget(common::Time(0.001));
+  EXPECT_EQ(common::Time(0.001), queue.Budget());
+
+  std::vector<std::string> log;
+  queue.Add(makeJob("lidar", sensors::RenderJobQueue::HIGH_PRIORITY,
+      common::Time(1.0), log, common::Time(0.002)));
+  queue.Add(makeJob("camera", sensors::RenderJobQueue::NORMAL_PRIORITY,
+      common::Time(1.0), log));
+  sensors::RenderJobQueue::Job strict = makeJob("strict",
+      sensors::RenderJobQueue::NORMAL_PRIORITY, common::Time(1.0), log);
+  strict.deferrable = false;
+  queue.Add(strict);
+  queue.Add(makeJob("future", sensors::RenderJobQueue::LOW_PRIORITY,
+      common::Time(9.0), log));
+
+  // The lidar spends the budget. The camera is deferred, but not the
+  // strict job, nor the job that isn't due yet.
+  EXPECT_EQ(3u, queue.Run(common::Time(2.0)));
+  EXPECT_EQ(1u, queue.DeferredCount());
+  std::vector<std::string> expected = {"lidar", "publish", "strict",
+      "publish", "future", "publish"};
+  EXPECT_EQ(expected, log);
+
+  // A deferred job runs in the next frame
+  log.clear();
+  EXPECT_EQ(4u, queue.Run(common::Time(2.0)));
+  EXPECT_EQ(0u, queue.DeferredCount());
+  EXPECT_EQ(4u, log.size() / 2);
+
+  // Forced frames run every job
+  log.clear();
+  EXPECT_EQ(4u, queue.Run(common::Time(2.0), true));
+  EXPECT_EQ(0u, queue.DeferredCount());
+}
+
+/////////////////////////////////////////////////
+TEST(RenderJobQueueTest, Stats)
+{
+  sensors::RenderJobQueue queue;
+  sensors::RenderJobQueue::Stats stats;
+  EXPECT_FALSE(queue.JobStats("camera", stats));
+
+  std::vector<std::string> log;
+  queue.Add(makeJob("camera", sensors::RenderJobQueue::NORMAL_PRIORITY,
+      common::Time::Zero, log, common::Time(0.002)));
+  sensors::RenderJobQueue::Job idle = makeJob("idle",
+      sensors::RenderJobQueue::NORMAL_PRIORITY, common::Time::Zero, log);
+  idle.render = []()
+  {
+    return false;
+  };
+  queue.Add(idle);
+
+  EXPECT_EQ(1u, queue.Run(common::Time(1.0)));
+  EXPECT_EQ(1u, queue.Run(common::Time(2.0)));
+
+  ASSERT_TRUE(queue.JobStats("camera", stats));
+  EXPECT_EQ(2u, stats.renders);
+  EXPECT_GE(stats.renderTime, common::Time(0.004));
+  EXPECT_LT(stats.publishTime, stats.renderTime);
+
+  // Passes that don't render aren't counted
+  ASSERT_TRUE(queue.JobStats("idle", stats));
+  EXPECT_EQ(0u, stats.renders);
+  EXPECT_EQ(common::Time::Zero, stats.renderTime);
+
+  queue.ResetStats();
+  ASSERT_TRUE(queue.JobStats("camera", stats));
+  EXPECT_EQ(0u, stats.renders);
+  EXPECT_EQ(common::Time::Zero, stats.renderTime);
+  EXPECT_EQ(common::Time::Zero, stats.publishTime);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -28,6 +28,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Plugin.hh"
+#include "gazebo/common/PluginCosts.hh"
 #include "gazebo/common/SdfFrameSemantics.hh"
 
 #include "gazebo/rendering/Camera.hh"
@@ -40,6 +41,7 @@
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/SensorPrivate.hh"
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorBundle.hh"
 #include "gazebo/sensors/SensorManager.hh"
 
 using namespace gazebo;
@@ -155,6 +157,10 @@ void Sensor::Load(const std::string &_worldName)
   this->node->Init(this->world->Name());
   this->dataPtr->sensorPub =
     this->node->Advertise<msgs::Sensor>("~/sensor");
+
+  if (this->sdf->HasElement("bundle"))
+    this->dataPtr->bundled = this->sdf->Get<bool>("bundle");
+  this->SetBundled(this->dataPtr->bundled);
 }
 
 //////////////////////////////////////////////////
@@ -176,6 +182,23 @@ void Sensor::Init()
   msgs::Sensor msg;
   this->FillMsg(msg);
   this->dataPtr->sensorPub->Publish(msg);
+
+  // Queue the render pass, now that the update rate is known.
+  if (this->dataPtr->renderJob.render && !this->dataPtr->renderJobId)
+  {
+    RenderJobQueue::Job job = this->dataPtr->renderJob;
+    job.name = this->ScopedName();
+    job.deferrable = !this->useStrictRate;
+    job.deadline = [this]()
+    {
+      return this->NextUpdateTime();
+    };
+    job.publish = [this]()
+    {
+      this->Update(false);
+    };
+    this->dataPtr->renderJobId = RenderJobQueue::Instance()->Add(job);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -197,6 +220,21 @@ uint32_t Sensor::Id() const
   return this->dataPtr->id;
 }
 
+//////////////////////////////////////////////////
+void Sensor::SetRenderJob(const std::function<bool()> &_render,
+    const RenderJobQueue::Priority _priority)
+{
+  this->dataPtr->renderJob.render = _render;
+  this->dataPtr->renderJob.priority = _priority;
+}
+
+//////////////////////////////////////////////////
+void Sensor::RemoveRenderJob()
+{
+  RenderJobQueue::Instance()->Remove(this->dataPtr->renderJobId);
+  this->dataPtr->renderJobId = 0;
+}
+
 //////////////////////////////////////////////////
 uint32_t Sensor::ParentId() const
 {
@@ -238,8 +276,12 @@ void Sensor::Update(const bool _force)
   {
     if (this->useStrictRate)
     {
+      const common::Time start = common::Time::GetWallTime();
       if (this->UpdateImpl(_force))
+      {
+        this->AddUpdateStats(start);
         this->updated();
+      }
     }
     else
     {
@@ -276,8 +318,10 @@ void Sensor::Update(const bool _force)
           this->dataPtr->updateDelay = common::Time::Zero;
       }
 
+      const common::Time start = common::Time::GetWallTime();
       if (this->UpdateImpl(_force))
       {
+        this->AddUpdateStats(start);
         std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
         this->lastUpdateTime = simTime;
         this->updated();
@@ -286,9 +330,24 @@ void Sensor::Update(const bool _force)
   }
 }
 
+//////////////////////////////////////////////////
+common::Time Sensor::NextUpdateTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLastUpdateTime);
+  // Same equation as in Sensor::Update
+  return this->lastUpdateTime + this->updatePeriod - this->dataPtr->updateDelay;
+}
+
 //////////////////////////////////////////////////
 void Sensor::Fini()
 {
+  this->RemoveRenderJob();
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutexBundle);
+    this->dataPtr->bundle.reset();
+  }
+
   if (this->node)
     this->node->Fini();
   this->node.reset();
@@ -331,6 +390,8 @@ void Sensor::LoadPlugin(sdf::ElementPtr _sdf)
 {
   std::string name = _sdf->Get<std::string>("name");
   std::string filename = _sdf->Get<std::string>("filename");
+  common::PluginCostScope costScope(this->ScopedName() + "::" + name,
+      filename);
   gazebo::SensorPluginPtr plugin = gazebo::SensorPlugin::Create(filename, name);
 
   if (plugin)
@@ -353,13 +414,74 @@ void Sensor::LoadPlugin(sdf::ElementPtr _sdf)
 //////////////////////////////////////////////////
 void Sensor::SetActive(const bool _value)
 {
+  const bool activated = _value && !this->active;
   this->active = _value;
+
+  // The sensor threads sleep until the next active sensor is due, which
+  // may be later than this sensor's next update.
+  if (activated)
+    SensorManager::Instance()->WakeUpSensors();
 }
 
 //////////////////////////////////////////////////
 bool Sensor::IsActive() const
 {
-  return this->active;
+  if (!this->active || !this->dataPtr->lazy)
+    return this->active;
+
+  const bool observed = this->HasConsumers();
+  const common::Time simTime = this->world ? this->world->SimTime() :
+      common::Time::Zero;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLazy);
+  if (observed && !this->dataPtr->observed)
+    this->dataPtr->warmupEnd = simTime + this->dataPtr->lazyWarmup;
+  this->dataPtr->observed = observed;
+
+  return observed || simTime < this->dataPtr->warmupEnd;
+}
+
+//////////////////////////////////////////////////
+void Sensor::SetLazy(const bool _lazy)
+{
+  this->dataPtr->lazy = _lazy;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::Lazy() const
+{
+  return this->dataPtr->lazy;
+}
+
+//////////////////////////////////////////////////
+void Sensor::SetLazyWarmup(const common::Time &_warmup)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLazy);
+  this->dataPtr->lazyWarmup = _warmup;
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::LazyWarmup() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexLazy);
+  return this->dataPtr->lazyWarmup;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::HasConsumers() const
+{
+  if (!this->plugins.empty() || this->updated.ConnectionCount() > 0)
+    return true;
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutexBundle);
+    if (this->dataPtr->bundle && this->dataPtr->bundle->HasConnections())
+      return true;
+  }
+
+  // The sensor description publisher is not an output of the sensor
+  return this->node &&
+      this->node->HasConnectedPublishers(this->dataPtr->sensorPub);
 }
 
 //////////////////////////////////////////////////
@@ -412,12 +534,90 @@ common::Time Sensor::LastUpdateTime() const
   return this->lastUpdateTime;
 }
 
+//////////////////////////////////////////////////
+void Sensor::AddUpdateStats(const common::Time &_start)
+{
+  const common::Time elapsed = common::Time::GetWallTime() - _start;
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexUpdateStats);
+  ++this->dataPtr->updateCount;
+  this->dataPtr->updateWallTime += elapsed;
+}
+
+//////////////////////////////////////////////////
+uint64_t Sensor::UpdateCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexUpdateStats);
+  return this->dataPtr->updateCount;
+}
+
+//////////////////////////////////////////////////
+common::Time Sensor::UpdateWallTime() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexUpdateStats);
+  return this->dataPtr->updateWallTime;
+}
+
+//////////////////////////////////////////////////
+void Sensor::ResetUpdateStats()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexUpdateStats);
+  this->dataPtr->updateCount = 0;
+  this->dataPtr->updateWallTime = common::Time::Zero;
+}
+
 //////////////////////////////////////////////////
 common::Time Sensor::LastMeasurementTime() const
 {
   return this->lastMeasurementTime;
 }
 
+//////////////////////////////////////////////////
+void Sensor::SetBundled(const bool _bundled)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexBundle);
+  this->dataPtr->bundled = _bundled;
+  this->dataPtr->bundle.reset();
+
+  // The bundle is shared by the sensors of the model of the parent link or
+  // joint, once the sensor is loaded
+  if (!_bundled || !this->world)
+    return;
+
+  const std::size_t sep = this->parentName.rfind("::");
+  const std::string model = sep == std::string::npos ? this->parentName :
+      this->parentName.substr(0, sep);
+  this->dataPtr->bundle = SensorBundle::Get(this->world->Name(), model);
+}
+
+//////////////////////////////////////////////////
+bool Sensor::Bundled() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutexBundle);
+  return this->dataPtr->bundled;
+}
+
+//////////////////////////////////////////////////
+void Sensor::Publish(const transport::PublisherPtr &_pub,
+    const google::protobuf::Message &_msg)
+{
+  SensorBundlePtr bundle;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutexBundle);
+    bundle = this->dataPtr->bundle;
+  }
+
+  if (!bundle)
+  {
+    if (_pub)
+      _pub->Publish(_msg);
+    return;
+  }
+
+  bundle->Add(this->ScopedName(), this->lastMeasurementTime, _msg);
+  if (_pub && _pub->HasConnections())
+    _pub->Publish(_msg);
+}
+
 //////////////////////////////////////////////////
 std::string Sensor::Type() const
 {
@@ -17,6 +17,8 @@
 #ifndef GAZEBO_SENSORS_SENSOR_HH_
 #define GAZEBO_SENSORS_SENSOR_HH_
 
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <map>
@@ -28,6 +30,7 @@
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/rendering/RenderTypes.hh"
+#include "gazebo/sensors/RenderJobQueue.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 
 #include "gazebo/msgs/msgs.hh"
@@ -122,6 +125,48 @@ namespace gazebo
       /// \return True if active, false if not.
       public: virtual bool IsActive() const;
 
+      /// \brief Set whether the sensor is lazy. A lazy sensor that is
+      /// active is only updated while its data has a consumer: a subscriber
+      /// to one of its topics, a callback connected with ConnectUpdated, or
+      /// a sensor plugin. Code that reads the sensor through its accessors
+      /// must connect to ConnectUpdated to keep it updating. An unobserved
+      /// lazy sensor doesn't render nor query the physics engine.
+      /// \param[in] _lazy True to suspend the sensor while unobserved.
+      /// \sa SetLazyWarmup
+      public: void SetLazy(const bool _lazy);
+
+      /// \brief Get whether the sensor is lazy.
+      /// \return True if the sensor is suspended while unobserved.
+      public: bool Lazy() const;
+
+      /// \brief Set how long a lazy sensor keeps updating once it gets a
+      /// consumer, even if the consumer goes away. This gives sensors whose
+      /// output depends on past updates the time to settle.
+      /// \param[in] _warmup Warm-up in simulation time.
+      public: void SetLazyWarmup(const common::Time &_warmup);
+
+      /// \brief Get the warm-up of a lazy sensor.
+      /// \return Warm-up in simulation time.
+      public: common::Time LazyWarmup() const;
+
+      /// \brief Tell whether the data of the sensor has a consumer.
+      /// \return True if a topic of the sensor has a subscriber, a
+      /// callback is connected to the updated event, or a plugin is loaded.
+      public: bool HasConsumers() const;
+
+      /// \brief Set whether the sensor publishes its messages in the
+      /// bundle of its model, which is also enabled by
+      /// <bundle>true</bundle> in the SDF of the sensor. A bundled sensor
+      /// still publishes on its own topic while it has subscribers.
+      /// \param[in] _bundled True to bundle the messages of the sensor.
+      /// \sa SensorBundle
+      public: void SetBundled(const bool _bundled);
+
+      /// \brief Get whether the sensor publishes in the bundle of its
+      /// model.
+      /// \return True if the messages of the sensor are bundled.
+      public: bool Bundled() const;
+
       /// \brief Get sensor type.
       /// \return Type of sensor.
       public: std::string Type() const;
@@ -130,6 +175,20 @@ namespace gazebo
       /// \return Time of last update.
       public: common::Time LastUpdateTime() const;
 
+      /// \brief Get the number of updates that produced data since the
+      /// sensor was loaded or since the last ResetUpdateStats() call.
+      /// \return Number of updates.
+      public: uint64_t UpdateCount() const;
+
+      /// \brief Get the total wall time of the updates counted by
+      /// UpdateCount(). The render passes of rendering sensors aren't
+      /// included, see RenderJobQueue::JobStats.
+      /// \return Wall time.
+      public: common::Time UpdateWallTime() const;
+
+      /// \brief Reset UpdateCount() and UpdateWallTime() to zero.
+      public: void ResetUpdateStats();
+
       /// \brief Return last measurement time.
       /// \return Time of last measurement.
       public: common::Time LastMeasurementTime() const;
@@ -167,6 +226,12 @@ namespace gazebo
       /// \brief Reset the lastUpdateTime to zero.
       public: virtual void ResetLastUpdateTime();
 
+      /// \brief Get the simulation time at which the sensor is next due
+      /// for an update, based on its update rate.
+      /// \return Time of the next update. Not meaningful for sensors with
+      /// an update rate of zero, which update on every call.
+      public: common::Time NextUpdateTime() const;
+
       /// \brief Get the sensor's ID.
       /// \return The sensor's ID.
       public: uint32_t Id() const;
@@ -201,10 +266,36 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: virtual bool NeedsUpdate();
 
+      /// \brief Publish a message of the sensor, in the bundle of its
+      /// model if the sensor is bundled, and on its own topic.
+      /// \param[in] _pub Publisher of the topic of the sensor.
+      /// \param[in] _msg The message, stamped with LastMeasurementTime().
+      protected: void Publish(const transport::PublisherPtr &_pub,
+                     const google::protobuf::Message &_msg);
+
+      /// \brief Set the render pass of a rendering sensor. It is run by
+      /// the RenderJobQueue from Init() until Fini() or RemoveRenderJob(),
+      /// and the sensor is updated right after each pass that rendered.
+      /// Call it from the constructor.
+      /// \param[in] _render Renders if the sensor is due, and returns true
+      /// if it rendered.
+      /// \param[in] _priority Priority of the pass.
+      protected: void SetRenderJob(const std::function<bool()> &_render,
+                     const RenderJobQueue::Priority _priority =
+                     RenderJobQueue::NORMAL_PRIORITY);
+
+      /// \brief Stop running the render pass. Rendering sensors call it
+      /// before they destroy their cameras.
+      protected: void RemoveRenderJob();
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
 
+      /// \brief Count an update that produced data.
+      /// \param[in] _start Wall time at which the update started.
+      private: void AddUpdateStats(const common::Time &_start);
+
       /// \brief Whether to enforce strict sensor update rate, even if physics
       ///        time has to slow down to wait for sensor updates to satisfy
       ///        the desired rate.
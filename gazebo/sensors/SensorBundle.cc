@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
+#include "gazebo/sensors/SensorBundle.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Private data for SensorBundle
+    class SensorBundlePrivate
+    {
+      /// \brief Scoped name of the model.
+      public: std::string model;
+
+      /// \brief Node of the publisher.
+      public: transport::NodePtr node;
+
+      /// \brief Publisher of the bundles.
+      public: transport::PublisherPtr pub;
+
+      /// \brief Protects msg and publishCount.
+      public: mutable std::mutex mutex;
+
+      /// \brief The held messages, all with the same time stamp.
+      public: msgs::SensorBundle msg;
+
+      /// \brief Number of published bundles.
+      public: uint64_t publishCount = 0;
+    };
+  }
+}
+
+/// \brief Protects the bundles of the models.
+static std::mutex g_bundlesMutex;
+
+/// \brief The bundles of the models, by world and model name.
+static std::map<std::pair<std::string, std::string>,
+    std::weak_ptr<SensorBundle>> g_bundles;
+
+//////////////////////////////////////////////////
+SensorBundle::SensorBundle(const std::string &_worldName,
+    const std::string &_model)
+  : dataPtr(new SensorBundlePrivate)
+{
+  this->dataPtr->model = _model;
+  this->dataPtr->msg.set_model(_model);
+  msgs::Set(this->dataPtr->msg.mutable_stamp(), common::Time::Zero);
+
+  std::string topic = "~/" + _model + "/sensor_bundle";
+  boost::replace_all(topic, "::", "/");
+
+  this->dataPtr->node = transport::NodePtr(new transport::Node());
+  this->dataPtr->node->Init(_worldName);
+  this->dataPtr->pub =
+      this->dataPtr->node->Advertise<msgs::SensorBundle>(topic, 50);
+}
+
+//////////////////////////////////////////////////
+SensorBundle::~SensorBundle()
+{
+  this->Flush();
+  this->dataPtr->pub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+}
+
+//////////////////////////////////////////////////
+SensorBundlePtr SensorBundle::Get(const std::string &_worldName,
+    const std::string &_model)
+{
+  std::lock_guard<std::mutex> lock(g_bundlesMutex);
+  std::weak_ptr<SensorBundle> &entry =
+      g_bundles[std::make_pair(_worldName, _model)];
+  SensorBundlePtr bundle = entry.lock();
+  if (!bundle)
+  {
+    bundle.reset(new SensorBundle(_worldName, _model));
+    entry = bundle;
+  }
+  return bundle;
+}
+
+//////////////////////////////////////////////////
+void SensorBundle::FlushAll()
+{
+  std::vector<SensorBundlePtr> bundles;
+  {
+    std::lock_guard<std::mutex> lock(g_bundlesMutex);
+    for (auto iter = g_bundles.begin(); iter != g_bundles.end();)
+    {
+      SensorBundlePtr bundle = iter->second.lock();
+      if (bundle)
+      {
+        bundles.push_back(bundle);
+        ++iter;
+      }
+      else
+        iter = g_bundles.erase(iter);
+    }
+  }
+
+  for (auto const &bundle : bundles)
+    bundle->Flush();
+}
+
+//////////////////////////////////////////////////
+void SensorBundle::Add(const std::string &_sensor,
+    const common::Time &_stamp, const google::protobuf::Message &_msg)
+{
+  if (!this->HasConnections())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // A message of another time stamp starts a new bundle
+  msgs::SensorBundle &msg = this->dataPtr->msg;
+  if (msg.entry_size() > 0 && msgs::Convert(msg.stamp()) != _stamp)
+  {
+    this->dataPtr->pub->Publish(msg);
+    ++this->dataPtr->publishCount;
+    msg.clear_entry();
+  }
+
+  msgs::Set(msg.mutable_stamp(), _stamp);
+  msgs::SensorBundle::Entry *entry = msg.add_entry();
+  entry->set_sensor(_sensor);
+  entry->set_type(_msg.GetTypeName());
+  _msg.SerializeToString(entry->mutable_data());
+}
+
+//////////////////////////////////////////////////
+void SensorBundle::Flush()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->msg.entry_size() == 0 || !this->dataPtr->pub)
+    return;
+
+  this->dataPtr->pub->Publish(this->dataPtr->msg);
+  ++this->dataPtr->publishCount;
+  this->dataPtr->msg.clear_entry();
+}
+
+//////////////////////////////////////////////////
+bool SensorBundle::HasConnections() const
+{
+  return this->dataPtr->pub && this->dataPtr->pub->HasConnections();
+}
+
+//////////////////////////////////////////////////
+std::string SensorBundle::Topic() const
+{
+  return this->dataPtr->pub ? this->dataPtr->pub->GetTopic() : "";
+}
+
+//////////////////////////////////////////////////
+uint64_t SensorBundle::PublishCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->publishCount;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_SENSORBUNDLE_HH_
+#define GAZEBO_SENSORS_SENSORBUNDLE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <google/protobuf/message.h>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/sensors/SensorTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declarations
+    class SensorBundlePrivate;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class SensorBundle SensorBundle.hh sensors/sensors.hh
+    /// \brief Publishes the messages of the bundled sensors of a model as
+    /// one msgs::SensorBundle per time stamp, on
+    /// ~/<model>/sensor_bundle.
+    ///
+    /// The messages are held until a message with another time stamp is
+    /// added, or until Flush() is called, which the SensorManager does
+    /// after each update of a sensor container. Sensors of different
+    /// containers, such as cameras and IMUs, are updated by different
+    /// threads, so their messages are bundled separately.
+    class GZ_SENSORS_VISIBLE SensorBundle
+    {
+      /// \brief Constructor
+      /// \param[in] _worldName Name of the world of the model.
+      /// \param[in] _model Scoped name of the model.
+      public: SensorBundle(const std::string &_worldName,
+                  const std::string &_model);
+
+      /// \brief Destructor. Publishes the held messages.
+      public: virtual ~SensorBundle();
+
+      /// \brief Get the bundle of a model, shared by its sensors.
+      /// \param[in] _worldName Name of the world of the model.
+      /// \param[in] _model Scoped name of the model.
+      /// \return The bundle, which lives as long as a sensor holds it.
+      public: static SensorBundlePtr Get(const std::string &_worldName,
+                  const std::string &_model);
+
+      /// \brief Publish the held messages of all the bundles.
+      public: static void FlushAll();
+
+      /// \brief Add the message of a sensor. It is dropped when nothing
+      /// subscribes to the bundle.
+      /// \param[in] _sensor Scoped name of the sensor.
+      /// \param[in] _stamp Time stamp of the message.
+      /// \param[in] _msg The message.
+      public: void Add(const std::string &_sensor,
+                  const common::Time &_stamp,
+                  const google::protobuf::Message &_msg);
+
+      /// \brief Publish the held messages.
+      public: void Flush();
+
+      /// \brief Get whether the bundle has subscribers.
+      /// \return True if the bundle topic has subscribers.
+      public: bool HasConnections() const;
+
+      /// \brief Get the topic of the bundle.
+      /// \return The topic, ~/<model>/sensor_bundle.
+      public: std::string Topic() const;
+
+      /// \brief Get the number of published bundles.
+      /// \return The number of messages published on the topic.
+      public: uint64_t PublishCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<SensorBundlePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+#include "gazebo/sensors/SensorBundle.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class SensorBundle_TEST : public ServerFixture
+{
+};
+
+/// \brief Protects g_bundles.
+std::mutex g_bundlesMutex;
+
+/// \brief Received bundles.
+std::vector<msgs::SensorBundle> g_bundles;
+
+/////////////////////////////////////////////////
+void ReceiveBundle(ConstSensorBundlePtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_bundlesMutex);
+  g_bundles.push_back(*_msg);
+}
+
+/////////////////////////////////////////////////
+/// \brief Wait for a number of bundles.
+/// \param[in] _count Number of bundles.
+/// \return True if the bundles were received in time.
+bool waitForBundles(const std::size_t _count)
+{
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_bundlesMutex);
+      if (g_bundles.size() >= _count)
+        return true;
+    }
+    common::Time::MSleep(20);
+  }
+  return false;
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorBundle_TEST, Group)
+{
+  Load("worlds/empty.world");
+
+  sensors::SensorBundlePtr bundle =
+      sensors::SensorBundle::Get("default", "robot::arm");
+  ASSERT_TRUE(bundle != nullptr);
+  EXPECT_EQ("/gazebo/default/robot/arm/sensor_bundle", bundle->Topic());
+  EXPECT_EQ(bundle, sensors::SensorBundle::Get("default", "robot::arm"));
+
+  // Nothing is bundled without a subscriber
+  msgs::Vector3d msg;
+  msgs::Set(&msg, ignition::math::Vector3d(1, 2, 3));
+  bundle->Add("a", common::Time(1), msg);
+  bundle->Flush();
+  EXPECT_EQ(0u, bundle->PublishCount());
+
+  g_bundles.clear();
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::SubscriberPtr sub =
+      node->Subscribe("~/robot/arm/sensor_bundle", &ReceiveBundle);
+  for (int i = 0; i < 100 && !bundle->HasConnections(); ++i)
+    common::Time::MSleep(20);
+  ASSERT_TRUE(bundle->HasConnections());
+
+  // The messages of a time stamp are published together
+  bundle->Add("a", common::Time(1), msg);
+  bundle->Add("b", common::Time(1), msg);
+  EXPECT_EQ(0u, bundle->PublishCount());
+  bundle->Add("a", common::Time(2), msg);
+  EXPECT_EQ(1u, bundle->PublishCount());
+  sensors::SensorBundle::FlushAll();
+  EXPECT_EQ(2u, bundle->PublishCount());
+
+  ASSERT_TRUE(waitForBundles(2));
+  std::lock_guard<std::mutex> lock(g_bundlesMutex);
+  EXPECT_EQ("robot::arm", g_bundles[0].model());
+  EXPECT_EQ(common::Time(1), msgs::Convert(g_bundles[0].stamp()));
+  ASSERT_EQ(2, g_bundles[0].entry_size());
+  EXPECT_EQ("a", g_bundles[0].entry(0).sensor());
+  EXPECT_EQ("b", g_bundles[0].entry(1).sensor());
+  EXPECT_EQ(msg.GetTypeName(), g_bundles[0].entry(1).type());
+
+  msgs::Vector3d data;
+  EXPECT_TRUE(data.ParseFromString(g_bundles[0].entry(1).data()));
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3), msgs::ConvertIgn(data));
+
+  EXPECT_EQ(common::Time(2), msgs::Convert(g_bundles[1].stamp()));
+  EXPECT_EQ(1, g_bundles[1].entry_size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorBundle_TEST, Sensor)
+{
+  Load("worlds/ray_test.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  sensors::SensorPtr imu =
+      mgr->GetSensor("default::box_model::box_link::box_imu_sensor");
+  ASSERT_TRUE(imu != nullptr);
+  EXPECT_FALSE(imu->Bundled());
+
+  g_bundles.clear();
+  imu->SetBundled(true);
+  EXPECT_TRUE(imu->Bundled());
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::SubscriberPtr sub =
+      node->Subscribe("~/box_model/sensor_bundle", &ReceiveBundle);
+
+  // The bundle topic is a consumer of the sensor
+  for (int i = 0; i < 100 && !imu->HasConsumers(); ++i)
+    common::Time::MSleep(20);
+  EXPECT_TRUE(imu->HasConsumers());
+
+  ASSERT_TRUE(waitForBundles(1));
+  std::lock_guard<std::mutex> lock(g_bundlesMutex);
+  EXPECT_EQ("box_model", g_bundles[0].model());
+  ASSERT_GE(g_bundles[0].entry_size(), 1);
+  EXPECT_EQ(imu->ScopedName(), g_bundles[0].entry(0).sensor());
+  EXPECT_EQ("gazebo.msgs.IMU", g_bundles[0].entry(0).type());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
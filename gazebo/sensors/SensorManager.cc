@@ -18,16 +18,20 @@
 #include <functional>
 #include <boost/bind.hpp>
 
+#include "gazebo/common/IterationProfiler.hh"
+#include "gazebo/common/StartupProfiler.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
-#include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/rendering/Camera.hh"
 #include "gazebo/sensors/CameraSensor.hh"
+#include "gazebo/sensors/RenderJobQueue.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorFactory.hh"
+#include "gazebo/sensors/SensorBundle.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/sensors/SensorsIface.hh"
 #include "gazebo/transport/transport.hh"
@@ -299,11 +303,17 @@ void SensorManager::Update(bool _force)
   {
     boost::recursive_mutex::scoped_lock lock(this->mutex);
 
-    if (this->worlds.empty() && physics::worlds_running() && this->initialized)
+    // Register the worlds without sensors, so that they load their
+    // plugins. There may be several worlds in the process.
+    if (physics::worlds_running() && this->initialized)
     {
-      auto world = physics::get_world();
-      this->worlds[world->Name()] = world;
-      world->_SetSensorsInitialized(true);
+      for (auto const &world : physics::get_worlds())
+      {
+        if (this->worlds.find(world->Name()) != this->worlds.end())
+          continue;
+        this->worlds[world->Name()] = world;
+        world->_SetSensorsInitialized(true);
+      }
     }
 
     if (!this->initSensors.empty())
@@ -317,7 +327,11 @@ void SensorManager::Update(bool _force)
         GZ_ASSERT(this->sensorContainers[sensor->Category()] != nullptr,
             "Sensor container is null");
 
-        sensor->Init();
+        {
+          common::StartupScope startupScope("Sensor::Init",
+              sensor->ScopedName());
+          sensor->Init();
+        }
         this->sensorContainers[sensor->Category()]->AddSensor(sensor);
       }
       this->initSensors.clear();
@@ -390,6 +404,33 @@ void SensorManager::ResetLastUpdateTimes()
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::WakeUpSensors()
+{
+  // The containers are created with the manager, so they can be walked
+  // without the manager's mutex, which a sensor thread may be waiting for.
+  for (auto &container : this->sensorContainers)
+    container->WakeUp();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::SetLazySensors(const bool _lazy,
+    const common::Time &_warmup)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+  this->lazySensors = _lazy;
+  this->lazyWarmup = _warmup;
+
+  Sensor_V sensors = this->GetSensors();
+  sensors.insert(sensors.end(), this->initSensors.begin(),
+      this->initSensors.end());
+  for (auto &sensor : sensors)
+  {
+    sensor->SetLazy(_lazy);
+    sensor->SetLazyWarmup(_warmup);
+  }
+}
+
 //////////////////////////////////////////////////
 double SensorManager::NextRequiredTimestamp()
 {
@@ -500,6 +541,12 @@ std::string SensorManager::CreateSensor(sdf::ElementPtr _elem,
   // Must come before sensor->Load
   sensor->SetParent(_parentName, _parentId);
 
+  {
+    boost::recursive_mutex::scoped_lock lock(this->mutex);
+    sensor->SetLazy(this->lazySensors);
+    sensor->SetLazyWarmup(this->lazyWarmup);
+  }
+
   // Load the sensor
   sensor->Load(_worldName, _elem);
   this->worlds[_worldName] = physics::get_world(_worldName);
@@ -708,6 +755,22 @@ void SensorManager::SensorContainer::Stop()
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::WakeUp()
+{
+  // Lock the timing mutex, so that the notification can't slip in between
+  // the run loop scheduling its next update and waiting for it.
+  boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
+
+  // The run loop schedules a new event once it wakes up, so drop the one
+  // it was waiting for.
+  SimTimeEventHandler *handler = SensorManager::Instance()->simTimeEventHandler;
+  if (handler)
+    handler->RemoveEvents(&this->runCondition);
+
+  this->runCondition.notify_all();
+}
+
 //////////////////////////////////////////////////
 bool SensorManager::SensorContainer::Running() const
 {
@@ -717,24 +780,9 @@ bool SensorManager::SensorContainer::Running() const
 //////////////////////////////////////////////////
 void SensorManager::SensorContainer::RunLoop()
 {
+  common::ThreadConfig::Instance()->Apply("sensors");
   this->stop = false;
 
-  physics::WorldPtr world = physics::get_world();
-  GZ_ASSERT(world != nullptr, "Pointer to World is null");
-
-  physics::PhysicsEnginePtr engine = world->Physics();
-  GZ_ASSERT(engine != nullptr, "Pointer to PhysicsEngine is null");
-
-  engine->InitForThread();
-
-  // The original value was hardcode to 1.0. Changed the value to
-  // 1000 * MaxStepSize in order to handle simulation with a
-  // large step size.
-  double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
-
-  // Release engine pointer, we don't need it in the loop
-  engine.reset();
-
   common::Time sleepTime, startTime, eventTime, diffTime;
   double maxUpdateRate = 0;
 
@@ -750,6 +798,25 @@ void SensorManager::SensorContainer::RunLoop()
       return;
   }
 
+  // The sensors are paced on the sim time of their own world, which is
+  // not the first world when a server runs several worlds.
+  common::Time nextUpdateTime;
+  physics::WorldPtr world = this->NextUpdateWorld(nextUpdateTime);
+  GZ_ASSERT(world != nullptr, "Pointer to World is null");
+
+  physics::PhysicsEnginePtr engine = world->Physics();
+  GZ_ASSERT(engine != nullptr, "Pointer to PhysicsEngine is null");
+
+  engine->InitForThread();
+
+  // The original value was hardcode to 1.0. Changed the value to
+  // 1000 * MaxStepSize in order to handle simulation with a
+  // large step size.
+  double maxSensorUpdate = engine->GetMaxStepSize() * 1000;
+
+  // Release engine pointer, we don't need it in the loop
+  engine.reset();
+
 
   auto computeMaxUpdateRate = [&]()
   {
@@ -783,7 +850,7 @@ void SensorManager::SensorContainer::RunLoop()
 
   while (!this->stop)
   {
-    IGN_PROFILE("SensorManager::RunLoop");
+    GZ_PROFILE("SensorManager::RunLoop");
 
     // If all the sensors get deleted, wait here.
     // Use a while loop since world resets will notify the runCondition.
@@ -799,9 +866,9 @@ void SensorManager::SensorContainer::RunLoop()
     // Get the start time of the update.
     startTime = world->SimTime();
 
-    IGN_PROFILE_BEGIN("UpdateSensors");
+    GZ_PROFILE_BEGIN("UpdateSensors");
     this->Update(false);
-    IGN_PROFILE_END();
+    GZ_PROFILE_END();
 
     // Compute the time it took to update the sensors.
     // It's possible that the world time was reset during the Update. This
@@ -821,6 +888,19 @@ void SensorManager::SensorContainer::RunLoop()
         << "This warning can be ignored during log playback" << std::endl;
     }
 
+    // Don't wake up before the next active sensor is due. This skips the
+    // wakeups at the fastest update rate when the fastest sensors are
+    // inactive or when the sensors run at different rates. The sensors
+    // may belong to several worlds, so wait on the world of the sensor
+    // that is due first.
+    physics::WorldPtr nextWorld = this->NextUpdateWorld(nextUpdateTime);
+    if (nextWorld)
+      world = nextWorld;
+    if (nextUpdateTime != common::Time::Maximum())
+    {
+      eventTime = std::max(eventTime, nextUpdateTime - world->SimTime());
+    }
+
     // Make sure eventTime is not negative.
     if (eventTime < common::Time::Zero)
     {
@@ -833,15 +913,15 @@ void SensorManager::SensorContainer::RunLoop()
     // Add an event to trigger when the appropriate simulation time has been
     // reached.
     SensorManager::Instance()->simTimeEventHandler->AddRelativeEvent(
-        eventTime, &this->runCondition);
+        world->Name(), eventTime, &this->runCondition);
 
     // This if statement helps prevent deadlock on osx during teardown.
-    IGN_PROFILE_BEGIN("Sleeping");
+    GZ_PROFILE_BEGIN("Sleeping");
     if (!this->stop)
     {
       this->runCondition.wait(timingLock);
     }
-    IGN_PROFILE_END();
+    GZ_PROFILE_END();
   }
 }
 
@@ -860,10 +940,71 @@ void SensorManager::SensorContainer::Update(bool _force)
        iter != this->sensors.end(); ++iter)
   {
     GZ_ASSERT((*iter) != nullptr, "Sensor is null");
-    IGN_PROFILE_BEGIN((*iter)->Name().c_str());
+    GZ_PROFILE_BEGIN((*iter)->Name().c_str());
     (*iter)->Update(_force);
-    IGN_PROFILE_END();
+    GZ_PROFILE_END();
   }
+
+  // Publish the messages of the bundled sensors of this update
+  SensorBundle::FlushAll();
+}
+
+//////////////////////////////////////////////////
+physics::WorldPtr SensorManager::SensorContainer::NextUpdateWorld(
+    common::Time &_nextUpdateTime) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  _nextUpdateTime = common::Time::Maximum();
+  physics::WorldPtr result;
+
+  // Sim time left until the sensor that is due first. The sensors of
+  // different worlds are compared by it, since their worlds may be at
+  // different sim times.
+  common::Time wait = common::Time::Maximum();
+
+  std::string worldName;
+  physics::WorldPtr world;
+  for (auto const &sensor : this->sensors)
+  {
+    // The sensors of a world are usually next to each other.
+    const std::string name = sensor->WorldName();
+    if (!world || name != worldName)
+    {
+      worldName = name;
+      world = physics::has_world(name) ? physics::get_world(name) : nullptr;
+    }
+
+    if (!world)
+      continue;
+
+    if (!result)
+      result = world;
+
+    if (!sensor->IsActive())
+      continue;
+
+    // Strict rate sensors and sensors without an update rate are stepped
+    // with the world.
+    if (sensor->StrictRate() || sensor->UpdateRate() <= 0)
+    {
+      _nextUpdateTime = common::Time::Zero;
+      return world;
+    }
+
+    const common::Time nextUpdateTime = sensor->NextUpdateTime();
+    const common::Time simTime = world->SimTime();
+    const common::Time left = nextUpdateTime > simTime ?
+        nextUpdateTime - simTime : common::Time::Zero;
+    if (left < wait)
+    {
+      wait = left;
+      _nextUpdateTime = nextUpdateTime;
+      result = world;
+    }
+  }
+
+  return result;
 }
 
 //////////////////////////////////////////////////
@@ -976,6 +1117,14 @@ void SensorManager::SensorContainer::RemoveSensors()
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
+  // Skip the render passes until a sensor is due, so that all the sensors
+  // due at the same time share a single prerender pass and frame.
+  if (!this->RenderNeeded(_force))
+  {
+    this->conditionPrerendered.notify_all();
+    return;
+  }
+
   // Prerender phase
   event::Events::preRender();
 
@@ -985,15 +1134,42 @@ void SensorManager::ImageSensorContainer::Update(bool _force)
   // Notify that prerender is over
   this->conditionPrerendered.notify_all();
 
-  // Tell all the cameras to render
+  // Render the cameras of plugins
   event::Events::render();
 
+  // Render the sensors from the scene committed by the prerender phase,
+  // timing critical sensors first. Each sensor publishes right after its
+  // pass.
+  common::Time simTime = common::Time::Maximum();
+  common::Time nextUpdateTime;
+  physics::WorldPtr world = this->NextUpdateWorld(nextUpdateTime);
+  if (physics::worlds_running() && world)
+    simTime = world->SimTime();
+  RenderJobQueue::Instance()->Run(simTime, _force);
+
   event::Events::postRender();
 
-  // Update the sensors, which will produce data messages.
+  // Update the other sensors, which will produce data messages.
   SensorContainer::Update(_force);
 }
 
+//////////////////////////////////////////////////
+bool SensorManager::ImageSensorContainer::RenderNeeded(const bool _force) const
+{
+  // Keep rendering every iteration when there are no sensors, since
+  // plugins may render their own cameras on the render events.
+  common::Time nextUpdateTime;
+  physics::WorldPtr world = this->NextUpdateWorld(nextUpdateTime);
+  if (_force || !world || !physics::worlds_running())
+    return true;
+
+  // No active sensors.
+  if (nextUpdateTime == common::Time::Maximum())
+    return false;
+
+  return nextUpdateTime <= world->SimTime();
+}
+
 //////////////////////////////////////////////////
 bool SensorManager::ImageSensorContainer::WaitForPrerendered(double _timeoutsec)
 {
@@ -1028,21 +1204,52 @@ SimTimeEventHandler::~SimTimeEventHandler()
 /////////////////////////////////////////////////
 void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
                                            boost::condition_variable *_var)
+{
+  physics::WorldPtr world = physics::get_world();
+  GZ_ASSERT(world != nullptr, "World pointer is null");
+
+  this->AddRelativeEvent(world->Name(), _time, _var);
+}
+
+/////////////////////////////////////////////////
+void SimTimeEventHandler::AddRelativeEvent(const std::string &_worldName,
+    const common::Time &_time, boost::condition_variable *_var)
 {
   boost::mutex::scoped_lock lock(this->mutex);
 
-  physics::WorldPtr world = physics::get_world();
+  physics::WorldPtr world = physics::get_world(_worldName);
   GZ_ASSERT(world != nullptr, "World pointer is null");
 
   // Create the new event.
   SimTimeEvent *event = new SimTimeEvent;
   event->time = world->SimTime() + _time;
   event->condition = _var;
+  event->worldName = _worldName;
 
   // Add the event to the list.
   this->events.push_back(event);
 }
 
+/////////////////////////////////////////////////
+void SimTimeEventHandler::RemoveEvents(boost::condition_variable *_var)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
+      iter != this->events.end();)
+  {
+    GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
+
+    if ((*iter)->condition == _var)
+    {
+      delete *iter;
+      this->events.erase(iter++);
+    }
+    else
+      ++iter;
+  }
+}
+
 /////////////////////////////////////////////////
 void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
 {
@@ -1055,6 +1262,13 @@ void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
   {
     GZ_ASSERT(*iter != nullptr, "SimTimeEvent is null");
 
+    // Each world fires the update event with its own sim time.
+    if (!(*iter)->worldName.empty() && (*iter)->worldName != _info.worldName)
+    {
+      ++iter;
+      continue;
+    }
+
     // Find events that have a time less than or equal to simulation
     // time.
     if ((*iter)->time <= _info.simTime)
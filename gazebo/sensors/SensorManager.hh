@@ -51,6 +51,10 @@ namespace gazebo
 
       /// \brief The condition to notify.
       public: boost::condition_variable *condition;
+
+      /// \brief Name of the world whose sim time triggers the condition,
+      /// empty for any world.
+      public: std::string worldName;
     };
 
     /// \brief Monitors simulation time, and notifies conditions when
@@ -71,6 +75,21 @@ namespace gazebo
       public: void AddRelativeEvent(const common::Time &_time,
                   boost::condition_variable *_var);
 
+      /// \brief Add a new event to the handler, triggered by the sim time
+      /// of a given world.
+      /// \param[in] _worldName Name of the world.
+      /// \param[in] _time Time of the new event. The current sim time of
+      /// the world will be add to this time.
+      /// \param[in] _var Condition to notify when the time has been
+      /// reached.
+      public: void AddRelativeEvent(const std::string &_worldName,
+                  const common::Time &_time,
+                  boost::condition_variable *_var);
+
+      /// \brief Remove the events that would notify a condition.
+      /// \param[in] _var Condition of the events to remove.
+      public: void RemoveEvents(boost::condition_variable *_var);
+
       /// \brief Called when the world is updated.
       /// \param[in] _info Update timing information.
       private: void OnUpdate(const common::UpdateInfo &_info);
@@ -179,6 +198,18 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Wake up the sensor threads, so that they reschedule their
+      /// next update. Called when a sensor becomes active.
+      public: void WakeUpSensors();
+
+      /// \brief Make all the sensors lazy or not, including the sensors
+      /// created afterwards.
+      /// \param[in] _lazy True to suspend the sensors while unobserved.
+      /// \param[in] _warmup Warm-up of the sensors when they get observed.
+      /// \sa Sensor::SetLazy
+      public: void SetLazySensors(const bool _lazy,
+                  const common::Time &_warmup = common::Time::Zero);
+
       /// \brief Block until all sensors do not need current world tick
       /// \param[in] _clk simulated clock of the world
       /// \param[in] _dt world time step
@@ -219,6 +250,10 @@ namespace gazebo
                  /// \brief Stop the run thread.
                  public: void Stop();
 
+                 /// \brief Wake up the run thread, so that it reschedules
+                 /// its next update.
+                 public: void WakeUp();
+
                  /// \brief Get whether running or stopped.
                  /// \return True if running.
                  public: bool Running() const;
@@ -251,6 +286,21 @@ namespace gazebo
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
+                 /// \brief Get the world of the active sensor that is due
+                 /// first for an update. The sensors of a container may
+                 /// belong to several worlds, and each sensor is due at a
+                 /// sim time of its own world.
+                 /// \param[out] _nextUpdateTime Sim time of that world at
+                 /// which the sensor is due, or common::Time::Maximum() if
+                 /// no active sensor has a fixed update rate.
+                 /// common::Time::Zero if a sensor must be updated on
+                 /// every iteration.
+                 /// \return The world, the world of the first sensor if no
+                 /// sensor is due, or nullptr if there are no sensors or
+                 /// their world isn't loaded.
+                 public: physics::WorldPtr NextUpdateWorld(
+                             common::Time &_nextUpdateTime) const;
+
                  /// \brief A loop to update the sensor. Used by the
                  /// runThread.
                  private: void RunLoop();
@@ -269,7 +319,7 @@ namespace gazebo
                  private: boost::thread *runThread;
 
                  /// \brief A mutex to manage access to the sensors vector.
-                 private: mutable boost::recursive_mutex mutex;
+                 protected: mutable boost::recursive_mutex mutex;
 
                  /// \brief Condition used to block the RunLoop if no
                  /// sensors are present.
@@ -292,6 +342,13 @@ namespace gazebo
                  /// even if they are not active.
                  public: virtual void Update(bool _force = false);
 
+                 /// \brief Check whether any image sensor is due to render
+                 /// this iteration. The prerender pass, which updates every
+                 /// scene, is only run for iterations that render sensors.
+                 /// \param[in] _force True if sensors are forced to update.
+                 /// \return True if the render passes should run.
+                 private: bool RenderNeeded(const bool _force) const;
+
                  /// \brief used to wait for the end of prerendering
                  private: std::condition_variable conditionPrerendered;
                };
@@ -304,6 +361,12 @@ namespace gazebo
       /// \brief True removes all sensors from all sensor containers.
       private: bool removeAllSensors;
 
+      /// \brief True if the sensors are lazy.
+      private: bool lazySensors = false;
+
+      /// \brief Warm-up of the lazy sensors.
+      private: common::Time lazyWarmup;
+
       /// \brief Mutex used when adding and removing sensors.
       private: mutable boost::recursive_mutex mutex;
 
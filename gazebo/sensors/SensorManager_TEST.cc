@@ -16,6 +16,7 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/test/ServerFixture.hh"
@@ -159,6 +160,109 @@ TEST_F(SensorManager_TEST, InitRemove)
   printf("Done done\n");
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that a reactivated sensor is updated at its own rate, even
+/// though its thread was waiting for the other sensors.
+TEST_F(SensorManager_TEST, Reactivate)
+{
+  Load("worlds/test_camera_laser.world", true);
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  sensors::SensorPtr laser1 = mgr->GetSensor("default::laser_1::link::laser");
+  sensors::SensorPtr laser2 = mgr->GetSensor("default::laser_2::link::laser");
+  ASSERT_TRUE(laser1 != nullptr);
+  ASSERT_TRUE(laser2 != nullptr);
+  world->Step(100);
+  common::Time::MSleep(100);
+
+  // Inactive sensors aren't updated
+  laser1->SetActive(false);
+  laser2->SetActive(false);
+  common::Time::MSleep(100);
+  const common::Time last = laser1->LastMeasurementTime();
+  const common::Time last2 = laser2->LastMeasurementTime();
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    world->Step(10);
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(last, laser1->LastMeasurementTime());
+
+  // The ray sensor thread has no sensor to wait for, it must be woken up
+  // when the sensor is activated again.
+  const common::Time activated = world->SimTime();
+  laser1->SetActive(true);
+  int sleep = 0;
+  while (laser1->LastMeasurementTime() <= activated && sleep++ < 200)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_LT(sleep, 200);
+  EXPECT_LT(laser1->LastMeasurementTime() - activated, common::Time(0.2));
+  EXPECT_EQ(last2, laser2->LastMeasurementTime());
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of prerender events.
+std::atomic<int> g_preRenders(0);
+
+/////////////////////////////////////////////////
+/// \brief Count the prerender events.
+void onPreRender()
+{
+  ++g_preRenders;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that the render passes only run when a camera is due.
+TEST_F(SensorManager_TEST, RenderWhenDue)
+{
+  Load("worlds/test_camera_laser.world", true);
+  physics::WorldPtr world = physics::get_world();
+  ASSERT_TRUE(world != nullptr);
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  sensors::SensorPtr camera1 =
+      mgr->GetSensor("default::camera_1::link::camera");
+  sensors::SensorPtr camera2 =
+      mgr->GetSensor("default::camera_2::link::camera");
+  ASSERT_TRUE(camera1 != nullptr);
+  ASSERT_TRUE(camera2 != nullptr);
+
+  event::ConnectionPtr connection =
+      event::Events::ConnectPreRender(&onPreRender);
+
+  // No camera is due, so nothing renders.
+  camera1->SetActive(false);
+  camera2->SetActive(false);
+  world->Step(100);
+  common::Time::MSleep(500);
+  g_preRenders = 0;
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    world->Step(10);
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(0, g_preRenders);
+
+  // The cameras render once they are active again.
+  camera1->SetActive(true);
+  camera2->SetActive(true);
+  const common::Time activated = world->SimTime();
+  int sleep = 0;
+  while ((camera1->LastMeasurementTime() <= activated ||
+          camera2->LastMeasurementTime() <= activated) && sleep++ < 200)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_LT(sleep, 200);
+  EXPECT_GT(g_preRenders, 0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
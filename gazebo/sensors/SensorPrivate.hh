@@ -24,6 +24,7 @@
 
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/sensors/RenderJobQueue.hh"
 #include "gazebo/sensors/SensorTypes.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -51,6 +52,49 @@ namespace gazebo
       /// \brief The sensors unique ID.
       public: uint32_t id;
 
+      /// \brief Protects updateCount and updateWallTime.
+      public: std::mutex mutexUpdateStats;
+
+      /// \brief Number of updates that produced data.
+      public: uint64_t updateCount = 0;
+
+      /// \brief Total wall time of the updates that produced data.
+      public: common::Time updateWallTime;
+
+      /// \brief True if the sensor is suspended while unobserved.
+      public: bool lazy = false;
+
+      /// \brief How long a lazy sensor keeps updating once observed.
+      public: common::Time lazyWarmup;
+
+      /// \brief Protects observed and warmupEnd.
+      public: std::mutex mutexLazy;
+
+      /// \brief True if the sensor had a consumer the last time it was
+      /// checked.
+      public: bool observed = false;
+
+      /// \brief Simulation time at which the current warm-up ends.
+      public: common::Time warmupEnd;
+
+      /// \brief Protects bundle.
+      public: mutable std::mutex mutexBundle;
+
+      /// \brief Bundle of the model of the sensor, null if the sensor
+      /// isn't bundled.
+      public: SensorBundlePtr bundle;
+
+      /// \brief True if the sensor is bundled once it is loaded.
+      public: bool bundled = false;
+
+      /// \brief Render pass of a rendering sensor, without a render
+      /// function for other sensors.
+      public: RenderJobQueue::Job renderJob;
+
+      /// \brief Identifier of the render job in the queue, 0 if it isn't
+      /// queued.
+      public: unsigned int renderJobId = 0;
+
       /// \brief An SDF pointer that allows us to only read the sensor.sdf
       /// file once, which in turns limits disk reads.
       public: static sdf::ElementPtr sdfSensor;
@@ -33,6 +33,7 @@ namespace gazebo
   {
     class AltimeterSensor;
     class Sensor;
+    class SensorBundle;
     class RaySensor;
     class CameraSensor;
     class LogicalCameraSensor;
@@ -63,6 +64,10 @@ namespace gazebo
     /// \brief Shared pointer to Sensor
     typedef std::shared_ptr<Sensor> SensorPtr;
 
+    /// \def SensorBundlePtr
+    /// \brief Shared pointer to SensorBundle
+    typedef std::shared_ptr<SensorBundle> SensorBundlePtr;
+
     /// \def RaySensorPtr
     /// \brief Shared pointer to RaySensor
     typedef std::shared_ptr<RaySensor> RaySensorPtr;
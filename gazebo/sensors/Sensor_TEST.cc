@@ -207,6 +207,60 @@ TEST_F(Sensor_TEST, SetPose)
   EXPECT_EQ(sensor.Pose(), ignition::math::Pose3d(0, 1, 2, 3, 4, 5));
 }
 
+/////////////////////////////////////////////////
+/// \brief A lazy sensor is only active while observed, or warming up
+TEST_F(Sensor_TEST, Lazy)
+{
+  sensors::Sensor sensor(gazebo::sensors::OTHER);
+  sensor.SetActive(true);
+  EXPECT_FALSE(sensor.Lazy());
+  EXPECT_FALSE(sensor.HasConsumers());
+  EXPECT_TRUE(sensor.IsActive());
+
+  sensor.SetLazy(true);
+  EXPECT_TRUE(sensor.Lazy());
+  EXPECT_FALSE(sensor.IsActive());
+
+  event::ConnectionPtr connection = sensor.ConnectUpdated([]() {});
+  EXPECT_TRUE(sensor.HasConsumers());
+  EXPECT_TRUE(sensor.IsActive());
+
+  connection.reset();
+  EXPECT_FALSE(sensor.HasConsumers());
+  EXPECT_FALSE(sensor.IsActive());
+
+  // Without a world the simulation time stays at zero, so the warm-up of
+  // the next observation never ends
+  sensor.SetLazyWarmup(common::Time(0.5));
+  EXPECT_EQ(common::Time(0.5), sensor.LazyWarmup());
+  connection = sensor.ConnectUpdated([]() {});
+  EXPECT_TRUE(sensor.IsActive());
+  connection.reset();
+  EXPECT_TRUE(sensor.IsActive());
+
+  // An inactive sensor stays inactive
+  sensor.SetActive(false);
+  EXPECT_FALSE(sensor.IsActive());
+}
+
+/////////////////////////////////////////////////
+/// \brief A sensor that didn't update has no update stats
+TEST_F(Sensor_TEST, UpdateStats)
+{
+  sensors::Sensor sensor(gazebo::sensors::OTHER);
+  EXPECT_EQ(0u, sensor.UpdateCount());
+  EXPECT_EQ(common::Time::Zero, sensor.UpdateWallTime());
+
+  // Inactive sensors don't update
+  sensor.SetActive(false);
+  sensor.Update(false);
+  EXPECT_EQ(0u, sensor.UpdateCount());
+
+  sensor.ResetUpdateStats();
+  EXPECT_EQ(0u, sensor.UpdateCount());
+  EXPECT_EQ(common::Time::Zero, sensor.UpdateWallTime());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
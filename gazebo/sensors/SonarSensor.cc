@@ -14,17 +14,22 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 
 #include <ignition/common/Profiler.hh>
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/physics/World.hh"
-#include "gazebo/physics/SurfaceParams.hh"
-#include "gazebo/physics/MeshShape.hh"
+#include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
-#include "gazebo/physics/ContactManager.hh"
-#include "gazebo/physics/Collision.hh"
+#include "gazebo/physics/RayShape.hh"
 
 #include "gazebo/common/Assert.hh"
 
@@ -40,22 +45,48 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("sonar", SonarSensor)
 
+/// \brief Number of rings of rays around the axis of a cone. Ring k has
+/// 6k rays, which gives 37 rays with the center one.
+static const unsigned int kConeRings = 3;
+
+/// \brief Number of rays that sample a sphere.
+static const unsigned int kSphereRays = 64;
+
+/////////////////////////////////////////////////
+/// \brief Distance along a ray from its origin to the side of a box.
+/// \param[in] _box The box.
+/// \param[in] _origin Origin of the ray.
+/// \param[in] _dir Unit direction of the ray.
+/// \return The distance, or 0 if the origin is outside the box.
+static double exitDistance(const ignition::math::AxisAlignedBox &_box,
+    const ignition::math::Vector3d &_origin,
+    const ignition::math::Vector3d &_dir)
+{
+  if (!_box.Contains(_origin))
+    return 0;
+
+  double dist = std::numeric_limits<double>::max();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    if (_dir[i] > 0)
+      dist = std::min(dist, (_box.Max()[i] - _origin[i]) / _dir[i]);
+    else if (_dir[i] < 0)
+      dist = std::min(dist, (_box.Min()[i] - _origin[i]) / _dir[i]);
+  }
+  return dist;
+}
+
 //////////////////////////////////////////////////
 SonarSensor::SonarSensor()
 : Sensor(sensors::OTHER),
   dataPtr(new SonarSensorPrivate)
 {
-  this->dataPtr->emptyContactCount = 0;
 }
 
 //////////////////////////////////////////////////
 SonarSensor::~SonarSensor()
 {
-  this->dataPtr->sonarCollision->Fini();
-  this->dataPtr->sonarCollision.reset();
-
-  this->dataPtr->sonarShape->Fini();
-  this->dataPtr->sonarShape.reset();
+  this->dataPtr->rays.reset();
 }
 
 //////////////////////////////////////////////////
@@ -83,7 +114,6 @@ void SonarSensor::Load(const std::string &_worldName)
   this->dataPtr->radius = sonarElem->Get<double>("radius");
   const std::string geometry =
       sonarElem->GetElement("geometry")->Get<std::string>();
-  double range = this->dataPtr->rangeMax - this->dataPtr->rangeMin;
 
   if (this->dataPtr->radius < 0 && geometry == "cone")
   {
@@ -122,38 +152,35 @@ void SonarSensor::Load(const std::string &_worldName)
   GZ_ASSERT(physicsEngine != nullptr,
       "Unable to get a pointer to the physics engine");
 
-  /// \todo: Change the collision shape to a cone. Needs a collision shape
-  /// within ODE. Or, switch out the collision engine.
-  this->dataPtr->sonarCollision = physicsEngine->CreateCollision("mesh",
-      this->ParentName());
-
-  GZ_ASSERT(this->dataPtr->sonarCollision != nullptr,
-      "Unable to create a cylinder collision using the physics engine.");
-
-  this->dataPtr->sonarCollision->SetName(this->ScopedName() +
-      "sensor_collision");
-
-  // We need a few contacts in order to get the closest collision. This is
-  // not guaranteed to return the closest contact.
-  this->dataPtr->sonarCollision->SetMaxContacts(2);
-  this->dataPtr->sonarCollision->AddType(physics::Base::SENSOR_COLLISION);
-  this->dataPtr->parentEntity->AddChild(this->dataPtr->sonarCollision);
-
-  this->dataPtr->sonarShape = boost::dynamic_pointer_cast<physics::MeshShape>(
-      this->dataPtr->sonarCollision->GetShape());
+  // Standalone rays aren't part of the world, so the sonar costs nothing
+  // to the physics engine between two updates. Only ODE can cast them all
+  // at once, the sonar always reports its maximum range with the others.
+  if (physicsEngine->GetType() == "ode")
+  {
+    this->dataPtr->rays = boost::dynamic_pointer_cast<physics::MultiRayShape>(
+        physicsEngine->CreateShape("multiray", physics::CollisionPtr()));
 
-  GZ_ASSERT(this->dataPtr->sonarShape != nullptr,
-      "Unable to get the sonar shape from the sonar collision.");
+    GZ_ASSERT(this->dataPtr->rays != nullptr,
+        "Unable to create a multiray shape using the physics engine.");
+  }
+  else
+  {
+    gzwarn << "Sonar range sensing only works in ODE, issue #1038\n";
+  }
 
+  // The sonar looks along the -Z axis of its frame.
+  this->dataPtr->directions.clear();
   if (geometry == "sphere")
   {
-    // Use a scaled sphere mesh for the sonar collision shape.
-    this->dataPtr->sonarShape->SetMesh("unit_sphere");
-
-    // Range is radius, scale is diameter
-    this->dataPtr->sonarShape->SetScale(
-        ignition::math::Vector3d(range*2, range*2, range*2));
-    this->dataPtr->sonarMidPose = this->pose;
+    // Fibonacci lattice, which spreads the rays evenly
+    const double goldenAngle = IGN_PI * (3.0 - std::sqrt(5.0));
+    for (unsigned int i = 0; i < kSphereRays; ++i)
+    {
+      const double z = 1.0 - 2.0 * (i + 0.5) / kSphereRays;
+      const double r = std::sqrt(1.0 - z * z);
+      this->dataPtr->directions.push_back(ignition::math::Vector3d(
+          r * std::cos(i * goldenAngle), r * std::sin(i * goldenAngle), z));
+    }
   }
   else
   {
@@ -163,44 +190,31 @@ void SonarSensor::Load(const std::string &_worldName)
             << "]. Defaults to cone." << std::endl;
     }
 
-    // Use a scaled cone mesh for the sonar collision shape.
-    this->dataPtr->sonarShape->SetMesh("unit_cone");
-    this->dataPtr->sonarShape->SetScale(ignition::math::Vector3d(
-        this->dataPtr->radius*2.0, this->dataPtr->radius*2.0, range));
-
-    // Position the collision shape properly. Without this, the shape will be
-    // centered at the start of the sonar.
-    const auto offset = this->pose.Rot().RotateVector({0, 0, range * 0.5});
-    this->dataPtr->sonarMidPose.Set(this->pose.Pos() - offset,
-        this->pose.Rot());
+    // Rings of rays around the axis, out to the radius at maximum range
+    const double halfAngle =
+        std::atan2(this->dataPtr->radius, this->dataPtr->rangeMax);
+    this->dataPtr->directions.push_back(-ignition::math::Vector3d::UnitZ);
+    for (unsigned int k = 1; k <= kConeRings; ++k)
+    {
+      const double theta = halfAngle * k / kConeRings;
+      const unsigned int count = 6 * k;
+      for (unsigned int j = 0; j < count; ++j)
+      {
+        const double phi = 2.0 * IGN_PI * j / count;
+        this->dataPtr->directions.push_back(ignition::math::Vector3d(
+            std::sin(theta) * std::cos(phi),
+            std::sin(theta) * std::sin(phi),
+            -std::cos(theta)));
+      }
+    }
   }
 
-  this->dataPtr->sonarCollision->SetRelativePose(this->dataPtr->sonarMidPose);
-  this->dataPtr->sonarCollision->SetInitialRelativePose(
-      this->dataPtr->sonarMidPose);
-
-  // Don't create contacts when objects collide with the sonar shape
-  this->dataPtr->sonarCollision->GetSurface()->collideWithoutContact = true;
-  this->dataPtr->sonarCollision->GetSurface()->collideWithoutContactBitmask = 1;
-  this->dataPtr->sonarCollision->SetCollideBits(~GZ_SENSOR_COLLIDE);
-  this->dataPtr->sonarCollision->SetCategoryBits(GZ_SENSOR_COLLIDE);
-
-  /*std::vector<std::string> collisions;
-  collisions.push_back(this->dataPtr->sonarCollision->GetScopedName());
-
-  physics::ContactManager *contactMgr =
-    this->world->Physics()->GetContactManager();
-    */
-
-  // Create a contact topic for the collision shape
-  std::string topic =
-    this->world->Physics()->GetContactManager()->CreateFilter(
-        this->dataPtr->sonarCollision->GetScopedName(),
-        this->dataPtr->sonarCollision->GetScopedName());
-
-  // Subscribe to the contact topic
-  this->dataPtr->contactSub = this->node->Subscribe(topic,
-      &SonarSensor::OnContacts, this);
+  // The points are set by each update
+  if (this->dataPtr->rays)
+  {
+    for (auto const &dir : this->dataPtr->directions)
+      this->dataPtr->rays->AddRay(ignition::math::Vector3d::Zero, dir);
+  }
 
   // Advertise the sensor's topic on which we will output range data.
   this->dataPtr->sonarPub = this->node->Advertise<msgs::SonarStamped>(
@@ -237,14 +251,8 @@ void SonarSensor::Init()
 //////////////////////////////////////////////////
 void SonarSensor::Fini()
 {
-  if (this->world && this->world->Running())
-  {
-    physics::ContactManager *mgr = this->world->Physics()->GetContactManager();
-    mgr->RemoveFilter(this->dataPtr->sonarCollision->GetScopedName());
-  }
-
   this->dataPtr->sonarPub.reset();
-  this->dataPtr->contactSub.reset();
+  this->dataPtr->rays.reset();
   Sensor::Fini();
 }
 
@@ -279,6 +287,12 @@ double SonarSensor::Range()
   return this->dataPtr->sonarMsg.sonar().range();
 }
 
+//////////////////////////////////////////////////
+unsigned int SonarSensor::RayCount() const
+{
+  return this->dataPtr->directions.size();
+}
+
 //////////////////////////////////////////////////
 bool SonarSensor::UpdateImpl(const bool /*_force*/)
 {
@@ -296,68 +310,52 @@ bool SonarSensor::UpdateImpl(const bool /*_force*/)
   msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_world_pose(),
       referencePose);
 
-  ignition::math::Vector3d pos;
-
-  // A 5-step hysteresis window was chosen to reduce range value from
-  // bouncing.
-  if (!this->dataPtr->incomingContacts.empty() ||
-      this->dataPtr->emptyContactCount > 5)
+  double range = this->dataPtr->rangeMax;
+  if (this->dataPtr->rays)
   {
-    this->dataPtr->sonarMsg.mutable_sonar()->set_range(
-        this->dataPtr->rangeMax);
-    this->dataPtr->emptyContactCount = 0;
-  }
-  else
-  {
-    ++this->dataPtr->emptyContactCount;
-  }
+    // Rays start outside the parent link, which the sonar can't see
+    const ignition::math::AxisAlignedBox parentBox =
+      this->dataPtr->parentEntity->BoundingBox();
+
+    const unsigned int rayCount = this->dataPtr->directions.size();
+    std::vector<double> starts(rayCount);
+    for (unsigned int i = 0; i < rayCount; ++i)
+    {
+      const ignition::math::Vector3d dir =
+        referencePose.Rot().RotateVector(this->dataPtr->directions[i]);
+      starts[i] = std::max(this->dataPtr->rangeMin,
+          exitDistance(parentBox, referencePose.Pos(), dir));
+      const double end = std::max(this->dataPtr->rangeMax, starts[i] + 1e-6);
+
+      this->dataPtr->rays->SetRay(i, referencePose.Pos() + dir * starts[i],
+          referencePose.Pos() + dir * end);
+      this->dataPtr->rays->Ray(i)->SetLength(end - starts[i]);
+    }
 
+    // Cast all the rays at once
+    this->dataPtr->rays->UpdateRays();
 
-  // Iterate over all the contact messages
-  for (auto iter = this->dataPtr->incomingContacts.begin();
-      iter != this->dataPtr->incomingContacts.end(); ++iter)
-  {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
+    for (unsigned int i = 0; i < rayCount; ++i)
     {
-      // Debug output:
-      // std::cout << "C1[" << (*iter)->contact(i).collision1() << "]"
-      //   << "C2[" << (*iter)->contact(i).collision2() << "]\n";
+      if (starts[i] >= this->dataPtr->rangeMax)
+        continue;
 
-      for (int j = 0; j < (*iter)->contact(i).position_size(); ++j)
+      const double len = starts[i] + this->dataPtr->rays->Ray(i)->GetLength();
+      if (len < range)
       {
-        // Get the contact position relative to the reference position.
-        pos = msgs::ConvertIgn((*iter)->contact(i).position(j)) -
-          referencePose.Pos();
-
-        // Compute the sensed range.
-        double len = pos.Length() - (*iter)->contact(i).depth(j);
-
-        // Debug output:
-        // std::cout << "  RP[" << referencePose << "]  P[" << pos
-        //   << "] L[" << len << "] D["
-        //   << (*iter)->contact(i).depth(j) << "]\n";
-
-        // Copy the contact message.
-        if (len < this->dataPtr->sonarMsg.sonar().range())
-        {
-          this->dataPtr->sonarMsg.mutable_sonar()->set_range(len);
-          msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_contact(),
-              referencePose.Rot().RotateVectorReverse(pos));
-        }
+        range = len;
+        msgs::Set(this->dataPtr->sonarMsg.mutable_sonar()->mutable_contact(),
+            this->dataPtr->directions[i] * len);
       }
     }
   }
-
-  // Clear the incoming contact list.
-  this->dataPtr->incomingContacts.clear();
+  this->dataPtr->sonarMsg.mutable_sonar()->set_range(range);
   IGN_PROFILE_END();
 
   IGN_PROFILE_BEGIN("Publish");
   this->dataPtr->update(this->dataPtr->sonarMsg);
 
-  if (this->dataPtr->sonarPub)
-    this->dataPtr->sonarPub->Publish(this->dataPtr->sonarMsg);
+  this->Publish(this->dataPtr->sonarPub, this->dataPtr->sonarMsg);
   IGN_PROFILE_END();
 
   return true;
@@ -369,23 +367,6 @@ bool SonarSensor::IsActive() const
   return Sensor::IsActive() || this->dataPtr->sonarPub->HasConnections();
 }
 
-//////////////////////////////////////////////////
-void SonarSensor::OnContacts(ConstContactsPtr &_msg)
-{
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  // Only store information if the sensor is active
-  if (this->IsActive() && _msg->contact_size() > 0)
-  {
-    // Store the contacts message for processing in UpdateImpl
-    this->dataPtr->incomingContacts.push_back(_msg);
-
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->dataPtr->incomingContacts.size() > 100)
-      this->dataPtr->incomingContacts.pop_front();
-  }
-}
-
 //////////////////////////////////////////////////
 event::ConnectionPtr SonarSensor::ConnectUpdate(
     std::function<void (msgs::SonarStamped)> _subscriber)
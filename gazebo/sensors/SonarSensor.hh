@@ -38,7 +38,10 @@ namespace gazebo
     /// \class SonarSensor SonarSensor.hh sensors/sensors.hh
     /// \brief Sensor with sonar cone.
     ///
-    /// This sensor uses a cone .
+    /// The range is measured by casting a fixed set of rays that sample the
+    /// cone, or the sphere, each time the sensor updates. The sensor adds
+    /// no collision to the world and costs nothing while it is inactive.
+    /// Objects inside the bounding box of the parent link are not seen.
     class GZ_SENSORS_VISIBLE SonarSensor: public Sensor
     {
       /// \brief Constructor
@@ -82,6 +85,9 @@ namespace gazebo
       /// \return Returns DBL_MAX for no detection.
       public: double Range();
 
+      /// \brief Get the number of rays that sample the sonar volume.
+      /// \return Number of rays.
+      public: unsigned int RayCount() const;
 
       // Documentation inherited
       public: virtual bool IsActive() const;
@@ -98,9 +104,6 @@ namespace gazebo
       // Documentation inherited
       protected: virtual void Fini();
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
-
       /// \internal
       /// \brief Internal data pointer
       private: std::unique_ptr<SonarSensorPrivate> dataPtr;
@@ -17,9 +17,9 @@
 #ifndef _GAZEBO_SENSORS_SONARSENSOR_PRIVATE_HH_
 #define _GAZEBO_SENSORS_SONARSENSOR_PRIVATE_HH_
 
-#include <list>
 #include <mutex>
-#include <ignition/math/Pose3.hh>
+#include <vector>
+#include <ignition/math/Vector3.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
@@ -33,24 +33,19 @@ namespace gazebo
     /// \brief Sonar sensor private data
     class SonarSensorPrivate
     {
-      /// \brief Contact messages list type
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
-
       /// \brief Update event.
       public: event::EventT<void(msgs::SonarStamped)> update;
 
-      /// \brief Collison object that holds the sonarShape.
-      public: physics::CollisionPtr sonarCollision;
+      /// \brief Standalone rays that sample the sonar volume. They are
+      /// not part of the world, and are only cast by UpdateImpl.
+      public: physics::MultiRayShapePtr rays;
 
-      /// \brief Shape used to generate contact information.
-      public: physics::MeshShapePtr sonarShape;
+      /// \brief Unit direction of each ray in the sensor frame.
+      public: std::vector<ignition::math::Vector3d> directions;
 
       /// \brief Parent entity of this sensor
       public: physics::EntityPtr parentEntity;
 
-      /// \brief Subscription to contact messages from the physics engine
-      public: transport::SubscriberPtr contactSub;
-
       /// \brief Publishes the sonarMsg.
       public: transport::PublisherPtr sonarPub;
 
@@ -60,12 +55,6 @@ namespace gazebo
       /// \brief Mutex used to protect reading/writing the sonar message.
       public: std::mutex mutex;
 
-      /// \brief List of received contacts from the sonar collision shape.
-      public: ContactMsgs_L incomingContacts;
-
-      /// \brief Pose of the sonar shape's midpoint.
-      public: ignition::math::Pose3d sonarMidPose;
-
       /// \brief Minimum range
       public: double rangeMin;
 
@@ -74,10 +63,6 @@ namespace gazebo
 
       /// \brief Radius of the sonar cone at maximum range.
       public: double radius;
-
-      /// \brief Counts the number of times there were no contacts. This is
-      /// used to reduce the range value jumping.
-      public: int emptyContactCount;
     };
   }
 }
@@ -70,6 +70,7 @@ void SonarSensor_TEST::CreateSonar(const std::string &_physicsEngine,
   physics::WorldPtr world = physics::get_world("default");
   physics::ModelPtr model = world->ModelByName("ground_plane");
   physics::LinkPtr link = model->GetLink("link");
+  const unsigned int childCount = link->GetChildCount();
 
   // Create the Sonar sensor
   std::string sensorName = mgr->CreateSensor(sdf, "default",
@@ -99,6 +100,10 @@ void SonarSensor_TEST::CreateSonar(const std::string &_physicsEngine,
   EXPECT_DOUBLE_EQ(sensor->Range(), 1.0);
   EXPECT_EQ(sensor->Geometry(), std::string("cone"));
 
+  // The cone is sampled by rays, without a collision in the world
+  EXPECT_EQ(37u, sensor->RayCount());
+  EXPECT_EQ(childCount, link->GetChildCount());
+
   EXPECT_TRUE(sensor->IsActive());
 }
 
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <ignition/common/Profiler.hh>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/WirelessPropagation.hh"
+#include "gazebo/sensors/WirelessReceiver.hh"
+#include "gazebo/sensors/WirelessTransmitter.hh"
+
+using namespace gazebo;
+using namespace sensors;
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \internal
+    /// \brief Obstacle test of a pair of static antennas.
+    class WirelessPropagationPair
+    {
+      /// \brief Position of the transmitter antenna.
+      public: ignition::math::Vector3d start;
+
+      /// \brief Position of the receiver antenna.
+      public: ignition::math::Vector3d end;
+
+      /// \brief True if there are obstacles between the antennas.
+      public: bool obstructed = false;
+    };
+
+    /// \internal
+    /// \brief Private data for WirelessPropagation
+    class WirelessPropagationPrivate
+    {
+      /// \brief Update the table if the simulation time changed, or if a
+      /// sensor was added or removed. The mutex must be locked.
+      public: void Update();
+
+      /// \brief World of the sensors.
+      public: physics::WorldPtr world;
+
+      /// \brief Ray used to test for obstacles between the antennas.
+      public: physics::RayShapePtr testRay;
+
+      /// \brief Protects everything below.
+      public: std::mutex mutex;
+
+      /// \brief The transmitters.
+      public: std::vector<WirelessTransmitter *> transmitters;
+
+      /// \brief The receivers, and the signals at each of them.
+      public: std::map<const WirelessReceiver *,
+              std::vector<WirelessPropagation::Signal>> receivers;
+
+      /// \brief Obstacle tests of the static pairs.
+      public: std::map<std::pair<const WirelessTransmitter *,
+              const WirelessReceiver *>, WirelessPropagationPair> pairs;
+
+      /// \brief Simulation time of the last update.
+      public: common::Time updateTime;
+
+      /// \brief True if the table must be updated.
+      public: bool dirty = true;
+
+      /// \brief Number of rays cast by the last update.
+      public: unsigned int rayCount = 0;
+    };
+  }
+}
+
+/// \brief Propagations by world name.
+static std::mutex gRegistryMutex;
+static std::map<std::string, std::weak_ptr<WirelessPropagation>> gRegistry;
+
+/////////////////////////////////////////////////
+WirelessPropagation::WirelessPropagation(physics::WorldPtr _world)
+  : dataPtr(new WirelessPropagationPrivate)
+{
+  this->dataPtr->world = _world;
+}
+
+/////////////////////////////////////////////////
+WirelessPropagation::~WirelessPropagation()
+{
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<WirelessPropagation> WirelessPropagation::ForWorld(
+    physics::WorldPtr _world)
+{
+  std::lock_guard<std::mutex> lock(gRegistryMutex);
+
+  std::weak_ptr<WirelessPropagation> &entry = gRegistry[_world->Name()];
+  std::shared_ptr<WirelessPropagation> propagation = entry.lock();
+
+  // A world that was reloaded with the same name gets a new propagation
+  if (!propagation || propagation->dataPtr->world != _world)
+  {
+    propagation.reset(new WirelessPropagation(_world));
+    entry = propagation;
+  }
+
+  return propagation;
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagation::AddTransmitter(WirelessTransmitter *_transmitter)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &transmitters = this->dataPtr->transmitters;
+  if (std::find(transmitters.begin(), transmitters.end(), _transmitter) ==
+      transmitters.end())
+  {
+    transmitters.push_back(_transmitter);
+    this->dataPtr->dirty = true;
+  }
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagation::RemoveTransmitter(
+    const WirelessTransmitter *_transmitter)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto &transmitters = this->dataPtr->transmitters;
+  transmitters.erase(std::remove(transmitters.begin(), transmitters.end(),
+      _transmitter), transmitters.end());
+
+  for (auto it = this->dataPtr->pairs.begin();
+       it != this->dataPtr->pairs.end();)
+  {
+    if (it->first.first == _transmitter)
+      it = this->dataPtr->pairs.erase(it);
+    else
+      ++it;
+  }
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagation::AddReceiver(WirelessReceiver *_receiver)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->receivers[_receiver].clear();
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagation::RemoveReceiver(const WirelessReceiver *_receiver)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->receivers.erase(_receiver);
+
+  for (auto it = this->dataPtr->pairs.begin();
+       it != this->dataPtr->pairs.end();)
+  {
+    if (it->first.second == _receiver)
+      it = this->dataPtr->pairs.erase(it);
+    else
+      ++it;
+  }
+  this->dataPtr->dirty = true;
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagation::Signals(const WirelessReceiver *_receiver,
+    std::vector<Signal> &_signals)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->Update();
+
+  auto iter = this->dataPtr->receivers.find(_receiver);
+  if (iter != this->dataPtr->receivers.end())
+    _signals = iter->second;
+  else
+    _signals.clear();
+}
+
+/////////////////////////////////////////////////
+unsigned int WirelessPropagation::RayCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->rayCount;
+}
+
+/////////////////////////////////////////////////
+void WirelessPropagationPrivate::Update()
+{
+  const common::Time simTime = this->world->SimTime();
+  if (!this->dirty && simTime == this->updateTime)
+    return;
+
+  IGN_PROFILE("WirelessPropagation::Update");
+
+  this->dirty = false;
+  this->updateTime = simTime;
+  this->rayCount = 0;
+
+  if (!this->testRay)
+  {
+    this->testRay = boost::dynamic_pointer_cast<physics::RayShape>(
+        this->world->Physics()->CreateShape("ray", physics::CollisionPtr()));
+  }
+
+  // One lock for all the obstacle tests, which keeps the antenna poses
+  // consistent with each other.
+  boost::recursive_mutex::scoped_lock lock(
+      *this->world->Physics()->GetPhysicsUpdateMutex());
+
+  std::vector<ignition::math::Vector3d> txPos(this->transmitters.size());
+  std::vector<bool> txStatic(this->transmitters.size());
+  for (unsigned int i = 0; i < this->transmitters.size(); ++i)
+  {
+    txPos[i] = this->transmitters[i]->AntennaPose().Pos();
+    txStatic[i] = this->transmitters[i]->IsStatic();
+  }
+
+  for (auto &receiver : this->receivers)
+  {
+    const WirelessReceiver *rx = receiver.first;
+    std::vector<WirelessPropagation::Signal> &signals = receiver.second;
+    signals.clear();
+
+    const ignition::math::Vector3d rxPos = rx->AntennaPose().Pos();
+    const bool rxStatic = rx->IsStatic();
+
+    for (unsigned int i = 0; i < this->transmitters.size(); ++i)
+    {
+      const WirelessTransmitter *tx = this->transmitters[i];
+      const double freq = tx->Freq();
+      if (freq < rx->MinFreqFiltered() || freq > rx->MaxFreqFiltered())
+        continue;
+
+      ignition::math::Vector3d start = txPos[i];
+      ignition::math::Vector3d end = rxPos;
+
+      // Avoid computing the intersection of coincident points
+      // This prevents an assertion in bullet (issue #849)
+      if (start == end)
+        end.Z() += 0.00001;
+
+      bool obstructed = false;
+      auto key = std::make_pair(tx, rx);
+      auto pairIter = this->pairs.find(key);
+      if (txStatic[i] && rxStatic && pairIter != this->pairs.end() &&
+          pairIter->second.start == start && pairIter->second.end == end)
+      {
+        obstructed = pairIter->second.obstructed;
+      }
+      else
+      {
+        double dist;
+        std::string entityName;
+        this->testRay->SetPoints(start, end);
+        this->testRay->GetIntersection(dist, entityName);
+        ++this->rayCount;
+
+        // ToDo: The ray intersects with my own collision model. Fix it.
+        obstructed = !entityName.empty();
+
+        if (txStatic[i] && rxStatic)
+        {
+          WirelessPropagationPair &pair = this->pairs[key];
+          pair.start = start;
+          pair.end = end;
+          pair.obstructed = obstructed;
+        }
+        else if (pairIter != this->pairs.end())
+        {
+          this->pairs.erase(pairIter);
+        }
+      }
+
+      WirelessPropagation::Signal signal;
+      signal.essid = tx->ESSID();
+      signal.frequency = freq;
+      signal.strength = tx->MeanSignalStrength(txPos[i].Distance(rxPos),
+          obstructed, rx->Gain());
+      signal.stdDev = tx->ModelStdDev();
+      signals.push_back(signal);
+    }
+  }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_SENSORS_WIRELESSPROPAGATION_HH_
+#define GAZEBO_SENSORS_WIRELESSPROPAGATION_HH_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    // Forward declarations
+    class WirelessPropagationPrivate;
+    class WirelessReceiver;
+    class WirelessTransmitter;
+
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class WirelessPropagation WirelessPropagation.hh sensors/sensors.hh
+    /// \brief Computes the signal strength between every wireless
+    /// transmitter and receiver of a world.
+    ///
+    /// The whole table is computed at most once per simulation time, the
+    /// first time a receiver asks for it, with a single lock of the physics
+    /// engine for all the obstacle tests. The obstacle test of a pair whose
+    /// transmitter and receiver are attached to static models is kept until
+    /// one of them moves.
+    class GZ_SENSORS_VISIBLE WirelessPropagation
+    {
+      /// \brief Signal of a transmitter at a receiver.
+      public: class Signal
+      {
+        /// \brief Service Set Identifier of the transmitter.
+        public: std::string essid;
+
+        /// \brief Frequency of the transmitter (MHz).
+        public: double frequency = 0;
+
+        /// \brief Signal strength including the antenna gains, but not the
+        /// random fading of the propagation model (dBm).
+        public: double strength = 0;
+
+        /// \brief Std dev of the random fading of the transmitter.
+        public: double stdDev = 0;
+      };
+
+      /// \brief Constructor
+      /// \param[in] _world World of the transmitters and receivers.
+      public: explicit WirelessPropagation(physics::WorldPtr _world);
+
+      /// \brief Destructor
+      public: virtual ~WirelessPropagation();
+
+      /// \brief Get the propagation shared by the sensors of a world. It
+      /// is created by the first call, and released when the last sensor
+      /// that holds it is gone.
+      /// \param[in] _world The world.
+      /// \return The propagation of the world.
+      public: static std::shared_ptr<WirelessPropagation> ForWorld(
+                  physics::WorldPtr _world);
+
+      /// \brief Add a transmitter.
+      /// \param[in] _transmitter Transmitter, which must be removed before
+      /// it is destroyed.
+      public: void AddTransmitter(WirelessTransmitter *_transmitter);
+
+      /// \brief Remove a transmitter.
+      /// \param[in] _transmitter Transmitter to remove.
+      public: void RemoveTransmitter(const WirelessTransmitter *_transmitter);
+
+      /// \brief Add a receiver.
+      /// \param[in] _receiver Receiver, which must be removed before it is
+      /// destroyed.
+      public: void AddReceiver(WirelessReceiver *_receiver);
+
+      /// \brief Remove a receiver.
+      /// \param[in] _receiver Receiver to remove.
+      public: void RemoveReceiver(const WirelessReceiver *_receiver);
+
+      /// \brief Get the signals at a receiver from the transmitters within
+      /// its frequency range. The table is updated first if the simulation
+      /// time changed since the last update.
+      /// \param[in] _receiver A receiver that was added.
+      /// \param[out] _signals The signals.
+      public: void Signals(const WirelessReceiver *_receiver,
+                           std::vector<Signal> &_signals);
+
+      /// \brief Get the number of rays cast by the last update.
+      /// \return Number of rays.
+      public: unsigned int RayCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<WirelessPropagationPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
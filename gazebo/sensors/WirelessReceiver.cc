@@ -14,12 +14,15 @@
  * limitations under the License.
  *
 */
+#include <vector>
+
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
+#include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/sensors/SensorFactory.hh"
-#include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/sensors/WirelessPropagation.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
@@ -48,6 +51,9 @@ WirelessReceiver::~WirelessReceiver()
 void WirelessReceiver::Init()
 {
   WirelessTransceiver::Init();
+
+  this->propagation = WirelessPropagation::ForWorld(this->world);
+  this->propagation->AddReceiver(this);
 }
 
 /////////////////////////////////////////////////
@@ -106,41 +112,28 @@ bool WirelessReceiver::UpdateImpl(const bool /*_force*/)
   IGN_PROFILE("WirelessReceiver::UpdateImpl");
   IGN_PROFILE_BEGIN("Update");
 
-  std::string txEssid;
   msgs::WirelessNodes msg;
-  double rxPower;
-  double txFreq;
 
-  this->referencePose = this->pose + this->parentEntity.lock()->WorldPose();
+  this->referencePose = this->AntennaPose();
+
+  // The signals of all the transmitters within our frequency range, which
+  // are shared with the other receivers of the world.
+  std::vector<WirelessPropagation::Signal> signals;
+  this->propagation->Signals(this, signals);
 
-  ignition::math::Pose3d myPos = this->referencePose;
-  Sensor_V sensors = SensorManager::Instance()->GetSensors();
-  for (Sensor_V::iterator it = sensors.begin(); it != sensors.end(); ++it)
+  for (auto const &signal : signals)
   {
-    if ((*it)->Type() == "wireless_transmitter")
-    {
-      std::shared_ptr<gazebo::sensors::WirelessTransmitter> transmitter =
-          std::static_pointer_cast<WirelessTransmitter>(*it);
-
-      txFreq = transmitter->Freq();
-      rxPower = transmitter->SignalStrength(myPos, this->Gain());
-
-      // Discard if the frequency received is out of our frequency range,
-      // or if the received signal strengh is lower than the sensivity
-      if ((txFreq < this->MinFreqFiltered()) ||
-          (txFreq > this->MaxFreqFiltered()) ||
-          (rxPower < this->Sensitivity()))
-      {
-        continue;
-      }
-
-      txEssid = transmitter->ESSID();
-
-      msgs::WirelessNode *wirelessNode = msg.add_node();
-      wirelessNode->set_essid(txEssid);
-      wirelessNode->set_frequency(txFreq);
-      wirelessNode->set_signal_level(rxPower);
-    }
+    double rxPower = signal.strength -
+        std::abs(ignition::math::Rand::DblNormal(0.0, signal.stdDev));
+
+    // Discard if the received signal strengh is lower than the sensivity
+    if (rxPower < this->Sensitivity())
+      continue;
+
+    msgs::WirelessNode *wirelessNode = msg.add_node();
+    wirelessNode->set_essid(signal.essid);
+    wirelessNode->set_frequency(signal.frequency);
+    wirelessNode->set_signal_level(rxPower);
   }
   IGN_PROFILE_END();
   IGN_PROFILE_BEGIN("Publish");
@@ -174,5 +167,7 @@ double WirelessReceiver::Sensitivity() const
 //////////////////////////////////////////////////
 void WirelessReceiver::Fini()
 {
+  if (this->propagation)
+    this->propagation->RemoveReceiver(this);
   WirelessTransceiver::Fini();
 }
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/regex.hpp>
+#include "gazebo/sensors/WirelessPropagation.hh"
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -34,6 +35,7 @@ class WirelessReceiver_TEST : public ServerFixture
   public: void TestIllegalMinMaxFreq();
   public: void TestIllegalSensitivity();
   public: void TestUpdateImpl();
+  public: void TestPropagation();
 
   /// \brief Create a sensor with an illegal value and check that an exception
   /// is thrown
@@ -253,6 +255,75 @@ void WirelessReceiver_TEST::TestUpdateImpl()
   sensor->Update(true);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test the signals shared by the receivers
+void WirelessReceiver_TEST::TestPropagation()
+{
+  const std::string transmitterSensorString =
+    "<sdf version='1.4'>"
+    "  <sensor name='wirelessTransmitter' type='wireless_transmitter'>"
+    "    <always_on>1</always_on>"
+    "    <visualize>0</visualize>"
+    "    <update_rate>1.0</update_rate>"
+    "    <pose>0 0 5 0 0 0</pose>"
+    "    <transceiver>"
+    "      <essid>GzTest</essid>"
+    "      <frequency>2442.0</frequency>"
+    "      <power>14.5</power>"
+    "      <gain>2.6</gain>"
+    "    </transceiver>"
+    "  </sensor>"
+    "</sdf>";
+
+  sdf::readString(transmitterSensorString, this->sdf);
+  std::string txName = this->mgr->CreateSensor(this->sdf, "default",
+      "ground_plane::link", 0);
+  sdf::readString(this->receiverSensorString, this->sdf);
+  std::string rxName = this->mgr->CreateSensor(this->sdf, "default",
+      "ground_plane::link", 0);
+  this->mgr->Update();
+
+  sensors::WirelessTransmitterPtr tx =
+    std::dynamic_pointer_cast<sensors::WirelessTransmitter>(
+        this->mgr->GetSensor(txName));
+  sensors::WirelessReceiverPtr rx =
+    std::dynamic_pointer_cast<sensors::WirelessReceiver>(
+        this->mgr->GetSensor(rxName));
+  ASSERT_TRUE(tx != nullptr);
+  ASSERT_TRUE(rx != nullptr);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  std::shared_ptr<sensors::WirelessPropagation> propagation =
+      sensors::WirelessPropagation::ForWorld(world);
+
+  std::vector<sensors::WirelessPropagation::Signal> signals;
+  propagation->Signals(rx.get(), signals);
+  ASSERT_EQ(1u, signals.size());
+  EXPECT_EQ("GzTest", signals[0].essid);
+  EXPECT_DOUBLE_EQ(2442.0, signals[0].frequency);
+  // The ray may hit the ground plane under the receiver
+  EXPECT_TRUE(
+      ignition::math::equal(signals[0].strength,
+        tx->MeanSignalStrength(5.0, false, rx->Gain())) ||
+      ignition::math::equal(signals[0].strength,
+        tx->MeanSignalStrength(5.0, true, rx->Gain())));
+  EXPECT_LE(propagation->RayCount(), 1u);
+
+  // Both antennas are on a static model, so the obstacle test is reused
+  world->Step(1);
+  const double strength = signals[0].strength;
+  propagation->Signals(rx.get(), signals);
+  ASSERT_EQ(1u, signals.size());
+  EXPECT_DOUBLE_EQ(strength, signals[0].strength);
+  EXPECT_EQ(0u, propagation->RayCount());
+
+  // Removed transmitters are not seen anymore
+  propagation->RemoveTransmitter(tx.get());
+  propagation->Signals(rx.get(), signals);
+  EXPECT_TRUE(signals.empty());
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessReceiver_TEST, TestCreateWilessReceiver)
 {
@@ -307,6 +378,12 @@ TEST_F(WirelessReceiver_TEST, TestUpdateImpl)
   TestUpdateImpl();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessReceiver_TEST, TestPropagation)
+{
+  TestPropagation();
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
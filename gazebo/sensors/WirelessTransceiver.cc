@@ -23,6 +23,7 @@
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
+#include "gazebo/sensors/WirelessPropagation.hh"
 #include "gazebo/sensors/WirelessTransceiver.hh"
 
 using namespace gazebo;
@@ -96,6 +97,7 @@ void WirelessTransceiver::Init()
 /////////////////////////////////////////////////
 void WirelessTransceiver::Fini()
 {
+  this->propagation.reset();
   this->pub.reset();
   this->parentEntity.lock().reset();
   Sensor::Fini();
@@ -112,3 +114,19 @@ double WirelessTransceiver::Gain() const
 {
   return this->gain;
 }
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d WirelessTransceiver::AntennaPose() const
+{
+  physics::LinkPtr parent = this->parentEntity.lock();
+  if (!parent)
+    return this->referencePose;
+  return this->pose + parent->WorldPose();
+}
+
+/////////////////////////////////////////////////
+bool WirelessTransceiver::IsStatic() const
+{
+  physics::LinkPtr parent = this->parentEntity.lock();
+  return parent && parent->GetModel() && parent->GetModel()->IsStatic();
+}
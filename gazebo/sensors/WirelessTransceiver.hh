@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_SENSORS_WIRELESSTRANSCEIVER_HH_
 #define _GAZEBO_SENSORS_WIRELESSTRANSCEIVER_HH_
 
+#include <memory>
 #include <string>
 #include <ignition/math/Pose3.hh>
 
@@ -29,6 +30,9 @@ namespace gazebo
 {
   namespace sensors
   {
+    // Forward declarations
+    class WirelessPropagation;
+
     /// \addtogroup gazebo_sensors
     /// \{
 
@@ -62,6 +66,14 @@ namespace gazebo
       /// \return Receiver power (dBm).
       public: double Power() const;
 
+      /// \brief Get the current world pose of the antenna.
+      /// \return Pose of the antenna.
+      public: ignition::math::Pose3d AntennaPose() const;
+
+      /// \brief Tell whether the antenna is attached to a static model.
+      /// \return True if the antenna can't move.
+      public: bool IsStatic() const;
+
       /// \brief Publisher to publish propagation model data
       protected: transport::PublisherPtr pub;
 
@@ -76,6 +88,9 @@ namespace gazebo
 
       /// \brief Sensor reference pose
       protected: ignition::math::Pose3d referencePose;
+
+      /// \brief Signal strengths shared by the sensors of the world.
+      protected: std::shared_ptr<WirelessPropagation> propagation;
     };
     /// \}
   }
@@ -22,6 +22,7 @@
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Publisher.hh"
 
+#include "gazebo/sensors/WirelessPropagation.hh"
 #include "gazebo/sensors/WirelessTransmitterPrivate.hh"
 #include "gazebo/sensors/WirelessTransmitter.hh"
 
@@ -83,6 +84,18 @@ void WirelessTransmitter::Init()
   // between the transmitter and a given point.
   this->dataPtr->testRay = boost::dynamic_pointer_cast<RayShape>(
       this->world->Physics()->CreateShape("ray", CollisionPtr()));
+
+  this->propagation = WirelessPropagation::ForWorld(this->world);
+  this->propagation->AddTransmitter(this);
+}
+
+//////////////////////////////////////////////////
+void WirelessTransmitter::Fini()
+{
+  if (this->propagation)
+    this->propagation->RemoveTransmitter(this);
+  this->dataPtr->testRay.reset();
+  WirelessTransceiver::Fini();
 }
 
 //////////////////////////////////////////////////
@@ -148,8 +161,6 @@ double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
 {
-  std::string entityName;
-  double dist;
   ignition::math::Vector3d end = _receiver.Pos();
   ignition::math::Vector3d start = this->referencePose.Pos();
 
@@ -160,34 +171,35 @@ double WirelessTransmitter::SignalStrength(
     end.Z() += 0.00001;
   }
 
-  // Acquire the mutex for avoiding race condition with the physics engine
-  boost::recursive_mutex::scoped_lock lock(*(
-        this->world->Physics()->GetPhysicsUpdateMutex()));
-
-  // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = WirelessTransmitterPrivate::NEmpty;
-
-  // Looking for obstacles between start and end points
-  this->dataPtr->testRay->SetPoints(start, end);
-  this->dataPtr->testRay->GetIntersection(dist, entityName);
+  // Looking for obstacles between start and end points, against the
+  // snapshot of the scene queries so the physics step isn't blocked
+  physics::SceneQueryHit hit;
 
   // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
-  {
-    n = WirelessTransmitterPrivate::NObstacle;
-  }
+  bool obstructed = this->world->SceneQueries().Ray(start, end, hit);
 
-  double distance = std::max(1.0,
-      this->referencePose.Pos().Distance(_receiver.Pos()));
   double x = std::abs(ignition::math::Rand::DblNormal(0.0,
         WirelessTransmitterPrivate::ModelStdDev));
+
+  return this->MeanSignalStrength(
+      this->referencePose.Pos().Distance(_receiver.Pos()), obstructed,
+      _rxGain) - x;
+}
+
+/////////////////////////////////////////////////
+double WirelessTransmitter::MeanSignalStrength(const double _distance,
+    const bool _obstructed, const double _rxGain) const
+{
+  // Compute the value of n depending on the obstacles between Tx and Rx
+  double n = _obstructed ? WirelessTransmitterPrivate::NObstacle :
+      WirelessTransmitterPrivate::NEmpty;
+
+  double distance = std::max(1.0, _distance);
   double wavelength = common::SpeedOfLight / (this->Freq() * 1000000);
 
   // Hata-Okumara propagation model
-  double rxPower = this->Power() + this->Gain() + _rxGain - x +
+  return this->Power() + this->Gain() + _rxGain +
       20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
-
-  return rxPower;
 }
 
 /////////////////////////////////////////////////
@@ -53,6 +53,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Init();
 
+      // Documentation inherited
+      public: virtual void Fini();
+
       /// \brief Returns the Service Set Identifier (network name).
       /// \return Service Set Identifier (network name).
       public: std::string ESSID() const;
@@ -68,6 +71,16 @@ namespace gazebo
       public: double SignalStrength(const ignition::math::Pose3d &_receiver,
           const double _rxGain);
 
+      /// \brief Returns the signal strength at a distance, without the
+      /// random fading of the propagation model (dBm).
+      /// \param[in] _distance Distance to the receiver (m).
+      /// \param[in] _obstructed True if there are obstacles between the
+      /// transmitter and the receiver.
+      /// \param[in] _rxGain Receiver gain value
+      /// \return Mean signal strength (dBm).
+      public: double MeanSignalStrength(const double _distance,
+          const bool _obstructed, const double _rxGain) const;
+
       /// \brief Get the std dev of the Gaussian random variable used in the
       /// propagation model.
       /// \return The standard deviation of the propagation model.
@@ -15,18 +15,22 @@
  *
 */
 #include <memory>
+#include <string>
+#include <vector>
 #include "gazebo/common/Exception.hh"
 #include "gazebo/util/LogRecord.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/rendering/ogre_gazebo.h"
+#include "gazebo/ForkServer.hh"
 #include "gazebo/Server.hh"
 
 //////////////////////////////////////////////////
-int main(int argc, char **argv)
+/// \brief Run a server.
+/// \param[in] argc Number of arguments.
+/// \param[in] argv Array of argument values.
+/// \return Exit status.
+static int runServer(int argc, char **argv)
 {
-#ifndef _WIN32
-  ::setenv("RMT_PORT", "1500", true);
-#endif
   std::unique_ptr<gazebo::Server> server;
 
   try
@@ -62,3 +66,32 @@ int main(int argc, char **argv)
 
   return 0;
 }
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+#ifndef _WIN32
+  ::setenv("RMT_PORT", "1500", true);
+#endif
+
+  if (!gazebo::ForkServer::Requested(argc, argv))
+    return runServer(argc, argv);
+
+  // Serve jobs, and run the server of a job in each forked child
+  gazebo::ForkServer forkServer;
+  std::vector<std::string> args;
+  if (!forkServer.Load(argc, argv))
+    return -1;
+  if (!forkServer.Run(args))
+    return 0;
+
+  std::vector<char *> jobArgv;
+  jobArgv.push_back(argv[0]);
+  for (auto &arg : args)
+    jobArgv.push_back(&arg[0]);
+  jobArgv.push_back(nullptr);
+
+  int status = runServer(static_cast<int>(jobArgv.size() - 1), &jobArgv[0]);
+  forkServer.Finish(status);
+  return status;
+}
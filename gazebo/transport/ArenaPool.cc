@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/arena.h>
+
+#include "gazebo/transport/ArenaPool.hh"
+
+// Messages of proto2 files can be created on an arena without the
+// cc_enable_arenas option since protobuf 3.14.
+#if GOOGLE_PROTOBUF_VERSION >= 3014000
+#define GZ_PROTOBUF_ARENA
+#endif
+
+using namespace gazebo;
+using namespace transport;
+
+const std::size_t ArenaPool::kCapacity;
+const std::size_t ArenaPool::kInitialBlockSize;
+const std::size_t ArenaPool::kMaxBlockSize;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief An arena and its memory block.
+    class ArenaBlock
+    {
+      /// \brief Constructor
+      /// \param[in] _size Size of the memory block.
+      public: explicit ArenaBlock(const std::size_t _size)
+              {
+                this->Resize(_size);
+              }
+
+      /// \brief Replace the arena by one with a block of a given size.
+      /// \param[in] _size Size of the memory block.
+      public: void Resize(const std::size_t _size)
+              {
+                this->arena.reset();
+                this->block.resize(_size);
+
+                google::protobuf::ArenaOptions options;
+                options.initial_block = this->block.data();
+                options.initial_block_size = this->block.size();
+                this->arena.reset(new google::protobuf::Arena(options));
+              }
+
+      /// \brief Memory block of the arena, which must outlive it.
+      public: std::vector<char> block;
+
+      /// \brief The arena.
+      public: std::unique_ptr<google::protobuf::Arena> arena;
+    };
+
+    /// \internal
+    /// \brief Private data for the ArenaPool class
+    class ArenaPoolPrivate
+    {
+      /// \brief Put an arena back in the pool, once its message was
+      /// released.
+      /// \param[in] _block The arena.
+      public: void Release(std::unique_ptr<ArenaBlock> _block);
+
+      /// \brief Protects the members below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Idle arenas.
+      public: std::vector<std::unique_ptr<ArenaBlock>> idle;
+
+      /// \brief Number of messages created on a reused arena.
+      public: uint64_t reused = 0;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+ArenaPool::ArenaPool()
+  : dataPtr(new ArenaPoolPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ArenaPool::~ArenaPool()
+{
+}
+
+//////////////////////////////////////////////////
+bool ArenaPool::Enabled()
+{
+#ifdef GZ_PROTOBUF_ARENA
+  static const bool enabled = []()
+  {
+    const char *env = std::getenv("GAZEBO_PROTOBUF_ARENA");
+    return !env || std::string(env) != "0";
+  }();
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+//////////////////////////////////////////////////
+MessagePtr ArenaPool::Create(const google::protobuf::Message &_prototype)
+{
+  if (!this->Enabled())
+    return MessagePtr(_prototype.New());
+
+  std::unique_ptr<ArenaBlock> block;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (!this->dataPtr->idle.empty())
+    {
+      block = std::move(this->dataPtr->idle.back());
+      this->dataPtr->idle.pop_back();
+      this->dataPtr->reused++;
+    }
+  }
+  if (!block)
+    block.reset(new ArenaBlock(kInitialBlockSize));
+
+  google::protobuf::Message *msg = _prototype.New(block->arena.get());
+
+  // The message is freed with its arena. The deleter keeps the pool alive
+  // until every message of the pool is released.
+  ArenaBlock *raw = block.release();
+  ArenaPoolPtr pool = this->shared_from_this();
+  return MessagePtr(msg, [pool, raw](google::protobuf::Message *)
+      {
+        pool->dataPtr->Release(std::unique_ptr<ArenaBlock>(raw));
+      });
+}
+
+//////////////////////////////////////////////////
+std::size_t ArenaPool::IdleCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->idle.size();
+}
+
+//////////////////////////////////////////////////
+uint64_t ArenaPool::ReuseCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->reused;
+}
+
+//////////////////////////////////////////////////
+void ArenaPoolPrivate::Release(std::unique_ptr<ArenaBlock> _block)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->idle.size() >= ArenaPool::kCapacity)
+      return;
+  }
+
+  // Grow the block to fit the largest message seen, so that the next
+  // message of the same size takes no allocation.
+  const std::size_t used = _block->arena->SpaceAllocated();
+  if (used > _block->block.size() && used <= ArenaPool::kMaxBlockSize)
+    _block->Resize(used);
+  else
+    _block->arena->Reset();
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->idle.push_back(std::move(_block));
+}
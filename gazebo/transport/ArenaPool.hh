@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_ARENAPOOL_HH_
+#define GAZEBO_TRANSPORT_ARENAPOOL_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class
+    class ArenaPoolPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class ArenaPool ArenaPool.hh transport/transport.hh
+    /// \brief Creates the messages of a topic on protobuf arenas, and
+    /// reuses the arenas once the messages are released.
+    ///
+    /// A message, its submessages and its strings are allocated from the
+    /// memory block of one arena, so that parsing or copying a message
+    /// doesn't call malloc once the block fits the largest message of the
+    /// topic. Messages stay valid for as long as a pointer to them exists,
+    /// as with messages on the heap.
+    ///
+    /// Arenas need protobuf 3.14 or later. Otherwise, or if the
+    /// environment variable GAZEBO_PROTOBUF_ARENA is 0, messages are
+    /// created on the heap. The pool must be owned by an ArenaPoolPtr.
+    class GZ_TRANSPORT_VISIBLE ArenaPool :
+      public boost::enable_shared_from_this<ArenaPool>
+    {
+      /// \brief Number of idle arenas kept at most.
+      public: static const std::size_t kCapacity = 4;
+
+      /// \brief Initial size of the memory block of an arena.
+      public: static const std::size_t kInitialBlockSize = 4096;
+
+      /// \brief Largest memory block of an arena. Larger messages get
+      /// extra blocks from the heap.
+      public: static const std::size_t kMaxBlockSize = 1024 * 1024;
+
+      /// \brief Constructor
+      public: ArenaPool();
+
+      /// \brief Destructor
+      public: ~ArenaPool();
+
+      /// \brief Get whether messages are created on arenas.
+      /// \return True if protobuf supports arenas and they aren't disabled.
+      public: static bool Enabled();
+
+      /// \brief Create an empty message.
+      /// \param[in] _prototype A message of the type to create.
+      /// \return The new message.
+      public: MessagePtr Create(const google::protobuf::Message &_prototype);
+
+      /// \brief Create an empty message.
+      /// \return The new message.
+      public: template<typename M>
+              boost::shared_ptr<M> Create()
+              {
+                return boost::static_pointer_cast<M>(
+                    this->Create(M::default_instance()));
+              }
+
+      /// \brief Get the number of idle arenas.
+      /// \return Arenas waiting for a message.
+      public: std::size_t IdleCount() const;
+
+      /// \brief Get the number of messages created on a reused arena.
+      /// \return Reuse count.
+      public: uint64_t ReuseCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<ArenaPoolPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/ArenaPool.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ArenaPool : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ArenaPool, Reuse)
+{
+  transport::ArenaPoolPtr pool(new transport::ArenaPool());
+
+  msgs::GzString source;
+  source.set_data(std::string(10000, 'x'));
+  std::string data;
+  source.SerializeToString(&data);
+
+  // Messages stay valid after the pool is gone
+  boost::shared_ptr<msgs::GzString> first = pool->Create<msgs::GzString>();
+  ASSERT_TRUE(first->ParseFromString(data));
+  EXPECT_EQ(first->data(), source.data());
+
+  transport::MessagePtr second = pool->Create(source);
+  second->CopyFrom(source);
+  EXPECT_EQ(second->GetTypeName(), "gazebo.msgs.GzString");
+  EXPECT_EQ(pool->IdleCount(), 0u);
+
+  first.reset();
+  if (!transport::ArenaPool::Enabled())
+    return;
+
+  // The released arena is reused, and grew to fit the message
+  EXPECT_EQ(pool->IdleCount(), 1u);
+  first = pool->Create<msgs::GzString>();
+  EXPECT_EQ(pool->ReuseCount(), 1u);
+  EXPECT_NE(first->GetArena(), nullptr);
+  ASSERT_TRUE(first->ParseFromString(data));
+  EXPECT_EQ(first->data(), source.data());
+
+  pool.reset();
+  EXPECT_EQ(boost::dynamic_pointer_cast<msgs::GzString>(second)->data(),
+      source.data());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ArenaPool, Capacity)
+{
+  transport::ArenaPoolPtr pool(new transport::ArenaPool());
+  std::vector<boost::shared_ptr<msgs::Pose>> poses;
+  for (unsigned int i = 0; i < 2 * transport::ArenaPool::kCapacity; ++i)
+  {
+    poses.push_back(pool->Create<msgs::Pose>());
+    poses.back()->set_name("pose");
+  }
+  poses.clear();
+
+  EXPECT_LE(pool->IdleCount(), transport::ArenaPool::kCapacity);
+}
@@ -53,6 +53,18 @@ void CallbackHelper::SetLatching(bool _latch)
   this->latching = _latch;
 }
 
+/////////////////////////////////////////////////
+bool CallbackHelper::GetLatestOnly() const
+{
+  return this->latestOnly;
+}
+
+/////////////////////////////////////////////////
+void CallbackHelper::SetLatestOnly(const bool _latestOnly)
+{
+  this->latestOnly = _latestOnly;
+}
+
 /////////////////////////////////////////////////
 unsigned int CallbackHelper::GetId() const
 {
@@ -29,6 +29,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Exception.hh"
 
+#include "gazebo/transport/ArenaPool.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/util/system.hh"
 
@@ -83,6 +84,17 @@ namespace gazebo
       /// \param[in] _latch False to turn off latching.
       public: void SetLatching(bool _latch);
 
+      /// \brief Does the callback only want the newest message?
+      /// \return True if older messages that weren't delivered yet are
+      /// replaced by newer ones.
+      public: bool GetLatestOnly() const;
+
+      /// \brief Set whether the callback only wants the newest message.
+      /// This must be set before the callback is registered.
+      /// \param[in] _latestOnly True to replace the messages that weren't
+      /// delivered yet with newer ones.
+      public: void SetLatestOnly(const bool _latestOnly);
+
       /// \brief Get the unique ID of this callback.
       /// \return The unique ID of this callback.
       public: unsigned int GetId() const;
@@ -94,6 +106,9 @@ namespace gazebo
       /// \brief Mutex to protect the latching variable.
       protected: mutable std::mutex latchingMutex;
 
+      /// \brief True if only the newest message is delivered.
+      protected: bool latestOnly = false;
+
       /// \brief A counter to generate the unique id of this callback.
       private: static unsigned int idCounter;
 
@@ -117,7 +132,8 @@ namespace gazebo
       public: CallbackHelperT(const boost::function<
                 void (const boost::shared_ptr<M const> &)> &_cb,
                 bool _latching = false)
-              : CallbackHelper(_latching), callback(_cb)
+              : CallbackHelper(_latching), callback(_cb),
+                arenas(new ArenaPool())
               {
                 // Just some code to make sure we have a google protobuf.
                 /*M test;
@@ -144,7 +160,7 @@ namespace gazebo
                   boost::function<void(uint32_t)> _cb, uint32_t _id)
               {
                 this->SetLatching(false);
-                boost::shared_ptr<M> m(new M);
+                boost::shared_ptr<M> m = this->arenas->template Create<M>();
                 m->ParseFromString(_newdata);
                 this->callback(m);
                 if (!_cb.empty())
@@ -168,6 +184,9 @@ namespace gazebo
 
       private: boost::function<void (const boost::shared_ptr<M const> &)>
                callback;
+
+      /// \brief Arenas of the messages parsed by HandleData.
+      private: ArenaPoolPtr arenas;
     };
 
     /// \class RawCallbackHelper RawCallbackHelper.hh transport/transport.hh
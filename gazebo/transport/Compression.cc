@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdlib>
+#include <iterator>
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/Compression.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+const char *const Compression::kZlib = "zlib";
+const std::size_t Compression::kDefaultMinSize;
+const std::size_t Compression::kMaxSize;
+
+/// \brief First byte of a compressed frame.
+static const char kFramePrefix = '\0';
+
+/// \brief Second byte of a frame compressed with zlib.
+static const char kZlibCodec = 'z';
+
+//////////////////////////////////////////////////
+std::string Compression::RequestedCodec()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_COMPRESSION");
+  if (!env || std::string(env).empty() || std::string(env) == "0")
+    return std::string();
+
+  if (std::string(env) != kZlib)
+  {
+    gzwarn << "Unsupported GAZEBO_TRANSPORT_COMPRESSION[" << env
+      << "], only [" << kZlib << "] is supported." << std::endl;
+    return std::string();
+  }
+
+  return kZlib;
+}
+
+//////////////////////////////////////////////////
+std::size_t Compression::MinSize()
+{
+  const char *env = std::getenv("GAZEBO_TRANSPORT_COMPRESSION_MIN");
+  if (env)
+  {
+    int size = std::atoi(env);
+    if (size > 0)
+      return size;
+  }
+  return kDefaultMinSize;
+}
+
+//////////////////////////////////////////////////
+bool Compression::IsCompressed(const std::string &_data)
+{
+  // A single zero byte is the shared memory marker, see ShmRing
+  return _data.size() > 2 && _data[0] == kFramePrefix;
+}
+
+//////////////////////////////////////////////////
+bool Compression::Compress(const std::string &_data, std::string &_frame)
+{
+  _frame.clear();
+  _frame.reserve(_data.size() / 2);
+  _frame.push_back(kFramePrefix);
+  _frame.push_back(kZlibCodec);
+
+  try
+  {
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor(
+          boost::iostreams::zlib::best_speed));
+    out.push(std::back_inserter(_frame));
+    boost::iostreams::copy(boost::make_iterator_range(_data), out);
+  }
+  catch(boost::iostreams::zlib_error &_e)
+  {
+    gzerr << "Unable to compress message: " << _e.what() << std::endl;
+    return false;
+  }
+
+  return _frame.size() < _data.size();
+}
+
+//////////////////////////////////////////////////
+bool Compression::Decompress(const std::string &_frame, std::string &_data)
+{
+  _data.clear();
+  if (!IsCompressed(_frame) || _frame[1] != kZlibCodec)
+    return false;
+
+  try
+  {
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::make_iterator_range(_frame.begin() + 2, _frame.end()));
+
+    char buffer[4096];
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+    {
+      _data.append(buffer, in.gcount());
+      if (_data.size() > kMaxSize)
+        return false;
+    }
+
+    // Errors of the decompressor are reported through the stream state
+    if (in.bad())
+      return false;
+  }
+  catch(boost::iostreams::zlib_error &)
+  {
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_COMPRESSION_HH_
+#define GAZEBO_TRANSPORT_COMPRESSION_HH_
+
+#include <cstddef>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class Compression Compression.hh transport/transport.hh
+    /// \brief Compression of the messages sent to remote subscribers.
+    ///
+    /// A subscriber on another host asks for compression by setting
+    /// msgs::Subscribe::compression when GAZEBO_TRANSPORT_COMPRESSION is
+    /// set to "zlib". The publisher then compresses the messages larger
+    /// than GAZEBO_TRANSPORT_COMPRESSION_MIN bytes, on its side. A
+    /// compressed message is framed as a zero byte, the codec byte and
+    /// the compressed data. A serialized protobuf message never starts
+    /// with a zero byte, so the frames need no other marker, and
+    /// publishers that don't compress keep working.
+    class GZ_TRANSPORT_VISIBLE Compression
+    {
+      /// \brief Name of the zlib codec in msgs::Subscribe::compression.
+      public: static const char *const kZlib;
+
+      /// \brief Default size in bytes above which messages are compressed.
+      public: static const std::size_t kDefaultMinSize = 1024;
+
+      /// \brief Largest decompressed message, to protect the subscriber
+      /// from corrupted frames.
+      public: static const std::size_t kMaxSize = 512 * 1024 * 1024;
+
+      /// \brief Get the codec that subscribers ask for.
+      /// \return The codec name, empty if compression isn't wanted.
+      public: static std::string RequestedCodec();
+
+      /// \brief Get the size above which publishers compress messages.
+      /// \return Minimum message size in bytes.
+      public: static std::size_t MinSize();
+
+      /// \brief Check whether a message is a compressed frame.
+      /// \param[in] _data The message, as read from the connection.
+      /// \return True if the message must be decompressed.
+      public: static bool IsCompressed(const std::string &_data);
+
+      /// \brief Compress a message with zlib.
+      /// \param[in] _data Serialized message.
+      /// \param[out] _frame The compressed frame.
+      /// \return False if the frame wouldn't be smaller than the message,
+      /// in which case the message is sent as it is.
+      public: static bool Compress(const std::string &_data,
+                                   std::string &_frame);
+
+      /// \brief Decompress a frame made by Compress().
+      /// \param[in] _frame The compressed frame.
+      /// \param[out] _data Serialized message.
+      /// \return False if the frame is invalid.
+      public: static bool Decompress(const std::string &_frame,
+                                     std::string &_data);
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <string>
+
+#include "gazebo/transport/Compression.hh"
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class CompressionTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(CompressionTest, RoundTrip)
+{
+  std::string data;
+  for (int i = 0; i < 2000; ++i)
+    data += "pose " + std::to_string(i % 10) + " ";
+
+  std::string frame;
+  ASSERT_TRUE(transport::Compression::Compress(data, frame));
+  EXPECT_LT(frame.size(), data.size());
+  EXPECT_TRUE(transport::Compression::IsCompressed(frame));
+  EXPECT_FALSE(transport::Compression::IsCompressed(data));
+
+  std::string result;
+  ASSERT_TRUE(transport::Compression::Decompress(frame, result));
+  EXPECT_EQ(data, result);
+
+  // Binary data, with zero bytes
+  std::string binary(5000, '\0');
+  for (size_t i = 0; i < binary.size(); i += 7)
+    binary[i] = static_cast<char>(i);
+  ASSERT_TRUE(transport::Compression::Compress(binary, frame));
+  ASSERT_TRUE(transport::Compression::Decompress(frame, result));
+  EXPECT_EQ(binary, result);
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressionTest, Incompressible)
+{
+  // Data that doesn't get smaller is sent as it is
+  std::string data;
+  unsigned int seed = 1;
+  for (int i = 0; i < 64; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    data.push_back(static_cast<char>(seed >> 16));
+  }
+
+  std::string frame;
+  EXPECT_FALSE(transport::Compression::Compress(data, frame));
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressionTest, InvalidFrames)
+{
+  std::string result;
+
+  // The shared memory marker isn't a frame
+  std::string marker(1, transport::ShmRing::kMarker);
+  EXPECT_FALSE(transport::Compression::IsCompressed(marker));
+  EXPECT_FALSE(transport::Compression::Decompress(marker, result));
+
+  // Unknown codec
+  std::string frame("\0x123", 5);
+  EXPECT_TRUE(transport::Compression::IsCompressed(frame));
+  EXPECT_FALSE(transport::Compression::Decompress(frame, result));
+
+  // Corrupted data
+  frame = std::string("\0zcorrupted data", 16);
+  EXPECT_FALSE(transport::Compression::Decompress(frame, result));
+}
+
+/////////////////////////////////////////////////
+TEST_F(CompressionTest, Environment)
+{
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION_MIN");
+  EXPECT_TRUE(transport::Compression::RequestedCodec().empty());
+  EXPECT_EQ(transport::Compression::kDefaultMinSize,
+      transport::Compression::MinSize());
+
+  setenv("GAZEBO_TRANSPORT_COMPRESSION", "zlib", 1);
+  setenv("GAZEBO_TRANSPORT_COMPRESSION_MIN", "100", 1);
+  EXPECT_EQ(std::string(transport::Compression::kZlib),
+      transport::Compression::RequestedCodec());
+  EXPECT_EQ(100u, transport::Compression::MinSize());
+
+  setenv("GAZEBO_TRANSPORT_COMPRESSION", "lz4", 1);
+  EXPECT_TRUE(transport::Compression::RequestedCodec().empty());
+
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION");
+  unsetenv("GAZEBO_TRANSPORT_COMPRESSION_MIN");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
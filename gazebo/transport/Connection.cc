@@ -46,14 +46,21 @@
   #include <ifaddrs.h>
 #endif
 
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include <memory>
+#include <unordered_map>
 
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/LockProfiler.hh"
+#include "gazebo/common/MemoryAccounts.hh"
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/transport/IOManager.hh"
@@ -67,6 +74,68 @@ extern void dummy_callback_fn(uint32_t);
 
 unsigned int Connection::idCounter = 0;
 IOManager *Connection::iomanager = NULL;
+const std::size_t Connection::kDefaultWriteLimit;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data of a Connection.
+    class ConnectionPrivate
+    {
+      /// \brief Outgoing data queue. Each entry is written to the socket
+      /// with a single gather-write of its buffers. Small messages are
+      /// coalesced, with their headers, into one buffer. A large message
+      /// gets its own entry with separate header and payload buffers, so
+      /// the payload is never concatenated with anything.
+      public: std::deque<std::vector<std::string> > writeQueue;
+
+      /// \brief Byte size of each entry in writeQueue.
+      public: std::deque<std::size_t> writeQueueSizes;
+
+      /// \brief Buffer sequence for the entry being written.
+      public: std::vector<boost::asio::const_buffer> writeBuffers;
+
+      /// \brief Bytes that the write queue can hold, 0 for no limit.
+      public: std::size_t writeLimit = 0;
+
+      /// \brief What to drop when the write queue is full.
+      public: Connection::WritePolicy writePolicy = Connection::DROP_OLDEST;
+
+      /// \brief Write queue metrics, protected by writeMutex.
+      public: WriteQueueStats writeStats;
+
+      /// \brief Share of the write queue in the memory accounts, protected
+      /// by writeMutex.
+      public: common::MemoryUsage writeMemory{"transport/write_queues"};
+
+      /// \brief Mutex to protect write.
+      public: common::ProfiledMutex<boost::recursive_mutex>
+              writeMutex{"transport/connection_write"};
+
+      /// \brief Content data from a new message.
+      public: std::string inboundData;
+    };
+
+    /// \internal
+    /// \brief Private data of all the connections.
+    struct ConnectionPrivates
+    {
+      /// \brief Mutex to protect data.
+      boost::shared_mutex mutex;
+
+      /// \brief Private data of each connection.
+      std::unordered_map<const Connection *,
+          std::unique_ptr<ConnectionPrivate>> data;
+    };
+  }
+}
+
+// TODO added here for ABI compatibility
+// move to a dataPtr member of Connection when merging forward.
+// Never freed, because connections can outlive static destruction.
+static ConnectionPrivates *connectionPrivates = new ConnectionPrivates();
 
 // Version 1.52 of boost has an address::is_unspecfied function, but
 // Version 1.46.1 (installed on ubuntu) does not. So this helper function
@@ -87,6 +156,11 @@ static bool addressIsLoopback(const boost::asio::ip::address_v4 &_addr)
 //////////////////////////////////////////////////
 Connection::Connection()
 {
+  {
+    boost::unique_lock<boost::shared_mutex> lock(connectionPrivates->mutex);
+    connectionPrivates->data[this].reset(new ConnectionPrivate());
+  }
+
   this->isOpen = false;
   this->dropMsgLogged = false;
 
@@ -101,7 +175,6 @@ Connection::Connection()
   this->acceptor = NULL;
   this->readQuit = false;
   this->connectError = false;
-  this->writeQueue.clear();
   this->writeCount = 0;
 
   this->localURI = std::string("http://") + this->GetLocalHostname() + ":" +
@@ -136,6 +209,9 @@ Connection::~Connection()
       iomanager = NULL;
     }
   }
+
+  boost::unique_lock<boost::shared_mutex> lock(connectionPrivates->mutex);
+  connectionPrivates->data.erase(this);
 }
 
 //////////////////////////////////////////////////
@@ -296,32 +372,66 @@ void Connection::EnqueueMsg(const std::string &_buffer, bool _force)
 void Connection::EnqueueMsg(const std::string &_buffer,
     boost::function<void(uint32_t)> _cb, uint32_t _id, bool _force)
 {
+  ConnectionPrivate *dataPtr = this->Private();
   // Don't enqueue empty messages
   if (_buffer.empty() || !this->IsOpen())
   {
     return;
   }
 
+  // Messages up to this size are coalesced into a single buffer.
+  static const std::size_t kCoalesceSize = 4096;
+
   char headerBuffer[HEADER_LENGTH + 1];
   snprintf(headerBuffer, HEADER_LENGTH + 1, "%08x",
       static_cast<unsigned int>(_buffer.size()));
 
   {
-    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+        dataPtr->writeMutex);
+
+    std::size_t msgSize = HEADER_LENGTH + _buffer.size();
+    if (dataPtr->writeLimit > 0)
+      this->EnforceWriteLimit(msgSize);
 
-    if (this->writeQueue.empty() ||
-        (this->writeCount > 0 && this->writeQueue.size() == 1) ||
-        (this->writeQueue.back().size() + HEADER_LENGTH + _buffer.size() >
-         4096))
+    if (dataPtr->writeQueue.empty() ||
+        (this->writeCount > 0 && dataPtr->writeQueue.size() == 1) ||
+        (dataPtr->writeQueueSizes.back() + msgSize > kCoalesceSize))
     {
-      this->writeQueue.push_back(std::string(headerBuffer) + _buffer);
+      dataPtr->writeQueue.emplace_back();
+      dataPtr->writeQueueSizes.push_back(0);
       this->callbacks.push_back({std::make_pair(_cb, _id)});
     }
     else
     {
-      this->writeQueue.back() += std::string(headerBuffer) + _buffer;
       this->callbacks.back().push_back(std::make_pair(_cb, _id));
     }
+
+    std::vector<std::string> &buffers = dataPtr->writeQueue.back();
+    if (msgSize > kCoalesceSize)
+    {
+      // Large message, keep the payload in its own buffer.
+      buffers.emplace_back(headerBuffer, HEADER_LENGTH);
+      buffers.push_back(_buffer);
+    }
+    else
+    {
+      if (buffers.empty())
+      {
+        buffers.emplace_back();
+        buffers.back().reserve(kCoalesceSize);
+      }
+      buffers.back().append(headerBuffer, HEADER_LENGTH);
+      buffers.back().append(_buffer);
+    }
+    dataPtr->writeQueueSizes.back() += msgSize;
+
+    dataPtr->writeStats.queuedBytes += msgSize;
+    dataPtr->writeStats.queuedMessages++;
+    dataPtr->writeStats.maxQueuedBytes = std::max(
+        dataPtr->writeStats.maxQueuedBytes, dataPtr->writeStats.queuedBytes);
+    dataPtr->writeMemory.Set(dataPtr->writeStats.queuedBytes,
+        dataPtr->writeStats.queuedMessages);
   }
 
   if (_force)
@@ -338,7 +448,9 @@ void Connection::EnqueueMsg(const std::string &_buffer,
 /////////////////////////////////////////////////
 void Connection::ProcessWriteQueue(bool _blocking)
 {
-  boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+  ConnectionPrivate *dataPtr = this->Private();
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+      dataPtr->writeMutex);
 
   if (!this->IsOpen())
   {
@@ -347,21 +459,25 @@ void Connection::ProcessWriteQueue(bool _blocking)
 
   // async_write should only be called when the last async_write has
   // completed. therefore we have to check the writeCount attribute
-  if (this->writeQueue.empty() || this->writeCount > 0)
+  if (dataPtr->writeQueue.empty() || this->writeCount > 0)
   {
     return;
   }
 
   this->writeCount++;
 
+  // The strings in the front entry aren't modified until PostWrite pops
+  // it, so the buffer sequence can point straight at them.
+  dataPtr->writeBuffers.clear();
+  for (auto const &buffer : dataPtr->writeQueue.front())
+    dataPtr->writeBuffers.push_back(boost::asio::buffer(buffer));
+
   // Write the serialized data to the socket. We use
   // "gather-write" to send both the head and the data in
   // a single write operation
   if (!_blocking)
   {
-    boost::asio::async_write(*this->socket,
-        boost::asio::buffer(this->writeQueue.front().c_str(),
-          this->writeQueue.front().size()),
+    boost::asio::async_write(*this->socket, dataPtr->writeBuffers,
           common::weakBind(&Connection::OnWrite, this->shared_from_this(),
             boost::asio::placeholders::error));
   }
@@ -369,9 +485,7 @@ void Connection::ProcessWriteQueue(bool _blocking)
   {
     try
     {
-      boost::asio::write(*this->socket,
-          boost::asio::buffer(this->writeQueue.front().c_str(),
-            this->writeQueue.front().size()));
+      boost::asio::write(*this->socket, dataPtr->writeBuffers);
     }
     catch(...)
     {
@@ -382,6 +496,95 @@ void Connection::ProcessWriteQueue(bool _blocking)
   }
 }
 
+//////////////////////////////////////////////////
+void Connection::SetWriteLimit(const std::size_t _bytes,
+    const WritePolicy _policy)
+{
+  ConnectionPrivate *dataPtr = this->Private();
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+      dataPtr->writeMutex);
+  dataPtr->writeLimit = _bytes;
+  dataPtr->writePolicy = _policy;
+}
+
+//////////////////////////////////////////////////
+void Connection::SetDefaultWriteLimit()
+{
+  std::size_t limit = kDefaultWriteLimit;
+  const char *limitEnv = getenv("GAZEBO_WRITE_QUEUE_LIMIT");
+  if (limitEnv && *limitEnv)
+  {
+    try
+    {
+      limit = boost::lexical_cast<std::size_t>(limitEnv);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_WRITE_QUEUE_LIMIT[" << limitEnv << "]\n";
+    }
+  }
+
+  WritePolicy policy = DROP_OLDEST;
+  const char *policyEnv = getenv("GAZEBO_WRITE_QUEUE_POLICY");
+  if (policyEnv && std::string(policyEnv) == "latest_only")
+    policy = LATEST_ONLY;
+  else if (policyEnv && *policyEnv && std::string(policyEnv) != "drop_oldest")
+    gzwarn << "Invalid GAZEBO_WRITE_QUEUE_POLICY[" << policyEnv << "]\n";
+
+  this->SetWriteLimit(limit, policy);
+}
+
+//////////////////////////////////////////////////
+WriteQueueStats Connection::WriteStats() const
+{
+  ConnectionPrivate *dataPtr = this->Private();
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+      dataPtr->writeMutex);
+  return dataPtr->writeStats;
+}
+
+//////////////////////////////////////////////////
+void Connection::EnforceWriteLimit(const std::size_t _size)
+{
+  ConnectionPrivate *dataPtr = this->Private();
+  if (dataPtr->writeStats.queuedBytes + _size <= dataPtr->writeLimit)
+    return;
+
+  // The front entry may be in the socket already
+  const std::size_t first = this->writeCount > 0 ? 1 : 0;
+  std::size_t dropped = 0;
+  while (dataPtr->writeQueue.size() > first &&
+      (dataPtr->writePolicy == LATEST_ONLY ||
+       dataPtr->writeStats.queuedBytes + _size > dataPtr->writeLimit))
+  {
+    const std::size_t bytes = dataPtr->writeQueueSizes[first];
+    dataPtr->writeStats.queuedBytes -= bytes;
+    dataPtr->writeStats.queuedMessages -= this->callbacks[first].size();
+    dataPtr->writeStats.droppedBytes += bytes;
+    dataPtr->writeStats.droppedMessages += this->callbacks[first].size();
+    dropped += this->callbacks[first].size();
+
+    // The publisher still waits for the dropped messages
+    for (auto const &callback : this->callbacks[first])
+      if (!callback.first.empty())
+        callback.first(callback.second);
+
+    dataPtr->writeQueue.erase(dataPtr->writeQueue.begin() + first);
+    dataPtr->writeQueueSizes.erase(dataPtr->writeQueueSizes.begin() + first);
+    this->callbacks.erase(this->callbacks.begin() + first);
+  }
+  dataPtr->writeMemory.Set(dataPtr->writeStats.queuedBytes,
+      dataPtr->writeStats.queuedMessages);
+
+  if (dropped > 0 && !this->dropMsgLogged)
+  {
+    gzwarn << "Write queue to " << this->GetRemoteURI() << " is over "
+           << dataPtr->writeLimit << " bytes, dropped " << dropped
+           << " messages. This warning is printed only once.\n";
+    this->dropMsgLogged = true;
+  }
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetLocalURI() const
 {
@@ -397,25 +600,37 @@ std::string Connection::GetRemoteURI() const
 //////////////////////////////////////////////////
 void Connection::PostWrite()
 {
+  ConnectionPrivate *dataPtr = this->Private();
   // Call the callbacks, if not NULL
   if (!this->callbacks.empty())
   {
     for (auto const &callback : this->callbacks.front())
       if (!callback.first.empty())
         callback.first(callback.second);
+    dataPtr->writeStats.queuedMessages -= this->callbacks.front().size();
+    dataPtr->writeStats.writtenMessages += this->callbacks.front().size();
     this->callbacks.pop_front();
   }
 
-  if (!this->writeQueue.empty())
-    this->writeQueue.pop_front();
+  if (!dataPtr->writeQueue.empty())
+  {
+    dataPtr->writeStats.queuedBytes -= dataPtr->writeQueueSizes.front();
+    dataPtr->writeStats.writtenBytes += dataPtr->writeQueueSizes.front();
+    dataPtr->writeQueue.pop_front();
+    dataPtr->writeQueueSizes.pop_front();
+  }
+  dataPtr->writeMemory.Set(dataPtr->writeStats.queuedBytes,
+      dataPtr->writeStats.queuedMessages);
   this->writeCount--;
 }
 
 //////////////////////////////////////////////////
 void Connection::OnWrite(const boost::system::error_code &_e)
 {
+  ConnectionPrivate *dataPtr = this->Private();
   {
-    boost::recursive_mutex::scoped_lock lock(this->writeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+        dataPtr->writeMutex);
 
     this->PostWrite();
   }
@@ -451,6 +666,7 @@ bool Connection::IsOpen() const
 //////////////////////////////////////////////////
 void Connection::Close()
 {
+  ConnectionPrivate *dataPtr = this->Private();
   boost::mutex::scoped_lock lock(this->socketMutex);
 
   if (this->socket && this->socket->is_open())
@@ -487,9 +703,14 @@ void Connection::Close()
     this->acceptor = NULL;
   }
 
-  boost::recursive_mutex::scoped_lock lock2(this->writeMutex);
-  this->writeQueue.clear();
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock2(
+      dataPtr->writeMutex);
+  dataPtr->writeQueue.clear();
+  dataPtr->writeQueueSizes.clear();
   this->callbacks.clear();
+  dataPtr->writeStats.queuedBytes = 0;
+  dataPtr->writeStats.queuedMessages = 0;
+  dataPtr->writeMemory.Set(0, 0);
 }
 
 //////////////////////////////////////////////////
@@ -531,7 +752,6 @@ bool Connection::Read(std::string &data)
 {
   bool result = false;
   char header[HEADER_LENGTH];
-  std::vector<char> incoming;
 
   std::size_t incoming_size;
   boost::system::error_code error;
@@ -551,13 +771,14 @@ bool Connection::Read(std::string &data)
   incoming_size = this->ParseHeader(std::string(header, HEADER_LENGTH));
   if (incoming_size > 0)
   {
-    incoming.resize(incoming_size);
+    // Read straight into the output string
+    data.resize(incoming_size);
 
     std::size_t len = 0;
     do
     {
       // Read in the actual data
-      len += this->socket->read_some(boost::asio::buffer(&incoming[len],
+      len += this->socket->read_some(boost::asio::buffer(&data[len],
             incoming_size - len), error);
     } while (len < incoming_size && !error && !this->readQuit);
 
@@ -570,7 +791,6 @@ bool Connection::Read(std::string &data)
     if (error)
       throw boost::system::system_error(error);
 
-    data = std::string(&incoming[0], incoming.size());
     result = true;
   }
 
@@ -987,6 +1207,19 @@ unsigned int Connection::GetId() const
   return this->id;
 }
 
+//////////////////////////////////////////////////
+ConnectionPrivate *Connection::Private() const
+{
+  boost::shared_lock<boost::shared_mutex> lock(connectionPrivates->mutex);
+  return connectionPrivates->data.at(this).get();
+}
+
+//////////////////////////////////////////////////
+std::string &Connection::InboundData()
+{
+  return this->Private()->inboundData;
+}
+
 //////////////////////////////////////////////////
 std::string Connection::GetIPWhiteList() const
 {
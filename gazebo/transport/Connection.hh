@@ -26,6 +26,8 @@
 #include <boost/thread.hpp>
 #include <boost/tuple/tuple.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -49,6 +51,7 @@ namespace gazebo
 
     class IOManager;
     class Connection;
+    class ConnectionPrivate;
     typedef boost::shared_ptr<Connection> ConnectionPtr;
 
     /// \cond
@@ -62,9 +65,9 @@ namespace gazebo
       /// \param[in] _data Data to send to the boost function pointer.
       public: ConnectionReadTask(
                   boost::function<void (const std::string &)> _func,
-                  const std::string &_data) :
+                  std::string _data) :
                 func(_func),
-                data(_data)
+                data(std::move(_data))
               {
               }
 
@@ -84,6 +87,31 @@ namespace gazebo
     };
     /// \endcond
 
+    /// \brief Write queue metrics of a connection.
+    class GZ_TRANSPORT_VISIBLE WriteQueueStats
+    {
+      /// \brief Bytes waiting in the write queue.
+      public: std::size_t queuedBytes = 0;
+
+      /// \brief Messages waiting in the write queue.
+      public: std::size_t queuedMessages = 0;
+
+      /// \brief Largest number of bytes that waited in the write queue.
+      public: std::size_t maxQueuedBytes = 0;
+
+      /// \brief Bytes written to the socket, headers included.
+      public: uint64_t writtenBytes = 0;
+
+      /// \brief Messages written to the socket.
+      public: uint64_t writtenMessages = 0;
+
+      /// \brief Bytes dropped because the queue was over its limit.
+      public: uint64_t droppedBytes = 0;
+
+      /// \brief Messages dropped because the queue was over its limit.
+      public: uint64_t droppedMessages = 0;
+    };
+
     /// \addtogroup gazebo_transport Transport
     /// \{
     ///
@@ -95,12 +123,33 @@ namespace gazebo
     /// IP lookup.
     ///   - GAZEBO_HOSTNAME: Hostame to export. Setting this will override
     /// both GAZEBO_IP and the default IP lookup.
+    ///   - GAZEBO_SHM: Set to 0 to keep subscribers from offering a shared
+    /// memory ring to publishers on the same host.
+    ///   - GAZEBO_WRITE_QUEUE_LIMIT: Bytes that a connection to a remote
+    /// subscriber can queue, 0 for no limit. Defaults to 256 MiB.
+    ///   - GAZEBO_WRITE_QUEUE_POLICY: "drop_oldest" (default) or
+    /// "latest_only", see Connection::WritePolicy.
     ///
     /// \class Connection Connection.hh transport/transport.hh
     /// \brief Single TCP/IP connection manager
     class GZ_TRANSPORT_VISIBLE Connection :
       public boost::enable_shared_from_this<Connection>
     {
+      /// \brief What a connection drops when a new message would take its
+      /// write queue over the limit. The message being written is never
+      /// dropped, and neither is the new message.
+      public: enum WritePolicy
+              {
+                /// \brief Drop the oldest messages until the new one fits.
+                DROP_OLDEST,
+
+                /// \brief Drop every queued message.
+                LATEST_ONLY
+              };
+
+      /// \brief Default write queue limit, in bytes.
+      public: static const std::size_t kDefaultWriteLimit = 256 * 1024 * 1024;
+
       /// \brief Constructor
       public: Connection();
 
@@ -250,15 +299,18 @@ namespace gazebo
 
                  if (inboundData_size > 0)
                   {
-                    // Start the asynchronous call to receive data
-                    this->inboundData.resize(inboundData_size);
+                    // Start the asynchronous call to receive data directly
+                    // into the string that is handed to the callback.
+                    std::string &inboundData = this->InboundData();
+                    inboundData.resize(inboundData_size);
 
                     void (Connection::*f)(const boost::system::error_code &e,
                         boost::tuple<Handler>) =
                       &Connection::OnReadData<Handler>;
 
                     boost::asio::async_read(*this->socket,
-                        boost::asio::buffer(this->inboundData),
+                        boost::asio::buffer(&inboundData[0],
+                                            inboundData.size()),
                         common::weakBind(f, this->shared_from_this(),
                                     boost::asio::placeholders::error,
                                     _handler));
@@ -300,10 +352,10 @@ namespace gazebo
                     this->isOpen = false;
                 }
 
-                // Inform caller that data has been received
-                std::string data(&this->inboundData[0],
-                                  this->inboundData.size());
-                this->inboundData.clear();
+                // Inform caller that data has been received. The data is
+                // moved out of inboundData, not copied.
+                std::string data;
+                data.swap(this->InboundData());
 
                 if (data.empty())
                   gzerr << "OnReadData got empty data!!!\n";
@@ -311,7 +363,8 @@ namespace gazebo
                 if (!_e && !transport::is_stopped())
                 {
                   ConnectionReadTask *task = new(tbb::task::allocate_root())
-                        ConnectionReadTask(boost::get<0>(_handler), data);
+                        ConnectionReadTask(boost::get<0>(_handler),
+                                           std::move(data));
                   tbb::task::enqueue(*task);
 
                   // Non-tbb version:
@@ -329,6 +382,22 @@ namespace gazebo
       /// \brief Handle on-write callbacks
       public: void ProcessWriteQueue(bool _blocking = false);
 
+      /// \brief Limit the bytes waiting in the write queue. Without a
+      /// limit, a slow peer makes the queue grow without bound.
+      /// \param[in] _bytes Limit, 0 for no limit.
+      /// \param[in] _policy What to drop when the limit is reached.
+      public: void SetWriteLimit(const std::size_t _bytes,
+                                 const WritePolicy _policy);
+
+      /// \brief Set the write queue limit from GAZEBO_WRITE_QUEUE_LIMIT
+      /// and GAZEBO_WRITE_QUEUE_POLICY. Used for the connections to
+      /// remote subscribers.
+      public: void SetDefaultWriteLimit();
+
+      /// \brief Get the write queue metrics.
+      /// \return Copy of the metrics.
+      public: WriteQueueStats WriteStats() const;
+
       /// \brief Get the ID of the connection.
       /// \return The connection's unique ID.
       public: unsigned int GetId() const;
@@ -347,6 +416,11 @@ namespace gazebo
       /// Called afer a write is finished.
       private: void PostWrite();
 
+      /// \brief Drop queued messages to make room for a new one, according
+      /// to the write policy. writeMutex must be locked.
+      /// \param[in] _size Size of the new message, header included.
+      private: void EnforceWriteLimit(const std::size_t _size);
+
       /// \brief Callback when a write has occurred.
       /// \param[in] _e Error code
       /// \param[in] _b Buffer of the data that was written.
@@ -382,13 +456,22 @@ namespace gazebo
       private: void OnConnect(const boost::system::error_code &_error,
                   boost::asio::ip::tcp::resolver::iterator _endPointIter);
 
+      /// \brief Get the private data of the connection.
+      /// \return The private data.
+      private: ConnectionPrivate *Private() const;
+
+      /// \brief Get the buffer that a message body is read into.
+      /// \return The buffer, which the read handler swaps out.
+      private: std::string &InboundData();
+
       /// \brief Socket pointer
       private: boost::asio::ip::tcp::socket *socket;
 
       /// \brief Accepts new connections.
       private: boost::asio::ip::tcp::acceptor *acceptor;
 
-      /// \brief Outgoing data queue
+      /// \brief Unused, see ConnectionPrivate::writeQueue. Kept for ABI
+      /// compatibility.
       private: std::deque<std::string> writeQueue;
 
       /// \brief List of callbacks, paired with writeQueue. The callbacks
@@ -400,7 +483,8 @@ namespace gazebo
       /// \brief Mutex to protect new connections.
       private: boost::mutex connectMutex;
 
-      /// \brief Mutex to protect write.
+      /// \brief Unused, see ConnectionPrivate::writeMutex. Kept for ABI
+      /// compatibility.
       private: boost::recursive_mutex writeMutex;
 
       /// \brief Mutex to protect reads.
@@ -418,7 +502,7 @@ namespace gazebo
       /// \brief Header data from a new message.
       private: std::vector<char> inboundHeader;
 
-      /// \brief Content data from a new message.
+      /// \brief Unused, see InboundData(). Kept for ABI compatibility.
       private: std::vector<char> inboundData;
 
       /// \brief Set to true to stop reading on the connection.
@@ -460,7 +544,8 @@ namespace gazebo
       /// \brief Comma separated list of valid IP addresses.
       private: std::string ipWhiteList;
 
-      /// \brief Used to prevent too many log messages.
+      /// \brief Used to log the first message dropped from the write
+      /// queue only.
       private: bool dropMsgLogged;
 
       /// \brief True if the connection is open.
@@ -19,6 +19,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/transport/MulticastChannel.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 
@@ -144,6 +145,13 @@ bool ConnectionManager::Init(const std::string &_masterHost,
       // TODO: set some flag.. maybe start "serverConn" when initialized
       gzmsg << "Connected to gazebo master @ "
             << this->masterConn->GetRemoteURI() << std::endl;
+
+      // A master of our version batches the publisher notifications of
+      // the connections that ask for it. Older clients never ask, so they
+      // keep getting a notification per publisher.
+      msgs::Empty batchingMsg;
+      this->masterConn->EnqueueMsg(
+          msgs::Package("publishers_batching", batchingMsg), true);
     }
     else
     {
@@ -355,6 +363,13 @@ void ConnectionManager::ProcessMessage(const std::string &_data)
     result.ParseFromString(packet.serialized_data());
     this->publishers.push_back(result);
   }
+  else if (packet.type() == "publishers_add")
+  {
+    msgs::Publishers result;
+    result.ParseFromString(packet.serialized_data());
+    for (int i = 0; i < result.publisher_size(); ++i)
+      this->publishers.push_back(result.publisher(i));
+  }
   else if (packet.type() == "publisher_del")
   {
     msgs::Publish result;
@@ -407,6 +422,24 @@ void ConnectionManager::ProcessMessage(const std::string &_data)
       tbb::task::enqueue(*task);
     }
   }
+  // The publishers advertised by the master at the same time, which are
+  // connected to as publisher_advertise does.
+  else if (packet.type() == "publishers_advertise")
+  {
+    msgs::Publishers pubs;
+    pubs.ParseFromString(packet.serialized_data());
+    for (int i = 0; i < pubs.publisher_size(); ++i)
+    {
+      const msgs::Publish &pub = pubs.publisher(i);
+      if (pub.host() != this->serverConn->GetLocalAddress() ||
+          pub.port() != this->serverConn->GetLocalPort())
+      {
+        TopicManagerConnectionTask *task = new(tbb::task::allocate_root())
+        TopicManagerConnectionTask(pub);
+        tbb::task::enqueue(*task);
+      }
+    }
+  }
   // publisher_subscribe. This occurs when we try to subscribe to a topic, and
   // the master informs us of a remote host that is publishing on our
   // requested topic
@@ -482,6 +515,20 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
     // via the connection
     SubscriptionTransportPtr subLink(new SubscriptionTransport());
     subLink->Init(_connection, sub.latching());
+    subLink->SetLatestOnly(sub.latest_only());
+    if (sub.has_shm_name())
+      subLink->InitSharedMemory(sub.shm_name());
+    if (sub.has_compression())
+      subLink->InitCompression(sub.compression());
+    subLink->SetMulticast(sub.multicast());
+
+    // Bound the messages queued for a slow subscriber
+    _connection->SetDefaultWriteLimit();
+    {
+      boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+      this->subscriberConnections.push_back(std::make_pair(sub.topic(),
+            boost::weak_ptr<Connection>(_connection)));
+    }
 
     // Connect the publisher to this transport mechanism
     TopicManager::Instance()->ConnectPubToSub(sub.topic(), subLink);
@@ -492,7 +539,8 @@ void ConnectionManager::OnRead(ConnectionPtr _connection,
 
 //////////////////////////////////////////////////
 void ConnectionManager::Advertise(const std::string &topic,
-                                  const std::string &msgType)
+                                  const std::string &msgType,
+                                  const uint32_t _multicastId)
 {
   if (!this->initialized)
     return;
@@ -502,6 +550,12 @@ void ConnectionManager::Advertise(const std::string &topic,
   msg.set_msg_type(msgType);
   msg.set_host(this->serverConn->GetLocalAddress());
   msg.set_port(this->serverConn->GetLocalPort());
+  if (_multicastId)
+  {
+    msg.set_multicast_group(MulticastChannel::Group());
+    msg.set_multicast_port(MulticastChannel::Port());
+    msg.set_multicast_id(_multicastId);
+  }
 
   this->masterConn->EnqueueMsg(msgs::Package("advertise", msg));
 }
@@ -672,6 +726,39 @@ void ConnectionManager::RemoveConnection(ConnectionPtr &_conn)
   }
 }
 
+//////////////////////////////////////////////////
+void ConnectionManager::GetConnectionStats(
+    msgs::ConnectionStatistics &_stats)
+{
+  _stats.Clear();
+  msgs::Set(_stats.mutable_stamp(), common::Time::GetWallTime());
+
+  boost::recursive_mutex::scoped_lock lock(this->connectionMutex);
+  auto iter = this->subscriberConnections.begin();
+  while (iter != this->subscriberConnections.end())
+  {
+    ConnectionPtr conn = iter->second.lock();
+    if (!conn || !conn->IsOpen())
+    {
+      iter = this->subscriberConnections.erase(iter);
+      continue;
+    }
+
+    WriteQueueStats stats = conn->WriteStats();
+    msgs::ConnectionStatistics::Connection *msg = _stats.add_connection();
+    msg->set_topic(iter->first);
+    msg->set_remote_uri(conn->GetRemoteURI());
+    msg->set_queued_bytes(stats.queuedBytes);
+    msg->set_queued_messages(stats.queuedMessages);
+    msg->set_max_queued_bytes(stats.maxQueuedBytes);
+    msg->set_written_bytes(stats.writtenBytes);
+    msg->set_written_messages(stats.writtenMessages);
+    msg->set_dropped_bytes(stats.droppedBytes);
+    msg->set_dropped_messages(stats.droppedMessages);
+    ++iter;
+  }
+}
+
 //////////////////////////////////////////////////
 ConnectionPtr ConnectionManager::FindConnection(const std::string &_host,
                                                  unsigned int _port)
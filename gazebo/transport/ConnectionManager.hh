@@ -19,9 +19,11 @@
 
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 #include <string>
 #include <list>
+#include <utility>
 #include <vector>
 
 #include "gazebo/msgs/msgs.hh"
@@ -102,8 +104,11 @@ namespace gazebo
       /// \brief Advertise a topic
       /// \param[in] _topic The topic to advertise
       /// \param[in] _msgType The type of the topic
+      /// \param[in] _multicastId Sender id of the multicast channel of
+      /// the publication, 0 if it has none.
       public: void Advertise(const std::string &_topic,
-                              const std::string &_msgType);
+                              const std::string &_msgType,
+                              const uint32_t _multicastId = 0);
 
       /// \brief Unadvertise a topic
       /// \param[in] _topic The topic to unadvertise
@@ -125,6 +130,11 @@ namespace gazebo
       /// \param[out] _namespaces The list of namespace is written here
       public: void GetTopicNamespaces(std::list<std::string> &_namespaces);
 
+      /// \brief Get the write queue metrics of the connections to remote
+      /// subscribers.
+      /// \param[out] _stats One entry per open connection.
+      public: void GetConnectionStats(msgs::ConnectionStatistics &_stats);
+
       /// \brief Find a connection that matches a host and port
       /// \param[in] _host The host of the connection
       /// \param[in] _port The port of the connection
@@ -174,6 +184,11 @@ namespace gazebo
       private: ConnectionPtr serverConn;
 
       private: std::list<ConnectionPtr> connections;
+
+      /// \brief Topics and connections of the remote subscribers, for
+      /// GetConnectionStats. Protected by connectionMutex.
+      private: std::list<std::pair<std::string, boost::weak_ptr<Connection> > >
+               subscriberConnections;
       protected: std::vector<event::ConnectionPtr> eventConnections;
 
       private: bool initialized;
@@ -16,9 +16,13 @@
 */
 
 #include <gtest/gtest.h>
+#include <boost/bind.hpp>
 #include <string>
+#include <thread>
+#include <vector>
 #include <stdlib.h>
 
+#include "gazebo/common/Time.hh"
 #include "gazebo/transport/Connection.hh"
 #include "test/util.hh"
 
@@ -64,6 +68,126 @@ TEST_F(Connection, IPWhiteList)
     setenv("GAZEBO_IP_WHITE_LIST", ipEnv, 1);
 }
 
+/////////////////////////////////////////////////
+/// \brief Count the publish callbacks of dropped and written messages.
+unsigned int g_writeCallbacks = 0;
+void onWrite(uint32_t)
+{
+  ++g_writeCallbacks;
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, WriteLimit)
+{
+  transport::ConnectionPtr server(new transport::Connection());
+  transport::ConnectionPtr accepted;
+  server->Listen(0, [&accepted](const transport::ConnectionPtr &_conn)
+      {
+        accepted = _conn;
+      });
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+        server->GetLocalPort()));
+
+  // Large messages get an entry each. Nothing writes the queue, since
+  // the connection manager isn't running.
+  const std::string data(5000, 'x');
+  const std::size_t size = data.size() + 8;
+  client->SetWriteLimit(3 * size, transport::Connection::DROP_OLDEST);
+  for (unsigned int i = 0; i < 5; ++i)
+    client->EnqueueMsg(data, boost::bind(&onWrite, _1), i);
+
+  transport::WriteQueueStats stats = client->WriteStats();
+  EXPECT_EQ(stats.queuedMessages, 3u);
+  EXPECT_EQ(stats.queuedBytes, 3 * size);
+  EXPECT_EQ(stats.maxQueuedBytes, 3 * size);
+  EXPECT_EQ(stats.droppedMessages, 2u);
+  EXPECT_EQ(stats.droppedBytes, 2 * size);
+  EXPECT_EQ(g_writeCallbacks, 2u);
+
+  // Latest only keeps the new message
+  client->SetWriteLimit(3 * size, transport::Connection::LATEST_ONLY);
+  client->EnqueueMsg(data, boost::bind(&onWrite, _1), 5);
+  stats = client->WriteStats();
+  EXPECT_EQ(stats.queuedMessages, 1u);
+  EXPECT_EQ(stats.droppedMessages, 5u);
+  EXPECT_EQ(g_writeCallbacks, 5u);
+
+  // Written messages leave the queue
+  client->ProcessWriteQueue(true);
+  stats = client->WriteStats();
+  EXPECT_EQ(stats.queuedMessages, 0u);
+  EXPECT_EQ(stats.queuedBytes, 0u);
+  EXPECT_EQ(stats.writtenMessages, 1u);
+  EXPECT_EQ(stats.writtenBytes, size);
+  EXPECT_EQ(g_writeCallbacks, 6u);
+
+  client->Shutdown();
+  server->Shutdown();
+}
+
+/////////////////////////////////////////////////
+TEST_F(Connection, GatherWrite)
+{
+  transport::ConnectionPtr server(new transport::Connection());
+  transport::ConnectionPtr accepted;
+  server->Listen(0, [&accepted](const transport::ConnectionPtr &_conn)
+      {
+        accepted = _conn;
+      });
+
+  transport::ConnectionPtr client(new transport::Connection());
+  ASSERT_TRUE(client->Connect(server->GetLocalAddress(),
+        server->GetLocalPort()));
+  for (int i = 0; i < 100 && !accepted; ++i)
+    common::Time::MSleep(10);
+  ASSERT_TRUE(accepted != nullptr);
+
+  // Small messages are coalesced with their headers, large ones are
+  // written from their own header and payload buffers
+  std::vector<std::string> messages;
+  messages.push_back(std::string(100, 'a'));
+  messages.push_back(std::string(200, 'b'));
+  messages.push_back(std::string(5000, 'c'));
+  messages.push_back(std::string(300, 'd'));
+  messages.push_back(std::string(200000, 'e'));
+  messages[2][4999] = 'z';
+  messages[4][0] = 'z';
+  for (auto const &message : messages)
+    client->EnqueueMsg(message);
+
+  // Read each message into its final buffer while the client writes
+  std::vector<std::string> received;
+  std::thread reader([&accepted, &received, &messages]()
+      {
+        try
+        {
+          std::string data;
+          while (received.size() < messages.size() && accepted->Read(data))
+            received.push_back(data);
+        }
+        catch(...)
+        {
+        }
+      });
+
+  for (int i = 0; i < 10 && client->WriteStats().queuedMessages > 0; ++i)
+    client->ProcessWriteQueue(true);
+  reader.join();
+
+  EXPECT_EQ(0u, client->WriteStats().queuedMessages);
+  EXPECT_EQ(messages.size(), client->WriteStats().writtenMessages);
+  ASSERT_EQ(messages.size(), received.size());
+  for (unsigned int i = 0; i < messages.size(); ++i)
+    EXPECT_TRUE(messages[i] == received[i]) << "message " << i;
+
+  client->Shutdown();
+  accepted->Shutdown();
+  server->Shutdown();
+}
+
+/////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
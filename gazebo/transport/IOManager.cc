@@ -18,6 +18,8 @@
 #include <boost/bind.hpp>
 #include <boost/thread/thread.hpp>
 #include <iostream>
+
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/transport/IOManager.hh"
 
 namespace gazebo
@@ -48,8 +50,12 @@ IOManager::IOManager()
   this->dataPtr->work = new boost::asio::io_service::work(
       *this->dataPtr->io_service);
   this->dataPtr->count = 0;
-  this->dataPtr->thread = new boost::thread(boost::bind(
-      &boost::asio::io_service::run, this->dataPtr->io_service));
+  boost::asio::io_service *ioService = this->dataPtr->io_service;
+  this->dataPtr->thread = new boost::thread([ioService]()
+      {
+        common::ThreadConfig::Instance()->Apply("io");
+        ioService->run();
+      });
 }
 
 /////////////////////////////////////////////////
@@ -0,0 +1,457 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/TransportIface.hh"
+#include "gazebo/transport/LoadProfile.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Private data for the LoadProfile class.
+    class LoadProfilePrivate
+    {
+      /// \brief Topics, by index.
+      public: std::vector<LoadTopic> topics;
+
+      /// \brief Index of the topics, by name.
+      public: std::map<std::string, uint32_t> indices;
+
+      /// \brief Messages, in the order they were added.
+      public: std::vector<LoadEvent> events;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+    };
+
+    /// \internal
+    /// \brief Subscription of a topic of a LoadRecorder.
+    class LoadTap
+    {
+      /// \brief Callback of the raw messages.
+      /// \param[in] _data The serialized message.
+      public: void OnData(const std::string &_data)
+              {
+                this->profile->Add(this->topic,
+                    std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - this->start).count(),
+                    static_cast<uint32_t>(_data.size()));
+              }
+
+      /// \brief The recorded profile.
+      public: LoadProfile *profile = nullptr;
+
+      /// \brief Index of the topic.
+      public: uint32_t topic = 0;
+
+      /// \brief Start of the recording.
+      public: std::chrono::steady_clock::time_point start;
+
+      /// \brief The subscription.
+      public: SubscriberPtr sub;
+    };
+
+    /// \internal
+    /// \brief Private data for the LoadRecorder class.
+    class LoadRecorderPrivate
+    {
+      /// \brief Node of the subscriptions.
+      public: NodePtr node;
+
+      /// \brief The recorded profile.
+      public: LoadProfile profile;
+
+      /// \brief Subscriptions, one per topic.
+      public: std::vector<std::unique_ptr<LoadTap>> taps;
+    };
+
+    /// \internal
+    /// \brief Private data for the LoadReplayer class.
+    class LoadReplayerPrivate
+    {
+      /// \brief Messages of the profile, by time.
+      public: std::vector<LoadEvent> events;
+
+      /// \brief Publishers, by topic index.
+      public: std::vector<PublisherPtr> pubs;
+
+      /// \brief Names of the replayed topics, by topic index.
+      public: std::vector<std::string> names;
+
+      /// \brief Duration of the profile in seconds.
+      public: double duration = 0;
+
+      /// \brief True to stop the replay.
+      public: std::atomic<bool> stop{false};
+    };
+  }
+}
+
+using namespace gazebo;
+using namespace transport;
+
+/// \brief First line of the profile files.
+static const char *kLoadProfileHeader = "# gazebo load profile 1";
+
+/////////////////////////////////////////////////
+LoadProfile::LoadProfile()
+  : dataPtr(new LoadProfilePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LoadProfile::LoadProfile(const LoadProfile &_profile)
+  : dataPtr(new LoadProfilePrivate)
+{
+  *this = _profile;
+}
+
+/////////////////////////////////////////////////
+LoadProfile::~LoadProfile()
+{
+}
+
+/////////////////////////////////////////////////
+LoadProfile &LoadProfile::operator=(const LoadProfile &_profile)
+{
+  if (this == &_profile)
+    return *this;
+
+  std::lock(this->dataPtr->mutex, _profile.dataPtr->mutex);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> otherLock(_profile.dataPtr->mutex,
+      std::adopt_lock);
+  this->dataPtr->topics = _profile.dataPtr->topics;
+  this->dataPtr->indices = _profile.dataPtr->indices;
+  this->dataPtr->events = _profile.dataPtr->events;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+uint32_t LoadProfile::AddTopic(const std::string &_name,
+    const std::string &_msgType)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  auto iter = this->dataPtr->indices.find(_name);
+  if (iter != this->dataPtr->indices.end())
+    return iter->second;
+
+  const uint32_t index = static_cast<uint32_t>(this->dataPtr->topics.size());
+  LoadTopic topic;
+  topic.name = _name;
+  topic.msgType = _msgType;
+  this->dataPtr->topics.push_back(topic);
+  this->dataPtr->indices[_name] = index;
+  return index;
+}
+
+/////////////////////////////////////////////////
+void LoadProfile::Add(const uint32_t _topic, const double _time,
+    const uint32_t _size)
+{
+  LoadEvent event;
+  event.time = _time;
+  event.topic = _topic;
+  event.size = _size;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->events.push_back(event);
+}
+
+/////////////////////////////////////////////////
+std::vector<LoadTopic> LoadProfile::Topics() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->topics;
+}
+
+/////////////////////////////////////////////////
+std::vector<LoadEvent> LoadProfile::Events() const
+{
+  std::vector<LoadEvent> result;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    result = this->dataPtr->events;
+  }
+
+  // The callbacks of the topics run on several threads
+  std::stable_sort(result.begin(), result.end(),
+      [](const LoadEvent &_a, const LoadEvent &_b)
+      {
+        return _a.time < _b.time;
+      });
+  return result;
+}
+
+/////////////////////////////////////////////////
+double LoadProfile::Duration() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  double result = 0;
+  for (auto const &event : this->dataPtr->events)
+    result = std::max(result, event.time);
+  return result;
+}
+
+/////////////////////////////////////////////////
+void LoadProfile::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->topics.clear();
+  this->dataPtr->indices.clear();
+  this->dataPtr->events.clear();
+}
+
+/////////////////////////////////////////////////
+bool LoadProfile::Save(const std::string &_filename) const
+{
+  std::ofstream out(_filename.c_str());
+  if (!out)
+  {
+    gzerr << "Unable to open load profile[" << _filename << "]\n";
+    return false;
+  }
+
+  out << kLoadProfileHeader << "\n";
+  const std::vector<LoadTopic> topics = this->Topics();
+  for (size_t i = 0; i < topics.size(); ++i)
+  {
+    // The type of a topic without publishers is unknown
+    const LoadTopic &topic = topics[i];
+    out << "topic " << i << " " << topic.name << " "
+        << (topic.msgType.empty() ? "-" : topic.msgType) << "\n";
+  }
+
+  out.precision(9);
+  out << std::fixed;
+  for (auto const &event : this->Events())
+    out << event.time << " " << event.topic << " " << event.size << "\n";
+
+  return static_cast<bool>(out);
+}
+
+/////////////////////////////////////////////////
+bool LoadProfile::Load(const std::string &_filename)
+{
+  std::ifstream in(_filename.c_str());
+  std::string line;
+  if (!in || !std::getline(in, line) || line != kLoadProfileHeader)
+  {
+    gzerr << "Unable to read load profile[" << _filename << "]\n";
+    return false;
+  }
+
+  LoadProfile profile;
+  unsigned int lineNumber = 1;
+  while (std::getline(in, line))
+  {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::istringstream stream(line);
+    bool valid = true;
+    if (line.compare(0, 6, "topic ") == 0)
+    {
+      std::string keyword, name, msgType;
+      uint32_t index = 0;
+      valid = static_cast<bool>(stream >> keyword >> index >> name >> msgType)
+          && profile.AddTopic(name, msgType == "-" ? "" : msgType) == index;
+    }
+    else
+    {
+      LoadEvent event;
+      valid = static_cast<bool>(stream >> event.time >> event.topic >>
+          event.size) && event.topic < profile.dataPtr->topics.size();
+      if (valid)
+        profile.Add(event.topic, event.time, event.size);
+    }
+
+    if (!valid)
+    {
+      gzerr << "Invalid line " << lineNumber << " of load profile["
+            << _filename << "]\n";
+      return false;
+    }
+  }
+
+  *this = profile;
+  return true;
+}
+
+/////////////////////////////////////////////////
+LoadRecorder::LoadRecorder(NodePtr _node)
+  : dataPtr(new LoadRecorderPrivate)
+{
+  this->dataPtr->node = _node;
+}
+
+/////////////////////////////////////////////////
+LoadRecorder::~LoadRecorder()
+{
+  this->Stop();
+}
+
+/////////////////////////////////////////////////
+void LoadRecorder::Start(const std::vector<std::string> &_topics)
+{
+  this->Stop();
+  this->dataPtr->profile.Clear();
+
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (auto const &name : _topics)
+  {
+    const std::string topic = this->dataPtr->node->DecodeTopicName(name);
+    std::unique_ptr<LoadTap> tap(new LoadTap);
+    tap->profile = &this->dataPtr->profile;
+    tap->topic = this->dataPtr->profile.AddTopic(topic,
+        getTopicMsgType(topic));
+    tap->start = start;
+    tap->sub = this->dataPtr->node->Subscribe(topic, &LoadTap::OnData,
+        tap.get());
+    this->dataPtr->taps.push_back(std::move(tap));
+  }
+}
+
+/////////////////////////////////////////////////
+void LoadRecorder::Stop()
+{
+  for (auto &tap : this->dataPtr->taps)
+    tap->sub->Unsubscribe();
+  this->dataPtr->taps.clear();
+}
+
+/////////////////////////////////////////////////
+LoadProfile LoadRecorder::Profile() const
+{
+  return this->dataPtr->profile;
+}
+
+/////////////////////////////////////////////////
+LoadReplayer::LoadReplayer(NodePtr _node, const LoadProfile &_profile,
+    const std::string &_prefix)
+  : dataPtr(new LoadReplayerPrivate)
+{
+  this->dataPtr->events = _profile.Events();
+  this->dataPtr->duration = _profile.Duration();
+
+  // The queue holds a second of the busiest topic
+  std::vector<unsigned int> counts(_profile.Topics().size(), 0);
+  for (auto const &event : this->dataPtr->events)
+    ++counts[event.topic];
+
+  const double duration = std::max(this->dataPtr->duration, 1.0);
+  for (auto const &topic : _profile.Topics())
+  {
+    const std::string name = _prefix + topic.name;
+    const unsigned int queue = std::max(1000u, static_cast<unsigned int>(
+        counts[this->dataPtr->names.size()] / duration));
+    this->dataPtr->names.push_back(name);
+    this->dataPtr->pubs.push_back(
+        _node->Advertise<msgs::GzString>(name, queue));
+  }
+}
+
+/////////////////////////////////////////////////
+LoadReplayer::~LoadReplayer()
+{
+}
+
+/////////////////////////////////////////////////
+std::string LoadReplayer::TopicName(const uint32_t _topic) const
+{
+  if (_topic >= this->dataPtr->names.size())
+    return "";
+  return this->dataPtr->names[_topic];
+}
+
+/////////////////////////////////////////////////
+LoadReplayStats LoadReplayer::Run(const double _speed,
+    const unsigned int _loops)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  LoadReplayStats stats;
+  this->dataPtr->stop = false;
+  if (_speed <= 0)
+  {
+    gzerr << "Invalid replay speed[" << _speed << "]\n";
+    return stats;
+  }
+
+  // One message per topic, resized to each recorded size
+  std::vector<msgs::GzString> payloads(this->dataPtr->pubs.size());
+
+  double lag = 0;
+  const Clock::time_point start = Clock::now();
+  for (unsigned int loop = 0; loop < _loops; ++loop)
+  {
+    const double offset = loop * this->dataPtr->duration;
+    for (auto const &event : this->dataPtr->events)
+    {
+      if (this->dataPtr->stop)
+        break;
+
+      const Clock::time_point due = start +
+          std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>((offset + event.time) / _speed));
+      const Clock::time_point now = Clock::now();
+      if (now < due)
+      {
+        std::this_thread::sleep_until(due);
+      }
+      else
+      {
+        const double late = std::chrono::duration<double>(now - due).count();
+        lag += late;
+        stats.maxLag = std::max(stats.maxLag, late);
+      }
+
+      msgs::GzString &msg = payloads[event.topic];
+      if (msg.data().size() != event.size)
+        msg.mutable_data()->assign(event.size, 'x');
+      this->dataPtr->pubs[event.topic]->Publish(msg);
+
+      ++stats.messages;
+      stats.bytes += event.size;
+    }
+  }
+
+  stats.wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+  if (stats.messages > 0)
+    stats.meanLag = lag / stats.messages;
+  return stats;
+}
+
+/////////////////////////////////////////////////
+void LoadReplayer::Stop()
+{
+  this->dataPtr->stop = true;
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_LOADPROFILE_HH_
+#define GAZEBO_TRANSPORT_LOADPROFILE_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data classes
+    class LoadProfilePrivate;
+    class LoadRecorderPrivate;
+    class LoadReplayerPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief A topic of a load profile.
+    class GZ_TRANSPORT_VISIBLE LoadTopic
+    {
+      /// \brief Name of the topic.
+      public: std::string name;
+
+      /// \brief Message type of the topic.
+      public: std::string msgType;
+    };
+
+    /// \brief A message of a load profile.
+    class GZ_TRANSPORT_VISIBLE LoadEvent
+    {
+      /// \brief Time since the start of the recording in seconds.
+      public: double time = 0;
+
+      /// \brief Index of the topic.
+      public: uint32_t topic = 0;
+
+      /// \brief Serialized size of the message in bytes.
+      public: uint32_t size = 0;
+    };
+
+    /// \class LoadProfile LoadProfile.hh transport/transport.hh
+    /// \brief The topics, sizes and times of the messages of a
+    /// simulation, without their payloads. A profile is recorded from
+    /// live traffic by a LoadRecorder, saved to a text file, and
+    /// replayed with synthetic messages by a LoadReplayer.
+    class GZ_TRANSPORT_VISIBLE LoadProfile
+    {
+      /// \brief Constructor.
+      public: LoadProfile();
+
+      /// \brief Copy constructor.
+      /// \param[in] _profile The profile to copy.
+      public: LoadProfile(const LoadProfile &_profile);
+
+      /// \brief Destructor.
+      public: virtual ~LoadProfile();
+
+      /// \brief Assignment operator.
+      /// \param[in] _profile The profile to copy.
+      /// \return This profile.
+      public: LoadProfile &operator=(const LoadProfile &_profile);
+
+      /// \brief Add a topic.
+      /// \param[in] _name Name of the topic.
+      /// \param[in] _msgType Message type of the topic.
+      /// \return Index of the topic, the existing one if the name was
+      /// already added.
+      public: uint32_t AddTopic(const std::string &_name,
+                  const std::string &_msgType);
+
+      /// \brief Add a message. Any thread can add messages.
+      /// \param[in] _topic Index of the topic.
+      /// \param[in] _time Time since the start of the recording in
+      /// seconds.
+      /// \param[in] _size Serialized size of the message in bytes.
+      public: void Add(const uint32_t _topic, const double _time,
+                  const uint32_t _size);
+
+      /// \brief Get the topics.
+      /// \return The topics, by index.
+      public: std::vector<LoadTopic> Topics() const;
+
+      /// \brief Get the messages.
+      /// \return The messages, by time.
+      public: std::vector<LoadEvent> Events() const;
+
+      /// \brief Get the time of the last message.
+      /// \return The time in seconds.
+      public: double Duration() const;
+
+      /// \brief Remove the topics and the messages.
+      public: void Clear();
+
+      /// \brief Save the profile.
+      /// \param[in] _filename Path of the file.
+      /// \return True on success.
+      public: bool Save(const std::string &_filename) const;
+
+      /// \brief Load a profile, replacing this one.
+      /// \param[in] _filename Path of the file.
+      /// \return True on success.
+      public: bool Load(const std::string &_filename);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LoadProfilePrivate> dataPtr;
+    };
+
+    /// \class LoadRecorder LoadProfile.hh transport/transport.hh
+    /// \brief Records the profile of a set of topics. The messages are
+    /// received raw, they aren't parsed.
+    class GZ_TRANSPORT_VISIBLE LoadRecorder
+    {
+      /// \brief Constructor.
+      /// \param[in] _node Node of the subscriptions.
+      public: explicit LoadRecorder(NodePtr _node);
+
+      /// \brief Destructor.
+      public: virtual ~LoadRecorder();
+
+      /// \brief Start recording, from an empty profile.
+      /// \param[in] _topics Names of the topics.
+      public: void Start(const std::vector<std::string> &_topics);
+
+      /// \brief Stop recording.
+      public: void Stop();
+
+      /// \brief Get the recorded profile.
+      /// \return The profile.
+      public: LoadProfile Profile() const;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LoadRecorderPrivate> dataPtr;
+    };
+
+    /// \brief Result of a replay.
+    class GZ_TRANSPORT_VISIBLE LoadReplayStats
+    {
+      /// \brief Number of messages published.
+      public: uint64_t messages = 0;
+
+      /// \brief Number of payload bytes published.
+      public: uint64_t bytes = 0;
+
+      /// \brief Wall time of the replay in seconds.
+      public: double wallTime = 0;
+
+      /// \brief Mean delay of the publications behind the profile in
+      /// seconds.
+      public: double meanLag = 0;
+
+      /// \brief Longest delay of a publication behind the profile in
+      /// seconds.
+      public: double maxLag = 0;
+    };
+
+    /// \class LoadReplayer LoadProfile.hh transport/transport.hh
+    /// \brief Replays a profile with synthetic messages. Each topic of
+    /// the profile is advertised under a prefix as a GzString topic, and
+    /// each message is a string of the recorded size published at the
+    /// recorded time. The delay behind the profile shows when the
+    /// transport can't keep up with the load.
+    class GZ_TRANSPORT_VISIBLE LoadReplayer
+    {
+      /// \brief Constructor, advertises the topics.
+      /// \param[in] _node Node of the publishers.
+      /// \param[in] _profile The profile.
+      /// \param[in] _prefix Prefix of the replayed topics; it keeps them
+      /// apart from the recorded ones, which have other message types.
+      public: LoadReplayer(NodePtr _node, const LoadProfile &_profile,
+                  const std::string &_prefix);
+
+      /// \brief Destructor.
+      public: virtual ~LoadReplayer();
+
+      /// \brief Get the name of a replayed topic.
+      /// \param[in] _topic Index of the topic in the profile.
+      /// \return The name, empty if the index is out of range.
+      public: std::string TopicName(const uint32_t _topic) const;
+
+      /// \brief Replay the profile, blocking until done or stopped.
+      /// \param[in] _speed Factor of the rates of the profile, 2 to
+      /// publish twice as fast.
+      /// \param[in] _loops Number of times to replay the profile.
+      /// \return The result.
+      public: LoadReplayStats Run(const double _speed = 1.0,
+                  const unsigned int _loops = 1);
+
+      /// \brief Stop a replay, from another thread.
+      public: void Stop();
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<LoadReplayerPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/transport/LoadProfile.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LoadProfileTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(LoadProfileTest, Add)
+{
+  transport::LoadProfile profile;
+  EXPECT_EQ(0u, profile.AddTopic("/gazebo/default/pose/info",
+      "gazebo.msgs.PosesStamped"));
+  EXPECT_EQ(1u, profile.AddTopic("/gazebo/default/world_stats",
+      "gazebo.msgs.WorldStatistics"));
+  EXPECT_EQ(0u, profile.AddTopic("/gazebo/default/pose/info", ""));
+  ASSERT_EQ(2u, profile.Topics().size());
+
+  // The callbacks of several threads add out of order
+  profile.Add(0, 0.2, 1000);
+  profile.Add(1, 0.1, 50);
+  profile.Add(0, 0.3, 1200);
+
+  std::vector<transport::LoadEvent> events = profile.Events();
+  ASSERT_EQ(3u, events.size());
+  EXPECT_DOUBLE_EQ(0.1, events[0].time);
+  EXPECT_EQ(1u, events[0].topic);
+  EXPECT_EQ(50u, events[0].size);
+  EXPECT_DOUBLE_EQ(0.3, events[2].time);
+  EXPECT_DOUBLE_EQ(0.3, profile.Duration());
+
+  transport::LoadProfile copy(profile);
+  profile.Clear();
+  EXPECT_TRUE(profile.Topics().empty());
+  EXPECT_TRUE(profile.Events().empty());
+  EXPECT_EQ(3u, copy.Events().size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(LoadProfileTest, SaveLoad)
+{
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("load_profile_%%%%%%.txt");
+
+  transport::LoadProfile profile;
+  profile.AddTopic("/gazebo/default/pose/info", "gazebo.msgs.PosesStamped");
+  profile.AddTopic("/gazebo/default/unknown", "");
+  profile.Add(0, 0.016, 2048);
+  profile.Add(1, 0.5, 10);
+  ASSERT_TRUE(profile.Save(path.string()));
+
+  transport::LoadProfile loaded;
+  ASSERT_TRUE(loaded.Load(path.string()));
+  std::vector<transport::LoadTopic> topics = loaded.Topics();
+  ASSERT_EQ(2u, topics.size());
+  EXPECT_EQ("/gazebo/default/pose/info", topics[0].name);
+  EXPECT_EQ("gazebo.msgs.PosesStamped", topics[0].msgType);
+  EXPECT_TRUE(topics[1].msgType.empty());
+
+  std::vector<transport::LoadEvent> events = loaded.Events();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_NEAR(0.016, events[0].time, 1e-9);
+  EXPECT_EQ(2048u, events[0].size);
+  EXPECT_EQ(1u, events[1].topic);
+
+  // A message of an unknown topic is rejected, the profile is kept
+  {
+    std::ofstream out(path.string().c_str(), std::ios::app);
+    out << "1.0 7 100\n";
+  }
+  EXPECT_FALSE(loaded.Load(path.string()));
+  EXPECT_EQ(2u, loaded.Events().size());
+
+  EXPECT_FALSE(loaded.Load("/no/such/load_profile.txt"));
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,658 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include <boost/asio.hpp>
+#include <boost/bind.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/MulticastChannel.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+const char *MulticastChannel::kDefaultGroup = "239.255.0.46";
+const unsigned int MulticastChannel::kDefaultPort;
+const std::size_t MulticastChannel::kMaxDatagramSize;
+const std::size_t MulticastChannel::kHeaderSize;
+const std::size_t MulticastChannel::kMaxMessageSize;
+const std::size_t MulticastReassembler::kMaxPartial;
+
+namespace
+{
+  /// \brief First bytes of every datagram.
+  const uint32_t kMagic = 0x434d5a47;
+
+  /// \brief Payload carried by a datagram.
+  const std::size_t kPayloadSize =
+    MulticastChannel::kMaxDatagramSize - MulticastChannel::kHeaderSize;
+
+  /// \brief Header of a datagram, in little endian order on the wire.
+  struct Header
+  {
+    uint32_t channelId;
+    uint32_t senderId;
+    uint32_t sequence;
+    uint16_t index;
+    uint16_t count;
+    uint32_t size;
+  };
+
+  /////////////////////////////////////////////////
+  void writeU32(char *_out, const uint32_t _value)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      _out[i] = static_cast<char>((_value >> (8 * i)) & 0xff);
+  }
+
+  /////////////////////////////////////////////////
+  uint32_t readU32(const char *_in)
+  {
+    uint32_t value = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+      value |= static_cast<uint32_t>(static_cast<unsigned char>(_in[i])) <<
+        (8 * i);
+    return value;
+  }
+
+  /////////////////////////////////////////////////
+  bool readHeader(const std::string &_datagram, Header &_header)
+  {
+    if (_datagram.size() < MulticastChannel::kHeaderSize ||
+        readU32(&_datagram[0]) != kMagic)
+    {
+      return false;
+    }
+
+    _header.channelId = readU32(&_datagram[4]);
+    _header.senderId = readU32(&_datagram[8]);
+    _header.sequence = readU32(&_datagram[12]);
+    const uint32_t fragment = readU32(&_datagram[16]);
+    _header.index = fragment & 0xffff;
+    _header.count = fragment >> 16;
+    _header.size = readU32(&_datagram[20]);
+    return true;
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Get whether a sequence number comes after another, allowing
+  /// the numbers to wrap around.
+  bool after(const uint32_t _a, const uint32_t _b)
+  {
+    return static_cast<int32_t>(_a - _b) > 0;
+  }
+}
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief A message missing fragments.
+    class MulticastPartial
+    {
+      /// \brief Number of fragments.
+      public: uint16_t count = 0;
+
+      /// \brief Number of fragments received.
+      public: uint16_t received = 0;
+
+      /// \brief Which fragments were received.
+      public: std::vector<bool> have;
+
+      /// \brief Bytes of the message.
+      public: std::string data;
+    };
+
+    /// \internal
+    /// \brief Private data for the MulticastReassembler class
+    class MulticastReassemblerPrivate
+    {
+      /// \brief Channel of the messages.
+      public: uint32_t channelId = 0;
+
+      /// \brief Sender of the messages.
+      public: uint32_t senderId = 0;
+
+      /// \brief True once a message was delivered.
+      public: bool delivered = false;
+
+      /// \brief Sequence number of the last message delivered.
+      public: uint32_t lastSequence = 0;
+
+      /// \brief Incomplete messages by sequence number.
+      public: std::map<uint32_t, MulticastPartial> partials;
+
+      /// \brief Counters.
+      public: MulticastStats stats;
+    };
+
+    /// \internal
+    /// \brief Socket and thread of a receiving channel. The thread keeps
+    /// it alive, so that the callback can close the channel.
+    class MulticastReceiver
+    {
+      /// \brief Service of the socket.
+      public: boost::asio::io_service io;
+
+      /// \brief The socket.
+      public: boost::asio::ip::udp::socket socket{io};
+
+      /// \brief Where the last datagram came from.
+      public: boost::asio::ip::udp::endpoint from;
+
+      /// \brief Buffer of the datagram being received.
+      public: std::vector<char> buffer;
+
+      /// \brief Runs the service.
+      public: std::thread thread;
+
+      /// \brief Rebuilds the received messages.
+      public: std::unique_ptr<MulticastReassembler> reassembler;
+
+      /// \brief Receives the messages.
+      public: MulticastChannel::Callback callback;
+
+      /// \brief Protects the reassembler and the callback.
+      public: std::mutex mutex;
+
+      /// \brief Start receiving a datagram.
+      public: void Receive();
+
+      /// \brief Handle a received datagram.
+      /// \param[in] _error Error of the receive.
+      /// \param[in] _size Size of the datagram.
+      public: void OnReceive(const boost::system::error_code &_error,
+                             const std::size_t _size);
+    };
+
+    /// \internal
+    /// \brief Private data for the MulticastChannel class
+    class MulticastChannelPrivate
+    {
+      /// \brief Service of the sending socket.
+      public: boost::asio::io_service io;
+
+      /// \brief The sending socket, null when closed.
+      public: std::unique_ptr<boost::asio::ip::udp::socket> socket;
+
+      /// \brief Where the messages are sent.
+      public: boost::asio::ip::udp::endpoint endpoint;
+
+      /// \brief The receiver, null when the channel isn't receiving.
+      public: std::shared_ptr<MulticastReceiver> receiver;
+
+      /// \brief Channel of the topic.
+      public: uint32_t channelId = 0;
+
+      /// \brief Identifier of this channel.
+      public: uint32_t senderId = 0;
+
+      /// \brief Sequence number of the next message sent.
+      public: uint32_t sequence = 0;
+
+      /// \brief Protects the sequence number and the counters.
+      public: mutable std::mutex mutex;
+
+      /// \brief Counters of a sending channel.
+      public: MulticastStats stats;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+MulticastReassembler::MulticastReassembler(const uint32_t _channelId,
+    const uint32_t _senderId)
+  : dataPtr(new MulticastReassemblerPrivate)
+{
+  this->dataPtr->channelId = _channelId;
+  this->dataPtr->senderId = _senderId;
+}
+
+//////////////////////////////////////////////////
+MulticastReassembler::~MulticastReassembler()
+{
+}
+
+//////////////////////////////////////////////////
+bool MulticastReassembler::Add(const std::string &_datagram,
+    std::string &_message)
+{
+  Header header;
+  if (!readHeader(_datagram, header) ||
+      header.channelId != this->dataPtr->channelId ||
+      header.senderId != this->dataPtr->senderId ||
+      header.count == 0 || header.index >= header.count ||
+      header.size > MulticastChannel::kMaxMessageSize)
+  {
+    return false;
+  }
+
+  // Every fragment but the last one is full
+  const std::size_t count = std::max<std::size_t>(1,
+      (header.size + kPayloadSize - 1) / kPayloadSize);
+  const std::size_t offset = header.index * kPayloadSize;
+  const std::size_t length = _datagram.size() - MulticastChannel::kHeaderSize;
+  if (header.count != count ||
+      length != std::min(kPayloadSize, header.size - offset))
+  {
+    return false;
+  }
+
+  this->dataPtr->stats.fragmentsReceived++;
+
+  // Messages older than the last one delivered were counted as dropped
+  if (this->dataPtr->delivered &&
+      !after(header.sequence, this->dataPtr->lastSequence))
+  {
+    return false;
+  }
+
+  auto inserted = this->dataPtr->partials.insert(
+      std::make_pair(header.sequence, MulticastPartial()));
+  MulticastPartial &partial = inserted.first->second;
+  if (inserted.second)
+  {
+    partial.count = header.count;
+    partial.have.assign(header.count, false);
+    partial.data.resize(header.size);
+  }
+  else if (partial.count != header.count ||
+           partial.data.size() != header.size)
+  {
+    return false;
+  }
+
+  if (!partial.have[header.index])
+  {
+    partial.have[header.index] = true;
+    partial.received++;
+    _datagram.copy(&partial.data[offset], length,
+        MulticastChannel::kHeaderSize);
+  }
+
+  if (partial.received < partial.count)
+  {
+    // Give up on the oldest message when too many are incomplete
+    if (this->dataPtr->partials.size() > this->kMaxPartial)
+      this->dataPtr->partials.erase(this->dataPtr->partials.begin());
+    return false;
+  }
+
+  if (this->dataPtr->delivered)
+  {
+    this->dataPtr->stats.dropped +=
+      header.sequence - this->dataPtr->lastSequence - 1;
+  }
+  this->dataPtr->delivered = true;
+  this->dataPtr->lastSequence = header.sequence;
+  this->dataPtr->stats.received++;
+  _message.swap(partial.data);
+
+  // Forget the incomplete messages that are now late
+  for (auto iter = this->dataPtr->partials.begin();
+       iter != this->dataPtr->partials.end();)
+  {
+    if (after(iter->first, header.sequence))
+      ++iter;
+    else
+      iter = this->dataPtr->partials.erase(iter);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+MulticastStats MulticastReassembler::Stats() const
+{
+  return this->dataPtr->stats;
+}
+
+//////////////////////////////////////////////////
+MulticastChannel::MulticastChannel()
+  : dataPtr(new MulticastChannelPrivate)
+{
+  // 0 means no channel in msgs::Publish
+  std::random_device device;
+  while (this->dataPtr->senderId == 0)
+    this->dataPtr->senderId = device();
+}
+
+//////////////////////////////////////////////////
+MulticastChannel::~MulticastChannel()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+std::string MulticastChannel::Group()
+{
+  const char *group = std::getenv("GAZEBO_MULTICAST_GROUP");
+  if (group && *group)
+    return group;
+  return kDefaultGroup;
+}
+
+//////////////////////////////////////////////////
+unsigned int MulticastChannel::Port()
+{
+  const char *port = std::getenv("GAZEBO_MULTICAST_PORT");
+  if (port && *port)
+  {
+    try
+    {
+      int value = std::stoi(port);
+      if (value > 0 && value < 65536)
+        return value;
+    }
+    catch(...)
+    {
+    }
+    gzwarn << "Invalid GAZEBO_MULTICAST_PORT[" << port << "]\n";
+  }
+  return kDefaultPort;
+}
+
+//////////////////////////////////////////////////
+uint32_t MulticastChannel::ChannelId(const std::string &_topic)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (const char c : _topic)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+//////////////////////////////////////////////////
+std::vector<std::string> MulticastChannel::Fragment(
+    const uint32_t _channelId, const uint32_t _senderId,
+    const uint32_t _sequence, const std::string &_data)
+{
+  std::vector<std::string> datagrams;
+  if (_data.size() > kMaxMessageSize)
+    return datagrams;
+
+  const std::size_t count =
+    std::max<std::size_t>(1, (_data.size() + kPayloadSize - 1) / kPayloadSize);
+  datagrams.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::size_t offset = i * kPayloadSize;
+    const std::size_t length = std::min(kPayloadSize, _data.size() - offset);
+
+    std::string datagram(kHeaderSize + length, '\0');
+    writeU32(&datagram[0], kMagic);
+    writeU32(&datagram[4], _channelId);
+    writeU32(&datagram[8], _senderId);
+    writeU32(&datagram[12], _sequence);
+    writeU32(&datagram[16], static_cast<uint32_t>(i | (count << 16)));
+    writeU32(&datagram[20], _data.size());
+    _data.copy(&datagram[kHeaderSize], length, offset);
+    datagrams.push_back(datagram);
+  }
+
+  return datagrams;
+}
+
+//////////////////////////////////////////////////
+bool MulticastChannel::OpenSender(const std::string &_group,
+    const unsigned int _port, const std::string &_topic)
+{
+  this->Close();
+
+  boost::system::error_code ec;
+  boost::asio::ip::address address =
+    boost::asio::ip::address::from_string(_group, ec);
+  if (ec || !address.is_multicast())
+  {
+    gzerr << "Invalid multicast group[" << _group << "]\n";
+    return false;
+  }
+
+  std::unique_ptr<boost::asio::ip::udp::socket> socket(
+      new boost::asio::ip::udp::socket(this->dataPtr->io));
+  socket->open(address.is_v6() ? boost::asio::ip::udp::v6() :
+      boost::asio::ip::udp::v4(), ec);
+  if (!ec)
+  {
+    // Stay on the local network, and let the subscribers of this host
+    // receive the messages.
+    socket->set_option(boost::asio::ip::multicast::hops(1), ec);
+  }
+  if (!ec)
+    socket->set_option(boost::asio::ip::multicast::enable_loopback(true), ec);
+
+  if (ec)
+  {
+    gzerr << "Unable to open multicast sender for topic[" << _topic
+          << "]: " << ec.message() << "\n";
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->stats = MulticastStats();
+  this->dataPtr->endpoint = boost::asio::ip::udp::endpoint(address, _port);
+  this->dataPtr->channelId = ChannelId(_topic);
+  this->dataPtr->socket = std::move(socket);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MulticastChannel::OpenReceiver(const std::string &_group,
+    const unsigned int _port, const std::string &_topic,
+    const uint32_t _senderId, const Callback &_cb)
+{
+  this->Close();
+
+  boost::system::error_code ec;
+  boost::asio::ip::address address =
+    boost::asio::ip::address::from_string(_group, ec);
+  if (ec || !address.is_multicast())
+  {
+    gzerr << "Invalid multicast group[" << _group << "]\n";
+    return false;
+  }
+
+  std::shared_ptr<MulticastReceiver> receiver(new MulticastReceiver);
+  receiver->reassembler.reset(
+      new MulticastReassembler(ChannelId(_topic), _senderId));
+  receiver->callback = _cb;
+  receiver->buffer.resize(65536);
+
+  boost::asio::ip::udp::endpoint listen(
+      boost::asio::ip::address_v4::any(), _port);
+  if (address.is_v6())
+  {
+    listen = boost::asio::ip::udp::endpoint(
+        boost::asio::ip::address_v6::any(), _port);
+  }
+
+  // Every receiver of the host shares the port, and keeps the datagrams
+  // of its own topic and sender.
+  receiver->socket.open(listen.protocol(), ec);
+  if (!ec)
+  {
+    receiver->socket.set_option(
+        boost::asio::ip::udp::socket::reuse_address(true), ec);
+  }
+  if (!ec)
+    receiver->socket.bind(listen, ec);
+  if (!ec)
+  {
+    receiver->socket.set_option(
+        boost::asio::ip::multicast::join_group(address), ec);
+  }
+
+  if (ec)
+  {
+    gzerr << "Unable to open multicast receiver for topic[" << _topic
+          << "]: " << ec.message() << "\n";
+    return false;
+  }
+
+  receiver->Receive();
+  receiver->thread = std::thread([receiver]()
+      {
+        receiver->io.run();
+      });
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->stats = MulticastStats();
+  this->dataPtr->receiver = receiver;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MulticastChannel::Close()
+{
+  std::shared_ptr<MulticastReceiver> receiver;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->socket.reset();
+    receiver.swap(this->dataPtr->receiver);
+  }
+
+  if (!receiver)
+    return;
+
+  // Keep the counters of the receiver
+  MulticastStats stats;
+  {
+    std::lock_guard<std::mutex> lock(receiver->mutex);
+    receiver->callback.clear();
+    stats = receiver->reassembler->Stats();
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stats = stats;
+  }
+  receiver->io.stop();
+
+  // The callback may close the channel, in which case the thread ends
+  // once the callback returns.
+  if (receiver->thread.get_id() == std::this_thread::get_id())
+    receiver->thread.detach();
+  else
+    receiver->thread.join();
+}
+
+//////////////////////////////////////////////////
+bool MulticastChannel::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->socket || this->dataPtr->receiver;
+}
+
+//////////////////////////////////////////////////
+bool MulticastChannel::Send(const std::string &_data)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->socket)
+    return false;
+
+  std::vector<std::string> datagrams = this->Fragment(
+      this->dataPtr->channelId, this->dataPtr->senderId,
+      this->dataPtr->sequence++, _data);
+  if (datagrams.empty())
+  {
+    gzerr << "Message of " << _data.size()
+          << " bytes is too large for multicast\n";
+    this->dataPtr->stats.sendErrors++;
+    return false;
+  }
+
+  bool result = true;
+  for (const auto &datagram : datagrams)
+  {
+    boost::system::error_code ec;
+    this->dataPtr->socket->send_to(boost::asio::buffer(datagram),
+        this->dataPtr->endpoint, 0, ec);
+    if (ec)
+    {
+      this->dataPtr->stats.sendErrors++;
+      result = false;
+    }
+    else
+      this->dataPtr->stats.fragmentsSent++;
+  }
+  this->dataPtr->stats.sent++;
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+uint32_t MulticastChannel::SenderId() const
+{
+  return this->dataPtr->senderId;
+}
+
+//////////////////////////////////////////////////
+MulticastStats MulticastChannel::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->receiver)
+  {
+    std::lock_guard<std::mutex> receiverLock(this->dataPtr->receiver->mutex);
+    return this->dataPtr->receiver->reassembler->Stats();
+  }
+  return this->dataPtr->stats;
+}
+
+//////////////////////////////////////////////////
+void MulticastReceiver::Receive()
+{
+  this->socket.async_receive_from(
+      boost::asio::buffer(this->buffer), this->from,
+      boost::bind(&MulticastReceiver::OnReceive, this,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred));
+}
+
+//////////////////////////////////////////////////
+void MulticastReceiver::OnReceive(
+    const boost::system::error_code &_error, const std::size_t _size)
+{
+  if (_error == boost::asio::error::operation_aborted)
+    return;
+
+  if (!_error)
+  {
+    std::string datagram(this->buffer.data(), _size);
+    std::string message;
+    MulticastChannel::Callback cb;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (this->reassembler->Add(datagram, message))
+        cb = this->callback;
+    }
+    if (cb)
+      cb(message);
+  }
+
+  if (!this->io.stopped())
+    this->Receive();
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_MULTICASTCHANNEL_HH_
+#define GAZEBO_TRANSPORT_MULTICASTCHANNEL_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data classes
+    class MulticastReassemblerPrivate;
+    class MulticastChannelPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief Counters of a multicast channel.
+    class GZ_TRANSPORT_VISIBLE MulticastStats
+    {
+      /// \brief Number of messages sent.
+      public: uint64_t sent = 0;
+
+      /// \brief Number of complete messages received.
+      public: uint64_t received = 0;
+
+      /// \brief Number of messages lost, found from the gaps in the
+      /// sequence numbers of the received messages.
+      public: uint64_t dropped = 0;
+
+      /// \brief Number of datagrams sent.
+      public: uint64_t fragmentsSent = 0;
+
+      /// \brief Number of valid datagrams received.
+      public: uint64_t fragmentsReceived = 0;
+
+      /// \brief Number of datagrams that couldn't be sent.
+      public: uint64_t sendErrors = 0;
+    };
+
+    /// \class MulticastReassembler MulticastChannel.hh transport/transport.hh
+    /// \brief Rebuilds the messages of one sender from the datagrams
+    /// made by MulticastChannel::Fragment.
+    ///
+    /// Datagrams can arrive in any order. A message is delivered once all
+    /// of its fragments arrived, and a message older than the last one
+    /// delivered is discarded.
+    class GZ_TRANSPORT_VISIBLE MulticastReassembler
+    {
+      /// \brief Number of incomplete messages kept at most.
+      public: static const std::size_t kMaxPartial = 8;
+
+      /// \brief Constructor
+      /// \param[in] _channelId Channel of the messages to keep, see
+      /// MulticastChannel::ChannelId.
+      /// \param[in] _senderId Sender of the messages to keep.
+      public: MulticastReassembler(const uint32_t _channelId,
+                  const uint32_t _senderId);
+
+      /// \brief Destructor
+      public: ~MulticastReassembler();
+
+      /// \brief Add a datagram.
+      /// \param[in] _datagram Received datagram.
+      /// \param[out] _message The message completed by the datagram.
+      /// \return True if _message was completed, false if the datagram is
+      /// invalid, from another channel or sender, late, or if the message
+      /// is still missing fragments.
+      public: bool Add(const std::string &_datagram, std::string &_message);
+
+      /// \brief Get the counters. Only the received, dropped and
+      /// fragmentsReceived counters are used.
+      /// \return Copy of the counters.
+      public: MulticastStats Stats() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<MulticastReassemblerPrivate> dataPtr;
+    };
+
+    /// \class MulticastChannel MulticastChannel.hh transport/transport.hh
+    /// \brief Sends or receives the messages of a topic through UDP
+    /// multicast, so that one send reaches every subscriber of a network.
+    ///
+    /// Delivery isn't reliable: a message that lost a datagram is dropped.
+    /// Messages larger than a datagram are fragmented, and every message
+    /// carries a sequence number so that the receiver can count the drops.
+    /// The group and port are read from the environment variables
+    /// GAZEBO_MULTICAST_GROUP and GAZEBO_MULTICAST_PORT.
+    class GZ_TRANSPORT_VISIBLE MulticastChannel
+    {
+      /// \brief Default multicast group.
+      public: static const char *kDefaultGroup;
+
+      /// \brief Default multicast port.
+      public: static const unsigned int kDefaultPort = 11346;
+
+      /// \brief Largest datagram sent, chosen to fit in an ethernet frame.
+      public: static const std::size_t kMaxDatagramSize = 1400;
+
+      /// \brief Size of the header of a datagram.
+      public: static const std::size_t kHeaderSize = 24;
+
+      /// \brief Largest message that can be sent.
+      public: static const std::size_t kMaxMessageSize = 64 * 1024 * 1024;
+
+      /// \brief Callback that receives complete messages.
+      public: typedef boost::function<void (const std::string &)> Callback;
+
+      /// \brief Constructor
+      public: MulticastChannel();
+
+      /// \brief Destructor. Closes the channel.
+      public: ~MulticastChannel();
+
+      /// \brief Get the multicast group to use.
+      /// \return GAZEBO_MULTICAST_GROUP, or kDefaultGroup.
+      public: static std::string Group();
+
+      /// \brief Get the multicast port to use.
+      /// \return GAZEBO_MULTICAST_PORT, or kDefaultPort.
+      public: static unsigned int Port();
+
+      /// \brief Get the identifier of a topic in datagrams.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return Hash of the name.
+      public: static uint32_t ChannelId(const std::string &_topic);
+
+      /// \brief Split a message in datagrams.
+      /// \param[in] _channelId Channel of the message.
+      /// \param[in] _senderId Sender of the message.
+      /// \param[in] _sequence Sequence number of the message.
+      /// \param[in] _data Serialized message.
+      /// \return Datagrams, at most kMaxDatagramSize bytes each.
+      public: static std::vector<std::string> Fragment(
+                  const uint32_t _channelId, const uint32_t _senderId,
+                  const uint32_t _sequence, const std::string &_data);
+
+      /// \brief Open the channel to send messages.
+      /// \param[in] _group Multicast group.
+      /// \param[in] _port Multicast port.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return True if the socket was opened.
+      public: bool OpenSender(const std::string &_group,
+                  const unsigned int _port, const std::string &_topic);
+
+      /// \brief Open the channel to receive the messages of one sender.
+      /// \param[in] _group Multicast group.
+      /// \param[in] _port Multicast port.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _senderId SenderId() of the sending channel.
+      /// \param[in] _cb Callback that receives the messages, called from
+      /// a thread of the channel.
+      /// \return True if the socket was opened and joined the group.
+      public: bool OpenReceiver(const std::string &_group,
+                  const unsigned int _port, const std::string &_topic,
+                  const uint32_t _senderId, const Callback &_cb);
+
+      /// \brief Close the channel. The callback isn't called after this
+      /// returns.
+      public: void Close();
+
+      /// \brief Get whether the channel is open.
+      /// \return True if the socket is open.
+      public: bool IsOpen() const;
+
+      /// \brief Send a message. The channel must have been opened with
+      /// OpenSender.
+      /// \param[in] _data Serialized message.
+      /// \return True if every datagram was sent.
+      public: bool Send(const std::string &_data);
+
+      /// \brief Get the identifier of this channel in datagrams. It's
+      /// random, so that the receivers can tell the senders apart.
+      /// \return Sender id.
+      public: uint32_t SenderId() const;
+
+      /// \brief Get the counters of the channel, which are kept after it
+      /// is closed.
+      /// \return Copy of the counters.
+      public: MulticastStats Stats() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<MulticastChannelPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
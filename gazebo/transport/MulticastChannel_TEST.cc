@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/MulticastChannel.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class MulticastChannel : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Make a message of a given size.
+std::string makeMessage(const std::size_t _size)
+{
+  std::string data(_size, '\0');
+  for (std::size_t i = 0; i < _size; ++i)
+    data[i] = static_cast<char>(i * 7);
+  return data;
+}
+
+/////////////////////////////////////////////////
+TEST_F(MulticastChannel, Fragment)
+{
+  const uint32_t channel = transport::MulticastChannel::ChannelId("/gazebo/a");
+  EXPECT_NE(channel, transport::MulticastChannel::ChannelId("/gazebo/b"));
+
+  // Small and empty messages fit in one datagram
+  EXPECT_EQ(transport::MulticastChannel::Fragment(
+        channel, 1, 0, "hello").size(), 1u);
+  EXPECT_EQ(transport::MulticastChannel::Fragment(channel, 1, 0, "").size(),
+      1u);
+
+  std::string data = makeMessage(10000);
+  auto datagrams = transport::MulticastChannel::Fragment(channel, 1, 0, data);
+  EXPECT_EQ(datagrams.size(), 8u);
+  for (const auto &datagram : datagrams)
+    EXPECT_LE(datagram.size(), transport::MulticastChannel::kMaxDatagramSize);
+
+  // Fragments can arrive in any order, and twice
+  transport::MulticastReassembler reassembler(channel, 1);
+  std::string message;
+  std::reverse(datagrams.begin(), datagrams.end());
+  for (std::size_t i = 0; i + 1 < datagrams.size(); ++i)
+  {
+    EXPECT_FALSE(reassembler.Add(datagrams[i], message));
+    EXPECT_FALSE(reassembler.Add(datagrams[i], message));
+  }
+  EXPECT_TRUE(reassembler.Add(datagrams.back(), message));
+  EXPECT_EQ(message, data);
+
+  transport::MulticastStats stats = reassembler.Stats();
+  EXPECT_EQ(stats.received, 1u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.fragmentsReceived, 15u);
+
+  // Other channels and senders, and invalid datagrams, are ignored
+  EXPECT_FALSE(reassembler.Add(transport::MulticastChannel::Fragment(
+          channel + 1, 1, 1, "x")[0], message));
+  EXPECT_FALSE(reassembler.Add(transport::MulticastChannel::Fragment(
+          channel, 2, 1, "x")[0], message));
+  EXPECT_FALSE(reassembler.Add("garbage", message));
+  std::string truncated =
+    transport::MulticastChannel::Fragment(channel, 1, 1, data)[0];
+  truncated.resize(truncated.size() - 1);
+  EXPECT_FALSE(reassembler.Add(truncated, message));
+  EXPECT_EQ(reassembler.Stats().fragmentsReceived, 15u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MulticastChannel, Drops)
+{
+  transport::MulticastReassembler reassembler(3, 4);
+  std::string message;
+
+  EXPECT_TRUE(reassembler.Add(
+        transport::MulticastChannel::Fragment(3, 4, 10, "a")[0], message));
+
+  // Messages 11 and 12 are lost, and 13 loses a fragment
+  auto partial = transport::MulticastChannel::Fragment(3, 4, 13,
+      makeMessage(3000));
+  EXPECT_FALSE(reassembler.Add(partial[0], message));
+
+  EXPECT_TRUE(reassembler.Add(
+        transport::MulticastChannel::Fragment(3, 4, 14, "b")[0], message));
+  EXPECT_EQ(message, "b");
+  EXPECT_EQ(reassembler.Stats().dropped, 3u);
+
+  // The rest of message 13 arrives late
+  EXPECT_FALSE(reassembler.Add(partial[1], message));
+  EXPECT_FALSE(reassembler.Add(partial[2], message));
+  EXPECT_EQ(reassembler.Stats().received, 2u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MulticastChannel, Loopback)
+{
+  const std::string topic = "/gazebo/default/test";
+  const unsigned int port = 11577;
+
+  transport::MulticastChannel sender;
+  if (!sender.OpenSender(transport::MulticastChannel::Group(), port, topic))
+  {
+    gzwarn << "No multicast support, skipping test\n";
+    return;
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  transport::MulticastChannel receiver;
+  if (!receiver.OpenReceiver(transport::MulticastChannel::Group(), port,
+        topic, sender.SenderId(), [&](const std::string &_data)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          received.push_back(_data);
+        }))
+  {
+    gzwarn << "No multicast support, skipping test\n";
+    return;
+  }
+
+  // A message of several datagrams
+  const std::string data = makeMessage(5000);
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    EXPECT_TRUE(sender.Send(data));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!received.empty())
+      break;
+  }
+
+  EXPECT_FALSE(receiver.Send(data));
+  receiver.Close();
+  EXPECT_FALSE(receiver.IsOpen());
+
+  // The network may not route multicast, only check what was received
+  for (const auto &message : received)
+    EXPECT_EQ(message, data);
+  EXPECT_EQ(receiver.Stats().received, received.size());
+  EXPECT_GE(sender.Stats().fragmentsSent, 4u);
+}
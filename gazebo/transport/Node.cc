@@ -14,8 +14,13 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
 #include <boost/algorithm/string.hpp>
 #include <boost/bind.hpp>
+#include <boost/weak_ptr.hpp>
 #include "gazebo/transport/TransportIface.hh"
 #include "gazebo/transport/Node.hh"
 
@@ -32,6 +37,7 @@ Node::Node()
   this->id = idCounter++;
   this->topicNamespace = "";
   this->initialized = false;
+  this->callbackGeneration = 0;
 }
 
 /////////////////////////////////////////////////
@@ -64,8 +70,15 @@ void Node::Fini()
   }
 
   {
+    // Wait for the dispatch threads, see RemoveCallback
+    boost::recursive_mutex::scoped_lock dispatchLock(this->dispatchMutex,
+        boost::defer_lock);
+    if (TopicManager::Instance()->Dispatcher().Enabled())
+      dispatchLock.lock();
+
     boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
     this->callbacks.clear();
+    ++this->callbackGeneration;
   }
 }
 
@@ -191,11 +204,27 @@ void Node::ProcessPublishers()
     this->publishers[i]->SendMessage();
 }
 
+/////////////////////////////////////////////////
+bool Node::HasConnectedPublishers(const PublisherPtr &_except)
+{
+  boost::mutex::scoped_lock lock(this->publisherMutex);
+
+  for (auto const &pub : this->publishers)
+  {
+    if (pub != _except && pub->HasConnections())
+      return true;
+  }
+  return false;
+}
+
 /////////////////////////////////////////////////
 bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 {
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgs[_topic].push_back(_msg);
+  std::list<std::string> &msgs = this->incomingMsgs[_topic];
+  if (this->HasLatestOnlySubscribers(_topic))
+    msgs.clear();
+  msgs.push_back(_msg);
   ConnectionManager::Instance()->TriggerUpdate();
   return true;
 }
@@ -204,7 +233,10 @@ bool Node::HandleData(const std::string &_topic, const std::string &_msg)
 bool Node::HandleMessage(const std::string &_topic, MessagePtr _msg)
 {
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-  this->incomingMsgsLocal[_topic].push_back(_msg);
+  std::list<MessagePtr> &msgs = this->incomingMsgsLocal[_topic];
+  if (this->HasLatestOnlySubscribers(_topic))
+    msgs.clear();
+  msgs.push_back(_msg);
   ConnectionManager::Instance()->TriggerUpdate();
   return true;
 }
@@ -218,6 +250,9 @@ void Node::ProcessIncoming()
       (this->incomingMsgs.empty() && this->incomingMsgsLocal.empty()))
     return;
 
+  TopicDispatcher &dispatcher = TopicManager::Instance()->Dispatcher();
+  const bool dispatch = dispatcher.Enabled();
+
   Callback_M::iterator cbIter;
   Callback_L::iterator liter;
 
@@ -233,6 +268,10 @@ void Node::ProcessIncoming()
 
     for (; inIter != endIter; ++inIter)
     {
+      // Topics with a dedicated thread are processed there
+      if (dispatch && this->Dispatch(inIter->first, inIter->second))
+        continue;
+
       // Find the callbacks for the topic
       cbIter = this->callbacks.find(inIter->first);
       if (cbIter != this->callbacks.end())
@@ -246,13 +285,28 @@ void Node::ProcessIncoming()
         // For each message in the buffer
         for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
         {
+          std::chrono::steady_clock::time_point start;
+          if (dispatch)
+            start = std::chrono::steady_clock::now();
+
           // Send the message to all callbacks
           for (liter = cbIter->second.begin();
               liter != cbIter->second.end(); ++liter)
           {
+            // Latest only subscribers get the newest message of the batch
+            if ((*liter)->GetLatestOnly() && std::next(msgIter) != msgEndIter)
+              continue;
+
             (*liter)->HandleData(*msgIter,
                 boost::bind(&dummy_callback_fn, _1), 0);
           }
+
+          if (dispatch)
+          {
+            dispatcher.ReportDuration(inIter->first,
+                std::chrono::duration<double>(
+                  std::chrono::steady_clock::now() - start).count());
+          }
         }
       }
     }
@@ -271,6 +325,10 @@ void Node::ProcessIncoming()
 
     for (; inIter != endIter; ++inIter)
     {
+      // Topics with a dedicated thread are processed there
+      if (dispatch && this->Dispatch(inIter->first, inIter->second))
+        continue;
+
       // Find the callbacks for the topic
       cbIter = this->callbacks.find(inIter->first);
       if (cbIter != this->callbacks.end())
@@ -284,12 +342,27 @@ void Node::ProcessIncoming()
         // For each message in the buffer
         for (msgIter = msgInIter; msgIter != msgEndIter; ++msgIter)
         {
+          std::chrono::steady_clock::time_point start;
+          if (dispatch)
+            start = std::chrono::steady_clock::now();
+
           // Send the message to all callbacks
           for (liter = cbIter->second.begin();
               liter != cbIter->second.end(); ++liter)
           {
+            // Latest only subscribers get the newest message of the batch
+            if ((*liter)->GetLatestOnly() && std::next(msgIter) != msgEndIter)
+              continue;
+
             (*liter)->HandleMessage(*msgIter);
           }
+
+          if (dispatch)
+          {
+            dispatcher.ReportDuration(inIter->first,
+                std::chrono::duration<double>(
+                  std::chrono::steady_clock::now() - start).count());
+          }
         }
       }
     }
@@ -298,6 +371,107 @@ void Node::ProcessIncoming()
   }
 }
 
+/////////////////////////////////////////////////
+template<typename M>
+bool Node::Dispatch(const std::string &_topic, std::list<M> &_msgs)
+{
+  TopicDispatcher &dispatcher = TopicManager::Instance()->Dispatcher();
+  if (!dispatcher.Dispatched(_topic))
+    return false;
+
+  // The task owns the batch, and doesn't keep the node alive
+  std::shared_ptr<std::list<M> > msgs(new std::list<M>());
+  msgs->swap(_msgs);
+  boost::weak_ptr<Node> weakNode(this->shared_from_this());
+  const std::string topic = _topic;
+
+  if (!dispatcher.Post(topic, [weakNode, topic, msgs]()
+        {
+          NodePtr node = weakNode.lock();
+          if (node)
+            node->ProcessDispatched(topic, *msgs);
+        }))
+  {
+    // The dispatcher was stopped
+    _msgs.swap(*msgs);
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Pass a message received from another process to a callback.
+/// \param[in] _callback The callback.
+/// \param[in] _msg Serialized message.
+static void handleDispatched(CallbackHelperPtr _callback,
+    const std::string &_msg)
+{
+  _callback->HandleData(_msg, boost::bind(&dummy_callback_fn, _1), 0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Pass a message published in this process to a callback.
+/// \param[in] _callback The callback.
+/// \param[in] _msg The message.
+static void handleDispatched(CallbackHelperPtr _callback, MessagePtr _msg)
+{
+  _callback->HandleMessage(_msg);
+}
+
+/////////////////////////////////////////////////
+template<typename M>
+void Node::ProcessDispatched(const std::string &_topic,
+    const std::list<M> &_msgs)
+{
+  // RemoveCallback waits for this lock, so a removed callback is never
+  // called. The callbacks are copied, so that they run without the
+  // incomingMutex and don't block the other topics of this node.
+  boost::recursive_mutex::scoped_lock lock(this->dispatchMutex);
+
+  Callback_L registered;
+  unsigned int generation = this->callbackGeneration + 1;
+
+  for (typename std::list<M>::const_iterator msgIter = _msgs.begin();
+       msgIter != _msgs.end(); ++msgIter)
+  {
+    Callback_L current = registered;
+    for (Callback_L::iterator liter = current.begin();; ++liter)
+    {
+      // Get the callbacks again if a callback removed a subscriber
+      if (generation != this->callbackGeneration)
+      {
+        boost::recursive_mutex::scoped_lock lock2(this->incomingMutex);
+        generation = this->callbackGeneration;
+
+        Callback_M::iterator cbIter = this->callbacks.find(_topic);
+        if (!this->initialized || cbIter == this->callbacks.end())
+          return;
+        registered = cbIter->second;
+
+        if (current.empty())
+        {
+          current = registered;
+          liter = current.begin();
+        }
+      }
+
+      if (liter == current.end())
+        break;
+
+      // Latest only subscribers get the newest message of the batch
+      if ((*liter)->GetLatestOnly() && std::next(msgIter) != _msgs.end())
+        continue;
+
+      if (std::find(registered.begin(), registered.end(), *liter) !=
+          registered.end())
+      {
+        handleDispatched(*liter, *msgIter);
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 void Node::InsertLatchedMsg(const std::string &_topic, const std::string &_msg)
 {
@@ -360,12 +534,51 @@ bool Node::HasLatchedSubscriber(const std::string &_topic) const
   return false;
 }
 
+/////////////////////////////////////////////////
+bool Node::HasLatestOnlySubscribers(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  Callback_M::const_iterator iter = this->callbacks.find(_topic);
+  if (iter == this->callbacks.end() || iter->second.empty())
+    return false;
+
+  for (auto const &callback : iter->second)
+  {
+    if (!callback->GetLatestOnly())
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool Node::HasRawSubscriber(const std::string &_topic) const
+{
+  boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
+  Callback_M::const_iterator iter = this->callbacks.find(_topic);
+  if (iter == this->callbacks.end())
+    return false;
+
+  for (auto const &callback : iter->second)
+  {
+    if (callback->GetMsgType() == "raw")
+      return true;
+  }
+  return false;
+}
+
 /////////////////////////////////////////////////
 void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
 {
   if (!this->initialized)
     return;
 
+  // A dispatch thread may be calling the callbacks of the topic. Wait for
+  // it, so that the callback isn't called once the subscriber is gone.
+  boost::recursive_mutex::scoped_lock dispatchLock(this->dispatchMutex,
+      boost::defer_lock);
+  if (TopicManager::Instance()->Dispatcher().Dispatched(_topic))
+    dispatchLock.lock();
+
   boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
 
   // Find the topic list in the map.
@@ -382,6 +595,7 @@ void Node::RemoveCallback(const std::string &_topic, unsigned int _id)
       {
         (*liter).reset();
         iter->second.erase(liter);
+        ++this->callbackGeneration;
         break;
       }
     }
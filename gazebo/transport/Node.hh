@@ -21,6 +21,7 @@
 #include <tbb/task.h>
 #include <boost/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
+#include <atomic>
 #include <map>
 #include <list>
 #include <string>
@@ -139,6 +140,12 @@ namespace gazebo
       /// most recent message over the wire. This is for internal use only
       public: void ProcessPublishers();
 
+      /// \brief Tell whether any publisher of the node has a subscriber.
+      /// \param[in] _except Publisher that is ignored.
+      /// \return True if a publisher other than _except has connections.
+      public: bool HasConnectedPublishers(
+                  const PublisherPtr &_except = PublisherPtr());
+
       /// \brief Process incoming messages.
       public: void ProcessIncoming();
 
@@ -147,6 +154,19 @@ namespace gazebo
       /// \return True if a latched subscriber exists.
       public: bool HasLatchedSubscriber(const std::string &_topic) const;
 
+      /// \brief Does every subscriber of a topic only want the newest
+      /// message?
+      /// \param[in] _topic Name of the topic to check.
+      /// \return True if the topic has subscribers, and all of them were
+      /// subscribed with _latestOnly set.
+      public: bool HasLatestOnlySubscribers(const std::string &_topic) const;
+
+      /// \brief Return true if a subscriber on a specific topic wants the
+      /// raw data instead of a message.
+      /// \param[in] _topic Name of the topic to check.
+      /// \return True if a raw subscriber exists.
+      public: bool HasRawSubscriber(const std::string &_topic) const;
+
 
       /// \brief A convenience function for a one-time publication of
       /// a message. This is inefficient, compared to
@@ -172,16 +192,21 @@ namespace gazebo
       /// queue for delivery
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _multicast True to also send the messages through UDP
+      /// multicast, where a single send reaches the remote subscribers
+      /// that accept losses. Must be set by the first advertiser of the
+      /// topic in this process.
       /// \return Pointer to new publisher object
       public: template<typename M>
       transport::PublisherPtr Advertise(const std::string &_topic,
                                         unsigned int _queueLimit = 1000,
-                                        double _hzRate = 0)
+                                        double _hzRate = 0,
+                                        bool _multicast = false)
       {
         std::string decodedTopic = this->DecodeTopicName(_topic);
         PublisherPtr publisher =
           transport::TopicManager::Instance()->Advertise<M>(
-              decodedTopic, _queueLimit, _hzRate);
+              decodedTopic, _queueLimit, _hzRate, _multicast);
 
         boost::mutex::scoped_lock lock(this->publisherMutex);
         publisher->SetNode(shared_from_this());
@@ -212,16 +237,19 @@ namespace gazebo
       /// queue for delivery
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _multicast True to also send the messages through UDP
+      /// multicast, see the templated Advertise.
       /// \return Pointer to new publisher object
       public: transport::PublisherPtr Advertise(const std::string &_topic,
                                         const std::string &_msgTypeName,
                                         unsigned int _queueLimit = 1000,
-                                        double _hzRate = 0)
+                                        double _hzRate = 0,
+                                        bool _multicast = false)
       {
         std::string decodedTopic = this->DecodeTopicName(_topic);
         PublisherPtr publisher =
           transport::TopicManager::Instance()->Advertise(
-              decodedTopic, _msgTypeName, _queueLimit, _hzRate);
+              decodedTopic, _msgTypeName, _queueLimit, _hzRate, _multicast);
 
         boost::mutex::scoped_lock lock(this->publisherMutex);
         publisher->SetNode(shared_from_this());
@@ -236,26 +264,33 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _latestOnly If true, only the newest message is
+      /// delivered, and older ones that weren't delivered yet are dropped.
+      /// Meant for state topics such as poses.
       /// \return Pointer to new Subscriber object
       public: template<typename M, typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const boost::shared_ptr<M const> &), T *_obj,
-          bool _latching = false)
+          bool _latching = false, bool _latestOnly = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        ops.SetLatestOnly(_latestOnly);
+
+        CallbackHelperPtr helper(
+            new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching));
+        helper->SetLatestOnly(_latestOnly);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
-                new CallbackHelperT<M>(boost::bind(_fp, _obj, _1), _latching)));
+          this->callbacks[decodedTopic].push_back(helper);
         }
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -265,26 +300,32 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _latestOnly If true, only the newest message is
+      /// delivered, and older ones that weren't delivered yet are dropped.
+      /// Meant for state topics such as poses.
       /// \return Pointer to new Subscriber object
       public: template<typename M>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(*_fp)(const boost::shared_ptr<M const> &),
-                     bool _latching = false)
+                     bool _latching = false, bool _latestOnly = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.template Init<M>(decodedTopic, shared_from_this(), _latching);
+        ops.SetLatestOnly(_latestOnly);
+
+        CallbackHelperPtr helper(new CallbackHelperT<M>(_fp, _latching));
+        helper->SetLatestOnly(_latestOnly);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(
-              CallbackHelperPtr(new CallbackHelperT<M>(_fp, _latching)));
+          this->callbacks[decodedTopic].push_back(helper);
         }
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -295,26 +336,33 @@ namespace gazebo
       /// \param[in] _obj Class instance to be used on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _latestOnly If true, only the newest message is
+      /// delivered, and older ones that weren't delivered yet are dropped.
+      /// Meant for state topics such as poses.
       /// \return Pointer to new Subscriber object
       template<typename T>
       SubscriberPtr Subscribe(const std::string &_topic,
           void(T::*_fp)(const std::string &), T *_obj,
-          bool _latching = false)
+          bool _latching = false, bool _latestOnly = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
+        ops.SetLatestOnly(_latestOnly);
+
+        CallbackHelperPtr helper(
+            new RawCallbackHelper(boost::bind(_fp, _obj, _1)));
+        helper->SetLatestOnly(_latestOnly);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(CallbackHelperPtr(
-                new RawCallbackHelper(boost::bind(_fp, _obj, _1))));
+          this->callbacks[decodedTopic].push_back(helper);
         }
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -325,24 +373,31 @@ namespace gazebo
       /// \param[in] _fp Function to be called on receipt of new message
       /// \param[in] _latching If true, latch latest incoming message;
       /// otherwise don't latch
+      /// \param[in] _latestOnly If true, only the newest message is
+      /// delivered, and older ones that weren't delivered yet are dropped.
+      /// Meant for state topics such as poses.
       /// \return Pointer to new Subscriber object
       SubscriberPtr Subscribe(const std::string &_topic,
-          void(*_fp)(const std::string &), bool _latching = false)
+          void(*_fp)(const std::string &), bool _latching = false,
+          bool _latestOnly = false)
       {
         SubscribeOptions ops;
         std::string decodedTopic = this->DecodeTopicName(_topic);
         ops.Init(decodedTopic, shared_from_this(), _latching);
+        ops.SetLatestOnly(_latestOnly);
+
+        CallbackHelperPtr helper(new RawCallbackHelper(_fp));
+        helper->SetLatestOnly(_latestOnly);
 
         {
           boost::recursive_mutex::scoped_lock lock(this->incomingMutex);
-          this->callbacks[decodedTopic].push_back(
-              CallbackHelperPtr(new RawCallbackHelper(_fp)));
+          this->callbacks[decodedTopic].push_back(helper);
         }
 
         SubscriberPtr result =
           transport::TopicManager::Instance()->Subscribe(ops);
 
-        result->SetCallbackId(this->callbacks[decodedTopic].back()->GetId());
+        result->SetCallbackId(helper->GetId());
 
         return result;
       }
@@ -390,6 +445,25 @@ namespace gazebo
       /// \param[in] _id Id of the callback.
       public: void RemoveCallback(const std::string &_topic, unsigned int _id);
 
+      /// \internal
+      /// \brief Post the messages of a topic to its dispatch thread.
+      /// The incomingMutex must be locked.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in,out] _msgs Messages of the topic, moved to the thread.
+      /// \return False if the topic isn't dispatched, in which case the
+      /// messages are left in _msgs.
+      private: template<typename M>
+               bool Dispatch(const std::string &_topic, std::list<M> &_msgs);
+
+      /// \internal
+      /// \brief Pass messages to the callbacks of a topic. Called by the
+      /// dispatch thread of the topic.
+      /// \param[in] _topic Name of the topic.
+      /// \param[in] _msgs Messages of the topic.
+      private: template<typename M>
+               void ProcessDispatched(const std::string &_topic,
+                                      const std::list<M> &_msgs);
+
       /// \internal
       /// \brief Private implementation of Init() and TryInit()
       /// \param[in] _space Namespace to initialize this Node to. Use an empty
@@ -421,12 +495,21 @@ namespace gazebo
 
       private: boost::mutex publisherMutex;
       private: boost::mutex publisherDeleteMutex;
-      private: boost::recursive_mutex incomingMutex;
+      private: mutable boost::recursive_mutex incomingMutex;
 
       /// \brief make sure we don't call ProcessingIncoming simultaneously
       /// from separate threads.
       private: boost::recursive_mutex processIncomingMutex;
 
+      /// \brief Locked by a dispatch thread while it calls the callbacks
+      /// of this node, and by RemoveCallback for a dispatched topic.
+      /// Always locked before incomingMutex.
+      private: boost::recursive_mutex dispatchMutex;
+
+      /// \brief Incremented when callbacks are removed, so that a
+      /// dispatch thread knows that its copy of the callbacks is stale.
+      private: std::atomic<unsigned int> callbackGeneration;
+
       private: bool initialized;
     };
     /// \}
@@ -18,6 +18,9 @@
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/msgs/MsgFactory.hh"
+#include "gazebo/transport/ArenaPool.hh"
+#include "gazebo/transport/MulticastChannel.hh"
 #include "SubscriptionTransport.hh"
 #include "Publication.hh"
 #include "Node.hh"
@@ -30,7 +33,8 @@ unsigned int Publication::idCounter = 0;
 
 //////////////////////////////////////////////////
 Publication::Publication(const std::string &_topic, const std::string &_msgType)
-  : topic(_topic), msgType(_msgType), locallyAdvertised(false)
+  : topic(_topic), msgType(_msgType), locallyAdvertised(false),
+    arenas(new ArenaPool())
 {
   this->id = idCounter++;
 }
@@ -42,20 +46,51 @@ Publication::~Publication()
   this->publishers.clear();
 }
 
+//////////////////////////////////////////////////
+ArenaPoolPtr Publication::Arenas() const
+{
+  return this->arenas;
+}
+
+//////////////////////////////////////////////////
+bool Publication::EnableMulticast()
+{
+  boost::mutex::scoped_lock lock(this->callbackMutex);
+  if (this->multicast)
+    return true;
+
+  std::unique_ptr<MulticastChannel> channel(new MulticastChannel());
+  if (!channel->OpenSender(MulticastChannel::Group(),
+        MulticastChannel::Port(), this->topic))
+  {
+    return false;
+  }
+
+  this->multicast = std::move(channel);
+  return true;
+}
+
+//////////////////////////////////////////////////
+uint32_t Publication::MulticastId() const
+{
+  boost::mutex::scoped_lock lock(this->callbackMutex);
+  return this->multicast ? this->multicast->SenderId() : 0;
+}
+
 //////////////////////////////////////////////////
 void Publication::AddSubscription(const NodePtr &_node)
 {
   std::list<NodePtr>::iterator iter, endIter;
 
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
     endIter = this->nodes.end();
     iter = std::find(this->nodes.begin(), this->nodes.end(), _node);
   }
 
   if (iter == endIter)
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
     this->nodes.push_back(_node);
   }
 
@@ -180,7 +215,8 @@ void Publication::RemoveTransport(const std::string &host_, unsigned int port_)
 //////////////////////////////////////////////////
 void Publication::RemoveSubscription(const NodePtr &_node)
 {
-  boost::mutex::scoped_try_lock lock(this->nodeMutex);
+  std::unique_lock<common::ProfiledMutex<boost::mutex>> lock(
+      this->nodeMutex, std::try_to_lock);
   if (!lock)
   {
     boost::mutex::scoped_lock removeLock(this->nodeRemoveMutex);
@@ -249,14 +285,33 @@ void Publication::LocalPublish(const std::string &_data)
 {
   std::list<NodePtr>::iterator iter, endIter;
 
+  // Parse the data once, and share the message between all the local
+  // subscribers. Unknown message types are handed out as raw data, and
+  // each subscriber parses it. Nodes with raw subscribers get the data as
+  // received, so that it isn't serialized again for them.
+  MessagePtr msg;
+
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
+
+    if (!this->nodes.empty())
+    {
+      if (!this->prototype)
+        this->prototype = msgs::MsgFactory::NewMsg(this->msgType);
+      if (this->prototype)
+        msg = this->arenas->Create(*this->prototype);
+      if (msg && !msg->ParseFromString(_data))
+        msg.reset();
+    }
 
     iter = this->nodes.begin();
     endIter = this->nodes.end();
     while (iter != endIter)
     {
-      if ((*iter)->HandleData(this->topic, _data))
+      bool handled = msg && !(*iter)->HasRawSubscriber(this->topic) ?
+          (*iter)->HandleMessage(this->topic, msg) :
+          (*iter)->HandleData(this->topic, _data);
+      if (handled)
         ++iter;
       else
         this->nodes.erase(iter++);
@@ -296,7 +351,7 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
   std::list<NodePtr>::iterator iter, endIter;
 
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
 
     iter = this->nodes.begin();
     endIter = this->nodes.end();
@@ -323,10 +378,36 @@ int Publication::Publish(MessagePtr _msg, boost::function<void(uint32_t)> _cb,
       _msg->SerializeToString(&data);
       std::list<CallbackHelperPtr>::iterator cbIter;
       cbIter = this->callbacks.begin();
+      bool multicastSent = false;
 
       while (cbIter != this->callbacks.end())
       {
-        if ((*cbIter)->HandleData(data, _cb, _id))
+        // Subscribers on multicast share a single send, and their
+        // connection only tells whether they are still there.
+        SubscriptionTransportPtr subLink;
+        if (this->multicast)
+        {
+          subLink = boost::dynamic_pointer_cast<SubscriptionTransport>(
+              *cbIter);
+        }
+        if (subLink && subLink->GetMulticast())
+        {
+          if (subLink->GetConnection() && subLink->GetConnection()->IsOpen())
+          {
+            if (!multicastSent)
+            {
+              this->multicast->Send(data);
+              multicastSent = true;
+            }
+            if (!_cb.empty())
+              _cb(_id);
+            ++result;
+            ++cbIter;
+          }
+          else
+            this->callbacks.erase(cbIter++);
+        }
+        else if ((*cbIter)->HandleData(data, _cb, _id))
         {
           ++result;
           ++cbIter;
@@ -378,7 +459,7 @@ unsigned int Publication::PublisherCount() const
 //////////////////////////////////////////////////
 unsigned int Publication::GetNodeCount() const
 {
-  boost::mutex::scoped_lock lock(this->nodeMutex);
+  std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
   return this->nodes.size();
 }
 
@@ -456,7 +537,8 @@ void Publication::RemoveNodes()
     for (std::list<unsigned int>::iterator iter = this->removeNodes.begin();
         iter != this->removeNodes.end(); ++iter)
     {
-      boost::mutex::scoped_lock lock(this->nodeMutex);
+      std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(
+          this->nodeMutex);
       for (nodeIter = this->nodes.begin(); nodeIter != this->nodes.end();
           ++nodeIter)
       {
@@ -505,7 +587,7 @@ void Publication::RemoveNodes()
   this->removeCallbacks.clear();
 
   {
-    boost::mutex::scoped_lock lock(this->nodeMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(this->nodeMutex);
     // If no more subscribers, then disconnect from all publishers
     if (this->nodes.empty() && this->callbacks.empty())
     {
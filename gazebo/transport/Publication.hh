@@ -26,7 +26,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
+#include "gazebo/common/LockProfiler.hh"
 #include "gazebo/transport/CallbackHelper.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/transport/PublicationTransport.hh"
@@ -36,6 +38,8 @@ namespace gazebo
 {
   namespace transport
   {
+    class MulticastChannel;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -112,11 +116,15 @@ namespace gazebo
       /// otherwise it was not
       public: void SetLocallyAdvertised(bool _value);
 
-      /// \brief Publish data to local subscribers (skip serialization)
+      /// \brief Publish data received from a remote publisher to local
+      /// subscribers. The data is parsed once, and the resulting message is
+      /// shared between all local nodes.
       /// \param[in] _data The data to be published
       public: void LocalPublish(const std::string &_data);
 
-      /// \brief Publish data to remote subscribers
+      /// \brief Publish a message. Local nodes receive _msg itself, which
+      /// must not be modified afterwards. The message is serialized once,
+      /// and only if there are remote subscribers.
       /// \param[in] _msg Message to be published
       /// \param[in] _cb Callback to be invoked after publishing
       /// is completed
@@ -164,6 +172,21 @@ namespace gazebo
       /// \param[in,out] _pub Pointer to publisher object to be added
       public: void AddPublisher(PublisherPtr _pub);
 
+      /// \brief Send the messages of this publication through UDP
+      /// multicast to the remote subscribers that accept it, instead of
+      /// one copy per connection. See MulticastChannel.
+      /// \return True if the multicast channel is open.
+      public: bool EnableMulticast();
+
+      /// \brief Get the sender id of the multicast channel, to advertise
+      /// it in msgs::Publish::multicast_id.
+      /// \return Sender id, or 0 if multicast isn't enabled.
+      public: uint32_t MulticastId() const;
+
+      /// \brief Get the arenas of the messages of this topic.
+      /// \return The pool shared by the publishers of the topic.
+      public: ArenaPoolPtr Arenas() const;
+
       /// \brief Remove nodes that have been marked for removal
       private: void RemoveNodes();
 
@@ -201,7 +224,8 @@ namespace gazebo
       private: bool locallyAdvertised;
 
       /// \brief Mutex to protect the list of nodes.
-      private: mutable boost::mutex nodeMutex;
+      private: mutable common::ProfiledMutex<boost::mutex> nodeMutex{
+          "transport/publication_nodes"};
 
       /// \brief Mutex to protect the list of nodes.
       private: mutable boost::mutex callbackMutex;
@@ -211,6 +235,17 @@ namespace gazebo
 
       /// \brief Publishers and their last messages.
       private: std::map<uint32_t, MessagePtr> prevMsgs;
+
+      /// \brief Arenas of the messages published or received.
+      private: ArenaPoolPtr arenas;
+
+      /// \brief Empty message of the topic's type, to create the messages
+      /// received from remote publishers. Null until the first one.
+      private: MessagePtr prototype;
+
+      /// \brief Multicast channel of the publication, null if multicast
+      /// isn't enabled.
+      private: std::unique_ptr<MulticastChannel> multicast;
     };
     /// \}
   }
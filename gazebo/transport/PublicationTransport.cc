@@ -16,6 +16,12 @@
 */
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include "gazebo/transport/Compression.hh"
+#include "gazebo/transport/MulticastChannel.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/ConnectionManager.hh"
 #include "gazebo/transport/PublicationTransport.hh"
@@ -51,11 +57,37 @@ PublicationTransport::~PublicationTransport()
 
     ConnectionManager::Instance()->RemoveConnection(this->connection);
   }
+  if (this->multicast)
+    this->multicast->Close();
   this->callback.clear();
 }
 
 /////////////////////////////////////////////////
-void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
+bool PublicationTransport::InitMulticast(const msgs::Publish &_pub)
+{
+  const char *multicastEnv = std::getenv("GAZEBO_MULTICAST");
+  if ((multicastEnv && std::string(multicastEnv) == "0") ||
+      !_pub.has_multicast_id() || !_pub.multicast_id())
+  {
+    return false;
+  }
+
+  std::unique_ptr<MulticastChannel> channel(new MulticastChannel());
+  if (!channel->OpenReceiver(_pub.multicast_group(), _pub.multicast_port(),
+        this->topic, _pub.multicast_id(),
+        common::weakBind(&PublicationTransport::OnMulticast,
+          this->shared_from_this(), _1)))
+  {
+    return false;
+  }
+
+  this->multicast = std::move(channel);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched,
+    bool _latestOnly)
 {
   this->connection = _conn;
   msgs::Subscribe sub;
@@ -64,6 +96,36 @@ void PublicationTransport::Init(const ConnectionPtr &_conn, bool _latched)
   sub.set_host(this->connection->GetLocalAddress());
   sub.set_port(this->connection->GetLocalPort());
   sub.set_latching(_latched);
+  sub.set_latest_only(_latestOnly);
+  sub.set_multicast(this->multicast != nullptr);
+
+  // Offer a shared memory ring to a publisher on this host. The publisher
+  // ignores it if it is remote or doesn't support it.
+  const char *shmEnv = std::getenv("GAZEBO_SHM");
+  if ((!shmEnv || std::string(shmEnv) != "0") &&
+      this->connection->GetRemoteAddress() ==
+      this->connection->GetLocalAddress())
+  {
+    std::random_device rd;
+    std::ostringstream name;
+    name << "gazebo_shm_" << std::hex << rd() << rd() << "_" << this->id;
+
+    std::unique_ptr<ShmRing> ring(new ShmRing());
+    if (ring->Create(name.str(), ShmRing::kDefaultCapacity))
+    {
+      this->shm = std::move(ring);
+      sub.set_shm_name(this->shm->Name());
+    }
+  }
+
+  // Ask a publisher on another host to compress large messages.
+  if (this->connection->GetRemoteAddress() !=
+      this->connection->GetLocalAddress())
+  {
+    std::string codec = Compression::RequestedCodec();
+    if (!codec.empty())
+      sub.set_compression(codec);
+  }
 
   this->connection->EnqueueMsg(msgs::Package("sub", sub));
 
@@ -92,12 +154,38 @@ void PublicationTransport::OnPublish(const std::string &_data)
 
     if (!_data.empty())
     {
-      if (this->callback)
+      // A marker means the message is in the shared memory ring.
+      if (this->shm && _data.size() == 1 && _data[0] == ShmRing::kMarker)
+      {
+        std::string data;
+        if (!this->shm->Read(data))
+          gzerr << "Missing message in shared memory ring for topic["
+                << this->topic << "]\n";
+        else if (this->callback)
+          (this->callback)(data);
+      }
+      else if (Compression::IsCompressed(_data))
+      {
+        std::string data;
+        if (!Compression::Decompress(_data, data))
+          gzerr << "Invalid compressed message for topic["
+                << this->topic << "]\n";
+        else if (this->callback)
+          (this->callback)(data);
+      }
+      else if (this->callback)
         (this->callback)(_data);
     }
   }
 }
 
+/////////////////////////////////////////////////
+void PublicationTransport::OnMulticast(const std::string &_data)
+{
+  if (this->callback)
+    (this->callback)(_data);
+}
+
 /////////////////////////////////////////////////
 const ConnectionPtr PublicationTransport::GetConnection() const
 {
@@ -125,4 +213,7 @@ void PublicationTransport::Fini()
     this->connection->Cancel();
     // this->connection.reset();
   }
+
+  if (this->multicast)
+    this->multicast->Close();
 }
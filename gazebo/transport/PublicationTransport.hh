@@ -20,8 +20,10 @@
 
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <memory>
 #include <string>
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/Connection.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/util/system.hh"
@@ -30,6 +32,9 @@ namespace gazebo
 {
   namespace transport
   {
+    class MulticastChannel;
+    class ShmRing;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -53,7 +58,17 @@ namespace gazebo
       /// \param[in] _conn The underlying connection.
       /// \param[in] _latched True to grab the last message sent on the
       /// topic.
-      public: void Init(const ConnectionPtr &_conn, bool _latched);
+      /// \param[in] _latestOnly True to ask the publisher for the newest
+      /// message only, when every subscriber of this process wants it.
+      public: void Init(const ConnectionPtr &_conn, bool _latched,
+                        bool _latestOnly = false);
+
+      /// \brief Receive the messages through the multicast channel of
+      /// the publisher, if it offers one. Must be called before Init, and
+      /// only for subscribers that accept losses.
+      /// \param[in] _pub The publisher, from the master.
+      /// \return True if the channel was joined.
+      public: bool InitMulticast(const msgs::Publish &_pub);
 
       /// \brief Finalize the transport
       public: void Fini();
@@ -79,6 +94,10 @@ namespace gazebo
       /// \param[in] _data Data to be published.
       private: void OnPublish(const std::string &_data);
 
+      /// \brief Called when a message arrives through multicast.
+      /// \param[in] _data Serialized message.
+      private: void OnMulticast(const std::string &_data);
+
       /// \brief The topic for this publication transport.
       private: std::string topic;
 
@@ -88,6 +107,13 @@ namespace gazebo
       /// \brief The connection for the publication transport
       private: ConnectionPtr connection;
 
+      /// \brief Shared memory ring for large messages from a publisher on
+      /// this host, null if not in use.
+      private: std::unique_ptr<ShmRing> shm;
+
+      /// \brief Multicast channel of the publisher, null if not in use.
+      private: std::unique_ptr<MulticastChannel> multicast;
+
       /// \brief Callback used when OnPublish is called.
       private: boost::function<void (const std::string &)> callback;
 
@@ -23,6 +23,7 @@
 
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/WeakBind.hh"
+#include "gazebo/transport/ArenaPool.hh"
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/TopicManager.hh"
 #include "gazebo/transport/Publisher.hh"
@@ -70,22 +71,21 @@ void Publisher::WaitForConnection() const
 //////////////////////////////////////////////////
 bool Publisher::WaitForConnection(const common::Time &_timeout) const
 {
-  common::Time start = common::Time::GetWallTime();
-  common::Time curr = common::Time::GetWallTime();
+  const int64_t start = common::Time::SteadyNs();
+  int64_t curr = start;
 
   while (!this->HasConnections() &&
-      (_timeout <= 0.0 || curr - start < _timeout))
+      (_timeout <= 0.0 || curr - start < _timeout.Ns()))
   {
     common::Time::MSleep(100);
-    curr = common::Time::GetWallTime();
+    curr = common::Time::SteadyNs();
   }
 
   return this->HasConnections();
 }
 
 //////////////////////////////////////////////////
-void Publisher::PublishImpl(const google::protobuf::Message &_message,
-                            bool _block)
+bool Publisher::ValidateAndThrottle(const google::protobuf::Message &_message)
 {
   if (_message.GetTypeName() != this->msgType)
     gzthrow("Invalid message type\n");
@@ -95,37 +95,72 @@ void Publisher::PublishImpl(const google::protobuf::Message &_message,
     gzerr << "Publishing an uninitialized message on topic[" <<
       this->topic << "]. Required field [" <<
       _message.InitializationErrorString() << "] missing.\n";
-    return;
+    return false;
   }
 
   // Check if a throttling rate has been set
   if (this->updatePeriod > 0)
   {
     // Get the current time
-    this->currentTime = common::Time::GetWallTime();
+    const int64_t currentNs = common::Time::SteadyNs();
 
     // Skip publication if the time difference is less than the update period.
-    if (this->prevPublishTime != common::Time(0, 0) &&
-        (this->currentTime - this->prevPublishTime).Double() <
-        this->updatePeriod)
+    if (this->prevPublishNs != 0 &&
+        (currentNs - this->prevPublishNs) * 1e-9 < this->updatePeriod)
     {
-      return;
+      return false;
     }
 
     // Set the previous time a message was published
-    this->prevPublishTime = this->currentTime;
+    this->prevPublishNs = currentNs;
   }
 
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(const google::protobuf::Message &_message,
+                            bool _block)
+{
+  if (!this->ValidateAndThrottle(_message))
+    return;
+
   // Save the latest message
-  MessagePtr msgPtr(_message.New());
+  MessagePtr msgPtr = this->CreateMessage(_message);
   msgPtr->CopyFrom(_message);
 
-  this->publication->SetPrevMsg(this->id, msgPtr);
+  this->Enqueue(msgPtr, _block);
+}
+
+//////////////////////////////////////////////////
+void Publisher::PublishImpl(MessagePtr _message, bool _block)
+{
+  if (!this->ValidateAndThrottle(*_message))
+    return;
+
+  // The message is shared with the caller, local subscribers and the
+  // latched message buffer, so it's not copied.
+  this->Enqueue(_message, _block);
+}
+
+//////////////////////////////////////////////////
+MessagePtr Publisher::CreateMessage(
+    const google::protobuf::Message &_prototype)
+{
+  if (this->publication)
+    return this->publication->Arenas()->Create(_prototype);
+  return MessagePtr(_prototype.New());
+}
+
+//////////////////////////////////////////////////
+void Publisher::Enqueue(MessagePtr _message, bool _block)
+{
+  this->publication->SetPrevMsg(this->id, _message);
 
   {
     boost::mutex::scoped_lock lock(this->mutex);
 
-    this->messages.push_back(msgPtr);
+    this->messages.push_back(_message);
 
     if (this->messages.size() > this->queueLimit)
     {
@@ -101,6 +101,41 @@ namespace gazebo
               void Publish(M _message, bool _block = false)
               { this->PublishImpl(_message, _block); }
 
+      /// \brief Publish a shared message on the topic without copying it.
+      /// Local subscribers receive the same message instance, and the
+      /// message is only serialized if there are remote subscribers. The
+      /// caller must not modify the message after publishing it.
+      /// \param[in] _message Message to be published
+      /// \param[in] _block Whether to block until the message is actually
+      /// written into the local message buffer, and SendMessage() is called.
+      public: template<typename M>
+              void Publish(const boost::shared_ptr<M> &_message,
+                           bool _block = false)
+              {
+                if (!_message)
+                  return;
+                this->PublishImpl(boost::const_pointer_cast<
+                    typename std::remove_const<M>::type>(_message), _block);
+              }
+
+      /// \brief Create a message to fill and publish with the shared
+      /// message Publish. The message is on a protobuf arena reused by the
+      /// messages of the topic, see ArenaPool.
+      /// \return The new message.
+      public: template<typename M>
+              boost::shared_ptr<M> CreateMessage()
+              {
+                return boost::static_pointer_cast<M>(
+                    this->CreateMessage(M::default_instance()));
+              }
+
+      /// \brief Create a message to fill and publish with the shared
+      /// message Publish.
+      /// \param[in] _prototype A message of the type to create.
+      /// \return The new message.
+      public: MessagePtr CreateMessage(
+                  const google::protobuf::Message &_prototype);
+
       /// \brief Get the number of outgoing messages
       /// \return The number of outgoing messages
       public: unsigned int GetOutgoingCount() const;
@@ -147,6 +182,27 @@ namespace gazebo
       private: void PublishImpl(const google::protobuf::Message &_message,
                                 bool _block);
 
+      /// \brief Implementation of Publish for shared messages.
+      /// \param[in] _message Message to be published, owned by the
+      /// transport from now on.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void PublishImpl(MessagePtr _message, bool _block);
+
+      /// \brief Check a message before publishing it, and apply the
+      /// publication rate throttling.
+      /// \param[in] _message Message to be published.
+      /// \return True if the message should be published.
+      private: bool ValidateAndThrottle(
+                   const google::protobuf::Message &_message);
+
+      /// \brief Store a message as the latest message and add it to the
+      /// outgoing queue.
+      /// \param[in] _message Message to be published.
+      /// \param[in] _block Whether to block until the message is actually
+      /// written out.
+      private: void Enqueue(MessagePtr _message, bool _block);
+
       /// \brief Callback when a publish is completed
       /// \param[in] _id ID associated with the publication.
       private: void OnPublishComplete(uint32_t _id);
@@ -182,8 +238,9 @@ namespace gazebo
       /// \brief Pointer to our containing node.
       private: NodePtr node;
 
-      private: common::Time currentTime;
-      private: common::Time prevPublishTime;
+      /// \brief Steady time of the last throttled publication in
+      /// nanoseconds, zero before the first.
+      private: int64_t prevPublishNs = 0;
 
       /// \brief Current id of the sent message.
       private: uint32_t pubId;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/ShmRing.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief Layout of the start of the shared memory segment. The ring
+    /// data follows it.
+    struct ShmRingHeader
+    {
+      /// \brief Identifies a valid ring.
+      uint32_t magic;
+
+      /// \brief Size of the ring data in bytes.
+      uint64_t capacity;
+
+      /// \brief Total bytes written. Only modified by the writer.
+      std::atomic<uint64_t> head;
+
+      /// \brief Total bytes read. Only modified by the reader.
+      std::atomic<uint64_t> tail;
+    };
+
+    /// \internal
+    /// \brief Private data for ShmRing
+    class ShmRingPrivate
+    {
+      /// \brief Copy bytes into the ring, wrapping around the end.
+      /// \param[in] _pos Ring position to write at.
+      /// \param[in] _src Bytes to copy.
+      /// \param[in] _size Number of bytes.
+      public: void CopyIn(const uint64_t _pos, const char *_src,
+                          const std::size_t _size)
+              {
+                std::size_t offset = _pos % this->header->capacity;
+                std::size_t first = std::min(_size,
+                    static_cast<std::size_t>(this->header->capacity - offset));
+                std::memcpy(this->data + offset, _src, first);
+                std::memcpy(this->data, _src + first, _size - first);
+              }
+
+      /// \brief Copy bytes out of the ring, wrapping around the end.
+      /// \param[in] _pos Ring position to read at.
+      /// \param[out] _dst Destination.
+      /// \param[in] _size Number of bytes.
+      public: void CopyOut(const uint64_t _pos, char *_dst,
+                           const std::size_t _size) const
+              {
+                std::size_t offset = _pos % this->header->capacity;
+                std::size_t first = std::min(_size,
+                    static_cast<std::size_t>(this->header->capacity - offset));
+                std::memcpy(_dst, this->data + offset, first);
+                std::memcpy(_dst + first, this->data, _size - first);
+              }
+
+      /// \brief Value of ShmRingHeader::magic for a valid ring.
+      public: static const uint32_t kMagic = 0x677a7368;
+
+      /// \brief Name of the segment.
+      public: std::string name;
+
+      /// \brief True if this instance created the segment.
+      public: bool owner = false;
+
+      /// \brief The mapped segment.
+      public: boost::interprocess::mapped_region region;
+
+      /// \brief Header at the start of the segment.
+      public: ShmRingHeader *header = nullptr;
+
+      /// \brief Start of the ring data.
+      public: char *data = nullptr;
+
+      /// \brief Serializes writers in this process.
+      public: std::mutex writeMutex;
+
+      /// \brief Serializes readers in this process.
+      public: std::mutex readMutex;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+ShmRing::ShmRing()
+: dataPtr(new ShmRingPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ShmRing::~ShmRing()
+{
+  if (this->dataPtr->owner)
+  {
+    boost::interprocess::shared_memory_object::remove(
+        this->dataPtr->name.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Create(const std::string &_name, const std::size_t _capacity)
+{
+  try
+  {
+    boost::interprocess::shared_memory_object::remove(_name.c_str());
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::create_only, _name.c_str(),
+        boost::interprocess::read_write);
+    shm.truncate(sizeof(ShmRingHeader) + _capacity);
+
+    // Remove the segment from here on, even if mapping fails.
+    this->dataPtr->name = _name;
+    this->dataPtr->owner = true;
+
+    this->dataPtr->region = boost::interprocess::mapped_region(shm,
+        boost::interprocess::read_write);
+  }
+  catch(boost::interprocess::interprocess_exception &_e)
+  {
+    gzwarn << "Unable to create shared memory ring[" << _name << "]: "
+           << _e.what() << std::endl;
+    return false;
+  }
+
+  this->dataPtr->header = new(this->dataPtr->region.get_address())
+    ShmRingHeader;
+  this->dataPtr->header->capacity = _capacity;
+  this->dataPtr->header->head = 0;
+  this->dataPtr->header->tail = 0;
+  this->dataPtr->data = static_cast<char *>(
+      this->dataPtr->region.get_address()) + sizeof(ShmRingHeader);
+
+  // Publish the ring to the writer last.
+  std::atomic_thread_fence(std::memory_order_release);
+  this->dataPtr->header->magic = ShmRingPrivate::kMagic;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Open(const std::string &_name)
+{
+  try
+  {
+    boost::interprocess::shared_memory_object shm(
+        boost::interprocess::open_only, _name.c_str(),
+        boost::interprocess::read_write);
+    this->dataPtr->region = boost::interprocess::mapped_region(shm,
+        boost::interprocess::read_write);
+  }
+  catch(boost::interprocess::interprocess_exception &)
+  {
+    return false;
+  }
+
+  if (this->dataPtr->region.get_size() < sizeof(ShmRingHeader))
+    return false;
+
+  auto header = static_cast<ShmRingHeader *>(
+      this->dataPtr->region.get_address());
+  if (header->magic != ShmRingPrivate::kMagic ||
+      this->dataPtr->region.get_size() <
+      sizeof(ShmRingHeader) + header->capacity)
+  {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  this->dataPtr->name = _name;
+  this->dataPtr->header = header;
+  this->dataPtr->data = static_cast<char *>(
+      this->dataPtr->region.get_address()) + sizeof(ShmRingHeader);
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Write(const std::string &_data)
+{
+  if (!this->dataPtr->header)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->writeMutex);
+
+  ShmRingHeader *header = this->dataPtr->header;
+  uint32_t size = static_cast<uint32_t>(_data.size());
+  uint64_t head = header->head.load(std::memory_order_relaxed);
+  uint64_t tail = header->tail.load(std::memory_order_acquire);
+
+  if (_data.size() > UINT32_MAX ||
+      header->capacity - (head - tail) < sizeof(size) + _data.size())
+  {
+    return false;
+  }
+
+  this->dataPtr->CopyIn(head, reinterpret_cast<const char *>(&size),
+      sizeof(size));
+  this->dataPtr->CopyIn(head + sizeof(size), _data.data(), _data.size());
+
+  header->head.store(head + sizeof(size) + _data.size(),
+      std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ShmRing::Read(std::string &_data)
+{
+  if (!this->dataPtr->header)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->readMutex);
+
+  ShmRingHeader *header = this->dataPtr->header;
+  uint64_t tail = header->tail.load(std::memory_order_relaxed);
+  uint64_t head = header->head.load(std::memory_order_acquire);
+
+  if (head - tail < sizeof(uint32_t))
+    return false;
+
+  uint32_t size = 0;
+  this->dataPtr->CopyOut(tail, reinterpret_cast<char *>(&size), sizeof(size));
+  if (head - tail < sizeof(size) + size)
+  {
+    gzerr << "Corrupt shared memory ring[" << this->dataPtr->name << "]\n";
+    return false;
+  }
+
+  _data.resize(size);
+  if (size > 0)
+    this->dataPtr->CopyOut(tail + sizeof(size), &_data[0], size);
+
+  header->tail.store(tail + sizeof(size) + size, std::memory_order_release);
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string ShmRing::Name() const
+{
+  if (!this->dataPtr->header)
+    return std::string();
+  return this->dataPtr->name;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_SHMRING_HH_
+#define GAZEBO_TRANSPORT_SHMRING_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class
+    class ShmRingPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \class ShmRing ShmRing.hh
+    /// \brief Single producer, single consumer ring buffer of messages in
+    /// shared memory.
+    ///
+    /// The subscriber of a topic creates the ring and passes its name to a
+    /// publisher on the same host, which opens it and writes large
+    /// messages into it instead of the TCP socket. The socket then carries
+    /// only a short marker per message, which keeps the messages in order
+    /// and wakes up the reader.
+    class GZ_TRANSPORT_VISIBLE ShmRing
+    {
+      /// \brief Messages smaller than this are cheaper to send through the
+      /// socket.
+      public: static const std::size_t kMinMessageSize = 64 * 1024;
+
+      /// \brief Default size of a ring in bytes.
+      public: static const std::size_t kDefaultCapacity = 32 * 1024 * 1024;
+
+      /// \brief Message sent through the socket in place of a message
+      /// written to the ring. A serialized protobuf message never consists
+      /// of a single zero byte.
+      public: static const char kMarker = '\0';
+
+      /// \brief Constructor
+      public: ShmRing();
+
+      /// \brief Destructor. Removes the shared memory segment if this
+      /// instance created it.
+      public: ~ShmRing();
+
+      /// \brief Create a new ring. Used by the reader.
+      /// \param[in] _name Name of the shared memory segment.
+      /// \param[in] _capacity Size of the ring in bytes.
+      /// \return True if the segment was created.
+      public: bool Create(const std::string &_name,
+                          const std::size_t _capacity);
+
+      /// \brief Open a ring created by another process. Used by the
+      /// writer.
+      /// \param[in] _name Name of the shared memory segment.
+      /// \return True if the segment exists and holds a valid ring.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Append a message to the ring.
+      /// \param[in] _data The message.
+      /// \return False if the ring isn't valid or doesn't have room for
+      /// the message.
+      public: bool Write(const std::string &_data);
+
+      /// \brief Remove the oldest message from the ring.
+      /// \param[out] _data The message.
+      /// \return False if the ring isn't valid or is empty.
+      public: bool Read(std::string &_data);
+
+      /// \brief Get the name of the shared memory segment.
+      /// \return Name of the segment, empty if the ring isn't valid.
+      public: std::string Name() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<ShmRingPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
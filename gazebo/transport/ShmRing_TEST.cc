@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/transport/ShmRing.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ShmRingTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, InvalidRing)
+{
+  transport::ShmRing ring;
+  EXPECT_TRUE(ring.Name().empty());
+  EXPECT_FALSE(ring.Write("data"));
+
+  std::string data;
+  EXPECT_FALSE(ring.Read(data));
+
+  EXPECT_FALSE(ring.Open("gazebo_shm_test_does_not_exist"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, WriteRead)
+{
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_shm_test_write_read", 64));
+  EXPECT_EQ("gazebo_shm_test_write_read", reader.Name());
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+
+  std::string data;
+  EXPECT_FALSE(reader.Read(data));
+
+  // Messages come out in order, and wrap around the end of the ring.
+  for (int i = 0; i < 20; ++i)
+  {
+    std::string msg1 = "message " + std::to_string(i);
+    std::string msg2(i, 'x');
+    EXPECT_TRUE(writer.Write(msg1));
+    EXPECT_TRUE(writer.Write(msg2));
+
+    EXPECT_TRUE(reader.Read(data));
+    EXPECT_EQ(msg1, data);
+    EXPECT_TRUE(reader.Read(data));
+    EXPECT_EQ(msg2, data);
+    EXPECT_FALSE(reader.Read(data));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(ShmRingTest, Full)
+{
+  transport::ShmRing reader;
+  ASSERT_TRUE(reader.Create("gazebo_shm_test_full", 32));
+
+  transport::ShmRing writer;
+  ASSERT_TRUE(writer.Open(reader.Name()));
+
+  // Each message takes 4 bytes of size plus its data.
+  EXPECT_FALSE(writer.Write(std::string(29, 'a')));
+  EXPECT_TRUE(writer.Write(std::string(12, 'a')));
+  EXPECT_TRUE(writer.Write(std::string(12, 'b')));
+  EXPECT_FALSE(writer.Write("c"));
+
+  std::string data;
+  EXPECT_TRUE(reader.Read(data));
+  EXPECT_EQ(std::string(12, 'a'), data);
+  EXPECT_TRUE(writer.Write("c"));
+
+  EXPECT_TRUE(reader.Read(data));
+  EXPECT_EQ(std::string(12, 'b'), data);
+  EXPECT_TRUE(reader.Read(data));
+  EXPECT_EQ("c", data);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
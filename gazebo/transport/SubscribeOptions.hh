@@ -36,7 +36,7 @@ namespace gazebo
     {
       /// \brief Constructor
       public: SubscribeOptions()
-              : latching(false)
+              : latching(false), latestOnly(false)
               {}
 
       /// \brief Initialize the options
@@ -103,10 +103,30 @@ namespace gazebo
                 return this->latching;
               }
 
+      /// \brief Set whether only the newest message is delivered. Older
+      /// messages that weren't delivered yet are replaced by newer ones,
+      /// both in the subscribing node and, when every subscriber of the
+      /// process wants it, in the queue of a remote publisher.
+      /// \param[in] _latestOnly True to conflate the messages.
+      public: void SetLatestOnly(const bool _latestOnly)
+              {
+                this->latestOnly = _latestOnly;
+              }
+
+      /// \brief Is only the newest message delivered?
+      /// \return True if the messages are conflated.
+      public: bool GetLatestOnly() const
+              {
+                return this->latestOnly;
+              }
+
       private: std::string topic;
       private: std::string msgType;
       private: NodePtr node;
       private: bool latching;
+
+      /// \brief True if only the newest message is delivered.
+      private: bool latestOnly;
     };
     /// \}
   }
@@ -16,7 +16,10 @@
 */
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include "gazebo/common/WeakBind.hh"
+#include "gazebo/transport/Compression.hh"
 #include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/ShmRing.hh"
 #include "gazebo/transport/SubscriptionTransport.hh"
 
 using namespace gazebo;
@@ -32,6 +35,11 @@ SubscriptionTransport::SubscriptionTransport()
 //////////////////////////////////////////////////
 SubscriptionTransport::~SubscriptionTransport()
 {
+  // The publisher of a message that won't be sent still expects its
+  // callback.
+  if (this->latestPending && !this->latestCb.empty())
+    this->latestCb(this->latestId);
+
   ConnectionManager::Instance()->RemoveConnection(this->connection);
   this->connection.reset();
 }
@@ -43,6 +51,53 @@ void SubscriptionTransport::Init(ConnectionPtr _conn, bool _latching)
   this->latching = _latching;
 }
 
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitSharedMemory(const std::string &_name)
+{
+  // Only use shared memory with a subscriber on this host.
+  if (_name.empty() || !this->connection ||
+      this->connection->GetRemoteAddress() !=
+      this->connection->GetLocalAddress())
+  {
+    return false;
+  }
+
+  std::unique_ptr<ShmRing> ring(new ShmRing());
+  if (!ring->Open(_name))
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->shmMutex);
+  this->shm = std::move(ring);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::InitCompression(const std::string &_codec)
+{
+  // Links on this host are faster than compression.
+  if (_codec != Compression::kZlib || !this->connection ||
+      this->connection->GetRemoteAddress() ==
+      this->connection->GetLocalAddress())
+  {
+    return false;
+  }
+
+  this->compressMinSize = Compression::MinSize();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::SetMulticast(const bool _multicast)
+{
+  this->multicast = _multicast;
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::GetMulticast() const
+{
+  return this->multicast;
+}
+
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 {
@@ -54,10 +109,117 @@ bool SubscriptionTransport::HandleMessage(MessagePtr _newMsg)
 //////////////////////////////////////////////////
 bool SubscriptionTransport::HandleData(const std::string &_newdata,
     boost::function<void(uint32_t)> _cb, uint32_t _id)
+{
+  if (!this->latestOnly)
+    return this->Send(_newdata, _cb, _id);
+
+  bool queued = false;
+  boost::function<void(uint32_t)> replacedCb;
+  uint32_t replacedId = 0;
+  {
+    std::lock_guard<std::mutex> lock(this->latestMutex);
+    if (this->latestSending)
+    {
+      // Wait behind the message being sent, replacing an older one
+      if (this->latestPending)
+      {
+        replacedCb.swap(this->latestCb);
+        replacedId = this->latestId;
+      }
+      this->latestData = _newdata;
+      this->latestCb = _cb;
+      this->latestId = _id;
+      this->latestPending = true;
+      queued = true;
+    }
+    else
+    {
+      this->latestSending = true;
+    }
+  }
+
+  if (queued)
+  {
+    // The replaced message counts as sent for its publisher
+    if (!replacedCb.empty())
+      replacedCb(replacedId);
+    return true;
+  }
+
+  if (!this->Send(_newdata, common::weakBind(
+          &SubscriptionTransport::OnLatestSent, this->shared_from_this(),
+          _cb, _1), _id))
+  {
+    std::lock_guard<std::mutex> lock(this->latestMutex);
+    this->latestSending = false;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void SubscriptionTransport::OnLatestSent(boost::function<void(uint32_t)> _cb,
+    uint32_t _id)
+{
+  if (!_cb.empty())
+    _cb(_id);
+
+  std::string data;
+  boost::function<void(uint32_t)> cb;
+  uint32_t id;
+  {
+    std::lock_guard<std::mutex> lock(this->latestMutex);
+    if (!this->latestPending)
+    {
+      this->latestSending = false;
+      return;
+    }
+
+    data.swap(this->latestData);
+    cb.swap(this->latestCb);
+    id = this->latestId;
+    this->latestPending = false;
+  }
+
+  if (!this->Send(data, common::weakBind(
+          &SubscriptionTransport::OnLatestSent, this->shared_from_this(),
+          cb, _1), id))
+  {
+    std::lock_guard<std::mutex> lock(this->latestMutex);
+    this->latestSending = false;
+  }
+}
+
+//////////////////////////////////////////////////
+bool SubscriptionTransport::Send(const std::string &_newdata,
+    boost::function<void(uint32_t)> _cb, uint32_t _id)
 {
   bool result = false;
   if (this->connection->IsOpen())
   {
+    // Large messages go through the shared memory ring, if there is room,
+    // and the connection carries only a marker for each of them.
+    if (this->shm && _newdata.size() >= ShmRing::kMinMessageSize)
+    {
+      std::lock_guard<std::mutex> lock(this->shmMutex);
+      if (this->shm->Write(_newdata))
+      {
+        this->connection->EnqueueMsg(
+            std::string(1, ShmRing::kMarker), _cb, _id);
+        return true;
+      }
+    }
+
+    if (this->compressMinSize > 0 && _newdata.size() >= this->compressMinSize)
+    {
+      std::string frame;
+      if (Compression::Compress(_newdata, frame))
+      {
+        this->connection->EnqueueMsg(frame, _cb, _id);
+        return true;
+      }
+    }
+
     this->connection->EnqueueMsg(_newdata, _cb, _id);
     result = true;
   }
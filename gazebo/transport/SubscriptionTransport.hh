@@ -17,8 +17,12 @@
 #ifndef _SUBSCRIPTIONTRANSPORT_HH_
 #define _SUBSCRIPTIONTRANSPORT_HH_
 
+#include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "Connection.hh"
@@ -29,6 +33,8 @@ namespace gazebo
 {
   namespace transport
   {
+    class ShmRing;
+
     /// \addtogroup gazebo_transport
     /// \{
 
@@ -36,7 +42,13 @@ namespace gazebo
     /// transport/transport.hh
     /// \brief Handles sending data over the wire to
     /// remote subscribers
-    class GZ_TRANSPORT_VISIBLE SubscriptionTransport : public CallbackHelper
+    ///
+    /// A latest only subscription (see CallbackHelper::SetLatestOnly) has
+    /// at most one message waiting in the connection. A newer message
+    /// replaces the one waiting behind it, so a slow subscriber gets
+    /// the newest message instead of the backlog.
+    class GZ_TRANSPORT_VISIBLE SubscriptionTransport : public CallbackHelper,
+      public boost::enable_shared_from_this<SubscriptionTransport>
     {
       /// \brief Constructor
       public: SubscriptionTransport();
@@ -50,6 +62,35 @@ namespace gazebo
       /// don't latch
       public: void Init(ConnectionPtr _conn, bool _latching);
 
+      /// \brief Send large messages through a shared memory ring created
+      /// by the remote subscriber. Only takes effect if the subscriber is
+      /// on this host and the ring can be opened; otherwise all messages
+      /// keep going through the connection.
+      /// \param[in] _name Name of the ring, from msgs::Subscribe::shm_name.
+      /// \return True if the ring is in use.
+      public: bool InitSharedMemory(const std::string &_name);
+
+      /// \brief Compress large messages for a subscriber on another
+      /// host. Messages below Compression::MinSize() and links on this
+      /// host stay uncompressed.
+      /// \param[in] _codec Codec accepted by the subscriber, from
+      /// msgs::Subscribe::compression.
+      /// \return True if messages will be compressed.
+      public: bool InitCompression(const std::string &_codec);
+
+      /// \brief Set whether the subscriber receives the messages through
+      /// the UDP multicast channel of the publication. The connection then
+      /// only carries the latched message, and tells whether the
+      /// subscriber is still there.
+      /// \param[in] _multicast From msgs::Subscribe::multicast.
+      public: void SetMulticast(const bool _multicast);
+
+      /// \brief Get whether the subscriber receives the messages through
+      /// multicast.
+      /// \return True if Publication::Publish mustn't send the messages
+      /// to the connection.
+      public: bool GetMulticast() const;
+
       /// \brief Output a message to a connection
       /// \param[in] _newdata The message to be handled
       /// \return true if the message was handled successfully, false otherwise
@@ -71,7 +112,55 @@ namespace gazebo
       /// is tied to a  remote connection
       public: virtual bool IsLocal() const;
 
+      /// \brief Write a message to the ring or the connection.
+      /// \param[in] _newdata The message.
+      /// \param[in] _cb Callback invoked once the message is sent.
+      /// \param[in] _id ID associated with the message data.
+      /// \return True if the message was queued.
+      private: bool Send(const std::string &_newdata,
+                         boost::function<void(uint32_t)> _cb, uint32_t _id);
+
+      /// \brief Called when a message of a latest only subscription is
+      /// sent. Sends the message that replaced the older ones, if any.
+      /// \param[in] _cb Callback of the message that was sent.
+      /// \param[in] _id ID of the message that was sent.
+      private: void OnLatestSent(boost::function<void(uint32_t)> _cb,
+                                 uint32_t _id);
+
       private: ConnectionPtr connection;
+
+      /// \brief Shared memory ring to the subscriber, null if not in use.
+      private: std::unique_ptr<ShmRing> shm;
+
+      /// \brief Keeps ring writes and their markers in the same order.
+      private: std::mutex shmMutex;
+
+      /// \brief Size above which messages are compressed, 0 if they
+      /// aren't.
+      private: std::size_t compressMinSize = 0;
+
+      /// \brief True if the subscriber receives the messages through
+      /// multicast.
+      private: bool multicast = false;
+
+      /// \brief Protects the latest only state below.
+      private: std::mutex latestMutex;
+
+      /// \brief True while a message of a latest only subscription is in
+      /// the connection.
+      private: bool latestSending = false;
+
+      /// \brief True if a message waits for the one being sent.
+      private: bool latestPending = false;
+
+      /// \brief The waiting message.
+      private: std::string latestData;
+
+      /// \brief Callback of the waiting message.
+      private: boost::function<void(uint32_t)> latestCb;
+
+      /// \brief ID of the waiting message.
+      private: uint32_t latestId = 0;
     };
     /// \}
   }
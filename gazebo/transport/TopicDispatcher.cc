@@ -0,0 +1,469 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/TopicDispatcher.hh"
+
+using namespace gazebo;
+using namespace transport;
+
+namespace gazebo
+{
+  namespace transport
+  {
+    /// \internal
+    /// \brief A dispatch thread and its queue.
+    class DispatchLane
+    {
+      /// \brief Clock used to measure latencies.
+      public: typedef std::chrono::steady_clock Clock;
+
+      /// \brief Constructor
+      /// \param[in] _name Pattern or topic served by the thread.
+      /// \param[in] _limit Number of batches the queue can hold.
+      public: DispatchLane(const std::string &_name, const std::size_t _limit);
+
+      /// \brief Create a lane and start its thread. The thread keeps the
+      /// lane alive until Stop() is called.
+      /// \param[in] _name Pattern or topic served by the thread.
+      /// \param[in] _limit Number of batches the queue can hold.
+      /// \return The new lane.
+      public: static std::shared_ptr<DispatchLane> Start(
+                  const std::string &_name, const std::size_t _limit);
+
+      /// \brief Queue a task, dropping the oldest one if the queue is
+      /// full.
+      /// \param[in] _task The task.
+      public: void Post(const TopicDispatcher::Task &_task);
+
+      /// \brief Stop the thread and drop the queued tasks.
+      public: void Stop();
+
+      /// \brief Run the queued tasks until the lane is stopped.
+      private: void Run();
+
+      /// \brief Pattern or topic served by the thread.
+      public: const std::string name;
+
+      /// \brief Number of batches the queue can hold.
+      public: std::size_t limit;
+
+      /// \brief Protects the queue, the metrics and the stop flag.
+      public: std::mutex mutex;
+
+      /// \brief Signaled when a task is queued or the lane is stopped.
+      public: std::condition_variable condition;
+
+      /// \brief Tasks with the time they were queued.
+      public: std::deque<std::pair<TopicDispatcher::Task, Clock::time_point>>
+              queue;
+
+      /// \brief Metrics of the lane.
+      public: DispatchStats stats;
+
+      /// \brief True when the thread must exit.
+      public: bool stop = false;
+
+      /// \brief The dispatch thread.
+      public: std::thread thread;
+    };
+
+    /// \internal
+    /// \brief Private data for TopicDispatcher
+    class TopicDispatcherPrivate
+    {
+      /// \brief Find the lane of a topic. The mutex must be locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return The lane, or null if the topic isn't dispatched.
+      public: std::shared_ptr<DispatchLane> Lane(const std::string &_topic);
+
+      /// \brief Protects everything below.
+      public: mutable std::mutex mutex;
+
+      /// \brief Lanes of the patterns, in the order they were added.
+      public: std::vector<std::shared_ptr<DispatchLane>> patternLanes;
+
+      /// \brief Lanes by topic, null for topics in the shared loop.
+      public: std::map<std::string, std::shared_ptr<DispatchLane>> topicLanes;
+
+      /// \brief Number of lanes created for slow topics.
+      public: unsigned int slowLaneCount = 0;
+
+      /// \brief Slow threshold in seconds, 0 if disabled.
+      public: double slowThreshold = 0;
+
+      /// \brief Number of batches a new queue can hold.
+      public: std::size_t queueLimit = TopicDispatcher::kDefaultQueueLimit;
+
+      /// \brief Copy of Enabled(), read without the mutex.
+      public: std::atomic<bool> enabled{false};
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a topic matches a dispatch pattern.
+/// \param[in] _pattern Pattern given to TopicDispatcher::SetDedicated.
+/// \param[in] _topic Fully qualified topic name.
+/// \return True if the topic matches.
+static bool matchTopic(const std::string &_pattern, const std::string &_topic)
+{
+  std::string pattern = _pattern;
+  std::string topic = _topic;
+
+  // "~/" stands for "/gazebo/<namespace>/"
+  if (pattern.compare(0, 2, "~/") == 0)
+  {
+    if (topic.compare(0, 8, "/gazebo/") != 0)
+      return false;
+    size_t pos = topic.find('/', 8);
+    if (pos == std::string::npos)
+      return false;
+    topic = topic.substr(pos + 1);
+    pattern = pattern.substr(2);
+  }
+
+  if (!pattern.empty() && pattern.back() == '*')
+    return topic.compare(0, pattern.size() - 1, pattern, 0,
+        pattern.size() - 1) == 0;
+
+  return topic == pattern;
+}
+
+//////////////////////////////////////////////////
+DispatchLane::DispatchLane(const std::string &_name, const std::size_t _limit)
+  : name(_name), limit(_limit)
+{
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<DispatchLane> DispatchLane::Start(const std::string &_name,
+    const std::size_t _limit)
+{
+  std::shared_ptr<DispatchLane> lane(new DispatchLane(_name, _limit));
+  lane->thread = std::thread([lane]()
+      {
+        lane->Run();
+      });
+  return lane;
+}
+
+//////////////////////////////////////////////////
+void DispatchLane::Post(const TopicDispatcher::Task &_task)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->stop)
+      return;
+
+    if (this->queue.size() >= this->limit)
+    {
+      if (this->stats.dropped == 0)
+      {
+        gzwarn << "Dispatch queue of [" << this->name << "] is full, "
+          << "dropping messages. This warning is printed only once."
+          << std::endl;
+      }
+      this->queue.pop_front();
+      ++this->stats.dropped;
+    }
+
+    this->queue.push_back(std::make_pair(_task, Clock::now()));
+    this->stats.queueDepth = this->queue.size();
+    this->stats.maxQueueDepth = std::max(this->stats.maxQueueDepth,
+        this->stats.queueDepth);
+  }
+  this->condition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void DispatchLane::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+    this->queue.clear();
+    this->stats.queueDepth = 0;
+  }
+  this->condition.notify_one();
+
+  // A task of the lane may be the one stopping it
+  if (this->thread.joinable())
+  {
+    if (this->thread.get_id() == std::this_thread::get_id())
+      this->thread.detach();
+    else
+      this->thread.join();
+  }
+}
+
+//////////////////////////////////////////////////
+void DispatchLane::Run()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (!this->stop)
+  {
+    if (this->queue.empty())
+    {
+      this->condition.wait(lock);
+      continue;
+    }
+
+    TopicDispatcher::Task task = std::move(this->queue.front().first);
+    Clock::time_point posted = this->queue.front().second;
+    this->queue.pop_front();
+    this->stats.queueDepth = this->queue.size();
+    lock.unlock();
+
+    Clock::time_point start = Clock::now();
+    task();
+    Clock::time_point end = Clock::now();
+    task = nullptr;
+
+    lock.lock();
+    ++this->stats.processed;
+    this->stats.maxLatency = std::max(this->stats.maxLatency,
+        std::chrono::duration<double>(start - posted).count());
+    this->stats.maxDuration = std::max(this->stats.maxDuration,
+        std::chrono::duration<double>(end - start).count());
+  }
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<DispatchLane> TopicDispatcherPrivate::Lane(
+    const std::string &_topic)
+{
+  auto iter = this->topicLanes.find(_topic);
+  if (iter != this->topicLanes.end())
+    return iter->second;
+
+  std::shared_ptr<DispatchLane> lane;
+  for (auto const &patternLane : this->patternLanes)
+  {
+    if (matchTopic(patternLane->name, _topic))
+    {
+      lane = patternLane;
+      break;
+    }
+  }
+  this->topicLanes[_topic] = lane;
+  return lane;
+}
+
+//////////////////////////////////////////////////
+TopicDispatcher::TopicDispatcher()
+  : dataPtr(new TopicDispatcherPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+TopicDispatcher::~TopicDispatcher()
+{
+  this->Fini();
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::Load()
+{
+  const char *queueEnv = std::getenv("GAZEBO_DISPATCH_QUEUE");
+  if (queueEnv)
+  {
+    int limit = std::atoi(queueEnv);
+    if (limit > 0)
+      this->SetQueueLimit(limit);
+    else
+      gzerr << "Invalid GAZEBO_DISPATCH_QUEUE[" << queueEnv << "]\n";
+  }
+
+  const char *slowEnv = std::getenv("GAZEBO_DISPATCH_SLOW_MS");
+  if (slowEnv)
+    this->SetSlowThreshold(std::max(0.0, std::atof(slowEnv)) * 1e-3);
+
+  const char *topicsEnv = std::getenv("GAZEBO_DISPATCH_TOPICS");
+  if (topicsEnv)
+  {
+    std::istringstream stream(topicsEnv);
+    std::string pattern;
+    while (std::getline(stream, pattern, ','))
+    {
+      if (!pattern.empty())
+        this->SetDedicated(pattern);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::Fini()
+{
+  std::vector<std::shared_ptr<DispatchLane>> lanes;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    lanes = this->dataPtr->patternLanes;
+    for (auto const &topicLane : this->dataPtr->topicLanes)
+    {
+      if (topicLane.second)
+        lanes.push_back(topicLane.second);
+    }
+    this->dataPtr->patternLanes.clear();
+    this->dataPtr->topicLanes.clear();
+    this->dataPtr->slowLaneCount = 0;
+    this->dataPtr->slowThreshold = 0;
+    this->dataPtr->enabled = false;
+  }
+
+  // Stop the threads without the mutex, their tasks may be posting
+  for (auto &lane : lanes)
+    lane->Stop();
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::SetDedicated(const std::string &_pattern)
+{
+  if (_pattern.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  for (auto const &lane : this->dataPtr->patternLanes)
+  {
+    if (lane->name == _pattern)
+      return;
+  }
+
+  this->dataPtr->patternLanes.push_back(DispatchLane::Start(
+        _pattern, this->dataPtr->queueLimit));
+
+  // Topics looked up before may match the new pattern, forget the ones
+  // that aren't dispatched yet.
+  for (auto iter = this->dataPtr->topicLanes.begin();
+       iter != this->dataPtr->topicLanes.end();)
+  {
+    if (!iter->second)
+      iter = this->dataPtr->topicLanes.erase(iter);
+    else
+      ++iter;
+  }
+  this->dataPtr->enabled = true;
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::SetSlowThreshold(const double _seconds)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->slowThreshold = std::max(0.0, _seconds);
+  this->dataPtr->enabled = this->dataPtr->slowThreshold > 0 ||
+    !this->dataPtr->topicLanes.empty() || !this->dataPtr->patternLanes.empty();
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::SetQueueLimit(const std::size_t _limit)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->queueLimit = std::max(_limit, static_cast<std::size_t>(1));
+}
+
+//////////////////////////////////////////////////
+bool TopicDispatcher::Enabled() const
+{
+  return this->dataPtr->enabled;
+}
+
+//////////////////////////////////////////////////
+bool TopicDispatcher::Dispatched(const std::string &_topic) const
+{
+  if (!this->dataPtr->enabled)
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->Lane(_topic) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool TopicDispatcher::Post(const std::string &_topic, const Task &_task)
+{
+  if (!this->dataPtr->enabled)
+    return false;
+
+  std::shared_ptr<DispatchLane> lane;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    lane = this->dataPtr->Lane(_topic);
+  }
+
+  if (!lane)
+    return false;
+
+  lane->Post(_task);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void TopicDispatcher::ReportDuration(const std::string &_topic,
+    const double _seconds)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->slowThreshold <= 0 ||
+      _seconds <= this->dataPtr->slowThreshold ||
+      this->dataPtr->Lane(_topic))
+  {
+    return;
+  }
+
+  gzmsg << "Callbacks of topic [" << _topic << "] took " << _seconds
+    << " seconds, moving them to a dedicated dispatch thread." << std::endl;
+
+  this->dataPtr->topicLanes[_topic] = DispatchLane::Start(
+      _topic, this->dataPtr->queueLimit);
+  ++this->dataPtr->slowLaneCount;
+}
+
+//////////////////////////////////////////////////
+bool TopicDispatcher::Stats(const std::string &_topic,
+    DispatchStats &_stats) const
+{
+  std::shared_ptr<DispatchLane> lane;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    lane = this->dataPtr->Lane(_topic);
+  }
+
+  if (!lane)
+    return false;
+
+  std::lock_guard<std::mutex> lock(lane->mutex);
+  _stats = lane->stats;
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int TopicDispatcher::ThreadCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->patternLanes.size() + this->dataPtr->slowLaneCount;
+}
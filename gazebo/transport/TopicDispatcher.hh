@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TRANSPORT_TOPICDISPATCHER_HH_
+#define GAZEBO_TRANSPORT_TOPICDISPATCHER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace transport
+  {
+    // Forward declare private data class
+    class TopicDispatcherPrivate;
+
+    /// \addtogroup gazebo_transport
+    /// \{
+
+    /// \brief Back-pressure metrics of a dispatch thread.
+    class GZ_TRANSPORT_VISIBLE DispatchStats
+    {
+      /// \brief Number of batches waiting in the queue.
+      public: std::size_t queueDepth = 0;
+
+      /// \brief Largest number of batches that waited in the queue.
+      public: std::size_t maxQueueDepth = 0;
+
+      /// \brief Number of batches processed.
+      public: uint64_t processed = 0;
+
+      /// \brief Number of batches dropped because the queue was full.
+      public: uint64_t dropped = 0;
+
+      /// \brief Longest time in seconds that a batch waited in the queue.
+      public: double maxLatency = 0;
+
+      /// \brief Longest time in seconds that a batch took to process.
+      public: double maxDuration = 0;
+    };
+
+    /// \class TopicDispatcher TopicDispatcher.hh transport/transport.hh
+    /// \brief Runs the subscriber callbacks of selected topics on
+    /// dedicated threads, instead of the loop of
+    /// TopicManager::ProcessNodes that serves every other topic.
+    ///
+    /// A topic is dispatched when it matches a pattern given to
+    /// SetDedicated(), or when one of its messages took longer than the
+    /// slow threshold to process in the shared loop. Every pattern and
+    /// every slow topic gets its own thread and queue. When a queue is
+    /// full, its oldest batch of messages is dropped.
+    ///
+    /// The initial configuration is read from the environment:
+    /// GAZEBO_DISPATCH_TOPICS is a comma separated list of patterns,
+    /// GAZEBO_DISPATCH_SLOW_MS is the slow threshold in milliseconds and
+    /// GAZEBO_DISPATCH_QUEUE is the queue limit.
+    class GZ_TRANSPORT_VISIBLE TopicDispatcher
+    {
+      /// \brief Work posted to a dispatch thread.
+      public: typedef std::function<void()> Task;
+
+      /// \brief Default number of batches a queue can hold.
+      public: static const std::size_t kDefaultQueueLimit = 1000;
+
+      /// \brief Constructor
+      public: TopicDispatcher();
+
+      /// \brief Destructor. Stops the threads.
+      public: ~TopicDispatcher();
+
+      /// \brief Read the configuration from the environment.
+      public: void Load();
+
+      /// \brief Stop the threads and forget the configuration. Batches
+      /// still in a queue are dropped.
+      public: void Fini();
+
+      /// \brief Give the topics that match a pattern a dedicated thread.
+      /// \param[in] _pattern A fully qualified topic name, or a name that
+      /// starts with "~/" to match it in every namespace. A trailing '*'
+      /// matches any suffix.
+      public: void SetDedicated(const std::string &_pattern);
+
+      /// \brief Set the time after which a topic is moved out of the
+      /// shared loop.
+      /// \param[in] _seconds Longest time a message can take to process,
+      /// 0 to never move topics.
+      public: void SetSlowThreshold(const double _seconds);
+
+      /// \brief Set the number of batches a queue can hold.
+      /// \param[in] _limit Queue limit, at least 1.
+      public: void SetQueueLimit(const std::size_t _limit);
+
+      /// \brief Get whether any topic can be dispatched. When false, the
+      /// shared loop doesn't need to query or time anything.
+      /// \return True if there is a pattern or a slow threshold.
+      public: bool Enabled() const;
+
+      /// \brief Get whether a topic has a dedicated thread.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return True if the callbacks of the topic must be posted.
+      public: bool Dispatched(const std::string &_topic) const;
+
+      /// \brief Queue work on the thread of a topic.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _task Work to run on the thread.
+      /// \return False if the topic isn't dispatched, in which case the
+      /// caller must run the work itself.
+      public: bool Post(const std::string &_topic, const Task &_task);
+
+      /// \brief Report the time the shared loop took to process a message
+      /// of a topic. The topic gets a dedicated thread if the time
+      /// exceeds the slow threshold.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _seconds Processing time.
+      public: void ReportDuration(const std::string &_topic,
+                                  const double _seconds);
+
+      /// \brief Get the metrics of the thread of a topic.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[out] _stats Metrics of the thread, which may be shared
+      /// with other topics that match the same pattern.
+      /// \return False if the topic isn't dispatched.
+      public: bool Stats(const std::string &_topic,
+                         DispatchStats &_stats) const;
+
+      /// \brief Get the number of dispatch threads.
+      /// \return Number of threads.
+      public: unsigned int ThreadCount() const;
+
+      /// \internal
+      /// \brief Private data pointer
+      private: std::unique_ptr<TopicDispatcherPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "gazebo/transport/TopicDispatcher.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TopicDispatcherTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Wait until a counter reaches a value.
+/// \param[in] _counter The counter.
+/// \param[in] _value Expected value.
+/// \return True if the value was reached within a few seconds.
+bool waitFor(const std::atomic<int> &_counter, const int _value)
+{
+  for (int i = 0; i < 500 && _counter < _value; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  return _counter == _value;
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, Disabled)
+{
+  transport::TopicDispatcher dispatcher;
+  EXPECT_FALSE(dispatcher.Enabled());
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/pose/info"));
+  EXPECT_FALSE(dispatcher.Post("/gazebo/default/pose/info", []() {}));
+  EXPECT_EQ(dispatcher.ThreadCount(), 0u);
+
+  // Without a threshold, slow topics stay in the shared loop
+  dispatcher.ReportDuration("/gazebo/default/pose/info", 10);
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/pose/info"));
+
+  transport::DispatchStats stats;
+  EXPECT_FALSE(dispatcher.Stats("/gazebo/default/pose/info", stats));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, Patterns)
+{
+  transport::TopicDispatcher dispatcher;
+  dispatcher.SetDedicated("~/pose/info");
+  dispatcher.SetDedicated("/gazebo/default/sensor/*");
+  dispatcher.SetDedicated("~/pose/info");
+  EXPECT_TRUE(dispatcher.Enabled());
+  EXPECT_EQ(dispatcher.ThreadCount(), 2u);
+
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/pose/info"));
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/other/pose/info"));
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/pose/info2"));
+  EXPECT_FALSE(dispatcher.Dispatched("/pose/info"));
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/sensor/cam/image"));
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/other/sensor/cam/image"));
+
+  // A topic looked up before a pattern is added can match it
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/world_stats"));
+  dispatcher.SetDedicated("~/world_stats");
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/world_stats"));
+
+  dispatcher.Fini();
+  EXPECT_FALSE(dispatcher.Enabled());
+  EXPECT_EQ(dispatcher.ThreadCount(), 0u);
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/pose/info"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, Post)
+{
+  transport::TopicDispatcher dispatcher;
+  dispatcher.SetDedicated("~/pose/info");
+
+  // Tasks run in order on a thread other than the caller's
+  std::atomic<int> count(0);
+  std::atomic<bool> ordered(true);
+  std::atomic<bool> otherThread(true);
+  const std::thread::id caller = std::this_thread::get_id();
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(dispatcher.Post("/gazebo/default/pose/info",
+          [&count, &ordered, &otherThread, caller, i]()
+          {
+            if (count != i)
+              ordered = false;
+            if (std::this_thread::get_id() == caller)
+              otherThread = false;
+            ++count;
+          }));
+  }
+  EXPECT_TRUE(waitFor(count, 10));
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(otherThread);
+
+  EXPECT_FALSE(dispatcher.Post("/gazebo/default/world_stats", []() {}));
+
+  transport::DispatchStats stats;
+  ASSERT_TRUE(dispatcher.Stats("/gazebo/default/pose/info", stats));
+  EXPECT_EQ(stats.processed, 10u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.queueDepth, 0u);
+  EXPECT_GE(stats.maxQueueDepth, 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, BackPressure)
+{
+  transport::TopicDispatcher dispatcher;
+  dispatcher.SetQueueLimit(2);
+  dispatcher.SetDedicated("~/pose/info");
+
+  // Block the thread until all the tasks are posted
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool release = false;
+  std::atomic<int> started(0);
+  std::atomic<int> count(0);
+  auto increment = [&count]()
+    {
+      ++count;
+    };
+  EXPECT_TRUE(dispatcher.Post("/gazebo/default/pose/info",
+        [&]()
+        {
+          ++started;
+          std::unique_lock<std::mutex> lock(mutex);
+          condition.wait(lock, [&release]()
+              {
+                return release;
+              });
+        }));
+  EXPECT_TRUE(waitFor(started, 1));
+
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_TRUE(dispatcher.Post("/gazebo/default/pose/info", increment));
+  }
+
+  transport::DispatchStats stats;
+  ASSERT_TRUE(dispatcher.Stats("/gazebo/default/pose/info", stats));
+  EXPECT_EQ(stats.queueDepth, 2u);
+  EXPECT_EQ(stats.maxQueueDepth, 2u);
+  EXPECT_EQ(stats.dropped, 3u);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  condition.notify_one();
+
+  // Only the newest tasks are left
+  EXPECT_TRUE(waitFor(count, 2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(count, 2);
+
+  ASSERT_TRUE(dispatcher.Stats("/gazebo/default/pose/info", stats));
+  EXPECT_EQ(stats.processed, 3u);
+  EXPECT_GT(stats.maxLatency, 0.0);
+  EXPECT_GT(stats.maxDuration, 0.0);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, SlowTopic)
+{
+  transport::TopicDispatcher dispatcher;
+  dispatcher.SetSlowThreshold(0.01);
+  EXPECT_TRUE(dispatcher.Enabled());
+  EXPECT_EQ(dispatcher.ThreadCount(), 0u);
+
+  // Fast topics stay in the shared loop
+  dispatcher.ReportDuration("/gazebo/default/fast", 0.001);
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/fast"));
+
+  // A slow topic gets its own thread
+  dispatcher.ReportDuration("/gazebo/default/slow", 0.1);
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/slow"));
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/fast"));
+  EXPECT_EQ(dispatcher.ThreadCount(), 1u);
+
+  dispatcher.ReportDuration("/gazebo/default/slow", 0.1);
+  EXPECT_EQ(dispatcher.ThreadCount(), 1u);
+
+  std::atomic<int> count(0);
+  auto increment = [&count]()
+    {
+      ++count;
+    };
+  EXPECT_TRUE(dispatcher.Post("/gazebo/default/slow", increment));
+  EXPECT_TRUE(waitFor(count, 1));
+
+  // Stopping drops the queued tasks
+  dispatcher.Fini();
+  EXPECT_FALSE(dispatcher.Post("/gazebo/default/slow", increment));
+  EXPECT_EQ(count, 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicDispatcherTest, Environment)
+{
+  setenv("GAZEBO_DISPATCH_TOPICS", "~/pose/info,,~/sensor/*", 1);
+  setenv("GAZEBO_DISPATCH_SLOW_MS", "5", 1);
+  setenv("GAZEBO_DISPATCH_QUEUE", "1", 1);
+
+  transport::TopicDispatcher dispatcher;
+  dispatcher.Load();
+  EXPECT_EQ(dispatcher.ThreadCount(), 2u);
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/pose/info"));
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/sensor/cam"));
+
+  dispatcher.ReportDuration("/gazebo/default/fast", 0.004);
+  EXPECT_FALSE(dispatcher.Dispatched("/gazebo/default/fast"));
+  dispatcher.ReportDuration("/gazebo/default/slow", 0.006);
+  EXPECT_TRUE(dispatcher.Dispatched("/gazebo/default/slow"));
+
+  unsetenv("GAZEBO_DISPATCH_TOPICS");
+  unsetenv("GAZEBO_DISPATCH_SLOW_MS");
+  unsetenv("GAZEBO_DISPATCH_QUEUE");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -58,6 +58,7 @@ TopicManager::TopicManager()
     gzwarn << "TopicManager requires the ConnectionManager" << std::endl;
   this->pauseIncoming = false;
   this->advertisedTopicsEnd = this->advertisedTopics.end();
+  this->dispatcher.reset(new TopicDispatcher());
 }
 
 //////////////////////////////////////////////////
@@ -72,6 +73,7 @@ void TopicManager::Init()
   this->advertisedTopicsEnd = this->advertisedTopics.end();
   this->subscribedNodes.clear();
   this->nodes.clear();
+  this->dispatcher->Load();
 }
 
 //////////////////////////////////////////////////
@@ -92,12 +94,14 @@ void TopicManager::Fini()
   this->advertisedTopicsEnd = this->advertisedTopics.end();
   this->subscribedNodes.clear();
   this->nodes.clear();
+  this->dispatcher->Fini();
 }
 
 //////////////////////////////////////////////////
 void TopicManager::AddNode(NodePtr _node)
 {
-  boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+      this->nodeMutex);
   this->nodes.push_back(_node);
 }
 
@@ -105,7 +109,8 @@ void TopicManager::AddNode(NodePtr _node)
 void TopicManager::RemoveNode(unsigned int _id)
 {
   std::vector<NodePtr>::iterator iter;
-  boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+  std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+      this->nodeMutex);
 
   for (iter = this->nodes.begin(); iter != this->nodes.end(); ++iter)
   {
@@ -144,16 +149,24 @@ void TopicManager::AddNodeToProcess(NodePtr _ptr)
 {
   if (_ptr)
   {
-    boost::mutex::scoped_lock lock(this->processNodesMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(
+        this->processNodesMutex);
     this->nodesToProcess.insert(_ptr);
   }
 }
 
+//////////////////////////////////////////////////
+TopicDispatcher &TopicManager::Dispatcher()
+{
+  return *this->dispatcher;
+}
+
 //////////////////////////////////////////////////
 void TopicManager::ProcessNodes(bool _onlyOut)
 {
   {
-    boost::mutex::scoped_lock lock(this->processNodesMutex);
+    std::lock_guard<common::ProfiledMutex<boost::mutex>> lock(
+        this->processNodesMutex);
     for (boost::unordered_set<NodePtr>::iterator iter =
         this->nodesToProcess.begin();
         iter != this->nodesToProcess.end(); ++iter)
@@ -164,7 +177,9 @@ void TopicManager::ProcessNodes(bool _onlyOut)
   }
 
   // Note: In general there are very few nodes. So, parallelization is not
-  // needed. Keeping this code for posterity.
+  // needed. Topics with slow or high priority callbacks are moved to the
+  // threads of the dispatcher by Node::ProcessIncoming instead. Keeping
+  // this code for posterity.
   // int s;
   // {
   //   boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
@@ -188,7 +203,8 @@ void TopicManager::ProcessNodes(bool _onlyOut)
   {
     {
       int s = 0;
-      boost::recursive_mutex::scoped_lock lock(this->nodeMutex);
+      std::lock_guard<common::ProfiledMutex<boost::recursive_mutex>> lock(
+          this->nodeMutex);
       s = this->nodes.size();
 
       for (int i = 0; i < s; ++i)
@@ -339,22 +355,31 @@ void TopicManager::ConnectSubToPub(const msgs::Publish &_pub)
             _pub.msg_type()));
 
       bool latched = false;
+      bool latestOnly = false;
       boost::mutex::scoped_lock lock(this->subscriberMutex);
       SubNodeMap::iterator nodeIter = this->subscribedNodes.find(_pub.topic());
 
       // Find if any local node has a latched subscriber for the new topic
-      // publication transport.
+      // publication transport, and if all of the subscribers only want
+      // the newest message.
       if (nodeIter != this->subscribedNodes.end())
       {
+        latestOnly = !nodeIter->second.empty();
         std::list<NodePtr>::iterator cbIter;
         for (cbIter = nodeIter->second.begin();
-             cbIter != nodeIter->second.end() && !latched; ++cbIter)
+             cbIter != nodeIter->second.end(); ++cbIter)
         {
-          latched = (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          latched = latched || (*cbIter)->HasLatchedSubscriber(_pub.topic());
+          latestOnly = latestOnly &&
+            (*cbIter)->HasLatestOnlySubscribers(_pub.topic());
         }
       }
 
-      publink->Init(conn, latched);
+      // Subscribers that only want the newest message accept losses, so
+      // they can share the multicast channel of the publisher.
+      if (latestOnly)
+        publink->InitMulticast(_pub);
+      publink->Init(conn, latched, latestOnly);
 
       publication->AddTransport(publink);
     }
@@ -20,13 +20,16 @@
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 #include <map>
+#include <memory>
 #include <list>
 #include <string>
 #include <vector>
 #include <boost/unordered/unordered_set.hpp>
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/LockProfiler.hh"
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
 
@@ -38,6 +41,7 @@
 #include "gazebo/transport/Publisher.hh"
 #include "gazebo/transport/Publication.hh"
 #include "gazebo/transport/Subscriber.hh"
+#include "gazebo/transport/TopicDispatcher.hh"
 #include "gazebo/util/system.hh"
 
 /// \brief Explicit instantiation for typed SingletonT.
@@ -98,11 +102,14 @@ namespace gazebo
       /// to queue
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _multicast True to also offer the messages through
+      /// UDP multicast, see Publication::EnableMulticast.
       /// \return Pointer to the newly created Publisher
       public: PublisherPtr Advertise(const std::string &_topic,
                                      const std::string &_msgTypeName,
                                      unsigned int _queueLimit,
-                                     double _hzRate)
+                                     double _hzRate,
+                                     bool _multicast = false)
               {
                 this->UpdatePublications(_topic, _msgTypeName);
 
@@ -115,10 +122,25 @@ namespace gazebo
                     "FindPublication returned nullptr");
 
                 publication->AddPublisher(pub);
+                if (_multicast && !publication->MulticastId())
+                {
+                  // The subscribers already learned about the publisher
+                  if (publication->GetLocallyAdvertised())
+                  {
+                    gzwarn << "Topic[" << _topic << "] was advertised "
+                           << "without multicast, ignoring multicast\n";
+                  }
+                  else if (!publication->EnableMulticast())
+                  {
+                    gzwarn << "Unable to advertise topic[" << _topic
+                           << "] with multicast\n";
+                  }
+                }
+
                 if (!publication->GetLocallyAdvertised())
                 {
                   ConnectionManager::Instance()->Advertise(_topic,
-                      _msgTypeName);
+                      _msgTypeName, publication->MulticastId());
                 }
 
                 publication->SetLocallyAdvertised(true);
@@ -144,11 +166,14 @@ namespace gazebo
       /// to queue
       /// \param[in] _hz Update rate for the publisher. Units are
       /// 1.0/seconds.
+      /// \param[in] _multicast True to also offer the messages through
+      /// UDP multicast, see Publication::EnableMulticast.
       /// \return Pointer to the newly created Publisher
       public: template<typename M>
               PublisherPtr Advertise(const std::string &_topic,
                                      unsigned int _queueLimit,
-                                     double _hzRate)
+                                     double _hzRate,
+                                     bool _multicast = false)
               {
                 google::protobuf::Message *msg = nullptr;
                 M msgtype;
@@ -157,7 +182,7 @@ namespace gazebo
                   gzthrow("Advertise requires a google protobuf type");
 
                 return this->Advertise(_topic, msg->GetTypeName(), _queueLimit,
-                        _hzRate);
+                        _hzRate, _multicast);
               }
 
       /// \brief Unadvertise a topic
@@ -240,6 +265,11 @@ namespace gazebo
       /// \param[in] _ptr Node to process.
       public: void AddNodeToProcess(NodePtr _ptr);
 
+      /// \brief Get the dispatcher that runs the callbacks of selected
+      /// topics outside of ProcessNodes().
+      /// \return The dispatcher, configured by Init().
+      public: TopicDispatcher &Dispatcher();
+
       /// \brief A map of string->list of Node pointers
       typedef std::map<std::string, std::list<NodePtr> > SubNodeMap;
 
@@ -252,16 +282,21 @@ namespace gazebo
       /// \brief Nodes that require processing.
       private: boost::unordered_set<NodePtr> nodesToProcess;
 
-      private: boost::recursive_mutex nodeMutex;
+      private: common::ProfiledMutex<boost::recursive_mutex> nodeMutex{
+          "transport/topic_nodes"};
 
       /// \brief Used to protect subscription connection creation.
       private: boost::mutex subscriberMutex;
 
       /// \brief Mutex to protect node processing
-      private: boost::mutex processNodesMutex;
+      private: common::ProfiledMutex<boost::mutex> processNodesMutex{
+          "transport/process_nodes"};
 
       private: bool pauseIncoming;
 
+      /// \brief Dedicated threads of the dispatched topics.
+      private: std::unique_ptr<TopicDispatcher> dispatcher;
+
       // Singleton implementation
       private: friend class SingletonT<TopicManager>;
     };
@@ -33,6 +33,7 @@ namespace gazebo
 {
   namespace transport
   {
+    class ArenaPool;
     class Publisher;
     class Publication;
     class PublicationTransport;
@@ -44,6 +45,10 @@ namespace gazebo
     /// \brief Shared_ptr to protobuf message
     typedef boost::shared_ptr<google::protobuf::Message> MessagePtr;
 
+    /// \def ArenaPoolPtr
+    /// \brief Shared_ptr to ArenaPool object
+    typedef boost::shared_ptr<ArenaPool> ArenaPoolPtr;
+
     /// \def PublisherPtr
     /// \brief Shared_ptr to Publisher object
     typedef boost::shared_ptr<Publisher> PublisherPtr;
@@ -14,16 +14,23 @@
  * limitations under the License.
  *
  */
+#include <chrono>
 #include <functional>
 #include <iomanip>
+#include <string>
+#include <utility>
+#include <vector>
 #include <ignition/math/SignalStats.hh>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
+#include "gazebo/common/LockProfiler.hh"
 #include "gazebo/common/SystemPaths.hh"
+#include "gazebo/common/URI.hh"
 #include "gazebo/transport/transport.hh"
 #include "gazebo/util/DiagnosticsPrivate.hh"
 #include "gazebo/util/Diagnostics.hh"
+#include "gazebo/util/IntrospectionManager.hh"
 
 using namespace gazebo;
 using namespace util;
@@ -59,6 +66,9 @@ DiagnosticManager::DiagnosticManager()
 #endif
 
   this->dataPtr->logPath = this->dataPtr->logPath / "diagnostics" / timeStr;
+
+  for (auto &slot : this->dataPtr->timerSlots)
+    slot = nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -72,7 +82,43 @@ void DiagnosticManager::Fini()
 {
   this->dataPtr->updateConnection.reset();
 
-  this->dataPtr->timers.clear();
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->exportMutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->exportCondition.notify_all();
+  if (this->dataPtr->exportThread.joinable())
+    this->dataPtr->exportThread.join();
+
+  // Stop the running timers, and export their last measurements before
+  // the timers write their statistics.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto &timer : this->dataPtr->timers)
+      timer.second->Stop();
+  }
+  this->dataPtr->Export();
+
+  TimerMap timers;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto &slot : this->dataPtr->timerSlots)
+      slot = nullptr;
+    std::swap(timers, this->dataPtr->timers);
+  }
+  timers.clear();
+
+  if (this->dataPtr->trace.is_open())
+  {
+    this->dataPtr->trace << "\n]\n";
+    this->dataPtr->trace.close();
+    this->dataPtr->traceEvents = false;
+  }
+
+  for (auto const &item : this->dataPtr->lockItems)
+    IntrospectionManager::Instance()->Unregister(item);
+  this->dataPtr->lockItems.clear();
+  this->dataPtr->lockNames.clear();
 
   this->dataPtr->pub.reset();
   if (this->dataPtr->node)
@@ -92,6 +138,13 @@ void DiagnosticManager::Init(const std::string &_worldName)
 
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
       std::bind(&DiagnosticManager::Update, this, std::placeholders::_1));
+
+  if (!this->dataPtr->exportThread.joinable())
+  {
+    this->dataPtr->stop = false;
+    this->dataPtr->exportThread = std::thread(
+        &DiagnosticManagerPrivate::ExportLoop, this->dataPtr.get());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -103,39 +156,78 @@ boost::filesystem::path DiagnosticManager::LogPath() const
 //////////////////////////////////////////////////
 void DiagnosticManager::Update(const common::UpdateInfo &_info)
 {
-  if (_info.realTime > common::Time::Zero)
-  {
-    this->dataPtr->msg.set_real_time_factor(
-        (_info.simTime / _info.realTime).Double());
-  }
-  else
-  {
-    this->dataPtr->msg.set_real_time_factor(0.0);
-  }
+  std::lock_guard<std::mutex> lock(this->dataPtr->infoMutex);
+  this->dataPtr->info = _info;
+}
 
-  msgs::Set(this->dataPtr->msg.mutable_real_time(), _info.realTime);
-  msgs::Set(this->dataPtr->msg.mutable_sim_time(), _info.simTime);
+//////////////////////////////////////////////////
+void DiagnosticManager::AddTime(const int _label,
+    const common::Time &_wallTime, const common::Time &_elapsedTime,
+    const common::Time &_stat)
+{
+  if (_label < 0)
+    return;
 
-  if (this->dataPtr->pub && this->dataPtr->pub->HasConnections())
-    this->dataPtr->pub->Publish(this->dataPtr->msg);
+  DiagnosticSampleRing *ring = this->dataPtr->ThreadRing();
+  if (!ring->Push({_label, _wallTime, _elapsedTime, _stat}))
+    ++ring->dropped;
+}
 
-  this->dataPtr->msg.clear_time();
+//////////////////////////////////////////////////
+int DiagnosticManager::TimerId(const std::string &_name)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->RegisterLabel(_name, _name, -1);
 }
 
 //////////////////////////////////////////////////
-void DiagnosticManager::AddTime(const std::string &_name,
-    const common::Time &_wallTime, const common::Time &_elapsedTime)
+int DiagnosticManager::LapId(const int _timerId, const std::string &_prefix)
 {
-  msgs::Diagnostics::DiagTime *time = this->dataPtr->msg.add_time();
-  time->set_name(_name);
-  msgs::Set(time->mutable_elapsed(), _elapsedTime);
-  msgs::Set(time->mutable_wall(), _wallTime);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (_timerId < 0 ||
+      static_cast<size_t>(_timerId) >= this->dataPtr->labels.size())
+  {
+    return -1;
+  }
+
+  return this->dataPtr->RegisterLabel(
+      this->dataPtr->labels[_timerId].name + ":" + _prefix, _prefix,
+      _timerId);
 }
 
 //////////////////////////////////////////////////
 void DiagnosticManager::StartTimer(const std::string &_name)
 {
-  TimerMap::iterator iter = this->dataPtr->timers.find(_name);
+  this->StartTimer(this->TimerId(_name));
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManager::StartTimer(const int _timerId)
+{
+  if (_timerId < 0 || _timerId >= DiagnosticManagerPrivate::kMaxLabels)
+    return;
+
+  DiagnosticTimer *timer = this->dataPtr->timerSlots[_timerId].load();
+  if (timer)
+  {
+    timer->Start();
+    return;
+  }
+
+  // First use of the timer since it was registered or since Fini.
+  std::string name;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    if (static_cast<size_t>(_timerId) >= this->dataPtr->labels.size())
+      return;
+    name = this->dataPtr->labels[_timerId].name;
+  }
+
+  // The new timer starts itself.
+  DiagnosticTimerPtr newTimer(new DiagnosticTimer(name));
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  TimerMap::iterator iter = this->dataPtr->timers.find(name);
   if (iter != this->dataPtr->timers.end())
   {
     GZ_ASSERT(iter->second != NULL, "DiagnosticTimerPtr is NULL");
@@ -143,50 +235,68 @@ void DiagnosticManager::StartTimer(const std::string &_name)
   }
   else
   {
-    this->dataPtr->timers[_name] =
-      DiagnosticTimerPtr(new DiagnosticTimer(_name));
+    this->dataPtr->timers[name] = newTimer;
+    this->dataPtr->timerSlots[_timerId] = newTimer.get();
   }
 }
 
 //////////////////////////////////////////////////
 void DiagnosticManager::StopTimer(const std::string &_name)
 {
-  TimerMap::iterator iter = this->dataPtr->timers.find(_name);
-  if (iter != this->dataPtr->timers.end())
+  this->StopTimer(this->TimerId(_name));
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManager::StopTimer(const int _timerId)
+{
+  DiagnosticTimer *timer = nullptr;
+  if (_timerId >= 0 && _timerId < DiagnosticManagerPrivate::kMaxLabels)
+    timer = this->dataPtr->timerSlots[_timerId].load();
+
+  if (timer)
+    timer->Stop();
+  else
   {
-    GZ_ASSERT(iter->second, "DiagnosticTimerPtr is NULL");
-    iter->second->Stop();
+    gzerr << "Unable to find timer[" << this->dataPtr->LabelName(_timerId)
+          << "]\n";
   }
-  else
-    gzerr << "Unable to find timer[" << _name << "]\n";
 }
 
 //////////////////////////////////////////////////
 void DiagnosticManager::Lap(const std::string &_name,
                             const std::string &_prefix)
 {
-  TimerMap::iterator iter;
-  iter = this->dataPtr->timers.find(_name);
+  int timerId = this->TimerId(_name);
+  this->Lap(timerId, this->LapId(timerId, _prefix));
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManager::Lap(const int _timerId, const int _lapId)
+{
+  DiagnosticTimer *timer = nullptr;
+  if (_timerId >= 0 && _timerId < DiagnosticManagerPrivate::kMaxLabels)
+    timer = this->dataPtr->timerSlots[_timerId].load();
 
-  if (iter == this->dataPtr->timers.end())
-    gzerr << "Unable to find timer with name[" << _name << "]\n";
+  if (timer)
+    timer->Lap(_lapId);
   else
   {
-    GZ_ASSERT(iter->second, "DiagnosticTimerPtr is NULL");
-
-    iter->second->Lap(_prefix);
+    gzerr << "Unable to find timer with name["
+          << this->dataPtr->LabelName(_timerId) << "]\n";
   }
 }
 
 //////////////////////////////////////////////////
 int DiagnosticManager::TimerCount() const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return this->dataPtr->timers.size();
 }
 
 //////////////////////////////////////////////////
 common::Time DiagnosticManager::Time(const int _index) const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   if (_index < 0 || static_cast<size_t>(_index) > this->dataPtr->timers.size())
   {
     gzerr << "Invalid index of[" << _index << "]. Must be between 0 and "
@@ -213,6 +323,7 @@ common::Time DiagnosticManager::Time(const int _index) const
 //////////////////////////////////////////////////
 std::string DiagnosticManager::Label(const int _index) const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   if (_index < 0 || static_cast<size_t>(_index) >= this->dataPtr->timers.size())
   {
     gzerr << "Invalid index of[" << _index << "]. Must be between 0 and "
@@ -235,6 +346,7 @@ std::string DiagnosticManager::Label(const int _index) const
 //////////////////////////////////////////////////
 common::Time DiagnosticManager::Time(const std::string &_label) const
 {
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   TimerMap::const_iterator iter;
   iter = this->dataPtr->timers.find(_label);
 
@@ -268,6 +380,7 @@ DiagnosticTimer::DiagnosticTimer(const std::string &_name)
       std::ios::out | std::ios::app);
 
   this->dataPtr->name = _name;
+  this->dataPtr->id = DiagnosticManager::Instance()->TimerId(_name);
   this->Start();
 }
 
@@ -325,10 +438,8 @@ void DiagnosticTimer::Stop()
     this->dataPtr->cumulativeTime += elapsed;
 
     // Record the total elapsed time.
-    this->InsertData(this->dataPtr->name, elapsed.Double());
-
-    DiagnosticManager::Instance()->AddTime(this->dataPtr->name,
-        currTime, elapsed);
+    DiagnosticManager::Instance()->AddTime(this->dataPtr->id,
+        currTime, elapsed, elapsed);
 
     // Reset the lap time and timer
     this->dataPtr->prevLap.Set(0, 0);
@@ -338,6 +449,12 @@ void DiagnosticTimer::Stop()
 
 //////////////////////////////////////////////////
 void DiagnosticTimer::Lap(const std::string &_prefix)
+{
+  this->Lap(DiagnosticManager::Instance()->LapId(this->dataPtr->id, _prefix));
+}
+
+//////////////////////////////////////////////////
+void DiagnosticTimer::Lap(const int _lapId)
 {
   // Get the current elapsed time.
   common::Time elapsed = this->GetElapsed();
@@ -345,10 +462,7 @@ void DiagnosticTimer::Lap(const std::string &_prefix)
   common::Time currTime = common::Time::GetWallTime();
 
   // Record the delta time.
-  this->InsertData(_prefix, elapsed.Double());
-
-  DiagnosticManager::Instance()->AddTime(this->dataPtr->name + ":" + _prefix,
-      currTime, delta);
+  DiagnosticManager::Instance()->AddTime(_lapId, currTime, delta, elapsed);
 
   // Store the previous lap time.
   this->dataPtr->prevLap = elapsed;
@@ -376,3 +490,206 @@ void DiagnosticTimer::InsertData(const std::string &_name,
   iter->second.InsertData(_time.Double());
 }
 
+//////////////////////////////////////////////////
+int DiagnosticManagerPrivate::RegisterLabel(const std::string &_name,
+    const std::string &_statName, const int _timer)
+{
+  auto iter = this->labelIds.find(_name);
+  if (iter != this->labelIds.end())
+    return iter->second;
+
+  if (this->labels.size() >= static_cast<size_t>(kMaxLabels))
+  {
+    gzerr << "Too many diagnostic labels, ignoring[" << _name << "]\n";
+    return -1;
+  }
+
+  int id = static_cast<int>(this->labels.size());
+  this->labels.push_back({_name, _statName, _timer < 0 ? id : _timer});
+  this->labelIds[_name] = id;
+  return id;
+}
+
+//////////////////////////////////////////////////
+std::string DiagnosticManagerPrivate::LabelName(const int _id) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (_id < 0 || static_cast<size_t>(_id) >= this->labels.size())
+    return std::string();
+  return this->labels[_id].name;
+}
+
+//////////////////////////////////////////////////
+DiagnosticSampleRing *DiagnosticManagerPrivate::ThreadRing()
+{
+  thread_local std::shared_ptr<DiagnosticSampleRing> ring;
+  if (!ring)
+  {
+    ring.reset(new DiagnosticSampleRing);
+
+    // The manager keeps the ring, so that samples recorded by a thread
+    // that exits are still exported.
+    std::lock_guard<std::mutex> lock(this->ringsMutex);
+    ring->threadId = static_cast<int>(this->rings.size()) + 1;
+    this->rings.push_back(ring);
+  }
+  return ring.get();
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManagerPrivate::ExportLoop()
+{
+  std::unique_lock<std::mutex> lock(this->exportMutex);
+  while (!this->stop)
+  {
+    this->exportCondition.wait_for(lock, std::chrono::milliseconds(100));
+    if (this->stop)
+      break;
+
+    lock.unlock();
+    this->Export();
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManagerPrivate::Export()
+{
+  std::vector<std::shared_ptr<DiagnosticSampleRing>> allRings;
+  {
+    std::lock_guard<std::mutex> lock(this->ringsMutex);
+    allRings = this->rings;
+  }
+
+  common::UpdateInfo updateInfo;
+  {
+    std::lock_guard<std::mutex> lock(this->infoMutex);
+    updateInfo = this->info;
+  }
+
+  if (updateInfo.realTime > common::Time::Zero)
+  {
+    this->msg.set_real_time_factor(
+        (updateInfo.simTime / updateInfo.realTime).Double());
+  }
+  else
+  {
+    this->msg.set_real_time_factor(0.0);
+  }
+
+  msgs::Set(this->msg.mutable_real_time(), updateInfo.realTime);
+  msgs::Set(this->msg.mutable_sim_time(), updateInfo.simTime);
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+
+    DiagnosticSample sample;
+    for (auto const &ring : allRings)
+    {
+      while (ring->Pop(sample))
+      {
+        if (sample.label < 0 ||
+            static_cast<size_t>(sample.label) >= this->labels.size())
+        {
+          continue;
+        }
+        const DiagnosticLabel &label = this->labels[sample.label];
+
+        msgs::Diagnostics::DiagTime *time = this->msg.add_time();
+        time->set_name(label.name);
+        msgs::Set(time->mutable_elapsed(), sample.elapsed);
+        msgs::Set(time->mutable_wall(), sample.wall);
+
+        DiagnosticTimer *timer = this->timerSlots[label.timer].load();
+        if (timer)
+          timer->InsertData(label.statName, sample.stat);
+
+        if (!this->trace.is_open())
+        {
+          if (!boost::filesystem::exists(this->logPath))
+            boost::filesystem::create_directories(this->logPath);
+          this->trace.open((this->logPath / "trace.json").string().c_str(),
+              std::ios::out | std::ios::trunc);
+          this->trace << "[";
+        }
+
+        // Complete event, in microseconds.
+        int64_t dur = static_cast<int64_t>(sample.elapsed.sec) * 1000000 +
+          sample.elapsed.nsec / 1000;
+        int64_t end = static_cast<int64_t>(sample.wall.sec) * 1000000 +
+          sample.wall.nsec / 1000;
+        this->trace << (this->traceEvents ? ",\n" : "\n")
+          << "{\"name\":\"" << label.name << "\",\"ph\":\"X\",\"pid\":1,"
+          << "\"tid\":" << ring->threadId << ",\"ts\":" << end - dur
+          << ",\"dur\":" << dur << "}";
+        this->traceEvents = true;
+      }
+
+      uint64_t dropped = ring->dropped.exchange(0);
+      if (dropped > 0)
+      {
+        gzwarn << "Dropped " << dropped << " diagnostic samples of thread "
+               << ring->threadId << ", the sample ring is full.\n";
+      }
+    }
+  }
+
+  if (this->trace.is_open())
+    this->trace.flush();
+
+  const bool connected = this->pub && this->pub->HasConnections();
+  this->ExportLocks(connected);
+  if (connected)
+    this->pub->Publish(this->msg);
+
+  this->msg.clear_time();
+  this->msg.clear_lock();
+}
+
+//////////////////////////////////////////////////
+void DiagnosticManagerPrivate::ExportLocks(const bool _fill)
+{
+  for (auto const &sample : common::LockProfiler::Instance()->Samples())
+  {
+    if (_fill)
+    {
+      msgs::Diagnostics::Lock *lock = this->msg.add_lock();
+      lock->set_name(sample.name);
+      lock->set_acquisitions(sample.acquisitions);
+      lock->set_contentions(sample.contentions);
+      lock->set_wait(sample.waitTime);
+      lock->set_max_wait(sample.maxWait);
+      lock->set_hold(sample.holdTime);
+      lock->set_max_hold(sample.maxHold);
+    }
+
+    if (!this->lockNames.insert(sample.name).second)
+      continue;
+
+    // The account outlives the manager.
+    common::LockStats *stats =
+        common::LockProfiler::Instance()->Stats(sample.name);
+    common::URI uri("data://locks/" + sample.name);
+    const std::vector<std::pair<std::string,
+        std::function<double (const common::LockSample &)> > > values =
+    {
+      {"wait_time", [](const common::LockSample &_s) {return _s.waitTime;}},
+      {"hold_time", [](const common::LockSample &_s) {return _s.holdTime;}},
+      {"contentions", [](const common::LockSample &_s)
+          {return static_cast<double>(_s.contentions);}},
+      {"acquisitions", [](const common::LockSample &_s)
+          {return static_cast<double>(_s.acquisitions);}}
+    };
+    for (auto const &value : values)
+    {
+      common::URI itemURI(uri);
+      itemURI.Query().Insert("p", "double/" + value.first);
+      auto get = value.second;
+      if (IntrospectionManager::Instance()->Register<double>(itemURI.Str(),
+          [stats, get]() {return get(stats->Sample());}))
+      {
+        this->lockItems.push_back(itemURI.Str());
+      }
+    }
+  }
+}
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_UTIL_DIAGNOSTICMANAGER_HH_
 #define _GAZEBO_UTIL_DIAGNOSTICMANAGER_HH_
 
+#include <memory>
 #include <string>
 #include <boost/filesystem.hpp>
 
@@ -49,10 +50,15 @@ namespace gazebo
 
 #ifdef ENABLE_DIAGNOSTICS
     /// \brief Start a diagnostic timer. Make sure to run DIAG_TIMER_STOP to
-    /// stop the timer.
+    /// stop the timer. The timer name is registered once per call site.
     /// \param[in] _name Name of the timer to start.
     #define DIAG_TIMER_START(_name) \
-    gazebo::util::DiagnosticManager::Instance()->StartTimer(_name);
+    do { \
+      static const int gzDiagTimerId = \
+        gazebo::util::DiagnosticManager::Instance()->TimerId(_name); \
+      gazebo::util::DiagnosticManager::Instance()->StartTimer( \
+          gzDiagTimerId); \
+    } while (0)
 
     /// \brief Output a lap time annotated with a prefix string. A lap is
     /// the time from last call to DIAG_TIMER_LAP or DIAG_TIMER_START, which
@@ -60,12 +66,25 @@ namespace gazebo
     /// \param[in] _name Name of the timer.
     /// \param[in] _prefix String for annotation.
     #define DIAG_TIMER_LAP(_name, _prefix) \
-    gazebo::util::DiagnosticManager::Instance()->Lap(_name, _prefix);
+    do { \
+      static const int gzDiagTimerId = \
+        gazebo::util::DiagnosticManager::Instance()->TimerId(_name); \
+      static const int gzDiagLapId = \
+        gazebo::util::DiagnosticManager::Instance()->LapId( \
+            gzDiagTimerId, _prefix); \
+      gazebo::util::DiagnosticManager::Instance()->Lap( \
+          gzDiagTimerId, gzDiagLapId); \
+    } while (0)
 
     /// \brief Stop a diagnostic timer.
     /// \param[in] name Name of the timer to stop
     #define DIAG_TIMER_STOP(_name) \
-    gazebo::util::DiagnosticManager::Instance()->StopTimer(_name);
+    do { \
+      static const int gzDiagTimerId = \
+        gazebo::util::DiagnosticManager::Instance()->TimerId(_name); \
+      gazebo::util::DiagnosticManager::Instance()->StopTimer( \
+          gzDiagTimerId); \
+    } while (0)
 #else
     #define DIAG_TIMER_START(_name) ((void) 0)
     #define DIAG_TIMER_LAP(_name, _prefix) ((void)0)
@@ -74,6 +93,12 @@ namespace gazebo
 
     /// \class DiagnosticManager Diagnostics.hh util/util.hh
     /// \brief A diagnostic manager class
+    ///
+    /// Timers record their measurements into a ring buffer owned by the
+    /// calling thread. A background thread drains the rings every
+    /// 100 ms, publishes the measurements on ~/diagnostics, updates the
+    /// timing statistics and appends them to trace.json in the log path,
+    /// which can be opened in chrome://tracing.
     class GZ_UTIL_VISIBLE DiagnosticManager :
       public SingletonT<DiagnosticManager>
     {
@@ -107,6 +132,32 @@ namespace gazebo
       /// elapsed time.
       public: void Lap(const std::string &_name, const std::string &_prefix);
 
+      /// \brief Get the id of a timer, registering it if needed.
+      /// \param[in] _name Name of the timer.
+      /// \return Id to pass to StartTimer, StopTimer and Lap, or -1 if
+      /// too many labels are registered.
+      public: int TimerId(const std::string &_name);
+
+      /// \brief Get the id of a lap of a timer, registering it if needed.
+      /// \param[in] _timerId Id of the timer.
+      /// \param[in] _prefix Informational string of the lap.
+      /// \return Id to pass to Lap, or -1 if too many labels are
+      /// registered.
+      public: int LapId(const int _timerId, const std::string &_prefix);
+
+      /// \brief Start a timer by id.
+      /// \param[in] _timerId Id returned by TimerId.
+      public: void StartTimer(const int _timerId);
+
+      /// \brief Stop a timer by id.
+      /// \param[in] _timerId Id returned by TimerId.
+      public: void StopTimer(const int _timerId);
+
+      /// \brief Output a lap time of a timer by id.
+      /// \param[in] _timerId Id returned by TimerId.
+      /// \param[in] _lapId Id returned by LapId.
+      public: void Lap(const int _timerId, const int _lapId);
+
       /// \brief Get the number of timers
       /// \return The number of timers
       public: int TimerCount() const;
@@ -134,14 +185,16 @@ namespace gazebo
       /// \param[in] _info World update information.
       private: void Update(const common::UpdateInfo &_info);
 
-      /// \brief Add a time for publication.
-      /// \param[in] _name Name of the diagnostic time.
+      /// \brief Record a measurement in the calling thread's ring.
+      /// \param[in] _label Id of the timer or lap label.
       /// \param[in] _wallTime Wall clock time stamp.
       /// \param[in] _elapsedTime Elapsed time, this is the time
       /// measurement.
-      private: void AddTime(const std::string &_name,
+      /// \param[in] _stat Value added to the label's statistics.
+      private: void AddTime(const int _label,
                    const common::Time &_wallTime,
-                   const common::Time &_elapsedtime);
+                   const common::Time &_elapsedTime,
+                   const common::Time &_stat);
 
       // Singleton implementation
       private: friend class SingletonT<DiagnosticManager>;
@@ -169,6 +222,10 @@ namespace gazebo
       /// \param[in] _prefix Annotation to output with the elapsed time.
       public: void Lap(const std::string &_prefix);
 
+      /// \brief Output a lap time.
+      /// \param[in] _lapId Label id returned by DiagnosticManager::LapId.
+      public: void Lap(const int _lapId);
+
       // Documentation inherited
       public: virtual void Start();
 
@@ -17,8 +17,18 @@
 #ifndef _GAZEBO_UTILS_DIAGNOSTICMANAGER_PRIVATE_HH_
 #define _GAZEBO_UTILS_DIAGNOSTICMANAGER_PRIVATE_HH_
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/unordered_map.hpp>
 #include <ignition/math/SignalStats.hh>
@@ -27,18 +37,181 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/Event.hh"
+#include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/util/UtilTypes.hh"
 
 namespace gazebo
 {
   namespace util
   {
+    /// \brief A measurement recorded by a timer.
+    struct DiagnosticSample
+    {
+      /// \brief Id of the timer or lap label.
+      int label;
+
+      /// \brief Wall clock time at which the measurement ended.
+      common::Time wall;
+
+      /// \brief Duration of the measurement, which is published and
+      /// written to the trace.
+      common::Time elapsed;
+
+      /// \brief Value added to the statistics of the label.
+      common::Time stat;
+    };
+
+    /// \brief Per thread ring of samples. Only the owning thread pushes
+    /// and only the exporter thread pops, so no lock is needed.
+    class DiagnosticSampleRing
+    {
+      /// \brief Number of samples the ring holds.
+      public: static const uint64_t kCapacity = 4096;
+
+      /// \brief Append a sample.
+      /// \param[in] _sample The sample.
+      /// \return False if the ring is full and the sample was dropped.
+      public: bool Push(const DiagnosticSample &_sample)
+              {
+                uint64_t h = this->head.load(std::memory_order_relaxed);
+                if (h - this->tail.load(std::memory_order_acquire) >=
+                    kCapacity)
+                {
+                  return false;
+                }
+                this->samples[h % kCapacity] = _sample;
+                this->head.store(h + 1, std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Remove the oldest sample.
+      /// \param[out] _sample The sample.
+      /// \return False if the ring is empty.
+      public: bool Pop(DiagnosticSample &_sample)
+              {
+                uint64_t t = this->tail.load(std::memory_order_relaxed);
+                if (t == this->head.load(std::memory_order_acquire))
+                  return false;
+                _sample = this->samples[t % kCapacity];
+                this->tail.store(t + 1, std::memory_order_release);
+                return true;
+              }
+
+      /// \brief Thread id written to the trace.
+      public: int threadId = 0;
+
+      /// \brief Number of samples dropped because the ring was full.
+      public: std::atomic<uint64_t> dropped{0};
+
+      /// \brief Samples.
+      private: std::array<DiagnosticSample, kCapacity> samples;
+
+      /// \brief Number of samples pushed.
+      private: std::atomic<uint64_t> head{0};
+
+      /// \brief Number of samples popped.
+      private: std::atomic<uint64_t> tail{0};
+    };
+
+    /// \brief A registered timer or lap name.
+    struct DiagnosticLabel
+    {
+      /// \brief Full name, "timer" or "timer:prefix".
+      std::string name;
+
+      /// \brief Name of the statistics entry in the timer's log.
+      std::string statName;
+
+      /// \brief Id of the timer the label belongs to.
+      int timer;
+    };
+
     /// \brief Private data for the DiagnosticManager class
     class DiagnosticManagerPrivate
     {
+      /// \brief Maximum number of registered labels.
+      public: static const int kMaxLabels = 1024;
+
+      /// \brief Get the sample ring of the calling thread, creating it
+      /// on first use.
+      /// \return The ring.
+      public: DiagnosticSampleRing *ThreadRing();
+
+      /// \brief Register a label. The mutex must be locked.
+      /// \param[in] _name Full name of the label.
+      /// \param[in] _statName Name of the statistics entry.
+      /// \param[in] _timer Id of the owning timer, -1 for a timer label.
+      /// \return Id of the label, or -1 if there are too many labels.
+      public: int RegisterLabel(const std::string &_name,
+                                const std::string &_statName,
+                                const int _timer);
+
+      /// \brief Get the name of a label.
+      /// \param[in] _id Id of the label.
+      /// \return Name of the label, empty if the id is invalid.
+      public: std::string LabelName(const int _id) const;
+
+      /// \brief Drain all sample rings, publish the samples and append
+      /// them to the trace.
+      public: void Export();
+
+      /// \brief Register the introspection items of the locks created
+      /// since the last call, and add the values of all the locks to the
+      /// message.
+      /// \param[in] _fill True to fill the message.
+      public: void ExportLocks(const bool _fill);
+
+      /// \brief Exporter thread loop.
+      public: void ExportLoop();
+
       /// \brief dictionary of timers index by name
       public: TimerMap timers;
 
+      /// \brief Timers indexed by label id, so that the timer macros
+      /// don't need a map lookup.
+      public: std::array<std::atomic<DiagnosticTimer *>, kMaxLabels>
+              timerSlots;
+
+      /// \brief Registered labels indexed by id. Labels are never
+      /// removed, so the ids cached by the timer macros stay valid.
+      public: std::vector<DiagnosticLabel> labels;
+
+      /// \brief Label ids indexed by name.
+      public: std::unordered_map<std::string, int> labelIds;
+
+      /// \brief Protects timers, labels and labelIds.
+      public: mutable std::mutex mutex;
+
+      /// \brief Sample rings of all threads that recorded a sample.
+      public: std::vector<std::shared_ptr<DiagnosticSampleRing>> rings;
+
+      /// \brief Protects rings.
+      public: std::mutex ringsMutex;
+
+      /// \brief Thread that periodically calls Export.
+      public: std::thread exportThread;
+
+      /// \brief Set to stop the exporter thread.
+      public: bool stop = false;
+
+      /// \brief Protects stop.
+      public: std::mutex exportMutex;
+
+      /// \brief Wakes up the exporter thread when stopping.
+      public: std::condition_variable exportCondition;
+
+      /// \brief Latest world update information.
+      public: common::UpdateInfo info;
+
+      /// \brief Protects info.
+      public: std::mutex infoMutex;
+
+      /// \brief Chrome trace event file.
+      public: std::ofstream trace;
+
+      /// \brief True if an event was written to the trace.
+      public: bool traceEvents = false;
+
       /// \brief Path in which to store timing logs.
       public: boost::filesystem::path logPath;
 
@@ -51,6 +224,12 @@ namespace gazebo
       /// \brief The message to output
       public: msgs::Diagnostics msg;
 
+      /// \brief Names of the locks with introspection items.
+      public: std::set<std::string> lockNames;
+
+      /// \brief Introspection items of the locks.
+      public: std::vector<std::string> lockItems;
+
       /// \brief Pointer to the update event connection
       public: event::ConnectionPtr updateConnection;
     };
@@ -61,6 +240,9 @@ namespace gazebo
       /// \brief Name of the timer.
       public: std::string name;
 
+      /// \brief Label id of the timer.
+      public: int id = -1;
+
       /// \brief Log file.
       public: std::ofstream log;
 
@@ -17,8 +17,16 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/Diagnostics.hh"
+#include "gazebo/util/DiagnosticsPrivate.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -43,6 +51,133 @@ TEST_F(DiagnosticsTest, Diagnostics)
   EXPECT_TRUE(mgr->Time(0) <= after - prev);
 }
 
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, TimerIds)
+{
+  util::DiagnosticManager *mgr = util::DiagnosticManager::Instance();
+  ASSERT_TRUE(mgr != NULL);
+
+  int timerId = mgr->TimerId("ids");
+  EXPECT_GE(timerId, 0);
+  EXPECT_EQ(timerId, mgr->TimerId("ids"));
+
+  int lapId = mgr->LapId(timerId, "lap");
+  EXPECT_GE(lapId, 0);
+  EXPECT_NE(timerId, lapId);
+  EXPECT_EQ(lapId, mgr->LapId(timerId, "lap"));
+  EXPECT_NE(lapId, mgr->LapId(timerId, "other"));
+  EXPECT_EQ(-1, mgr->LapId(-1, "lap"));
+
+  int count = mgr->TimerCount();
+  mgr->StartTimer(timerId);
+  mgr->Lap(timerId, lapId);
+  mgr->StopTimer(timerId);
+  EXPECT_EQ(count + 1, mgr->TimerCount());
+
+  // The string interface uses the same timer
+  mgr->StartTimer("ids");
+  mgr->Lap("ids", "lap");
+  mgr->StopTimer("ids");
+  EXPECT_EQ(count + 1, mgr->TimerCount());
+
+  mgr->Fini();
+  EXPECT_EQ(0, mgr->TimerCount());
+  EXPECT_EQ(timerId, mgr->TimerId("ids"));
+}
+
+
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, SampleRing)
+{
+  std::unique_ptr<util::DiagnosticSampleRing> ring(
+      new util::DiagnosticSampleRing);
+
+  util::DiagnosticSample sample;
+  EXPECT_FALSE(ring->Pop(sample));
+
+  // The ring holds up to its capacity, and drops the rest
+  for (uint64_t i = 0; i < util::DiagnosticSampleRing::kCapacity; ++i)
+  {
+    sample.label = static_cast<int>(i);
+    EXPECT_TRUE(ring->Push(sample));
+  }
+  EXPECT_FALSE(ring->Push(sample));
+
+  // Samples come out in order
+  for (uint64_t i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(ring->Pop(sample));
+    EXPECT_EQ(static_cast<int>(i), sample.label);
+  }
+
+  // Popping makes room again
+  sample.label = -1;
+  EXPECT_TRUE(ring->Push(sample));
+  for (uint64_t i = 10; i < util::DiagnosticSampleRing::kCapacity; ++i)
+  {
+    EXPECT_TRUE(ring->Pop(sample));
+    EXPECT_EQ(static_cast<int>(i), sample.label);
+  }
+  EXPECT_TRUE(ring->Pop(sample));
+  EXPECT_EQ(-1, sample.label);
+  EXPECT_FALSE(ring->Pop(sample));
+}
+
+/////////////////////////////////////////////////
+TEST_F(DiagnosticsTest, Trace)
+{
+  util::DiagnosticManager *mgr = util::DiagnosticManager::Instance();
+  ASSERT_TRUE(mgr != NULL);
+
+  // The timers of two threads are written to the trace when the manager
+  // stops
+  auto record = [mgr](const std::string &_name)
+  {
+    for (int i = 0; i < 5; ++i)
+    {
+      mgr->StartTimer(_name);
+      mgr->Lap(_name, "lap");
+      mgr->StopTimer(_name);
+    }
+  };
+  std::thread other(record, "trace_other");
+  record("trace_main");
+  other.join();
+  mgr->Fini();
+
+  std::ifstream file((mgr->LogPath() / "trace.json").string().c_str());
+  ASSERT_TRUE(file.good());
+  std::stringstream stream;
+  stream << file.rdbuf();
+  const std::string trace = stream.str();
+
+  EXPECT_EQ(0u, trace.find("["));
+  EXPECT_NE(std::string::npos, trace.rfind("]"));
+
+  // Count the events of each label, and collect the thread of each timer
+  std::map<std::string, int> events;
+  std::map<std::string, std::string> threadIds;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    if (line.find("{\"name\":\"") != 0)
+      continue;
+
+    const std::string name = line.substr(9, line.find('"', 9) - 9);
+    ++events[name];
+
+    const size_t tid = line.find("\"tid\":");
+    ASSERT_NE(std::string::npos, tid);
+    threadIds[name.substr(0, name.find(':'))] =
+        line.substr(tid, line.find(',', tid) - tid);
+  }
+  EXPECT_EQ(5, events["trace_main"]);
+  EXPECT_EQ(5, events["trace_main:lap"]);
+  EXPECT_EQ(5, events["trace_other"]);
+  EXPECT_EQ(5, events["trace_other:lap"]);
+  EXPECT_NE(threadIds["trace_main"], threadIds["trace_other"]);
+}
+
 
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
@@ -181,6 +181,30 @@ TEST_F(IntrospectionClientTest, NewAndRemoveFilter)
   EXPECT_FALSE(this->callbackExecuted);
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionClientTest, OnlyChangedItems)
+{
+  std::string filterId;
+  std::string topic;
+
+  std::set<std::string> items = {"item1", "item2"};
+  EXPECT_TRUE(this->client.NewFilter(this->managerId, items, filterId, topic));
+  this->Subscribe(topic);
+
+  // The first update contains all the items.
+  this->manager->Update();
+  this->WaitForCallback();
+  EXPECT_TRUE(this->callbackExecuted);
+  this->callbackExecuted = false;
+
+  // The items didn't change, so nothing is published.
+  this->manager->Update();
+  this->WaitForCallback();
+  EXPECT_FALSE(this->callbackExecuted);
+
+  EXPECT_TRUE(this->client.RemoveFilter(this->managerId, filterId));
+}
+
 /////////////////////////////////////////////////
 TEST_F(IntrospectionClientTest, RemoveAllFilters)
 {
@@ -14,6 +14,8 @@
  * limitations under the License.
  *
  */
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <set>
 #include <string>
@@ -32,6 +34,37 @@
 using namespace gazebo;
 using namespace util;
 
+//////////////////////////////////////////////////
+/// \brief Compare two values of introspection items.
+/// \param[in] _a First value.
+/// \param[in] _b Second value.
+/// \return True if the values are equal.
+static bool AnyEqual(const gazebo::msgs::Any &_a,
+    const gazebo::msgs::Any &_b)
+{
+  if (_a.type() != _b.type())
+    return false;
+
+  switch (_a.type())
+  {
+    case gazebo::msgs::Any::NONE:
+      return true;
+    case gazebo::msgs::Any::DOUBLE:
+      return _a.double_value() == _b.double_value();
+    case gazebo::msgs::Any::INT32:
+      return _a.int_value() == _b.int_value();
+    case gazebo::msgs::Any::BOOLEAN:
+      return _a.bool_value() == _b.bool_value();
+    case gazebo::msgs::Any::STRING:
+      return _a.string_value() == _b.string_value();
+    case gazebo::msgs::Any::TIME:
+      return _a.time_value().sec() == _b.time_value().sec() &&
+             _a.time_value().nsec() == _b.time_value().nsec();
+    default:
+      return _a.SerializeAsString() == _b.SerializeAsString();
+  }
+}
+
 //////////////////////////////////////////////////
 IntrospectionManager::IntrospectionManager()
   : dataPtr(new IntrospectionManagerPrivate)
@@ -114,6 +147,7 @@ bool IntrospectionManager::Register(const std::string &_item,
   this->dataPtr->allItems[_item] = _cb;
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->slotsDirty = true;
 
   return true;
 }
@@ -135,6 +169,7 @@ bool IntrospectionManager::Unregister(const std::string &_item)
   this->dataPtr->allItems.erase(_item);
 
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->slotsDirty = true;
 
   return true;
 }
@@ -146,6 +181,7 @@ void IntrospectionManager::Clear()
   this->dataPtr->allItemsKeys.clear();
   this->dataPtr->allItems.clear();
   this->dataPtr->itemsUpdated = true;
+  this->dataPtr->slotsDirty = true;
 }
 
 //////////////////////////////////////////////////
@@ -161,91 +197,93 @@ std::set<std::string> IntrospectionManager::Items() const
   return items;
 }
 
+//////////////////////////////////////////////////
+void IntrospectionManager::SetPublishRate(const double _rate)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->publishRate = std::max(0.0, _rate);
+}
+
+//////////////////////////////////////////////////
+double IntrospectionManager::PublishRate() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->publishRate;
+}
+
 //////////////////////////////////////////////////
 void IntrospectionManager::Update()
 {
-  std::map<std::string, IntrospectionFilter> filtersCopy;
-  std::map<std::string, ObservedItem> observedItemsCopy;
-  std::map<std::string, std::function <gazebo::msgs::Any ()>> usedItemsCopy;
+  bool rebuilt = false;
+  double rate;
 
   {
     std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-    filtersCopy = this->dataPtr->filters;
-    observedItemsCopy = this->dataPtr->observedItems;
-
-    for (const auto &observedItem: this->dataPtr->observedItems)
+    if (this->dataPtr->slotsDirty)
     {
-      auto &item = observedItem.first;
-      // Sanity check: Make sure that someone registered this item.
-      if (this->dataPtr->allItemsKeys.count(item) == 0)
-      {
-        continue;
-      }
-
-      usedItemsCopy[item] = this->dataPtr->allItems[item];
-    }
-
-    for (auto& filter: filtersCopy)
-    {
-      for (auto const &item : filter.second.items)
-      {
-        // Sanity check: Make sure that someone registered this item.
-        if (this->dataPtr->allItemsKeys.count(item) == 0)
-        {
-          continue;
-        }
-        usedItemsCopy[item] = this->dataPtr->allItems[item];
-      }
+      this->dataPtr->RebuildSlots();
+      this->dataPtr->slotsDirty = false;
+      rebuilt = true;
     }
+    rate = this->dataPtr->publishRate;
   }
 
-  for (auto &observedItem : observedItemsCopy)
+  // Limit the rate of the filter updates, except right after a change, so
+  // that new filters receive their first update immediately.
+  auto now = std::chrono::steady_clock::now();
+  if (!rebuilt && rate > 0 &&
+      now - this->dataPtr->lastPublish <
+      std::chrono::duration<double>(1.0 / rate))
   {
-    auto &item = observedItem.first;
-    auto itemIter = usedItemsCopy.find(item);
-
-    // Sanity check: Make sure that we can update the item.
-    if (itemIter == usedItemsCopy.end())
-      continue;
+    this->NotifyUpdates();
+    return;
+  }
+  this->dataPtr->lastPublish = now;
 
+  // Update the values of the items under observation.
+  gazebo::msgs::Any value;
+  for (auto &slot : this->dataPtr->itemSlots)
+  {
     try
     {
-      // Update the values of the items under observation.
-      gazebo::msgs::Any value = itemIter->second();
-      auto &lastValue = observedItem.second.lastValue;
-      lastValue.CopyFrom(value);
+      value = slot.cb();
     }
     catch(...)
     {
       gzerr << "Exception caught calling user callback" << std::endl;
       continue;
     }
+
+    if (!AnyEqual(value, slot.lastValue))
+    {
+      slot.lastValue.Swap(&value);
+      ++slot.version;
+    }
   }
 
-  // Prepare the next message to be sent in each filter.
-  for (auto &filter : filtersCopy)
+  // Prepare the next message to be sent in each filter. It only contains the
+  // items that changed since the last message of the filter.
+  for (auto &filter : this->dataPtr->filterSlots)
   {
-    // First of all, clear the old message.
-    auto &nextMsg = filter.second.msg;
+    auto &nextMsg = filter.msg;
     nextMsg.Clear();
 
-    // Insert the last value of each item under observation for this filter.
-    for (auto const &item : filter.second.items)
+    for (size_t i = 0; i < filter.items.size(); ++i)
     {
-      // Sanity check: Make sure that someone registered this item.
-      if (usedItemsCopy.find(item) == usedItemsCopy.end())
-        continue;
+      const auto &slot = this->dataPtr->itemSlots[filter.items[i]];
 
       // Sanity check: Make sure that the value was updated.
       // (e.g.: an exception was not raised).
-      auto &lastValue = observedItemsCopy[item].lastValue;
-      if (lastValue.type() == gazebo::msgs::Any::NONE)
+      if (slot.lastValue.type() == gazebo::msgs::Any::NONE ||
+          filter.sentVersions[i] == slot.version)
+      {
         continue;
+      }
 
       auto nextParam = nextMsg.add_param();
-      nextParam->set_name(item);
-      nextParam->mutable_value()->CopyFrom(lastValue);
+      nextParam->set_name(slot.name);
+      nextParam->mutable_value()->CopyFrom(slot.lastValue);
+      filter.sentVersions[i] = slot.version;
     }
 
     // Sanity check: Make sure that we have at least one item updated.
@@ -253,17 +291,10 @@ void IntrospectionManager::Update()
       continue;
 
     // Publish the update for this filter.
-    std::string topicName = this->dataPtr->prefix + "filter/" + filter.first;
-
+    if (!filter.pub || !filter.pub.Publish(nextMsg))
     {
-      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-      if (this->dataPtr->filterPubs.find(topicName) ==
-          this->dataPtr->filterPubs.end() ||
-          !this->dataPtr->filterPubs[topicName].Publish(nextMsg))
-      {
-        gzerr << "Error publishing update for topic [" << topicName << "]"
-          << std::endl;
-      }
+      gzerr << "Error publishing update for topic [" << filter.topic << "]"
+        << std::endl;
     }
   }
 
@@ -336,6 +367,8 @@ bool IntrospectionManager::NewFilterImpl(const std::set<std::string> &_newItems,
   for (auto const &item : _newItems)
     this->dataPtr->observedItems[item].filters.emplace(_filterId);
 
+  this->dataPtr->slotsDirty = true;
+
   return true;
 }
 
@@ -393,6 +426,8 @@ bool IntrospectionManager::UpdateFilterImpl(const std::string &_filterId,
     }
   }
 
+  this->dataPtr->slotsDirty = true;
+
   return true;
 }
 
@@ -441,6 +476,8 @@ bool IntrospectionManager::RemoveFilterImpl(const std::string &_filterId)
       this->dataPtr->observedItems.erase(oldItem);
   }
 
+  this->dataPtr->slotsDirty = true;
+
   return true;
 }
 
@@ -642,3 +679,50 @@ bool IntrospectionManager::ValidateParameter(const gazebo::msgs::Param &_msg,
 
   return true;
 }
+
+//////////////////////////////////////////////////
+void IntrospectionManagerPrivate::RebuildSlots()
+{
+  this->itemSlots.clear();
+  this->filterSlots.clear();
+
+  // One slot per registered item under observation.
+  std::map<std::string, size_t> slotIndices;
+  for (auto const &observedItem : this->observedItems)
+  {
+    auto &item = observedItem.first;
+    auto itemIter = this->allItems.find(item);
+
+    // Sanity check: Make sure that someone registered this item.
+    if (itemIter == this->allItems.end())
+      continue;
+
+    slotIndices[item] = this->itemSlots.size();
+    IntrospectionSlot slot;
+    slot.name = item;
+    slot.cb = itemIter->second;
+    this->itemSlots.push_back(slot);
+  }
+
+  // The filters start with no value sent, so their next update contains all
+  // their items.
+  for (auto const &filter : this->filters)
+  {
+    IntrospectionFilterSlot filterSlot;
+    filterSlot.topic = this->prefix + "filter/" + filter.first;
+
+    auto pubIter = this->filterPubs.find(filterSlot.topic);
+    if (pubIter != this->filterPubs.end())
+      filterSlot.pub = pubIter->second;
+
+    for (auto const &item : filter.second.items)
+    {
+      auto slotIter = slotIndices.find(item);
+      if (slotIter != slotIndices.end())
+        filterSlot.items.push_back(slotIter->second);
+    }
+    filterSlot.sentVersions.resize(filterSlot.items.size(), 0);
+
+    this->filterSlots.push_back(filterSlot);
+  }
+}
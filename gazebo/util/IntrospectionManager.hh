@@ -83,10 +83,22 @@ namespace gazebo
       /// \return Set of registered items.
       public: std::set<std::string> Items() const;
 
+      /// \brief Set the maximum rate of the filter updates published by
+      /// Update, measured in wall clock time. Calls to Update in between
+      /// don't evaluate the items.
+      /// \param[in] _rate Rate in Hz, zero to publish on every Update.
+      public: void SetPublishRate(const double _rate);
+
+      /// \brief Get the maximum rate of the filter updates.
+      /// \return Rate in Hz, zero if every Update publishes.
+      public: double PublishRate() const;
+
       /// \brief Update all the items under observation and publish updates
       /// through all the topics. The message received in the update will
-      /// contain the name and latest values of all the items specified
-      /// in the filter.
+      /// contain the name and latest values of the items specified in the
+      /// filter that changed since the previous message of the filter. The
+      /// first message after the filter is created or updated contains all
+      /// its items.
       /// If there are changes in the items list since the last update,
       /// a new message is published under the topic
       /// "/introspection/<manager_id>/items_update".
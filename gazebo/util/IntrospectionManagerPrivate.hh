@@ -17,11 +17,14 @@
 #ifndef GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 #define GAZEBO_UTIL_INTROSPECTION_MANAGER_PRIVATE_HH_
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include <ignition/transport.hh>
 #include "gazebo/msgs/any.pb.h"
 #include "gazebo/msgs/param_v.pb.h"
@@ -36,25 +39,58 @@ namespace gazebo
     {
       /// \brief Items observed by this filter.
       std::set<std::string> items;
-
-      /// \brief Message containing the next update. A message is a collection
-      /// of items and values.
-      msgs::Param_V msg;
     };
 
-    /// \brief Todo.
+    /// \brief An item observed by at least one filter.
     struct ObservedItem
     {
-      /// \brief ToDo.
+      /// \brief Filters observing the item.
+      std::set<std::string> filters;
+    };
+
+    /// \brief Persistent state of an observed item, used by Update.
+    struct IntrospectionSlot
+    {
+      /// \brief Name of the item.
+      std::string name;
+
+      /// \brief Callback that returns the value of the item.
+      std::function<gazebo::msgs::Any()> cb;
+
+      /// \brief Last value of the item.
       gazebo::msgs::Any lastValue;
 
-      /// \brief ToDo.
-      std::set<std::string> filters;
+      /// \brief Incremented every time the value changes.
+      uint64_t version = 0;
+    };
+
+    /// \brief Persistent state of a filter, used by Update.
+    struct IntrospectionFilterSlot
+    {
+      /// \brief Topic of the filter.
+      std::string topic;
+
+      /// \brief Publisher of the filter updates.
+      ignition::transport::Node::Publisher pub;
+
+      /// \brief Indices of the filter's items in the item slots.
+      std::vector<size_t> items;
+
+      /// \brief Version of each item last published.
+      std::vector<uint64_t> sentVersions;
+
+      /// \brief Message containing the next update. A message is a collection
+      /// of items and values.
+      msgs::Param_V msg;
     };
 
     /// \brief Private data for the IntrospectionManager class.
     class IntrospectionManagerPrivate
     {
+      /// \brief Rebuild the item and filter slots from the registered items
+      /// and the filters. The mutex must be locked.
+      public: void RebuildSlots();
+
       /// \brief List of active filters.
       /// The key is the topic where the filter publishes updates.
       /// The value is the associated introspection filter.
@@ -75,8 +111,7 @@ namespace gazebo
 
       /// \brief List of items that have at least one active observer.
       /// The key contains the item name.
-      /// The value contains the last value stored for this item, as well as a
-      /// list of all the filters that contain the item.
+      /// The value contains the list of all the filters that contain the item.
       public: std::map<std::string, ObservedItem> observedItems;
 
       /// \brief Mutex to make this class thread-safe.
@@ -102,6 +137,22 @@ namespace gazebo
 
       /// \brief Items update publisher for ignition transport.
       public: ignition::transport::Node::Publisher itemsUpdatePub;
+
+      /// \brief Item slots, only accessed by Update.
+      public: std::vector<IntrospectionSlot> itemSlots;
+
+      /// \brief Filter slots, only accessed by Update.
+      public: std::vector<IntrospectionFilterSlot> filterSlots;
+
+      /// \brief True when the items or filters changed since the slots were
+      /// built.
+      public: bool slotsDirty = true;
+
+      /// \brief Maximum rate of filter updates in Hz, zero for no limit.
+      public: double publishRate = 0;
+
+      /// \brief Wall clock time of the last filter update.
+      public: std::chrono::steady_clock::time_point lastPublish;
     };
   }
 }
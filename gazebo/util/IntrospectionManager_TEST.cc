@@ -240,6 +240,19 @@ TEST_F(IntrospectionManagerTest, UpdateItems)
   EXPECT_EQ(items.param_size(), 0);
 }
 
+/////////////////////////////////////////////////
+TEST_F(IntrospectionManagerTest, PublishRate)
+{
+  EXPECT_DOUBLE_EQ(0.0, this->manager->PublishRate());
+
+  this->manager->SetPublishRate(30.0);
+  EXPECT_DOUBLE_EQ(30.0, this->manager->PublishRate());
+
+  // Negative rates disable the limit.
+  this->manager->SetPublishRate(-1.0);
+  EXPECT_DOUBLE_EQ(0.0, this->manager->PublishRate());
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,856 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "gazebo/msgs/log_frames.pb.h"
+#include "gazebo/util/LogFrames.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Most decimals of the fixed point values. The world writes its
+/// states with up to 4, and scales with up to 6.
+static const unsigned int kMaxDecimals = 6;
+
+/// \brief Powers of ten up to kMaxDecimals.
+static const int64_t kPow10[kMaxDecimals + 1] =
+  {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+/// \brief Largest magnitude of a fixed point value, which leaves room for
+/// the difference of two values.
+static const int64_t kMaxFixed = 1000000000000000000LL;
+
+/// \brief Number of values of a pose or a velocity.
+static const int kPoseSize = 6;
+
+/// \brief Number of values of a scale.
+static const int kScaleSize = 3;
+
+/// \brief Bit of the flags of an entity that has a velocity.
+static const uint32_t kVelocityFlag = 1;
+
+/// \brief Bit of the flags of an entity that has a scale.
+static const uint32_t kScaleFlag = 2;
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief A number of a frame, which is digits * 10^-decimals.
+    class LogFrameNumber
+    {
+      /// \brief Digits of the number.
+      public: int64_t digits = 0;
+
+      /// \brief Number of decimals, at most kMaxDecimals.
+      public: unsigned int decimals = 0;
+    };
+
+    /// \internal
+    /// \brief A model, link or light of a frame.
+    class LogFrameEntity
+    {
+      /// \brief Type of the entity.
+      public: msgs::LogFrames::Entity::Type type =
+              msgs::LogFrames::Entity::MODEL;
+
+      /// \brief Name of the entity, as written in the frame.
+      public: std::string name;
+
+      /// \brief Index of the parent model in LogFrameState::entities, -1
+      /// for the entities of the world.
+      public: int parent = -1;
+
+      /// \brief kVelocityFlag and kScaleFlag bits.
+      public: uint32_t flags = 0;
+
+      /// \brief The pose, followed by the velocity or the scale.
+      public: std::vector<LogFrameNumber> values;
+    };
+
+    /// \internal
+    /// \brief A state frame read from its SDF.
+    class LogFrameState
+    {
+      /// \brief Version attribute of the sdf element.
+      public: std::string version;
+
+      /// \brief World name attribute of the state element.
+      public: std::string world;
+
+      /// \brief Simulation, wall and real times, as seconds and
+      /// nanoseconds each.
+      public: int32_t times[6] = {0, 0, 0, 0, 0, 0};
+
+      /// \brief True if the frame has an iterations element, which older
+      /// logs don't have.
+      public: bool hasIterations = false;
+
+      /// \brief Iterations of the frame.
+      public: uint64_t iterations = 0;
+
+      /// \brief The entities, in document order.
+      public: std::vector<LogFrameEntity> entities;
+    };
+
+    /// \internal
+    /// \brief Reads a state frame written by the physics::WorldState
+    /// stream operator. Anything else, such as insertions, deletions or a
+    /// number that isn't a short decimal, fails to read.
+    class LogFrameReader
+    {
+      /// \brief Constructor
+      /// \param[in] _text Text holding the frame.
+      /// \param[in] _pos Start of the frame in _text.
+      /// \param[in] _end End of the frame in _text.
+      public: LogFrameReader(const std::string &_text, const std::size_t _pos,
+                  const std::size_t _end)
+              : text(_text), pos(_pos), end(_end)
+      {
+      }
+
+      /// \brief Read the frame.
+      /// \param[out] _state The frame.
+      /// \return True if the whole frame was read.
+      public: bool Read(LogFrameState &_state)
+      {
+        if (!this->Tag("<sdf version='") || !this->Attribute(_state.version) ||
+            !this->Tag("<state world_name='") ||
+            !this->Attribute(_state.world))
+        {
+          return false;
+        }
+
+        if (!this->Tag("<sim_time>") ||
+            !this->Time(_state.times[0], _state.times[1]) ||
+            !this->Tag("</sim_time>") || !this->Tag("<wall_time>") ||
+            !this->Time(_state.times[2], _state.times[3]) ||
+            !this->Tag("</wall_time>") || !this->Tag("<real_time>") ||
+            !this->Time(_state.times[4], _state.times[5]) ||
+            !this->Tag("</real_time>"))
+        {
+          return false;
+        }
+
+        if (this->Tag("<iterations>"))
+        {
+          if (!this->Unsigned(_state.iterations) ||
+              !this->Tag("</iterations>"))
+          {
+            return false;
+          }
+          _state.hasIterations = true;
+        }
+
+        while (true)
+        {
+          if (this->Tag("<model name='"))
+          {
+            if (!this->Model(-1, _state))
+              return false;
+          }
+          else if (this->Tag("<light name='"))
+          {
+            if (!this->Light(_state))
+              return false;
+          }
+          else
+            break;
+        }
+
+        if (!this->Tag("</state>") || !this->Tag("</sdf>"))
+          return false;
+
+        this->SkipSpace();
+        return this->pos == this->end;
+      }
+
+      /// \brief Read a model, after its name attribute starts.
+      /// \param[in] _parent Index of the parent model, -1 for none.
+      /// \param[in,out] _state The frame.
+      /// \return True on success.
+      private: bool Model(const int _parent, LogFrameState &_state)
+      {
+        LogFrameEntity model;
+        model.type = msgs::LogFrames::Entity::MODEL;
+        model.parent = _parent;
+        if (!this->Attribute(model.name) || !this->Tag("<pose>") ||
+            !this->Numbers(kPoseSize, model.values) || !this->Tag("</pose>"))
+        {
+          return false;
+        }
+
+        if (this->Tag("<scale>"))
+        {
+          if (!this->Numbers(kScaleSize, model.values) ||
+              !this->Tag("</scale>"))
+          {
+            return false;
+          }
+          model.flags |= kScaleFlag;
+        }
+
+        const int index = static_cast<int>(_state.entities.size());
+        _state.entities.push_back(std::move(model));
+
+        while (true)
+        {
+          if (this->Tag("<link name='"))
+          {
+            if (!this->Link(index, _state))
+              return false;
+          }
+          else if (this->Tag("<model name='"))
+          {
+            if (!this->Model(index, _state))
+              return false;
+          }
+          else
+            return this->Tag("</model>");
+        }
+      }
+
+      /// \brief Read a link, after its name attribute starts.
+      /// \param[in] _parent Index of the model of the link.
+      /// \param[in,out] _state The frame.
+      /// \return True on success.
+      private: bool Link(const int _parent, LogFrameState &_state)
+      {
+        LogFrameEntity link;
+        link.type = msgs::LogFrames::Entity::LINK;
+        link.parent = _parent;
+        if (!this->Attribute(link.name) || !this->Tag("<pose>") ||
+            !this->Numbers(kPoseSize, link.values) || !this->Tag("</pose>"))
+        {
+          return false;
+        }
+
+        if (this->Tag("<velocity>"))
+        {
+          if (!this->Numbers(kPoseSize, link.values) ||
+              !this->Tag("</velocity>"))
+          {
+            return false;
+          }
+          link.flags |= kVelocityFlag;
+        }
+
+        if (!this->Tag("</link>"))
+          return false;
+
+        _state.entities.push_back(std::move(link));
+        return true;
+      }
+
+      /// \brief Read a light, after its name attribute starts.
+      /// \param[in,out] _state The frame.
+      /// \return True on success.
+      private: bool Light(LogFrameState &_state)
+      {
+        LogFrameEntity light;
+        light.type = msgs::LogFrames::Entity::LIGHT;
+        if (!this->Attribute(light.name) || !this->Tag("<pose>") ||
+            !this->Numbers(kPoseSize, light.values) ||
+            !this->Tag("</pose>") || !this->Tag("</light>"))
+        {
+          return false;
+        }
+
+        _state.entities.push_back(std::move(light));
+        return true;
+      }
+
+      /// \brief Skip the whitespace.
+      private: void SkipSpace()
+      {
+        while (this->pos < this->end && std::isspace(static_cast<unsigned char>(
+                this->text[this->pos])))
+        {
+          ++this->pos;
+        }
+      }
+
+      /// \brief Read a tag, after the whitespace.
+      /// \param[in] _tag The tag. Nothing is read if it doesn't match.
+      /// \return True if the tag was read.
+      private: bool Tag(const char *_tag)
+      {
+        this->SkipSpace();
+        const std::size_t size = std::strlen(_tag);
+        if (this->end - this->pos < size ||
+            this->text.compare(this->pos, size, _tag) != 0)
+        {
+          return false;
+        }
+
+        this->pos += size;
+        return true;
+      }
+
+      /// \brief Read the value of an attribute, up to its closing quote,
+      /// and the end of the element's start tag.
+      /// \param[out] _value The value.
+      /// \return True on success.
+      private: bool Attribute(std::string &_value)
+      {
+        const std::size_t quote = this->text.find('\'', this->pos);
+        if (quote == std::string::npos || quote + 1 >= this->end ||
+            this->text[quote + 1] != '>')
+        {
+          return false;
+        }
+
+        _value = this->text.substr(this->pos, quote - this->pos);
+        this->pos = quote + 2;
+        return true;
+      }
+
+      /// \brief Read the digits of an integer.
+      /// \param[in] _max Largest value.
+      /// \param[out] _value The value.
+      /// \return False if there are no digits, or the value is too large.
+      private: bool Digits(const uint64_t _max, uint64_t &_value)
+      {
+        const std::size_t start = this->pos;
+        _value = 0;
+        while (this->pos < this->end && this->text[this->pos] >= '0' &&
+               this->text[this->pos] <= '9')
+        {
+          const uint64_t digit = this->text[this->pos] - '0';
+          if (_value > (_max - digit) / 10)
+            return false;
+          _value = _value * 10 + digit;
+          ++this->pos;
+        }
+        return this->pos > start;
+      }
+
+      /// \brief Read an unsigned integer.
+      /// \param[out] _value The value.
+      /// \return True on success.
+      private: bool Unsigned(uint64_t &_value)
+      {
+        this->SkipSpace();
+        return this->Digits(UINT64_MAX, _value);
+      }
+
+      /// \brief Read a time, as written by common::Time.
+      /// \param[out] _sec Seconds.
+      /// \param[out] _nsec Nanoseconds.
+      /// \return True on success.
+      private: bool Time(int32_t &_sec, int32_t &_nsec)
+      {
+        int32_t *values[2] = {&_sec, &_nsec};
+        for (auto value : values)
+        {
+          this->SkipSpace();
+          const bool negative = this->pos < this->end &&
+            this->text[this->pos] == '-';
+          if (negative)
+            ++this->pos;
+
+          uint64_t digits;
+          if (!this->Digits(negative ? 2147483648ULL : INT32_MAX, digits))
+            return false;
+          *value = static_cast<int32_t>(negative ?
+              -static_cast<int64_t>(digits) : static_cast<int64_t>(digits));
+        }
+        return true;
+      }
+
+      /// \brief Read numbers.
+      /// \param[in] _count Number of numbers.
+      /// \param[in,out] _numbers The numbers are appended to it.
+      /// \return True on success.
+      private: bool Numbers(const int _count,
+                   std::vector<LogFrameNumber> &_numbers)
+      {
+        for (int i = 0; i < _count; ++i)
+        {
+          LogFrameNumber number;
+          if (!this->Number(number))
+            return false;
+          _numbers.push_back(number);
+        }
+        return true;
+      }
+
+      /// \brief Read a decimal number, without rounding it.
+      /// \param[out] _number The number.
+      /// \return False if it isn't a number, or it doesn't fit with
+      /// kMaxDecimals decimals.
+      private: bool Number(LogFrameNumber &_number)
+      {
+        this->SkipSpace();
+        bool negative = false;
+        if (this->pos < this->end &&
+            (this->text[this->pos] == '-' || this->text[this->pos] == '+'))
+        {
+          negative = this->text[this->pos] == '-';
+          ++this->pos;
+        }
+
+        // Integer and fractional digits, with leading zeros skipped.
+        int64_t digits = 0;
+        int64_t decimals = 0;
+        bool point = false;
+        bool any = false;
+        while (this->pos < this->end)
+        {
+          const char c = this->text[this->pos];
+          if (c >= '0' && c <= '9')
+          {
+            if (digits > kMaxFixed / 10)
+              return false;
+            digits = digits * 10 + (c - '0');
+            decimals += point ? 1 : 0;
+            any = true;
+          }
+          else if (c == '.' && !point)
+            point = true;
+          else
+            break;
+          ++this->pos;
+        }
+        if (!any)
+          return false;
+
+        if (this->pos < this->end &&
+            (this->text[this->pos] == 'e' || this->text[this->pos] == 'E'))
+        {
+          ++this->pos;
+          bool negativeExponent = false;
+          if (this->pos < this->end &&
+              (this->text[this->pos] == '-' || this->text[this->pos] == '+'))
+          {
+            negativeExponent = this->text[this->pos] == '-';
+            ++this->pos;
+          }
+
+          uint64_t exponent;
+          if (!this->Digits(1000, exponent))
+            return false;
+          decimals += negativeExponent ? static_cast<int64_t>(exponent) :
+            -static_cast<int64_t>(exponent);
+        }
+
+        // The number must end here.
+        if (this->pos < this->end && this->text[this->pos] != ' ' &&
+            this->text[this->pos] != '<')
+        {
+          return false;
+        }
+
+        if (digits == 0)
+          decimals = 0;
+        while (decimals > 0 && digits % 10 == 0)
+        {
+          digits /= 10;
+          --decimals;
+        }
+        for (; decimals < 0; ++decimals)
+        {
+          if (digits > kMaxFixed / 10)
+            return false;
+          digits *= 10;
+        }
+
+        if (decimals > kMaxDecimals ||
+            digits > kMaxFixed / kPow10[kMaxDecimals - decimals])
+        {
+          return false;
+        }
+
+        _number.digits = negative ? -digits : digits;
+        _number.decimals = static_cast<unsigned int>(decimals);
+        return true;
+      }
+
+      /// \brief Text holding the frame.
+      private: const std::string &text;
+
+      /// \brief Read position.
+      private: std::size_t pos;
+
+      /// \brief End of the frame.
+      private: const std::size_t end;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a fixed point value in its shortest decimal form.
+/// \param[in] _value The value.
+/// \param[in] _decimals Number of decimals of the value.
+/// \param[in,out] _out The string to append to.
+static void appendFixed(const int64_t _value, const unsigned int _decimals,
+    std::string &_out)
+{
+  // Unsigned, for the magnitude of the smallest int64_t.
+  uint64_t magnitude = static_cast<uint64_t>(_value);
+  if (_value < 0)
+  {
+    _out += '-';
+    magnitude = 0 - magnitude;
+  }
+
+  const uint64_t scale = kPow10[_decimals];
+  _out += std::to_string(magnitude / scale);
+
+  uint64_t fraction = magnitude % scale;
+  if (fraction == 0)
+    return;
+
+  char digits[kMaxDecimals];
+  unsigned int count = _decimals;
+  for (unsigned int i = _decimals; i > 0; --i)
+  {
+    digits[i - 1] = static_cast<char>('0' + fraction % 10);
+    fraction /= 10;
+  }
+  while (digits[count - 1] == '0')
+    --count;
+
+  _out += '.';
+  _out.append(digits, count);
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a time, as written by common::Time.
+/// \param[in] _time The time.
+/// \param[in,out] _out The string to append to.
+static void appendTime(const msgs::Time &_time, std::string &_out)
+{
+  _out += std::to_string(_time.sec());
+  _out += ' ';
+  _out += std::to_string(_time.nsec());
+}
+
+/////////////////////////////////////////////////
+bool LogFrames::Encode(const std::string &_sdf, std::string &_data)
+{
+  const std::string kStartFrame = "<sdf ";
+  const std::string kEndFrame = "</sdf>";
+  const char *kSpace = " \t\r\n";
+
+  // Find and read the frames. The number of decimals is the largest among
+  // every frame that has a compact encoding.
+  std::vector<std::pair<std::size_t, std::size_t>> spans;
+  std::vector<LogFrameState> states;
+  std::vector<bool> compact;
+  int first = -1;
+  unsigned int decimals = 0;
+  for (std::size_t pos = _sdf.find_first_not_of(kSpace);
+       pos != std::string::npos; pos = _sdf.find_first_not_of(kSpace, pos))
+  {
+    if (_sdf.compare(pos, kStartFrame.size(), kStartFrame) != 0)
+      return false;
+
+    std::size_t to = _sdf.find(kEndFrame, pos);
+    if (to == std::string::npos)
+      return false;
+    to += kEndFrame.size();
+
+    LogFrameState state;
+    LogFrameReader reader(_sdf, pos, to);
+    bool ok = reader.Read(state);
+
+    // The frames share the attributes of the first compact one.
+    if (ok && first >= 0)
+    {
+      ok = state.version == states[first].version &&
+        state.world == states[first].world;
+    }
+
+    if (ok)
+    {
+      for (auto const &entity : state.entities)
+      {
+        for (auto const &number : entity.values)
+          decimals = std::max(decimals, number.decimals);
+      }
+    }
+
+    if (ok && first < 0)
+      first = static_cast<int>(states.size());
+
+    spans.push_back(std::make_pair(pos, to));
+    states.push_back(std::move(state));
+    compact.push_back(ok);
+    pos = to;
+  }
+
+  msgs::LogFrames msg;
+  msg.set_decimals(decimals);
+
+  // Entities of the chunk by parent, type and name, and their last values.
+  std::map<std::tuple<uint32_t, int, std::string>, uint32_t> indices;
+  std::vector<std::vector<int64_t>> lastValues;
+
+  for (std::size_t i = 0; i < states.size(); ++i)
+  {
+    msgs::LogFrames::Frame *frame = msg.add_frame();
+    if (!compact[i])
+    {
+      frame->set_sdf(_sdf.substr(spans[i].first,
+            spans[i].second - spans[i].first));
+      continue;
+    }
+
+    const LogFrameState &state = states[i];
+    if (!msg.has_sdf_version())
+    {
+      msg.set_sdf_version(state.version);
+      msg.set_world_name(state.world);
+    }
+
+    msgs::Time *times[3] = {frame->mutable_sim_time(),
+      frame->mutable_wall_time(), frame->mutable_real_time()};
+    for (int t = 0; t < 3; ++t)
+    {
+      times[t]->set_sec(state.times[t * 2]);
+      times[t]->set_nsec(state.times[t * 2 + 1]);
+    }
+    if (state.hasIterations)
+      frame->set_iterations(state.iterations);
+
+    // Index in msg of each entity of the frame.
+    std::vector<uint32_t> frameIndices(state.entities.size());
+    for (std::size_t e = 0; e < state.entities.size(); ++e)
+    {
+      const LogFrameEntity &entity = state.entities[e];
+      const uint32_t parent =
+        entity.parent < 0 ? 0 : frameIndices[entity.parent] + 1;
+
+      auto key = std::make_tuple(parent, static_cast<int>(entity.type),
+          entity.name);
+      auto iter = indices.find(key);
+      if (iter == indices.end())
+      {
+        iter = indices.insert(std::make_pair(key, msg.entity_size())).first;
+        msgs::LogFrames::Entity *entityMsg = msg.add_entity();
+        entityMsg->set_name(entity.name);
+        entityMsg->set_type(entity.type);
+        entityMsg->set_parent(parent);
+        lastValues.push_back(
+            std::vector<int64_t>(kPoseSize * 2 + kScaleSize, 0));
+      }
+      frameIndices[e] = iter->second;
+      frame->add_entity(iter->second);
+      frame->add_flags(entity.flags);
+
+      // Store the differences with the last values of the entity.
+      std::vector<int64_t> &last = lastValues[iter->second];
+      auto number = entity.values.begin();
+      auto addValues = [&](google::protobuf::RepeatedField<int64_t> *_field,
+          const int _offset, const int _count)
+      {
+        for (int v = _offset; v < _offset + _count; ++v, ++number)
+        {
+          const int64_t value = number->digits *
+            kPow10[decimals - number->decimals];
+          _field->Add(value - last[v]);
+          last[v] = value;
+        }
+      };
+
+      addValues(frame->mutable_pose(), 0, kPoseSize);
+      if (entity.flags & kVelocityFlag)
+        addValues(frame->mutable_velocity(), kPoseSize, kPoseSize);
+      if (entity.flags & kScaleFlag)
+        addValues(frame->mutable_scale(), kPoseSize * 2, kScaleSize);
+    }
+  }
+
+  return msg.SerializeToString(&_data);
+}
+
+/////////////////////////////////////////////////
+bool LogFrames::Decode(const std::string &_data, std::string &_sdf)
+{
+  msgs::LogFrames msg;
+  if (!msg.ParseFromString(_data) || msg.decimals() > kMaxDecimals)
+    return false;
+
+  // Parents are models listed before their children. Links have a parent,
+  // lights don't.
+  for (int e = 0; e < msg.entity_size(); ++e)
+  {
+    const msgs::LogFrames::Entity &entity = msg.entity(e);
+    const uint32_t parent = entity.parent();
+    if (parent == 0)
+    {
+      if (entity.type() == msgs::LogFrames::Entity::LINK)
+        return false;
+    }
+    else if (entity.type() == msgs::LogFrames::Entity::LIGHT ||
+        parent > static_cast<uint32_t>(e) ||
+        msg.entity(parent - 1).type() != msgs::LogFrames::Entity::MODEL)
+    {
+      return false;
+    }
+  }
+
+  const unsigned int decimals = msg.decimals();
+  std::vector<std::vector<int64_t>> lastValues(msg.entity_size(),
+      std::vector<int64_t>(kPoseSize * 2 + kScaleSize, 0));
+
+  _sdf.clear();
+  for (auto const &frame : msg.frame())
+  {
+    if (frame.has_sdf())
+    {
+      _sdf += frame.sdf();
+      continue;
+    }
+
+    // Check the sizes before reading the values.
+    int velocities = 0;
+    int scales = 0;
+    for (auto const flags : frame.flags())
+    {
+      velocities += (flags & kVelocityFlag) ? 1 : 0;
+      scales += (flags & kScaleFlag) ? 1 : 0;
+    }
+    if (frame.flags_size() != frame.entity_size() ||
+        frame.pose_size() != frame.entity_size() * kPoseSize ||
+        frame.velocity_size() != velocities * kPoseSize ||
+        frame.scale_size() != scales * kScaleSize)
+    {
+      return false;
+    }
+
+    _sdf += "<sdf version='";
+    _sdf += msg.sdf_version();
+    _sdf += "'><state world_name='";
+    _sdf += msg.world_name();
+    _sdf += "'><sim_time>";
+    appendTime(frame.sim_time(), _sdf);
+    _sdf += "</sim_time><wall_time>";
+    appendTime(frame.wall_time(), _sdf);
+    _sdf += "</wall_time><real_time>";
+    appendTime(frame.real_time(), _sdf);
+    _sdf += "</real_time>";
+    if (frame.has_iterations())
+    {
+      _sdf += "<iterations>";
+      _sdf += std::to_string(frame.iterations());
+      _sdf += "</iterations>";
+    }
+
+    int pose = 0;
+    int velocity = 0;
+    int scale = 0;
+
+    // Add the values to the last values of the entity, unsigned so that
+    // invalid data doesn't overflow.
+    auto appendValues = [&](const google::protobuf::RepeatedField<int64_t>
+        &_field, int &_index, std::vector<int64_t> &_last, const int _offset,
+        const int _count, const bool _trailingSpace)
+    {
+      for (int v = _offset; v < _offset + _count; ++v)
+      {
+        _last[v] = static_cast<int64_t>(static_cast<uint64_t>(_last[v]) +
+            static_cast<uint64_t>(_field.Get(_index++)));
+        if (v > _offset)
+          _sdf += ' ';
+        appendFixed(_last[v], decimals, _sdf);
+      }
+      if (_trailingSpace)
+        _sdf += ' ';
+    };
+
+    // Models that are open, innermost last.
+    std::vector<uint32_t> models;
+    for (int e = 0; e < frame.entity_size(); ++e)
+    {
+      const uint32_t index = frame.entity(e);
+      if (index >= static_cast<uint32_t>(msg.entity_size()))
+        return false;
+
+      const msgs::LogFrames::Entity &entity = msg.entity(index);
+      while (!models.empty() && models.back() + 1 != entity.parent())
+      {
+        _sdf += "</model>";
+        models.pop_back();
+      }
+      if (entity.parent() > 0 && models.empty())
+        return false;
+
+      std::vector<int64_t> &last = lastValues[index];
+      const uint32_t flags = frame.flags(e);
+      switch (entity.type())
+      {
+        case msgs::LogFrames::Entity::MODEL:
+          _sdf += "<model name='";
+          break;
+        case msgs::LogFrames::Entity::LINK:
+          _sdf += "<link name='";
+          break;
+        default:
+          _sdf += "<light name='";
+          break;
+      }
+      _sdf += entity.name();
+      _sdf += "'><pose>";
+      appendValues(frame.pose(), pose, last, 0, kPoseSize, true);
+      _sdf += "</pose>";
+      if (flags & kVelocityFlag)
+      {
+        _sdf += "<velocity>";
+        appendValues(frame.velocity(), velocity, last, kPoseSize, kPoseSize,
+            true);
+        _sdf += "</velocity>";
+      }
+      if (flags & kScaleFlag)
+      {
+        _sdf += "<scale>";
+        appendValues(frame.scale(), scale, last, kPoseSize * 2, kScaleSize,
+            false);
+        _sdf += "</scale>";
+      }
+
+      switch (entity.type())
+      {
+        case msgs::LogFrames::Entity::MODEL:
+          models.push_back(index);
+          break;
+        case msgs::LogFrames::Entity::LINK:
+          _sdf += "</link>";
+          break;
+        default:
+          _sdf += "</light>";
+          break;
+      }
+    }
+
+    for (std::size_t m = 0; m < models.size(); ++m)
+      _sdf += "</model>";
+    _sdf += "</state></sdf>";
+  }
+
+  return true;
+}
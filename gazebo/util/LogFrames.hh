@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_LOGFRAMES_HH_
+#define GAZEBO_UTIL_LOGFRAMES_HH_
+
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \class LogFrames LogFrames.hh util/util.hh
+    /// \brief Binary encoding of the frames of a state log chunk, used by
+    /// the "frames" format of LogRecord.
+    ///
+    /// The frames are the <sdf> elements that the world writes to its
+    /// state log. A chunk is encoded as a msgs::LogFrames message. The
+    /// models, links and lights of the frames are listed once per chunk,
+    /// and the frames refer to them by index. Their poses, velocities and
+    /// scales are fixed point integers, stored as the difference with the
+    /// previous frame. Frames that this doesn't cover, such as the world
+    /// description or frames that insert or delete models, are kept as
+    /// text.
+    ///
+    /// Decoding gives the frames back as SDF, so LogPlay::Step returns the
+    /// same states as for a chunk recorded as text. The numbers keep their
+    /// values, written in their shortest form.
+    class GZ_UTIL_VISIBLE LogFrames
+    {
+      /// \brief Encode the frames of a chunk.
+      /// \param[in] _sdf The frames. Whitespace between frames is dropped.
+      /// \param[out] _data The encoded frames.
+      /// \return False if _sdf isn't a sequence of <sdf> elements.
+      public: static bool Encode(const std::string &_sdf, std::string &_data);
+
+      /// \brief Decode the frames of a chunk.
+      /// \param[in] _data Frames encoded with Encode.
+      /// \param[out] _sdf The frames, one after the other.
+      /// \return False if _data isn't a valid encoding.
+      public: static bool Decode(const std::string &_data, std::string &_sdf);
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <string>
+
+#include "gazebo/util/LogFrames.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class LogFrames_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write a state frame the way the world does.
+/// \param[in] _iterations Iterations of the frame.
+/// \param[in] _z Height of the box.
+/// \return The frame.
+static std::string stateFrame(const int _iterations, const std::string &_z)
+{
+  return "<sdf version='1.6'><state world_name='default'>"
+    "<sim_time>" + std::to_string(_iterations / 1000) + " " +
+    std::to_string(_iterations % 1000 * 1000000) + "</sim_time>"
+    "<wall_time>1488833218 801500869</wall_time>"
+    "<real_time>1 658504778</real_time>"
+    "<iterations>" + std::to_string(_iterations) + "</iterations>"
+    "<model name='box'><pose>1.5 2 " + _z + " 0 0 0.7854 </pose>"
+    "<scale>1 1 2.5</scale>"
+    "<link name='link'><pose>1.5 2 " + _z + " 0 0 0.7854 </pose>"
+    "<velocity>0 0 -0.0098 0 0.001 0 </velocity></link>"
+    "<model name='arm'><pose>1.5 2 1 0 0 0 </pose>"
+    "<link name='link'><pose>1.5 2 1 0 0 0 </pose></link></model>"
+    "<link name='lid'><pose>1.5 2 1.2 0 0 0 </pose></link></model>"
+    "<model name='ground_plane'><pose>0 0 0 0 0 0 </pose>"
+    "<link name='link'><pose>0 0 0 0 0 0 </pose>"
+    "<velocity>0 0 0 0 0 0 </velocity></link></model>"
+    "<light name='sun'><pose>0 0 10 0 0 0 </pose></light>"
+    "</state></sdf>";
+}
+
+/////////////////////////////////////////////////
+/// \brief Encode and decode frames.
+/// \param[in] _sdf The frames.
+/// \return The decoded frames, or an empty string on failure.
+static std::string roundTrip(const std::string &_sdf)
+{
+  std::string data;
+  std::string sdf;
+  if (!util::LogFrames::Encode(_sdf, data) ||
+      !util::LogFrames::Decode(data, sdf))
+  {
+    return "";
+  }
+  return sdf;
+}
+
+/////////////////////////////////////////////////
+/// \brief State frames read back as written.
+TEST_F(LogFrames_TEST, States)
+{
+  std::string frames;
+  for (int i = 1; i <= 100; ++i)
+    frames += stateFrame(i, "0.5" + std::to_string(i * 10 + 1));
+
+  EXPECT_EQ(frames, roundTrip(frames));
+
+  // A single frame, and no frames.
+  EXPECT_EQ(stateFrame(1, "0.5"), roundTrip(stateFrame(1, "0.5")));
+  EXPECT_EQ("", roundTrip(""));
+
+  // Frames of older logs have no iterations.
+  const std::string old = "<sdf version='1.5'><state world_name='default'>"
+    "<sim_time>28 457000000</sim_time><wall_time>1 2</wall_time>"
+    "<real_time>28 527654347</real_time></state></sdf>";
+  EXPECT_EQ(old, roundTrip(old));
+
+  // The encoding is smaller than the text.
+  std::string data;
+  EXPECT_TRUE(util::LogFrames::Encode(frames, data));
+  EXPECT_LT(data.size() * 5, frames.size());
+}
+
+/////////////////////////////////////////////////
+/// \brief Numbers keep their values, in their shortest form.
+TEST_F(LogFrames_TEST, Numbers)
+{
+  const std::string frame = "<sdf version='1.5'><state world_name='w'>"
+    "<sim_time>1 0</sim_time><wall_time>2 0</wall_time>"
+    "<real_time>-1 -5</real_time>"
+    "<light name='sun'><pose>%s</pose></light></state></sdf>";
+  auto withPose = [&frame](const std::string &_pose)
+  {
+    std::string sdf = frame;
+    sdf.replace(sdf.find("%s"), 2, _pose);
+    return sdf;
+  };
+
+  EXPECT_EQ(withPose("1 -2.5 0 0 0 0.000001 "),
+      roundTrip(withPose("1.00000 -2.50000 -0.000 0.000 0 1e-6 ")));
+  EXPECT_EQ(withPose("1230 -0.0123 12 0.5 100 -100000 "),
+      roundTrip(withPose("1.23e+03 -1.23e-2 +12 .5 1E2 -1e5 ")));
+
+  // Numbers that don't fit in 6 decimals, or that aren't numbers, are
+  // kept as text.
+  const std::string precise = withPose("0.0000001 0 0 0 0 0 ");
+  EXPECT_EQ(precise, roundTrip(precise));
+  const std::string nan = withPose("nan 0 0 0 0 0 ");
+  EXPECT_EQ(nan, roundTrip(nan));
+  const std::string large = withPose("1e30 0 0 0 0 0 ");
+  EXPECT_EQ(large, roundTrip(large));
+}
+
+/////////////////////////////////////////////////
+/// \brief Frames that have no compact encoding are kept as text.
+TEST_F(LogFrames_TEST, Text)
+{
+  const std::string world = "<sdf version ='1.6'>\n<world name='default'>\n"
+    "  <gravity>0 0 -9.8</gravity>\n</world>\n</sdf>";
+  const std::string insertion = "<sdf version='1.6'>"
+    "<state world_name='default'><sim_time>1 0</sim_time>"
+    "<wall_time>1 0</wall_time><real_time>1 0</real_time>"
+    "<iterations>1000</iterations><insertions><model name='box'>\n"
+    "  <pose frame=''>1 2 0.5 0 -0 0</pose>\n</model>\n</insertions>"
+    "</state></sdf>";
+  const std::string otherWorld = "<sdf version='1.6'>"
+    "<state world_name='other'><sim_time>1 0</sim_time>"
+    "<wall_time>1 0</wall_time><real_time>1 0</real_time></state></sdf>";
+
+  std::string frames = stateFrame(1, "0.5") + insertion + stateFrame(2, "0.4")
+    + otherWorld;
+  EXPECT_EQ(frames, roundTrip(frames));
+  EXPECT_EQ(world + frames, roundTrip(world + frames));
+
+  // Whitespace between frames is dropped.
+  EXPECT_EQ(stateFrame(1, "0.5") + stateFrame(2, "0.4"),
+      roundTrip("\n" + stateFrame(1, "0.5") + "\n\n" + stateFrame(2, "0.4") +
+        "\n"));
+}
+
+/////////////////////////////////////////////////
+/// \brief Invalid frames and data.
+TEST_F(LogFrames_TEST, Invalid)
+{
+  std::string data;
+  EXPECT_FALSE(util::LogFrames::Encode("not a frame", data));
+  EXPECT_FALSE(util::LogFrames::Encode(stateFrame(1, "0.5") + "text", data));
+  EXPECT_FALSE(util::LogFrames::Encode("<sdf version='1.6'>", data));
+
+  std::string sdf;
+  EXPECT_FALSE(util::LogFrames::Decode("not encoded frames", sdf));
+
+  // Truncated data.
+  EXPECT_TRUE(util::LogFrames::Encode(stateFrame(1, "0.5"), data));
+  EXPECT_TRUE(util::LogFrames::Decode(data, sdf));
+  EXPECT_FALSE(util::LogFrames::Decode(data.substr(0, data.size() / 2), sdf));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
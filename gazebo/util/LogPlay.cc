@@ -23,6 +23,7 @@
 #endif
 
 #include <algorithm>
+#include <iterator>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -40,6 +41,7 @@
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Base64.hh"
+#include "gazebo/util/LogFrames.hh"
 #include "gazebo/util/LogRecord.hh"
 
 #include "gazebo/util/LogPlayPrivate.hh"
@@ -53,16 +55,34 @@ LogPlay::LogPlay()
 : dataPtr(new LogPlayPrivate)
 {
   this->dataPtr->logStartXml = NULL;
+
+  const char *depthEnv = getenv("GAZEBO_LOG_PREFETCH");
+  if (depthEnv && *depthEnv)
+  {
+    try
+    {
+      this->dataPtr->prefetchDepth =
+        boost::lexical_cast<unsigned int>(depthEnv);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_LOG_PREFETCH[" << depthEnv << "]\n";
+    }
+  }
 }
 
 /////////////////////////////////////////////////
 LogPlay::~LogPlay()
 {
+  this->dataPtr->StopPrefetch();
 }
 
 /////////////////////////////////////////////////
 void LogPlay::Open(const std::string &_logFile)
 {
+  // The prefetch threads read the document that is about to be replaced.
+  this->dataPtr->StopPrefetch();
+
   this->dataPtr->currentChunk.clear();
 
   boost::filesystem::path path(_logFile);
@@ -150,6 +170,9 @@ void LogPlay::Open(const std::string &_logFile)
   this->dataPtr->logCurrXml = this->dataPtr->logStartXml;
   this->dataPtr->encoding.clear();
 
+  // Collect the chunks and their sim_time index.
+  this->ReadIndex();
+
   // Extract the start/end log times from the log.
   this->ReadLogTimes();
 
@@ -170,6 +193,8 @@ void LogPlay::Open(const std::string &_logFile)
 
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, 1);
 }
 
 /////////////////////////////////////////////////
@@ -255,19 +280,68 @@ void LogPlay::ReadHeader()
   ignition::math::Rand::Seed(this->dataPtr->randSeed);
 }
 
+/////////////////////////////////////////////////
+void LogPlay::ReadIndex()
+{
+  this->dataPtr->chunks.clear();
+  this->dataPtr->chunkTimes.clear();
+  this->dataPtr->chunkIndices.clear();
+  this->dataPtr->indexed = true;
+
+  for (auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+       chunkXml; chunkXml = chunkXml->NextSiblingElement("chunk"))
+  {
+    common::Time simTime;
+    const char *simTimeStr = chunkXml->Attribute("sim_time");
+    if (simTimeStr)
+    {
+      std::stringstream ss(simTimeStr);
+      ss >> simTime;
+    }
+    // The first chunk holds the world description, which has no state.
+    else if (!this->dataPtr->chunks.empty())
+    {
+      this->dataPtr->indexed = false;
+    }
+
+    // Times must not decrease for the binary search in Seek to be valid.
+    if (!this->dataPtr->chunkTimes.empty() &&
+        simTime < this->dataPtr->chunkTimes.back())
+    {
+      this->dataPtr->indexed = false;
+    }
+
+    this->dataPtr->chunkIndices[chunkXml] = this->dataPtr->chunks.size();
+    this->dataPtr->chunks.push_back(chunkXml);
+    this->dataPtr->chunkTimes.push_back(simTime);
+  }
+
+  // A single chunk has no state to index.
+  if (this->dataPtr->chunks.size() < 2)
+    this->dataPtr->indexed = false;
+}
+
 /////////////////////////////////////////////////
 void LogPlay::ReadLogTimes()
 {
   std::string chunk;
   bool found = false;
 
+  // Use the sim_time index if available.
+  if (this->dataPtr->indexed)
+  {
+    this->dataPtr->logStartTime = this->dataPtr->chunkTimes[
+      this->dataPtr->chunks.front()->Attribute("sim_time") ? 0 : 1];
+    found = true;
+  }
+
   auto chunkXml = this->dataPtr->logStartXml->FirstChildElement("chunk");
 
   // Try to read the start time of the log.
   auto numChunksToTry =
     std::min(this->ChunkCount(), this->dataPtr->kNumChunksToTry);
 
-  for (unsigned int i = 0; i < numChunksToTry; ++i)
+  for (unsigned int i = 0; !found && i < numChunksToTry; ++i)
   {
     if (!chunkXml)
     {
@@ -307,6 +381,15 @@ void LogPlay::ReadLogTimes()
     return;
   }
 
+  // Use the index of the last chunk if available.
+  const char *lastTimeStr = lastChunk->Attribute("last_sim_time");
+  if (lastTimeStr)
+  {
+    std::stringstream ss(lastTimeStr);
+    ss >> this->dataPtr->logEndTime;
+    return;
+  }
+
   if (!this->dataPtr->ChunkData(lastChunk, chunk))
     return;
 
@@ -350,6 +433,15 @@ bool LogPlay::ReadIterations()
       return false;
     }
 
+    // Use the iterations index if available.
+    const char *iterationsStr = chunkXml->Attribute("iterations");
+    if (iterationsStr)
+    {
+      std::stringstream ss(iterationsStr);
+      ss >> this->dataPtr->initialIterations;
+      return true;
+    }
+
     std::string chunk;
     if (!this->dataPtr->ChunkData(chunkXml, chunk))
       return false;
@@ -489,6 +581,64 @@ bool LogPlay::Step(const int _step, std::string &_data)
   return res;
 }
 
+/////////////////////////////////////////////////
+bool LogPlay::StepUntil(const common::Time &_time, std::string &_data)
+{
+  if (!this->Step(_data))
+    return false;
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  const std::string &chunk = this->dataPtr->currentChunk;
+
+  // True if a tag is in the current frame.
+  auto inFrame = [&](const std::string &_tag)
+  {
+    auto first = chunk.begin() + this->dataPtr->start;
+    auto last = chunk.begin() + this->dataPtr->end;
+    return std::search(first, last, _tag.begin(), _tag.end()) != last;
+  };
+
+  // Walk over the frames that are due, and stop at the last one. Frames
+  // in later chunks are left to the next step, which decodes the chunk.
+  bool skipped = false;
+  while (!inFrame(this->dataPtr->kInsertions) &&
+         !inFrame(this->dataPtr->kDeletions))
+  {
+    auto from = chunk.find(this->dataPtr->kStartFrame,
+        this->dataPtr->end + this->dataPtr->kEndFrame.size());
+    if (from == std::string::npos)
+      break;
+    auto to = chunk.find(this->dataPtr->kEndFrame, from);
+    auto timeFrom = chunk.find(this->dataPtr->kStartTime, from);
+    auto timeTo = chunk.find(this->dataPtr->kEndTime, timeFrom);
+    if (to == std::string::npos || timeFrom == std::string::npos ||
+        timeTo == std::string::npos || timeTo > to)
+    {
+      break;
+    }
+
+    timeFrom += this->dataPtr->kStartTime.size();
+    common::Time logTime;
+    std::stringstream ss(chunk.substr(timeFrom, timeTo - timeFrom));
+    ss >> logTime;
+    if (logTime > _time)
+      break;
+
+    this->dataPtr->start = from;
+    this->dataPtr->end = to;
+    skipped = true;
+  }
+
+  if (skipped)
+  {
+    _data = chunk.substr(this->dataPtr->start,
+        this->dataPtr->end + this->dataPtr->kEndFrame.size() -
+        this->dataPtr->start);
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 bool LogPlay::StepBack(std::string &_data)
 {
@@ -567,6 +717,8 @@ bool LogPlay::Rewind()
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, 1);
+
   return true;
 }
 
@@ -594,6 +746,8 @@ bool LogPlay::Forward()
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
   this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
 
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, -1);
+
   return true;
 }
 
@@ -610,6 +764,28 @@ bool LogPlay::Seek(const common::Time &_time)
 
   common::Time logTime = this->dataPtr->logStartTime;
 
+  // Indexed log: The frame is in the last chunk that starts before the
+  // target time, which is found without decoding any chunk. Only that
+  // chunk is decoded.
+  if (this->dataPtr->indexed)
+  {
+    auto it = std::lower_bound(this->dataPtr->chunkTimes.begin(),
+        this->dataPtr->chunkTimes.end(), _time);
+
+    // The first chunk may hold only the world description.
+    const unsigned int first =
+      this->dataPtr->chunks.front()->Attribute("sim_time") ? 0u : 1u;
+    unsigned int index = it - this->dataPtr->chunkTimes.begin();
+    index = index > first ? index - 1 : first;
+
+    if (!this->Chunk(index, this->dataPtr->currentChunk))
+      return false;
+
+    this->SeekInChunk(_time);
+    this->dataPtr->Prefetch(this->dataPtr->logCurrXml, 1);
+    return true;
+  }
+
   // 1st step: Locate the chunk: We're looking for the first chunk that has
   // a time greater than the target time.
   int64_t imin = 0;
@@ -659,6 +835,53 @@ bool LogPlay::Seek(const common::Time &_time)
       this->Forward();
   }
 
+  return this->SeekBack(_time);
+}
+
+/////////////////////////////////////////////////
+void LogPlay::SeekInChunk(const common::Time &_time)
+{
+  const std::string &chunk = this->dataPtr->currentChunk;
+
+  // Start before the first frame.
+  this->dataPtr->start = 0;
+  this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
+
+  // Walk the frames of the chunk until one isn't before the target time.
+  // Frames without a <sim_time>, such as the world description, are
+  // walked over.
+  auto from = chunk.find(this->dataPtr->kStartFrame);
+  while (from != std::string::npos)
+  {
+    auto to = chunk.find(this->dataPtr->kEndFrame, from);
+    if (to == std::string::npos)
+      break;
+
+    auto timeFrom = chunk.find(this->dataPtr->kStartTime, from);
+    auto timeTo = chunk.find(this->dataPtr->kEndTime, timeFrom);
+    if (timeFrom != std::string::npos && timeTo != std::string::npos &&
+        timeTo < to)
+    {
+      timeFrom += this->dataPtr->kStartTime.size();
+      common::Time logTime;
+      std::stringstream ss(chunk.substr(timeFrom, timeTo - timeFrom));
+      ss >> logTime;
+
+      if (logTime >= _time)
+        break;
+    }
+
+    this->dataPtr->start = from;
+    this->dataPtr->end = to;
+    from = chunk.find(this->dataPtr->kStartFrame, to);
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::SeekBack(const common::Time &_time)
+{
+  common::Time logTime;
+
   // 2nd step: Locate the frame in the previous chunk.
   while (true)
   {
@@ -684,27 +907,20 @@ bool LogPlay::Seek(const common::Time &_time)
     }
   }
 
+  // Playback resumes forward from the frame found.
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, 1);
+
   return true;
 }
 
 /////////////////////////////////////////////////
 bool LogPlay::Chunk(unsigned int _index, std::string &_data) const
 {
-  unsigned int count = 0;
-  this->dataPtr->logCurrXml =
-    this->dataPtr->logStartXml->FirstChildElement("chunk");
-
-  while (this->dataPtr->logCurrXml && count < _index)
-  {
-    count++;
-    this->dataPtr->logCurrXml =
-      this->dataPtr->logCurrXml->NextSiblingElement("chunk");
-  }
-
-  if (this->dataPtr->logCurrXml && count == _index)
-    return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
-  else
+  if (_index >= this->dataPtr->chunks.size())
     return false;
+
+  this->dataPtr->logCurrXml = this->dataPtr->chunks[_index];
+  return this->dataPtr->ChunkData(this->dataPtr->logCurrXml, _data);
 }
 
 /////////////////////////////////////////////////
@@ -719,6 +935,10 @@ bool LogPlayPrivate::ChunkData(
     return false;
   }
 
+  // Use the chunk if a prefetch thread decoded it.
+  if (this->TakePrefetched(_xml, _data))
+    return true;
+
   /// Get the chunk's encoding
   this->encoding = _xml->Attribute("encoding");
 
@@ -728,15 +948,60 @@ bool LogPlayPrivate::ChunkData(
     gzthrow("Encoding missing for a chunk in log file[" + this->filename + "]");
   }
 
-  if (this->encoding == "txt")
-    _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  // Chunks without a format hold SDF.
+  const char *format = _xml->Attribute("format");
+  if (!DecodeChunk(this->encoding, format ? format : "sdf", _xml->GetText(),
+        _data))
+  {
+    gzerr << "Invalid encoding[" << this->encoding << "] or format["
+      << (format ? format : "sdf") << "] in log file[" << this->filename
+      << "]\n";
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read the decompressed data of a chunk.
+/// \param[in] _in Decompressed data.
+/// \param[in] _format Format of the chunk's frames, sdf or frames.
+/// \param[out] _data Storage for the chunk's data, as SDF.
+/// \return False if the format is unknown, or the frames are invalid.
+static bool readChunk(std::istream &_in, const std::string &_format,
+    std::string &_data)
+{
+  if (_format == "sdf")
+  {
+    std::getline(_in, _data, '\0');
+  }
+  else if (_format == "frames")
+  {
+    // Binary frames may contain null characters.
+    std::string frames((std::istreambuf_iterator<char>(_in)),
+        std::istreambuf_iterator<char>());
+    if (!LogFrames::Decode(frames, _data))
+      return false;
+  }
+  else
+    return false;
+
+  _data += '\0';
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlayPrivate::DecodeChunk(const std::string &_encoding,
+    const std::string &_format, const std::string &_text, std::string &_data)
+{
+  if (_encoding == "txt" && _format == "sdf")
+    _data = _text;
+  else if (_encoding == "bz2")
   {
-    std::string data = _xml->GetText();
     std::string buffer;
 
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    Base64Decode(_text, buffer);
 
     // Decompress the bz2 data
     {
@@ -745,17 +1010,16 @@ bool LogPlayPrivate::ChunkData(
       in.push(boost::make_iterator_range(buffer));
 
       // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
+      if (!readChunk(in, _format, _data))
+        return false;
     }
   }
-  else if (this->encoding == "zlib")
+  else if (_encoding == "zlib")
   {
-    std::string data = _xml->GetText();
     std::string buffer;
 
     // Decode the base64 string
-    buffer = Base64Decode(data);
+    Base64Decode(_text, buffer);
 
     // Decompress the zlib data
     {
@@ -764,39 +1028,203 @@ bool LogPlayPrivate::ChunkData(
       in.push(boost::make_iterator_range(buffer));
 
       // Get the data
-      std::getline(in, _data, '\0');
-      _data += '\0';
+      if (!readChunk(in, _format, _data))
+        return false;
     }
   }
   else
-  {
-    gzerr << "Invalid encoding[" << this->encoding << "] in log file["
-      << this->filename << "]\n";
     return false;
-  }
 
   return true;
 }
 
 /////////////////////////////////////////////////
-std::string LogPlay::Encoding() const
+bool LogPlayPrivate::TakePrefetched(const tinyxml2::XMLElement *_xml,
+    std::string &_data)
 {
-  return this->dataPtr->encoding;
+  std::unique_lock<std::mutex> lock(this->prefetchMutex);
+
+  auto iter = this->prefetched.find(_xml);
+  if (iter == this->prefetched.end())
+    return false;
+
+  // Once removed, a chunk that no thread started is left to the caller.
+  auto chunk = iter->second;
+  this->prefetched.erase(iter);
+  if (!chunk->started)
+    return false;
+
+  this->prefetchDone.wait(lock, [&chunk]
+      {
+        return chunk->done;
+      });
+  if (!chunk->ok)
+    return false;
+
+  this->encoding = chunk->encoding;
+  _data = std::move(chunk->data);
+  return true;
 }
 
 /////////////////////////////////////////////////
-unsigned int LogPlay::ChunkCount() const
+void LogPlayPrivate::Prefetch(const tinyxml2::XMLElement *_xml,
+    const int _direction)
+{
+  std::lock_guard<std::mutex> lock(this->prefetchMutex);
+
+  auto iter = this->chunkIndices.find(_xml);
+  if (this->prefetchDepth == 0u || iter == this->chunkIndices.end())
+    return;
+
+  std::vector<const tinyxml2::XMLElement *> wanted;
+  for (unsigned int i = 1; i <= this->prefetchDepth; ++i)
+  {
+    const int64_t index = static_cast<int64_t>(iter->second) +
+      static_cast<int64_t>(i) * _direction;
+    if (index < 0 || index >= static_cast<int64_t>(this->chunks.size()))
+      break;
+    wanted.push_back(this->chunks[index]);
+  }
+
+  // Drop the chunks that aren't ahead of the playhead anymore. Chunks that
+  // are being decoded are kept until done, so that ChunkData waits for
+  // them instead of reading the same element concurrently.
+  for (auto chunkIter = this->prefetched.begin();
+       chunkIter != this->prefetched.end();)
+  {
+    const bool busy = chunkIter->second->started && !chunkIter->second->done;
+    if (!busy && std::find(wanted.begin(), wanted.end(), chunkIter->first) ==
+        wanted.end())
+    {
+      chunkIter = this->prefetched.erase(chunkIter);
+    }
+    else
+      ++chunkIter;
+  }
+
+  // Queue the missing chunks, nearest first.
+  this->prefetchQueue.clear();
+  for (auto const xml : wanted)
+  {
+    auto &chunk = this->prefetched[xml];
+    if (!chunk)
+      chunk.reset(new LogPlayPrefetchedChunk);
+    if (!chunk->started)
+      this->prefetchQueue.push_back(xml);
+  }
+
+  while (this->prefetchThreads.size() <
+         std::min(this->prefetchDepth, this->kMaxPrefetchThreads))
+  {
+    this->prefetchThreads.push_back(
+        std::thread(&LogPlayPrivate::PrefetchLoop, this));
+  }
+
+  this->prefetchWork.notify_all();
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::StopPrefetch()
 {
-  unsigned int count = 0;
-  auto xml = this->dataPtr->logStartXml->FirstChildElement("chunk");
+  {
+    std::lock_guard<std::mutex> lock(this->prefetchMutex);
+    this->prefetchStop = true;
+  }
+  this->prefetchWork.notify_all();
+
+  for (auto &thread : this->prefetchThreads)
+    thread.join();
 
-  while (xml)
+  std::lock_guard<std::mutex> lock(this->prefetchMutex);
+  this->prefetchThreads.clear();
+  this->prefetchQueue.clear();
+  this->prefetched.clear();
+  this->prefetchStop = false;
+}
+
+/////////////////////////////////////////////////
+void LogPlayPrivate::PrefetchLoop()
+{
+  std::unique_lock<std::mutex> lock(this->prefetchMutex);
+  while (true)
   {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
+    this->prefetchWork.wait(lock, [this]
+        {
+          return this->prefetchStop || !this->prefetchQueue.empty();
+        });
+    if (this->prefetchStop)
+      return;
+
+    const tinyxml2::XMLElement *xml = this->prefetchQueue.front();
+    this->prefetchQueue.pop_front();
+
+    auto iter = this->prefetched.find(xml);
+    if (iter == this->prefetched.end() || iter->second->started)
+      continue;
+
+    auto chunk = iter->second;
+    chunk->started = true;
+    lock.unlock();
+
+    // Neither the playhead nor another thread reads this chunk until it is
+    // done, which matters because tinyxml2 processes text on first access.
+    // Errors are left for ChunkData to report when the chunk is reached.
+    bool ok = false;
+    std::string chunkEncoding;
+    std::string data;
+    try
+    {
+      const char *encodingStr = xml->Attribute("encoding");
+      const char *formatStr = xml->Attribute("format");
+      const char *text = xml->GetText();
+      if (encodingStr && text)
+      {
+        chunkEncoding = encodingStr;
+        ok = DecodeChunk(chunkEncoding, formatStr ? formatStr : "sdf", text,
+            data);
+      }
+    }
+    catch(...)
+    {
+      ok = false;
+    }
+
+    lock.lock();
+    chunk->ok = ok;
+    chunk->encoding = chunkEncoding;
+    chunk->data = std::move(data);
+    chunk->done = true;
+    this->prefetchDone.notify_all();
   }
+}
+
+/////////////////////////////////////////////////
+void LogPlay::SetPrefetchDepth(const unsigned int _depth)
+{
+  if (_depth == 0u)
+    this->dataPtr->StopPrefetch();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->prefetchMutex);
+  this->dataPtr->prefetchDepth = _depth;
+}
+
+/////////////////////////////////////////////////
+unsigned int LogPlay::PrefetchDepth() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->prefetchMutex);
+  return this->dataPtr->prefetchDepth;
+}
 
-  return count;
+/////////////////////////////////////////////////
+std::string LogPlay::Encoding() const
+{
+  return this->dataPtr->encoding;
+}
+
+/////////////////////////////////////////////////
+unsigned int LogPlay::ChunkCount() const
+{
+  return this->dataPtr->chunks.size();
 }
 
 /////////////////////////////////////////////////
@@ -816,6 +1244,8 @@ bool LogPlay::NextChunk()
   this->dataPtr->start = 0;
   this->dataPtr->end = -1 * this->dataPtr->kEndFrame.size();
 
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, 1);
+
   return true;
 }
 
@@ -836,5 +1266,7 @@ bool LogPlay::PrevChunk()
   this->dataPtr->start = this->dataPtr->currentChunk.size() - 1;
   this->dataPtr->end = this->dataPtr->currentChunk.size() - 1;
 
+  this->dataPtr->Prefetch(this->dataPtr->logCurrXml, -1);
+
   return true;
 }
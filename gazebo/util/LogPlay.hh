@@ -115,6 +115,18 @@ namespace gazebo
       /// \param[out] _data Data from next entry in the log file.
       public: bool Step(const int _step, std::string &_data);
 
+      /// \brief Step forward to the last sample of the current chunk that
+      /// is not after a simulation time, without copying the samples in
+      /// between. Samples that insert or delete entities are never stepped
+      /// over, since they change the world rather than only its state.
+      /// This is used to fast-forward faster than the states can be
+      /// played.
+      /// \param[in] _time Simulation time that playback is due at.
+      /// \param[out] _data Data of the sample reached. It's the next sample
+      /// if that one is already after _time.
+      /// \return False at the end of the log.
+      public: bool StepUntil(const common::Time &_time, std::string &_data);
+
       /// \brief Jump to the closest sample that has its simulation time lower
       /// than the time specified as a parameter.
       /// \param[in] _time Target simulation time.
@@ -161,9 +173,27 @@ namespace gazebo
       /// false otherwise.
       public: bool HasIterations() const;
 
+      /// \brief Set the number of chunks decoded ahead of the playhead, in
+      /// the direction of the last step. The chunks are decoded on
+      /// background threads, so that Step and StepBack don't stall at
+      /// chunk boundaries. The initial depth is read from the environment
+      /// variable GAZEBO_LOG_PREFETCH.
+      /// \param[in] _depth Number of chunks, 0 to decode every chunk when
+      /// it is reached.
+      public: void SetPrefetchDepth(const unsigned int _depth);
+
+      /// \brief Get the number of chunks decoded ahead of the playhead.
+      /// \return Number of chunks.
+      /// \sa SetPrefetchDepth
+      public: unsigned int PrefetchDepth() const;
+
       /// \brief Read the header from the log file.
       private: void ReadHeader();
 
+      /// \brief Collect the chunks of the open log file along with the
+      /// sim_time index recorded by LogRecord, if present.
+      private: void ReadIndex();
+
       /// \brief Update the internal variables that keep track of the times
       /// where the log started and finished (simulation time).
       private: void ReadLogTimes();
@@ -179,6 +209,18 @@ namespace gazebo
       /// chunks after the current one.
       private: bool NextChunk();
 
+      /// \brief Step backwards from the current position until reaching a
+      /// frame with its simulation time lower than the time specified.
+      /// \param[in] _time Target simulation time.
+      /// \return True.
+      private: bool SeekBack(const common::Time &_time);
+
+      /// \brief Move to the last frame of the current chunk that comes
+      /// before the first frame with a simulation time not lower than the
+      /// time specified. Doesn't leave the current chunk.
+      /// \param[in] _time Target simulation time.
+      private: void SeekInChunk(const common::Time &_time);
+
       /// \brief If possible, jump to the previous chunk.
       /// \return True if the operation succeed or false if there were no more
       /// chunks before the current one.
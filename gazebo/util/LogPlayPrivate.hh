@@ -25,8 +25,14 @@
 #include <tinyxml2.h>
 #endif
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/system.hh"
@@ -35,10 +41,65 @@ namespace gazebo
 {
   namespace util
   {
+    /// \internal
+    /// \brief A chunk decoded ahead of the playhead.
+    class LogPlayPrefetchedChunk
+    {
+      /// \brief True once a thread started to decode the chunk.
+      public: bool started = false;
+
+      /// \brief True once the chunk was decoded.
+      public: bool done = false;
+
+      /// \brief True if the chunk was decoded successfully.
+      public: bool ok = false;
+
+      /// \brief Encoding of the chunk.
+      public: std::string encoding;
+
+      /// \brief Decoded data of the chunk.
+      public: std::string data;
+    };
+
     /// \internal
     /// \brief Private data for log play
     class LogPlayPrivate
     {
+      /// \brief Decode the data of a chunk. Safe to call from any thread,
+      /// as long as no other thread reads the same chunk.
+      /// \param[in] _encoding Encoding of the chunk.
+      /// \param[in] _format Format of the chunk's frames, sdf or frames.
+      /// \param[in] _text Text of the chunk.
+      /// \param[out] _data Storage for the chunk's data, as SDF.
+      /// \return False if the encoding or the format is unknown, or the
+      /// frames are invalid.
+      public: static bool DecodeChunk(const std::string &_encoding,
+                  const std::string &_format, const std::string &_text,
+                  std::string &_data);
+
+      /// \brief Take the data of a chunk decoded ahead of the playhead,
+      /// waiting for its thread if needed.
+      /// \param[in] _xml The chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return False if the chunk wasn't decoded ahead, or failed to.
+      public: bool TakePrefetched(const tinyxml2::XMLElement *_xml,
+                  std::string &_data);
+
+      /// \brief Decode the chunks that follow a chunk in the background.
+      /// Chunks that were decoded ahead and aren't needed anymore are
+      /// dropped.
+      /// \param[in] _xml The chunk at the playhead.
+      /// \param[in] _direction 1 to decode the next chunks, -1 to decode
+      /// the previous ones.
+      public: void Prefetch(const tinyxml2::XMLElement *_xml,
+                  const int _direction);
+
+      /// \brief Stop the prefetch threads and drop the chunks they decoded.
+      public: void StopPrefetch();
+
+      /// \brief Loop of a prefetch thread.
+      public: void PrefetchLoop();
+
       /// \brief Helper function to get chunk data from XML.
       /// \param[in] _xml Pointer to an xml block that has state data.
       /// \param[out] _data Storage for the chunk's data.
@@ -62,6 +123,12 @@ namespace gazebo
       /// \brief XML tag delimiting the end of a simulation time element.
       public: const std::string kEndTime = "</sim_time>";
 
+      /// \brief XML tag of the entities inserted by a frame.
+      public: const std::string kInsertions = "<insertions>";
+
+      /// \brief XML tag of the entities deleted by a frame.
+      public: const std::string kDeletions = "<deletions>";
+
       /// \brief The XML document of the log file.
       public: tinyxml2::XMLDocument xmlDoc;
 
@@ -111,8 +178,51 @@ namespace gazebo
       /// may not include this tag in the log files.
       public: bool iterationsFound = false;
 
+      /// \brief All the chunks of the log file, in file order.
+      public: std::vector<tinyxml2::XMLElement *> chunks;
+
+      /// \brief Simulation time of the first frame in each chunk, read from
+      /// the chunk's sim_time attribute. Same size as chunks.
+      public: std::vector<common::Time> chunkTimes;
+
+      /// \brief True if every chunk holding world states has a sim_time
+      /// attribute, which lets Seek binary search chunkTimes.
+      public: bool indexed = false;
+
+      /// \brief Index of each chunk in chunks.
+      public: std::map<const tinyxml2::XMLElement *, unsigned int>
+              chunkIndices;
+
       /// \brief A mutex to avoid race conditions.
       public: std::mutex mutex;
+
+      /// \brief Most prefetch threads started.
+      public: const unsigned int kMaxPrefetchThreads = 2u;
+
+      /// \brief Number of chunks decoded ahead of the playhead.
+      public: unsigned int prefetchDepth = 2u;
+
+      /// \brief Chunks decoded or being decoded ahead of the playhead.
+      public: std::map<const tinyxml2::XMLElement *,
+              std::shared_ptr<LogPlayPrefetchedChunk>> prefetched;
+
+      /// \brief Chunks waiting for a prefetch thread, nearest first.
+      public: std::deque<const tinyxml2::XMLElement *> prefetchQueue;
+
+      /// \brief Prefetch threads.
+      public: std::vector<std::thread> prefetchThreads;
+
+      /// \brief Set to stop the prefetch threads.
+      public: bool prefetchStop = false;
+
+      /// \brief Protects the prefetch members.
+      public: std::mutex prefetchMutex;
+
+      /// \brief Signaled when a chunk is queued or the threads must stop.
+      public: std::condition_variable prefetchWork;
+
+      /// \brief Signaled when a chunk is decoded.
+      public: std::condition_variable prefetchDone;
     };
   }
 }
@@ -17,8 +17,10 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
@@ -346,6 +348,63 @@ TEST_F(LogPlay_TEST, MultiStep)
   EXPECT_EQ(shasum, expectedShashum);
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the simulation time of a frame.
+/// \param[in] _frame The frame.
+/// \return Its <sim_time>.
+common::Time frameTime(const std::string &_frame)
+{
+  auto from = _frame.find("<sim_time>");
+  auto to = _frame.find("</sim_time>");
+  common::Time time;
+  if (from != std::string::npos && to != std::string::npos)
+  {
+    std::stringstream ss(_frame.substr(from + 10, to - from - 10));
+    ss >> time;
+  }
+  return time;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test StepUntil().
+TEST_F(LogPlay_TEST, StepUntil)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  // Open a correct log file.
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  std::string frame;
+  EXPECT_TRUE(player->Seek(common::Time(28.457)));
+  EXPECT_TRUE(player->Step(frame));
+  const common::Time start = frameTime(frame);
+
+  // A target before the next frame steps once.
+  EXPECT_TRUE(player->StepUntil(start, frame));
+  common::Time time = frameTime(frame);
+  EXPECT_GT(time, start);
+
+  // Jump to the last frame that is due, within the first chunk.
+  const common::Time target(29.0);
+  EXPECT_TRUE(player->StepUntil(target, frame));
+  time = frameTime(frame);
+  EXPECT_LE(time, target);
+  EXPECT_GT(time, target - common::Time(0.01));
+
+  // The frames after it are still there.
+  EXPECT_TRUE(player->Step(frame));
+  EXPECT_GT(frameTime(frame), target);
+
+  // Fast-forwarding past the end of the log stops at the last frame.
+  while (player->StepUntil(common::Time(100.0), frame))
+    time = frameTime(frame);
+  EXPECT_EQ(time, player->LogEndTime());
+}
+
 /////////////////////////////////////////////////
 /// \brief Test Seek().
 TEST_F(LogPlay_TEST, Seek)
@@ -406,6 +465,83 @@ TEST_F(LogPlay_TEST, Seek)
   EXPECT_EQ(shasum, expectedShashum4);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that Seek() on a log with a sim_time chunk index lands on
+/// the same frames as on the unindexed log.
+TEST_F(LogPlay_TEST, SeekIndexed)
+{
+  // \todo Make temporary files work in windows.
+#ifndef _WIN32
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Copy the log, adding a sim_time attribute to each chunk.
+  std::string header = player->Header();
+  std::ostringstream stream;
+  stream << "/tmp/__gz_log_index_test" << std::this_thread::get_id();
+  std::string tmpFilename = stream.str();
+  std::ofstream destFile(tmpFilename);
+  ASSERT_TRUE(destFile.good());
+  destFile << header;
+
+  for (unsigned int i = 0; i < player->ChunkCount(); ++i)
+  {
+    std::string chunk;
+    ASSERT_TRUE(player->Chunk(i, chunk));
+    if (!chunk.empty() && chunk.back() == '\0')
+      chunk.pop_back();
+
+    destFile << "<chunk encoding='txt'";
+    auto from = chunk.find("<sim_time>");
+    auto to = chunk.find("</sim_time>");
+    if (from != std::string::npos && to != std::string::npos)
+    {
+      from += std::string("<sim_time>").size();
+      destFile << " sim_time='" << chunk.substr(from, to - from) << "'";
+
+      to = chunk.rfind("</sim_time>");
+      from = chunk.rfind("<sim_time>") + std::string("<sim_time>").size();
+      destFile << " last_sim_time='" << chunk.substr(from, to - from) << "'";
+    }
+    destFile << "><![CDATA[" << chunk << "]]></chunk>\n";
+  }
+  destFile << "</gazebo_log>\n";
+  destFile.close();
+
+  const common::Time endTime = player->LogEndTime();
+
+  std::vector<common::Time> times = {common::Time(30.0),
+    common::Time(31.5), common::Time(28.457), common::Time(31.745),
+    common::Time(25.0), common::Time(35.0), common::Time(29.458),
+    common::Time(30.458)};
+
+  std::vector<std::string> expectedFrames;
+  for (auto const &time : times)
+  {
+    std::string frame;
+    EXPECT_TRUE(player->Seek(time));
+    EXPECT_TRUE(player->Step(frame));
+    expectedFrames.push_back(frame);
+  }
+
+  EXPECT_NO_THROW(player->Open(tmpFilename));
+  std::remove(tmpFilename.c_str());
+  EXPECT_EQ(endTime, player->LogEndTime());
+
+  for (unsigned int i = 0; i < times.size(); ++i)
+  {
+    std::string frame;
+    EXPECT_TRUE(player->Seek(times[i]));
+    EXPECT_TRUE(player->Step(frame));
+    EXPECT_EQ(expectedFrames[i], frame) << "Seek to " << times[i];
+  }
+#endif
+}
+
 /////////////////////////////////////////////////
 /// \brief Test reading a log file that is missing the closing </gazebo_log>
 /// tag
@@ -457,6 +593,42 @@ TEST_F(LogPlay_TEST, NoEndTag)
 #endif
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that the chunks decoded ahead of the playhead give the same
+/// frames as chunks decoded when reached.
+TEST_F(LogPlay_TEST, Prefetch)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+  const unsigned int depth = player->PrefetchDepth();
+
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("insertion_deletion.log");
+
+  std::vector<std::string> forward[2];
+  std::vector<std::string> backward[2];
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    player->SetPrefetchDepth(i * 2);
+    EXPECT_EQ(player->PrefetchDepth(), i * 2);
+    EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+    std::string frame;
+    while (player->Step(frame))
+      forward[i].push_back(frame);
+
+    EXPECT_TRUE(player->Forward());
+    while (player->StepBack(frame))
+      backward[i].push_back(frame);
+  }
+
+  EXPECT_GT(forward[0].size(), 1000u);
+  EXPECT_EQ(forward[0], forward[1]);
+  EXPECT_EQ(backward[0], backward[1]);
+
+  player->SetPrefetchDepth(depth);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
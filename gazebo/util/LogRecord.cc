@@ -25,6 +25,8 @@
   #define access _access
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 
 #include <boost/archive/iterators/base64_from_binary.hpp>
@@ -34,6 +36,7 @@
 
 #include <boost/date_time.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
@@ -48,10 +51,12 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/common/ThreadConfig.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/gazebo_config.h"
 #include "gazebo/transport/transport.hh"
+#include "gazebo/util/LogFrames.hh"
 #include "gazebo/util/LogRecordPrivate.hh"
 #include "gazebo/util/LogRecord.hh"
 
@@ -93,6 +98,32 @@ LogRecord::LogRecord()
 
   this->dataPtr->logsEnd = this->dataPtr->logs.end();
 
+  // Compress the chunks on a few threads, so that bz2 keeps up with
+  // large worlds.
+  unsigned int threads = std::min(std::thread::hardware_concurrency(), 4u);
+  const char *threadsEnv = common::getEnv("GAZEBO_LOG_COMPRESS_THREADS");
+  if (threadsEnv && *threadsEnv)
+  {
+    try
+    {
+      threads = boost::lexical_cast<unsigned int>(threadsEnv);
+    }
+    catch(...)
+    {
+      gzwarn << "Invalid GAZEBO_LOG_COMPRESS_THREADS[" << threadsEnv
+             << "]\n";
+    }
+  }
+  threads = common::ThreadConfig::Instance()->PoolSize(
+      "log_compress", threads);
+  this->dataPtr->compressPool.reset(
+      new LogCompressPool(std::max(threads, 1u)));
+
+  // Share the saved resources of several log directories.
+  const char *storeEnv = common::getEnv("GAZEBO_LOG_RESOURCE_STORE");
+  if (storeEnv)
+    this->dataPtr->resourceStorePath = storeEnv;
+
   this->dataPtr->connections.push_back(
      event::Events::ConnectPause(
        std::bind(&LogRecord::OnPause, this, std::placeholders::_1)));
@@ -137,9 +168,18 @@ bool LogRecord::Init(const std::string &_subdir)
 //////////////////////////////////////////////////
 bool LogRecord::Start(const LogRecordParams &_params)
 {
+  if (_params.format != "sdf" && _params.format != "frames")
+  {
+    gzthrow("Invalid log format[" + _params.format +
+            "]. Must be one of [sdf, frames]");
+  }
+
   this->dataPtr->period = _params.period;
   this->dataPtr->filter = _params.filter;
   this->dataPtr->recordResources = _params.recordResources;
+  this->dataPtr->topics = _params.topics;
+  if (!this->Running())
+    this->dataPtr->format = _params.format;
   return this->Start(_params.encoding, _params.path);
 }
 
@@ -182,13 +222,29 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
       logTimeDir / this->dataPtr->logSubDir;
   }
 
+  // Keep the resource store next to the logs, so that they can link to
+  // it. A log with its own path shares the store of its parent directory.
+  if (!this->dataPtr->resourceStorePath.empty())
+    this->dataPtr->resourceRoot = this->dataPtr->resourceStorePath;
+  else if (!_path.empty())
+  {
+    this->dataPtr->resourceRoot =
+      boost::filesystem::path(_path).remove_trailing_separator()
+      .parent_path() / ".resources";
+  }
+  else
+    this->dataPtr->resourceRoot = this->dataPtr->logBasePath / ".resources";
+
   // Create the log directory if necessary
   if (!boost::filesystem::exists(this->dataPtr->logCompletePath))
     boost::filesystem::create_directories(this->dataPtr->logCompletePath);
 
-  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib")
+  if (_encoding != "bz2" && _encoding != "txt" && _encoding != "zlib" &&
+      _encoding != "zlib_fast")
+  {
     gzthrow("Invalid log encoding[" + _encoding +
-            "]. Must be one of [bz2, zlib, txt]");
+            "]. Must be one of [bz2, zlib, zlib_fast, txt]");
+  }
 
   this->dataPtr->encoding = _encoding;
 
@@ -202,6 +258,8 @@ bool LogRecord::Start(const std::string &_encoding, const std::string &_path)
       iter->second->Start(this->dataPtr->logCompletePath);
   }
 
+  this->StartTopicLog();
+
   this->dataPtr->running = true;
   this->dataPtr->paused = false;
   this->dataPtr->firstUpdate = true;
@@ -244,6 +302,12 @@ const std::string &LogRecord::Encoding() const
   return this->dataPtr->encoding;
 }
 
+//////////////////////////////////////////////////
+const std::string &LogRecord::Format() const
+{
+  return this->dataPtr->format;
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Fini()
 {
@@ -262,6 +326,11 @@ void LogRecord::Fini()
     this->dataPtr->cleanupThread->join();
   this->dataPtr->cleanupThread.reset();
 
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+    this->dataPtr->resourceStore.reset();
+  }
+
   std::lock_guard<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->connections.clear();
 
@@ -272,6 +341,14 @@ void LogRecord::Fini()
 //////////////////////////////////////////////////
 void LogRecord::Stop()
 {
+  // The log is complete once its resources are, so it's only reported as
+  // stopped after them.
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+    if (this->dataPtr->resourceStore)
+      this->dataPtr->resourceStore->Wait();
+  }
+
   this->dataPtr->running = false;
   this->dataPtr->cleanupCondition.notify_all();
 
@@ -352,6 +429,27 @@ void LogRecord::SetRecordResources(const bool _record)
   this->dataPtr->recordResources = _record;
 }
 
+//////////////////////////////////////////////////
+std::string LogRecord::ResourceStorePath() const
+{
+  return this->dataPtr->resourceStorePath;
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetResourceStorePath(const std::string &_path)
+{
+  this->dataPtr->resourceStorePath = _path;
+}
+
+//////////////////////////////////////////////////
+ResourceStoreStats LogRecord::ResourceStats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->resourceMutex);
+  if (!this->dataPtr->resourceStore)
+    return ResourceStoreStats();
+  return this->dataPtr->resourceStore->Stats();
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Add(const std::string &_name, const std::string &_filename,
                     std::function<bool (std::ostringstream &)> _logCallback)
@@ -383,6 +481,7 @@ void LogRecord::Add(const std::string &_name, const std::string &_filename,
   try
   {
     newLog = new LogRecordPrivate::Log(this, _filename, _logCallback);
+    newLog->pool = this->dataPtr->compressPool.get();
   }
   catch(...)
   {
@@ -549,11 +648,8 @@ bool LogRecord::SaveModels(const std::set<std::string> &_models)
         modelFound = true;
         boost::filesystem::path destModelPath =
           this->dataPtr->logCompletePath / model;
-        if (!gazebo::common::copyDir(srcModelPath, destModelPath))
-        {
-          gzerr << "Failed to copy model from '" << srcModelPath.string()
-                 << "' to '" << destModelPath.string() << "'" << std::endl;
-        }
+        this->dataPtr->Resources().AddDirectory(srcModelPath.string(),
+            destModelPath.string());
         break;
       }
     }
@@ -631,15 +727,8 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / modelPath;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / modelPath;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(destPath, errorCode);
-        if (errorCode != boost::system::errc::success ||
-            !gazebo::common::copyDir(srcPath, destPath))
-        {
-          gzerr << "Failed to copy model from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->Resources().AddDirectory(srcPath.string(),
+            destPath.string());
       }
       // else copy only the specified file
       else
@@ -647,17 +736,8 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
         srcPath = srcPath / fileName;
         boost::filesystem::path destPath =
           this->dataPtr->logCompletePath / fileName;
-        boost::system::error_code errorCode;
-        boost::filesystem::create_directories(
-            destPath.parent_path(), errorCode);
-        if (errorCode == boost::system::errc::success)
-          boost::filesystem::copy_file(srcPath, destPath, errorCode);
-        else
-        {
-          gzerr << "Failed to copy file from '" << srcPath.string()
-                 << "' to '" << destPath.string() << "'" << std::endl;
-          saveError = true;
-        }
+        this->dataPtr->Resources().AddFile(srcPath.string(),
+            destPath.string());
       }
     }
     else
@@ -670,6 +750,18 @@ bool LogRecord::SaveFiles(const std::set<std::string> &_files)
   return !saveError;
 }
 
+//////////////////////////////////////////////////
+ResourceStore &LogRecordPrivate::Resources()
+{
+  std::lock_guard<std::mutex> lock(this->resourceMutex);
+  if (!this->resourceStore ||
+      this->resourceStore->Root() != this->resourceRoot.string())
+  {
+    this->resourceStore.reset(new ResourceStore(this->resourceRoot.string()));
+  }
+  return *this->resourceStore;
+}
+
 //////////////////////////////////////////////////
 void LogRecord::Notify()
 {
@@ -680,6 +772,8 @@ void LogRecord::Notify()
 //////////////////////////////////////////////////
 void LogRecord::RunUpdate()
 {
+  common::ThreadConfig::Instance()->Apply("log_record");
+
   std::unique_lock<std::mutex> updateLock(this->dataPtr->updateMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -733,6 +827,8 @@ void LogRecord::Update()
 //////////////////////////////////////////////////
 void LogRecord::RunWrite()
 {
+  common::ThreadConfig::Instance()->Apply("log_record");
+
   // Wait for new data.
   std::unique_lock<std::mutex> lock(this->dataPtr->runWriteMutex);
   this->dataPtr->startThreadCondition.notify_all();
@@ -758,6 +854,155 @@ void LogRecord::Write(const bool /*_force*/)
   {
     this->dataPtr->updateIter->second->Write();
   }
+
+  if (this->dataPtr->topicLog)
+    this->dataPtr->topicLog->Write();
+}
+
+//////////////////////////////////////////////////
+void LogRecord::SetSimTime(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->simTimeMutex);
+  this->dataPtr->simTime = _time;
+}
+
+//////////////////////////////////////////////////
+std::string LogRecord::TopicLogFilename() const
+{
+  return this->dataPtr->topicLogPath.string();
+}
+
+//////////////////////////////////////////////////
+void LogRecord::StartTopicLog()
+{
+  this->dataPtr->topicLogPath.clear();
+  if (this->dataPtr->topics.empty())
+    return;
+
+  if (!this->dataPtr->node)
+  {
+    gzerr << "No world is recorded, unable to record topics\n";
+    return;
+  }
+
+  // Chunks of the topic log share the compression threads of the logs
+  LogCompressPool *pool = this->dataPtr->compressPool.get();
+  this->dataPtr->topicLog.reset(new TopicLogWriter(
+      [pool](const std::function<std::string ()> &_task)
+      {
+        return pool->Post(_task);
+      }));
+
+  boost::filesystem::path path =
+    this->dataPtr->logCompletePath / "topics.tlog";
+  if (!this->dataPtr->topicLog->Open(path.string(),
+        this->dataPtr->encoding != "txt"))
+  {
+    this->dataPtr->topicLog.reset();
+    return;
+  }
+  this->dataPtr->topicLogPath = path;
+
+  for (auto const &topic : this->dataPtr->topics)
+  {
+    std::unique_ptr<LogTopicTap> tap(new LogTopicTap);
+    tap->writer = this->dataPtr->topicLog.get();
+    tap->parent = this->dataPtr.get();
+    tap->topic = this->dataPtr->node->DecodeTopicName(topic);
+    tap->sub = this->dataPtr->node->Subscribe(tap->topic,
+        &LogTopicTap::OnMessage, tap.get());
+    this->dataPtr->topicTaps.push_back(std::move(tap));
+  }
+}
+
+//////////////////////////////////////////////////
+void LogRecord::StopTopicLog()
+{
+  for (auto &tap : this->dataPtr->topicTaps)
+    tap->sub.reset();
+  this->dataPtr->topicTaps.clear();
+
+  if (this->dataPtr->topicLog)
+  {
+    this->dataPtr->topicLog->Close();
+    this->dataPtr->topicLog.reset();
+  }
+}
+
+//////////////////////////////////////////////////
+void LogTopicTap::OnMessage(const std::string &_data)
+{
+  if (this->msgType.empty())
+    this->msgType = transport::getTopicMsgType(this->topic);
+
+  common::Time time;
+  {
+    std::lock_guard<std::mutex> lock(this->parent->simTimeMutex);
+    time = this->parent->simTime;
+  }
+  this->writer->Add(this->topic, this->msgType, time, _data);
+}
+
+//////////////////////////////////////////////////
+LogCompressPool::LogCompressPool(const unsigned int _threads)
+{
+  for (unsigned int i = 0; i < _threads; ++i)
+    this->threads.push_back(std::thread(&LogCompressPool::Run, this));
+}
+
+//////////////////////////////////////////////////
+LogCompressPool::~LogCompressPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_all();
+
+  for (auto &thread : this->threads)
+    thread.join();
+}
+
+//////////////////////////////////////////////////
+std::future<std::string> LogCompressPool::Post(
+    const std::function<std::string ()> &_task)
+{
+  std::packaged_task<std::string ()> task(_task);
+  std::future<std::string> result = task.get_future();
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->tasks.push_back(std::move(task));
+  }
+  this->condition.notify_one();
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+void LogCompressPool::Run()
+{
+  common::ThreadConfig::Instance()->Apply("log_compress");
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->condition.wait(lock, [this]
+        {
+          return this->stop || !this->tasks.empty();
+        });
+
+    // Queued tasks still run when stopping, as their logs wait for them.
+    if (this->tasks.empty())
+      return;
+
+    std::packaged_task<std::string ()> task = std::move(this->tasks.front());
+    this->tasks.pop_front();
+
+    lock.unlock();
+    task();
+    lock.lock();
+  }
 }
 
 //////////////////////////////////////////////////
@@ -766,6 +1011,27 @@ common::Time LogRecord::RunTime() const
   return this->dataPtr->currTime - this->dataPtr->startTime;
 }
 
+//////////////////////////////////////////////////
+bool LogRecordPrivate::Log::ChunkValue(const std::string &_data,
+    const std::string &_startTag, const std::string &_endTag,
+    std::string &_value, const bool _last)
+{
+  auto from = _last ? _data.rfind(_startTag) : _data.find(_startTag);
+  if (from == std::string::npos)
+    return false;
+
+  from += _startTag.size();
+  auto to = _data.find(_endTag, from);
+  if (to == std::string::npos)
+    return false;
+
+  _value = _data.substr(from, to - from);
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::size_t LogRecordPrivate::Log::kMaxChunkSize;
+
 //////////////////////////////////////////////////
 LogRecordPrivate::Log::Log(LogRecord *_parent,
     const std::string &_relativeFilename,
@@ -794,66 +1060,170 @@ unsigned int LogRecordPrivate::Log::Update()
     std::string data = stream.str();
     if (!data.empty())
     {
-      const std::string &encodingLocal = this->parent->Encoding();
-
-      this->buffer.append("<chunk encoding='");
-      this->buffer.append(encodingLocal);
-      this->buffer.append("'>\n");
-
-      this->buffer.append("<![CDATA[");
-      // Compress the data.
-      if (encodingLocal == "bz2")
+      const std::string encodingLocal = this->parent->Encoding();
+      const std::string formatLocal = this->parent->Format();
+      const std::string kStartFrame = "<sdf ";
+      const std::string kEndFrame = "</sdf>";
+
+      // Split the data after whole frames, so that the chunks can be
+      // compressed independently.
+      std::size_t start = 0;
+      while (start < data.size())
       {
-        std::string str;
-
-        // Compress to bzip2
+        std::size_t end = data.size();
+        if (end - start > kMaxChunkSize)
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::bzip2_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
+          auto frameEnd = data.rfind(kEndFrame, start + kMaxChunkSize);
+          if (frameEnd == std::string::npos || frameEnd < start)
+            frameEnd = data.find(kEndFrame, start + kMaxChunkSize);
+
+          // Don't leave a chunk without a frame.
+          if (frameEnd != std::string::npos &&
+              data.find(kStartFrame, frameEnd) != std::string::npos)
+          {
+            end = frameEnd + kEndFrame.size();
+          }
         }
 
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
-      }
-      else if (encodingLocal == "zlib")
-      {
-        std::string str;
+        std::string chunk = data.substr(start, end - start);
+        start = end;
 
-        // Compress to zlib
+        if (this->pool && encodingLocal != "txt")
         {
-          boost::iostreams::filtering_ostream out;
-          out.push(boost::iostreams::zlib_compressor());
-          out.push(std::back_inserter(str));
-          boost::iostreams::copy(boost::make_iterator_range(data), out);
+          this->pending.push_back(this->pool->Post(
+                [encodingLocal, formatLocal, chunk = std::move(chunk)]()
+                {
+                  return EncodeChunk(encodingLocal, formatLocal, chunk);
+                }));
+        }
+        else
+        {
+          std::promise<std::string> encoded;
+          encoded.set_value(EncodeChunk(encodingLocal, formatLocal, chunk));
+          this->pending.push_back(encoded.get_future());
         }
-
-        // Encode in base64.
-        Base64Encode(str.c_str(), str.size(), this->buffer);
       }
-      else if (encodingLocal == "txt")
-        this->buffer.append(data);
-      else
-        gzerr << "Unknown log file encoding[" << encodingLocal << "]\n";
-      this->buffer.append("]]>\n");
-
-      this->buffer.append("</chunk>\n");
     }
   }
 
+  this->Collect(false);
   return this->buffer.size();
 }
 
+//////////////////////////////////////////////////
+void LogRecordPrivate::Log::Collect(const bool _wait)
+{
+  while (!this->pending.empty() && (_wait ||
+         this->pending.front().wait_for(std::chrono::seconds(0)) ==
+         std::future_status::ready))
+  {
+    this->buffer.append(this->pending.front().get());
+    this->pending.pop_front();
+  }
+  this->memory.Set(this->buffer.size(), this->pending.size());
+}
+
+//////////////////////////////////////////////////
+std::string LogRecordPrivate::Log::EncodeChunk(const std::string &_encoding,
+    const std::string &_format, const std::string &_data)
+{
+  std::string result;
+
+  // zlib_fast trades size for speed, and reads like any zlib chunk.
+  result.append("<chunk encoding='");
+  result.append(_encoding == "zlib_fast" ? "zlib" : _encoding);
+  result.append("'");
+
+  // Compressed chunks can store their frames in binary. Data that isn't a
+  // sequence of frames stays as text.
+  std::string frames;
+  const bool binary = _format == "frames" && _encoding != "txt" &&
+    LogFrames::Encode(_data, frames);
+  const std::string &payload = binary ? frames : _data;
+  if (binary)
+    result.append(" format='frames'");
+
+  // Index the chunk by the first simulation time and iteration it
+  // contains, so that LogPlay can seek without decoding every chunk.
+  std::string simTime, iterations;
+  if (ChunkValue(_data, "<sim_time>", "</sim_time>", simTime))
+  {
+    result.append(" sim_time='");
+    result.append(simTime);
+    result.append("'");
+
+    // The last time lets LogPlay read the end of the log without
+    // decoding the last chunk.
+    ChunkValue(_data, "<sim_time>", "</sim_time>", simTime, true);
+    result.append(" last_sim_time='");
+    result.append(simTime);
+    result.append("'");
+  }
+  if (ChunkValue(_data, "<iterations>", "</iterations>", iterations))
+  {
+    result.append(" iterations='");
+    result.append(iterations);
+    result.append("'");
+  }
+  result.append(">\n");
+
+  result.append("<![CDATA[");
+  // Compress the data.
+  if (_encoding == "bz2")
+  {
+    std::string str;
+
+    // Compress to bzip2
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::bzip2_compressor());
+      out.push(std::back_inserter(str));
+      boost::iostreams::copy(boost::make_iterator_range(payload), out);
+    }
+
+    // Encode in base64.
+    Base64Encode(str.c_str(), str.size(), result);
+  }
+  else if (_encoding == "zlib" || _encoding == "zlib_fast")
+  {
+    std::string str;
+
+    // Compress to zlib
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push(boost::iostreams::zlib_compressor(_encoding == "zlib" ?
+            boost::iostreams::zlib::default_compression :
+            boost::iostreams::zlib::best_speed));
+      out.push(std::back_inserter(str));
+      boost::iostreams::copy(boost::make_iterator_range(payload), out);
+    }
+
+    // Encode in base64.
+    Base64Encode(str.c_str(), str.size(), result);
+  }
+  else if (_encoding == "txt")
+    result.append(_data);
+  else
+    gzerr << "Unknown log file encoding[" << _encoding << "]\n";
+  result.append("]]>\n");
+
+  result.append("</chunk>\n");
+
+  return result;
+}
+
 //////////////////////////////////////////////////
 void LogRecordPrivate::Log::ClearBuffer()
 {
+  this->pending.clear();
   this->buffer.clear();
+  this->memory.Set(0, 0);
 }
 
 //////////////////////////////////////////////////
 unsigned int LogRecordPrivate::Log::BufferSize()
 {
+  this->Collect(false);
   return this->buffer.size();
 }
 
@@ -875,6 +1245,7 @@ void LogRecordPrivate::Log::Stop()
   if (this->logFile.is_open())
   {
     this->Update();
+    this->Collect(true);
     this->Write();
 
     std::string xmlEnd = "</gazebo_log>";
@@ -912,6 +1283,8 @@ void LogRecordPrivate::Log::Start(const boost::filesystem::path &_path)
 //////////////////////////////////////////////////
 void LogRecordPrivate::Log::Write()
 {
+  this->Collect(false);
+
   // Make sure the file is open for writing
   if (!this->logFile.is_open())
   {
@@ -934,6 +1307,7 @@ void LogRecordPrivate::Log::Write()
 
     // We have to clear the buffer, or else it may grow indefinitely.
     this->buffer.clear();
+    this->memory.Set(0, this->pending.size());
     return;
   }
 
@@ -943,6 +1317,7 @@ void LogRecordPrivate::Log::Write()
 
   // Clear the buffer.
   this->buffer.clear();
+  this->memory.Set(0, this->pending.size());
 }
 
 //////////////////////////////////////////////////
@@ -957,6 +1332,16 @@ void LogRecord::OnLogControl(ConstLogControlPtr &_data)
 
   if (_data->has_start() && _data->start())
   {
+    if (_data->has_format() && !this->Running())
+    {
+      if (_data->format() != "sdf" && _data->format() != "frames")
+      {
+        gzerr << "Invalid log format[" << _data->format()
+              << "]. Must be one of [sdf, frames]\n";
+        return;
+      }
+      this->dataPtr->format = _data->format();
+    }
     this->Start(msgEncoding);
   }
   else if (_data->has_stop() && _data->stop())
@@ -1030,6 +1415,8 @@ void LogRecord::PublishLogStatus()
 //////////////////////////////////////////////////
 void LogRecord::Cleanup()
 {
+  common::ThreadConfig::Instance()->Apply("log_record");
+
   std::unique_lock<std::mutex> lock(this->dataPtr->controlMutex);
   this->dataPtr->startThreadCondition.notify_all();
 
@@ -1079,6 +1466,8 @@ void LogRecord::Cleanup()
     iter->second->Stop();
   }
 
+  this->StopTopicLog();
+
   // Reset the times
   this->dataPtr->startTime = this->dataPtr->currTime = common::Time();
 
@@ -20,9 +20,11 @@
 #include <fstream>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/common/SingletonT.hh"
+#include "gazebo/util/ResourceStore.hh"
 #include "gazebo/util/system.hh"
 
 #define GZ_LOG_VERSION "1.0"
@@ -38,9 +40,15 @@ namespace gazebo
     /// \sa LogRecord::Start
     class LogRecordParams
     {
-      /// \brief The type of encoding (txt, zlib, or bz2).
+      /// \brief The type of encoding (txt, zlib, zlib_fast, or bz2).
       public: std::string encoding = "zlib";
 
+      /// \brief The format of the state frames, sdf or frames. frames
+      /// stores the poses of each chunk in a compact binary form, see
+      /// LogFrames, which older versions can't play back. It is ignored
+      /// by the txt encoding.
+      public: std::string format = "sdf";
+
       /// \brief Path in which to store log files.
       public: std::string path;
 
@@ -54,6 +62,10 @@ namespace gazebo
       /// \brief Recording resources. True will record state logs
       /// together with model meshes and materials.
       public: bool recordResources = false;
+
+      /// \brief Topics whose messages are recorded into a topic log next
+      /// to the state log, see TopicLogWriter.
+      public: std::vector<std::string> topics;
     };
 
     // Forward declare private data class
@@ -162,6 +174,23 @@ namespace gazebo
       /// \param[in] _record True to save model resources when recording.
       public: void SetRecordResources(const bool _record);
 
+      /// \brief Get the directory of the store that holds the saved
+      /// resources, which the log directories link to.
+      /// \return The directory, empty for the default, which is the
+      /// .resources directory of the base path. It can also be set with
+      /// the GAZEBO_LOG_RESOURCE_STORE environment variable.
+      public: std::string ResourceStorePath() const;
+
+      /// \brief Set the directory of the resource store. Logs on another
+      /// file system get copies of the resources instead of links. It
+      /// applies from the next log.
+      /// \param[in] _path The directory, empty for the default.
+      public: void SetResourceStorePath(const std::string &_path);
+
+      /// \brief Get the counters of the resource store.
+      /// \return The counters, zero if no resource was saved.
+      public: ResourceStoreStats ResourceStats() const;
+
       /// \brief Get whether the logger is ready to start, which implies
       /// that any previous runs have finished.
       // \return True if logger is ready to start.
@@ -176,16 +205,22 @@ namespace gazebo
       public: bool Start(const LogRecordParams &_params);
 
       /// \brief Start the logger.
-      /// \param[in] _encoding The type of encoding (txt, zlib, or bz2).
+      /// \param[in] _encoding The type of encoding (txt, zlib, zlib_fast, or
+      /// bz2). zlib_fast compresses less than zlib, but faster, and is read
+      /// back as zlib.
       /// \param[in] _path Path in which to store log files.
       public: bool Start(const std::string &_encoding="zlib",
                          const std::string &_path="");
 
       /// \brief Get the encoding used.
-      /// \return Either [txt, zlib, or bz2], where txt is plain txt and bz2
-      /// and zlib are compressed data with Base64 encoding.
+      /// \return Either [txt, zlib, zlib_fast, or bz2], where txt is plain
+      /// txt and the others are compressed data with Base64 encoding.
       public: const std::string &Encoding() const;
 
+      /// \brief Get the format of the state frames.
+      /// \return Either sdf or frames, see LogRecordParams::format.
+      public: const std::string &Format() const;
+
       /// \brief Get the filename for a log object.
       /// \param[in] _name Name of the log object.
       /// \return Filename, empty string if not found.
@@ -215,13 +250,15 @@ namespace gazebo
       /// \return True if an Update has not yet been completed.
       public: bool FirstUpdate() const;
 
-      /// \brief Return true if all the models are saved successfully.
+      /// \brief Save the models into the log. They're added to the
+      /// resource store in the background, and Stop waits for them.
       /// \return True if all the models are saved successfully.
       public: bool SaveModels(const std::set<std::string> &models);
 
-      /// \brief Return true if all the files are saved successfully.
-      /// \return True if all the files are saved successfully, and false if
-      /// there are errors saving the files.
+      /// \brief Save the files into the log, in the background like
+      /// SaveModels.
+      /// \return True if all the files are found, and false if there are
+      /// errors saving the files.
       public: bool SaveFiles(const std::set<std::string> &resources);
 
       /// \brief Write all logs.
@@ -232,6 +269,15 @@ namespace gazebo
       /// \return Size of the buffer, in bytes.
       public: unsigned int BufferSize() const;
 
+      /// \brief Set the simulation time given to the recorded topic
+      /// messages. The world calls this on every update while recording.
+      /// \param[in] _time Current simulation time.
+      public: void SetSimTime(const common::Time &_time);
+
+      /// \brief Get the path of the topic log.
+      /// \return Path of the topic log, empty if no topic is recorded.
+      public: std::string TopicLogFilename() const;
+
       /// \brief Update the log files
       ///
       /// Captures the current state of all registered entities, and outputs
@@ -259,6 +305,13 @@ namespace gazebo
       /// to trigger a cleanup.
       private: void Cleanup();
 
+      /// \brief Open the topic log and subscribe to the recorded topics.
+      private: void StartTopicLog();
+
+      /// \brief Unsubscribe from the recorded topics and close the topic
+      /// log.
+      private: void StopTopicLog();
+
       /// \brief Used to get the simulation pause state.
       private: void OnPause(const bool _pause);
 
@@ -17,20 +17,94 @@
 #ifndef _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 #define _GAZEBO_UTIL_LOGRECORD_PRIVATE_HH_
 
+#include <deque>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
 #include <functional>
+#include <future>
+#include <vector>
 #include <condition_variable>
 #include <boost/filesystem.hpp>
 
+#include "gazebo/common/MemoryAccounts.hh"
+#include "gazebo/common/Time.hh"
+#include "gazebo/transport/TransportTypes.hh"
+#include "gazebo/util/ResourceStore.hh"
+#include "gazebo/util/TopicLog.hh"
+
 namespace gazebo
 {
   namespace util
   {
     class LogRecord;
+    class LogRecordPrivate;
+
+    /// \internal
+    /// \brief Records the messages of a topic into the topic log. The
+    /// subscription is raw, so local publications reach it as the bytes
+    /// serialized once for every subscriber, without a copy of the message.
+    class LogTopicTap
+    {
+      /// \brief Called when a message is published on the topic.
+      /// \param[in] _data The serialized message.
+      public: void OnMessage(const std::string &_data);
+
+      /// \brief Topic log to write to.
+      public: TopicLogWriter *writer = nullptr;
+
+      /// \brief Log record whose simulation time stamps the messages.
+      public: LogRecordPrivate *parent = nullptr;
+
+      /// \brief Fully qualified name of the topic.
+      public: std::string topic;
+
+      /// \brief Type of the messages, found with the first message.
+      public: std::string msgType;
+
+      /// \brief Subscription to the topic.
+      public: transport::SubscriberPtr sub;
+    };
+
+    /// \internal
+    /// \brief Threads that compress the chunks of every log.
+    class LogCompressPool
+    {
+      /// \brief Constructor
+      /// \param[in] _threads Number of threads, at least 1.
+      public: explicit LogCompressPool(const unsigned int _threads);
+
+      /// \brief Destructor. Runs the queued tasks, then stops the threads.
+      public: ~LogCompressPool();
+
+      /// \brief Queue a task.
+      /// \param[in] _task Task that returns an encoded chunk.
+      /// \return The result of the task.
+      public: std::future<std::string> Post(
+                  const std::function<std::string ()> &_task);
+
+      /// \brief Loop of a thread.
+      private: void Run();
+
+      /// \brief The threads.
+      private: std::vector<std::thread> threads;
+
+      /// \brief Queued tasks.
+      private: std::deque<std::packaged_task<std::string ()>> tasks;
+
+      /// \brief Set to stop the threads.
+      private: bool stop = false;
+
+      /// \brief Protects the queue.
+      private: std::mutex mutex;
+
+      /// \brief Signaled when a task is queued or the threads must stop.
+      private: std::condition_variable condition;
+    };
 
     /// \internal
     /// \brief Private data class for LogRecord.
@@ -39,6 +113,11 @@ namespace gazebo
       /// \brief Destructor (makes style checker happy)
       public: virtual ~LogRecordPrivate() = default;
 
+      /// \brief Get the resource store of the current log, created or
+      /// moved to resourceRoot when needed.
+      /// \return The store.
+      public: ResourceStore &Resources();
+
       /// \brief Log helper class
       public: class Log
       {
@@ -64,10 +143,37 @@ namespace gazebo
         /// \brief Write data to disk.
         public: void Write();
 
-        /// \brief Update the data buffer.
+        /// \brief Update the data buffer. New data is split in chunks of
+        /// whole frames, which are encoded on the compression pool.
         /// \return The size of the data buffer.
         public: unsigned int Update();
 
+        /// \brief Move the encoded chunks to the data buffer, in order.
+        /// \param[in] _wait True to wait for every chunk, false to stop
+        /// at the first chunk that isn't encoded yet.
+        public: void Collect(const bool _wait);
+
+        /// \brief Encode a chunk.
+        /// \param[in] _encoding Encoding of the log, see
+        /// LogRecord::Encoding.
+        /// \param[in] _format Format of the frames, see LogRecord::Format.
+        /// \param[in] _data Log data of the chunk.
+        /// \return The chunk element.
+        public: static std::string EncodeChunk(const std::string &_encoding,
+                    const std::string &_format, const std::string &_data);
+
+        /// \brief Extract the text between the first occurrence of a pair
+        /// of tags in a block of log data.
+        /// \param[in] _data Log data to search.
+        /// \param[in] _startTag Opening tag, such as "<sim_time>".
+        /// \param[in] _endTag Closing tag, such as "</sim_time>".
+        /// \param[out] _value Text between the two tags.
+        /// \param[in] _last True to use the last occurrence instead.
+        /// \return True if both tags were found.
+        public: static bool ChunkValue(const std::string &_data,
+                    const std::string &_startTag, const std::string &_endTag,
+                    std::string &_value, const bool _last = false);
+
         /// \brief Clear the data buffer.
         public: void ClearBuffer();
 
@@ -84,15 +190,28 @@ namespace gazebo
         /// \return The complete filename.
         public: std::string CompleteFilename() const;
 
+        /// \brief Largest log data put in one chunk, unless a single frame
+        /// is larger.
+        public: static const std::size_t kMaxChunkSize = 1024 * 1024;
+
         /// \brief Pointer to the log record parent.
         public: LogRecord *parent;
 
+        /// \brief Pool that encodes the chunks.
+        public: LogCompressPool *pool = nullptr;
+
+        /// \brief Chunks being encoded, in log order.
+        public: std::deque<std::future<std::string>> pending;
+
         /// \brief Callback from which to get data.
         public: std::function<bool (std::ostringstream &)> logCB;
 
         /// \brief Data buffer.
         public: std::string buffer;
 
+        /// \brief Share of the buffer in the memory accounts.
+        public: common::MemoryUsage memory{"util/log_buffers"};
+
         /// \brief The log file.
         public: std::ofstream logFile;
 
@@ -166,6 +285,9 @@ namespace gazebo
       /// \brief Encoding format for each chunk.
       public: std::string encoding;
 
+      /// \brief Format of the state frames, see LogRecord::Format.
+      public: std::string format = "sdf";
+
       /// \brief True if initialized.
       public: bool initialized;
 
@@ -217,6 +339,41 @@ namespace gazebo
 
       /// \brief List of saved files if record with resources is enabled.
       public: std::set<std::string> savedFiles;
+
+      /// \brief Directory of the resource store set by the user, empty
+      /// for the default.
+      public: std::string resourceStorePath;
+
+      /// \brief Directory of the resource store of the current log.
+      public: boost::filesystem::path resourceRoot;
+
+      /// \brief Stores the saved resources, null until the first resource
+      /// is saved.
+      public: std::unique_ptr<ResourceStore> resourceStore;
+
+      /// \brief Protects resourceStore.
+      public: std::mutex resourceMutex;
+
+      /// \brief Compresses the chunks of every log.
+      public: std::unique_ptr<LogCompressPool> compressPool;
+
+      /// \brief Topics recorded into the topic log.
+      public: std::vector<std::string> topics;
+
+      /// \brief The topic log, null if no topic is recorded.
+      public: std::unique_ptr<TopicLogWriter> topicLog;
+
+      /// \brief Path of the topic log.
+      public: boost::filesystem::path topicLogPath;
+
+      /// \brief Subscriptions of the recorded topics.
+      public: std::vector<std::unique_ptr<LogTopicTap>> topicTaps;
+
+      /// \brief Simulation time given to the recorded messages.
+      public: common::Time simTime;
+
+      /// \brief Protects simTime.
+      public: mutable std::mutex simTimeMutex;
     };
     /// \}
   }
@@ -16,12 +16,17 @@
 */
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/common/SystemPaths.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/util/LogPlay.hh"
 #include "gazebo/util/LogRecord.hh"
 #include "test/util.hh"
 
@@ -224,6 +229,157 @@ TEST_F(LogRecord_TEST, RecordResources)
 
   recorder->SetRecordResources(false);
   EXPECT_FALSE(recorder->RecordResources());
+
+  // resources are stored next to the logs by default
+  EXPECT_TRUE(recorder->ResourceStorePath().empty());
+  EXPECT_EQ(recorder->ResourceStats().files, 0u);
+
+  recorder->SetResourceStorePath("/tmp/gazebo_resources");
+  EXPECT_EQ(recorder->ResourceStorePath(), "/tmp/gazebo_resources");
+
+  recorder->SetResourceStorePath("");
+  EXPECT_TRUE(recorder->ResourceStorePath().empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that large updates are split in chunks that play back in
+/// order.
+TEST_F(LogRecord_TEST, Chunks)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  EXPECT_TRUE(recorder->Init("test"));
+
+  // A single update of about 3MB, in frames of 100KB.
+  std::vector<std::string> frames;
+  for (int i = 0; i < 30; ++i)
+  {
+    std::ostringstream frame;
+    frame << "<sdf version='1.6'><state world_name='default'><sim_time>"
+          << i << " 0</sim_time>" << std::string(100000, 'a' + i % 26)
+          << "</state></sdf>";
+    frames.push_back(frame.str());
+  }
+
+  bool logged = false;
+  recorder->Add("chunks", "chunks.log", [&](std::ostringstream &_stream)
+      {
+        if (logged)
+          return false;
+        for (auto const &frame : frames)
+          _stream << frame << "\n";
+        logged = true;
+        return true;
+      });
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_log_chunks_%%%%");
+  EXPECT_TRUE(recorder->Start("zlib_fast", path.string()));
+  EXPECT_EQ(recorder->Encoding(), std::string("zlib_fast"));
+  const std::string filename = recorder->Filename("chunks");
+  recorder->Stop();
+
+  int i = 0;
+  while (!recorder->IsReadyToStart())
+  {
+    gazebo::common::Time::MSleep(100);
+    if ((++i % 50) == 0)
+      gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+  }
+  EXPECT_TRUE(recorder->Remove("chunks"));
+
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+  EXPECT_NO_THROW(player->Open(filename));
+  EXPECT_GT(player->ChunkCount(), 1u);
+  EXPECT_EQ(player->LogEndTime(), gazebo::common::Time(29, 0));
+
+  std::vector<std::string> played;
+  std::string frame;
+  while (player->Step(frame))
+    played.push_back(frame);
+  EXPECT_EQ(frames, played);
+
+  boost::filesystem::remove_all(path);
+}
+
+/////////////////////////////////////////////////
+/// \brief Record state frames in the frames format.
+TEST_F(LogRecord_TEST, Frames)
+{
+  gazebo::util::LogRecord *recorder = gazebo::util::LogRecord::Instance();
+  EXPECT_TRUE(recorder->Init("test"));
+
+  std::vector<std::string> frames;
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::ostringstream frame;
+    frame << "<sdf version='1.6'><state world_name='default'><sim_time>"
+          << i / 1000 << " " << i % 1000 * 1000000 << "</sim_time>"
+          << "<wall_time>100 " << i << "</wall_time><real_time>0 " << i
+          << "</real_time><iterations>" << i << "</iterations>"
+          << "<model name='box'><pose>1.5 2 " << 5 - i * 0.0001
+          << " 0 -0.1 0.7854 </pose><link name='link'><pose>1.5 2 "
+          << 5 - i * 0.0001 << " 0 -0.1 0.7854 </pose><velocity>0 0 -0.098 "
+          << "0 0 0 </velocity></link></model></state></sdf>";
+    frames.push_back(frame.str());
+  }
+
+  bool logged = false;
+  recorder->Add("frames", "frames.log", [&](std::ostringstream &_stream)
+      {
+        if (logged)
+          return false;
+        for (auto const &frame : frames)
+          _stream << frame << "\n";
+        logged = true;
+        return true;
+      });
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_log_frames_%%%%");
+
+  // Record the frames in both formats.
+  std::map<std::string, std::string> filenames;
+  for (auto const &format : {"frames", "sdf"})
+  {
+    gazebo::util::LogRecordParams params;
+    params.format = format;
+    params.path = (path / format).string();
+    logged = false;
+    EXPECT_TRUE(recorder->Start(params));
+    EXPECT_EQ(recorder->Format(), std::string(format));
+    filenames[format] = recorder->Filename("frames");
+    recorder->Stop();
+
+    int i = 0;
+    while (!recorder->IsReadyToStart())
+    {
+      gazebo::common::Time::MSleep(100);
+      if ((++i % 50) == 0)
+        gzdbg << "Waiting for recorder->IsReadyToStart()" << std::endl;
+    }
+  }
+  EXPECT_TRUE(recorder->Remove("frames"));
+
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+  EXPECT_NO_THROW(player->Open(filenames["frames"]));
+  EXPECT_EQ(player->LogEndTime(), gazebo::common::Time(0, 999000000));
+
+  std::vector<std::string> played;
+  std::string frame;
+  while (player->Step(frame))
+    played.push_back(frame);
+  EXPECT_EQ(frames, played);
+
+  // The binary frames are smaller.
+  EXPECT_LT(boost::filesystem::file_size(filenames["frames"]),
+      boost::filesystem::file_size(filenames["sdf"]));
+
+  // Unknown formats are rejected.
+  gazebo::util::LogRecordParams params;
+  params.format = "xml";
+  EXPECT_ANY_THROW(recorder->Start(params));
+
+  boost::filesystem::remove_all(path);
 }
 
 /////////////////////////////////////////////////
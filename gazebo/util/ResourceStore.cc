@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifdef __linux__
+  #include <fcntl.h>
+  #include <linux/fs.h>
+  #include <sys/ioctl.h>
+  #include <unistd.h>
+#endif
+
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/uuid/detail/sha1.hpp>
+
+#include "gazebo/common/CommonIface.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/ThreadConfig.hh"
+#include "gazebo/util/ResourceStore.hh"
+
+using namespace gazebo;
+using namespace util;
+
+namespace fs = boost::filesystem;
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief A queued file or directory.
+    class ResourceTask
+    {
+      /// \brief Source path.
+      public: fs::path source;
+
+      /// \brief Path in the log.
+      public: fs::path destination;
+
+      /// \brief True for a directory.
+      public: bool directory = false;
+    };
+
+    /// \internal
+    /// \brief A cached hash.
+    class ResourceHash
+    {
+      /// \brief Size of the file when it was hashed.
+      public: uintmax_t size = 0;
+
+      /// \brief Modification time of the file when it was hashed.
+      public: std::time_t time = 0;
+
+      /// \brief SHA1 of the content.
+      public: std::string hash;
+    };
+
+    /// \internal
+    /// \brief Private data for ResourceStore.
+    class ResourceStorePrivate
+    {
+      /// \brief Add the queued files until the store is destroyed.
+      public: void Run();
+
+      /// \brief Add the files of a directory.
+      /// \param[in] _source The directory.
+      /// \param[in] _destination The directory in the log.
+      public: void StoreDirectory(const fs::path &_source,
+                  const fs::path &_destination);
+
+      /// \brief Add a file.
+      /// \param[in] _source The file.
+      /// \param[in] _destination The file in the log.
+      public: void StoreFile(const fs::path &_source,
+                  const fs::path &_destination);
+
+      /// \brief Get the hash of a file, from the cache if it didn't
+      /// change.
+      /// \param[in] _source The file.
+      /// \param[out] _size Its size.
+      /// \return The hash, empty on failure.
+      public: std::string Hash(const fs::path &_source, uintmax_t &_size);
+
+      /// \brief Count a failure.
+      public: void Fail();
+
+      /// \brief Directory of the store.
+      public: fs::path root;
+
+      /// \brief Queued files and directories.
+      public: std::deque<ResourceTask> queue;
+
+      /// \brief Number of tasks being done.
+      public: std::size_t busy = 0;
+
+      /// \brief True to stop the thread once the queue is empty.
+      public: bool stop = false;
+
+      /// \brief Hashes, by path.
+      public: std::map<std::string, ResourceHash> hashes;
+
+      /// \brief The counters.
+      public: ResourceStoreStats stats;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+
+      /// \brief Signaled when a task is queued or the store stops.
+      public: std::condition_variable queueCondition;
+
+      /// \brief Signaled when the queue is done.
+      public: std::condition_variable idleCondition;
+
+      /// \brief Thread that adds the files.
+      public: std::thread thread;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Clone a file with a reflink, which shares the blocks of the
+/// source until either is written.
+/// \param[in] _source The file.
+/// \param[in] _destination The clone, which mustn't exist.
+/// \return False if the file system doesn't support it.
+static bool cloneFile(const fs::path &_source, const fs::path &_destination)
+{
+#if defined(__linux__) && defined(FICLONE)
+  const int source = open(_source.c_str(), O_RDONLY);
+  if (source < 0)
+    return false;
+
+  const int destination = open(_destination.c_str(),
+      O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (destination < 0)
+  {
+    close(source);
+    return false;
+  }
+
+  const bool cloned = ioctl(destination, FICLONE, source) == 0;
+  close(source);
+  close(destination);
+  if (!cloned)
+    unlink(_destination.c_str());
+  return cloned;
+#else
+  (void)_source;
+  (void)_destination;
+  return false;
+#endif
+}
+
+/////////////////////////////////////////////////
+ResourceStore::ResourceStore(const std::string &_root)
+  : dataPtr(new ResourceStorePrivate)
+{
+  this->dataPtr->root = _root;
+  this->dataPtr->thread =
+    std::thread(&ResourceStorePrivate::Run, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+ResourceStore::~ResourceStore()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->stop = true;
+  }
+  this->dataPtr->queueCondition.notify_all();
+  this->dataPtr->thread.join();
+}
+
+/////////////////////////////////////////////////
+std::string ResourceStore::Root() const
+{
+  return this->dataPtr->root.string();
+}
+
+/////////////////////////////////////////////////
+void ResourceStore::AddFile(const std::string &_source,
+    const std::string &_destination)
+{
+  ResourceTask task;
+  task.source = _source;
+  task.destination = _destination;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->queue.push_back(task);
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void ResourceStore::AddDirectory(const std::string &_source,
+    const std::string &_destination)
+{
+  ResourceTask task;
+  task.source = _source;
+  task.destination = _destination;
+  task.directory = true;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->queue.push_back(task);
+  }
+  this->dataPtr->queueCondition.notify_one();
+}
+
+/////////////////////////////////////////////////
+void ResourceStore::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->idleCondition.wait(lock, [this]
+      {
+        return this->dataPtr->queue.empty() && this->dataPtr->busy == 0;
+      });
+}
+
+/////////////////////////////////////////////////
+std::size_t ResourceStore::Pending() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->queue.size() + this->dataPtr->busy;
+}
+
+/////////////////////////////////////////////////
+ResourceStoreStats ResourceStore::Stats() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->stats;
+}
+
+/////////////////////////////////////////////////
+std::string ResourceStore::FileHash(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  if (!file)
+    return "";
+
+  boost::uuids::detail::sha1 sha1;
+  std::vector<char> buffer(64 * 1024);
+  while (file)
+  {
+    file.read(buffer.data(), buffer.size());
+    if (file.gcount() > 0)
+      sha1.process_bytes(buffer.data(), file.gcount());
+  }
+  if (file.bad())
+    return "";
+
+  unsigned int hash[5];
+  sha1.get_digest(hash);
+
+  std::stringstream stream;
+  for (std::size_t i = 0; i < sizeof(hash) / sizeof(hash[0]); ++i)
+  {
+    stream << std::setfill('0')
+           << std::setw(sizeof(hash[0]) * 2)
+           << std::hex
+           << hash[i];
+  }
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+void ResourceStorePrivate::Run()
+{
+  common::ThreadConfig::Instance()->Apply("log_record");
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->queueCondition.wait(lock, [this]
+        {
+          return this->stop || !this->queue.empty();
+        });
+    if (this->queue.empty())
+      return;
+
+    ResourceTask task = this->queue.front();
+    this->queue.pop_front();
+    ++this->busy;
+    lock.unlock();
+
+    if (task.directory)
+      this->StoreDirectory(task.source, task.destination);
+    else
+      this->StoreFile(task.source, task.destination);
+
+    lock.lock();
+    --this->busy;
+    if (this->queue.empty() && this->busy == 0)
+      this->idleCondition.notify_all();
+  }
+}
+
+/////////////////////////////////////////////////
+void ResourceStorePrivate::StoreDirectory(const fs::path &_source,
+    const fs::path &_destination)
+{
+  boost::system::error_code error;
+  if (!fs::is_directory(_source, error))
+  {
+    gzwarn << "Source directory " << _source.string()
+           << " does not exist or is not a directory." << std::endl;
+    this->Fail();
+    return;
+  }
+
+  fs::remove_all(_destination, error);
+  fs::create_directories(_destination, error);
+  if (error)
+  {
+    gzwarn << "Unable to create the destination directory "
+           << _destination.string() << ", please check the permission.\n";
+    this->Fail();
+    return;
+  }
+
+  for (fs::directory_iterator file(_source, error);
+       !error && file != fs::directory_iterator(); file.increment(error))
+  {
+    const fs::path current(file->path());
+    if (fs::is_directory(current, error))
+      this->StoreDirectory(current, _destination / current.filename());
+    else
+      this->StoreFile(current, _destination / current.filename());
+  }
+}
+
+/////////////////////////////////////////////////
+void ResourceStorePrivate::StoreFile(const fs::path &_source,
+    const fs::path &_destination)
+{
+  uintmax_t size = 0;
+  const std::string hash = this->Hash(_source, size);
+  if (hash.empty())
+  {
+    gzerr << "Failed to read file '" << _source.string() << "'\n";
+    this->Fail();
+    return;
+  }
+
+  // Store the content once, under its hash. The file is written under a
+  // unique name and renamed, so that stores shared by several processes
+  // never expose a partial file.
+  boost::system::error_code error;
+  const fs::path object =
+    this->root / "objects" / hash.substr(0, 2) / hash.substr(2);
+  const bool stored = !fs::exists(object, error);
+  if (stored)
+  {
+    fs::create_directories(object.parent_path(), error);
+    const fs::path temporary = object.string() + "." +
+      fs::unique_path("%%%%%%%%").string() + ".tmp";
+    if (!cloneFile(_source, temporary))
+      fs::copy_file(_source, temporary, error);
+    if (!error)
+    {
+      fs::permissions(temporary,
+          fs::owner_read | fs::group_read | fs::others_read, error);
+      fs::rename(temporary, object, error);
+    }
+    if (error)
+    {
+      gzerr << "Failed to store file '" << _source.string() << "' in '"
+            << this->root.string() << "': " << error.message() << "\n";
+      fs::remove(temporary, error);
+      this->Fail();
+      return;
+    }
+  }
+
+  // Link the stored file into the log, or clone or copy it if the log is
+  // on another file system.
+  fs::create_directories(_destination.parent_path(), error);
+  fs::remove(_destination, error);
+  fs::create_hard_link(object, _destination, error);
+  bool linked = !error;
+  bool cloned = false;
+  if (!linked)
+  {
+    cloned = cloneFile(object, _destination);
+    if (!cloned)
+    {
+      error.clear();
+      fs::copy_file(object, _destination, error);
+    }
+  }
+  if (error && !cloned)
+  {
+    gzerr << "Failed to copy file from '" << object.string() << "' to '"
+          << _destination.string() << "': " << error.message() << "\n";
+    this->Fail();
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ++this->stats.files;
+  if (stored)
+  {
+    ++this->stats.stored;
+    this->stats.bytesStored += size;
+  }
+  else
+  {
+    ++this->stats.deduplicated;
+    this->stats.bytesDeduplicated += size;
+  }
+
+  if (linked)
+    ++this->stats.linked;
+  else if (cloned)
+    ++this->stats.cloned;
+  else
+    ++this->stats.copied;
+}
+
+/////////////////////////////////////////////////
+std::string ResourceStorePrivate::Hash(const fs::path &_source,
+    uintmax_t &_size)
+{
+  boost::system::error_code error;
+  _size = fs::file_size(_source, error);
+  if (error)
+    return "";
+  const std::time_t time = fs::last_write_time(_source, error);
+  if (error)
+    return "";
+
+  const std::string key = _source.string();
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto iter = this->hashes.find(key);
+    if (iter != this->hashes.end() && iter->second.size == _size &&
+        iter->second.time == time)
+    {
+      return iter->second.hash;
+    }
+  }
+
+  ResourceHash entry;
+  entry.size = _size;
+  entry.time = time;
+  entry.hash = ResourceStore::FileHash(key);
+  if (!entry.hash.empty())
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->hashes[key] = entry;
+  }
+  return entry.hash;
+}
+
+/////////////////////////////////////////////////
+void ResourceStorePrivate::Fail()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  ++this->stats.failed;
+}
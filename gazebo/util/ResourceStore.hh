@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_RESOURCESTORE_HH_
+#define GAZEBO_UTIL_RESOURCESTORE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data class
+    class ResourceStorePrivate;
+
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \brief Counters of a resource store.
+    class GZ_UTIL_VISIBLE ResourceStoreStats
+    {
+      /// \brief Number of files added.
+      public: uint64_t files = 0;
+
+      /// \brief Number of files whose content wasn't in the store yet.
+      public: uint64_t stored = 0;
+
+      /// \brief Number of files whose content was already in the store.
+      public: uint64_t deduplicated = 0;
+
+      /// \brief Number of files hard linked from the store.
+      public: uint64_t linked = 0;
+
+      /// \brief Number of files cloned from the store with a reflink.
+      public: uint64_t cloned = 0;
+
+      /// \brief Number of files copied from the store, because it is on
+      /// another file system.
+      public: uint64_t copied = 0;
+
+      /// \brief Number of files that couldn't be added.
+      public: uint64_t failed = 0;
+
+      /// \brief Bytes written to the store.
+      public: uint64_t bytesStored = 0;
+
+      /// \brief Bytes of the files that were already in the store.
+      public: uint64_t bytesDeduplicated = 0;
+    };
+
+    /// \class ResourceStore ResourceStore.hh util/util.hh
+    /// \brief Content addressed store of the resources saved with logs.
+    ///
+    /// Each file is stored once, under the SHA1 of its content, in the
+    /// objects directory of the store. The file of a log is then a hard
+    /// link to the stored file, or a reflink or a copy of it if the log
+    /// is on another file system. Stored files are read only, as the logs
+    /// share them.
+    ///
+    /// Files are added on a thread of the store, in order, so that adding
+    /// the resources of a world never blocks the start of its log. The
+    /// hashes are cached by path, size and modification time, so that
+    /// adding the same resources to the next log only links them.
+    class GZ_UTIL_VISIBLE ResourceStore
+    {
+      /// \brief Constructor
+      /// \param[in] _root Directory of the store, created when the first
+      /// file is added. Stores of several processes can share it.
+      public: explicit ResourceStore(const std::string &_root);
+
+      /// \brief Destructor. Adds the queued files first.
+      public: virtual ~ResourceStore();
+
+      /// \brief Get the directory of the store.
+      /// \return The directory.
+      public: std::string Root() const;
+
+      /// \brief Queue a file.
+      /// \param[in] _source Path of the file.
+      /// \param[in] _destination Path of the file in the log. Its
+      /// directories are created.
+      public: void AddFile(const std::string &_source,
+                  const std::string &_destination);
+
+      /// \brief Queue all the files of a directory, recursively. Like
+      /// common::copyDir, it replaces an existing destination.
+      /// \param[in] _source Path of the directory.
+      /// \param[in] _destination Path of the directory in the log.
+      public: void AddDirectory(const std::string &_source,
+                  const std::string &_destination);
+
+      /// \brief Wait until the queued files are added.
+      public: void Wait();
+
+      /// \brief Get the number of queued files and directories.
+      /// \return Number of additions not done yet.
+      public: std::size_t Pending() const;
+
+      /// \brief Get the counters.
+      /// \return The counters.
+      public: ResourceStoreStats Stats() const;
+
+      /// \brief Compute the SHA1 of the content of a file.
+      /// \param[in] _path Path of the file.
+      /// \return The 40 character hash, empty if the file can't be read.
+      public: static std::string FileHash(const std::string &_path);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ResourceStorePrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+
+#include "gazebo/util/ResourceStore.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class ResourceStore_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _content Content of the file.
+static void writeFile(const boost::filesystem::path &_path,
+    const std::string &_content)
+{
+  boost::filesystem::create_directories(_path.parent_path());
+  std::ofstream file(_path.string(), std::ios::binary);
+  file << _content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a file.
+/// \param[in] _path Path of the file.
+/// \return Content of the file.
+static std::string readFile(const boost::filesystem::path &_path)
+{
+  std::ifstream file(_path.string(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+}
+
+/////////////////////////////////////////////////
+TEST_F(ResourceStore_TEST, FileHash)
+{
+  boost::filesystem::path dir =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("%%%%-%%%%");
+
+  writeFile(dir / "abc", "abc");
+  EXPECT_EQ(util::ResourceStore::FileHash((dir / "abc").string()),
+      "a9993e364706816aba3e25717850c26c9cd0d89d");
+  EXPECT_TRUE(util::ResourceStore::FileHash((dir / "none").string()).empty());
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+TEST_F(ResourceStore_TEST, Deduplicate)
+{
+  boost::filesystem::path dir =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("%%%%-%%%%");
+
+  // A model with two meshes of the same content
+  writeFile(dir / "models/box/model.config", "<model/>");
+  writeFile(dir / "models/box/meshes/a.dae", "mesh");
+  writeFile(dir / "models/box/meshes/b.dae", "mesh");
+  writeFile(dir / "media/box.material", "material");
+
+  util::ResourceStore store((dir / "store").string());
+  EXPECT_EQ(store.Root(), (dir / "store").string());
+
+  // Save the resources into two logs
+  for (const std::string log : {"log1", "log2"})
+  {
+    store.AddDirectory((dir / "models/box").string(),
+        (dir / log / "box").string());
+    store.AddFile((dir / "media/box.material").string(),
+        (dir / log / "media/box.material").string());
+  }
+  store.Wait();
+  EXPECT_EQ(store.Pending(), 0u);
+
+  for (const std::string log : {"log1", "log2"})
+  {
+    EXPECT_EQ(readFile(dir / log / "box/model.config"), "<model/>");
+    EXPECT_EQ(readFile(dir / log / "box/meshes/a.dae"), "mesh");
+    EXPECT_EQ(readFile(dir / log / "box/meshes/b.dae"), "mesh");
+    EXPECT_EQ(readFile(dir / log / "media/box.material"), "material");
+  }
+
+  // Three distinct contents are stored, and the other five files are
+  // links to them
+  util::ResourceStoreStats stats = store.Stats();
+  EXPECT_EQ(stats.files, 8u);
+  EXPECT_EQ(stats.stored, 3u);
+  EXPECT_EQ(stats.deduplicated, 5u);
+  EXPECT_EQ(stats.failed, 0u);
+  EXPECT_EQ(stats.bytesStored, 20u);
+  EXPECT_EQ(stats.linked + stats.cloned + stats.copied, 8u);
+
+  // The logs are on the file system of the store, so they're hard links
+  EXPECT_EQ(stats.linked, 8u);
+  EXPECT_EQ(boost::filesystem::hard_link_count(
+        dir / "log2/box/meshes/b.dae"), 5u);
+
+  // A missing source fails without stopping the store
+  store.AddFile((dir / "none").string(), (dir / "log3/none").string());
+  store.Wait();
+  EXPECT_EQ(store.Stats().failed, 1u);
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
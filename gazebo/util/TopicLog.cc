@@ -0,0 +1,753 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/transport/Compression.hh"
+#include "gazebo/util/TopicLog.hh"
+
+using namespace gazebo;
+using namespace util;
+
+/// \brief Start of a topic log.
+static const char kFileMagic[] = "GZTLOG01";
+
+/// \brief End of a complete topic log, after the offset of the index.
+static const char kEndMagic[] = "GZTLEND1";
+
+/// \brief Start of a chunk.
+static const char kChunkMagic[] = "CHNK";
+
+/// \brief Start of the index.
+static const char kIndexMagic[] = "TIDX";
+
+/// \brief Size of a chunk header: the magic, the codec, the number of
+/// messages, a reserved word, the stored and raw sizes, and the times of
+/// the first and last messages.
+static const std::size_t kChunkHeaderSize = 48;
+
+/// \brief Size of a message header: the time, the topic id and the size.
+static const std::size_t kRecordHeaderSize = 16;
+
+/// \brief Size of the footer: the offset of the index and the end magic.
+static const std::size_t kFooterSize = 16;
+
+/// \brief Codecs of the chunks.
+static const uint32_t kCodecNone = 0;
+static const uint32_t kCodecZlib = 1;
+
+/////////////////////////////////////////////////
+/// \brief Append a number to a buffer.
+/// \param[in,out] _buffer The buffer.
+/// \param[in] _value The number.
+template<typename T>
+static void append(std::string &_buffer, const T _value)
+{
+  _buffer.append(reinterpret_cast<const char *>(&_value), sizeof(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Append a string, with its size, to a buffer.
+/// \param[in,out] _buffer The buffer.
+/// \param[in] _value The string.
+static void appendString(std::string &_buffer, const std::string &_value)
+{
+  append(_buffer, static_cast<uint32_t>(_value.size()));
+  _buffer.append(_value);
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a number from a buffer.
+/// \param[in,out] _data Position in the buffer, moved past the number.
+/// \param[in] _end End of the buffer.
+/// \param[out] _value The number.
+/// \return False if the buffer is too short.
+template<typename T>
+static bool read(const char *&_data, const char *_end, T &_value)
+{
+  if (_end - _data < static_cast<std::ptrdiff_t>(sizeof(_value)))
+    return false;
+  std::memcpy(&_value, _data, sizeof(_value));
+  _data += sizeof(_value);
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a string, with its size, from a buffer.
+/// \param[in,out] _data Position in the buffer, moved past the string.
+/// \param[in] _end End of the buffer.
+/// \param[out] _value The string.
+/// \return False if the buffer is too short.
+static bool readString(const char *&_data, const char *_end,
+    std::string &_value)
+{
+  uint32_t size;
+  if (!read(_data, _end, size) || _end - _data < size)
+    return false;
+  _value.assign(_data, size);
+  _data += size;
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a time to nanoseconds.
+/// \param[in] _time The time.
+/// \return Nanoseconds.
+static int64_t toNsec(const common::Time &_time)
+{
+  return static_cast<int64_t>(_time.sec) * 1000000000 + _time.nsec;
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert nanoseconds to a time.
+/// \param[in] _nsec Nanoseconds.
+/// \return The time.
+static common::Time fromNsec(const int64_t _nsec)
+{
+  return common::Time(static_cast<int32_t>(_nsec / 1000000000),
+                      static_cast<int32_t>(_nsec % 1000000000));
+}
+
+namespace gazebo
+{
+  namespace util
+  {
+    /// \internal
+    /// \brief Location and time range of a chunk.
+    class TopicLogChunk
+    {
+      /// \brief Offset of the chunk header in the file.
+      public: uint64_t offset = 0;
+
+      /// \brief Time of the first message, in nanoseconds.
+      public: int64_t first = 0;
+
+      /// \brief Time of the last message, in nanoseconds.
+      public: int64_t last = 0;
+
+      /// \brief Number of messages.
+      public: uint32_t count = 0;
+    };
+
+    /// \internal
+    /// \brief Private data for TopicLogWriter.
+    class TopicLogWriterPrivate
+    {
+      /// \brief Runs the encoding of the chunks.
+      public: TopicLogWriter::PostFunction post;
+
+      /// \brief The log file.
+      public: std::ofstream file;
+
+      /// \brief True to compress the chunks.
+      public: bool compress = false;
+
+      /// \brief Ids of the topics.
+      public: std::map<std::string, uint32_t> topicIds;
+
+      /// \brief Names and types of the topics, by id.
+      public: std::vector<std::pair<std::string, std::string>> topics;
+
+      /// \brief Messages of the chunk being filled.
+      public: std::string chunk;
+
+      /// \brief Range and message count of the chunk being filled.
+      public: TopicLogChunk chunkInfo;
+
+      /// \brief Chunks being encoded, in log order.
+      public: std::deque<std::pair<TopicLogChunk,
+                  std::future<std::string> > > pending;
+
+      /// \brief Chunks written to the file.
+      public: std::vector<TopicLogChunk> chunks;
+
+      /// \brief Bytes written to the file.
+      public: std::size_t fileSize = 0;
+
+      /// \brief Number of messages added.
+      public: std::size_t records = 0;
+
+      /// \brief Protects the members.
+      public: mutable std::mutex mutex;
+
+      /// \brief Queue the chunk being filled for encoding. The mutex must
+      /// be held.
+      public: void Seal();
+
+      /// \brief Write the encoded chunks. The mutex must be held.
+      /// \param[in] _wait True to wait for the chunks being encoded.
+      public: void WriteChunks(const bool _wait);
+    };
+
+    /// \internal
+    /// \brief Private data for TopicLogReader.
+    class TopicLogReaderPrivate
+    {
+      /// \brief Destructor, unmaps the file.
+      public: ~TopicLogReaderPrivate();
+
+      /// \brief Unmap the file and forget the index.
+      public: void Reset();
+
+      /// \brief Decode a chunk into the chunk buffer.
+      /// \param[in] _index Index of the chunk.
+      /// \return False if the chunk is corrupted.
+      public: bool LoadChunk(const std::size_t _index);
+
+      /// \brief Start of the file data.
+      public: const char *data = nullptr;
+
+      /// \brief Size of the file.
+      public: std::size_t size = 0;
+
+      /// \brief True if the data is mapped, false if it was read.
+      public: bool mapped = false;
+
+      /// \brief Data of the file when it can't be mapped.
+      public: std::string contents;
+
+      /// \brief Names and types of the topics, by id.
+      public: std::vector<std::pair<std::string, std::string>> topics;
+
+      /// \brief The chunks, in log order.
+      public: std::vector<TopicLogChunk> chunks;
+
+      /// \brief Index of the current chunk, chunks.size() at the end.
+      public: std::size_t chunkIndex = 0;
+
+      /// \brief Index of the chunk in the chunk buffer.
+      public: std::size_t loadedChunk = static_cast<std::size_t>(-1);
+
+      /// \brief Decoded messages of the current chunk.
+      public: std::string chunk;
+
+      /// \brief Offset of the next message in the chunk buffer.
+      public: std::size_t chunkOffset = 0;
+    };
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicLogWriterPrivate::Seal()
+{
+  if (this->chunkInfo.count == 0)
+    return;
+
+  const TopicLogChunk info = this->chunkInfo;
+  const bool zlib = this->compress;
+  auto raw = std::make_shared<std::string>();
+  raw->swap(this->chunk);
+  this->chunkInfo = TopicLogChunk();
+
+  std::function<std::string ()> encode = [info, zlib, raw]()
+  {
+    std::string stored;
+    uint32_t codec = kCodecNone;
+    if (zlib && transport::Compression::Compress(*raw, stored))
+      codec = kCodecZlib;
+    else
+      stored.swap(*raw);
+
+    std::string result;
+    result.reserve(kChunkHeaderSize + stored.size());
+    result.append(kChunkMagic, 4);
+    append(result, codec);
+    append(result, info.count);
+    append(result, static_cast<uint32_t>(0));
+    append(result, static_cast<uint64_t>(stored.size()));
+    append(result, static_cast<uint64_t>(
+          codec == kCodecNone ? stored.size() : 0));
+    append(result, info.first);
+    append(result, info.last);
+    result.append(stored);
+    return result;
+  };
+
+  if (this->post)
+    this->pending.push_back(std::make_pair(info, this->post(encode)));
+  else
+  {
+    std::promise<std::string> promise;
+    promise.set_value(encode());
+    this->pending.push_back(std::make_pair(info, promise.get_future()));
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicLogWriterPrivate::WriteChunks(const bool _wait)
+{
+  while (!this->pending.empty())
+  {
+    auto &front = this->pending.front();
+    if (!_wait && front.second.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+    {
+      break;
+    }
+
+    std::string encoded = front.second.get();
+    TopicLogChunk info = front.first;
+    info.offset = this->fileSize;
+    this->file.write(encoded.data(), encoded.size());
+    this->fileSize += encoded.size();
+    this->chunks.push_back(info);
+    this->pending.pop_front();
+  }
+}
+
+/////////////////////////////////////////////////
+TopicLogWriter::TopicLogWriter(const PostFunction &_post)
+  : dataPtr(new TopicLogWriterPrivate)
+{
+  this->dataPtr->post = _post;
+}
+
+/////////////////////////////////////////////////
+TopicLogWriter::~TopicLogWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::Open(const std::string &_filename, const bool _compress)
+{
+  this->Close();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->file.open(_filename.c_str(),
+      std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!this->dataPtr->file.is_open())
+  {
+    gzerr << "Unable to create topic log[" << _filename << "]\n";
+    return false;
+  }
+
+  this->dataPtr->compress = _compress;
+  this->dataPtr->topicIds.clear();
+  this->dataPtr->topics.clear();
+  this->dataPtr->chunk.clear();
+  this->dataPtr->chunkInfo = TopicLogChunk();
+  this->dataPtr->chunks.clear();
+  this->dataPtr->records = 0;
+
+  this->dataPtr->file.write(kFileMagic, 8);
+  this->dataPtr->fileSize = 8;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void TopicLogWriter::Add(const std::string &_topic,
+    const std::string &_msgType, const common::Time &_time,
+    const std::string &_data)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open())
+    return;
+
+  auto id = this->dataPtr->topicIds.insert(std::make_pair(_topic,
+      static_cast<uint32_t>(this->dataPtr->topics.size())));
+  if (id.second)
+    this->dataPtr->topics.push_back(std::make_pair(_topic, _msgType));
+
+  const int64_t nsec = toNsec(_time);
+  TopicLogChunk &info = this->dataPtr->chunkInfo;
+  if (info.count == 0)
+    info.first = info.last = nsec;
+  info.first = std::min(info.first, nsec);
+  info.last = std::max(info.last, nsec);
+  ++info.count;
+
+  std::string &chunk = this->dataPtr->chunk;
+  append(chunk, nsec);
+  append(chunk, id.first->second);
+  append(chunk, static_cast<uint32_t>(_data.size()));
+  chunk.append(_data);
+  ++this->dataPtr->records;
+
+  if (chunk.size() >= kChunkSize)
+    this->dataPtr->Seal();
+}
+
+/////////////////////////////////////////////////
+void TopicLogWriter::Write(const bool _wait)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (this->dataPtr->file.is_open())
+  {
+    this->dataPtr->WriteChunks(_wait);
+    this->dataPtr->file.flush();
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicLogWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file.is_open())
+    return;
+
+  this->dataPtr->Seal();
+  this->dataPtr->WriteChunks(true);
+
+  const uint64_t indexOffset = this->dataPtr->fileSize;
+  std::string index(kIndexMagic, 4);
+  append(index, static_cast<uint32_t>(this->dataPtr->topics.size()));
+  for (auto const &topic : this->dataPtr->topics)
+  {
+    appendString(index, topic.first);
+    appendString(index, topic.second);
+  }
+  append(index, static_cast<uint32_t>(this->dataPtr->chunks.size()));
+  for (auto const &chunk : this->dataPtr->chunks)
+  {
+    append(index, chunk.offset);
+    append(index, chunk.first);
+    append(index, chunk.last);
+    append(index, chunk.count);
+  }
+  append(index, indexOffset);
+  index.append(kEndMagic, 8);
+
+  this->dataPtr->file.write(index.data(), index.size());
+  this->dataPtr->fileSize += index.size();
+  this->dataPtr->file.close();
+}
+
+/////////////////////////////////////////////////
+bool TopicLogWriter::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->file.is_open();
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogWriter::FileSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->fileSize;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogWriter::RecordCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->records;
+}
+
+/////////////////////////////////////////////////
+TopicLogReaderPrivate::~TopicLogReaderPrivate()
+{
+  this->Reset();
+}
+
+/////////////////////////////////////////////////
+void TopicLogReaderPrivate::Reset()
+{
+#ifndef _WIN32
+  if (this->mapped)
+    munmap(const_cast<char *>(this->data), this->size);
+#endif
+  this->mapped = false;
+  this->data = nullptr;
+  this->size = 0;
+  this->contents.clear();
+  this->topics.clear();
+  this->chunks.clear();
+  this->chunkIndex = 0;
+  this->loadedChunk = static_cast<std::size_t>(-1);
+  this->chunk.clear();
+  this->chunkOffset = 0;
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReaderPrivate::LoadChunk(const std::size_t _index)
+{
+  if (this->loadedChunk == _index)
+    return true;
+
+  const uint64_t offset = this->chunks[_index].offset;
+  const char *pos = this->data + offset;
+  const char *end = this->data + this->size;
+  uint32_t codec, count, reserved;
+  uint64_t storedSize, rawSize;
+  int64_t first, last;
+  if (offset + kChunkHeaderSize > this->size ||
+      std::memcmp(pos, kChunkMagic, 4) != 0)
+  {
+    return false;
+  }
+  pos += 4;
+  if (!read(pos, end, codec) || !read(pos, end, count) ||
+      !read(pos, end, reserved) || !read(pos, end, storedSize) ||
+      !read(pos, end, rawSize) || !read(pos, end, first) ||
+      !read(pos, end, last) ||
+      storedSize > static_cast<uint64_t>(end - pos))
+  {
+    return false;
+  }
+
+  if (codec == kCodecNone)
+    this->chunk.assign(pos, storedSize);
+  else if (codec != kCodecZlib || !transport::Compression::Decompress(
+        std::string(pos, storedSize), this->chunk))
+  {
+    return false;
+  }
+
+  this->loadedChunk = _index;
+  this->chunkOffset = 0;
+  return true;
+}
+
+/////////////////////////////////////////////////
+TopicLogReader::TopicLogReader()
+  : dataPtr(new TopicLogReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+TopicLogReader::~TopicLogReader()
+{
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReader::Open(const std::string &_filename)
+{
+  this->dataPtr->Reset();
+
+#ifndef _WIN32
+  int fd = open(_filename.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED)
+    {
+      this->dataPtr->data = static_cast<const char *>(map);
+      this->dataPtr->size = st.st_size;
+      this->dataPtr->mapped = true;
+    }
+  }
+  if (fd >= 0)
+    close(fd);
+#endif
+
+  if (!this->dataPtr->mapped)
+  {
+    std::ifstream file(_filename.c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open())
+    {
+      gzerr << "Unable to open topic log[" << _filename << "]\n";
+      return false;
+    }
+    this->dataPtr->contents.assign(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+    this->dataPtr->data = this->dataPtr->contents.data();
+    this->dataPtr->size = this->dataPtr->contents.size();
+  }
+
+  const char *data = this->dataPtr->data;
+  const std::size_t size = this->dataPtr->size;
+  uint64_t indexOffset = 0;
+  if (size < 8 + kFooterSize || std::memcmp(data, kFileMagic, 8) != 0 ||
+      std::memcmp(data + size - 8, kEndMagic, 8) != 0)
+  {
+    gzerr << "Topic log[" << _filename << "] is incomplete or invalid\n";
+    this->dataPtr->Reset();
+    return false;
+  }
+  std::memcpy(&indexOffset, data + size - kFooterSize, sizeof(indexOffset));
+
+  const char *pos = data + indexOffset;
+  const char *end = data + size - kFooterSize;
+  uint32_t topicCount = 0, chunkCount = 0;
+  bool valid = indexOffset < size - kFooterSize &&
+      std::memcmp(pos, kIndexMagic, 4) == 0;
+  if (valid)
+  {
+    pos += 4;
+    valid = read(pos, end, topicCount);
+  }
+  for (uint32_t i = 0; valid && i < topicCount; ++i)
+  {
+    std::pair<std::string, std::string> topic;
+    valid = readString(pos, end, topic.first) &&
+        readString(pos, end, topic.second);
+    this->dataPtr->topics.push_back(topic);
+  }
+  valid = valid && read(pos, end, chunkCount);
+  for (uint32_t i = 0; valid && i < chunkCount; ++i)
+  {
+    TopicLogChunk chunk;
+    valid = read(pos, end, chunk.offset) && read(pos, end, chunk.first) &&
+        read(pos, end, chunk.last) && read(pos, end, chunk.count) &&
+        chunk.offset < indexOffset;
+    this->dataPtr->chunks.push_back(chunk);
+  }
+
+  if (!valid)
+  {
+    gzerr << "Topic log[" << _filename << "] has an invalid index\n";
+    this->dataPtr->Reset();
+    return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicLogReader::Topics() const
+{
+  std::vector<std::string> topics;
+  for (auto const &topic : this->dataPtr->topics)
+    topics.push_back(topic.first);
+  return topics;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogReader::RecordCount() const
+{
+  std::size_t count = 0;
+  for (auto const &chunk : this->dataPtr->chunks)
+    count += chunk.count;
+  return count;
+}
+
+/////////////////////////////////////////////////
+std::size_t TopicLogReader::ChunkCount() const
+{
+  return this->dataPtr->chunks.size();
+}
+
+/////////////////////////////////////////////////
+common::Time TopicLogReader::StartTime() const
+{
+  if (this->dataPtr->chunks.empty())
+    return common::Time();
+
+  int64_t first = this->dataPtr->chunks.front().first;
+  for (auto const &chunk : this->dataPtr->chunks)
+    first = std::min(first, chunk.first);
+  return fromNsec(first);
+}
+
+/////////////////////////////////////////////////
+common::Time TopicLogReader::EndTime() const
+{
+  if (this->dataPtr->chunks.empty())
+    return common::Time();
+
+  int64_t last = this->dataPtr->chunks.front().last;
+  for (auto const &chunk : this->dataPtr->chunks)
+    last = std::max(last, chunk.last);
+  return fromNsec(last);
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReader::Seek(const common::Time &_time)
+{
+  const int64_t nsec = toNsec(_time);
+  auto &chunks = this->dataPtr->chunks;
+
+  // Messages are added in time order, so the chunks are sorted by time
+  auto chunk = std::lower_bound(chunks.begin(), chunks.end(), nsec,
+      [](const TopicLogChunk &_chunk, const int64_t _nsec)
+      {
+        return _chunk.last < _nsec;
+      });
+
+  this->dataPtr->chunkIndex = chunk - chunks.begin();
+  if (chunk == chunks.end() ||
+      !this->dataPtr->LoadChunk(this->dataPtr->chunkIndex))
+  {
+    return false;
+  }
+
+  // Skip the messages of the chunk that are older than _time
+  this->dataPtr->chunkOffset = 0;
+  const std::string &data = this->dataPtr->chunk;
+  while (this->dataPtr->chunkOffset + kRecordHeaderSize <= data.size())
+  {
+    int64_t time;
+    uint32_t size;
+    std::memcpy(&time, data.data() + this->dataPtr->chunkOffset,
+        sizeof(time));
+    if (time >= nsec)
+      break;
+    std::memcpy(&size, data.data() + this->dataPtr->chunkOffset + 12,
+        sizeof(size));
+    this->dataPtr->chunkOffset += kRecordHeaderSize + size;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TopicLogReader::Next(TopicLogRecord &_record)
+{
+  while (this->dataPtr->chunkIndex < this->dataPtr->chunks.size())
+  {
+    if (!this->dataPtr->LoadChunk(this->dataPtr->chunkIndex))
+    {
+      gzerr << "Topic log chunk[" << this->dataPtr->chunkIndex
+            << "] is corrupted\n";
+      return false;
+    }
+
+    const std::string &data = this->dataPtr->chunk;
+    if (this->dataPtr->chunkOffset >= data.size())
+    {
+      ++this->dataPtr->chunkIndex;
+      this->dataPtr->chunkOffset = 0;
+      continue;
+    }
+
+    const char *pos = data.data() + this->dataPtr->chunkOffset;
+    const char *end = data.data() + data.size();
+    int64_t time;
+    uint32_t id, size;
+    if (!read(pos, end, time) || !read(pos, end, id) ||
+        !read(pos, end, size) || size > end - pos ||
+        id >= this->dataPtr->topics.size())
+    {
+      gzerr << "Topic log chunk[" << this->dataPtr->chunkIndex
+            << "] is corrupted\n";
+      return false;
+    }
+
+    _record.time = fromNsec(time);
+    _record.topic = this->dataPtr->topics[id].first;
+    _record.msgType = this->dataPtr->topics[id].second;
+    _record.data.assign(pos, size);
+    this->dataPtr->chunkOffset += kRecordHeaderSize + size;
+    return true;
+  }
+  return false;
+}
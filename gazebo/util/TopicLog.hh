@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_UTIL_TOPICLOG_HH_
+#define GAZEBO_UTIL_TOPICLOG_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace util
+  {
+    // Forward declare private data classes
+    class TopicLogReaderPrivate;
+    class TopicLogWriterPrivate;
+
+    /// addtogroup gazebo_util
+    /// \{
+
+    /// \brief A message read from a topic log.
+    class GZ_UTIL_VISIBLE TopicLogRecord
+    {
+      /// \brief Simulation time at which the message was recorded, the
+      /// time of the state log.
+      public: common::Time time;
+
+      /// \brief Topic of the message.
+      public: std::string topic;
+
+      /// \brief Type of the message, such as "gazebo.msgs.ImageStamped".
+      public: std::string msgType;
+
+      /// \brief The serialized message.
+      public: std::string data;
+    };
+
+    /// \class TopicLogWriter TopicLog.hh util/util.hh
+    /// \brief Writes serialized messages into a topic log.
+    ///
+    /// A topic log is a binary container for recorded messages. The
+    /// messages are appended, with their simulation time and topic, to
+    /// chunks of about kChunkSize bytes. Full chunks are encoded by the
+    /// function given to the constructor, which can run them in parallel,
+    /// and are written in order. Closing the log appends an index of the
+    /// topics and of the time range and offset of every chunk, so that a
+    /// reader can seek to a time without reading the chunks before it.
+    /// Numbers are stored in the byte order of the host.
+    class GZ_UTIL_VISIBLE TopicLogWriter
+    {
+      /// \brief Function that runs an encoding task, possibly on another
+      /// thread, and returns its future.
+      public: using PostFunction = std::function<std::future<std::string> (
+                  const std::function<std::string ()> &)>;
+
+      /// \brief Constructor
+      /// \param[in] _post Function that runs the encoding of the chunks.
+      /// The chunks are encoded on the calling thread if it's empty.
+      public: explicit TopicLogWriter(const PostFunction &_post = nullptr);
+
+      /// \brief Destructor. Closes the log.
+      public: virtual ~TopicLogWriter();
+
+      /// \brief Create the log file.
+      /// \param[in] _filename Path of the file.
+      /// \param[in] _compress True to compress the chunks with zlib.
+      /// \return False if the file can't be created.
+      public: bool Open(const std::string &_filename, const bool _compress);
+
+      /// \brief Append a message. This is safe to call from any thread.
+      /// \param[in] _topic Topic of the message.
+      /// \param[in] _msgType Type of the message.
+      /// \param[in] _time Simulation time of the message.
+      /// \param[in] _data The serialized message.
+      public: void Add(const std::string &_topic, const std::string &_msgType,
+                       const common::Time &_time, const std::string &_data);
+
+      /// \brief Write the encoded chunks to the file, in order.
+      /// \param[in] _wait True to wait for the chunks being encoded, false
+      /// to stop at the first chunk that isn't encoded yet.
+      public: void Write(const bool _wait = false);
+
+      /// \brief Encode the last chunk, write all the chunks and the index,
+      /// and close the file. Does nothing if the log isn't open.
+      public: void Close();
+
+      /// \brief Get whether the log is open.
+      /// \return True between Open and Close.
+      public: bool IsOpen() const;
+
+      /// \brief Get the number of bytes written to the file.
+      /// \return Size of the file.
+      public: std::size_t FileSize() const;
+
+      /// \brief Get the number of messages added.
+      /// \return Number of messages.
+      public: std::size_t RecordCount() const;
+
+      /// \brief Raw size of a chunk at which it's encoded.
+      public: static const std::size_t kChunkSize = 4 * 1024 * 1024;
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TopicLogWriterPrivate> dataPtr;
+    };
+
+    /// \class TopicLogReader TopicLog.hh util/util.hh
+    /// \brief Reads a topic log written by TopicLogWriter.
+    ///
+    /// The file is memory mapped, so that opening it only reads the
+    /// index, and a chunk is only read and decoded when a message in it
+    /// is read. Seek uses the time range of the chunks to start reading
+    /// at the simulation time of a state log frame.
+    class GZ_UTIL_VISIBLE TopicLogReader
+    {
+      /// \brief Constructor
+      public: TopicLogReader();
+
+      /// \brief Destructor
+      public: virtual ~TopicLogReader();
+
+      /// \brief Open a topic log.
+      /// \param[in] _filename Path of the file.
+      /// \return False if the file can't be read or isn't a complete
+      /// topic log.
+      public: bool Open(const std::string &_filename);
+
+      /// \brief Get the recorded topics.
+      /// \return Names of the topics.
+      public: std::vector<std::string> Topics() const;
+
+      /// \brief Get the number of recorded messages.
+      /// \return Number of messages.
+      public: std::size_t RecordCount() const;
+
+      /// \brief Get the number of chunks.
+      /// \return Number of chunks.
+      public: std::size_t ChunkCount() const;
+
+      /// \brief Get the time of the first message.
+      /// \return Simulation time.
+      public: common::Time StartTime() const;
+
+      /// \brief Get the time of the last message.
+      /// \return Simulation time.
+      public: common::Time EndTime() const;
+
+      /// \brief Move to the first message recorded at or after a time.
+      /// \param[in] _time Simulation time.
+      /// \return False if no message was recorded at or after _time.
+      public: bool Seek(const common::Time &_time);
+
+      /// \brief Read the next message.
+      /// \param[out] _record The message.
+      /// \return False at the end of the log, or if a chunk is corrupted.
+      public: bool Next(TopicLogRecord &_record);
+
+      /// \internal
+      /// \brief Private data pointer.
+      private: std::unique_ptr<TopicLogReaderPrivate> dataPtr;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <future>
+#include <string>
+
+#include "gazebo/common/Time.hh"
+#include "gazebo/util/TopicLog.hh"
+#include "test/util.hh"
+
+using namespace gazebo;
+
+class TopicLog_TEST : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Write enough messages to fill several chunks.
+/// \param[in] _writer Open topic log.
+/// \param[in] _count Number of messages per topic.
+void writeMessages(util::TopicLogWriter &_writer, const int _count)
+{
+  // Messages of 1 MiB, so that a chunk holds about 4 of them
+  for (int i = 0; i < _count; ++i)
+  {
+    common::Time time(i / 10, (i % 10) * 100000000);
+    _writer.Add("/gazebo/default/camera", "gazebo.msgs.ImageStamped", time,
+        std::string(1024 * 1024, static_cast<char>('a' + i % 26)));
+    _writer.Add("/gazebo/default/imu", "gazebo.msgs.IMU", time,
+        std::to_string(i));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that messages are read back in order, with their topics.
+void checkLog(const std::string &_filename, const int _count)
+{
+  util::TopicLogReader reader;
+  ASSERT_TRUE(reader.Open(_filename));
+  EXPECT_EQ(reader.RecordCount(), static_cast<std::size_t>(_count * 2));
+  EXPECT_GT(reader.ChunkCount(), 1u);
+  ASSERT_EQ(reader.Topics().size(), 2u);
+  EXPECT_EQ(reader.Topics()[0], "/gazebo/default/camera");
+  EXPECT_EQ(reader.StartTime(), common::Time(0, 0));
+  EXPECT_EQ(reader.EndTime(), common::Time((_count - 1) / 10,
+        ((_count - 1) % 10) * 100000000));
+
+  util::TopicLogRecord record;
+  int read = 0;
+  while (reader.Next(record))
+  {
+    if (record.topic == "/gazebo/default/imu")
+    {
+      EXPECT_EQ(record.msgType, "gazebo.msgs.IMU");
+      EXPECT_EQ(record.data, std::to_string(read / 2));
+    }
+    else
+    {
+      EXPECT_EQ(record.msgType, "gazebo.msgs.ImageStamped");
+      EXPECT_EQ(record.data.size(), 1024u * 1024u);
+    }
+    ++read;
+  }
+  EXPECT_EQ(read, _count * 2);
+
+  // Seek to the middle of the log, past the first chunk
+  EXPECT_TRUE(reader.Seek(common::Time(1, 500000000)));
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(record.time, common::Time(1, 500000000));
+  EXPECT_EQ(record.topic, "/gazebo/default/camera");
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(record.data, "15");
+
+  // Nothing was recorded after the end
+  EXPECT_FALSE(reader.Seek(common::Time(100, 0)));
+  EXPECT_FALSE(reader.Next(record));
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicLog_TEST, WriteRead)
+{
+  boost::filesystem::path path =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("%%%%-%%%%.tlog");
+
+  util::TopicLogWriter writer;
+  ASSERT_TRUE(writer.Open(path.string(), false));
+  EXPECT_TRUE(writer.IsOpen());
+  writeMessages(writer, 20);
+  EXPECT_EQ(writer.RecordCount(), 40u);
+  writer.Close();
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_EQ(writer.FileSize(), boost::filesystem::file_size(path));
+
+  checkLog(path.string(), 20);
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicLog_TEST, CompressedOnThreads)
+{
+  boost::filesystem::path path =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("%%%%-%%%%.tlog");
+
+  util::TopicLogWriter writer(
+      [](const std::function<std::string ()> &_task)
+      {
+        return std::async(std::launch::async, _task);
+      });
+  ASSERT_TRUE(writer.Open(path.string(), true));
+  writeMessages(writer, 20);
+  writer.Write(true);
+  writer.Close();
+
+  // Repeated bytes compress well
+  EXPECT_LT(boost::filesystem::file_size(path), 1024u * 1024u);
+
+  checkLog(path.string(), 20);
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TopicLog_TEST, Invalid)
+{
+  boost::filesystem::path path =
+    boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("%%%%-%%%%.tlog");
+
+  util::TopicLogReader reader;
+  EXPECT_FALSE(reader.Open(path.string()));
+
+  // A log that wasn't closed has no index
+  {
+    util::TopicLogWriter writer;
+    ASSERT_TRUE(writer.Open(path.string(), false));
+    writeMessages(writer, 10);
+    writer.Write(true);
+    EXPECT_FALSE(reader.Open(path.string()));
+  }
+  EXPECT_TRUE(reader.Open(path.string()));
+  boost::filesystem::remove(path);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,67 @@
+// Lens distortion followed by Gaussian noise in a single pass, so that a
+// camera with both post-effects renders one full-screen quad and one
+// intermediate texture instead of two. See camera_distortion_map_fs.glsl
+// and camera_noise_gaussian_fs.glsl for the two steps.
+
+// The input texture, which is set up by the Ogre Compositor infrastructure.
+uniform sampler2D RT;
+
+// Mapping of undistorted to distorted uv coordinates.
+uniform sampler2D distortionMap;
+
+// Scale the input texture if necessary to crop black border
+uniform vec3 scale;
+
+// Random values sampled on the CPU, used as offsets into the 2-D
+// pseudo-random sampler.
+uniform vec3 offsets;
+// Mean of the Gaussian noise.
+uniform float mean;
+// Standard deviation of the Gaussian noise.
+uniform float stddev;
+
+#define PI 3.14159265358979323846264
+
+float rand(vec2 co)
+{
+  float r = fract(sin(dot(co.xy, vec2(12.9898,78.233))) * 43758.5453);
+
+  // Make sure that we don't return 0.0
+  if(r == 0.0)
+    return 0.000000000001;
+  else
+    return r;
+}
+
+vec4 gaussrand(vec2 co)
+{
+  // Box-Muller method, with a 3rd random value to switch between the two
+  // outputs
+  float U, V, R, Z;
+  U = rand(co + vec2(offsets.x, offsets.x));
+  V = rand(co + vec2(offsets.y, offsets.y));
+  R = rand(co + vec2(offsets.z, offsets.z));
+  if(R < 0.5)
+    Z = sqrt(-2.0 * log(U)) * sin(2.0 * PI * V);
+  else
+    Z = sqrt(-2.0 * log(U)) * cos(2.0 * PI * V);
+
+  Z = Z * stddev + mean;
+
+  return vec4(Z, Z, Z, 0.0);
+}
+
+void main()
+{
+  vec2 scaleCenter = vec2(0.5, 0.5);
+  vec2 inputUV = (gl_TexCoord[0].xy - scaleCenter) / scale.xy + scaleCenter;
+  vec4 mapUV = texture2D(distortionMap, inputUV);
+
+  vec4 color;
+  if (mapUV.x < 0.0 || mapUV.y < 0.0)
+    color = vec4(0.0, 0.0, 0.0, 1.0);
+  else
+    color = texture2D(RT, mapUV.xy);
+
+  gl_FragColor = clamp(color + gaussrand(gl_TexCoord[0].xy), 0.0, 1.0);
+}
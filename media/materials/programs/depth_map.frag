@@ -1,6 +1,9 @@
 uniform float pNear;
 uniform float pFar;
 
+// Applied to the output, for the 16 bit integer depth formats
+uniform float depthScale;
+
 varying float depth;
 
 void main()
@@ -9,5 +12,5 @@ void main()
   //gl_FragColor = vec4(vec3(depth / (pFar - pNear)), 1.0);
 
   // This returns the world position
-  gl_FragColor = vec4(vec3(depth), 1.0);
+  gl_FragColor = vec4(vec3(depth * depthScale), 1.0);
 }
@@ -9,9 +9,11 @@ varying vec4 point;
 
 void main()
 {
-  //vec3 color = 255 * texture2D(tex, vec2(gl_FragCoord.s / width , gl_FragCoord.t / height)).xyz;
-  vec3 color = vec3(80, 0, 0);
-  // int rgb = int(color.r) << 16 | int(color.g) << 8 | int(color.b);
-  int rgb = 1;
+  // Color of the same pixel in the camera image, which is rendered before
+  // the point cloud. Each channel is packed in 8 bits of an integer that
+  // is exactly representable in a float: r * 65536 + g * 256 + b.
+  vec3 color = floor(255.0 * texture2D(tex,
+      vec2(gl_FragCoord.s / width, gl_FragCoord.t / height)).xyz + 0.5);
+  float rgb = color.r * 65536.0 + color.g * 256.0 + color.b;
   gl_FragColor = vec4(point.x, -point.y, -point.z, rgb);
 }
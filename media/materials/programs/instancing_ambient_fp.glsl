@@ -0,0 +1,15 @@
+uniform vec4 derived_ambient_color;
+uniform vec4 surface_emissive_color;
+uniform sampler2D diffuse_map;
+uniform float textured;
+
+varying vec2 vertex_tex_coord;
+
+void main()
+{
+  vec4 color = derived_ambient_color;
+  if (textured > 0.5)
+    color *= texture2D(diffuse_map, vertex_tex_coord);
+
+  gl_FragColor = vec4(color.rgb + surface_emissive_color.rgb, 1.0);
+}
@@ -0,0 +1,67 @@
+uniform vec4 derived_light_diffuse_color;
+uniform vec4 derived_light_specular_color;
+uniform float surface_shininess;
+
+uniform vec4 light_position;
+uniform vec4 light_direction;
+uniform vec4 light_attenuation;
+uniform vec4 spotlight_params;
+uniform vec4 camera_position;
+
+uniform sampler2D diffuse_map;
+uniform float textured;
+
+varying vec3 vertex_world_pos;
+varying vec3 vertex_world_norm;
+varying vec2 vertex_tex_coord;
+
+void main()
+{
+  vec4 color = vec4(0.0, 0.0, 0.0, 1.0);
+
+  // Normalized fragment normal
+  vec3 norm = normalize(vertex_world_norm);
+
+  // Direction from the fragment to the light, light_position.w == 0 for
+  // directional lights
+  vec3 light_dir = light_position.xyz -
+                   vertex_world_pos * light_position.w;
+  float light_dist = length(light_dir);
+  light_dir = normalize(light_dir);
+
+  float lambert_term = max(dot(norm, light_dir), 0.0);
+
+  if (lambert_term > 0.0)
+  {
+    vec3 view = normalize(camera_position.xyz - vertex_world_pos);
+    vec3 halfway = normalize(view + light_dir);
+    float nDotH = dot(norm, halfway);
+
+    // Light attenuation
+    float atten = 1.0 / (light_attenuation.y +
+                         light_attenuation.z*light_dist +
+                         light_attenuation.w*light_dist*light_dist);
+
+    // Modify attenuation for spot lights
+    if (!(spotlight_params.x == 1.0 && spotlight_params.y == 0.0 &&
+          spotlight_params.z == 0.0 && spotlight_params.w == 1.0))
+    {
+      float rho = dot(-light_direction.xyz, light_dir);
+
+      float fSpotE  = clamp((rho - spotlight_params.y) /
+          (spotlight_params.x - spotlight_params.y), 0.0, 1.0);
+
+      atten *= pow(fSpotE, spotlight_params.z);
+    }
+
+    vec4 diffuse = derived_light_diffuse_color;
+    if (textured > 0.5)
+      diffuse *= texture2D(diffuse_map, vertex_tex_coord);
+
+    color.rgb += diffuse.rgb * lambert_term * atten;
+    color.rgb += derived_light_specular_color.rgb *
+        pow(clamp(nDotH, 0.0, 1.0), surface_shininess) * atten;
+  }
+
+  gl_FragColor = color;
+}
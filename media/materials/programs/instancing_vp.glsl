@@ -0,0 +1,32 @@
+// Vertex program of the visuals drawn with hardware instancing. The
+// instance batch passes the world matrix of each instance as three rows
+// in the texture coordinates that follow the texture coordinates of the
+// mesh.
+attribute vec4 vertex;
+attribute vec3 normal;
+attribute vec4 uv0;
+attribute vec4 uv1;
+attribute vec4 uv2;
+attribute vec4 uv3;
+
+uniform mat4 view_proj_mat;
+
+varying vec3 vertex_world_pos;
+varying vec3 vertex_world_norm;
+varying vec2 vertex_tex_coord;
+
+void main()
+{
+  mat4 world_mat;
+  world_mat[0] = uv1;
+  world_mat[1] = uv2;
+  world_mat[2] = uv3;
+  world_mat[3] = vec4(0.0, 0.0, 0.0, 1.0);
+
+  vec4 world_pos = vertex * world_mat;
+  gl_Position = view_proj_mat * world_pos;
+
+  vertex_world_pos = world_pos.xyz;
+  vertex_world_norm = normalize(normal * mat3(world_mat));
+  vertex_tex_coord = uv0.xy;
+}
@@ -15,7 +15,12 @@
  *
 */
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 #include <ignition/math.hh>
 #include <ignition/common/Profiler.hh>
@@ -27,11 +32,420 @@ GZ_REGISTER_MODEL_PLUGIN(ActorPlugin)
 
 #define WALKING_ANIMATION "walking"
 
+namespace gazebo
+{
+  /// \brief A model in the spatial hash of a crowd.
+  class CrowdObstacle
+  {
+    /// \brief The model.
+    public: const physics::Model *model;
+
+    /// \brief Position of the model.
+    public: ignition::math::Vector3d pos;
+
+    /// \brief Index of the agent of the model, -1 if the model isn't an
+    /// agent.
+    public: int agent;
+  };
+
+  /// \brief An actor of a crowd.
+  class CrowdAgent
+  {
+    /// \brief The actor.
+    public: const physics::Model *model = nullptr;
+
+    /// \brief Radius of the actor.
+    public: double radius = 0.4;
+
+    /// \brief Computes the preferred velocity of the actor.
+    public: std::function<ignition::math::Vector3d()> preferred;
+
+    /// \brief Makes the actor walk at a velocity.
+    public: std::function<void(const common::UpdateInfo &,
+                const ignition::math::Vector3d &)> walk;
+
+    /// \brief Position of the actor.
+    public: ignition::math::Vector3d pos;
+
+    /// \brief Velocity of the actor at the last update.
+    public: ignition::math::Vector3d vel;
+
+    /// \brief Preferred velocity of the actor.
+    public: ignition::math::Vector3d prefVel;
+
+    /// \brief New velocity of the actor.
+    public: ignition::math::Vector3d newVel;
+  };
+
+  /// \brief The actors of a world that use the ActorPlugin. The crowd
+  /// updates all of them once per step: it puts the models of the world in
+  /// a spatial hash, asks each actor for its preferred velocity, computes
+  /// the velocities that avoid the other actors in one batch, then makes
+  /// the actors walk.
+  class ActorCrowd
+  {
+    /// \brief Get the crowd of a world, created the first time.
+    /// \param[in] _world The world.
+    /// \return The crowd.
+    public: static std::shared_ptr<ActorCrowd> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Constructor.
+    /// \param[in] _world The world.
+    public: explicit ActorCrowd(const physics::WorldPtr &_world);
+
+    /// \brief Destructor.
+    public: ~ActorCrowd();
+
+    /// \brief Add an actor.
+    /// \param[in] _agent The actor.
+    /// \return Id of the actor.
+    public: int Add(const CrowdAgent &_agent);
+
+    /// \brief Remove an actor.
+    /// \param[in] _id Id of the actor.
+    public: void Remove(const int _id);
+
+    /// \brief Visit the models near a position, from the spatial hash of
+    /// this step.
+    /// \param[in] _pos The position.
+    /// \param[in] _radius Radius of the neighborhood. Models a bit farther
+    /// away may be visited too.
+    /// \param[in] _visit Called with each model.
+    public: void Query(const ignition::math::Vector3d &_pos,
+                const double _radius,
+                const std::function<void(const CrowdObstacle &)> &_visit)
+                const;
+
+    /// \brief Get a number that changes when models are inserted or
+    /// removed.
+    /// \return The generation of the models.
+    public: unsigned int Generation() const;
+
+    /// \brief Update the actors.
+    /// \param[in] _info Timing information
+    private: void OnUpdate(const common::UpdateInfo &_info);
+
+    /// \brief Put the models of the world in the spatial hash.
+    private: void Rebuild();
+
+    /// \brief Compute the new velocities of the agents.
+    private: void Avoid();
+
+    /// \brief Get the key of a cell of the spatial hash.
+    /// \param[in] _x Index of the cell along x.
+    /// \param[in] _y Index of the cell along y.
+    /// \return The key.
+    private: static int64_t CellKey(const int64_t _x, const int64_t _y);
+
+    /// \brief Crowds of the worlds.
+    private: static std::map<physics::World *,
+                 std::weak_ptr<ActorCrowd>> crowds;
+
+    /// \brief Protects the crowds.
+    private: static std::mutex crowdsMutex;
+
+    /// \brief Size of the cells of the spatial hash.
+    private: static const double kCellSize;
+
+    /// \brief Distance at which actors avoid each other.
+    private: static const double kNeighborDistance;
+
+    /// \brief The world.
+    private: physics::World *world;
+
+    /// \brief Connection to the world update.
+    private: event::ConnectionPtr updateConnection;
+
+    /// \brief Agents, by id.
+    private: std::map<int, CrowdAgent> agents;
+
+    /// \brief Id of the next agent.
+    private: int nextId = 0;
+
+    /// \brief Agents of this step, in the order of the agent indices of
+    /// the obstacles.
+    private: std::vector<CrowdAgent *> stepAgents;
+
+    /// \brief Models of the world at this step.
+    private: std::vector<CrowdObstacle> obstacles;
+
+    /// \brief Indices of the obstacles in each cell.
+    private: std::unordered_map<int64_t, std::vector<std::size_t>> cells;
+
+    /// \brief Number of models when the generation last changed.
+    private: unsigned int modelCount = 0;
+
+    /// \brief Generation of the models.
+    private: unsigned int generation = 1;
+  };
+}
+
+std::map<physics::World *, std::weak_ptr<ActorCrowd>> ActorCrowd::crowds;
+std::mutex ActorCrowd::crowdsMutex;
+const double ActorCrowd::kCellSize = 4.0;
+const double ActorCrowd::kNeighborDistance = 4.0;
+
+/////////////////////////////////////////////////
+std::shared_ptr<ActorCrowd> ActorCrowd::Get(const physics::WorldPtr &_world)
+{
+  std::lock_guard<std::mutex> lock(crowdsMutex);
+  std::shared_ptr<ActorCrowd> crowd = crowds[_world.get()].lock();
+  if (!crowd)
+  {
+    crowd = std::make_shared<ActorCrowd>(_world);
+    crowds[_world.get()] = crowd;
+  }
+  return crowd;
+}
+
+/////////////////////////////////////////////////
+ActorCrowd::ActorCrowd(const physics::WorldPtr &_world)
+  : world(_world.get())
+{
+  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&ActorCrowd::OnUpdate, this, std::placeholders::_1));
+}
+
+/////////////////////////////////////////////////
+ActorCrowd::~ActorCrowd()
+{
+  std::lock_guard<std::mutex> lock(crowdsMutex);
+  auto iter = crowds.find(this->world);
+  if (iter != crowds.end() && iter->second.expired())
+    crowds.erase(iter);
+}
+
+/////////////////////////////////////////////////
+int ActorCrowd::Add(const CrowdAgent &_agent)
+{
+  this->agents[this->nextId] = _agent;
+  return this->nextId++;
+}
+
+/////////////////////////////////////////////////
+void ActorCrowd::Remove(const int _id)
+{
+  this->agents.erase(_id);
+  this->stepAgents.clear();
+  this->obstacles.clear();
+}
+
+/////////////////////////////////////////////////
+int64_t ActorCrowd::CellKey(const int64_t _x, const int64_t _y)
+{
+  return (_x << 32) ^ (_y & 0xffffffff);
+}
+
+/////////////////////////////////////////////////
+unsigned int ActorCrowd::Generation() const
+{
+  return this->generation;
+}
+
+/////////////////////////////////////////////////
+void ActorCrowd::Query(const ignition::math::Vector3d &_pos,
+    const double _radius,
+    const std::function<void(const CrowdObstacle &)> &_visit) const
+{
+  const int64_t minX =
+      static_cast<int64_t>(std::floor((_pos.X() - _radius) / kCellSize));
+  const int64_t maxX =
+      static_cast<int64_t>(std::floor((_pos.X() + _radius) / kCellSize));
+  const int64_t minY =
+      static_cast<int64_t>(std::floor((_pos.Y() - _radius) / kCellSize));
+  const int64_t maxY =
+      static_cast<int64_t>(std::floor((_pos.Y() + _radius) / kCellSize));
+  for (int64_t x = minX; x <= maxX; ++x)
+  {
+    for (int64_t y = minY; y <= maxY; ++y)
+    {
+      auto cell = this->cells.find(CellKey(x, y));
+      if (cell == this->cells.end())
+        continue;
+      for (auto const index : cell->second)
+        _visit(this->obstacles[index]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ActorCrowd::Rebuild()
+{
+  // Keep the cells, so that their vectors are reused
+  for (auto &cell : this->cells)
+    cell.second.clear();
+  this->obstacles.clear();
+
+  std::unordered_map<const physics::Model *, int> agentIndex;
+  this->stepAgents.clear();
+  for (auto &iter : this->agents)
+  {
+    agentIndex[iter.second.model] = this->stepAgents.size();
+    this->stepAgents.push_back(&iter.second);
+  }
+
+  const unsigned int count = this->world->ModelCount();
+  if (count != this->modelCount)
+  {
+    this->modelCount = count;
+    ++this->generation;
+  }
+
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    physics::ModelPtr model = this->world->ModelByIndex(i);
+    if (!model)
+      continue;
+
+    CrowdObstacle obstacle;
+    obstacle.model = model.get();
+    obstacle.pos = model->WorldPose().Pos();
+    auto agent = agentIndex.find(obstacle.model);
+    obstacle.agent = agent == agentIndex.end() ? -1 : agent->second;
+    if (obstacle.agent >= 0)
+      this->stepAgents[obstacle.agent]->pos = obstacle.pos;
+
+    const int64_t key = CellKey(
+        static_cast<int64_t>(std::floor(obstacle.pos.X() / kCellSize)),
+        static_cast<int64_t>(std::floor(obstacle.pos.Y() / kCellSize)));
+    this->cells[key].push_back(this->obstacles.size());
+    this->obstacles.push_back(obstacle);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the time until two discs collide, in the plane.
+/// \param[in] _pos Position of the second disc relative to the first.
+/// \param[in] _vel Velocity of the first disc relative to the second.
+/// \param[in] _radius Sum of the radii.
+/// \return Time to collision, 0 if they overlap and infinity if they
+/// never collide.
+static double timeToCollision(const ignition::math::Vector2d &_pos,
+    const ignition::math::Vector2d &_vel, const double _radius)
+{
+  const double c = _pos.Dot(_pos) - _radius * _radius;
+  if (c < 0)
+    return 0;
+
+  const double a = _vel.Dot(_vel);
+  const double b = _pos.Dot(_vel);
+  const double discr = b * b - a * c;
+  if (b <= 0 || discr <= 0 || a <= 0)
+    return ignition::math::INF_D;
+
+  return (b - std::sqrt(discr)) / a;
+}
+
+/////////////////////////////////////////////////
+void ActorCrowd::Avoid()
+{
+  // Sampling-based reciprocal velocity obstacles: each agent picks the
+  // candidate velocity closest to its preferred one that doesn't collide
+  // soon with its neighbors, assuming they take half of the avoidance.
+  static const int kSamples = 24;
+  static const double kTimeWeight = 1.0;
+
+  std::vector<const CrowdAgent *> neighbors;
+  for (std::size_t i = 0; i < this->stepAgents.size(); ++i)
+  {
+    CrowdAgent &agent = *this->stepAgents[i];
+    agent.newVel = agent.prefVel;
+
+    neighbors.clear();
+    this->Query(agent.pos, kNeighborDistance,
+        [&](const CrowdObstacle &_obstacle)
+        {
+          if (_obstacle.agent >= 0 && _obstacle.agent != static_cast<int>(i))
+            neighbors.push_back(this->stepAgents[_obstacle.agent]);
+        });
+    if (neighbors.empty())
+      continue;
+
+    const ignition::math::Vector2d pref(agent.prefVel.X(), agent.prefVel.Y());
+    const ignition::math::Vector2d vel(agent.vel.X(), agent.vel.Y());
+    const double speed = pref.Length();
+
+    double bestCost = ignition::math::INF_D;
+    ignition::math::Vector2d best = pref;
+    for (int k = -1; k < kSamples * 2; ++k)
+    {
+      // The preferred velocity, then samples on two speed circles
+      ignition::math::Vector2d candidate = pref;
+      if (k >= 0)
+      {
+        const double angle = 2 * IGN_PI * (k % kSamples) / kSamples;
+        const double scale = k < kSamples ? 1.0 : 0.5;
+        candidate.Set(std::cos(angle) * speed * scale,
+            std::sin(angle) * speed * scale);
+      }
+
+      double tc = ignition::math::INF_D;
+      for (auto const &neighbor : neighbors)
+      {
+        const ignition::math::Vector2d pos(neighbor->pos.X() - agent.pos.X(),
+            neighbor->pos.Y() - agent.pos.Y());
+        const ignition::math::Vector2d other(neighbor->vel.X(),
+            neighbor->vel.Y());
+        tc = std::min(tc, timeToCollision(pos, candidate * 2 - vel - other,
+            agent.radius + neighbor->radius));
+      }
+
+      const double cost = kTimeWeight / std::max(tc, 1e-3) +
+          (candidate - pref).Length();
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        best = candidate;
+      }
+    }
+
+    agent.newVel.X(best.X());
+    agent.newVel.Y(best.Y());
+  }
+}
+
+/////////////////////////////////////////////////
+void ActorCrowd::OnUpdate(const common::UpdateInfo &_info)
+{
+  IGN_PROFILE("ActorCrowd::OnUpdate");
+  if (this->agents.empty())
+    return;
+
+  IGN_PROFILE_BEGIN("Rebuild");
+  this->Rebuild();
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Preferred");
+  for (auto &agent : this->stepAgents)
+    agent->prefVel = agent->preferred();
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Avoid");
+  this->Avoid();
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Walk");
+  for (auto &agent : this->stepAgents)
+  {
+    agent->vel = agent->newVel;
+    agent->walk(_info, agent->newVel);
+  }
+  IGN_PROFILE_END();
+}
+
 /////////////////////////////////////////////////
 ActorPlugin::ActorPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+ActorPlugin::~ActorPlugin()
+{
+  if (this->crowd)
+    this->crowd->Remove(this->agentId);
+}
+
 /////////////////////////////////////////////////
 void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 {
@@ -39,9 +453,6 @@ void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   this->actor = boost::dynamic_pointer_cast<physics::Actor>(_model);
   this->world = this->actor->GetWorld();
 
-  this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
-          std::bind(&ActorPlugin::OnUpdate, this, std::placeholders::_1)));
-
   this->Reset();
 
   // Read in the target weight
@@ -56,12 +467,16 @@ void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   else
     this->obstacleWeight = 1.5;
 
-  // Read in the animation factor (applied in the OnUpdate function).
+  // Read in the animation factor (applied in the Walk function).
   if (_sdf->HasElement("animation_factor"))
     this->animationFactor = _sdf->Get<double>("animation_factor");
   else
     this->animationFactor = 4.5;
 
+  // Read in the radius used to avoid other actors
+  if (_sdf->HasElement("agent_radius"))
+    this->agentRadius = _sdf->Get<double>("agent_radius");
+
   // Add our own name to models we should ignore when avoiding obstacles.
   this->ignoreModels.push_back(this->actor->GetName());
 
@@ -76,6 +491,22 @@ void ActorPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       modelElem = modelElem->GetNextElement("model");
     }
   }
+
+  // Join the crowd of the world, which updates the actor every cycle
+  CrowdAgent agent;
+  agent.model = this->actor.get();
+  agent.radius = this->agentRadius;
+  agent.preferred = [this]()
+      {
+        return this->PreferredVelocity();
+      };
+  agent.walk = [this](const common::UpdateInfo &_info,
+      const ignition::math::Vector3d &_vel)
+      {
+        this->Walk(_info, _vel);
+      };
+  this->crowd = ActorCrowd::Get(this->world);
+  this->agentId = this->crowd->Add(agent);
 }
 
 /////////////////////////////////////////////////
@@ -89,6 +520,23 @@ void ActorPlugin::Reset()
   else
     this->target = ignition::math::Vector3d(0, -5, 1.2138);
 
+  // Read in the waypoints, which replace the random targets
+  this->waypoints.clear();
+  this->waypointIndex = 0;
+  if (this->sdf && this->sdf->HasElement("waypoints"))
+  {
+    sdf::ElementPtr waypointElem =
+      this->sdf->GetElement("waypoints")->GetElement("waypoint");
+    while (waypointElem)
+    {
+      this->waypoints.push_back(
+          waypointElem->Get<ignition::math::Vector3d>());
+      waypointElem = waypointElem->GetNextElement("waypoint");
+    }
+  }
+  if (!this->waypoints.empty())
+    this->target = this->waypoints[0];
+
   auto skelAnims = this->actor->SkeletonAnimations();
   if (skelAnims.find(WALKING_ANIMATION) == skelAnims.end())
   {
@@ -108,61 +556,81 @@ void ActorPlugin::Reset()
 /////////////////////////////////////////////////
 void ActorPlugin::ChooseNewTarget()
 {
+  if (!this->waypoints.empty())
+  {
+    this->waypointIndex = (this->waypointIndex + 1) % this->waypoints.size();
+    this->target = this->waypoints[this->waypointIndex];
+    return;
+  }
+
   ignition::math::Vector3d newTarget(this->target);
   while ((newTarget - this->target).Length() < 2.0)
   {
     newTarget.X(ignition::math::Rand::DblUniform(-3, 3.5));
     newTarget.Y(ignition::math::Rand::DblUniform(-10, 2));
 
-    for (unsigned int i = 0; i < this->world->ModelCount(); ++i)
-    {
-      double dist = (this->world->ModelByIndex(i)->WorldPose().Pos()
-          - newTarget).Length();
-      if (dist < 2.0)
-      {
-        newTarget = this->target;
-        break;
-      }
-    }
+    bool blocked = false;
+    this->crowd->Query(newTarget, 2.0,
+        [&](const CrowdObstacle &_obstacle)
+        {
+          if ((_obstacle.pos - newTarget).Length() < 2.0)
+            blocked = true;
+        });
+    if (blocked)
+      newTarget = this->target;
   }
   this->target = newTarget;
 }
 
 /////////////////////////////////////////////////
-void ActorPlugin::HandleObstacles(ignition::math::Vector3d &_pos)
+void ActorPlugin::UpdateIgnoredModels()
 {
-  for (unsigned int i = 0; i < this->world->ModelCount(); ++i)
+  if (this->ignoredGeneration == this->crowd->Generation())
+    return;
+
+  this->ignoredModels.clear();
+  for (auto const &name : this->ignoreModels)
   {
-    physics::ModelPtr model = this->world->ModelByIndex(i);
-    if (std::find(this->ignoreModels.begin(), this->ignoreModels.end(),
-          model->GetName()) == this->ignoreModels.end())
-    {
-      ignition::math::Vector3d offset = model->WorldPose().Pos() -
-        this->actor->WorldPose().Pos();
-      double modelDist = offset.Length();
-      if (modelDist < 4.0)
-      {
-        double invModelDist = this->obstacleWeight / modelDist;
-        offset.Normalize();
-        offset *= invModelDist;
-        _pos -= offset;
-      }
-    }
+    physics::ModelPtr model = this->world->ModelByName(name);
+    if (model)
+      this->ignoredModels.insert(model.get());
   }
+  this->ignoredGeneration = this->crowd->Generation();
 }
 
 /////////////////////////////////////////////////
-void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
+void ActorPlugin::HandleObstacles(ignition::math::Vector3d &_pos)
 {
-  IGN_PROFILE("ActorPlugin::UpdateImpl");
-  IGN_PROFILE_BEGIN("Update");
+  this->UpdateIgnoredModels();
 
-  // Time delta
-  double dt = (_info.simTime - this->lastUpdate).Double();
+  // Other actors of the crowd are avoided by the crowd
+  const ignition::math::Vector3d actorPos = this->actor->WorldPose().Pos();
+  this->crowd->Query(actorPos, 4.0,
+      [&](const CrowdObstacle &_obstacle)
+      {
+        if (_obstacle.agent >= 0 ||
+            this->ignoredModels.count(_obstacle.model) > 0)
+        {
+          return;
+        }
+
+        ignition::math::Vector3d offset = _obstacle.pos - actorPos;
+        double modelDist = offset.Length();
+        if (modelDist < 4.0)
+        {
+          double invModelDist = this->obstacleWeight / modelDist;
+          offset.Normalize();
+          offset *= invModelDist;
+          _pos -= offset;
+        }
+      });
+}
 
+/////////////////////////////////////////////////
+ignition::math::Vector3d ActorPlugin::PreferredVelocity()
+{
   ignition::math::Pose3d pose = this->actor->WorldPose();
   ignition::math::Vector3d pos = this->target - pose.Pos();
-  ignition::math::Vector3d rpy = pose.Rot().Euler();
 
   double distance = pos.Length();
 
@@ -180,8 +648,23 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   // Adjust the direction vector by avoiding obstacles
   this->HandleObstacles(pos);
 
+  return pos * this->velocity;
+}
+
+/////////////////////////////////////////////////
+void ActorPlugin::Walk(const common::UpdateInfo &_info,
+    const ignition::math::Vector3d &_vel)
+{
+  IGN_PROFILE("ActorPlugin::Walk");
+
+  // Time delta
+  double dt = (_info.simTime - this->lastUpdate).Double();
+
+  ignition::math::Pose3d pose = this->actor->WorldPose();
+  ignition::math::Vector3d rpy = pose.Rot().Euler();
+
   // Compute the yaw orientation
-  ignition::math::Angle yaw = atan2(pos.Y(), pos.X()) + 1.5707 - rpy.Z();
+  ignition::math::Angle yaw = atan2(_vel.Y(), _vel.X()) + 1.5707 - rpy.Z();
   yaw.Normalize();
 
   // Rotate in place, instead of jumping.
@@ -192,14 +675,19 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   }
   else
   {
-    pose.Pos() += pos * this->velocity * dt;
+    pose.Pos() += _vel * dt;
     pose.Rot() = ignition::math::Quaterniond(1.5707, 0, rpy.Z()+yaw.Radian());
   }
 
-  // Make sure the actor stays within bounds
-  pose.Pos().X(std::max(-3.0, std::min(3.5, pose.Pos().X())));
-  pose.Pos().Y(std::max(-10.0, std::min(2.0, pose.Pos().Y())));
-  pose.Pos().Z(1.2138);
+  if (this->waypoints.empty())
+  {
+    // Make sure the actor stays within bounds
+    pose.Pos().X(std::max(-3.0, std::min(3.5, pose.Pos().X())));
+    pose.Pos().Y(std::max(-10.0, std::min(2.0, pose.Pos().Y())));
+    pose.Pos().Z(1.2138);
+  }
+  else
+    pose.Pos().Z(this->target.Z());
 
   // Distance traveled is used to coordinate motion with the walking
   // animation
@@ -210,5 +698,4 @@ void ActorPlugin::OnUpdate(const common::UpdateInfo &_info)
   this->actor->SetScriptTime(this->actor->ScriptTime() +
     (distanceTraveled * this->animationFactor));
   this->lastUpdate = _info.simTime;
-  IGN_PROFILE_END();
 }
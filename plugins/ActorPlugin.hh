@@ -18,7 +18,9 @@
 #ifndef GAZEBO_PLUGINS_ACTORPLUGIN_HH_
 #define GAZEBO_PLUGINS_ACTORPLUGIN_HH_
 
+#include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "gazebo/common/Plugin.hh"
@@ -27,11 +29,37 @@
 
 namespace gazebo
 {
+  // Forward declare the crowd shared by the actors of a world.
+  class ActorCrowd;
+
+  /// \brief Makes an actor walk to random targets, or along waypoints,
+  /// while avoiding obstacles and the other actors.
+  ///
+  /// All the actors of a world that use this plugin form a crowd, updated
+  /// together once per step. The models of the world are put in a spatial
+  /// hash once per step, and each actor only looks at the models near it.
+  /// Actors avoid each other with a batch of reciprocal velocity obstacle
+  /// (RVO) computations over all the actors.
+  ///
+  /// optional parameters:
+  /// <target>            first target, 0 -5 1.2138 by default
+  /// <waypoints>         <waypoint> elements to walk along in a loop,
+  ///                     instead of random targets
+  /// <target_weight>     weight of the target in the vector field
+  /// <obstacle_weight>   weight of the obstacles in the vector field
+  /// <animation_factor>  coordinates motion with the walking animation
+  /// <agent_radius>      radius of the actor when avoiding other actors,
+  ///                     0.4 m by default
+  /// <ignore_obstacles>  <model> elements with the names of the models
+  ///                     that aren't obstacles
   class GZ_PLUGIN_VISIBLE ActorPlugin : public ModelPlugin
   {
     /// \brief Constructor
     public: ActorPlugin();
 
+    /// \brief Destructor
+    public: virtual ~ActorPlugin();
+
     /// \brief Load the actor plugin.
     /// \param[in] _model Pointer to the parent model.
     /// \param[in] _sdf Pointer to the plugin's SDF elements.
@@ -40,9 +68,17 @@ namespace gazebo
     // Documentation Inherited.
     public: virtual void Reset();
 
-    /// \brief Function that is called every update cycle.
+    /// \brief Compute the velocity the actor would like to walk at. Called
+    /// by the crowd every update cycle, before the actors avoid each other.
+    /// \return The preferred velocity.
+    private: ignition::math::Vector3d PreferredVelocity();
+
+    /// \brief Walk at a velocity. Called by the crowd every update cycle,
+    /// after the actors avoid each other.
     /// \param[in] _info Timing information
-    private: void OnUpdate(const common::UpdateInfo &_info);
+    /// \param[in] _vel Velocity of the actor.
+    private: void Walk(const common::UpdateInfo &_info,
+                 const ignition::math::Vector3d &_vel);
 
     /// \brief Helper function to choose a new target location
     private: void ChooseNewTarget();
@@ -53,9 +89,19 @@ namespace gazebo
     /// to nearby obstacles.
     private: void HandleObstacles(ignition::math::Vector3d &_pos);
 
+    /// \brief Resolve the names of the models to ignore, when the models of
+    /// the world changed.
+    private: void UpdateIgnoredModels();
+
     /// \brief Pointer to the parent actor.
     private: physics::ActorPtr actor;
 
+    /// \brief Crowd of the world.
+    private: std::shared_ptr<ActorCrowd> crowd;
+
+    /// \brief Id of the actor in the crowd.
+    private: int agentId = -1;
+
     /// \brief Pointer to the world, for convenience.
     private: physics::WorldPtr world;
 
@@ -65,12 +111,18 @@ namespace gazebo
     /// \brief Velocity of the actor
     private: ignition::math::Vector3d velocity;
 
-    /// \brief List of connections
-    private: std::vector<event::ConnectionPtr> connections;
-
     /// \brief Current target location
     private: ignition::math::Vector3d target;
 
+    /// \brief Waypoints to walk along, empty for random targets.
+    private: std::vector<ignition::math::Vector3d> waypoints;
+
+    /// \brief Index of the current waypoint.
+    private: std::size_t waypointIndex = 0;
+
+    /// \brief Radius of the actor when avoiding other actors.
+    private: double agentRadius = 0.4;
+
     /// \brief Target location weight (used for vector field)
     private: double targetWeight = 1.0;
 
@@ -87,6 +139,13 @@ namespace gazebo
     /// \brief List of models to ignore. Used for vector field
     private: std::vector<std::string> ignoreModels;
 
+    /// \brief Models to ignore, resolved from their names.
+    private: std::unordered_set<const physics::Model *> ignoredModels;
+
+    /// \brief Generation of the crowd's models when the models to ignore
+    /// were resolved.
+    private: unsigned int ignoredGeneration = 0;
+
     /// \brief Custom trajectory info.
     private: physics::TrajectoryInfoPtr trajectoryInfo;
   };
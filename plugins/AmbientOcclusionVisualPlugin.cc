@@ -206,7 +206,8 @@ void AmbientOcclusionVisualPluginPrivate::AddSsao(rendering::CameraPtr _cam)
       // set a visibility mask so that the ssao effect does not apply to
       // gui visuals
       gBufCompInstance->getTechnique()->getTargetPass(1)->setVisibilityMask(
-          GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE));
+          GZ_VISIBILITY_ALL & ~(GZ_VISIBILITY_GUI | GZ_VISIBILITY_SELECTABLE |
+          GZ_VISIBILITY_INSTANCED));
     }
   }
   else
@@ -36,8 +36,12 @@
 typedef SSIZE_T ssize_t;
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sdf/sdf.hh>
 #include <ignition/common/Profiler.hh>
@@ -160,76 +164,292 @@ double Rotor::kDefaultRotorVelocitySlowdownSim = 10.0;
 double Rotor::kDefaultFrequencyCutoff = 5.0;
 double Rotor::kDefaultSamplingRate = 0.2;
 
-// Private data class
-class gazebo::ArduCopterPluginPrivate
+/// \brief Single producer, single consumer mailbox that holds the latest
+/// value written. The writer and the reader never wait for each other: the
+/// value is triple buffered, and the buffers are exchanged atomically.
+template<typename T>
+class Mailbox
+{
+  /// \brief Write a value, replacing the value not read yet, if any.
+  /// Called by the producer only.
+  /// \param[in] _value The value.
+  public: void Write(const T &_value)
+  {
+    this->buffers[this->back] = _value;
+    this->back = this->middle.exchange(this->back | kNew) & kIndex;
+  }
+
+  /// \brief Read the latest value. Called by the consumer only.
+  /// \param[out] _value The value, if one was written since the last read.
+  /// \return True if a value was written since the last read.
+  public: bool Read(T &_value)
+  {
+    if ((this->middle.load() & kNew) == 0)
+      return false;
+
+    this->front = this->middle.exchange(this->front) & kIndex;
+    _value = this->buffers[this->front];
+    return true;
+  }
+
+  /// \brief Flag of the middle buffer when it holds a value not read yet.
+  private: static const int kNew = 4;
+
+  /// \brief Mask of the index of the middle buffer.
+  private: static const int kIndex = 3;
+
+  /// \brief The buffers.
+  private: T buffers[3];
+
+  /// \brief Buffer written by the producer.
+  private: int back = 0;
+
+  /// \brief Buffer exchanged between the producer and the consumer, and
+  /// kNew if it holds a value not read yet.
+  private: std::atomic<int> middle{1};
+
+  /// \brief Buffer read by the consumer.
+  private: int front = 2;
+};
+
+/// \brief A servo packet, as received by the I/O thread.
+struct ServoMail
+{
+  /// \brief The packet.
+  ServoPacket pkt;
+
+  /// \brief Number of bytes received.
+  ssize_t size;
+};
+
+/// \brief Close a socket.
+/// \param[in] _handle Socket handle.
+static void closeSocket(const int _handle)
+{
+  shutdown(_handle, 0);
+  #ifdef _WIN32
+  closesocket(_handle);
+  #else
+  close(_handle);
+  #endif
+}
+
+/// \brief Make a socket address
+/// \param[in] _address Socket address.
+/// \param[in] _port Socket port
+/// \param[out] _sockaddr New socket address structure.
+static void makeSockAddr(const char *_address, const uint16_t _port,
+  struct sockaddr_in &_sockaddr)
 {
-  /// \brief Bind to an adress and port
+  memset(&_sockaddr, 0, sizeof(_sockaddr));
+
+  #ifdef HAVE_SOCK_SIN_LEN
+    _sockaddr.sin_len = sizeof(_sockaddr);
+  #endif
+
+  _sockaddr.sin_port = htons(_port);
+  _sockaddr.sin_family = AF_INET;
+  _sockaddr.sin_addr.s_addr = inet_addr(_address);
+}
+
+/// \brief The SITL link of a vehicle. The physics thread and the I/O thread
+/// only exchange packets through its mailboxes.
+class SitlVehicle
+{
+  /// \brief Destructor. Closes the socket.
+  public: ~SitlVehicle()
+  {
+    if (this->handle >= 0)
+      closeSocket(this->handle);
+  }
+
+  /// \brief Open a non blocking socket bound to an address and port
   /// \param[in] _address Address to bind to.
   /// \param[in] _port Port to bind to.
   /// \return True on success.
-  public: bool Bind(const char *_address, const uint16_t _port)
+  public: bool Open(const std::string &_address, const uint16_t _port)
   {
+    this->handle = socket(AF_INET, SOCK_DGRAM /*SOCK_STREAM*/, 0);
+    #ifndef _WIN32
+    // Windows does not support FD_CLOEXEC
+    fcntl(this->handle, F_SETFD, FD_CLOEXEC);
+    #endif
+    int one = 1;
+    setsockopt(this->handle, IPPROTO_TCP, TCP_NODELAY,
+        reinterpret_cast<const char *>(&one), sizeof(one));
+
     struct sockaddr_in sockaddr;
-    this->MakeSockAddr(_address, _port, sockaddr);
+    makeSockAddr(_address.c_str(), _port, sockaddr);
 
     if (bind(this->handle, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) != 0)
     {
-      shutdown(this->handle, 0);
-      #ifdef _WIN32
-      closesocket(this->handle);
-      #else
-      close(this->handle);
-      #endif
+      closeSocket(this->handle);
+      this->handle = -1;
       return false;
     }
+
+    setsockopt(this->handle, SOL_SOCKET, SO_REUSEADDR,
+       reinterpret_cast<const char *>(&one), sizeof(one));
+
+    #ifdef _WIN32
+    u_long on = 1;
+    ioctlsocket(this->handle, FIONBIO,
+                reinterpret_cast<u_long FAR *>(&on));
+    #else
+    fcntl(this->handle, F_SETFL,
+        fcntl(this->handle, F_GETFL, 0) | O_NONBLOCK);
+    #endif
     return true;
   }
 
-  /// \brief Make a socket
-  /// \param[in] _address Socket address.
-  /// \param[in] _port Socket port
-  /// \param[out] _sockaddr New socket address structure.
-  public: void MakeSockAddr(const char *_address, const uint16_t _port,
-    struct sockaddr_in &_sockaddr)
-  {
-    memset(&_sockaddr, 0, sizeof(_sockaddr));
+  /// \brief Socket handle
+  public: int handle = -1;
 
-    #ifdef HAVE_SOCK_SIN_LEN
-      _sockaddr.sin_len = sizeof(_sockaddr);
-    #endif
+  /// \brief Address the state packets are sent to.
+  public: struct sockaddr_in fdmAddr;
 
-    _sockaddr.sin_port = htons(_port);
-    _sockaddr.sin_family = AF_INET;
-    _sockaddr.sin_addr.s_addr = inet_addr(_address);
+  /// \brief Servo packets, from the I/O thread to the physics thread.
+  public: Mailbox<ServoMail> servo;
+
+  /// \brief State packets, from the physics thread to the I/O thread.
+  public: Mailbox<fdmPacket> state;
+};
+
+/// \brief Dedicated thread that exchanges the packets of all the vehicles
+/// with their SITL instances, so that the physics thread never waits on a
+/// socket.
+class SitlIO
+{
+  /// \brief Get the instance shared by all the vehicles.
+  /// \return The instance.
+  public: static SitlIO &Instance()
+  {
+    static SitlIO instance;
+    return instance;
+  }
+
+  /// \brief Destructor.
+  public: ~SitlIO()
+  {
+    this->Stop();
   }
 
-  /// \brief Receive data
-  /// \param[out] _buf Buffer that receives the data.
-  /// \param[in] _size Size of the buffer.
-  /// \param[in] _timeoutMS Milliseconds to wait for data.
-  public: ssize_t Recv(void *_buf, const size_t _size, uint32_t _timeoutMs)
+  /// \brief Serve a vehicle. The thread starts with the first vehicle.
+  /// \param[in] _vehicle The vehicle.
+  public: void Add(const std::shared_ptr<SitlVehicle> &_vehicle)
   {
-    fd_set fds;
-    struct timeval tv;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->vehicles.push_back(_vehicle);
+    if (!this->thread.joinable())
+    {
+      this->running = true;
+      this->thread = std::thread(&SitlIO::Run, this);
+    }
+  }
 
-    FD_ZERO(&fds);
-    FD_SET(this->handle, &fds);
+  /// \brief Stop serving a vehicle. The thread stops with the last vehicle.
+  /// \param[in] _vehicle The vehicle.
+  public: void Remove(const std::shared_ptr<SitlVehicle> &_vehicle)
+  {
+    bool empty;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->vehicles.erase(std::remove(this->vehicles.begin(),
+          this->vehicles.end(), _vehicle), this->vehicles.end());
+      empty = this->vehicles.empty();
+    }
 
-    tv.tv_sec = _timeoutMs / 1000;
-    tv.tv_usec = (_timeoutMs % 1000) * 1000UL;
+    if (empty)
+      this->Stop();
+  }
 
-    if (select(this->handle+1, &fds, NULL, NULL, &tv) != 1)
+  /// \brief Stop the thread.
+  private: void Stop()
+  {
+    this->running = false;
+    if (this->thread.joinable() &&
+        this->thread.get_id() != std::this_thread::get_id())
     {
-        return -1;
+      this->thread.join();
     }
+  }
 
-    #ifdef _WIN32
-    return recv(this->handle, reinterpret_cast<char *>(_buf), _size, 0);
-    #else
-    return recv(this->handle, _buf, _size, 0);
-    #endif
+  /// \brief Thread main loop: send the new state packets, then wait a
+  /// short time for servo packets on all the sockets.
+  private: void Run()
+  {
+    std::vector<std::shared_ptr<SitlVehicle>> served;
+    while (this->running)
+    {
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        served = this->vehicles;
+      }
+
+      fd_set fds;
+      FD_ZERO(&fds);
+      int maxHandle = -1;
+      for (auto const &vehicle : served)
+      {
+        fdmPacket pkt;
+        if (vehicle->state.Read(pkt))
+        {
+          ::sendto(vehicle->handle,
+                   reinterpret_cast<raw_type *>(&pkt),
+                   sizeof(pkt), 0,
+                   (struct sockaddr *)&vehicle->fdmAddr,
+                   sizeof(vehicle->fdmAddr));
+        }
+        FD_SET(vehicle->handle, &fds);
+        maxHandle = std::max(maxHandle, vehicle->handle);
+      }
+
+      // short, so that new state packets are sent right away
+      struct timeval tv;
+      tv.tv_sec = 0;
+      tv.tv_usec = 100;
+      if (maxHandle < 0 || select(maxHandle + 1, &fds, NULL, NULL, &tv) <= 0)
+        continue;
+
+      for (auto const &vehicle : served)
+      {
+        if (!FD_ISSET(vehicle->handle, &fds))
+          continue;
+
+        // keep the latest packet of the socket
+        ServoMail mail;
+        while (true)
+        {
+          #ifdef _WIN32
+          mail.size = recv(vehicle->handle,
+              reinterpret_cast<char *>(&mail.pkt), sizeof(mail.pkt), 0);
+          #else
+          mail.size = recv(vehicle->handle, &mail.pkt, sizeof(mail.pkt), 0);
+          #endif
+          if (mail.size < 0)
+            break;
+          vehicle->servo.Write(mail);
+        }
+      }
+    }
   }
 
+  /// \brief The vehicles.
+  private: std::vector<std::shared_ptr<SitlVehicle>> vehicles;
+
+  /// \brief Protects the vehicles.
+  private: std::mutex mutex;
+
+  /// \brief The I/O thread.
+  private: std::thread thread;
+
+  /// \brief False to stop the thread.
+  private: std::atomic<bool> running{false};
+};
+
+// Private data class
+class gazebo::ArduCopterPluginPrivate
+{
   /// \brief Pointer to the update event connection.
   public: event::ConnectionPtr updateConnection;
 
@@ -245,8 +465,12 @@ class gazebo::ArduCopterPluginPrivate
   /// \brief Controller update mutex.
   public: std::mutex mutex;
 
-  /// \brief Socket handle
-  public: int handle;
+  /// \brief SITL link of the vehicle, served by the I/O thread.
+  public: std::shared_ptr<SitlVehicle> vehicle;
+
+  /// \brief True to wait for each servo packet of the controller, once it
+  /// is online, false to apply the latest one without waiting.
+  public: bool lockstep = true;
 
   /// \brief Pointer to an IMU sensor
   public: sensors::ImuSensorPtr imuSensor;
@@ -261,48 +485,25 @@ class gazebo::ArduCopterPluginPrivate
   /// \brief number of times ArduCotper skips update
   /// before marking ArduCopter offline
   public: int connectionTimeoutMaxCount;
+
+  /// \brief Wall time of the last servo packet.
+  public: common::Time lastPacketTime;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 ArduCopterPlugin::ArduCopterPlugin()
   : dataPtr(new ArduCopterPluginPrivate)
 {
-  // socket
-  this->dataPtr->handle = socket(AF_INET, SOCK_DGRAM /*SOCK_STREAM*/, 0);
-  #ifndef _WIN32
-  // Windows does not support FD_CLOEXEC
-  fcntl(this->dataPtr->handle, F_SETFD, FD_CLOEXEC);
-  #endif
-  int one = 1;
-  setsockopt(this->dataPtr->handle, IPPROTO_TCP, TCP_NODELAY,
-      reinterpret_cast<const char *>(&one), sizeof(one));
-
-  if (!this->dataPtr->Bind("127.0.0.1", 9002))
-  {
-    gzerr << "failed to bind with 127.0.0.1:9002, aborting plugin.\n";
-    return;
-  }
-
   this->dataPtr->arduCopterOnline = false;
 
   this->dataPtr->connectionTimeoutCount = 0;
-
-  setsockopt(this->dataPtr->handle, SOL_SOCKET, SO_REUSEADDR,
-     reinterpret_cast<const char *>(&one), sizeof(one));
-
-  #ifdef _WIN32
-  u_long on = 1;
-  ioctlsocket(this->dataPtr->handle, FIONBIO,
-              reinterpret_cast<u_long FAR *>(&on));
-  #else
-  fcntl(this->dataPtr->handle, F_SETFL,
-      fcntl(this->dataPtr->handle, F_GETFL, 0) | O_NONBLOCK);
-  #endif
 }
 
 /////////////////////////////////////////////////
 ArduCopterPlugin::~ArduCopterPlugin()
 {
+  if (this->dataPtr->vehicle)
+    SitlIO::Instance().Remove(this->dataPtr->vehicle);
 }
 
 /////////////////////////////////////////////////
@@ -455,6 +656,30 @@ void ArduCopterPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   getSdfParam<int>(_sdf, "connectionTimeoutMaxCount",
     this->dataPtr->connectionTimeoutMaxCount, 10);
 
+  getSdfParam<bool>(_sdf, "lockstep", this->dataPtr->lockstep, true);
+
+  // SITL link. Each vehicle has its own ports, and one I/O thread serves
+  // all of them.
+  std::string listenAddr;
+  getSdfParam<std::string>(_sdf, "listen_addr", listenAddr, "127.0.0.1");
+  std::string fdmAddr;
+  getSdfParam<std::string>(_sdf, "fdm_addr", fdmAddr, "127.0.0.1");
+  int fdmPortIn;
+  getSdfParam<int>(_sdf, "fdm_port_in", fdmPortIn, 9002);
+  int fdmPortOut;
+  getSdfParam<int>(_sdf, "fdm_port_out", fdmPortOut, 9003);
+
+  auto vehicle = std::make_shared<SitlVehicle>();
+  if (!vehicle->Open(listenAddr, fdmPortIn))
+  {
+    gzerr << "failed to bind with " << listenAddr << ":" << fdmPortIn
+          << ", aborting plugin.\n";
+    return;
+  }
+  makeSockAddr(fdmAddr.c_str(), fdmPortOut, vehicle->fdmAddr);
+  this->dataPtr->vehicle = vehicle;
+  SitlIO::Instance().Add(vehicle);
+
   // Listen to the update event. This event is broadcast every simulation
   // iteration.
   this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
@@ -526,28 +751,40 @@ void ArduCopterPlugin::ApplyMotorForces(const double _dt)
 void ArduCopterPlugin::ReceiveMotorCommand()
 {
   // Added detection for whether ArduCopter is online or not.
-  // If ArduCopter is detected (receive of fdm packet from someone),
-  // then socket receive wait time is increased from 1ms to 1 sec
-  // to accomodate network jitter.
-  // If ArduCopter is not detected, receive call blocks for 1ms
-  // on each call.
+  // Packets are received by the I/O thread, so this never waits on the
+  // socket. If ArduCopter is not detected, the latest packet, if any, is
+  // taken without waiting.
+  // If ArduCopter is detected, in lockstep, we wait up to 1 sec for the
+  // next packet to accomodate network jitter. Otherwise the last command
+  // is kept until no packet came in for 1 sec.
   // Once ArduCopter presence is detected, it takes this many
   // missed receives before declaring the FCS offline.
 
-  ServoPacket pkt;
-  int waitMs = 1;
-  if (this->dataPtr->arduCopterOnline)
+  ServoMail mail;
+  bool received = this->dataPtr->vehicle->servo.Read(mail);
+  if (!received && this->dataPtr->arduCopterOnline && this->dataPtr->lockstep)
   {
-    // increase timeout for receive once we detect a packet from
-    // ArduCopter FCS.
-    waitMs = 1000;
+    // wait for the packet in the mailbox, without touching the socket
+    const common::Time timeout = common::Time::GetWallTime() +
+        common::Time(1.0);
+    while (!received && common::Time::GetWallTime() < timeout)
+    {
+      gazebo::common::Time::NSleep(10000);
+      received = this->dataPtr->vehicle->servo.Read(mail);
+    }
   }
-  else
+
+  const common::Time now = common::Time::GetWallTime();
+  if (!received && this->dataPtr->arduCopterOnline &&
+      !this->dataPtr->lockstep &&
+      now - this->dataPtr->lastPacketTime < common::Time(1.0))
   {
-    // Otherwise skip quickly and do not set control force.
-    waitMs = 1;
+    // keep the last command until no packet came in for a second
+    return;
   }
-  ssize_t recvSize = this->dataPtr->Recv(&pkt, sizeof(ServoPacket), waitMs);
+
+  const ServoPacket &pkt = mail.pkt;
+  ssize_t recvSize = received ? mail.size : -1;
   ssize_t expectedPktSize =
     sizeof(pkt.motorSpeed[0])*this->dataPtr->rotors.size();
   if ((recvSize == -1) || (recvSize < expectedPktSize))
@@ -560,9 +797,9 @@ void ArduCopterPlugin::ReceiveMotorCommand()
             << " controller expected size (" << expectedPktSize << ").\n";
     }
 
-    gazebo::common::Time::NSleep(100);
     if (this->dataPtr->arduCopterOnline)
     {
+      this->dataPtr->lastPacketTime = now;
       gzwarn << "Broken ArduCopter connection, count ["
              << this->dataPtr->connectionTimeoutCount
              << "/" << this->dataPtr->connectionTimeoutMaxCount
@@ -579,6 +816,7 @@ void ArduCopterPlugin::ReceiveMotorCommand()
   }
   else
   {
+    this->dataPtr->lastPacketTime = now;
     if (!this->dataPtr->arduCopterOnline)
     {
       gzdbg << "ArduCopter controller online detected.\n";
@@ -699,11 +937,6 @@ void ArduCopterPlugin::SendState() const
   pkt.velocityXYZ[1] = velNEDFrame.Y();
   pkt.velocityXYZ[2] = velNEDFrame.Z();
 
-  struct sockaddr_in sockaddr;
-  this->dataPtr->MakeSockAddr("127.0.0.1", 9003, sockaddr);
-
-  ::sendto(this->dataPtr->handle,
-           reinterpret_cast<raw_type *>(&pkt),
-           sizeof(pkt), 0,
-           (struct sockaddr *)&sockaddr, sizeof(sockaddr));
+  // sent by the I/O thread
+  this->dataPtr->vehicle->state.Write(pkt);
 }
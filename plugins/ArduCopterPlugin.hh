@@ -45,6 +45,20 @@ namespace gazebo
   /// <imuName>     scoped name for the imu sensor
   /// <connectionTimeoutMaxCount> timeout before giving up on
   ///                             controller synchronization
+  ///
+  /// optional parameters:
+  /// <lockstep>     wait for each servo packet once the controller is
+  ///                online (default), or apply the latest one without
+  ///                waiting
+  /// <listen_addr>  address the servo packets are received on, 127.0.0.1
+  /// <fdm_port_in>  port the servo packets are received on, 9002
+  /// <fdm_addr>     address the state packets are sent to, 127.0.0.1
+  /// <fdm_port_out> port the state packets are sent to, 9003
+  ///
+  /// The packets are exchanged by one I/O thread shared by all the
+  /// vehicles, through lock-free mailboxes, so the physics thread never
+  /// waits on a socket. Give each vehicle its own ports to fly several
+  /// SITL instances.
   class GZ_PLUGIN_VISIBLE ArduCopterPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -15,6 +15,7 @@
  *
 */
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -165,19 +166,21 @@ void AttachLightPlugin::OnUpdate()
 void AttachLightPlugin::OnRequest(ConstRequestPtr &_msg)
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  if (_msg->request() != "entity_delete")
-    return;
-  for (auto &it : this->dataPtr->linkLights)
+  for (auto const &name : msgs::DeletedEntities(*_msg))
   {
-    physics::LinkPtr link = it.first;
-    std::map<physics::LightPtr, ignition::math::Pose3d> &lights = it.second;
-    for (auto lightIt = lights.begin(); lightIt != lights.end(); ++lightIt)
+    for (auto &it : this->dataPtr->linkLights)
     {
-      physics::LightPtr light = lightIt->first;
-      if (light->GetScopedName() == _msg->data())
+      std::map<physics::LightPtr, ignition::math::Pose3d> &lights = it.second;
+      auto lightIt = std::find_if(lights.begin(), lights.end(),
+          [&name](const std::pair<const physics::LightPtr,
+            ignition::math::Pose3d> &_light)
+          {
+            return _light.first->GetScopedName() == name;
+          });
+      if (lightIt != lights.end())
       {
         lights.erase(lightIt);
-        return;
+        break;
       }
     }
   }
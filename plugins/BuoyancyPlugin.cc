@@ -15,9 +15,7 @@
  *
 */
 
-#include "ignition/common/Profiler.hh"
 #include "gazebo/common/Assert.hh"
-#include "gazebo/common/Events.hh"
 #include "plugins/BuoyancyPlugin.hh"
 
 using namespace gazebo;
@@ -27,10 +25,17 @@ GZ_REGISTER_MODEL_PLUGIN(BuoyancyPlugin)
 /////////////////////////////////////////////////
 BuoyancyPlugin::BuoyancyPlugin()
   // Density of liquid water at 1 atm pressure and 15 degrees Celsius.
-  : fluidDensity(999.1026)
+  : fieldId(-1), fluidDensity(999.1026)
 {
 }
 
+/////////////////////////////////////////////////
+BuoyancyPlugin::~BuoyancyPlugin()
+{
+  if (this->fieldId >= 0)
+    this->model->GetWorld()->ForceFields().Remove(this->fieldId);
+}
+
 /////////////////////////////////////////////////
 void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 {
@@ -147,34 +152,46 @@ void BuoyancyPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void BuoyancyPlugin::Init()
 {
-  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&BuoyancyPlugin::OnUpdate, this));
+  // The links are updated in one pass, before the physics update, with
+  // their volume properties in link order.
+  physics::Link_V links;
+  this->linkVolProps.clear();
+  for (auto link : this->model->GetLinks())
+  {
+    auto iter = this->volPropsMap.find(link->GetId());
+    if (iter == this->volPropsMap.end())
+      continue;
+
+    GZ_ASSERT(iter->second.volume > 0,
+        "Nonpositive volume found in volume properties!");
+    links.push_back(link);
+    this->linkVolProps.push_back(iter->second);
+  }
+
+  this->fieldId = this->model->GetWorld()->ForceFields().Add(links,
+      std::bind(&BuoyancyPlugin::ApplyForces, this, std::placeholders::_1,
+        std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
 }
 
 /////////////////////////////////////////////////
-void BuoyancyPlugin::OnUpdate()
+void BuoyancyPlugin::ApplyForces(physics::ForceFieldLinks &_links,
+    const std::vector<std::size_t> &_slots, const std::size_t _begin,
+    const std::size_t _end)
 {
-  IGN_PROFILE("BuoyancyPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN("Update");
-  for (auto link : this->model->GetLinks())
+  for (std::size_t i = _begin; i < _end; ++i)
   {
-    VolumeProperties volumeProperties = this->volPropsMap[link->GetId()];
-    double volume = volumeProperties.volume;
-    GZ_ASSERT(volume > 0, "Nonpositive volume found in volume properties!");
+    const std::size_t s = _slots[i];
+    const VolumeProperties &volumeProperties = this->linkVolProps[i];
 
     // By Archimedes' principle,
     // buoyancy = -(mass*gravity)*fluid_density/object_density
     // object_density = mass/volume, so the mass term cancels.
     // Therefore,
     ignition::math::Vector3d buoyancy =
-        -this->fluidDensity * volume * this->model->GetWorld()->Gravity();
-
-    ignition::math::Pose3d linkFrame = link->WorldPose();
-    // rotate buoyancy into the link frame before applying the force.
-    ignition::math::Vector3d buoyancyLinkFrame =
-        linkFrame.Rot().Inverse().RotateVector(buoyancy);
+        -this->fluidDensity * volumeProperties.volume * _links.gravity;
 
-    link->AddLinkForce(buoyancyLinkFrame, volumeProperties.cov);
+    // Apply it at the center of volume, from the link frame.
+    _links.AddForceAtWorldPosition(s, buoyancy,
+        _links.poses[s].CoordPositionAdd(volumeProperties.cov));
   }
-  IGN_PROFILE_END();
 }
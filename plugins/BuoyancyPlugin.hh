@@ -19,6 +19,7 @@
 #define GAZEBO_PLUGINS_BUOYANCYPLUGIN_HH_
 
 #include <map>
+#include <vector>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/Event.hh"
@@ -69,11 +70,20 @@ namespace gazebo
     // Documentation inherited
     public: virtual void Init();
 
-    /// \brief Callback for World Update events.
-    protected: virtual void OnUpdate();
+    /// \brief Destructor.
+    public: virtual ~BuoyancyPlugin();
 
-    /// \brief Connection to World Update events.
-    protected: event::ConnectionPtr updateConnection;
+    /// \brief Force field kernel that applies the buoyancy of the links.
+    /// \param[in,out] _links State of the links.
+    /// \param[in] _slots Slots of the links of the model.
+    /// \param[in] _begin First link.
+    /// \param[in] _end Past the last link.
+    protected: virtual void ApplyForces(physics::ForceFieldLinks &_links,
+                   const std::vector<std::size_t> &_slots,
+                   const std::size_t _begin, const std::size_t _end);
+
+    /// \brief Id of the force field of the model, -1 if there is none.
+    protected: int fieldId;
 
     /// \brief Pointer to model containing the plugin.
     protected: physics::ModelPtr model;
@@ -88,6 +98,10 @@ namespace gazebo
     /// \brief Map of <link ID, point> pairs mapping link IDs to the CoV (center
     /// of volume) and volume of the link.
     protected: std::map<int, VolumeProperties> volPropsMap;
+
+    /// \brief Volume properties of each link of the force field, copied
+    /// from volPropsMap by Init.
+    protected: std::vector<VolumeProperties> linkVolProps;
   };
 }
 
@@ -22,26 +22,18 @@
 #include <ignition/msgs/boolean.pb.h>
 #include <ignition/transport/Node.hh>
 
-#include "gazebo/common/Events.hh"
-#include "gazebo/common/UpdateInfo.hh"
-
-#include "gazebo/physics/Entity.hh"
 #include "gazebo/physics/World.hh"
 
 #include "ContainPlugin.hh"
 
 namespace gazebo
 {
-  namespace physics
-  {
-    typedef boost::weak_ptr<physics::Entity> EntityWeakPtr;
-  }
-
   /// \brief Private data class for the ContainPlugin class
   class ContainPluginPrivate
   {
-    /// \brief Connection to world update.
-    public: event::ConnectionPtr updateConnection;
+    /// \brief Id of the region of the world region triggers, -1 while the
+    /// plugin is disabled.
+    public: int regionId = -1;
 
     /// \brief Pointer to the world.
     public: physics::WorldPtr world;
@@ -49,15 +41,9 @@ namespace gazebo
     /// \brief Scoped name of the entity we're checking.
     public: std::string entityName;
 
-    /// \brief Pointer to the entity we're checking.
-    public: physics::EntityWeakPtr entity;
-
     /// \brief Box representing the volume to check.
     public: ignition::math::OrientedBoxd box;
 
-    /// \brief pointer to an entity whose pose the geometry will track
-    public: physics::EntityWeakPtr containerEntity;
-
     /// \brief scoped name of entity to track
     public: std::string containerEntityName;
 
@@ -87,6 +73,13 @@ ContainPlugin::ContainPlugin() : WorldPlugin(),
 {
 }
 
+/////////////////////////////////////////////////
+ContainPlugin::~ContainPlugin()
+{
+  if (this->dataPtr->regionId >= 0)
+    this->dataPtr->world->RegionTriggers().Remove(this->dataPtr->regionId);
+}
+
 /////////////////////////////////////////////////
 void ContainPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -182,14 +175,14 @@ bool ContainPlugin::EnableIgn(const ignition::msgs::Boolean &_req,
 bool ContainPlugin::Enable(const bool _enable)
 {
   // Already started
-  if (_enable && this->dataPtr->updateConnection)
+  if (_enable && this->dataPtr->regionId >= 0)
   {
     gzwarn << "Contain plugin is already enabled." << std::endl;
     return false;
   }
 
   // Already stopped
-  if (!_enable && !this->dataPtr->updateConnection)
+  if (!_enable && this->dataPtr->regionId < 0)
   {
     gzwarn << "Contain plugin is already disabled." << std::endl;
     return false;
@@ -198,15 +191,20 @@ bool ContainPlugin::Enable(const bool _enable)
   // Start
   if (_enable)
   {
-    // Start update
-    this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-        std::bind(&ContainPlugin::OnUpdate, this, std::placeholders::_1));
-
     auto topic = "/" + this->dataPtr->ns + "/contain";
 
     this->dataPtr->containIgnPub =
         this->dataPtr->ignNode.Advertise<ignition::msgs::Boolean>(topic);
 
+    // The world evaluates all the regions together, and reports the first
+    // state then only the transitions
+    this->dataPtr->regionId = this->dataPtr->world->RegionTriggers().Add(
+        this->dataPtr->box, {this->dataPtr->entityName},
+        [this](const std::string &, const bool _inside)
+        {
+          this->PublishContains(_inside);
+        }, this->dataPtr->containerEntityName);
+
     gzmsg << "Started contain plugin [" << this->dataPtr->ns << "]"
           << std::endl;
 
@@ -215,7 +213,8 @@ bool ContainPlugin::Enable(const bool _enable)
 
   // Stop
   {
-    this->dataPtr->updateConnection.reset();
+    this->dataPtr->world->RegionTriggers().Remove(this->dataPtr->regionId);
+    this->dataPtr->regionId = -1;
     this->dataPtr->containIgnPub = ignition::transport::Node::Publisher();
     this->dataPtr->contain = -1;
 
@@ -226,60 +225,6 @@ bool ContainPlugin::Enable(const bool _enable)
   }
 }
 
-/////////////////////////////////////////////////
-void ContainPlugin::OnUpdate(const common::UpdateInfo &/*_info*/)
-{
-  // Only get the entity once
-  physics::EntityPtr entity = this->dataPtr->entity.lock();
-  if (!entity)
-  {
-    this->dataPtr->entity = this->dataPtr->world->EntityByName(
-        this->dataPtr->entityName);
-    entity = this->dataPtr->entity.lock();
-    if (!entity)
-    {
-      // Could not find entity being tested
-      this->PublishContains(false);
-      return;
-    }
-  }
-
-  ignition::math::Vector3d entityInWorldFrame =
-    entity->WorldPose().Pos();
-
-  ignition::math::Vector3d entityInBoxFrame;
-  if (!this->dataPtr->containerEntityName.empty())
-  {
-    physics::EntityPtr referenceEntity = this->dataPtr->containerEntity.lock();
-    // box is in a potentially moving reference frame
-    if (!referenceEntity)
-    {
-      this->dataPtr->containerEntity = this->dataPtr->world->EntityByName(
-        this->dataPtr->containerEntityName);
-      referenceEntity = this->dataPtr->containerEntity.lock();
-      if (!referenceEntity)
-      {
-        // Could not find reference entity
-        this->PublishContains(false);
-        return;
-      }
-    }
-
-    auto worldToBox = referenceEntity->WorldPose();
-    auto boxToWorld = worldToBox.Inverse();
-    // Transform the entity vector from world frame to the frame the box is in
-    entityInBoxFrame = (boxToWorld.Rot() * entityInWorldFrame)
-      + boxToWorld.Pos();
-  }
-  else
-  {
-    // box frame is world frame
-    entityInBoxFrame = entityInWorldFrame;
-  }
-
-  this->PublishContains(this->dataPtr->box.Contains(entityInBoxFrame));
-}
-
 //////////////////////////////////////////////////
 void ContainPlugin::PublishContains(const bool _contains)
 {
@@ -74,9 +74,8 @@ namespace gazebo
     // Documentation inherited
     public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
 
-    /// \brief Called every world iteration on world update begin.
-    /// \param[in] _info Update info.
-    private: void OnUpdate(const common::UpdateInfo &_info);
+    /// \brief Destructor.
+    public: ~ContainPlugin() override;
 
     /// \brief Enables or disables the plugin.
     /// \param[in] _enable False to disable and true to enable the plugin.
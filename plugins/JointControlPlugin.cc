@@ -38,7 +38,7 @@ void JointControlPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   GZ_ASSERT(_sdf, "SDF pointer is null");
 
   std::vector<std::string> jointNames;
-  for (auto joint : _model->GetJoints())
+  for (auto const &joint : _model->GetJoints())
   {
     jointNames.push_back(joint->GetScopedName());
   }
@@ -46,8 +46,11 @@ namespace gazebo
     /// \brief The pointer to publisher to send a command to update a visual.
     public: transport::PublisherPtr pubVisual;
 
-    /// \brief A message holding a Visual message.
-    public: msgs::Visual msg;
+    /// \brief A message holding the appearance of the visual.
+    public: msgs::VisualProperties msg;
+
+    /// \brief The appearance of the visual in msg.
+    public: msgs::VisualProperties::Property *property = nullptr;
 
     /// \brief True if <visual> element exists.
     public: bool visualExists;
@@ -115,12 +118,10 @@ void LedSetting::InitPubVisual(const transport::PublisherPtr &_pubVisual)
   if (this->dataPtr->visualExists)
   {
     // Make a message
-    this->dataPtr->msg.set_name(
-      this->Link()->GetScopedName() + "::" + this->Name());
-    this->dataPtr->msg.set_parent_name(this->Link()->GetScopedName());
     uint32_t id;
     this->Link()->VisualId(this->Name(), id);
-    this->dataPtr->msg.set_id(id);
+    this->dataPtr->property = this->dataPtr->msg.add_property();
+    this->dataPtr->property->set_id(id);
   }
 }
 
@@ -130,38 +131,32 @@ void LedSetting::Flash()
   // Call the function of the parent class.
   FlashLightSetting::Flash();
 
+  if (!this->dataPtr->property)
+    return;
+
   // Make the appearance brighter.
-  this->dataPtr->msg.set_transparency(0.0);
+  msgs::VisualProperties::Property *property = this->dataPtr->property;
+  property->set_transparency(0.0);
   ignition::math::Color color = this->CurrentColor();
   if (color != ignition::math::Color::Black)
   {
     // If the base class is using a specific color rather than the default,
     // apply it to the visual object.
-    msgs::Set(this->dataPtr->msg.mutable_material()->mutable_diffuse(), color);
-    msgs::Set(this->dataPtr->msg.mutable_material()->mutable_emissive(), color);
-    msgs::Set(this->dataPtr->msg.mutable_material()->mutable_specular(), color);
-    msgs::Set(this->dataPtr->msg.mutable_material()->mutable_ambient(), color);
+    msgs::Set(property->mutable_diffuse(), color);
+    msgs::Set(property->mutable_emissive(), color);
+    msgs::Set(property->mutable_specular(), color);
+    msgs::Set(property->mutable_ambient(), color);
   }
   else
   {
     // Otherwise, just apply the default color.
-    msgs::Set(this->dataPtr->msg.mutable_material()->mutable_emissive(),
+    msgs::Set(property->mutable_emissive(),
       this->dataPtr->defaultEmissiveColor);
   }
 
-  // Send the message.
-  if (this->dataPtr->visualExists)
-  {
-    // NOTE: this if statement is to make sure that a visual object to update
-    // has been created in the environment before publishing a message.
-    // Otherwise, a duplicate object will be created and the original one will
-    // never be updated.
-    // This problem is solved by the patch (Pull Request # 2983), which has
-    // been merged into gazebo7 as of July 16, 2018. This if satement should be
-    // removed once the patch is forwarded up to gazebo9.
-    if (this->Link()->GetWorld()->SimTime() > 2.0)
-      this->dataPtr->pubVisual->Publish(this->dataPtr->msg);
-  }
+  // Send the message. The scene applies it once the visual exists, so it
+  // can be sent from the start.
+  this->dataPtr->pubVisual->Publish(this->dataPtr->msg);
 }
 
 //////////////////////////////////////////////////
@@ -170,23 +165,17 @@ void LedSetting::Dim()
   // Call the function of the parent class.
   FlashLightSetting::Dim();
 
+  if (!this->dataPtr->property)
+    return;
+
   // Make the appearance darker.
-  this->dataPtr->msg.set_transparency(this->dataPtr->transparency);
-  msgs::Set(this->dataPtr->msg.mutable_material()->mutable_emissive(),
-    ignition::math::Color(0, 0, 0));
-  // Send the message.
-  if (this->dataPtr->visualExists)
-  {
-    // NOTE: this if statement is to make sure that a visual object to update
-    // has been created in the environment before publishing a message.
-    // Otherwise, a duplicate object will be created and the original one will
-    // never be updated.
-    // This problem is solved by the patch (Pull Request # 2983), which has
-    // been merged into gazebo7 as of July 16, 2018. This if satement should be
-    // removed once the patch is forwarded up to gazebo9.
-    if (this->Link()->GetWorld()->SimTime() > 2.0)
-      this->dataPtr->pubVisual->Publish(this->dataPtr->msg);
-  }
+  msgs::VisualProperties::Property *property = this->dataPtr->property;
+  property->set_transparency(this->dataPtr->transparency);
+  msgs::Set(property->mutable_emissive(), ignition::math::Color(0, 0, 0));
+
+  // Send the message. The scene applies it once the visual exists, so it
+  // can be sent from the start.
+  this->dataPtr->pubVisual->Publish(this->dataPtr->msg);
 }
 
 //////////////////////////////////////////////////
@@ -196,12 +185,13 @@ LedPlugin::LedPlugin() : FlashLightPlugin(), dataPtr(new LedPluginPrivate)
   this->dataPtr->node = transport::NodePtr(new transport::Node());
   this->dataPtr->node->Init();
 
-  // Advertise the topic to update lights
-  this->dataPtr->pubVisual
-    = this->dataPtr->node->Advertise<gazebo::msgs::Visual>("~/visual");
+  // Advertise the topic to update the appearance of visuals, which carries
+  // only the changed properties.
+  this->dataPtr->pubVisual = this->dataPtr->node->Advertise<
+    gazebo::msgs::VisualProperties>("~/visual/properties");
   // NOTE: it should not call WaitForConnection() since there could be no
-  // subscriber to "~/visual" topic if the render engine is not running (e.g.,
-  // rostest), leading to a hang-up.
+  // subscriber to "~/visual/properties" topic if the render engine is not
+  // running (e.g., rostest), leading to a hang-up.
 }
 
 //////////////////////////////////////////////////
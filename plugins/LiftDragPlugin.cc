@@ -16,22 +16,354 @@
 */
 
 #include <algorithm>
+#include <array>
+#include <fstream>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 #include <ignition/math/Pose3.hh>
 
 #include "gazebo/common/Assert.hh"
+#include "gazebo/common/SystemPaths.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/transport/transport.hh"
 #include "plugins/LiftDragPlugin.hh"
 
+namespace gazebo
+{
+  /// \brief Lift, drag and moment coefficient curves of a surface,
+  /// tabulated over the angle of attack on a uniform grid, so that they are
+  /// evaluated without searching or branching.
+  class LiftDragCurve
+  {
+    /// \brief A point of a curve: angle of attack, cl, cd and cm.
+    public: typedef std::array<double, 4> Point;
+
+    /// \brief Build the curves from points, interpolated linearly.
+    /// \param[in] _points Points of the curves, in any order.
+    /// \return False if there are less than 2 distinct angles of attack.
+    public: bool Load(std::vector<Point> _points);
+
+    /// \brief Load the curves from a CSV file, with one point per line.
+    /// Curves loaded by several surfaces are shared.
+    /// \param[in] _uri URI or path of the file.
+    /// \return The curves, null on error.
+    public: static std::shared_ptr<const LiftDragCurve> LoadFile(
+                const std::string &_uri);
+
+    /// \brief Evaluate the curves. Angles outside of the curves take the
+    /// value of the nearest end.
+    /// \param[in] _alpha Angle of attack.
+    /// \param[out] _cl Coefficient of lift.
+    /// \param[out] _cd Coefficient of drag.
+    /// \param[out] _cm Coefficient of moment.
+    public: void Evaluate(const double _alpha, double &_cl, double &_cd,
+                double &_cm) const;
+
+    /// \brief Angle of attack of the first sample.
+    public: double alphaMin = 0;
+
+    /// \brief Inverse of the angle between samples.
+    public: double invStep = 0;
+
+    /// \brief cl, cd and cm of each sample.
+    public: std::vector<std::array<double, 3>> samples;
+  };
+
+  /// \brief The lift drag surfaces of a world, evaluated together in a
+  /// single pass per step: the states of the links are gathered, then the
+  /// forces are computed, then they are applied.
+  class LiftDragSurfaces
+  {
+    /// \brief Get the surfaces of a world, created the first time.
+    /// \param[in] _world The world.
+    /// \return The surfaces.
+    public: static std::shared_ptr<LiftDragSurfaces> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Constructor.
+    /// \param[in] _world The world.
+    public: explicit LiftDragSurfaces(const physics::WorldPtr &_world);
+
+    /// \brief Destructor.
+    public: ~LiftDragSurfaces();
+
+    /// \brief Add a surface.
+    /// \param[in] _plugin Plugin of the surface.
+    public: void Add(LiftDragPlugin *_plugin);
+
+    /// \brief Remove a surface.
+    /// \param[in] _plugin Plugin of the surface.
+    public: void Remove(LiftDragPlugin *_plugin);
+
+    /// \brief Evaluate and apply the forces of all the surfaces.
+    private: void Update();
+
+    /// \brief Surfaces of the worlds.
+    private: static std::map<physics::World *,
+                 std::weak_ptr<LiftDragSurfaces>> registry;
+
+    /// \brief Protects the registry.
+    private: static std::mutex registryMutex;
+
+    /// \brief The world.
+    private: physics::World *world;
+
+    /// \brief Plugins of the surfaces.
+    private: std::vector<LiftDragPlugin *> plugins;
+
+    /// \brief World pose of the link of each surface.
+    private: std::vector<ignition::math::Pose3d> poses;
+
+    /// \brief World velocity of the center of pressure of each surface.
+    private: std::vector<ignition::math::Vector3d> vels;
+
+    /// \brief Force of each surface, applied at its center of pressure.
+    private: std::vector<ignition::math::Vector3d> forces;
+
+    /// \brief Torque of each surface.
+    private: std::vector<ignition::math::Vector3d> torques;
+
+    /// \brief True for the surfaces that generate forces.
+    private: std::vector<char> active;
+
+    /// \brief Protects the surfaces.
+    private: std::mutex mutex;
+
+    /// \brief Connection to World Update events.
+    private: event::ConnectionPtr updateConnection;
+  };
+}
+
 using namespace gazebo;
 
 GZ_REGISTER_MODEL_PLUGIN(LiftDragPlugin)
 
+/// \brief Angle between the samples of tabulated curves, 0.25 deg.
+static const double kCurveStep = 0.25 * M_PI / 180.0;
+
+/////////////////////////////////////////////////
+bool LiftDragCurve::Load(std::vector<Point> _points)
+{
+  std::sort(_points.begin(), _points.end(),
+      [](const Point &_a, const Point &_b)
+      {
+        return _a[0] < _b[0];
+      });
+  if (_points.size() < 2 || _points.back()[0] - _points.front()[0] <= 0)
+    return false;
+
+  // Resample the points on a uniform grid, which lets Evaluate find the
+  // sample of an angle with a multiplication
+  const double range = _points.back()[0] - _points.front()[0];
+  const std::size_t count =
+      static_cast<std::size_t>(std::ceil(range / kCurveStep)) + 1;
+  const double step = range / (count - 1);
+  this->alphaMin = _points.front()[0];
+  this->invStep = 1.0 / step;
+  this->samples.resize(count);
+
+  std::size_t p = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const double alpha = std::min(this->alphaMin + i * step,
+        _points.back()[0]);
+    while (p + 2 < _points.size() && _points[p + 1][0] < alpha)
+      ++p;
+
+    const Point &a = _points[p];
+    const Point &b = _points[p + 1];
+    const double t = b[0] > a[0] ?
+        ignition::math::clamp((alpha - a[0]) / (b[0] - a[0]), 0.0, 1.0) : 0.0;
+    for (int c = 0; c < 3; ++c)
+      this->samples[i][c] = a[c + 1] + t * (b[c + 1] - a[c + 1]);
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const LiftDragCurve> LiftDragCurve::LoadFile(
+    const std::string &_uri)
+{
+  static std::map<std::string, std::weak_ptr<const LiftDragCurve>> cache;
+  static std::mutex cacheMutex;
+
+  const std::string path = common::SystemPaths::Instance()->FindFileURI(_uri);
+  if (path.empty())
+  {
+    gzerr << "Unable to find lift drag coefficients file [" << _uri << "]\n";
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  std::shared_ptr<const LiftDragCurve> curve = cache[path].lock();
+  if (curve)
+    return curve;
+
+  std::ifstream file(path);
+  if (!file)
+  {
+    gzerr << "Unable to open lift drag coefficients file [" << path << "]\n";
+    return nullptr;
+  }
+
+  // One point per line: alpha, cl, cd, cm, separated by commas or spaces.
+  // Empty lines, comments and a header are skipped.
+  std::vector<Point> points;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line))
+  {
+    ++lineNumber;
+    line = line.substr(0, line.find('#'));
+    std::replace(line.begin(), line.end(), ',', ' ');
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    std::istringstream stream(line);
+    Point point;
+    if (!(stream >> point[0] >> point[1] >> point[2] >> point[3]))
+    {
+      if (points.empty())
+        continue;
+
+      gzerr << "Invalid point on line " << lineNumber
+            << " of lift drag coefficients file [" << path << "]\n";
+      return nullptr;
+    }
+    points.push_back(point);
+  }
+
+  auto newCurve = std::make_shared<LiftDragCurve>();
+  if (!newCurve->Load(points))
+  {
+    gzerr << "Lift drag coefficients file [" << path
+          << "] needs at least 2 angles of attack\n";
+    return nullptr;
+  }
+  cache[path] = newCurve;
+  return newCurve;
+}
+
+/////////////////////////////////////////////////
+void LiftDragCurve::Evaluate(const double _alpha, double &_cl, double &_cd,
+    double &_cm) const
+{
+  const double x = ignition::math::clamp((_alpha - this->alphaMin) *
+      this->invStep, 0.0, static_cast<double>(this->samples.size() - 1));
+  const std::size_t i = std::min(static_cast<std::size_t>(x),
+      this->samples.size() - 2);
+  const double t = x - i;
+  const std::array<double, 3> &a = this->samples[i];
+  const std::array<double, 3> &b = this->samples[i + 1];
+  _cl = a[0] + t * (b[0] - a[0]);
+  _cd = a[1] + t * (b[1] - a[1]);
+  _cm = a[2] + t * (b[2] - a[2]);
+}
+
+std::map<physics::World *, std::weak_ptr<LiftDragSurfaces>>
+    LiftDragSurfaces::registry;
+std::mutex LiftDragSurfaces::registryMutex;
+
+/////////////////////////////////////////////////
+std::shared_ptr<LiftDragSurfaces> LiftDragSurfaces::Get(
+    const physics::WorldPtr &_world)
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+  std::shared_ptr<LiftDragSurfaces> surfaces = registry[_world.get()].lock();
+  if (!surfaces)
+  {
+    surfaces = std::make_shared<LiftDragSurfaces>(_world);
+    registry[_world.get()] = surfaces;
+  }
+  return surfaces;
+}
+
+/////////////////////////////////////////////////
+LiftDragSurfaces::LiftDragSurfaces(const physics::WorldPtr &_world)
+  : world(_world.get())
+{
+  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&LiftDragSurfaces::Update, this));
+}
+
+/////////////////////////////////////////////////
+LiftDragSurfaces::~LiftDragSurfaces()
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto iter = registry.find(this->world);
+  if (iter != registry.end() && iter->second.expired())
+    registry.erase(iter);
+}
+
+/////////////////////////////////////////////////
+void LiftDragSurfaces::Add(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.push_back(_plugin);
+}
+
+/////////////////////////////////////////////////
+void LiftDragSurfaces::Remove(LiftDragPlugin *_plugin)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->plugins.erase(
+      std::remove(this->plugins.begin(), this->plugins.end(), _plugin),
+      this->plugins.end());
+}
+
+/////////////////////////////////////////////////
+void LiftDragSurfaces::Update()
+{
+  IGN_PROFILE("LiftDragSurfaces::Update");
+  std::lock_guard<std::mutex> lock(this->mutex);
+  const std::size_t count = this->plugins.size();
+  this->poses.resize(count);
+  this->vels.resize(count);
+  this->forces.resize(count);
+  this->torques.resize(count);
+  this->active.resize(count);
+
+  // get the pose of the links and the linear velocity at cp in inertial
+  // frame
+  IGN_PROFILE_BEGIN("Gather");
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const LiftDragPlugin *plugin = this->plugins[i];
+    this->poses[i] = plugin->link->WorldPose();
+    this->vels[i] = plugin->link->WorldLinearVel(plugin->cp);
+  }
+  IGN_PROFILE_END();
+
+  IGN_PROFILE_BEGIN("Compute");
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    this->active[i] = this->plugins[i]->ComputeWrench(this->poses[i],
+        this->vels[i], this->forces[i], this->torques[i]);
+  }
+  IGN_PROFILE_END();
+
+  // apply forces at cg (with torques for position shift)
+  IGN_PROFILE_BEGIN("Apply");
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (!this->active[i])
+      continue;
+
+    const LiftDragPlugin *plugin = this->plugins[i];
+    plugin->link->AddForceAtRelativePosition(this->forces[i], plugin->cp);
+    plugin->link->AddTorque(this->torques[i]);
+  }
+  IGN_PROFILE_END();
+}
+
 /////////////////////////////////////////////////
 LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 {
@@ -61,6 +393,8 @@ LiftDragPlugin::LiftDragPlugin() : cla(1.0), cda(0.01), cma(0.01), rho(1.2041)
 /////////////////////////////////////////////////
 LiftDragPlugin::~LiftDragPlugin()
 {
+  if (this->surfaces)
+    this->surfaces->Remove(this);
 }
 
 /////////////////////////////////////////////////
@@ -126,6 +460,40 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
   if (_sdf->HasElement("air_density"))
     this->rho = _sdf->Get<double>("air_density");
 
+  // tabulated coefficient curves, which replace the ones given by the
+  // slopes and the stall angle
+  if (_sdf->HasElement("coefficients_file"))
+  {
+    this->curve =
+        LiftDragCurve::LoadFile(_sdf->Get<std::string>("coefficients_file"));
+  }
+  else if (_sdf->HasElement("coefficients"))
+  {
+    std::vector<LiftDragCurve::Point> points;
+    sdf::ElementPtr pointElem =
+        _sdf->GetElement("coefficients")->GetElement("point");
+    while (pointElem)
+    {
+      std::istringstream stream(pointElem->Get<std::string>());
+      LiftDragCurve::Point point;
+      if (stream >> point[0] >> point[1] >> point[2] >> point[3])
+        points.push_back(point);
+      else
+      {
+        gzerr << "Invalid lift drag coefficients point ["
+              << pointElem->Get<std::string>()
+              << "], expected alpha, cl, cd and cm\n";
+      }
+      pointElem = pointElem->GetNextElement("point");
+    }
+
+    auto newCurve = std::make_shared<LiftDragCurve>();
+    if (newCurve->Load(points))
+      this->curve = newCurve;
+    else
+      gzerr << "Lift drag coefficients need at least 2 angles of attack\n";
+  }
+
   if (_sdf->HasElement("link_name"))
   {
     sdf::ElementPtr elem = _sdf->GetElement("link_name");
@@ -141,8 +509,9 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
     }
     else
     {
-      this->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&LiftDragPlugin::OnUpdate, this));
+      // the surfaces of the world are evaluated together
+      this->surfaces = LiftDragSurfaces::Get(this->world);
+      this->surfaces->Add(this);
     }
   }
 
@@ -164,8 +533,28 @@ void LiftDragPlugin::Load(physics::ModelPtr _model,
 void LiftDragPlugin::OnUpdate()
 {
   GZ_ASSERT(this->link, "Link was NULL");
+  IGN_PROFILE("LiftDragPlugin::OnUpdate");
+
   // get linear velocity at cp in inertial frame
-  ignition::math::Vector3d vel = this->link->WorldLinearVel(this->cp);
+  ignition::math::Vector3d force;
+  ignition::math::Vector3d torque;
+  if (!this->ComputeWrench(this->link->WorldPose(),
+        this->link->WorldLinearVel(this->cp), force, torque))
+  {
+    return;
+  }
+
+  // apply forces at cg (with torques for position shift)
+  this->link->AddForceAtRelativePosition(force, this->cp);
+  this->link->AddTorque(torque);
+}
+
+/////////////////////////////////////////////////
+bool LiftDragPlugin::ComputeWrench(const ignition::math::Pose3d &_pose,
+    const ignition::math::Vector3d &_vel, ignition::math::Vector3d &_force,
+    ignition::math::Vector3d &_torque)
+{
+  const ignition::math::Vector3d &vel = _vel;
   ignition::math::Vector3d velI = vel;
   velI.Normalize();
 
@@ -175,13 +564,10 @@ void LiftDragPlugin::OnUpdate()
   // vel = this->velSmooth;
 
   if (vel.Length() <= 0.01)
-    return;
-
-  IGN_PROFILE("LiftDragPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN(std::string(this->link->GetName()).c_str());
+    return false;
 
   // pose of body
-  ignition::math::Pose3d pose = this->link->WorldPose();
+  const ignition::math::Pose3d &pose = _pose;
 
   // rotate forward and upward vectors into inertial frame
   ignition::math::Vector3d forwardI = pose.Rot().RotateVector(this->forward);
@@ -265,26 +651,76 @@ void LiftDragPlugin::OnUpdate()
   double speedInLDPlane = velInLDPlane.Length();
   double q = 0.5 * this->rho * speedInLDPlane * speedInLDPlane;
 
-  // compute cl at cp, check for stall, correct for sweep
+  // compute cl, cd and cm at cp from the tabulated curves, or from the
+  // slopes with a check for stall, and correct for sweep
   double cl;
-  if (this->alpha > this->alphaStall)
+  double cd;
+  double cm;
+  if (this->curve)
   {
-    cl = (this->cla * this->alphaStall +
-          this->claStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still great than 0
-    cl = std::max(0.0, cl);
+    this->curve->Evaluate(this->alpha, cl, cd, cm);
+    cl *= cosSweepAngle;
+    cd *= cosSweepAngle;
+    cm *= cosSweepAngle;
   }
-  else if (this->alpha < -this->alphaStall)
+  else
   {
-    cl = (-this->cla * this->alphaStall +
-          this->claStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cl is still less than 0
-    cl = std::min(0.0, cl);
+    // compute cl at cp, check for stall, correct for sweep
+    if (this->alpha > this->alphaStall)
+    {
+      cl = (this->cla * this->alphaStall +
+            this->claStall * (this->alpha - this->alphaStall))
+           * cosSweepAngle;
+      // make sure cl is still great than 0
+      cl = std::max(0.0, cl);
+    }
+    else if (this->alpha < -this->alphaStall)
+    {
+      cl = (-this->cla * this->alphaStall +
+            this->claStall * (this->alpha + this->alphaStall))
+           * cosSweepAngle;
+      // make sure cl is still less than 0
+      cl = std::min(0.0, cl);
+    }
+    else
+      cl = this->cla * this->alpha * cosSweepAngle;
+
+    // compute cd at cp, check for stall, correct for sweep
+    if (this->alpha > this->alphaStall)
+    {
+      cd = (this->cda * this->alphaStall +
+            this->cdaStall * (this->alpha - this->alphaStall))
+           * cosSweepAngle;
+    }
+    else if (this->alpha < -this->alphaStall)
+    {
+      cd = (-this->cda * this->alphaStall +
+            this->cdaStall * (this->alpha + this->alphaStall))
+           * cosSweepAngle;
+    }
+    else
+      cd = (this->cda * this->alpha) * cosSweepAngle;
+
+    // compute cm at cp, check for stall, correct for sweep
+    if (this->alpha > this->alphaStall)
+    {
+      cm = (this->cma * this->alphaStall +
+            this->cmaStall * (this->alpha - this->alphaStall))
+           * cosSweepAngle;
+      // make sure cm is still great than 0
+      cm = std::max(0.0, cm);
+    }
+    else if (this->alpha < -this->alphaStall)
+    {
+      cm = (-this->cma * this->alphaStall +
+            this->cmaStall * (this->alpha + this->alphaStall))
+           * cosSweepAngle;
+      // make sure cm is still less than 0
+      cm = std::min(0.0, cm);
+    }
+    else
+      cm = this->cma * this->alpha * cosSweepAngle;
   }
-  else
-    cl = this->cla * this->alpha * cosSweepAngle;
 
   // modify cl per control joint value
   if (this->controlJoint)
@@ -297,50 +733,12 @@ void LiftDragPlugin::OnUpdate()
   // compute lift force at cp
   ignition::math::Vector3d lift = cl * q * this->area * liftI;
 
-  // compute cd at cp, check for stall, correct for sweep
-  double cd;
-  if (this->alpha > this->alphaStall)
-  {
-    cd = (this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cd = (-this->cda * this->alphaStall +
-          this->cdaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-  }
-  else
-    cd = (this->cda * this->alpha) * cosSweepAngle;
-
   // make sure drag is positive
   cd = fabs(cd);
 
   // drag at cp
   ignition::math::Vector3d drag = cd * q * this->area * dragDirection;
 
-  // compute cm at cp, check for stall, correct for sweep
-  double cm;
-  if (this->alpha > this->alphaStall)
-  {
-    cm = (this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha - this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still great than 0
-    cm = std::max(0.0, cm);
-  }
-  else if (this->alpha < -this->alphaStall)
-  {
-    cm = (-this->cma * this->alphaStall +
-          this->cmaStall * (this->alpha + this->alphaStall))
-         * cosSweepAngle;
-    // make sure cm is still less than 0
-    cm = std::min(0.0, cm);
-  }
-  else
-    cm = this->cma * this->alpha * cosSweepAngle;
-
   /// \TODO: implement cm
   /// for now, reset cm to zero, as cm needs testing
   cm = 0.0;
@@ -348,11 +746,6 @@ void LiftDragPlugin::OnUpdate()
   // compute moment (torque) at cp
   ignition::math::Vector3d moment = cm * q * this->area * momentDirection;
 
-  // moment arm from cg to cp in inertial plane
-  ignition::math::Vector3d momentArm = pose.Rot().RotateVector(
-    this->cp - this->link->GetInertial()->CoG());
-  // gzerr << this->cp << " : " << this->link->GetInertial()->GetCoG() << "\n";
-
   // force and torque about cg in inertial frame
   ignition::math::Vector3d force = lift + drag;
   // + moment.Cross(momentArm);
@@ -368,6 +761,10 @@ void LiftDragPlugin::OnUpdate()
   //      vel.Length() < 50.0))
   if (0)
   {
+    // moment arm from cg to cp in inertial plane
+    ignition::math::Vector3d momentArm = pose.Rot().RotateVector(
+      this->cp - this->link->GetInertial()->CoG());
+
     gzdbg << "=============================\n";
     gzdbg << "sensor: [" << this->GetHandle() << "]\n";
     gzdbg << "Link: [" << this->link->GetName()
@@ -397,8 +794,7 @@ void LiftDragPlugin::OnUpdate()
   this->cp.Correct();
   torque.Correct();
 
-  // apply forces at cg (with torques for position shift)
-  this->link->AddForceAtRelativePosition(force, this->cp);
-  this->link->AddTorque(torque);
-  IGN_PROFILE_END();
+  _force = force;
+  _torque = torque;
+  return true;
 }
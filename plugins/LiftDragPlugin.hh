@@ -17,9 +17,11 @@
 #ifndef GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 #define GAZEBO_PLUGINS_LIFTDRAGPLUGIN_HH_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
 #include "gazebo/common/Plugin.hh"
@@ -28,7 +30,28 @@
 
 namespace gazebo
 {
+  // Forward declare private classes.
+  class LiftDragCurve;
+  class LiftDragSurfaces;
+
   /// \brief A plugin that simulates lift and drag.
+  ///
+  /// The coefficients are linear in the angle of attack up to the stall
+  /// angle (cla, cda and cma), then follow the post-stall slopes (cla_stall,
+  /// cda_stall and cma_stall). They can instead be given as tabulated
+  /// curves, either inline:
+  /// <coefficients>
+  ///   <point>alpha cl cd cm</point>
+  ///   ...
+  /// </coefficients>
+  /// or in a CSV file with one "alpha, cl, cd, cm" point per line:
+  /// <coefficients_file>model://my_wing/coefficients.csv</coefficients_file>
+  /// The angles are in radians. The curves are interpolated linearly,
+  /// resampled on a uniform grid at load time and shared between the
+  /// surfaces that use the same file.
+  ///
+  /// All the surfaces of a world are evaluated together, in a single pass
+  /// at the beginning of each world update.
   class GZ_PLUGIN_VISIBLE LiftDragPlugin : public ModelPlugin
   {
     /// \brief Constructor.
@@ -40,9 +63,23 @@ namespace gazebo
     // Documentation Inherited.
     public: virtual void Load(physics::ModelPtr _model, sdf::ElementPtr _sdf);
 
-    /// \brief Callback for World Update events.
+    /// \brief Evaluate and apply the forces of this surface alone. The
+    /// surfaces of a world are normally evaluated together, without
+    /// calling this function.
     protected: virtual void OnUpdate();
 
+    /// \brief Compute the force and torque of the surface, and update the
+    /// angle of attack and the angle of sweep.
+    /// \param[in] _pose World pose of the link.
+    /// \param[in] _vel World linear velocity of the center of pressure.
+    /// \param[out] _force Force to apply at the center of pressure.
+    /// \param[out] _torque Torque to apply to the link.
+    /// \return False if the surface moves too slowly to generate forces.
+    protected: bool ComputeWrench(const ignition::math::Pose3d &_pose,
+                   const ignition::math::Vector3d &_vel,
+                   ignition::math::Vector3d &_force,
+                   ignition::math::Vector3d &_torque);
+
     /// \brief Connection to World Update events.
     protected: event::ConnectionPtr updateConnection;
 
@@ -136,6 +173,15 @@ namespace gazebo
 
     /// \brief SDF for this plugin;
     protected: sdf::ElementPtr sdf;
+
+    /// \brief Tabulated coefficient curves, null to use the slopes.
+    protected: std::shared_ptr<const LiftDragCurve> curve;
+
+    /// \brief Surfaces of the world, evaluated together.
+    private: std::shared_ptr<LiftDragSurfaces> surfaces;
+
+    /// \brief The surfaces of the world are evaluated together.
+    private: friend class LiftDragSurfaces;
   };
 }
 #endif
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/common/LockstepChannel.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/PhysicsEngine.hh"
+#include "gazebo/physics/World.hh"
+#include "plugins/LockstepPlugin.hh"
+
+using namespace gazebo;
+GZ_REGISTER_WORLD_PLUGIN(LockstepPlugin)
+
+namespace gazebo
+{
+  /// \internal
+  /// \brief Private data for the LockstepPlugin class.
+  class LockstepPluginPrivate
+  {
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief The joints, in the order of the blocks.
+    public: std::vector<physics::JointPtr> joints;
+
+    /// \brief The channel shared with the external process.
+    public: common::LockstepChannel channel;
+
+    /// \brief True while the external process asked for the current
+    /// iteration, so that only those iterations complete a step.
+    public: bool stepping = false;
+
+    /// \brief Connections to the world update events.
+    public: std::vector<event::ConnectionPtr> connections;
+  };
+}
+
+/////////////////////////////////////////////////
+LockstepPlugin::LockstepPlugin()
+  : dataPtr(new LockstepPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+LockstepPlugin::~LockstepPlugin()
+{
+  this->dataPtr->connections.clear();
+  this->dataPtr->channel.Close();
+}
+
+/////////////////////////////////////////////////
+void LockstepPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  this->dataPtr->world = _world;
+
+  std::string name = _world->Name();
+  if (_sdf->HasElement("channel"))
+    name = _sdf->Get<std::string>("channel");
+
+  sdf::ElementPtr elem = _sdf->HasElement("joint") ?
+      _sdf->GetElement("joint") : sdf::ElementPtr();
+  while (elem)
+  {
+    const std::string jointName = elem->Get<std::string>();
+    physics::JointPtr joint = boost::dynamic_pointer_cast<physics::Joint>(
+        _world->BaseByName(jointName));
+    if (!joint)
+    {
+      gzerr << "Unable to find joint [" << jointName << "], "
+            << "the lockstep plugin is disabled\n";
+      return;
+    }
+    this->dataPtr->joints.push_back(joint);
+    elem = elem->GetNextElement("joint");
+  }
+
+  const unsigned int count = this->dataPtr->joints.size();
+  if (!this->dataPtr->channel.Create(name, count, count * 2))
+  {
+    gzerr << "The lockstep plugin is disabled\n";
+    return;
+  }
+
+  // The external process sets the pace
+  _world->Physics()->SetRealTimeUpdateRate(0);
+
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateBegin(
+        std::bind(&LockstepPlugin::OnWorldUpdateBegin, this)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateEnd(
+        std::bind(&LockstepPlugin::OnWorldUpdateEnd, this)));
+
+  gzmsg << "Lockstep channel [" << name << "] with " << count
+        << " joints\n";
+}
+
+/////////////////////////////////////////////////
+void LockstepPlugin::OnWorldUpdateBegin()
+{
+  // Wait in slices, so that the world can still be stopped
+  this->dataPtr->stepping = false;
+  while (this->dataPtr->channel.Valid() && this->dataPtr->world->Running())
+  {
+    if (this->dataPtr->channel.WaitForStep(0.1))
+    {
+      this->dataPtr->stepping = true;
+      break;
+    }
+  }
+
+  if (!this->dataPtr->stepping)
+    return;
+
+  const double *command = this->dataPtr->channel.Command();
+  for (unsigned int i = 0; i < this->dataPtr->joints.size(); ++i)
+    this->dataPtr->joints[i]->SetForce(0, command[i]);
+}
+
+/////////////////////////////////////////////////
+void LockstepPlugin::OnWorldUpdateEnd()
+{
+  if (!this->dataPtr->stepping)
+    return;
+
+  const unsigned int count = this->dataPtr->joints.size();
+  double *state = this->dataPtr->channel.State();
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    state[i] = this->dataPtr->joints[i]->Position(0);
+    state[count + i] = this->dataPtr->joints[i]->GetVelocity(0);
+  }
+
+  this->dataPtr->channel.CompleteStep(this->dataPtr->world->Iterations(),
+      this->dataPtr->world->SimTime().Double());
+  this->dataPtr->stepping = false;
+}
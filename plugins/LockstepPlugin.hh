@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_LOCKSTEPPLUGIN_HH_
+#define GAZEBO_PLUGINS_LOCKSTEPPLUGIN_HH_
+
+#include <memory>
+
+#include <gazebo/common/Plugin.hh>
+#include <gazebo/util/system.hh>
+
+namespace gazebo
+{
+  class LockstepPluginPrivate;
+
+  /// \brief The LockstepPlugin lets an external process, such as a
+  /// controller or another simulator, step the world one iteration at a
+  /// time through a common::LockstepChannel.
+  ///
+  /// Before each iteration the world waits for the external process to
+  /// ask for a step, then applies the efforts of the command block to the
+  /// joints. After the iteration it writes the positions, then the
+  /// velocities, of the joints to the state block and wakes the external
+  /// process. Both sides then advance in lockstep, with a round trip in
+  /// shared memory instead of messages, and the real time update rate is
+  /// set to 0 so that the world doesn't sleep between iterations.
+  ///
+  /// The world must run unpaused. While it waits, it can still be paused
+  /// or stopped.
+  ///
+  /// # Usage
+  ///
+  /// \code
+  /// <plugin name="lockstep" filename="libLockstepPlugin.so">
+  ///   <channel>robot</channel>
+  ///   <joint>robot::shoulder</joint>
+  ///   <joint>robot::elbow</joint>
+  /// </plugin>
+  /// \endcode
+  ///
+  /// # Configuration
+  ///
+  /// 1. <channel>(string): Name of the channel. The default is the name of
+  /// the world.
+  ///
+  /// 2. <joint>(string): Scoped name of a joint, repeated. The command
+  /// block holds one effort per joint, and the state block the positions
+  /// and the velocities of the first axis of each joint.
+  class GZ_PLUGIN_VISIBLE LockstepPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: LockstepPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~LockstepPlugin();
+
+    // Documentation Inherited.
+    public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
+
+    /// \brief Wait for the external process, then apply the command.
+    private: void OnWorldUpdateBegin();
+
+    /// \brief Write the state and complete the step.
+    private: void OnWorldUpdateEnd();
+
+    /// \internal
+    /// \brief Private data pointer.
+    private: std::unique_ptr<LockstepPluginPrivate> dataPtr;
+  };
+}
+#endif
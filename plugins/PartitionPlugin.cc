@@ -0,0 +1,646 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <ignition/math/AxisAlignedBox.hh>
+#include <ignition/transport/Node.hh>
+#include <sdf/sdf.hh>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/Model.hh"
+#include "gazebo/physics/World.hh"
+#include "plugins/PartitionPlugin.hh"
+
+using namespace gazebo;
+GZ_REGISTER_WORLD_PLUGIN(PartitionPlugin)
+
+namespace gazebo
+{
+  /// \internal
+  /// \brief A ghost of a model of a peer.
+  class PartitionGhost
+  {
+    /// \brief Id of the peer that owns the model.
+    public: int owner = -1;
+
+    /// \brief Last pose published by the owner.
+    public: ignition::math::Pose3d pose;
+  };
+
+  /// \internal
+  /// \brief What is known of a peer.
+  class PartitionPeer
+  {
+    /// \brief Last iteration the peer finished, -1 before its first
+    /// message.
+    public: double iterations = -1;
+
+    /// \brief Region of the peer.
+    public: ignition::math::AxisAlignedBox region;
+
+    /// \brief Messages received and not applied yet, in order.
+    public: std::deque<msgs::Param_V> pending;
+  };
+
+  /// \internal
+  /// \brief Private data for the PartitionPlugin class.
+  class PartitionPluginPrivate
+  {
+    /// \brief Receive the message of a peer.
+    /// \param[in] _msg The message.
+    public: void OnMessage(const msgs::Param_V &_msg);
+
+    /// \brief Tell whether a point is in a region.
+    /// \param[in] _region The region.
+    /// \param[in] _point The point.
+    /// \return True if min <= point < max.
+    public: static bool Contains(const ignition::math::AxisAlignedBox &_region,
+                const ignition::math::Vector3d &_point);
+
+    /// \brief Apply a message of a peer.
+    /// \param[in] _msg The message.
+    /// \param[in] _peer Id of the peer.
+    public: void Apply(const msgs::Param_V &_msg, const int _peer);
+
+    /// \brief Remove the models that start in the region of a peer, the
+    /// peer simulates them.
+    public: void RemoveForeignModels();
+
+    /// \brief Get the SDF of a model at its current pose.
+    /// \param[in] _model The model.
+    /// \param[in] _ghost True to make a static copy without plugins and
+    /// sensors.
+    /// \return The SDF string.
+    public: static std::string ModelSDF(const physics::ModelPtr &_model,
+                const bool _ghost);
+
+    /// \brief Pointer to the world.
+    public: physics::WorldPtr world;
+
+    /// \brief Id of this server.
+    public: int partition = 0;
+
+    /// \brief Number of servers.
+    public: int partitions = 1;
+
+    /// \brief Region of this server.
+    public: ignition::math::AxisAlignedBox region;
+
+    /// \brief Distance from the border within which models get ghosts.
+    public: double ghostMargin = 1.0;
+
+    /// \brief Wall time after which a step goes on without a late peer.
+    public: double barrierTimeout = 10.0;
+
+    /// \brief The peers, by id.
+    public: std::map<int, PartitionPeer> peers;
+
+    /// \brief Ghosts of the models of the peers, by name.
+    public: std::map<std::string, PartitionGhost> ghosts;
+
+    /// \brief Models of this server that have ghosts on the peers.
+    public: std::set<std::string> ghosted;
+
+    /// \brief Velocities of the models handed over to this server, applied
+    /// once they are inserted.
+    public: std::map<std::string,
+            std::pair<ignition::math::Vector3d, ignition::math::Vector3d>>
+            arriving;
+
+    /// \brief True once the models of the peers are removed.
+    public: bool started = false;
+
+    /// \brief The message of the last step, sent again while waiting for
+    /// late peers.
+    public: msgs::Param_V lastMsg;
+
+    /// \brief Protects the peers.
+    public: std::mutex mutex;
+
+    /// \brief Notified when a peer message arrives.
+    public: std::condition_variable cond;
+
+    /// \brief Connections to the world update events.
+    public: std::vector<event::ConnectionPtr> connections;
+
+    /// \brief Ignition communication node.
+    public: ignition::transport::Node node;
+
+    /// \brief Publisher of the messages of this server.
+    public: ignition::transport::Node::Publisher pub;
+  };
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a parameter to a message.
+/// \param[in,out] _msg The message.
+/// \param[in] _name Name of the parameter.
+/// \param[in] _value Value of the parameter.
+/// \return The parameter.
+template<typename T>
+static msgs::Param *addParam(msgs::Param_V &_msg, const std::string &_name,
+    const T &_value)
+{
+  msgs::Param *param = _msg.add_param();
+  param->set_name(_name);
+  param->mutable_value()->CopyFrom(msgs::ConvertAny(_value));
+  return param;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a child to a parameter.
+/// \param[in,out] _param The parameter.
+/// \param[in] _name Name of the child.
+/// \param[in] _value Value of the child.
+template<typename T>
+static void addChild(msgs::Param &_param, const std::string &_name,
+    const T &_value)
+{
+  msgs::Param *child = _param.add_children();
+  child->set_name(_name);
+  child->mutable_value()->CopyFrom(msgs::ConvertAny(_value));
+}
+
+/////////////////////////////////////////////////
+/// \brief Find a child of a parameter.
+/// \param[in] _param The parameter.
+/// \param[in] _name Name of the child.
+/// \return The value of the child, null if it is missing.
+static const msgs::Any *child(const msgs::Param &_param,
+    const std::string &_name)
+{
+  for (auto const &c : _param.children())
+  {
+    if (c.name() == _name)
+      return &c.value();
+  }
+  return nullptr;
+}
+
+/////////////////////////////////////////////////
+bool PartitionPluginPrivate::Contains(
+    const ignition::math::AxisAlignedBox &_region,
+    const ignition::math::Vector3d &_point)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    if (_point[i] < _region.Min()[i] || _point[i] >= _region.Max()[i])
+      return false;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string PartitionPluginPrivate::ModelSDF(const physics::ModelPtr &_model,
+    const bool _ghost)
+{
+  sdf::ElementPtr elem = _model->GetSDF()->Clone();
+  elem->GetElement("pose")->Set(_model->WorldPose());
+
+  if (_ghost)
+  {
+    elem->GetElement("static")->Set(true);
+    while (elem->HasElement("plugin"))
+      elem->GetElement("plugin")->RemoveFromParent();
+
+    sdf::ElementPtr link = elem->HasElement("link") ?
+        elem->GetElement("link") : sdf::ElementPtr();
+    while (link)
+    {
+      while (link->HasElement("sensor"))
+        link->GetElement("sensor")->RemoveFromParent();
+      link = link->GetNextElement("link");
+    }
+  }
+
+  return "<sdf version='" + std::string(SDF_VERSION) + "'>" +
+      elem->ToString("") + "</sdf>";
+}
+
+/////////////////////////////////////////////////
+void PartitionPluginPrivate::OnMessage(const msgs::Param_V &_msg)
+{
+  if (_msg.param_size() < 4 || _msg.param(0).name() != "partition")
+    return;
+
+  const int id = _msg.param(0).value().int_value();
+  if (id == this->partition)
+    return;
+
+  const double iterations = _msg.param(1).value().double_value();
+  std::lock_guard<std::mutex> lock(this->mutex);
+  PartitionPeer &peer = this->peers[id];
+
+  // Messages are sent again while a peer waits, apply each step once
+  if (iterations <= peer.iterations)
+    return;
+
+  peer.iterations = iterations;
+  peer.region = ignition::math::AxisAlignedBox(
+      msgs::ConvertIgn(_msg.param(2).value().vector3d_value()),
+      msgs::ConvertIgn(_msg.param(3).value().vector3d_value()));
+  peer.pending.push_back(_msg);
+  this->cond.notify_all();
+}
+
+/////////////////////////////////////////////////
+void PartitionPluginPrivate::Apply(const msgs::Param_V &_msg, const int _peer)
+{
+  for (int i = 4; i < _msg.param_size(); ++i)
+  {
+    const msgs::Param &param = _msg.param(i);
+    const msgs::Any *name = child(param, "name");
+    if (!name)
+      continue;
+    const std::string &modelName = name->string_value();
+
+    if (param.name() == "migrate")
+    {
+      const msgs::Any *target = child(param, "target");
+      if (!target || target->int_value() != this->partition)
+        continue;
+
+      // The model replaces its ghost
+      const bool ghost = this->ghosts.erase(modelName) > 0;
+      if (ghost)
+        this->world->RemoveModel(modelName);
+
+      const msgs::Any *linear = child(param, "linear_velocity");
+      const msgs::Any *angular = child(param, "angular_velocity");
+
+      // A model that is already here takes the state of the migrated one,
+      // it is never inserted twice
+      physics::ModelPtr model = ghost ? physics::ModelPtr() :
+          this->world->ModelByName(modelName);
+      if (model)
+      {
+        const msgs::Any *pose = child(param, "pose");
+        if (pose)
+          model->SetWorldPose(msgs::ConvertIgn(pose->pose3d_value()));
+        if (linear && angular)
+        {
+          model->SetLinearVel(msgs::ConvertIgn(linear->vector3d_value()));
+          model->SetAngularVel(msgs::ConvertIgn(angular->vector3d_value()));
+        }
+        continue;
+      }
+
+      const bool inserted = this->arriving.count(modelName) > 0;
+      if (linear && angular)
+      {
+        this->arriving[modelName] = std::make_pair(
+            msgs::ConvertIgn(linear->vector3d_value()),
+            msgs::ConvertIgn(angular->vector3d_value()));
+      }
+      if (!inserted)
+        this->world->InsertModelString(param.value().string_value());
+    }
+    else if (param.name() == "ghost")
+    {
+      const ignition::math::Pose3d pose =
+          msgs::ConvertIgn(param.value().pose3d_value());
+      auto iter = this->ghosts.find(modelName);
+      if (iter == this->ghosts.end())
+      {
+        // A model of this server is never replaced by a ghost
+        const msgs::Any *sdfString = child(param, "sdf");
+        if (!sdfString || this->arriving.count(modelName) > 0 ||
+            this->world->ModelByName(modelName))
+        {
+          continue;
+        }
+        this->world->InsertModelString(sdfString->string_value());
+        iter = this->ghosts.insert(
+            std::make_pair(modelName, PartitionGhost())).first;
+      }
+      iter->second.owner = _peer;
+      iter->second.pose = pose;
+    }
+    else if (param.name() == "unghost")
+    {
+      auto iter = this->ghosts.find(modelName);
+      if (iter != this->ghosts.end() && iter->second.owner == _peer)
+      {
+        this->ghosts.erase(iter);
+        this->world->RemoveModel(modelName);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void PartitionPluginPrivate::RemoveForeignModels()
+{
+  // Every server loads the whole world, a model is kept by the server
+  // that a migration would hand it to
+  std::vector<std::string> foreign;
+  for (auto const &model : this->world->Models())
+  {
+    const ignition::math::Vector3d pos = model->WorldPose().Pos();
+    if (model->IsStatic() || Contains(this->region, pos))
+      continue;
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (auto const &peer : this->peers)
+    {
+      if (Contains(peer.second.region, pos))
+      {
+        foreign.push_back(model->GetName());
+        break;
+      }
+    }
+  }
+
+  for (auto const &name : foreign)
+    this->world->RemoveModel(name);
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::PartitionPlugin()
+  : dataPtr(new PartitionPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PartitionPlugin::~PartitionPlugin()
+{
+  this->dataPtr->connections.clear();
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
+{
+  GZ_ASSERT(_world, "PartitionPlugin world pointer is NULL");
+  GZ_ASSERT(_sdf, "PartitionPlugin sdf pointer is NULL");
+  this->dataPtr->world = _world;
+
+  if (!_sdf->HasElement("partition") || !_sdf->HasElement("partitions"))
+  {
+    gzerr << "PartitionPlugin requires <partition> and <partitions>\n";
+    return;
+  }
+  this->dataPtr->partition = _sdf->Get<int>("partition");
+  this->dataPtr->partitions = _sdf->Get<int>("partitions");
+  if (this->dataPtr->partition < 0 ||
+      this->dataPtr->partition >= this->dataPtr->partitions)
+  {
+    gzerr << "Invalid partition [" << this->dataPtr->partition
+          << "] of [" << this->dataPtr->partitions << "]\n";
+    return;
+  }
+
+  const double inf = std::numeric_limits<double>::max();
+  ignition::math::Vector3d min(-inf, -inf, -inf);
+  ignition::math::Vector3d max(inf, inf, inf);
+  if (_sdf->HasElement("region"))
+  {
+    sdf::ElementPtr regionElem = _sdf->GetElement("region");
+    if (regionElem->HasElement("min"))
+      min = regionElem->Get<ignition::math::Vector3d>("min");
+    if (regionElem->HasElement("max"))
+      max = regionElem->Get<ignition::math::Vector3d>("max");
+  }
+  this->dataPtr->region = ignition::math::AxisAlignedBox(min, max);
+
+  if (_sdf->HasElement("ghost_margin"))
+    this->dataPtr->ghostMargin = _sdf->Get<double>("ghost_margin");
+  if (_sdf->HasElement("barrier_timeout"))
+    this->dataPtr->barrierTimeout = _sdf->Get<double>("barrier_timeout");
+
+  std::string topic = "/gazebo/partition";
+  if (_sdf->HasElement("topic"))
+    topic = _sdf->Get<std::string>("topic");
+
+  this->dataPtr->pub = this->dataPtr->node.Advertise<msgs::Param_V>(topic);
+  if (!this->dataPtr->node.Subscribe(topic,
+        &PartitionPluginPrivate::OnMessage, this->dataPtr.get()))
+  {
+    gzerr << "PartitionPlugin unable to subscribe to [" << topic << "]\n";
+    return;
+  }
+
+  // The first message tells the peers that this server is ready
+  addParam(this->dataPtr->lastMsg, "partition", this->dataPtr->partition);
+  addParam(this->dataPtr->lastMsg, "iterations",
+      static_cast<double>(_world->Iterations()));
+  addParam(this->dataPtr->lastMsg, "region_min", min);
+  addParam(this->dataPtr->lastMsg, "region_max", max);
+  this->dataPtr->pub.Publish(this->dataPtr->lastMsg);
+
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateBegin(
+        std::bind(&PartitionPlugin::OnWorldUpdateBegin, this)));
+  this->dataPtr->connections.push_back(
+      event::Events::ConnectWorldUpdateEnd(
+        std::bind(&PartitionPlugin::OnWorldUpdateEnd, this)));
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnWorldUpdateBegin()
+{
+  const double previous =
+      static_cast<double>(this->dataPtr->world->Iterations()) - 1;
+  std::vector<std::pair<int, msgs::Param_V>> messages;
+  {
+    std::unique_lock<std::mutex> lock(this->dataPtr->mutex);
+
+    // Wait until all the peers finished the previous step
+    auto ready = [this, previous]()
+    {
+      for (int id = 0; id < this->dataPtr->partitions; ++id)
+      {
+        if (id == this->dataPtr->partition)
+          continue;
+        auto iter = this->dataPtr->peers.find(id);
+        if (iter == this->dataPtr->peers.end() ||
+            iter->second.iterations < previous)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration<double>(this->dataPtr->barrierTimeout);
+    while (!ready())
+    {
+      if (std::chrono::steady_clock::now() >= deadline)
+      {
+        gzwarn << "PartitionPlugin: a peer is late at iteration ["
+               << previous << "], stepping without it\n";
+        break;
+      }
+
+      // Late peers may have missed the last message
+      if (!this->dataPtr->cond.wait_for(lock, std::chrono::milliseconds(100),
+            ready))
+      {
+        this->dataPtr->pub.Publish(this->dataPtr->lastMsg);
+      }
+    }
+
+    for (auto &peer : this->dataPtr->peers)
+    {
+      for (auto &msg : peer.second.pending)
+        messages.push_back(std::make_pair(peer.first, std::move(msg)));
+      peer.second.pending.clear();
+    }
+  }
+
+  // The regions of the peers are known once they are all ready
+  if (!this->dataPtr->started)
+  {
+    this->dataPtr->RemoveForeignModels();
+    this->dataPtr->started = true;
+  }
+
+  for (auto const &msg : messages)
+    this->dataPtr->Apply(msg.second, msg.first);
+
+  // Move the ghosts
+  for (auto const &ghost : this->dataPtr->ghosts)
+  {
+    physics::ModelPtr model = this->dataPtr->world->ModelByName(ghost.first);
+    if (model)
+      model->SetWorldPose(ghost.second.pose);
+  }
+
+  // Models handed over keep their velocity once inserted
+  for (auto iter = this->dataPtr->arriving.begin();
+       iter != this->dataPtr->arriving.end();)
+  {
+    physics::ModelPtr model = this->dataPtr->world->ModelByName(iter->first);
+    if (model)
+    {
+      model->SetLinearVel(iter->second.first);
+      model->SetAngularVel(iter->second.second);
+      this->dataPtr->arriving.erase(iter++);
+    }
+    else
+      ++iter;
+  }
+}
+
+/////////////////////////////////////////////////
+void PartitionPlugin::OnWorldUpdateEnd()
+{
+  msgs::Param_V msg;
+  addParam(msg, "partition", this->dataPtr->partition);
+  addParam(msg, "iterations",
+      static_cast<double>(this->dataPtr->world->Iterations()));
+  addParam(msg, "region_min", this->dataPtr->region.Min());
+  addParam(msg, "region_max", this->dataPtr->region.Max());
+
+  std::map<int, ignition::math::AxisAlignedBox> regions;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    for (auto const &peer : this->dataPtr->peers)
+      regions[peer.first] = peer.second.region;
+  }
+
+  const ignition::math::Vector3d margin(this->dataPtr->ghostMargin,
+      this->dataPtr->ghostMargin, this->dataPtr->ghostMargin);
+  const ignition::math::AxisAlignedBox inner(
+      this->dataPtr->region.Min() + margin,
+      this->dataPtr->region.Max() - margin);
+
+  std::set<std::string> ghosted;
+  std::vector<std::string> departed;
+  for (auto const &model : this->dataPtr->world->Models())
+  {
+    const std::string &name = model->GetName();
+    if (model->IsStatic() || this->dataPtr->ghosts.count(name) > 0 ||
+        this->dataPtr->arriving.count(name) > 0)
+    {
+      continue;
+    }
+
+    // Hand over the models that left the region
+    const ignition::math::Pose3d pose = model->WorldPose();
+    if (!PartitionPluginPrivate::Contains(this->dataPtr->region, pose.Pos()))
+    {
+      int target = -1;
+      for (auto const &region : regions)
+      {
+        if (PartitionPluginPrivate::Contains(region.second, pose.Pos()))
+        {
+          target = region.first;
+          break;
+        }
+      }
+
+      if (target >= 0)
+      {
+        msgs::Param *param = addParam(msg, "migrate",
+            PartitionPluginPrivate::ModelSDF(model, false));
+        addChild(*param, "name", name);
+        addChild(*param, "target", target);
+        addChild(*param, "pose", pose);
+        addChild(*param, "linear_velocity", model->WorldLinearVel());
+        addChild(*param, "angular_velocity", model->WorldAngularVel());
+        departed.push_back(name);
+        continue;
+      }
+    }
+
+    // Publish the ghosts of the models near the border
+    const ignition::math::AxisAlignedBox box = model->BoundingBox();
+    if (box.Min().X() < inner.Min().X() || box.Min().Y() < inner.Min().Y() ||
+        box.Min().Z() < inner.Min().Z() || box.Max().X() > inner.Max().X() ||
+        box.Max().Y() > inner.Max().Y() || box.Max().Z() > inner.Max().Z())
+    {
+      msgs::Param *param = addParam(msg, "ghost", pose);
+      addChild(*param, "name", name);
+      if (this->dataPtr->ghosted.count(name) == 0)
+        addChild(*param, "sdf", PartitionPluginPrivate::ModelSDF(model, true));
+      ghosted.insert(name);
+    }
+  }
+
+  // The peers drop the ghosts of the models that moved away from the
+  // border. The models handed over get a ghost from their new owner.
+  for (auto const &name : this->dataPtr->ghosted)
+  {
+    if (ghosted.count(name) == 0)
+    {
+      msgs::Param *param = addParam(msg, "unghost", name);
+      addChild(*param, "name", name);
+    }
+  }
+  this->dataPtr->ghosted = ghosted;
+
+  for (auto const &name : departed)
+    this->dataPtr->world->RemoveModel(name);
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->lastMsg = msg;
+  }
+  this->dataPtr->pub.Publish(msg);
+}
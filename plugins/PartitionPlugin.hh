@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+#define GAZEBO_PLUGINS_PARTITIONPLUGIN_HH_
+
+#include <memory>
+
+#include <gazebo/common/Plugin.hh>
+#include <gazebo/util/system.hh>
+
+namespace gazebo
+{
+  class PartitionPluginPrivate;
+
+  /// \brief The PartitionPlugin splits a simulation across several
+  /// gzserver processes, each of which owns a region of space and steps
+  /// the models in it with its own physics engine.
+  ///
+  /// Every server loads the same world, with a different partition id and
+  /// region. Before the first step, a server removes the models that start
+  /// in the region of a peer, so that each model is simulated once. A
+  /// model migrated to a server that already has it updates its state
+  /// instead of being inserted again. After each step, a server publishes
+  /// one message to its peers over an Ignition Transport topic, which works
+  /// across machines. The message holds:
+  ///
+  /// 1. The iteration count, used as a step barrier: a server only starts
+  /// step N + 1 once all its peers finished step N.
+  ///
+  /// 2. The models whose origin left the region. They are handed over,
+  /// with their SDF, pose and velocity, to the peer whose region holds
+  /// them, and removed locally. A model that no region holds stays where
+  /// it is.
+  ///
+  /// 3. The models whose bounding box is within the ghost margin of the
+  /// border of the region. The peers insert a static ghost copy of them,
+  /// without plugins and sensors, and move it to the published pose at
+  /// each step. Local models can then collide with the ghosts. The contact
+  /// is one way: a ghost pushes local models, but is only moved by its
+  /// owner.
+  ///
+  /// # Usage
+  ///
+  /// \code
+  /// <plugin name="partition" filename="libPartitionPlugin.so">
+  ///   <partition>0</partition>
+  ///   <partitions>2</partitions>
+  ///   <region>
+  ///     <min>-1000 -1000 -1000</min>
+  ///     <max>0 1000 1000</max>
+  ///   </region>
+  ///   <ghost_margin>1.0</ghost_margin>
+  /// </plugin>
+  /// \endcode
+  ///
+  /// # Configuration
+  ///
+  /// 1. <partition>(int): Id of this server, from 0. Required.
+  ///
+  /// 2. <partitions>(int): Number of servers. Required.
+  ///
+  /// 3. <region>: Box owned by this server, with <min> and <max> corners.
+  /// A model is in the region when min <= origin < max. The default is
+  /// all space.
+  ///
+  /// 4. <ghost_margin>(double): Distance from the border of the region
+  /// within which a model gets a ghost on the peers. The default is 1 m.
+  ///
+  /// 5. <topic>(string): Topic shared by the servers. The default is
+  /// /gazebo/partition.
+  ///
+  /// 6. <barrier_timeout>(double): Wall time in seconds after which a step
+  /// goes on without a late peer, with a warning. The default is 10 s.
+  class GZ_PLUGIN_VISIBLE PartitionPlugin : public WorldPlugin
+  {
+    /// \brief Constructor.
+    public: PartitionPlugin();
+
+    /// \brief Destructor.
+    public: virtual ~PartitionPlugin();
+
+    // Documentation Inherited.
+    public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf) override;
+
+    /// \brief Wait for the peers, then apply their hand overs and ghosts.
+    private: void OnWorldUpdateBegin();
+
+    /// \brief Hand over the models that left the region, and publish the
+    /// state of the step.
+    private: void OnWorldUpdateEnd();
+
+    /// \internal
+    /// \brief Private data pointer.
+    private: std::unique_ptr<PartitionPluginPrivate> dataPtr;
+  };
+}
+#endif
@@ -342,18 +342,12 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
   // For each contact, compute the friction force direction and speed of
   // surface movement.
   ////////////////////////////////////////////////////////////////////////
-  size_t i = 0;
-  const auto contacts = this->contactManager->GetContacts();
-  const auto model = this->body->GetModel();
+  // Only the contacts of the links of this vehicle
+  this->contactManager->ContactsOf(this->body->GetModel().get(),
+      this->contacts);
 
-  for (auto contact : contacts)
+  for (auto contact : this->contacts)
   {
-    // Beware! There may be invalid contacts beyond GetContactCount()...
-    if (i == this->contactManager->GetContactCount())
-      break;
-
-    ++i;
-
     if (contact->collision1->GetSurface()->collideWithoutContact ||
       contact->collision2->GetSurface()->collideWithoutContact)
       continue;
@@ -369,13 +363,6 @@ void SimpleTrackedVehiclePlugin::DriveTracks(
       continue;
     }
 
-    if (model != contact->collision1->GetLink()->GetModel() &&
-        model != contact->collision2->GetLink()->GetModel())
-    {
-      // Verify one of the collisions' bodies is a track of this vehicle
-      continue;
-    }
-
     dBodyID body1 = dynamic_cast<physics::ODELink&>(
       *contact->collision1->GetLink()).GetODEId();
     dBodyID body2 = dynamic_cast<physics::ODELink& >(
@@ -20,6 +20,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/algorithm/string.hpp>
 
@@ -157,6 +158,9 @@ namespace gazebo {
 
     private: physics::ContactManager *contactManager;
 
+    /// \brief Contacts of the vehicle in the current step.
+    private: std::vector<physics::Contact *> contacts;
+
     /// \class ContactIterator
     /// \brief An iterator over all contacts between two geometries.
     class ContactIterator : std::iterator<std::input_iterator_tag, dContact>
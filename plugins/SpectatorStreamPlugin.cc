@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
+#include <gazebo/common/Console.hh>
+#include <gazebo/common/VideoEncoder.hh>
+#include <gazebo/msgs/msgs.hh>
+#include <gazebo/rendering/Camera.hh>
+#include <gazebo/sensors/CameraSensor.hh>
+#include <gazebo/transport/transport.hh>
+
+#include "plugins/SpectatorStreamPlugin.hh"
+
+using namespace gazebo;
+GZ_REGISTER_SENSOR_PLUGIN(SpectatorStreamPlugin)
+
+namespace gazebo
+{
+  /// \brief Private data class for the SpectatorStreamPlugin class
+  class SpectatorStreamPluginPrivate
+  {
+    /// \brief Pointer to the parent camera sensor
+    public: sensors::CameraSensorPtr parentSensor;
+
+    /// \brief Connection to the new frames of the camera
+    public: event::ConnectionPtr newFrameConnection;
+
+    /// \brief Transport node used for publishing the video.
+    public: transport::NodePtr node;
+
+    /// \brief Publisher of the video.
+    public: transport::PublisherPtr videoPub;
+
+    /// \brief Topic of the video, empty for the default topic.
+    public: std::string topic;
+
+    /// \brief Encoder of the video.
+    public: common::VideoEncoder encoder;
+
+    /// \brief ffmpeg format of the stream.
+    public: std::string format = "mpegts";
+
+    /// \brief Bit rate of the video, 0 for a computed bit rate.
+    public: unsigned int bitRate = 0;
+
+    /// \brief Message that carries the bytes of the stream.
+    public: msgs::VideoStream msg;
+
+    /// \brief Time of the last frame given to the encoder.
+    public: common::Time frameTime;
+
+    /// \brief Protects the message and the time of the last frame.
+    public: std::mutex mutex;
+
+    /// \brief True once a warning about the image format was printed.
+    public: bool formatWarned = false;
+  };
+}
+
+/////////////////////////////////////////////////
+SpectatorStreamPlugin::SpectatorStreamPlugin()
+    : SensorPlugin(),
+      dataPtr(new SpectatorStreamPluginPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SpectatorStreamPlugin::~SpectatorStreamPlugin()
+{
+  // The encoder publishes from its own thread
+  this->dataPtr->newFrameConnection.reset();
+  this->dataPtr->encoder.Reset();
+
+  this->dataPtr->videoPub.reset();
+  if (this->dataPtr->node)
+    this->dataPtr->node->Fini();
+  this->dataPtr->parentSensor.reset();
+}
+
+/////////////////////////////////////////////////
+void SpectatorStreamPlugin::Load(sensors::SensorPtr _sensor,
+                                 sdf::ElementPtr _sdf)
+{
+  this->dataPtr->parentSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(_sensor);
+
+  if (!this->dataPtr->parentSensor || !this->dataPtr->parentSensor->Camera())
+  {
+    gzerr << "SpectatorStreamPlugin not attached to a camera sensor\n";
+    return;
+  }
+
+  if (_sdf->HasElement("format"))
+    this->dataPtr->format = _sdf->Get<std::string>("format");
+  if (_sdf->HasElement("bit_rate"))
+    this->dataPtr->bitRate = _sdf->Get<unsigned int>("bit_rate");
+  if (_sdf->HasElement("topic"))
+    this->dataPtr->topic = _sdf->Get<std::string>("topic");
+
+  this->dataPtr->encoder.SetStreamCallback(
+      std::bind(&SpectatorStreamPlugin::OnStream, this,
+        std::placeholders::_1, std::placeholders::_2));
+
+  this->dataPtr->newFrameConnection =
+      this->dataPtr->parentSensor->Camera()->ConnectNewImageFrame(
+      std::bind(&SpectatorStreamPlugin::OnNewFrame, this,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+
+  this->dataPtr->parentSensor->SetActive(true);
+}
+
+/////////////////////////////////////////////////
+void SpectatorStreamPlugin::Init()
+{
+  if (!this->dataPtr->parentSensor)
+    return;
+
+  this->dataPtr->node.reset(new transport::Node());
+  this->dataPtr->node->Init();
+
+  std::string topicName = this->dataPtr->topic;
+  if (topicName.empty())
+  {
+    topicName = "~/" + this->dataPtr->parentSensor->ParentName() + "/" +
+        this->dataPtr->parentSensor->Name() + "/video";
+
+    size_t pos;
+    while ((pos = topicName.find("::")) != std::string::npos)
+      topicName = topicName.substr(0, pos) + "/" + topicName.substr(pos+2);
+  }
+
+  this->dataPtr->videoPub =
+      this->dataPtr->node->Advertise<msgs::VideoStream>(topicName);
+}
+
+/////////////////////////////////////////////////
+void SpectatorStreamPlugin::OnNewFrame(const unsigned char *_image,
+    const unsigned int _width, const unsigned int _height,
+    const unsigned int /*_depth*/, const std::string &_format)
+{
+  if (!this->dataPtr->videoPub)
+    return;
+
+  if (_format != "R8G8B8")
+  {
+    if (!this->dataPtr->formatWarned)
+    {
+      gzwarn << "SpectatorStreamPlugin can't stream images of format["
+             << _format << "], only R8G8B8\n";
+      this->dataPtr->formatWarned = true;
+    }
+    return;
+  }
+
+  // Nobody watches, stop encoding until a viewer connects. Each viewer
+  // that connects to a stopped encoder gets the start of a new stream.
+  if (!this->dataPtr->videoPub->HasConnections())
+  {
+    if (this->dataPtr->encoder.IsEncoding())
+      this->dataPtr->encoder.Reset();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->frameTime =
+        this->dataPtr->parentSensor->LastMeasurementTime();
+  }
+
+  if (!this->dataPtr->encoder.IsEncoding())
+  {
+    const double rate = this->dataPtr->parentSensor->UpdateRate();
+    const unsigned int fps = rate > 0 ?
+        static_cast<unsigned int>(rate + 0.5) : VIDEO_ENCODER_FPS_DEFAULT;
+
+    {
+      std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+      this->dataPtr->msg.set_format(this->dataPtr->format);
+      this->dataPtr->msg.set_width(_width);
+      this->dataPtr->msg.set_height(_height);
+    }
+
+    if (!this->dataPtr->encoder.Start(this->dataPtr->format, "", _width,
+          _height, std::max(fps, 1u), this->dataPtr->bitRate))
+    {
+      gzerr << "Unable to stream the images of camera["
+            << this->dataPtr->parentSensor->Name() << "]\n";
+      this->dataPtr->videoPub.reset();
+      return;
+    }
+  }
+
+  // Frames that arrive while the encoder is busy are dropped
+  this->dataPtr->encoder.AddFrame(_image, _width, _height);
+}
+
+/////////////////////////////////////////////////
+void SpectatorStreamPlugin::OnStream(const unsigned char *_data,
+    const std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  msgs::Set(this->dataPtr->msg.mutable_time(), this->dataPtr->frameTime);
+  this->dataPtr->msg.set_data(_data, _size);
+  this->dataPtr->videoPub->Publish(this->dataPtr->msg);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_PLUGINS_SPECTATORSTREAMPLUGIN_HH_
+#define GAZEBO_PLUGINS_SPECTATORSTREAMPLUGIN_HH_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "gazebo/common/Plugin.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  // Forward declare private class.
+  class SpectatorStreamPluginPrivate;
+
+  /// \brief A camera sensor plugin that streams the images of the camera
+  /// as an encoded video, so that remote viewers don't need to render the
+  /// scene. The camera is rendered by gzserver, or by any process that
+  /// runs the sensors, and the video is published to a topic, e.g.
+  /// ~/camera_model_name/link_name/sensor_name/video. The message format is
+  /// VideoStream: the data of consecutive messages, joined together, is a
+  /// video that a player like ffplay can read.
+  ///
+  /// The video is only encoded while the topic has subscribers, and a new
+  /// stream starts when the first one connects. Streams favor latency,
+  /// see common::VideoEncoder::SetStreamCallback.
+  ///
+  /// Parameters:
+  ///   <format>   ffmpeg format of the stream, "mpegts" by default.
+  ///   <bit_rate> Bit rate of the video, 0 by default for a bit rate
+  ///              computed from the resolution.
+  ///   <topic>    Topic of the video, instead of the default topic.
+  ///
+  /// The camera must produce R8G8B8 images. The frame rate of the video is
+  /// the update rate of the sensor.
+  class GZ_PLUGIN_VISIBLE SpectatorStreamPlugin : public SensorPlugin
+  {
+    /// \brief Constructor
+    public: SpectatorStreamPlugin();
+
+    /// \brief Destructor
+    public: virtual ~SpectatorStreamPlugin();
+
+    // Documentation Inherited.
+    public: void Load(sensors::SensorPtr _sensor, sdf::ElementPtr _sdf);
+
+    // Documentation Inherited.
+    public: void Init();
+
+    /// \brief Callback when a new camera frame is available
+    /// \param[in] _image image data
+    /// \param[in] _width image width
+    /// \param[in] _height image height
+    /// \param[in] _depth image depth
+    /// \param[in] _format image format
+    public: virtual void OnNewFrame(const unsigned char *_image,
+        const unsigned int _width, const unsigned int _height,
+        const unsigned int _depth, const std::string &_format);
+
+    /// \brief Publish bytes of the stream.
+    /// \param[in] _data Bytes of the stream.
+    /// \param[in] _size Number of bytes.
+    private: void OnStream(const unsigned char *_data,
+        const std::size_t _size);
+
+    /// \internal
+    /// \brief Pointer to private data.
+    private: std::unique_ptr<SpectatorStreamPluginPrivate> dataPtr;
+  };
+}
+#endif
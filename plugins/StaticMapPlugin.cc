@@ -18,12 +18,17 @@
 #include <curl/curl.h>
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 #include <ignition/math/Vector2.hh>
 #include <gazebo/physics/physics.hh>
 #include <gazebo/common/CommonIface.hh>
+#include <gazebo/common/Events.hh>
 #include <gazebo/transport/Node.hh>
 
 #include "StaticMapPlugin.hh"
@@ -50,10 +55,23 @@ namespace gazebo
   };
 
 
+  /// \brief A map tile to fetch.
+  class MapTile
+  {
+    /// \brief URL of the tile image.
+    public: std::string url;
+
+    /// \brief Filename of the tile image in the model.
+    public: std::string filename;
+
+    /// \brief Filename of the tile image in the tile cache.
+    public: std::string cacheFilename;
+  };
+
   /// \brief Private data class for StaticMapPlugin
   class StaticMapPluginPrivate
   {
-    /// \brief Download map tiles.
+    /// \brief Compute the map tiles that cover the map.
     /// \param[in] _centerLat Latitude of center point of map
     /// \param[in] _centerLon Longitude of center point of map
     /// \param[in] _zoom Map zoom level between 0 (entire world) and 21+
@@ -64,15 +82,30 @@ namespace gazebo
     /// \param[in] _mapType Type of map to download: roadmap, satellite,
     /// terrain, hybrid
     /// \param[in] _apiKey Google API key
-    /// \param[in] _saveDirPath Location in local filesystem to save tile
-    /// images.
-    public: std::vector<std::string> DownloadMapTiles(const double _centerLat,
+    /// \return The tiles, row by row.
+    public: std::vector<MapTile> MapTiles(const double _centerLat,
         const double _centerLon, const unsigned int _zoom,
         const unsigned int _tileSizePx,
         const ignition::math::Vector2d &_worldSize,
-        const std::string &_mapType, const std::string &_apiKey,
+        const std::string &_mapType, const std::string &_apiKey) const;
+
+    /// \brief Fetch map tiles on several threads. Tiles found in the tile
+    /// cache are copied from it, and downloaded tiles are added to it.
+    /// \param[in] _tiles Tiles to fetch.
+    /// \param[in] _saveDirPath Location in local filesystem to save tile
+    /// images.
+    /// \return Number of tiles that could not be downloaded.
+    public: unsigned int FetchTiles(const std::vector<MapTile> &_tiles,
         const std::string &_saveDirPath);
 
+    /// \brief Fetch the tiles, then create the textured map model in the
+    /// gazebo model path. Runs on the fetch thread.
+    public: void BuildModel();
+
+    /// \brief Swap the textures of the tiles in, once the model is built.
+    /// Runs on the world update.
+    public: void OnUpdate();
+
     /// \brief Create textured map model and save it in specified path.
     /// \param[in] _name Name of map model
     /// \param[in] _tileWorldSize Size of map tiles in meters
@@ -95,12 +128,31 @@ namespace gazebo
     public: double GroundResolution(const double _lat,
         const unsigned int _zoom) const;
 
+    /// \brief Get the SDF of the map model.
+    /// \param[in] _name Name of map model
+    /// \param[in] _tileWorldSize Size of map tiles in meters
+    /// \param[in] _xNumTiles Number of tiles in x direction
+    /// \param[in] _yNumTiles Number of tiles in y direction
+    /// \param[in] _textured True to texture the tiles with the tile
+    /// images of the model, false for a placeholder material.
+    /// \return The model SDF.
+    public: std::string ModelSDF(const std::string &_name,
+        const double _tileWorldSize,
+        const unsigned int _xNumTiles, const unsigned int _yNumTiles,
+        const bool _textured) const;
+
     /// \brief Spawn a model into the world
     /// \param[in] _name Name of model
     /// \param[in] _pose Pose of model
     public: void SpawnModel(const std::string &_name,
         const ignition::math::Pose3d &_pose);
 
+    /// \brief Spawn a model from its SDF into the world
+    /// \param[in] _sdf SDF of model
+    /// \param[in] _pose Pose of model
+    public: void SpawnModelSDF(const std::string &_sdf,
+        const ignition::math::Pose3d &_pose);
+
     /// \brief Pointer to world.
     public: physics::WorldPtr world;
 
@@ -135,9 +187,6 @@ namespace gazebo
     /// \brief Google API key
     public: std::string apiKey;
 
-    /// \brief Filenames of map tile images
-    public: std::vector<std::string> mapTileFilenames;
-
     /// \brief Pointer to a node for communication.
     public: transport::NodePtr node;
 
@@ -146,6 +195,37 @@ namespace gazebo
 
     /// \brief True if the plugin is loaded successfully
     public: bool loaded = false;
+
+    /// \brief Number of tiles downloaded at once.
+    public: unsigned int downloadThreads = 8u;
+
+    /// \brief Tiles of the map, row by row.
+    public: std::vector<MapTile> tiles;
+
+    /// \brief Number of tiles in x direction
+    public: unsigned int xNumTiles = 0u;
+
+    /// \brief Number of tiles in y direction
+    public: unsigned int yNumTiles = 0u;
+
+    /// \brief Size of map tiles in meters
+    public: double tileWorldSize = 0.0;
+
+    /// \brief Thread that fetches the tiles and builds the model.
+    public: std::thread fetchThread;
+
+    /// \brief True to stop fetching tiles.
+    public: std::atomic<bool> stop{false};
+
+    /// \brief True once the textured model is in the gazebo model path.
+    public: std::atomic<bool> modelReady{false};
+
+    /// \brief True if curl was initialized by the plugin.
+    public: bool curlInitialized = false;
+
+    /// \brief Connection to the world update, while the textures of the
+    /// tiles are pending.
+    public: event::ConnectionPtr updateConnection;
   };
 }
 
@@ -163,25 +243,34 @@ size_t WriteData(void *_ptr, size_t _size, size_t _nmemb, FILE *_stream)
 }
 
 /////////////////////////////////////////////////
+/// \brief Download a file. Several files can be downloaded at once from
+/// different threads.
+/// \param[in] _url URL of the file
+/// \param[in] _outputFile Path of the downloaded file. The response is
+/// saved even if the request failed.
+/// \return True if the file was downloaded successfully.
 bool DownloadFile(const std::string &_url, const std::string &_outputFile)
 {
   if (_url.empty())
     return false;
 
-  CURL *curl = curl_easy_init();
-
-  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
-
   FILE *fp = fopen(_outputFile.c_str(), "wb");
   if (!fp)
   {
-    gzerr << "Could not download model[" << _url << "] because we were"
-      << "unable to write to file[" << _outputFile << "]."
-      << "Please fix file permissions.";
+    gzerr << "Could not download file because we were "
+      << "unable to write to file[" << _outputFile << "]. "
+      << "Please fix file permissions." << std::endl;
     return false;
   }
+
+  CURL *curl = curl_easy_init();
+
+  curl_easy_setopt(curl, CURLOPT_URL, _url.c_str());
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteData);
   curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+  // signals can't be used on the download threads
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
 
   char errbuf[CURL_ERROR_SIZE];
   // provide a buffer to store errors in
@@ -190,32 +279,31 @@ bool DownloadFile(const std::string &_url, const std::string &_outputFile)
   errbuf[0] = 0;
 
   CURLcode success = curl_easy_perform(curl);
-  if (success != CURLE_OK)
-  {
-    gzerr << "Error in REST request" << std::endl;
-    size_t len = strlen(errbuf);
-    fprintf(stderr, "\nlibcurl: (%d) ", success);
-    if (len)
-    {
-      fprintf(stderr, "%s%s", errbuf,
-              ((errbuf[len - 1] != '\n') ? "\n" : ""));
-    }
-    else
-      fprintf(stderr, "%s\n", curl_easy_strerror(success));
-  }
   fclose(fp);
 
-  // Update the status code.
-  int statusCode = 0;
+  // Get the status code.
+  int64_t statusCode = 0;
   curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
 
   // Cleaning.
   curl_easy_cleanup(curl);
 
+  if (success != CURLE_OK)
+  {
+    gzerr << "Error in REST request: "
+          << (errbuf[0] ? errbuf : curl_easy_strerror(success)) << std::endl;
+    return false;
+  }
+
+  if (statusCode != 200)
+  {
+    gzerr << "Error in REST request: status code " << statusCode << std::endl;
+    return false;
+  }
+
   return true;
 }
 
-
 /////////////////////////////////////////////////
 ignition::math::Vector2d MercatorProjection::LatLonToPoint(
     const ignition::math::SphericalCoordinates &_latLon)
@@ -261,6 +349,20 @@ StaticMapPlugin::StaticMapPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+StaticMapPlugin::~StaticMapPlugin()
+{
+  this->dataPtr->updateConnection.reset();
+
+  // tiles being downloaded are finished
+  this->dataPtr->stop = true;
+  if (this->dataPtr->fetchThread.joinable())
+    this->dataPtr->fetchThread.join();
+
+  if (this->dataPtr->curlInitialized)
+    curl_global_cleanup();
+}
+
 /////////////////////////////////////////////////
 void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -322,6 +424,12 @@ void StaticMapPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   if (_sdf->HasElement("use_cache"))
     this->dataPtr->useCache = _sdf->Get<bool>("use_cache");
 
+  if (_sdf->HasElement("download_threads"))
+  {
+    this->dataPtr->downloadThreads =
+        std::max(1u, _sdf->Get<unsigned int>("download_threads"));
+  }
+
   if (_sdf->HasElement("pose"))
     this->dataPtr->modelPose = _sdf->Get<ignition::math::Pose3d>("pose");
 
@@ -367,74 +475,146 @@ void StaticMapPlugin::Init()
     return;
   }
 
-
-  // create tmp dir to save model files
-  boost::filesystem::path tmpModelPath =
-      boost::filesystem::temp_directory_path() / this->dataPtr->modelName;
-  boost::filesystem::path scriptsPath(tmpModelPath / "materials" / "scripts");
-  boost::filesystem::create_directories(scriptsPath);
-  boost::filesystem::path texturesPath(tmpModelPath / "materials" / "textures");
-  boost::filesystem::create_directories(texturesPath);
-
-  // download map tile images into model/materials/textures
-  std::vector<std::string> tiles = this->dataPtr->DownloadMapTiles(
+  this->dataPtr->tiles = this->dataPtr->MapTiles(
       this->dataPtr->center.X(),
       this->dataPtr->center.Y(),
       this->dataPtr->zoom,
       this->dataPtr->tileSizePx,
       this->dataPtr->worldSize,
       this->dataPtr->mapType,
-      this->dataPtr->apiKey,
-      texturesPath.string());
+      this->dataPtr->apiKey);
 
   // assume square model for now
-  unsigned int xNumTiles = std::sqrt(tiles.size());
-  unsigned int yNumTiles = xNumTiles;
+  this->dataPtr->xNumTiles = std::sqrt(this->dataPtr->tiles.size());
+  this->dataPtr->yNumTiles = this->dataPtr->xNumTiles;
 
-  double tileWorldSize = this->dataPtr->GroundResolution(
+  this->dataPtr->tileWorldSize = this->dataPtr->GroundResolution(
       IGN_DTOR(this->dataPtr->center.X()), this->dataPtr->zoom)
       * this->dataPtr->tileSizePx;
 
-  // create model and spawn it into the world
-  if (this->dataPtr->CreateMapTileModel(
-      this->dataPtr->modelName, tileWorldSize,
-      xNumTiles, yNumTiles, tiles, tmpModelPath.string()))
+  // spawn the model right away, with a placeholder material that is
+  // replaced by the tiles once they are fetched
+  this->dataPtr->SpawnModelSDF(this->dataPtr->ModelSDF(
+      this->dataPtr->modelName, this->dataPtr->tileWorldSize,
+      this->dataPtr->xNumTiles, this->dataPtr->yNumTiles, false),
+      this->dataPtr->modelPose);
+
+  this->dataPtr->curlInitialized = curl_global_init(CURL_GLOBAL_ALL) == 0;
+  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&StaticMapPluginPrivate::OnUpdate, this->dataPtr.get()));
+  this->dataPtr->fetchThread = std::thread(
+      &StaticMapPluginPrivate::BuildModel, this->dataPtr.get());
+}
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::BuildModel()
+{
+  auto basePath = common::SystemPaths::Instance()->GetLogPath() /
+        boost::filesystem::path("models");
+  boost::filesystem::path modelPath = basePath / this->modelName;
+
+  // create tmp dir to save model files
+  boost::filesystem::path tmpModelPath =
+      boost::filesystem::temp_directory_path() / this->modelName;
+  boost::filesystem::path scriptsPath(tmpModelPath / "materials" / "scripts");
+  boost::filesystem::create_directories(scriptsPath);
+  boost::filesystem::path texturesPath(tmpModelPath / "materials" / "textures");
+  boost::filesystem::create_directories(texturesPath);
+
+  // fetch map tile images into model/materials/textures
+  unsigned int failed = this->FetchTiles(this->tiles, texturesPath.string());
+  if (this->stop)
+    return;
+  if (failed > 0)
+  {
+    gzerr << failed << " of " << this->tiles.size()
+          << " map tiles could not be downloaded" << std::endl;
+  }
+
+  std::vector<std::string> tileFilenames;
+  for (auto const &tile : this->tiles)
+    tileFilenames.push_back(tile.filename);
+
+  // create model
+  if (!this->CreateMapTileModel(this->modelName, this->tileWorldSize,
+      this->xNumTiles, this->yNumTiles, tileFilenames, tmpModelPath.string()))
   {
-    // verify model dir is created
-    if (common::exists(tmpModelPath.string()))
+    return;
+  }
+
+  // verify model dir is created
+  if (!common::exists(tmpModelPath.string()))
+  {
+    gzerr << "Failed to create model: " << tmpModelPath.string() << std::endl;
+    return;
+  }
+
+  // remove existing map model
+  if (common::exists(modelPath.string()))
+    boost::filesystem::remove_all(modelPath);
+
+  try
+  {
+    // move new map model to gazebo model path
+    boost::filesystem::rename(tmpModelPath, modelPath);
+  }
+  catch(boost::filesystem::filesystem_error &_e)
+  {
+    // rename failed. Could be an invalid cross-device link error
+    // try copy and remove method
+    bool result = common::copyDir(tmpModelPath, modelPath);
+    if (result)
+    {
+      boost::filesystem::remove_all(tmpModelPath);
+    }
+    else
     {
-      // remove existing map model
-      if (common::exists(modelPath.string()))
-        boost::filesystem::remove_all(modelPath);
+      gzerr<< "Unable to copy model from '" << tmpModelPath.string()
+             << "' to '" << modelPath.string() << "'" << std::endl;
+      return;
+    }
+  }
 
-      try
-      {
-        // move new map model to gazebo model path
-        boost::filesystem::rename(tmpModelPath, modelPath);
-      }
-      catch(boost::filesystem::filesystem_error &_e)
+  this->modelReady = true;
+}
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::OnUpdate()
+{
+  if (!this->modelReady)
+    return;
+
+  // the placeholder model may not be inserted yet
+  physics::ModelPtr model = this->world->ModelByName(this->modelName);
+  if (!model)
+    return;
+
+  physics::LinkPtr link = model->GetLink("link");
+  if (link)
+  {
+    for (unsigned int i = 0; i < this->yNumTiles; ++i)
+    {
+      for (unsigned int j = 0; j < this->xNumTiles; ++j)
       {
-        // rename failed. Could be an invalid cross-device link error
-        // try copy and remove method
-        bool result = common::copyDir(tmpModelPath, modelPath);
-        if (result)
-        {
-          boost::filesystem::remove_all(tmpModelPath);
-        }
-        else
-        {
-          gzerr<< "Unable to copy model from '" << tmpModelPath.string()
-                 << "' to '" << modelPath.string() << "'" << std::endl;
-          return;
-        }
+        std::stringstream name;
+        name << i << "_" << j;
+        uint32_t id;
+        if (!link->VisualId("visual" + name.str(), id))
+          continue;
+
+        msgs::Material material;
+        material.mutable_script()->add_uri(
+            "model://" + this->modelName + "/materials/scripts");
+        material.mutable_script()->add_uri(
+            "model://" + this->modelName + "/materials/textures");
+        material.mutable_script()->set_name(
+            this->modelName + "/" + name.str());
+        link->SetVisualMaterial(id, material);
       }
-      // spawn the model
-      this->dataPtr->SpawnModel("model://" + this->dataPtr->modelName,
-          this->dataPtr->modelPose);
     }
-    else
-      gzerr << "Failed to create model: " << tmpModelPath.string() << std::endl;
   }
+
+  this->updateConnection.reset();
 }
 
 /////////////////////////////////////////////////
@@ -448,11 +628,11 @@ double StaticMapPluginPrivate::GroundResolution(const double _lat,
 }
 
 /////////////////////////////////////////////////
-std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
+std::vector<MapTile> StaticMapPluginPrivate::MapTiles(
     const double _centerLat, const double _centerLon,
     const unsigned int _zoom, const unsigned int _tileSizePx,
     const ignition::math::Vector2d &_worldSize, const std::string &_mapType,
-    const std::string &_apiKey, const std::string &_saveDirPath)
+    const std::string &_apiKey) const
 {
   ignition::math::Angle lonAngle;
   ignition::math::Angle latAngle;
@@ -493,7 +673,8 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
     y += halfTileSize;
   double startx = x;
 
-  // download map tiles using google static map API
+  // map tiles of the google static map API
+  std::vector<MapTile> mapTiles;
   std::string url = "https://maps.googleapis.com/maps/api/staticmap";
   for (unsigned int i = 0; i < yNumTiles; ++i)
   {
@@ -505,7 +686,7 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
       // convert world point to lat lon
       auto latLon = MercatorProjection::PointToLatLon(point);
 
-      // download tile image
+      // tile image
       std::stringstream query;
       query << "?center="
             << std::setprecision(9)
@@ -520,17 +701,83 @@ std::vector<std::string> StaticMapPluginPrivate::DownloadMapTiles(
       filename << "tile_"
                << std::setprecision(9) << latLon.LatitudeReference().Degree()
                << "_" << latLon.LongitudeReference().Degree() << ".png";
-      std::string fullPath = _saveDirPath + "/" + filename.str();
-      DownloadFile(fullURL, fullPath);
-      gzmsg << "Downloading map tile: " << filename.str() << std::endl;
-      mapTileFilenames.push_back(filename.str());
+      // tiles are cached by center, zoom, size and map type
+      std::stringstream cacheFilename;
+      cacheFilename << _mapType << "_" << _zoom << "_" << _tileSizePx << "_"
+                    << filename.str();
+
+      MapTile tile;
+      tile.url = fullURL;
+      tile.filename = filename.str();
+      tile.cacheFilename = cacheFilename.str();
+      mapTiles.push_back(tile);
 
       x += _tileSizePx;
     }
     x = startx;
     y += _tileSizePx;
   }
-  return mapTileFilenames;
+  return mapTiles;
+}
+
+/////////////////////////////////////////////////
+unsigned int StaticMapPluginPrivate::FetchTiles(
+    const std::vector<MapTile> &_tiles, const std::string &_saveDirPath)
+{
+  boost::filesystem::path cachePath =
+      common::SystemPaths::Instance()->GetLogPath() /
+      boost::filesystem::path("tile_cache");
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(cachePath, ec);
+
+  std::atomic<std::size_t> next(0);
+  std::atomic<unsigned int> failed(0);
+  auto fetch = [&]()
+  {
+    for (std::size_t i = next++; i < _tiles.size() && !this->stop; i = next++)
+    {
+      const MapTile &tile = _tiles[i];
+      boost::filesystem::path cached = cachePath / tile.cacheFilename;
+      boost::filesystem::path saved =
+          boost::filesystem::path(_saveDirPath) / tile.filename;
+
+      boost::system::error_code copyError;
+      if (boost::filesystem::exists(cached))
+      {
+        boost::filesystem::remove(saved, copyError);
+        boost::filesystem::copy_file(cached, saved, copyError);
+        if (!copyError)
+          continue;
+      }
+
+      gzmsg << "Downloading map tile: " << tile.filename << std::endl;
+      if (!DownloadFile(tile.url, saved.string()))
+      {
+        ++failed;
+        continue;
+      }
+
+      // add the tile to the cache through a temporary file, so that the
+      // cache never holds a partial tile
+      boost::filesystem::path part = cached;
+      part += ".part";
+      boost::filesystem::remove(part, copyError);
+      boost::filesystem::copy_file(saved, part, copyError);
+      if (!copyError)
+        boost::filesystem::rename(part, cached, copyError);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  const unsigned int threadCount = std::min<std::size_t>(
+      this->downloadThreads, _tiles.size());
+  for (unsigned int i = 1; i < threadCount; ++i)
+    threads.push_back(std::thread(fetch));
+  fetch();
+  for (auto &thread : threads)
+    thread.join();
+
+  return failed;
 }
 
 /////////////////////////////////////////////////
@@ -578,7 +825,61 @@ bool StaticMapPluginPrivate::CreateMapTileModel(
   scriptFile << materialScriptStr.str();
   scriptFile.close();
 
-  // create model.sdf file
+  // save model.sdf file to disk
+  boost::filesystem::path modelSDFFilePath(_modelPath);
+  modelSDFFilePath /= "model.sdf";
+  std::ofstream modelSDFFile;
+  modelSDFFile.open(modelSDFFilePath.string().c_str());
+  if (!modelSDFFile.is_open())
+  {
+    gzerr << "Couldn't open file for writing: " << modelSDFFilePath.string()
+          << std::endl;
+    return false;
+  }
+  modelSDFFile << this->ModelSDF(_name, _tileWorldSize, _xNumTiles,
+      _yNumTiles, true);
+  modelSDFFile.close();
+
+  // create model.config file
+  std::ostringstream modelConfigStr;
+  modelConfigStr << "<?xml version=\"1.0\"?>\n"
+  << "<model>\n"
+  << "  <name>" << _name << "</name>\n"
+  << "  <version>1.0</version>\n"
+  << "  <sdf version=\"" << SDF_VERSION << "\">model.sdf</sdf>\n"
+  << "  <author>\n"
+  << "    <name>gazebo</name>\n"
+  << "    <email></email>\n"
+  << "  </author>\n"
+  << "  <description>\n"
+  << "    Made with Gazebo using Google Static Map API. "
+  <<     "https://developers.google.com/maps/documentation/static-maps\n"
+  << "  </description>\n"
+  << "</model>";
+
+  // save model.config file to disk
+  boost::filesystem::path modelConfigFilePath(_modelPath);
+  modelConfigFilePath /= "model.config";
+  std::ofstream modelConfigFile;
+  modelConfigFile.open(modelConfigFilePath.string().c_str());
+  if (!modelConfigFile.is_open())
+  {
+    gzerr << "Couldn't open file for writing: "
+        << modelConfigFilePath.string() << std::endl;
+    return false;
+  }
+  modelConfigFile << modelConfigStr.str();
+  modelConfigFile.close();
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::string StaticMapPluginPrivate::ModelSDF(const std::string &_name,
+    const double _tileWorldSize,
+    const unsigned int _xNumTiles, const unsigned int _yNumTiles,
+    const bool _textured) const
+{
   double sizeX = _tileWorldSize;
   double sizeY = _tileWorldSize;
   double sizeZ = 1.0;
@@ -632,10 +933,22 @@ bool StaticMapPluginPrivate::CreateMapTileModel(
         "        </box>\n"
         "      </geometry>\n"
         "      <material>\n"
-        "        <script>\n"
-        "          <uri>model://" << _name << "/materials/scripts</uri>\n"
-        "          <uri>model://" << _name << "/materials/textures</uri>\n"
-        "          <name>" << _name << "/" << i << "_" << j << "</name>\n"
+        "        <script>\n";
+      if (_textured)
+      {
+        newModelStr <<
+          "          <uri>model://" << _name << "/materials/scripts</uri>\n"
+          "          <uri>model://" << _name << "/materials/textures</uri>\n"
+          "          <name>" << _name << "/" << i << "_" << j << "</name>\n";
+      }
+      else
+      {
+        newModelStr <<
+          "          <uri>file://media/materials/scripts/gazebo.material"
+          "</uri>\n"
+          "          <name>Gazebo/Grey</name>\n";
+      }
+      newModelStr <<
         "        </script>\n"
         "      </material>\n"
         "    </visual>\n";
@@ -649,54 +962,10 @@ bool StaticMapPluginPrivate::CreateMapTileModel(
     "</model>\n"
     "</sdf>";
 
-  // save model.sdf file to disk
-  boost::filesystem::path modelSDFFilePath(_modelPath);
-  modelSDFFilePath /= "model.sdf";
-  std::ofstream modelSDFFile;
-  modelSDFFile.open(modelSDFFilePath.string().c_str());
-  if (!modelSDFFile.is_open())
-  {
-    gzerr << "Couldn't open file for writing: " << modelSDFFilePath.string()
-          << std::endl;
-    return false;
-  }
-  modelSDFFile << newModelStr.str();
-  modelSDFFile.close();
-
-  // create model.config file
-  std::ostringstream modelConfigStr;
-  modelConfigStr << "<?xml version=\"1.0\"?>\n"
-  << "<model>\n"
-  << "  <name>" << _name << "</name>\n"
-  << "  <version>1.0</version>\n"
-  << "  <sdf version=\"" << SDF_VERSION << "\">model.sdf</sdf>\n"
-  << "  <author>\n"
-  << "    <name>gazebo</name>\n"
-  << "    <email></email>\n"
-  << "  </author>\n"
-  << "  <description>\n"
-  << "    Made with Gazebo using Google Static Map API. "
-  <<     "https://developers.google.com/maps/documentation/static-maps\n"
-  << "  </description>\n"
-  << "</model>";
-
-  // save model.config file to disk
-  boost::filesystem::path modelConfigFilePath(_modelPath);
-  modelConfigFilePath /= "model.config";
-  std::ofstream modelConfigFile;
-  modelConfigFile.open(modelConfigFilePath.string().c_str());
-  if (!modelConfigFile.is_open())
-  {
-    gzerr << "Couldn't open file for writing: "
-        << modelConfigFilePath.string() << std::endl;
-    return false;
-  }
-  modelConfigFile << modelConfigStr.str();
-  modelConfigFile.close();
-
-  return true;
+  return newModelStr.str();
 }
 
+
 /////////////////////////////////////////////////
 void StaticMapPluginPrivate::SpawnModel(const std::string &_uri,
     const ignition::math::Pose3d &_pose)
@@ -707,3 +976,14 @@ void StaticMapPluginPrivate::SpawnModel(const std::string &_uri,
   msgs::Set(msg.mutable_pose(), _pose);
   this->factoryPub->Publish(msg);
 }
+
+/////////////////////////////////////////////////
+void StaticMapPluginPrivate::SpawnModelSDF(const std::string &_sdf,
+    const ignition::math::Pose3d &_pose)
+{
+  // publish to factory topic to spawn the model
+  msgs::Factory msg;
+  msg.set_sdf(_sdf);
+  msgs::Set(msg.mutable_pose(), _pose);
+  this->factoryPub->Publish(msg);
+}
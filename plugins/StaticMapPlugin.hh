@@ -52,11 +52,21 @@ namespace gazebo
   ///              API documentation for more details.
   /// <use_cache>  Use model in gazebo model path if exists, otherwise
   ///              recreate the model and save it in <HOME>/.gazebo/models
+  /// <download_threads> Number of tiles downloaded at once. Defaults to 8.
+  ///
+  /// When the model is recreated, it is spawned right away with a
+  /// placeholder material. The tiles are fetched in the background, and
+  /// their textures replace the placeholder once the model is saved. Tiles
+  /// are cached in <HOME>/.gazebo/tile_cache by center, zoom, size and map
+  /// type, so only new tiles are downloaded.
   class GZ_PLUGIN_VISIBLE StaticMapPlugin : public WorldPlugin
   {
     /// \brief Constructor.
     public: StaticMapPlugin();
 
+    /// \brief Destructor.
+    public: ~StaticMapPlugin();
+
     /// \brief Load the plugin.
     /// \param[in] _world Pointer to world
     /// \param[in] _sdf Pointer to the SDF configuration.
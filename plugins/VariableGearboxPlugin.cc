@@ -179,7 +179,7 @@ void VariableGearboxPlugin::Load(physics::ModelPtr _parent,
     gzerr << "Could not find a joint named " << jointName
           << ", but found joints named:"
           << std::endl;
-    for (auto j : this->dataPtr->model->GetJoints())
+    for (auto const &j : this->dataPtr->model->GetJoints())
     {
       gzerr << "  " << j->GetName() << std::endl;
     }
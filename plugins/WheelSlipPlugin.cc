@@ -14,8 +14,12 @@
  * limitations under the License.
  *
 */
+#include <functional>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Profiler.hh>
 
@@ -51,57 +55,159 @@ namespace gazebo
     typedef boost::weak_ptr<physics::ODESurfaceParams> ODESurfaceParamsWeakPtr;
   }
 
-  class WheelSlipPluginPrivate
+  /// \brief A wheel of the wheel table. The table doesn't keep the
+  /// entities of the wheel alive, and drops the wheel once they are
+  /// deleted.
+  class WheelSlipWheel
   {
-    public: class LinkSurfaceParams
-    {
-      /// \brief Pointer to wheel spin joint.
-      public: physics::JointWeakPtr joint;
+    /// \brief Wheel link.
+    public: physics::LinkWeakPtr link;
+
+    /// \brief Wheel spin joint.
+    public: physics::JointWeakPtr joint;
 
-      /// \brief Pointer to ODESurfaceParams object.
-      public: physics::ODESurfaceParamsWeakPtr surface;
+    /// \brief ODESurfaceParams object of the wheel collision.
+    public: physics::ODESurfaceParamsWeakPtr surface;
 
-      /// \brief Unitless wheel slip compliance in lateral direction.
-      /// The parameter should be non-negative,
-      /// with a value of zero allowing no slip
-      /// and larger values allowing increasing slip.
-      public: double slipComplianceLateral = 0;
+    /// \brief Unitless wheel slip compliance in lateral direction.
+    /// The parameter should be non-negative,
+    /// with a value of zero allowing no slip
+    /// and larger values allowing increasing slip.
+    public: double slipComplianceLateral = 0;
 
-      /// \brief Unitless wheel slip compliance in longitudinal direction.
-      /// The parameter should be non-negative,
-      /// with a value of zero allowing no slip
-      /// and larger values allowing increasing slip.
-      public: double slipComplianceLongitudinal = 0;
+    /// \brief Unitless wheel slip compliance in longitudinal direction.
+    /// The parameter should be non-negative,
+    /// with a value of zero allowing no slip
+    /// and larger values allowing increasing slip.
+    public: double slipComplianceLongitudinal = 0;
 
-      /// \brief Wheel normal force estimate used to compute slip
-      /// compliance for ODE, which takes units of 1/N.
-      public: double wheelNormalForce = 0;
+    /// \brief Wheel normal force estimate used to compute slip
+    /// compliance for ODE, which takes units of 1/N.
+    public: double wheelNormalForce = 0;
 
-      /// \brief Wheel radius extracted from collision shape if not
-      /// specified as xml parameter.
-      public: double wheelRadius = 0;
+    /// \brief Wheel radius extracted from collision shape if not
+    /// specified as xml parameter.
+    public: double wheelRadius = 0;
+
+    /// \brief Publish slip for each wheel.
+    public: transport::PublisherPtr slipPub;
+  };
 
-      /// \brief Publish slip for each wheel.
-      public: transport::PublisherPtr slipPub;
-    };
+  /// \brief A vehicle of the wheel table.
+  class WheelSlipVehicle
+  {
+    /// \brief Parent model.
+    public: physics::ModelWeakPtr model;
 
     /// \brief Initial gravity direction in parent model frame.
     public: ignition::math::Vector3d initialGravityDirection;
 
+    /// \brief Wheels of the vehicle.
+    public: std::vector<WheelSlipWheel> wheels;
+  };
+
+  /// \brief The wheels of all the vehicles of a world, updated in a single
+  /// pass per step with one lock, instead of one update per plugin.
+  class WheelSlipTable
+  {
+    /// \brief Get the table of a world, created the first time.
+    /// \param[in] _world The world.
+    /// \return The table.
+    public: static std::shared_ptr<WheelSlipTable> Get(
+                const physics::WorldPtr &_world);
+
+    /// \brief Constructor.
+    /// \param[in] _world The world.
+    public: explicit WheelSlipTable(const physics::WorldPtr &_world);
+
+    /// \brief Destructor.
+    public: ~WheelSlipTable();
+
+    /// \brief Add a vehicle.
+    /// \param[in] _vehicle The vehicle.
+    /// \return Id of the vehicle.
+    public: int Add(const WheelSlipVehicle &_vehicle);
+
+    /// \brief Remove a vehicle.
+    /// \param[in] _id Id of the vehicle.
+    public: void Remove(const int _id);
+
+    /// \brief Get the slips of the wheels of a vehicle.
+    /// \param[in] _id Id of the vehicle.
+    /// \param[out] _out Map of wheel name to a Vector3 of slip velocities.
+    public: void Slips(const int _id,
+                std::map<std::string, ignition::math::Vector3d> &_out) const;
+
+    /// \brief Set the lateral slip compliance of the wheels of a vehicle.
+    /// \param[in] _id Id of the vehicle.
+    /// \param[in] _compliance Unitless slip compliance.
+    public: void SetSlipComplianceLateral(const int _id,
+                const double _compliance);
+
+    /// \brief Set the longitudinal slip compliance of the wheels of a
+    /// vehicle.
+    /// \param[in] _id Id of the vehicle.
+    /// \param[in] _compliance Unitless slip compliance.
+    public: void SetSlipComplianceLongitudinal(const int _id,
+                const double _compliance);
+
+    /// \brief Update the slip parameters of all the wheels and publish
+    /// their slips. The vehicles whose model was deleted, and the wheels
+    /// whose link, joint or collision was deleted, are dropped.
+    private: void Update();
+
+    /// \brief Compute the slip of a wheel.
+    /// \param[in] _vehicle The vehicle.
+    /// \param[in] _modelWorldPose World pose of the vehicle model.
+    /// \param[in] _link Link of the wheel.
+    /// \param[in] _joint Spin joint of the wheel.
+    /// \param[in] _wheelRadius Radius of the wheel.
+    /// \return Slip velocities of the wheel.
+    private: static ignition::math::Vector3d Slip(
+                 const WheelSlipVehicle &_vehicle,
+                 const ignition::math::Pose3d &_modelWorldPose,
+                 const physics::LinkPtr &_link,
+                 const physics::JointPtr &_joint,
+                 const double _wheelRadius);
+
+    /// \brief Tables of the worlds.
+    private: static std::map<physics::World *,
+                 std::weak_ptr<WheelSlipTable>> tables;
+
+    /// \brief Protects the tables.
+    private: static std::mutex tablesMutex;
+
+    /// \brief The world.
+    private: physics::World *world;
+
+    /// \brief Vehicles, by id.
+    private: std::map<int, WheelSlipVehicle> vehicles;
+
+    /// \brief Id of the next vehicle.
+    private: int nextId = 0;
+
+    /// \brief Protect data access during transport callbacks
+    private: mutable std::mutex mutex;
+
+    /// \brief Pointer to the update event connection
+    private: event::ConnectionPtr updateConnection;
+  };
+
+  class WheelSlipPluginPrivate
+  {
     /// \brief Model pointer.
     public: physics::ModelWeakPtr model;
 
-    /// \brief Protect data access during transport callbacks
-    public: std::mutex mutex;
+    /// \brief Wheel table of the world.
+    public: std::shared_ptr<WheelSlipTable> table;
+
+    /// \brief Id of the vehicle in the wheel table.
+    public: int vehicleId = -1;
 
     /// \brief Gazebo communication node
     /// \todo: Transition to ignition-transport in gazebo8
     public: transport::NodePtr gzNode;
 
-    /// \brief Link and surface pointers to update.
-    public: std::map<physics::LinkWeakPtr,
-                        LinkSurfaceParams> mapLinkSurfaceParams;
-
     /// \brief Lateral slip compliance subscriber.
     /// \todo: Transition to ignition-transport in gazebo8.
     public: transport::SubscriberPtr lateralComplianceSub;
@@ -109,9 +215,6 @@ namespace gazebo
     /// \brief Longitudinal slip compliance subscriber.
     /// \todo: Transition to ignition-transport in gazebo8.
     public: transport::SubscriberPtr longitudinalComplianceSub;
-
-    /// \brief Pointer to the update event connection
-    public: event::ConnectionPtr updateConnection;
   };
 }
 
@@ -120,6 +223,216 @@ using namespace gazebo;
 // Register the plugin
 GZ_REGISTER_MODEL_PLUGIN(WheelSlipPlugin)
 
+std::map<physics::World *, std::weak_ptr<WheelSlipTable>>
+    WheelSlipTable::tables;
+std::mutex WheelSlipTable::tablesMutex;
+
+/////////////////////////////////////////////////
+std::shared_ptr<WheelSlipTable> WheelSlipTable::Get(
+    const physics::WorldPtr &_world)
+{
+  std::lock_guard<std::mutex> lock(tablesMutex);
+  std::shared_ptr<WheelSlipTable> table = tables[_world.get()].lock();
+  if (!table)
+  {
+    table = std::make_shared<WheelSlipTable>(_world);
+    tables[_world.get()] = table;
+  }
+  return table;
+}
+
+/////////////////////////////////////////////////
+WheelSlipTable::WheelSlipTable(const physics::WorldPtr &_world)
+  : world(_world.get())
+{
+  // Before the collisions, which read the slip parameters of the
+  // surfaces when they create contact joints
+  this->updateConnection = event::Events::ConnectWorldUpdateBegin(
+      std::bind(&WheelSlipTable::Update, this));
+}
+
+/////////////////////////////////////////////////
+WheelSlipTable::~WheelSlipTable()
+{
+  std::lock_guard<std::mutex> lock(tablesMutex);
+  auto iter = tables.find(this->world);
+  if (iter != tables.end() && iter->second.expired())
+    tables.erase(iter);
+}
+
+/////////////////////////////////////////////////
+int WheelSlipTable::Add(const WheelSlipVehicle &_vehicle)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->vehicles[this->nextId] = _vehicle;
+  return this->nextId++;
+}
+
+/////////////////////////////////////////////////
+void WheelSlipTable::Remove(const int _id)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->vehicles.erase(_id);
+}
+
+/////////////////////////////////////////////////
+ignition::math::Vector3d WheelSlipTable::Slip(
+    const WheelSlipVehicle &_vehicle,
+    const ignition::math::Pose3d &_modelWorldPose,
+    const physics::LinkPtr &_link,
+    const physics::JointPtr &_joint,
+    const double _wheelRadius)
+{
+  // Compute wheel velocity in parent model frame
+  auto wheelWorldLinearVel = _link->WorldLinearVel();
+  auto wheelModelLinearVel =
+      _modelWorldPose.Rot().RotateVectorReverse(wheelWorldLinearVel);
+  // Compute wheel spin axis in parent model frame
+  auto wheelWorldAxis = _joint->GlobalAxis(0).Normalized();
+  auto wheelModelAxis =
+      _modelWorldPose.Rot().RotateVectorReverse(wheelWorldAxis);
+  // Estimate longitudinal direction as cross product of initial gravity
+  // direction with wheel spin axis.
+  auto longitudinalModelAxis =
+      _vehicle.initialGravityDirection.Cross(wheelModelAxis);
+
+  double spinSpeed = _wheelRadius * _joint->GetVelocity(0);
+  double lateralSpeed = wheelModelAxis.Dot(wheelModelLinearVel);
+  double longitudinalSpeed = longitudinalModelAxis.Dot(wheelModelLinearVel);
+
+  ignition::math::Vector3d slip;
+  slip.X(longitudinalSpeed - spinSpeed);
+  slip.Y(lateralSpeed);
+  slip.Z(spinSpeed);
+  return slip;
+}
+
+/////////////////////////////////////////////////
+void WheelSlipTable::Slips(const int _id,
+    std::map<std::string, ignition::math::Vector3d> &_out) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->vehicles.find(_id);
+  if (iter == this->vehicles.end())
+    return;
+
+  const WheelSlipVehicle &vehicle = iter->second;
+  physics::ModelPtr model = vehicle.model.lock();
+  if (!model)
+    return;
+
+  auto modelWorldPose = model->WorldPose();
+  for (const auto &wheel : vehicle.wheels)
+  {
+    physics::LinkPtr link = wheel.link.lock();
+    physics::JointPtr joint = wheel.joint.lock();
+    if (!link || !joint)
+      continue;
+
+    _out[link->GetName()] =
+        Slip(vehicle, modelWorldPose, link, joint, wheel.wheelRadius);
+  }
+}
+
+/////////////////////////////////////////////////
+void WheelSlipTable::SetSlipComplianceLateral(const int _id,
+    const double _compliance)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->vehicles.find(_id);
+  if (iter == this->vehicles.end())
+    return;
+
+  for (auto &wheel : iter->second.wheels)
+    wheel.slipComplianceLateral = _compliance;
+}
+
+/////////////////////////////////////////////////
+void WheelSlipTable::SetSlipComplianceLongitudinal(const int _id,
+    const double _compliance)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->vehicles.find(_id);
+  if (iter == this->vehicles.end())
+    return;
+
+  for (auto &wheel : iter->second.wheels)
+    wheel.slipComplianceLongitudinal = _compliance;
+}
+
+/////////////////////////////////////////////////
+void WheelSlipTable::Update()
+{
+  IGN_PROFILE("WheelSlipTable::Update");
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto iter = this->vehicles.begin(); iter != this->vehicles.end();)
+  {
+    WheelSlipVehicle &vehicle = iter->second;
+    physics::ModelPtr model = vehicle.model.lock();
+    if (!model)
+    {
+      // The model was deleted before its plugin removed the vehicle
+      iter = this->vehicles.erase(iter);
+      continue;
+    }
+    ++iter;
+
+    // The model pose is shared by the wheels of the vehicle
+    auto modelWorldPose = model->WorldPose();
+    for (auto wheelIter = vehicle.wheels.begin();
+         wheelIter != vehicle.wheels.end();)
+    {
+      const WheelSlipWheel &wheel = *wheelIter;
+      physics::LinkPtr link = wheel.link.lock();
+      physics::JointPtr joint = wheel.joint.lock();
+      physics::ODESurfaceParamsPtr surface = wheel.surface.lock();
+      if (!link || !joint || !surface)
+      {
+        wheelIter = vehicle.wheels.erase(wheelIter);
+        continue;
+      }
+      ++wheelIter;
+
+      // get user-defined normal force constant
+      double force = wheel.wheelNormalForce;
+
+      // get link angular velocity parallel to joint axis
+      ignition::math::Vector3d wheelAngularVelocity =
+          link->WorldAngularVel();
+      ignition::math::Vector3d jointAxis = joint->GlobalAxis(0);
+      double spinAngularVelocity = wheelAngularVelocity.Dot(jointAxis);
+
+      // As discussed in WheelSlipPlugin.hh, the ODE slip1 and slip2
+      // parameters have units of inverse viscous damping:
+      // [linear velocity / force] or [m / s / N].
+      // Since the slip compliance parameters supplied to the plugin
+      // are unitless, they must be scaled by a linear speed and force
+      // magnitude before being passed to ODE.
+      // The force is taken from a user-defined constant that should roughly
+      // match the steady-state normal force at the wheel.
+      // The linear speed is computed dynamically at each time step as
+      // radius * spin angular velocity.
+      // This choice of linear speed corresponds to the denominator of
+      // the slip ratio during acceleration (see equation (1) in
+      // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
+      // "Motion dynamics of a rover with slip-based traction model").
+      // The acceleration form is more well-behaved numerically at low-speed
+      // and when the vehicle is at rest than the braking form,
+      // so it is used for both slip directions.
+      double speed = wheel.wheelRadius * std::abs(spinAngularVelocity);
+      surface->slip1 = speed / force * wheel.slipComplianceLateral;
+      surface->slip2 = speed / force * wheel.slipComplianceLongitudinal;
+
+      // Try to publish slip data for this wheel, if anyone listens
+      if (wheel.slipPub && wheel.slipPub->HasConnections())
+      {
+        wheel.slipPub->Publish(msgs::Convert(Slip(vehicle, modelWorldPose,
+            link, joint, wheel.wheelRadius)));
+      }
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 WheelSlipPlugin::WheelSlipPlugin()
   : dataPtr(new WheelSlipPluginPrivate)
@@ -129,19 +442,20 @@ WheelSlipPlugin::WheelSlipPlugin()
 /////////////////////////////////////////////////
 WheelSlipPlugin::~WheelSlipPlugin()
 {
+  this->Fini();
 }
 
 /////////////////////////////////////////////////
 void WheelSlipPlugin::Fini()
 {
-  this->dataPtr->updateConnection.reset();
+  if (this->dataPtr->table)
+  {
+    this->dataPtr->table->Remove(this->dataPtr->vehicleId);
+    this->dataPtr->table.reset();
+  }
 
   this->dataPtr->lateralComplianceSub.reset();
   this->dataPtr->longitudinalComplianceSub.reset();
-  for (auto linkSurface : this->dataPtr->mapLinkSurfaceParams)
-  {
-    linkSurface.second.slipPub.reset();
-  }
   if (this->dataPtr->gzNode)
     this->dataPtr->gzNode->Fini();
 }
@@ -155,11 +469,14 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   this->dataPtr->model = _model;
   auto world = _model->GetWorld();
   GZ_ASSERT(world, "world pointer is NULL");
+
+  WheelSlipVehicle vehicle;
+  vehicle.model = _model;
   {
     ignition::math::Vector3d gravity = world->Gravity();
     ignition::math::Quaterniond initialModelRot =
         _model->WorldPose().Rot();
-    this->dataPtr->initialGravityDirection =
+    vehicle.initialGravityDirection =
         initialModelRot.RotateVectorReverse(gravity.Normalized());
   }
 
@@ -182,7 +499,7 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
     // Get link name
     auto linkName = wheelElem->Get<std::string>("link_name");
 
-    WheelSlipPluginPrivate::LinkSurfaceParams params;
+    WheelSlipWheel params;
     if (wheelElem->HasElement("slip_compliance_lateral"))
     {
       params.slipComplianceLateral =
@@ -212,6 +529,8 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       continue;
     }
 
+    params.link = link;
+
     auto collisions = link->GetCollisions();
     if (collisions.empty() || collisions.size() != 1)
     {
@@ -316,10 +635,10 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       continue;
     }
 
-    this->dataPtr->mapLinkSurfaceParams[link] = params;
+    vehicle.wheels.push_back(params);
   }
 
-  if (this->dataPtr->mapLinkSurfaceParams.empty())
+  if (vehicle.wheels.empty())
   {
     gzerr << "No ODE links and surfaces found, plugin is disabled" << std::endl;
     return;
@@ -330,13 +649,11 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
   this->dataPtr->gzNode->Init(world->Name());
 
   // add publishers
-  for (auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
+  for (auto &wheel : vehicle.wheels)
   {
-    auto link = linkSurface.first.lock();
-    GZ_ASSERT(link, "link should still exist inside Load");
-    auto &params = linkSurface.second;
-    params.slipPub = this->dataPtr->gzNode->Advertise<msgs::Vector3d>(
-        "~/" + _model->GetName() + "/wheel_slip/" + link->GetName());
+    wheel.slipPub = this->dataPtr->gzNode->Advertise<msgs::Vector3d>(
+        "~/" + _model->GetName() + "/wheel_slip/" +
+        wheel.link.lock()->GetName());
   }
 
   this->dataPtr->lateralComplianceSub = this->dataPtr->gzNode->Subscribe(
@@ -347,9 +664,10 @@ void WheelSlipPlugin::Load(physics::ModelPtr _model, sdf::ElementPtr _sdf)
       "~/" + _model->GetName() + "/wheel_slip/longitudinal_compliance",
       &WheelSlipPlugin::OnLongitudinalCompliance, this);
 
-  // Connect to the update event
-  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-      std::bind(&WheelSlipPlugin::Update, this));
+  // The wheels are updated with the wheels of the other vehicles of the
+  // world
+  this->dataPtr->table = WheelSlipTable::Get(world);
+  this->dataPtr->vehicleId = this->dataPtr->table->Add(vehicle);
 }
 
 /////////////////////////////////////////////////
@@ -362,50 +680,14 @@ physics::ModelPtr WheelSlipPlugin::GetParentModel() const
 void WheelSlipPlugin::GetSlips(
         std::map<std::string, ignition::math::Vector3d> &_out) const
 {
-  auto model = this->GetParentModel();
-  if (!model)
+  if (!this->GetParentModel())
   {
     gzerr << "Parent model does not exist" << std::endl;
     return;
   }
-  auto modelWorldPose = model->WorldPose();
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (const auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
-  {
-    auto link = linkSurface.first.lock();
-    if (!link)
-      continue;
-    auto params = linkSurface.second;
-
-    // Compute wheel velocity in parent model frame
-    auto wheelWorldLinearVel = link->WorldLinearVel();
-    auto wheelModelLinearVel =
-        modelWorldPose.Rot().RotateVectorReverse(wheelWorldLinearVel);
-    // Compute wheel spin axis in parent model frame
-    auto joint = params.joint.lock();
-    if (!joint)
-      continue;
-    auto wheelWorldAxis = joint->GlobalAxis(0).Normalized();
-    auto wheelModelAxis =
-        modelWorldPose.Rot().RotateVectorReverse(wheelWorldAxis);
-    // Estimate longitudinal direction as cross product of initial gravity
-    // direction with wheel spin axis.
-    auto longitudinalModelAxis =
-        this->dataPtr->initialGravityDirection.Cross(wheelModelAxis);
-
-    double spinSpeed = params.wheelRadius * joint->GetVelocity(0);
-    double lateralSpeed = wheelModelAxis.Dot(wheelModelLinearVel);
-    double longitudinalSpeed = longitudinalModelAxis.Dot(wheelModelLinearVel);
-
-    ignition::math::Vector3d slip;
-    slip.X(longitudinalSpeed - spinSpeed);
-    slip.Y(lateralSpeed);
-    slip.Z(spinSpeed);
-
-    auto name = link->GetName();
-    _out[name] = slip;
-  }
+  if (this->dataPtr->table)
+    this->dataPtr->table->Slips(this->dataPtr->vehicleId, _out);
 }
 
 /////////////////////////////////////////////////
@@ -437,87 +719,19 @@ void WheelSlipPlugin::OnLongitudinalCompliance(ConstGzStringPtr &_msg)
 /////////////////////////////////////////////////
 void WheelSlipPlugin::SetSlipComplianceLateral(const double _compliance)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
+  if (this->dataPtr->table)
   {
-    linkSurface.second.slipComplianceLateral = _compliance;
+    this->dataPtr->table->SetSlipComplianceLateral(this->dataPtr->vehicleId,
+        _compliance);
   }
 }
 
 /////////////////////////////////////////////////
 void WheelSlipPlugin::SetSlipComplianceLongitudinal(const double _compliance)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
-  {
-    linkSurface.second.slipComplianceLongitudinal = _compliance;
-  }
-}
-
-/////////////////////////////////////////////////
-void WheelSlipPlugin::Update()
-{
-  IGN_PROFILE("WheelSlipPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN("Update");
-  // Get slip data so it can be published later
-  std::map<std::string, ignition::math::Vector3d> slips;
-  this->GetSlips(slips);
-
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  for (const auto &linkSurface : this->dataPtr->mapLinkSurfaceParams)
+  if (this->dataPtr->table)
   {
-    const auto &params = linkSurface.second;
-
-    // get user-defined normal force constant
-    double force = params.wheelNormalForce;
-
-    // get link angular velocity parallel to joint axis
-    ignition::math::Vector3d wheelAngularVelocity;
-    auto link = linkSurface.first.lock();
-    if (link)
-      wheelAngularVelocity = link->WorldAngularVel();
-
-    ignition::math::Vector3d jointAxis;
-    auto joint = params.joint.lock();
-    if (joint)
-      jointAxis = joint->GlobalAxis(0);
-
-    double spinAngularVelocity = wheelAngularVelocity.Dot(jointAxis);
-
-    auto surface = params.surface.lock();
-    if (surface)
-    {
-      // As discussed in WheelSlipPlugin.hh, the ODE slip1 and slip2
-      // parameters have units of inverse viscous damping:
-      // [linear velocity / force] or [m / s / N].
-      // Since the slip compliance parameters supplied to the plugin
-      // are unitless, they must be scaled by a linear speed and force
-      // magnitude before being passed to ODE.
-      // The force is taken from a user-defined constant that should roughly
-      // match the steady-state normal force at the wheel.
-      // The linear speed is computed dynamically at each time step as
-      // radius * spin angular velocity.
-      // This choice of linear speed corresponds to the denominator of
-      // the slip ratio during acceleration (see equation (1) in
-      // Yoshida, Hamano 2002 DOI 10.1109/ROBOT.2002.1013712
-      // "Motion dynamics of a rover with slip-based traction model").
-      // The acceleration form is more well-behaved numerically at low-speed
-      // and when the vehicle is at rest than the braking form,
-      // so it is used for both slip directions.
-      double speed = params.wheelRadius * std::abs(spinAngularVelocity);
-      surface->slip1 = speed / force * params.slipComplianceLateral;
-      surface->slip2 = speed / force * params.slipComplianceLongitudinal;
-    }
-
-    // Try to publish slip data for this wheel
-    if (link)
-    {
-      msgs::Vector3d msg;
-      auto name = link->GetName();
-      msg = msgs::Convert(slips[name]);
-      if (params.slipPub)
-        params.slipPub->Publish(msg);
-    }
+    this->dataPtr->table->SetSlipComplianceLongitudinal(
+        this->dataPtr->vehicleId, _compliance);
   }
-  IGN_PROFILE_END();
 }
@@ -51,6 +51,10 @@ namespace gazebo
   /// parameter specified below in order to match the units of the ODE
   /// slip parameters.
   ///
+  /// The wheels of all the instances of the plugin in a world are kept in
+  /// one table, with their link, joint and surface, and are updated
+  /// together in a single pass at the beginning of each world update.
+  ///
   /// A graphical interpretation of these parameters is provided below
   /// for a positive value of slip compliance.
   /// The horizontal axis corresponds to the slip ratio at the wheel,
@@ -141,10 +145,6 @@ namespace gazebo
     /// \param[in] _msg Slip compliance encoded as string.
     private: void OnLongitudinalCompliance(ConstGzStringPtr &_msg);
 
-    /// \brief Update the plugin. This is updated every iteration of
-    /// simulation.
-    private: void Update();
-
     /// \brief Private data pointer.
     private: std::unique_ptr<WheelSlipPluginPrivate> dataPtr;
   };
@@ -17,8 +17,6 @@
 
 #include <functional>
 
-#include <ignition/common/Profiler.hh>
-
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Event.hh"
 #include "gazebo/common/Events.hh"
@@ -33,8 +31,8 @@ class gazebo::WindPluginPrivate
   /// \brief World pointer.
   public: physics::WorldPtr world;
 
-  /// \brief Connection to World Update events.
-  public: event::ConnectionPtr updateConnection;
+  /// \brief Id of the force field of the wind, -1 if there is none.
+  public: int fieldId = -1;
 
   /// \brief Time for wind to rise
   public: double characteristicTimeForWindRise = 1;
@@ -99,6 +97,13 @@ WindPlugin::WindPlugin()
 {
 }
 
+/////////////////////////////////////////////////
+WindPlugin::~WindPlugin()
+{
+  if (this->dataPtr->fieldId >= 0)
+    this->dataPtr->world->ForceFields().Remove(this->dataPtr->fieldId);
+}
+
 /////////////////////////////////////////////////
 void WindPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
 {
@@ -225,8 +230,12 @@ void WindPlugin::Load(physics::WorldPtr _world, sdf::ElementPtr _sdf)
   wind.SetLinearVelFunc(std::bind(&WindPlugin::LinearVel, this,
         std::placeholders::_1, std::placeholders::_2));
 
-  this->dataPtr->updateConnection = event::Events::ConnectWorldUpdateBegin(
-          std::bind(&WindPlugin::OnUpdate, this));
+  // The links with wind are updated in one pass, before the physics update
+  this->dataPtr->fieldId = this->dataPtr->world->ForceFields().Add(
+      [](const physics::LinkPtr &_link) {return _link->WindMode();},
+      std::bind(&WindPlugin::ApplyForces, this, std::placeholders::_1,
+        std::placeholders::_2, std::placeholders::_3, std::placeholders::_4),
+      true);
 }
 
 /////////////////////////////////////////////////
@@ -291,34 +300,19 @@ ignition::math::Vector3d WindPlugin::LinearVel(const physics::Wind *_wind,
 }
 
 /////////////////////////////////////////////////
-void WindPlugin::OnUpdate()
+void WindPlugin::ApplyForces(physics::ForceFieldLinks &_links,
+    const std::vector<std::size_t> &_slots, const std::size_t _begin,
+    const std::size_t _end) const
 {
-  IGN_PROFILE("WindPlugin::OnUpdate");
-  IGN_PROFILE_BEGIN("Update");
   // Update loop for using the force on mass approximation
   // This is not recommended. Please use the LiftDragPlugin instead.
-
-  // Get all the models
-  physics::Model_V models = this->dataPtr->world->Models();
-
-  // Process each model.
-  for (auto const &model : models)
+  for (std::size_t i = _begin; i < _end; ++i)
   {
-    // Get all the links
-    physics::Link_V links = model->GetLinks();
+    const std::size_t s = _slots[i];
 
-    // Process each link.
-    for (auto const &link : links)
-    {
-      // Skip links for which the wind is disabled
-      if (!link->WindMode())
-        continue;
-
-      // Add wind velocity as a force to the body
-      link->AddRelativeForce(link->GetInertial()->Mass() *
-          this->dataPtr->forceApproximationScalingFactor *
-          (link->RelativeWindLinearVel() - link->RelativeLinearVel()));
-    }
+    // Add wind velocity as a force to the body
+    _links.forces[s] += _links.masses[s] *
+        this->dataPtr->forceApproximationScalingFactor *
+        (_links.windVels[s] - _links.linearVels[s]);
   }
-  IGN_PROFILE_END();
 }
@@ -18,6 +18,7 @@
 #define GAZEBO_PLUGINS_WINDPLUGIN_HH_
 
 #include <memory>
+#include <vector>
 
 #include <ignition/math/Vector3.hh>
 
@@ -50,6 +51,9 @@ namespace gazebo
     /// \brief Constructor.
     public: WindPlugin();
 
+    /// \brief Destructor.
+    public: virtual ~WindPlugin();
+
     // Documentation inherited
     public: virtual void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
 
@@ -62,8 +66,15 @@ namespace gazebo
             const physics::Wind *_wind,
             const physics::Entity *_entity);
 
-    /// \brief Callback for World Update events.
-    private: void OnUpdate();
+    /// \brief Force field kernel that applies the wind as a force on the
+    /// mass of the links.
+    /// \param[in,out] _links State of the links.
+    /// \param[in] _slots Slots of the links with wind.
+    /// \param[in] _begin First link.
+    /// \param[in] _end Past the last link.
+    private: void ApplyForces(physics::ForceFieldLinks &_links,
+                 const std::vector<std::size_t> &_slots,
+                 const std::size_t _begin, const std::size_t _end) const;
 
     /// \internal
     /// \brief Pointer to private data.
@@ -47,9 +47,8 @@ SimEventsPlugin::~SimEventsPlugin()
 ////////////////////////////////////////////////////////////////////////////////
 void SimEventsPlugin::OnRequest(ConstRequestPtr &_msg)
 {
-  if (_msg->request() == "entity_delete")
+  for (auto const &modelName : msgs::DeletedEntities(*_msg))
   {
-    std::string modelName = _msg->data();
     if (models.erase(modelName) == 1)
     {
       // notify everyone!
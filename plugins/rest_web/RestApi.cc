@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <stdlib.h>
@@ -197,14 +198,56 @@ RestApi::~RestApi()
 /////////////////////////////////////////////////
 void RestApi::PostJsonData(const char *_route, const char *_json)
 {
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  if (this->posts.size() >= this->maxPostCount)
+  {
+    // Warn once each time the queue overflows
+    if (!this->overflowing)
+    {
+      gzwarn << "REST post queue is full, dropping the oldest posts"
+             << std::endl;
+      this->overflowing = true;
+    }
+    while (this->posts.size() >= this->maxPostCount)
+    {
+      this->posts.pop_front();
+      ++this->droppedPostCount;
+    }
+  }
+
   Post post;
   post.route = _route;
   post.json = _json;
-  {
-    std::lock_guard<std::mutex> lock(this->postsMutex);
-    this->posts.push_back(post);
-  }
-  this->SendUnpostedPosts();
+  post.seq = this->nextSeq++;
+  this->posts.push_back(post);
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetMaxPostCount(const std::size_t _max)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->maxPostCount = std::max<std::size_t>(1, _max);
+}
+
+/////////////////////////////////////////////////
+void RestApi::SetBatchSize(const std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  this->batchSize = std::max<std::size_t>(1, _size);
+}
+
+/////////////////////////////////////////////////
+std::size_t RestApi::PostCount() const
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->posts.size();
+}
+
+/////////////////////////////////////////////////
+uint64_t RestApi::DroppedPostCount() const
+{
+  std::lock_guard<std::mutex> lock(this->postsMutex);
+  return this->droppedPostCount;
 }
 
 /////////////////////////////////////////////////
@@ -242,26 +285,47 @@ void RestApi::Logout()
 /////////////////////////////////////////////////
 void RestApi::SendUnpostedPosts()
 {
-  if (this->isLoggedIn)
+  if (!this->isLoggedIn)
+    return;
+
+  while (true)
   {
-    while (!this->posts.empty())
+    // Take the next batch: the consecutive posts to the same route
+    std::string route;
+    std::string json;
+    uint64_t lastSeq = 0;
     {
-      Post post;
+      std::lock_guard<std::mutex> lock(this->postsMutex);
+      if (this->posts.empty())
+        return;
+
+      route = this->posts.front().route;
+      std::size_t count = 0;
+      for (auto const &post : this->posts)
       {
-        std::lock_guard<std::mutex> lock(this->postsMutex);
-        post = this->posts.front();
-
-        //  You can generate a similar request on the cmd line like so:
-        //  curl --verbose --connect-timeout 5 -X POST
-        //    -H \"Content-Type: application/json \" -k --user"
-        this->Request(post.route, post.json);
-        this->posts.pop_front();
+        if (count == this->batchSize || post.route != route)
+          break;
+
+        if (count > 0)
+          json += ",\n";
+        json += post.json;
+        lastSeq = post.seq;
+        ++count;
       }
+      if (this->batchSize > 1)
+        json = "[" + json + "]";
     }
-  }
-  else
-  {
-    gzmsg << posts.size() << " post(s) queued to be sent" << std::endl;
+
+    //  You can generate a similar request on the cmd line like so:
+    //  curl --verbose --connect-timeout 5 -X POST
+    //    -H \"Content-Type: application/json \" -k --user"
+    this->Request(route, json);
+
+    // Remove the posts that were sent, unless they were dropped meanwhile
+    std::lock_guard<std::mutex> lock(this->postsMutex);
+    while (!this->posts.empty() && this->posts.front().seq <= lastSeq)
+      this->posts.pop_front();
+    this->overflowing = false;
   }
 }
 
@@ -18,6 +18,9 @@
 #ifndef GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 #define GAZEBO_PLUGINS_REST_WEB_RESTAPI_HH_
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <list>
 #include <mutex>
@@ -53,11 +56,37 @@ namespace gazebo
     /// a new call to Login has to be made to resume sending messages.
     public: void Logout();
 
-    /// \brief Notify the service with a http POST
+    /// \brief Queue a http POST to notify the service. The post is sent by
+    /// the next call to SendUnpostedPosts, so that this call never waits
+    /// for the network. When the queue is full, the oldest post is dropped.
     /// \param[in] _route on the web server
     /// \param[in] _json the data to send to the server
     public: void PostJsonData(const char *_route, const char *_json);
 
+    /// \brief Sends the queued posts, if logged in. Consecutive posts to
+    /// the same route are sent together as a JSON array, up to the batch
+    /// size. The requests are made without holding the queue lock.
+    /// \throws RestException When a request failed. The posts that were
+    /// not sent stay in the queue.
+    public: void SendUnpostedPosts();
+
+    /// \brief Set the maximum number of queued posts.
+    /// \param[in] _max Maximum number of posts, at least 1.
+    public: void SetMaxPostCount(const std::size_t _max);
+
+    /// \brief Set the maximum number of posts sent in one request.
+    /// \param[in] _size Number of posts, 1 to send each post on its own
+    /// as before.
+    public: void SetBatchSize(const std::size_t _size);
+
+    /// \brief Get the number of queued posts.
+    /// \return Number of posts.
+    public: std::size_t PostCount() const;
+
+    /// \brief Get the number of posts dropped because the queue was full.
+    /// \return Number of dropped posts.
+    public: uint64_t DroppedPostCount() const;
+
     /// \brief Returns the username
     /// \return The user name
     public: std::string GetUser() const;
@@ -71,9 +100,6 @@ namespace gazebo
     private: std::string Request(const std::string &_requestUrl,
                                  const std::string &_postStr);
 
-    /// \brief Sends unposted posts
-    private: void SendUnpostedPosts();
-
     /// \brief Login information: REST service host url
     private: std::string url;
 
@@ -87,20 +113,36 @@ namespace gazebo
     private: std::string loginRoute;
 
     /// \brief True when a previous Login attempt was successful
-    private: bool isLoggedIn;
+    private: std::atomic<bool> isLoggedIn;
 
-    /// \brief A post: what (json) and where (route)
+    /// \brief A post: what (json), where (route) and its sequence number
     private: struct Post
       {
         std::string route;
         std::string json;
+        uint64_t seq;
       };
 
     /// \brief List of unposted posts. Posts await when isLoggedIn is false
     private: std::list<Post> posts;
 
+    /// \brief Sequence number of the next post
+    private: uint64_t nextSeq = 0;
+
+    /// \brief Maximum number of queued posts
+    private: std::size_t maxPostCount = 1000;
+
+    /// \brief Maximum number of posts sent in one request
+    private: std::size_t batchSize = 1;
+
+    /// \brief Number of posts dropped because the queue was full
+    private: uint64_t droppedPostCount = 0;
+
+    /// \brief True while posts are dropped, until the next post is sent
+    private: bool overflowing = false;
+
     /// \brief A mutex to ensure integrity of the post list
-    private: std::mutex postsMutex;
+    private: mutable std::mutex postsMutex;
   };
 }
 
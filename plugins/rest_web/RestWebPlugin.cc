@@ -29,12 +29,20 @@
 
 #endif
 
+#include <algorithm>
+#include <string>
+
+#include <gazebo/common/CommonIface.hh>
+
 #include "RestWebPlugin.hh"
 
 
 using namespace gazebo;
 using namespace std;
 
+/// \brief Maximum delay before retrying to send posts, in seconds
+static const double kMaxRetryDelay = 60;
+
 //////////////////////////////////////////////////
 RestWebPlugin::RestWebPlugin()
 : node(new gazebo::transport::Node()),
@@ -114,50 +122,151 @@ void RestWebPlugin::Init()
 //////////////////////////////////////////////////
 void RestWebPlugin::Load(int /*_argc*/, char ** /*_argv*/)
 {
-  // nothing to do for now
+  // the posts are tuned with environment variables
+  const char *env = common::getEnv("GAZEBO_REST_FLUSH_INTERVAL");
+  if (env)
+  {
+    try
+    {
+      this->flushInterval = std::max(0.0, std::stod(env));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_REST_FLUSH_INTERVAL [" << env << "]\n";
+    }
+  }
+
+  env = common::getEnv("GAZEBO_REST_BATCH_SIZE");
+  if (env)
+  {
+    try
+    {
+      this->restApi.SetBatchSize(std::stoul(env));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_REST_BATCH_SIZE [" << env << "]\n";
+    }
+  }
+
+  env = common::getEnv("GAZEBO_REST_MAX_POSTS");
+  if (env)
+  {
+    try
+    {
+      this->restApi.SetMaxPostCount(std::stoul(env));
+    }
+    catch(...)
+    {
+      gzerr << "Invalid GAZEBO_REST_MAX_POSTS [" << env << "]\n";
+    }
+  }
 }
 
 //////////////////////////////////////////////////
 void RestWebPlugin::OnSimEvent(ConstSimEventPtr &_msg)
 {
-  gazebo::msgs::RestResponse msg;
-  std::string response;
-  try
-  {
-    // where to post the data on the REST server
-    std::string route = "/events/new";
-    std::string eType = _msg->type();
-    std::string name = _msg->name();
-    std::string data = _msg->data();
+  // where to post the data on the REST server
+  std::string route = "/events/new";
+  std::string eType = _msg->type();
+  std::string name = _msg->name();
+  std::string data = _msg->data();
+
+  msgs::WorldStatistics ws = _msg->world_statistics();
+  msgs::Time simT = ws.sim_time();
+  msgs::Time realT = ws.real_time();
+  msgs::Time pauseT = ws.pause_time();
+  bool paused = ws.paused();
+
+  std::string worldName = physics::get_world()->Name();
+  std::string event = "{\n";
+
+  event += "\"session\": \"" + this->session + "\", ";
+  event += "\"name\": \"" + name + "\", ";
+  event += "\"type\": \"" + eType + "\",\n";
+  event += "\"data\": " + data + ", ";
+
+  event += "\"world\": {";
+  event += "\"name\": ";
+  event += "\"";
+  event += worldName;
+  event += "\", ";
+
+  event += "\"paused\": ";
+  event += "\"";
+  if (paused)
+    event += "true";
+  else
+    event += "false";
+  event += "\", ";
+
+  event += "\"clock_time\": ";
+  event += "\"";
+  event += common::Time::GetWallTimeAsISOString();
+  event += "\", ";
+
+  event += "\"real_time\": ";
+  event += "\"";
+  event += msgs::Convert(realT).FormattedString();
+  event += "\", ";
+
+  event += "\"sim_time\": ";
+  event += "\"";
+  event += msgs::Convert(simT).FormattedString();
+  event += "\", ";
+
+  event += "\"pause_time\": ";
+  event += "\"";
+  event += msgs::Convert(pauseT).FormattedString();
+  event += "\"";
+
+  event += "}\n";  // world element
+  event += "}";    // root element
+  // queue it, it is posted with curl by the request thread
+  this->restApi.PostJsonData(route.c_str(), event.c_str());
 
-    msgs::WorldStatistics ws = _msg->world_statistics();
-    msgs::Time simT = ws.sim_time();
-    msgs::Time realT = ws.real_time();
-    msgs::Time pauseT = ws.pause_time();
-    bool paused = ws.paused();
+  gazebo::msgs::RestResponse msg;
+  msg.set_type(msgs::RestResponse::SUCCESS);
+  if (_msg->has_id())
+    msg.set_id(_msg->id());
+  msg.set_msg("");
+  this->pub->Publish(msg);
+}
 
-    std::string worldName = physics::get_world()->Name();
-    std::string event = "{\n";
+//////////////////////////////////////////////////
+void RestWebPlugin::OnEventRestPost(ConstRestPostPtr &_msg)
+{
+  gzmsg << "RestWebPlugin::OnRestPost";
+  gzmsg << "[" << _msg->route() << ", " << _msg->json() << "]"  << std::endl;
+  gzmsg << std::endl;
 
+  std::string event = "{";
+  event += "\"event\": " + _msg->json() + ", ";
+  physics::WorldPtr world = physics::get_world();
+  if (!world)
+  {
+    gzerr << "Can't access world before web service POST" << std::endl;
+  }
+  else
+  {
     event += "\"session\": \"" + this->session + "\", ";
-    event += "\"name\": \"" + name + "\", ";
-    event += "\"type\": \"" + eType + "\",\n";
-    event += "\"data\": " + data + ", ";
-
     event += "\"world\": {";
+
     event += "\"name\": ";
     event += "\"";
-    event += worldName;
+    event += world->Name();
     event += "\", ";
 
-    event += "\"paused\": ";
-    event += "\"";
-    if (paused)
-      event += "true";
+    if (!world->IsPaused())
+    {
+      event += "\"is_running\": \"true\", ";
+    }
     else
-      event += "false";
-    event += "\", ";
+    {
+      event +=  "\"is_running\": \"false\", ";
+    }
 
+    common::Time t;
     event += "\"clock_time\": ";
     event += "\"";
     event += common::Time::GetWallTimeAsISOString();
@@ -165,120 +274,34 @@ void RestWebPlugin::OnSimEvent(ConstSimEventPtr &_msg)
 
     event += "\"real_time\": ";
     event += "\"";
-    event += msgs::Convert(realT).FormattedString();
+    t = world->RealTime();
+    event += t.FormattedString();
     event += "\", ";
 
     event += "\"sim_time\": ";
     event += "\"";
-    event += msgs::Convert(simT).FormattedString();
+    t = world->SimTime();
+    event += t.FormattedString();
     event += "\", ";
 
     event += "\"pause_time\": ";
     event += "\"";
-    event += msgs::Convert(pauseT).FormattedString();
-    event += "\"";
+    t = world->PauseTime();
+    event += t.FormattedString();
+    event += "\" ";
 
-    event += "}\n";  // world element
-    event += "}";    // root element
-    // post it with curl
-    this->restApi.PostJsonData(route.c_str(), event.c_str());
-    msg.set_type(msgs::RestResponse::SUCCESS);
-  }
-  catch(RestException &x)
-  {
-    response = "There was a problem trying to send data to the server: ";
-    response += x.what();
-    msg.set_type(msgs::RestResponse::ERR);
-    // alert the user via the gui plugin
-    gzerr << "ERROR in REST service POST request: " << response << std::endl;
+    event += "}";
   }
+  event += "}";
 
-  if (_msg->has_id())
-    msg.set_id(_msg->id());
-  msg.set_msg(response);
-  this->pub->Publish(msg);
-}
-
-//////////////////////////////////////////////////
-void RestWebPlugin::OnEventRestPost(ConstRestPostPtr &_msg)
-{
-  gzmsg << "RestWebPlugin::OnRestPost";
-  gzmsg << "[" << _msg->route() << ", " << _msg->json() << "]"  << std::endl;
-  gzmsg << std::endl;
+  // queue it, it is posted with curl by the request thread
+  this->restApi.PostJsonData(_msg->route().c_str(), event.c_str());
 
   gazebo::msgs::RestResponse msg;
-  std::string response;
-  try
-  {
-    std::string event = "{";
-    event += "\"event\": " + _msg->json() + ", ";
-    physics::WorldPtr world = physics::get_world();
-    if (!world)
-    {
-      gzerr << "Can't access world before web service POST" << std::endl;
-    }
-    else
-    {
-      event += "\"session\": \"" + this->session + "\", ";
-      event += "\"world\": {";
-
-      event += "\"name\": ";
-      event += "\"";
-      event += world->Name();
-      event += "\", ";
-
-      if (!world->IsPaused())
-      {
-        event += "\"is_running\": \"true\", ";
-      }
-      else
-      {
-        event +=  "\"is_running\": \"false\", ";
-      }
-
-      common::Time t;
-      event += "\"clock_time\": ";
-      event += "\"";
-      event += common::Time::GetWallTimeAsISOString();
-      event += "\", ";
-
-      event += "\"real_time\": ";
-      event += "\"";
-      t = world->RealTime();
-      event += t.FormattedString();
-      event += "\", ";
-
-      event += "\"sim_time\": ";
-      event += "\"";
-      t = world->SimTime();
-      event += t.FormattedString();
-      event += "\", ";
-
-      event += "\"pause_time\": ";
-      event += "\"";
-      t = world->PauseTime();
-      event += t.FormattedString();
-      event += "\" ";
-
-      event += "}";
-    }
-    event += "}";
-
-    this->restApi.PostJsonData(_msg->route().c_str(), event.c_str());
-    msg.set_type(msgs::RestResponse::SUCCESS);
-  }
-  catch(RestException &x)
-  {
-    response = "There was a problem trying to send data to the server: ";
-    response += x.what();
-    msg.set_type(msgs::RestResponse::ERR);
-    // alert the user via the gui plugin
-    gzerr << "ERROR in REST request: " << response << std::endl;
-  }
-
+  msg.set_type(msgs::RestResponse::SUCCESS);
   if (_msg->has_id())
     msg.set_id(_msg->id());
-  msg.set_msg(response);
+  msg.set_msg("");
   this->pub->Publish(msg);
 }
 
@@ -342,6 +365,7 @@ void RestWebPlugin::RunRequestQ()
   // be ready to send errors back to the UI
   std::string path("/gazebo/rest/rest_response");
   this->pub = node->Advertise<gazebo::msgs::RestResponse>(path);
+  common::Time nextFlush = common::Time::GetWallTime();
   // process any login or post data that ha been received
   while (!this->stopMsgProcessing)
   {
@@ -362,6 +386,15 @@ void RestWebPlugin::RunRequestQ()
       {
         this->ProcessLoginRequest(login);
       }
+
+      // send the queued posts at the flush interval, or later after a
+      // failure
+      common::Time now = common::Time::GetWallTime();
+      if (now >= nextFlush)
+      {
+        this->FlushPosts();
+        nextFlush = now + common::Time(this->flushInterval + this->retryDelay);
+      }
     }
     catch(...)
     {
@@ -371,5 +404,35 @@ void RestWebPlugin::RunRequestQ()
   }
 }
 
+//////////////////////////////////////////////////
+void RestWebPlugin::FlushPosts()
+{
+  try
+  {
+    this->restApi.SendUnpostedPosts();
+    this->retryDelay = 0;
+  }
+  catch(RestException &x)
+  {
+    // back off exponentially, so that a missing server costs little
+    this->retryDelay = std::min(kMaxRetryDelay,
+        std::max(2 * this->retryDelay, std::max(this->flushInterval, 1.0)));
+
+    std::string response =
+        "There was a problem trying to send data to the server: ";
+    response += x.what();
+    gzerr << "ERROR in REST service POST request: " << response
+          << " (" << this->restApi.PostCount() << " post(s) queued, "
+          << this->restApi.DroppedPostCount() << " dropped, retrying in "
+          << this->retryDelay << " s)" << std::endl;
+
+    // alert the user via the gui plugin
+    gazebo::msgs::RestResponse msg;
+    msg.set_type(msgs::RestResponse::ERR);
+    msg.set_msg(response);
+    this->pub->Publish(msg);
+  }
+}
+
 // plugin registration
 GZ_REGISTER_SYSTEM_PLUGIN(RestWebPlugin)
@@ -33,6 +33,16 @@ namespace gazebo
 {
   /// \class RestWebPlugin RestWebPlugin.hh RestWebPlugin.hh
   /// \brief REST web plugin
+  ///
+  /// Events are queued by the transport callbacks and posted by a request
+  /// thread, so the web service never slows the simulation. The posts are
+  /// tuned with environment variables:
+  /// GAZEBO_REST_FLUSH_INTERVAL is the delay between sends in seconds
+  /// (0.5 by default), GAZEBO_REST_BATCH_SIZE the number of events sent
+  /// together as a JSON array (1 by default, to post each event on its
+  /// own) and GAZEBO_REST_MAX_POSTS the size of the queue, past which the
+  /// oldest events are dropped (1000 by default). After a failure, the
+  /// sends back off exponentially up to a minute.
   class GZ_PLUGIN_VISIBLE RestWebPlugin : public SystemPlugin
   {
     /// \brief Constructor
@@ -72,6 +82,10 @@ namespace gazebo
     /// \param[in] The message to process
     private: void ProcessLoginRequest(ConstRestLoginPtr _msg);
 
+    /// \brief Send the queued posts from the requestThread, and back off
+    /// on failure
+    private: void FlushPosts();
+
     /// \brief Gazebo pub/sub node
     private: gazebo::transport::NodePtr node;
 
@@ -111,6 +125,13 @@ namespace gazebo
 
     /// \brief A session string to keep track of exercises
     private: std::string session;
+
+    /// \brief Delay between sends of the queued posts, in seconds
+    private: double flushInterval = 0.5;
+
+    /// \brief Additional delay before the next send after a failure, in
+    /// seconds
+    private: double retryDelay = 0;
   };
 }
 
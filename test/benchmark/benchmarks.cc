@@ -0,0 +1,516 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Benchmark of the world step throughput of the physics engines.
+//
+// Each case generates a world, loads it headless and runs it for a number
+// of iterations with World::RunBlocking. The results are printed as JSON:
+// iterations per second, real time factor, the mean time of the update
+// phases delimited by the world update events, and the peak resident set
+// size of the process. Build with ENABLE_DIAGNOSTICS to also get the
+// trace of every profiled section in the diagnostics log path.
+//
+// Example:
+//   gazebo_benchmarks --engine ode --scenario boxes --size 100 -o out.json
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/physics/physics.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Result of a benchmark case.
+struct BenchmarkResult
+{
+  /// \brief Physics engine name.
+  std::string engine;
+
+  /// \brief Scenario name.
+  std::string scenario;
+
+  /// \brief Number of entities in the scenario.
+  unsigned int size = 0;
+
+  /// \brief Number of iterations run.
+  unsigned int iterations = 0;
+
+  /// \brief Wall clock time of the run in seconds.
+  double wallTime = 0;
+
+  /// \brief Simulation time of the run in seconds.
+  double simTime = 0;
+
+  /// \brief Mean time from the start of an update to the physics update,
+  /// which covers the model updates and collision detection, in seconds.
+  double preUpdateTime = 0;
+
+  /// \brief Mean time from the physics update to the end of an update,
+  /// which covers the constraint solver and contact publication, in
+  /// seconds.
+  double physicsTime = 0;
+
+  /// \brief Peak resident set size of the process after the run in kB.
+  int64_t peakRss = 0;
+
+  /// \brief Error message, empty if the case ran.
+  std::string error;
+};
+
+/// \brief Times the phases of each world update through the world events.
+class PhaseTimer
+{
+  /// \brief Clock used for timing.
+  public: using Clock = std::chrono::steady_clock;
+
+  /// \brief Constructor. Connects to the world events.
+  public: PhaseTimer()
+  {
+    this->connections.push_back(event::Events::ConnectWorldUpdateBegin(
+        [this](const common::UpdateInfo &)
+        {
+          this->begin = Clock::now();
+        }));
+    this->connections.push_back(event::Events::ConnectBeforePhysicsUpdate(
+        [this](const common::UpdateInfo &)
+        {
+          this->beforePhysics = Clock::now();
+          this->preUpdate += this->beforePhysics - this->begin;
+        }));
+    this->connections.push_back(event::Events::ConnectWorldUpdateEnd(
+        [this]()
+        {
+          this->physics += Clock::now() - this->beforePhysics;
+          ++this->count;
+        }));
+  }
+
+  /// \brief Start of the current update.
+  public: Clock::time_point begin;
+
+  /// \brief Start of the current physics update.
+  public: Clock::time_point beforePhysics;
+
+  /// \brief Total time before the physics updates.
+  public: Clock::duration preUpdate = Clock::duration::zero();
+
+  /// \brief Total time of the physics updates.
+  public: Clock::duration physics = Clock::duration::zero();
+
+  /// \brief Number of updates.
+  public: unsigned int count = 0;
+
+  /// \brief Event connections.
+  private: std::vector<event::ConnectionPtr> connections;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a box link.
+/// \param[in] _name Link name.
+/// \param[in] _pose Pose of the link.
+/// \param[in] _size Size of the box.
+/// \param[in] _mass Mass of the box.
+/// \return SDF of the link.
+static std::string BoxLink(const std::string &_name,
+    const ignition::math::Pose3d &_pose, const ignition::math::Vector3d &_size,
+    const double _mass)
+{
+  double ixx = _mass / 12.0 * (_size.Y() * _size.Y() + _size.Z() * _size.Z());
+  double iyy = _mass / 12.0 * (_size.X() * _size.X() + _size.Z() * _size.Z());
+  double izz = _mass / 12.0 * (_size.X() * _size.X() + _size.Y() * _size.Y());
+
+  std::ostringstream sdf;
+  sdf << "<link name='" << _name << "'>"
+      << "<pose>" << _pose << "</pose>"
+      << "<inertial><mass>" << _mass << "</mass><inertia>"
+      << "<ixx>" << ixx << "</ixx><iyy>" << iyy << "</iyy>"
+      << "<izz>" << izz << "</izz></inertia></inertial>"
+      << "<collision name='collision'><geometry><box><size>" << _size
+      << "</size></box></geometry></collision>"
+      << "</link>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a model made of stacked boxes.
+/// \param[in] _size Number of boxes.
+/// \return SDF of the models.
+static std::string BoxesScenario(const unsigned int _size)
+{
+  // Columns of up to ten boxes on a square grid.
+  const unsigned int height = 10;
+  unsigned int columns = (_size + height - 1) / height;
+  unsigned int side = static_cast<unsigned int>(std::ceil(std::sqrt(columns)));
+
+  std::ostringstream sdf;
+  for (unsigned int i = 0; i < _size; ++i)
+  {
+    unsigned int column = i / height;
+    ignition::math::Pose3d pose(
+        (column % side) * 1.0, (column / side) * 1.0,
+        0.25 + (i % height) * 0.51, 0, 0, 0);
+
+    sdf << "<model name='box_" << i << "'>"
+        << BoxLink("link", pose, ignition::math::Vector3d(0.5, 0.5, 0.5), 1.0)
+        << "</model>";
+  }
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of articulated arms swinging under gravity.
+/// \param[in] _size Number of arms.
+/// \return SDF of the models.
+static std::string ArmsScenario(const unsigned int _size)
+{
+  const unsigned int links = 6;
+  unsigned int side = static_cast<unsigned int>(std::ceil(std::sqrt(_size)));
+
+  std::ostringstream sdf;
+  for (unsigned int i = 0; i < _size; ++i)
+  {
+    ignition::math::Vector3d base((i % side) * 2.0, (i / side) * 2.0, 0);
+
+    sdf << "<model name='arm_" << i << "'>";
+    for (unsigned int j = 0; j < links; ++j)
+    {
+      ignition::math::Pose3d pose(base.X(), base.Y(), 0.05 + j * 0.3 + 0.15,
+          0, 0, 0);
+      std::string name = "link_" + std::to_string(j);
+      sdf << BoxLink(name, pose, ignition::math::Vector3d(0.05, 0.05, 0.3),
+          0.5);
+
+      // Alternate the joint axes, and bend the arm a bit so it moves.
+      std::string parent = j == 0 ? "world" : "link_" + std::to_string(j - 1);
+      sdf << "<joint name='joint_" << j << "' type='revolute'>"
+          << "<parent>" << parent << "</parent><child>" << name << "</child>"
+          << "<pose>0 0 -0.15 0 0 0</pose>"
+          << "<axis><xyz>" << (j % 2 == 0 ? "1 0 0" : "0 1 0") << "</xyz>"
+          << "<dynamics><damping>0.01</damping></dynamics></axis>"
+          << "</joint>";
+    }
+    sdf << "<pose>0 0 0 0.1 0.1 0</pose>";
+    sdf << "</model>";
+  }
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of vehicles on a heightmap.
+/// \param[in] _size Number of vehicles.
+/// \return SDF of the models.
+static std::string VehiclesScenario(const unsigned int _size)
+{
+  std::ostringstream sdf;
+  sdf << "<model name='heightmap'><static>true</static>"
+      << "<link name='link'><collision name='collision'><geometry>"
+      << "<heightmap>"
+      << "<uri>file://media/materials/textures/heightmap_bowl.png</uri>"
+      << "<size>129 129 10</size><pos>0 0 0</pos>"
+      << "</heightmap></geometry></collision></link></model>";
+
+  unsigned int side = static_cast<unsigned int>(std::ceil(std::sqrt(_size)));
+  for (unsigned int i = 0; i < _size; ++i)
+  {
+    ignition::math::Pose3d pose(
+        (i % side) * 4.0 - side * 2.0, (i / side) * 4.0 - side * 2.0, 12,
+        0, 0, 0);
+
+    sdf << "<model name='vehicle_" << i << "'>"
+        << "<pose>" << pose << "</pose>"
+        << BoxLink("chassis", ignition::math::Pose3d(0, 0, 0.4, 0, 0, 0),
+            ignition::math::Vector3d(2.0, 1.0, 0.4), 20.0);
+
+    for (unsigned int j = 0; j < 4; ++j)
+    {
+      std::string name = "wheel_" + std::to_string(j);
+      double x = j < 2 ? 0.7 : -0.7;
+      double y = j % 2 == 0 ? 0.6 : -0.6;
+      sdf << "<link name='" << name << "'>"
+          << "<pose>" << x << " " << y << " 0.3 " << IGN_PI * 0.5
+          << " 0 0</pose>"
+          << "<inertial><mass>1</mass><inertia>"
+          << "<ixx>0.025</ixx><iyy>0.025</iyy><izz>0.045</izz>"
+          << "</inertia></inertial>"
+          << "<collision name='collision'><geometry><cylinder>"
+          << "<radius>0.3</radius><length>0.2</length>"
+          << "</cylinder></geometry></collision></link>"
+          << "<joint name='" << name << "_joint' type='revolute'>"
+          << "<parent>chassis</parent><child>" << name << "</child>"
+          << "<axis><xyz>0 0 1</xyz></axis></joint>";
+    }
+    sdf << "</model>";
+  }
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a benchmark world.
+/// \param[in] _engine Physics engine name.
+/// \param[in] _scenario Scenario name.
+/// \param[in] _size Number of entities in the scenario.
+/// \return SDF of the world, empty if the scenario is unknown.
+static std::string WorldSdf(const std::string &_engine,
+    const std::string &_scenario, const unsigned int _size)
+{
+  std::string models;
+  if (_scenario == "boxes")
+    models = BoxesScenario(_size);
+  else if (_scenario == "arms")
+    models = ArmsScenario(_size);
+  else if (_scenario == "vehicles")
+    models = VehiclesScenario(_size);
+  else
+    return std::string();
+
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0'?><sdf version='" << SDF_VERSION << "'>"
+      << "<world name='default'>"
+      // Run as fast as possible.
+      << "<physics type='" << _engine << "'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "<real_time_update_rate>0</real_time_update_rate>"
+      << "</physics>";
+
+  if (_scenario != "vehicles")
+  {
+    sdf << "<model name='ground_plane'><static>true</static>"
+        << "<link name='link'><collision name='collision'><geometry>"
+        << "<plane><normal>0 0 1</normal><size>200 200</size></plane>"
+        << "</geometry></collision></link></model>";
+  }
+
+  sdf << models << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a benchmark case.
+/// \param[in] _engine Physics engine name.
+/// \param[in] _scenario Scenario name.
+/// \param[in] _size Number of entities in the scenario.
+/// \param[in] _iterations Number of iterations to run.
+/// \return The result of the case.
+static BenchmarkResult RunCase(const std::string &_engine,
+    const std::string &_scenario, const unsigned int _size,
+    const unsigned int _iterations)
+{
+  BenchmarkResult result;
+  result.engine = _engine;
+  result.scenario = _scenario;
+  result.size = _size;
+
+  std::string sdf = WorldSdf(_engine, _scenario, _size);
+  if (sdf.empty())
+  {
+    result.error = "unknown scenario";
+    return result;
+  }
+
+  boost::filesystem::path worldFile =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_benchmark_%%%%-%%%%.world");
+  {
+    std::ofstream out(worldFile.string());
+    out << sdf;
+  }
+
+  physics::WorldPtr world = gazebo::loadWorld(worldFile.string());
+  boost::filesystem::remove(worldFile);
+  if (!world || world->Physics()->GetType() != _engine)
+  {
+    result.error = "unable to load the world";
+    physics::remove_worlds();
+    return result;
+  }
+
+  // Let the contacts settle before timing.
+  gazebo::runWorld(world, 10);
+  common::Time startSimTime = world->SimTime();
+
+  {
+    PhaseTimer phases;
+    auto start = PhaseTimer::Clock::now();
+    gazebo::runWorld(world, _iterations);
+    result.wallTime = std::chrono::duration<double>(
+        PhaseTimer::Clock::now() - start).count();
+
+    result.iterations = phases.count;
+    if (phases.count > 0)
+    {
+      result.preUpdateTime = std::chrono::duration<double>(
+          phases.preUpdate).count() / phases.count;
+      result.physicsTime = std::chrono::duration<double>(
+          phases.physics).count() / phases.count;
+    }
+  }
+  result.simTime = (world->SimTime() - startSimTime).Double();
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    result.peakRss = usage.ru_maxrss;
+
+  world.reset();
+  physics::remove_worlds();
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+static void WriteJson(std::ostream &_out,
+    const std::vector<BenchmarkResult> &_results)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const BenchmarkResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"engine\": \"" << r.engine << "\", "
+         << "\"scenario\": \"" << r.scenario << "\", "
+         << "\"size\": " << r.size;
+
+    if (!r.error.empty())
+    {
+      _out << ", \"error\": \"" << r.error << "\"}";
+      continue;
+    }
+
+    _out << ", \"iterations\": " << r.iterations
+         << ", \"wall_time\": " << r.wallTime
+         << ", \"steps_per_sec\": "
+         << (r.wallTime > 0 ? r.iterations / r.wallTime : 0.0)
+         << ", \"real_time_factor\": "
+         << (r.wallTime > 0 ? r.simTime / r.wallTime : 0.0)
+         << ", \"phases\": {\"models_and_collision\": " << r.preUpdateTime
+         << ", \"physics_and_contacts\": " << r.physicsTime << "}"
+         << ", \"peak_rss_kb\": " << r.peakRss << "}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> engines = {"ode"};
+#ifdef HAVE_BULLET
+  engines.push_back("bullet");
+#endif
+#ifdef HAVE_DART
+  engines.push_back("dart");
+#endif
+#ifdef HAVE_SIMBODY
+  engines.push_back("simbody");
+#endif
+
+  std::vector<std::string> scenarios = {"boxes", "arms", "vehicles"};
+  std::vector<unsigned int> sizes = {10, 100};
+  unsigned int iterations = 1000;
+  std::string output;
+
+  po::options_description desc("Usage: gazebo_benchmarks [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("engine,e", po::value<std::vector<std::string> >(&engines)->composing(),
+     "Physics engine, can be repeated. Defaults to all available engines.")
+    ("scenario,s",
+     po::value<std::vector<std::string> >(&scenarios)->composing(),
+     "Scenario: boxes, arms or vehicles. Can be repeated. Defaults to all.")
+    ("size,n", po::value<std::vector<unsigned int> >(&sizes)->composing(),
+     "Number of boxes, arms or vehicles. Can be repeated.")
+    ("iterations,i", po::value<unsigned int>(&iterations),
+     "Number of iterations of each case.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (auto const &engine : engines)
+  {
+    for (auto const &scenario : scenarios)
+    {
+      for (auto const size : sizes)
+      {
+        gzmsg << "Running " << scenario << "[" << size << "] on " << engine
+              << std::endl;
+        results.push_back(RunCase(engine, scenario, size, iterations));
+      }
+    }
+  }
+
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+  return 0;
+}
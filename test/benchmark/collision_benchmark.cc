@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Benchmark of the collision detection of the physics engines by shape
+// pair.
+//
+// Each case generates a world with a number of pairs of overlapping
+// shapes, loads it headless with the physics disabled, and times
+// PhysicsEngine::UpdateCollision, which then runs the broad and narrow
+// phases without solving. The poses never change, so every call does the
+// same work. Trimeshes are spheres generated as STL files, with
+// --mesh-segments segments around. The results are printed as JSON: the
+// mean time of an update, the time per pair, and the number of contacts
+// and contact points found, which tell apart a pair that an engine doesn't
+// support.
+//
+// Simbody doesn't detect collisions outside of its steps, its cases report
+// the contacts of the initial state.
+//
+// Example:
+//   gazebo_collision_benchmark --engine ode --pair box_box --size 100
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/physics/physics.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Result of a benchmark case.
+struct BenchmarkResult
+{
+  /// \brief Physics engine name.
+  std::string engine;
+
+  /// \brief Shape pair name.
+  std::string pair;
+
+  /// \brief Number of shape pairs.
+  unsigned int size = 0;
+
+  /// \brief Number of collision updates run.
+  unsigned int iterations = 0;
+
+  /// \brief Wall clock time of the updates in seconds.
+  double wallTime = 0;
+
+  /// \brief Number of contacts found by the last update.
+  unsigned int contacts = 0;
+
+  /// \brief Number of contact points found by the last update.
+  unsigned int contactPoints = 0;
+
+  /// \brief Error message, empty if the case ran.
+  std::string error;
+};
+
+/////////////////////////////////////////////////
+/// \brief Write an STL file of a sphere.
+/// \param[in] _path Path of the file.
+/// \param[in] _radius Radius of the sphere.
+/// \param[in] _segments Number of segments around the sphere. There are
+/// half as many rings, so the sphere has about _segments^2 triangles.
+static void WriteSphereStl(const std::string &_path, const double _radius,
+    const unsigned int _segments)
+{
+  const unsigned int rings = std::max(2u, _segments / 2);
+  auto vertex = [&](const unsigned int _ring, const unsigned int _segment)
+  {
+    double theta = IGN_PI * _ring / rings;
+    double phi = 2 * IGN_PI * _segment / _segments;
+    return ignition::math::Vector3d(
+        _radius * std::sin(theta) * std::cos(phi),
+        _radius * std::sin(theta) * std::sin(phi),
+        _radius * std::cos(theta));
+  };
+
+  std::ofstream out(_path);
+  auto facet = [&out](const ignition::math::Vector3d &_a,
+      const ignition::math::Vector3d &_b, const ignition::math::Vector3d &_c)
+  {
+    ignition::math::Vector3d n = (_b - _a).Cross(_c - _a).Normalize();
+    out << "facet normal " << n << "\n outer loop\n"
+        << "  vertex " << _a << "\n  vertex " << _b << "\n  vertex " << _c
+        << "\n endloop\nendfacet\n";
+  };
+
+  out << "solid sphere\n";
+  for (unsigned int r = 0; r < rings; ++r)
+  {
+    for (unsigned int s = 0; s < _segments; ++s)
+    {
+      ignition::math::Vector3d a = vertex(r, s);
+      ignition::math::Vector3d b = vertex(r + 1, s);
+      ignition::math::Vector3d c = vertex(r + 1, s + 1);
+      ignition::math::Vector3d d = vertex(r, s + 1);
+
+      // The poles have a single triangle per segment.
+      if (r > 0)
+        facet(a, b, d);
+      if (r + 1 < rings)
+        facet(b, c, d);
+    }
+  }
+  out << "endsolid sphere\n";
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a model with a single shape.
+/// \param[in] _name Model name.
+/// \param[in] _pose Pose of the model.
+/// \param[in] _geometry SDF of the geometry.
+/// \param[in] _static True for a static model.
+/// \return SDF of the model.
+static std::string ShapeModel(const std::string &_name,
+    const ignition::math::Pose3d &_pose, const std::string &_geometry,
+    const bool _static)
+{
+  std::ostringstream sdf;
+  sdf << "<model name='" << _name << "'>"
+      << "<static>" << (_static ? "true" : "false") << "</static>"
+      << "<pose>" << _pose << "</pose>"
+      << "<link name='link'>"
+      << "<inertial><mass>1</mass><inertia>"
+      << "<ixx>0.1</ixx><iyy>0.1</iyy><izz>0.1</izz>"
+      << "</inertia></inertial>"
+      << "<collision name='collision'><geometry>" << _geometry
+      << "</geometry></collision></link></model>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a benchmark world.
+/// \param[in] _engine Physics engine name.
+/// \param[in] _pair Shape pair name.
+/// \param[in] _size Number of shape pairs.
+/// \param[in] _mesh Path of the STL file of the trimeshes.
+/// \return SDF of the world, empty if the pair is unknown.
+static std::string WorldSdf(const std::string &_engine,
+    const std::string &_pair, const unsigned int _size,
+    const std::string &_mesh)
+{
+  const std::string box = "<box><size>1 1 1</size></box>";
+  const std::string sphere = "<sphere><radius>0.5</radius></sphere>";
+  const std::string cylinder =
+      "<cylinder><radius>0.3</radius><length>1</length></cylinder>";
+  const std::string trimesh = "<mesh><uri>file://" + _mesh + "</uri></mesh>";
+
+  // The first shape of a pair is static, the second one is dynamic and
+  // overlaps it. Planes and heightmaps are shared by every pair.
+  std::string first;
+  std::string second;
+  std::string shared;
+  if (_pair == "box_box")
+  {
+    first = box;
+    second = box;
+  }
+  else if (_pair == "sphere_sphere")
+  {
+    first = sphere;
+    second = sphere;
+  }
+  else if (_pair == "cylinder_trimesh")
+  {
+    first = trimesh;
+    second = cylinder;
+  }
+  else if (_pair == "trimesh_trimesh")
+  {
+    first = trimesh;
+    second = trimesh;
+  }
+  else if (_pair == "box_plane")
+  {
+    shared = "<plane><normal>0 0 1</normal><size>1000 1000</size></plane>";
+    second = box;
+  }
+  else if (_pair == "heightmap_sphere")
+  {
+    shared = "<heightmap>"
+        "<uri>file://media/materials/textures/heightmap_bowl.png</uri>"
+        "<size>129 129 10</size><pos>0 0 0</pos></heightmap>";
+    second = sphere;
+  }
+  else
+    return std::string();
+
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0'?><sdf version='" << SDF_VERSION << "'>"
+      << "<world name='default'>"
+      << "<physics type='" << _engine << "'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "<real_time_update_rate>0</real_time_update_rate>"
+      << "</physics>"
+      << "<gravity>0 0 0</gravity>";
+
+  if (!shared.empty())
+  {
+    sdf << ShapeModel("shared", ignition::math::Pose3d::Zero, shared, true);
+  }
+
+  // Pairs on a square grid, far enough apart not to touch each other.
+  const double spacing = 3;
+  unsigned int side = static_cast<unsigned int>(std::ceil(std::sqrt(_size)));
+  for (unsigned int i = 0; i < _size; ++i)
+  {
+    double x = ((i % side) - side * 0.5) * spacing;
+    double y = ((i / side) - side * 0.5) * spacing;
+    std::string name = "pair_" + std::to_string(i);
+
+    if (!first.empty())
+    {
+      sdf << ShapeModel(name + "_a", ignition::math::Pose3d(x, y, 1, 0, 0, 0),
+          first, true);
+    }
+    // Tilted, so that the contacts aren't degenerate.
+    sdf << ShapeModel(name + "_b",
+        ignition::math::Pose3d(x + 0.3, y + 0.2, first.empty() ? 0.4 : 1.6,
+          0.3, 0.2, 0.1), second, false);
+  }
+
+  sdf << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a benchmark case.
+/// \param[in] _engine Physics engine name.
+/// \param[in] _pair Shape pair name.
+/// \param[in] _size Number of shape pairs.
+/// \param[in] _iterations Number of collision updates to run.
+/// \param[in] _mesh Path of the STL file of the trimeshes.
+/// \return The result of the case.
+static BenchmarkResult RunCase(const std::string &_engine,
+    const std::string &_pair, const unsigned int _size,
+    const unsigned int _iterations, const std::string &_mesh)
+{
+  BenchmarkResult result;
+  result.engine = _engine;
+  result.pair = _pair;
+  result.size = _size;
+
+  std::string sdf = WorldSdf(_engine, _pair, _size, _mesh);
+  if (sdf.empty())
+  {
+    result.error = "unknown shape pair";
+    return result;
+  }
+
+  boost::filesystem::path worldFile =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_benchmark_%%%%-%%%%.world");
+  {
+    std::ofstream out(worldFile.string());
+    out << sdf;
+  }
+
+  physics::WorldPtr world = gazebo::loadWorld(worldFile.string());
+  boost::filesystem::remove(worldFile);
+  if (!world || world->Physics()->GetType() != _engine)
+  {
+    result.error = "unable to load the world";
+    physics::remove_worlds();
+    return result;
+  }
+
+  // Rest the spheres on the heightmap.
+  if (_pair == "heightmap_sphere")
+  {
+    for (unsigned int i = 0; i < _size; ++i)
+    {
+      physics::ModelPtr model =
+          world->ModelByName("pair_" + std::to_string(i) + "_b");
+      if (!model)
+        continue;
+      ignition::math::Pose3d pose = model->WorldPose();
+      physics::SceneQueryHit hit;
+      if (world->SceneQueries().Ray(pose.Pos() + ignition::math::Vector3d(
+          0, 0, 100), pose.Pos() - ignition::math::Vector3d(0, 0, 100), hit))
+      {
+        pose.Pos().Z() = hit.point.Z() + 0.4;
+        model->SetWorldPose(pose);
+      }
+    }
+  }
+
+  // Without physics the engines detect the collisions in UpdateCollision.
+  world->SetPhysicsEnabled(false);
+  physics::PhysicsEnginePtr engine = world->Physics();
+  engine->GetContactManager()->SetNeverDropContacts(true);
+  engine->InitForThread();
+
+  // Warm up the caches of the broad phases.
+  for (unsigned int i = 0; i < 10; ++i)
+    engine->UpdateCollision();
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0; i < _iterations; ++i)
+    engine->UpdateCollision();
+  result.wallTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  result.iterations = _iterations;
+
+  physics::ContactManager *contactManager = engine->GetContactManager();
+  result.contacts = contactManager->GetContactCount();
+  auto const &contacts = contactManager->GetContacts();
+  for (unsigned int i = 0; i < result.contacts && i < contacts.size(); ++i)
+    result.contactPoints += contacts[i]->count;
+
+  engine.reset();
+  world.reset();
+  physics::remove_worlds();
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+static void WriteJson(std::ostream &_out,
+    const std::vector<BenchmarkResult> &_results)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const BenchmarkResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"engine\": \"" << r.engine << "\", "
+         << "\"pair\": \"" << r.pair << "\", "
+         << "\"size\": " << r.size;
+
+    if (!r.error.empty())
+    {
+      _out << ", \"error\": \"" << r.error << "\"}";
+      continue;
+    }
+
+    double update = r.iterations > 0 ? r.wallTime / r.iterations : 0.0;
+    _out << ", \"iterations\": " << r.iterations
+         << ", \"wall_time\": " << r.wallTime
+         << ", \"update_time_us\": " << update * 1e6
+         << ", \"pair_time_us\": " << (r.size > 0 ? update * 1e6 / r.size : 0)
+         << ", \"contacts\": " << r.contacts
+         << ", \"contact_points\": " << r.contactPoints << "}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> engines = {"ode"};
+#ifdef HAVE_BULLET
+  engines.push_back("bullet");
+#endif
+#ifdef HAVE_DART
+  engines.push_back("dart");
+#endif
+#ifdef HAVE_SIMBODY
+  engines.push_back("simbody");
+#endif
+
+  std::vector<std::string> pairs = {"box_box", "sphere_sphere", "box_plane",
+      "cylinder_trimesh", "trimesh_trimesh", "heightmap_sphere"};
+  std::vector<unsigned int> sizes = {10, 100};
+  unsigned int iterations = 1000;
+  unsigned int segments = 32;
+  std::string output;
+
+  po::options_description desc("Usage: gazebo_collision_benchmark [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("engine,e", po::value<std::vector<std::string> >(&engines)->composing(),
+     "Physics engine, can be repeated. Defaults to all available engines.")
+    ("pair,p", po::value<std::vector<std::string> >(&pairs)->composing(),
+     "Shape pair: box_box, sphere_sphere, box_plane, cylinder_trimesh, "
+     "trimesh_trimesh or heightmap_sphere. Can be repeated. Defaults to all.")
+    ("size,n", po::value<std::vector<unsigned int> >(&sizes)->composing(),
+     "Number of shape pairs. Can be repeated.")
+    ("iterations,i", po::value<unsigned int>(&iterations),
+     "Number of collision updates of each case.")
+    ("mesh-segments", po::value<unsigned int>(&segments),
+     "Number of segments around the trimesh spheres.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  boost::filesystem::path mesh =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_benchmark_%%%%-%%%%.stl");
+  WriteSphereStl(mesh.string(), 0.5, std::max(3u, segments));
+
+  std::vector<BenchmarkResult> results;
+  for (auto const &engine : engines)
+  {
+    for (auto const &pair : pairs)
+    {
+      for (auto const size : sizes)
+      {
+        gzmsg << "Running " << pair << "[" << size << "] on " << engine
+              << std::endl;
+        results.push_back(RunCase(engine, pair, size, iterations,
+            mesh.string()));
+      }
+    }
+  }
+
+  boost::filesystem::remove(mesh);
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Regression benchmark of the physics step on a set of reference worlds.
+//
+// Each world is loaded headless with a fixed seed for gazebo and for the
+// physics engine, stepped until its plugins are loaded, warmed up, then
+// stepped a fixed number of iterations through World::Step(n) as fast as
+// possible, --repeat times. The results are printed as JSON: the median
+// steps per second, the contacts per step, the solver iterations of the
+// world, and the resident and accounted memory after the run.
+//
+// To track regressions, keep the output of a build as the baseline of a
+// machine and compare the output of the next builds with
+// reference_compare.py, which flags the worlds that got slower or bigger
+// by more than a threshold. The contacts per step are deterministic for
+// a seed, a change means that the simulation itself changed.
+//
+// Example:
+//   gazebo_reference_benchmark -o baseline.json
+//   gazebo_reference_benchmark -o current.json
+//   reference_compare.py baseline.json current.json --threshold 5
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <ignition/math/Rand.hh>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/common/MemoryAccounts.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Result of a reference world.
+struct BenchmarkResult
+{
+  /// \brief World file.
+  std::string world;
+
+  /// \brief Steps per second of each run.
+  std::vector<double> stepRates;
+
+  /// \brief Mean number of contacts per step of the first run.
+  double contacts = 0;
+
+  /// \brief Solver iterations per step of the world.
+  int solverIterations = 0;
+
+  /// \brief Resident memory after the first run in bytes.
+  int64_t rss = 0;
+
+  /// \brief Growth of the resident memory over the first run in bytes.
+  int64_t rssGrowth = 0;
+
+  /// \brief Memory of the accounted pools after the first run in bytes.
+  int64_t accounted = 0;
+
+  /// \brief Error message, empty on success.
+  std::string error;
+};
+
+/////////////////////////////////////////////////
+/// \brief Get the resident memory of the process.
+/// \return Resident memory in bytes, 0 if unknown.
+static int64_t ResidentMemory()
+{
+  std::ifstream statm("/proc/self/statm");
+  int64_t size = 0;
+  int64_t resident = 0;
+  if (!(statm >> size >> resident))
+    return 0;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get an integer parameter of the physics engine.
+/// \param[in] _physics The physics engine.
+/// \param[in] _key Key of the parameter.
+/// \return The value, 0 if the engine doesn't have it.
+static int IntParam(const physics::PhysicsEnginePtr &_physics,
+    const std::string &_key)
+{
+  boost::any value;
+  if (!_physics->GetParam(_key, value))
+    return 0;
+
+  try
+  {
+    return boost::any_cast<int>(value);
+  }
+  catch(boost::bad_any_cast &)
+  {
+    return 0;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a reference world once.
+/// \param[in] _file Path of the world file.
+/// \param[in] _seed Random seed.
+/// \param[in] _warmup Number of untimed steps.
+/// \param[in] _iterations Number of timed steps.
+/// \param[in] _first True to fill the counters of the result.
+/// \param[in,out] _result The result.
+static void RunOnce(const std::string &_file, const unsigned int _seed,
+    const unsigned int _warmup, const unsigned int _iterations,
+    const bool _first, BenchmarkResult &_result)
+{
+  const int64_t rssStart = ResidentMemory();
+
+  ignition::math::Rand::Seed(_seed);
+  physics::WorldPtr world = gazebo::loadWorld(_file);
+  if (!world)
+  {
+    _result.error = "Unable to load the world";
+    return;
+  }
+
+  physics::PhysicsEnginePtr physics = world->Physics();
+  physics->SetSeed(_seed);
+  physics->SetRealTimeUpdateRate(0);
+
+  // World::Step loads the plugins once the sensors are initialized.
+  for (unsigned int i = 0; i < 1000 && !world->PluginsLoaded(); ++i)
+  {
+    sensors::run_once(true);
+    gazebo::runWorld(world, 1);
+  }
+
+  world->SetPaused(true);
+  world->Run();
+  world->Step(_warmup);
+
+  // ODE counts the contacts of the last step, read them after each one.
+  int64_t contacts = 0;
+  event::ConnectionPtr updateEnd = event::Events::ConnectWorldUpdateEnd(
+      [&contacts, &physics]()
+      {
+        contacts += IntParam(physics, "num_contacts");
+      });
+
+  auto start = std::chrono::steady_clock::now();
+  world->Step(_iterations);
+  const double wallTime = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  updateEnd.reset();
+
+  world->Stop();
+
+  if (wallTime > 0)
+    _result.stepRates.push_back(_iterations / wallTime);
+
+  if (_first)
+  {
+    _result.contacts = _iterations > 0 ?
+        static_cast<double>(contacts) / _iterations : 0;
+    _result.solverIterations = IntParam(physics, "iters");
+    _result.rss = ResidentMemory();
+    _result.rssGrowth = _result.rss - rssStart;
+    for (auto const &sample : common::MemoryAccounts::Instance()->Samples())
+      _result.accounted += sample.bytes;
+  }
+
+  physics.reset();
+  world.reset();
+  physics::remove_worlds();
+  sensors::remove_sensors();
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a reference world.
+/// \param[in] _world World file, found in the resource paths.
+/// \param[in] _seed Random seed.
+/// \param[in] _warmup Number of untimed steps.
+/// \param[in] _iterations Number of timed steps.
+/// \param[in] _repeat Number of runs.
+/// \return The result of the world.
+static BenchmarkResult RunCase(const std::string &_world,
+    const unsigned int _seed, const unsigned int _warmup,
+    const unsigned int _iterations, const unsigned int _repeat)
+{
+  BenchmarkResult result;
+  result.world = _world;
+
+  const std::string file = common::find_file(_world);
+  if (file.empty())
+  {
+    result.error = "World file not found";
+    return result;
+  }
+
+  for (unsigned int i = 0; i < _repeat && result.error.empty(); ++i)
+    RunOnce(file, _seed, _warmup, _iterations, i == 0, result);
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+/// \param[in] _seed Random seed.
+/// \param[in] _iterations Number of timed steps.
+static void WriteJson(std::ostream &_out,
+    const std::vector<BenchmarkResult> &_results, const unsigned int _seed,
+    const unsigned int _iterations)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"seed\": " << _seed << ",\n"
+       << "  \"iterations\": " << _iterations << ",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const BenchmarkResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"world\": \"" << r.world << "\"";
+
+    if (!r.error.empty() || r.stepRates.empty())
+    {
+      _out << ", \"error\": \""
+           << (r.error.empty() ? "No timed steps" : r.error) << "\"}";
+      continue;
+    }
+
+    std::vector<double> rates = r.stepRates;
+    std::sort(rates.begin(), rates.end());
+
+    _out << ", \"steps_per_second\": " << rates[rates.size() / 2]
+         << ", \"runs\": [";
+    for (size_t j = 0; j < r.stepRates.size(); ++j)
+      _out << (j == 0 ? "" : ", ") << r.stepRates[j];
+    _out << "],\n     \"contacts_per_step\": " << r.contacts
+         << ", \"solver_iterations\": " << r.solverIterations
+         << ", \"rss_bytes\": " << r.rss
+         << ", \"rss_growth_bytes\": " << r.rssGrowth
+         << ", \"accounted_bytes\": " << r.accounted << "}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> worlds = {"worlds/shapes.world",
+      "worlds/friction_pyramid.world", "worlds/stacks.world",
+      "worlds/rubble.world", "worlds/pioneer2dx.world",
+      "worlds/heightmap.world", "worlds/pr2.world"};
+  unsigned int seed = 1234;
+  unsigned int warmup = 100;
+  unsigned int iterations = 2000;
+  unsigned int repeat = 5;
+  std::string output;
+
+  po::options_description desc(
+      "Usage: gazebo_reference_benchmark [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("world,w", po::value<std::vector<std::string> >(&worlds)->composing(),
+     "World file, can be repeated. Defaults to the reference worlds.")
+    ("seed,s", po::value<unsigned int>(&seed),
+     "Random seed of gazebo and of the physics engine.")
+    ("warmup", po::value<unsigned int>(&warmup),
+     "Number of untimed steps before each run.")
+    ("iterations,i", po::value<unsigned int>(&iterations),
+     "Number of timed steps of each run.")
+    ("repeat,r", po::value<unsigned int>(&repeat),
+     "Number of runs of each world, the median is reported.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (auto const &world : worlds)
+  {
+    gzmsg << "Running " << world << std::endl;
+    results.push_back(RunCase(world, seed, warmup, iterations,
+        std::max(1u, repeat)));
+  }
+
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results, seed, iterations);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results, seed, iterations);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#!/usr/bin/env python
+#
+# Copyright (C) 2026 Open Source Robotics Foundation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Compares an output of gazebo_reference_benchmark with a baseline.
+
+A world regresses when its steps per second drop, or its memory grows, by
+more than the threshold in percent. A change of the contacts per step or
+of the solver iterations is reported: the simulation itself changed, and
+the timings aren't comparable. The exit code is 1 on a regression, so the
+comparison can gate a perf lab job.
+
+Example:
+  reference_compare.py baseline.json current.json --threshold 5
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        data = json.load(f)
+    return data, dict((r['world'], r) for r in data['results'])
+
+
+def change(old, new):
+    if old == 0:
+        return 0.0
+    return 100.0 * (new - old) / old
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare reference benchmark results with a baseline.')
+    parser.add_argument('baseline', help='JSON output of the baseline.')
+    parser.add_argument('current', help='JSON output to check.')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help='Largest allowed slowdown or memory growth, '
+                             'in percent.')
+    parser.add_argument('--memory-threshold', type=float,
+                        help='Largest allowed memory growth in percent, '
+                             'defaults to the threshold.')
+    args = parser.parse_args()
+    memory_threshold = args.memory_threshold
+    if memory_threshold is None:
+        memory_threshold = args.threshold
+
+    baseline, baseResults = load(args.baseline)
+    current, currentResults = load(args.current)
+
+    for key in ('seed', 'iterations'):
+        if baseline.get(key) != current.get(key):
+            print('warning: the %s differs, %s instead of %s' %
+                  (key, current.get(key), baseline.get(key)))
+
+    regressions = 0
+    print('%-32s %12s %12s %8s %8s' %
+          ('world', 'base step/s', 'step/s', 'speed', 'memory'))
+    for world in sorted(baseResults):
+        base = baseResults[world]
+        if world not in currentResults:
+            print('%-32s missing' % world)
+            regressions += 1
+            continue
+
+        cur = currentResults[world]
+        if 'error' in cur:
+            print('%-32s error: %s' % (world, cur['error']))
+            regressions += 1
+            continue
+        if 'error' in base:
+            print('%-32s no baseline: %s' % (world, base['error']))
+            continue
+
+        speed = change(base['steps_per_second'], cur['steps_per_second'])
+        memory = change(base['rss_bytes'], cur['rss_bytes'])
+
+        flags = []
+        if -speed > args.threshold:
+            flags.append('SLOWER')
+        if memory > memory_threshold:
+            flags.append('BIGGER')
+        if flags:
+            regressions += 1
+
+        if abs(base['contacts_per_step'] - cur['contacts_per_step']) > 1e-6:
+            flags.append('contacts %g -> %g' %
+                         (base['contacts_per_step'],
+                          cur['contacts_per_step']))
+        if base['solver_iterations'] != cur['solver_iterations']:
+            flags.append('iterations %d -> %d' %
+                         (base['solver_iterations'],
+                          cur['solver_iterations']))
+
+        print('%-32s %12.1f %12.1f %+7.1f%% %+7.1f%% %s' %
+              (world, base['steps_per_second'], cur['steps_per_second'],
+               speed, memory, ' '.join(flags)))
+
+    if regressions:
+        print('%d regression(s) above %g%%' % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,629 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Benchmark of the update cost of the sensors.
+//
+// Each case generates a world with a few shapes and a number of sensors of
+// one type, loads it headless and steps it one iteration at a time. After
+// each iteration the rendering sensors run through sensors::run_once, and
+// the other sensors are updated by the benchmark instead of the sensor
+// threads, so that every case is deterministic. The results are printed as
+// JSON, by sensor type: the wall time of an update, split into the render
+// pass, the readback and the publication of the data, and the update rate
+// achieved in simulation time against the requested one.
+//
+// The render pass is timed by the render job queue. The readback ends with
+// the new frame event of the rendering camera, and the publication with the
+// updated event of the sensor. Sensors only publish to the topics that have
+// subscribers, use --subscribe to include the cost of the messages.
+//
+// Example:
+//   gazebo_sensor_benchmark --sensor camera --sensor ray --count 4 -o out.json
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/rendering/rendering.hh"
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/transport/transport.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Result of a sensor type in a benchmark case.
+struct SensorResult
+{
+  /// \brief Sensor type.
+  std::string type;
+
+  /// \brief Number of sensors of the type.
+  unsigned int count = 0;
+
+  /// \brief Requested update rate of each sensor in Hz.
+  double requestedRate = 0;
+
+  /// \brief Number of updates of all the sensors of the type.
+  uint64_t updates = 0;
+
+  /// \brief Total wall time of the render passes in seconds.
+  double renderTime = 0;
+
+  /// \brief Total wall time of the readbacks in seconds.
+  double readbackTime = 0;
+
+  /// \brief Total wall time of the updates after the readbacks, which
+  /// fill and publish the messages, in seconds.
+  double publishTime = 0;
+};
+
+/// \brief Result of a benchmark case.
+struct BenchmarkResult
+{
+  /// \brief Sensor type of the case.
+  std::string sensor;
+
+  /// \brief Number of sensors of the case.
+  unsigned int count = 0;
+
+  /// \brief Number of iterations run.
+  unsigned int iterations = 0;
+
+  /// \brief Wall clock time of the run in seconds.
+  double wallTime = 0;
+
+  /// \brief Simulation time of the run in seconds.
+  double simTime = 0;
+
+  /// \brief Results by sensor type. Wireless receivers come with their
+  /// transmitter.
+  std::vector<SensorResult> sensors;
+
+  /// \brief Error message, empty if the case ran.
+  std::string error;
+};
+
+/// \brief Times the readback and the publication of a sensor.
+class SensorTimer
+{
+  /// \brief Clock used for timing.
+  public: using Clock = std::chrono::steady_clock;
+
+  /// \brief Constructor. Connects to the events of the sensor.
+  /// \param[in] _sensor The sensor.
+  public: explicit SensorTimer(sensors::SensorPtr _sensor)
+    : sensor(_sensor)
+  {
+    auto onFrame = [this]()
+    {
+      this->frame = Clock::now();
+      this->framed = true;
+    };
+
+    // The rendering sensors read back their data before the frame
+    // events, the other sensors have no readback.
+    if (auto depth =
+        std::dynamic_pointer_cast<sensors::DepthCameraSensor>(_sensor))
+    {
+      this->connections.push_back(depth->DepthCamera()->ConnectNewDepthFrame(
+          [onFrame](const float *, unsigned int, unsigned int, unsigned int,
+              const std::string &)
+          {
+            onFrame();
+          }));
+    }
+    else if (auto camera =
+        std::dynamic_pointer_cast<sensors::CameraSensor>(_sensor))
+    {
+      this->connections.push_back(camera->Camera()->ConnectNewImageFrame(
+          [onFrame](const unsigned char *, unsigned int, unsigned int,
+              unsigned int, const std::string &)
+          {
+            onFrame();
+          }));
+    }
+    else if (auto gpuRay =
+        std::dynamic_pointer_cast<sensors::GpuRaySensor>(_sensor))
+    {
+      this->connections.push_back(gpuRay->LaserCamera()->ConnectNewLaserFrame(
+          [onFrame](const float *, unsigned int, unsigned int, unsigned int,
+              const std::string &)
+          {
+            onFrame();
+          }));
+    }
+
+    this->connections.push_back(_sensor->ConnectUpdated([this]()
+        {
+          if (this->framed)
+            this->published += Clock::now() - this->frame;
+          this->framed = false;
+        }));
+  }
+
+  /// \brief The sensor.
+  public: sensors::SensorPtr sensor;
+
+  /// \brief Time of the last frame event.
+  public: Clock::time_point frame;
+
+  /// \brief True if a frame was read back since the last update.
+  public: bool framed = false;
+
+  /// \brief Total time from the frame events to the end of the updates.
+  public: Clock::duration published = Clock::duration::zero();
+
+  /// \brief Event connections.
+  private: std::vector<event::ConnectionPtr> connections;
+};
+
+/////////////////////////////////////////////////
+/// \brief Receive the serialized messages of a sensor, so that it
+/// publishes them.
+static void OnMessage(const std::string &/*_msg*/)
+{
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a sensor.
+/// \param[in] _type Sensor type.
+/// \param[in] _name Sensor name.
+/// \param[in] _rate Update rate in Hz.
+/// \return SDF of the sensor, empty if the type is unknown.
+static std::string SensorSdf(const std::string &_type,
+    const std::string &_name, const double _rate)
+{
+  const std::string scan =
+      "<scan><horizontal><samples>640</samples><resolution>1</resolution>"
+      "<min_angle>-1.5708</min_angle><max_angle>1.5708</max_angle>"
+      "</horizontal></scan>"
+      "<range><min>0.1</min><max>10</max><resolution>0.01</resolution>"
+      "</range>";
+
+  std::ostringstream sdf;
+  sdf << "<sensor name='" << _name << "' type='" << _type << "'>"
+      << "<always_on>true</always_on>"
+      << "<update_rate>" << _rate << "</update_rate>";
+
+  if (_type == "camera" || _type == "depth")
+  {
+    sdf << "<camera><horizontal_fov>1.047</horizontal_fov>"
+        << "<image><width>320</width><height>240</height></image>"
+        << "<clip><near>0.1</near><far>100</far></clip></camera>";
+  }
+  else if (_type == "gpu_ray" || _type == "ray")
+    sdf << "<ray>" << scan << "</ray>";
+  else if (_type == "contact")
+    sdf << "<contact><collision>collision</collision></contact>";
+  else if (_type == "logical_camera")
+  {
+    sdf << "<logical_camera><near>0.1</near><far>10</far>"
+        << "<horizontal_fov>1.047</horizontal_fov>"
+        << "<aspect_ratio>1.333</aspect_ratio></logical_camera>";
+  }
+  else if (_type == "sonar")
+  {
+    sdf << "<sonar><min>0</min><max>5</max><radius>0.3</radius>"
+        << "<geometry>cone</geometry></sonar>";
+  }
+  else if (_type == "wireless_receiver")
+    sdf << "<transceiver><gain>2.5</gain><power>14.5</power></transceiver>";
+  else if (_type == "wireless_transmitter")
+  {
+    sdf << "<transceiver><essid>benchmark</essid>"
+        << "<frequency>2442.0</frequency></transceiver>";
+  }
+  else if (_type != "imu")
+    return std::string();
+
+  sdf << "</sensor>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a model holding a sensor.
+/// \param[in] _name Model name.
+/// \param[in] _pose Pose of the model.
+/// \param[in] _sensor SDF of the sensor.
+/// \param[in] _static True for a static model.
+/// \return SDF of the model.
+static std::string SensorModel(const std::string &_name,
+    const ignition::math::Pose3d &_pose, const std::string &_sensor,
+    const bool _static)
+{
+  std::ostringstream sdf;
+  sdf << "<model name='" << _name << "'>"
+      << "<static>" << (_static ? "true" : "false") << "</static>"
+      << "<pose>" << _pose << "</pose>"
+      << "<link name='link'>"
+      << "<inertial><mass>1</mass><inertia>"
+      << "<ixx>0.0017</ixx><iyy>0.0017</iyy><izz>0.0017</izz>"
+      << "</inertia></inertial>"
+      << "<collision name='collision'><geometry><box>"
+      << "<size>0.1 0.1 0.1</size></box></geometry></collision>"
+      << "<visual name='visual'><geometry><box>"
+      << "<size>0.1 0.1 0.1</size></box></geometry></visual>"
+      << _sensor
+      << "</link></model>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a benchmark world.
+/// \param[in] _name World name.
+/// \param[in] _type Sensor type.
+/// \param[in] _count Number of sensors.
+/// \param[in] _rate Update rate of the sensors in Hz.
+/// \return SDF of the world, empty if the sensor type is unknown.
+static std::string WorldSdf(const std::string &_name,
+    const std::string &_type, const unsigned int _count, const double _rate)
+{
+  if (SensorSdf(_type, "sensor", _rate).empty())
+    return std::string();
+
+  std::ostringstream sdf;
+  sdf << "<?xml version='1.0'?><sdf version='" << SDF_VERSION << "'>"
+      << "<world name='" << _name << "'>"
+      << "<physics type='ode'>"
+      << "<max_step_size>0.001</max_step_size>"
+      << "<real_time_update_rate>0</real_time_update_rate>"
+      << "</physics>"
+      << "<light name='sun' type='directional'>"
+      << "<direction>-0.5 0.1 -0.9</direction></light>"
+      << "<model name='ground_plane'><static>true</static>"
+      << "<link name='link'>"
+      << "<collision name='collision'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></collision>"
+      << "<visual name='visual'><geometry>"
+      << "<plane><normal>0 0 1</normal><size>100 100</size></plane>"
+      << "</geometry></visual></link></model>";
+
+  // A ring of shapes for the sensors to see around them.
+  const unsigned int shapes = 16;
+  for (unsigned int i = 0; i < shapes; ++i)
+  {
+    double angle = 2 * IGN_PI * i / shapes;
+    std::string geometry = i % 2 == 0 ?
+        "<box><size>0.8 0.8 0.8</size></box>" :
+        "<sphere><radius>0.4</radius></sphere>";
+    sdf << "<model name='shape_" << i << "'><static>true</static>"
+        << "<pose>" << 5 * std::cos(angle) << " " << 5 * std::sin(angle)
+        << " 0.4 0 0 0</pose><link name='link'>"
+        << "<collision name='collision'><geometry>" << geometry
+        << "</geometry></collision>"
+        << "<visual name='visual'><geometry>" << geometry
+        << "</geometry></visual></link></model>";
+  }
+
+  // The sensors look outwards from an inner ring. Contact sensors sit on
+  // boxes resting on the ground.
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    double angle = 2 * IGN_PI * i / std::max(_count, 1u);
+    bool contact = _type == "contact";
+    ignition::math::Pose3d pose(std::cos(angle), std::sin(angle),
+        contact ? 0.05 : 0.5, 0, 0, angle);
+    std::string name = "sensor_" + std::to_string(i);
+    sdf << SensorModel(name, pose, SensorSdf(_type, "sensor", _rate),
+        !contact);
+  }
+
+  if (_type == "wireless_receiver")
+  {
+    sdf << SensorModel("transmitter", ignition::math::Pose3d(0, 0, 1, 0, 0, 0),
+        SensorSdf("wireless_transmitter", "sensor", _rate), true);
+  }
+
+  sdf << "</world></sdf>";
+  return sdf.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a benchmark case.
+/// \param[in] _type Sensor type.
+/// \param[in] _count Number of sensors.
+/// \param[in] _rate Update rate of the sensors in Hz.
+/// \param[in] _iterations Number of iterations to run.
+/// \param[in] _subscribe True to subscribe to the topics of the sensors.
+/// \return The result of the case.
+static BenchmarkResult RunCase(const std::string &_type,
+    const unsigned int _count, const double _rate,
+    const unsigned int _iterations, const bool _subscribe)
+{
+  BenchmarkResult result;
+  result.sensor = _type;
+  result.count = _count;
+
+  // A world per case, so that each case gets its own scene.
+  std::string worldName = "sensor_benchmark_" + _type + "_" +
+      std::to_string(_count);
+  std::string sdf = WorldSdf(worldName, _type, _count, _rate);
+  if (sdf.empty())
+  {
+    result.error = "unknown sensor type";
+    return result;
+  }
+
+  boost::filesystem::path worldFile =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo_benchmark_%%%%-%%%%.world");
+  {
+    std::ofstream out(worldFile.string());
+    out << sdf;
+  }
+
+  physics::WorldPtr world = gazebo::loadWorld(worldFile.string());
+  boost::filesystem::remove(worldFile);
+  if (!world)
+  {
+    result.error = "unable to load the world";
+    physics::remove_worlds();
+    return result;
+  }
+
+  // Initialize the sensors created by the world, and let the contacts
+  // settle before timing.
+  sensors::run_once(true);
+  gazebo::runWorld(world, 10);
+
+  std::vector<std::unique_ptr<SensorTimer>> timers;
+  for (auto const &sensor : sensors::SensorManager::Instance()->GetSensors())
+  {
+    if (sensor->WorldName() == worldName)
+      timers.emplace_back(new SensorTimer(sensor));
+  }
+  if (timers.empty())
+  {
+    result.error = "unable to create the sensors";
+    sensors::remove_sensors();
+    sensors::run_once(true);
+    world.reset();
+    physics::remove_worlds();
+    return result;
+  }
+
+  transport::NodePtr node;
+  std::vector<transport::SubscriberPtr> subscribers;
+  if (_subscribe)
+  {
+    node.reset(new transport::Node());
+    node->Init(worldName);
+    for (auto const &timer : timers)
+    {
+      if (!timer->sensor->Topic().empty())
+      {
+        subscribers.push_back(
+            node->Subscribe(timer->sensor->Topic(), &OnMessage));
+      }
+    }
+  }
+
+  sensors::RenderJobQueue::Instance()->ResetStats();
+  for (auto const &timer : timers)
+    timer->sensor->ResetUpdateStats();
+
+  common::Time startSimTime = world->SimTime();
+  auto start = SensorTimer::Clock::now();
+  for (unsigned int i = 0; i < _iterations; ++i)
+  {
+    gazebo::runWorld(world, 1);
+    sensors::run_once(false);
+    for (auto const &timer : timers)
+    {
+      if (timer->sensor->Category() != sensors::IMAGE)
+        timer->sensor->Update(false);
+    }
+  }
+  result.wallTime = std::chrono::duration<double>(
+      SensorTimer::Clock::now() - start).count();
+  result.iterations = _iterations;
+  result.simTime = (world->SimTime() - startSimTime).Double();
+
+  std::map<std::string, SensorResult> byType;
+  for (auto const &timer : timers)
+  {
+    SensorResult &r = byType[timer->sensor->Type()];
+    r.type = timer->sensor->Type();
+    ++r.count;
+    r.requestedRate = timer->sensor->UpdateRate();
+    r.updates += timer->sensor->UpdateCount();
+
+    // The update of a rendering sensor runs after its render pass, and
+    // covers the readback and the publication.
+    double update = timer->sensor->UpdateWallTime().Double();
+    double published =
+        std::chrono::duration<double>(timer->published).count();
+    sensors::RenderJobQueue::Stats stats;
+    if (sensors::RenderJobQueue::Instance()->JobStats(
+        timer->sensor->ScopedName(), stats))
+    {
+      r.renderTime += stats.renderTime.Double();
+      r.readbackTime += std::max(0.0, update - published);
+      r.publishTime += published;
+    }
+    else
+    {
+      r.publishTime += update;
+    }
+  }
+  for (auto const &type : byType)
+    result.sensors.push_back(type.second);
+
+  subscribers.clear();
+  node.reset();
+  timers.clear();
+  sensors::remove_sensors();
+  sensors::run_once(true);
+  world.reset();
+  physics::remove_worlds();
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+static void WriteJson(std::ostream &_out,
+    const std::vector<BenchmarkResult> &_results)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const BenchmarkResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"sensor\": \"" << r.sensor << "\", "
+         << "\"count\": " << r.count;
+
+    if (!r.error.empty())
+    {
+      _out << ", \"error\": \"" << r.error << "\"}";
+      continue;
+    }
+
+    _out << ", \"iterations\": " << r.iterations
+         << ", \"wall_time\": " << r.wallTime
+         << ", \"sim_time\": " << r.simTime
+         << ", \"sensors\": [";
+
+    for (size_t j = 0; j < r.sensors.size(); ++j)
+    {
+      const SensorResult &s = r.sensors[j];
+      double updates = static_cast<double>(s.updates);
+      auto perUpdate = [updates](const double _time)
+      {
+        return updates > 0 ? _time / updates : 0.0;
+      };
+
+      _out << (j == 0 ? "" : ", ")
+           << "{\"type\": \"" << s.type << "\", "
+           << "\"count\": " << s.count
+           << ", \"updates\": " << s.updates
+           << ", \"wall_time_per_update\": " << perUpdate(
+               s.renderTime + s.readbackTime + s.publishTime)
+           << ", \"split\": {\"render\": " << perUpdate(s.renderTime)
+           << ", \"readback\": " << perUpdate(s.readbackTime)
+           << ", \"publish\": " << perUpdate(s.publishTime) << "}"
+           << ", \"requested_rate\": " << s.requestedRate
+           << ", \"achieved_rate\": " << (r.simTime > 0 && s.count > 0 ?
+               updates / s.count / r.simTime : 0.0)
+           << "}";
+    }
+    _out << "]}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> types = {"camera", "depth", "gpu_ray", "ray",
+      "imu", "contact", "logical_camera", "sonar", "wireless_receiver"};
+  std::vector<unsigned int> counts = {1, 8};
+  double rate = 30;
+  unsigned int iterations = 1000;
+  std::string output;
+
+  po::options_description desc("Usage: gazebo_sensor_benchmark [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("sensor,s", po::value<std::vector<std::string> >(&types)->composing(),
+     "Sensor type: camera, depth, gpu_ray, ray, imu, contact, logical_camera,"
+     " sonar or wireless_receiver. Can be repeated. Defaults to all.")
+    ("count,n", po::value<std::vector<unsigned int> >(&counts)->composing(),
+     "Number of sensors of the type. Can be repeated.")
+    ("rate,r", po::value<double>(&rate),
+     "Requested update rate of the sensors in Hz.")
+    ("iterations,i", po::value<unsigned int>(&iterations),
+     "Number of iterations of each case.")
+    ("subscribe", "Subscribe to the topics of the sensors.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (auto const &type : types)
+  {
+    for (auto const count : counts)
+    {
+      gzmsg << "Running " << count << " " << type << " sensors" << std::endl;
+      results.push_back(RunCase(type, count, rate, iterations,
+          vm.count("subscribe") > 0));
+    }
+  }
+
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+  return 0;
+}
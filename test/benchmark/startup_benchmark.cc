@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Benchmark of the startup of the server on a set of worlds.
+//
+// Each world is loaded headless with the StartupProfiler started, then
+// stepped until its world plugins are loaded, which is where the startup
+// of gzserver ends. Every world runs --repeat times: the first run is
+// cold, the next ones find the meshes in the MeshManager and the plugins
+// already opened. The results are printed as JSON: the startup time of
+// each run, and the time by phase of the cold run, to compare between
+// builds to catch startup regressions.
+//
+// Example:
+//   gazebo_startup_benchmark --world worlds/shapes.world --repeat 5
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/common/StartupProfiler.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/sensors.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Result of a benchmark world.
+struct BenchmarkResult
+{
+  /// \brief World file.
+  std::string world;
+
+  /// \brief Startup time of each run in seconds, the cold run first.
+  std::vector<double> startupTimes;
+
+  /// \brief Time by phase of the cold run.
+  std::vector<common::StartupProfiler::Entry> phases;
+
+  /// \brief Error message, empty on success.
+  std::string error;
+};
+
+/////////////////////////////////////////////////
+/// \brief Load a world and step it until its plugins are loaded.
+/// \param[in] _file Path of the world file.
+/// \param[in] _maxSteps Largest number of steps to wait for the plugins.
+/// \param[out] _error Error message.
+/// \return Startup time in seconds, negative on error.
+static double RunOnce(const std::string &_file, const unsigned int _maxSteps,
+    std::string &_error)
+{
+  common::StartupProfiler *profiler = common::StartupProfiler::Instance();
+  profiler->Start("");
+
+  double result = -1;
+  physics::WorldPtr world = gazebo::loadWorld(_file);
+  if (!world)
+  {
+    _error = "Unable to load the world";
+  }
+  else
+  {
+    // World::Step loads the plugins once the sensors are initialized.
+    for (unsigned int i = 0; i < _maxSteps && !world->PluginsLoaded(); ++i)
+    {
+      sensors::run_once(true);
+      gazebo::runWorld(world, 1);
+    }
+
+    if (world->PluginsLoaded())
+      result = profiler->Duration();
+    else
+      _error = "World plugins not loaded";
+  }
+
+  profiler->Finish();
+  physics::remove_worlds();
+  sensors::remove_sensors();
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a benchmark world.
+/// \param[in] _world World file, found in the resource paths.
+/// \param[in] _repeat Number of runs.
+/// \param[in] _maxSteps Largest number of steps to wait for the plugins.
+/// \return The result of the world.
+static BenchmarkResult RunCase(const std::string &_world,
+    const unsigned int _repeat, const unsigned int _maxSteps)
+{
+  BenchmarkResult result;
+  result.world = _world;
+
+  const std::string file = common::find_file(_world);
+  if (file.empty())
+  {
+    result.error = "World file not found";
+    return result;
+  }
+
+  for (unsigned int i = 0; i < _repeat; ++i)
+  {
+    double time = RunOnce(file, _maxSteps, result.error);
+    if (time < 0)
+      return result;
+
+    result.startupTimes.push_back(time);
+    if (i == 0)
+      result.phases = common::StartupProfiler::Instance()->Phases();
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+/// \param[in] _rows Largest number of phases of each world.
+static void WriteJson(std::ostream &_out,
+    const std::vector<BenchmarkResult> &_results, const unsigned int _rows)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const BenchmarkResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"world\": \"" << r.world << "\"";
+
+    if (!r.error.empty())
+    {
+      _out << ", \"error\": \"" << r.error << "\"}";
+      continue;
+    }
+
+    std::vector<double> warm(r.startupTimes.begin() + 1,
+        r.startupTimes.end());
+    std::sort(warm.begin(), warm.end());
+
+    _out << ", \"cold_ms\": " << r.startupTimes[0] * 1e3;
+    if (!warm.empty())
+      _out << ", \"warm_median_ms\": " << warm[warm.size() / 2] * 1e3;
+
+    _out << ", \"runs_ms\": [";
+    for (size_t j = 0; j < r.startupTimes.size(); ++j)
+      _out << (j == 0 ? "" : ", ") << r.startupTimes[j] * 1e3;
+    _out << "],\n     \"phases\": [";
+
+    for (size_t j = 0; j < r.phases.size() && j < _rows; ++j)
+    {
+      const common::StartupProfiler::Entry &p = r.phases[j];
+      _out << (j == 0 ? "\n" : ",\n")
+           << "       {\"name\": \"" << p.name << "\", "
+           << "\"calls\": " << p.calls << ", "
+           << "\"total_ms\": " << p.totalTime * 1e3 << ", "
+           << "\"self_ms\": " << p.selfTime * 1e3 << "}";
+    }
+    _out << "]}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> worlds = {"worlds/empty.world",
+      "worlds/shapes.world", "worlds/pioneer2dx.world",
+      "worlds/heightmap.world", "worlds/pr2.world"};
+  unsigned int repeat = 3;
+  unsigned int maxSteps = 1000;
+  unsigned int rows = 15;
+  std::string output;
+
+  po::options_description desc("Usage: gazebo_startup_benchmark [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("world,w", po::value<std::vector<std::string> >(&worlds)->composing(),
+     "World file, can be repeated. Defaults to a set of the installed "
+     "worlds.")
+    ("repeat,r", po::value<unsigned int>(&repeat),
+     "Number of runs of each world, the first one cold.")
+    ("max-steps", po::value<unsigned int>(&maxSteps),
+     "Largest number of steps to wait for the world plugins.")
+    ("rows", po::value<unsigned int>(&rows),
+     "Largest number of phases reported for each world.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (auto const &world : worlds)
+  {
+    gzmsg << "Running " << world << std::endl;
+    results.push_back(RunCase(world, std::max(1u, repeat), maxSteps));
+  }
+
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results, rows);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results, rows);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,778 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Benchmark of the latency and the throughput of gazebo transport.
+//
+// Each case publishes image messages of a payload size to a number of
+// subscribers over a path:
+//
+// - local: the subscribers are in this process, which skips the sockets.
+// - loopback: the subscribers are in an echo process started on this
+//   machine, and the messages go through TCP to localhost and back.
+// - remote: the subscribers are in an echo process started by hand on
+//   another machine, with GAZEBO_MASTER_URI pointing to this one:
+//     gazebo_transport_benchmark --echo
+//
+// The latency is measured one message at a time, from the publish call to
+// the callback. Through an echo process it is half the round trip, so that
+// the clocks of the machines don't matter. The throughput is measured by
+// publishing a burst of messages and waiting for all the callbacks. The
+// results are printed as JSON, with the 50th, 99th and 99.9th percentiles
+// of the latency.
+//
+// With --load, it replays instead a load profile recorded from a
+// simulation with "gz topic --record-load", to a local subscriber of each
+// topic, and reports how far the publications fell behind the profile and
+// how many messages arrived. --speed scales the rates of the profile, to
+// find the load the transport can take.
+//
+// Example:
+//   gazebo_transport_benchmark --path local --path loopback \
+//     --size 64 --size 1048576 --subscribers 1 --subscribers 4 -o out.json
+//   gazebo_transport_benchmark --load profile.txt --speed 4
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "gazebo/gazebo.hh"
+#include "gazebo/gazebo_config.h"
+#include "gazebo/common/common.hh"
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/transport/transport.hh"
+
+namespace po = boost::program_options;
+
+using namespace gazebo;
+
+/// \brief Clock used for timing.
+using Clock = std::chrono::steady_clock;
+
+/// \brief Namespace of the benchmark topics.
+static const char *kNamespace = "transport_benchmark";
+
+/////////////////////////////////////////////////
+/// \brief Get the time of the clock in nanoseconds.
+/// \return The time.
+static int64_t NowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now().time_since_epoch()).count();
+}
+
+/// \brief Result of a benchmark case.
+struct TransportResult
+{
+  /// \brief Path name.
+  std::string path;
+
+  /// \brief Payload size in bytes.
+  unsigned int size = 0;
+
+  /// \brief Number of subscribers.
+  unsigned int subscribers = 0;
+
+  /// \brief Latencies of the callbacks in microseconds, sorted.
+  std::vector<double> latencies;
+
+  /// \brief Number of messages of the burst.
+  unsigned int messages = 0;
+
+  /// \brief Number of callbacks of the burst.
+  uint64_t received = 0;
+
+  /// \brief Wall time from the start of the burst to its last callback in
+  /// seconds.
+  double burstTime = 0;
+
+  /// \brief Error message, empty if the case ran.
+  std::string error;
+};
+
+/// \brief Collects the callbacks of a case.
+class Receiver
+{
+  /// \brief Constructor.
+  /// \param[in] _scale Factor of the measured latencies, 0.5 for a round
+  /// trip.
+  public: explicit Receiver(const double _scale)
+    : scale(_scale)
+  {
+  }
+
+  /// \brief Callback of a subscriber.
+  /// \param[in] _msg The message, stamped when it was published.
+  public: void OnMessage(ConstImageStampedPtr &_msg)
+  {
+    const int64_t now = NowNs();
+    const int64_t sent = _msg->time().sec() * 1000000000ll +
+        _msg->time().nsec();
+
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->record)
+      this->latencies.push_back((now - sent) * this->scale * 1e-3);
+    this->last = Clock::now();
+    ++this->received;
+    this->cond.notify_all();
+  }
+
+  /// \brief Wait for a number of callbacks.
+  /// \param[in] _count Number of callbacks since the last Reset.
+  /// \param[in] _timeout Longest wait in seconds.
+  /// \return True if they arrived.
+  public: bool WaitFor(const uint64_t _count, const double _timeout)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->cond.wait_for(lock, std::chrono::duration<double>(_timeout),
+        [this, _count]() { return this->received >= _count; });
+  }
+
+  /// \brief Forget the callbacks so far.
+  /// \param[in] _record True to record the latencies from now on.
+  public: void Reset(const bool _record)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->latencies.clear();
+    this->received = 0;
+    this->record = _record;
+  }
+
+  /// \brief Factor of the measured latencies.
+  public: const double scale;
+
+  /// \brief True to record the latencies.
+  public: bool record = false;
+
+  /// \brief Recorded latencies in microseconds.
+  public: std::vector<double> latencies;
+
+  /// \brief Number of callbacks since the last Reset.
+  public: uint64_t received = 0;
+
+  /// \brief Time of the last callback.
+  public: Clock::time_point last;
+
+  /// \brief Protects the members.
+  public: std::mutex mutex;
+
+  /// \brief Notified on each callback.
+  public: std::condition_variable cond;
+};
+
+/// \brief Counts the messages of the replayed topics.
+class LoadCounter
+{
+  /// \brief Callback of a subscriber.
+  /// \param[in] _data The serialized message.
+  public: void OnData(const std::string &_data)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    ++this->received;
+    this->bytes += _data.size();
+  }
+
+  /// \brief Number of callbacks.
+  public: uint64_t received = 0;
+
+  /// \brief Number of bytes received.
+  public: uint64_t bytes = 0;
+
+  /// \brief Protects the counters.
+  public: std::mutex mutex;
+};
+
+/// \brief Subscribers that publish back every message they receive, run by
+/// the echo process. The benchmark tells it the number of subscribers of
+/// each case over a control topic.
+class Echo
+{
+  /// \brief Constructor.
+  public: Echo()
+  {
+    this->node.reset(new transport::Node());
+    this->node->Init(kNamespace);
+    this->pongPub = this->node->Advertise<msgs::ImageStamped>("~/pong",
+        100000);
+    this->statusPub = this->node->Advertise<msgs::GzString>("~/status");
+    this->controlSub = this->node->Subscribe("~/control", &Echo::OnControl,
+        this);
+  }
+
+  /// \brief Run until the benchmark says quit, telling it the number of
+  /// subscribers now and then, so that it notices the echo once connected.
+  public: void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (!this->quit)
+    {
+      msgs::GzString status;
+      status.set_data("ready " + std::to_string(this->subs.size()));
+      this->statusPub->Publish(status);
+      this->cond.wait_for(lock, std::chrono::milliseconds(100));
+    }
+  }
+
+  /// \brief Control callback.
+  /// \param[in] _msg "subscribers <count>" or "quit".
+  private: void OnControl(ConstGzStringPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (_msg->data() == "quit")
+    {
+      this->quit = true;
+    }
+    else if (_msg->data().compare(0, 12, "subscribers ") == 0)
+    {
+      // The benchmark repeats the message until it gets the status
+      const unsigned int count = std::stoul(_msg->data().substr(12));
+      if (count == this->subs.size())
+        return;
+
+      this->subs.clear();
+      this->nodes.clear();
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        transport::NodePtr subNode(new transport::Node());
+        subNode->Init(kNamespace);
+        this->subs.push_back(subNode->Subscribe("~/ping", &Echo::OnPing,
+            this));
+        this->nodes.push_back(subNode);
+      }
+    }
+    this->cond.notify_all();
+  }
+
+  /// \brief Ping callback.
+  /// \param[in] _msg The message, published back as is.
+  private: void OnPing(ConstImageStampedPtr &_msg)
+  {
+    this->pongPub->Publish(*_msg);
+  }
+
+  /// \brief Node of the control and the replies.
+  private: transport::NodePtr node;
+
+  /// \brief Nodes of the subscribers.
+  private: std::vector<transport::NodePtr> nodes;
+
+  /// \brief Subscribers of the pings.
+  private: std::vector<transport::SubscriberPtr> subs;
+
+  /// \brief Publisher of the replies.
+  private: transport::PublisherPtr pongPub;
+
+  /// \brief Publisher of the status.
+  private: transport::PublisherPtr statusPub;
+
+  /// \brief Subscriber of the control.
+  private: transport::SubscriberPtr controlSub;
+
+  /// \brief True once told to quit.
+  private: bool quit = false;
+
+  /// \brief Protects the members.
+  private: std::mutex mutex;
+
+  /// \brief Notified on each control message.
+  private: std::condition_variable cond;
+};
+
+/// \brief Status of the echo process, as last published.
+class EchoStatus
+{
+  /// \brief Status callback.
+  /// \param[in] _msg "ready <count>".
+  public: void OnStatus(ConstGzStringPtr &_msg)
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->status = _msg->data();
+    this->cond.notify_all();
+  }
+
+  /// \brief Wait for a status.
+  /// \param[in] _status The status.
+  /// \param[in] _timeout Longest wait in seconds.
+  /// \return True if the echo process published it.
+  public: bool WaitFor(const std::string &_status, const double _timeout)
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->cond.wait_for(lock, std::chrono::duration<double>(_timeout),
+        [this, &_status]() { return this->status == _status; });
+  }
+
+  /// \brief Last status.
+  public: std::string status;
+
+  /// \brief Protects the status.
+  public: std::mutex mutex;
+
+  /// \brief Notified on each status.
+  public: std::condition_variable cond;
+};
+
+/////////////////////////////////////////////////
+/// \brief Stamp a message with the time of the clock.
+/// \param[in,out] _msg The message.
+static void Stamp(msgs::ImageStamped &_msg)
+{
+  const int64_t now = NowNs();
+  _msg.mutable_time()->set_sec(now / 1000000000ll);
+  _msg.mutable_time()->set_nsec(static_cast<int32_t>(now % 1000000000ll));
+}
+
+/////////////////////////////////////////////////
+/// \brief Run a benchmark case.
+/// \param[in] _node Node of the benchmark.
+/// \param[in] _path Path name.
+/// \param[in] _size Payload size in bytes.
+/// \param[in] _subscribers Number of subscribers.
+/// \param[in] _samples Number of latency samples.
+/// \param[in] _messages Number of messages of the burst.
+/// \return The result of the case.
+static TransportResult RunCase(transport::NodePtr _node,
+    const std::string &_path, const unsigned int _size,
+    const unsigned int _subscribers, const unsigned int _samples,
+    const unsigned int _messages)
+{
+  TransportResult result;
+  result.path = _path;
+  result.size = _size;
+  result.subscribers = _subscribers;
+  result.messages = _messages;
+
+  const bool local = _path == "local";
+  Receiver receiver(local ? 1.0 : 0.5);
+
+  std::vector<transport::NodePtr> nodes;
+  std::vector<transport::SubscriberPtr> subs;
+  transport::PublisherPtr controlPub;
+  if (local)
+  {
+    for (unsigned int i = 0; i < _subscribers; ++i)
+    {
+      transport::NodePtr subNode(new transport::Node());
+      subNode->Init(kNamespace);
+      subs.push_back(subNode->Subscribe("~/ping", &Receiver::OnMessage,
+          &receiver));
+      nodes.push_back(subNode);
+    }
+  }
+  else
+  {
+    EchoStatus status;
+    transport::SubscriberPtr statusSub = _node->Subscribe("~/status",
+        &EchoStatus::OnStatus, &status);
+    controlPub = _node->Advertise<msgs::GzString>("~/control");
+
+    // The echo process may still be connecting
+    msgs::GzString control;
+    control.set_data("subscribers " + std::to_string(_subscribers));
+    const std::string ready = "ready " + std::to_string(_subscribers);
+    bool echo = false;
+    for (int i = 0; i < 100 && !echo; ++i)
+    {
+      controlPub->Publish(control);
+      echo = status.WaitFor(ready, 0.1);
+    }
+    if (!echo)
+    {
+      result.error = "no echo process";
+      return result;
+    }
+    subs.push_back(_node->Subscribe("~/pong", &Receiver::OnMessage,
+        &receiver));
+  }
+
+  transport::PublisherPtr pub = _node->Advertise<msgs::ImageStamped>(
+      "~/ping", std::max(_messages, 1000u));
+
+  msgs::ImageStamped msg;
+  msg.mutable_image()->set_width(_size);
+  msg.mutable_image()->set_height(1);
+  msg.mutable_image()->set_pixel_format(0);
+  msg.mutable_image()->set_step(_size);
+  msg.mutable_image()->set_data(std::string(_size, '\0'));
+
+  // Connections are made in the background, ping until all the subscribers
+  // answer
+  bool connected = false;
+  for (int i = 0; i < 100 && !connected; ++i)
+  {
+    receiver.Reset(false);
+    Stamp(msg);
+    pub->Publish(msg);
+    connected = receiver.WaitFor(_subscribers, 0.1);
+  }
+  if (!connected)
+  {
+    result.error = "subscribers not connected";
+    return result;
+  }
+
+  // Let the replies of the other pings arrive
+  common::Time::MSleep(200);
+
+  // Latency, one message in flight
+  receiver.Reset(true);
+  for (unsigned int i = 0; i < _samples; ++i)
+  {
+    Stamp(msg);
+    pub->Publish(msg);
+    if (!receiver.WaitFor(static_cast<uint64_t>(i + 1) * _subscribers, 5.0))
+    {
+      result.error = "latency sample timed out";
+      return result;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(receiver.mutex);
+    result.latencies = receiver.latencies;
+  }
+  std::sort(result.latencies.begin(), result.latencies.end());
+
+  // Throughput, a burst of messages
+  receiver.Reset(false);
+  const Clock::time_point start = Clock::now();
+  for (unsigned int i = 0; i < _messages; ++i)
+  {
+    Stamp(msg);
+    pub->Publish(msg);
+  }
+  receiver.WaitFor(static_cast<uint64_t>(_messages) * _subscribers, 30.0);
+  {
+    std::lock_guard<std::mutex> lock(receiver.mutex);
+    result.received = receiver.received;
+    result.burstTime = std::chrono::duration<double>(
+        receiver.last - start).count();
+  }
+
+  subs.clear();
+  for (auto &subNode : nodes)
+    subNode->Fini();
+
+  // Don't let the echo process answer the next cases
+  if (controlPub)
+  {
+    msgs::GzString control;
+    control.set_data("subscribers 0");
+    controlPub->Publish(control);
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+/// \brief Replay a load profile to local subscribers.
+/// \param[in] _node Node of the benchmark.
+/// \param[in] _filename Path of the profile.
+/// \param[in] _speed Factor of the rates of the profile.
+/// \param[in] _out Output stream of the JSON result.
+/// \return True on success.
+static bool RunLoad(transport::NodePtr _node, const std::string &_filename,
+    const double _speed, std::ostream &_out)
+{
+  transport::LoadProfile profile;
+  if (_speed <= 0 || !profile.Load(_filename))
+    return false;
+
+  transport::LoadReplayer replayer(_node, profile, "/gazebo/load_replay");
+  LoadCounter counter;
+  std::vector<transport::SubscriberPtr> subs;
+  for (uint32_t i = 0; i < profile.Topics().size(); ++i)
+  {
+    subs.push_back(_node->Subscribe(replayer.TopicName(i),
+        &LoadCounter::OnData, &counter));
+  }
+
+  // Let the subscriptions connect
+  common::Time::MSleep(500);
+
+  transport::LoadReplayStats stats = replayer.Run(_speed);
+
+  // Let the last messages arrive
+  uint64_t received = 0;
+  for (int i = 0; i < 50; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(counter.mutex);
+      if (counter.received >= stats.messages || counter.received == received)
+        break;
+      received = counter.received;
+    }
+    common::Time::MSleep(100);
+  }
+  subs.clear();
+
+  std::lock_guard<std::mutex> lock(counter.mutex);
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"load\": {\"profile\": \"" << _filename << "\", "
+       << "\"topics\": " << profile.Topics().size() << ", "
+       << "\"speed\": " << _speed << ",\n"
+       << "    \"published\": " << stats.messages << ", "
+       << "\"received\": " << counter.received << ", "
+       << "\"mb_published\": " << stats.bytes / 1e6 << ", "
+       << "\"wall_time\": " << stats.wallTime << ", "
+       << "\"profile_time\": " << profile.Duration() / _speed << ",\n"
+       << "    \"mean_lag_ms\": " << stats.meanLag * 1e3 << ", "
+       << "\"max_lag_ms\": " << stats.maxLag * 1e3 << "}\n}\n";
+  return true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a percentile of sorted values, by nearest rank.
+/// \param[in] _values The values.
+/// \param[in] _percent The percentile.
+/// \return The value, 0 if there are none.
+static double Percentile(const std::vector<double> &_values,
+    const double _percent)
+{
+  if (_values.empty())
+    return 0;
+
+  size_t rank = static_cast<size_t>(std::ceil(_percent / 100.0 *
+      _values.size()));
+  return _values[std::min(std::max(rank, size_t(1)), _values.size()) - 1];
+}
+
+/////////////////////////////////////////////////
+/// \brief Write results as JSON.
+/// \param[in] _out Output stream.
+/// \param[in] _results The results.
+static void WriteJson(std::ostream &_out,
+    const std::vector<TransportResult> &_results)
+{
+  _out << "{\n  \"gazebo_version\": \"" << GAZEBO_VERSION_FULL << "\",\n"
+       << "  \"results\": [";
+
+  for (size_t i = 0; i < _results.size(); ++i)
+  {
+    const TransportResult &r = _results[i];
+    _out << (i == 0 ? "\n" : ",\n")
+         << "    {\"path\": \"" << r.path << "\", "
+         << "\"size\": " << r.size << ", "
+         << "\"subscribers\": " << r.subscribers;
+
+    if (!r.error.empty())
+    {
+      _out << ", \"error\": \"" << r.error << "\"}";
+      continue;
+    }
+
+    double mean = 0;
+    for (auto const latency : r.latencies)
+      mean += latency;
+    if (!r.latencies.empty())
+      mean /= r.latencies.size();
+
+    const double rate = r.burstTime > 0 ? r.received / r.burstTime : 0.0;
+    _out << ", \"latency_us\": {\"samples\": " << r.latencies.size()
+         << ", \"mean\": " << mean
+         << ", \"p50\": " << Percentile(r.latencies, 50)
+         << ", \"p99\": " << Percentile(r.latencies, 99)
+         << ", \"p999\": " << Percentile(r.latencies, 99.9)
+         << ", \"max\": " << (r.latencies.empty() ? 0 : r.latencies.back())
+         << "}"
+         << ", \"throughput\": {\"messages\": " << r.messages
+         << ", \"received\": " << r.received
+         << ", \"wall_time\": " << r.burstTime
+         << ", \"msgs_per_sec\": " << rate
+         << ", \"mb_per_sec\": " << rate * r.size / 1e6 << "}}";
+  }
+
+  _out << "\n  ]\n}\n";
+}
+
+/////////////////////////////////////////////////
+int main(int _argc, char **_argv)
+{
+  std::vector<std::string> paths = {"local", "loopback"};
+  std::vector<unsigned int> sizes = {64, 4096, 65536, 1048576};
+  std::vector<unsigned int> subscribers = {1, 4};
+  unsigned int samples = 1000;
+  unsigned int messages = 1000;
+  std::string load;
+  double speed = 1.0;
+  std::string output;
+
+  po::options_description desc("Usage: gazebo_transport_benchmark [options]");
+  desc.add_options()
+    ("help,h", "Produce this help message.")
+    ("path,p", po::value<std::vector<std::string> >(&paths)->composing(),
+     "Path: local, loopback or remote. Can be repeated. Defaults to local "
+     "and loopback.")
+    ("size,n", po::value<std::vector<unsigned int> >(&sizes)->composing(),
+     "Payload size in bytes. Can be repeated.")
+    ("subscribers,s",
+     po::value<std::vector<unsigned int> >(&subscribers)->composing(),
+     "Number of subscribers. Can be repeated.")
+    ("samples,l", po::value<unsigned int>(&samples),
+     "Number of latency samples of each case.")
+    ("messages,m", po::value<unsigned int>(&messages),
+     "Number of messages of the throughput burst of each case.")
+    ("echo", "Run the echo process of the loopback and remote paths.")
+    ("load", po::value<std::string>(&load),
+     "Replay a load profile instead of the cases.")
+    ("speed", po::value<double>(&speed),
+     "Factor of the rates of the replayed load profile.")
+    ("output,o", po::value<std::string>(&output),
+     "JSON output file, defaults to the standard output.");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(_argc, _argv, desc), vm);
+    po::notify(vm);
+  }
+  catch(boost::exception &)
+  {
+    std::cerr << "Error. Invalid arguments\n" << desc << "\n";
+    return -1;
+  }
+
+  if (vm.count("help"))
+  {
+    std::cout << desc << "\n";
+    return 0;
+  }
+
+  if (vm.count("echo"))
+  {
+    if (!transport::init())
+    {
+      std::cerr << "Unable to connect to the master\n";
+      return -1;
+    }
+    transport::run();
+    {
+      Echo echo;
+      echo.Run();
+    }
+    transport::fini();
+    return 0;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server\n";
+    return -1;
+  }
+
+  if (!load.empty())
+  {
+    transport::NodePtr node(new transport::Node());
+    node->Init(kNamespace);
+
+    bool result;
+    if (output.empty())
+    {
+      result = RunLoad(node, load, speed, std::cout);
+    }
+    else
+    {
+      std::ofstream out(output);
+      result = RunLoad(node, load, speed, out);
+    }
+
+    node->Fini();
+    node.reset();
+    gazebo::shutdown();
+    return result ? 0 : 1;
+  }
+
+  // The loopback echo process is this program, connected to our master
+  pid_t echoPid = -1;
+  if (std::find(paths.begin(), paths.end(), "loopback") != paths.end())
+  {
+    echoPid = fork();
+    if (echoPid == 0)
+    {
+      execl("/proc/self/exe", _argv[0], "--echo", static_cast<char *>(0));
+      _exit(127);
+    }
+  }
+
+  transport::NodePtr node(new transport::Node());
+  node->Init(kNamespace);
+
+  std::vector<TransportResult> results;
+  for (auto const &path : paths)
+  {
+    for (auto const size : sizes)
+    {
+      for (auto const count : subscribers)
+      {
+        gzmsg << "Running " << path << " with " << count << " subscribers of "
+              << size << " bytes" << std::endl;
+        results.push_back(RunCase(node, path, size, count, samples,
+              messages));
+      }
+    }
+  }
+
+  // Stop the echo processes
+  {
+    transport::PublisherPtr controlPub =
+        node->Advertise<msgs::GzString>("~/control");
+    msgs::GzString control;
+    control.set_data("quit");
+    controlPub->Publish(control);
+    common::Time::MSleep(200);
+  }
+  if (echoPid > 0)
+  {
+    int waits = 0;
+    while (waitpid(echoPid, nullptr, WNOHANG) == 0)
+    {
+      if (++waits == 50)
+        kill(echoPid, SIGTERM);
+      common::Time::MSleep(100);
+    }
+  }
+
+  node->Fini();
+  node.reset();
+  gazebo::shutdown();
+
+  if (output.empty())
+  {
+    WriteJson(std::cout, results);
+  }
+  else
+  {
+    std::ofstream out(output);
+    WriteJson(out, results);
+  }
+
+  for (auto const &result : results)
+  {
+    if (!result.error.empty())
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ActorPluginTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// Two actors walk along their waypoints in opposite directions. The crowd
+// makes them avoid each other, and keeps updating the other actor once one
+// of them is removed.
+TEST_F(ActorPluginTest, Crowd)
+{
+  this->Load("test/worlds/actor_plugin.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::ModelPtr east = world->ModelByName("actor_east");
+  ASSERT_NE(nullptr, east);
+  physics::ModelPtr west = world->ModelByName("actor_west");
+  ASSERT_NE(nullptr, west);
+
+  // Walk for 30 s, the actors cross near the origin
+  const ignition::math::Vector3d firstWaypoint(5, 0, 1.2138);
+  double minDistance = ignition::math::MAX_D;
+  double nearestToWaypoint = ignition::math::MAX_D;
+  bool leftWaypoint = false;
+  for (int i = 0; i < 3000; ++i)
+  {
+    world->Step(10);
+    const ignition::math::Vector3d eastPos = east->WorldPose().Pos();
+    const ignition::math::Vector3d westPos = west->WorldPose().Pos();
+    minDistance = std::min(minDistance, eastPos.Distance(westPos));
+
+    // The east actor reaches its first waypoint, then walks back to the
+    // second. The ground plane at the origin is ignored, or it would push
+    // the actor away.
+    const double distance = eastPos.Distance(firstWaypoint);
+    nearestToWaypoint = std::min(nearestToWaypoint, distance);
+    if (nearestToWaypoint < 0.5 && distance > 2)
+      leftWaypoint = true;
+
+    EXPECT_NEAR(1.2138, eastPos.Z(), 1e-3);
+  }
+  EXPECT_LT(nearestToWaypoint, 0.5);
+  EXPECT_TRUE(leftWaypoint);
+
+  // Each agent has a radius of 0.4 m
+  EXPECT_GT(minDistance, 0.4);
+
+  // Remove an actor, the other keeps walking
+  west.reset();
+  world->RemoveModel("actor_west");
+  world->Step(100);
+  EXPECT_EQ(nullptr, world->ModelByName("actor_west"));
+
+  const ignition::math::Vector3d pos = east->WorldPose().Pos();
+  world->Step(5000);
+  EXPECT_GT(east->WorldPose().Pos().Distance(pos), 1.0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,6 +33,12 @@ class JointLiftDragPluginTest : public ServerFixture,
   /// Measure / verify force torques against analytical answers.
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void LiftDragPlugin1(const std::string &_physicsEngine);
+
+  /// \brief Load a world whose lifting surfaces use tabulated curves,
+  /// inline and from a file, equal to the slopes of LiftDragPlugin1.
+  /// Verify the forces, then remove the model of the surfaces.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void LiftDragCurves(const std::string &_physicsEngine);
 };
 
 /////////////////////////////////////////////////
@@ -138,6 +144,75 @@ TEST_P(JointLiftDragPluginTest, LiftDragPlugin1)
   LiftDragPlugin1(GetParam());
 }
 
+/////////////////////////////////////////////////
+void JointLiftDragPluginTest::LiftDragCurves(const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode")
+  {
+    gzlog << "this test works for ode only for now (Link::AddForce)"
+          << " missing for other engines.\n";
+    return;
+  }
+
+  Load("worlds/lift_drag_plugin_curves.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  world->Physics()->SetGravity(ignition::math::Vector3d::Zero);
+
+  physics::ModelPtr model_1 = world->ModelByName("lift_drag_demo_model");
+  ASSERT_TRUE(model_1 != NULL);
+  physics::LinkPtr body = model_1->GetLink("body");
+  physics::LinkPtr wing_1 = model_1->GetLink("wing_1");
+  physics::LinkPtr wing_2 = model_1->GetLink("wing_2");
+  physics::JointPtr wing_1_joint = model_1->GetJoint("wing_1_joint");
+  physics::JointPtr wing_2_joint = model_1->GetJoint("wing_2_joint");
+
+  // the coefficients of the curves
+  double cla = 4.0;
+  double dihedral = 0.1;
+  double rho = 1.2041;
+  double area = 10;
+  double a0 = 0.1;
+
+  for (unsigned int i = 0; i < 2400; ++i)
+  {
+    world->Step(1);
+    body->AddForce(ignition::math::Vector3d(-1, 0, 0));
+
+    if (i > 2385)
+    {
+      double v = body->WorldLinearVel().X();
+      double q = 0.5 * rho * v * v;
+      double cl = cla * a0 * q * area;
+
+      // the inline curve (wing_1) and the file (wing_2) give the lift of
+      // the slopes
+      auto wing_1_force = wing_1->WorldPose().Rot().RotateVector(
+          wing_1_joint->GetForceTorque(0).body2Force);
+      auto wing_2_force = wing_2->WorldPose().Rot().RotateVector(
+          wing_2_joint->GetForceTorque(0).body2Force);
+      EXPECT_NEAR(wing_1_force.Z(), cl * cos(dihedral), TOL);
+      EXPECT_NEAR(wing_2_force.Z(), cl * cos(dihedral), TOL);
+    }
+  }
+
+  // the surfaces of the model leave the surfaces of the world
+  body.reset();
+  wing_1.reset();
+  wing_2.reset();
+  wing_1_joint.reset();
+  wing_2_joint.reset();
+  model_1.reset();
+  world->RemoveModel("lift_drag_demo_model");
+  world->Step(100);
+  EXPECT_TRUE(world->ModelByName("lift_drag_demo_model") == NULL);
+}
+
+TEST_P(JointLiftDragPluginTest, LiftDragCurves)
+{
+  LiftDragCurves(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, JointLiftDragPluginTest,
                         PHYSICS_ENGINE_VALUES,);  // NOLINT
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ArduCopterPluginTest : public ServerFixture
+{
+};
+
+/// \brief State packet sent by the plugin, see ArduCopterPlugin.cc.
+struct FdmPacket
+{
+  double timestamp;
+  double imuAngularVelocityRPY[3];
+  double imuLinearAccelerationXYZ[3];
+  double imuOrientationQuat[4];
+  double velocityXYZ[3];
+  double positionXYZ[3];
+};
+
+/////////////////////////////////////////////////
+/// \brief Make a local socket address.
+/// \param[in] _port Port of the address.
+/// \return The address.
+static sockaddr_in localAddr(const int _port)
+{
+  sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(_port);
+  addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+  return addr;
+}
+
+/////////////////////////////////////////////////
+/// \brief Send a servo packet to the plugin, as ArduCopter SITL does.
+/// \param[in] _fd Socket of the test.
+/// \param[in] _speed Speed of the motor, from 0 to 1.
+static void sendServo(const int _fd, const float _speed)
+{
+  const sockaddr_in addr = localAddr(9102);
+  float motorSpeed[4] = {_speed, 0, 0, 0};
+  sendto(_fd, motorSpeed, sizeof(motorSpeed), 0,
+      reinterpret_cast<const sockaddr *>(&addr), sizeof(addr));
+}
+
+/////////////////////////////////////////////////
+/// \brief Receive the state packets sent by the plugin.
+/// \param[in] _fd Socket of the test.
+/// \param[out] _pkt The last packet.
+/// \return Number of packets received.
+static int receiveStates(const int _fd, FdmPacket &_pkt)
+{
+  int count = 0;
+  FdmPacket pkt;
+  while (recv(_fd, &pkt, sizeof(pkt), MSG_DONTWAIT) ==
+      static_cast<ssize_t>(sizeof(pkt)))
+  {
+    _pkt = pkt;
+    ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+// The plugin exchanges its packets with the controller through the I/O
+// thread, and stops waiting for a controller that went offline.
+TEST_F(ArduCopterPluginTest, Exchange)
+{
+  // The test plays ArduCopter SITL, which receives the state packets
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+  const sockaddr_in addr = localAddr(9103);
+  ASSERT_EQ(0, bind(fd, reinterpret_cast<const sockaddr *>(&addr),
+      sizeof(addr)));
+
+  this->Load("test/worlds/arducopter_plugin.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  physics::JointPtr joint = world->ModelByName("copter")->GetJoint(
+      "rotor_joint");
+  ASSERT_NE(nullptr, joint);
+
+  // No state is sent while the controller is offline, and the steps don't
+  // wait for it
+  common::Time start = common::Time::GetWallTime();
+  world->Step(100);
+  EXPECT_LT((common::Time::GetWallTime() - start).Double(), 5.0);
+  common::Time::MSleep(100);
+  FdmPacket pkt;
+  EXPECT_EQ(0, receiveStates(fd, pkt));
+
+  // The controller comes online, and each step waits for its command
+  int states = 0;
+  for (int i = 0; i < 500; ++i)
+  {
+    sendServo(fd, 1.0);
+    world->Step(1);
+    states += receiveStates(fd, pkt);
+  }
+  common::Time::MSleep(100);
+  states += receiveStates(fd, pkt);
+  EXPECT_GT(states, 0);
+  EXPECT_NEAR(world->SimTime().Double(), pkt.timestamp, 0.01);
+
+  // The rotor turns to follow the command
+  EXPECT_GT(joint->GetVelocity(0), 1.0);
+
+  // The controller goes offline after a few steps without command, and
+  // the steps don't wait for it anymore
+  world->Step(3);
+  common::Time::MSleep(100);
+  receiveStates(fd, pkt);
+  start = common::Time::GetWallTime();
+  world->Step(100);
+  EXPECT_LT((common::Time::GetWallTime() - start).Double(), 5.0);
+  common::Time::MSleep(100);
+  EXPECT_EQ(0, receiveStates(fd, pkt));
+
+  close(fd);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
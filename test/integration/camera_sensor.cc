@@ -301,6 +301,89 @@ TEST_F(CameraSensor, CheckThrottle)
   delete [] img;
 }
 
+/////////////////////////////////////////////////
+// Images read back asynchronously should match images read back
+// synchronously in a static scene.
+TEST_F(CameraSensor, ReadbackLatency)
+{
+  Load("worlds/empty_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  unsigned int width  = 320;
+  unsigned int height = 240;
+  double updateRate = 10;
+  ignition::math::Pose3d setPose(ignition::math::Vector3d(-5, 0, 5),
+      ignition::math::Quaterniond(0, IGN_DTOR(15), 0));
+  SpawnCamera("camera_model", "camera_sensor", setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+  SpawnCamera("camera_model_async", "camera_sensor_async", setPose.Pos(),
+      setPose.Rot().Euler(), width, height, updateRate);
+
+  sensors::CameraSensorPtr camSensor =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(
+        sensors::get_sensor("camera_sensor"));
+  sensors::CameraSensorPtr camSensorAsync =
+    std::dynamic_pointer_cast<sensors::CameraSensor>(
+        sensors::get_sensor("camera_sensor_async"));
+  ASSERT_NE(nullptr, camSensor);
+  ASSERT_NE(nullptr, camSensorAsync);
+
+  EXPECT_EQ(0u, camSensor->ReadbackLatency());
+  camSensorAsync->SetReadbackLatency(5);
+  EXPECT_EQ(2u, camSensorAsync->ReadbackLatency());
+  camSensorAsync->SetReadbackLatency(1);
+  EXPECT_EQ(1u, camSensorAsync->ReadbackLatency());
+  EXPECT_EQ(1u, camSensorAsync->Camera()->ReadbackLatency());
+
+  imageCount = 0;
+  imageCount2 = 0;
+  img = new unsigned char[width * height * 3];
+  img2 = new unsigned char[width * height * 3];
+  event::ConnectionPtr c = camSensor->Camera()->ConnectNewImageFrame(
+      std::bind(&::OnNewCameraFrame, &imageCount, img,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+  event::ConnectionPtr c2 = camSensorAsync->Camera()->ConnectNewImageFrame(
+      std::bind(&::OnNewCameraFrame, &imageCount2, img2,
+        std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+        std::placeholders::_4, std::placeholders::_5));
+
+  int sleep = 0;
+  while ((imageCount < 10 || imageCount2 < 10) && sleep++ < 1000)
+    common::Time::MSleep(10);
+  EXPECT_GE(imageCount, 10);
+  EXPECT_GE(imageCount2, 10);
+
+  c.reset();
+  c2.reset();
+
+  // The image is stamped with the time it was rendered at, which is
+  // never later than the current time.
+  EXPECT_LE(camSensorAsync->Camera()->ImageSimTime(),
+      camSensorAsync->Camera()->GetScene()->SimTime());
+
+  unsigned int diffMax = 0, diffSum = 0;
+  double diffAvg = 0.0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->ImageCompare(img, img2, width, height, 3,
+        diffMax, diffSum, diffAvg);
+  }
+  EXPECT_EQ(0u, diffSum);
+
+  delete [] img;
+  delete [] img2;
+  img = nullptr;
+  img2 = nullptr;
+}
+
 /////////////////////////////////////////////////
 TEST_F(CameraSensor, StrictUpdateRate)
 {
@@ -1147,6 +1147,70 @@ TEST_F(FactoryTest, FilenameModelDatabase)
   ASSERT_NE(nullptr, world->ModelByName("cococan"));
 }
 
+//////////////////////////////////////////////////
+TEST_F(FactoryTest, CopyPoses)
+{
+  this->Load("worlds/empty.world", true);
+  auto world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  const std::string sdfStr =
+    "<sdf version='" SDF_VERSION "'>"
+    "<model name='box'>"
+    "  <link name='link'>"
+    "    <collision name='collision'>"
+    "      <geometry><box><size>0.5 0.5 0.5</size></box></geometry>"
+    "    </collision>"
+    "  </link>"
+    "</model>"
+    "</sdf>";
+
+  // Spawn copies of one SDF, the first two with names
+  const unsigned int copyCount = 20;
+  msgs::Factory msg;
+  msg.set_sdf(sdfStr);
+  for (unsigned int i = 0; i < copyCount; ++i)
+  {
+    msgs::Set(msg.add_copy_pose(),
+        ignition::math::Pose3d(i, 2.0, 0.25, 0, 0, 0));
+  }
+  msg.add_copy_name("first");
+  msg.add_copy_name("second");
+
+  auto pub = this->node->Advertise<msgs::Factory>("~/factory");
+  pub->Publish(msg);
+
+  // Wait for them to be spawned
+  int sleep = 0;
+  int maxSleep = 50;
+  while (world->ModelCount() < copyCount + 1 && sleep++ < maxSleep)
+  {
+    common::Time::MSleep(100);
+  }
+
+  // The ground plane and the copies
+  EXPECT_EQ(copyCount + 1, world->ModelCount());
+
+  auto first = world->ModelByName("first");
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(ignition::math::Pose3d(0, 2.0, 0.25, 0, 0, 0), first->WorldPose());
+
+  auto second = world->ModelByName("second");
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(ignition::math::Pose3d(1, 2.0, 0.25, 0, 0, 0),
+      second->WorldPose());
+
+  // Unnamed copies get unique names after the model
+  auto box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+  EXPECT_EQ(ignition::math::Pose3d(2, 2.0, 0.25, 0, 0, 0), box->WorldPose());
+
+  auto last = world->ModelByName("box_" + std::to_string(copyCount - 4));
+  ASSERT_NE(nullptr, last);
+  EXPECT_EQ(ignition::math::Pose3d(copyCount - 1, 2.0, 0.25, 0, 0, 0),
+      last->WorldPose());
+}
+
 //////////////////////////////////////////////////
 TEST_F(FactoryTest, FilenameModelDatabaseRelativePaths)
 {
@@ -1376,6 +1440,70 @@ TEST_P(FactoryTest, InvalidMeshInsertionWithWorld)
   world->Step(1);
 }
 
+//////////////////////////////////////////////////
+// Insert several models that are processed in one step, so that the physics
+// engine initializes them as one batch.
+TEST_P(FactoryTest, BatchInsertion)
+{
+  std::string physicsEngine = GetParam();
+  this->Load("worlds/empty.world", true, physicsEngine);
+  auto world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  const unsigned int modelCount = world->ModelCount();
+
+  const unsigned int count = 5;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    std::ostringstream modelStr;
+    modelStr << "<sdf version='" << sdf::SDF::Version() << "'>"
+      << "<model name='pendulum_" << i << "'>"
+      << "  <pose>" << 2.0 * i << " 0 0.5 0 0 0</pose>"
+      << "  <link name='base'>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>1 1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "  <link name='arm'>"
+      << "    <pose>0 0 1 0 0 0</pose>"
+      << "    <collision name='collision'>"
+      << "      <geometry><box><size>0.1 0.1 1</size></box></geometry>"
+      << "    </collision>"
+      << "  </link>"
+      << "  <joint name='hinge' type='revolute'>"
+      << "    <parent>base</parent>"
+      << "    <child>arm</child>"
+      << "    <pose>0 0 -0.5 0 0 0</pose>"
+      << "    <axis>"
+      << "      <xyz>1 0 0</xyz>"
+      << "      <limit><lower>-0.5</lower><upper>0.5</upper></limit>"
+      << "    </axis>"
+      << "  </joint>"
+      << "</model>"
+      << "</sdf>";
+    world->InsertModelString(modelStr.str());
+  }
+
+  world->Step(1);
+  ASSERT_EQ(modelCount + count, world->ModelCount());
+
+  world->Step(100);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    auto model = world->ModelByName("pendulum_" + std::to_string(i));
+    ASSERT_TRUE(model != nullptr) << i;
+
+    auto joint = model->GetJoint("hinge");
+    ASSERT_TRUE(joint != nullptr) << i;
+    EXPECT_NEAR(0.5, joint->UpperLimit(0), g_tolerance) << i;
+    EXPECT_NEAR(-0.5, joint->LowerLimit(0), g_tolerance) << i;
+
+    // The base rests on the ground where it was inserted
+    auto pose = model->GetLink("base")->WorldPose();
+    EXPECT_NEAR(2.0 * i, pose.Pos().X(), 1e-2) << i;
+    EXPECT_NEAR(0.5, pose.Pos().Z(), 1e-2) << i;
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, FactoryTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 /////////////////////////////////////////////////
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class ForkServerTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Submit a job to a fork server.
+/// \param[in] _socket Path of the socket of the fork server.
+/// \param[in] _lines Lines of the job.
+/// \return Connection to the fork server, -1 on failure.
+static int submitJob(const std::string &_socket,
+    const std::vector<std::string> &_lines)
+{
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strncpy(addr.sun_path, _socket.c_str(), sizeof(addr.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  // Don't wait forever for a job that doesn't stop
+  timeval timeout;
+  timeout.tv_sec = 120;
+  timeout.tv_usec = 0;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  std::string text;
+  for (auto const &line : _lines)
+    text += line + "\n";
+  text += "\n";
+  if (write(fd, text.data(), text.size()) !=
+      static_cast<ssize_t>(text.size()))
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/////////////////////////////////////////////////
+/// \brief Read a line of the answer of a fork server.
+/// \param[in] _fd Connection to the fork server.
+/// \return The line, empty once the connection is closed.
+static std::string readLine(const int _fd)
+{
+  std::string line;
+  char c;
+  while (read(_fd, &c, 1) == 1 && c != '\n')
+    line += c;
+  return line;
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the state logs in a directory.
+/// \param[in] _dir The directory.
+/// \return Number of state logs.
+static int stateLogCount(const boost::filesystem::path &_dir)
+{
+  int count = 0;
+  if (!boost::filesystem::exists(_dir))
+    return count;
+
+  for (boost::filesystem::recursive_directory_iterator iter(_dir), end;
+       iter != end; ++iter)
+  {
+    if (iter->path().filename() == "state.log")
+      ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+// Two jobs run at the same time in their own forked server
+TEST_F(ForkServerTest, TwoJobs)
+{
+  const boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo-fork-%%%%%%");
+  ASSERT_TRUE(boost::filesystem::create_directories(dir));
+  const std::string socketPath = (dir / "jobs.sock").string();
+
+  std::thread forkServer([socketPath]()
+  {
+    custom_exec("gzserver --fork-server " + socketPath);
+  });
+
+  struct stat st;
+  int sleep = 0;
+  while (stat(socketPath.c_str(), &st) != 0 && sleep++ < 300)
+    common::Time::MSleep(100);
+
+  // Each job has its own master and its own log
+  std::vector<int> jobs;
+  for (int i = 0; i < 2; ++i)
+  {
+    const std::string port = std::to_string(11350 + i);
+    jobs.push_back(submitJob(socketPath, {
+        "env GAZEBO_MASTER_URI=http://localhost:" + port,
+        "arg --iters", "arg 500",
+        "arg -r", "arg --record_path",
+        "arg " + (dir / ("log" + std::to_string(i))).string(),
+        "arg worlds/empty.world"}));
+  }
+
+  std::vector<std::string> pids;
+  std::vector<std::string> exits;
+  for (auto const fd : jobs)
+  {
+    EXPECT_GE(fd, 0);
+    pids.push_back(fd < 0 ? "" : readLine(fd));
+  }
+  for (auto const fd : jobs)
+  {
+    exits.push_back(fd < 0 ? "" : readLine(fd));
+    if (fd >= 0)
+      close(fd);
+  }
+
+  custom_exec("pkill -INT -f \"fork-server " + socketPath + "\"");
+  forkServer.join();
+
+  ASSERT_EQ(2u, pids.size());
+  EXPECT_EQ(0u, pids[0].find("pid "));
+  EXPECT_EQ(0u, pids[1].find("pid "));
+  EXPECT_NE(pids[0], pids[1]);
+  EXPECT_EQ("exit 0", exits[0]);
+  EXPECT_EQ("exit 0", exits[1]);
+
+  // Each job only wrote its own log
+  EXPECT_EQ(1, stateLogCount(dir / "log0"));
+  EXPECT_EQ(1, stateLogCount(dir / "log1"));
+
+  // The fork server removes its socket when it stops
+  EXPECT_FALSE(boost::filesystem::exists(socketPath));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -278,6 +278,12 @@ TEST_F(GzLog, RecordResources)
   // model with abs path to mesh
   path = logDirPath + absMeshPath;
   EXPECT_TRUE(common::exists(path));
+
+  // the resources are linked from the store of the record path
+  util::ResourceStoreStats stats = recorder->ResourceStats();
+  EXPECT_GT(stats.files, 0u);
+  EXPECT_EQ(stats.failed, 0u);
+  EXPECT_EQ(stats.linked, stats.files);
   boost::filesystem::remove_all(recordPath);
 }
 
@@ -16,6 +16,9 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <string>
 
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Model.hh"
@@ -173,6 +176,49 @@ TEST_F(JointControllerTest, JointCmd)
   EXPECT_DOUBLE_EQ(velPids[jointName].GetDGain(), 9);
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, SetJointPositionsBatched)
+{
+  Load("worlds/simple_arm_test.world", true);
+  gazebo::physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  gazebo::physics::ModelPtr model = world->ModelByName("simple_arm");
+  ASSERT_TRUE(model != NULL);
+  gazebo::physics::JointControllerPtr jointController =
+    model->GetJointController();
+
+  const std::map<std::string, double> positions = {
+    {"arm_shoulder_pan_joint", 0.7},
+    {"arm_elbow_pan_joint", -1.1},
+    {"arm_wrist_lift_joint", -0.3},
+    {"arm_wrist_roll_joint", 2.0}};
+
+  // Set the joints one at a time, as Joint::SetPosition does
+  for (auto const &position : positions)
+    model->GetJoint(position.first)->SetPosition(0, position.second);
+
+  std::map<std::string, ignition::math::Pose3d> poses;
+  for (auto const &link : model->GetLinks())
+    poses[link->GetName()] = link->WorldPose();
+
+  world->Reset();
+
+  // The links are moved once for all the joints, to the same poses
+  jointController->SetJointPositions(positions);
+  for (auto const &position : positions)
+  {
+    EXPECT_NEAR(model->GetJoint(position.first)->Position(0),
+        position.second, 1e-6);
+  }
+  for (auto const &link : model->GetLinks())
+  {
+    const ignition::math::Pose3d &pose = poses[link->GetName()];
+    EXPECT_NEAR(link->WorldPose().Pos().Distance(pose.Pos()), 0, 1e-6);
+    EXPECT_NEAR(std::abs(
+        (link->WorldPose().Rot().Inverse() * pose.Rot()).W()), 1, 1e-6);
+  }
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
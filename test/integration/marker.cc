@@ -595,5 +595,108 @@ void Marker_TEST::CornerCases()
   delete mainWindow;
 }
 
+/////////////////////////////////////////////////
+void Marker_TEST::Array()
+{
+  this->resMaxPercentChange = 5.0;
+  this->shareMaxPercentChange = 2.0;
+
+  this->Load("worlds/empty_bright.world", false, false, false);
+
+  gazebo::gui::MainWindow *mainWindow = new gazebo::gui::MainWindow();
+  QVERIFY(mainWindow != nullptr);
+
+  // Create the main window.
+  mainWindow->Load();
+  mainWindow->Init();
+  mainWindow->show();
+
+  this->ProcessEventsAndDraw(mainWindow);
+
+  gazebo::rendering::ScenePtr scene = gazebo::rendering::get_scene();
+  QVERIFY(scene != nullptr);
+
+  // Create our node for communication
+  ignition::transport::Node node;
+
+  std::string arrayTopic = "/marker_array";
+  std::string listTopic = "/marker/list";
+
+  std::vector<std::string> serviceList;
+  node.ServiceList(serviceList);
+
+  QVERIFY(std::find(serviceList.begin(), serviceList.end(), arrayTopic)
+          != serviceList.end());
+
+  // Add many line strips in one request
+  ignition::msgs::Marker_V arrayMsg;
+  const int markerCount = 20;
+  for (int i = 0; i < markerCount; ++i)
+  {
+    ignition::msgs::Marker *markerMsg = arrayMsg.add_marker();
+    markerMsg->set_ns("array");
+    markerMsg->set_id(i + 1);
+    markerMsg->set_action(ignition::msgs::Marker::ADD_MODIFY);
+    markerMsg->set_type(ignition::msgs::Marker::LINE_STRIP);
+    for (int j = 0; j < 10; ++j)
+      ignition::msgs::Set(markerMsg->add_point(),
+          ignition::math::Vector3d(i, j, 0));
+  }
+
+  {
+    auto visCount = scene->VisualCount();
+
+    ignition::msgs::Boolean rep;
+    bool result;
+    QVERIFY(node.Request(arrayTopic, arrayMsg, 5000u, rep, result));
+    QVERIFY(result);
+    QVERIFY(rep.data());
+
+    this->ProcessEventsAndDraw(mainWindow);
+
+    QCOMPARE(scene->VisualCount(), visCount + markerCount);
+  }
+
+  // Move a single point of every marker
+  for (int i = 0; i < markerCount; ++i)
+  {
+    ignition::msgs::Set(arrayMsg.mutable_marker(i)->mutable_point(5),
+        ignition::math::Vector3d(i, 5, 1));
+  }
+
+  {
+    auto visCount = scene->VisualCount();
+
+    ignition::msgs::Boolean rep;
+    bool result;
+    QVERIFY(node.Request(arrayTopic, arrayMsg, 5000u, rep, result));
+    QVERIFY(result);
+
+    this->ProcessEventsAndDraw(mainWindow);
+
+    // No visual was added
+    QCOMPARE(scene->VisualCount(), visCount);
+  }
+
+  // Check the points of the markers
+  {
+    ignition::msgs::Marker_V rep;
+    bool result;
+
+    QVERIFY(node.Request(listTopic, 5000u, rep, result));
+
+    QCOMPARE(rep.marker().size(), markerCount);
+    for (int i = 0; i < rep.marker().size(); ++i)
+    {
+      QCOMPARE(rep.marker(i).point().size(), 10);
+      QVERIFY(ignition::math::equal(rep.marker(i).point(5).z(), 1.0));
+      QVERIFY(ignition::math::equal(rep.marker(i).point(4).z(), 0.0));
+    }
+  }
+
+  mainWindow->close();
+  delete mainWindow;
+}
+
 // Generate a main function for the test
 QTEST_MAIN(Marker_TEST)
@@ -29,5 +29,8 @@ class Marker_TEST : public QTestFixture
 
   /// \brief Test corner cases.
   private slots: void CornerCases();
+
+  /// \brief Test adding and modifying many markers at once.
+  private slots: void Array();
 };
 #endif
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <fstream>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+
+// The model database is only fetched once per process, so these tests
+// don't share a binary with the tests that use the online database.
+class ModelDatabaseDownloadTest : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+/// \brief Write a file.
+/// \param[in] _path Path of the file.
+/// \param[in] _data Content of the file.
+static void writeFile(const boost::filesystem::path &_path,
+    const std::string &_data)
+{
+  boost::filesystem::create_directories(_path.parent_path());
+  std::ofstream out(_path.string().c_str());
+  out << _data;
+}
+
+/////////////////////////////////////////////////
+/// \brief Add a model to a local model database.
+/// \param[in] _db Directory of the database.
+/// \param[in] _name Name of the model.
+/// \param[in] _depend Name of a model it depends on, or empty.
+static void addModel(const boost::filesystem::path &_db,
+    const std::string &_name, const std::string &_depend)
+{
+  std::string config = "<?xml version='1.0'?><model><name>" + _name +
+    "</name><version>1.0</version><sdf version='1.6'>model.sdf</sdf>";
+  if (!_depend.empty())
+  {
+    config += "<depend><model><uri>model://" + _depend +
+      "</uri></model></depend>";
+  }
+  config += "</model>";
+
+  const boost::filesystem::path src = _db / "src" / _name;
+  writeFile(src / "model.config", config);
+  writeFile(src / "model.sdf", "<?xml version='1.0'?><sdf version='1.6'>"
+      "<model name='" + _name + "'><static>true</static>"
+      "<link name='link'/></model></sdf>");
+
+  // The database serves the manifest and a tarball of the model
+  writeFile(_db / _name / "model.config", config);
+  custom_exec("tar -C " + (_db / "src").string() + " -czf " +
+      (_db / _name / "model.tar.gz").string() + " " + _name);
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the files in a directory.
+/// \param[in] _dir The directory.
+/// \return Number of files.
+static int fileCount(const boost::filesystem::path &_dir)
+{
+  int count = 0;
+  if (!boost::filesystem::exists(_dir))
+    return count;
+
+  for (boost::filesystem::directory_iterator iter(_dir), end;
+       iter != end; ++iter)
+  {
+    ++count;
+  }
+  return count;
+}
+
+/////////////////////////////////////////////////
+// Models and their dependencies are downloaded from a database, and their
+// tarballs are reused from the cache.
+TEST_F(ModelDatabaseDownloadTest, DownloadModels)
+{
+  const boost::filesystem::path dir =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gazebo-model-db-%%%%%%");
+  const boost::filesystem::path db = dir / "db";
+  const boost::filesystem::path home = dir / "home";
+  const boost::filesystem::path cache = dir / "cache";
+  ASSERT_TRUE(boost::filesystem::create_directories(home));
+
+  addModel(db, "db_box", "db_base");
+  addModel(db, "db_base", "");
+  addModel(db, "db_cone", "db_base");
+  writeFile(db / "database.config", "<?xml version='1.0'?><database>"
+      "<name>test</name><models><uri>file://db_box</uri>"
+      "<uri>file://db_base</uri><uri>file://db_cone</uri></models>"
+      "</database>");
+
+  setenv("GAZEBO_MODEL_DATABASE_URI", ("file://" + db.string()).c_str(), 1);
+  setenv("GAZEBO_MODEL_CACHE_PATH", cache.string().c_str(), 1);
+  setenv("GAZEBO_MODEL_DOWNLOAD_CONNECTIONS", "2", 1);
+  setenv("HOME", home.string().c_str(), 1);
+
+  common::ModelDatabase *modelDb = common::ModelDatabase::Instance();
+  EXPECT_TRUE(modelDb->HasModel("model://db_box"));
+
+  // The dependency is downloaded once for both models
+  EXPECT_TRUE(modelDb->DownloadModels({"model://db_box", "model://db_cone"}));
+  const boost::filesystem::path models = home / ".gazebo" / "models";
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_box" / "model.sdf"));
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_cone" / "model.sdf"));
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_base" / "model.sdf"));
+  EXPECT_EQ(3, fileCount(cache / "objects"));
+  EXPECT_EQ(3, fileCount(cache / "refs"));
+
+  // Installed models aren't downloaded again
+  boost::filesystem::remove(db / "db_box" / "model.tar.gz");
+  EXPECT_TRUE(modelDb->DownloadModels({"model://db_box"}));
+
+  // The cache is used for models that aren't installed
+  boost::filesystem::remove_all(models);
+  EXPECT_TRUE(modelDb->DownloadModels({"model://db_box"}));
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_box" / "model.sdf"));
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_base" / "model.sdf"));
+
+  // A damaged cached tarball is downloaded again
+  boost::filesystem::remove_all(models);
+  for (boost::filesystem::directory_iterator iter(cache / "objects"), end;
+       iter != end; ++iter)
+  {
+    writeFile(iter->path(), "damaged");
+  }
+  EXPECT_TRUE(modelDb->DownloadModels({"model://db_cone"}));
+  EXPECT_TRUE(boost::filesystem::exists(models / "db_cone" / "model.sdf"));
+
+  // A model that the database doesn't have
+  EXPECT_FALSE(modelDb->DownloadModels({"model://db_missing"}));
+
+  boost::filesystem::remove_all(dir);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
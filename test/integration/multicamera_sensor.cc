@@ -15,6 +15,10 @@
  *
 */
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/sensors.hh"
 #include "gazebo/common/common.hh"
@@ -652,6 +656,102 @@ TEST_F(MultiCameraSensor, StrictUpdateRate)
   delete [] img2;
 }
 
+/// \brief Protects the received multicamera messages.
+std::mutex g_imagesMutex;
+
+/// \brief Number of images and bytes of each received message.
+std::vector<std::vector<size_t>> g_imagesSizes;
+
+/////////////////////////////////////////////////
+void OnImagesStamped(ConstImagesStampedPtr &_msg)
+{
+  std::vector<size_t> sizes;
+  for (int i = 0; i < _msg->image_size(); ++i)
+    sizes.push_back(_msg->image(i).data().size());
+
+  std::lock_guard<std::mutex> lock(g_imagesMutex);
+  g_imagesSizes.push_back(sizes);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MultiCameraSensor, SameFrame)
+{
+  Load("worlds/camera_rotation_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run camera test\n";
+    return;
+  }
+
+  sensors::MultiCameraSensorPtr multiCamSensor =
+    std::dynamic_pointer_cast<sensors::MultiCameraSensor>(
+    sensors::get_sensor("multicamera_sensor_unrotated"));
+  ASSERT_TRUE(multiCamSensor != nullptr);
+  ASSERT_EQ(2u, multiCamSensor->CameraCount());
+
+  // A slow render rate on one camera doesn't make it skip frames
+  multiCamSensor->Camera(1)->SetRenderRate(1.0);
+
+  transport::SubscriberPtr sub = this->node->Subscribe(
+      multiCamSensor->Topic(), &OnImagesStamped);
+
+  int imageCount0 = 0;
+  unsigned char* img0 = new unsigned char[
+      multiCamSensor->ImageWidth(0) * multiCamSensor->ImageHeight(0) * 3];
+  event::ConnectionPtr c0 = multiCamSensor->Camera(0)->ConnectNewImageFrame(
+        std::bind(&::OnNewFrameTest, &imageCount0, img0,
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+
+  int imageCount1 = 0;
+  unsigned char* img1 = new unsigned char[
+      multiCamSensor->ImageWidth(1) * multiCamSensor->ImageHeight(1) * 3];
+  event::ConnectionPtr c1 = multiCamSensor->Camera(1)->ConnectNewImageFrame(
+        std::bind(&::OnNewFrameTest, &imageCount1, img1,
+          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+          std::placeholders::_4, std::placeholders::_5));
+
+  int sleep = 0;
+  while (imageCount0 < 15 && sleep++ < 500)
+    common::Time::MSleep(10);
+  c0.reset();
+  c1.reset();
+
+  EXPECT_GE(imageCount0, 15);
+  EXPECT_GE(imageCount1, imageCount0 - 1);
+  EXPECT_LE(imageCount1, imageCount0 + 1);
+
+  // Each message carries the full image of both cameras
+  sleep = 0;
+  while (sleep++ < 100)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_imagesMutex);
+      if (g_imagesSizes.size() >= 5u)
+        break;
+    }
+    common::Time::MSleep(10);
+  }
+  sub.reset();
+
+  std::lock_guard<std::mutex> lock(g_imagesMutex);
+  EXPECT_GE(g_imagesSizes.size(), 5u);
+  for (auto const &sizes : g_imagesSizes)
+  {
+    ASSERT_EQ(2u, sizes.size());
+    EXPECT_EQ(multiCamSensor->ImageWidth(0) *
+        multiCamSensor->ImageHeight(0) * 3, sizes[0]);
+    EXPECT_EQ(multiCamSensor->ImageWidth(1) *
+        multiCamSensor->ImageHeight(1) * 3, sizes[1]);
+  }
+
+  delete [] img0;
+  delete [] img1;
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
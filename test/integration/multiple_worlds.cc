@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <atomic>
+
+#include "gazebo/sensors/sensors.hh"
+#include "gazebo/test/ServerFixture.hh"
+
+using namespace gazebo;
+class MultipleWorlds : public ServerFixture
+{
+};
+
+/////////////////////////////////////////////////
+// Load every world of a file and step them independently
+TEST_F(MultipleWorlds, Load)
+{
+  this->Load("test/worlds/multiple_worlds.world", true);
+
+  auto worlds = physics::get_worlds();
+  ASSERT_EQ(2u, worlds.size());
+  EXPECT_EQ("first", worlds[0]->Name());
+  EXPECT_EQ("second", worlds[1]->Name());
+
+  EXPECT_NE(nullptr, worlds[0]->ModelByName("box"));
+  EXPECT_EQ(nullptr, worlds[1]->ModelByName("box"));
+
+  worlds[0]->Step(10);
+  EXPECT_EQ(10u, worlds[0]->Iterations());
+  EXPECT_EQ(0u, worlds[1]->Iterations());
+
+  worlds[1]->Step(5);
+  EXPECT_EQ(10u, worlds[0]->Iterations());
+  EXPECT_EQ(5u, worlds[1]->Iterations());
+}
+
+/////////////////////////////////////////////////
+// Run several copies of a world at the same time
+TEST_F(MultipleWorlds, Instances)
+{
+  this->LoadArgs("-u --instances 3 worlds/empty.world");
+
+  auto worlds = physics::get_worlds();
+  ASSERT_EQ(3u, worlds.size());
+  for (unsigned int i = 0; i < worlds.size(); ++i)
+    EXPECT_EQ("default_" + std::to_string(i), worlds[i]->Name());
+
+  physics::pause_worlds(false);
+
+  // Each world steps in its own thread
+  int sleep = 0;
+  int maxSleep = 500;
+  bool stepped = false;
+  while (!stepped && sleep++ < maxSleep)
+  {
+    stepped = true;
+    for (auto const &world : worlds)
+      stepped = stepped && world->Iterations() > 100;
+    common::Time::MSleep(10);
+  }
+  EXPECT_TRUE(stepped);
+
+  physics::pause_worlds(true);
+}
+
+/////////////////////////////////////////////////
+// Sensors of each world are paced on the sim time of their own world
+TEST_F(MultipleWorlds, Sensors)
+{
+  this->Load("test/worlds/multiple_worlds_sensors.world", true);
+
+  auto worlds = physics::get_worlds();
+  ASSERT_EQ(2u, worlds.size());
+
+  while (!sensors::SensorManager::Instance()->SensorsInitialized())
+    common::Time::MSleep(100);
+
+  sensors::SensorPtr first = sensors::get_sensor("first_imu");
+  sensors::SensorPtr second = sensors::get_sensor("second_imu");
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ("first", first->WorldName());
+  EXPECT_EQ("second", second->WorldName());
+
+  std::atomic<int> firstCount(0);
+  std::atomic<int> secondCount(0);
+  event::ConnectionPtr firstConnection = first->ConnectUpdated(
+      [&firstCount]()
+      {
+        ++firstCount;
+      });
+  event::ConnectionPtr secondConnection = second->ConnectUpdated(
+      [&secondCount]()
+      {
+        ++secondCount;
+      });
+
+  // Move the first world well ahead of the second one
+  for (int i = 0; i < 2000; ++i)
+    worlds[0]->Step(1);
+  EXPECT_EQ(2000u, worlds[0]->Iterations());
+  EXPECT_EQ(0u, worlds[1]->Iterations());
+
+  // The sensor of the second world updates at its rate, even though the
+  // first world is 2 s ahead. Step slowly so that the sensor thread keeps
+  // up with the world.
+  for (int i = 0; i < 500; ++i)
+  {
+    worlds[1]->Step(1);
+    common::Time::MSleep(2);
+  }
+  EXPECT_EQ(500u, worlds[1]->Iterations());
+
+  // 0.5 s at 100 Hz
+  const int count = secondCount;
+  EXPECT_GE(count, 25);
+  EXPECT_LE(count, 51);
+  EXPECT_GT(firstCount.load(), 0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -57,6 +57,17 @@ void MultirayShapeTest::Standalone(const std::string &_physicsEngine)
 
   rays->Update();
 
+  // The batched scan matches the per ray values
+  std::vector<double> ranges, retros;
+  rays->Scan(ranges, retros);
+  ASSERT_EQ(ranges.size(), 4u);
+  ASSERT_EQ(retros.size(), 4u);
+  for (unsigned int i = 0; i < ranges.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(ranges[i], rays->GetRange(i));
+    EXPECT_DOUBLE_EQ(retros[i], rays->GetRetro(i));
+  }
+
   double dist;
   std::string entity;
 
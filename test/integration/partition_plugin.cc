@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <ignition/math/Vector3.hh>
+#include <ignition/transport/Node.hh>
+
+#include "gazebo/msgs/msgs.hh"
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "test_config.h"
+
+using namespace gazebo;
+class PartitionPluginTest : public ServerFixture
+{
+};
+
+/// \brief Protects the received steps.
+std::mutex g_partitionMutex;
+
+/// \brief Iterations of the steps published by each partition.
+std::map<int, std::set<double>> g_partitionSteps;
+
+/// \brief Number of times each partition handed the box over.
+std::map<int, int> g_boxMigrations;
+
+/////////////////////////////////////////////////
+// Receive the messages of both partitions.
+void onPartition(const msgs::Param_V &_msg)
+{
+  if (_msg.param_size() < 4)
+    return;
+
+  const int id = _msg.param(0).value().int_value();
+  const double iterations = _msg.param(1).value().double_value();
+  std::lock_guard<std::mutex> lock(g_partitionMutex);
+
+  // Messages are sent again while a partition waits for its peer
+  if (!g_partitionSteps[id].insert(iterations).second)
+    return;
+
+  for (int i = 4; i < _msg.param_size(); ++i)
+  {
+    if (_msg.param(i).name() != "migrate")
+      continue;
+    for (auto const &child : _msg.param(i).children())
+    {
+      if (child.name() == "name" && child.value().string_value() == "box")
+        ++g_boxMigrations[id];
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+// A box crossing the border between two servers is handed over once.
+TEST_F(PartitionPluginTest, MigrateOnce)
+{
+  ignition::transport::Node node;
+  ASSERT_TRUE(node.Subscribe("/test/partition", &onPartition));
+
+  // Partition 0, x < 0, runs here
+  this->Load("test/worlds/partition_plugin_0.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+  physics::ModelPtr box = world->ModelByName("box");
+  ASSERT_NE(nullptr, box);
+
+  // Partition 1, x >= 0, runs in its own gzserver, with its own master
+  const std::string cmd = "GAZEBO_MASTER_URI=http://localhost:11346 "
+      "GAZEBO_PLUGIN_PATH=" PROJECT_BINARY_PATH "/plugins "
+      "gzserver " TEST_PATH "/worlds/partition_plugin_1.world";
+  std::thread peer([cmd]()
+  {
+    custom_exec(cmd);
+  });
+
+  int sleep = 0;
+  bool ready = false;
+  while (!ready && sleep++ < 300)
+  {
+    common::Time::MSleep(100);
+    std::lock_guard<std::mutex> lock(g_partitionMutex);
+    ready = g_partitionSteps.count(1) > 0;
+  }
+  if (!ready)
+  {
+    custom_exec("pkill -9 -f partition_plugin_1.world");
+    peer.join();
+    FAIL() << "The peer gzserver didn't start";
+  }
+  box->SetLinearVel(ignition::math::Vector3d(1, 0, 0));
+  box.reset();
+
+  // The box crosses x = 0 after 0.5 s, and is past the ghost margin of
+  // the peer after 1 s
+  world->Step(1500);
+
+  sleep = 0;
+  while (world->ModelByName("box") && sleep++ < 50)
+  {
+    world->Step(1);
+    common::Time::MSleep(10);
+  }
+  EXPECT_EQ(nullptr, world->ModelByName("box"));
+
+  custom_exec("pkill -9 -f partition_plugin_1.world");
+  peer.join();
+
+  std::lock_guard<std::mutex> lock(g_partitionMutex);
+  EXPECT_EQ(1, g_boxMigrations[0]);
+
+  // The peer removed its own copy of the box when it started
+  EXPECT_EQ(0, g_boxMigrations[1]);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -46,6 +46,7 @@ class PhysicsTest : public ServerFixture,
   public: void JointDampingTest(const std::string &_physicsEngine);
   public: void DropStuff(const std::string &_physicsEngine);
   public: void SpawnFixedJoint(const std::string &_physicsEngine);
+  public: void SpawnRemove(const std::string &_physicsEngine);
 };
 
 ////////////////////////////////////////////////////////////////////////
@@ -1569,6 +1570,49 @@ TEST_P(PhysicsTest, SpawnFixedJoint)
   SpawnFixedJoint(GetParam());
 }
 
+/////////////////////////////////////////////////
+// This test verifies that the poses of models spawned after others were
+// removed are updated, also when the number of models doesn't change.
+void PhysicsTest::SpawnRemove(const std::string &_physicsEngine)
+{
+  Load("worlds/empty.world", true, _physicsEngine);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // Verify physics engine type
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+  EXPECT_EQ(physics->GetType(), _physicsEngine);
+
+  const unsigned int modelCount = world->ModelCount();
+  SpawnBox("box_a", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(0, 0, 5));
+  physics::ModelPtr boxA = world->ModelByName("box_a");
+  ASSERT_TRUE(boxA != NULL);
+  world->Step(100);
+  EXPECT_LT(boxA->WorldPose().Pos().Z(), 5.0 - PHYSICS_TOL);
+  boxA.reset();
+
+  // Replace the box, so that the world has as many models as before
+  world->RemoveModel("box_a");
+  world->Step(1);
+  SpawnBox("box_b", ignition::math::Vector3d::One,
+      ignition::math::Vector3d(2, 0, 5));
+  EXPECT_EQ(modelCount + 1, world->ModelCount());
+  physics::ModelPtr boxB = world->ModelByName("box_b");
+  ASSERT_TRUE(boxB != NULL);
+  world->Step(100);
+  EXPECT_LT(boxB->WorldPose().Pos().Z(), 5.0 - PHYSICS_TOL);
+  EXPECT_LT(boxB->GetLink("body")->WorldPose().Pos().Z(),
+      5.0 - PHYSICS_TOL);
+}
+
+TEST_P(PhysicsTest, SpawnRemove)
+{
+  SpawnRemove(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, PhysicsTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 int main(int argc, char **argv)
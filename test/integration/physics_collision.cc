@@ -38,6 +38,11 @@ class PhysicsCollisionTest : public ServerFixture,
   /// and verify that they have matching behavior.
   /// \param[in] _physicsEngine Type of physics engine to use.
   public: void PoseOffsets(const std::string &_physicsEngine);
+
+  /// \brief Shoot spheres at a thin wall with large steps, and verify
+  /// that only the sphere with continuous collision detection is stopped.
+  /// \param[in] _physicsEngine Type of physics engine to use.
+  public: void ContinuousCollision(const std::string &_physicsEngine);
 };
 
 /////////////////////////////////////////////////
@@ -349,6 +354,89 @@ TEST_F(PhysicsCollisionTest, ModelSelfCollide)
   Unload();
 }
 
+/////////////////////////////////////////////////
+void PhysicsCollisionTest::ContinuousCollision(
+    const std::string &_physicsEngine)
+{
+  if (_physicsEngine != "ode" && _physicsEngine != "bullet")
+  {
+    gzerr << "Continuous collision detection isn't supported by "
+          << _physicsEngine << std::endl;
+    return;
+  }
+
+  Load("worlds/empty.world", true, _physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != NULL);
+  physics->SetMaxStepSize(0.004);
+  world->SetGravity(ignition::math::Vector3d::Zero);
+
+  // A wall 2 cm thick
+  std::ostringstream wallStream;
+  wallStream << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='wall'>"
+    << "<static>true</static>"
+    << "<pose>2 0 1 0 0 0</pose>"
+    << "<link name='link'>"
+      << "<collision name='collision'>"
+        << "<geometry><box><size>0.02 4 2</size></box></geometry>"
+      << "</collision>"
+    << "</link>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(wallStream.str());
+
+  // Spheres that move 0.8 m per step
+  for (auto const &ccd : {true, false})
+  {
+    std::ostringstream sphereStream;
+    sphereStream << "<sdf version='" << SDF_VERSION << "'>"
+      << "<model name='sphere_" << ccd << "'>"
+      << "<pose>0 " << (ccd ? -1 : 1) << " 1 0 0 0</pose>"
+      << "<link name='link'>"
+        << "<gz:continuous_collision>" << ccd << "</gz:continuous_collision>"
+        << "<collision name='collision'>"
+          << "<geometry><sphere><radius>0.05</radius></sphere></geometry>"
+        << "</collision>"
+      << "</link>"
+      << "</model>"
+      << "</sdf>";
+    SpawnSDF(sphereStream.str());
+  }
+
+  physics::ModelPtr swept = world->ModelByName("sphere_1");
+  physics::ModelPtr plain = world->ModelByName("sphere_0");
+  ASSERT_TRUE(swept != NULL);
+  ASSERT_TRUE(plain != NULL);
+  physics::LinkPtr link = swept->GetLink("link");
+  ASSERT_TRUE(link != NULL);
+  EXPECT_TRUE(link->ContinuousCollision());
+  EXPECT_NEAR(link->ContinuousCollisionRadius(), 0.05, 1e-6);
+  EXPECT_FALSE(plain->GetLink("link")->ContinuousCollision());
+
+  swept->SetLinearVel(ignition::math::Vector3d(200, 0, 0));
+  plain->SetLinearVel(ignition::math::Vector3d(200, 0, 0));
+  world->Step(10);
+
+  // The plain sphere passes through the wall, the swept one doesn't
+  EXPECT_GT(plain->WorldPose().Pos().X(), 2.0);
+  EXPECT_LT(swept->WorldPose().Pos().X(), 2.0);
+
+  // It can be disabled at run time
+  link->SetContinuousCollision(false);
+  EXPECT_FALSE(link->ContinuousCollision());
+
+  Unload();
+}
+
+/////////////////////////////////////////////////
+TEST_P(PhysicsCollisionTest, ContinuousCollision)
+{
+  ContinuousCollision(GetParam());
+}
+
 /////////////////////////////////////////////////
 TEST_P(PhysicsCollisionTest, GetBoundingBox)
 {
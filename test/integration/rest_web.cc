@@ -15,7 +15,19 @@
  *
 */
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
 #include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -33,6 +45,7 @@ class RestWebTest : public ServerFixture,
                       public testing::WithParamInterface<const char*>
 {
   public: void FirstTest(const std::string &_physicsEngine);
+  public: void BatchedPosts(const std::string &_physicsEngine);
 };
 
 // globals to exchange data between threads
@@ -144,6 +157,264 @@ void RestWebTest::FirstTest(const std::string &_physicsEngine)
   EXPECT_GT(count_after, count_before);
 }
 
+/////////////////////////////////////////////////
+/// \brief A REST service on localhost, that answers every request with
+/// success and keeps the route and the data of each request.
+class RestServer
+{
+  /// \brief Constructor, starts the service on a free port.
+  public: RestServer()
+  {
+    this->fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t size = sizeof(addr);
+    if (bind(this->fd, reinterpret_cast<sockaddr *>(&addr), size) != 0 ||
+        listen(this->fd, 8) != 0 ||
+        getsockname(this->fd, reinterpret_cast<sockaddr *>(&addr),
+          &size) != 0)
+    {
+      return;
+    }
+
+    // Check the stop flag every 100 ms
+    timeval timeout;
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 100000;
+    setsockopt(this->fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    this->url = "http://127.0.0.1:" + std::to_string(ntohs(addr.sin_port));
+    this->thread = std::thread(&RestServer::Run, this);
+  }
+
+  /// \brief Destructor, stops the service.
+  public: ~RestServer()
+  {
+    this->Stop();
+  }
+
+  /// \brief Stop the service, later requests fail to connect.
+  public: void Stop()
+  {
+    this->stop = true;
+    if (this->thread.joinable())
+      this->thread.join();
+    if (this->fd >= 0)
+      close(this->fd);
+    this->fd = -1;
+  }
+
+  /// \brief Get the requests received so far.
+  /// \return The route and the data of each request.
+  public: std::vector<std::pair<std::string, std::string>> Requests()
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    return this->requests;
+  }
+
+  /// \brief Accept the requests until stopped.
+  private: void Run()
+  {
+    while (!this->stop)
+    {
+      int client = accept(this->fd, nullptr, nullptr);
+      if (client < 0)
+        continue;
+
+      std::string text;
+      std::size_t end = std::string::npos;
+      char buffer[4096];
+      ssize_t n;
+      while (end == std::string::npos &&
+          (n = read(client, buffer, sizeof(buffer))) > 0)
+      {
+        text.append(buffer, n);
+        end = text.find("\r\n\r\n");
+      }
+      if (end == std::string::npos)
+      {
+        close(client);
+        continue;
+      }
+
+      const std::string header = text.substr(0, end);
+      std::string data = text.substr(end + 4);
+      std::size_t length = 0;
+      const std::size_t field = header.find("Content-Length: ");
+      if (field != std::string::npos)
+        length = std::stoul(header.substr(field + 16));
+      if (header.find("Expect: 100-continue") != std::string::npos)
+      {
+        const std::string proceed = "HTTP/1.1 100 Continue\r\n\r\n";
+        EXPECT_GT(write(client, proceed.data(), proceed.size()), 0);
+      }
+      while (data.size() < length &&
+          (n = read(client, buffer, sizeof(buffer))) > 0)
+      {
+        data.append(buffer, n);
+      }
+
+      // "POST /route HTTP/1.1"
+      const std::size_t start = header.find(' ') + 1;
+      const std::string route =
+          header.substr(start, header.find(' ', start) - start);
+      {
+        boost::mutex::scoped_lock lock(this->mutex);
+        this->requests.push_back(std::make_pair(route, data));
+      }
+
+      const std::string response = "HTTP/1.1 200 OK\r\n"
+          "Content-Length: 2\r\nConnection: close\r\n\r\nok";
+      EXPECT_GT(write(client, response.data(), response.size()), 0);
+      close(client);
+    }
+  }
+
+  /// \brief Url of the service.
+  public: std::string url;
+
+  /// \brief Socket of the service.
+  private: int fd = -1;
+
+  /// \brief True to stop the service.
+  private: std::atomic<bool> stop{false};
+
+  /// \brief Thread accepting the requests.
+  private: std::thread thread;
+
+  /// \brief Protects the requests.
+  private: boost::mutex mutex;
+
+  /// \brief Route and data of each request.
+  private: std::vector<std::pair<std::string, std::string>> requests;
+};
+
+/// \brief Responses of the plugin, by type.
+std::map<int, unsigned int> g_responses;
+
+//////////////////////////////////////////////////
+// callback for the responses, counts them by type
+void ReceiveRestResponse(ConstRestResponsePtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_mutex);
+  ++g_responses[_msg->type()];
+}
+
+//////////////////////////////////////////////////
+// waits for a number of responses of a type
+unsigned int WaitForResponses(const int _type, const unsigned int _count)
+{
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    {
+      boost::mutex::scoped_lock lock(g_mutex);
+      if (g_responses[_type] >= _count)
+        return g_responses[_type];
+    }
+    common::Time::MSleep(100);
+  }
+  boost::mutex::scoped_lock lock(g_mutex);
+  return g_responses[_type];
+}
+
+//////////////////////////////////////////////////
+// test macro
+TEST_P(RestWebTest, BatchedPosts)
+{
+  BatchedPosts(GetParam());
+}
+
+//////////////////////////////////////////////////
+// Posts queued before the login are sent in batches once logged in, the
+// oldest ones being dropped when the queue is full. A failed post is
+// reported once the service is gone.
+//////////////////////////////////////////////////
+void RestWebTest::BatchedPosts(const std::string &_physicsEngine)
+{
+  RestServer server;
+  ASSERT_FALSE(server.url.empty());
+
+  setenv("GAZEBO_REST_FLUSH_INTERVAL", "0.2", 1);
+  setenv("GAZEBO_REST_BATCH_SIZE", "5", 1);
+  setenv("GAZEBO_REST_MAX_POSTS", "8", 1);
+  Load("test/worlds/rest_web.world",
+       true,
+       _physicsEngine,
+       {"libRestWebPlugin.so"});
+  unsetenv("GAZEBO_REST_FLUSH_INTERVAL");
+  unsetenv("GAZEBO_REST_BATCH_SIZE");
+  unsetenv("GAZEBO_REST_MAX_POSTS");
+  {
+    boost::mutex::scoped_lock lock(g_mutex);
+    g_responses.clear();
+  }
+
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+  transport::SubscriberPtr sub = node->Subscribe("/gazebo/rest/rest_response",
+      &ReceiveRestResponse);
+
+  // Queue 10 posts while logged out, the first 2 are dropped
+  transport::PublisherPtr postPub =
+      node->Advertise<msgs::RestPost>("/gazebo/rest/rest_post");
+  postPub->WaitForConnection();
+  for (int i = 0; i < 10; ++i)
+  {
+    msgs::RestPost msg;
+    msg.set_route("/events/new");
+    msg.set_json("{\"post\": " + std::to_string(i) + "}");
+    postPub->Publish(msg);
+  }
+  EXPECT_EQ(10u, WaitForResponses(msgs::RestResponse::SUCCESS, 10));
+
+  transport::PublisherPtr loginPub =
+      node->Advertise<msgs::RestLogin>("/gazebo/rest/rest_login");
+  loginPub->WaitForConnection();
+  msgs::RestLogin login;
+  login.set_url(server.url);
+  login.set_username("myuser");
+  login.set_password("mypass");
+  loginPub->Publish(login);
+  EXPECT_EQ(1u, WaitForResponses(msgs::RestResponse::LOGIN, 1));
+
+  // The login, then a batch of 5 posts and a batch of 3 posts
+  auto requests = server.Requests();
+  ASSERT_EQ(3u, requests.size());
+  EXPECT_EQ("/login", requests[0].first);
+  EXPECT_TRUE(requests[0].second.empty());
+  for (unsigned int i = 1; i < requests.size(); ++i)
+  {
+    EXPECT_EQ("/events/new", requests[i].first);
+    EXPECT_EQ('[', requests[i].second.front());
+    EXPECT_EQ(']', requests[i].second.back());
+  }
+  for (int i = 0; i < 10; ++i)
+  {
+    const std::string post = "{\"post\": " + std::to_string(i) + "}";
+    const std::string &data = requests[i < 7 ? 1 : 2].second;
+    EXPECT_EQ(i >= 2, data.find(post) != std::string::npos) << post;
+  }
+
+  // Posts of a logged in session are sent at the flush interval
+  msgs::RestPost msg;
+  msg.set_route("/events/other");
+  msg.set_json("{\"post\": 10}");
+  postPub->Publish(msg);
+  for (int i = 0; i < 50 && server.Requests().size() < 4u; ++i)
+    common::Time::MSleep(100);
+  requests = server.Requests();
+  ASSERT_EQ(4u, requests.size());
+  EXPECT_EQ("/events/other", requests[3].first);
+  EXPECT_NE(std::string::npos, requests[3].second.find("{\"post\": 10}"));
+
+  // Once the service is gone, the failed post is reported
+  server.Stop();
+  postPub->Publish(msg);
+  EXPECT_GE(WaitForResponses(msgs::RestResponse::ERR, 1), 1u);
+}
+
 INSTANTIATE_TEST_CASE_P(PhysicsEngines, RestWebTest, PHYSICS_ENGINE_VALUES,);  // NOLINT
 
 // main, where we can specify to skip certain tests
@@ -176,6 +176,47 @@ TEST_F(SpeedThreadIslandsTest, DualPR2WorldStep)
   ThreadSpeedup("ode", "world", "worlds/dual_pr2.world", 2, 50);
 }
 
+/////////////////////////////////////////////////
+// Islands are independent, so their order and the threads that solve
+// them must not change the result.
+TEST_F(SpeedThreadIslandsTest, ThreadedMatchesSerial)
+{
+  Load("worlds/revolute_joint_test_with_large_gap.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != nullptr);
+  physics::PhysicsEnginePtr physics = world->Physics();
+  ASSERT_TRUE(physics != nullptr);
+
+  world->Step(100);
+  physics::WorldSnapshot snapshot;
+  world->SaveSnapshot(snapshot);
+
+  auto record = [&world]()
+  {
+    std::vector<ignition::math::Pose3d> poses;
+    for (unsigned int i = 0; i < 50; ++i)
+    {
+      world->Step(10);
+      for (auto const &model : world->Models())
+      {
+        for (auto const &link : model->GetLinks())
+          poses.push_back(link->WorldPose());
+      }
+    }
+    return poses;
+  };
+
+  const std::vector<ignition::math::Pose3d> serial = record();
+
+  physics->SetParam("island_threads", 4);
+  ASSERT_TRUE(world->RestoreSnapshot(snapshot));
+  const std::vector<ignition::math::Pose3d> threaded = record();
+
+  ASSERT_EQ(serial.size(), threaded.size());
+  for (unsigned int i = 0; i < serial.size(); ++i)
+    EXPECT_EQ(serial[i], threaded[i]) << i;
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -69,6 +69,21 @@ TEST_F(StaticMapTest, StaticMapPlugin)
   auto collisions = link->GetCollisions();
   EXPECT_FALSE(collisions.empty());
 
+  // the model is spawned before its tiles are fetched
+  auto visuals = link->Visuals();
+  ASSERT_FALSE(visuals.empty());
+  EXPECT_EQ(visuals.begin()->second.material().script().name(),
+      "Gazebo/Grey");
+
+  // the textures of the tiles replace the placeholder once they are fetched
+  std::string material = "Gazebo/Grey";
+  for (int sleep = 0; material == "Gazebo/Grey" && sleep < 300; ++sleep)
+  {
+    common::Time::MSleep(100);
+    material = link->Visuals().begin()->second.material().script().name();
+  }
+  EXPECT_EQ(material.find(modelName + "/"), 0u);
+
   // verify model dir structure and files
   EXPECT_TRUE(common::exists(modelPath));
   EXPECT_TRUE(common::isFile(modelPath + "/model.sdf"));
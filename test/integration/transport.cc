@@ -18,6 +18,12 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#include <list>
+#include <string>
+#include <vector>
+
+#include "gazebo/transport/ConnectionManager.hh"
+#include "gazebo/transport/TopicManager.hh"
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -186,6 +192,168 @@ TEST_F(TransportTest, DirectPublish)
   ASSERT_GT(timeout, 0) << "Not received a message in 10 seconds";
 }
 
+/////////////////////////////////////////////////
+// Publishing a shared message hands the same instance to local subscribers
+ConstGzStringPtr g_sharedStringMsg;
+void ReceiveSharedStringMsg(ConstGzStringPtr &_msg)
+{
+  g_sharedStringMsg = _msg;
+}
+
+TEST_F(TransportTest, SharedPublish)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node = transport::NodePtr(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>("~/shared");
+  transport::SubscriberPtr sub = node->Subscribe("~/shared",
+      &ReceiveSharedStringMsg);
+
+  boost::shared_ptr<msgs::GzString> msg(new msgs::GzString);
+  msg->set_data("shared");
+  pub->Publish(msg);
+
+  int timeout = 1000;
+  while (!g_sharedStringMsg && --timeout > 0)
+    common::Time::MSleep(10);
+
+  ASSERT_TRUE(g_sharedStringMsg != nullptr);
+  EXPECT_EQ("shared", g_sharedStringMsg->data());
+  EXPECT_EQ(msg.get(), g_sharedStringMsg.get());
+  EXPECT_EQ(msg.get(), pub->GetPrevMsgPtr().get());
+
+  g_sharedStringMsg.reset();
+}
+
+/////////////////////////////////////////////////
+// A latest only subscriber gets the newest message of a backlog
+std::vector<std::string> g_latestOnlyMsgs;
+std::vector<std::string> g_allMsgs;
+void ReceiveLatestOnlyMsg(ConstGzStringPtr &_msg)
+{
+  g_latestOnlyMsgs.push_back(_msg->data());
+}
+
+void ReceiveAllMsg(ConstGzStringPtr &_msg)
+{
+  g_allMsgs.push_back(_msg->data());
+}
+
+TEST_F(TransportTest, LatestOnly)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>("~/latest");
+  transport::SubscriberPtr latestSub = node->Subscribe("~/latest",
+      &ReceiveLatestOnlyMsg, false, true);
+  EXPECT_TRUE(node->HasLatestOnlySubscribers(
+        node->DecodeTopicName("~/latest")));
+
+  // Stall the subscribers while the messages arrive
+  transport::TopicManager::Instance()->PauseIncoming(true);
+  for (int i = 0; i < 10; ++i)
+  {
+    msgs::GzString msg;
+    msg.set_data(std::to_string(i));
+    pub->Publish(msg);
+  }
+  common::Time::MSleep(200);
+  transport::TopicManager::Instance()->PauseIncoming(false);
+
+  int timeout = 1000;
+  while (g_latestOnlyMsgs.empty() && --timeout > 0)
+    common::Time::MSleep(10);
+  common::Time::MSleep(100);
+
+  ASSERT_EQ(1u, g_latestOnlyMsgs.size());
+  EXPECT_EQ("9", g_latestOnlyMsgs.back());
+
+  // With another subscriber that wants every message, the latest only
+  // subscriber still gets only the newest one.
+  transport::SubscriberPtr allSub = node->Subscribe("~/latest",
+      &ReceiveAllMsg);
+  EXPECT_FALSE(node->HasLatestOnlySubscribers(
+        node->DecodeTopicName("~/latest")));
+  g_latestOnlyMsgs.clear();
+
+  transport::TopicManager::Instance()->PauseIncoming(true);
+  for (int i = 10; i < 20; ++i)
+  {
+    msgs::GzString msg;
+    msg.set_data(std::to_string(i));
+    pub->Publish(msg);
+  }
+  common::Time::MSleep(200);
+  transport::TopicManager::Instance()->PauseIncoming(false);
+
+  timeout = 1000;
+  while (g_allMsgs.size() < 10u && --timeout > 0)
+    common::Time::MSleep(10);
+  common::Time::MSleep(100);
+
+  EXPECT_EQ(10u, g_allMsgs.size());
+  ASSERT_FALSE(g_latestOnlyMsgs.empty());
+  EXPECT_EQ("19", g_latestOnlyMsgs.back());
+  EXPECT_LT(g_latestOnlyMsgs.size(), g_allMsgs.size());
+}
+
+/////////////////////////////////////////////////
+// Raw subscribers get the data of remote publishers as it was received
+std::string g_rawData;
+void ReceiveRawData(const std::string &_data)
+{
+  g_rawData = _data;
+}
+
+ConstGzStringPtr g_parsedStringMsg;
+void ReceiveParsedStringMsg(ConstGzStringPtr &_msg)
+{
+  g_parsedStringMsg = _msg;
+}
+
+TEST_F(TransportTest, RawLocalPublish)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr rawNode(new transport::Node());
+  rawNode->Init();
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+  transport::PublisherPtr pub = node->Advertise<msgs::GzString>("~/raw");
+  transport::SubscriberPtr rawSub = rawNode->Subscribe("~/raw",
+      &ReceiveRawData);
+  transport::SubscriberPtr sub = node->Subscribe("~/raw",
+      &ReceiveParsedStringMsg);
+
+  // The data field is set twice, which a parsed message doesn't keep
+  msgs::GzString first;
+  first.set_data("first");
+  msgs::GzString second;
+  second.set_data("second");
+  const std::string data =
+    first.SerializeAsString() + second.SerializeAsString();
+
+  transport::PublicationPtr publication =
+    transport::TopicManager::Instance()->FindPublication(
+        "/gazebo/default/raw");
+  ASSERT_TRUE(publication != nullptr);
+  publication->LocalPublish(data);
+
+  int timeout = 1000;
+  while ((g_rawData.empty() || !g_parsedStringMsg) && --timeout > 0)
+    common::Time::MSleep(10);
+
+  EXPECT_EQ(data, g_rawData);
+  ASSERT_TRUE(g_parsedStringMsg != nullptr);
+  EXPECT_EQ("second", g_parsedStringMsg->data());
+
+  g_rawData.clear();
+  g_parsedStringMsg.reset();
+}
+
 /////////////////////////////////////////////////
 void SinglePub()
 {
@@ -788,6 +956,72 @@ TEST_F(TransportTest, TryInit)
   EXPECT_EQ(physics::get_world()->Name(), node->GetTopicNamespace());
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the advertised topics known to the connection manager.
+/// \param[in] _prefix Prefix of the topics.
+/// \return The topics, in the order the master announced them.
+static std::vector<std::string> knownTopics(const std::string &_prefix)
+{
+  std::list<msgs::Publish> publishers;
+  transport::ConnectionManager::Instance()->GetAllPublishers(publishers);
+
+  std::vector<std::string> topics;
+  for (auto const &pub : publishers)
+  {
+    if (pub.topic().find(_prefix) == 0)
+      topics.push_back(pub.topic());
+  }
+  return topics;
+}
+
+/////////////////////////////////////////////////
+// Publishers advertised at the same time are all announced by the master,
+// in order, and before they are removed.
+TEST_F(TransportTest, ManyAdvertisements)
+{
+  Load("worlds/empty.world");
+
+  transport::NodePtr node(new transport::Node());
+  node->Init();
+
+  const std::string prefix = "/gazebo/default/test/advertise_";
+  const unsigned int count = 100;
+  std::vector<transport::PublisherPtr> pubs;
+  std::vector<std::string> expected;
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    pubs.push_back(node->Advertise<msgs::GzString>(
+        "~/test/advertise_" + std::to_string(i)));
+    expected.push_back(prefix + std::to_string(i));
+  }
+
+  int sleep = 0;
+  while (knownTopics(prefix).size() < count && sleep++ < 300)
+    common::Time::MSleep(10);
+  EXPECT_EQ(expected, knownTopics(prefix));
+
+  // Subscribers of the new topics get their messages
+  g_stringMsg = false;
+  transport::SubscriberPtr sub =
+    node->Subscribe("~/test/advertise_50", &ReceiveStringMsg);
+  msgs::GzString msg;
+  msg.set_data("Hello");
+  pubs[50]->Publish(msg);
+
+  sleep = 0;
+  while (!g_stringMsg && sleep++ < 300)
+    common::Time::MSleep(10);
+  EXPECT_TRUE(g_stringMsg);
+
+  // The removal of a publisher follows its announcement
+  sub.reset();
+  pubs.clear();
+  sleep = 0;
+  while (!knownTopics(prefix).empty() && sleep++ < 300)
+    common::Time::MSleep(10);
+  EXPECT_TRUE(knownTopics(prefix).empty());
+}
+
 /////////////////////////////////////////////////
 // Main
 int main(int argc, char **argv)
@@ -14,6 +14,9 @@
  * limitations under the License.
  *
 */
+#include <cmath>
+#include <string>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/physics.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
@@ -611,6 +614,97 @@ TEST_F(WheelSlipTest, TricyclesUphill)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Check that the slip parameters of a wheel match its spin speed.
+/// \param[in] _model Model of the wheel.
+/// \param[in] _linkName Name of the wheel link.
+/// \param[in] _normalForce Wheel normal force given to the plugin.
+/// \param[in] _compliance Slip compliance given to the plugin.
+static void expectWheelSlip(const physics::ModelPtr &_model,
+    const std::string &_linkName, const double _normalForce,
+    const double _compliance)
+{
+  auto link = _model->GetLink(_linkName);
+  ASSERT_NE(nullptr, link);
+  auto joint = _model->GetJoint(_linkName + "_spin");
+  ASSERT_NE(nullptr, joint);
+  auto collisions = link->GetCollisions();
+  ASSERT_EQ(1u, collisions.size());
+  auto sphere = boost::dynamic_pointer_cast<physics::SphereShape>(
+      collisions.front()->GetShape());
+  ASSERT_NE(nullptr, sphere);
+  auto surface = boost::dynamic_pointer_cast<physics::ODESurfaceParams>(
+      collisions.front()->GetSurface());
+  ASSERT_NE(nullptr, surface);
+
+  const double spin = link->WorldAngularVel().Dot(joint->GlobalAxis(0));
+  const double expected =
+      sphere->GetRadius() * std::abs(spin) / _normalForce * _compliance;
+  EXPECT_NEAR(expected, surface->slip1, 0.02 * expected + 1e-6);
+  EXPECT_NEAR(expected, surface->slip2, 0.02 * expected + 1e-6);
+}
+
+/////////////////////////////////////////////////
+// The vehicles of a world share one wheel table. The table keeps updating
+// the other vehicles once one of them is removed.
+TEST_F(WheelSlipTest, SharedTable)
+{
+  Load("worlds/trisphere_cycle_wheel_slip.world", true);
+
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(world, nullptr);
+  world->Physics()->SetRealTimeUpdateRate(0);
+
+  physics::ModelPtr modelSlip0 = world->ModelByName("trisphere_cycle_slip0");
+  ASSERT_NE(nullptr, modelSlip0);
+  physics::ModelPtr modelSlip1 = world->ModelByName("trisphere_cycle_slip1");
+  ASSERT_NE(nullptr, modelSlip1);
+
+  const common::PID wheelSpeed(9, 0, 0);
+  for (auto const &model : {modelSlip0, modelSlip1})
+  {
+    auto jc = model->GetJointController();
+    for (auto const &joint : {"wheel_rear_left_spin", "wheel_rear_right_spin"})
+    {
+      jc->SetVelocityPID(model->GetScopedName() + "::" + joint, wheelSpeed);
+      jc->SetVelocityTarget(model->GetScopedName() + "::" + joint, 6.0);
+    }
+  }
+
+  world->Step(1000);
+
+  // Each vehicle has the compliance of its own plugin
+  expectWheelSlip(modelSlip0, "wheel_rear_left", 32, 0);
+  expectWheelSlip(modelSlip0, "wheel_rear_right", 32, 0);
+  expectWheelSlip(modelSlip1, "wheel_rear_left", 32, 1);
+  expectWheelSlip(modelSlip1, "wheel_rear_right", 32, 1);
+
+  // Spinning wheels with a compliance slip
+  {
+    auto collision = modelSlip1->GetLink("wheel_rear_left")->GetCollisions();
+    ASSERT_EQ(1u, collision.size());
+    auto surface = boost::dynamic_pointer_cast<physics::ODESurfaceParams>(
+        collision.front()->GetSurface());
+    ASSERT_NE(nullptr, surface);
+    EXPECT_GT(surface->slip1, 0.0);
+  }
+
+  // Remove a vehicle, the other one is still updated
+  modelSlip0.reset();
+  world->RemoveModel("trisphere_cycle_slip0");
+  world->Step(500);
+  EXPECT_EQ(nullptr, world->ModelByName("trisphere_cycle_slip0"));
+
+  auto jc = modelSlip1->GetJointController();
+  jc->SetVelocityTarget(
+      modelSlip1->GetScopedName() + "::wheel_rear_left_spin", 3.0);
+  world->Step(1000);
+
+  expectWheelSlip(modelSlip1, "wheel_rear_left", 32, 1);
+  expectWheelSlip(modelSlip1, "wheel_rear_right", 32, 1);
+  expectWheelSlip(modelSlip1, "wheel_front", 77, 1);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
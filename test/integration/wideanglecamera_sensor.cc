@@ -16,6 +16,8 @@
 */
 #include <mutex>
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include "gazebo/sensors/sensors.hh"
 #include "gazebo/common/Time.hh"
@@ -225,3 +227,46 @@ TEST_F(WideAngleCameraSensor, Projection)
   EXPECT_LT(screenPt.Z(), 1.0);
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST_F(WideAngleCameraSensor, CubeFaces)
+{
+#if not defined(__APPLE__)
+  Load("worlds/usercamera_test.world");
+
+  // Make sure the render engine is available.
+  if (rendering::RenderEngine::Instance()->GetRenderPathType() ==
+      rendering::RenderEngine::NONE)
+  {
+    gzerr << "No rendering engine, unable to run wide angle camera test\n";
+    return;
+  }
+
+  std::string cameraName = "camera_sensor";
+  SpawnWideAngleCamera("camera_model", cameraName,
+      ignition::math::Vector3d::Zero, ignition::math::Vector3d::Zero,
+      320, 240, 10, 6.0);
+  sensors::WideAngleCameraSensorPtr camSensor =
+      std::dynamic_pointer_cast<sensors::WideAngleCameraSensor>(
+      sensors::get_sensor(cameraName));
+  ASSERT_NE(camSensor, nullptr);
+  rendering::WideAngleCameraPtr camera =
+      boost::dynamic_pointer_cast<rendering::WideAngleCamera>(
+      camSensor->Camera());
+  ASSERT_NE(camera, nullptr);
+
+  // Only the faces within the cut off angle are rendered
+  std::vector<std::pair<double, unsigned int>> expected =
+      {{0.5, 1u}, {1.2, 5u}, {IGN_PI, 6u}};
+  for (auto const &cutOff : expected)
+  {
+    camera->Lens()->SetCutOffAngle(cutOff.first);
+    for (int i = 0; i < 100 &&
+         camera->RenderedFaceCount() != cutOff.second; ++i)
+    {
+      common::Time::MSleep(20);
+    }
+    EXPECT_EQ(cutOff.second, camera->RenderedFaceCount());
+  }
+#endif
+}
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 #include "gazebo/test/ServerFixture.hh"
 #include "gazebo/physics/Light.hh"
 #include "gazebo/physics/physics.hh"
@@ -573,6 +577,162 @@ TEST_F(WorldTest, CheckWorldEventsWork)
   worldUpdateEndEventConnection.reset();
 }
 
+/////////////////////////////////////////////////
+TEST_P(WorldTest, StepBatch)
+{
+  const std::string physicsEngine = GetParam();
+  this->Load("worlds/shapes.world", true, physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr sphereModel = world->ModelByName("sphere");
+  ASSERT_TRUE(sphereModel != NULL);
+  sphereModel->SetLinearVel(ignition::math::Vector3d(1, 0, 2));
+
+  physics::WorldSnapshot snapshot;
+  world->SaveSnapshot(snapshot);
+
+  const double dt = world->Physics()->GetMaxStepSize();
+  const uint64_t iterations = world->Iterations();
+
+  EXPECT_EQ(500u, world->StepBatch(500, 100));
+  EXPECT_EQ(iterations + 500, world->Iterations());
+  EXPECT_NEAR((snapshot.SimTime() + 500 * dt).Double(),
+      world->SimTime().Double(), 1e-9);
+  EXPECT_TRUE(world->IsPaused());
+  const ignition::math::Pose3d batchPose = sphereModel->WorldPose();
+
+  // A batch runs the same iterations as Step
+  EXPECT_TRUE(world->RestoreSnapshot(snapshot));
+  world->Step(500);
+  EXPECT_EQ(iterations + 500, world->Iterations());
+  if (physicsEngine == "ode")
+    EXPECT_EQ(batchPose, sphereModel->WorldPose());
+  else
+    EXPECT_NEAR(batchPose.Pos().Distance(sphereModel->WorldPose().Pos()),
+        0, 1e-2);
+
+  // An empty batch doesn't step
+  EXPECT_EQ(0u, world->StepBatch(0));
+  EXPECT_EQ(iterations + 500, world->Iterations());
+}
+
+/////////////////////////////////////////////////
+/// \brief Number of world statistics messages received.
+std::atomic<unsigned int> g_statsCount(0);
+
+/// \brief Count world statistics messages.
+/// \param[in] _msg The message.
+void onWorldStats(ConstWorldStatisticsPtr &/*_msg*/)
+{
+  ++g_statsCount;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, PublishRate)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // Every step publishes by default
+  EXPECT_DOUBLE_EQ(0.0, world->WorldStatsPublishRate());
+  EXPECT_DOUBLE_EQ(0.0, world->PosePublishRate());
+  EXPECT_DOUBLE_EQ(0.0, world->LocalPosePublishRate());
+
+  world->SetWorldStatsPublishRate(10);
+  world->SetPosePublishRate(30);
+  world->SetLocalPosePublishRate(60);
+  EXPECT_NEAR(10.0, world->WorldStatsPublishRate(), 1e-6);
+  EXPECT_NEAR(30.0, world->PosePublishRate(), 1e-6);
+  EXPECT_NEAR(60.0, world->LocalPosePublishRate(), 1e-6);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::SubscriberPtr sub = node->Subscribe("~/world_stats",
+      &onWorldStats);
+
+  // Let the subscription connect
+  for (unsigned int i = 0; i < 50 && g_statsCount == 0; ++i)
+    common::Time::MSleep(100);
+  ASSERT_GT(g_statsCount, 0u);
+
+  // One second of sim time at 1 kHz publishes about 10 messages, plus
+  // about 10 per second of wall time
+  const common::Time start = common::Time::GetWallTime();
+  g_statsCount = 0;
+  world->Step(1000);
+  const double wallElapsed = (common::Time::GetWallTime() - start).Double();
+  common::Time::MSleep(200);
+
+  EXPECT_GT(g_statsCount, 0u);
+  EXPECT_LE(g_statsCount, 10 + 10 * (wallElapsed + 0.2) + 2);
+
+  world->SetWorldStatsPublishRate(0);
+  EXPECT_DOUBLE_EQ(0.0, world->WorldStatsPublishRate());
+}
+
+/////////////////////////////////////////////////
+/// \brief Protects g_sphereHeights.
+std::mutex g_poseMutex;
+
+/// \brief Heights of the sphere received on ~/pose/info.
+std::vector<double> g_sphereHeights;
+
+/// \brief Record the height of the sphere.
+/// \param[in] _msg The poses.
+void onPoseInfo(ConstPosesStampedPtr &_msg)
+{
+  std::lock_guard<std::mutex> lock(g_poseMutex);
+  for (int i = 0; i < _msg->pose_size(); ++i)
+  {
+    if (_msg->pose(i).name() == "sphere")
+      g_sphereHeights.push_back(_msg->pose(i).position().z());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_P(WorldTest, PoseInfoFalling)
+{
+  Load("worlds/blank.world", true, GetParam());
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnSphere("sphere", ignition::math::Vector3d(0, 0, 10),
+      ignition::math::Vector3d::Zero);
+  physics::ModelPtr sphere = world->ModelByName("sphere");
+  ASSERT_TRUE(sphere != NULL);
+
+  transport::NodePtr node(new transport::Node());
+  node->Init("default");
+  transport::SubscriberPtr sub = node->Subscribe("~/pose/info",
+      &onPoseInfo);
+
+  // The poses that physics moves are published while the sphere falls
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    world->Step(50);
+    common::Time::MSleep(50);
+  }
+  EXPECT_LT(sphere->WorldPose().Pos().Z(), 9.0);
+
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(g_poseMutex);
+      if (!g_sphereHeights.empty() && g_sphereHeights.back() < 9.0)
+        break;
+    }
+    common::Time::MSleep(100);
+  }
+
+  std::lock_guard<std::mutex> lock(g_poseMutex);
+  ASSERT_GT(g_sphereHeights.size(), 1u);
+  EXPECT_LT(g_sphereHeights.back(), 9.0);
+  EXPECT_LT(g_sphereHeights.back(), g_sphereHeights.front());
+  g_sphereHeights.clear();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WorldTest, URI)
 {
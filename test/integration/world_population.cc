@@ -160,6 +160,22 @@ void WorldEnvPopulationTest::LoadEnvironment(const std::string &/*_physicsEng*/)
       EXPECT_NEAR(model->WorldPose().Pos().Y(), 0, tolerance);
     }
   }
+
+  // Objects distributed uniformly keep a minimum spacing.
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = i + 1; j < 10; ++j)
+    {
+      physics::ModelPtr first = world->ModelByName(
+          "can4_clone_" + std::to_string(i));
+      physics::ModelPtr second = world->ModelByName(
+          "can4_clone_" + std::to_string(j));
+      ASSERT_TRUE(first != NULL);
+      ASSERT_TRUE(second != NULL);
+      EXPECT_GT(first->WorldPose().Pos().Distance(
+          second->WorldPose().Pos()), 0.3);
+    }
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <vector>
+
+#include "gazebo/physics/physics.hh"
+#include "gazebo/test/ServerFixture.hh"
+#include "gazebo/test/helper_physics_generator.hh"
+
+using namespace gazebo;
+class WorldSnapshotTest : public ServerFixture,
+                          public testing::WithParamInterface<const char*>
+{
+  /// \brief Step a world and record the pose of its links.
+  /// \param[in] _world The world.
+  /// \param[in] _steps Number of steps.
+  /// \return Pose of each link after each step.
+  public: std::vector<ignition::math::Pose3d> Record(
+              physics::WorldPtr _world, const unsigned int _steps);
+};
+
+/////////////////////////////////////////////////
+std::vector<ignition::math::Pose3d> WorldSnapshotTest::Record(
+    physics::WorldPtr _world, const unsigned int _steps)
+{
+  std::vector<ignition::math::Pose3d> poses;
+  for (unsigned int i = 0; i < _steps; ++i)
+  {
+    _world->Step(1);
+    for (auto const &model : _world->Models())
+    {
+      for (auto const &link : model->GetLinks())
+        poses.push_back(link->WorldPose());
+    }
+  }
+  return poses;
+}
+
+/////////////////////////////////////////////////
+// Restoring a snapshot continues the simulation from the saved state
+TEST_P(WorldSnapshotTest, Continuation)
+{
+  const std::string physicsEngine = GetParam();
+  this->Load("test/worlds/snapshot.world", true, physicsEngine);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_NE(nullptr, world);
+
+  physics::ModelPtr arm = world->ModelByName("arm");
+  ASSERT_NE(nullptr, arm);
+  physics::JointControllerPtr controller = arm->GetJointController();
+  controller->SetPositionPID("arm::hinge", common::PID(50, 1, 1));
+  controller->SetPositionTarget("arm::hinge", 0.5);
+
+  // An empty snapshot can't be restored
+  physics::WorldSnapshot snapshot;
+  EXPECT_FALSE(snapshot.Valid());
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+
+  // Save a state while the box bounces on the ground
+  world->Step(300);
+  world->SaveSnapshot(snapshot);
+  EXPECT_TRUE(snapshot.Valid());
+  EXPECT_EQ(world->SimTime(), snapshot.SimTime());
+  EXPECT_EQ(world->Iterations(), snapshot.Iterations());
+  EXPECT_GT(snapshot.Size(), 0u);
+
+  const std::vector<ignition::math::Pose3d> first = this->Record(world, 500);
+
+  // Change the target, which the snapshot restores too
+  controller->SetPositionTarget("arm::hinge", -0.5);
+  world->Step(100);
+
+  EXPECT_TRUE(world->RestoreSnapshot(snapshot));
+  EXPECT_EQ(snapshot.SimTime(), world->SimTime());
+  EXPECT_EQ(snapshot.Iterations(), world->Iterations());
+  EXPECT_DOUBLE_EQ(0.5, controller->GetPositions()["arm::hinge"]);
+
+  const std::vector<ignition::math::Pose3d> second =
+      this->Record(world, 500);
+  ASSERT_EQ(first.size(), second.size());
+
+  // ODE continues bit for bit, other engines only restore the links
+  for (unsigned int i = 0; i < first.size(); ++i)
+  {
+    if (physicsEngine == "ode")
+    {
+      EXPECT_EQ(first[i], second[i]) << i;
+    }
+    else
+    {
+      EXPECT_NEAR(first[i].Pos().Distance(second[i].Pos()), 0, 1e-2) << i;
+    }
+  }
+
+  // A copy of the snapshot restores the same state
+  physics::WorldSnapshot copy(snapshot);
+  EXPECT_TRUE(world->RestoreSnapshot(copy));
+  EXPECT_EQ(snapshot.Iterations(), world->Iterations());
+
+  // A snapshot doesn't match a world whose models changed
+  world->RemoveModel("box");
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+}
+
+INSTANTIATE_TEST_CASE_P(PhysicsEngines, WorldSnapshotTest,
+                        PHYSICS_ENGINE_VALUES,);  // NOLINT
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
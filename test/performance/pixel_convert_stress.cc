@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gazebo/common/PixelConvert.hh"
+
+using namespace gazebo;
+
+/// \brief Pixels in a full HD frame.
+static const std::size_t kPixels = 1920 * 1080;
+
+/// \brief Number of frames converted per measure.
+static const int kIterations = 100;
+
+/////////////////////////////////////////////////
+/// \brief Time a conversion.
+/// \param[in] _name Name printed with the time.
+/// \param[in] _func Conversion of a frame.
+/// \return Average time of a frame in milliseconds.
+static double measure(const std::string &_name,
+    const std::function<void()> &_func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kIterations; ++i)
+    _func();
+  const double ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count() / kIterations;
+  std::cout << _name << ": " << ms << " ms per frame ("
+            << common::PixelConvertPath() << ")" << std::endl;
+  return ms;
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConvertStressTest, SwapRedBlue)
+{
+  std::vector<unsigned char> src(kPixels * 3);
+  for (std::size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<unsigned char>(i);
+  std::vector<unsigned char> loop(src.size());
+  std::vector<unsigned char> vec(src.size());
+
+  measure("RGB to BGR loop", [&]()
+  {
+    for (std::size_t i = 0; i < kPixels; ++i)
+    {
+      loop[i * 3] = src[i * 3 + 2];
+      loop[i * 3 + 1] = src[i * 3 + 1];
+      loop[i * 3 + 2] = src[i * 3];
+    }
+  });
+  measure("RGB to BGR", [&]()
+  {
+    common::SwapRedBlue(src.data(), vec.data(), kPixels);
+  });
+  EXPECT_EQ(loop, vec);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConvertStressTest, RGBAToRGB)
+{
+  std::vector<unsigned char> src(kPixels * 4);
+  for (std::size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<unsigned char>(i);
+  std::vector<unsigned char> loop(kPixels * 3);
+  std::vector<unsigned char> vec(kPixels * 3);
+
+  measure("RGBA to RGB loop", [&]()
+  {
+    for (std::size_t i = 0; i < kPixels; ++i)
+    {
+      loop[i * 3] = src[i * 4];
+      loop[i * 3 + 1] = src[i * 4 + 1];
+      loop[i * 3 + 2] = src[i * 4 + 2];
+    }
+  });
+  measure("RGBA to RGB", [&]()
+  {
+    common::RGBAToRGB(src.data(), vec.data(), kPixels);
+  });
+  EXPECT_EQ(loop, vec);
+}
+
+/////////////////////////////////////////////////
+TEST(PixelConvertStressTest, Depth)
+{
+  std::vector<float> src(kPixels);
+  for (std::size_t i = 0; i < src.size(); ++i)
+    src[i] = static_cast<float>(i % 10000) * 0.001f;
+  std::vector<float> clamped(src);
+  std::vector<uint16_t> depth(kPixels);
+
+  measure("Depth clamp", [&]()
+  {
+    common::ClampDepth(clamped.data(), kPixels, 0.1f, 9.0f);
+  });
+  measure("Depth to 16 bit", [&]()
+  {
+    common::DepthToUInt16(src.data(), depth.data(), kPixels, 1000.0f);
+  });
+  EXPECT_EQ(depth[1234], 1234);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
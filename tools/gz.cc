@@ -15,6 +15,9 @@
  *
 */
 #include <stdio.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 #include <signal.h>
 #include <tinyxml.h>
 #include <boost/filesystem.hpp>
@@ -26,6 +29,7 @@
 #include <sdf/sdf.hh>
 #include "gz_log.hh"
 #include "gz_marker.hh"
+#include "gz_shader_cache.hh"
 #include "gz_topic.hh"
 #include "gz.hh"
 
@@ -216,7 +220,11 @@ WorldCommand::WorldCommand()
      "Step simulation mulitple iteration.")
     ("reset-all,r", "Reset time and model poses")
     ("reset-time,t", "Reset time")
-    ("reset-models,o", "Reset models");
+    ("reset-models,o", "Reset models")
+    ("profile", po::value<uint32_t>(), "Profile a number of iterations, "
+     "and write a Chrome trace on the server.")
+    ("profile-file", po::value<std::string>(), "Path of the trace on the "
+     "server, defaults to the log directory. Applicable with profile");
 }
 
 /////////////////////////////////////////////////
@@ -283,6 +291,22 @@ bool WorldCommand::RunImpl()
     good = true;
   }
 
+  if (this->vm.count("profile"))
+  {
+    transport::PublisherPtr profilePub =
+      node->Advertise<msgs::ProfileControl>("~/profile");
+    profilePub->WaitForConnection();
+
+    msgs::ProfileControl profileMsg;
+    profileMsg.set_iterations(this->vm["profile"].as<uint32_t>());
+    if (this->vm.count("profile-file"))
+      profileMsg.set_filename(this->vm["profile-file"].as<std::string>());
+    profilePub->Publish(profileMsg, true);
+
+    if (!good)
+      return true;
+  }
+
   if (good)
     pub->Publish(msg, true);
   else
@@ -900,7 +924,10 @@ StatsCommand::StatsCommand()
     ("world-name,w", po::value<std::string>(), "World name.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run.")
     ("plot,p", "Output comma-separated values, useful for processing and "
-     "plotting.");
+     "plotting.")
+    ("memory,m", "Print the memory accounts of the server instead.")
+    ("steps,s", "Print the step telemetry of the world instead.")
+    ("plugins,c", "Print the update cost of the plugins instead.");
 }
 
 /////////////////////////////////////////////////
@@ -909,7 +936,13 @@ void StatsCommand::HelpDetailed()
   std::cerr <<
     "\tPrint gzserver statics to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
-    "\tthe Gazebo master will be used.\n"
+    "\tthe Gazebo master will be used. With option -m, the memory used\n"
+    "\tby each subsystem of the server is printed once per second.\n"
+    "\tWith option -s, the wall time of the steps and of their phases,\n"
+    "\tthe steps that missed the update period and the longest steps\n"
+    "\tare printed once per second. With option -c, the plugins that\n"
+    "\tspend the most wall time in their event callbacks are printed\n"
+    "\tonce per second, with their share of the wall time.\n"
     << std::endl;
 }
 
@@ -924,8 +957,18 @@ bool StatsCommand::RunImpl()
   transport::NodePtr node(new transport::Node());
   node->Init(worldName);
 
-  transport::SubscriberPtr sub =
-    node->Subscribe("~/world_stats", &StatsCommand::CB, this);
+  transport::SubscriberPtr sub;
+  if (this->vm.count("memory"))
+    sub = node->Subscribe("/gazebo/memory", &StatsCommand::OnMemory, this);
+  else if (this->vm.count("steps"))
+    sub = node->Subscribe("~/step_stats", &StatsCommand::OnSteps, this);
+  else if (this->vm.count("plugins"))
+  {
+    sub = node->Subscribe("/gazebo/plugin_costs",
+        &StatsCommand::OnPluginCosts, this);
+  }
+  else
+    sub = node->Subscribe("~/world_stats", &StatsCommand::CB, this);
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
@@ -1002,6 +1045,168 @@ void StatsCommand::CB(ConstWorldStatisticsPtr &_msg)
         percent, simTime.Double(), realTime.Double(), paused);
 }
 
+/////////////////////////////////////////////////
+void StatsCommand::OnMemory(ConstMemoryStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const double wallTime = msgs::Convert(_msg->stamp()).Double();
+  for (auto const &account : _msg->account())
+  {
+    if (this->vm.count("plot"))
+    {
+      printf("%16.6f, %s, %" PRId64 ", %" PRId64 ", %" PRId64 "\n",
+          wallTime, account.name().c_str(),
+          static_cast<int64_t>(account.bytes()),
+          static_cast<int64_t>(account.objects()),
+          static_cast<int64_t>(account.peak_bytes()));
+    }
+    else
+    {
+      printf("%-32s Bytes[%" PRId64 "] Objects[%" PRId64 "] Peak[%" PRId64
+          "]\n", account.name().c_str(),
+          static_cast<int64_t>(account.bytes()),
+          static_cast<int64_t>(account.objects()),
+          static_cast<int64_t>(account.peak_bytes()));
+    }
+  }
+  if (!this->vm.count("plot"))
+    printf("\n");
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get a percentile of a step telemetry histogram.
+/// \param[in] _phase The phase.
+/// \param[in] _q The percentile, from 0 to 1.
+/// \return Upper bound of the bin of the percentile in seconds, at most
+/// the longest duration.
+static double stepPercentile(const msgs::StepStatistics::Phase &_phase,
+    const double _q)
+{
+  const double target = _q * _phase.count();
+  uint64_t count = 0;
+  for (int i = 0; i < _phase.histogram_size(); ++i)
+  {
+    count += _phase.histogram(i);
+    if (count > 0 && count >= target)
+      return std::min(_phase.max(), std::ldexp(1e-6, i));
+  }
+  return _phase.max();
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::OnSteps(ConstStepStatisticsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  const double wallTime = msgs::Convert(_msg->stamp()).Double();
+  if (this->vm.count("plot"))
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# walltime (sec), phase, count, mean (ms), p50 (ms), "
+        << "p99 (ms), max (ms), deadline misses\n";
+      first = false;
+    }
+    for (auto const &phase : _msg->phase())
+    {
+      printf("%16.6f, %s, %" PRIu64 ", %.4f, %.4f, %.4f, %.4f, %" PRIu64
+          "\n", wallTime, phase.name().c_str(),
+          static_cast<uint64_t>(phase.count()), phase.mean() * 1e3,
+          stepPercentile(phase, 0.5) * 1e3, stepPercentile(phase, 0.99) * 1e3,
+          phase.max() * 1e3, static_cast<uint64_t>(_msg->deadline_misses()));
+    }
+    fflush(stdout);
+    return;
+  }
+
+  printf("Window[%4.2f s] Period[%.3f ms] Misses[%" PRIu64 "] TotalMisses[%"
+      PRIu64 "]\n", _msg->window(), _msg->period() * 1e3,
+      static_cast<uint64_t>(_msg->deadline_misses()),
+      static_cast<uint64_t>(_msg->total_deadline_misses()));
+  printf("  %-12s %8s %10s %10s %10s %10s\n", "phase", "count", "mean ms",
+      "p50 ms", "p99 ms", "max ms");
+  for (auto const &phase : _msg->phase())
+  {
+    printf("  %-12s %8" PRIu64 " %10.4f %10.4f %10.4f %10.4f\n",
+        phase.name().c_str(), static_cast<uint64_t>(phase.count()),
+        phase.mean() * 1e3, stepPercentile(phase, 0.5) * 1e3,
+        stepPercentile(phase, 0.99) * 1e3, phase.max() * 1e3);
+  }
+  for (auto const &step : _msg->worst())
+  {
+    printf("  Worst: iteration %" PRIu64 " %.4f ms, %s %.4f ms\n",
+        static_cast<uint64_t>(step.iteration()),
+        step.duration() * 1e3, step.phase().c_str(),
+        step.phase_duration() * 1e3);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+/////////////////////////////////////////////////
+void StatsCommand::OnPluginCosts(ConstPluginCostsPtr &_msg)
+{
+  GZ_ASSERT(_msg, "Invalid message received");
+
+  // The share of the wall time since the previous message.
+  const common::Time stamp = msgs::Convert(_msg->stamp());
+  const double elapsed = (stamp - this->prevPluginCostsStamp).Double();
+  const bool hasPrev = this->prevPluginCostsStamp != common::Time::Zero;
+  this->prevPluginCostsStamp = stamp;
+
+  const bool plot = this->vm.count("plot") > 0;
+  if (plot)
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "# walltime (sec), plugin, filename, calls, mean (us), "
+        << "max (ms), load (ms), share (percent)\n";
+      first = false;
+    }
+  }
+  else
+  {
+    printf("%-40s %-28s %10s %10s %10s %10s %8s\n", "plugin", "filename",
+        "calls", "mean us", "max ms", "load ms", "share %");
+  }
+
+  for (auto const &plugin : _msg->plugin())
+  {
+    double share = 0;
+    auto prev = this->prevPluginCosts.find(plugin.name());
+    if (hasPrev && elapsed > 0 && prev != this->prevPluginCosts.end())
+    {
+      share = std::max(0.0, plugin.update_time() - prev->second) /
+          elapsed * 100.0;
+    }
+    this->prevPluginCosts[plugin.name()] = plugin.update_time();
+
+    const double mean = plugin.calls() > 0 ?
+        plugin.update_time() / plugin.calls() : 0;
+    if (plot)
+    {
+      printf("%16.6f, %s, %s, %" PRIu64 ", %.3f, %.4f, %.4f, %.2f\n",
+          stamp.Double(), plugin.name().c_str(), plugin.filename().c_str(),
+          static_cast<uint64_t>(plugin.calls()), mean * 1e6,
+          plugin.max_time() * 1e3, plugin.load_time() * 1e3, share);
+    }
+    else
+    {
+      printf("%-40s %-28s %10" PRIu64 " %10.3f %10.4f %10.4f %8.2f\n",
+          plugin.name().c_str(), plugin.filename().c_str(),
+          static_cast<uint64_t>(plugin.calls()), mean * 1e6,
+          plugin.max_time() * 1e3, plugin.load_time() * 1e3, share);
+    }
+  }
+  if (!plot)
+    printf("\n");
+  fflush(stdout);
+}
+
 /////////////////////////////////////////////////
 SDFCommand::SDFCommand()
   : Command("sdf",
@@ -1311,6 +1516,7 @@ int main(int argc, char **argv)
   g_commandMap["topic"] = new TopicCommand();
   g_commandMap["log"] = new LogCommand();
   g_commandMap["sdf"] = new SDFCommand();
+  g_commandMap["shader-cache"] = new ShaderCacheCommand();
   g_commandMap["debug"] = new DebugCommand();
 
   // Get the command name
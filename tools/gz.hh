@@ -19,6 +19,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <boost/thread.hpp>
 #include <boost/program_options.hpp>
 #include <ignition/math/Pose3.hh>
@@ -195,6 +196,25 @@ namespace gazebo
     /// \param[in] _msg World statistics message.
     private: void CB(ConstWorldStatisticsPtr &_msg);
 
+    /// \brief Memory accounts callback.
+    /// \param[in] _msg Memory statistics message.
+    private: void OnMemory(ConstMemoryStatisticsPtr &_msg);
+
+    /// \brief Step telemetry callback.
+    /// \param[in] _msg Step statistics message.
+    private: void OnSteps(ConstStepStatisticsPtr &_msg);
+
+    /// \brief Plugin costs callback.
+    /// \param[in] _msg Plugin costs message.
+    private: void OnPluginCosts(ConstPluginCostsPtr &_msg);
+
+    /// \brief Update time of each plugin in the previous plugin costs
+    /// message, in seconds.
+    private: std::map<std::string, double> prevPluginCosts;
+
+    /// \brief Stamp of the previous plugin costs message.
+    private: common::Time prevPluginCostsStamp;
+
     /// \brief Sim time buffer
     private: std::list<common::Time> simTimes;
 
@@ -14,6 +14,10 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
@@ -22,11 +26,15 @@
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/copy.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 
 #include <gazebo/util/util.hh>
 #include "gz_log.hh"
+#include "gz_log_query.hh"
 
 sdf::ElementPtr g_stateSdf;
 
@@ -622,7 +630,11 @@ LogCommand::LogCommand()
      "Valid in conjunction with the output command. See also the "
      "--output argument.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only with the echo, step, and output commands");
+     "Filter output. Valid only with the echo, step, and output commands")
+    ("format", po::value<std::string>(),
+     "Output the values selected by the filter as csv or binary records, "
+     "without parsing the states as SDF. Valid with the echo and output "
+     "commands.");
 }
 
 /////////////////////////////////////////////////
@@ -692,7 +704,14 @@ bool LogCommand::RunImpl()
   g_stateSdf.reset(new sdf::Element);
   sdf::initFile("state.sdf", g_stateSdf);
 
-  if (this->vm.count("output"))
+  if (this->vm.count("format") &&
+      (this->vm.count("output") || this->vm.count("echo")))
+  {
+    return this->Query(filter, this->vm["format"].as<std::string>(), stamp,
+        hz, this->vm.count("output") ?
+        this->vm["output"].as<std::string>() : "");
+  }
+  else if (this->vm.count("output"))
   {
     std::string encoding = this->vm.count("encoding") ?
       this->vm["encoding"].as<std::string>() : "";
@@ -932,6 +951,71 @@ void LogCommand::Echo(const std::string &_filter, bool _raw,
     std::cout << "</gazebo_log>\n";
 }
 
+/////////////////////////////////////////////////
+bool LogCommand::Query(const std::string &_filter,
+    const std::string &_format, const std::string &_stamp, const double _hz,
+    const std::string &_outFilename)
+{
+  if (_format != "csv" && _format != "binary")
+  {
+    std::cerr << "Invalid format[" << _format << "]. "
+      << "Use one of: csv, binary.\n";
+    return false;
+  }
+
+  LogQuery query(_format == "csv" ? LogQuery::CSV : LogQuery::BINARY,
+      _stamp, _hz);
+  if (!query.Init(_filter))
+    return false;
+
+  std::ofstream outFile;
+  if (!_outFilename.empty())
+  {
+    outFile.open(_outFilename, std::fstream::out | std::ios::binary);
+    if (!outFile.is_open())
+    {
+      std::cerr << "Unable to open file[" << _outFilename
+        << "] for writing.\n";
+      return false;
+    }
+  }
+  std::ostream &out = _outFilename.empty() ? std::cout : outFile;
+
+  query.WriteHeader(out);
+
+  // Chunks are decoded in order by LogPlay, which isn't thread safe, and
+  // scanned in parallel by batches.
+  const unsigned int batchSize = 256;
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+  std::vector<std::string> chunks(batchSize);
+  std::vector<std::vector<LogQuery::Result>> results(batchSize);
+  for (unsigned int start = 0; start < play->ChunkCount(); start += batchSize)
+  {
+    const unsigned int count = std::min(batchSize,
+        play->ChunkCount() - start);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      if (!play->Chunk(start + i, chunks[i]))
+        chunks[i].clear();
+    }
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, count, 1),
+        [&](const tbb::blocked_range<unsigned int> &_r)
+    {
+      for (unsigned int i = _r.begin(); i != _r.end(); ++i)
+      {
+        results[i].clear();
+        query.Scan(chunks[i], results[i]);
+      }
+    });
+
+    for (unsigned int i = 0; i < count; ++i)
+      query.Write(results[i], out);
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Step(const std::string &_filter, bool _raw,
     const std::string &_stamp, double _hz)
@@ -231,6 +231,19 @@ namespace gazebo
     private: void Echo(const std::string &_filter,
                  bool _raw, const std::string &_stamp, double _hz);
 
+    /// \brief Extract the values selected by a filter with LogQuery, which
+    /// scans the chunks of the log file in parallel.
+    /// \param[in] _filter Filter string
+    /// \param[in] _format Output format: csv or binary.
+    /// \param[in] _stamp Type of stamp to apply.
+    /// Valid values are (sim,real,wall,iterations)
+    /// \param[in] _hz Hertz rate.
+    /// \param[in] _outFilename Output file, empty for the standard output.
+    /// \return False if the format, filter or output file is invalid.
+    private: bool Query(const std::string &_filter,
+                 const std::string &_format, const std::string &_stamp,
+                 const double _hz, const std::string &_outFilename);
+
     /// \brief Step through a log file.
     /// \param[in] _filter Filter string
     /// \param[in] _raw True to output data without xml formatting.
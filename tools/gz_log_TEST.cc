@@ -331,6 +331,37 @@ TEST(gz_log, RawFilterStamp)
   EXPECT_EQ(validEcho, echo);
 }
 
+/////////////////////////////////////////////////
+/// Check the values extracted with 'gz log -e --format csv'
+TEST(gz_log, EchoFormat)
+{
+  std::string echo, validEcho;
+
+  echo = custom_exec(std::string(GZ_LOG_PATH +
+        " -e --format csv --filter pr2.pose.[x,z] -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  validEcho = "sim,name,field,values\n"
+    "0.021343973,pr2,pose,0,-8e-06\n"
+    "0.028958235,pr2,pose,0,-1.5e-05\n";
+  EXPECT_EQ(validEcho, echo);
+
+  echo = custom_exec(std::string(GZ_LOG_PATH +
+        " -e --format csv --stamp real -z 1.0"
+        " --filter pr2//r_upper_arm_roll_joint -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  validEcho = "real,name,field,values\n"
+    "0.001000000,pr2::r_upper_arm_roll_joint,angle,-1.0234e-05\n";
+  EXPECT_EQ(validEcho, echo);
+
+  echo = custom_exec(std::string(GZ_LOG_PATH +
+        " -e --format csv --filter pr2/base_footprint.velocity.z -f ") +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  validEcho = "sim,name,field,values\n"
+    "0.021343973,pr2::base_footprint,velocity,-0.007966\n"
+    "0.028958235,pr2::base_footprint,velocity,-0.007403\n";
+  EXPECT_EQ(validEcho, echo);
+}
+
 /////////////////////////////////////////////////
 /// Check to make sure that 'gz log -s' returns correct information
 TEST(gz_log, Step)
@@ -0,0 +1,639 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <list>
+
+#include <boost/algorithm/string.hpp>
+
+#include "gz_log_query.hh"
+
+using namespace gazebo;
+
+/// \brief Version of the binary output.
+static const uint32_t kBinaryVersion = 1;
+
+/// \brief Names of the fields, indexed by LogQuery::Field.
+static const char *kFieldNames[] =
+{
+  "pose", "velocity", "acceleration", "wrench", "angle"
+};
+
+/////////////////////////////////////////////////
+/// \brief Check for XML whitespace.
+/// \param[in] _c Character to check.
+/// \return True if _c is whitespace.
+static inline bool isSpace(const char _c)
+{
+  return _c == ' ' || _c == '\n' || _c == '\t' || _c == '\r';
+}
+
+/////////////////////////////////////////////////
+/// \brief A tag found by XmlCursor.
+class XmlTag
+{
+  /// \brief Check the name of the tag.
+  /// \param[in] _name Name to compare.
+  /// \return True if the tag has this name.
+  public: bool Is(const char *_name) const
+  {
+    return std::strlen(_name) == this->nameLen &&
+      std::strncmp(this->name, _name, this->nameLen) == 0;
+  }
+
+  /// \brief Get the value of an attribute.
+  /// \param[in] _name Name of the attribute.
+  /// \param[out] _value Value of the attribute.
+  /// \return True if the attribute was found.
+  public: bool Attribute(const char *_name, std::string &_value) const
+  {
+    const std::size_t len = std::strlen(_name);
+    const char *p = this->attrs;
+    while (p < this->attrsEnd)
+    {
+      while (p < this->attrsEnd && isSpace(*p))
+        ++p;
+      const char *key = p;
+      while (p < this->attrsEnd && *p != '=' && !isSpace(*p))
+        ++p;
+      const std::size_t keyLen = p - key;
+      while (p < this->attrsEnd && *p != '\'' && *p != '"')
+        ++p;
+      if (p >= this->attrsEnd)
+        return false;
+
+      const char quote = *p++;
+      const char *value = p;
+      while (p < this->attrsEnd && *p != quote)
+        ++p;
+      if (keyLen == len && std::strncmp(key, _name, len) == 0)
+      {
+        _value.assign(value, p);
+        return true;
+      }
+      ++p;
+    }
+    return false;
+  }
+
+  /// \brief Start of the name.
+  public: const char *name = nullptr;
+
+  /// \brief Length of the name.
+  public: std::size_t nameLen = 0;
+
+  /// \brief Start of the attributes.
+  public: const char *attrs = nullptr;
+
+  /// \brief End of the attributes.
+  public: const char *attrsEnd = nullptr;
+
+  /// \brief True for an end tag.
+  public: bool closing = false;
+
+  /// \brief True for a tag that closes itself.
+  public: bool empty = false;
+};
+
+/////////////////////////////////////////////////
+/// \brief Pull parser that walks the tags of an XML string without
+/// building nodes. Comments, processing instructions and CDATA are
+/// skipped, and entities aren't expanded, which state values don't use.
+class XmlCursor
+{
+  /// \brief Constructor
+  /// \param[in] _xml XML to walk, which must outlive the cursor.
+  public: explicit XmlCursor(const std::string &_xml)
+    : pos(_xml.data()), end(_xml.data() + _xml.size())
+  {
+  }
+
+  /// \brief Move to the next tag.
+  /// \param[out] _tag The tag.
+  /// \return False at the end of the string.
+  public: bool Next(XmlTag &_tag)
+  {
+    while (true)
+    {
+      this->pos = static_cast<const char *>(
+          std::memchr(this->pos, '<', this->end - this->pos));
+      if (!this->pos || this->pos + 1 >= this->end)
+      {
+        this->pos = this->end;
+        return false;
+      }
+
+      ++this->pos;
+      if (*this->pos == '?')
+        this->SkipPast("?>");
+      else if (this->Starts("!--"))
+        this->SkipPast("-->");
+      else if (this->Starts("![CDATA["))
+        this->SkipPast("]]>");
+      else if (*this->pos == '!')
+        this->SkipPast(">");
+      else
+        break;
+    }
+
+    _tag.closing = *this->pos == '/';
+    if (_tag.closing)
+      ++this->pos;
+
+    _tag.name = this->pos;
+    while (this->pos < this->end && *this->pos != '>' && *this->pos != '/' &&
+        !isSpace(*this->pos))
+    {
+      ++this->pos;
+    }
+    _tag.nameLen = this->pos - _tag.name;
+
+    // Find the end of the tag, ignoring '>' in quoted values
+    _tag.attrs = this->pos;
+    char quote = '\0';
+    while (this->pos < this->end && (quote || *this->pos != '>'))
+    {
+      if (quote && *this->pos == quote)
+        quote = '\0';
+      else if (!quote && (*this->pos == '\'' || *this->pos == '"'))
+        quote = *this->pos;
+      ++this->pos;
+    }
+    _tag.attrsEnd = this->pos;
+    _tag.empty = this->pos > _tag.attrs && this->pos[-1] == '/';
+    if (_tag.empty)
+      --_tag.attrsEnd;
+    if (this->pos < this->end)
+      ++this->pos;
+    return true;
+  }
+
+  /// \brief Split the text that follows the current tag on whitespace.
+  /// \param[out] _tokens Words of the text.
+  public: void Words(std::vector<LogQuery::Token> &_tokens)
+  {
+    _tokens.clear();
+    const char *p = this->pos;
+    while (p < this->end && *p != '<')
+    {
+      while (p < this->end && isSpace(*p))
+        ++p;
+      const char *start = p;
+      while (p < this->end && *p != '<' && !isSpace(*p))
+        ++p;
+      if (p > start)
+        _tokens.push_back(LogQuery::Token(start, p));
+    }
+    this->pos = p;
+  }
+
+  /// \brief Move past the end of an element.
+  /// \param[in] _tag Start tag of the element, the last one returned.
+  public: void Skip(const XmlTag &_tag)
+  {
+    if (_tag.closing || _tag.empty)
+      return;
+
+    int depth = 1;
+    XmlTag tag;
+    while (depth > 0 && this->Next(tag))
+    {
+      if (tag.closing)
+        --depth;
+      else if (!tag.empty)
+        ++depth;
+    }
+  }
+
+  /// \brief Check whether the string continues with a prefix.
+  /// \param[in] _prefix The prefix.
+  /// \return True if it does.
+  private: bool Starts(const char *_prefix) const
+  {
+    const std::size_t len = std::strlen(_prefix);
+    return static_cast<std::size_t>(this->end - this->pos) >= len &&
+      std::strncmp(this->pos, _prefix, len) == 0;
+  }
+
+  /// \brief Move past a marker, or to the end.
+  /// \param[in] _marker The marker.
+  private: void SkipPast(const char *_marker)
+  {
+    const std::size_t len = std::strlen(_marker);
+    while (this->pos < this->end && !this->Starts(_marker))
+      ++this->pos;
+    if (this->pos < this->end)
+      this->pos += len;
+  }
+
+  /// \brief Current position.
+  private: const char *pos;
+
+  /// \brief End of the string.
+  private: const char *end;
+};
+
+/////////////////////////////////////////////////
+/// \brief Values found in a state, formatted once the time is known.
+class PendingRecord
+{
+  /// \brief Name of the entity.
+  public: std::string name;
+
+  /// \brief Field of the values.
+  public: LogQuery::Field field;
+
+  /// \brief Values of the field.
+  public: std::vector<LogQuery::Token> values;
+
+  /// \brief Values to output.
+  public: const LogQuery::Selection *selection;
+};
+
+/////////////////////////////////////////////////
+/// \brief Convert a time element of a state to text and seconds.
+/// \param[in] _words "sec nsec", or an iteration count.
+/// \param[out] _text Time as text.
+/// \return Time in seconds.
+static double formatTime(const std::vector<LogQuery::Token> &_words,
+    std::string &_text)
+{
+  if (_words.empty())
+  {
+    _text = "0";
+    return 0;
+  }
+
+  const int64_t sec = std::strtoll(_words[0].first, nullptr, 10);
+  if (_words.size() < 2)
+  {
+    _text.assign(_words[0].first, _words[0].second);
+    return static_cast<double>(sec);
+  }
+
+  const int64_t nsec = std::strtoll(_words[1].first, nullptr, 10);
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%" PRId64 ".%09" PRId64, sec, nsec);
+  _text = buffer;
+  return sec + nsec * 1e-9;
+}
+
+/////////////////////////////////////////////////
+LogQuery::LogQuery(const Format _format, const std::string &_stamp,
+    const double _hz)
+  : format(_format), stamp(_stamp.empty() ? "sim" : _stamp), hz(_hz)
+{
+}
+
+/////////////////////////////////////////////////
+boost::regex LogQuery::Pattern(const std::string &_pattern)
+{
+  std::string regexStr = _pattern.empty() ? "*" : _pattern;
+  boost::replace_all(regexStr, "*", ".*");
+  return boost::regex(regexStr);
+}
+
+/////////////////////////////////////////////////
+bool LogQuery::ParseList(std::string _list, const bool _pose,
+    Selection &_selection)
+{
+  _selection.enabled = true;
+  _selection.indices.clear();
+
+  boost::erase_all(_list, "[");
+  boost::erase_all(_list, "]");
+  if (_list.empty())
+    return true;
+
+  std::list<std::string> elements;
+  boost::split(elements, _list, boost::is_any_of(","));
+  for (auto const &element : elements)
+  {
+    if (element.empty())
+      continue;
+
+    if (!_pose)
+    {
+      char *end = nullptr;
+      const uint64_t axis = std::strtoull(element.c_str(), &end, 10);
+      if (*end != '\0')
+      {
+        std::cerr << "Invalid axis value[" << element << "]\n";
+        return false;
+      }
+      _selection.indices.push_back(static_cast<unsigned int>(axis));
+      continue;
+    }
+
+    const char *names = "xyzrpa";
+    const char *found = std::strchr(names,
+        std::tolower(static_cast<unsigned char>(element[0])));
+    if (!found)
+    {
+      std::cerr << "Invalid pose value[" << element << "]\n";
+      return false;
+    }
+    _selection.indices.push_back(static_cast<unsigned int>(found - names));
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogQuery::Init(const std::string &_filter)
+{
+  std::vector<std::string> mainParts;
+  boost::split(mainParts, _filter, boost::is_any_of("/"));
+
+  // Model part: name[.pose[.elements]]
+  std::vector<std::string> parts;
+  boost::split(parts, mainParts[0], boost::is_any_of("."));
+  this->modelRegex = Pattern(parts[0]);
+  if (parts.size() > 1)
+  {
+    if (parts[1] != "pose")
+    {
+      std::cerr << "Invalid model state component[" << parts[1] << "]\n";
+      return false;
+    }
+    if (!ParseList(parts.size() > 2 ? parts[2] : "", true, this->modelPose))
+      return false;
+  }
+  else if (mainParts.size() == 1)
+    this->modelPose.enabled = true;
+
+  // Link part: name[.field[.elements]]
+  if (mainParts.size() > 1 && !mainParts[1].empty())
+  {
+    boost::split(parts, mainParts[1], boost::is_any_of("."));
+    this->links = true;
+    this->linkRegex = Pattern(parts[0]);
+    bool found = parts.size() == 1;
+    for (int i = POSE; i <= WRENCH; ++i)
+    {
+      if (parts.size() == 1)
+        this->linkFields[i].enabled = true;
+      else if (parts[1] == kFieldNames[i])
+      {
+        found = true;
+        if (!ParseList(parts.size() > 2 ? parts[2] : "", true,
+              this->linkFields[i]))
+        {
+          return false;
+        }
+      }
+    }
+
+    if (!found)
+    {
+      std::cerr << "Invalid link state component[" << parts[1] << "]\n";
+      return false;
+    }
+  }
+
+  // Joint part: name[.axes]
+  if (mainParts.size() > 2 && !mainParts[2].empty())
+  {
+    boost::split(parts, mainParts[2], boost::is_any_of("."));
+    this->joints = true;
+    this->jointRegex = Pattern(parts[0]);
+    if (!ParseList(parts.size() > 1 ? parts[1] : "", false, this->jointAxes))
+      return false;
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+void LogQuery::Scan(const std::string &_chunk,
+    std::vector<Result> &_results) const
+{
+  XmlCursor cursor(_chunk);
+  XmlTag tag;
+  std::string name;
+  std::vector<Token> words;
+  std::vector<PendingRecord> pending;
+  const std::string stampTag =
+    this->stamp == "iterations" ? this->stamp : this->stamp + "_time";
+
+  while (cursor.Next(tag))
+  {
+    // States are children of <sdf>. Anything else, such as the world of
+    // the first chunk, is skipped.
+    if (tag.closing || tag.Is("sdf"))
+      continue;
+    if (!tag.Is("state"))
+    {
+      cursor.Skip(tag);
+      continue;
+    }
+
+    std::vector<Token> simTime;
+    std::vector<Token> stampTime;
+    pending.clear();
+
+    while (cursor.Next(tag) && !tag.closing)
+    {
+      if (tag.Is("sim_time") || tag.Is(stampTag.c_str()))
+      {
+        cursor.Words(words);
+        if (tag.Is("sim_time"))
+          simTime = words;
+        if (tag.Is(stampTag.c_str()))
+          stampTime = words;
+        cursor.Skip(tag);
+        continue;
+      }
+
+      std::string modelName;
+      if (!tag.Is("model") || !tag.Attribute("name", modelName) ||
+          !boost::regex_match(modelName, this->modelRegex))
+      {
+        cursor.Skip(tag);
+        continue;
+      }
+
+      // Children of a matching model
+      XmlTag modelTag = tag;
+      while (!modelTag.empty && cursor.Next(tag) && !tag.closing)
+      {
+        if (tag.Is("pose") && this->modelPose.enabled)
+        {
+          pending.push_back(PendingRecord());
+          cursor.Words(pending.back().values);
+          pending.back().name = modelName;
+          pending.back().field = POSE;
+          pending.back().selection = &this->modelPose;
+          cursor.Skip(tag);
+        }
+        else if (tag.Is("link") && this->links &&
+            tag.Attribute("name", name) &&
+            boost::regex_match(name, this->linkRegex))
+        {
+          const std::string linkName = modelName + "::" + name;
+          XmlTag linkTag = tag;
+          while (!linkTag.empty && cursor.Next(tag) && !tag.closing)
+          {
+            int field = POSE;
+            while (field <= WRENCH && !tag.Is(kFieldNames[field]))
+              ++field;
+            if (field <= WRENCH && this->linkFields[field].enabled)
+            {
+              pending.push_back(PendingRecord());
+              cursor.Words(pending.back().values);
+              pending.back().name = linkName;
+              pending.back().field = static_cast<Field>(field);
+              pending.back().selection = &this->linkFields[field];
+            }
+            cursor.Skip(tag);
+          }
+        }
+        else if (tag.Is("joint") && this->joints &&
+            tag.Attribute("name", name) &&
+            boost::regex_match(name, this->jointRegex))
+        {
+          pending.push_back(PendingRecord());
+          PendingRecord &record = pending.back();
+          record.name = modelName + "::" + name;
+          record.field = ANGLE;
+          record.selection = &this->jointAxes;
+
+          // Angles are stored by axis
+          XmlTag jointTag = tag;
+          std::string axis;
+          while (!jointTag.empty && cursor.Next(tag) && !tag.closing)
+          {
+            if (tag.Is("angle") && tag.Attribute("axis", axis))
+            {
+              const std::size_t index = std::strtoul(axis.c_str(), nullptr,
+                  10);
+              cursor.Words(words);
+              if (!words.empty() && index < 64)
+              {
+                if (record.values.size() <= index)
+                  record.values.resize(index + 1, Token(nullptr, nullptr));
+                record.values[index] = words[0];
+              }
+            }
+            cursor.Skip(tag);
+          }
+        }
+        else
+          cursor.Skip(tag);
+      }
+    }
+
+    Result result;
+    std::string timeText;
+    result.simTime = formatTime(simTime, timeText);
+    const double timeValue = formatTime(stampTime, timeText);
+    for (auto const &record : pending)
+    {
+      this->Append(timeText, timeValue, record.name, record.field,
+          record.values, *record.selection, result.data);
+    }
+    _results.push_back(std::move(result));
+  }
+}
+
+/////////////////////////////////////////////////
+void LogQuery::Append(const std::string &_time, const double _timeValue,
+    const std::string &_name, const Field _field,
+    const std::vector<Token> &_values, const Selection &_selection,
+    std::string &_out) const
+{
+  // Collect the selected values that exist
+  std::vector<Token> values;
+  if (_selection.indices.empty())
+    values = _values;
+  else
+  {
+    for (auto index : _selection.indices)
+    {
+      if (index < _values.size())
+        values.push_back(_values[index]);
+    }
+  }
+
+  std::vector<Token>::iterator last =
+    std::remove(values.begin(), values.end(), Token(nullptr, nullptr));
+  values.erase(last, values.end());
+  if (values.empty())
+    return;
+
+  if (this->format == CSV)
+  {
+    _out.append(_time).append(1, ',').append(_name).append(1, ',');
+    _out.append(kFieldNames[_field]);
+    for (auto const &value : values)
+      _out.append(1, ',').append(value.first, value.second);
+    _out.append(1, '\n');
+    return;
+  }
+
+  const uint16_t nameLen = static_cast<uint16_t>(
+      std::min<std::size_t>(_name.size(), UINT16_MAX));
+  const uint8_t field = static_cast<uint8_t>(_field);
+  const uint8_t count = static_cast<uint8_t>(
+      std::min<std::size_t>(values.size(), UINT8_MAX));
+  _out.append(reinterpret_cast<const char *>(&_timeValue),
+      sizeof(_timeValue));
+  _out.append(reinterpret_cast<const char *>(&nameLen), sizeof(nameLen));
+  _out.append(_name, 0, nameLen);
+  _out.append(reinterpret_cast<const char *>(&field), sizeof(field));
+  _out.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (uint8_t i = 0; i < count; ++i)
+  {
+    // The token is followed by whitespace or '<', which ends strtod
+    const double value = std::strtod(values[i].first, nullptr);
+    _out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+}
+
+/////////////////////////////////////////////////
+void LogQuery::WriteHeader(std::ostream &_out) const
+{
+  if (this->format == CSV)
+  {
+    _out << this->stamp << ",name,field,values\n";
+    return;
+  }
+
+  _out.write("GZLQ", 4);
+  _out.write(reinterpret_cast<const char *>(&kBinaryVersion),
+      sizeof(kBinaryVersion));
+}
+
+/////////////////////////////////////////////////
+void LogQuery::Write(const std::vector<Result> &_results, std::ostream &_out)
+{
+  for (auto const &result : _results)
+  {
+    if (this->hz > 0.0 && this->prevTime >= 0 &&
+        result.simTime - this->prevTime < 1.0 / this->hz)
+    {
+      continue;
+    }
+
+    _out.write(result.data.data(), result.data.size());
+    this->prevTime = result.simTime;
+  }
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TOOLS_GZLOGQUERY_HH_
+#define GAZEBO_TOOLS_GZLOGQUERY_HH_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/regex.hpp>
+
+namespace gazebo
+{
+  /// \brief Query of the states of a log file, which extracts the values
+  /// selected by a filter of `gz log` without building SDF elements or
+  /// world states.
+  ///
+  /// The filter has the same syntax as for echo:
+  /// model[.pose[.[x,y,z,r,p,a]]]/link[.field[.[x,...]]]/joint[.[axes]],
+  /// where names may contain '*' and a link field is one of pose,
+  /// velocity, acceleration and wrench. A model without parts selects its
+  /// pose, a link without field selects all its fields and a joint
+  /// without axes selects all its angles.
+  ///
+  /// The states are scanned with a pull parser that skips the models,
+  /// links and joints that don't match, so chunks can be scanned in
+  /// parallel. Results are written as CSV lines
+  /// "time,name,field,value[,value...]", where the name of a link or
+  /// joint is prefixed by "model::", or as binary records described by
+  /// WriteHeader().
+  class LogQuery
+  {
+    /// \brief Output formats.
+    public: enum Format
+    {
+      /// \brief Comma separated values, with a header line.
+      CSV,
+
+      /// \brief Binary records.
+      BINARY
+    };
+
+    /// \brief Fields of a record.
+    public: enum Field
+    {
+      /// \brief Pose of a model or link.
+      POSE = 0,
+
+      /// \brief Velocity of a link.
+      VELOCITY = 1,
+
+      /// \brief Acceleration of a link.
+      ACCELERATION = 2,
+
+      /// \brief Wrench of a link.
+      WRENCH = 3,
+
+      /// \brief Angles of a joint.
+      ANGLE = 4
+    };
+
+    /// \brief Records extracted from one state.
+    public: class Result
+    {
+      /// \brief Simulation time of the state, used by the rate filter.
+      public: double simTime = 0;
+
+      /// \brief Formatted records.
+      public: std::string data;
+    };
+
+    /// \brief Constructor
+    /// \param[in] _format Output format.
+    /// \param[in] _stamp Time of the records: sim, real, wall or
+    /// iterations. Sim time is used when empty.
+    /// \param[in] _hz Largest rate of the states written, 0 for all.
+    public: LogQuery(const Format _format, const std::string &_stamp,
+                const double _hz);
+
+    /// \brief Parse a filter.
+    /// \param[in] _filter Filter string.
+    /// \return False if the filter is invalid.
+    public: bool Init(const std::string &_filter);
+
+    /// \brief Extract the records of every state of a chunk. This can be
+    /// called from several threads.
+    /// \param[in] _chunk Decoded chunk of a log file.
+    /// \param[out] _results Records of every state of the chunk, appended
+    /// in order.
+    public: void Scan(const std::string &_chunk,
+                std::vector<Result> &_results) const;
+
+    /// \brief Write the header of the output. A CSV header is the column
+    /// names. A binary header is the 4 bytes "GZLQ" and a uint32 version.
+    /// A binary record is a float64 time, a uint16 name length, the name,
+    /// a uint8 Field, a uint8 count and count float64 values, all in the
+    /// byte order of the machine.
+    /// \param[in] _out Output stream.
+    public: void WriteHeader(std::ostream &_out) const;
+
+    /// \brief Write results in order, skipping the states that exceed the
+    /// rate.
+    /// \param[in] _results Results from Scan.
+    /// \param[in] _out Output stream.
+    public: void Write(const std::vector<Result> &_results,
+                std::ostream &_out);
+
+    /// \brief Range of characters of a value in a state.
+    public: typedef std::pair<const char *, const char *> Token;
+
+    /// \brief Selection of the values of a field.
+    public: class Selection
+    {
+      /// \brief Indices of the values to output, all when empty.
+      public: std::vector<unsigned int> indices;
+
+      /// \brief True if the field is selected.
+      public: bool enabled = false;
+    };
+
+    /// \brief Parse a list of pose elements or joint axes.
+    /// \param[in] _list Elements, with or without brackets.
+    /// \param[in] _pose True for pose elements, false for axes.
+    /// \param[out] _selection Selection to fill.
+    /// \return False if an element is invalid.
+    private: static bool ParseList(std::string _list, const bool _pose,
+                 Selection &_selection);
+
+    /// \brief Convert a name pattern of the filter to a regex.
+    /// \param[in] _pattern Name, where '*' matches anything.
+    /// \return Regex of the name.
+    private: static boost::regex Pattern(const std::string &_pattern);
+
+    /// \brief Append a record.
+    /// \param[in] _time Formatted time of the record.
+    /// \param[in] _timeValue Time of the record.
+    /// \param[in] _name Name of the entity.
+    /// \param[in] _field Field of the values.
+    /// \param[in] _values Values of the field, as found in the state.
+    /// \param[in] _selection Values to output.
+    /// \param[out] _out Formatted records.
+    private: void Append(const std::string &_time, const double _timeValue,
+                 const std::string &_name, const Field _field,
+                 const std::vector<Token> &_values,
+                 const Selection &_selection, std::string &_out) const;
+
+    /// \brief Output format.
+    private: Format format;
+
+    /// \brief Time stamp type.
+    private: std::string stamp;
+
+    /// \brief Largest output rate.
+    private: double hz;
+
+    /// \brief Simulation time of the last state written.
+    private: double prevTime = -1;
+
+    /// \brief Model names to match.
+    private: boost::regex modelRegex;
+
+    /// \brief Selection of the model pose.
+    private: Selection modelPose;
+
+    /// \brief True if links are selected.
+    private: bool links = false;
+
+    /// \brief Link names to match.
+    private: boost::regex linkRegex;
+
+    /// \brief Selections of the link fields, indexed by Field.
+    private: Selection linkFields[4];
+
+    /// \brief True if joints are selected.
+    private: bool joints = false;
+
+    /// \brief Joint names to match.
+    private: boost::regex jointRegex;
+
+    /// \brief Selection of the joint axes.
+    private: Selection jointAxes;
+  };
+}
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Matrix4.hh>
+
+#include <gazebo/gazebo.hh>
+#include <gazebo/physics/physics.hh>
+#include <gazebo/rendering/rendering.hh>
+
+#include "gz_shader_cache.hh"
+
+using namespace gazebo;
+
+/////////////////////////////////////////////////
+ShaderCacheCommand::ShaderCacheCommand()
+  : Command("shader-cache", "Fill the shader cache with the shaders of a world")
+{
+  // Options that are visible to the user through help.
+  this->visibleOptions.add_options()
+    ("world,w", po::value<std::string>(), "World file to render.")
+    ("iterations,i", po::value<unsigned int>()->default_value(100),
+     "Number of world iterations to run before rendering, so that the "
+     "visuals of the world are loaded.");
+}
+
+/////////////////////////////////////////////////
+void ShaderCacheCommand::HelpDetailed()
+{
+  std::cerr <<
+    "\tLoad a world without a running server, and render it from\n"
+    "\tseveral points of view. The generated and compiled shaders\n"
+    "\tare saved in the shader cache, which the next runs of gzserver\n"
+    "\tand gzclient load instead of compiling them again. The cache is\n"
+    "\tkept in rtshader_cache in the log path, see GAZEBO_LOG_PATH.\n"
+    << std::endl;
+}
+
+/////////////////////////////////////////////////
+bool ShaderCacheCommand::TransportRequired()
+{
+  // The command runs its own server.
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool ShaderCacheCommand::RunImpl()
+{
+  if (!this->vm.count("world"))
+  {
+    std::cerr << "A world file is required, see the -w option.\n";
+    return false;
+  }
+
+  if (!gazebo::setupServer())
+  {
+    std::cerr << "Unable to setup the server.\n";
+    return false;
+  }
+
+  physics::WorldPtr world =
+      gazebo::loadWorld(this->vm["world"].as<std::string>());
+  rendering::ScenePtr scene;
+  if (world)
+    scene = rendering::create_scene(world->Name(), false, true);
+
+  if (!scene)
+  {
+    std::cerr << "Unable to load the world.\n";
+    gazebo::shutdown();
+    return false;
+  }
+
+  // Run the world, which answers the request of the scene for its
+  // visuals and lights.
+  const unsigned int iterations = this->vm["iterations"].as<unsigned int>();
+  for (unsigned int i = 0; i < iterations; ++i)
+  {
+    gazebo::runWorld(world, 1);
+    scene->PreRender();
+  }
+
+  // Look around the origin, then at each model.
+  std::vector<ignition::math::Pose3d> views;
+  for (unsigned int i = 0; i < 4; ++i)
+    views.push_back(ignition::math::Pose3d(0, 0, 1, 0, 0, i * IGN_PI_2));
+  views.push_back(ignition::math::Pose3d(0, 0, 1, 0, IGN_PI_2, 0));
+  views.push_back(ignition::math::Pose3d(0, 0, 1, 0, -IGN_PI_2, 0));
+
+  for (auto const &model : world->Models())
+  {
+    const ignition::math::AxisAlignedBox box = model->BoundingBox();
+    const ignition::math::Vector3d center = box.Center();
+    const double dist = std::max(box.Size().Length(), 1.0);
+    views.push_back(ignition::math::Matrix4d::LookAt(
+        center + ignition::math::Vector3d(-dist, -dist, dist),
+        center).Pose());
+  }
+
+  rendering::CameraPtr camera =
+      scene->CreateCamera("__shader_cache_camera__", false);
+  camera->Load();
+  camera->Init();
+  camera->CreateRenderTexture("__shader_cache_camera___RttTex");
+
+  // Shaders are generated on pre-render, and compiled by the first frame
+  // that draws them.
+  for (auto const &view : views)
+  {
+    camera->SetWorldPose(view);
+    scene->PreRender();
+    camera->Update();
+    camera->Render(true);
+    camera->PostRender();
+  }
+
+  scene->RemoveCamera(camera->Name());
+  camera.reset();
+
+  const bool result = rendering::RTShaderSystem::Instance()->SaveShaderCache();
+  if (result)
+  {
+    std::cout << "Shaders of " << views.size() << " views saved in ["
+              << rendering::RTShaderSystem::Instance()->ShaderCachePath()
+              << "]\n";
+  }
+  else
+  {
+    std::cerr << "Compiled shaders can't be cached, only the generated "
+              << "shaders were saved.\n";
+  }
+
+  scene.reset();
+  gazebo::shutdown();
+
+  return result;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GAZEBO_TOOLS_GZ_SHADER_CACHE_HH_
+#define GAZEBO_TOOLS_GZ_SHADER_CACHE_HH_
+
+#include "gz.hh"
+
+namespace gazebo
+{
+  /// \brief Shader cache command. This command line option to `gz` loads
+  /// a world, and renders it from several points of view, so that the
+  /// shaders of its visuals are generated and compiled before the first
+  /// run of the world needs them.
+  class ShaderCacheCommand : public Command
+  {
+    /// \brief Constructor
+    public: ShaderCacheCommand();
+
+    // Documentation inherited
+    public: virtual void HelpDetailed();
+
+    // Documentation inherited
+    protected: virtual bool RunImpl();
+
+    // Documentation inherited
+    protected: virtual bool TransportRequired();
+  };
+}
+#endif
@@ -14,6 +14,7 @@
  * limitations under the License.
  *
 */
+#include <thread>
 #include <google/protobuf/text_format.h>
 
 #include <gazebo/gui/qt.h>
@@ -26,6 +27,9 @@
 
 using namespace gazebo;
 
+/// \brief Prefix of the topics of a replayed load profile.
+static const std::string kLoadReplayPrefix = "/gazebo/load_replay";
+
 static std::string &EraseTrailingWhitespaces(std::string &_str)
 {
   const std::string whitespaces(" \t\f\v\n\r");
@@ -54,9 +58,17 @@ TopicCommand::TopicCommand()
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
     ("publish,p", po::value<std::string>(), "Publish message on a topic.")
     ("request,r", po::value<std::string>(), "Send a request.")
+    ("record-load", po::value<std::string>(), "Record the topics, sizes and "
+     "times of the messages of all the topics to a load profile file.")
+    ("replay-load", po::value<std::string>(), "Replay a load profile file "
+     "with synthetic messages, under /gazebo/load_replay.")
+    ("speed", po::value<double>()->default_value(1.0), "Factor of the rates "
+     "of the replayed profile. Applicable with replay-load")
+    ("loops", po::value<unsigned int>()->default_value(1), "Number of times "
+     "to replay the profile. Applicable with replay-load")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<uint64_t>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw")
+     "Applicable with echo, hz, bw and record-load")
     ("msg,m", po::value<std::string>(), "Message to send on topic. "
      "Applicable with publish and request")
     ("file,f", po::value<std::string>(), "Path to a file containing the "
@@ -72,6 +84,11 @@ void TopicCommand::HelpDetailed()
     "If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\n"
+    "\tA load profile holds the topic, size and time of each message,\n"
+    "\tbut not the payloads. Record one from a simulation with\n"
+    "\t--record-load, then replay it against a server with\n"
+    "\t--replay-load to test the capacity of the transport.\n"
     << std::endl;
 }
 
@@ -102,6 +119,10 @@ bool TopicCommand::RunImpl()
     this->Publish(this->vm["publish"].as<std::string>());
   else if (this->vm.count("request"))
     this->Request(worldName, this->vm["request"].as<std::string>());
+  else if (this->vm.count("record-load"))
+    return this->RecordLoad(this->vm["record-load"].as<std::string>());
+  else if (this->vm.count("replay-load"))
+    return this->ReplayLoad(this->vm["replay-load"].as<std::string>());
   else
     this->Help();
 
@@ -573,3 +594,81 @@ bool TopicCommand::Request(const std::string &_space,
   std::cerr << "No response received\n";
   return false;
 }
+
+/////////////////////////////////////////////////
+bool TopicCommand::RecordLoad(const std::string &_filename)
+{
+  std::vector<std::string> topics;
+  for (auto const &type : transport::getAdvertisedTopics())
+  {
+    for (auto const &topic : type.second)
+    {
+      // Don't record a replay
+      if (topic.compare(0, kLoadReplayPrefix.size(), kLoadReplayPrefix) != 0)
+        topics.push_back(topic);
+    }
+  }
+
+  if (topics.empty())
+  {
+    std::cerr << "Error: No topics to record.\n";
+    return false;
+  }
+
+  transport::LoadRecorder recorder(this->node);
+  recorder.Start(topics);
+  {
+    boost::mutex::scoped_lock lock(this->sigMutex);
+    if (this->vm.count("duration"))
+      this->sigCondition.timed_wait(lock,
+          boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+    else
+      this->sigCondition.wait(lock);
+  }
+  recorder.Stop();
+
+  transport::LoadProfile profile = recorder.Profile();
+  if (!profile.Save(_filename))
+    return false;
+
+  std::cout << "Recorded " << profile.Events().size() << " messages on "
+            << profile.Topics().size() << " topics over "
+            << profile.Duration() << " seconds\n";
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TopicCommand::ReplayLoad(const std::string &_filename)
+{
+  transport::LoadProfile profile;
+  if (!profile.Load(_filename))
+    return false;
+
+  transport::LoadReplayer replayer(this->node, profile, kLoadReplayPrefix);
+
+  // Replay on another thread, so that ctrl-c stops it
+  bool done = false;
+  transport::LoadReplayStats stats;
+  std::thread thread([&]()
+      {
+        stats = replayer.Run(this->vm["speed"].as<double>(),
+            this->vm["loops"].as<unsigned int>());
+        boost::mutex::scoped_lock lock(this->sigMutex);
+        done = true;
+        this->sigCondition.notify_all();
+      });
+  {
+    boost::mutex::scoped_lock lock(this->sigMutex);
+    if (!done)
+      this->sigCondition.wait(lock);
+  }
+  replayer.Stop();
+  thread.join();
+
+  std::cout << "Replayed " << stats.messages << " messages, "
+            << stats.bytes / 1.049e6 << " MB in " << stats.wallTime
+            << " seconds\n"
+            << "Lag behind the profile: mean " << stats.meanLag * 1e3
+            << " ms, max " << stats.maxLag * 1e3 << " ms\n";
+  return true;
+}
@@ -89,6 +89,16 @@ namespace gazebo
     private: bool Request(const std::string &_space,
                      const std::string &_requestType);
 
+    /// \brief Record the load profile of all the topics.
+    /// \param[in] _filename Path of the profile file.
+    /// \return True on success
+    private: bool RecordLoad(const std::string &_filename);
+
+    /// \brief Replay a load profile with synthetic messages.
+    /// \param[in] _filename Path of the profile file.
+    /// \return True on success
+    private: bool ReplayLoad(const std::string &_filename);
+
     /// \brief Message used to hold data received from EchoCB().
     private: boost::shared_ptr<google::protobuf::Message> echoMsg;
 